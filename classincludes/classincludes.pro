@@ -20,6 +20,8 @@ CLASSHEADERS = \
     QwtAxis \
     QwtAxisId \
     QwtBezier \
+    QwtCacheEntry \
+    QwtCacheRegistry \
     QwtClipper \
     QwtColorMap \
     QwtColumnRect \
@@ -59,6 +61,7 @@ CLASSHEADERS = \
     QwtPointPolar \
     QwtPowerTransform \
     QwtRichTextEngine \
+    QwtRenderStatistics \
     QwtRoundScaleDraw \
     QwtSaturationValueColorMap \
     QwtScaleArithmetic \
@@ -66,6 +69,7 @@ CLASSHEADERS = \
     QwtScaleDraw \
     QwtScaleEngine \
     QwtScaleMap \
+    QwtScratchPool \
     QwtSimpleCompassRose \
     QwtSplineBasis \
     QwtSpline \
@@ -80,10 +84,13 @@ CLASSHEADERS = \
     QwtSplinePleasing \
     QwtSplinePolynomial \
     QwtSymbol \
+    QwtSymbolAtlas \
     QwtSystemClock \
     QwtText \
     QwtTextEngine \
     QwtTextLabel \
+    QwtTimestampScaleDraw \
+    QwtTimestampScaleEngine \
     QwtTransform \
     QwtWidgetOverlay
 
@@ -97,8 +104,15 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtLegend \
         QwtLegendData \
         QwtLegendLabel \
+        QwtListLegend \
         QwtPointMapper \
+        QwtLineRasterizer \
+        QwtPointSpatialIndex \
         QwtMatrixRasterData \
+        QwtBufferRasterData \
+        QwtMappedRasterData \
+        QwtScatteredRasterData \
+        QwtRingBufferRasterData \
         QwtOHLCSample \
         QwtPlot \
         QwtPlotAbstractBarChart \
@@ -106,10 +120,15 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotBarChart \
         QwtPlotCanvas \
         QwtPlotCurve \
+        QwtPlotCurveTracker \
         QwtPlotDict \
         QwtPlotDirectPainter \
+        QwtPlotRecorder \
+        QwtFrameEncoder \
+        QwtImageSequenceEncoder \
         QwtPlotGraphicItem \
         QwtPlotGrid \
+        QwtPlotGroup \
         QwtPlotHistogram \
         QwtPlotIntervalCurve \
         QwtPlotItem \
@@ -117,17 +136,25 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotLegendItem \
         QwtPlotMagnifier \
         QwtPlotMarker \
+        QwtPlotMarkerCollection \
         QwtPlotMultiBarChart \
+        QwtPlotMultiCurve \
+        QwtPlotStackedCurve \
+        QwtPlotOverlay \
+        QwtPlotOverview \
         QwtPlotPanner \
         QwtPlotPicker \
         QwtPlotRasterItem \
         QwtPlotRenderer \
         QwtPlotRescaler \
+        QwtAxisLink \
+        QwtPlotScene \
         QwtPlotScaleItem \
         QwtPlotSeriesItem \
         QwtPlotShapeItem \
         QwtPlotSpectroCurve \
         QwtPlotSpectrogram \
+        QwtPlotDensityItem \
         QwtPlotTextLabel \
         QwtPlotTradingCurve \
         QwtPlotVectorField \
@@ -136,21 +163,44 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtScaleWidget \
         QwtRasterData \
         QwtSeriesData \
+        QwtSeriesStatistics \
+        QwtAppendSeriesData \
+        QwtPointAppendSeriesData \
+        QwtSeriesDataPyramid \
+        QwtOHLCSeriesDataPyramid \
+        QwtIntervalSeriesDataPyramid \
+        QwtMappedSeriesData \
+        QwtViewportSeriesData \
         QwtSetSample \
         QwtSamplingThread \
+        QwtSampler \
+        QwtSamplingScheduler \
+        QwtRingBufferSeriesData \
+        QwtSwapBufferSeriesData \
+        QwtTimestampSeriesData \
+        QwtHistogramSeriesData \
         QwtSplineCurveFitter \
         QwtWeedingCurveFitter \
+        QwtDownsamplingCurveFitter \
+        QwtIncrementalWeeder \
         QwtIntervalSeriesData \
         QwtPoint3DSeriesData \
         QwtPointSeriesData \
         QwtSetSeriesData \
         QwtSyntheticPointData \
+        QwtAdaptivePointData \
+        QwtCompressedPointData \
         QwtPointArrayData \
+        QwtAbstractUniformData \
+        QwtUniformSeriesData \
+        QwtStridedPointData \
+        QwtStridedValueData \
         QwtTradingChartData \
         QwtVectorFieldSymbol \
         QwtVectorFieldArrow \
         QwtVectorFieldThinArrow \
         QwtVectorFieldData \
+        QwtRasterVectorFieldData \
         QwtVectorFieldSample \
         QwtCPointerData
 }
@@ -170,13 +220,32 @@ contains(QWT_CONFIG, QwtOpenGL) {
             greaterThan(QT_MINOR_VERSION, 3) {
 
                 CLASSHEADERS += \
-                    QwtPlotOpenGLCanvas
+                    QwtPlotOpenGLCanvas \
+                    QwtPlotOpenGLCurve \
+                    QwtPlotOpenGLSpectrogram
             }
         }
         else {
 
             CLASSHEADERS += \
-                QwtPlotOpenGLCanvas
+                QwtPlotOpenGLCanvas \
+                QwtPlotOpenGLCurve \
+                QwtPlotOpenGLSpectrogram
+        }
+    }
+}
+
+contains(QWT_CONFIG, QwtRhi) {
+
+    greaterThan(QT_MAJOR_VERSION, 5) {
+
+        !equals(QT_MAJOR_VERSION, 6) | greaterThan(QT_MINOR_VERSION, 6) {
+
+            qtHaveModule(gui-private) {
+
+                CLASSHEADERS += \
+                    QwtPlotRhiCanvas
+            }
         }
     }
 }
@@ -11,40 +11,12 @@
 #include <QwtScaleMap>
 #include <QwtPlotDirectPainter>
 #include <QwtPainter>
-
-namespace
-{
-    class CurveData : public QwtArraySeriesData< QPointF >
-    {
-      public:
-        virtual QRectF boundingRect() const QWT_OVERRIDE
-        {
-            if ( cachedBoundingRect.width() < 0.0 )
-                cachedBoundingRect = qwtBoundingRect( *this );
-
-            return cachedBoundingRect;
-        }
-
-        inline void append( const QPointF& point )
-        {
-            m_samples += point;
-        }
-
-        void clear()
-        {
-            m_samples.clear();
-            m_samples.squeeze();
-            cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
-        }
-    };
-}
+#include <QwtPointAppendSeriesData>
 
 IncrementalPlot::IncrementalPlot( QWidget* parent )
     : QwtPlot( parent )
     , m_curve( NULL )
 {
-    m_directPainter = new QwtPlotDirectPainter( this );
-
     if ( QwtPainter::isX11GraphicsSystem() )
     {
 #if QT_VERSION < 0x050000
@@ -54,7 +26,7 @@ IncrementalPlot::IncrementalPlot( QWidget* parent )
     }
 
     m_curve = new QwtPlotCurve( "Test Curve" );
-    m_curve->setData( new CurveData() );
+    m_curve->setData( new QwtPointAppendSeriesData() );
     showSymbols( true );
 
     m_curve->attach( this );
@@ -69,7 +41,8 @@ IncrementalPlot::~IncrementalPlot()
 
 void IncrementalPlot::appendPoint( const QPointF& point )
 {
-    CurveData* curveData = static_cast< CurveData* >( m_curve->data() );
+    QwtPointAppendSeriesData* curveData =
+        static_cast< QwtPointAppendSeriesData* >( m_curve->data() );
     curveData->append( point );
 
     const bool doClip = !canvas()->testAttribute( Qt::WA_PaintOnScreen );
@@ -90,16 +63,16 @@ void IncrementalPlot::appendPoint( const QPointF& point )
         const QPointF center = QwtScaleMap::transform( xMap, yMap, point );
         r.moveCenter( center.toPoint() );
 
-        m_directPainter->setClipRegion( r );
+        m_curve->directPainter()->setClipRegion( r );
     }
 
-    m_directPainter->drawSeries( m_curve,
-        curveData->size() - 1, curveData->size() - 1 );
+    m_curve->paintAppendedSamples();
 }
 
 void IncrementalPlot::clearPoints()
 {
-    CurveData* curveData = static_cast< CurveData* >( m_curve->data() );
+    QwtPointAppendSeriesData* curveData =
+        static_cast< QwtPointAppendSeriesData* >( m_curve->data() );
     curveData->clear();
 
     replot();
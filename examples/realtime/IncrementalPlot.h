@@ -8,7 +8,6 @@
 #include <QwtPlot>
 
 class QwtPlotCurve;
-class QwtPlotDirectPainter;
 
 class IncrementalPlot : public QwtPlot
 {
@@ -26,5 +25,4 @@ class IncrementalPlot : public QwtPlot
 
   private:
     QwtPlotCurve* m_curve;
-    QwtPlotDirectPainter* m_directPainter;
 };
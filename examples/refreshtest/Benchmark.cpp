@@ -0,0 +1,530 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmark.h"
+#include "Plot.h"
+
+#include <QwtPlotCurve>
+#include <QwtMath>
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QWidget>
+
+#if QT_VERSION >= 0x050000
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSysInfo>
+#endif
+
+#include <algorithm>
+
+namespace
+{
+    // a canvas, that has been configured by a token
+    bool setCanvasType( const QString& type, Settings& s )
+    {
+        s.canvas.useBackingStore = false;
+        s.canvas.paintOnScreen = false;
+#ifndef QWT_NO_OPENGL
+        s.canvas.openGL = false;
+#endif
+
+        if ( type == "plain" )
+            return true;
+
+        if ( type == "backingstore" )
+        {
+            s.canvas.useBackingStore = true;
+            return true;
+        }
+
+        if ( type == "paintonscreen" )
+        {
+            s.canvas.paintOnScreen = true;
+            return true;
+        }
+
+#ifndef QWT_NO_OPENGL
+        if ( type == "opengl" )
+        {
+            s.canvas.openGL = true;
+            return true;
+        }
+#endif
+
+        return false;
+    }
+
+    bool setUpdateType( const QString& type, Settings& s )
+    {
+        if ( type == "repaint" )
+            s.updateType = Settings::RepaintCanvas;
+        else if ( type == "replot" )
+            s.updateType = Settings::Replot;
+        else
+            return false;
+
+        return true;
+    }
+
+    bool setCurveStyle( const QString& style, Settings& s )
+    {
+        if ( style == "Lines" )
+            s.curve.style = QwtPlotCurve::Lines;
+        else if ( style == "Sticks" )
+            s.curve.style = QwtPlotCurve::Sticks;
+        else if ( style == "Steps" )
+            s.curve.style = QwtPlotCurve::Steps;
+        else if ( style == "Dots" )
+            s.curve.style = QwtPlotCurve::Dots;
+        else
+            return false;
+
+        return true;
+    }
+
+    // f.e. "FilterPoints+Antialiasing"
+    bool setAttributes( const QString& attributes, Settings& s )
+    {
+        s.curve.paintAttributes = 0;
+        s.curve.renderHint = 0;
+
+        const QStringList names = attributes.split( '+' );
+        for ( int i = 0; i < names.size(); i++ )
+        {
+            const QString name = names[i].trimmed();
+
+            if ( name == "none" )
+                continue;
+
+            if ( name == "ClipPolygons" )
+                s.curve.paintAttributes |= QwtPlotCurve::ClipPolygons;
+            else if ( name == "FilterPoints" )
+                s.curve.paintAttributes |= QwtPlotCurve::FilterPoints;
+            else if ( name == "FilterPointsAggressive" )
+                s.curve.paintAttributes |= QwtPlotCurve::FilterPointsAggressive;
+            else if ( name == "Antialiasing" )
+                s.curve.renderHint |= QwtPlotItem::RenderAntialiased;
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    // nearest rank
+    double percentile( const QVector< qint64 >& sorted, double p )
+    {
+        if ( sorted.isEmpty() )
+            return 0.0;
+
+        int index = qwtCeil( p * sorted.size() ) - 1;
+        index = qBound( 0, index, sorted.size() - 1 );
+
+        return sorted[index] / 1.0e6; // ms
+    }
+}
+
+Benchmark::Benchmark( QObject* parent )
+    : QObject( parent )
+    , m_function( "wave" )
+    , m_duration( 5.0 )
+    , m_warmup( 1.0 )
+    , m_size( 800, 600 )
+    , m_plot( NULL )
+    , m_runIndex( -1 )
+    , m_isMeasuring( false )
+    , m_lastFrame( -1 )
+{
+    m_canvasTypes << "plain";
+    m_updateTypes << "repaint";
+    m_styles << "Lines";
+    m_attributes << "none";
+    m_points << "1000";
+}
+
+Benchmark::~Benchmark()
+{
+    delete m_plot;
+}
+
+bool Benchmark::isRequested( const QStringList& arguments )
+{
+    return arguments.contains( "--benchmark" );
+}
+
+QString Benchmark::usage()
+{
+    return QString(
+        "Usage: refreshtest --benchmark [options]\n"
+        "\n"
+        "Lists are comma separated, all combinations are run.\n"
+        "\n"
+        "  --config <file>       JSON file with the options below as keys\n"
+        "  --duration <s>        measuring time of each run ( 5 )\n"
+        "  --warmup <s>          time before measuring ( 1 )\n"
+        "  --size <w>x<h>        size of the plot ( 800x600 )\n"
+        "  --canvas <list>       plain, backingstore, paintonscreen, opengl\n"
+        "  --updates <list>      repaint, replot\n"
+        "  --styles <list>       Lines, Sticks, Steps, Dots\n"
+        "  --attributes <list>   none or ClipPolygons, FilterPoints,\n"
+        "                        FilterPointsAggressive, Antialiasing joined by '+'\n"
+        "  --points <list>       number of points\n"
+        "  --function <name>     wave, noise\n"
+        "  --output <file>       write the results as JSON\n"
+        "\n"
+        "Use \"-platform offscreen\" to run without display.\n" );
+}
+
+QString Benchmark::errorString() const
+{
+    return m_error;
+}
+
+bool Benchmark::parseArguments( const QStringList& arguments )
+{
+    for ( int i = 1; i < arguments.size(); i++ )
+    {
+        const QString arg = arguments[i];
+        if ( arg == "--benchmark" || !arg.startsWith( "--" ) )
+            continue;
+
+        if ( i + 1 >= arguments.size() )
+        {
+            m_error = QString( "Missing value for %1" ).arg( arg );
+            return false;
+        }
+
+        const QString key = arg.mid( 2 );
+        const QString value = arguments[++i];
+
+        if ( key == "config" )
+        {
+            if ( !loadConfig( value ) )
+                return false;
+        }
+        else
+        {
+            if ( !setOption( key, value.split( ',' ) ) )
+                return false;
+        }
+    }
+
+    return createRuns();
+}
+
+bool Benchmark::loadConfig( const QString& fileName )
+{
+#if QT_VERSION >= 0x050000
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        m_error = QString( "Can't open %1" ).arg( fileName );
+        return false;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson( file.readAll(), &error );
+    if ( !document.isObject() )
+    {
+        m_error = QString( "%1: %2" ).arg( fileName, error.errorString() );
+        return false;
+    }
+
+    const QJsonObject config = document.object();
+    for ( QJsonObject::const_iterator it = config.constBegin();
+        it != config.constEnd(); ++it )
+    {
+        QStringList values;
+
+        const QJsonArray array = it.value().isArray()
+            ? it.value().toArray() : QJsonArray() << it.value();
+
+        for ( int i = 0; i < array.size(); i++ )
+        {
+            const QJsonValue v = array[i];
+            values += v.isDouble() ? QString::number( v.toDouble(), 'g', 15 ) : v.toString();
+        }
+
+        if ( !setOption( it.key(), values ) )
+            return false;
+    }
+
+    return true;
+#else
+    m_error = QString( "Loading %1 requires Qt >= 5" ).arg( fileName );
+    return false;
+#endif
+}
+
+bool Benchmark::setOption( const QString& key, const QStringList& values )
+{
+    if ( values.isEmpty() || values.first().isEmpty() )
+    {
+        m_error = QString( "Missing value for %1" ).arg( key );
+        return false;
+    }
+
+    bool ok = true;
+
+    if ( key == "duration" )
+        m_duration = values.first().toDouble( &ok );
+    else if ( key == "warmup" )
+        m_warmup = values.first().toDouble( &ok );
+    else if ( key == "size" )
+    {
+        const QStringList wh = values.first().split( 'x' );
+        ok = ( wh.size() == 2 );
+        if ( ok )
+            m_size = QSize( wh[0].toInt(), wh[1].toInt() );
+    }
+    else if ( key == "canvas" )
+        m_canvasTypes = values;
+    else if ( key == "updates" )
+        m_updateTypes = values;
+    else if ( key == "styles" )
+        m_styles = values;
+    else if ( key == "attributes" )
+        m_attributes = values;
+    else if ( key == "points" )
+        m_points = values;
+    else if ( key == "function" )
+        m_function = values.first();
+    else if ( key == "output" )
+        m_output = values.first();
+    else
+    {
+        m_error = QString( "Unknown option: %1" ).arg( key );
+        return false;
+    }
+
+    if ( !ok )
+        m_error = QString( "Invalid value for %1" ).arg( key );
+
+    return ok;
+}
+
+bool Benchmark::createRuns()
+{
+    Settings settings;
+    settings.updateInterval = 0; // as fast as possible
+
+    if ( m_function == "wave" )
+        settings.curve.functionType = Settings::Wave;
+    else if ( m_function == "noise" )
+        settings.curve.functionType = Settings::Noise;
+    else
+    {
+        m_error = QString( "Unknown function: %1" ).arg( m_function );
+        return false;
+    }
+
+    m_runs.clear();
+
+    for ( int c = 0; c < m_canvasTypes.size(); c++ )
+    {
+        for ( int u = 0; u < m_updateTypes.size(); u++ )
+        {
+            for ( int s = 0; s < m_styles.size(); s++ )
+            {
+                for ( int a = 0; a < m_attributes.size(); a++ )
+                {
+                    for ( int p = 0; p < m_points.size(); p++ )
+                    {
+                        Run run;
+                        run.settings = settings;
+
+                        QString invalid;
+
+                        if ( !setCanvasType( m_canvasTypes[c], run.settings ) )
+                            invalid = m_canvasTypes[c];
+                        else if ( !setUpdateType( m_updateTypes[u], run.settings ) )
+                            invalid = m_updateTypes[u];
+                        else if ( !setCurveStyle( m_styles[s], run.settings ) )
+                            invalid = m_styles[s];
+                        else if ( !setAttributes( m_attributes[a], run.settings ) )
+                            invalid = m_attributes[a];
+
+                        bool ok;
+                        run.settings.curve.numPoints = m_points[p].toUInt( &ok );
+                        if ( !ok || run.settings.curve.numPoints == 0 )
+                            invalid = m_points[p];
+
+                        if ( !invalid.isEmpty() )
+                        {
+                            m_error = QString( "Invalid value: %1" ).arg( invalid );
+                            return false;
+                        }
+
+                        run.name = QString( "canvas=%1 update=%2 style=%3 attributes=%4 points=%5" )
+                            .arg( m_canvasTypes[c], m_updateTypes[u],
+                                m_styles[s], m_attributes[a], m_points[p] );
+
+                        m_runs += run;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void Benchmark::start()
+{
+    m_plot = new Plot();
+    m_plot->resize( m_size );
+    m_plot->show();
+
+    m_runIndex = 0;
+    QTimer::singleShot( 0, this, SLOT(startRun()) );
+}
+
+void Benchmark::startRun()
+{
+    if ( m_runIndex >= m_runs.size() )
+    {
+        report();
+
+        if ( !m_output.isEmpty() && !writeResults( m_output ) )
+        {
+            QTextStream( stderr ) << "Can't write " << m_output << "\n";
+            QCoreApplication::exit( 1 );
+        }
+        else
+        {
+            QCoreApplication::quit();
+        }
+
+        return;
+    }
+
+    m_plot->setSettings( m_runs[m_runIndex].settings );
+
+    // the canvas might have been recreated
+    m_plot->canvas()->removeEventFilter( this );
+    m_plot->canvas()->installEventFilter( this );
+
+    m_isMeasuring = false;
+    QTimer::singleShot( qRound( m_warmup * 1000 ), this, SLOT(startMeasuring()) );
+}
+
+void Benchmark::startMeasuring()
+{
+    m_runs[m_runIndex].frameTimes.clear();
+
+    m_lastFrame = -1;
+    m_clock.start();
+    m_isMeasuring = true;
+
+    QTimer::singleShot( qRound( m_duration * 1000 ), this, SLOT(finishRun()) );
+}
+
+void Benchmark::finishRun()
+{
+    m_isMeasuring = false;
+
+    QVector< qint64 >& frameTimes = m_runs[m_runIndex].frameTimes;
+    std::sort( frameTimes.begin(), frameTimes.end() );
+
+    QTextStream( stderr ) << m_runIndex + 1 << "/" << m_runs.size()
+        << " " << m_runs[m_runIndex].name << "\n";
+
+    m_runIndex++;
+    QTimer::singleShot( 0, this, SLOT(startRun()) );
+}
+
+bool Benchmark::eventFilter( QObject* object, QEvent* event )
+{
+    if ( m_isMeasuring && event->type() == QEvent::Paint
+        && object == m_plot->canvas() )
+    {
+        // the time between 2 paint events of the canvas
+
+        const qint64 now = m_clock.nsecsElapsed();
+        if ( m_lastFrame >= 0 )
+            m_runs[m_runIndex].frameTimes += now - m_lastFrame;
+
+        m_lastFrame = now;
+    }
+
+    return QObject::eventFilter( object, event );
+}
+
+void Benchmark::report() const
+{
+    QTextStream out( stdout );
+
+    out << "frames\tfps\tp50 ms\tp90 ms\tp99 ms\tmax ms\trun\n";
+
+    for ( int i = 0; i < m_runs.size(); i++ )
+    {
+        const QVector< qint64 >& frameTimes = m_runs[i].frameTimes;
+
+        out << frameTimes.size()
+            << "\t" << qRound( frameTimes.size() / m_duration )
+            << "\t" << QString::number( percentile( frameTimes, 0.5 ), 'f', 2 )
+            << "\t" << QString::number( percentile( frameTimes, 0.9 ), 'f', 2 )
+            << "\t" << QString::number( percentile( frameTimes, 0.99 ), 'f', 2 )
+            << "\t" << QString::number( percentile( frameTimes, 1.0 ), 'f', 2 )
+            << "\t" << m_runs[i].name << "\n";
+    }
+}
+
+bool Benchmark::writeResults( const QString& fileName ) const
+{
+#if QT_VERSION >= 0x050000
+    QJsonObject environment;
+    environment["qwt"] = QString( QWT_VERSION_STR );
+    environment["qt"] = QString( qVersion() );
+    environment["platform"] = QGuiApplication::platformName();
+#if QT_VERSION >= 0x050400
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["cpu"] = QSysInfo::currentCpuArchitecture();
+#endif
+    environment["width"] = m_size.width();
+    environment["height"] = m_size.height();
+    environment["duration"] = m_duration;
+
+    QJsonArray runs;
+    for ( int i = 0; i < m_runs.size(); i++ )
+    {
+        const QVector< qint64 >& frameTimes = m_runs[i].frameTimes;
+
+        QJsonObject run;
+        run["name"] = m_runs[i].name;
+        run["frames"] = frameTimes.size();
+        run["fps"] = frameTimes.size() / m_duration;
+        run["p50"] = percentile( frameTimes, 0.5 );
+        run["p90"] = percentile( frameTimes, 0.9 );
+        run["p99"] = percentile( frameTimes, 0.99 );
+        run["max"] = percentile( frameTimes, 1.0 );
+
+        runs.append( run );
+    }
+
+    QJsonObject results;
+    results["environment"] = environment;
+    results["runs"] = runs;
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly ) )
+        return false;
+
+    file.write( QJsonDocument( results ).toJson() );
+    return true;
+#else
+    Q_UNUSED( fileName );
+    return false;
+#endif
+}
+
+#include "moc_Benchmark.cpp"
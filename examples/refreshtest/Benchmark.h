@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include "Settings.h"
+
+#include <QwtGlobal>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QSize>
+
+class Plot;
+
+/*
+   Runs the plot for all combinations of the configured settings
+   and reports percentiles of the frame times. The sweep is configured
+   by command line options or a JSON file ( Qt >= 5 ), see usage().
+
+   For running without display use the offscreen platform:
+
+       refreshtest --benchmark -platform offscreen --points 1000,100000
+ */
+class Benchmark : public QObject
+{
+    Q_OBJECT
+
+  public:
+    Benchmark( QObject* parent = NULL );
+    virtual ~Benchmark();
+
+    bool parseArguments( const QStringList& );
+    QString errorString() const;
+
+    static bool isRequested( const QStringList& );
+    static QString usage();
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+  public Q_SLOTS:
+    void start();
+
+  private Q_SLOTS:
+    void startRun();
+    void startMeasuring();
+    void finishRun();
+
+  private:
+    struct Run
+    {
+        QString name;
+        Settings settings;
+
+        QVector< qint64 > frameTimes; // ns
+    };
+
+    bool loadConfig( const QString& fileName );
+    bool setOption( const QString& key, const QStringList& values );
+    bool createRuns();
+    void report() const;
+    bool writeResults( const QString& fileName ) const;
+
+    QStringList m_canvasTypes;
+    QStringList m_updateTypes;
+    QStringList m_styles;
+    QStringList m_attributes;
+    QStringList m_points;
+    QString m_function;
+
+    double m_duration; // s
+    double m_warmup;   // s
+    QSize m_size;
+    QString m_output;
+
+    QString m_error;
+
+    Plot* m_plot;
+
+    QVector< Run > m_runs;
+    int m_runIndex;
+
+    bool m_isMeasuring;
+    QElapsedTimer m_clock;
+    qint64 m_lastFrame;
+};
@@ -140,6 +140,7 @@ void Plot::setSettings( const Settings& s )
 
     m_curve->setPen( s.curve.pen );
     m_curve->setBrush( s.curve.brush );
+    m_curve->setStyle( s.curve.style );
 
     m_curve->setPaintAttribute( QwtPlotCurve::ClipPolygons,
         s.curve.paintAttributes & QwtPlotCurve::ClipPolygons );
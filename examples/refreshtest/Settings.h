@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <QwtPlotCurve>
+
 #include <QPen>
 #include <QBrush>
 
@@ -31,6 +33,7 @@ class Settings
         grid.pen.setCosmetic( true );
 
         curve.brush = Qt::NoBrush;
+        curve.style = QwtPlotCurve::Lines;
         curve.numPoints = 1000;
         curve.functionType = Wave;
         curve.paintAttributes = 0;
@@ -57,6 +60,7 @@ class Settings
     {
         QPen pen;
         QBrush brush;
+        QwtPlotCurve::CurveStyle style;
         uint numPoints;
         FunctionType functionType;
         int paintAttributes;
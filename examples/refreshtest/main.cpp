@@ -4,12 +4,34 @@
  *****************************************************************************/
 
 #include "MainWindow.h"
+
 #include <QApplication>
 
+#if QT_VERSION >= 0x050000
+#include "Benchmark.h"
+#include <QTextStream>
+#endif
+
 int main( int argc, char* argv[] )
 {
     QApplication app( argc, argv );
 
+#if QT_VERSION >= 0x050000
+    if ( Benchmark::isRequested( app.arguments() ) )
+    {
+        Benchmark benchmark;
+        if ( !benchmark.parseArguments( app.arguments() ) )
+        {
+            QTextStream( stderr ) << benchmark.errorString() << "\n\n"
+                << Benchmark::usage();
+            return 1;
+        }
+
+        benchmark.start();
+        return app.exec();
+    }
+#endif
+
     MainWindow window;
     window.resize( 600, 400 );
     window.show();
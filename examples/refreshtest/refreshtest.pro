@@ -21,3 +21,11 @@ SOURCES = \
     MainWindow.cpp \
     main.cpp
 
+greaterThan(QT_MAJOR_VERSION, 4) {
+
+    # the benchmark mode writes its results with QJsonDocument
+
+    HEADERS += Benchmark.h
+    SOURCES += Benchmark.cpp
+}
+
@@ -9,6 +9,7 @@
 #include "QuoteFactory.h"
 
 #include <QwtPlotTradingCurve>
+#include <QwtOHLCSeriesDataPyramid>
 #include <QwtPlotMarker>
 #include <QwtPlotZoneItem>
 #include <QwtPlotRenderer>
@@ -178,7 +179,12 @@ void Plot::populate()
         QwtPlotTradingCurve* curve = new QwtPlotTradingCurve();
         curve->setTitle( QuoteFactory::title( stock ) );
         curve->setOrientation( Qt::Vertical );
-        curve->setSamples( QuoteFactory::samples2010( stock ) );
+
+        // the pyramid aggregates all samples, that are mapped
+        // to the same pixel, when zooming out of long series
+
+        curve->setData( new QwtOHLCSeriesDataPyramid(
+            new QwtTradingChartData( QuoteFactory::samples2010( stock ) ) ) );
 
         // as we have one sample per day a symbol width of
         // 12h avoids overlapping symbols. We also bound
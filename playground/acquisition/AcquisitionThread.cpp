@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "AcquisitionThread.h"
+
+#include <QwtRingBufferSeriesData>
+#include <QwtMath>
+
+#include <QElapsedTimer>
+#include <QVarLengthArray>
+#include <qmath.h>
+
+AcquisitionThread::AcquisitionThread( QObject* parent )
+    : QwtSamplingThread( parent )
+    , m_sampleRate( 1000.0 )
+{
+    setSchedulingMode( QwtSamplingThread::DeadlineScheduling );
+    setSampleRate( m_sampleRate );
+}
+
+void AcquisitionThread::setChannels(
+    const QVector< QwtRingBufferSeriesData* >& channels )
+{
+    m_channels = channels;
+
+    QMutexLocker locker( &m_mutex );
+    m_busyTimes.fill( 0, channels.size() );
+}
+
+void AcquisitionThread::setSampleRate( double hz )
+{
+    m_sampleRate = qMax( hz, 1.0 );
+
+    setInterval( 1e3 / m_sampleRate );
+
+    // waking up once per ms
+    setBatchSize( qMax( 1, qRound( m_sampleRate / 1e3 ) ) );
+}
+
+double AcquisitionThread::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+qint64 AcquisitionThread::busyTime( int channel ) const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_busyTimes.value( channel );
+}
+
+void AcquisitionThread::sample( double elapsed )
+{
+    sampleBatch( elapsed, 1 );
+}
+
+void AcquisitionThread::sampleBatch( double elapsed, int numSamples )
+{
+    const double step = interval() / 1e3;
+
+    QVarLengthArray< qint64, 16 > times( m_channels.size() );
+
+    QElapsedTimer timer;
+
+    for ( int ch = 0; ch < m_channels.size(); ch++ )
+    {
+        timer.start();
+
+        QwtRingBufferSeriesData* buffer = m_channels[ch];
+
+        for ( int i = 0; i < numSamples; i++ )
+        {
+            const double t = elapsed + i * step;
+            buffer->append( QPointF( t, value( ch, t ) ) );
+        }
+
+        times[ch] = timer.nsecsElapsed();
+    }
+
+    QMutexLocker locker( &m_mutex );
+
+    for ( int ch = 0; ch < m_channels.size(); ch++ )
+        m_busyTimes[ch] += times[ch];
+}
+
+double AcquisitionThread::value( int channel, double timeStamp ) const
+{
+    // each channel has its own frequency and offset
+    const double frequency = 5.0 * ( channel + 1 );
+    const double phase = std::fmod( timeStamp * frequency, 1.0 );
+
+    return 80.0 * qFastSin( phase * 2 * M_PI ) + 10.0 * channel;
+}
+
+#include "moc_AcquisitionThread.cpp"
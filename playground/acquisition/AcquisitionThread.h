@@ -0,0 +1,46 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QwtSamplingThread>
+#include <QVector>
+#include <QMutex>
+
+class QwtRingBufferSeriesData;
+
+/*
+   Generates samples for several channels at a fixed rate. The samples
+   are created in batches of ~1ms and passed to one ring buffer
+   per channel. The time spent for each channel is accumulated.
+ */
+class AcquisitionThread : public QwtSamplingThread
+{
+    Q_OBJECT
+
+  public:
+    AcquisitionThread( QObject* parent = NULL );
+
+    void setChannels( const QVector< QwtRingBufferSeriesData* >& );
+
+    void setSampleRate( double hz );
+    double sampleRate() const;
+
+    // time spent for the channel in the thread ( ns )
+    qint64 busyTime( int channel ) const;
+
+  protected:
+    virtual void sample( double elapsed ) QWT_OVERRIDE;
+    virtual void sampleBatch( double elapsed, int numSamples ) QWT_OVERRIDE;
+
+  private:
+    double value( int channel, double timeStamp ) const;
+
+    QVector< QwtRingBufferSeriesData* > m_channels;
+    double m_sampleRate;
+
+    mutable QMutex m_mutex;
+    QVector< qint64 > m_busyTimes;
+};
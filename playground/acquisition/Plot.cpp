@@ -0,0 +1,179 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Plot.h"
+#include "AcquisitionThread.h"
+
+#include <QwtPlotCurve>
+#include <QwtPlotCanvas>
+#include <QwtPlotLayout>
+#include <QwtRingBufferSeriesData>
+
+#include <QElapsedTimer>
+#include <QTimerEvent>
+
+class Curve : public QwtPlotCurve
+{
+  public:
+    Curve()
+        : m_paintTime( 0 )
+    {
+    }
+
+    virtual void drawSeries( QPainter* painter,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QwtPlotCurve::drawSeries( painter, xMap, yMap, canvasRect, from, to );
+
+        m_paintTime += timer.nsecsElapsed();
+    }
+
+    qint64 paintTime() const
+    {
+        return m_paintTime;
+    }
+
+  private:
+    mutable qint64 m_paintTime;
+};
+
+Plot::Plot( AcquisitionThread* thread,
+        int numChannels, double window, QWidget* parent )
+    : QwtPlot( parent )
+    , m_thread( thread )
+    , m_window( window )
+    , m_timerId( -1 )
+{
+    setAutoReplot( false );
+
+    QwtPlotCanvas* canvas = new QwtPlotCanvas();
+    canvas->setFrameStyle( QFrame::Box | QFrame::Plain );
+    canvas->setPalette( Qt::black );
+
+    // painting synchronously, so that the latency includes the paint event
+    canvas->setPaintAttribute( QwtPlotCanvas::BackingStore, false );
+    canvas->setPaintAttribute( QwtPlotCanvas::ImmediatePaint, true );
+
+    setCanvas( canvas );
+
+    plotLayout()->setAlignCanvasToScales( true );
+
+    setAxisTitle( QwtAxis::XBottom, "Time [s]" );
+    setAxisScale( QwtAxis::YLeft, -100.0, 100.0 + 10.0 * numChannels );
+
+    // samples of the visible window, but 4M samples at most
+    const double rate = m_thread->sampleRate();
+    const int capacity = int( qBound( 1000.0, rate * m_window, 4194304.0 ) );
+
+    for ( int ch = 0; ch < numChannels; ch++ )
+    {
+        // the buffers are owned by the curves
+        QwtRingBufferSeriesData* buffer = new QwtRingBufferSeriesData( capacity );
+        m_buffers += buffer;
+
+        Curve* curve = new Curve();
+        curve->setPen( QColor::fromHsv( ( ch * 47 ) % 360, 255, 255 ) );
+        curve->setData( buffer );
+        curve->attach( this );
+
+        m_curves += curve;
+    }
+
+    m_updateTimes.fill( 0, numChannels );
+
+    m_thread->setChannels( m_buffers );
+}
+
+void Plot::start( int frameInterval )
+{
+    m_latencies.clear();
+    m_timerId = startTimer( frameInterval );
+}
+
+void Plot::setFiltering( bool on )
+{
+    for ( int ch = 0; ch < m_curves.size(); ch++ )
+    {
+        m_curves[ch]->setPaintAttribute(
+            QwtPlotCurve::FilterPointsAggressive, on );
+    }
+}
+
+void Plot::setAntialiasing( bool on )
+{
+    for ( int ch = 0; ch < m_curves.size(); ch++ )
+        m_curves[ch]->setRenderHint( QwtPlotItem::RenderAntialiased, on );
+}
+
+int Plot::frameCount() const
+{
+    return m_latencies.size();
+}
+
+QVector< double > Plot::latencies() const
+{
+    return m_latencies;
+}
+
+int Plot::droppedSamples() const
+{
+    int dropped = 0;
+    for ( int ch = 0; ch < m_buffers.size(); ch++ )
+        dropped += m_buffers[ch]->droppedSamples();
+
+    return dropped;
+}
+
+qint64 Plot::busyTime( int channel ) const
+{
+    return m_updateTimes.value( channel ) + m_curves[channel]->paintTime();
+}
+
+void Plot::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() != m_timerId )
+    {
+        QwtPlot::timerEvent( event );
+        return;
+    }
+
+    QElapsedTimer timer;
+
+    for ( int ch = 0; ch < m_buffers.size(); ch++ )
+    {
+        timer.start();
+        m_buffers[ch]->update();
+        m_updateTimes[ch] += timer.nsecsElapsed();
+    }
+
+    const double now = m_thread->elapsed() / 1e3;
+    setAxisScale( QwtAxis::XBottom, now - m_window, now );
+
+    replot();
+
+    // the delay of the newest sample, that is on the canvas now
+
+    const double painted = m_thread->elapsed() / 1e3;
+
+    double latency = -1.0;
+    for ( int ch = 0; ch < m_buffers.size(); ch++ )
+    {
+        const QwtRingBufferSeriesData* buffer = m_buffers[ch];
+        if ( buffer->size() > 0 )
+        {
+            const double t = buffer->sample( buffer->size() - 1 ).x();
+            latency = qMax( latency, painted - t );
+        }
+    }
+
+    if ( latency >= 0.0 )
+        m_latencies += latency * 1e3;
+}
+
+#include "moc_Plot.cpp"
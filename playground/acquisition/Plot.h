@@ -0,0 +1,57 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QwtPlot>
+#include <QVector>
+
+class AcquisitionThread;
+class QwtRingBufferSeriesData;
+class Curve;
+
+/*
+   Displays the channels of an AcquisitionThread, scrolling with
+   the time. After each replot the delay between the newest sample
+   on the canvas and the moment, when painting has been finished,
+   is recorded as latency.
+ */
+class Plot : public QwtPlot
+{
+    Q_OBJECT
+
+  public:
+    Plot( AcquisitionThread*, int numChannels,
+        double window, QWidget* = NULL );
+
+    void start( int frameInterval );
+
+    void setFiltering( bool );
+    void setAntialiasing( bool );
+
+    int frameCount() const;
+
+    // end-to-end latency of each frame in ms
+    QVector< double > latencies() const;
+
+    int droppedSamples() const;
+
+    // time spent for updating and painting a channel ( ns )
+    qint64 busyTime( int channel ) const;
+
+  protected:
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
+  private:
+    AcquisitionThread* m_thread;
+    double m_window;
+
+    QVector< QwtRingBufferSeriesData* > m_buffers;
+    QVector< Curve* > m_curves;
+    QVector< qint64 > m_updateTimes;
+
+    QVector< double > m_latencies;
+    int m_timerId;
+};
@@ -0,0 +1,17 @@
+######################################################################
+# Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+# This file may be used under the terms of the 3-clause BSD License
+######################################################################
+
+include( $${PWD}/../playground.pri )
+
+TARGET       = acquisition
+
+HEADERS = \
+    AcquisitionThread.h \
+    Plot.h
+
+SOURCES = \
+    AcquisitionThread.cpp \
+    Plot.cpp \
+    main.cpp
@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+   A stress test for live plots: an AcquisitionThread produces samples
+   for several channels at a configurable rate, while the plot displays
+   the last seconds. After the configured duration the latencies,
+   dropped samples and the time spent per channel are printed.
+
+   acquisition --rate 1e6 --channels 8 --duration 10 [--window 1]
+       [--fps 60] [--filter] [--antialiasing] [-platform offscreen]
+ */
+
+#include "AcquisitionThread.h"
+#include "Plot.h"
+
+#include <QApplication>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace
+{
+    class Options
+    {
+      public:
+        Options()
+            : rate( 1e4 )
+            , channels( 4 )
+            , duration( 10.0 )
+            , window( 1.0 )
+            , fps( 60 )
+            , filter( false )
+            , antialiasing( false )
+        {
+        }
+
+        bool parse( const QStringList& args, QString& error )
+        {
+            for ( int i = 1; i < args.size(); i++ )
+            {
+                const QString arg = args[i];
+
+                if ( arg == "--filter" )
+                {
+                    filter = true;
+                    continue;
+                }
+
+                if ( arg == "--antialiasing" )
+                {
+                    antialiasing = true;
+                    continue;
+                }
+
+                if ( !arg.startsWith( "--" ) )
+                    continue;
+
+                if ( i + 1 >= args.size() )
+                {
+                    error = QString( "Missing value for %1" ).arg( arg );
+                    return false;
+                }
+
+                bool ok = false;
+                const QString value = args[++i];
+
+                if ( arg == "--rate" )
+                    rate = value.toDouble( &ok );
+                else if ( arg == "--channels" )
+                    channels = value.toInt( &ok );
+                else if ( arg == "--duration" )
+                    duration = value.toDouble( &ok );
+                else if ( arg == "--window" )
+                    window = value.toDouble( &ok );
+                else if ( arg == "--fps" )
+                    fps = value.toInt( &ok );
+
+                if ( !ok || rate < 1.0 || channels < 1
+                    || duration <= 0.0 || window <= 0.0 || fps < 1 )
+                {
+                    error = QString( "Invalid option: %1 %2" ).arg( arg, value );
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        double rate; // Hz
+        int channels;
+        double duration; // s
+        double window; // s
+        int fps;
+        bool filter;
+        bool antialiasing;
+    };
+
+    double percentile( QVector< double > values, double p )
+    {
+        if ( values.isEmpty() )
+            return 0.0;
+
+        std::sort( values.begin(), values.end() );
+
+        const int index = qBound( 0, int( p * values.size() + 0.5 ) - 1,
+            values.size() - 1 );
+
+        return values[index];
+    }
+
+    void report( const Options& options,
+        const AcquisitionThread& thread, const Plot& plot )
+    {
+        const QwtSamplingThread::Statistics statistics = thread.statistics();
+        const QVector< double > latencies = plot.latencies();
+
+        const double wall = options.duration * 1e9; // ns
+
+        QTextStream out( stdout );
+
+        out << "rate:               " << options.rate << " Hz\n";
+        out << "channels:           " << options.channels << "\n";
+        out << "frames:             " << plot.frameCount()
+            << " ( " << plot.frameCount() / options.duration << " fps )\n";
+
+        out << "latency p50/p99/max: "
+            << percentile( latencies, 0.5 ) << " / "
+            << percentile( latencies, 0.99 ) << " / "
+            << percentile( latencies, 1.0 ) << " ms\n";
+
+        out << "samples:            "
+            << qint64( statistics.numSamples ) * options.channels << "\n";
+        out << "skipped deadlines:  "
+            << qint64( statistics.numSkipped ) * options.channels << " samples\n";
+        out << "queue overflows:    " << plot.droppedSamples() << " samples\n";
+        out << "wakeup jitter:      " << statistics.meanJitter
+            << " ms mean, " << statistics.maxJitter << " ms max\n";
+
+        out << "channel\tacquisition %\tgui %\n";
+        for ( int ch = 0; ch < options.channels; ch++ )
+        {
+            out << ch
+                << "\t" << 100.0 * thread.busyTime( ch ) / wall
+                << "\t" << 100.0 * plot.busyTime( ch ) / wall << "\n";
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    QApplication app( argc, argv );
+
+    Options options;
+
+    QString error;
+    if ( !options.parse( app.arguments(), error ) )
+    {
+        QTextStream( stderr ) << error << "\n";
+        return 1;
+    }
+
+    AcquisitionThread thread;
+    thread.setSampleRate( options.rate );
+
+    Plot plot( &thread, options.channels, options.window );
+    plot.setFiltering( options.filter );
+    plot.setAntialiasing( options.antialiasing );
+    plot.resize( 800, 600 );
+    plot.show();
+
+    thread.start();
+    plot.start( qMax( 1, 1000 / options.fps ) );
+
+    QTimer::singleShot( qRound( options.duration * 1000 ), &app, SLOT(quit()) );
+
+    const int ret = app.exec();
+
+    thread.stop();
+    thread.wait();
+
+    report( options, thread, plot );
+
+    return ret;
+}
@@ -5,21 +5,13 @@
 
 #pragma once
 
-#include <QwtPlotPicker>
+#include <QwtPlotCurveTracker>
 
-class QwtPlotCurve;
-class QLineF;
-
-class CurveTracker : public QwtPlotPicker
+class CurveTracker : public QwtPlotCurveTracker
 {
   public:
     CurveTracker( QWidget* );
 
   protected:
     virtual QwtText trackerTextF( const QPointF& ) const QWT_OVERRIDE;
-    virtual QRect trackerRect( const QFont& ) const QWT_OVERRIDE;
-
-  private:
-    QString curveInfoAt( const QwtPlotCurve*, const QPointF& ) const;
-    QLineF curveLineAt( const QwtPlotCurve*, double x ) const;
 };
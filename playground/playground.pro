@@ -17,7 +17,8 @@ contains(QWT_CONFIG, QwtPlot) {
         shapes \
         curvetracker \
         vectorfield \
-        symbols
+        symbols \
+        acquisition
 
     greaterThan(QT_MAJOR_VERSION, 4) {
         qtHaveModule(svg) {
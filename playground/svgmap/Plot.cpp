@@ -76,6 +76,7 @@ void Plot::loadSVG( const QString& fileName )
     if ( m_mapItem == NULL )
     {
         m_mapItem = new QwtPlotGraphicItem();
+        m_mapItem->setCachePolicy( QwtPlotGraphicItem::TileCache );
         m_mapItem->attach( this );
     }
 
@@ -108,6 +108,14 @@ QWT_CONFIG     += QwtSvg
 
 QWT_CONFIG     += QwtOpenGL
 
+######################################################################
+# If you want to use a plot canvas based on the Qt Rendering Hardware
+# Interface ( Vulkan, Metal, Direct3D ). Requires Qt >= 6.7 with
+# the private headers of the Qt Gui module being installed.
+######################################################################
+
+#QWT_CONFIG     += QwtRhi
+
 ######################################################################
 # If you want to build the Qwt designer plugin,
 # enable the line below.
@@ -9,15 +9,57 @@
 
 #include "qwt_abstract_scale_draw.h"
 #include "qwt_text.h"
+#include "qwt_text_engine.h"
 #include "qwt_painter.h"
 #include "qwt_scale_map.h"
 #include "qwt_math.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpalette.h>
 #include <qmap.h>
 #include <qlist.h>
+#include <qvector.h>
 #include <qlocale.h>
+#include <qstatictext.h>
+#include <qpaintengine.h>
+#include <algorithm>
+
+static const int qwtMaxCachedLabels = 200;
+
+// estimated memory of the cached labels in bytes
+static const int qwtCachedLabelSize = 256;
+static const int qwtStaticLabelSize = 1024;
+
+namespace
+{
+    class CachedLabel
+    {
+      public:
+        CachedLabel()
+            : usage( 0 )
+        {
+        }
+
+        QwtText text;
+        uint usage;
+    };
+
+    class StaticLabel
+    {
+      public:
+        StaticLabel()
+            : isPlainText( false )
+        {
+        }
+
+        QString text;
+        bool isPlainText;
+
+        QStaticText staticText;
+        QPointF offset;
+    };
+}
 
 class QwtAbstractScaleDraw::PrivateData
 {
@@ -25,7 +67,9 @@ class QwtAbstractScaleDraw::PrivateData
     PrivateData():
         spacing( 4.0 ),
         penWidthF( 0.0 ),
-        minExtent( 0.0 )
+        minExtent( 0.0 ),
+        labelUsage( 0 ),
+        cacheEntry( this )
     {
         components = QwtAbstractScaleDraw::Backbone
             | QwtAbstractScaleDraw::Ticks
@@ -47,9 +91,188 @@ class QwtAbstractScaleDraw::PrivateData
 
     double minExtent;
 
-    QMap< double, QwtText > labelCache;
+    bool drawStaticLabel( QPainter*, double value,
+        const QwtText&, const QRectF& );
+
+    void clearLabelCache()
+    {
+        labelCache.clear();
+        staticLabelCache.clear();
+    }
+
+    void updateCacheUsage()
+    {
+        cacheEntry.setMemoryUsage(
+            qint64( labelCache.size() ) * qwtCachedLabelSize
+            + qint64( staticLabelCache.size() ) * qwtStaticLabelSize );
+    }
+
+    void updateLabelCache( const QwtScaleDiv& oldDiv, const QwtScaleDiv& newDiv );
+
+    QMap< double, CachedLabel > labelCache;
+    uint labelUsage;
+
+    QFont staticLabelFont;
+    QMap< double, StaticLabel > staticLabelCache;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::LabelCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->clearLabelCache();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
+/*
+    Labels depend on their value only, what is also true for the labels
+    of a scale division, that has been translated. As the width of the scale
+    might be responsible for the number format in derived classes -
+    f.e. QwtDateScaleDraw - the labels are only kept for translations.
+ */
+void QwtAbstractScaleDraw::PrivateData::updateLabelCache(
+    const QwtScaleDiv& oldDiv, const QwtScaleDiv& newDiv )
+{
+    if ( !qFuzzyCompare( oldDiv.range(), newDiv.range() ) )
+    {
+        clearLabelCache();
+        return;
+    }
+
+    if ( labelCache.size() <= qwtMaxCachedLabels )
+        return;
+
+    // removing the least recently used labels, that are not on the new scale
+
+    const QList< double >& ticks = newDiv.ticks( QwtScaleDiv::MajorTick );
+    for ( int i = 0; i < ticks.size(); i++ )
+    {
+        QMap< double, CachedLabel >::iterator it = labelCache.find( ticks[i] );
+        if ( it != labelCache.end() )
+            it->usage = labelUsage;
+    }
+
+    QVector< uint > usages;
+    usages.reserve( labelCache.size() );
+
+    for ( QMap< double, CachedLabel >::const_iterator it = labelCache.constBegin();
+        it != labelCache.constEnd(); ++it )
+    {
+        usages += it->usage;
+    }
+
+    // keeping 3/4 of the entries, so that we don't run into this too often
+
+    const int numRemoved = labelCache.size() - qwtMaxCachedLabels * 3 / 4;
+
+    std::nth_element( usages.begin(), usages.begin() + numRemoved, usages.end() );
+    const uint minUsage = usages[ numRemoved ];
+
+    QMap< double, CachedLabel >::iterator it = labelCache.begin();
+    while ( it != labelCache.end() )
+    {
+        if ( it->usage < minUsage )
+        {
+            staticLabelCache.remove( it.key() );
+            it = labelCache.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool QwtAbstractScaleDraw::PrivateData::drawStaticLabel(
+    QPainter* painter, double value, const QwtText& label, const QRectF& rect )
+{
+    if ( label.testPaintAttribute( QwtText::PaintBackground ) &&
+        ( label.borderPen() != Qt::NoPen || label.backgroundBrush() != Qt::NoBrush ) )
+    {
+        return false;
+    }
+
+    if ( !QwtPainter::roundingAlignment( painter ) )
+        return false;
+
+    const QPaintEngine::Type engineType = painter->paintEngine()->type();
+    if ( engineType != QPaintEngine::Raster &&
+        engineType != QPaintEngine::OpenGL2 )
+    {
+        return false;
+    }
+
+    const QFont font = label.usedFont( painter->font() );
+    if ( font != staticLabelFont )
+    {
+        staticLabelCache.clear();
+        staticLabelFont = font;
+    }
+
+    QMap< double, StaticLabel >::iterator it = staticLabelCache.find( value );
+    if ( it == staticLabelCache.end() || it->text != label.text() )
+    {
+        StaticLabel staticLabel;
+        staticLabel.text = label.text();
+
+        const QwtTextEngine* engine =
+            QwtText::textEngine( label.text(), QwtText::AutoText );
+
+        staticLabel.isPlainText =
+            ( dynamic_cast< const QwtPlainTextEngine* >( engine ) != NULL )
+            && !label.text().contains( QLatin1Char( '\n' ) );
+
+        if ( staticLabel.isPlainText )
+        {
+            staticLabel.staticText.setTextFormat( Qt::PlainText );
+            staticLabel.staticText.setPerformanceHint( QStaticText::AggressiveCaching );
+            staticLabel.staticText.setText( label.text() );
+
+            if ( label.testLayoutAttribute( QwtText::MinimumLayout ) )
+            {
+                double left, right, top, bottom;
+                engine->textMargins( QwtPainter::scaledFont( font ),
+                    label.text(), left, right, top, bottom );
+
+                staticLabel.offset = QPointF( -left, -top );
+            }
+        }
+
+        it = staticLabelCache.insert( value, staticLabel );
+        updateCacheUsage();
+    }
+
+    if ( !it->isPlainText )
+        return false;
+
+    painter->save();
+
+    painter->setFont( font );
+
+    const QColor color = label.usedColor( painter->pen().color() );
+    if ( color.isValid() )
+        painter->setPen( color );
+
+    painter->drawStaticText( rect.topLeft() + it->offset, it->staticText );
+
+    painter->restore();
+
+    return true;
+}
+
 /*!
    \brief Constructor
 
@@ -103,9 +326,11 @@ bool QwtAbstractScaleDraw::hasComponent( ScaleComponent component ) const
  */
 void QwtAbstractScaleDraw::setScaleDiv( const QwtScaleDiv& scaleDiv )
 {
+    m_data->updateLabelCache( m_data->scaleDiv, scaleDiv );
+    m_data->updateCacheUsage();
+
     m_data->scaleDiv = scaleDiv;
     m_data->map.setScaleInterval( scaleDiv.lowerBound(), scaleDiv.upperBound() );
-    m_data->labelCache.clear();
 }
 
 /*!
@@ -393,28 +618,66 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
 const QwtText& QwtAbstractScaleDraw::tickLabel(
     const QFont& font, double value ) const
 {
-    QMap< double, QwtText >::const_iterator it1 = m_data->labelCache.constFind( value );
-    if ( it1 != m_data->labelCache.constEnd() )
-        return *it1;
+    QMap< double, CachedLabel >::iterator it = m_data->labelCache.find( value );
+    if ( it == m_data->labelCache.end() )
+    {
+        CachedLabel cachedLabel;
 
-    QwtText lbl = label( value );
-    lbl.setRenderFlags( 0 );
-    lbl.setLayoutAttribute( QwtText::MinimumLayout );
+        cachedLabel.text = label( value );
+        cachedLabel.text.setRenderFlags( 0 );
+        cachedLabel.text.setLayoutAttribute( QwtText::MinimumLayout );
 
-    ( void )lbl.textSize( font ); // initialize the internal cache
+        // initialize the internal cache
+        ( void )cachedLabel.text.textSize( font );
 
-    QMap< double, QwtText >::iterator it2 = m_data->labelCache.insert( value, lbl );
-    return *it2;
+        it = m_data->labelCache.insert( value, cachedLabel );
+        m_data->updateCacheUsage();
+    }
+    else
+    {
+        m_data->cacheEntry.touch();
+    }
+
+    it->usage = ++m_data->labelUsage;
+    return it->text;
 }
 
 /*!
    Invalidate the cache used by tickLabel()
 
-   The cache is invalidated, when a new QwtScaleDiv is set. If
-   the labels need to be changed. while the same QwtScaleDiv is set,
-   invalidateCache() needs to be called manually.
+   The cache is invalidated, when a new QwtScaleDiv with a different
+   range is set. For divisions, that have been translated - like when
+   scrolling - the labels of the values, that are still on the scale,
+   are kept. The cache is limited to the labels used most recently.
+
+   If the labels need to be changed, while the same QwtScaleDiv or
+   a translated one is set, invalidateCache() needs to be called manually.
  */
 void QwtAbstractScaleDraw::invalidateCache()
 {
-    m_data->labelCache.clear();
+    m_data->clearLabelCache();
+    m_data->updateCacheUsage();
+}
+
+/*!
+   \brief Draw a tick label into a rectangle
+
+   Labels, that are rendered by the QwtPlainTextEngine are drawn from a
+   QStaticText, that is cached together with the label. So the layout of
+   the glyphs is only done, when the label, the font or the scale division
+   have changed. All other labels - or when painting to vector graphics
+   formats - are drawn by QwtText::draw().
+
+   \param painter Painter
+   \param value Value of the tick
+   \param label Label, usually returned from tickLabel()
+   \param rect Bounding rectangle for the label
+
+   \sa tickLabel(), drawLabel()
+ */
+void QwtAbstractScaleDraw::drawTickLabel( QPainter* painter,
+    double value, const QwtText& label, const QRectF& rect ) const
+{
+    if ( !m_data->drawStaticLabel( painter, value, label, rect ) )
+        label.draw( painter, rect );
 }
@@ -19,6 +19,7 @@ class QPainter;
 class QFont;
 class QwtTransform;
 class QwtScaleMap;
+class QRectF;
 
 /*!
    \brief A abstract base class for drawing scales
@@ -128,6 +129,9 @@ class QWT_EXPORT QwtAbstractScaleDraw
 
     const QwtText& tickLabel( const QFont&, double value ) const;
 
+    void drawTickLabel( QPainter*, double value,
+        const QwtText&, const QRectF& ) const;
+
   private:
     Q_DISABLE_COPY(QwtAbstractScaleDraw)
 
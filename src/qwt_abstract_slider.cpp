@@ -56,6 +56,8 @@ class QwtAbstractSlider::PrivateData
         , value( 0.0 )
         , wrapping( false )
         , invertedControls( false )
+        , hasPendingValue( false )
+        , pendingValue( 0.0 )
     {
     }
 
@@ -75,6 +77,9 @@ class QwtAbstractSlider::PrivateData
 
     bool wrapping;
     bool invertedControls;
+
+    bool hasPendingValue;
+    double pendingValue;
 };
 
 /*!
@@ -569,6 +574,9 @@ bool QwtAbstractSlider::stepAlignment() const
  */
 void QwtAbstractSlider::setValue( double value )
 {
+    // an explicit value wins over a pending one
+    m_data->hasPendingValue = false;
+
     value = qBound( minimum(), value, maximum() );
 
     const bool changed = ( m_data->value != value ) || !m_data->isValid;
@@ -583,6 +591,51 @@ void QwtAbstractSlider::setValue( double value )
     }
 }
 
+/*!
+   \brief Set a value, that is applied, when the application
+          enters the event loop
+
+   When values are arriving faster than they can be displayed - f.e.
+   from a fieldbus - assigning each of them by setValue() results in
+   calling sliderChange() and emitting valueChanged() for each value.
+   setPendingValue() only stores the value, and only the last one
+   is assigned by setValue(), when control returns to the event loop.
+   So all sliders of a panel, that have been updated in between,
+   are repainted together in the next frame.
+
+   \param value New value
+   \sa setValue(), hasPendingValue()
+
+   \note value() returns the previous value, until the pending value
+         has been applied. A call of setValue() discards the pending value.
+ */
+void QwtAbstractSlider::setPendingValue( double value )
+{
+    m_data->pendingValue = value;
+
+    if ( !m_data->hasPendingValue )
+    {
+        m_data->hasPendingValue = true;
+        QMetaObject::invokeMethod( this, "applyPendingValue", Qt::QueuedConnection );
+    }
+}
+
+/*!
+   \return True, when a value set by setPendingValue()
+           has not been applied yet
+   \sa setPendingValue()
+ */
+bool QwtAbstractSlider::hasPendingValue() const
+{
+    return m_data->hasPendingValue;
+}
+
+void QwtAbstractSlider::applyPendingValue()
+{
+    if ( m_data->hasPendingValue )
+        setValue( m_data->pendingValue );
+}
+
 //! Returns the current value.
 double QwtAbstractSlider::value() const
 {
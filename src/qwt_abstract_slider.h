@@ -79,8 +79,11 @@ class QWT_EXPORT QwtAbstractSlider : public QwtAbstractScale
     void setInvertedControls( bool );
     bool invertedControls() const;
 
+    bool hasPendingValue() const;
+
   public Q_SLOTS:
     void setValue( double value );
+    void setPendingValue( double value );
 
   Q_SIGNALS:
 
@@ -156,6 +159,9 @@ class QWT_EXPORT QwtAbstractSlider : public QwtAbstractScale
     double incrementedValue(
         double value, int stepCount ) const;
 
+  private Q_SLOTS:
+    void applyPendingValue();
+
   private:
     double alignedValue( double ) const;
     double boundedValue( double ) const;
@@ -0,0 +1,474 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_adaptive_point_data.h"
+#include "qwt_math.h"
+#include "qwt_plot.h"
+
+#include <qwidget.h>
+#include <qpointer.h>
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // below this number of values the overhead of threads is not worth it
+    const int qwtMinParallelValues = 64;
+
+    class QwtAdaptiveSegment
+    {
+      public:
+        QwtAdaptiveSegment()
+        {
+        }
+
+        QwtAdaptiveSegment( const QPointF& p1, const QPointF& p2 )
+            : p1( p1 )
+            , p2( p2 )
+        {
+        }
+
+        QPointF p1;
+        QPointF p2;
+    };
+
+    class QwtAdaptiveJob
+    {
+      public:
+        const QwtSyntheticPointData* data;
+
+        const double* x;
+        double* y;
+        int numValues;
+    };
+}
+
+static void qwtEvaluateJob( const QwtAdaptiveJob* job )
+{
+    for ( int i = 0; i < job->numValues; i++ )
+        job->y[i] = job->data->y( job->x[i] );
+}
+
+static inline bool qwtLessX( const QPointF& p1, const QPointF& p2 )
+{
+    return p1.x() < p2.x();
+}
+
+static inline bool qwtNeedsRefinement( const QPointF& p1,
+    const QPointF& p, const QPointF& p2, double yScale, double tolerance )
+{
+    const bool nan1 = qIsNaN( p1.y() );
+    const bool nan = qIsNaN( p.y() );
+    const bool nan2 = qIsNaN( p2.y() );
+
+    if ( nan1 || nan || nan2 )
+    {
+        // the border of a gap
+        return !( nan1 && nan && nan2 );
+    }
+
+    const double deviation = p.y() - 0.5 * ( p1.y() + p2.y() );
+    return qAbs( deviation ) * yScale > tolerance;
+}
+
+class QwtAdaptivePointData::PrivateData
+{
+  public:
+    PrivateData()
+        : sampleSpacing( 4 )
+        , tolerance( 0.5 )
+        , maxDepth( 8 )
+        , parallelEvaluation( false )
+        , isDirty( true )
+    {
+    }
+
+    QPointer< QwtPlot > plot;
+
+    int sampleSpacing;
+    double tolerance;
+    int maxDepth;
+    bool parallelEvaluation;
+
+    // the points of the last update and its parameters
+
+    bool isDirty;
+    QwtInterval interval;
+    QRectF rect;
+    QSize canvasSize;
+
+    QVector< QPointF > points;
+};
+
+/*!
+   Constructor
+
+   \param size Number of pixels, when no plot has been assigned
+   \param interval Bounding interval for the points
+
+   \sa setPlot(), setInterval()
+ */
+QwtAdaptivePointData::QwtAdaptivePointData(
+        size_t size, const QwtInterval& interval )
+    : QwtSyntheticPointData( size, interval )
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtAdaptivePointData::~QwtAdaptivePointData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the plot, whose canvas size determines the resolution
+
+   \param plot Plot
+   \sa plot()
+ */
+void QwtAdaptivePointData::setPlot( QwtPlot* plot )
+{
+    m_data->plot = plot;
+    m_data->isDirty = true;
+}
+
+/*!
+   \return Plot, whose canvas size determines the resolution
+   \sa setPlot()
+ */
+QwtPlot* QwtAdaptivePointData::plot() const
+{
+    return m_data->plot;
+}
+
+/*!
+   \brief Set the distance between the points before refinement
+
+   \param pixels Distance in pixels. The default setting is 4.
+   \sa sampleSpacing(), setTolerance()
+ */
+void QwtAdaptivePointData::setSampleSpacing( int pixels )
+{
+    pixels = qMax( pixels, 1 );
+
+    if ( pixels != m_data->sampleSpacing )
+    {
+        m_data->sampleSpacing = pixels;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return Distance between the points before refinement
+   \sa setSampleSpacing()
+ */
+int QwtAdaptivePointData::sampleSpacing() const
+{
+    return m_data->sampleSpacing;
+}
+
+/*!
+   \brief Set the tolerance for refining a step
+
+   A step is bisected, when the y coordinate of its center deviates
+   by more than tolerance from the line between its end points.
+
+   \param pixels Tolerance in pixels. The default setting is 0.5.
+   \sa tolerance(), setMaxDepth()
+ */
+void QwtAdaptivePointData::setTolerance( double pixels )
+{
+    pixels = qMax( pixels, 0.0 );
+
+    if ( pixels != m_data->tolerance )
+    {
+        m_data->tolerance = pixels;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return Tolerance for refining a step
+   \sa setTolerance()
+ */
+double QwtAdaptivePointData::tolerance() const
+{
+    return m_data->tolerance;
+}
+
+/*!
+   \brief Set the maximum number of bisections of a step
+
+   At a discontinuity the refinement always ends at the maximum depth,
+   where the step has been narrowed down to sampleSpacing() / 2^depth pixels.
+
+   \param depth Maximum number of bisections. The default setting is 8.
+   \sa maxDepth(), setTolerance()
+ */
+void QwtAdaptivePointData::setMaxDepth( int depth )
+{
+    depth = qBound( 0, depth, 30 );
+
+    if ( depth != m_data->maxDepth )
+    {
+        m_data->maxDepth = depth;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return Maximum number of bisections of a step
+   \sa setMaxDepth()
+ */
+int QwtAdaptivePointData::maxDepth() const
+{
+    return m_data->maxDepth;
+}
+
+/*!
+   \brief En/Disable the evaluation of y() in several threads
+
+   \param on On/Off. The default setting is off.
+   \note y() has to be thread-safe, when the parallel evaluation is enabled
+   \sa parallelEvaluation()
+ */
+void QwtAdaptivePointData::setParallelEvaluation( bool on )
+{
+    m_data->parallelEvaluation = on;
+}
+
+/*!
+   \return True, when y() is evaluated in several threads
+   \sa setParallelEvaluation()
+ */
+bool QwtAdaptivePointData::parallelEvaluation() const
+{
+    return m_data->parallelEvaluation;
+}
+
+/*!
+   \brief Discard the cached points
+
+   invalidate() has to be called, when the function has been changed.
+ */
+void QwtAdaptivePointData::invalidate()
+{
+    m_data->isDirty = true;
+}
+
+/*!
+   \return Number of points for the current rectangle of interest
+   \sa sample()
+ */
+size_t QwtAdaptivePointData::size() const
+{
+    updatePoints();
+    return m_data->points.size();
+}
+
+/*!
+   \param index Index
+   \return Point for the current rectangle of interest
+   \note The points are updated in size()
+ */
+QPointF QwtAdaptivePointData::sample( size_t index ) const
+{
+    if ( index >= size_t( m_data->points.size() ) )
+        return QPointF( 0, 0 );
+
+    return m_data->points[ int( index ) ];
+}
+
+/*!
+   \return Bounding rectangle of the points for the current
+           rectangle of interest
+ */
+QRectF QwtAdaptivePointData::boundingRect() const
+{
+    if ( size() == 0 )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // something invalid
+
+    return qwtBoundingRect( *this );
+}
+
+/*!
+   \brief Evaluate y() for an array of x coordinates
+
+   Depending on parallelEvaluation() the values are calculated
+   in several threads.
+
+   \param x Array of x coordinates
+   \param y Array, where to store the y coordinates
+   \param numValues Number of values
+ */
+void QwtAdaptivePointData::evaluate(
+    const double* x, double* y, int numValues ) const
+{
+    int numThreads = 1;
+
+#if QWT_USE_THREADS
+    if ( m_data->parallelEvaluation && numValues >= qwtMinParallelValues )
+    {
+        numThreads = qBound( 1, QThread::idealThreadCount(),
+            numValues / qwtMinParallelValues );
+    }
+#endif
+
+    QVector< QwtAdaptiveJob > jobs( numThreads );
+
+    const int numJobValues = numValues / numThreads;
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        QwtAdaptiveJob& job = jobs[i];
+        job.data = this;
+        job.x = x + i * numJobValues;
+        job.y = y + i * numJobValues;
+        job.numValues = ( i == numThreads - 1 )
+            ? numValues - i * numJobValues : numJobValues;
+    }
+
+#if QWT_USE_THREADS
+    QVector< QFuture< void > > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( int i = 1; i < numThreads; i++ )
+        futures += QtConcurrent::run( &qwtEvaluateJob, &jobs[i] );
+
+    qwtEvaluateJob( &jobs[0] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtEvaluateJob( &jobs[0] );
+#endif
+}
+
+void QwtAdaptivePointData::updatePoints() const
+{
+    PrivateData* d = m_data;
+
+    const QRectF rect = rectOfInterest();
+
+    QwtInterval xInterval = interval();
+    if ( rect.width() > 0.0 )
+    {
+        const QwtInterval xRect = QwtInterval( rect.left(), rect.right() ).normalized();
+        xInterval = xInterval.isValid() ? ( xInterval & xRect ) : xRect;
+    }
+
+    QSize canvasSize;
+    if ( d->plot && d->plot->canvas() )
+    {
+        canvasSize = d->plot->canvas()->contentsRect().size();
+    }
+    else
+    {
+        const int n = int( qMin( QwtSyntheticPointData::size(), size_t( 10000 ) ) );
+        canvasSize = QSize( n, n );
+    }
+
+    if ( !d->isDirty && xInterval == d->interval
+        && rect == d->rect && canvasSize == d->canvasSize )
+    {
+        return;
+    }
+
+    d->isDirty = false;
+    d->interval = xInterval;
+    d->rect = rect;
+    d->canvasSize = canvasSize;
+
+    d->points.clear();
+
+    if ( !xInterval.isValid() || canvasSize.isEmpty() )
+        return;
+
+    // scale factors from plot to pixel coordinates
+
+    const double xRange = ( rect.width() > 0.0 ) ? rect.width() : xInterval.width();
+    const double xScale = ( xRange > 0.0 ) ? canvasSize.width() / xRange : 0.0;
+
+    const double yRange = qAbs( rect.height() );
+    const double yScale = ( yRange > 0.0 ) ? canvasSize.height() / yRange : 0.0;
+
+    const int numSteps = qMax( 1, qwtCeil(
+        xInterval.width() * xScale / d->sampleSpacing ) );
+
+    // upper limit for the refinement - ~8 points per pixel
+    const int maxPoints = 8 * qMax( canvasSize.width(), numSteps );
+
+    QVector< double > x( numSteps + 1 );
+    QVector< double > y( numSteps + 1 );
+
+    const double dx = xInterval.width() / numSteps;
+    for ( int i = 0; i <= numSteps; i++ )
+        x[i] = xInterval.minValue() + i * dx;
+
+    x[numSteps] = xInterval.maxValue();
+
+    evaluate( x.constData(), y.data(), x.size() );
+
+    QVector< QPointF >& points = d->points;
+    points.reserve( 2 * ( numSteps + 1 ) );
+
+    for ( int i = 0; i <= numSteps; i++ )
+        points += QPointF( x[i], y[i] );
+
+    QVector< QwtAdaptiveSegment > segments( numSteps );
+    for ( int i = 0; i < numSteps; i++ )
+        segments[i] = QwtAdaptiveSegment( points[i], points[i + 1] );
+
+    // breadth first, so that all centers of a level can be evaluated at once
+
+    for ( int depth = 0; depth < d->maxDepth && !segments.isEmpty(); depth++ )
+    {
+        if ( points.size() + segments.size() > maxPoints )
+            break;
+
+        x.resize( segments.size() );
+        y.resize( segments.size() );
+
+        for ( int i = 0; i < segments.size(); i++ )
+            x[i] = 0.5 * ( segments[i].p1.x() + segments[i].p2.x() );
+
+        evaluate( x.constData(), y.data(), x.size() );
+
+        QVector< QwtAdaptiveSegment > refined;
+
+        for ( int i = 0; i < segments.size(); i++ )
+        {
+            const QwtAdaptiveSegment& s = segments[i];
+            const QPointF center( x[i], y[i] );
+
+            points += center;
+
+            if ( qwtNeedsRefinement( s.p1, center, s.p2, yScale, d->tolerance ) )
+            {
+                refined += QwtAdaptiveSegment( s.p1, center );
+                refined += QwtAdaptiveSegment( center, s.p2 );
+            }
+        }
+
+        segments = refined;
+    }
+
+    if ( points.size() > numSteps + 1 )
+        std::sort( points.begin(), points.end(), qwtLessX );
+}
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_ADAPTIVE_POINT_DATA_H
+#define QWT_ADAPTIVE_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_point_data.h"
+
+class QwtPlot;
+
+/*!
+   \brief Synthetic point data with adaptive sampling
+
+   QwtAdaptivePointData evaluates y() in a resolution, that depends on
+   the size of the plot canvas instead of a fixed number of points:
+
+   - the x interval is divided into equidistant steps of sampleSpacing()
+     pixels
+
+   - each step is bisected recursively, as long as the y coordinate of its
+     center deviates by more than tolerance() pixels from the line between
+     its end points. So the points are refined where the curvature is high
+     and around discontinuities or gaps ( NaN ) only.
+
+   The points are calculated lazily once for each rectangle of interest and
+   are cached until the rectangle, the canvas or the settings change.
+   For expensive functions the evaluation can be distributed
+   to several threads ( see setParallelEvaluation() ).
+
+   The size of the canvas is taken from the plot assigned by setPlot().
+   Without a plot QwtSyntheticPointData::size() is used as number of
+   pixels for the width and the height of the rectangle of interest.
+
+   \note size() and sample() refer to the adaptively calculated points
+
+   \sa QwtSyntheticPointData
+ */
+class QWT_EXPORT QwtAdaptivePointData : public QwtSyntheticPointData
+{
+  public:
+    explicit QwtAdaptivePointData( size_t size = 1000,
+        const QwtInterval& = QwtInterval() );
+
+    virtual ~QwtAdaptivePointData();
+
+    void setPlot( QwtPlot* );
+    QwtPlot* plot() const;
+
+    void setSampleSpacing( int pixels );
+    int sampleSpacing() const;
+
+    void setTolerance( double pixels );
+    double tolerance() const;
+
+    void setMaxDepth( int );
+    int maxDepth() const;
+
+    void setParallelEvaluation( bool );
+    bool parallelEvaluation() const;
+
+    void invalidate();
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  protected:
+    void evaluate( const double* x, double* y, int numValues ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtAdaptivePointData )
+
+    void updatePoints() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
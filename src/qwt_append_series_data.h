@@ -0,0 +1,316 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_APPEND_SERIES_DATA_H
+#define QWT_APPEND_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+/*!
+   \brief Array of samples with an incrementally maintained bounding rectangle
+
+   QwtArraySeriesData recalculates the bounding rectangle by iterating
+   over all samples, whenever it has been invalidated. For series,
+   that are growing continuously - f.e. in streaming applications -
+   this results in iterating over all samples for each replot
+   of an autoscaling plot.
+
+   QwtAppendSeriesData extends the bounding rectangle, when samples are
+   appended, so that boundingRect() is available in O(1).
+   The samples are organized in blocks, that remember
+   their bounding rectangles. When samples are modified or removed only the
+   bounding rectangles of the affected blocks have to be recalculated.
+
+   \par Example
+   \code
+   QwtPointAppendSeriesData* data = new QwtPointAppendSeriesData();
+   curve->setData( data );
+
+   ...
+
+   data->append( QPointF( x, y ) );
+   plot->replot();
+   \endcode
+   \endpar
+ */
+template< typename T >
+class QwtAppendSeriesData : public QwtArraySeriesData< T >
+{
+  public:
+    QwtAppendSeriesData();
+    explicit QwtAppendSeriesData( const QVector< T >& samples );
+
+    void setSamples( const QVector< T >& samples );
+
+    void append( const T& );
+    void append( const QVector< T >& );
+
+    void setSample( size_t index, const T& );
+    void removeFirst( size_t count );
+
+    void clear();
+    void reserve( int size );
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    enum { BlockSize = 4096 };
+
+    void extendCache( int from, int to );
+    void invalidateBlock( int block );
+
+    static QRectF invalidRect();
+    static void unite( QRectF& rect, const QRectF& other );
+
+    mutable QVector< QRectF > m_blockRects;
+    mutable QVector< bool > m_dirtyBlocks;
+    mutable bool m_isDirty;
+};
+
+//! Interface for appending points with an incremental bounding rectangle
+typedef QwtAppendSeriesData< QPointF > QwtPointAppendSeriesData;
+
+//! Constructor
+template< typename T >
+QwtAppendSeriesData< T >::QwtAppendSeriesData()
+    : m_isDirty( false )
+{
+    QwtSeriesData< T >::cachedBoundingRect = invalidRect();
+}
+
+/*!
+   Constructor
+   \param samples Array of samples
+ */
+template< typename T >
+QwtAppendSeriesData< T >::QwtAppendSeriesData( const QVector< T >& samples )
+    : m_isDirty( false )
+{
+    setSamples( samples );
+}
+
+/*!
+   Assign an array of samples
+   \param samples Array of samples
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::setSamples( const QVector< T >& samples )
+{
+    QwtArraySeriesData< T >::m_samples = samples;
+
+    QwtSeriesData< T >::cachedBoundingRect = invalidRect();
+    m_blockRects.clear();
+    m_dirtyBlocks.clear();
+    m_isDirty = false;
+
+    extendCache( 0, samples.size() - 1 );
+}
+
+/*!
+   Append a sample and extend the bounding rectangle
+   \param sample Sample
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::append( const T& sample )
+{
+    QwtArraySeriesData< T >::m_samples += sample;
+
+    const int index = QwtArraySeriesData< T >::m_samples.size() - 1;
+    extendCache( index, index );
+}
+
+/*!
+   Append samples and extend the bounding rectangle
+   \param samples Samples
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::append( const QVector< T >& samples )
+{
+    if ( samples.isEmpty() )
+        return;
+
+    const int from = QwtArraySeriesData< T >::m_samples.size();
+    QwtArraySeriesData< T >::m_samples += samples;
+
+    extendCache( from, QwtArraySeriesData< T >::m_samples.size() - 1 );
+}
+
+/*!
+   Modify a sample
+
+   Only the bounding rectangle of the block containing the
+   sample needs to be recalculated.
+
+   \param index Index
+   \param sample Sample
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::setSample( size_t index, const T& sample )
+{
+    QVector< T >& samples = QwtArraySeriesData< T >::m_samples;
+
+    if ( int( index ) >= samples.size() )
+        return;
+
+    samples[ int( index ) ] = sample;
+    invalidateBlock( int( index ) / BlockSize );
+}
+
+/*!
+   Remove samples from the beginning of the array
+
+   As the samples of all blocks are shifted the complete bounding
+   rectangle has to be recalculated, when it is requested the next time.
+
+   \param count Number of samples to be removed
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::removeFirst( size_t count )
+{
+    QVector< T >& samples = QwtArraySeriesData< T >::m_samples;
+
+    const int n = qMin( int( count ), samples.size() );
+    if ( n <= 0 )
+        return;
+
+    samples.remove( 0, n );
+
+    m_blockRects.resize( ( samples.size() + BlockSize - 1 ) / BlockSize );
+    m_dirtyBlocks.fill( true, m_blockRects.size() );
+
+    m_isDirty = true;
+    QwtSeriesData< T >::cachedBoundingRect = invalidRect();
+}
+
+//! Remove all samples
+template< typename T >
+void QwtAppendSeriesData< T >::clear()
+{
+    setSamples( QVector< T >() );
+}
+
+/*!
+   Allocate memory for samples in advance
+   \param size Number of samples
+ */
+template< typename T >
+void QwtAppendSeriesData< T >::reserve( int size )
+{
+    QwtArraySeriesData< T >::m_samples.reserve( size );
+}
+
+/*!
+   \return Bounding rectangle of all samples
+
+   Only the blocks, that have been invalidated by setSample() or
+   removeFirst() have to be recalculated.
+ */
+template< typename T >
+QRectF QwtAppendSeriesData< T >::boundingRect() const
+{
+    if ( m_isDirty )
+    {
+        const int numSamples = QwtArraySeriesData< T >::m_samples.size();
+
+        QRectF rect = invalidRect();
+
+        for ( int block = 0; block < m_blockRects.size(); block++ )
+        {
+            if ( m_dirtyBlocks[block] )
+            {
+                const int from = block * BlockSize;
+                const int to = qMin( from + BlockSize, numSamples ) - 1;
+
+                m_blockRects[block] = qwtBoundingRect( *this, from, to );
+                m_dirtyBlocks[block] = false;
+            }
+
+            unite( rect, m_blockRects[block] );
+        }
+
+        QwtSeriesData< T >::cachedBoundingRect = rect;
+        m_isDirty = false;
+    }
+
+    return QwtSeriesData< T >::cachedBoundingRect;
+}
+
+template< typename T >
+void QwtAppendSeriesData< T >::extendCache( int from, int to )
+{
+    if ( from > to )
+        return;
+
+    const int numBlocks = to / BlockSize + 1;
+    if ( m_blockRects.size() < numBlocks )
+    {
+        const int oldSize = m_blockRects.size();
+
+        m_blockRects.resize( numBlocks );
+        m_dirtyBlocks.resize( numBlocks );
+
+        for ( int i = oldSize; i < numBlocks; i++ )
+        {
+            m_blockRects[i] = invalidRect();
+            m_dirtyBlocks[i] = false;
+        }
+    }
+
+    for ( int block = from / BlockSize; block < numBlocks; block++ )
+    {
+        const int i1 = qMax( from, block * BlockSize );
+        const int i2 = qMin( to, ( block + 1 ) * BlockSize - 1 );
+
+        const QRectF rect = qwtBoundingRect( *this, i1, i2 );
+
+        if ( !m_dirtyBlocks[block] )
+            unite( m_blockRects[block], rect );
+
+        if ( !m_isDirty )
+            unite( QwtSeriesData< T >::cachedBoundingRect, rect );
+    }
+}
+
+template< typename T >
+void QwtAppendSeriesData< T >::invalidateBlock( int block )
+{
+    if ( block >= 0 && block < m_dirtyBlocks.size() )
+    {
+        m_dirtyBlocks[block] = true;
+        m_isDirty = true;
+    }
+}
+
+template< typename T >
+inline QRectF QwtAppendSeriesData< T >::invalidRect()
+{
+    return QRectF( 1.0, 1.0, -2.0, -2.0 );
+}
+
+template< typename T >
+inline void QwtAppendSeriesData< T >::unite( QRectF& rect, const QRectF& other )
+{
+    // QRectF::united() ignores rectangles of zero size
+
+    if ( other.width() < 0.0 || other.height() < 0.0 )
+        return;
+
+    if ( rect.width() < 0.0 || rect.height() < 0.0 )
+    {
+        rect = other;
+        return;
+    }
+
+    rect.setCoords(
+        qMin( rect.left(), other.left() ), qMin( rect.top(), other.top() ),
+        qMax( rect.right(), other.right() ), qMax( rect.bottom(), other.bottom() ) );
+}
+
+#endif
@@ -0,0 +1,40 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_ATOMIC_P_H
+#define QWT_ATOMIC_P_H
+
+/*
+    Not part of the Qwt API: acquire/release operations of QAtomicInt,
+    that are also available with Qt 4, where they are emulated by
+    fetch-and-add/fetch-and-store operations.
+ */
+
+#include "qwt_global.h"
+#include <qatomic.h>
+
+static inline int qwtLoadAcquire( const QAtomicInt& value )
+{
+#if QT_VERSION >= 0x050000
+    return value.loadAcquire();
+#else
+    return const_cast< QAtomicInt& >( value ).fetchAndAddAcquire( 0 );
+#endif
+}
+
+static inline void qwtStoreRelease( QAtomicInt& value, int newValue )
+{
+#if QT_VERSION >= 0x050000
+    value.storeRelease( newValue );
+#else
+    value.fetchAndStoreRelease( newValue );
+#endif
+}
+
+#endif
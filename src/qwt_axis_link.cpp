@@ -0,0 +1,466 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_axis_link.h"
+#include "qwt_plot.h"
+#include "qwt_scale_widget.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_div.h"
+
+#include <qlist.h>
+
+namespace
+{
+    class QwtAxisLinkMember
+    {
+      public:
+        QwtAxisLinkMember( QwtPlot* plot = NULL, QwtAxisId axisId = -1 )
+            : plot( plot )
+            , axisId( axisId )
+        {
+        }
+
+        bool operator==( const QwtAxisLinkMember& other ) const
+        {
+            return ( plot == other.plot ) && ( axisId == other.axisId );
+        }
+
+        QwtPlot* plot;
+        QwtAxisId axisId;
+    };
+}
+
+class QwtAxisLink::PrivateData
+{
+  public:
+    PrivateData()
+        : canvasAlignment( true )
+        , hasScaleDiv( false )
+        , isPropagating( false )
+        , isUpdatePending( false )
+    {
+    }
+
+    bool hasPlot( const QObject* plot ) const
+    {
+        for ( int i = 0; i < members.size(); i++ )
+        {
+            if ( members[i].plot == plot )
+                return true;
+        }
+
+        return false;
+    }
+
+    void markDirty( QwtPlot* plot )
+    {
+        if ( !dirtyPlots.contains( plot ) )
+            dirtyPlots += plot;
+    }
+
+    QList< QwtAxisLinkMember > members;
+    bool canvasAlignment;
+
+    QwtScaleDiv scaleDiv;
+    bool hasScaleDiv;
+
+    bool isPropagating;
+
+    bool isUpdatePending;
+    QList< QwtPlot* > dirtyPlots;
+};
+
+/*!
+   \brief Constructor
+   \param parent Parent object
+ */
+QwtAxisLink::QwtAxisLink( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtAxisLink::~QwtAxisLink()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Add an axis to the link
+
+   When the link has a scale division already, it is assigned
+   to the axis. Otherwise the link adopts the scale division of the axis.
+
+   \param plot Plot
+   \param axisId Axis of the plot
+   \sa removeAxis(), contains()
+ */
+void QwtAxisLink::addAxis( QwtPlot* plot, QwtAxisId axisId )
+{
+    if ( plot == NULL || !plot->isAxisValid( axisId ) || contains( plot, axisId ) )
+        return;
+
+    if ( !m_data->hasPlot( plot ) )
+    {
+        connect( plot, SIGNAL(destroyed(QObject*)),
+            this, SLOT(removePlot(QObject*)) );
+    }
+
+    m_data->members += QwtAxisLinkMember( plot, axisId );
+
+    connect( plot->axisWidget( axisId ), SIGNAL(scaleDivChanged()),
+        this, SLOT(propagateScaleDiv()) );
+
+    if ( m_data->hasScaleDiv )
+    {
+        const bool doReplot = plot->autoReplot();
+        plot->setAutoReplot( false );
+
+        plot->setAxisScaleDiv( axisId, m_data->scaleDiv );
+
+        plot->setAutoReplot( doReplot );
+    }
+    else
+    {
+        m_data->scaleDiv = plot->axisScaleDiv( axisId );
+        m_data->hasScaleDiv = true;
+    }
+
+    update();
+}
+
+/*!
+   \brief Remove an axis from the link
+
+   \param plot Plot
+   \param axisId Axis of the plot
+   \sa addAxis(), contains()
+ */
+void QwtAxisLink::removeAxis( QwtPlot* plot, QwtAxisId axisId )
+{
+    const int index = m_data->members.indexOf( QwtAxisLinkMember( plot, axisId ) );
+    if ( index < 0 )
+        return;
+
+    m_data->members.removeAt( index );
+
+    disconnect( plot->axisWidget( axisId ), SIGNAL(scaleDivChanged()),
+        this, SLOT(propagateScaleDiv()) );
+
+    if ( !m_data->hasPlot( plot ) )
+    {
+        disconnect( plot, SIGNAL(destroyed(QObject*)),
+            this, SLOT(removePlot(QObject*)) );
+
+        m_data->dirtyPlots.removeAll( plot );
+    }
+
+    if ( m_data->members.isEmpty() )
+        m_data->hasScaleDiv = false;
+}
+
+/*!
+   \return True, when the axis is a member of the link
+   \param plot Plot
+   \param axisId Axis of the plot
+ */
+bool QwtAxisLink::contains( const QwtPlot* plot, QwtAxisId axisId ) const
+{
+    return m_data->members.contains(
+        QwtAxisLinkMember( const_cast< QwtPlot* >( plot ), axisId ) );
+}
+
+//! \return Number of linked axes
+int QwtAxisLink::memberCount() const
+{
+    return m_data->members.size();
+}
+
+/*!
+   \brief En/Disable the alignment of the canvases
+
+   When canvas alignment is enabled, the extents of the axes orthogonal
+   to the linked axes are aligned - f.e. the y axes of plots with linked
+   x axes - and the border distances of the linked axes are aligned.
+   So the canvases of the plots are aligned in the direction of
+   the linked axes, like for the plots of a matrix.
+
+   \param on On/Off. The default setting is on.
+   \sa canvasAlignment()
+ */
+void QwtAxisLink::setCanvasAlignment( bool on )
+{
+    if ( on != m_data->canvasAlignment )
+    {
+        m_data->canvasAlignment = on;
+        update();
+    }
+}
+
+/*!
+   \return True, when the canvases are aligned
+   \sa setCanvasAlignment()
+ */
+bool QwtAxisLink::canvasAlignment() const
+{
+    return m_data->canvasAlignment;
+}
+
+/*!
+   \brief Assign a scale division to all linked axes
+
+   The plots are updated and replotted, when the application
+   enters the event loop.
+
+   \param scaleDiv Scale division
+   \sa scaleDiv()
+ */
+void QwtAxisLink::setScaleDiv( const QwtScaleDiv& scaleDiv )
+{
+    m_data->scaleDiv = scaleDiv;
+    m_data->hasScaleDiv = true;
+
+    m_data->isPropagating = true;
+
+    for ( int i = 0; i < m_data->members.size(); i++ )
+    {
+        const QwtAxisLinkMember& member = m_data->members[i];
+
+        QwtPlot* plot = member.plot;
+        if ( plot->axisScaleDiv( member.axisId ) == scaleDiv )
+            continue;
+
+        // collecting all replots in updatePlots()
+
+        const bool doReplot = plot->autoReplot();
+        plot->setAutoReplot( false );
+
+        plot->setAxisScaleDiv( member.axisId, scaleDiv );
+
+        plot->setAutoReplot( doReplot );
+
+        m_data->markDirty( plot );
+    }
+
+    m_data->isPropagating = false;
+
+    scheduleUpdate();
+}
+
+/*!
+   \return Scale division of the linked axes
+   \sa setScaleDiv()
+ */
+QwtScaleDiv QwtAxisLink::scaleDiv() const
+{
+    return m_data->scaleDiv;
+}
+
+/*!
+   \brief Update and replot all plots of the link
+
+   The update is done, when the application enters the event loop.
+ */
+void QwtAxisLink::update()
+{
+    for ( int i = 0; i < m_data->members.size(); i++ )
+        m_data->markDirty( m_data->members[i].plot );
+
+    scheduleUpdate();
+}
+
+void QwtAxisLink::propagateScaleDiv()
+{
+    if ( m_data->isPropagating )
+        return;
+
+    for ( int i = 0; i < m_data->members.size(); i++ )
+    {
+        const QwtAxisLinkMember& member = m_data->members[i];
+
+        if ( member.plot->axisWidget( member.axisId ) == sender() )
+        {
+            const QwtScaleDiv& scaleDiv =
+                member.plot->axisScaleDiv( member.axisId );
+
+            // the peers are emitting the signal too, when being updated
+            if ( !( m_data->hasScaleDiv && scaleDiv == m_data->scaleDiv ) )
+                setScaleDiv( scaleDiv );
+
+            return;
+        }
+    }
+}
+
+void QwtAxisLink::removePlot( QObject* object )
+{
+    // the plot is being destroyed: no disconnects
+
+    for ( int i = m_data->members.size() - 1; i >= 0; i-- )
+    {
+        if ( m_data->members[i].plot == object )
+            m_data->members.removeAt( i );
+    }
+
+    for ( int i = m_data->dirtyPlots.size() - 1; i >= 0; i-- )
+    {
+        if ( m_data->dirtyPlots[i] == object )
+            m_data->dirtyPlots.removeAt( i );
+    }
+
+    if ( m_data->members.isEmpty() )
+        m_data->hasScaleDiv = false;
+}
+
+void QwtAxisLink::scheduleUpdate()
+{
+    if ( m_data->isUpdatePending || m_data->dirtyPlots.isEmpty() )
+        return;
+
+    m_data->isUpdatePending = true;
+    QMetaObject::invokeMethod( this, "updatePlots", Qt::QueuedConnection );
+}
+
+void QwtAxisLink::updatePlots()
+{
+    m_data->isUpdatePending = false;
+
+    if ( m_data->dirtyPlots.isEmpty() )
+        return;
+
+    m_data->isPropagating = true;
+
+    // the scale widgets need the new divisions for the alignment
+
+    for ( int i = 0; i < m_data->dirtyPlots.size(); i++ )
+        m_data->dirtyPlots[i]->updateAxes();
+
+    if ( m_data->canvasAlignment )
+        alignCanvases();
+
+    const QList< QwtPlot* > plots = m_data->dirtyPlots;
+    m_data->dirtyPlots.clear();
+
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        plots[i]->updateLayout();
+        plots[i]->replot();
+    }
+
+    m_data->isPropagating = false;
+}
+
+/*
+    Aligning the extents of the orthogonal axes and the border
+    distances of the linked axes, like PlotMatrix in the playground does.
+    Plots, where something has changed, are marked dirty.
+ */
+void QwtAxisLink::alignCanvases()
+{
+    const QList< QwtAxisLinkMember >& members = m_data->members;
+    if ( members.size() < 2 )
+        return;
+
+    QList< QwtPlot* > plots;
+    for ( int i = 0; i < members.size(); i++ )
+    {
+        if ( !plots.contains( members[i].plot ) )
+            plots += members[i].plot;
+    }
+
+    int crossAxes[2];
+    if ( QwtAxis::isXAxis( members[0].axisId ) )
+    {
+        crossAxes[0] = QwtAxis::YLeft;
+        crossAxes[1] = QwtAxis::YRight;
+    }
+    else
+    {
+        crossAxes[0] = QwtAxis::XBottom;
+        crossAxes[1] = QwtAxis::XTop;
+    }
+
+    for ( int k = 0; k < 2; k++ )
+    {
+        const int axisPos = crossAxes[k];
+
+        QList< double > oldExtents;
+        double maxExtent = 0.0;
+
+        for ( int i = 0; i < plots.size(); i++ )
+        {
+            QwtScaleWidget* scaleWidget = plots[i]->axisWidget( axisPos );
+            QwtScaleDraw* sd = scaleWidget->scaleDraw();
+
+            oldExtents += sd->minimumExtent();
+
+            if ( plots[i]->isAxisVisible( axisPos ) )
+            {
+                sd->setMinimumExtent( 0.0 );
+                maxExtent = qMax( maxExtent, sd->extent( scaleWidget->font() ) );
+            }
+        }
+
+        for ( int i = 0; i < plots.size(); i++ )
+        {
+            QwtScaleDraw* sd = plots[i]->axisWidget( axisPos )->scaleDraw();
+
+            if ( plots[i]->isAxisVisible( axisPos ) )
+            {
+                sd->setMinimumExtent( maxExtent );
+                if ( maxExtent != oldExtents[i] )
+                    m_data->markDirty( plots[i] );
+            }
+            else
+            {
+                sd->setMinimumExtent( oldExtents[i] );
+            }
+        }
+    }
+
+    int maxStart = 0;
+    int maxEnd = 0;
+
+    for ( int i = 0; i < members.size(); i++ )
+    {
+        QwtScaleWidget* scaleWidget = members[i].plot->axisWidget( members[i].axisId );
+
+        int start, end;
+        scaleWidget->getMinBorderDist( start, end );
+
+        scaleWidget->setMinBorderDist( 0, 0 );
+
+        int startHint, endHint;
+        scaleWidget->getBorderDistHint( startHint, endHint );
+
+        scaleWidget->setMinBorderDist( start, end );
+
+        maxStart = qMax( maxStart, startHint );
+        maxEnd = qMax( maxEnd, endHint );
+    }
+
+    for ( int i = 0; i < members.size(); i++ )
+    {
+        QwtScaleWidget* scaleWidget = members[i].plot->axisWidget( members[i].axisId );
+
+        int start, end;
+        scaleWidget->getMinBorderDist( start, end );
+
+        if ( start != maxStart || end != maxEnd )
+        {
+            scaleWidget->setMinBorderDist( maxStart, maxEnd );
+            m_data->markDirty( members[i].plot );
+        }
+    }
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_axis_link.cpp"
+#endif
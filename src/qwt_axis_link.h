@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_AXIS_LINK_H
+#define QWT_AXIS_LINK_H
+
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+
+#include <qobject.h>
+
+class QwtPlot;
+class QwtScaleDiv;
+
+/*!
+   \brief A group of synchronized axes
+
+   QwtAxisLink keeps the scales of axes of different plots in sync:
+   when the scale division of one member changes - f.e. by zooming,
+   panning or autoscaling - it is assigned to all other members.
+
+   Instead of connecting the axes to each other, where each change
+   cascades into updates of all peers, the link propagates a change
+   once and collects the updates of all plots in one pass,
+   that is executed from the event loop:
+
+   - the layouts of the plots are updated, after aligning
+     the canvases ( see setCanvasAlignment() )
+   - each plot is replotted once
+
+   \par Example
+   \code
+   QwtAxisLink* link = new QwtAxisLink( this );
+   for ( int i = 0; i < plots.size(); i++ )
+       link->addAxis( plots[i], QwtAxis::XBottom );
+   \endcode
+   \endpar
+
+   \note All members of a link should be of the same orientation.
+ */
+class QWT_EXPORT QwtAxisLink : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtAxisLink( QObject* parent = NULL );
+    virtual ~QwtAxisLink();
+
+    void addAxis( QwtPlot*, QwtAxisId );
+    void removeAxis( QwtPlot*, QwtAxisId );
+
+    bool contains( const QwtPlot*, QwtAxisId ) const;
+    int memberCount() const;
+
+    void setCanvasAlignment( bool );
+    bool canvasAlignment() const;
+
+    void setScaleDiv( const QwtScaleDiv& );
+    QwtScaleDiv scaleDiv() const;
+
+  public Q_SLOTS:
+    void update();
+
+  private Q_SLOTS:
+    void propagateScaleDiv();
+    void updatePlots();
+    void removePlot( QObject* );
+
+  private:
+    void scheduleUpdate();
+    void alignCanvases();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -11,8 +11,57 @@
 #include "qwt_math.h"
 
 #include <qpolygon.h>
+#include <qline.h>
 #include <qstack.h>
 
+static inline void qwtFlatten( const QPointF& p1, const QPointF& cp1,
+    const QPointF& cp2, const QPointF& p2, int count, QPointF* points )
+{
+    // forward differencing of the polynomial a * t^3 + b * t^2 + c * t + p1
+
+    const double h = 1.0 / count;
+    const double h2 = h * h;
+    const double h3 = h2 * h;
+
+    const double ax = p2.x() - p1.x() + 3.0 * ( cp1.x() - cp2.x() );
+    const double ay = p2.y() - p1.y() + 3.0 * ( cp1.y() - cp2.y() );
+
+    const double bx = 3.0 * ( p1.x() - 2.0 * cp1.x() + cp2.x() );
+    const double by = 3.0 * ( p1.y() - 2.0 * cp1.y() + cp2.y() );
+
+    const double cx = 3.0 * ( cp1.x() - p1.x() );
+    const double cy = 3.0 * ( cp1.y() - p1.y() );
+
+    double x = p1.x();
+    double y = p1.y();
+
+    double dx = ax * h3 + bx * h2 + cx * h;
+    double dy = ay * h3 + by * h2 + cy * h;
+
+    double ddx = 6.0 * ax * h3 + 2.0 * bx * h2;
+    double ddy = 6.0 * ay * h3 + 2.0 * by * h2;
+
+    const double dddx = 6.0 * ax * h3;
+    const double dddy = 6.0 * ay * h3;
+
+    for ( int i = 1; i < count; i++ )
+    {
+        x += dx;
+        y += dy;
+
+        dx += ddx;
+        dy += ddy;
+
+        ddx += dddx;
+        ddy += dddy;
+
+        *points++ = QPointF( x, y );
+    }
+
+    // avoiding accumulated rounding errors at the end point
+    *points = p2;
+}
+
 namespace
 {
     class BezierData
@@ -225,6 +274,107 @@ void QwtBezier::appendToPolygon( const QPointF& p1, const QPointF& cp1,
 
 }
 
+/*!
+   \brief Number of lines for approximating a Bézier curve
+
+   The number is calculated from the second differences of the
+   control points ( Wang's formula ), so that the distance between
+   the curve and lines, that are equidistant in the parameter,
+   is below the tolerance.
+
+   \param p1 Start point
+   \param cp1 First control point
+   \param cp2 Second control point
+   \param p2 End point
+
+   \return Number of lines, at least 1
+   \sa toPolygon()
+ */
+int QwtBezier::segmentCount( const QPointF& p1, const QPointF& cp1,
+    const QPointF& cp2, const QPointF& p2 ) const
+{
+    // avoiding endless polygons for insane input
+    const int maxCount = 1 << 16;
+
+    if ( m_tolerance <= 0.0 )
+        return maxCount;
+
+    const double dx1 = p1.x() - 2.0 * cp1.x() + cp2.x();
+    const double dy1 = p1.y() - 2.0 * cp1.y() + cp2.y();
+    const double dx2 = cp1.x() - 2.0 * cp2.x() + p2.x();
+    const double dy2 = cp1.y() - 2.0 * cp2.y() + p2.y();
+
+    const double l = std::sqrt( qwtMaxF( dx1 * dx1 + dy1 * dy1, dx2 * dx2 + dy2 * dy2 ) );
+
+    // n = sqrt( d * ( d - 1 ) / 8 * l / tolerance ) for a curve of degree d
+    const double n = std::ceil( std::sqrt( 0.75 * l / m_tolerance ) );
+
+    if ( !( n < maxCount ) ) // also true for NaN
+        return maxCount;
+
+    return qMax( 1, static_cast< int >( n ) );
+}
+
+/*!
+   \brief Interpolate a sequence of Bézier curves by a polygon
+
+   The Bézier curve i starts at points[i], has the control points
+   of controlLines[i] and ends at points[i + 1]. When there are as many
+   control lines as points the last curve ends at points[0] - like
+   for a closed spline.
+
+   In opposite to appendToPolygon() the points are not found by adaptive
+   subdivision but are equidistant in the parameter of each curve.
+   Their number is estimated by segmentCount() in advance, so that
+   the polygon can be allocated once. Usually the number of points is
+   a bit higher, but it is significantly faster for many curves.
+
+   \param points Start/End points of the curves
+   \param controlLines Control points of the curves
+
+   \return Interpolating polygon
+   \sa QwtSplineInterpolating::bezierControlLines(), segmentCount()
+ */
+QPolygonF QwtBezier::toPolygon( const QPolygonF& points,
+    const QVector< QLineF >& controlLines ) const
+{
+    const int numPoints = points.size();
+    const int n = controlLines.size();
+
+    if ( m_flatness <= 0.0 || n <= 0 || n > numPoints )
+        return QPolygonF();
+
+    const QPointF* p = points.constData();
+    const QLineF* cl = controlLines.constData();
+
+    QVector< int > counts( n );
+    int* c = counts.data();
+
+    int numOutput = 1;
+    for ( int i = 0; i < n; i++ )
+    {
+        const QPointF& p2 = p[ ( i + 1 ) % numPoints ];
+
+        c[i] = segmentCount( p[i], cl[i].p1(), cl[i].p2(), p2 );
+        numOutput += c[i];
+    }
+
+    QPolygonF polygon( numOutput );
+    QPointF* out = polygon.data();
+
+    *out++ = p[0];
+
+    for ( int i = 0; i < n; i++ )
+    {
+        const QPointF& p2 = p[ ( i + 1 ) % numPoints ];
+
+        qwtFlatten( p[i], cl[i].p1(), cl[i].p2(), p2, c[i], out );
+        out += c[i];
+    }
+
+    return polygon;
+}
+
 /*!
    Find a point on a Bézier Curve
 
@@ -12,8 +12,11 @@
 
 #include "qwt_global.h"
 
+#include <qvector.h>
+
 class QPointF;
 class QPolygonF;
+class QLineF;
 
 /*!
    \brief An implementation of the de Casteljau’s Algorithm for interpolating
@@ -25,6 +28,12 @@ class QPolygonF;
 
    This article explains the maths behind in a very nice way:
    https://jeremykun.com/2013/05/11/bezier-curves-and-picasso
+
+   For a large number of curves, like the pieces of a spline, the adaptive
+   subdivision is expensive. The batch version of toPolygon() estimates
+   the number of lines for each curve in advance ( Wang's formula )
+   and calculates the points by forward differencing into a
+   polygon, that is allocated once.
  */
 class QWT_EXPORT QwtBezier
 {
@@ -41,6 +50,12 @@ class QWT_EXPORT QwtBezier
     void appendToPolygon( const QPointF& p1, const QPointF& cp1,
         const QPointF& cp2, const QPointF& p2, QPolygonF& polygon ) const;
 
+    QPolygonF toPolygon( const QPolygonF& points,
+        const QVector< QLineF >& controlLines ) const;
+
+    int segmentCount( const QPointF& p1, const QPointF& cp1,
+        const QPointF& cp2, const QPointF& p2 ) const;
+
     static QPointF pointAt( const QPointF& p1, const QPointF& cp1,
         const QPointF& cp2, const QPointF& p2, double t );
 
@@ -0,0 +1,627 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_buffer_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qnumeric.h>
+#include <qrect.h>
+
+namespace
+{
+    class QwtMatrixBuffer
+    {
+      public:
+        QwtMatrixBuffer()
+            : buffer( NULL )
+            , type( QwtBufferRasterData::Double )
+            , numColumns( 0 )
+            , numRows( 0 )
+            , stride( 0 )
+            , scale( 1.0 )
+            , offset( 0.0 )
+            , dx( 0.0 )
+            , dy( 0.0 )
+            , resampleMode( QwtMatrixRasterData::NearestNeighbour )
+        {
+        }
+
+        const void* buffer;
+        QwtBufferRasterData::ValueType type;
+
+        int numColumns;
+        int numRows;
+        int stride;
+
+        double scale;
+        double offset;
+
+        QwtInterval xInterval;
+        QwtInterval yInterval;
+
+        double dx;
+        double dy;
+
+        QwtMatrixRasterData::ResampleMode resampleMode;
+    };
+}
+
+static inline double qwtHermiteInterpolate(
+    double A, double B, double C, double D, double t )
+{
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+
+    const double a = -A / 2.0 + ( 3.0 * B ) / 2.0 - ( 3.0 * C ) / 2.0 + D / 2.0;
+    const double b = A - ( 5.0 * B ) / 2.0 + 2.0 * C - D / 2.0;
+    const double c = -A / 2.0 + C / 2.0;
+    const double d = B;
+
+    return a * t3 + b * t2 + c * t + d;
+}
+
+/*
+    All resampling modes calculate weighted sums, where the
+    weights add up to 1. So the raw values can be interpolated
+    first and scale/offset is applied to the result only.
+ */
+template< typename T >
+static void qwtBufferValues( const QwtMatrixBuffer& m,
+    double y, const double* x, int numValues, double* values )
+{
+    const QwtInterval& xInterval = m.xInterval;
+    const QwtInterval& yInterval = m.yInterval;
+
+    const double x0 = xInterval.minValue();
+    const double dx = m.dx;
+    const int numColumns = m.numColumns;
+    const double scale = m.scale;
+    const double offset = m.offset;
+
+    const T* matrix = static_cast< const T* >( m.buffer );
+
+    switch( m.resampleMode )
+    {
+        case QwtMatrixRasterData::BicubicInterpolation:
+        {
+            const double rowF = ( y - yInterval.minValue() ) / m.dy;
+            const int row = qRound( rowF );
+
+            int rows[4] = { row - 2, row - 1, row, row + 1 };
+
+            if ( rows[1] < 0 )
+                rows[1] = rows[2];
+
+            if ( rows[0] < 0 )
+                rows[0] = rows[1];
+
+            if ( rows[2] >= m.numRows )
+                rows[2] = rows[1];
+
+            if ( rows[3] >= m.numRows )
+                rows[3] = rows[2];
+
+            const T* r0 = matrix + qint64( rows[0] ) * m.stride;
+            const T* r1 = matrix + qint64( rows[1] ) * m.stride;
+            const T* r2 = matrix + qint64( rows[2] ) * m.stride;
+            const T* r3 = matrix + qint64( rows[3] ) * m.stride;
+
+            const double ty = rowF - row + 0.5;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                const double colF = ( x[i] - x0 ) / dx;
+                const int col = qRound( colF );
+
+                int col0 = col - 2;
+                int col1 = col - 1;
+                int col2 = col;
+                int col3 = col + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+
+                if ( col0 < 0 )
+                    col0 = col1;
+
+                if ( col2 >= numColumns )
+                    col2 = col1;
+
+                if ( col3 >= numColumns )
+                    col3 = col2;
+
+                const double tx = colF - col + 0.5;
+
+                const double v0 = qwtHermiteInterpolate(
+                    r0[col0], r0[col1], r0[col2], r0[col3], tx );
+                const double v1 = qwtHermiteInterpolate(
+                    r1[col0], r1[col1], r1[col2], r1[col3], tx );
+                const double v2 = qwtHermiteInterpolate(
+                    r2[col0], r2[col1], r2[col2], r2[col3], tx );
+                const double v3 = qwtHermiteInterpolate(
+                    r3[col0], r3[col1], r3[col2], r3[col3], tx );
+
+                values[i] = scale * qwtHermiteInterpolate( v0, v1, v2, v3, ty ) + offset;
+            }
+
+            break;
+        }
+        case QwtMatrixRasterData::BilinearInterpolation:
+        {
+            int row1 = qRound( ( y - yInterval.minValue() ) / m.dy ) - 1;
+            int row2 = row1 + 1;
+
+            if ( row1 < 0 )
+                row1 = row2;
+            else if ( row2 >= m.numRows )
+                row2 = row1;
+
+            const T* r1 = matrix + qint64( row1 ) * m.stride;
+            const T* r2 = matrix + qint64( row2 ) * m.stride;
+
+            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * m.dy;
+            const double ry = ( y2 - y ) / m.dy;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                int col1 = qRound( ( x[i] - x0 ) / dx ) - 1;
+                int col2 = col1 + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+                else if ( col2 >= numColumns )
+                    col2 = col1;
+
+                const double x2 = x0 + ( col2 + 0.5 ) * dx;
+                const double rx = ( x2 - x[i] ) / dx;
+
+                const double vr1 = rx * r1[col1] + ( 1.0 - rx ) * r1[col2];
+                const double vr2 = rx * r2[col1] + ( 1.0 - rx ) * r2[col2];
+
+                values[i] = scale * ( ry * vr1 + ( 1.0 - ry ) * vr2 ) + offset;
+            }
+
+            break;
+        }
+        case QwtMatrixRasterData::NearestNeighbour:
+        default:
+        {
+            int row = int( ( y - yInterval.minValue() ) / m.dy );
+            if ( row >= m.numRows )
+                row = m.numRows - 1;
+
+            const T* r = matrix + qint64( row ) * m.stride;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                int col = int( ( x[i] - x0 ) / dx );
+                if ( col >= numColumns )
+                    col = numColumns - 1;
+
+                values[i] = scale * r[col] + offset;
+            }
+        }
+    }
+}
+
+class QwtBufferRasterData::PrivateData
+{
+  public:
+    QwtInterval intervals[3];
+    QwtMatrixBuffer matrix;
+};
+
+//! Constructor
+QwtBufferRasterData::QwtBufferRasterData()
+{
+    m_data = new PrivateData();
+    update();
+}
+
+//! Destructor
+QwtBufferRasterData::~QwtBufferRasterData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the resampling algorithm
+
+   \param mode Resampling mode
+   \sa resampleMode(), value()
+ */
+void QwtBufferRasterData::setResampleMode(
+    QwtMatrixRasterData::ResampleMode mode )
+{
+    m_data->matrix.resampleMode = mode;
+}
+
+/*!
+   \return resampling algorithm
+   \sa setResampleMode(), value()
+ */
+QwtMatrixRasterData::ResampleMode QwtBufferRasterData::resampleMode() const
+{
+    return m_data->matrix.resampleMode;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   Setting the bounding intervals for the X/Y axis is mandatory
+   to define the positions for the values of the matrix.
+   The interval in Z direction defines the possible range for
+   the values - after applying scale and offset.
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa QwtRasterData::interval(), setBuffer(), setValueScale()
+ */
+void QwtBufferRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+    {
+        m_data->intervals[axis] = interval;
+        update();
+    }
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval
+ */
+QwtInterval QwtBufferRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Assign a buffer of doubles
+
+   The positions of the values are calculated by dividing
+   the bounding rectangle of the X/Y intervals into equidistant
+   rectangles ( pixels ). Each value corresponds to the center of
+   a pixel.
+
+   \param buffer Buffer with numRows rows of numColumns values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+
+   \note The buffer is not copied and has to stay valid
+
+   \sa buffer(), resetBuffer(), setInterval()
+ */
+void QwtBufferRasterData::setBuffer( const double* buffer,
+    int numColumns, int numRows, int stride )
+{
+    setRawBuffer( buffer, Double, numColumns, numRows, stride );
+}
+
+/*!
+   \brief Assign a buffer of floats
+
+   \param buffer Buffer with numRows rows of numColumns values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+
+   \note The buffer is not copied and has to stay valid
+   \sa setBuffer( const double*, int, int, int )
+ */
+void QwtBufferRasterData::setBuffer( const float* buffer,
+    int numColumns, int numRows, int stride )
+{
+    setRawBuffer( buffer, Float, numColumns, numRows, stride );
+}
+
+/*!
+   \brief Assign a buffer of 16 bit integers
+
+   \param buffer Buffer with numRows rows of numColumns values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+
+   \note The buffer is not copied and has to stay valid
+   \sa setBuffer( const double*, int, int, int )
+ */
+void QwtBufferRasterData::setBuffer( const qint16* buffer,
+    int numColumns, int numRows, int stride )
+{
+    setRawBuffer( buffer, Int16, numColumns, numRows, stride );
+}
+
+/*!
+   \brief Assign a buffer of unsigned 16 bit integers
+
+   \param buffer Buffer with numRows rows of numColumns values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+
+   \note The buffer is not copied and has to stay valid
+   \sa setBuffer( const double*, int, int, int )
+ */
+void QwtBufferRasterData::setBuffer( const quint16* buffer,
+    int numColumns, int numRows, int stride )
+{
+    setRawBuffer( buffer, UInt16, numColumns, numRows, stride );
+}
+
+/*!
+   \brief Assign a buffer of bytes
+
+   \param buffer Buffer with numRows rows of numColumns values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+
+   \note The buffer is not copied and has to stay valid
+   \sa setBuffer( const double*, int, int, int )
+ */
+void QwtBufferRasterData::setBuffer( const quint8* buffer,
+    int numColumns, int numRows, int stride )
+{
+    setRawBuffer( buffer, UInt8, numColumns, numRows, stride );
+}
+
+/*!
+   Detach the buffer
+   \sa setBuffer()
+ */
+void QwtBufferRasterData::resetBuffer()
+{
+    setRawBuffer( NULL, Double, 0, 0, 0 );
+}
+
+/*!
+   \return Buffer, that has been assigned by setBuffer()
+   \sa valueType()
+ */
+const void* QwtBufferRasterData::buffer() const
+{
+    return m_data->matrix.buffer;
+}
+
+/*!
+   \return Type of the values in buffer()
+   \sa setBuffer()
+ */
+QwtBufferRasterData::ValueType QwtBufferRasterData::valueType() const
+{
+    return m_data->matrix.type;
+}
+
+/*!
+   \return Number of columns of the matrix
+   \sa numRows(), stride(), setBuffer()
+ */
+int QwtBufferRasterData::numColumns() const
+{
+    return m_data->matrix.numColumns;
+}
+
+/*!
+   \return Number of rows of the matrix
+   \sa numColumns(), stride(), setBuffer()
+ */
+int QwtBufferRasterData::numRows() const
+{
+    return m_data->matrix.numRows;
+}
+
+/*!
+   \return Number of values between the beginnings of 2 rows
+   \sa numColumns(), setBuffer()
+ */
+int QwtBufferRasterData::stride() const
+{
+    return m_data->matrix.stride;
+}
+
+/*!
+   \brief Set a linear conversion for the values of the buffer
+
+   The value at a position is raw * scale + offset.
+   The default setting is a scale of 1.0 and an offset of 0.0.
+
+   \param scale Scale factor
+   \param offset Offset
+
+   \sa valueScale(), valueOffset()
+ */
+void QwtBufferRasterData::setValueScale( double scale, double offset )
+{
+    m_data->matrix.scale = scale;
+    m_data->matrix.offset = offset;
+}
+
+/*!
+   \return Scale factor for the values of the buffer
+   \sa setValueScale()
+ */
+double QwtBufferRasterData::valueScale() const
+{
+    return m_data->matrix.scale;
+}
+
+/*!
+   \return Offset for the values of the buffer
+   \sa setValueScale()
+ */
+double QwtBufferRasterData::valueOffset() const
+{
+    return m_data->matrix.offset;
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   For NearestNeighbour pixelHint() returns the surrounding pixel
+   of the top left value in the matrix. Otherwise an empty rectangle
+   is returned recommending to render in target device resolution.
+
+   \param area Requested area, ignored
+   \return Calculated hint
+
+   \sa QwtMatrixRasterData::pixelHint()
+ */
+QRectF QwtBufferRasterData::pixelHint( const QRectF& area ) const
+{
+    Q_UNUSED( area )
+
+    const QwtMatrixBuffer& m = m_data->matrix;
+
+    QRectF rect;
+    if ( m.resampleMode == QwtMatrixRasterData::NearestNeighbour )
+    {
+        if ( m.xInterval.isValid() && m.yInterval.isValid() )
+        {
+            rect = QRectF( m.xInterval.minValue(), m.yInterval.minValue(),
+                m.dx, m.dy );
+        }
+    }
+
+    return rect;
+}
+
+/*!
+   \return the value at a raster position
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   \sa values(), QwtMatrixRasterData::ResampleMode
+ */
+double QwtBufferRasterData::value( double x, double y ) const
+{
+    double v;
+    values( y, &x, 1, &v );
+
+    return v;
+}
+
+/*!
+   \brief Values of a row
+
+   The rows of the buffer and the weights in y direction are
+   calculated only once for all positions. The values are read in
+   their original type, what is done in separate loops for each type.
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa value()
+ */
+void QwtBufferRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    const QwtMatrixBuffer& m = m_data->matrix;
+
+    if ( m.buffer == NULL || m.numRows <= 0 || !m.yInterval.contains( y ) )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            values[i] = qQNaN();
+
+        return;
+    }
+
+    switch( m.type )
+    {
+        case Float:
+            qwtBufferValues< float >( m, y, x, numValues, values );
+            break;
+
+        case Int16:
+            qwtBufferValues< qint16 >( m, y, x, numValues, values );
+            break;
+
+        case UInt16:
+            qwtBufferValues< quint16 >( m, y, x, numValues, values );
+            break;
+
+        case UInt8:
+            qwtBufferValues< quint8 >( m, y, x, numValues, values );
+            break;
+
+        case Double:
+        default:
+            qwtBufferValues< double >( m, y, x, numValues, values );
+    }
+}
+
+void QwtBufferRasterData::setRawBuffer( const void* buffer,
+    ValueType type, int numColumns, int numRows, int stride )
+{
+    QwtMatrixBuffer& m = m_data->matrix;
+
+    if ( buffer == NULL || numColumns <= 0 || numRows <= 0 )
+    {
+        buffer = NULL;
+        numColumns = numRows = stride = 0;
+    }
+
+    m.buffer = buffer;
+    m.type = type;
+    m.numColumns = numColumns;
+    m.numRows = numRows;
+    m.stride = qMax( stride, numColumns );
+
+    update();
+}
+
+void QwtBufferRasterData::update()
+{
+    QwtMatrixBuffer& m = m_data->matrix;
+
+    m.xInterval = m_data->intervals[ Qt::XAxis ];
+    m.yInterval = m_data->intervals[ Qt::YAxis ];
+
+    m.dx = 0.0;
+    m.dy = 0.0;
+
+    if ( m.numColumns > 0 && m.numRows > 0 )
+    {
+        if ( m.xInterval.isValid() )
+            m.dx = m.xInterval.width() / m.numColumns;
+        if ( m.yInterval.isValid() )
+            m.dy = m.yInterval.width() / m.numRows;
+    }
+}
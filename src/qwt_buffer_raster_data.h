@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_BUFFER_RASTER_DATA_H
+#define QWT_BUFFER_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+#include "qwt_matrix_raster_data.h"
+
+/*!
+   \brief Raster data, that maps a matrix from an external buffer
+
+   In opposite to QwtMatrixRasterData, that stores the values of the
+   matrix in a QVector<double>, QwtBufferRasterData is a thin wrapper
+   for a buffer, that is owned by the application - f.e. the frame of
+   a detector or a memory mapped file. Nothing is copied and the values
+   remain in their original type: a 16k x 16k matrix of floats needs
+   1 GB instead of the 2 GB of doubles.
+
+   The values are converted on the fly: value = raw * scale + offset.
+   The buffer has to stay valid as long as it is attached to the data
+   object and must not be modified while an image is rendered.
+
+   \sa QwtMatrixRasterData, setBuffer(), setValueScale()
+ */
+class QWT_EXPORT QwtBufferRasterData : public QwtRasterData
+{
+  public:
+    //! Type of the values in the buffer
+    enum ValueType
+    {
+        //! double
+        Double,
+
+        //! float
+        Float,
+
+        //! qint16
+        Int16,
+
+        //! quint16
+        UInt16,
+
+        //! quint8
+        UInt8
+    };
+
+    QwtBufferRasterData();
+    virtual ~QwtBufferRasterData();
+
+    void setResampleMode( QwtMatrixRasterData::ResampleMode );
+    QwtMatrixRasterData::ResampleMode resampleMode() const;
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE QWT_FINAL;
+
+    void setBuffer( const double*, int numColumns, int numRows, int stride = -1 );
+    void setBuffer( const float*, int numColumns, int numRows, int stride = -1 );
+    void setBuffer( const qint16*, int numColumns, int numRows, int stride = -1 );
+    void setBuffer( const quint16*, int numColumns, int numRows, int stride = -1 );
+    void setBuffer( const quint8*, int numColumns, int numRows, int stride = -1 );
+
+    void resetBuffer();
+
+    const void* buffer() const;
+    ValueType valueType() const;
+
+    int numColumns() const;
+    int numRows() const;
+    int stride() const;
+
+    void setValueScale( double scale, double offset = 0.0 );
+    double valueScale() const;
+    double valueOffset() const;
+
+    virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
+
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const QWT_OVERRIDE;
+
+  private:
+    void setRawBuffer( const void*, ValueType,
+        int numColumns, int numRows, int stride );
+
+    void update();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,441 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_cache_registry.h"
+#include "qwt_atomic_p.h"
+
+#include <qobject.h>
+#include <qevent.h>
+#include <qcoreapplication.h>
+#include <qmutex.h>
+#include <qlist.h>
+#include <qpixmap.h>
+#include <qimage.h>
+
+static QAtomicInt qwtCacheTick;
+
+static inline int qwtNextTick()
+{
+    return qwtCacheTick.fetchAndAddRelaxed( 1 ) + 1;
+}
+
+/*
+    Eviction is done in the event loop of the GUI thread, where
+    the caches are not in use - f.e. a backing store, that is
+    reported in the middle of painting into it.
+ */
+class QwtCacheEvictor : public QObject
+{
+  public:
+    static int eventType()
+    {
+        static const int type = QEvent::registerEventType();
+        return type;
+    }
+
+    virtual bool event( QEvent* event ) QWT_OVERRIDE
+    {
+        if ( event->type() == eventType() )
+        {
+            QwtCacheRegistry::evict();
+            return true;
+        }
+
+        return QObject::event( event );
+    }
+};
+
+namespace
+{
+    class RegistryData
+    {
+      public:
+        RegistryData()
+            : budget( 0 )
+            , isEvictionPending( false )
+            , evictor( NULL )
+        {
+            for ( int i = 0; i < QwtCacheRegistry::NumCategories; i++ )
+            {
+                usage[i] = 0;
+                count[i] = 0;
+            }
+        }
+
+        qint64 totalUsage() const
+        {
+            qint64 total = 0;
+            for ( int i = 0; i < QwtCacheRegistry::NumCategories; i++ )
+                total += usage[i];
+
+            return total;
+        }
+
+        bool exceedsBudget() const
+        {
+            return ( budget > 0 ) && ( totalUsage() > budget );
+        }
+
+        QMutex mutex;
+
+        QList< QwtCacheEntry* > entries;
+
+        qint64 usage[QwtCacheRegistry::NumCategories];
+        int count[QwtCacheRegistry::NumCategories];
+
+        qint64 budget;
+        bool isEvictionPending;
+
+        QwtCacheEvictor* evictor;
+    };
+}
+
+static RegistryData* qwtRegistryData()
+{
+    static RegistryData data;
+    return &data;
+}
+
+/*!
+   \brief Set the memory budget for all caches
+
+   When the caches hold more memory than the budget, the least recently
+   used caches are purged in the event loop of the GUI thread.
+
+   \param bytes Budget in bytes, a value <= 0 disables the budget
+   \sa memoryBudget(), memoryUsage()
+   \note The default setting is 0
+ */
+void QwtCacheRegistry::setMemoryBudget( qint64 bytes )
+{
+    RegistryData* data = qwtRegistryData();
+
+    bool exceeds;
+    {
+        QMutexLocker locker( &data->mutex );
+
+        data->budget = qMax( bytes, qint64( 0 ) );
+        exceeds = data->exceedsBudget();
+    }
+
+    if ( exceeds )
+        scheduleEviction();
+}
+
+/*!
+   \return Memory budget for all caches in bytes, 0 means unlimited
+   \sa setMemoryBudget()
+ */
+qint64 QwtCacheRegistry::memoryBudget()
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return data->budget;
+}
+
+//! \return Memory held by all caches in bytes
+qint64 QwtCacheRegistry::memoryUsage()
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return data->totalUsage();
+}
+
+/*!
+   \param category Category of the caches
+   \return Memory held by the caches of a category in bytes
+ */
+qint64 QwtCacheRegistry::memoryUsage( Category category )
+{
+    if ( category < 0 || category >= NumCategories )
+        return 0;
+
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return data->usage[category];
+}
+
+//! \return Number of registered caches
+int QwtCacheRegistry::entryCount()
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return data->entries.size();
+}
+
+/*!
+   \param category Category of the caches
+   \return Number of registered caches of a category
+ */
+int QwtCacheRegistry::entryCount( Category category )
+{
+    if ( category < 0 || category >= NumCategories )
+        return 0;
+
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return data->count[category];
+}
+
+/*!
+   \brief Release all caches
+
+   Applications might call purge() when being notified about
+   low memory by the system.
+
+   \note Needs to be called from the GUI thread
+ */
+void QwtCacheRegistry::purge()
+{
+    for ( int i = 0; i < NumCategories; i++ )
+        purge( static_cast< Category >( i ) );
+}
+
+/*!
+   \brief Release all caches of a category
+
+   \param category Category of the caches
+   \note Needs to be called from the GUI thread
+ */
+void QwtCacheRegistry::purge( Category category )
+{
+    RegistryData* data = qwtRegistryData();
+
+    QList< QwtCacheEntry* > entries;
+    {
+        QMutexLocker locker( &data->mutex );
+
+        // empty entries too: they might be filled by a renderer,
+        // that is stopped when purging another entry
+        for ( int i = 0; i < data->entries.size(); i++ )
+        {
+            if ( data->entries[i]->m_category == category )
+                entries += data->entries[i];
+        }
+    }
+
+    for ( int i = 0; i < entries.size(); i++ )
+        purgeEntry( entries[i] );
+}
+
+/*
+    purge() might wait for threads, that report their memory usage
+    in the meantime - f.e. the tile renderer of QwtPlotRasterItem.
+    So it is called without the registry being locked.
+ */
+void QwtCacheRegistry::purgeEntry( QwtCacheEntry* entry )
+{
+    RegistryData* data = qwtRegistryData();
+
+    {
+        // an entry might have been deleted by purging another one
+        QMutexLocker locker( &data->mutex );
+        if ( !data->entries.contains( entry ) )
+            return;
+    }
+
+    entry->purge();
+
+    QMutexLocker locker( &data->mutex );
+
+    if ( data->entries.contains( entry ) )
+    {
+        data->usage[entry->m_category] -= entry->m_memoryUsage;
+        entry->m_memoryUsage = 0;
+    }
+}
+
+void QwtCacheRegistry::scheduleEviction()
+{
+    QCoreApplication* app = QCoreApplication::instance();
+    if ( app == NULL )
+        return;
+
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+
+    if ( data->isEvictionPending )
+        return;
+
+    if ( data->evictor == NULL )
+    {
+        data->evictor = new QwtCacheEvictor();
+        data->evictor->moveToThread( app->thread() );
+    }
+
+    data->isEvictionPending = true;
+
+    QCoreApplication::postEvent( data->evictor,
+        new QEvent( static_cast< QEvent::Type >( QwtCacheEvictor::eventType() ) ) );
+}
+
+void QwtCacheRegistry::evict()
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+
+    data->isEvictionPending = false;
+
+    const int tick = qwtLoadAcquire( qwtCacheTick );
+
+    // each entry once, even if it is refilled while being purged
+    QList< QwtCacheEntry* > purged;
+
+    while ( data->exceedsBudget() )
+    {
+        QwtCacheEntry* lru = NULL;
+        uint maxAge = 0;
+
+        for ( int i = 0; i < data->entries.size(); i++ )
+        {
+            QwtCacheEntry* entry = data->entries[i];
+            if ( entry->m_memoryUsage <= 0 || purged.contains( entry ) )
+                continue;
+
+            // unsigned differences are robust against an overflow of the tick
+            const uint age = uint( tick ) - uint( qwtLoadAcquire( entry->m_lastUse ) );
+            if ( lru == NULL || age > maxAge )
+            {
+                lru = entry;
+                maxAge = age;
+            }
+        }
+
+        if ( lru == NULL )
+            break;
+
+        purged += lru;
+
+        locker.unlock();
+        purgeEntry( lru );
+        locker.relock();
+    }
+}
+
+/*!
+   \brief Constructor
+
+   The entry is registered in QwtCacheRegistry
+   \param category Category of the cache
+ */
+QwtCacheEntry::QwtCacheEntry( QwtCacheRegistry::Category category )
+    : m_category( category )
+    , m_memoryUsage( 0 )
+    , m_lastUse( qwtNextTick() )
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+
+    data->entries += this;
+    data->count[m_category]++;
+}
+
+//! Destructor, unregistering the entry
+QwtCacheEntry::~QwtCacheEntry()
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+
+    data->entries.removeOne( this );
+    data->count[m_category]--;
+    data->usage[m_category] -= m_memoryUsage;
+}
+
+//! \return Category of the cache
+QwtCacheRegistry::Category QwtCacheEntry::category() const
+{
+    return m_category;
+}
+
+/*!
+   \brief Report the memory held by the cache
+
+   When the caches exceed the budget of the registry, an eviction
+   is scheduled. The entry is marked as being used.
+
+   \param bytes Memory in bytes
+   \sa memoryUsage(), touch()
+ */
+void QwtCacheEntry::setMemoryUsage( qint64 bytes )
+{
+    bytes = qMax( bytes, qint64( 0 ) );
+
+    RegistryData* data = qwtRegistryData();
+
+    bool exceeds;
+    {
+        QMutexLocker locker( &data->mutex );
+
+        data->usage[m_category] += bytes - m_memoryUsage;
+        m_memoryUsage = bytes;
+
+        m_lastUse.fetchAndStoreRelaxed( qwtNextTick() );
+
+        exceeds = data->exceedsBudget();
+    }
+
+    if ( exceeds )
+        QwtCacheRegistry::scheduleEviction();
+}
+
+/*!
+   \return Memory held by the cache in bytes
+   \sa setMemoryUsage()
+ */
+qint64 QwtCacheEntry::memoryUsage() const
+{
+    RegistryData* data = qwtRegistryData();
+
+    QMutexLocker locker( &data->mutex );
+    return m_memoryUsage;
+}
+
+/*!
+   \brief Mark the cache as being used
+
+   touch() is cheap and can be called for each cache hit.
+   The least recently used caches are purged first.
+ */
+void QwtCacheEntry::touch()
+{
+    m_lastUse.fetchAndStoreRelaxed( qwtNextTick() );
+}
+
+/*!
+   \param pixmap Pixmap
+   \return Estimated memory of the pixmap in bytes
+ */
+qint64 QwtCacheEntry::pixmapSize( const QPixmap& pixmap )
+{
+    if ( pixmap.isNull() )
+        return 0;
+
+    return qint64( pixmap.width() ) * pixmap.height() * pixmap.depth() / 8;
+}
+
+/*!
+   \param image Image
+   \return Memory of the image in bytes
+ */
+qint64 QwtCacheEntry::imageSize( const QImage& image )
+{
+    if ( image.isNull() )
+        return 0;
+
+    return qint64( image.bytesPerLine() ) * image.height();
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_CACHE_REGISTRY_H
+#define QWT_CACHE_REGISTRY_H
+
+#include "qwt_global.h"
+#include <qatomic.h>
+
+class QPixmap;
+class QImage;
+
+/*!
+   \brief Accounting and memory budget for the caches of Qwt
+
+   Many classes of Qwt keep pixmaps, images or layout information
+   to avoid expensive recalculations. Each of these caches registers itself
+   - see QwtCacheEntry - and reports the memory it is holding.
+
+   QwtCacheRegistry returns the memory usage of all caches or
+   of the caches of a category. When a memory budget has been set,
+   the least recently used caches are purged, until the total usage
+   fits into the budget again. As caches might be in use while they report
+   their size, purging happens deferred in the event loop of the GUI thread.
+
+   Qt offers no portable notification about a low memory situation.
+   Applications, that receive one from the system, can call purge()
+   to release all caches. The caches are rebuilt, when they are needed again.
+
+   \par Example
+   \code
+   QwtCacheRegistry::setMemoryBudget( 64 * 1024 * 1024 );
+   ...
+   qDebug() << "Symbols:" << QwtCacheRegistry::memoryUsage( QwtCacheRegistry::SymbolCache );
+   \endcode
+   \endpar
+
+   \sa QwtCacheEntry
+ */
+class QWT_EXPORT QwtCacheRegistry
+{
+  public:
+    //! Category of a cache
+    enum Category
+    {
+        //! Backing stores of QwtPlotCanvas
+        BackingStoreCache,
+
+        //! Pixmaps of QwtSymbol
+        SymbolCache,
+
+        //! Images and tiles of QwtPlotRasterItem
+        RasterCache,
+
+        //! Pixmaps of widgets and plot items, like QwtDial or QwtPlotTextLabel
+        PixmapCache,
+
+        //! Tick labels of QwtAbstractScaleDraw
+        LabelCache,
+
+        //! Font and layout information of the text engines
+        TextCache,
+
+        //! Legend icons of QwtPlotCurve
+        LegendCache,
+
+        //! Mapped polylines of QwtPlotCurve
+        PolylineCache,
+
+        //! Number of categories
+        NumCategories
+    };
+
+    static void setMemoryBudget( qint64 bytes );
+    static qint64 memoryBudget();
+
+    static qint64 memoryUsage();
+    static qint64 memoryUsage( Category );
+
+    static int entryCount();
+    static int entryCount( Category );
+
+    static void purge();
+    static void purge( Category );
+
+  private:
+    friend class QwtCacheEntry;
+    friend class QwtCacheEvictor;
+
+    QwtCacheRegistry();
+
+    static void scheduleEviction();
+    static void evict();
+    static void purgeEntry( QwtCacheEntry* );
+};
+
+/*!
+   \brief A cache, that is registered in QwtCacheRegistry
+
+   The owner of a cache embeds an object derived from QwtCacheEntry,
+   reports the memory held by the cache with setMemoryUsage()
+   and marks its use with touch(). purge() is called by
+   QwtCacheRegistry from the GUI thread to release the cache.
+
+   \sa QwtCacheRegistry
+ */
+class QWT_EXPORT QwtCacheEntry
+{
+  public:
+    explicit QwtCacheEntry( QwtCacheRegistry::Category );
+    virtual ~QwtCacheEntry();
+
+    QwtCacheRegistry::Category category() const;
+
+    void setMemoryUsage( qint64 bytes );
+    qint64 memoryUsage() const;
+
+    void touch();
+
+    static qint64 pixmapSize( const QPixmap& );
+    static qint64 imageSize( const QImage& );
+
+  protected:
+    /*!
+       \brief Release the cache
+
+       purge() is called from the GUI thread without the registry being
+       locked, so it might wait for threads, that call setMemoryUsage().
+       The memory usage is reset to 0 by the registry afterwards.
+     */
+    virtual void purge() = 0;
+
+  private:
+    Q_DISABLE_COPY( QwtCacheEntry )
+
+    friend class QwtCacheRegistry;
+
+    const QwtCacheRegistry::Category m_category;
+    qint64 m_memoryUsage;
+    QAtomicInt m_lastUse;
+};
+
+#endif
@@ -11,6 +11,8 @@
 #include "qwt_point_polar.h"
 #include "qwt_interval.h"
 #include "qwt_math.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_render_statistics.h"
 
 #include <qpolygon.h>
 #include <qrect.h>
@@ -141,12 +143,15 @@ class QwtPolygonClipper
 #endif
 
         Polygon points2;
+        QwtScratchPool::acquire( points2, 0 );
         points2.reserve( qMin( 256, points1.size() ) );
 
         clipEdge< LeftEdge< Point, T > >( closePolygon, points1, points2 );
         clipEdge< RightEdge< Point, T > >( closePolygon, points2, points1 );
         clipEdge< TopEdge< Point, T > >( closePolygon, points1, points2 );
         clipEdge< BottomEdge< Point, T > >( closePolygon, points2, points1 );
+
+        QwtScratchPool::release( points2 );
     }
 
   private:
@@ -369,6 +374,8 @@ QVector< QPointF > QwtCircleClipper::cuttingPoints(
 void QwtClipper::clipPolygon(
     const QRectF& clipRect, QPolygon& polygon, bool closePolygon )
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Clipping );
+
     const int minX = qCeil( clipRect.left() );
     const int maxX = qFloor( clipRect.right() );
     const int minY = qCeil( clipRect.top() );
@@ -390,6 +397,8 @@ void QwtClipper::clipPolygon(
 void QwtClipper::clipPolygon(
     const QRect& clipRect, QPolygon& polygon, bool closePolygon )
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Clipping );
+
     QwtPolygonClipper< QPolygon, QRect, int > clipper( clipRect );
     clipper.clipPolygon( polygon, closePolygon );
 }
@@ -404,6 +413,8 @@ void QwtClipper::clipPolygon(
 void QwtClipper::clipPolygonF(
     const QRectF& clipRect, QPolygonF& polygon, bool closePolygon )
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Clipping );
+
     QwtPolygonClipper< QPolygonF, QRectF, double > clipper( clipRect );
     clipper.clipPolygon( polygon, closePolygon );
 }
@@ -461,6 +472,141 @@ QPolygonF QwtClipper::clippedPolygonF(
     return points;
 }
 
+/*!
+   Liang-Barsky line clipping
+
+   \param clipRect Clip rectangle
+   \param p1 Start point of the line IN/OUT
+   \param p2 End point of the line IN/OUT
+
+   \return True, when a part of the line is inside of the clip rectangle.
+           Then p1 and p2 have been moved to the end points of this part.
+ */
+bool QwtClipper::clipLine( const QRectF& clipRect, QPointF& p1, QPointF& p2 )
+{
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] =
+    {
+        p1.x() - clipRect.left(), clipRect.right() - p1.x(),
+        p1.y() - clipRect.top(), clipRect.bottom() - p1.y()
+    };
+
+    double t0 = 0.0;
+    double t1 = 1.0;
+
+    for ( int k = 0; k < 4; k++ )
+    {
+        if ( p[k] == 0.0 )
+        {
+            if ( q[k] < 0.0 )
+                return false;
+        }
+        else
+        {
+            const double r = q[k] / p[k];
+            if ( p[k] < 0.0 )
+            {
+                if ( r > t1 )
+                    return false;
+
+                if ( r > t0 )
+                    t0 = r;
+            }
+            else
+            {
+                if ( r < t0 )
+                    return false;
+
+                if ( r < t1 )
+                    t1 = r;
+            }
+        }
+    }
+
+    const QPointF d( dx, dy );
+
+    if ( t1 < 1.0 )
+        p2 = p1 + t1 * d;
+
+    if ( t0 > 0.0 )
+        p1 = p1 + t0 * d;
+
+    return true;
+}
+
+/*!
+   Polyline clipping
+
+   Sutherland-Hodgman clipping is for closed polygons: parts
+   outside of the clip rectangle are replaced by runs along its border,
+   that become visible, when a polyline is stroked. Here the segments
+   are clipped one by one ( Liang-Barsky ) in a single pass, and the
+   polyline is split into separate parts, whenever it leaves the
+   clip rectangle.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Visible parts of the polyline
+ */
+QVector< QPolygonF > QwtClipper::clippedPolyline(
+    const QRectF& clipRect, const QPolygonF& polyline )
+{
+    return clippedPolyline( clipRect, polyline.constData(), polyline.size() );
+}
+
+/*!
+   Polyline clipping
+
+   \param clipRect Clip rectangle
+   \param points Points of the polyline
+   \param pointCount Number of points
+
+   \return Visible parts of the polyline
+   \sa clipLine()
+ */
+QVector< QPolygonF > QwtClipper::clippedPolyline(
+    const QRectF& clipRect, const QPointF* points, int pointCount )
+{
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Clipping );
+
+    QVector< QPolygonF > parts;
+
+    QPolygonF part;
+
+    for ( int i = 1; i < pointCount; i++ )
+    {
+        QPointF p1 = points[i - 1];
+        QPointF p2 = points[i];
+
+        if ( clipLine( clipRect, p1, p2 ) )
+        {
+            if ( part.isEmpty() )
+                part += p1;
+
+            part += p2;
+
+            if ( p2 == points[i] )
+                continue;
+
+            // leaving the clip rectangle
+        }
+
+        if ( part.size() > 1 )
+            parts += part;
+
+        part.clear();
+    }
+
+    if ( part.size() > 1 )
+        parts += part;
+
+    return parts;
+}
+
 /*!
    Circle clipping
 
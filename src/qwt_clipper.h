@@ -47,6 +47,14 @@ namespace QwtClipper
     QWT_EXPORT QPolygonF clippedPolygonF( const QRectF&,
         const QPolygonF&, bool closePolygon = false );
 
+    QWT_EXPORT bool clipLine( const QRectF&, QPointF& p1, QPointF& p2 );
+
+    QWT_EXPORT QVector< QPolygonF > clippedPolyline(
+        const QRectF&, const QPolygonF& );
+
+    QWT_EXPORT QVector< QPolygonF > clippedPolyline(
+        const QRectF&, const QPointF* points, int pointCount );
+
     QWT_EXPORT QVector< QwtInterval > clipCircle(
         const QRectF&, const QPointF&, double radius );
 };
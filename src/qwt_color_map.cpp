@@ -11,6 +11,10 @@
 #include "qwt_interval.h"
 
 #include <qvector.h>
+#include <qnumeric.h>
+
+#include <algorithm>
+#include <typeinfo>
 
 static inline QRgb qwtHsvToRgb( int h, int s, int v, int a )
 {
@@ -70,6 +74,9 @@ class QwtLinearColorMap::ColorStops
     void insert( double pos, const QColor& color );
     QRgb rgb( QwtLinearColorMap::Mode, double pos ) const;
 
+    void rgbValues( QwtLinearColorMap::Mode, const QwtInterval&,
+        const double* values, QRgb* rgbs, int numValues ) const;
+
     QVector< double > stops() const;
 
   private:
@@ -127,6 +134,8 @@ class QwtLinearColorMap::ColorStops
     };
 
     inline int findUpper( double pos ) const;
+    inline QRgb interpolate( QwtLinearColorMap::Mode, int index, double pos ) const;
+
     QVector< ColorStop > m_stops;
     bool m_doAlpha;
 };
@@ -208,7 +217,12 @@ inline QRgb QwtLinearColorMap::ColorStops::rgb(
     if ( pos >= 1.0 )
         return m_stops[ m_stops.size() - 1 ].rgb;
 
-    const int index = findUpper( pos );
+    return interpolate( mode, findUpper( pos ), pos );
+}
+
+inline QRgb QwtLinearColorMap::ColorStops::interpolate(
+    QwtLinearColorMap::Mode mode, int index, double pos ) const
+{
     if ( mode == FixedColors )
     {
         return m_stops[index - 1].rgb;
@@ -242,6 +256,53 @@ inline QRgb QwtLinearColorMap::ColorStops::rgb(
     }
 }
 
+void QwtLinearColorMap::ColorStops::rgbValues(
+    QwtLinearColorMap::Mode mode, const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    const double minValue = interval.minValue();
+    const double width = interval.width();
+
+    const ColorStop* stops = m_stops.constData();
+
+    const QRgb rgbMin = stops[0].rgb;
+    const QRgb rgbMax = stops[ m_stops.size() - 1 ].rgb;
+
+    // neighboured values are often between the same color stops,
+    // so the binary search is only done when leaving the section
+
+    int index = 1;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+
+        if ( qIsNaN( value ) )
+        {
+            rgbs[i] = 0u;
+            continue;
+        }
+
+        const double pos = ( value - minValue ) / width;
+
+        if ( pos <= 0.0 )
+        {
+            rgbs[i] = rgbMin;
+        }
+        else if ( pos >= 1.0 )
+        {
+            rgbs[i] = rgbMax;
+        }
+        else
+        {
+            if ( pos < stops[index - 1].pos || pos >= stops[index].pos )
+                index = findUpper( pos );
+
+            rgbs[i] = interpolate( mode, index, pos );
+        }
+    }
+}
+
 /*!
    Constructor
    \param format Format of the color map
@@ -293,6 +354,56 @@ uint QwtColorMap::colorIndex( int numColors,
     return static_cast< unsigned int >( v + 0.5 );
 }
 
+/*!
+   \brief Map an array of values of a given interval into RGB values
+
+   The default implementation calls rgb() for each value. Color maps,
+   where the mapping can be done faster for many values - f.e. by
+   precalculating everything, that depends on the interval only -
+   should overload rgbValues().
+
+   \param interval Range for all values
+   \param values Values to map into RGB values
+   \param rgbs Array for the RGB values
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0 ( transparent )
+   \sa rgb(), colorIndices()
+ */
+void QwtColorMap::rgbValues( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        rgbs[i] = qIsNaN( value ) ? 0u : rgb( interval, value );
+    }
+}
+
+/*!
+   \brief Map an array of values of a given interval into color indices
+
+   The default implementation calls colorIndex() for each value.
+
+   \param numColors Number of colors
+   \param interval Range for all values
+   \param values Values to map into color indices
+   \param indices Array for the color indices
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0
+   \sa colorIndex(), rgbValues()
+ */
+void QwtColorMap::colorIndices( int numColors, const QwtInterval& interval,
+    const double* values, uint* indices, int numValues ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        indices[i] = qIsNaN( value ) ? 0u : colorIndex( numColors, interval, value );
+    }
+}
+
 /*!
    Build and return a color map of 256 colors
 
@@ -508,6 +619,80 @@ uint QwtLinearColorMap::colorIndex( int numColors,
     return static_cast< unsigned int >( ( m_data->mode == FixedColors ) ? v : v + 0.5 );
 }
 
+/*!
+   \brief Map an array of values of a given interval into RGB values
+
+   The interval is checked only once and the color stops are searched
+   only, when a value is in another section of the color stops than
+   its predecessor.
+
+   \param interval Range for all values
+   \param values Values to map into RGB values
+   \param rgbs Array for the RGB values
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0 ( transparent )
+ */
+void QwtLinearColorMap::rgbValues( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    if ( interval.width() <= 0.0 )
+    {
+        std::fill( rgbs, rgbs + numValues, 0u );
+        return;
+    }
+
+    m_data->colorStops.rgbValues( m_data->mode,
+        interval, values, rgbs, numValues );
+}
+
+/*!
+   \brief Map an array of values of a given interval into color indices
+
+   \param numColors Size of the color table
+   \param interval Range for all values
+   \param values Values to map into color indices
+   \param indices Array for the color indices
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0
+ */
+void QwtLinearColorMap::colorIndices( int numColors, const QwtInterval& interval,
+    const double* values, uint* indices, int numValues ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        std::fill( indices, indices + numValues, 0u );
+        return;
+    }
+
+    const double minValue = interval.minValue();
+    const double maxValue = interval.maxValue();
+
+    const uint maxIndex = numColors - 1;
+    const double rounding = ( m_data->mode == FixedColors ) ? 0.0 : 0.5;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+
+        if ( qIsNaN( value ) || value <= minValue )
+        {
+            indices[i] = 0;
+        }
+        else if ( value >= maxValue )
+        {
+            indices[i] = maxIndex;
+        }
+        else
+        {
+            const double v = ( numColors - 1 ) * ( value - minValue ) / width;
+            indices[i] = static_cast< unsigned int >( v + rounding );
+        }
+    }
+}
+
 class QwtAlphaColorMap::PrivateData
 {
   public:
@@ -637,6 +822,61 @@ QRgb QwtAlphaColorMap::rgb( const QwtInterval& interval, double value ) const
     return m_data->rgb | ( alpha << 24 );
 }
 
+/*!
+   \brief Map an array of values of a given interval into RGB values
+
+   \param interval Range for all values
+   \param values Values to map into RGB values
+   \param rgbs Array for the RGB values
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0 ( transparent )
+ */
+void QwtAlphaColorMap::rgbValues( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        std::fill( rgbs, rgbs + numValues, 0u );
+        return;
+    }
+
+    const double minValue = interval.minValue();
+    const double maxValue = interval.maxValue();
+
+    const QRgb rgb = m_data->rgb;
+    const QRgb rgbMax = m_data->rgbMax;
+
+    const int alpha1 = m_data->alpha1;
+    const int alphaStep = m_data->alpha2 - m_data->alpha1;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+
+        if ( qIsNaN( value ) )
+        {
+            rgbs[i] = 0u;
+        }
+        else if ( value <= minValue )
+        {
+            rgbs[i] = rgb;
+        }
+        else if ( value >= maxValue )
+        {
+            rgbs[i] = rgbMax;
+        }
+        else
+        {
+            const double ratio = ( value - minValue ) / width;
+            const int alpha = alpha1 + qRound( ratio * alphaStep );
+
+            rgbs[i] = rgb | ( alpha << 24 );
+        }
+    }
+}
+
 class QwtHueColorMap::PrivateData
 {
   public:
@@ -892,6 +1132,63 @@ QRgb QwtHueColorMap::rgb( const QwtInterval& interval, double value ) const
     return m_data->rgbTable[hue];
 }
 
+/*!
+   \brief Map an array of values of a given interval into RGB values
+
+   \param interval Range for all values
+   \param values Values to map into RGB values
+   \param rgbs Array for the RGB values
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0 ( transparent )
+ */
+void QwtHueColorMap::rgbValues( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    const double width = interval.width();
+    if ( width <= 0 )
+    {
+        std::fill( rgbs, rgbs + numValues, 0u );
+        return;
+    }
+
+    const double minValue = interval.minValue();
+    const double maxValue = interval.maxValue();
+
+    const QRgb* rgbTable = m_data->rgbTable;
+
+    const int hue1 = m_data->hue1;
+    const int hueStep = m_data->hue2 - m_data->hue1;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+
+        if ( qIsNaN( value ) )
+        {
+            rgbs[i] = 0u;
+        }
+        else if ( value <= minValue )
+        {
+            rgbs[i] = m_data->rgbMin;
+        }
+        else if ( value >= maxValue )
+        {
+            rgbs[i] = m_data->rgbMax;
+        }
+        else
+        {
+            const double ratio = ( value - minValue ) / width;
+
+            int hue = hue1 + qRound( ratio * hueStep );
+            if ( hue >= 360 )
+                hue %= 360;
+
+            rgbs[i] = rgbTable[hue];
+        }
+    }
+}
+
 class QwtSaturationValueColorMap::PrivateData
 {
   public:
@@ -1201,3 +1498,197 @@ QRgb QwtSaturationValueColorMap::rgb(
         }
     }
 }
+
+/*!
+   \brief Map an array of values of a given interval into RGB values
+
+   \param interval Range for all values
+   \param values Values to map into RGB values
+   \param rgbs Array for the RGB values
+   \param numValues Number of values
+
+   \note NaN values are mapped to 0 ( transparent )
+ */
+void QwtSaturationValueColorMap::rgbValues( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int numValues ) const
+{
+    const double width = interval.width();
+    if ( width <= 0 )
+    {
+        std::fill( rgbs, rgbs + numValues, 0u );
+        return;
+    }
+
+    const double minValue = interval.minValue();
+    const double maxValue = interval.maxValue();
+
+    const QRgb* rgbTable = m_data->rgbTable.constData();
+
+    int index1, index2;
+    switch( m_data->tableType )
+    {
+        case PrivateData::Saturation:
+        {
+            index1 = m_data->sat1;
+            index2 = m_data->sat2;
+            break;
+        }
+        case PrivateData::Value:
+        {
+            index1 = m_data->value1;
+            index2 = m_data->value2;
+            break;
+        }
+        default:
+        {
+            // saturation and value are varying
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                const double value = values[i];
+                rgbs[i] = qIsNaN( value )
+                    ? 0u : QwtSaturationValueColorMap::rgb( interval, value );
+            }
+            return;
+        }
+    }
+
+    const int step = index2 - index1;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+
+        if ( qIsNaN( value ) )
+        {
+            rgbs[i] = 0u;
+        }
+        else if ( value <= minValue )
+        {
+            rgbs[i] = rgbTable[index1];
+        }
+        else if ( value >= maxValue )
+        {
+            rgbs[i] = rgbTable[index2];
+        }
+        else
+        {
+            const double ratio = ( value - minValue ) / width;
+            rgbs[i] = rgbTable[ index1 + qRound( ratio * step ) ];
+        }
+    }
+}
+
+//! Constructor
+QwtColorLookupTable::QwtColorLookupTable()
+    : m_minValue( 0.0 )
+    , m_maxValue( 0.0 )
+    , m_factor( 0.0 )
+    , m_offset( 0.0 )
+    , m_rounding( 0.5 )
+{
+}
+
+/*!
+   \brief Check if a color map can be replaced by a lookup table
+
+   Only the color maps of Qwt are known to map values according to
+   their relative position in the interval. For other color maps - including
+   classes derived from the color maps of Qwt, that might
+   have overloaded rgb() - the lookup table might give different results.
+
+   \param colorMap Color map
+   \return true, when colorMap has the format QwtColorMap::RGB and
+           is one of the color maps of Qwt
+ */
+bool QwtColorLookupTable::isSupported( const QwtColorMap* colorMap )
+{
+    if ( colorMap == NULL || colorMap->format() != QwtColorMap::RGB )
+        return false;
+
+    // subclasses might override rgb(): exact types only
+
+    const std::type_info& info = typeid( *colorMap );
+
+    return info == typeid( QwtLinearColorMap )
+        || info == typeid( QwtAlphaColorMap )
+        || info == typeid( QwtHueColorMap )
+        || info == typeid( QwtSaturationValueColorMap );
+}
+
+/*!
+   \brief Calculate the colors of the table
+
+   \param colorMap Color map
+   \param numColors Number of colors, must be > 1
+
+   \sa QwtColorMap::colorTable(), reset()
+ */
+void QwtColorLookupTable::setColorMap(
+    const QwtColorMap* colorMap, int numColors )
+{
+    if ( colorMap == NULL || numColors < 2 )
+    {
+        reset();
+        return;
+    }
+
+    m_table = colorMap->colorTable( numColors );
+
+    // QwtLinearColorMap::colorIndex() doesn't round for FixedColors
+
+    m_rounding = 0.5;
+
+    const QwtLinearColorMap* linearMap =
+        dynamic_cast< const QwtLinearColorMap* >( colorMap );
+
+    if ( linearMap && linearMap->mode() == QwtLinearColorMap::FixedColors )
+        m_rounding = 0.0;
+}
+
+//! Remove all colors
+void QwtColorLookupTable::reset()
+{
+    m_table.clear();
+}
+
+//! \return true, when the table has no colors
+bool QwtColorLookupTable::isNull() const
+{
+    return m_table.isEmpty();
+}
+
+//! \return Number of colors
+int QwtColorLookupTable::size() const
+{
+    return m_table.size();
+}
+
+/*!
+   \brief Set the interval of the values to be mapped
+
+   Values below/above the interval are mapped to the first/last color.
+   For an interval with a width of 0 all values are mapped to 0.
+
+   \param interval Interval of the values
+ */
+void QwtColorLookupTable::setInterval( const QwtInterval& interval )
+{
+    const double width = interval.width();
+
+    if ( width > 0.0 )
+    {
+        m_minValue = interval.minValue();
+        m_maxValue = interval.maxValue();
+        m_factor = ( m_table.size() - 1 ) / width;
+    }
+    else
+    {
+        // like QwtColorMap::rgb(): 0 for all values, see rgb()
+
+        m_minValue = m_maxValue = qQNaN();
+        m_factor = 0.0;
+    }
+
+    m_offset = m_rounding - m_minValue * m_factor;
+}
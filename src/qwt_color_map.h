@@ -12,13 +12,10 @@
 
 #include "qwt_global.h"
 #include <qcolor.h>
+#include <qvector.h>
 
 class QwtInterval;
 
-#if QT_VERSION < 0x060000
-template< typename T > class QVector;
-#endif
-
 /*!
    \brief QwtColorMap is used to map values into colors.
 
@@ -78,6 +75,12 @@ class QWT_EXPORT QwtColorMap
     virtual uint colorIndex( int numColors,
         const QwtInterval& interval, double value ) const;
 
+    virtual void rgbValues( const QwtInterval&, const double* values,
+        QRgb* rgbs, int numValues ) const;
+
+    virtual void colorIndices( int numColors, const QwtInterval&,
+        const double* values, uint* indices, int numValues ) const;
+
     QColor color( const QwtInterval&, double value ) const;
     virtual QVector< QRgb > colorTable( int numColors ) const;
     virtual QVector< QRgb > colorTable256() const;
@@ -134,6 +137,12 @@ class QWT_EXPORT QwtLinearColorMap : public QwtColorMap
     virtual uint colorIndex( int numColors,
         const QwtInterval&, double value ) const QWT_OVERRIDE;
 
+    virtual void rgbValues( const QwtInterval&, const double* values,
+        QRgb* rgbs, int numValues ) const QWT_OVERRIDE;
+
+    virtual void colorIndices( int numColors, const QwtInterval&,
+        const double* values, uint* indices, int numValues ) const QWT_OVERRIDE;
+
     class ColorStops;
 
   private:
@@ -161,6 +170,9 @@ class QWT_EXPORT QwtAlphaColorMap : public QwtColorMap
     virtual QRgb rgb( const QwtInterval&,
         double value ) const QWT_OVERRIDE;
 
+    virtual void rgbValues( const QwtInterval&, const double* values,
+        QRgb* rgbs, int numValues ) const QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -197,6 +209,9 @@ class QWT_EXPORT QwtHueColorMap : public QwtColorMap
     virtual QRgb rgb( const QwtInterval&,
         double value ) const QWT_OVERRIDE;
 
+    virtual void rgbValues( const QwtInterval&, const double* values,
+        QRgb* rgbs, int numValues ) const QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -232,11 +247,82 @@ class QWT_EXPORT QwtSaturationValueColorMap : public QwtColorMap
     virtual QRgb rgb( const QwtInterval&,
         double value ) const QWT_OVERRIDE;
 
+    virtual void rgbValues( const QwtInterval&, const double* values,
+        QRgb* rgbs, int numValues ) const QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
 };
 
+/*!
+   \brief A lookup table for mapping values into colors
+
+   QwtColorLookupTable precalculates the colors of a color map, so that
+   mapping a value is a single table lookup without any virtual call.
+   It is used by QwtPlotSpectrogram and QwtPolarSpectrogram, where
+   the color map is called for each pixel of the image.
+
+   As the colors are calculated for equidistant positions of the
+   interval only color maps can be used, where the color depends
+   on the relative position of the value in the interval.
+   This is true for all color maps of Qwt.
+
+   \sa isSupported(), QwtColorMap::colorTable()
+ */
+class QWT_EXPORT QwtColorLookupTable
+{
+  public:
+    QwtColorLookupTable();
+
+    static bool isSupported( const QwtColorMap* );
+
+    void setColorMap( const QwtColorMap*, int numColors );
+    void reset();
+
+    bool isNull() const;
+    int size() const;
+
+    void setInterval( const QwtInterval& );
+
+    QRgb rgb( double value ) const;
+
+  private:
+    QVector< QRgb > m_table;
+
+    double m_minValue;
+    double m_maxValue;
+    double m_factor;
+    double m_offset;
+    double m_rounding;
+};
+
+/*!
+   Map a value into a color
+
+   The result is the same as QwtColorMap::colorTable()[ colorIndex() ]
+   for the interval, that has been set by setInterval().
+
+   \param value Value
+   \return RGB value, corresponding to value. NaN - and all values for
+            an invalid interval - are mapped to 0 like in QwtColorMap::rgb().
+ */
+inline QRgb QwtColorLookupTable::rgb( double value ) const
+{
+    const QRgb* table = m_table.constData();
+
+    if ( !( value > m_minValue ) )
+    {
+        // fails for NaN and for an invalid interval as well
+        return ( value <= m_minValue ) ? table[0] : 0u;
+    }
+
+    if ( value >= m_maxValue )
+        return table[ m_table.size() - 1 ];
+
+    return table[ static_cast< int >( value * m_factor + m_offset ) ];
+}
+
 /*!
    Map a value into a color
 
@@ -13,6 +13,7 @@
 
 #include <qpainter.h>
 #include <qpalette.h>
+#include <qvector.h>
 
 static void qwtDrawBox( QPainter* p, const QRectF& rect,
     const QPalette& pal, double lw )
@@ -253,6 +254,93 @@ void QwtColumnSymbol::draw( QPainter* painter,
     painter->restore();
 }
 
+/*!
+   \brief Draw many bars at once
+
+   For a symbol of QwtColumnSymbol::Box style without a
+   QwtColumnSymbol::Raised frame the bars are painted like drawBox(),
+   but with one call of QPainter::drawRects() for all frames and one
+   for all interiors. Otherwise they are painted one by one.
+
+   As the bars are not directed the virtual draw() is not called.
+
+   \param painter Painter
+   \param rects Rectangles of the bars, already aligned
+                like in drawBox()
+   \param numRects Number of rectangles
+
+   \sa draw()
+ */
+void QwtColumnSymbol::drawBoxes( QPainter* painter,
+    const QRectF* rects, int numRects ) const
+{
+    if ( m_data->style != QwtColumnSymbol::Box || numRects <= 0 )
+        return;
+
+    painter->save();
+
+    if ( m_data->frameStyle == QwtColumnSymbol::Raised )
+    {
+        for ( int i = 0; i < numRects; i++ )
+        {
+            qwtDrawPanel( painter, rects[i],
+                m_data->palette, m_data->lineWidth );
+        }
+
+        painter->restore();
+        return;
+    }
+
+    double lineWidth = 0.0;
+    if ( m_data->frameStyle == QwtColumnSymbol::Plain )
+        lineWidth = m_data->lineWidth;
+
+    QVector< QRectF > frames;
+    if ( lineWidth > 0.0 )
+        frames.reserve( numRects );
+
+    QVector< QRectF > windows;
+    windows.reserve( numRects );
+
+    for ( int i = 0; i < numRects; i++ )
+    {
+        const QRectF& r = rects[i];
+
+        double lw = lineWidth;
+        if ( lw > 0.0 )
+        {
+            if ( r.width() == 0.0 || r.height() == 0.0 )
+            {
+                frames += r.adjusted( 0, 0, 1, 1 );
+                continue;
+            }
+
+            lw = qwtMinF( lw, r.height() / 2.0 - 1.0 );
+            lw = qwtMinF( lw, r.width() / 2.0 - 1.0 );
+
+            if ( lw > 0.0 )
+                frames += r.adjusted( 0, 0, 1, 1 );
+        }
+
+        const QRectF windowRect = r.adjusted( lw, lw, -lw + 1, -lw + 1 );
+        if ( windowRect.isValid() )
+            windows += windowRect;
+    }
+
+    painter->setPen( Qt::NoPen );
+
+    if ( !frames.isEmpty() )
+    {
+        painter->setBrush( m_data->palette.dark() );
+        QwtPainter::drawRects( painter, frames.constData(), frames.size() );
+    }
+
+    painter->setBrush( m_data->palette.window() );
+    QwtPainter::drawRects( painter, windows.constData(), windows.size() );
+
+    painter->restore();
+}
+
 /*!
    Draw the symbol when it is in Box style.
 
@@ -131,6 +131,8 @@ class QWT_EXPORT QwtColumnSymbol
 
     virtual void draw( QPainter*, const QwtColumnRect& ) const;
 
+    void drawBoxes( QPainter*, const QRectF* rects, int numRects ) const;
+
   protected:
     void drawBox( QPainter*, const QwtColumnRect& ) const;
 
@@ -12,6 +12,7 @@
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qvector.h>
 
 static QPointF qwtIntersection(
     QPointF p11, QPointF p12, QPointF p21, QPointF p22 )
@@ -30,6 +31,104 @@ static QPointF qwtIntersection(
     return pos;
 }
 
+/*
+    The thorns of a level are collected in a dark and a light path,
+    with north at 0 degrees. As the thorns of the higher levels
+    are painted on top, each level has its own pair of paths.
+ */
+static QVector< QPainterPath > qwtRosePaths( double radius, double width,
+    int numThorns, int numThornLevels, double shrinkFactor )
+{
+    QVector< QPainterPath > paths;
+
+    if ( numThorns < 4 )
+        numThorns = 4;
+
+    if ( numThorns % 4 )
+        numThorns += 4 - numThorns % 4;
+
+    if ( numThornLevels <= 0 )
+        numThornLevels = numThorns / 4;
+
+    if ( shrinkFactor >= 1.0 )
+        shrinkFactor = 1.0;
+
+    if ( shrinkFactor <= 0.5 )
+        shrinkFactor = 0.5;
+
+    const QPointF center( 0.0, 0.0 );
+
+    for ( int j = 1; j <= numThornLevels; j++ )
+    {
+        double step = std::pow( 2.0, j ) * M_PI / numThorns;
+        if ( step > M_PI_2 )
+            break;
+
+        double r = radius;
+        for ( int k = 0; k < 3; k++ )
+        {
+            if ( j + k < numThornLevels )
+                r *= shrinkFactor;
+        }
+
+        double leafWidth = r * width;
+        if ( 2.0 * M_PI / step > 32 )
+            leafWidth = 16;
+
+        QPainterPath darkPath;
+        darkPath.setFillRule( Qt::WindingFill );
+
+        QPainterPath lightPath;
+        lightPath.setFillRule( Qt::WindingFill );
+
+        for ( double angle = 0.0; angle < 2.0 * M_PI; angle += step )
+        {
+            const QPointF p = qwtPolar2Pos( center, r, angle );
+            const QPointF p1 = qwtPolar2Pos( center, leafWidth, angle + M_PI_2 );
+            const QPointF p2 = qwtPolar2Pos( center, leafWidth, angle - M_PI_2 );
+            const QPointF p3 = qwtPolar2Pos( center, r, angle + step / 2.0 );
+            const QPointF p4 = qwtPolar2Pos( center, r, angle - step / 2.0 );
+
+            darkPath.moveTo( center );
+            darkPath.lineTo( p );
+            darkPath.lineTo( qwtIntersection( center, p3, p1, p ) );
+            darkPath.closeSubpath();
+
+            lightPath.moveTo( center );
+            lightPath.lineTo( p );
+            lightPath.lineTo( qwtIntersection( center, p4, p2, p ) );
+            lightPath.closeSubpath();
+        }
+
+        paths += darkPath;
+        paths += lightPath;
+    }
+
+    return paths;
+}
+
+static void qwtDrawRosePaths( QPainter* painter, const QPalette& palette,
+    const QPointF& center, double north, const QVector< QPainterPath >& paths )
+{
+    painter->save();
+
+    painter->setPen( Qt::NoPen );
+
+    painter->translate( center );
+    painter->rotate( -north );
+
+    for ( int i = 0; i + 1 < paths.size(); i += 2 )
+    {
+        painter->setBrush( palette.brush( QPalette::Dark ) );
+        painter->drawPath( paths[i] );
+
+        painter->setBrush( palette.brush( QPalette::Light ) );
+        painter->drawPath( paths[i + 1] );
+    }
+
+    painter->restore();
+}
+
 //! Constructor
 QwtCompassRose::QwtCompassRose()
 {
@@ -60,13 +159,23 @@ class QwtSimpleCompassRose::PrivateData
         , numThorns( 8 )
         , numThornLevels( -1 )
         , shrinkFactor( 0.9 )
+        , cacheRadius( -1.0 )
     {
     }
 
+    void invalidateCache()
+    {
+        cacheRadius = -1.0;
+    }
+
     double width;
     int numThorns;
     int numThornLevels;
     double shrinkFactor;
+
+    // the thorns are independent of north and the center
+    mutable double cacheRadius;
+    mutable QVector< QPainterPath > paths;
 };
 
 /*!
@@ -108,6 +217,7 @@ QwtSimpleCompassRose::~QwtSimpleCompassRose()
 void QwtSimpleCompassRose::setShrinkFactor( double factor )
 {
     m_data->shrinkFactor = factor;
+    m_data->invalidateCache();
 }
 
 /*!
@@ -134,8 +244,18 @@ void QwtSimpleCompassRose::draw( QPainter* painter, const QPointF& center,
     QPalette pal = palette();
     pal.setCurrentColorGroup( cg );
 
-    drawRose( painter, pal, center, radius, north, m_data->width,
-        m_data->numThorns, m_data->numThornLevels, m_data->shrinkFactor );
+    if ( radius != m_data->cacheRadius )
+    {
+        // the paths are reused, as long as the geometry
+        // of the rose doesn't change - f.e. for rotations
+
+        m_data->paths = qwtRosePaths( radius, m_data->width,
+            m_data->numThorns, m_data->numThornLevels, m_data->shrinkFactor );
+
+        m_data->cacheRadius = radius;
+    }
+
+    qwtDrawRosePaths( painter, pal, center, north, m_data->paths );
 }
 
 /*!
@@ -157,70 +277,10 @@ void QwtSimpleCompassRose::drawRose(
     const QPointF& center, double radius, double north, double width,
     int numThorns, int numThornLevels, double shrinkFactor )
 {
-    if ( numThorns < 4 )
-        numThorns = 4;
-
-    if ( numThorns % 4 )
-        numThorns += 4 - numThorns % 4;
-
-    if ( numThornLevels <= 0 )
-        numThornLevels = numThorns / 4;
-
-    if ( shrinkFactor >= 1.0 )
-        shrinkFactor = 1.0;
-
-    if ( shrinkFactor <= 0.5 )
-        shrinkFactor = 0.5;
-
-    painter->save();
-
-    painter->setPen( Qt::NoPen );
-
-    for ( int j = 1; j <= numThornLevels; j++ )
-    {
-        double step = std::pow( 2.0, j ) * M_PI / numThorns;
-        if ( step > M_PI_2 )
-            break;
-
-        double r = radius;
-        for ( int k = 0; k < 3; k++ )
-        {
-            if ( j + k < numThornLevels )
-                r *= shrinkFactor;
-        }
-
-        double leafWidth = r * width;
-        if ( 2.0 * M_PI / step > 32 )
-            leafWidth = 16;
-
-        const double origin = qwtRadians( north );
-        for ( double angle = origin;
-            angle < 2.0 * M_PI + origin; angle += step )
-        {
-            const QPointF p = qwtPolar2Pos( center, r, angle );
-            const QPointF p1 = qwtPolar2Pos( center, leafWidth, angle + M_PI_2 );
-            const QPointF p2 = qwtPolar2Pos( center, leafWidth, angle - M_PI_2 );
-            const QPointF p3 = qwtPolar2Pos( center, r, angle + step / 2.0 );
-            const QPointF p4 = qwtPolar2Pos( center, r, angle - step / 2.0 );
-
-            QPainterPath darkPath;
-            darkPath.moveTo( center );
-            darkPath.lineTo( p );
-            darkPath.lineTo( qwtIntersection( center, p3, p1, p ) );
-
-            painter->setBrush( palette.brush( QPalette::Dark ) );
-            painter->drawPath( darkPath );
+    const QVector< QPainterPath > paths = qwtRosePaths(
+        radius, width, numThorns, numThornLevels, shrinkFactor );
 
-            QPainterPath lightPath;
-            lightPath.moveTo( center );
-            lightPath.lineTo( p );
-            lightPath.lineTo( qwtIntersection( center, p4, p2, p ) );
-
-            painter->setBrush( palette.brush( QPalette::Light ) );
-            painter->drawPath( lightPath );
-        }
-    }
-    painter->restore();
+    qwtDrawRosePaths( painter, palette, center, north, paths );
 }
 
 /*!
@@ -237,6 +297,8 @@ void QwtSimpleCompassRose::setWidth( double width )
 
     if ( m_data->width > 0.4 )
         m_data->width = 0.4;
+
+    m_data->invalidateCache();
 }
 
 /*!
@@ -264,6 +326,7 @@ void QwtSimpleCompassRose::setNumThorns( int numThorns )
         numThorns += 4 - numThorns % 4;
 
     m_data->numThorns = numThorns;
+    m_data->invalidateCache();
 }
 
 /*!
@@ -284,6 +347,7 @@ int QwtSimpleCompassRose::numThorns() const
 void QwtSimpleCompassRose::setNumThornLevels( int numThornLevels )
 {
     m_data->numThornLevels = numThornLevels;
+    m_data->invalidateCache();
 }
 
 /*!
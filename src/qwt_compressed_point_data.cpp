@@ -0,0 +1,678 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_compressed_point_data.h"
+
+#include <qmutex.h>
+#include <cstring>
+
+namespace
+{
+    // a stream of bits, written and read from the most significant bit
+
+    class QwtBitWriter
+    {
+      public:
+        explicit QwtBitWriter( QVector< quint64 >& words )
+            : m_words( words )
+            , m_numBits( 0 )
+        {
+        }
+
+        void write( quint64 value, int numBits )
+        {
+            if ( numBits < 64 )
+                value &= ( Q_UINT64_C( 1 ) << numBits ) - 1;
+
+            const int used = m_numBits & 63;
+            if ( used == 0 )
+                m_words += 0;
+
+            const int available = 64 - used;
+            if ( numBits <= available )
+            {
+                m_words.last() |= value << ( available - numBits );
+            }
+            else
+            {
+                const int rest = numBits - available;
+
+                m_words.last() |= value >> rest;
+                m_words += value << ( 64 - rest );
+            }
+
+            m_numBits += numBits;
+        }
+
+      private:
+        QVector< quint64 >& m_words;
+        qint64 m_numBits;
+    };
+
+    class QwtBitReader
+    {
+      public:
+        explicit QwtBitReader( const quint64* words )
+            : m_words( words )
+            , m_pos( 0 )
+        {
+        }
+
+        quint64 read( int numBits )
+        {
+            const int used = int( m_pos & 63 );
+            const int available = 64 - used;
+            const quint64 word = m_words[ m_pos >> 6 ] << used;
+
+            quint64 value;
+            if ( numBits <= available )
+            {
+                value = word >> ( 64 - numBits );
+            }
+            else
+            {
+                const int rest = numBits - available;
+
+                value = ( word >> used ) << rest;
+                value |= m_words[ ( m_pos >> 6 ) + 1 ] >> ( 64 - rest );
+            }
+
+            m_pos += numBits;
+            return value;
+        }
+
+        inline bool readBit()
+        {
+            return read( 1 ) != 0;
+        }
+
+      private:
+        const quint64* m_words;
+        qint64 m_pos;
+    };
+
+    // state of the XOR compression of a coordinate
+    class QwtXorState
+    {
+      public:
+        explicit QwtXorState( quint64 bits )
+            : prevBits( bits )
+            , leading( -1 )
+            , trailing( 0 )
+        {
+        }
+
+        quint64 prevBits;
+        int leading;
+        int trailing;
+    };
+
+    class QwtCompressedBlock
+    {
+      public:
+        int numSamples;
+        bool integralX;
+
+        QPointF first;
+        QPointF last;
+        QRectF boundingRect;
+
+        QVector< quint64 > bits;
+    };
+}
+
+static inline quint64 qwtBits( double value )
+{
+    quint64 bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+static inline double qwtDouble( quint64 bits )
+{
+    double value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+
+    return value;
+}
+
+static inline int qwtLeadingZeros( quint64 value )
+{
+    int n = 0;
+    for ( int shift = 32; shift > 0; shift >>= 1 )
+    {
+        if ( ( value >> ( 64 - shift ) ) == 0 )
+        {
+            n += shift;
+            value <<= shift;
+        }
+    }
+
+    return n;
+}
+
+static inline int qwtTrailingZeros( quint64 value )
+{
+    int n = 0;
+    for ( int shift = 32; shift > 0; shift >>= 1 )
+    {
+        if ( ( value << ( 64 - shift ) ) == 0 )
+        {
+            n += shift;
+            value >>= shift;
+        }
+    }
+
+    return n;
+}
+
+static inline bool qwtIsIntegral( double value )
+{
+    // beyond 2^53 not all integers can be represented as doubles
+    const double maxValue = 9007199254740992.0;
+
+    return ( value > -maxValue ) && ( value < maxValue )
+        && ( double( qint64( value ) ) == value );
+}
+
+static void qwtWriteXor( QwtBitWriter& writer, QwtXorState& state, double value )
+{
+    const quint64 bits = qwtBits( value );
+    const quint64 xorBits = bits ^ state.prevBits;
+
+    state.prevBits = bits;
+
+    if ( xorBits == 0 )
+    {
+        writer.write( 0, 1 );
+        return;
+    }
+
+    writer.write( 1, 1 );
+
+    const int leading = qMin( qwtLeadingZeros( xorBits ), 31 );
+    const int trailing = qwtTrailingZeros( xorBits );
+
+    if ( state.leading >= 0 && leading >= state.leading
+        && trailing >= state.trailing )
+    {
+        // the changed bits fit into the window of the previous value
+
+        writer.write( 0, 1 );
+        writer.write( xorBits >> state.trailing,
+            64 - state.leading - state.trailing );
+    }
+    else
+    {
+        const int numBits = 64 - leading - trailing;
+
+        writer.write( 1, 1 );
+        writer.write( quint64( leading ), 5 );
+        writer.write( quint64( numBits & 63 ), 6 ); // 64 is stored as 0
+        writer.write( xorBits >> trailing, numBits );
+
+        state.leading = leading;
+        state.trailing = trailing;
+    }
+}
+
+static inline double qwtReadXor( QwtBitReader& reader, QwtXorState& state )
+{
+    if ( reader.readBit() )
+    {
+        if ( reader.readBit() )
+        {
+            const int leading = int( reader.read( 5 ) );
+
+            int numBits = int( reader.read( 6 ) );
+            if ( numBits == 0 )
+                numBits = 64;
+
+            state.leading = leading;
+            state.trailing = 64 - leading - numBits;
+        }
+
+        const int numBits = 64 - state.leading - state.trailing;
+        state.prevBits ^= reader.read( numBits ) << state.trailing;
+    }
+
+    return qwtDouble( state.prevBits );
+}
+
+static void qwtWriteDelta( QwtBitWriter& writer, qint64 deltaOfDelta )
+{
+    // buckets of the Gorilla paper, with a fallback of 64 bits
+
+    if ( deltaOfDelta == 0 )
+    {
+        writer.write( 0, 1 );
+    }
+    else if ( deltaOfDelta >= -64 && deltaOfDelta < 64 )
+    {
+        writer.write( 0x2, 2 );
+        writer.write( quint64( deltaOfDelta ), 7 );
+    }
+    else if ( deltaOfDelta >= -256 && deltaOfDelta < 256 )
+    {
+        writer.write( 0x6, 3 );
+        writer.write( quint64( deltaOfDelta ), 9 );
+    }
+    else if ( deltaOfDelta >= -2048 && deltaOfDelta < 2048 )
+    {
+        writer.write( 0xe, 4 );
+        writer.write( quint64( deltaOfDelta ), 12 );
+    }
+    else
+    {
+        writer.write( 0xf, 4 );
+        writer.write( quint64( deltaOfDelta ), 64 );
+    }
+}
+
+static inline qint64 qwtSignExtend( quint64 value, int numBits )
+{
+    const quint64 signBit = Q_UINT64_C( 1 ) << ( numBits - 1 );
+    return qint64( ( value ^ signBit ) - signBit );
+}
+
+static inline qint64 qwtReadDelta( QwtBitReader& reader )
+{
+    if ( !reader.readBit() )
+        return 0;
+
+    if ( !reader.readBit() )
+        return qwtSignExtend( reader.read( 7 ), 7 );
+
+    if ( !reader.readBit() )
+        return qwtSignExtend( reader.read( 9 ), 9 );
+
+    if ( !reader.readBit() )
+        return qwtSignExtend( reader.read( 12 ), 12 );
+
+    return qint64( reader.read( 64 ) );
+}
+
+static QwtCompressedBlock qwtCompressBlock( const QVector< QPointF >& points )
+{
+    QwtCompressedBlock block;
+    block.numSamples = points.size();
+    block.first = points.first();
+    block.last = points.last();
+
+    double xMin = block.first.x();
+    double xMax = xMin;
+    double yMin = block.first.y();
+    double yMax = yMin;
+
+    block.integralX = true;
+
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const QPointF& p = points[i];
+
+        if ( block.integralX && !qwtIsIntegral( p.x() ) )
+            block.integralX = false;
+
+        xMin = qMin( xMin, p.x() );
+        xMax = qMax( xMax, p.x() );
+        yMin = qMin( yMin, p.y() );
+        yMax = qMax( yMax, p.y() );
+    }
+
+    block.boundingRect.setCoords( xMin, yMin, xMax, yMax );
+
+    QwtBitWriter writer( block.bits );
+
+    qint64 prevX = block.integralX ? qint64( block.first.x() ) : 0;
+    qint64 prevDelta = 0;
+
+    QwtXorState xState( qwtBits( block.first.x() ) );
+    QwtXorState yState( qwtBits( block.first.y() ) );
+
+    for ( int i = 1; i < points.size(); i++ )
+    {
+        const QPointF& p = points[i];
+
+        if ( block.integralX )
+        {
+            const qint64 x = qint64( p.x() );
+            const qint64 delta = x - prevX;
+
+            qwtWriteDelta( writer, delta - prevDelta );
+
+            prevX = x;
+            prevDelta = delta;
+        }
+        else
+        {
+            qwtWriteXor( writer, xState, p.x() );
+        }
+
+        qwtWriteXor( writer, yState, p.y() );
+    }
+
+    block.bits.squeeze();
+
+    return block;
+}
+
+// decompress the samples [from, to[ of a block
+static void qwtDecompressBlock( const QwtCompressedBlock& block,
+    int from, int to, QPointF* samples )
+{
+    QPointF p = block.first;
+
+    if ( from == 0 )
+        *samples++ = p;
+
+    if ( to <= 1 )
+        return;
+
+    QwtBitReader reader( block.bits.constData() );
+
+    qint64 x = block.integralX ? qint64( p.x() ) : 0;
+    qint64 delta = 0;
+
+    QwtXorState xState( qwtBits( p.x() ) );
+    QwtXorState yState( qwtBits( p.y() ) );
+
+    for ( int i = 1; i < to; i++ )
+    {
+        if ( block.integralX )
+        {
+            delta += qwtReadDelta( reader );
+            x += delta;
+
+            p.rx() = double( x );
+        }
+        else
+        {
+            p.rx() = qwtReadXor( reader, xState );
+        }
+
+        p.ry() = qwtReadXor( reader, yState );
+
+        if ( i >= from )
+            *samples++ = p;
+    }
+}
+
+class QwtCompressedPointData::PrivateData
+{
+  public:
+    PrivateData( int size )
+        : blockSize( size )
+        , boundingRect( 0.0, 0.0, -1.0, -1.0 )
+        , rectOfInterest( 0.0, 0.0, -1.0, -1.0 )
+        , cachedBlock( -1 )
+    {
+    }
+
+    inline bool isSkipped( const QwtCompressedBlock& block ) const
+    {
+        if ( !rectOfInterest.isValid() )
+            return false;
+
+        const QRectF& br = block.boundingRect;
+        return ( br.right() < rectOfInterest.left() )
+            || ( br.left() > rectOfInterest.right() );
+    }
+
+    const int blockSize;
+
+    QVector< QwtCompressedBlock > blocks;
+    QVector< QPointF > pending;
+
+    QRectF boundingRect;
+    QRectF rectOfInterest;
+
+    // the block, that has been decompressed by sample()
+    QMutex mutex;
+    int cachedBlock;
+    QVector< QPointF > cachedSamples;
+};
+
+/*!
+   \brief Constructor
+
+   \param blockSize Number of samples of a block
+ */
+QwtCompressedPointData::QwtCompressedPointData( int blockSize )
+{
+    m_data = new PrivateData( qMax( blockSize, 2 ) );
+}
+
+//! Destructor
+QwtCompressedPointData::~QwtCompressedPointData()
+{
+    delete m_data;
+}
+
+//! \return Number of samples of a block
+int QwtCompressedPointData::blockSize() const
+{
+    return m_data->blockSize;
+}
+
+/*!
+   \brief Append a sample
+
+   When the last block is complete, it gets compressed.
+
+   \param point Sample
+   \sa clear()
+ */
+void QwtCompressedPointData::append( const QPointF& point )
+{
+    if ( m_data->pending.isEmpty() )
+        m_data->pending.reserve( m_data->blockSize );
+
+    m_data->pending += point;
+
+    QRectF& br = m_data->boundingRect;
+    if ( br.width() < 0.0 )
+    {
+        br = QRectF( point, QSizeF( 0.0, 0.0 ) );
+    }
+    else
+    {
+        br.setLeft( qMin( br.left(), point.x() ) );
+        br.setRight( qMax( br.right(), point.x() ) );
+        br.setTop( qMin( br.top(), point.y() ) );
+        br.setBottom( qMax( br.bottom(), point.y() ) );
+    }
+
+    if ( m_data->pending.size() >= m_data->blockSize )
+        flushBlock();
+}
+
+/*!
+   \brief Append samples
+   \param points Samples
+ */
+void QwtCompressedPointData::append( const QVector< QPointF >& points )
+{
+    for ( int i = 0; i < points.size(); i++ )
+        append( points[i] );
+}
+
+void QwtCompressedPointData::flushBlock()
+{
+    m_data->blocks += qwtCompressBlock( m_data->pending );
+    m_data->pending.clear();
+}
+
+//! Remove all samples
+void QwtCompressedPointData::clear()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->blocks.clear();
+    m_data->pending.clear();
+    m_data->boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    m_data->cachedBlock = -1;
+    m_data->cachedSamples.clear();
+}
+
+//! \return Number of compressed blocks
+int QwtCompressedPointData::blockCount() const
+{
+    return m_data->blocks.size();
+}
+
+/*!
+   \return Number of bytes, that are allocated for the samples
+   \note The overhead of the memory allocator is not included
+ */
+size_t QwtCompressedPointData::memoryUsage() const
+{
+    size_t bytes = size_t( m_data->pending.capacity() ) * sizeof( QPointF );
+
+    for ( int i = 0; i < m_data->blocks.size(); i++ )
+    {
+        bytes += sizeof( QwtCompressedBlock );
+        bytes += size_t( m_data->blocks[i].bits.capacity() ) * sizeof( quint64 );
+    }
+
+    return bytes;
+}
+
+//! \return Number of samples
+size_t QwtCompressedPointData::size() const
+{
+    return size_t( m_data->blocks.size() ) * m_data->blockSize
+        + m_data->pending.size();
+}
+
+/*!
+   \return Sample at a specific index
+
+   The block of the sample is decompressed and cached, so that
+   the following requests for samples of the same block are fast.
+
+   \param index Index
+ */
+QPointF QwtCompressedPointData::sample( size_t index ) const
+{
+    const int blockIndex = int( index / m_data->blockSize );
+    const int pos = int( index % m_data->blockSize );
+
+    if ( blockIndex >= m_data->blocks.size() )
+        return m_data->pending[ int( index - m_data->blocks.size() * size_t( m_data->blockSize ) ) ];
+
+    const QwtCompressedBlock& block = m_data->blocks[ blockIndex ];
+
+    if ( pos == 0 )
+        return block.first;
+
+    if ( pos == block.numSamples - 1 )
+        return block.last;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    if ( m_data->cachedBlock != blockIndex )
+    {
+        m_data->cachedSamples.resize( block.numSamples );
+        qwtDecompressBlock( block, 0, block.numSamples,
+            m_data->cachedSamples.data() );
+
+        m_data->cachedBlock = blockIndex;
+    }
+
+    return m_data->cachedSamples[ pos ];
+}
+
+/*!
+   \return Bounding rectangle of all samples
+
+   The rectangle is updated, when appending samples.
+ */
+QRectF QwtCompressedPointData::boundingRect() const
+{
+    return m_data->boundingRect;
+}
+
+/*!
+   \brief Set the rectangle of interest
+
+   The samples of blocks, that are completely left or right of the
+   rectangle, are not decompressed by fetch().
+
+   \param rect Rectangle of interest. An invalid rectangle
+               disables skipping blocks.
+
+   \sa rectOfInterest(), fetch()
+ */
+void QwtCompressedPointData::setRectOfInterest( const QRectF& rect )
+{
+    m_data->rectOfInterest = rect;
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtCompressedPointData::rectOfInterest() const
+{
+    return m_data->rectOfInterest;
+}
+
+/*!
+   \brief Decompress a range of samples
+
+   The samples are decompressed into the buffer of the caller, so
+   that fetch() can be called from different threads in parallel.
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+
+   \sa setRectOfInterest()
+ */
+void QwtCompressedPointData::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const size_t blockSize = size_t( m_data->blockSize );
+    const size_t numCompressed = m_data->blocks.size() * blockSize;
+
+    const size_t to = from + numSamples;
+
+    size_t index = from;
+    while ( index < to && index < numCompressed )
+    {
+        const QwtCompressedBlock& block = m_data->blocks[ int( index / blockSize ) ];
+
+        const size_t blockStart = ( index / blockSize ) * blockSize;
+        const size_t blockEnd = qMin( to, blockStart + blockSize );
+
+        QPointF* out = samples + ( index - from );
+
+        if ( m_data->isSkipped( block ) )
+        {
+            for ( size_t i = index; i < blockEnd; i++ )
+                *out++ = ( i == blockStart + blockSize - 1 ) ? block.last : block.first;
+        }
+        else
+        {
+            qwtDecompressBlock( block, int( index - blockStart ),
+                int( blockEnd - blockStart ), out );
+        }
+
+        index = blockEnd;
+    }
+
+    if ( index < to )
+    {
+        const QPointF* pending = m_data->pending.constData() + ( index - numCompressed );
+        std::memcpy( samples + ( index - from ), pending,
+            ( to - index ) * sizeof( QPointF ) );
+    }
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_COMPRESSED_POINT_DATA_H
+#define QWT_COMPRESSED_POINT_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qvector.h>
+
+/*!
+   \brief Series of points, that are stored compressed in memory
+
+   QwtCompressedPointData is intended for long histories of time series,
+   where the x coordinates are increasing timestamps. The samples are
+   appended in blocks of blockSize() points, that are compressed like
+   in Facebook's Gorilla database:
+
+   - integral x coordinates ( f.e. seconds or milliseconds since the epoch )
+     are stored as delta of the deltas, what needs only 1 bit for
+     samples with a constant rate.
+   - all other coordinates are stored as XOR to the previous value,
+     where only the bits, that have changed, are written.
+
+   For each block the first, the last sample and the bounding rectangle
+   are stored uncompressed. So boundingRect() is calculated from the block
+   headers only. The samples of the last block, that has not been filled
+   yet, are stored uncompressed.
+
+   fetch() decompresses the requested blocks into the buffer of
+   the caller, so that the samples can be mapped in parallel
+   without any locking. Blocks, that are completely left or right of the
+   rectangle of interest ( see setRectOfInterest() ), are not decompressed
+   at all. Their first and last sample are returned correctly, while all
+   other samples are replaced by the first one. As all of them are outside
+   of the visible area the result of painting lines, steps, vertical sticks,
+   fills or dots is the same.
+
+   sample() decompresses a block into a cache, so that accessing
+   a couple of samples of the same block - f.e. by qwtClipSampleRange()
+   - is fast.
+
+   \par Example
+   \code
+   QwtCompressedPointData* data = new QwtCompressedPointData();
+   for ( int i = 0; i < numSamples; i++ )
+       data->append( QPointF( timestamps[i], values[i] ) );
+
+   curve->setData( data );
+   curve->setSeriesAttribute( QwtPlotSeriesItem::OrderedSamples, true );
+   \endcode
+   \endpar
+
+   \note Symbols of samples of a skipped block might be visible partly,
+         when they are close to the border of the rectangle of interest.
+
+   \sa QwtPointArrayData, QwtViewportSeriesData
+ */
+class QWT_EXPORT QwtCompressedPointData : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtCompressedPointData( int blockSize = 1024 );
+    virtual ~QwtCompressedPointData();
+
+    int blockSize() const;
+
+    void append( const QPointF& );
+    void append( const QVector< QPointF >& );
+
+    void clear();
+
+    int blockCount() const;
+    size_t memoryUsage() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+    virtual void fetch( size_t from, size_t numSamples,
+        QPointF* samples ) const QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtCompressedPointData )
+
+    void flushBlock();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -10,6 +10,11 @@
 #include "qwt_date_scale_draw.h"
 #include "qwt_text.h"
 
+#include <qmap.h>
+
+// labels of a scrolling axis are usually found in the cache
+static const int qwtMaxCachedLabels = 1000;
+
 class QwtDateScaleDraw::PrivateData
 {
   public:
@@ -17,6 +22,8 @@ class QwtDateScaleDraw::PrivateData
         : timeSpec( spec )
         , utcOffset( 0 )
         , week0Type( QwtDate::FirstThursday )
+        , hasIntervalType( false )
+        , intervalType( QwtDate::Second )
     {
         dateFormats[ QwtDate::Millisecond ] = "hh:mm:ss:zzz\nddd dd MMM yyyy";
         dateFormats[ QwtDate::Second ] = "hh:mm:ss\nddd dd MMM yyyy";
@@ -28,10 +35,26 @@ class QwtDateScaleDraw::PrivateData
         dateFormats[ QwtDate::Year ] = "yyyy";
     }
 
+    void invalidateCache()
+    {
+        hasIntervalType = false;
+
+        for ( int i = 0; i <= QwtDate::Year; i++ )
+            labelCache[i].clear();
+    }
+
     Qt::TimeSpec timeSpec;
     int utcOffset;
     QwtDate::Week0Type week0Type;
     QString dateFormats[ QwtDate::Year + 1 ];
+
+    // interval type of the scale division, that was used last
+    bool hasIntervalType;
+    QwtScaleDiv intervalTypeDiv;
+    QwtDate::IntervalType intervalType;
+
+    // formatted labels for each interval type, kept across scale divisions
+    QMap< double, QString > labelCache[ QwtDate::Year + 1 ];
 };
 
 /*!
@@ -65,6 +88,7 @@ QwtDateScaleDraw::~QwtDateScaleDraw()
 void QwtDateScaleDraw::setTimeSpec( Qt::TimeSpec timeSpec )
 {
     m_data->timeSpec = timeSpec;
+    m_data->invalidateCache();
 }
 
 /*!
@@ -89,6 +113,7 @@ Qt::TimeSpec QwtDateScaleDraw::timeSpec() const
 void QwtDateScaleDraw::setUtcOffset( int seconds )
 {
     m_data->utcOffset = seconds;
+    m_data->invalidateCache();
 }
 
 /*!
@@ -115,6 +140,7 @@ int QwtDateScaleDraw::utcOffset() const
 void QwtDateScaleDraw::setWeek0Type( QwtDate::Week0Type week0Type )
 {
     m_data->week0Type = week0Type;
+    m_data->invalidateCache();
 }
 
 /*!
@@ -141,6 +167,7 @@ void QwtDateScaleDraw::setDateFormat(
         intervalType <= QwtDate::Year )
     {
         m_data->dateFormats[ intervalType ] = format;
+        m_data->labelCache[ intervalType ].clear();
     }
 }
 
@@ -197,18 +224,64 @@ QString QwtDateScaleDraw::dateFormatOfDate( const QDateTime& dateTime,
    The value is converted to a datetime value using toDateTime()
    and converted to a plain text using QwtDate::toString().
 
+   As formatting dates is expensive the strings are cached for each
+   interval type. In opposite to the label cache of QwtAbstractScaleDraw
+   this cache is not cleared, when the scale division changes. So for axes
+   that are scrolling the labels, that have been visible before, don't need
+   to be formatted again.
+
    \param value Value
    \return Label string.
 
    \sa dateFormatOfDate()
+   \note The cache assumes, that dateFormatOfDate() always returns
+         the same format for the same date and interval type.
  */
 QwtText QwtDateScaleDraw::label( double value ) const
 {
+    const QwtDate::IntervalType intvType = cachedIntervalType();
+
+    if ( intvType < QwtDate::Millisecond || intvType > QwtDate::Year )
+    {
+        const QDateTime dt = toDateTime( value );
+        return QwtDate::toString( dt,
+            dateFormatOfDate( dt, intvType ), m_data->week0Type );
+    }
+
+    QMap< double, QString >& cache = m_data->labelCache[ intvType ];
+
+    QMap< double, QString >::const_iterator it = cache.constFind( value );
+    if ( it != cache.constEnd() )
+        return *it;
+
     const QDateTime dt = toDateTime( value );
-    const QString fmt = dateFormatOfDate(
-        dt, intervalType( scaleDiv() ) );
+    const QString text = QwtDate::toString( dt,
+        dateFormatOfDate( dt, intvType ), m_data->week0Type );
+
+    if ( cache.size() >= qwtMaxCachedLabels )
+        cache.clear();
+
+    cache.insert( value, text );
+
+    return text;
+}
+
+/*!
+   \return intervalType() for the current scale division
+
+   As label() is called for each tick, the result is
+   cached until the scale division changes.
+ */
+QwtDate::IntervalType QwtDateScaleDraw::cachedIntervalType() const
+{
+    if ( !m_data->hasIntervalType || m_data->intervalTypeDiv != scaleDiv() )
+    {
+        m_data->intervalTypeDiv = scaleDiv();
+        m_data->intervalType = intervalType( scaleDiv() );
+        m_data->hasIntervalType = true;
+    }
 
-    return QwtDate::toString( dt, fmt, m_data->week0Type );
+    return m_data->intervalType;
 }
 
 /*!
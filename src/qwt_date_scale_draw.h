@@ -79,6 +79,8 @@ class QWT_EXPORT QwtDateScaleDraw : public QwtScaleDraw
         QwtDate::IntervalType ) const;
 
   private:
+    QwtDate::IntervalType cachedIntervalType() const;
+
     class PrivateData;
     PrivateData* m_data;
 };
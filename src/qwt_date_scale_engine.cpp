@@ -444,6 +444,68 @@ static QList< double > qwtDstTicks( const QDateTime& dateTime,
     return ticks;
 }
 
+/*
+   Without daylight saving the steps are equidistant in ms, and
+   the ticks can be calculated without any QDateTime operation.
+   The values are the same as QDateTime::addSecs/addMSecs would give.
+ */
+static QwtScaleDiv qwtDivideToSecondsFast(
+    const QDateTime& minDate, const QDateTime& maxDate,
+    int secondsMajor, double secondsMinor )
+{
+    const double minValue = QwtDate::toDouble( minDate );
+    const double maxValue = QwtDate::toDouble( maxDate );
+
+    QList< double > majorTicks;
+    QList< double > mediumTicks;
+    QList< double > minorTicks;
+
+    const double msecsMajor = secondsMajor * 1000.0;
+
+    int numMinorSteps = 0;
+    if ( secondsMinor > 0.0 )
+        numMinorSteps = qwtFloor( secondsMajor / secondsMinor );
+
+    if ( msecsMajor > 0.0 )
+    {
+        for ( int k = 0; ; k++ )
+        {
+            const double majorValue = minValue + k * msecsMajor;
+            if ( majorValue > maxValue )
+                break;
+
+            majorTicks += majorValue;
+
+            for ( int i = 1; i < numMinorSteps; i++ )
+            {
+                const double minorValue = majorValue
+                    + static_cast< double >( qRound64( i * secondsMinor * 1000 ) );
+
+                if ( minorTicks.isEmpty() || minorTicks.last() != minorValue )
+                {
+                    const bool isMedium = ( numMinorSteps % 2 == 0 )
+                        && ( i != 1 ) && ( i == numMinorSteps / 2 );
+
+                    if ( isMedium )
+                        mediumTicks += minorValue;
+                    else
+                        minorTicks += minorValue;
+                }
+            }
+        }
+    }
+
+    QwtScaleDiv scaleDiv;
+
+    scaleDiv.setInterval( minValue, maxValue );
+
+    scaleDiv.setTicks( QwtScaleDiv::MajorTick, majorTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MediumTick, mediumTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MinorTick, minorTicks );
+
+    return scaleDiv;
+}
+
 static QwtScaleDiv qwtDivideToSeconds(
     const QDateTime& minDate, const QDateTime& maxDate,
     double stepSize, int maxMinSteps,
@@ -472,6 +534,12 @@ static QwtScaleDiv qwtDivideToSeconds(
     const int secondsMajor = static_cast< int >( stepSize * s );
     const double secondsMinor = minStepSize * s;
 
+    if ( !daylightSaving )
+    {
+        return qwtDivideToSecondsFast( minDate, maxDate,
+            secondsMajor, secondsMinor );
+    }
+
     // UTC excludes daylight savings. So from the difference
     // of a date and its UTC counterpart we can find out
     // the daylight saving hours
@@ -13,7 +13,9 @@
 #include "qwt_scale_map.h"
 #include "qwt_round_scale_draw.h"
 #include "qwt_painter.h"
+#include "qwt_graphic.h"
 #include "qwt.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpalette.h>
@@ -21,6 +23,197 @@
 #include <qevent.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
+#include <qlist.h>
+#include <qfont.h>
+#include <qregion.h>
+
+#include <typeinfo>
+
+namespace
+{
+    /*
+        Everything, that has an effect on the static layer
+        of a dial in QwtDial::RotateNeedle mode
+     */
+    class QwtDialCacheKey
+    {
+      public:
+        QwtDialCacheKey()
+            : metaObject( NULL )
+            , scaleDrawType( NULL )
+        {
+        }
+
+        QwtDialCacheKey( const QwtDial* dial, const QSize& size )
+            : metaObject( dial->metaObject() )
+            , scaleDrawType( NULL )
+            , size( size )
+            , pixelRatio( QwtPainter::devicePixelRatio( dial ) )
+            , palette( dial->palette() )
+            , colorGroup( dial->palette().currentColorGroup() )
+            , font( dial->font() )
+            , frameShadow( dial->frameShadow() )
+            , lineWidth( dial->lineWidth() )
+            , origin( dial->origin() )
+            , minScaleArc( dial->minScaleArc() )
+            , maxScaleArc( dial->maxScaleArc() )
+            , isInverted( dial->isInverted() )
+            , spacing( 0.0 )
+            , penWidthF( 0.0 )
+            , components( 0 )
+        {
+            for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+                tickLength[i] = 0.0;
+
+            const QwtRoundScaleDraw* sd = dial->scaleDraw();
+            if ( sd )
+            {
+                scaleDrawType = &typeid( *sd );
+                scaleDiv = sd->scaleDiv();
+
+                for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+                {
+                    tickLength[i] = sd->tickLength(
+                        static_cast< QwtScaleDiv::TickType >( i ) );
+                }
+
+                spacing = sd->spacing();
+                penWidthF = sd->penWidthF();
+
+                const QwtAbstractScaleDraw::ScaleComponent c[] =
+                {
+                    QwtAbstractScaleDraw::Backbone,
+                    QwtAbstractScaleDraw::Ticks,
+                    QwtAbstractScaleDraw::Labels
+                };
+
+                for ( int i = 0; i < 3; i++ )
+                {
+                    if ( sd->hasComponent( c[i] ) )
+                        components |= c[i];
+                }
+            }
+        }
+
+        bool operator==( const QwtDialCacheKey& other ) const
+        {
+            if ( metaObject != other.metaObject || size != other.size )
+                return false;
+
+            if ( ( scaleDrawType == NULL ) != ( other.scaleDrawType == NULL ) )
+                return false;
+
+            if ( scaleDrawType && *scaleDrawType != *other.scaleDrawType )
+                return false;
+
+            for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+            {
+                if ( tickLength[i] != other.tickLength[i] )
+                    return false;
+            }
+
+            return ( pixelRatio == other.pixelRatio )
+                && ( frameShadow == other.frameShadow )
+                && ( lineWidth == other.lineWidth )
+                && ( origin == other.origin )
+                && ( minScaleArc == other.minScaleArc )
+                && ( maxScaleArc == other.maxScaleArc )
+                && ( isInverted == other.isInverted )
+                && ( spacing == other.spacing )
+                && ( penWidthF == other.penWidthF )
+                && ( components == other.components )
+                && ( colorGroup == other.colorGroup )
+                && ( scaleDiv == other.scaleDiv )
+                && ( font == other.font )
+                && ( palette == other.palette );
+        }
+
+        const QMetaObject* metaObject;
+        const std::type_info* scaleDrawType;
+
+        QSize size;
+        qreal pixelRatio;
+
+        QPalette palette;
+        QPalette::ColorGroup colorGroup;
+        QFont font;
+
+        QwtDial::Shadow frameShadow;
+        int lineWidth;
+
+        double origin;
+        double minScaleArc;
+        double maxScaleArc;
+        bool isInverted;
+
+        QwtScaleDiv scaleDiv;
+        double tickLength[QwtScaleDiv::NTickTypes];
+        double spacing;
+        qreal penWidthF;
+        int components;
+    };
+
+    class QwtDialCacheEntry
+    {
+      public:
+        QwtDialCacheKey key;
+        QPixmap pixmap;
+        int refCount;
+    };
+
+    /*
+        The static layers shared between dials. Dials are widgets
+        living in the GUI thread, so there is no need for a mutex.
+     */
+    class QwtDialCache
+    {
+      public:
+        QwtDialCacheEntry* acquire( const QwtDialCacheKey& key )
+        {
+            for ( int i = 0; i < m_entries.size(); i++ )
+            {
+                QwtDialCacheEntry* entry = m_entries[i];
+                if ( entry->key == key )
+                {
+                    entry->refCount++;
+                    return entry;
+                }
+            }
+
+            return NULL;
+        }
+
+        QwtDialCacheEntry* insert( const QwtDialCacheKey& key, const QPixmap& pixmap )
+        {
+            QwtDialCacheEntry* entry = new QwtDialCacheEntry;
+            entry->key = key;
+            entry->pixmap = pixmap;
+            entry->refCount = 1;
+
+            m_entries += entry;
+
+            return entry;
+        }
+
+        void release( QwtDialCacheEntry* entry )
+        {
+            if ( --entry->refCount == 0 )
+            {
+                m_entries.removeOne( entry );
+                delete entry;
+            }
+        }
+
+      private:
+        QList< QwtDialCacheEntry* > m_entries;
+    };
+}
+
+static QwtDialCache* qwtDialCache()
+{
+    static QwtDialCache cache;
+    return &cache;
+}
 
 static inline double qwtAngleDist( double a1, double a2 )
 {
@@ -85,13 +278,28 @@ class QwtDial::PrivateData
         , needle( NULL )
         , arcOffset( 0.0 )
         , mouseOffset( 0.0 )
+        , cachePixelRatio( 1.0 )
+        , isCacheSharing( false )
+        , sharedEntry( NULL )
+        , cacheEntry( this )
     {
     }
 
     ~PrivateData()
     {
+        releaseSharedEntry();
         delete needle;
     }
+
+    void releaseSharedEntry()
+    {
+        if ( sharedEntry )
+        {
+            qwtDialCache()->release( sharedEntry );
+            sharedEntry = NULL;
+        }
+    }
+
     Shadow frameShadow;
     int lineWidth;
 
@@ -107,6 +315,39 @@ class QwtDial::PrivateData
     double mouseOffset;
 
     QPixmap pixmapCache;
+    QSize cacheSize;
+    qreal cachePixelRatio;
+
+    bool isCacheSharing;
+    QwtDialCacheEntry* sharedEntry;
+
+    // area of the needle, when it has been painted last
+    QRect needleRect;
+    QRect needleInnerRect;
+
+    // shared pixmaps are accounted by the dial, that has rendered them
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::PixmapCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->releaseSharedEntry();
+            m_data->pixmapCache = QPixmap();
+            m_data->needleRect = QRect();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 /*!
@@ -300,7 +541,51 @@ QwtDial::Mode QwtDial::mode() const
  */
 void QwtDial::invalidateCache()
 {
+    m_data->releaseSharedEntry();
     m_data->pixmapCache = QPixmap();
+    m_data->needleRect = QRect();
+
+    m_data->cacheEntry.setMemoryUsage( 0 );
+}
+
+/*!
+   \brief En/Disable sharing the static layer with other dials
+
+   In QwtDial::RotateNeedle mode the contents, the scale and the frame
+   are rendered to a pixmap, that is reused until invalidateCache()
+   gets called. When sharing is enabled, dials of the same class and
+   the same attributes - size, device pixel ratio, palette, font,
+   frame, scale arc, origin, scale division and settings of the
+   scale draw - share one pixmap. So a panel with many identical gauges
+   renders and stores the static layer only once.
+
+   \param on On/Off. The default setting is off.
+
+   \warning Derived classes with attributes, that have an effect on
+            drawContents(), drawScaleContents() or drawFrame() and are not
+            part of the list above - f.e. a label painted inside
+            of the scale - must not enable sharing, unless these attributes
+            are identical for all instances.
+
+   \sa isCacheSharing(), invalidateCache()
+ */
+void QwtDial::setCacheSharing( bool on )
+{
+    if ( on != m_data->isCacheSharing )
+    {
+        m_data->isCacheSharing = on;
+        invalidateCache();
+        update();
+    }
+}
+
+/*!
+   \return True, when the static layer might be shared with other dials
+   \sa setCacheSharing()
+ */
+bool QwtDial::isCacheSharing() const
+{
+    return m_data->isCacheSharing;
 }
 
 /*!
@@ -327,23 +612,62 @@ void QwtDial::paintEvent( QPaintEvent* event )
     }
 
     const QRect r = contentsRect();
-    if ( r.size() != m_data->pixmapCache.size() )
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+
+    if ( m_data->pixmapCache.isNull() || r.size() != m_data->cacheSize
+        || pixelRatio != m_data->cachePixelRatio )
     {
-        m_data->pixmapCache = QwtPainter::backingStore( this, r.size() );
-        m_data->pixmapCache.fill( Qt::transparent );
+        m_data->releaseSharedEntry();
 
-        QPainter p( &m_data->pixmapCache );
-        p.setRenderHint( QPainter::Antialiasing, true );
-        p.translate( -r.topLeft() );
+        m_data->cacheSize = r.size();
+        m_data->cachePixelRatio = pixelRatio;
 
-        if ( m_data->mode != QwtDial::RotateScale )
-            drawContents( &p );
+        // the needle is part of the cache in RotateScale mode
+        const bool doShare = m_data->isCacheSharing
+            && ( m_data->mode == QwtDial::RotateNeedle );
 
-        if ( lineWidth() > 0 )
-            drawFrame( &p );
+        QwtDialCacheKey key;
+        if ( doShare )
+        {
+            key = QwtDialCacheKey( this, r.size() );
+            m_data->sharedEntry = qwtDialCache()->acquire( key );
+        }
+
+        if ( m_data->sharedEntry )
+        {
+            m_data->pixmapCache = m_data->sharedEntry->pixmap;
+            m_data->cacheEntry.setMemoryUsage( 0 );
+        }
+        else
+        {
+            m_data->pixmapCache = QwtPainter::backingStore( this, r.size() );
+            m_data->pixmapCache.fill( Qt::transparent );
 
-        if ( m_data->mode != QwtDial::RotateNeedle )
-            drawNeedle( &p );
+            QPainter p( &m_data->pixmapCache );
+            p.setRenderHint( QPainter::Antialiasing, true );
+            p.translate( -r.topLeft() );
+
+            if ( m_data->mode != QwtDial::RotateScale )
+                drawContents( &p );
+
+            if ( lineWidth() > 0 )
+                drawFrame( &p );
+
+            if ( m_data->mode != QwtDial::RotateNeedle )
+                drawNeedle( &p );
+
+            p.end();
+
+            if ( doShare )
+                m_data->sharedEntry = qwtDialCache()->insert( key, m_data->pixmapCache );
+
+            m_data->cacheEntry.setMemoryUsage(
+                QwtCacheEntry::pixmapSize( m_data->pixmapCache ) );
+        }
+    }
+    else
+    {
+        m_data->cacheEntry.touch();
     }
 
     painter.drawPixmap( r.topLeft(), m_data->pixmapCache );
@@ -465,6 +789,28 @@ void QwtDial::drawNeedle( QPainter* painter ) const
     painter->restore();
 }
 
+/*
+    The area of the needle for the current value, measured by
+    recording it to a QwtGraphic. As any type of needle might be
+    drawn by a derived class there is no other way to find out.
+ */
+QRect QwtDial::needleBoundingRect() const
+{
+    QwtGraphic graphic;
+    graphic.setMeasureOnly( true );
+
+    QPainter painter( &graphic );
+    drawNeedle( &painter );
+    painter.end();
+
+    const QRectF br = graphic.boundingRect();
+    if ( !br.isValid() )
+        return QRect();
+
+    // antialiasing
+    return br.toAlignedRect().adjusted( -2, -2, 2, 2 );
+}
+
 /*!
    Draw the scale
 
@@ -527,6 +873,8 @@ void QwtDial::setNeedle( QwtDialNeedle* needle )
             delete m_data->needle;
 
         m_data->needle = needle;
+        m_data->needleRect = QRect();
+
         update();
     }
 }
@@ -870,7 +1218,37 @@ void QwtDial::sliderChange()
             m_data->maxScaleArc - m_data->minScaleArc );
     }
 
-    QwtAbstractSlider::sliderChange();
+    /*
+        In RotateNeedle mode only the needle changes with the value,
+        so we can restrict the update to the old and new needle areas.
+        When the cache has been invalidated or the geometry has changed
+        we don't know the area of the old needle and need a full update.
+     */
+
+    bool isNeedleUpdate = false;
+
+    if ( mode() == RotateNeedle && isVisible() && !m_data->pixmapCache.isNull() )
+    {
+        const QRect innerRect = scaleInnerRect();
+
+        const QRect oldRect = m_data->needleRect;
+        m_data->needleRect = needleBoundingRect();
+
+        if ( oldRect.isValid() && innerRect == m_data->needleInnerRect )
+        {
+            update( QRegion( oldRect ) + m_data->needleRect );
+            isNeedleUpdate = true;
+        }
+
+        m_data->needleInnerRect = innerRect;
+    }
+    else
+    {
+        m_data->needleRect = QRect();
+    }
+
+    if ( !isNeedleUpdate )
+        QwtAbstractSlider::sliderChange();
 }
 
 #if QWT_MOC_INCLUDE
@@ -41,6 +41,8 @@ class QwtAbstractScaleDraw;
    devices. For these high refresh rates QwtDial caches as much as possible.
    For derived classes it might be necessary to clear these caches manually
    according to attribute changes using invalidateCache().
+   Identical dials - f.e. the gauges of a cockpit panel - might share
+   their cache ( see setCacheSharing() ).
 
    \sa QwtCompass, QwtAnalogClock, QwtDialNeedle
    \note The controls and dials examples shows different types of dials.
@@ -132,6 +134,9 @@ class QWT_EXPORT QwtDial : public QwtAbstractSlider
     QwtRoundScaleDraw* scaleDraw();
     const QwtRoundScaleDraw* scaleDraw() const;
 
+    void setCacheSharing( bool );
+    bool isCacheSharing() const;
+
   protected:
     virtual void wheelEvent( QWheelEvent* ) QWT_OVERRIDE;
     virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
@@ -161,6 +166,7 @@ class QWT_EXPORT QwtDial : public QwtAbstractSlider
   private:
     void setAngleRange( double angle, double span );
     void drawNeedle( QPainter* ) const;
+    QRect needleBoundingRect() const;
 
     class PrivateData;
     PrivateData* m_data;
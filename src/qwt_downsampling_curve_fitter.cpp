@@ -0,0 +1,253 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_downsampling_curve_fitter.h"
+#include "qwt_math.h"
+
+#include <qpainterpath.h>
+#include <qpolygon.h>
+
+static QPolygonF qwtLargestTriangleThreeBuckets(
+    const QPolygonF& points, int numPoints )
+{
+    const int size = points.size();
+    if ( numPoints >= size || numPoints < 3 )
+        return points;
+
+    const QPointF* p = points.constData();
+
+    QPolygonF sampled;
+    sampled.reserve( numPoints );
+
+    sampled += p[0];
+
+    // the first and last points are always kept
+    const double bucketSize = double( size - 2 ) / ( numPoints - 2 );
+
+    int a = 0;
+
+    for ( int i = 0; i < numPoints - 2; i++ )
+    {
+        // average of the next bucket
+
+        const int avgFrom = int( ( i + 1 ) * bucketSize ) + 1;
+        const int avgTo = qMin( int( ( i + 2 ) * bucketSize ) + 1, size );
+
+        double avgX = 0.0;
+        double avgY = 0.0;
+
+        for ( int j = avgFrom; j < avgTo; j++ )
+        {
+            avgX += p[j].x();
+            avgY += p[j].y();
+        }
+
+        avgX /= ( avgTo - avgFrom );
+        avgY /= ( avgTo - avgFrom );
+
+        // point of the current bucket forming the largest triangle
+
+        const int from = int( i * bucketSize ) + 1;
+        const int to = int( ( i + 1 ) * bucketSize ) + 1;
+
+        const double ax = p[a].x();
+        const double ay = p[a].y();
+
+        double maxArea = -1.0;
+        int next = from;
+
+        for ( int j = from; j < to; j++ )
+        {
+            const double area = std::fabs( ( ax - avgX ) * ( p[j].y() - ay )
+                - ( ax - p[j].x() ) * ( avgY - ay ) );
+
+            if ( area > maxArea )
+            {
+                maxArea = area;
+                next = j;
+            }
+        }
+
+        sampled += p[next];
+        a = next;
+    }
+
+    sampled += p[size - 1];
+
+    return sampled;
+}
+
+static QPolygonF qwtMinMaxPreselection( const QPolygonF& points, int numBins )
+{
+    const int size = points.size();
+    if ( 2 * numBins + 2 >= size )
+        return points;
+
+    const QPointF* p = points.constData();
+
+    QPolygonF selected;
+    selected.reserve( 2 * numBins + 2 );
+
+    selected += p[0];
+
+    const double binSize = double( size - 2 ) / numBins;
+
+    for ( int i = 0; i < numBins; i++ )
+    {
+        const int from = int( i * binSize ) + 1;
+        const int to = qMin( int( ( i + 1 ) * binSize ) + 1, size - 1 );
+
+        if ( from >= to )
+            continue;
+
+        int minIndex = from;
+        int maxIndex = from;
+
+        for ( int j = from + 1; j < to; j++ )
+        {
+            if ( p[j].y() < p[minIndex].y() )
+                minIndex = j;
+
+            if ( p[j].y() > p[maxIndex].y() )
+                maxIndex = j;
+        }
+
+        if ( minIndex < maxIndex )
+        {
+            selected += p[minIndex];
+            selected += p[maxIndex];
+        }
+        else
+        {
+            selected += p[maxIndex];
+            if ( minIndex != maxIndex )
+                selected += p[minIndex];
+        }
+    }
+
+    selected += p[size - 1];
+
+    return selected;
+}
+
+/*!
+   Constructor
+
+   \param pointsPerPixel Number of points for each pixel
+   \sa setPointsPerPixel()
+ */
+QwtDownsamplingCurveFitter::QwtDownsamplingCurveFitter( double pointsPerPixel )
+    : QwtCurveFitter( QwtCurveFitter::Polygon )
+    , m_algorithm( LargestTriangleThreeBuckets )
+    , m_pointsPerPixel( 2.0 )
+{
+    setPointsPerPixel( pointsPerPixel );
+}
+
+//! Destructor
+QwtDownsamplingCurveFitter::~QwtDownsamplingCurveFitter()
+{
+}
+
+/*!
+   Set the downsampling algorithm
+
+   The default setting is LargestTriangleThreeBuckets.
+
+   \param algorithm Algorithm
+   \sa algorithm()
+ */
+void QwtDownsamplingCurveFitter::setAlgorithm( Algorithm algorithm )
+{
+    m_algorithm = algorithm;
+}
+
+/*!
+   \return Downsampling algorithm
+   \sa setAlgorithm()
+ */
+QwtDownsamplingCurveFitter::Algorithm QwtDownsamplingCurveFitter::algorithm() const
+{
+    return m_algorithm;
+}
+
+/*!
+   Set the number of points for each pixel
+
+   The number of resulting points is pointsPerPixel multiplied by
+   the width of the bounding rectangle of the polygon.
+   The default setting is 2.0.
+
+   \param pointsPerPixel Number of points for each pixel
+   \sa pointsPerPixel()
+ */
+void QwtDownsamplingCurveFitter::setPointsPerPixel( double pointsPerPixel )
+{
+    m_pointsPerPixel = qwtMaxF( pointsPerPixel, 0.0 );
+}
+
+/*!
+   \return Number of points for each pixel
+   \sa setPointsPerPixel()
+ */
+double QwtDownsamplingCurveFitter::pointsPerPixel() const
+{
+    return m_pointsPerPixel;
+}
+
+/*!
+   \param points Series of data points
+   \return Downsampled points
+   \sa fitCurvePath()
+ */
+QPolygonF QwtDownsamplingCurveFitter::fitCurve( const QPolygonF& points ) const
+{
+    const int size = points.size();
+    if ( size <= 3 )
+        return points;
+
+    double minX = points[0].x();
+    double maxX = minX;
+
+    for ( int i = 1; i < size; i++ )
+    {
+        const double x = points[i].x();
+
+        if ( x < minX )
+            minX = x;
+        else if ( x > maxX )
+            maxX = x;
+    }
+
+    const double numPoints = std::ceil( m_pointsPerPixel * ( maxX - minX ) );
+    if ( numPoints >= size )
+        return points;
+
+    const int numBuckets = qMax( int( numPoints ), 3 );
+
+    if ( m_algorithm == MinMaxLargestTriangleThreeBuckets )
+    {
+        const QPolygonF selected = qwtMinMaxPreselection( points, 2 * numBuckets );
+        return qwtLargestTriangleThreeBuckets( selected, numBuckets );
+    }
+
+    return qwtLargestTriangleThreeBuckets( points, numBuckets );
+}
+
+/*!
+   \param points Series of data points
+   \return Curve path
+   \sa fitCurve()
+ */
+QPainterPath QwtDownsamplingCurveFitter::fitCurvePath( const QPolygonF& points ) const
+{
+    QPainterPath path;
+    path.addPolygon( fitCurve( points ) );
+    return path;
+}
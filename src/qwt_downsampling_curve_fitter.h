@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_DOWNSAMPLING_CURVE_FITTER_H
+#define QWT_DOWNSAMPLING_CURVE_FITTER_H
+
+#include "qwt_curve_fitter.h"
+
+/*!
+   \brief A curve fitter implementing the Largest Triangle Three Buckets algorithm
+
+   The points are split into buckets of consecutive points and for each
+   bucket the point is selected, that forms the largest triangle with the
+   point selected for the previous bucket and the average of the next bucket.
+   In opposite to a min/max reduction the shape of noisy signals is
+   preserved without painting "fences".
+
+   The number of resulting points is driven by the width of the polygon:
+   as QwtPlotCurve applies the curve fitter to points in paint device
+   coordinates a curve of millions of points is reduced to pointsPerPixel()
+   points for each pixel - independent of the paint device. So it can also
+   be used, when exporting a plot to a vector format by QwtPlotRenderer.
+
+   QwtPlotCurve applies the fitter for the styles QwtPlotCurve::Lines,
+   QwtPlotCurve::Steps and QwtPlotCurve::Sticks, when QwtPlotCurve::Fitted
+   is enabled.
+
+   \code
+    curve->setCurveFitter( new QwtDownsamplingCurveFitter( 2.0 ) );
+    curve->setCurveAttribute( QwtPlotCurve::Fitted, true );
+   \endcode
+
+   \sa QwtWeedingCurveFitter, QwtPointMapper::WeedOutIntermediatePoints
+ */
+class QWT_EXPORT QwtDownsamplingCurveFitter : public QwtCurveFitter
+{
+  public:
+    //! Downsampling algorithm
+    enum Algorithm
+    {
+        /*!
+           The Largest Triangle Three Buckets algorithm ( LTTB ),
+           that processes all points.
+         */
+        LargestTriangleThreeBuckets,
+
+        /*!
+           The points are chosen from a preselection of the minimum
+           and maximum points of 2 bins for each bucket ( MinMaxLTTB ).
+           Extreme values are more likely to be kept, while
+           the LTTB step has to process a fraction of the points only.
+         */
+        MinMaxLargestTriangleThreeBuckets
+    };
+
+    explicit QwtDownsamplingCurveFitter( double pointsPerPixel = 2.0 );
+    virtual ~QwtDownsamplingCurveFitter();
+
+    void setAlgorithm( Algorithm );
+    Algorithm algorithm() const;
+
+    void setPointsPerPixel( double );
+    double pointsPerPixel() const;
+
+    virtual QPolygonF fitCurve( const QPolygonF& ) const QWT_OVERRIDE;
+    virtual QPainterPath fitCurvePath( const QPolygonF& ) const QWT_OVERRIDE;
+
+  private:
+    Algorithm m_algorithm;
+    double m_pointsPerPixel;
+};
+
+#endif
@@ -18,10 +18,18 @@ class QwtDynGridLayout::PrivateData
     PrivateData()
         : isDirty( true )
     {
+        resetResults();
     }
 
     void updateLayoutCache();
 
+    void resetResults()
+    {
+        columnsWidth = -1;
+        heightWidth = -1;
+        itemGeometries.clear();
+    }
+
     mutable QList< QLayoutItem* > itemList;
 
     uint maxColumns;
@@ -32,18 +40,36 @@ class QwtDynGridLayout::PrivateData
 
     bool isDirty;
     QVector< QSize > itemSizeHints;
+
+    // sum of the widths of the first n items
+    QVector< int > widthPrefix;
+
+    // results of the last calculations, valid until the next invalidate()
+    int columnsWidth;
+    uint columns;
+
+    int heightWidth;
+    int height;
+
+    QList< QRect > itemGeometries;
 };
 
 void QwtDynGridLayout::PrivateData::updateLayoutCache()
 {
     itemSizeHints.resize( itemList.count() );
+    widthPrefix.resize( itemList.count() + 1 );
+
+    widthPrefix[0] = 0;
 
     int index = 0;
 
     for ( QList< QLayoutItem* >::const_iterator it = itemList.constBegin();
         it != itemList.constEnd(); ++it, index++ )
     {
-        itemSizeHints[ index ] = ( *it )->sizeHint();
+        const QSize hint = ( *it )->sizeHint();
+
+        itemSizeHints[ index ] = hint;
+        widthPrefix[ index + 1 ] = widthPrefix[ index ] + qMax( hint.width(), 0 );
     }
 
     isDirty = false;
@@ -95,6 +121,8 @@ QwtDynGridLayout::~QwtDynGridLayout()
 void QwtDynGridLayout::invalidate()
 {
     m_data->isDirty = true;
+    m_data->resetResults();
+
     QLayout::invalidate();
 }
 
@@ -106,6 +134,7 @@ void QwtDynGridLayout::invalidate()
 void QwtDynGridLayout::setMaxColumns( uint maxColumns )
 {
     m_data->maxColumns = maxColumns;
+    m_data->resetResults();
 }
 
 /*!
@@ -175,6 +204,8 @@ QLayoutItem* QwtDynGridLayout::takeAt( int index )
         return NULL;
 
     m_data->isDirty = true;
+    m_data->resetResults();
+
     return m_data->itemList.takeAt( index );
 }
 
@@ -233,13 +264,23 @@ void QwtDynGridLayout::setGeometry( const QRect& rect )
 
     const QList< QRect > itemGeometries = layoutItems( rect, m_data->numColumns );
 
+    // for large legends most items keep their geometry, when
+    // the layout is resized. Those are not touched again.
+
+    const QList< QRect >& oldGeometries = m_data->itemGeometries;
+    const bool hasOldGeometries = ( oldGeometries.size() == itemGeometries.size() );
+
     int index = 0;
     for ( QList< QLayoutItem* >::const_iterator it = m_data->itemList.constBegin();
         it != m_data->itemList.constEnd(); ++it )
     {
-        ( *it )->setGeometry( itemGeometries[index] );
+        if ( !hasOldGeometries || oldGeometries[index] != itemGeometries[index] )
+            ( *it )->setGeometry( itemGeometries[index] );
+
         index++;
     }
+
+    m_data->itemGeometries = itemGeometries;
 }
 
 /*!
@@ -258,21 +299,48 @@ uint QwtDynGridLayout::columnsForWidth( int width ) const
     if ( isEmpty() )
         return 0;
 
+    if ( width == m_data->columnsWidth )
+        return m_data->columns;
+
     uint maxColumns = itemCount();
     if ( m_data->maxColumns > 0 )
         maxColumns = qMin( m_data->maxColumns, maxColumns );
 
-    if ( maxRowWidth( maxColumns ) <= width )
-        return maxColumns;
+    uint columns = 1; // At least 1 column
 
-    for ( uint numColumns = 2; numColumns <= maxColumns; numColumns++ )
+    if ( maxRowWidth( maxColumns, width ) <= width )
     {
-        const int rowWidth = maxRowWidth( numColumns );
-        if ( rowWidth > width )
-            return numColumns - 1;
+        columns = maxColumns;
     }
+    else
+    {
+        if ( m_data->isDirty )
+            m_data->updateLayoutCache();
 
-    return 1; // At least 1 column
+        const QMargins m = contentsMargins();
+
+        for ( uint numColumns = 2; numColumns <= maxColumns; numColumns++ )
+        {
+            /*
+                The items of the first row are a lower bound for the
+                width of a row. When they don't fit, there is no need
+                to check the other items.
+             */
+            const int minRowWidth = m.left() + m.right()
+                + ( numColumns - 1 ) * spacing() + m_data->widthPrefix[numColumns];
+
+            if ( minRowWidth > width || maxRowWidth( numColumns, width ) > width )
+            {
+                columns = numColumns - 1;
+                break;
+            }
+        }
+    }
+
+    m_data->columnsWidth = width;
+    m_data->columns = columns;
+
+    return columns;
 }
 
 /*!
@@ -280,32 +348,37 @@ uint QwtDynGridLayout::columnsForWidth( int width ) const
    columns.
 
    \param numColumns Given number of columns
-   \param itemWidth Array of the width hints for all items
+   \param maxWidth The calculation is aborted, as soon as the
+                   width exceeds maxWidth
+
+   \return Width of the layout, or a value > maxWidth
  */
-int QwtDynGridLayout::maxRowWidth( int numColumns ) const
+int QwtDynGridLayout::maxRowWidth( int numColumns, int maxWidth ) const
 {
-    int col;
-
-    QVector< int > colWidth( numColumns );
-    for ( col = 0; col < numColumns; col++ )
-        colWidth[col] = 0;
-
     if ( m_data->isDirty )
         m_data->updateLayoutCache();
 
+    const QMargins m = contentsMargins();
+
+    int rowWidth = m.left() + m.right() + ( numColumns - 1 ) * spacing();
+
+    QVector< int > colWidth( numColumns, 0 );
+
     for ( int index = 0;
         index < m_data->itemSizeHints.count(); index++ )
     {
-        col = index % numColumns;
-        colWidth[col] = qMax( colWidth[col],
-            m_data->itemSizeHints[index].width() );
-    }
+        const int col = index % numColumns;
+        const int w = m_data->itemSizeHints[index].width();
 
-    const QMargins m = contentsMargins();
+        if ( w > colWidth[col] )
+        {
+            rowWidth += w - colWidth[col];
+            colWidth[col] = w;
 
-    int rowWidth = m.left() + m.right() + ( numColumns - 1 ) * spacing();
-    for ( col = 0; col < numColumns; col++ )
-        rowWidth += colWidth[col];
+            if ( rowWidth > maxWidth )
+                break;
+        }
+    }
 
     return rowWidth;
 }
@@ -349,7 +422,7 @@ QList< QRect > QwtDynGridLayout::layoutItems( const QRect& rect,
         return itemGeometries;
 
     uint numRows = itemCount() / numColumns;
-    if ( numColumns % itemCount() )
+    if ( itemCount() % numColumns )
         numRows++;
 
     if ( numRows == 0 )
@@ -457,6 +530,9 @@ int QwtDynGridLayout::heightForWidth( int width ) const
     if ( isEmpty() )
         return 0;
 
+    if ( width == m_data->heightWidth )
+        return m_data->height;
+
     const uint numColumns = columnsForWidth( width );
     uint numRows = itemCount() / numColumns;
     if ( itemCount() % numColumns )
@@ -473,6 +549,9 @@ int QwtDynGridLayout::heightForWidth( int width ) const
     for ( uint row = 0; row < numRows; row++ )
         h += rowHeight[row];
 
+    m_data->heightWidth = width;
+    m_data->height = h;
+
     return h;
 }
 
@@ -75,7 +75,7 @@ class QWT_EXPORT QwtDynGridLayout : public QLayout
 
   private:
     void init();
-    int maxRowWidth( int numColumns ) const;
+    int maxRowWidth( int numColumns, int maxWidth ) const;
 
     class PrivateData;
     PrivateData* m_data;
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_frame_encoder.h"
+
+#include <qimage.h>
+#include <qimagewriter.h>
+#include <qstring.h>
+#include <qbytearray.h>
+
+//! Constructor
+QwtFrameEncoder::QwtFrameEncoder()
+{
+}
+
+//! Destructor
+QwtFrameEncoder::~QwtFrameEncoder()
+{
+}
+
+/*!
+   \brief Prepare the encoding
+
+   open() is called, before the first frame is encoded.
+   The default implementation does nothing.
+
+   \return true, when the encoder is ready for encoding frames
+ */
+bool QwtFrameEncoder::open()
+{
+    return true;
+}
+
+/*!
+   \brief Finish the encoding
+
+   close() is called after the last frame has been encoded.
+   The default implementation does nothing.
+ */
+void QwtFrameEncoder::close()
+{
+}
+
+class QwtImageSequenceEncoder::PrivateData
+{
+  public:
+    PrivateData()
+        : filePattern( "frame_%1.png" )
+        , format( "png" )
+        , quality( -1 )
+    {
+    }
+
+    QString filePattern;
+    QByteArray format;
+    int quality;
+};
+
+//! Constructor
+QwtImageSequenceEncoder::QwtImageSequenceEncoder()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtImageSequenceEncoder::~QwtImageSequenceEncoder()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the pattern for the file names
+
+   The "%1" of the pattern is replaced by the index of the frame,
+   padded with zeros to 6 digits. The default pattern is "frame_%1.png".
+
+   \param pattern File pattern
+   \sa filePattern(), fileName()
+ */
+void QwtImageSequenceEncoder::setFilePattern( const QString& pattern )
+{
+    m_data->filePattern = pattern;
+}
+
+/*!
+   \return Pattern for the file names
+   \sa setFilePattern(), fileName()
+ */
+QString QwtImageSequenceEncoder::filePattern() const
+{
+    return m_data->filePattern;
+}
+
+/*!
+   \brief Set the image format
+
+   The default format is "png"
+
+   \param format Image format, as supported by QImageWriter
+   \sa format(), QImageWriter::supportedImageFormats()
+ */
+void QwtImageSequenceEncoder::setFormat( const QByteArray& format )
+{
+    m_data->format = format;
+}
+
+/*!
+   \return Image format
+   \sa setFormat()
+ */
+QByteArray QwtImageSequenceEncoder::format() const
+{
+    return m_data->format;
+}
+
+/*!
+   \brief Set the quality of the image format
+
+   Lower values mean faster encoding, but larger files
+   for lossless formats. The default setting is -1, what means
+   the default of the image format.
+
+   \param quality Quality factor, see QImageWriter::setQuality()
+   \sa quality()
+ */
+void QwtImageSequenceEncoder::setQuality( int quality )
+{
+    m_data->quality = quality;
+}
+
+/*!
+   \return Quality of the image format
+   \sa setQuality()
+ */
+int QwtImageSequenceEncoder::quality() const
+{
+    return m_data->quality;
+}
+
+/*!
+   \return File name for a frame
+   \param frameIndex Index of the frame
+   \sa setFilePattern()
+ */
+QString QwtImageSequenceEncoder::fileName( int frameIndex ) const
+{
+    return m_data->filePattern.arg( frameIndex, 6, 10, QLatin1Char( '0' ) );
+}
+
+/*!
+   \brief Write a frame to a file
+
+   \param image Content of the canvas
+   \param frameIndex Index of the frame
+   \param timestamp Time in ms since the recording has been started
+
+   \return true, when the file has been written
+   \sa fileName()
+ */
+bool QwtImageSequenceEncoder::encode(
+    const QImage& image, int frameIndex, qint64 timestamp )
+{
+    Q_UNUSED( timestamp );
+
+    QImageWriter writer( fileName( frameIndex ), m_data->format );
+    writer.setQuality( m_data->quality );
+
+    return writer.write( image );
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_FRAME_ENCODER_H
+#define QWT_FRAME_ENCODER_H
+
+#include "qwt_global.h"
+
+class QImage;
+class QString;
+class QByteArray;
+
+/*!
+   \brief Abstract base class for encoding the frames of a QwtPlotRecorder
+
+   All methods are called from the encoder thread of the recorder.
+   An implementation might write image files, or pass the frames
+   to a video encoding library.
+
+   \sa QwtImageSequenceEncoder, QwtPlotRecorder::setEncoder()
+ */
+class QWT_EXPORT QwtFrameEncoder
+{
+  public:
+    QwtFrameEncoder();
+    virtual ~QwtFrameEncoder();
+
+    virtual bool open();
+
+    /*!
+       \brief Encode a frame
+
+       \param image Content of the canvas
+       \param frameIndex Index of the frame. Frames, that have been dropped
+                         by the recorder, leave gaps in the sequence.
+       \param timestamp Time in ms since the recording has been started
+
+       \return true, when the frame could be encoded
+     */
+    virtual bool encode( const QImage& image,
+        int frameIndex, qint64 timestamp ) = 0;
+
+    virtual void close();
+
+  private:
+    Q_DISABLE_COPY( QwtFrameEncoder )
+};
+
+/*!
+   \brief Encoder writing the frames as sequence of image files
+
+   The files are written by QImageWriter, where the file name is
+   built from a pattern and the index of the frame.
+
+   \par Example
+   \code
+   QwtImageSequenceEncoder* encoder = new QwtImageSequenceEncoder();
+   encoder->setFilePattern( "/tmp/frames/frame_%1.png" );
+
+   QwtPlotRecorder* recorder = new QwtPlotRecorder( plot );
+   recorder->setEncoder( encoder );
+   recorder->start( plot );
+   \endcode
+   \endpar
+ */
+class QWT_EXPORT QwtImageSequenceEncoder : public QwtFrameEncoder
+{
+  public:
+    QwtImageSequenceEncoder();
+    virtual ~QwtImageSequenceEncoder();
+
+    void setFilePattern( const QString& );
+    QString filePattern() const;
+
+    void setFormat( const QByteArray& );
+    QByteArray format() const;
+
+    void setQuality( int );
+    int quality() const;
+
+    QString fileName( int frameIndex ) const;
+
+    virtual bool encode( const QImage&,
+        int frameIndex, qint64 timestamp ) QWT_OVERRIDE;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
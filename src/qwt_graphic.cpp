@@ -17,6 +17,13 @@
 #include <qimage.h>
 #include <qpixmap.h>
 #include <qpainterpath.h>
+#include <qmath.h>
+#include <qatomic.h>
+#include <qfile.h>
+#include <qdatastream.h>
+
+#include <algorithm>
+#include <utility>
 
 #if QT_VERSION >= 0x050000
 
@@ -51,6 +58,79 @@ static bool qwtHasScalablePen( const QPainter* painter )
     return scalablePen;
 }
 
+static bool qwtIsMergeable( const QPainter* painter )
+{
+    if ( painter->compositionMode() != QPainter::CompositionMode_SourceOver
+        || painter->opacity() < 1.0 )
+    {
+        return false;
+    }
+
+    const QPen pen = painter->pen();
+    if ( pen.style() != Qt::NoPen )
+    {
+        // overlapping strokes are only invisible with opaque pens
+
+        if ( pen.style() != Qt::SolidLine
+            || pen.brush().style() != Qt::SolidPattern
+            || pen.color().alpha() < 255 )
+        {
+            return false;
+        }
+    }
+
+    const Qt::BrushStyle brushStyle = painter->brush().style();
+    return brushStyle == Qt::NoBrush || brushStyle == Qt::SolidPattern;
+}
+
+static bool qwtMergeState( QwtPainterCommand::StateData* to,
+    const QwtPainterCommand::StateData* from )
+{
+    // the order of clip operations matters
+
+    const QPaintEngine::DirtyFlags clipFlags = QPaintEngine::DirtyClipEnabled
+        | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath;
+
+    if ( ( to->flags & clipFlags ) || ( from->flags & clipFlags ) )
+        return false;
+
+    const QPaintEngine::DirtyFlags flags = from->flags;
+
+    if ( flags & QPaintEngine::DirtyPen )
+        to->pen = from->pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        to->brush = from->brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        to->brushOrigin = from->brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        to->font = from->font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        to->backgroundMode = from->backgroundMode;
+        to->backgroundBrush = from->backgroundBrush;
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        to->transform = from->transform;
+
+    if ( flags & QPaintEngine::DirtyHints )
+        to->renderHints = from->renderHints;
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        to->compositionMode = from->compositionMode;
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        to->opacity = from->opacity;
+
+    to->flags |= flags;
+
+    return true;
+}
+
 static QRectF qwtStrokedPathRect(
     const QPainter* painter, const QPainterPath& path )
 {
@@ -213,6 +293,389 @@ static inline void qwtExecCommand(
     }
 }
 
+static const quint32 qwtFileMagic = 0x51574721;
+static const quint32 qwtFileVersion = 1;
+
+static void qwtWriteState( QDataStream& stream,
+    const QwtPainterCommand::StateData* data )
+{
+    const QPaintEngine::DirtyFlags flags = data->flags;
+
+    stream << quint32( flags );
+
+    if ( flags & QPaintEngine::DirtyPen )
+        stream << data->pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        stream << data->brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        stream << data->brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        stream << data->font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+        stream << qint32( data->backgroundMode ) << data->backgroundBrush;
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        stream << data->transform;
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        stream << data->isClipEnabled;
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+        stream << qint32( data->clipOperation ) << data->clipRegion;
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+        stream << qint32( data->clipOperation ) << data->clipPath;
+
+    if ( flags & QPaintEngine::DirtyHints )
+        stream << quint32( data->renderHints );
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        stream << qint32( data->compositionMode );
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        stream << double( data->opacity );
+}
+
+static void qwtReadState( QDataStream& stream,
+    QwtPainterCommand::StateData& data )
+{
+    quint32 flags;
+    stream >> flags;
+
+    data.flags = QPaintEngine::DirtyFlags( int( flags ) );
+    data.backgroundMode = Qt::TransparentMode;
+    data.clipOperation = Qt::NoClip;
+    data.isClipEnabled = false;
+    data.compositionMode = QPainter::CompositionMode_SourceOver;
+    data.opacity = 1.0;
+
+    qint32 value;
+
+    if ( flags & QPaintEngine::DirtyPen )
+        stream >> data.pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        stream >> data.brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        stream >> data.brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        stream >> data.font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        stream >> value >> data.backgroundBrush;
+        data.backgroundMode = static_cast< Qt::BGMode >( value );
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        stream >> data.transform;
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        stream >> data.isClipEnabled;
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+    {
+        stream >> value >> data.clipRegion;
+        data.clipOperation = static_cast< Qt::ClipOperation >( value );
+    }
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+    {
+        stream >> value >> data.clipPath;
+        data.clipOperation = static_cast< Qt::ClipOperation >( value );
+    }
+
+    if ( flags & QPaintEngine::DirtyHints )
+    {
+        quint32 hints;
+        stream >> hints;
+        data.renderHints = QPainter::RenderHints( int( hints ) );
+    }
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+    {
+        stream >> value;
+        data.compositionMode = static_cast< QPainter::CompositionMode >( value );
+    }
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+    {
+        double opacity;
+        stream >> opacity;
+        data.opacity = opacity;
+    }
+}
+
+static inline bool qwtIntersects( const QRectF& r1, const QRectF& r2 )
+{
+    // unlike QRectF::intersects rectangles with a width or height
+    // of 0 - like horizontal/vertical lines - are accepted
+
+    return ( r1.left() <= r2.right() ) && ( r1.right() >= r2.left() )
+        && ( r1.top() <= r2.bottom() ) && ( r1.bottom() >= r2.top() );
+}
+
+static bool qwtCullingRect( const QPainter* painter,
+    qreal margin, QRectF& cullingRect )
+{
+    if ( painter->viewTransformEnabled() )
+        return false;
+
+    const QTransform transform = painter->transform();
+    if ( !transform.isInvertible() )
+        return false;
+
+    QRectF deviceRect;
+
+    if ( painter->hasClipping() )
+    {
+        deviceRect = transform.mapRect( painter->clipBoundingRect() );
+    }
+    else
+    {
+        const QPaintDevice* device = painter->device();
+        if ( device == NULL )
+            return false;
+
+        switch( device->devType() )
+        {
+            case QInternal::Widget:
+            case QInternal::Pixmap:
+            case QInternal::Image:
+            {
+                deviceRect = QRectF( 0.0, 0.0,
+                    device->width(), device->height() );
+                break;
+            }
+            default:
+            {
+                // we can't be sure about the visible area of
+                // printers, pictures or other vector devices
+                return false;
+            }
+        }
+    }
+
+    deviceRect.adjust( -margin, -margin, margin, margin );
+    cullingRect = transform.inverted().mapRect( deviceRect );
+
+    return true;
+}
+
+namespace
+{
+    // below this number of commands the index doesn't pay off
+    const int qwtMinIndexedCommands = 1000;
+
+    /*
+        A uniform grid over the bounding rectangle of the graphic. Each cell
+        stores the indexes of the path/pixmap/image commands intersecting it.
+        State commands and commands covering a large part of the graphic
+        are candidates for any area.
+     */
+    class QwtGraphicIndex
+    {
+      public:
+        QwtGraphicIndex( const QVector< QwtPainterCommand >& commands,
+            const QVector< QRectF >& commandRects, const QRectF& rect )
+            : m_rect( rect )
+        {
+            int numDrawCommands = 0;
+            for ( int i = 0; i < commands.size(); i++ )
+            {
+                if ( commands[i].type() != QwtPainterCommand::State )
+                    numDrawCommands++;
+            }
+
+            const int n = qBound( 1, int( qSqrt( numDrawCommands / 8.0 ) ), 256 );
+
+            m_numCols = ( m_rect.width() > 0.0 ) ? n : 1;
+            m_numRows = ( m_rect.height() > 0.0 ) ? n : 1;
+
+            const int numCells = m_numCols * m_numRows;
+
+            QVector< int > counts( numCells + 1, 0 );
+
+            for ( int pass = 0; pass < 2; pass++ )
+            {
+                for ( int i = 0; i < commands.size(); i++ )
+                {
+                    if ( commands[i].type() == QwtPainterCommand::State )
+                    {
+                        if ( pass == 0 )
+                            m_commonCommands += i;
+
+                        continue;
+                    }
+
+                    const QRectF& r = commandRects[i];
+                    if ( r.isNull() )
+                        continue; // empty paths: nothing to paint
+
+                    int col0, col1, row0, row1;
+                    cellRange( r, col0, col1, row0, row1 );
+
+                    const int numCellsCovered = ( col1 - col0 + 1 ) * ( row1 - row0 + 1 );
+                    if ( numCellsCovered > qMax( numCells / 4, 1 ) )
+                    {
+                        if ( pass == 0 )
+                            m_commonCommands += i;
+
+                        continue;
+                    }
+
+                    for ( int row = row0; row <= row1; row++ )
+                    {
+                        for ( int col = col0; col <= col1; col++ )
+                        {
+                            const int cell = row * m_numCols + col;
+
+                            if ( pass == 0 )
+                                counts[cell + 1]++;
+                            else
+                                m_cellCommands[ m_cellOffsets[cell] + counts[cell]++ ] = i;
+                        }
+                    }
+                }
+
+                if ( pass == 0 )
+                {
+                    m_cellOffsets.resize( numCells + 1 );
+                    m_cellOffsets[0] = 0;
+                    for ( int cell = 0; cell < numCells; cell++ )
+                        m_cellOffsets[cell + 1] = m_cellOffsets[cell] + counts[cell + 1];
+
+                    m_cellCommands.resize( m_cellOffsets[numCells] );
+                    counts.fill( 0 );
+                }
+            }
+        }
+
+        // indexes of the commands, that might intersect rect - in
+        // increasing order
+        QVector< int > candidates( const QRectF& rect ) const
+        {
+            QVector< int > indexes;
+
+            if ( qwtIntersects( rect, m_rect ) )
+            {
+                int col0, col1, row0, row1;
+                cellRange( rect, col0, col1, row0, row1 );
+
+                for ( int row = row0; row <= row1; row++ )
+                {
+                    for ( int col = col0; col <= col1; col++ )
+                    {
+                        const int cell = row * m_numCols + col;
+                        for ( int i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; i++ )
+                            indexes += m_cellCommands[i];
+                    }
+                }
+
+                std::sort( indexes.begin(), indexes.end() );
+                indexes.erase( std::unique( indexes.begin(), indexes.end() ), indexes.end() );
+            }
+
+            QVector< int > merged( indexes.size() + m_commonCommands.size() );
+            std::merge( indexes.constBegin(), indexes.constEnd(),
+                m_commonCommands.constBegin(), m_commonCommands.constEnd(),
+                merged.begin() );
+
+            return merged;
+        }
+
+      private:
+        void cellRange( const QRectF& rect,
+            int& col0, int& col1, int& row0, int& row1 ) const
+        {
+            const double sx = ( m_rect.width() > 0.0 ) ? m_numCols / m_rect.width() : 0.0;
+            const double sy = ( m_rect.height() > 0.0 ) ? m_numRows / m_rect.height() : 0.0;
+
+            col0 = qBound( 0, int( ( rect.left() - m_rect.left() ) * sx ), m_numCols - 1 );
+            col1 = qBound( 0, int( ( rect.right() - m_rect.left() ) * sx ), m_numCols - 1 );
+            row0 = qBound( 0, int( ( rect.top() - m_rect.top() ) * sy ), m_numRows - 1 );
+            row1 = qBound( 0, int( ( rect.bottom() - m_rect.top() ) * sy ), m_numRows - 1 );
+        }
+
+        QRectF m_rect;
+        int m_numCols;
+        int m_numRows;
+
+        QVector< int > m_cellOffsets;
+        QVector< int > m_cellCommands;
+        QVector< int > m_commonCommands;
+    };
+
+    /*
+        The index is built lazily, when rendering the first time. As a graphic
+        might be rendered from different threads at the same time
+        ( f.e. the tiles of QwtPlotGraphicItem ) it is published atomically.
+        Copies of the graphic build their own index.
+     */
+    class QwtGraphicIndexHolder
+    {
+      public:
+        QwtGraphicIndexHolder()
+        {
+        }
+
+        QwtGraphicIndexHolder( const QwtGraphicIndexHolder& )
+        {
+        }
+
+        ~QwtGraphicIndexHolder()
+        {
+            reset();
+        }
+
+        QwtGraphicIndexHolder& operator=( const QwtGraphicIndexHolder& )
+        {
+            reset();
+            return *this;
+        }
+
+        void reset()
+        {
+            delete m_index.fetchAndStoreOrdered( NULL );
+        }
+
+        const QwtGraphicIndex* index( const QVector< QwtPainterCommand >& commands,
+            const QVector< QRectF >& commandRects, const QRectF& rect ) const
+        {
+#if QT_VERSION >= 0x050000
+            QwtGraphicIndex* index = m_index.loadAcquire();
+#else
+            QwtGraphicIndex* index = m_index;
+#endif
+            if ( index == NULL )
+            {
+                index = new QwtGraphicIndex( commands, commandRects, rect );
+                if ( !m_index.testAndSetOrdered( NULL, index ) )
+                {
+                    // another thread has been faster
+                    delete index;
+#if QT_VERSION >= 0x050000
+                    index = m_index.loadAcquire();
+#else
+                    index = m_index;
+#endif
+                }
+            }
+
+            return index;
+        }
+
+      private:
+        mutable QAtomicPointer< QwtGraphicIndex > m_index;
+    };
+}
+
 class QwtGraphic::PathInfo
 {
   public:
@@ -230,6 +693,21 @@ class QwtGraphic::PathInfo
     {
     }
 
+    inline QRectF pointRect() const
+    {
+        return m_pointRect;
+    }
+
+    inline QRectF boundingRect() const
+    {
+        return m_boundingRect;
+    }
+
+    inline bool hasScalablePen() const
+    {
+        return m_scalablePen;
+    }
+
     inline QRectF scaledBoundingRect( qreal sx, qreal sy, bool scalePens ) const
     {
         if ( sx == 1.0 && sy == 1.0 )
@@ -332,6 +810,11 @@ class QwtGraphic::PrivateData
     PrivateData()
         : boundingRect( 0.0, 0.0, -1.0, -1.0 )
         , pointRect( 0.0, 0.0, -1.0, -1.0 )
+        , penMargin( 0.0 )
+        , storeCommands( true )
+        , mergeablePath( -1 )
+        , hasPen( false )
+        , hasBrush( false )
     {
     }
 
@@ -339,11 +822,31 @@ class QwtGraphic::PrivateData
     QVector< QwtPainterCommand > commands;
     QVector< QwtGraphic::PathInfo > pathInfos;
 
+    // the area being affected by a command - in the coordinates
+    // of the graphic. Used for skipping invisible commands.
+    QVector< QRectF > commandRects;
+    qreal penMargin;
+
+    QwtGraphicIndexHolder index;
+
     QRectF boundingRect;
     QRectF pointRect;
 
     QwtGraphic::CommandTypes commandTypes;
     QwtGraphic::RenderHints renderHints;
+    QwtGraphic::RecordingFlags recordingFlags;
+
+    // false, when replaying commands, that are moved afterwards
+    bool storeCommands;
+
+    // index of the last path command, that can be extended
+    int mergeablePath;
+
+    // last recorded pen/brush for dropping redundant state changes
+    bool hasPen;
+    bool hasBrush;
+    QPen pen;
+    QBrush brush;
 };
 
 /*!
@@ -367,6 +870,7 @@ QwtGraphic::QwtGraphic()
 QwtGraphic::QwtGraphic( const QwtGraphic& other )
 {
     setMode( other.mode() );
+    setMeasureOnly( other.isMeasureOnly() );
     m_data = new PrivateData( *other.m_data );
 }
 
@@ -385,6 +889,7 @@ QwtGraphic::~QwtGraphic()
 QwtGraphic& QwtGraphic::operator=( const QwtGraphic& other )
 {
     setMode( other.mode() );
+    setMeasureOnly( other.isMeasureOnly() );
     *m_data = *other.m_data;
 
     return *this;
@@ -398,6 +903,12 @@ void QwtGraphic::reset()
 {
     m_data->commands.clear();
     m_data->pathInfos.clear();
+    m_data->commandRects.clear();
+    m_data->penMargin = 0.0;
+    m_data->index.reset();
+
+    m_data->mergeablePath = -1;
+    m_data->hasPen = m_data->hasBrush = false;
 
     m_data->commandTypes = CommandTypes();
 
@@ -466,6 +977,40 @@ QwtGraphic::RenderHints QwtGraphic::renderHints() const
     return m_data->renderHints;
 }
 
+/*!
+   Toggle a recording flag
+
+   The flags affect the commands, that are recorded
+   from now on. Commands, that have already been recorded
+   are not modified.
+
+   \param flag Recording flag
+   \param on true/false
+
+   \sa testRecordingFlag(), RecordingFlag
+ */
+void QwtGraphic::setRecordingFlag( RecordingFlag flag, bool on )
+{
+    if ( on )
+        m_data->recordingFlags |= flag;
+    else
+        m_data->recordingFlags &= ~flag;
+
+    m_data->mergeablePath = -1;
+}
+
+/*!
+   Test a recording flag
+
+   \param flag Recording flag
+   \return true/false
+   \sa setRecordingFlag(), RecordingFlag
+ */
+bool QwtGraphic::testRecordingFlag( RecordingFlag flag ) const
+{
+    return m_data->recordingFlags.testFlag( flag );
+}
+
 /*!
    The bounding rectangle is the controlPointRect()
    extended by the areas needed for rendering the outlines
@@ -633,14 +1178,67 @@ void QwtGraphic::renderGraphic( QPainter* painter, QTransform* initialTransform
 
     const int numCommands = m_data->commands.size();
     const QwtPainterCommand* commands = m_data->commands.constData();
+    const QRectF* commandRects = m_data->commandRects.constData();
 
     const QTransform transform = painter->transform();
 
+    /*
+        Commands, that don't affect the visible area of the paint device
+        can be skipped. As outlines of unscaled pens might be wider
+        than in the coordinates of the graphic we add the widest pen
+        padding ( + 1 pixel for antialiasing ) as margin.
+     */
+    QRectF cullingRect;
+    const bool doCull = qwtCullingRect( painter,
+        m_data->penMargin + 1.0, cullingRect );
+
     painter->save();
 
+    if ( doCull && numCommands >= qwtMinIndexedCommands )
+    {
+        const QRectF& br = m_data->boundingRect;
+
+        const QRectF r = cullingRect & br;
+        if ( r.width() * r.height() < 0.25 * br.width() * br.height() )
+        {
+            // only a small part of the graphic is visible
+
+            const QwtGraphicIndex* index = m_data->index.index(
+                m_data->commands, m_data->commandRects, br );
+
+            const QVector< int > candidates = index->candidates( cullingRect );
+
+            for ( int i = 0; i < candidates.size(); i++ )
+            {
+                const int pos = candidates[i];
+                const QwtPainterCommand& cmd = commands[pos];
+
+                if ( cmd.type() != QwtPainterCommand::State )
+                {
+                    if ( !qwtIntersects( commandRects[pos], cullingRect ) )
+                        continue;
+                }
+
+                qwtExecCommand( painter, cmd,
+                    m_data->renderHints, transform, initialTransform );
+            }
+
+            painter->restore();
+            return;
+        }
+    }
+
     for ( int i = 0; i < numCommands; i++ )
     {
-        qwtExecCommand( painter, commands[i],
+        const QwtPainterCommand& cmd = commands[i];
+
+        if ( doCull && cmd.type() != QwtPainterCommand::State )
+        {
+            if ( !qwtIntersects( commandRects[i], cullingRect ) )
+                continue;
+        }
+
+        qwtExecCommand( painter, cmd,
             m_data->renderHints, transform, initialTransform );
     }
 
@@ -987,10 +1585,27 @@ void QwtGraphic::drawPath( const QPainterPath& path )
     if ( painter == NULL )
         return;
 
-    m_data->commands += QwtPainterCommand( path );
+    const bool isRecording = !isMeasureOnly();
+
     m_data->commandTypes |= QwtGraphic::VectorData;
 
-    if ( !path.isEmpty() )
+    if ( isRecording )
+        m_data->index.reset();
+
+    if ( path.isEmpty() )
+    {
+        if ( isRecording )
+        {
+            if ( m_data->storeCommands )
+            {
+                m_data->commands += QwtPainterCommand( path );
+                m_data->mergeablePath = -1;
+            }
+
+            m_data->commandRects += QRectF();
+        }
+    }
+    else
     {
         const QPainterPath scaledPath = painter->transform().map( path );
 
@@ -1006,9 +1621,77 @@ void QwtGraphic::drawPath( const QPainterPath& path )
         updateControlPointRect( pointRect );
         updateBoundingRect( boundingRect );
 
-        m_data->pathInfos += PathInfo( pointRect,
-            boundingRect, qwtHasScalablePen( painter ) );
+        if ( isRecording
+            && !mergePath( painter, path, pointRect, boundingRect ) )
+        {
+            if ( m_data->storeCommands )
+            {
+                m_data->commands += QwtPainterCommand( path );
+
+                m_data->mergeablePath = -1;
+                if ( ( m_data->recordingFlags & CompactCommands )
+                    && qwtIsMergeable( painter ) )
+                {
+                    m_data->mergeablePath = m_data->commands.size() - 1;
+                }
+            }
+
+            m_data->pathInfos += PathInfo( pointRect,
+                boundingRect, qwtHasScalablePen( painter ) );
+
+            m_data->commandRects += boundingRect;
+        }
+
+        const qreal margin = qwtMaxF(
+            qwtMaxF( pointRect.left() - boundingRect.left(),
+                boundingRect.right() - pointRect.right() ),
+            qwtMaxF( pointRect.top() - boundingRect.top(),
+                boundingRect.bottom() - pointRect.bottom() ) );
+
+        m_data->penMargin = qwtMaxF( m_data->penMargin, margin );
+    }
+}
+
+/*
+   Append a path to the previous path command, when painting
+   both paths at once gives the same result as painting them
+   one after the other.
+ */
+bool QwtGraphic::mergePath( const QPainter* painter, const QPainterPath& path,
+    const QRectF& pointRect, const QRectF& boundingRect )
+{
+    const int index = m_data->mergeablePath;
+
+    if ( index < 0 || index != m_data->commands.size() - 1 )
+        return false;
+
+    // no state command since the last path: the painter state is the same
+
+    QPainterPath* mergedPath = m_data->commands[index].path();
+    if ( mergedPath == NULL || mergedPath->fillRule() != path.fillRule() )
+        return false;
+
+    PathInfo& info = m_data->pathInfos.last();
+
+    if ( painter->brush().style() != Qt::NoBrush )
+    {
+        /*
+            overlapping fills would be combined by the fill rule
+            and the outline of the previous path would be painted
+            on top of the fill of the new path
+         */
+        if ( info.boundingRect().intersects( boundingRect ) )
+            return false;
     }
+
+    mergedPath->addPath( path );
+
+    info = PathInfo( info.pointRect() | pointRect,
+        info.boundingRect() | boundingRect, info.hasScalablePen() );
+
+    m_data->commandRects[index] |= boundingRect;
+
+    return true;
 }
 
 /*!
@@ -1027,10 +1710,23 @@ void QwtGraphic::drawPixmap( const QRectF& rect,
     if ( painter == NULL )
         return;
 
-    m_data->commands += QwtPainterCommand( rect, pixmap, subRect );
     m_data->commandTypes |= QwtGraphic::RasterData;
 
     const QRectF r = painter->transform().mapRect( rect );
+
+    if ( !isMeasureOnly() )
+    {
+        m_data->index.reset();
+
+        if ( m_data->storeCommands )
+        {
+            m_data->commands += QwtPainterCommand( rect, pixmap, subRect );
+            m_data->mergeablePath = -1;
+        }
+
+        m_data->commandRects += r;
+    }
+
     updateControlPointRect( r );
     updateBoundingRect( r );
 }
@@ -1052,11 +1748,23 @@ void QwtGraphic::drawImage( const QRectF& rect, const QImage& image,
     if ( painter == NULL )
         return;
 
-    m_data->commands += QwtPainterCommand( rect, image, subRect, flags );
     m_data->commandTypes |= QwtGraphic::RasterData;
 
     const QRectF r = painter->transform().mapRect( rect );
 
+    if ( !isMeasureOnly() )
+    {
+        m_data->index.reset();
+
+        if ( m_data->storeCommands )
+        {
+            m_data->commands += QwtPainterCommand( rect, image, subRect, flags );
+            m_data->mergeablePath = -1;
+        }
+
+        m_data->commandRects += r;
+    }
+
     updateControlPointRect( r );
     updateBoundingRect( r );
 }
@@ -1069,7 +1777,8 @@ void QwtGraphic::drawImage( const QRectF& rect, const QImage& image,
  */
 void QwtGraphic::updateState( const QPaintEngineState& state )
 {
-    m_data->commands += QwtPainterCommand( state );
+    if ( !isMeasureOnly() && m_data->storeCommands )
+        recordState( state );
 
     if ( state.state() & QPaintEngine::DirtyTransform )
     {
@@ -1086,6 +1795,54 @@ void QwtGraphic::updateState( const QPaintEngineState& state )
     }
 }
 
+void QwtGraphic::recordState( const QPaintEngineState& state )
+{
+    const bool compact = m_data->recordingFlags & CompactCommands;
+
+    QPaintEngine::DirtyFlags flags = state.state();
+
+    if ( flags & QPaintEngine::DirtyPen )
+    {
+        if ( compact && m_data->hasPen && state.pen() == m_data->pen )
+            flags &= ~QPaintEngine::DirtyPen;
+
+        m_data->pen = state.pen();
+        m_data->hasPen = true;
+    }
+
+    if ( flags & QPaintEngine::DirtyBrush )
+    {
+        if ( compact && m_data->hasBrush && state.brush() == m_data->brush )
+            flags &= ~QPaintEngine::DirtyBrush;
+
+        m_data->brush = state.brush();
+        m_data->hasBrush = true;
+    }
+
+    if ( !flags )
+        return;
+
+    m_data->index.reset();
+    m_data->mergeablePath = -1;
+
+    QwtPainterCommand command( state );
+    command.stateData()->flags = flags;
+
+    if ( compact && !m_data->commands.isEmpty() )
+    {
+        QwtPainterCommand& last = m_data->commands.last();
+
+        if ( last.type() == QwtPainterCommand::State
+            && qwtMergeState( last.stateData(), command.stateData() ) )
+        {
+            return;
+        }
+    }
+
+    m_data->commands += command;
+    m_data->commandRects += QRectF();
+}
+
 void QwtGraphic::updateBoundingRect( const QRectF& rect )
 {
     QRectF br = rect;
@@ -1150,3 +1907,286 @@ void QwtGraphic::setCommands( const QVector< QwtPainterCommand >& commands )
 
     painter.end();
 }
+
+#ifdef Q_COMPILER_RVALUE_REFS
+
+/*!
+   \brief Append paint commands
+
+   Like setCommands( const QVector< QwtPainterCommand >& ), but
+   the commands are moved instead of being copied, when
+   CompactCommands is not enabled.
+
+   \param commands Paint commands
+   \sa commands()
+ */
+void QwtGraphic::setCommands( QVector< QwtPainterCommand >&& commands )
+{
+    if ( m_data->recordingFlags & CompactCommands )
+    {
+        // the commands will be modified
+        setCommands( static_cast< const QVector< QwtPainterCommand >& >( commands ) );
+        return;
+    }
+
+    reset();
+
+    const int numCommands = commands.size();
+    if ( numCommands <= 0 )
+        return;
+
+    /*
+        The commands are replayed for calculating the bounding
+        rectangles only, but are not stored. Finally the
+        vector is taken over.
+     */
+
+    const QwtPainterCommand* cmds = commands.constData();
+
+    const QTransform noTransform;
+    const RenderHints noRenderHints;
+
+    m_data->storeCommands = false;
+    m_data->commandRects.reserve( numCommands );
+
+    QPainter painter( this );
+    for ( int i = 0; i < numCommands; i++ )
+    {
+        qwtExecCommand( &painter, cmds[i], noRenderHints, noTransform, NULL );
+
+        // state commands, empty paths or null pixmaps don't reach the engine
+        while ( m_data->commandRects.size() <= i )
+            m_data->commandRects += QRectF();
+    }
+
+    painter.end();
+
+    m_data->storeCommands = true;
+    m_data->commands = std::move( commands );
+}
+
+#endif
+
+/*!
+   \brief Save the graphic to a file
+
+   The recorded commands are stored together with the bounding rectangles,
+   that have been calculated when recording. So load() doesn't need to
+   replay the commands like setCommands().
+
+   \param fileName Name of the file
+   \return true, when the graphic could be written
+   \sa load()
+ */
+bool QwtGraphic::save( const QString& fileName ) const
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly ) )
+        return false;
+
+    QDataStream stream( &file );
+    stream.setVersion( QDataStream::Qt_4_8 );
+
+    stream << qwtFileMagic << qwtFileVersion;
+
+    const PrivateData* d = m_data;
+
+    stream << d->defaultSize << d->boundingRect << d->pointRect
+        << double( d->penMargin ) << quint32( d->commandTypes )
+        << quint32( d->renderHints );
+
+    stream << qint32( d->commands.size() );
+
+    for ( int i = 0; i < d->commands.size(); i++ )
+    {
+        const QwtPainterCommand& cmd = d->commands[i];
+
+        stream << qint32( cmd.type() ) << d->commandRects[i];
+
+        switch( cmd.type() )
+        {
+            case QwtPainterCommand::Path:
+            {
+                stream << *cmd.path();
+                break;
+            }
+            case QwtPainterCommand::Pixmap:
+            {
+                const QwtPainterCommand::PixmapData* data = cmd.pixmapData();
+                stream << data->rect << data->pixmap << data->subRect;
+                break;
+            }
+            case QwtPainterCommand::Image:
+            {
+                const QwtPainterCommand::ImageData* data = cmd.imageData();
+                stream << data->rect << data->image << data->subRect
+                    << quint32( data->flags );
+                break;
+            }
+            case QwtPainterCommand::State:
+            {
+                qwtWriteState( stream, cmd.stateData() );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    stream << qint32( d->pathInfos.size() );
+
+    for ( int i = 0; i < d->pathInfos.size(); i++ )
+    {
+        const PathInfo& info = d->pathInfos[i];
+        stream << info.pointRect() << info.boundingRect() << info.hasScalablePen();
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+/*!
+   \brief Load a graphic, that has been written by save()
+
+   The file is mapped into memory and the commands are read
+   directly from the mapped pages.
+
+   \param fileName Name of the file
+   \return true, when the graphic could be loaded. Otherwise
+           the graphic is reset.
+   \sa save()
+ */
+bool QwtGraphic::load( const QString& fileName )
+{
+    reset();
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 size = file.size();
+
+    uchar* mapped = file.map( 0, size );
+
+    QByteArray bytes;
+    if ( mapped )
+        bytes = QByteArray::fromRawData( reinterpret_cast< const char* >( mapped ), size );
+    else
+        bytes = file.readAll();
+
+    bool ok = false;
+
+    {
+        QDataStream stream( bytes );
+        stream.setVersion( QDataStream::Qt_4_8 );
+
+        quint32 magic, version;
+        stream >> magic >> version;
+
+        if ( magic == qwtFileMagic && version == qwtFileVersion )
+        {
+            PrivateData* d = m_data;
+
+            double penMargin;
+            quint32 commandTypes, renderHints;
+            qint32 numCommands;
+
+            stream >> d->defaultSize >> d->boundingRect >> d->pointRect
+                >> penMargin >> commandTypes >> renderHints >> numCommands;
+
+            d->penMargin = penMargin;
+            d->commandTypes = CommandTypes( int( commandTypes ) );
+            d->renderHints = RenderHints( int( renderHints ) );
+
+            // each command needs at least its type and rectangle
+            ok = ( stream.status() == QDataStream::Ok )
+                && numCommands >= 0 && numCommands <= size / 36;
+
+            if ( ok )
+            {
+                d->commands.reserve( numCommands );
+                d->commandRects.reserve( numCommands );
+            }
+
+            for ( int i = 0; ok && i < numCommands; i++ )
+            {
+                qint32 type;
+                QRectF rect;
+
+                stream >> type >> rect;
+
+                switch( type )
+                {
+                    case QwtPainterCommand::Path:
+                    {
+                        QPainterPath path;
+                        stream >> path;
+
+                        d->commands += QwtPainterCommand( path );
+                        break;
+                    }
+                    case QwtPainterCommand::Pixmap:
+                    {
+                        QRectF targetRect, subRect;
+                        QPixmap pixmap;
+
+                        stream >> targetRect >> pixmap >> subRect;
+                        d->commands += QwtPainterCommand( targetRect, pixmap, subRect );
+                        break;
+                    }
+                    case QwtPainterCommand::Image:
+                    {
+                        QRectF targetRect, subRect;
+                        QImage image;
+                        quint32 flags;
+
+                        stream >> targetRect >> image >> subRect >> flags;
+                        d->commands += QwtPainterCommand( targetRect, image, subRect,
+                            Qt::ImageConversionFlags( int( flags ) ) );
+                        break;
+                    }
+                    case QwtPainterCommand::State:
+                    {
+                        QwtPainterCommand::StateData data;
+                        qwtReadState( stream, data );
+
+                        d->commands += QwtPainterCommand( data );
+                        break;
+                    }
+                    default:
+                        ok = false;
+                }
+
+                d->commandRects += rect;
+                ok = ok && ( stream.status() == QDataStream::Ok );
+            }
+
+            qint32 numPathInfos = -1;
+            if ( ok )
+                stream >> numPathInfos;
+
+            ok = ok && numPathInfos >= 0 && numPathInfos <= numCommands;
+
+            for ( int i = 0; ok && i < numPathInfos; i++ )
+            {
+                QRectF pointRect, boundingRect;
+                bool scalablePen;
+
+                stream >> pointRect >> boundingRect >> scalablePen;
+                d->pathInfos += PathInfo( pointRect, boundingRect, scalablePen );
+            }
+
+            ok = ok && ( stream.status() == QDataStream::Ok );
+        }
+    }
+
+    // the commands must not refer to the mapped memory anymore
+    bytes = QByteArray();
+
+    if ( mapped )
+        file.unmap( mapped );
+
+    if ( !ok )
+        reset();
+
+    return ok;
+}
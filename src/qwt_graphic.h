@@ -18,6 +18,7 @@
 class QwtPainterCommand;
 class QPixmap;
 class QImage;
+class QString;
 
 /*!
     \brief A paint device for scalable graphics
@@ -70,6 +71,27 @@ class QImage;
     scaling with a fixed aspect ratio always needs to be calculated from the
     control point rectangle.
 
+    For each painter command QwtGraphic also stores the area that is
+    affected in coordinates of the graphic. When rendering on a paint
+    device with a known visible area - the clip rectangle or the
+    size of a widget, pixmap or image - commands outside of this area
+    are skipped. So rendering a small section of a large map
+    ( f.e. when zooming in ) is much faster than rendering all of it.
+    State commands ( pen, brush, transformation ... ) are always replayed.
+    For graphics with many commands a grid index is built, so that the
+    costs for rendering a small section don't depend on the number of
+    invisible commands.
+
+    When a graphic is measure-only ( QwtNullPaintDevice::setMeasureOnly() )
+    no commands are stored and only the rectangles and the command types
+    are updated. Then paint code might skip expensive operations
+    ( see QwtPainter::isMeasureOnly() ), so that the geometry
+    of an item can be calculated cheaply.
+
+    Recorded graphics can be stored in a binary format by save() - f.e.
+    for SVG maps, that take long to be parsed by QSvgRenderer - and
+    are loaded fast from a memory mapped file by load().
+
     \sa QwtPainterCommand
  */
 class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
@@ -116,6 +138,31 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
     Q_DECLARE_FLAGS( CommandTypes, CommandType )
 
+    /*!
+        Flags affecting how painter commands are recorded
+        \sa setRecordingFlag(), testRecordingFlag()
+     */
+    enum RecordingFlag
+    {
+        /*!
+           Compact the commands while recording:
+
+           - consecutive paths with the same painter state are merged
+             into one path, when the result can't be distinguished
+             from painting them one by one: solid and opaque pens, no
+             brush or a solid brush for paths, that don't overlap
+           - consecutive state commands are merged into one
+           - pen or brush changes to the values, that are already
+             active, are dropped
+
+           Compacting is useful for graphics with many small paths
+           like symbols or icons, that are replayed often.
+         */
+        CompactCommands = 0x1
+    };
+
+    Q_DECLARE_FLAGS( RecordingFlags, RecordingFlag )
+
     QwtGraphic();
     QwtGraphic( const QwtGraphic& );
 
@@ -161,6 +208,13 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
     const QVector< QwtPainterCommand >& commands() const;
     void setCommands( const QVector< QwtPainterCommand >& );
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    void setCommands( QVector< QwtPainterCommand >&& );
+#endif
+
+    bool save( const QString& fileName ) const;
+    bool load( const QString& fileName );
+
     void setDefaultSize( const QSizeF& );
     QSizeF defaultSize() const;
 
@@ -172,6 +226,9 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
     RenderHints renderHints() const;
 
+    void setRecordingFlag( RecordingFlag, bool on = true );
+    bool testRecordingFlag( RecordingFlag ) const;
+
   protected:
     virtual QSize sizeMetrics() const QWT_OVERRIDE;
 
@@ -191,6 +248,10 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
     void updateBoundingRect( const QRectF& );
     void updateControlPointRect( const QRectF& );
 
+    bool mergePath( const QPainter*, const QPainterPath&,
+        const QRectF& pointRect, const QRectF& boundingRect );
+    void recordState( const QPaintEngineState& );
+
     class PathInfo;
 
     class PrivateData;
@@ -199,6 +260,7 @@ class QWT_EXPORT QwtGraphic : public QwtNullPaintDevice
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::RenderHints )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::CommandTypes )
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::RecordingFlags )
 Q_DECLARE_METATYPE( QwtGraphic )
 
 #endif
@@ -0,0 +1,433 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_histogram_series_data.h"
+#include "qwt_interval.h"
+#include "qwt_atomic_p.h"
+
+#include <qnumeric.h>
+#include <qmath.h>
+#include <qvector.h>
+
+class QwtHistogramSeriesData::PrivateData
+{
+  public:
+    PrivateData()
+        : numBaseBins( 0 )
+        , binMode( QwtHistogramSeriesData::LinearBins )
+        , numBins( 100 )
+        , counts( NULL )
+        , isLog( false )
+        , origin( 0.0 )
+        , scale( 0.0 )
+        , isDirty( true )
+        , maxCount( 0.0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete [] counts;
+    }
+
+    void updateMapping()
+    {
+        isLog = ( binMode == QwtHistogramSeriesData::LogarithmicBins )
+            && ( range.minValue() > 0.0 );
+
+        double t1 = range.minValue();
+        double t2 = range.maxValue();
+
+        if ( isLog )
+        {
+            t1 = qLn( t1 );
+            t2 = qLn( t2 );
+        }
+
+        origin = t1;
+        end = t2;
+        scale = ( t2 > t1 ) ? numBaseBins / ( t2 - t1 ) : 0.0;
+    }
+
+    inline double transform( double value ) const
+    {
+        return isLog ? qLn( value ) : value;
+    }
+
+    // position of value in units of base bins
+    inline double binPosition( double value ) const
+    {
+        return ( transform( value ) - origin ) * scale;
+    }
+
+    //! \return -1 for values below, numBaseBins for values above the range
+    inline int binIndex( double value ) const
+    {
+        if ( isLog && value <= 0.0 )
+            return -1;
+
+        const double t = transform( value );
+        if ( t < origin )
+            return -1;
+
+        const double pos = ( t - origin ) * scale;
+        if ( pos >= numBaseBins )
+            return ( t <= end ) ? numBaseBins - 1 : numBaseBins;
+
+        return int( pos );
+    }
+
+    inline double binBorder( int index ) const
+    {
+        if ( index <= 0 )
+            return range.minValue();
+
+        if ( index >= numBaseBins || scale == 0.0 )
+            return range.maxValue();
+
+        const double t = origin + index / scale;
+        return isLog ? qExp( t ) : t;
+    }
+
+    QwtInterval range;
+    int numBaseBins;
+    QwtHistogramSeriesData::BinMode binMode;
+    int numBins;
+
+    QAtomicInt* counts;
+    QAtomicInt below;
+    QAtomicInt above;
+
+    bool isLog;
+    double origin;
+    double end;
+    double scale;
+
+    QwtInterval intervalOfInterest;
+
+    // snapshot: only accessed by the GUI thread
+    mutable bool isDirty;
+    mutable QVector< QwtIntervalSample > samples;
+    mutable double maxCount;
+};
+
+/*!
+   \brief Constructor
+
+   \param range Range of the values, that are counted
+   \param numBaseBins Number of the base bins, dividing the range
+
+   \sa setRange()
+ */
+QwtHistogramSeriesData::QwtHistogramSeriesData(
+    const QwtInterval& range, int numBaseBins )
+{
+    m_data = new PrivateData();
+    setRange( range, numBaseBins );
+}
+
+//! Destructor
+QwtHistogramSeriesData::~QwtHistogramSeriesData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the range of the values, that are counted
+
+   The range is divided into numBaseBins bins, that are the finest
+   resolution of the histogram. Values outside of the range are
+   counted by numValuesBelow() and numValuesAbove().
+
+   \param range Range of the values
+   \param numBaseBins Number of base bins
+
+   \warning All counts are reset. setRange() must not be called,
+            while other threads are appending values.
+   \sa range(), numBaseBins(), reset()
+ */
+void QwtHistogramSeriesData::setRange(
+    const QwtInterval& range, int numBaseBins )
+{
+    numBaseBins = qMax( numBaseBins, 1 );
+
+    if ( numBaseBins != m_data->numBaseBins )
+    {
+        delete [] m_data->counts;
+        m_data->counts = new QAtomicInt[ numBaseBins ];
+        m_data->numBaseBins = numBaseBins;
+    }
+
+    m_data->range = range.normalized();
+    m_data->updateMapping();
+
+    reset();
+}
+
+/*!
+   \return Range of the values, that are counted
+   \sa setRange()
+ */
+QwtInterval QwtHistogramSeriesData::range() const
+{
+    return m_data->range;
+}
+
+/*!
+   \return Number of base bins
+   \sa setRange()
+ */
+int QwtHistogramSeriesData::numBaseBins() const
+{
+    return m_data->numBaseBins;
+}
+
+/*!
+   \brief Set the distribution of the base bins
+
+   LogarithmicBins requires a range with a minimum > 0.
+   Otherwise the bins are distributed linearly.
+
+   \param mode Bin mode
+   \warning All counts are reset. setBinMode() must not be called,
+            while other threads are appending values.
+   \sa binMode()
+ */
+void QwtHistogramSeriesData::setBinMode( BinMode mode )
+{
+    if ( mode != m_data->binMode )
+    {
+        m_data->binMode = mode;
+        m_data->updateMapping();
+
+        reset();
+    }
+}
+
+/*!
+   \return Distribution of the base bins
+   \sa setBinMode()
+ */
+QwtHistogramSeriesData::BinMode QwtHistogramSeriesData::binMode() const
+{
+    return m_data->binMode;
+}
+
+/*!
+   \brief Set the maximum number of samples
+
+   Adjacent base bins are combined, so that the x interval of the
+   "rect of interest" is covered by at most numBins samples.
+   The default setting is 100.
+
+   \param numBins Maximum number of samples
+   \sa numBins(), setRectOfInterest()
+ */
+void QwtHistogramSeriesData::setNumBins( int numBins )
+{
+    numBins = qMax( numBins, 1 );
+    if ( numBins != m_data->numBins )
+    {
+        m_data->numBins = numBins;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return Maximum number of samples
+   \sa setNumBins()
+ */
+int QwtHistogramSeriesData::numBins() const
+{
+    return m_data->numBins;
+}
+
+/*!
+   \brief Count a value
+
+   append() is lock-free and may be called from any thread. The value
+   will be visible in the samples after the next update().
+   NaN values are ignored.
+
+   \param value Value
+   \sa update()
+ */
+void QwtHistogramSeriesData::append( double value )
+{
+    if ( qIsNaN( value ) )
+        return;
+
+    const int index = m_data->binIndex( value );
+
+    if ( index < 0 )
+        m_data->below.fetchAndAddRelaxed( 1 );
+    else if ( index >= m_data->numBaseBins )
+        m_data->above.fetchAndAddRelaxed( 1 );
+    else
+        m_data->counts[index].fetchAndAddRelaxed( 1 );
+}
+
+/*!
+   \brief Count an array of values
+
+   \param values Array of values
+   \param numValues Number of values
+   \sa append( double )
+ */
+void QwtHistogramSeriesData::append( const double* values, int numValues )
+{
+    for ( int i = 0; i < numValues; i++ )
+        append( values[i] );
+}
+
+/*!
+   \brief Invalidate the samples
+
+   update() has to be called from the GUI thread before replotting.
+   Between 2 calls of update() the samples are stable, so that the plot
+   items can iterate over them without interference of the producer threads.
+ */
+void QwtHistogramSeriesData::update()
+{
+    m_data->isDirty = true;
+}
+
+/*!
+   \brief Reset all counts to 0
+   \warning reset() must not be called, while other threads are appending values.
+ */
+void QwtHistogramSeriesData::reset()
+{
+    for ( int i = 0; i < m_data->numBaseBins; i++ )
+        qwtStoreRelease( m_data->counts[i], 0 );
+
+    qwtStoreRelease( m_data->below, 0 );
+    qwtStoreRelease( m_data->above, 0 );
+
+    m_data->isDirty = true;
+}
+
+//! \return Number of values, that have been below the range
+int QwtHistogramSeriesData::numValuesBelow() const
+{
+    return qwtLoadAcquire( m_data->below );
+}
+
+//! \return Number of values, that have been above the range
+int QwtHistogramSeriesData::numValuesAbove() const
+{
+    return qwtLoadAcquire( m_data->above );
+}
+
+/*!
+   \brief Set the "rect of interest"
+
+   The samples are rebuilt lazily for the x interval of rect.
+
+   \param rect Rectangle of interest
+   \sa QwtSeriesData::setRectOfInterest(), setNumBins()
+ */
+void QwtHistogramSeriesData::setRectOfInterest( const QRectF& rect )
+{
+    const QwtInterval interval( rect.left(), rect.right() );
+    if ( interval != m_data->intervalOfInterest )
+    {
+        m_data->intervalOfInterest = interval;
+        m_data->isDirty = true;
+    }
+}
+
+//! \return Number of samples
+size_t QwtHistogramSeriesData::size() const
+{
+    if ( m_data->isDirty )
+        rebin();
+
+    return m_data->samples.size();
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QwtIntervalSample QwtHistogramSeriesData::sample( size_t index ) const
+{
+    if ( m_data->isDirty )
+        rebin();
+
+    return m_data->samples[ int( index ) ];
+}
+
+/*!
+   \return Bounding rectangle of the samples
+
+   The x coordinates are the range(), the y coordinates are
+   from 0 to the maximum of the samples.
+ */
+QRectF QwtHistogramSeriesData::boundingRect() const
+{
+    if ( m_data->isDirty )
+        rebin();
+
+    const QwtInterval& range = m_data->range;
+    return QRectF( range.minValue(), 0.0, range.width(), m_data->maxCount );
+}
+
+void QwtHistogramSeriesData::rebin() const
+{
+    const int numBaseBins = m_data->numBaseBins;
+
+    int from = 0;
+    int to = numBaseBins;
+
+    const QwtInterval& interval = m_data->intervalOfInterest;
+    if ( interval.isValid() && interval.width() > 0.0 )
+    {
+        const double pos1 = m_data->binPosition(
+            qMax( interval.minValue(), m_data->range.minValue() ) );
+        const double pos2 = m_data->binPosition(
+            qMin( interval.maxValue(), m_data->range.maxValue() ) );
+
+        if ( pos1 < pos2 )
+        {
+            from = qBound( 0, qFloor( pos1 ), numBaseBins - 1 );
+            to = qBound( from + 1, qCeil( pos2 ), numBaseBins );
+        }
+    }
+
+    const int step = ( to - from + m_data->numBins - 1 ) / m_data->numBins;
+
+    // aligning the bins, so that they don't change when panning
+    from -= from % step;
+
+    m_data->samples.clear();
+    m_data->samples.reserve( ( to - from ) / step + 1 );
+
+    double maxCount = 0.0;
+
+    for ( int i = from; i < to; i += step )
+    {
+        const int end = qMin( i + step, numBaseBins );
+
+        double count = 0.0;
+        for ( int j = i; j < end; j++ )
+            count += qwtLoadAcquire( m_data->counts[j] );
+
+        const QwtInterval binInterval(
+            m_data->binBorder( i ), m_data->binBorder( end ) );
+
+        m_data->samples += QwtIntervalSample( count, binInterval );
+
+        if ( count > maxCount )
+            maxCount = count;
+    }
+
+    m_data->maxCount = maxCount;
+    m_data->isDirty = false;
+}
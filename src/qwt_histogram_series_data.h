@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_HISTOGRAM_SERIES_DATA_H
+#define QWT_HISTOGRAM_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+/*!
+   \brief Series of intervals, that is built from raw values
+
+   QwtHistogramSeriesData counts raw values, that are passed by append(),
+   in a fixed number of base bins and returns the counts as
+   QwtIntervalSample for a QwtPlotHistogram.
+
+   - append() increments the count of a base bin atomically. It may be called
+     from several producer threads at the same time.
+
+   - update() invalidates the samples, that are displayed by the plot items.
+     It has to be called from the GUI thread before the plot gets replotted.
+
+   - size(), sample() and boundingRect() operate on the samples, that are
+     built lazily from the base bins. They are only allowed to
+     be called from the GUI thread.
+
+   The number of base bins is the finest resolution of the histogram.
+   The samples are built by combining adjacent base bins, so that
+   at most numBins() samples cover the x interval of the "rect of interest"
+   ( see QwtSeriesData::setRectOfInterest() ). So when zooming in the
+   bins get smaller down to the size of a base bin without having to
+   recalculate anything from the raw values.
+
+   \par Example
+   \code
+   QwtHistogramSeriesData* histogramData =
+       new QwtHistogramSeriesData( QwtInterval( 0.0, 1000.0 ), 100000 );
+   histogram->setData( histogramData );
+
+   // from any thread
+   histogramData->append( values, numValues );
+
+   ...
+
+   // f.e. in a timer event of the GUI thread
+   histogramData->update();
+   plot->replot();
+   \endcode
+   \endpar
+
+   \note Raw values are not stored. Changing the range, the number of base
+         bins or the bin mode resets all counts.
+ */
+class QWT_EXPORT QwtHistogramSeriesData
+    : public QwtSeriesData< QwtIntervalSample >
+{
+  public:
+    /*!
+       \brief Distribution of the base bins
+       \sa setBinMode()
+     */
+    enum BinMode
+    {
+        //! All base bins have the same width
+        LinearBins,
+
+        /*!
+           All base bins have the same width on a logarithmic scale.
+           Values <= 0 are counted as being below the range.
+         */
+        LogarithmicBins
+    };
+
+    explicit QwtHistogramSeriesData(
+        const QwtInterval& range, int numBaseBins = 10000 );
+
+    virtual ~QwtHistogramSeriesData();
+
+    void setRange( const QwtInterval& range, int numBaseBins );
+    QwtInterval range() const;
+    int numBaseBins() const;
+
+    void setBinMode( BinMode );
+    BinMode binMode() const;
+
+    void setNumBins( int );
+    int numBins() const;
+
+    void append( double value );
+    void append( const double* values, int numValues );
+
+    void update();
+    void reset();
+
+    int numValuesBelow() const;
+    int numValuesAbove() const;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtIntervalSample sample( size_t index ) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtHistogramSeriesData )
+
+    void rebin() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
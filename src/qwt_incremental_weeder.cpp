@@ -0,0 +1,310 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_incremental_weeder.h"
+#include "qwt_scale_map.h"
+#include "qwt_math.h"
+
+#include <qpolygon.h>
+
+// angle in ]-PI, PI]
+static inline double qwtRelativeAngle( double angle, double reference )
+{
+    double a = qwtNormalizeRadians( angle - reference );
+    if ( a > M_PI )
+        a -= 2.0 * M_PI;
+
+    return a;
+}
+
+class QwtIncrementalWeeder::PrivateData
+{
+  public:
+    PrivateData()
+        : tolerance( 1.0 )
+        , hasScaleMaps( false )
+        , numAppended( 0 )
+        , hasPending( false )
+        , hasWedge( false )
+        , reference( 0.0 )
+        , minAngle( 0.0 )
+        , maxAngle( 0.0 )
+    {
+    }
+
+    double tolerance;
+
+    bool hasScaleMaps;
+    QwtScaleMap xMap;
+    QwtScaleMap yMap;
+
+    QPolygonF points;
+    int numAppended;
+
+    // the anchor is the last point of points
+    QPointF anchor;
+
+    bool hasPending;
+    QPointF pending;
+    QPointF pendingMapped;
+
+    // range of directions from the anchor, relative to reference
+    bool hasWedge;
+    double reference;
+    double minAngle;
+    double maxAngle;
+};
+
+/*!
+   Constructor
+
+   \param tolerance Tolerance
+   \sa setTolerance(), tolerance()
+ */
+QwtIncrementalWeeder::QwtIncrementalWeeder( double tolerance )
+{
+    m_data = new PrivateData;
+    setTolerance( tolerance );
+}
+
+//! Destructor
+QwtIncrementalWeeder::~QwtIncrementalWeeder()
+{
+    delete m_data;
+}
+
+/*!
+   Assign the tolerance
+
+   The tolerance is the maximum distance of a point, that is not kept,
+   to the simplified polygon. When scale maps have been assigned the
+   tolerance is in screen coordinates.
+
+   \param tolerance Tolerance
+
+   \note The tolerance has no effect on points, that have been
+         appended before.
+   \sa tolerance(), setScaleMaps()
+ */
+void QwtIncrementalWeeder::setTolerance( double tolerance )
+{
+    tolerance = qwtMaxF( tolerance, 0.0 );
+    if ( tolerance != m_data->tolerance )
+    {
+        m_data->tolerance = tolerance;
+        restart();
+    }
+}
+
+/*!
+   \return Tolerance
+   \sa setTolerance()
+ */
+double QwtIncrementalWeeder::tolerance() const
+{
+    return m_data->tolerance;
+}
+
+/*!
+   \brief Assign the maps, that translate the points into screen coordinates
+
+   When the maps are set the points are weeded in screen coordinates
+   and the tolerance is in pixels. Usually the maps are the canvas maps
+   of the plot, where the simplified polygon is displayed.
+
+   \param xMap Maps x-coordinates into screen coordinates
+   \param yMap Maps y-coordinates into screen coordinates
+
+   \note The maps have no effect on points, that have been
+         appended before.
+
+   \sa resetScaleMaps(), QwtPlot::canvasMap()
+ */
+void QwtIncrementalWeeder::setScaleMaps(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap )
+{
+    m_data->hasScaleMaps = true;
+    m_data->xMap = xMap;
+    m_data->yMap = yMap;
+
+    restart();
+}
+
+/*!
+   \brief Weed the points in their own coordinates
+   \sa setScaleMaps()
+ */
+void QwtIncrementalWeeder::resetScaleMaps()
+{
+    if ( m_data->hasScaleMaps )
+    {
+        m_data->hasScaleMaps = false;
+        restart();
+    }
+}
+
+/*!
+   \return True, when scale maps have been assigned
+   \sa setScaleMaps(), resetScaleMaps()
+ */
+bool QwtIncrementalWeeder::hasScaleMaps() const
+{
+    return m_data->hasScaleMaps;
+}
+
+/*!
+   \brief Append a point
+
+   \param point Point
+   \sa points()
+ */
+void QwtIncrementalWeeder::append( const QPointF& point )
+{
+    m_data->numAppended++;
+
+    const QPointF pos = mapped( point );
+
+    if ( m_data->points.isEmpty() )
+    {
+        m_data->points += point;
+        m_data->anchor = pos;
+
+        return;
+    }
+
+    const double tolerance = m_data->tolerance;
+
+    double dx = pos.x() - m_data->anchor.x();
+    double dy = pos.y() - m_data->anchor.y();
+    double length = std::sqrt( dx * dx + dy * dy );
+
+    if ( m_data->hasWedge )
+    {
+        bool inside = false;
+
+        double angle = 0.0;
+        if ( length > 0.0 )
+        {
+            angle = qwtRelativeAngle( std::atan2( dy, dx ), m_data->reference );
+            inside = ( angle >= m_data->minAngle ) && ( angle <= m_data->maxAngle );
+        }
+
+        if ( inside )
+        {
+            if ( length > tolerance )
+            {
+                const double delta = std::asin( tolerance / length );
+
+                m_data->minAngle = qwtMaxF( m_data->minAngle, angle - delta );
+                m_data->maxAngle = qwtMinF( m_data->maxAngle, angle + delta );
+            }
+
+            m_data->pending = point;
+            m_data->pendingMapped = pos;
+
+            return;
+        }
+
+        // the pending point becomes the new anchor
+
+        m_data->points += m_data->pending;
+        m_data->anchor = m_data->pendingMapped;
+        m_data->hasWedge = false;
+
+        dx = pos.x() - m_data->anchor.x();
+        dy = pos.y() - m_data->anchor.y();
+        length = std::sqrt( dx * dx + dy * dy );
+    }
+
+    if ( length > tolerance )
+    {
+        const double delta = std::asin( tolerance / length );
+
+        m_data->hasWedge = true;
+        m_data->reference = std::atan2( dy, dx );
+        m_data->minAngle = -delta;
+        m_data->maxAngle = delta;
+    }
+
+    // points closer to the anchor than the tolerance are always inside
+
+    m_data->hasPending = true;
+    m_data->pending = point;
+    m_data->pendingMapped = pos;
+}
+
+/*!
+   \brief Append points
+
+   \param points Array of points
+   \param count Number of points
+   \sa points()
+ */
+void QwtIncrementalWeeder::append( const QPointF* points, int count )
+{
+    for ( int i = 0; i < count; i++ )
+        append( points[i] );
+}
+
+//! Remove all points
+void QwtIncrementalWeeder::reset()
+{
+    m_data->points.clear();
+    m_data->numAppended = 0;
+    m_data->hasPending = false;
+    m_data->hasWedge = false;
+}
+
+/*!
+   \return Number of points, that have been appended since the last reset()
+ */
+int QwtIncrementalWeeder::numAppended() const
+{
+    return m_data->numAppended;
+}
+
+/*!
+   \return Simplified polygon. Its last point is always the
+           point, that has been appended last.
+ */
+QPolygonF QwtIncrementalWeeder::points() const
+{
+    QPolygonF points = m_data->points;
+    if ( m_data->hasPending )
+        points += m_data->pending;
+
+    return points;
+}
+
+/*
+   Keep the pending point and start with a new range of
+   directions, so that modified parameters do not
+   affect the decisions made before
+ */
+void QwtIncrementalWeeder::restart()
+{
+    if ( m_data->hasPending )
+    {
+        m_data->points += m_data->pending;
+        m_data->hasPending = false;
+    }
+
+    if ( !m_data->points.isEmpty() )
+        m_data->anchor = mapped( m_data->points.last() );
+
+    m_data->hasWedge = false;
+}
+
+QPointF QwtIncrementalWeeder::mapped( const QPointF& point ) const
+{
+    if ( !m_data->hasScaleMaps )
+        return point;
+
+    return QwtScaleMap::transform( m_data->xMap, m_data->yMap, point );
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_INCREMENTAL_WEEDER_H
+#define QWT_INCREMENTAL_WEEDER_H
+
+#include "qwt_global.h"
+
+class QwtScaleMap;
+class QPointF;
+class QPolygonF;
+
+/*!
+   \brief Simplification of append-only data in a single pass
+
+   QwtIncrementalWeeder reduces the number of points of a series, that
+   is growing by appending samples, without processing the history again.
+   Each sample is processed in O( 1 ), so that the simplified
+   polygon can be kept up to date, while the data is acquired.
+
+   The implementation is a "sliding window" or "sleeve fitting"
+   algorithm: starting from the last point, that has been kept - the anchor -
+   the range of directions is narrowed by each appended point in a way,
+   that all points in between are within the tolerance of a line
+   from the anchor into one of these directions. When an appended point is not
+   in this range, the previous point is kept and becomes the new anchor.
+
+   In opposite to QwtWeedingCurveFitter the result is not the optimum,
+   but it is decided for each point only once.
+
+   The tolerance can be given in screen coordinates by setScaleMaps(). Then the
+   points are mapped before being weeded, so that the level of details matches
+   the resolution of the plot.
+
+   \code
+    QwtIncrementalWeeder weeder( 1.0 );
+    weeder.setScaleMaps( plot->canvasMap( QwtAxis::XBottom ),
+        plot->canvasMap( QwtAxis::YLeft ) );
+
+    for ( ... )
+        weeder.append( sample );
+
+    curve->setSamples( weeder.points() );
+   \endcode
+
+   \sa QwtWeedingCurveFitter
+ */
+class QWT_EXPORT QwtIncrementalWeeder
+{
+  public:
+    explicit QwtIncrementalWeeder( double tolerance = 1.0 );
+    ~QwtIncrementalWeeder();
+
+    void setTolerance( double );
+    double tolerance() const;
+
+    void setScaleMaps( const QwtScaleMap& xMap, const QwtScaleMap& yMap );
+    void resetScaleMaps();
+    bool hasScaleMaps() const;
+
+    void append( const QPointF& );
+    void append( const QPointF* points, int count );
+
+    void reset();
+
+    int numAppended() const;
+    QPolygonF points() const;
+
+  private:
+    Q_DISABLE_COPY(QwtIncrementalWeeder)
+
+    void restart();
+    QPointF mapped( const QPointF& ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,478 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_interval_series_data_pyramid.h"
+#include "qwt_scale_map.h"
+
+#include <qvector.h>
+#include <cmath>
+
+namespace
+{
+    // number of samples, that are summarized by a node of the lowest level
+    const int qwtBlockSize = 32;
+
+    class QwtIntervalPyramidNode
+    {
+      public:
+        inline void init( const QwtIntervalSample& sample )
+        {
+            min = sample.interval.minValue();
+            max = sample.interval.maxValue();
+        }
+
+        inline void add( const QwtIntervalSample& sample )
+        {
+            if ( sample.interval.minValue() < min )
+                min = sample.interval.minValue();
+
+            if ( sample.interval.maxValue() > max )
+                max = sample.interval.maxValue();
+        }
+
+        inline void add( const QwtIntervalPyramidNode& other )
+        {
+            if ( other.min < min )
+                min = other.min;
+
+            if ( other.max > max )
+                max = other.max;
+        }
+
+        double min;
+        double max;
+    };
+}
+
+class QwtIntervalSeriesDataPyramid::PrivateData
+{
+  public:
+    PrivateData()
+        : series( NULL )
+        , isDirty( true )
+        , isMonotonic( false )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete series;
+    }
+
+    void scan( int from, int to, bool& valid, QwtIntervalPyramidNode& node ) const
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtIntervalSample sample = series->sample( i );
+
+            if ( valid )
+            {
+                node.add( sample );
+            }
+            else
+            {
+                node.init( sample );
+                valid = true;
+            }
+        }
+    }
+
+    int upperIndex( double value, int from, int to ) const
+    {
+        // index of the first sample in [from, to] with a value >= value,
+        // to + 1, when there is none
+
+        int n = to - from + 1;
+        int index = from;
+
+        while ( n > 0 )
+        {
+            const int half = n >> 1;
+            const int indexMid = index + half;
+
+            if ( series->sample( indexMid ).value < value )
+            {
+                index = indexMid + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+
+        return index;
+    }
+
+    QwtSeriesData< QwtIntervalSample >* series;
+
+    bool isDirty;
+    bool isMonotonic;
+    QRectF boundingRect;
+
+    QVector< QVector< QwtIntervalPyramidNode > > levels;
+};
+
+/*!
+   \brief Constructor
+
+   \param series Series to be indexed
+   \warning The pyramid takes ownership of the series
+ */
+QwtIntervalSeriesDataPyramid::QwtIntervalSeriesDataPyramid(
+    QwtSeriesData< QwtIntervalSample >* series )
+{
+    m_data = new PrivateData();
+    m_data->series = series;
+}
+
+//! Destructor
+QwtIntervalSeriesDataPyramid::~QwtIntervalSeriesDataPyramid()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the series to be indexed
+
+   \param series Series
+   \warning The pyramid takes ownership of the series,
+            the previous series will be deleted.
+   \sa series(), invalidate()
+ */
+void QwtIntervalSeriesDataPyramid::setSeries(
+    QwtSeriesData< QwtIntervalSample >* series )
+{
+    if ( series != m_data->series )
+    {
+        delete m_data->series;
+        m_data->series = series;
+    }
+
+    invalidate();
+}
+
+/*!
+   \return Series being indexed
+   \sa setSeries()
+ */
+const QwtSeriesData< QwtIntervalSample >*
+QwtIntervalSeriesDataPyramid::series() const
+{
+    return m_data->series;
+}
+
+/*!
+   \brief Invalidate the index
+
+   invalidate() has to be called, whenever the samples of the
+   wrapped series have been modified. The index will be rebuilt,
+   when it is needed the next time.
+ */
+void QwtIntervalSeriesDataPyramid::invalidate()
+{
+    m_data->isDirty = true;
+    m_data->levels.clear();
+}
+
+/*!
+   \return True, when the values of the samples are in increasing order
+   \note For a non monotonic series aggregatedSamples() returns
+         the samples unmodified
+ */
+bool QwtIntervalSeriesDataPyramid::isMonotonic() const
+{
+    build();
+    return m_data->isMonotonic;
+}
+
+//! \return Number of samples
+size_t QwtIntervalSeriesDataPyramid::size() const
+{
+    return m_data->series ? m_data->series->size() : 0;
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QwtIntervalSample QwtIntervalSeriesDataPyramid::sample( size_t index ) const
+{
+    return m_data->series->sample( index );
+}
+
+/*!
+   \return Bounding rectangle of all samples
+
+   The bounding rectangle is calculated, when building the index.
+   So it is available in O(1) as long as the index is valid.
+ */
+QRectF QwtIntervalSeriesDataPyramid::boundingRect() const
+{
+    build();
+    return m_data->boundingRect;
+}
+
+/*!
+   Forward the rectangle of interest to the wrapped series
+
+   \param rect Rectangle of interest
+   \sa QwtSeriesData::setRectOfInterest()
+ */
+void QwtIntervalSeriesDataPyramid::setRectOfInterest( const QRectF& rect )
+{
+    if ( m_data->series )
+        m_data->series->setRectOfInterest( rect );
+}
+
+/*!
+   \brief Aggregate a range of samples into one sample
+
+   The aggregated sample has the value of the first sample and
+   an interval from the minimum of the lower limits to the
+   maximum of the upper limits.
+
+   \param from Index of the first sample
+   \param to Index of the last sample
+   \param sample Aggregated sample
+
+   \return false, when the index range is empty
+ */
+bool QwtIntervalSeriesDataPyramid::aggregate(
+    int from, int to, QwtIntervalSample& sample ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    if ( from > to )
+        return false;
+
+    bool valid = false;
+    QwtIntervalPyramidNode node;
+
+    int b0 = ( from + qwtBlockSize - 1 ) / qwtBlockSize; // first complete block
+    int b1 = ( to + 1 ) / qwtBlockSize; // behind the last complete block
+
+    if ( b0 >= b1 )
+    {
+        m_data->scan( from, to, valid, node );
+    }
+    else
+    {
+        m_data->scan( from, b0 * qwtBlockSize - 1, valid, node );
+        m_data->scan( b1 * qwtBlockSize, to, valid, node );
+
+        for ( int level = 0; b0 < b1; level++ )
+        {
+            const QwtIntervalPyramidNode* nodes = m_data->levels[level].constData();
+
+            if ( b0 & 1 )
+            {
+                if ( valid )
+                    node.add( nodes[b0] );
+                else
+                    node = nodes[b0];
+
+                valid = true;
+                b0++;
+            }
+
+            if ( b1 & 1 )
+            {
+                b1--;
+
+                if ( valid )
+                    node.add( nodes[b1] );
+                else
+                    node = nodes[b1];
+
+                valid = true;
+            }
+
+            b0 >>= 1;
+            b1 >>= 1;
+        }
+    }
+
+    sample.value = m_data->series->sample( from ).value;
+    sample.interval.setInterval( node.min, node.max );
+
+    return valid;
+}
+
+/*!
+   \brief Unite the intervals of the samples, that are mapped to the same bucket
+
+   The paint interval of valueMap is divided into buckets of bucketWidth.
+   All samples of a bucket are aggregated into one sample, that
+   is located in the center of the bucket. Samples outside of the
+   scale interval of valueMap are ignored, beside the neighbours
+   of the visible samples.
+
+   The number of returned samples is limited by the number of buckets.
+   The costs are O(buckets * log(n)).
+
+   \param valueMap Maps the values into paint device coordinates
+   \param bucketWidth Width of a bucket in paint device coordinates
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return Aggregated samples in the order of the series.
+           For a non monotonic series all samples in the range are returned.
+   \sa aggregate()
+ */
+QVector< QwtIntervalSample > QwtIntervalSeriesDataPyramid::aggregatedSamples(
+    const QwtScaleMap& valueMap, double bucketWidth, int from, int to ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QVector< QwtIntervalSample > samples;
+    if ( from > to )
+        return samples;
+
+    const QwtSeriesData< QwtIntervalSample >* series = m_data->series;
+
+    if ( !m_data->isMonotonic || bucketWidth <= 0.0 )
+    {
+        samples.reserve( to - from + 1 );
+        for ( int i = from; i <= to; i++ )
+            samples += series->sample( i );
+
+        return samples;
+    }
+
+    const double vMin = qMin( valueMap.s1(), valueMap.s2() );
+    const double vMax = qMax( valueMap.s1(), valueMap.s2() );
+
+    // restricting the range to the visible samples
+    // and their neighbours
+
+    from = qMax( from, m_data->upperIndex( vMin, from, to ) - 1 );
+    to = qMin( to, m_data->upperIndex( vMax, from, to ) );
+
+    const bool increasing = !valueMap.isInverting();
+
+    samples.reserve( qMin( to - from + 1,
+        int( valueMap.pDist() / bucketWidth ) + 3 ) );
+
+    int i = from;
+    while ( i <= to )
+    {
+        const double pos = valueMap.transform( series->sample( i ).value );
+        const double bucket = std::floor( pos / bucketWidth + 0.5 ) * bucketWidth;
+
+        const double v2 = valueMap.invTransform(
+            increasing ? bucket + 0.5 * bucketWidth : bucket - 0.5 * bucketWidth );
+
+        const int j = qMax( i, m_data->upperIndex( v2, i + 1, to ) - 1 );
+
+        QwtIntervalSample sample;
+        if ( j == i )
+        {
+            sample = series->sample( i );
+        }
+        else
+        {
+            aggregate( i, j, sample );
+            sample.value = valueMap.invTransform( bucket );
+        }
+
+        samples += sample;
+
+        i = j + 1;
+    }
+
+    return samples;
+}
+
+void QwtIntervalSeriesDataPyramid::build() const
+{
+    if ( !m_data->isDirty )
+        return;
+
+    m_data->isDirty = false;
+    m_data->isMonotonic = true;
+    m_data->boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+    m_data->levels.clear();
+
+    const int numSamples = int( size() );
+    if ( numSamples <= 0 )
+        return;
+
+    const QwtSeriesData< QwtIntervalSample >* series = m_data->series;
+
+    const int numBlocks = ( numSamples + qwtBlockSize - 1 ) / qwtBlockSize;
+
+    QVector< QwtIntervalPyramidNode > nodes( numBlocks );
+
+    const double v0 = series->sample( 0 ).value;
+
+    double vMin = v0;
+    double vMax = v0;
+    double vPrev = v0;
+
+    for ( int block = 0; block < numBlocks; block++ )
+    {
+        const int from = block * qwtBlockSize;
+        const int to = qMin( from + qwtBlockSize, numSamples ) - 1;
+
+        QwtIntervalPyramidNode& node = nodes[block];
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtIntervalSample sample = series->sample( i );
+
+            if ( i == from )
+                node.init( sample );
+            else
+                node.add( sample );
+
+            const double v = sample.value;
+
+            if ( v < vPrev )
+                m_data->isMonotonic = false;
+
+            if ( v < vMin )
+                vMin = v;
+
+            if ( v > vMax )
+                vMax = v;
+
+            vPrev = v;
+        }
+    }
+
+    m_data->levels += nodes;
+
+    while ( nodes.size() > 1 )
+    {
+        const QVector< QwtIntervalPyramidNode > lower = nodes;
+
+        nodes.resize( ( lower.size() + 1 ) / 2 );
+        for ( int i = 0; i < nodes.size(); i++ )
+        {
+            nodes[i] = lower[2 * i];
+            if ( 2 * i + 1 < lower.size() )
+                nodes[i].add( lower[2 * i + 1] );
+        }
+
+        m_data->levels += nodes;
+    }
+
+    const QwtIntervalPyramidNode& root = m_data->levels.last()[0];
+
+    // see qwtBoundingRect( const QwtIntervalSample& )
+    m_data->boundingRect.setCoords( root.min, vMin, root.max, vMax );
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_INTERVAL_SERIES_DATA_PYRAMID_H
+#define QWT_INTERVAL_SERIES_DATA_PYRAMID_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+class QwtScaleMap;
+
+#if QT_VERSION < 0x060000
+template< typename T > class QVector;
+#endif
+
+/*!
+   \brief A min/max pyramid for a series of interval samples
+
+   QwtIntervalSeriesDataPyramid wraps another QwtSeriesData<QwtIntervalSample>
+   object and builds a multi-resolution index of the minimum of the lower
+   and the maximum of the upper limits of consecutive blocks of samples.
+   For series with increasing values ( f.e. error bands of a recording )
+   it offers to unite the intervals of any index range in O(log n).
+
+   QwtPlotIntervalCurve takes advantage of the index: the intervals of
+   all samples, that are mapped to the same pixel are united, so that
+   the tube has one vertex pair per pixel. So the costs of a replot
+   depend on the size of the canvas instead of the number of samples.
+
+   The index is built lazily, when it is needed the first time.
+   When the samples of the wrapped series are modified invalidate()
+   has to be called.
+
+   \par Example
+   \code
+   QwtPlotIntervalCurve* curve = new QwtPlotIntervalCurve();
+   curve->setData( new QwtIntervalSeriesDataPyramid(
+       new QwtIntervalSeriesData( samples ) ) );
+   \endcode
+   \endpar
+
+   \sa QwtPlotIntervalCurve::drawTube(), QwtSeriesDataPyramid,
+       QwtOHLCSeriesDataPyramid
+ */
+class QWT_EXPORT QwtIntervalSeriesDataPyramid
+    : public QwtSeriesData< QwtIntervalSample >
+{
+  public:
+    explicit QwtIntervalSeriesDataPyramid(
+        QwtSeriesData< QwtIntervalSample >* series = NULL );
+
+    virtual ~QwtIntervalSeriesDataPyramid();
+
+    void setSeries( QwtSeriesData< QwtIntervalSample >* );
+    const QwtSeriesData< QwtIntervalSample >* series() const;
+
+    void invalidate();
+
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtIntervalSample sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+
+    bool aggregate( int from, int to, QwtIntervalSample& ) const;
+
+    QVector< QwtIntervalSample > aggregatedSamples(
+        const QwtScaleMap& valueMap, double bucketWidth,
+        int from, int to ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtIntervalSeriesDataPyramid )
+
+    void build() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <qpainter.h>
 #include <qpalette.h>
+#include <qpixmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qevent.h>
@@ -70,6 +71,8 @@ class QwtKnob::PrivateData
         , markerSize( 8 )
         , totalAngle( 270.0 )
         , mouseOffset( 0.0 )
+        , cachePixelRatio( 1.0 )
+        , cacheColorGroup( QPalette::Active )
     {
     }
 
@@ -87,6 +90,11 @@ class QwtKnob::PrivateData
     double totalAngle;
 
     double mouseOffset;
+
+    // scale and knob, without the marker
+    QPixmap pixmapCache;
+    qreal cachePixelRatio;
+    QPalette::ColorGroup cacheColorGroup;
 };
 
 /*!
@@ -133,6 +141,8 @@ void QwtKnob::setKnobStyle( KnobStyle knobStyle )
     if ( m_data->knobStyle != knobStyle )
     {
         m_data->knobStyle = knobStyle;
+
+        invalidateCache();
         update();
     }
 }
@@ -193,6 +203,8 @@ void QwtKnob::setTotalAngle ( double angle )
         scaleDraw()->setAngleRange( -0.5 * m_data->totalAngle,
             0.5 * m_data->totalAngle );
 
+        invalidateCache();
+
         updateGeometry();
         update();
     }
@@ -231,6 +243,8 @@ void QwtKnob::setNumTurns( int numTurns )
         scaleDraw()->setAngleRange( -0.5 * m_data->totalAngle,
             0.5 * m_data->totalAngle );
 
+        invalidateCache();
+
         updateGeometry();
         update();
     }
@@ -261,6 +275,8 @@ void QwtKnob::setScaleDraw( QwtRoundScaleDraw* scaleDraw )
     setAbstractScaleDraw( scaleDraw );
     setTotalAngle( m_data->totalAngle );
 
+    invalidateCache();
+
     updateGeometry();
     update();
 }
@@ -427,6 +443,8 @@ double QwtKnob::scrolledTo( const QPoint& pos ) const
 /*!
    Handle QEvent::StyleChange and QEvent::FontChange;
    \param event Change event
+
+   Invalidates internal paint caches if necessary
  */
 void QwtKnob::changeEvent( QEvent* event )
 {
@@ -435,15 +453,56 @@ void QwtKnob::changeEvent( QEvent* event )
         case QEvent::StyleChange:
         case QEvent::FontChange:
         {
+            invalidateCache();
+
             updateGeometry();
             update();
             break;
         }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LanguageChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            break;
+        }
         default:
             break;
     }
 }
 
+/*!
+   Invalidate the internal caches used to speed up repainting
+
+   The scale and the knob are rendered to a pixmap, that is reused
+   until the geometry or an attribute of the knob changes. Only the marker
+   is painted, when the value changes. Derived classes might need to
+   call invalidateCache() according to their own attributes.
+ */
+void QwtKnob::invalidateCache()
+{
+    m_data->pixmapCache = QPixmap();
+}
+
+//! Invalidate the internal caches and call QwtAbstractSlider::scaleChange()
+void QwtKnob::scaleChange()
+{
+    invalidateCache();
+    QwtAbstractSlider::scaleChange();
+}
+
+/*!
+   Update the knob, when the value has changed
+
+   As only the marker depends on the value, the update
+   is restricted to the knob.
+ */
+void QwtKnob::sliderChange()
+{
+    update( knobRect() );
+}
+
 /*!
    Repaint the knob
    \param event Paint event
@@ -459,17 +518,38 @@ void QwtKnob::paintEvent( QPaintEvent* event )
     opt.initFrom(this);
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
 
-    painter.setRenderHint( QPainter::Antialiasing, true );
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+    const QPalette::ColorGroup colorGroup = palette().currentColorGroup();
 
-    if ( !knobRect.contains( event->region().boundingRect() ) )
+    QPixmap& cache = m_data->pixmapCache;
+
+    if ( cache.isNull() || cache.size() != size() * pixelRatio
+        || pixelRatio != m_data->cachePixelRatio
+        || colorGroup != m_data->cacheColorGroup )
     {
+        cache = QwtPainter::backingStore( this, size() );
+        cache.fill( Qt::transparent );
+
+        QPainter p( &cache );
+        p.setFont( font() );
+        p.setRenderHint( QPainter::Antialiasing, true );
+
         scaleDraw()->setRadius( 0.5 * knobRect.width() + m_data->scaleDist );
         scaleDraw()->moveCenter( knobRect.center() );
 
-        scaleDraw()->draw( &painter, palette() );
+        scaleDraw()->draw( &p, palette() );
+
+        drawKnob( &p, knobRect );
+
+        p.end();
+
+        m_data->cachePixelRatio = pixelRatio;
+        m_data->cacheColorGroup = colorGroup;
     }
 
-    drawKnob( &painter, knobRect );
+    painter.drawPixmap( 0, 0, cache );
+
+    painter.setRenderHint( QPainter::Antialiasing, true );
 
     drawMarker( &painter, knobRect,
         qwtNormalizeDegrees( scaleMap().transform( value() ) ) );
@@ -732,6 +812,8 @@ void QwtKnob::setAlignment( Qt::Alignment alignment )
     if ( m_data->alignment != alignment )
     {
         m_data->alignment = alignment;
+
+        invalidateCache();
         update();
     }
 }
@@ -772,6 +854,8 @@ void QwtKnob::setKnobWidth( int width )
 
         m_data->knobWidth = width;
 
+        invalidateCache();
+
         updateGeometry();
         update();
     }
@@ -791,6 +875,8 @@ void QwtKnob::setBorderWidth( int borderWidth )
 {
     m_data->borderWidth = qMax( borderWidth, 0 );
 
+    invalidateCache();
+
     updateGeometry();
     update();
 }
@@ -170,6 +170,11 @@ class QWT_EXPORT QwtKnob : public QwtAbstractSlider
     virtual double scrolledTo( const QPoint& ) const QWT_OVERRIDE;
     virtual bool isScrollPosition( const QPoint& ) const QWT_OVERRIDE;
 
+    virtual void sliderChange() QWT_OVERRIDE;
+    virtual void scaleChange() QWT_OVERRIDE;
+
+    void invalidateCache();
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -0,0 +1,358 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_line_rasterizer.h"
+#include "qwt_painter.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qpen.h>
+#include <qvector.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class QwtRasterJob
+    {
+      public:
+        const QPointF* points;
+        int numPoints;
+        QwtLineRasterizer::Mode mode;
+
+        QPointF origin;
+        QRgb rgb;
+
+        QRgb* bits;
+        int stride;
+        int width;
+        int height;
+
+        // band of rows, that are written by the job
+        int row0;
+        int row1;
+    };
+}
+
+static inline int qwtRoundPixel( double value )
+{
+    return qwtFloor( value + 0.5 );
+}
+
+// Liang-Barsky line clipping
+
+static inline bool qwtClipLine( const QRectF& rect, QPointF& p1, QPointF& p2 )
+{
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] =
+    {
+        p1.x() - rect.left(), rect.right() - p1.x(),
+        p1.y() - rect.top(), rect.bottom() - p1.y()
+    };
+
+    double t0 = 0.0;
+    double t1 = 1.0;
+
+    for ( int k = 0; k < 4; k++ )
+    {
+        if ( p[k] == 0.0 )
+        {
+            if ( q[k] < 0.0 )
+                return false;
+        }
+        else
+        {
+            const double r = q[k] / p[k];
+            if ( p[k] < 0.0 )
+            {
+                if ( r > t1 )
+                    return false;
+
+                if ( r > t0 )
+                    t0 = r;
+            }
+            else
+            {
+                if ( r < t0 )
+                    return false;
+
+                if ( r < t1 )
+                    t1 = r;
+            }
+        }
+    }
+
+    const QPointF d( dx, dy );
+
+    if ( t1 < 1.0 )
+        p2 = p1 + t1 * d;
+
+    if ( t0 > 0.0 )
+        p1 = p1 + t0 * d;
+
+    return true;
+}
+
+/*
+    The pixels of a line are calculated from its end points only -
+    and not incrementally - so that all jobs come to the same pixels,
+    no matter which band of rows they are responsible for.
+ */
+static void qwtRasterizeLine( const QwtRasterJob* job,
+    const QRectF& clipRect, QPointF p1, QPointF p2 )
+{
+    if ( !qwtClipLine( clipRect, p1, p2 ) )
+        return;
+
+    const int x1 = qwtRoundPixel( p1.x() );
+    const int y1 = qwtRoundPixel( p1.y() );
+    const int x2 = qwtRoundPixel( p2.x() );
+    const int y2 = qwtRoundPixel( p2.y() );
+
+    QRgb* bits = job->bits;
+    const int stride = job->stride;
+    const int width = job->width;
+
+    const int dx = x2 - x1;
+    const int dy = y2 - y1;
+
+    if ( qAbs( dy ) > qAbs( dx ) )
+    {
+        const double s = double( dx ) / dy;
+
+        const int from = qMax( qMin( y1, y2 ), job->row0 );
+        const int to = qMin( qMax( y1, y2 ), job->row1 - 1 );
+
+        for ( int y = from; y <= to; y++ )
+        {
+            const int x = qwtRoundPixel( x1 + ( y - y1 ) * s );
+            if ( x >= 0 && x < width )
+                bits[ y * stride + x ] = job->rgb;
+        }
+    }
+    else
+    {
+        if ( dx == 0 )
+        {
+            if ( x1 >= 0 && x1 < width && y1 >= job->row0 && y1 < job->row1 )
+                bits[ y1 * stride + x1 ] = job->rgb;
+
+            return;
+        }
+
+        int from = qMax( qMin( x1, x2 ), 0 );
+        int to = qMin( qMax( x1, x2 ), width - 1 );
+
+        const double s = double( dy ) / dx;
+
+        if ( dy == 0 )
+        {
+            if ( y1 < job->row0 || y1 >= job->row1 )
+                return;
+        }
+        else
+        {
+            // the columns, where the line is inside of the band
+
+            const double xa = x1 + ( job->row0 - 0.5 - y1 ) / s;
+            const double xb = x1 + ( job->row1 - 0.5 - y1 ) / s;
+
+            from = qMax( from, qwtFloor( qMin( xa, xb ) ) - 1 );
+            to = qMin( to, qwtCeil( qMax( xa, xb ) ) + 1 );
+        }
+
+        for ( int x = from; x <= to; x++ )
+        {
+            const int y = qwtRoundPixel( y1 + ( x - x1 ) * s );
+            if ( y >= job->row0 && y < job->row1 )
+                bits[ y * stride + x ] = job->rgb;
+        }
+    }
+}
+
+static void qwtRasterizeBand( const QwtRasterJob* job )
+{
+    // clipping with a margin, so that the rounded end points
+    // of the clipped lines are the same as for the unclipped lines
+
+    const QRectF clipRect( -1.0, -1.0, job->width + 2.0, job->height + 2.0 );
+
+    const QPointF* points = job->points;
+    const QPointF& origin = job->origin;
+
+    if ( job->mode == QwtLineRasterizer::LinePairs )
+    {
+        for ( int i = 1; i < job->numPoints; i += 2 )
+        {
+            qwtRasterizeLine( job, clipRect,
+                points[i - 1] - origin, points[i] - origin );
+        }
+    }
+    else
+    {
+        if ( job->numPoints == 1 )
+        {
+            const QPointF pos = points[0] - origin;
+            qwtRasterizeLine( job, clipRect, pos, pos );
+
+            return;
+        }
+
+        for ( int i = 1; i < job->numPoints; i++ )
+        {
+            qwtRasterizeLine( job, clipRect,
+                points[i - 1] - origin, points[i] - origin );
+        }
+    }
+}
+
+/*!
+   \brief Check if the rasterizer can be used for a painter
+
+   The rasterizer supports solid, opaque pens of 1 pixel without
+   antialiasing for painters on a raster paint engine, that are
+   not transformed - beside translations. Also the painter has to paint
+   with QPainter::CompositionMode_SourceOver and without opacity.
+
+   \param painter Painter
+   \return True, when draw() can be used for painter
+ */
+bool QwtLineRasterizer::isSupported( const QPainter* painter )
+{
+    const QPaintEngine* pe = painter->paintEngine();
+    if ( pe == NULL || pe->type() != QPaintEngine::Raster )
+        return false;
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    if ( QwtPainter::devicePixelRatio( painter->device() ) != 1.0 )
+        return false;
+
+    if ( ( painter->renderHints() & QPainter::Antialiasing )
+        || painter->compositionMode() != QPainter::CompositionMode_SourceOver
+        || painter->opacity() < 1.0 )
+    {
+        return false;
+    }
+
+    const QPen pen = painter->pen();
+
+    return ( pen.style() == Qt::SolidLine ) && pen.isSolid()
+        && ( pen.color().alpha() == 255 ) && ( pen.widthF() <= 1.0 );
+}
+
+/*!
+   \brief Rasterize lines and paint them
+
+   The lines are rasterized to an image, that is painted with
+   the pen color of the painter to rect.
+
+   \param painter Painter, for which isSupported() is true
+   \param rect Target rectangle, usually the contents rectangle
+               of the canvas. It is intersected with the clip rectangle
+               of the painter.
+   \param points Points
+   \param numPoints Number of points
+   \param mode Interpretation of the points
+   \param numThreads Number of threads for rendering bands of the image.
+                     If numThreads is set to 0, the system specific
+                     ideal thread count is used.
+
+   \sa isSupported()
+ */
+void QwtLineRasterizer::draw( QPainter* painter, const QRectF& rect,
+    const QPointF* points, int numPoints, Mode mode, uint numThreads )
+{
+    if ( numPoints <= 0 )
+        return;
+
+    QRectF paintRect = rect;
+    if ( painter->hasClipping() )
+        paintRect &= painter->clipBoundingRect();
+
+    const QRect imageRect = paintRect.toAlignedRect();
+    if ( imageRect.isEmpty() )
+        return;
+
+    QImage image( imageRect.size(), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QwtRasterJob job;
+    job.points = points;
+    job.numPoints = numPoints;
+    job.mode = mode;
+    job.origin = imageRect.topLeft();
+    job.rgb = painter->pen().color().rgba();
+    job.bits = reinterpret_cast< QRgb* >( image.bits() );
+    job.stride = image.bytesPerLine() / sizeof( QRgb );
+    job.width = image.width();
+    job.height = image.height();
+    job.row0 = 0;
+    job.row1 = image.height();
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    // for small images or a few lines it is not worth the overhead
+
+    const int minRows = 32;
+    const int minPoints = 10000;
+
+    int numBands = qMin( int( numThreads ), image.height() / minRows );
+    if ( numPoints < minPoints )
+        numBands = 1;
+
+    if ( numBands > 1 )
+    {
+        const int bandHeight = image.height() / numBands;
+
+        QVector< QwtRasterJob > jobs( numBands );
+        for ( int i = 0; i < numBands; i++ )
+        {
+            jobs[i] = job;
+            jobs[i].row0 = i * bandHeight;
+            jobs[i].row1 = ( i == numBands - 1 )
+                ? image.height() : ( i + 1 ) * bandHeight;
+        }
+
+        QList< QFuture< void > > futures;
+        for ( int i = 1; i < numBands; i++ )
+            futures += QtConcurrent::run( &qwtRasterizeBand, &jobs[i] );
+
+        qwtRasterizeBand( &jobs[0] );
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+    }
+    else
+    {
+        qwtRasterizeBand( &job );
+    }
+#else
+    Q_UNUSED( numThreads )
+    qwtRasterizeBand( &job );
+#endif
+
+    painter->drawImage( imageRect.topLeft(), image );
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_LINE_RASTERIZER_H
+#define QWT_LINE_RASTERIZER_H
+
+#include "qwt_global.h"
+
+class QPainter;
+class QPointF;
+class QRectF;
+
+/*!
+   \brief A software rasterizer for thin opaque lines
+
+   For cosmetic pens of 1 pixel QPainter spends most of the time
+   in building and dispatching the path of the lines. QwtLineRasterizer
+   sets the pixels of the lines in a temporary image instead,
+   that is painted with one QPainter::drawImage() call. For huge
+   polylines the image might be rendered in parallel, where each
+   thread is responsible for a horizontal band of the image.
+
+   It is a very special optimization used by QwtPlotCurve for the
+   ImageBuffer paint attribute, that is only possible, when
+   isSupported() returns true.
+
+   \sa QwtPlotCurve::ImageBuffer
+ */
+namespace QwtLineRasterizer
+{
+    /*!
+       Interpretation of the points passed to draw()
+     */
+    enum Mode
+    {
+        //! Points of a polyline
+        Polyline,
+
+        //! Pairs of points, where each pair is a line
+        LinePairs
+    };
+
+    QWT_EXPORT bool isSupported( const QPainter* );
+
+    QWT_EXPORT void draw( QPainter*, const QRectF& rect,
+        const QPointF* points, int numPoints, Mode, uint numThreads );
+}
+
+#endif
@@ -0,0 +1,745 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_list_legend.h"
+#include "qwt_plot_item.h"
+#include "qwt_graphic.h"
+#include "qwt_painter.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+
+#include <qapplication.h>
+#include <qabstractitemmodel.h>
+#include <qlistview.h>
+#include <qscrollbar.h>
+#include <qlayout.h>
+#include <qstyle.h>
+#include <qpainter.h>
+#include <qpixmap.h>
+#include <qcache.h>
+#include <qhash.h>
+#include <qvector.h>
+
+static const int qwtLegendMargin = 2;
+static const int qwtLegendSpacing = 4;
+
+static inline quintptr qwtItemKey( const QVariant& itemInfo )
+{
+    // the default implementation of QwtPlot::itemToInfo()
+    if ( itemInfo.canConvert< QwtPlotItem* >() )
+        return reinterpret_cast< quintptr >( qvariant_cast< QwtPlotItem* >( itemInfo ) );
+
+    return 0;
+}
+
+namespace
+{
+    // the entries of a plot item
+    class LegendEntry
+    {
+      public:
+        LegendEntry()
+            : serial( 0 )
+        {
+        }
+
+        QVariant itemInfo;
+        QList< QwtLegendData > data;
+        QVector< bool > checked;
+
+        // to identify the cached icons
+        quint64 serial;
+
+        // maximum size of icon and title
+        QSize size;
+    };
+
+    class LegendModel : public QAbstractListModel
+    {
+      public:
+        LegendModel( QObject* parent )
+            : QAbstractListModel( parent )
+            , m_defaultMode( QwtLegendData::ReadOnly )
+            , m_serial( 0 )
+            , m_icons( 500 )
+        {
+        }
+
+        virtual int rowCount(
+            const QModelIndex& parent = QModelIndex() ) const QWT_OVERRIDE
+        {
+            return parent.isValid() ? 0 : m_rows.size();
+        }
+
+        virtual QVariant data(
+            const QModelIndex& index, int role ) const QWT_OVERRIDE;
+
+        void setDefaultMode( QwtLegendData::Mode mode )
+        {
+            beginResetModel();
+            m_defaultMode = mode;
+            endResetModel();
+        }
+
+        QwtLegendData::Mode defaultMode() const
+        {
+            return m_defaultMode;
+        }
+
+        inline QwtLegendData::Mode mode( const QwtLegendData& data ) const
+        {
+            if ( data.hasRole( QwtLegendData::ModeRole ) )
+                return data.mode();
+
+            return m_defaultMode;
+        }
+
+        void setIconCacheSize( int numIcons )
+        {
+            m_icons.setMaxCost( numIcons );
+        }
+
+        int iconCacheSize() const
+        {
+            return m_icons.maxCost();
+        }
+
+        void update( const QList< LegendEntry >&,
+            const QFont&, int indicatorExtent );
+
+        inline int numRows() const
+        {
+            return m_rows.size();
+        }
+
+        inline const LegendEntry& entryAt( int row ) const
+        {
+            return m_entries[ m_rows[row].first ];
+        }
+
+        inline int dataIndex( int row ) const
+        {
+            return m_rows[row].second;
+        }
+
+        inline const QwtLegendData& dataAt( int row ) const
+        {
+            return entryAt( row ).data[ dataIndex( row ) ];
+        }
+
+        inline QSize rowSize() const
+        {
+            return m_rowSize;
+        }
+
+        bool toggle( int row )
+        {
+            LegendEntry& entry = m_entries[ m_rows[row].first ];
+
+            bool& on = entry.checked[ m_rows[row].second ];
+            on = !on;
+
+            const QModelIndex idx = index( row );
+            Q_EMIT dataChanged( idx, idx );
+
+            return on;
+        }
+
+      private:
+        int find( const QVariant& itemInfo ) const
+        {
+            const quintptr key = qwtItemKey( itemInfo );
+            if ( key != 0 )
+                return m_index.value( key, -1 );
+
+            for ( int i = 0; i < m_entries.size(); i++ )
+            {
+                if ( m_entries[i].itemInfo == itemInfo )
+                    return i;
+            }
+
+            return -1;
+        }
+
+        QwtLegendData::Mode m_defaultMode;
+
+        QList< LegendEntry > m_entries;
+        QHash< quintptr, int > m_index;
+
+        // row -> entry, index of the data
+        QVector< QPair< int, int > > m_rows;
+        QSize m_rowSize;
+
+        quint64 m_serial;
+        mutable QCache< quint64, QPixmap > m_icons;
+    };
+}
+
+static QSize qwtEntrySize( const QList< QwtLegendData >& data, const QFont& font )
+{
+    QSize size;
+
+    for ( int i = 0; i < data.size(); i++ )
+    {
+        const QSizeF iconSize = data[i].icon().defaultSize();
+        const QSizeF textSize = data[i].title().textSize( font );
+
+        double w = textSize.width();
+        if ( iconSize.width() > 0.0 )
+            w += iconSize.width() + qwtLegendSpacing;
+
+        const double h = qMax( iconSize.height(), textSize.height() );
+
+        size = size.expandedTo( QSize( qwtCeil( w ), qwtCeil( h ) ) );
+    }
+
+    return size;
+}
+
+QVariant LegendModel::data( const QModelIndex& index, int role ) const
+{
+    const int row = index.row();
+    if ( !index.isValid() || row < 0 || row >= m_rows.size() )
+        return QVariant();
+
+    const LegendEntry& entry = entryAt( row );
+    const QwtLegendData& data = dataAt( row );
+
+    switch ( role )
+    {
+        case Qt::DisplayRole:
+        {
+            return data.title().text();
+        }
+        case Qt::DecorationRole:
+        {
+            const quint64 key = ( entry.serial << 16 ) | quint64( dataIndex( row ) );
+
+            const QPixmap* icon = m_icons.object( key );
+            if ( icon )
+                return *icon;
+
+            // rendering the icon, when it is displayed the first time
+            const QwtGraphic graphic = data.icon();
+            if ( graphic.isNull() )
+                return QVariant();
+
+            const QPixmap pixmap = graphic.toPixmap();
+            m_icons.insert( key, new QPixmap( pixmap ) );
+
+            return pixmap;
+        }
+        case Qt::FontRole:
+        {
+            const QwtText title = data.title();
+            if ( title.testPaintAttribute( QwtText::PaintUsingTextFont ) )
+                return title.font();
+
+            break;
+        }
+        case Qt::ForegroundRole:
+        {
+            const QwtText title = data.title();
+            if ( title.testPaintAttribute( QwtText::PaintUsingTextColor ) )
+                return QBrush( title.color() );
+
+            break;
+        }
+        case Qt::CheckStateRole:
+        {
+            if ( mode( data ) == QwtLegendData::Checkable )
+            {
+                const bool on = entry.checked[ dataIndex( row ) ];
+                return on ? Qt::Checked : Qt::Unchecked;
+            }
+
+            break;
+        }
+        case Qt::SizeHintRole:
+        {
+            return m_rowSize;
+        }
+        default:
+            break;
+    }
+
+    return QVariant();
+}
+
+void LegendModel::update( const QList< LegendEntry >& updates,
+    const QFont& font, int indicatorExtent )
+{
+    beginResetModel();
+
+    bool hasRemovals = false;
+
+    for ( int i = 0; i < updates.size(); i++ )
+    {
+        const LegendEntry& update = updates[i];
+
+        const int pos = find( update.itemInfo );
+        if ( update.data.isEmpty() )
+        {
+            if ( pos >= 0 )
+            {
+                // removed, when compressing the list below
+                m_entries[pos].data.clear();
+                hasRemovals = true;
+            }
+
+            continue;
+        }
+
+        LegendEntry entry = update;
+        entry.serial = ++m_serial;
+        entry.size = qwtEntrySize( entry.data, font );
+
+        if ( pos >= 0 )
+        {
+            entry.checked = m_entries[pos].checked;
+            entry.checked.resize( entry.data.size() );
+
+            m_entries[pos] = entry;
+        }
+        else
+        {
+            entry.checked.fill( false, entry.data.size() );
+            m_entries += entry;
+
+            const quintptr key = qwtItemKey( entry.itemInfo );
+            if ( key != 0 )
+                m_index.insert( key, m_entries.size() - 1 );
+        }
+    }
+
+    if ( hasRemovals )
+    {
+        QList< LegendEntry > entries;
+        entries.reserve( m_entries.size() );
+
+        m_index.clear();
+
+        for ( int i = 0; i < m_entries.size(); i++ )
+        {
+            if ( !m_entries[i].data.isEmpty() )
+            {
+                entries += m_entries[i];
+
+                const quintptr key = qwtItemKey( m_entries[i].itemInfo );
+                if ( key != 0 )
+                    m_index.insert( key, entries.size() - 1 );
+            }
+        }
+
+        m_entries = entries;
+    }
+
+    m_rows.clear();
+
+    QSize size;
+    bool hasCheckable = false;
+
+    for ( int i = 0; i < m_entries.size(); i++ )
+    {
+        const LegendEntry& entry = m_entries[i];
+
+        for ( int j = 0; j < entry.data.size(); j++ )
+        {
+            m_rows += qMakePair( i, j );
+
+            if ( mode( entry.data[j] ) == QwtLegendData::Checkable )
+                hasCheckable = true;
+        }
+
+        size = size.expandedTo( entry.size );
+    }
+
+    if ( hasCheckable )
+        size.rwidth() += indicatorExtent;
+
+    m_rowSize = size + QSize( 2 * qwtLegendMargin, 2 * qwtLegendMargin );
+
+    endResetModel();
+}
+
+class QwtListLegend::PrivateData
+{
+  public:
+    PrivateData()
+        : model( NULL )
+        , view( NULL )
+        , isFlushPending( false )
+    {
+    }
+
+    LegendModel* model;
+    QListView* view;
+
+    // updates, that have not been applied yet
+    QList< LegendEntry > pending;
+    QHash< quintptr, int > pendingIndex;
+
+    bool isFlushPending;
+};
+
+/*!
+   Constructor
+   \param parent Parent widget
+ */
+QwtListLegend::QwtListLegend( QWidget* parent )
+    : QwtAbstractLegend( parent )
+{
+    setFrameStyle( NoFrame );
+
+    m_data = new PrivateData;
+
+    m_data->model = new LegendModel( this );
+
+    QListView* view = new QListView( this );
+    view->setObjectName( "QwtListLegendView" );
+    view->setFrameStyle( NoFrame );
+    view->setUniformItemSizes( true );
+    view->setSelectionMode( QAbstractItemView::NoSelection );
+    view->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    view->setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    view->setModel( m_data->model );
+
+    connect( view, SIGNAL(clicked(const QModelIndex&)),
+        this, SLOT(handleClick(const QModelIndex&)) );
+
+    m_data->view = view;
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( view );
+}
+
+//! Destructor
+QwtListLegend::~QwtListLegend()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the default mode for the entries
+
+   The default mode is used for all entries, that have
+   no QwtLegendData::ModeRole.
+
+   \param mode Default item mode
+   \sa defaultItemMode(), QwtLegend::setDefaultItemMode()
+ */
+void QwtListLegend::setDefaultItemMode( QwtLegendData::Mode mode )
+{
+    if ( mode != m_data->model->defaultMode() )
+    {
+        m_data->model->setDefaultMode( mode );
+        updateGeometry();
+    }
+}
+
+/*!
+   \return Default item mode
+   \sa setDefaultItemMode()
+ */
+QwtLegendData::Mode QwtListLegend::defaultItemMode() const
+{
+    return m_data->model->defaultMode();
+}
+
+/*!
+   \brief Set the maximum number of icons in the pixmap cache
+
+   The default setting is 500.
+
+   \param numIcons Maximum number of cached icons
+   \sa iconCacheSize()
+ */
+void QwtListLegend::setIconCacheSize( int numIcons )
+{
+    m_data->model->setIconCacheSize( qMax( numIcons, 0 ) );
+}
+
+/*!
+   \return Maximum number of icons in the pixmap cache
+   \sa setIconCacheSize()
+ */
+int QwtListLegend::iconCacheSize() const
+{
+    return m_data->model->iconCacheSize();
+}
+
+//! \return List view displaying the entries
+QListView* QwtListLegend::view() const
+{
+    return m_data->view;
+}
+
+//! \return Number of entries
+int QwtListLegend::entryCount() const
+{
+    const_cast< QwtListLegend* >( this )->flushUpdates();
+    return m_data->model->numRows();
+}
+
+/*!
+   \brief Update the entries for a plot item
+
+   The update is applied, when the application returns to the event loop
+   or flushUpdates() is called. Further updates for the same item in
+   between replace the pending one.
+
+   \param itemInfo Info for an item
+   \param data List of legend entry attributes for the item
+ */
+void QwtListLegend::updateLegend( const QVariant& itemInfo,
+    const QList< QwtLegendData >& data )
+{
+    LegendEntry entry;
+    entry.itemInfo = itemInfo;
+    entry.data = data;
+
+    QList< LegendEntry >& pending = m_data->pending;
+
+    int pos = -1;
+
+    const quintptr key = qwtItemKey( itemInfo );
+    if ( key != 0 )
+    {
+        pos = m_data->pendingIndex.value( key, -1 );
+    }
+    else
+    {
+        for ( int i = 0; i < pending.size(); i++ )
+        {
+            if ( pending[i].itemInfo == itemInfo )
+            {
+                pos = i;
+                break;
+            }
+        }
+    }
+
+    if ( pos >= 0 )
+    {
+        pending[pos] = entry;
+    }
+    else
+    {
+        pending += entry;
+
+        if ( key != 0 )
+            m_data->pendingIndex.insert( key, pending.size() - 1 );
+    }
+
+    if ( !m_data->isFlushPending )
+    {
+        m_data->isFlushPending = true;
+        QMetaObject::invokeMethod( this, "flushUpdates", Qt::QueuedConnection );
+    }
+}
+
+/*!
+   \brief Apply all pending updates
+
+   The view is updated once for all updates and the parent widget
+   ( usually QwtPlot ) is requested to recalculate its layout.
+
+   \sa updateLegend()
+ */
+void QwtListLegend::flushUpdates()
+{
+    m_data->isFlushPending = false;
+
+    if ( m_data->pending.isEmpty() )
+        return;
+
+    const QList< LegendEntry > pending = m_data->pending;
+
+    m_data->pending.clear();
+    m_data->pendingIndex.clear();
+
+    const QStyle* style = m_data->view->style();
+    const int indicatorExtent = style->pixelMetric( QStyle::PM_IndicatorWidth )
+        + style->pixelMetric( QStyle::PM_CheckBoxLabelSpacing );
+
+    m_data->model->update( pending, m_data->view->font(), indicatorExtent );
+
+    updateGeometry();
+
+    if ( parentWidget() && parentWidget()->layout() == NULL )
+    {
+        // see QwtLegend::eventFilter()
+        QApplication::postEvent( parentWidget(),
+            new QEvent( QEvent::LayoutRequest ) );
+    }
+}
+
+/*!
+   \return Size hint, that is large enough for all entries
+ */
+QSize QwtListLegend::sizeHint() const
+{
+    const_cast< QwtListLegend* >( this )->flushUpdates();
+
+    const LegendModel* model = m_data->model;
+
+    QSize hint( model->rowSize().width(),
+        model->numRows() * model->rowSize().height() );
+
+    const int fw = 2 * frameWidth();
+    hint += QSize( fw, fw );
+
+    return hint;
+}
+
+/*!
+   Render the legend into a given rectangle.
+
+   The entries are arranged in columns, that are filled from top to bottom.
+
+   \param painter Painter
+   \param rect Bounding rectangle
+   \param fillBackground When true, fill rect with the widget background
+
+   \sa renderLegend() is used by QwtPlotRenderer
+ */
+void QwtListLegend::renderLegend( QPainter* painter,
+    const QRectF& rect, bool fillBackground ) const
+{
+    const_cast< QwtListLegend* >( this )->flushUpdates();
+
+    const LegendModel* model = m_data->model;
+
+    const int numRows = model->numRows();
+    if ( numRows == 0 )
+        return;
+
+    if ( fillBackground )
+    {
+        if ( autoFillBackground() ||
+            testAttribute( Qt::WA_StyledBackground ) )
+        {
+            QwtPainter::drawBackgound( painter, rect, this );
+        }
+    }
+
+    const QSize rowSize = model->rowSize();
+
+    const int rowsPerColumn = qMax( qwtFloor( rect.height() / rowSize.height() ), 1 );
+    const int numColumns = ( numRows + rowsPerColumn - 1 ) / rowsPerColumn;
+
+    const double columnWidth = rect.width() / numColumns;
+
+    QFont font = m_data->view->font();
+#if QT_VERSION >= 0x060000
+    font.setResolveMask( QFont::AllPropertiesResolved );
+#else
+    font.resolve( QFont::AllPropertiesResolved );
+#endif
+
+    painter->save();
+
+    painter->setFont( font );
+    painter->setPen( palette().color( QPalette::Text ) );
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        const QwtLegendData& data = model->dataAt( row );
+
+        const QRectF entryRect(
+            rect.x() + ( row / rowsPerColumn ) * columnWidth,
+            rect.y() + ( row % rowsPerColumn ) * rowSize.height(),
+            columnWidth, rowSize.height() );
+
+        const QRectF r = entryRect.adjusted( qwtLegendMargin,
+            qwtLegendMargin, -qwtLegendMargin, -qwtLegendMargin );
+
+        painter->save();
+        painter->setClipRect( entryRect, Qt::IntersectClip );
+
+        const QwtGraphic icon = data.icon();
+        const QSizeF sz = icon.defaultSize();
+
+        const QRectF iconRect( r.x(), r.center().y() - 0.5 * sz.height(),
+            sz.width(), sz.height() );
+
+        if ( !icon.isNull() )
+            icon.render( painter, iconRect, Qt::KeepAspectRatio );
+
+        QRectF titleRect = r;
+        if ( sz.width() > 0.0 )
+            titleRect.setX( iconRect.right() + qwtLegendSpacing );
+
+        QwtText title = data.title();
+        title.setRenderFlags( Qt::AlignLeft | Qt::AlignVCenter );
+        title.draw( painter, titleRect );
+
+        painter->restore();
+    }
+
+    painter->restore();
+}
+
+//! \return True, when there are no entries
+bool QwtListLegend::isEmpty() const
+{
+    return entryCount() == 0;
+}
+
+/*!
+    Return the extent, that is needed for the scrollbars
+
+    \param orientation Orientation
+    \return The width of the vertical scrollbar for Qt::Horizontal and v.v.
+ */
+int QwtListLegend::scrollExtent( Qt::Orientation orientation ) const
+{
+    int extent = 0;
+
+    if ( orientation == Qt::Horizontal )
+        extent = m_data->view->verticalScrollBar()->sizeHint().width();
+    else
+        extent = m_data->view->horizontalScrollBar()->sizeHint().height();
+
+    return extent;
+}
+
+void QwtListLegend::handleClick( const QModelIndex& index )
+{
+    const int row = index.row();
+    if ( !index.isValid() || row >= m_data->model->numRows() )
+        return;
+
+    LegendModel* model = m_data->model;
+
+    const QVariant itemInfo = model->entryAt( row ).itemInfo;
+    const int dataIndex = model->dataIndex( row );
+
+    switch ( model->mode( model->dataAt( row ) ) )
+    {
+        case QwtLegendData::Clickable:
+        {
+            Q_EMIT clicked( itemInfo, dataIndex );
+            break;
+        }
+        case QwtLegendData::Checkable:
+        {
+            const bool on = model->toggle( row );
+            Q_EMIT checked( itemInfo, on, dataIndex );
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_list_legend.cpp"
+#endif
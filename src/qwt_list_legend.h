@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_LIST_LEGEND_H
+#define QWT_LIST_LEGEND_H
+
+#include "qwt_global.h"
+#include "qwt_abstract_legend.h"
+#include "qwt_legend_data.h"
+
+class QListView;
+class QModelIndex;
+
+/*!
+   \brief A legend for plots with many items
+
+   QwtLegend creates a widget for each entry, what doesn't scale
+   for plots with thousands of items. QwtListLegend displays the entries
+   in a QListView, where only the visible rows are painted - all by
+   the same item delegate.
+
+   - The icons ( QwtLegendData::icon() ) are rendered into pixmaps,
+     when a row becomes visible the first time. The pixmaps are kept
+     in a cache of limited size ( see setIconCacheSize() ).
+
+   - Updates of the entries are collected and applied together,
+     when the application returns to the event loop. So attaching
+     or modifying many items results in one update of the view and
+     one layout request of the plot only.
+
+   Titles are displayed as plain text with the font and color of
+   the QwtText.
+
+   \par Example
+   \code
+   plot->insertLegend( new QwtListLegend(), QwtPlot::RightLegend );
+   \endcode
+   \endpar
+
+   \sa QwtLegend, QwtPlot::insertLegend()
+ */
+class QWT_EXPORT QwtListLegend : public QwtAbstractLegend
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtListLegend( QWidget* parent = NULL );
+    virtual ~QwtListLegend();
+
+    void setDefaultItemMode( QwtLegendData::Mode );
+    QwtLegendData::Mode defaultItemMode() const;
+
+    void setIconCacheSize( int numIcons );
+    int iconCacheSize() const;
+
+    QListView* view() const;
+
+    int entryCount() const;
+
+    virtual QSize sizeHint() const QWT_OVERRIDE;
+
+    virtual void renderLegend( QPainter*,
+        const QRectF&, bool fillBackground ) const QWT_OVERRIDE;
+
+    virtual bool isEmpty() const QWT_OVERRIDE;
+    virtual int scrollExtent( Qt::Orientation ) const QWT_OVERRIDE;
+
+  Q_SIGNALS:
+    /*!
+       A signal which is emitted when the user has clicked on
+       an entry, which is in QwtLegendData::Clickable mode.
+
+       \param itemInfo Info for the item of the selected entry
+       \param index Index of the entry in the list of entries,
+                   that are associated with the plot item
+
+       \sa setDefaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void clicked( const QVariant& itemInfo, int index );
+
+    /*!
+       A signal which is emitted when the user has clicked on
+       an entry, which is in QwtLegendData::Checkable mode
+
+       \param itemInfo Info for the item of the selected entry
+       \param on True when the entry is checked
+       \param index Index of the entry in the list of entries,
+                   that are associated with the plot item
+
+       \sa setDefaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void checked( const QVariant& itemInfo, bool on, int index );
+
+  public Q_SLOTS:
+    virtual void updateLegend( const QVariant&,
+        const QList< QwtLegendData >& ) QWT_OVERRIDE;
+
+    void flushUpdates();
+
+  private Q_SLOTS:
+    void handleClick( const QModelIndex& );
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -20,6 +20,9 @@ class QwtMagnifier::PrivateData
         : isEnabled( false )
         , wheelFactor( 0.9 )
         , wheelModifiers( Qt::NoModifier )
+        , wheelInterval( 0 )
+        , wheelTimerId( 0 )
+        , pendingWheelFactor( 1.0 )
         , mouseFactor( 0.95 )
         , mouseButton( Qt::RightButton )
         , mouseButtonModifiers( Qt::NoModifier )
@@ -38,6 +41,10 @@ class QwtMagnifier::PrivateData
     double wheelFactor;
     Qt::KeyboardModifiers wheelModifiers;
 
+    int wheelInterval;
+    int wheelTimerId;
+    double pendingWheelFactor;
+
     double mouseFactor;
 
     Qt::MouseButton mouseButton;
@@ -103,6 +110,14 @@ void QwtMagnifier::setEnabled( bool on )
             else
                 o->removeEventFilter( this );
         }
+
+        if ( !m_data->isEnabled && m_data->wheelTimerId != 0 )
+        {
+            killTimer( m_data->wheelTimerId );
+
+            m_data->wheelTimerId = 0;
+            m_data->pendingWheelFactor = 1.0;
+        }
     }
 }
 
@@ -166,6 +181,34 @@ Qt::KeyboardModifiers QwtMagnifier::wheelModifiers() const
     return m_data->wheelModifiers;
 }
 
+/*!
+   \brief Set the interval for accumulating wheel steps
+
+   When the interval is > 0, the first wheel event starts a timer and
+   all steps until it expires are accumulated into one factor,
+   that is passed to rescale(). So spinning the wheel results in
+   one rescale/replot for each interval instead of one for each step.
+
+   The default setting is 0, where each wheel event is
+   passed to rescale() immediately.
+
+   \param msec Interval in milliseconds
+   \sa wheelCoalescingInterval(), setWheelFactor()
+ */
+void QwtMagnifier::setWheelCoalescingInterval( int msec )
+{
+    m_data->wheelInterval = qMax( msec, 0 );
+}
+
+/*!
+   \return Interval for accumulating wheel steps
+   \sa setWheelCoalescingInterval()
+ */
+int QwtMagnifier::wheelCoalescingInterval() const
+{
+    return m_data->wheelInterval;
+}
+
 /*!
    \brief Change the mouse factor
 
@@ -460,8 +503,42 @@ void QwtMagnifier::widgetWheelEvent( QWheelEvent* wheelEvent )
         if ( wheelDelta > 0 )
             f = 1 / f;
 
+        if ( m_data->wheelInterval > 0 )
+        {
+            m_data->pendingWheelFactor *= f;
+
+            if ( m_data->wheelTimerId == 0 )
+                m_data->wheelTimerId = startTimer( m_data->wheelInterval );
+        }
+        else
+        {
+            rescale( f );
+        }
+    }
+}
+
+/*!
+   Apply the accumulated wheel steps
+
+   \param event Timer event
+   \sa setWheelCoalescingInterval()
+ */
+void QwtMagnifier::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->wheelTimerId )
+    {
+        killTimer( m_data->wheelTimerId );
+        m_data->wheelTimerId = 0;
+
+        const double f = m_data->pendingWheelFactor;
+        m_data->pendingWheelFactor = 1.0;
+
         rescale( f );
+
+        return;
     }
+
+    QObject::timerEvent( event );
 }
 
 /*!
@@ -23,6 +23,13 @@ class QKeyEvent;
 
    Using QwtMagnifier a plot can be zoomed in/out in steps using
    keys, the mouse wheel or moving a mouse button in vertical direction.
+
+   Spinning the wheel generates bursts of wheel events, where each
+   step would result in rescaling and repainting the widget. With
+   a wheel coalescing interval the steps are accumulated and applied
+   by one call of rescale().
+
+   \sa setWheelCoalescingInterval()
  */
 class QWT_EXPORT QwtMagnifier : public QObject
 {
@@ -52,6 +59,9 @@ class QWT_EXPORT QwtMagnifier : public QObject
     void setWheelModifiers( Qt::KeyboardModifiers );
     Qt::KeyboardModifiers wheelModifiers() const;
 
+    void setWheelCoalescingInterval( int msec );
+    int wheelCoalescingInterval() const;
+
     // keyboard
     void setKeyFactor( double );
     double keyFactor() const;
@@ -78,6 +88,8 @@ class QWT_EXPORT QwtMagnifier : public QObject
     virtual void widgetKeyPressEvent( QKeyEvent* );
     virtual void widgetKeyReleaseEvent( QKeyEvent* );
 
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -0,0 +1,789 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qfile.h>
+#include <qstring.h>
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qrect.h>
+
+#include <cstring>
+#include <climits>
+
+namespace
+{
+    enum
+    {
+        MaxLevels = 32,
+        ByteOrderMark = 0x01020304,
+        FormatVersion = 1
+    };
+
+    const char qwtRasterMagic[8] = { 'Q', 'W', 'T', 'R', 'A', 'S', 'T', 'R' };
+
+    // layout of the first bytes of a file - without any padding
+
+    class QwtRasterFileHeader
+    {
+      public:
+        char magic[8];
+        quint32 byteOrder;
+        quint32 version;
+
+        quint32 numColumns;
+        quint32 numRows;
+        quint32 tileSize;
+        quint32 numLevels;
+        quint32 reduction;
+        quint32 reserved;
+
+        double minValue;
+        double maxValue;
+
+        quint64 levelOffsets[MaxLevels];
+    };
+
+    class QwtRasterLevel
+    {
+      public:
+        QwtRasterLevel()
+            : numColumns( 0 )
+            , numRows( 0 )
+            , tileColumns( 0 )
+            , tileRows( 0 )
+            , offset( 0 )
+            , values( NULL )
+        {
+        }
+
+        inline qint64 byteCount( int tileSize ) const
+        {
+            return qint64( tileColumns ) * tileRows
+                * tileSize * tileSize * qint64( sizeof( float ) );
+        }
+
+        inline const float* tileRow( int tileSize, int row ) const
+        {
+            // first value of the row inside the first tile of its tile row
+
+            const int tileRow = row / tileSize;
+            return values + ( qint64( tileRow ) * tileColumns * tileSize
+                + row % tileSize ) * tileSize;
+        }
+
+        inline float value( int tileSize, int row, int col ) const
+        {
+            return valueAt( tileRow( tileSize, row ), tileSize, col );
+        }
+
+        static inline float valueAt( const float* row, int tileSize, int col )
+        {
+            return row[ qint64( col / tileSize ) * tileSize * tileSize
+                + col % tileSize ];
+        }
+
+        int numColumns;
+        int numRows;
+        int tileColumns;
+        int tileRows;
+
+        quint64 offset;
+        const float* values;
+    };
+
+    class QwtMappedLevelContext : public QwtRasterData::RenderContext
+    {
+      public:
+        QwtMappedLevelContext( const QwtMappedRasterData* data,
+                const QRectF& area, const QSize& raster )
+            : QwtRasterData::RenderContext( data, area, raster )
+            , m_level( data->levelFor( area, raster ) )
+        {
+        }
+
+        virtual double value( double x, double y ) QWT_OVERRIDE
+        {
+            double v;
+            values( y, &x, 1, &v );
+
+            return v;
+        }
+
+        virtual void values( double y, const double* x,
+            int numValues, double* values ) QWT_OVERRIDE;
+
+      private:
+        const int m_level;
+    };
+}
+
+static inline qint64 qwtAlignedOffset( qint64 offset )
+{
+    return ( offset + 15 ) & ~qint64( 15 );
+}
+
+static int qwtLevels( int numColumns, int numRows,
+    int tileSize, QwtRasterLevel levels[MaxLevels] )
+{
+    qint64 offset = qwtAlignedOffset( sizeof( QwtRasterFileHeader ) );
+
+    int numLevels = 0;
+    while ( numLevels < MaxLevels )
+    {
+        QwtRasterLevel& level = levels[ numLevels++ ];
+
+        level.numColumns = numColumns;
+        level.numRows = numRows;
+        level.tileColumns = ( numColumns + tileSize - 1 ) / tileSize;
+        level.tileRows = ( numRows + tileSize - 1 ) / tileSize;
+        level.offset = offset;
+
+        offset = qwtAlignedOffset( offset + level.byteCount( tileSize ) );
+
+        if ( numColumns <= tileSize && numRows <= tileSize )
+            break;
+
+        numColumns = ( numColumns + 1 ) / 2;
+        numRows = ( numRows + 1 ) / 2;
+    }
+
+    return numLevels;
+}
+
+static inline float qwtReduce( const float v[4],
+    QwtMappedRasterData::Reduction reduction )
+{
+    // ignoring gaps and values outside of the matrix ( NaN )
+
+    int count = 0;
+    float sum = 0.0f;
+    float max = 0.0f;
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        if ( qIsFinite( v[i] ) )
+        {
+            if ( count == 0 || v[i] > max )
+                max = v[i];
+
+            sum += v[i];
+            count++;
+        }
+    }
+
+    if ( count == 0 )
+        return qQNaN();
+
+    if ( reduction == QwtMappedRasterData::Maximum )
+        return max;
+
+    return sum / count;
+}
+
+void QwtMappedLevelContext::values( double y, const double* x,
+    int numValues, double* values )
+{
+    /*
+        The context only reads from the mapped memory and does
+        not need any synchronization with other contexts.
+     */
+    const QwtMappedRasterData* mappedData =
+        static_cast< const QwtMappedRasterData* >( data() );
+
+    mappedData->levelValues( m_level, y, x, numValues, values );
+}
+
+class QwtMappedRasterData::PrivateData
+{
+  public:
+    PrivateData()
+        : memory( NULL )
+        , numLevels( 0 )
+        , tileSize( 0 )
+        , reduction( QwtMappedRasterData::Mean )
+        , level( 0 )
+    {
+    }
+
+    QFile file;
+    uchar* memory;
+
+    QwtRasterLevel levels[MaxLevels];
+    int numLevels;
+    int tileSize;
+
+    QwtMappedRasterData::Reduction reduction;
+    QwtInterval valueRange;
+
+    QwtInterval intervals[3];
+    int level;
+};
+
+/*!
+   \brief Values of a row of a specific level
+
+   \param levelIndex Level, 0 = full resolution
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa values(), levelFor()
+ */
+void QwtMappedRasterData::levelValues( int levelIndex,
+    double y, const double* x, int numValues, double* values ) const
+{
+    const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+    const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+    const int tileSize = m_data->tileSize;
+
+    if ( m_data->memory == NULL || !yInterval.contains( y ) )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            values[i] = qQNaN();
+
+        return;
+    }
+
+    const QwtRasterLevel& lvl =
+        m_data->levels[ qBound( 0, levelIndex, m_data->numLevels - 1 ) ];
+
+    const double dx = xInterval.width() / lvl.numColumns;
+    const double dy = yInterval.width() / lvl.numRows;
+    const double x0 = xInterval.minValue();
+
+    int row = int( ( y - yInterval.minValue() ) / dy );
+    if ( row >= lvl.numRows )
+        row = lvl.numRows - 1;
+
+    const float* r = lvl.tileRow( tileSize, row );
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        if ( !xInterval.contains( x[i] ) )
+        {
+            values[i] = qQNaN();
+            continue;
+        }
+
+        int col = int( ( x[i] - x0 ) / dx );
+        if ( col >= lvl.numColumns )
+            col = lvl.numColumns - 1;
+
+        values[i] = QwtRasterLevel::valueAt( r, tileSize, col );
+    }
+}
+
+//! Constructor
+QwtMappedRasterData::QwtMappedRasterData()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtMappedRasterData::~QwtMappedRasterData()
+{
+    close();
+    delete m_data;
+}
+
+/*!
+   \brief Map a file, that has been created by createFile()
+
+   Only the header of the file is read, the values are loaded
+   by the operating system, when they are accessed.
+
+   \param fileName Name of the file
+   \return true, when the file could be mapped
+
+   \sa close(), createFile()
+ */
+bool QwtMappedRasterData::open( const QString& fileName )
+{
+    close();
+
+    m_data->file.setFileName( fileName );
+    if ( !m_data->file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 fileSize = m_data->file.size();
+
+    QwtRasterFileHeader header;
+    if ( fileSize < qint64( sizeof( header ) ) ||
+        m_data->file.read( reinterpret_cast< char* >( &header ),
+            sizeof( header ) ) != qint64( sizeof( header ) ) )
+    {
+        m_data->file.close();
+        return false;
+    }
+
+    const bool isValid =
+        std::memcmp( header.magic, qwtRasterMagic, sizeof( qwtRasterMagic ) ) == 0
+        && header.byteOrder == ByteOrderMark && header.version == FormatVersion
+        && header.numColumns > 0 && header.numColumns <= quint32( INT_MAX )
+        && header.numRows > 0 && header.numRows <= quint32( INT_MAX )
+        && header.tileSize > 0 && header.tileSize <= 4096;
+
+    QwtRasterLevel levels[MaxLevels];
+    int numLevels = 0;
+
+    if ( isValid )
+    {
+        numLevels = qwtLevels( header.numColumns, header.numRows,
+            header.tileSize, levels );
+    }
+
+    if ( numLevels <= 0 || quint32( numLevels ) != header.numLevels
+        || qint64( levels[numLevels - 1].offset
+            + levels[numLevels - 1].byteCount( header.tileSize ) ) > fileSize )
+    {
+        m_data->file.close();
+        return false;
+    }
+
+    uchar* memory = m_data->file.map( 0, fileSize );
+    if ( memory == NULL )
+    {
+        m_data->file.close();
+        return false;
+    }
+
+    for ( int i = 0; i < numLevels; i++ )
+    {
+        levels[i].values = reinterpret_cast< const float* >(
+            memory + levels[i].offset );
+
+        m_data->levels[i] = levels[i];
+    }
+
+    m_data->memory = memory;
+    m_data->numLevels = numLevels;
+    m_data->tileSize = header.tileSize;
+    m_data->reduction = ( header.reduction == Maximum ) ? Maximum : Mean;
+    m_data->valueRange = QwtInterval( header.minValue, header.maxValue );
+    m_data->level = 0;
+
+    return true;
+}
+
+/*!
+   Unmap the file
+   \sa open()
+ */
+void QwtMappedRasterData::close()
+{
+    if ( m_data->memory )
+    {
+        m_data->file.unmap( m_data->memory );
+        m_data->memory = NULL;
+    }
+
+    if ( m_data->file.isOpen() )
+        m_data->file.close();
+
+    m_data->numLevels = 0;
+    m_data->tileSize = 0;
+    m_data->valueRange = QwtInterval();
+    m_data->level = 0;
+}
+
+/*!
+   \return true, when a file is mapped
+   \sa open(), close()
+ */
+bool QwtMappedRasterData::isOpen() const
+{
+    return m_data->memory != NULL;
+}
+
+//! \return Name of the file
+QString QwtMappedRasterData::fileName() const
+{
+    return m_data->file.fileName();
+}
+
+/*!
+   \brief Create a file for QwtMappedRasterData
+
+   The file is resized to its final size and mapped into memory.
+   Then the tiles of the full resolution are copied from values, and
+   the following levels are calculated from their previous level -
+   without holding more than the mapped pages in memory. So values might
+   be another mapped file with the raw matrix.
+
+   \param fileName Name of the file
+   \param values Matrix of numRows rows of numColumns values;
+                 NaN values indicate gaps
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param stride Number of values between the beginnings of
+                 2 rows. A value < numColumns means numColumns.
+   \param reduction Algorithm for calculating the values of a level
+   \param tileSize Number of columns and rows of a tile
+
+   \return true on success
+   \sa open()
+ */
+bool QwtMappedRasterData::createFile( const QString& fileName,
+    const float* values, int numColumns, int numRows,
+    int stride, Reduction reduction, int tileSize )
+{
+    if ( values == NULL || numColumns <= 0 || numRows <= 0 )
+        return false;
+
+    stride = qMax( stride, numColumns );
+    tileSize = qBound( 16, tileSize, 4096 );
+
+    QwtRasterLevel levels[MaxLevels];
+    const int numLevels = qwtLevels( numColumns, numRows, tileSize, levels );
+
+    const QwtRasterLevel& lastLevel = levels[numLevels - 1];
+    const qint64 fileSize = lastLevel.offset + lastLevel.byteCount( tileSize );
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadWrite | QIODevice::Truncate ) )
+        return false;
+
+    if ( !file.resize( fileSize ) )
+        return false;
+
+    uchar* memory = file.map( 0, fileSize );
+    if ( memory == NULL )
+        return false;
+
+    bool hasValues = false;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+
+    for ( int l = 0; l < numLevels; l++ )
+    {
+        QwtRasterLevel& level = levels[l];
+        level.values = reinterpret_cast< const float* >( memory + level.offset );
+
+        float* tile = reinterpret_cast< float* >( memory + level.offset );
+
+        for ( int tr = 0; tr < level.tileRows; tr++ )
+        {
+            for ( int tc = 0; tc < level.tileColumns; tc++ )
+            {
+                for ( int i = 0; i < tileSize; i++ )
+                {
+                    const int row = tr * tileSize + i;
+
+                    for ( int j = 0; j < tileSize; j++ )
+                    {
+                        const int col = tc * tileSize + j;
+
+                        float v = qQNaN();
+
+                        if ( row < level.numRows && col < level.numColumns )
+                        {
+                            if ( l == 0 )
+                            {
+                                v = values[ qint64( row ) * stride + col ];
+
+                                if ( qIsFinite( v ) )
+                                {
+                                    if ( !hasValues || v < minValue )
+                                        minValue = v;
+
+                                    if ( !hasValues || v > maxValue )
+                                        maxValue = v;
+
+                                    hasValues = true;
+                                }
+                            }
+                            else
+                            {
+                                const QwtRasterLevel& prev = levels[l - 1];
+
+                                const int r1 = 2 * row;
+                                const int c1 = 2 * col;
+                                const int r2 = qMin( r1 + 1, prev.numRows - 1 );
+                                const int c2 = qMin( c1 + 1, prev.numColumns - 1 );
+
+                                float v4[4] =
+                                {
+                                    prev.value( tileSize, r1, c1 ),
+                                    prev.value( tileSize, r1, c2 ),
+                                    prev.value( tileSize, r2, c1 ),
+                                    prev.value( tileSize, r2, c2 )
+                                };
+
+                                // duplicated values at the borders
+                                if ( r2 == r1 )
+                                    v4[2] = v4[3] = qQNaN();
+
+                                if ( c2 == c1 )
+                                    v4[1] = v4[3] = qQNaN();
+
+                                v = qwtReduce( v4, reduction );
+                            }
+                        }
+
+                        *tile++ = v;
+                    }
+                }
+            }
+        }
+    }
+
+    QwtRasterFileHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+
+    std::memcpy( header.magic, qwtRasterMagic, sizeof( qwtRasterMagic ) );
+    header.byteOrder = ByteOrderMark;
+    header.version = FormatVersion;
+    header.numColumns = numColumns;
+    header.numRows = numRows;
+    header.tileSize = tileSize;
+    header.numLevels = numLevels;
+    header.reduction = reduction;
+    header.minValue = hasValues ? minValue : qQNaN();
+    header.maxValue = hasValues ? maxValue : qQNaN();
+
+    for ( int l = 0; l < numLevels; l++ )
+        header.levelOffsets[l] = levels[l].offset;
+
+    std::memcpy( memory, &header, sizeof( header ) );
+
+    file.unmap( memory );
+    file.close();
+
+    return true;
+}
+
+/*!
+   \return Algorithm, how the values of the levels have been calculated
+   \sa createFile()
+ */
+QwtMappedRasterData::Reduction QwtMappedRasterData::reduction() const
+{
+    return m_data->reduction;
+}
+
+/*!
+   \return Number of columns of the full resolution
+   \sa numRows(), levelCount()
+ */
+int QwtMappedRasterData::numColumns() const
+{
+    return ( m_data->numLevels > 0 ) ? m_data->levels[0].numColumns : 0;
+}
+
+/*!
+   \return Number of rows of the full resolution
+   \sa numColumns(), levelCount()
+ */
+int QwtMappedRasterData::numRows() const
+{
+    return ( m_data->numLevels > 0 ) ? m_data->levels[0].numRows : 0;
+}
+
+//! \return Number of columns and rows of a tile
+int QwtMappedRasterData::tileSize() const
+{
+    return m_data->tileSize;
+}
+
+/*!
+   \return Number of levels including the full resolution
+   \sa level(), levelFor()
+ */
+int QwtMappedRasterData::levelCount() const
+{
+    return m_data->numLevels;
+}
+
+/*!
+   \return Level, that has been selected by the last initRaster()
+   \sa initRaster(), levelFor()
+ */
+int QwtMappedRasterData::level() const
+{
+    return m_data->level;
+}
+
+/*!
+   \brief Find the level for rendering a raster
+
+   \param area Area of the raster
+   \param raster Number of horizontal and vertical pixels
+   \return Coarsest level, that has at least the resolution of the raster.
+           0 = full resolution, when the raster is invalid.
+ */
+int QwtMappedRasterData::levelFor(
+    const QRectF& area, const QSize& raster ) const
+{
+    const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+    const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+
+    if ( m_data->numLevels <= 1 || !area.isValid() || raster.isEmpty()
+        || !xInterval.isValid() || !yInterval.isValid() )
+    {
+        return 0;
+    }
+
+    const double pixelWidth = area.width() / raster.width();
+    const double pixelHeight = area.height() / raster.height();
+
+    int level = 0;
+    for ( int l = 1; l < m_data->numLevels; l++ )
+    {
+        const QwtRasterLevel& lvl = m_data->levels[l];
+
+        if ( xInterval.width() / lvl.numColumns > pixelWidth
+            || yInterval.width() / lvl.numRows > pixelHeight )
+        {
+            break;
+        }
+
+        level = l;
+    }
+
+    return level;
+}
+
+/*!
+   \return Bounding interval of the values, that has been
+           calculated by createFile()
+ */
+QwtInterval QwtMappedRasterData::valueRange() const
+{
+    return m_data->valueRange;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   The X/Y intervals define the positions of the values
+   of the matrix. The interval in Z direction defines the possible
+   range of the values ( see valueRange() ).
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa QwtRasterData::interval()
+ */
+void QwtMappedRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+        m_data->intervals[axis] = interval;
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval
+ */
+QwtInterval QwtMappedRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   \param area Requested area, ignored
+   \return Pixel of the full resolution, so that the image is never
+           rendered in a resolution beyond the matrix
+ */
+QRectF QwtMappedRasterData::pixelHint( const QRectF& area ) const
+{
+    Q_UNUSED( area )
+
+    const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+    const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+
+    if ( m_data->numLevels <= 0
+        || !xInterval.isValid() || !yInterval.isValid() )
+    {
+        return QRectF();
+    }
+
+    const QwtRasterLevel& lvl = m_data->levels[0];
+
+    return QRectF( xInterval.minValue(), yInterval.minValue(),
+        xInterval.width() / lvl.numColumns, yInterval.width() / lvl.numRows );
+}
+
+/*!
+   \brief Select the level for rendering a raster
+
+   \param area Area of the raster
+   \param raster Number of horizontal and vertical pixels
+
+   \sa levelFor(), level()
+ */
+void QwtMappedRasterData::initRaster( const QRectF& area, const QSize& raster )
+{
+    m_data->level = levelFor( area, raster );
+}
+
+/*!
+   Reset the level to the full resolution
+   \sa initRaster()
+ */
+void QwtMappedRasterData::discardRaster()
+{
+    m_data->level = 0;
+}
+
+/*!
+   \brief Create a context for requesting the values of an area
+
+   The context reads the values from the level, that matches
+   the area and raster best - regardless of the level, that has been
+   selected by initRaster().
+
+   \param area Area, that will be requested by the context
+   \param raster Number of horizontal and vertical pixels of the area
+
+   \return Render context, to be deleted by the caller
+   \sa levelFor()
+ */
+QwtRasterData::RenderContext* QwtMappedRasterData::createRenderContext(
+    const QRectF& area, const QSize& raster ) const
+{
+    return new QwtMappedLevelContext( this, area, raster );
+}
+
+/*!
+   \return the value at a raster position of level()
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+ */
+double QwtMappedRasterData::value( double x, double y ) const
+{
+    double v;
+    levelValues( m_data->level, y, &x, 1, &v );
+
+    return v;
+}
+
+/*!
+   \brief Values of a row of level()
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+ */
+void QwtMappedRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    levelValues( m_data->level, y, x, numValues, values );
+}
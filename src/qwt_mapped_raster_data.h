@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_RASTER_DATA_H
+#define QWT_MAPPED_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+
+class QString;
+
+/*!
+   \brief Raster data from a memory mapped file with a mip map pyramid
+
+   QwtMappedRasterData displays matrices, that are too large to be
+   loaded into memory. The values are stored as floats in a file, that is
+   mapped into the address space of the process, so that opening the
+   file is instant and only the pages being rendered are read by
+   the operating system.
+
+   Beside the full resolution the file contains a pyramid of levels,
+   where each level has half of the columns and rows of the previous
+   one. A value of a level is the mean or the maximum ( see Reduction )
+   of the corresponding 2x2 values of the previous level. Every level is
+   organized in square tiles, so that a rectangular area of a level
+   is found in a few contiguous blocks of the file.
+
+   When rendering, the coarsest level is selected, that still has at
+   least the resolution of the image ( see initRaster(),
+   createRenderContext() ). So a zoomed out view touches only a couple
+   of MB, regardless of the size of the full matrix.
+   The values are resampled with NearestNeighbour.
+
+   Files are created by createFile(). The format uses the native
+   byte order and is not meant for exchanging files between systems.
+
+   \par Example
+   \code
+   QwtMappedRasterData::createFile( "frame.qwtraster",
+       values, numColumns, numRows );
+
+   QwtMappedRasterData* data = new QwtMappedRasterData();
+   if ( data->open( "frame.qwtraster" ) )
+   {
+       data->setInterval( Qt::XAxis, QwtInterval( 0.0, 100.0 ) );
+       data->setInterval( Qt::YAxis, QwtInterval( 0.0, 100.0 ) );
+       data->setInterval( Qt::ZAxis, data->valueRange() );
+   }
+
+   spectrogram->setData( data );
+   \endcode
+   \endpar
+
+   \sa QwtMatrixRasterData, QwtBufferRasterData
+ */
+class QWT_EXPORT QwtMappedRasterData : public QwtRasterData
+{
+  public:
+    //! Algorithm, how the values of a level are calculated
+    enum Reduction
+    {
+        //! Mean of the 2x2 values of the previous level
+        Mean,
+
+        //! Maximum of the 2x2 values of the previous level
+        Maximum
+    };
+
+    QwtMappedRasterData();
+    virtual ~QwtMappedRasterData();
+
+    bool open( const QString& fileName );
+    void close();
+
+    bool isOpen() const;
+    QString fileName() const;
+
+    static bool createFile( const QString& fileName,
+        const float* values, int numColumns, int numRows,
+        int stride = -1, Reduction = Mean, int tileSize = 256 );
+
+    Reduction reduction() const;
+
+    int numColumns() const;
+    int numRows() const;
+    int tileSize() const;
+
+    int levelCount() const;
+    int level() const;
+
+    int levelFor( const QRectF& area, const QSize& raster ) const;
+
+    QwtInterval valueRange() const;
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE QWT_FINAL;
+
+    virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
+
+    virtual void initRaster( const QRectF&, const QSize& raster ) QWT_OVERRIDE;
+    virtual void discardRaster() QWT_OVERRIDE;
+
+    virtual RenderContext* createRenderContext(
+        const QRectF& area, const QSize& raster ) const QWT_OVERRIDE;
+
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const QWT_OVERRIDE;
+
+    void levelValues( int level, double y, const double* x,
+        int numValues, double* values ) const;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
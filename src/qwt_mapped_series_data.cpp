@@ -0,0 +1,852 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_series_data.h"
+
+#include <qfile.h>
+#include <qnumeric.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    enum
+    {
+        MaxLevels = 32,
+        ByteOrderMark = 0x01020304,
+        FormatVersion = 1
+    };
+
+    const char qwtIndexMagic[8] = { 'Q', 'W', 'T', 'S', 'I', 'D', 'X', '1' };
+
+    // layout of the first bytes of an index file - without any padding
+
+    class QwtSeriesIndexHeader
+    {
+      public:
+        char magic[8];
+        quint32 byteOrder;
+        quint32 version;
+
+        quint32 valueType;
+        quint32 stride;
+        quint32 blockSize;
+        quint32 numLevels;
+        quint32 reserved[2];
+
+        qint64 offset;
+        qint64 sampleCount;
+
+        double minValue;
+        double maxValue;
+
+        quint64 levelOffsets[MaxLevels];
+        quint64 levelNodes[MaxLevels];
+    };
+
+    // minimum and maximum of the raw values of a block
+
+    class QwtSeriesIndexNode
+    {
+      public:
+        float min;
+        float max;
+    };
+}
+
+static inline int qwtValueSize( QwtMappedSeriesData::ValueType type )
+{
+    switch( type )
+    {
+        case QwtMappedSeriesData::Int8:
+        case QwtMappedSeriesData::UInt8:
+            return 1;
+
+        case QwtMappedSeriesData::Int16:
+        case QwtMappedSeriesData::UInt16:
+            return 2;
+
+        case QwtMappedSeriesData::Int32:
+        case QwtMappedSeriesData::UInt32:
+        case QwtMappedSeriesData::Float:
+            return 4;
+
+        case QwtMappedSeriesData::Double:
+        default:
+            return 8;
+    }
+}
+
+template< typename T >
+static inline double qwtReadValue( const uchar* p )
+{
+    // the stride doesn't need to be a multiple of the value size
+
+    T value;
+    std::memcpy( &value, p, sizeof( T ) );
+
+    return value;
+}
+
+static inline double qwtValue( const uchar* p,
+    QwtMappedSeriesData::ValueType type )
+{
+    switch( type )
+    {
+        case QwtMappedSeriesData::Int8:
+            return qwtReadValue< qint8 >( p );
+
+        case QwtMappedSeriesData::UInt8:
+            return qwtReadValue< quint8 >( p );
+
+        case QwtMappedSeriesData::Int16:
+            return qwtReadValue< qint16 >( p );
+
+        case QwtMappedSeriesData::UInt16:
+            return qwtReadValue< quint16 >( p );
+
+        case QwtMappedSeriesData::Int32:
+            return qwtReadValue< qint32 >( p );
+
+        case QwtMappedSeriesData::UInt32:
+            return qwtReadValue< quint32 >( p );
+
+        case QwtMappedSeriesData::Float:
+            return qwtReadValue< float >( p );
+
+        case QwtMappedSeriesData::Double:
+        default:
+            return qwtReadValue< double >( p );
+    }
+}
+
+static inline void qwtAddNode( QwtSeriesIndexNode& node,
+    bool& valid, float min, float max )
+{
+    // NaN values are gaps, that are ignored
+
+    if ( !( qIsFinite( min ) && qIsFinite( max ) ) )
+        return;
+
+    if ( !valid )
+    {
+        node.min = min;
+        node.max = max;
+        valid = true;
+    }
+    else
+    {
+        if ( min < node.min )
+            node.min = min;
+
+        if ( max > node.max )
+            node.max = max;
+    }
+}
+
+static int qwtIndexLevels( qint64 sampleCount, int blockSize,
+    quint64 offsets[MaxLevels], quint64 nodes[MaxLevels] )
+{
+    quint64 offset = sizeof( QwtSeriesIndexHeader );
+
+    int numLevels = 0;
+    qint64 numSamples = blockSize;
+
+    while ( numLevels < MaxLevels )
+    {
+        const qint64 numNodes = ( sampleCount + numSamples - 1 ) / numSamples;
+
+        offsets[numLevels] = offset;
+        nodes[numLevels] = numNodes;
+        numLevels++;
+
+        offset += numNodes * sizeof( QwtSeriesIndexNode );
+
+        if ( numNodes <= 1 )
+            break;
+
+        numSamples *= 2;
+    }
+
+    return numLevels;
+}
+
+static QString qwtIndexFileName( const QString& fileName,
+    const QString& indexFileName )
+{
+    if ( !indexFileName.isEmpty() )
+        return indexFileName;
+
+    return fileName + QLatin1String( ".qwtidx" );
+}
+
+class QwtMappedSeriesData::PrivateData
+{
+  public:
+    PrivateData()
+        : memory( NULL )
+        , valueType( QwtMappedSeriesData::Double )
+        , offset( 0 )
+        , stride( 0 )
+        , sampleCount( 0 )
+        , xFactor( 1.0 )
+        , xOffset( 0.0 )
+        , yFactor( 1.0 )
+        , yOffset( 0.0 )
+        , indexMemory( NULL )
+        , maxSamples( 10000 )
+        , viewLevel( -1 )
+        , viewFirst( 0 )
+        , viewCount( 0 )
+    {
+        std::memset( &indexHeader, 0, sizeof( indexHeader ) );
+    }
+
+    inline double rawValue( qint64 index ) const
+    {
+        return qwtValue( memory + offset + index * stride, valueType );
+    }
+
+    inline const QwtSeriesIndexNode* nodes( int level ) const
+    {
+        return reinterpret_cast< const QwtSeriesIndexNode* >(
+            indexMemory + indexHeader.levelOffsets[level] );
+    }
+
+    QFile file;
+    uchar* memory;
+
+    QwtMappedSeriesData::ValueType valueType;
+    qint64 offset;
+    int stride;
+    qint64 sampleCount;
+
+    double xFactor;
+    double xOffset;
+    double yFactor;
+    double yOffset;
+
+    QFile indexFile;
+    uchar* indexMemory;
+    QwtSeriesIndexHeader indexHeader;
+
+    int maxSamples;
+    QRectF rectOfInterest;
+
+    // the view: samples or nodes of a level
+
+    int viewLevel;
+    qint64 viewFirst;
+    qint64 viewCount;
+};
+
+//! Constructor
+QwtMappedSeriesData::QwtMappedSeriesData()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtMappedSeriesData::~QwtMappedSeriesData()
+{
+    close();
+    delete m_data;
+}
+
+/*!
+   \brief Map a binary file
+
+   \param fileName Name of the file
+   \param valueType Type of the values of the channel
+   \param offset Position of the first value in the file in bytes,
+                 f.e. the size of a header + the offset of the channel
+                 inside of a record
+   \param stride Distance between 2 values in bytes, f.e. the size of
+                 a record with all channels. A value < the size of the value
+                 type means values without any gaps.
+
+   \return true, when the file could be mapped
+   \sa close(), openIndex()
+ */
+bool QwtMappedSeriesData::open( const QString& fileName,
+    ValueType valueType, qint64 offset, int stride )
+{
+    close();
+
+    const int valueSize = qwtValueSize( valueType );
+
+    m_data->file.setFileName( fileName );
+    if ( !m_data->file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 fileSize = m_data->file.size();
+
+    offset = qMax( offset, qint64( 0 ) );
+    stride = qMax( stride, valueSize );
+
+    if ( fileSize - offset < valueSize )
+    {
+        m_data->file.close();
+        return false;
+    }
+
+    uchar* memory = m_data->file.map( 0, fileSize );
+    if ( memory == NULL )
+    {
+        m_data->file.close();
+        return false;
+    }
+
+    m_data->memory = memory;
+    m_data->valueType = valueType;
+    m_data->offset = offset;
+    m_data->stride = stride;
+    m_data->sampleCount = ( fileSize - offset - valueSize ) / stride + 1;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateView();
+
+    return true;
+}
+
+/*!
+   Unmap the file and its index
+   \sa open(), closeIndex()
+ */
+void QwtMappedSeriesData::close()
+{
+    closeIndex();
+
+    if ( m_data->memory )
+    {
+        m_data->file.unmap( m_data->memory );
+        m_data->memory = NULL;
+    }
+
+    if ( m_data->file.isOpen() )
+        m_data->file.close();
+
+    m_data->sampleCount = 0;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateView();
+}
+
+/*!
+   \return true, when a file is mapped
+   \sa open()
+ */
+bool QwtMappedSeriesData::isOpen() const
+{
+    return m_data->memory != NULL;
+}
+
+//! \return Name of the file
+QString QwtMappedSeriesData::fileName() const
+{
+    return m_data->file.fileName();
+}
+
+//! \return Type of the values
+QwtMappedSeriesData::ValueType QwtMappedSeriesData::valueType() const
+{
+    return m_data->valueType;
+}
+
+//! \return Position of the first value in the file in bytes
+qint64 QwtMappedSeriesData::offset() const
+{
+    return m_data->offset;
+}
+
+//! \return Distance between 2 values in bytes
+int QwtMappedSeriesData::stride() const
+{
+    return m_data->stride;
+}
+
+/*!
+   \brief Set the affine transformation for the x coordinates
+
+   x = index * factor + offset
+
+   \param factor Factor, f.e. the inverse of the sample rate
+   \param offset Offset
+ */
+void QwtMappedSeriesData::setXScaling( double factor, double offset )
+{
+    m_data->xFactor = factor;
+    m_data->xOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateView();
+}
+
+/*!
+   \brief Set the affine transformation for the y coordinates
+
+   y = value * factor + offset
+
+   \param factor Factor
+   \param offset Offset
+ */
+void QwtMappedSeriesData::setYScaling( double factor, double offset )
+{
+    m_data->yFactor = factor;
+    m_data->yOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \brief Create a sidecar index for the mapped file
+
+   The samples of the file are read once and the minimum and maximum
+   of each block of blockSize samples is written to the index. Each
+   further level combines 2 blocks of the previous level. The index needs
+   8 bytes for each block and about twice this size for all levels.
+
+   NaN values are treated as gaps and are ignored.
+
+   \param indexFileName Name of the index file. An empty string means
+                        fileName() with the suffix ".qwtidx"
+   \param blockSize Number of samples of a block of the first level
+
+   \return true on success
+   \sa openIndex()
+ */
+bool QwtMappedSeriesData::createIndex(
+    const QString& indexFileName, int blockSize ) const
+{
+    if ( m_data->memory == NULL )
+        return false;
+
+    blockSize = qMax( blockSize, 16 );
+
+    QwtSeriesIndexHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+
+    const int numLevels = qwtIndexLevels( m_data->sampleCount,
+        blockSize, header.levelOffsets, header.levelNodes );
+
+    const qint64 fileSize = header.levelOffsets[numLevels - 1]
+        + header.levelNodes[numLevels - 1] * sizeof( QwtSeriesIndexNode );
+
+    QFile file( qwtIndexFileName( fileName(), indexFileName ) );
+    if ( !file.open( QIODevice::ReadWrite | QIODevice::Truncate ) )
+        return false;
+
+    if ( !file.resize( fileSize ) )
+        return false;
+
+    uchar* memory = file.map( 0, fileSize );
+    if ( memory == NULL )
+        return false;
+
+    // the first level from the samples
+
+    QwtSeriesIndexNode* nodes = reinterpret_cast< QwtSeriesIndexNode* >(
+        memory + header.levelOffsets[0] );
+
+    for ( quint64 i = 0; i < header.levelNodes[0]; i++ )
+    {
+        const qint64 from = qint64( i ) * blockSize;
+        const qint64 to = qMin( from + blockSize, m_data->sampleCount );
+
+        QwtSeriesIndexNode node;
+        node.min = node.max = qQNaN();
+
+        bool valid = false;
+        for ( qint64 j = from; j < to; j++ )
+        {
+            const float v = m_data->rawValue( j );
+            qwtAddNode( node, valid, v, v );
+        }
+
+        nodes[i] = node;
+    }
+
+    // all further levels from their previous level
+
+    for ( int l = 1; l < numLevels; l++ )
+    {
+        const QwtSeriesIndexNode* prev = reinterpret_cast< const QwtSeriesIndexNode* >(
+            memory + header.levelOffsets[l - 1] );
+
+        QwtSeriesIndexNode* nodes = reinterpret_cast< QwtSeriesIndexNode* >(
+            memory + header.levelOffsets[l] );
+
+        for ( quint64 i = 0; i < header.levelNodes[l]; i++ )
+        {
+            QwtSeriesIndexNode node;
+            node.min = node.max = qQNaN();
+
+            bool valid = false;
+            qwtAddNode( node, valid, prev[2 * i].min, prev[2 * i].max );
+
+            if ( 2 * i + 1 < header.levelNodes[l - 1] )
+                qwtAddNode( node, valid, prev[2 * i + 1].min, prev[2 * i + 1].max );
+
+            nodes[i] = node;
+        }
+    }
+
+    const QwtSeriesIndexNode* top = reinterpret_cast< const QwtSeriesIndexNode* >(
+        memory + header.levelOffsets[numLevels - 1] );
+
+    std::memcpy( header.magic, qwtIndexMagic, sizeof( qwtIndexMagic ) );
+    header.byteOrder = ByteOrderMark;
+    header.version = FormatVersion;
+    header.valueType = m_data->valueType;
+    header.stride = m_data->stride;
+    header.blockSize = blockSize;
+    header.numLevels = numLevels;
+    header.offset = m_data->offset;
+    header.sampleCount = m_data->sampleCount;
+    header.minValue = top[0].min;
+    header.maxValue = top[0].max;
+
+    std::memcpy( memory, &header, sizeof( header ) );
+
+    file.unmap( memory );
+    file.close();
+
+    return true;
+}
+
+/*!
+   \brief Map the sidecar index
+
+   The index has to be created by createIndex() for a file with the same
+   layout ( value type, offset, stride and number of samples ).
+
+   \param indexFileName Name of the index file. An empty string means
+                        fileName() with the suffix ".qwtidx"
+
+   \return true, when the index could be mapped
+   \sa createIndex(), closeIndex(), hasIndex()
+ */
+bool QwtMappedSeriesData::openIndex( const QString& indexFileName )
+{
+    closeIndex();
+
+    if ( m_data->memory == NULL )
+        return false;
+
+    QFile& file = m_data->indexFile;
+
+    file.setFileName( qwtIndexFileName( fileName(), indexFileName ) );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 fileSize = file.size();
+
+    QwtSeriesIndexHeader header;
+    if ( file.read( reinterpret_cast< char* >( &header ),
+        sizeof( header ) ) != qint64( sizeof( header ) ) )
+    {
+        file.close();
+        return false;
+    }
+
+    bool isValid =
+        std::memcmp( header.magic, qwtIndexMagic, sizeof( qwtIndexMagic ) ) == 0
+        && header.byteOrder == ByteOrderMark && header.version == FormatVersion
+        && header.valueType == quint32( m_data->valueType )
+        && header.stride == quint32( m_data->stride )
+        && header.offset == m_data->offset
+        && header.sampleCount == m_data->sampleCount
+        && header.blockSize >= 16;
+
+    if ( isValid )
+    {
+        quint64 offsets[MaxLevels];
+        quint64 nodes[MaxLevels];
+
+        const int numLevels = qwtIndexLevels( header.sampleCount,
+            header.blockSize, offsets, nodes );
+
+        isValid = header.numLevels == quint32( numLevels )
+            && qint64( offsets[numLevels - 1]
+                + nodes[numLevels - 1] * sizeof( QwtSeriesIndexNode ) ) <= fileSize;
+    }
+
+    uchar* memory = isValid ? file.map( 0, fileSize ) : NULL;
+    if ( memory == NULL )
+    {
+        file.close();
+        return false;
+    }
+
+    m_data->indexMemory = memory;
+    m_data->indexHeader = header;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateView();
+
+    return true;
+}
+
+/*!
+   Unmap the sidecar index
+   \sa openIndex()
+ */
+void QwtMappedSeriesData::closeIndex()
+{
+    if ( m_data->indexMemory )
+    {
+        m_data->indexFile.unmap( m_data->indexMemory );
+        m_data->indexMemory = NULL;
+    }
+
+    if ( m_data->indexFile.isOpen() )
+        m_data->indexFile.close();
+
+    std::memset( &m_data->indexHeader, 0, sizeof( m_data->indexHeader ) );
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    updateView();
+}
+
+/*!
+   \return true, when a sidecar index is mapped
+   \sa openIndex()
+ */
+bool QwtMappedSeriesData::hasIndex() const
+{
+    return m_data->indexMemory != NULL;
+}
+
+/*!
+   \brief Set the maximum number of samples of the view
+
+   When the rectangle of interest contains more samples, the view
+   is built from the blocks of the index.
+
+   \param numSamples Maximum number of samples. The default
+                     setting is 10000.
+
+   \sa maxSamples(), setRectOfInterest()
+ */
+void QwtMappedSeriesData::setMaxSamples( int numSamples )
+{
+    numSamples = qMax( numSamples, 4 );
+
+    if ( numSamples != m_data->maxSamples )
+    {
+        m_data->maxSamples = numSamples;
+        updateView();
+    }
+}
+
+/*!
+   \return Maximum number of samples of the view
+   \sa setMaxSamples()
+ */
+int QwtMappedSeriesData::maxSamples() const
+{
+    return m_data->maxSamples;
+}
+
+/*!
+   \return Number of samples in the file
+   \sa rawSample(), size()
+ */
+qint64 QwtMappedSeriesData::sampleCount() const
+{
+    return m_data->sampleCount;
+}
+
+/*!
+   \param index Index of a sample in the file
+   \return Sample in the file, regardless of the view
+   \sa sampleCount(), sample()
+ */
+QPointF QwtMappedSeriesData::rawSample( qint64 index ) const
+{
+    return QPointF( m_data->xOffset + m_data->xFactor * index,
+        m_data->yOffset + m_data->yFactor * m_data->rawValue( index ) );
+}
+
+/*!
+   \return Number of samples of the view
+   \sa sampleCount()
+ */
+size_t QwtMappedSeriesData::size() const
+{
+    if ( m_data->viewLevel >= 0 )
+        return 2 * m_data->viewCount;
+
+    return m_data->viewCount;
+}
+
+/*!
+   \param index Index of the sample in the view
+   \return Sample of the view
+
+   When the view is built from a level of the index, each block
+   is represented by 2 samples: the minimum and the maximum
+   at the center of the block.
+ */
+QPointF QwtMappedSeriesData::sample( size_t index ) const
+{
+    const PrivateData* d = m_data;
+
+    if ( d->viewLevel < 0 )
+        return rawSample( d->viewFirst + qint64( index ) );
+
+    const qint64 block = d->viewFirst + qint64( index / 2 );
+    const QwtSeriesIndexNode& node = d->nodes( d->viewLevel )[block];
+
+    const double numSamples = double( qint64( d->indexHeader.blockSize ) << d->viewLevel );
+
+    const double x = ( block + 0.5 ) * numSamples - 0.5;
+    const double value = ( index & 1 ) ? node.max : node.min;
+
+    return QPointF( d->xOffset + d->xFactor * x,
+        d->yOffset + d->yFactor * value );
+}
+
+/*!
+   \return Bounding rectangle of all samples in the file
+
+   With an index the rectangle is available in O(1). Otherwise all
+   samples of the file have to be read once, what might take a while.
+ */
+QRectF QwtMappedSeriesData::boundingRect() const
+{
+    const PrivateData* d = m_data;
+
+    if ( d->sampleCount <= 0 )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 );
+
+    if ( cachedBoundingRect.width() >= 0.0 )
+        return cachedBoundingRect;
+
+    double minValue = qQNaN();
+    double maxValue = qQNaN();
+
+    if ( d->indexMemory )
+    {
+        minValue = d->indexHeader.minValue;
+        maxValue = d->indexHeader.maxValue;
+    }
+    else
+    {
+        bool valid = false;
+        for ( qint64 i = 0; i < d->sampleCount; i++ )
+        {
+            const double v = d->rawValue( i );
+            if ( !qIsFinite( v ) )
+                continue;
+
+            if ( !valid || v < minValue )
+                minValue = v;
+
+            if ( !valid || v > maxValue )
+                maxValue = v;
+
+            valid = true;
+        }
+    }
+
+    if ( !( qIsFinite( minValue ) && qIsFinite( maxValue ) ) )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 );
+
+    const double x1 = d->xOffset;
+    const double x2 = d->xOffset + d->xFactor * ( d->sampleCount - 1 );
+
+    const double y1 = d->yOffset + d->yFactor * minValue;
+    const double y2 = d->yOffset + d->yFactor * maxValue;
+
+    cachedBoundingRect = QRectF( qMin( x1, x2 ), qMin( y1, y2 ),
+        qAbs( x2 - x1 ), qAbs( y2 - y1 ) );
+
+    return cachedBoundingRect;
+}
+
+/*!
+   \brief Update the view for a rectangle of interest
+
+   QwtPlotSeriesItem calls setRectOfInterest() with the area of the
+   plot canvas in scale coordinates, whenever the scales have changed.
+
+   \param rect Rectangle of interest
+   \sa maxSamples(), QwtSeriesData::setRectOfInterest()
+ */
+void QwtMappedSeriesData::setRectOfInterest( const QRectF& rect )
+{
+    m_data->rectOfInterest = rect;
+    updateView();
+}
+
+void QwtMappedSeriesData::updateView()
+{
+    PrivateData* d = m_data;
+
+    d->viewLevel = -1;
+    d->viewFirst = 0;
+    d->viewCount = d->sampleCount;
+
+    if ( d->indexMemory == NULL || d->sampleCount <= d->maxSamples )
+        return;
+
+    qint64 from = 0;
+    qint64 to = d->sampleCount - 1;
+
+    const QRectF& roi = d->rectOfInterest;
+    if ( roi.width() > 0.0 && d->xFactor != 0.0 )
+    {
+        double i1 = ( roi.left() - d->xOffset ) / d->xFactor;
+        double i2 = ( roi.right() - d->xOffset ) / d->xFactor;
+        if ( i1 > i2 )
+            qSwap( i1, i2 );
+
+        // including the neighbours outside of the rectangle
+
+        i1 = std::floor( i1 ) - 1.0;
+        i2 = std::ceil( i2 ) + 1.0;
+
+        if ( i1 > to || i2 < 0.0 )
+        {
+            d->viewCount = 0;
+            return;
+        }
+
+        from = qMax( qint64( 0 ), qint64( qMax( i1, 0.0 ) ) );
+        to = qMin( to, qint64( qMin( i2, double( to ) ) ) );
+    }
+
+    if ( to - from + 1 <= d->maxSamples )
+    {
+        d->viewFirst = from;
+        d->viewCount = to - from + 1;
+        return;
+    }
+
+    const int numLevels = d->indexHeader.numLevels;
+
+    for ( int level = 0; level < numLevels; level++ )
+    {
+        const qint64 numSamples = qint64( d->indexHeader.blockSize ) << level;
+
+        const qint64 b1 = from / numSamples;
+        const qint64 b2 = to / numSamples;
+
+        if ( 2 * ( b2 - b1 + 1 ) <= d->maxSamples || level == numLevels - 1 )
+        {
+            d->viewLevel = level;
+            d->viewFirst = b1;
+            d->viewCount = b2 - b1 + 1;
+
+            break;
+        }
+    }
+}
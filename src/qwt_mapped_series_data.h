@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_SERIES_DATA_H
+#define QWT_MAPPED_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qstring.h>
+
+/*!
+   \brief Series data from a memory mapped binary file
+
+   QwtMappedSeriesData displays one channel of a binary recording,
+   that is too large to be loaded into memory. The file is mapped into
+   the address space of the process, so that only the pages of the
+   samples being accessed are read by the operating system.
+
+   The samples of the channel are values of a ValueType, where
+   consecutive values are stride bytes apart - f.e. for files with
+   interleaved channels. The index of a sample is mapped by an affine
+   transformation into its x coordinate ( see setXScaling() ), like
+   in QwtStridedValueData.
+
+   For recordings with billions of samples the file can be accompanied
+   by a sidecar index ( see createIndex(), openIndex() ) with the minimum
+   and maximum of blocks of samples in several levels of detail.
+   With an index the series offers a view for the rectangle of interest,
+   that is updated by QwtPlotSeriesItem, whenever the scales change:
+
+   - when there are not more than maxSamples() samples inside the
+     x interval of the rectangle, the view consists of the samples
+     in this interval
+
+   - otherwise the view consists of the minimum and maximum of the blocks
+     of the coarsest level, that still has ~maxSamples() / 2 blocks
+     inside the interval
+
+   So a full range overview reads only a small part of the index, and
+   zooming in reads only the visible byte range of the file.
+   The bounding rectangle is taken from the index in O(1).
+
+   \note size() and sample() always refer to the current view.
+         Use sampleCount() and rawSample() for the samples of the file.
+
+   \note The file and the index use the native byte order.
+
+   \sa QwtStridedValueData, QwtSeriesDataPyramid, QwtMappedRasterData
+ */
+class QWT_EXPORT QwtMappedSeriesData : public QwtSeriesData< QPointF >
+{
+  public:
+    //! Type of the values in the file
+    enum ValueType
+    {
+        //! qint8
+        Int8,
+
+        //! quint8
+        UInt8,
+
+        //! qint16
+        Int16,
+
+        //! quint16
+        UInt16,
+
+        //! qint32
+        Int32,
+
+        //! quint32
+        UInt32,
+
+        //! float
+        Float,
+
+        //! double
+        Double
+    };
+
+    QwtMappedSeriesData();
+    virtual ~QwtMappedSeriesData();
+
+    bool open( const QString& fileName, ValueType,
+        qint64 offset = 0, int stride = 0 );
+
+    void close();
+
+    bool isOpen() const;
+    QString fileName() const;
+
+    ValueType valueType() const;
+    qint64 offset() const;
+    int stride() const;
+
+    void setXScaling( double factor, double offset = 0.0 );
+    void setYScaling( double factor, double offset = 0.0 );
+
+    bool createIndex( const QString& indexFileName = QString(),
+        int blockSize = 1024 ) const;
+
+    bool openIndex( const QString& indexFileName = QString() );
+    void closeIndex();
+
+    bool hasIndex() const;
+
+    void setMaxSamples( int );
+    int maxSamples() const;
+
+    qint64 sampleCount() const;
+    QPointF rawSample( qint64 index ) const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtMappedSeriesData )
+
+    void updateView();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
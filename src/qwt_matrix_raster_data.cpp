@@ -43,15 +43,183 @@ static inline double qwtBicubicInterpolate(
     return qwtHermiteInterpolate( v0, v1, v2, v3, dy );
 }
 
+static inline double qwtReduce( QwtMatrixRasterData::Reduction reduction,
+    const double* values, int numValues )
+{
+    // NaN values are gaps, that are ignored
+
+    double v = qQNaN();
+    int count = 0;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        if ( qIsNaN( value ) )
+            continue;
+
+        if ( count++ == 0 )
+        {
+            v = value;
+            continue;
+        }
+
+        switch( reduction )
+        {
+            case QwtMatrixRasterData::Minimum:
+                v = qMin( v, value );
+                break;
+
+            case QwtMatrixRasterData::Maximum:
+                v = qMax( v, value );
+                break;
+
+            case QwtMatrixRasterData::MaximumAbsolute:
+                if ( qAbs( value ) > qAbs( v ) )
+                    v = value;
+                break;
+
+            case QwtMatrixRasterData::Mean:
+            default:
+                v += value;
+        }
+    }
+
+    if ( reduction == QwtMatrixRasterData::Mean && count > 1 )
+        v /= count;
+
+    return v;
+}
+
+namespace
+{
+    class QwtMatrixLevel
+    {
+      public:
+        QwtMatrixLevel()
+            : numColumns( 0 )
+            , numRows( 0 )
+            , dx( 0.0 )
+            , dy( 0.0 )
+        {
+        }
+
+        QVector< double > values;
+        int numColumns;
+        int numRows;
+
+        double dx;
+        double dy;
+    };
+
+    class QwtMatrixLevelContext : public QwtRasterData::RenderContext
+    {
+      public:
+        QwtMatrixLevelContext( const QwtMatrixRasterData* data,
+                const QRectF& area, const QSize& raster )
+            : QwtRasterData::RenderContext( data, area, raster )
+            , m_level( data->levelFor( area, raster ) )
+            , m_x( NULL )
+        {
+        }
+
+        virtual double value( double x, double y ) QWT_OVERRIDE
+        {
+            double v;
+            values( y, &x, 1, &v );
+
+            return v;
+        }
+
+        virtual void setColumns( const double* x, int numColumns ) QWT_OVERRIDE
+        {
+            const QwtMatrixRasterData* matrixData =
+                static_cast< const QwtMatrixRasterData* >( data() );
+
+            m_x = NULL;
+            m_columns.clear();
+
+            // interpolating modes have more to do, than finding the column
+            if ( matrixData->resampleMode() == QwtMatrixRasterData::NearestNeighbour )
+            {
+                m_columns.resize( numColumns );
+                matrixData->levelColumns( m_level, x, numColumns, m_columns.data() );
+
+                m_x = x;
+            }
+        }
+
+        virtual void values( double y, const double* x,
+            int numValues, double* values ) QWT_OVERRIDE
+        {
+            const QwtMatrixRasterData* matrixData =
+                static_cast< const QwtMatrixRasterData* >( data() );
+
+            if ( x == m_x && numValues == m_columns.size() )
+            {
+                matrixData->levelValues( m_level, y,
+                    m_columns.constData(), numValues, values );
+            }
+            else
+            {
+                matrixData->levelValues( m_level, y, x, numValues, values );
+            }
+        }
+
+      private:
+        const int m_level;
+
+        // column indices for the array announced by setColumns()
+        const double* m_x;
+        QVector< int > m_columns;
+    };
+}
+
 class QwtMatrixRasterData::PrivateData
 {
   public:
     PrivateData()
         : resampleMode( QwtMatrixRasterData::NearestNeighbour )
+        , reduction( QwtMatrixRasterData::NoReduction )
         , numColumns(0)
+        , level( 0 )
     {
     }
 
+    void reduceValue( int level, int row, int col )
+    {
+        // level > 0: the value from 2x2 values of the previous level
+
+        const double* prev;
+        int prevColumns, prevRows;
+
+        if ( level == 1 )
+        {
+            prev = values.constData();
+            prevColumns = numColumns;
+            prevRows = numRows;
+        }
+        else
+        {
+            const QwtMatrixLevel& lvl = levels[ level - 2 ];
+
+            prev = lvl.values.constData();
+            prevColumns = lvl.numColumns;
+            prevRows = lvl.numRows;
+        }
+
+        double v[4];
+        int n = 0;
+
+        for ( int r = 2 * row; r <= 2 * row + 1 && r < prevRows; r++ )
+        {
+            for ( int c = 2 * col; c <= 2 * col + 1 && c < prevColumns; c++ )
+                v[n++] = prev[ r * prevColumns + c ];
+        }
+
+        QwtMatrixLevel& lvl = levels[ level - 1 ];
+        lvl.values.data()[ row * lvl.numColumns + col ] = qwtReduce( reduction, v, n );
+    }
+
     inline double value(int row, int col) const
     {
         return values.data()[ row * numColumns + col ];
@@ -59,6 +227,7 @@ class QwtMatrixRasterData::PrivateData
 
     QwtInterval intervals[3];
     QwtMatrixRasterData::ResampleMode resampleMode;
+    QwtMatrixRasterData::Reduction reduction;
 
     QVector< double > values;
     int numColumns;
@@ -66,6 +235,10 @@ class QwtMatrixRasterData::PrivateData
 
     double dx;
     double dy;
+
+    // level 1, 2, ...
+    QVector< QwtMatrixLevel > levels;
+    int level;
 };
 
 //! Constructor
@@ -101,6 +274,134 @@ QwtMatrixRasterData::ResampleMode QwtMatrixRasterData::resampleMode() const
     return m_data->resampleMode;
 }
 
+/*!
+   \brief Set the reduction for calculating the levels of a pyramid
+
+   Each level has half of the columns and rows of the previous level,
+   the values are reduced from the corresponding 2x2 values.
+   The levels need ~1/3 of the memory of the value matrix.
+
+   - Mean\n
+     Alias-free in general.
+
+   - Minimum, Maximum, MaximumAbsolute\n
+     For matrices, where single peaks must not disappear, when being
+     zoomed out.
+
+   \param reduction Reduction, the default setting is NoReduction.
+   \sa reduction(), levelFor(), initRaster()
+ */
+void QwtMatrixRasterData::setReduction( Reduction reduction )
+{
+    if ( reduction != m_data->reduction )
+    {
+        m_data->reduction = reduction;
+        updateLevels();
+    }
+}
+
+/*!
+   \return Reduction for calculating the levels of a pyramid
+   \sa setReduction()
+ */
+QwtMatrixRasterData::Reduction QwtMatrixRasterData::reduction() const
+{
+    return m_data->reduction;
+}
+
+/*!
+   \return Number of levels including the full resolution
+   \sa setReduction(), level()
+ */
+int QwtMatrixRasterData::levelCount() const
+{
+    return m_data->levels.size() + 1;
+}
+
+/*!
+   \return Level, that has been selected by the last initRaster()
+   \sa initRaster(), levelFor()
+ */
+int QwtMatrixRasterData::level() const
+{
+    return m_data->level;
+}
+
+/*!
+   \brief Find the level for rendering a raster
+
+   \param area Area of the raster
+   \param raster Number of horizontal and vertical pixels
+   \return Coarsest level, that has at least the resolution of the raster.
+           0 = full resolution, when the raster is invalid.
+ */
+int QwtMatrixRasterData::levelFor(
+    const QRectF& area, const QSize& raster ) const
+{
+    if ( m_data->levels.isEmpty() || !area.isValid() || raster.isEmpty() )
+        return 0;
+
+    const double pixelWidth = area.width() / raster.width();
+    const double pixelHeight = area.height() / raster.height();
+
+    int level = 0;
+    for ( int l = 0; l < m_data->levels.size(); l++ )
+    {
+        const QwtMatrixLevel& lvl = m_data->levels[l];
+
+        if ( lvl.dx > pixelWidth || lvl.dy > pixelHeight )
+            break;
+
+        level = l + 1;
+    }
+
+    return level;
+}
+
+/*!
+   \brief Select the level for rendering a raster
+
+   \param area Area of the raster
+   \param raster Number of horizontal and vertical pixels
+
+   \sa levelFor(), level()
+ */
+void QwtMatrixRasterData::initRaster( const QRectF& area, const QSize& raster )
+{
+    m_data->level = levelFor( area, raster );
+}
+
+/*!
+   Reset the level to the full resolution
+   \sa initRaster()
+ */
+void QwtMatrixRasterData::discardRaster()
+{
+    m_data->level = 0;
+}
+
+/*!
+   \brief Create a context for requesting the values of an area
+
+   The context reads the values from the level, that matches
+   the area and raster best - regardless of the level, that has been
+   selected by initRaster().
+
+   In NearestNeighbour mode the context precalculates the column indices
+   for the x values announced by RenderContext::setColumns().
+
+   \param area Area, that will be requested by the context
+   \param raster Number of horizontal and vertical pixels of the area
+
+   \return Render context, to be deleted by the caller
+   \sa levelFor()
+ */
+QwtRasterData::RenderContext* QwtMatrixRasterData::createRenderContext(
+    const QRectF& area, const QSize& raster ) const
+{
+    return new QwtMatrixLevelContext( this, area, raster );
+}
+
 /*!
    \brief Assign the bounding interval for an axis
 
@@ -158,6 +459,7 @@ void QwtMatrixRasterData::setValueMatrix(
     m_data->values = values;
     m_data->numColumns = qMax( numColumns, 0 );
     update();
+    updateLevels();
 }
 
 /*!
@@ -185,6 +487,8 @@ void QwtMatrixRasterData::setValue( int row, int col, double value )
     {
         const int index = row * m_data->numColumns + col;
         m_data->values.data()[ index ] = value;
+
+        updateLevelValue( row, col );
     }
 }
 
@@ -251,10 +555,18 @@ QRectF QwtMatrixRasterData::pixelHint( const QRectF& area ) const
    \param x X value in plot coordinates
    \param y Y value in plot coordinates
 
-   \sa ResampleMode
+   \sa ResampleMode, level()
  */
 double QwtMatrixRasterData::value( double x, double y ) const
 {
+    if ( m_data->level > 0 )
+    {
+        double v;
+        levelValues( m_data->level, y, &x, 1, &v );
+
+        return v;
+    }
+
     const QwtInterval xInterval = interval( Qt::XAxis );
     const QwtInterval yInterval = interval( Qt::YAxis );
 
@@ -397,6 +709,315 @@ double QwtMatrixRasterData::value( double x, double y ) const
     return value;
 }
 
+/*!
+   \brief Values of a row
+
+   Returns the same values as value(), but the rows of the matrix,
+   and the weights in y direction are calculated only once for all
+   positions. The inner loops are free of virtual calls, so that the
+   compiler is able to unroll and vectorize them.
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa value(), ResampleMode
+ */
+void QwtMatrixRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    levelValues( m_data->level, y, x, numValues, values );
+}
+
+/*!
+   \brief Values of a row of a level
+
+   \param level Level, 0 = full resolution
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa values(), levelFor()
+ */
+void QwtMatrixRasterData::levelValues( int level, double y,
+    const double* x, int numValues, double* values ) const
+{
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
+
+    if ( !yInterval.contains( y ) )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            values[i] = qQNaN();
+
+        return;
+    }
+
+    const double* matrix = m_data->values.constData();
+    int numColumns = m_data->numColumns;
+    int numRows = m_data->numRows;
+    double dx = m_data->dx;
+    double dy = m_data->dy;
+
+    if ( level > 0 && level <= m_data->levels.size() )
+    {
+        const QwtMatrixLevel& lvl = m_data->levels[ level - 1 ];
+
+        matrix = lvl.values.constData();
+        numColumns = lvl.numColumns;
+        numRows = lvl.numRows;
+        dx = lvl.dx;
+        dy = lvl.dy;
+    }
+
+    const double x0 = xInterval.minValue();
+
+    switch( m_data->resampleMode )
+    {
+        case BicubicInterpolation:
+        {
+            const double rowF = ( y - yInterval.minValue() ) / dy;
+            const int row = qRound( rowF );
+
+            int rows[4] = { row - 2, row - 1, row, row + 1 };
+
+            if ( rows[1] < 0 )
+                rows[1] = rows[2];
+
+            if ( rows[0] < 0 )
+                rows[0] = rows[1];
+
+            if ( rows[2] >= numRows )
+                rows[2] = rows[1];
+
+            if ( rows[3] >= numRows )
+                rows[3] = rows[2];
+
+            const double* r0 = matrix + rows[0] * numColumns;
+            const double* r1 = matrix + rows[1] * numColumns;
+            const double* r2 = matrix + rows[2] * numColumns;
+            const double* r3 = matrix + rows[3] * numColumns;
+
+            const double ty = rowF - row + 0.5;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                const double colF = ( x[i] - x0 ) / dx;
+                const int col = qRound( colF );
+
+                int col0 = col - 2;
+                int col1 = col - 1;
+                int col2 = col;
+                int col3 = col + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+
+                if ( col0 < 0 )
+                    col0 = col1;
+
+                if ( col2 >= numColumns )
+                    col2 = col1;
+
+                if ( col3 >= numColumns )
+                    col3 = col2;
+
+                const double tx = colF - col + 0.5;
+
+                const double v0 = qwtHermiteInterpolate(
+                    r0[col0], r0[col1], r0[col2], r0[col3], tx );
+                const double v1 = qwtHermiteInterpolate(
+                    r1[col0], r1[col1], r1[col2], r1[col3], tx );
+                const double v2 = qwtHermiteInterpolate(
+                    r2[col0], r2[col1], r2[col2], r2[col3], tx );
+                const double v3 = qwtHermiteInterpolate(
+                    r3[col0], r3[col1], r3[col2], r3[col3], tx );
+
+                values[i] = qwtHermiteInterpolate( v0, v1, v2, v3, ty );
+            }
+
+            break;
+        }
+        case BilinearInterpolation:
+        {
+            int row1 = qRound( ( y - yInterval.minValue() ) / dy ) - 1;
+            int row2 = row1 + 1;
+
+            if ( row1 < 0 )
+                row1 = row2;
+            else if ( row2 >= numRows )
+                row2 = row1;
+
+            const double* r1 = matrix + row1 * numColumns;
+            const double* r2 = matrix + row2 * numColumns;
+
+            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * dy;
+            const double ry = ( y2 - y ) / dy;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                int col1 = qRound( ( x[i] - x0 ) / dx ) - 1;
+                int col2 = col1 + 1;
+
+                if ( col1 < 0 )
+                    col1 = col2;
+                else if ( col2 >= numColumns )
+                    col2 = col1;
+
+                const double x2 = x0 + ( col2 + 0.5 ) * dx;
+                const double rx = ( x2 - x[i] ) / dx;
+
+                const double vr1 = rx * r1[col1] + ( 1.0 - rx ) * r1[col2];
+                const double vr2 = rx * r2[col1] + ( 1.0 - rx ) * r2[col2];
+
+                values[i] = ry * vr1 + ( 1.0 - ry ) * vr2;
+            }
+
+            break;
+        }
+        case NearestNeighbour:
+        default:
+        {
+            int row = int( ( y - yInterval.minValue() ) / dy );
+            if ( row >= numRows )
+                row = numRows - 1;
+
+            const double* r = matrix + row * numColumns;
+
+            for ( int i = 0; i < numValues; i++ )
+            {
+                if ( !xInterval.contains( x[i] ) )
+                {
+                    values[i] = qQNaN();
+                    continue;
+                }
+
+                int col = int( ( x[i] - x0 ) / dx );
+                if ( col >= numColumns )
+                    col = numColumns - 1;
+
+                values[i] = r[col];
+            }
+        }
+    }
+}
+
+/*!
+   \brief Find the columns of a level for an array of x values
+
+   The columns are those of the NearestNeighbour resample mode,
+   so that the values of many rows with the same x values can
+   be found by levelValues() without dividing per value.
+
+   \param level Level, 0 = full resolution
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param columns Array, where to store numValues column indices.
+                  Positions outside of the matrix are indicated by -1.
+
+   \sa levelValues(), QwtRasterData::RenderContext::setColumns()
+ */
+void QwtMatrixRasterData::levelColumns( int level, const double* x,
+    int numValues, int* columns ) const
+{
+    const QwtInterval xInterval = interval( Qt::XAxis );
+
+    int numColumns = m_data->numColumns;
+    double dx = m_data->dx;
+
+    if ( level > 0 && level <= m_data->levels.size() )
+    {
+        const QwtMatrixLevel& lvl = m_data->levels[ level - 1 ];
+
+        numColumns = lvl.numColumns;
+        dx = lvl.dx;
+    }
+
+    const double x0 = xInterval.minValue();
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        if ( !xInterval.contains( x[i] ) )
+        {
+            columns[i] = -1;
+            continue;
+        }
+
+        int col = int( ( x[i] - x0 ) / dx );
+        if ( col >= numColumns )
+            col = numColumns - 1;
+
+        columns[i] = col;
+    }
+}
+
+/*!
+   \brief Values of a row of a level for precalculated columns
+
+   \param level Level, 0 = full resolution
+   \param y Y value in plot coordinates
+   \param columns Column indices found by levelColumns()
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \note The values are always resampled like in NearestNeighbour mode
+   \sa levelColumns()
+ */
+void QwtMatrixRasterData::levelValues( int level, double y,
+    const int* columns, int numValues, double* values ) const
+{
+    const QwtInterval yInterval = interval( Qt::YAxis );
+
+    if ( !yInterval.contains( y ) )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            values[i] = qQNaN();
+
+        return;
+    }
+
+    const double* matrix = m_data->values.constData();
+    int numColumns = m_data->numColumns;
+    int numRows = m_data->numRows;
+    double dy = m_data->dy;
+
+    if ( level > 0 && level <= m_data->levels.size() )
+    {
+        const QwtMatrixLevel& lvl = m_data->levels[ level - 1 ];
+
+        matrix = lvl.values.constData();
+        numColumns = lvl.numColumns;
+        numRows = lvl.numRows;
+        dy = lvl.dy;
+    }
+
+    int row = int( ( y - yInterval.minValue() ) / dy );
+    if ( row >= numRows )
+        row = numRows - 1;
+
+    const double* r = matrix + row * numColumns;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const int col = columns[i];
+        values[i] = ( col >= 0 ) ? r[col] : qQNaN();
+    }
+}
+
 void QwtMatrixRasterData::update()
 {
     m_data->numRows = 0;
@@ -414,4 +1035,59 @@ void QwtMatrixRasterData::update()
         if ( yInterval.isValid() )
             m_data->dy = yInterval.width() / m_data->numRows;
     }
+
+    for ( int i = 0; i < m_data->levels.size(); i++ )
+    {
+        QwtMatrixLevel& lvl = m_data->levels[i];
+
+        lvl.dx = m_data->dx * m_data->numColumns / lvl.numColumns;
+        lvl.dy = m_data->dy * m_data->numRows / lvl.numRows;
+    }
+}
+
+void QwtMatrixRasterData::updateLevels()
+{
+    PrivateData* d = m_data;
+
+    d->levels.clear();
+    d->level = 0;
+
+    if ( d->reduction != NoReduction && d->numColumns > 0 && d->numRows > 0 )
+    {
+        int numColumns = d->numColumns;
+        int numRows = d->numRows;
+
+        while ( numColumns > 1 || numRows > 1 )
+        {
+            numColumns = ( numColumns + 1 ) / 2;
+            numRows = ( numRows + 1 ) / 2;
+
+            d->levels += QwtMatrixLevel();
+
+            QwtMatrixLevel& lvl = d->levels.last();
+            lvl.numColumns = numColumns;
+            lvl.numRows = numRows;
+            lvl.values.resize( numColumns * numRows );
+
+            const int level = d->levels.size();
+            for ( int row = 0; row < numRows; row++ )
+            {
+                for ( int col = 0; col < numColumns; col++ )
+                    d->reduceValue( level, row, col );
+            }
+        }
+    }
+
+    update();
+}
+
+void QwtMatrixRasterData::updateLevelValue( int row, int col )
+{
+    for ( int level = 1; level <= m_data->levels.size(); level++ )
+    {
+        row /= 2;
+        col /= 2;
+
+        m_data->reduceValue( level, row, col );
+    }
 }
@@ -24,6 +24,13 @@ template< typename T > class QVector;
    equidistant values, that can be used by a QwtPlotRasterItem.
    It implements a couple of resampling algorithms, to provide
    values for positions, that or not on the value matrix.
+
+   For large matrices, that are displayed zoomed out, sampling one value
+   per pixel is aliasing. Optionally QwtMatrixRasterData precalculates
+   levels of a pyramid ( see setReduction() ), where each level has half
+   of the columns and rows of the previous one. When rendering an image
+   the coarsest level, that has at least the resolution of the image,
+   is selected ( see initRaster(), createRenderContext() ).
  */
 class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
 {
@@ -53,12 +60,43 @@ class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
         BicubicInterpolation
     };
 
+    /*!
+       \brief Reduction of 2x2 values to a value of the next level
+       The default setting is NoReduction;
+       \sa setReduction()
+     */
+    enum Reduction
+    {
+        //! No levels, the values are always taken from the matrix
+        NoReduction,
+
+        //! Mean of the values
+        Mean,
+
+        //! Minimum of the values
+        Minimum,
+
+        //! Maximum of the values
+        Maximum,
+
+        //! Value with the maximum of the absolute values
+        MaximumAbsolute
+    };
+
     QwtMatrixRasterData();
     virtual ~QwtMatrixRasterData();
 
     void setResampleMode(ResampleMode mode);
     ResampleMode resampleMode() const;
 
+    void setReduction( Reduction );
+    Reduction reduction() const;
+
+    int levelCount() const;
+    int level() const;
+
+    int levelFor( const QRectF& area, const QSize& raster ) const;
+
     void setInterval( Qt::Axis, const QwtInterval& );
     virtual QwtInterval interval( Qt::Axis axis) const QWT_OVERRIDE QWT_FINAL;
 
@@ -74,8 +112,28 @@ class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
 
     virtual double value( double x, double y ) const QWT_OVERRIDE;
 
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const QWT_OVERRIDE;
+
+    void levelValues( int level, double y, const double* x,
+        int numValues, double* values ) const;
+
+    void levelColumns( int level, const double* x,
+        int numValues, int* columns ) const;
+
+    void levelValues( int level, double y, const int* columns,
+        int numValues, double* values ) const;
+
+    virtual void initRaster( const QRectF&, const QSize& raster ) QWT_OVERRIDE;
+    virtual void discardRaster() QWT_OVERRIDE;
+
+    virtual RenderContext* createRenderContext(
+        const QRectF&, const QSize& ) const QWT_OVERRIDE;
+
   private:
     void update();
+    void updateLevels();
+    void updateLevelValue( int row, int col );
 
     class PrivateData;
     PrivateData* m_data;
@@ -15,11 +15,13 @@ class QwtNullPaintDevice::PrivateData
 {
   public:
     PrivateData():
-        mode( QwtNullPaintDevice::NormalMode )
+        mode( QwtNullPaintDevice::NormalMode ),
+        isMeasureOnly( false )
     {
     }
 
     QwtNullPaintDevice::Mode mode;
+    bool isMeasureOnly;
 };
 
 class QwtNullPaintDevice::PaintEngine QWT_FINAL : public QPaintEngine
@@ -397,6 +399,32 @@ QwtNullPaintDevice::Mode QwtNullPaintDevice::mode() const
     return m_data->mode;
 }
 
+/*!
+    \brief En/Disable the measure-only mode
+
+    In measure-only mode the painter commands are only of interest
+    for the geometry they cover. Paint code might check
+    QwtPainter::isMeasureOnly() and skip expensive operations, like
+    rendering images or shaping texts, in favor of drawing
+    placeholders with the same geometry.
+
+    \param on On/Off
+    \sa isMeasureOnly(), QwtPainter::isMeasureOnly()
+ */
+void QwtNullPaintDevice::setMeasureOnly( bool on )
+{
+    m_data->isMeasureOnly = on;
+}
+
+/*!
+    \return True, when the device is in measure-only mode
+    \sa setMeasureOnly()
+ */
+bool QwtNullPaintDevice::isMeasureOnly() const
+{
+    return m_data->isMeasureOnly;
+}
+
 //! See QPaintDevice::paintEngine()
 QPaintEngine* QwtNullPaintDevice::paintEngine() const
 {
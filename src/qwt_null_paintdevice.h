@@ -27,6 +27,12 @@
 
    F.e. QwtNullPaintDevice is used by QwtPlotCanvas to identify
    styled backgrounds with rounded corners.
+
+   When only the geometry of the painted primitives is of interest
+   the device can be set to be measure-only ( see setMeasureOnly() ).
+   Code, that paints something expensive - like images or texts - might
+   check QwtPainter::isMeasureOnly() and draw a cheap placeholder
+   of the same geometry instead.
  */
 
 class QWT_EXPORT QwtNullPaintDevice : public QPaintDevice
@@ -75,6 +81,9 @@ class QWT_EXPORT QwtNullPaintDevice : public QPaintDevice
     void setMode( Mode );
     Mode mode() const;
 
+    void setMeasureOnly( bool );
+    bool isMeasureOnly() const;
+
     virtual QPaintEngine* paintEngine() const QWT_OVERRIDE;
 
     virtual int metric( PaintDeviceMetric ) const QWT_OVERRIDE;
@@ -0,0 +1,542 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_ohlc_series_data_pyramid.h"
+#include "qwt_scale_map.h"
+
+#include <qvector.h>
+#include <cmath>
+
+namespace
+{
+    // number of samples, that are summarized by a node of the lowest level
+    const int qwtBlockSize = 32;
+
+    class QwtOHLCPyramidNode
+    {
+      public:
+        inline void init( const QwtOHLCSample& sample )
+        {
+            low = sample.low;
+            high = sample.high;
+        }
+
+        inline void add( const QwtOHLCSample& sample )
+        {
+            if ( sample.low < low )
+                low = sample.low;
+
+            if ( sample.high > high )
+                high = sample.high;
+        }
+
+        inline void add( const QwtOHLCPyramidNode& other )
+        {
+            if ( other.low < low )
+                low = other.low;
+
+            if ( other.high > high )
+                high = other.high;
+        }
+
+        double low;
+        double high;
+    };
+}
+
+class QwtOHLCSeriesDataPyramid::PrivateData
+{
+  public:
+    PrivateData()
+        : series( NULL )
+        , isDirty( true )
+        , isMonotonic( false )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete series;
+    }
+
+    void scan( int from, int to, bool& valid, QwtOHLCPyramidNode& node ) const
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtOHLCSample sample = series->sample( i );
+
+            if ( valid )
+            {
+                node.add( sample );
+            }
+            else
+            {
+                node.init( sample );
+                valid = true;
+            }
+        }
+    }
+
+    int upperIndex( double value, int from, int to ) const
+    {
+        // index of the first sample in [from, to] with time >= value,
+        // to + 1, when there is none
+
+        int n = to - from + 1;
+        int index = from;
+
+        while ( n > 0 )
+        {
+            const int half = n >> 1;
+            const int indexMid = index + half;
+
+            if ( series->sample( indexMid ).time < value )
+            {
+                index = indexMid + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+
+        return index;
+    }
+
+    QwtSeriesData< QwtOHLCSample >* series;
+
+    bool isDirty;
+    bool isMonotonic;
+    QRectF boundingRect;
+
+    QVector< QVector< QwtOHLCPyramidNode > > levels;
+};
+
+/*!
+   \brief Constructor
+
+   \param series Series to be indexed
+   \warning The pyramid takes ownership of the series
+ */
+QwtOHLCSeriesDataPyramid::QwtOHLCSeriesDataPyramid(
+    QwtSeriesData< QwtOHLCSample >* series )
+{
+    m_data = new PrivateData();
+    m_data->series = series;
+}
+
+//! Destructor
+QwtOHLCSeriesDataPyramid::~QwtOHLCSeriesDataPyramid()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the series to be indexed
+
+   \param series Series
+   \warning The pyramid takes ownership of the series,
+            the previous series will be deleted.
+   \sa series(), invalidate()
+ */
+void QwtOHLCSeriesDataPyramid::setSeries(
+    QwtSeriesData< QwtOHLCSample >* series )
+{
+    if ( series != m_data->series )
+    {
+        delete m_data->series;
+        m_data->series = series;
+    }
+
+    invalidate();
+}
+
+/*!
+   \return Series being indexed
+   \sa setSeries()
+ */
+const QwtSeriesData< QwtOHLCSample >* QwtOHLCSeriesDataPyramid::series() const
+{
+    return m_data->series;
+}
+
+/*!
+   \brief Invalidate the index
+
+   invalidate() has to be called, whenever the samples of the
+   wrapped series have been modified. The index will be rebuilt,
+   when it is needed the next time.
+ */
+void QwtOHLCSeriesDataPyramid::invalidate()
+{
+    m_data->isDirty = true;
+    m_data->levels.clear();
+}
+
+/*!
+   \return True, when the time values of the samples are in increasing order
+   \note For a non monotonic series aggregatedSamples() returns
+         the samples unmodified
+ */
+bool QwtOHLCSeriesDataPyramid::isMonotonic() const
+{
+    build();
+    return m_data->isMonotonic;
+}
+
+//! \return Number of samples
+size_t QwtOHLCSeriesDataPyramid::size() const
+{
+    return m_data->series ? m_data->series->size() : 0;
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QwtOHLCSample QwtOHLCSeriesDataPyramid::sample( size_t index ) const
+{
+    return m_data->series->sample( index );
+}
+
+/*!
+   \return Bounding rectangle of all samples
+
+   The bounding rectangle is calculated, when building the index.
+   So it is available in O(1) as long as the index is valid.
+ */
+QRectF QwtOHLCSeriesDataPyramid::boundingRect() const
+{
+    build();
+    return m_data->boundingRect;
+}
+
+/*!
+   Forward the rectangle of interest to the wrapped series
+
+   \param rect Rectangle of interest
+   \sa QwtSeriesData::setRectOfInterest()
+ */
+void QwtOHLCSeriesDataPyramid::setRectOfInterest( const QRectF& rect )
+{
+    if ( m_data->series )
+        m_data->series->setRectOfInterest( rect );
+}
+
+/*!
+   \brief Aggregate a range of samples into one sample
+
+   The aggregated sample has the time and open value of the first sample,
+   the minimum of the low values, the maximum of the high values
+   and the close value of the last sample.
+
+   \param from Index of the first sample
+   \param to Index of the last sample
+   \param sample Aggregated sample
+
+   \return false, when the index range is empty
+ */
+bool QwtOHLCSeriesDataPyramid::aggregate(
+    int from, int to, QwtOHLCSample& sample ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    if ( from > to )
+        return false;
+
+    bool valid = false;
+    QwtOHLCPyramidNode node;
+
+    int b0 = ( from + qwtBlockSize - 1 ) / qwtBlockSize; // first complete block
+    int b1 = ( to + 1 ) / qwtBlockSize; // behind the last complete block
+
+    if ( b0 >= b1 )
+    {
+        m_data->scan( from, to, valid, node );
+    }
+    else
+    {
+        m_data->scan( from, b0 * qwtBlockSize - 1, valid, node );
+        m_data->scan( b1 * qwtBlockSize, to, valid, node );
+
+        for ( int level = 0; b0 < b1; level++ )
+        {
+            const QwtOHLCPyramidNode* nodes = m_data->levels[level].constData();
+
+            if ( b0 & 1 )
+            {
+                if ( valid )
+                    node.add( nodes[b0] );
+                else
+                    node = nodes[b0];
+
+                valid = true;
+                b0++;
+            }
+
+            if ( b1 & 1 )
+            {
+                b1--;
+
+                if ( valid )
+                    node.add( nodes[b1] );
+                else
+                    node = nodes[b1];
+
+                valid = true;
+            }
+
+            b0 >>= 1;
+            b1 >>= 1;
+        }
+    }
+
+    const QwtOHLCSample first = m_data->series->sample( from );
+
+    sample.time = first.time;
+    sample.open = first.open;
+    sample.high = node.high;
+    sample.low = node.low;
+    sample.close = ( to > from ) ? m_data->series->sample( to ).close : first.close;
+
+    return valid;
+}
+
+/*!
+   \brief Aggregate the samples, that are mapped to the same bucket
+
+   The paint interval of timeMap is divided into buckets of bucketWidth.
+   All samples of a bucket are aggregated into one sample, that
+   is located in the center of the bucket. Samples outside of the
+   scale interval of timeMap are ignored, beside the neighbours
+   of the visible samples.
+
+   The number of returned samples is limited by the number of buckets.
+   The costs are O(buckets * log(n)).
+
+   \param timeMap Maps time values into paint device coordinates
+   \param bucketWidth Width of a bucket in paint device coordinates
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return Aggregated samples in the order of the series.
+           For a non monotonic series all samples in the range are returned.
+   \sa aggregate()
+ */
+QVector< QwtOHLCSample > QwtOHLCSeriesDataPyramid::aggregatedSamples(
+    const QwtScaleMap& timeMap, double bucketWidth, int from, int to ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QVector< QwtOHLCSample > samples;
+    if ( from > to )
+        return samples;
+
+    const QwtSeriesData< QwtOHLCSample >* series = m_data->series;
+
+    if ( !m_data->isMonotonic || bucketWidth <= 0.0 )
+    {
+        samples.reserve( to - from + 1 );
+        for ( int i = from; i <= to; i++ )
+            samples += series->sample( i );
+
+        return samples;
+    }
+
+    const double tMin = qMin( timeMap.s1(), timeMap.s2() );
+    const double tMax = qMax( timeMap.s1(), timeMap.s2() );
+
+    // restricting the range to the visible samples
+    // and their neighbours
+
+    from = qMax( from, m_data->upperIndex( tMin, from, to ) - 1 );
+    to = qMin( to, m_data->upperIndex( tMax, from, to ) );
+
+    const bool increasing = !timeMap.isInverting();
+
+    samples.reserve( qMin( to - from + 1,
+        int( timeMap.pDist() / bucketWidth ) + 3 ) );
+
+    int i = from;
+    while ( i <= to )
+    {
+        const double pos = timeMap.transform( series->sample( i ).time );
+        const double bucket = std::floor( pos / bucketWidth + 0.5 ) * bucketWidth;
+
+        const double t2 = timeMap.invTransform(
+            increasing ? bucket + 0.5 * bucketWidth : bucket - 0.5 * bucketWidth );
+
+        const int j = qMax( i, m_data->upperIndex( t2, i + 1, to ) - 1 );
+
+        QwtOHLCSample sample;
+        if ( j == i )
+        {
+            sample = series->sample( i );
+        }
+        else
+        {
+            aggregate( i, j, sample );
+            sample.time = timeMap.invTransform( bucket );
+        }
+
+        samples += sample;
+
+        i = j + 1;
+    }
+
+    return samples;
+}
+
+/*!
+   \brief Aggregate the samples, that are inside the same time interval
+
+   The time axis is divided into intervals of timeStep starting at timeOrigin.
+   All samples of an interval are aggregated into one sample, that
+   is located at the beginning of the interval.
+
+   \param timeOrigin Start of one of the intervals
+   \param timeStep Length of an interval
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return Aggregated samples in the order of the series.
+           For a non monotonic series all samples in the range are returned.
+   \sa aggregate()
+ */
+QVector< QwtOHLCSample > QwtOHLCSeriesDataPyramid::aggregatedSamples(
+    double timeOrigin, double timeStep, int from, int to ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QVector< QwtOHLCSample > samples;
+    if ( from > to )
+        return samples;
+
+    const QwtSeriesData< QwtOHLCSample >* series = m_data->series;
+
+    if ( !m_data->isMonotonic || timeStep <= 0.0 )
+    {
+        samples.reserve( to - from + 1 );
+        for ( int i = from; i <= to; i++ )
+            samples += series->sample( i );
+
+        return samples;
+    }
+
+    int i = from;
+    while ( i <= to )
+    {
+        const double t = series->sample( i ).time;
+        const double t1 = timeOrigin +
+            std::floor( ( t - timeOrigin ) / timeStep ) * timeStep;
+
+        const int j = qMax( i,
+            m_data->upperIndex( t1 + timeStep, i + 1, to ) - 1 );
+
+        QwtOHLCSample sample;
+        aggregate( i, j, sample );
+        sample.time = t1;
+
+        samples += sample;
+
+        i = j + 1;
+    }
+
+    return samples;
+}
+
+void QwtOHLCSeriesDataPyramid::build() const
+{
+    if ( !m_data->isDirty )
+        return;
+
+    m_data->isDirty = false;
+    m_data->isMonotonic = true;
+    m_data->boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+    m_data->levels.clear();
+
+    const int numSamples = int( size() );
+    if ( numSamples <= 0 )
+        return;
+
+    const QwtSeriesData< QwtOHLCSample >* series = m_data->series;
+
+    const int numBlocks = ( numSamples + qwtBlockSize - 1 ) / qwtBlockSize;
+
+    QVector< QwtOHLCPyramidNode > nodes( numBlocks );
+
+    const double t0 = series->sample( 0 ).time;
+
+    double tMin = t0;
+    double tMax = t0;
+    double tPrev = t0;
+
+    for ( int block = 0; block < numBlocks; block++ )
+    {
+        const int from = block * qwtBlockSize;
+        const int to = qMin( from + qwtBlockSize, numSamples ) - 1;
+
+        QwtOHLCPyramidNode& node = nodes[block];
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtOHLCSample sample = series->sample( i );
+
+            if ( i == from )
+                node.init( sample );
+            else
+                node.add( sample );
+
+            const double t = sample.time;
+
+            if ( t < tPrev )
+                m_data->isMonotonic = false;
+
+            if ( t < tMin )
+                tMin = t;
+
+            if ( t > tMax )
+                tMax = t;
+
+            tPrev = t;
+        }
+    }
+
+    m_data->levels += nodes;
+
+    while ( nodes.size() > 1 )
+    {
+        const QVector< QwtOHLCPyramidNode > lower = nodes;
+
+        nodes.resize( ( lower.size() + 1 ) / 2 );
+        for ( int i = 0; i < nodes.size(); i++ )
+        {
+            nodes[i] = lower[2 * i];
+            if ( 2 * i + 1 < lower.size() )
+                nodes[i].add( lower[2 * i + 1] );
+        }
+
+        m_data->levels += nodes;
+    }
+
+    const QwtOHLCPyramidNode& root = m_data->levels.last()[0];
+
+    m_data->boundingRect.setCoords( tMin, root.low, tMax, root.high );
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_OHLC_SERIES_DATA_PYRAMID_H
+#define QWT_OHLC_SERIES_DATA_PYRAMID_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+class QwtScaleMap;
+
+#if QT_VERSION < 0x060000
+template< typename T > class QVector;
+#endif
+
+/*!
+   \brief A low/high pyramid for a series of OHLC samples
+
+   QwtOHLCSeriesDataPyramid wraps another QwtSeriesData<QwtOHLCSample> object
+   and builds a multi-resolution index of the minimum of the low and the
+   maximum of the high values of consecutive blocks of samples. For series
+   with increasing time values it offers to aggregate any index range
+   into one sample in O(log n): open of the first sample, maximum of
+   the highs, minimum of the lows and close of the last sample.
+
+   QwtPlotTradingCurve takes advantage of the index: all samples,
+   that are mapped to the same pixel are aggregated into one symbol.
+   So the costs of a replot depend on the size of the canvas
+   instead of the number of samples.
+
+   The index is built lazily, when it is needed the first time.
+   When the samples of the wrapped series are modified invalidate()
+   has to be called.
+
+   \par Example
+   \code
+   QwtPlotTradingCurve* curve = new QwtPlotTradingCurve();
+   curve->setData( new QwtOHLCSeriesDataPyramid(
+       new QwtTradingChartData( samples ) ) );
+   \endcode
+   \endpar
+
+   \sa QwtPlotTradingCurve::drawSymbols(), QwtSeriesDataPyramid
+ */
+class QWT_EXPORT QwtOHLCSeriesDataPyramid
+    : public QwtSeriesData< QwtOHLCSample >
+{
+  public:
+    explicit QwtOHLCSeriesDataPyramid(
+        QwtSeriesData< QwtOHLCSample >* series = NULL );
+
+    virtual ~QwtOHLCSeriesDataPyramid();
+
+    void setSeries( QwtSeriesData< QwtOHLCSample >* );
+    const QwtSeriesData< QwtOHLCSample >* series() const;
+
+    void invalidate();
+
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtOHLCSample sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+
+    bool aggregate( int from, int to, QwtOHLCSample& ) const;
+
+    QVector< QwtOHLCSample > aggregatedSamples(
+        const QwtScaleMap& timeMap, double bucketWidth,
+        int from, int to ) const;
+
+    QVector< QwtOHLCSample > aggregatedSamples(
+        double timeOrigin, double timeStep, int from, int to ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtOHLCSeriesDataPyramid )
+
+    void build() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
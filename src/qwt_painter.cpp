@@ -12,6 +12,8 @@
 #include "qwt_clipper.h"
 #include "qwt_color_map.h"
 #include "qwt_scale_map.h"
+#include "qwt_null_paintdevice.h"
+#include "qwt_atomic_p.h"
 
 #include <qwidget.h>
 #include <qframe.h>
@@ -27,6 +29,7 @@
 #include <qstyleoption.h>
 #include <qpaintengine.h>
 #include <qapplication.h>
+#include <qthread.h>
 
 #if QT_VERSION >= 0x060000
 #include <qscreen.h>
@@ -46,6 +49,10 @@
 
 bool QwtPainter::m_polylineSplitting = true;
 bool QwtPainter::m_roundingAlignment = true;
+double QwtPainter::m_vectorResolution = 0.0;
+
+// number of points of the chunks, when painting to vector devices
+static const int qwtVectorSplitSize = 1000;
 
 static inline bool qwtIsRasterPaintEngineBuggy()
 {
@@ -105,22 +112,132 @@ static inline bool qwtIsClippingNeeded(
     return doClipping;
 }
 
+static inline bool qwtIsThinPen( const QPainter* painter )
+{
+    const QPen pen = painter->pen();
+    if ( pen.widthF() > 1.0 )
+        return false;
+
+    return pen.isCosmetic()
+        || painter->transform().type() <= QTransform::TxTranslate;
+}
+
+static inline int qwtPolylineSplitSize( const QPainter* painter )
+{
+    /*
+        The effort of QStroker for a polyline grows overproportionally
+        with the number of segments, and even more for wide or
+        antialiased pens. On the other hand each chunk has a fixed
+        overhead and introduces a join, where the pieces meet.
+        So the chunks are the shorter the wider the pen.
+     */
+
+    const QPen pen = painter->pen();
+
+    qreal width = pen.widthF();
+    if ( !pen.isCosmetic() )
+    {
+        const QTransform& tr = painter->transform();
+        width *= std::sqrt( qAbs( tr.determinant() ) );
+    }
+
+    width = qMax( width, qreal( 1.0 ) );
+
+    if ( painter->renderHints() & QPainter::Antialiasing )
+        return qBound( 4, qRound( 24.0 / width ), 24 );
+
+    return qBound( 6, qRound( 48.0 / width ), 48 );
+}
+
+template< class T >
+static inline void qwtDrawPolylineBuggy( QPainter* painter,
+    const T* points, int pointCount )
+{
+    // work around a bug with short lines below 2 pixels difference
+    // in height and width
+
+    const int splitSize = 6;
+
+    int k = 0;
+
+    for ( int i = k + 1; i < pointCount; i++ )
+    {
+        const QPointF& p1 = points[i - 1];
+        const QPointF& p2 = points[i];
+
+        const bool isBad = ( qAbs( p2.y() - p1.y() ) <= 1 )
+            && qAbs( p2.x() - p1.x() ) <= 1;
+
+        if ( isBad || ( i - k >= splitSize ) )
+        {
+            painter->drawPolyline( points + k, i - k + 1 );
+            k = i;
+        }
+    }
+
+    painter->drawPolyline( points + k, pointCount - k );
+}
+
+template< class T >
+static inline void qwtDrawPolylineAsLines( QPainter* painter,
+    const T* points, int pointCount )
+{
+    /*
+        For thin, opaque and solid pens without antialiasing the
+        raster paint engine uses its cosmetic stroker - a simple
+        line rasterizer. Passing the segments as lines avoids building
+        the path of the polyline and is not affected by the bug
+        with short segments. As the pen is opaque painting the joins
+        twice makes no difference.
+     */
+
+    const int bufferSize = 512;
+    QLineF lines[ bufferSize ];
+
+    int numLines = 0;
+
+    for ( int i = 1; i < pointCount; i++ )
+    {
+        lines[ numLines++ ] = QLineF( points[i - 1], points[i] );
+
+        if ( numLines == bufferSize )
+        {
+            painter->drawLines( lines, numLines );
+            numLines = 0;
+        }
+    }
+
+    if ( numLines > 0 )
+        painter->drawLines( lines, numLines );
+}
+
 template< class T >
 static inline void qwtDrawPolyline( QPainter* painter,
     const T* points, int pointCount, bool polylineSplitting )
 {
-    bool doSplit = false;
     if ( polylineSplitting && pointCount > 3 )
     {
         const QPaintEngine* pe = painter->paintEngine();
         if ( pe && pe->type() == QPaintEngine::Raster )
         {
-            if ( painter->pen().width() <= 1 )
+            if ( qwtIsThinPen( painter ) )
             {
-                // work around a bug with short lines below 2 pixels difference
-                // in height and width
+                const QPen pen = painter->pen();
 
-                doSplit = qwtIsRasterPaintEngineBuggy();
+                if ( pen.style() == Qt::SolidLine && pen.isSolid()
+                    && pen.color().alpha() == 255
+                    && !( painter->renderHints() & QPainter::Antialiasing ) )
+                {
+                    qwtDrawPolylineAsLines( painter, points, pointCount );
+                    return;
+                }
+
+                if ( pen.isSolid() && qwtIsRasterPaintEngineBuggy()
+                    && !( painter->renderHints() & QPainter::Antialiasing ) )
+                {
+                    qwtDrawPolylineBuggy( painter, points, pointCount );
+                    return;
+                }
             }
             else
             {
@@ -129,77 +246,79 @@ static inline void qwtDrawPolyline( QPainter* painter,
                    the polygon, but of course we might see some issues where
                    the pieces are joining
                  */
-                doSplit = true;
-            }
-        }
-    }
-
-    if ( doSplit )
-    {
-        QPen pen = painter->pen();
-
-        const int splitSize = 6;
-
-        if ( pen.width() <= 1 && pen.isSolid() && qwtIsRasterPaintEngineBuggy()
-            && !( painter->renderHints() & QPainter::Antialiasing ) )
-        {
-            int k = 0;
-
-            for ( int i = k + 1; i < pointCount; i++ )
-            {
-                const QPointF& p1 = points[i - 1];
-                const QPointF& p2 = points[i];
+                const int splitSize = qwtPolylineSplitSize( painter );
 
-                const bool isBad = ( qAbs( p2.y() - p1.y() ) <= 1 )
-                    && qAbs( p2.x() - p1.x() ) <= 1;
-
-                if ( isBad || ( i - k >= splitSize ) )
+                for ( int i = 0; i < pointCount; i += splitSize )
                 {
-                    painter->drawPolyline( points + k, i - k + 1 );
-                    k = i;
+                    const int n = qMin( splitSize + 1, pointCount - i );
+                    painter->drawPolyline( points + i, n );
                 }
-            }
 
-            painter->drawPolyline( points + k, pointCount - k );
-        }
-        else
-        {
-            for ( int i = 0; i < pointCount; i += splitSize )
-            {
-                const int n = qMin( splitSize + 1, pointCount - i );
-                painter->drawPolyline( points + i, n );
+                return;
             }
         }
     }
-    else
+
+    if ( pointCount > qwtVectorSplitSize
+        && painter->pen().style() == Qt::SolidLine
+        && QwtPainter::vectorResolution( painter ) > 0.0 )
     {
-        painter->drawPolyline( points, pointCount );
+        /*
+            Viewers of PDF/SVG documents are often slow for paths
+            with many elements. As the pen is solid, the pieces
+            can't be distinguished - beside the joins.
+         */
+        for ( int i = 0; i < pointCount; i += qwtVectorSplitSize )
+        {
+            const int n = qMin( qwtVectorSplitSize + 1, pointCount - i );
+            painter->drawPolyline( points + i, n );
+        }
+
+        return;
     }
+
+    painter->drawPolyline( points, pointCount );
 }
 
 static inline QSize qwtScreenResolution()
 {
-    static QSize screenResolution;
-    if ( !screenResolution.isValid() )
-    {
-        /*
-            We might have screens with different resolutions. TODO ...
-         */
+    /*
+        Text might be painted from worker threads, f.e. when
+        rendering scenes. So the resolution is stored as one atomic
+        value: ( dpiX << 16 ) | dpiY, 0 means not yet known.
+     */
+    static QAtomicInt cachedResolution( 0 );
+
+    const int resolution = qwtLoadAcquire( cachedResolution );
+    if ( resolution != 0 )
+        return QSize( resolution >> 16, resolution & 0xffff );
+
+    /*
+        We might have screens with different resolutions. TODO ...
+     */
+    QSize screenResolution;
+
 #if QT_VERSION >= 0x060000
-        QScreen* screen = QGuiApplication::primaryScreen();
-        if ( screen )
-        {
-            screenResolution.setWidth( screen->logicalDotsPerInchX() );
-            screenResolution.setHeight( screen->logicalDotsPerInchY() );
-        }
+    QScreen* screen = QGuiApplication::primaryScreen();
+    if ( screen )
+    {
+        screenResolution.setWidth( screen->logicalDotsPerInchX() );
+        screenResolution.setHeight( screen->logicalDotsPerInchY() );
+    }
 #else
-        QDesktopWidget* desktop = QApplication::desktop();
-        if ( desktop )
-        {
-            screenResolution.setWidth( desktop->logicalDpiX() );
-            screenResolution.setHeight( desktop->logicalDpiY() );
-        }
+    QDesktopWidget* desktop = QApplication::desktop();
+    if ( desktop )
+    {
+        screenResolution.setWidth( desktop->logicalDpiX() );
+        screenResolution.setHeight( desktop->logicalDpiY() );
+    }
 #endif
+
+    if ( screenResolution.isValid() )
+    {
+        // concurrent threads store the same value
+        qwtStoreRelease( cachedResolution, ( screenResolution.width() << 16 )
+            | ( screenResolution.height() & 0xffff ) );
     }
 
     return screenResolution;
@@ -229,6 +348,8 @@ static inline void qwtUnscaleFont( QPainter* painter )
    painting to a widget.
 
    \return True, when the graphics system is X11
+   \note The graphics system is detected in the GUI thread. Until then
+         other threads get false.
  */
 bool QwtPainter::isX11GraphicsSystem()
 {
@@ -238,16 +359,30 @@ bool QwtPainter::isX11GraphicsSystem()
         "export QT_XCB_NATIVE_PAINTING=1".
      */
 
-    static int onX11 = -1;
-    if ( onX11 < 0 )
+    static QAtomicInt onX11( -1 );
+
+    int isX11 = qwtLoadAcquire( onX11 );
+    if ( isX11 < 0 )
     {
+        /*
+            A QImage is always painted by the raster paint engine, so
+            the detection needs a QPixmap, that must not be created
+            outside of the GUI thread. As pixmaps - and the X11 paint
+            engine - are not available in other threads anyway, those
+            get false without resolving the value.
+         */
+        const QCoreApplication* app = QCoreApplication::instance();
+        if ( app == NULL || QThread::currentThread() != app->thread() )
+            return false;
+
         QPixmap pm( 1, 1 );
         QPainter painter( &pm );
 
-        onX11 = ( painter.paintEngine()->type() == QPaintEngine::X11 ) ? 1 : 0;
+        isX11 = ( painter.paintEngine()->type() == QPaintEngine::X11 ) ? 1 : 0;
+        qwtStoreRelease( onX11, isX11 );
     }
 
-    return onX11 == 1;
+    return isX11 == 1;
 }
 
 /*!
@@ -301,6 +436,35 @@ bool QwtPainter::isAligning( const QPainter* painter )
     return true;
 }
 
+/*!
+   Check if the painter is painting to a QwtNullPaintDevice,
+   that is measure-only.
+
+   In this case only the geometry of the painter commands is
+   of interest, and expensive operations - like rendering images
+   or shaping texts - might be replaced by placeholders of
+   the same geometry.
+
+   \param painter Painter
+   \return true, when the paint device is measure-only
+
+   \sa QwtNullPaintDevice::setMeasureOnly()
+ */
+bool QwtPainter::isMeasureOnly( const QPainter* painter )
+{
+    if ( painter == NULL || !painter->isActive() )
+        return false;
+
+    // QwtNullPaintDevice is using a type above QPaintEngine::User
+    if ( painter->paintEngine()->type() <= QPaintEngine::User )
+        return false;
+
+    const QwtNullPaintDevice* device =
+        dynamic_cast< const QwtNullPaintDevice* >( painter->device() );
+
+    return device && device->isMeasureOnly();
+}
+
 /*!
    Enable whether coordinates should be rounded, before they are painted
    to a paint engine that floors to integer values. For other paint engines
@@ -310,6 +474,9 @@ bool QwtPainter::isAligning( const QPainter* painter )
 
    The default setting is true.
 
+   \note The flag is global for all threads and is not meant to be
+         changed while painting is in progress.
+
    \sa roundingAlignment(), isAligning()
  */
 void QwtPainter::setRoundingAlignment( bool enable )
@@ -317,6 +484,65 @@ void QwtPainter::setRoundingAlignment( bool enable )
     m_roundingAlignment = enable;
 }
 
+/*!
+   \brief Set a resolution for reducing polylines on vector devices
+
+   For paint devices without integer coordinates ( PDF, SVG ) plot items
+   can't reduce the points of a polyline to what is visible on
+   the pixel grid of the device. When a vector resolution is set
+   the points are reduced to a virtual pixel grid of this resolution
+   instead and long polylines are painted in chunks. Then the size
+   of the document depends on the resolution and not on the number
+   of samples.
+
+   QwtPlotRenderer sets the vector resolution temporarily while
+   rendering, when QwtPlotRenderer::setExportResolution() has been called.
+
+   \param dpi Resolution in dots per inch. A value <= 0.0 disables
+          the reduction, what is the default setting.
+
+   \note The value is global for all threads and is not meant to be
+         changed while painting is in progress.
+
+   \sa vectorResolution(), QwtPointMapper::setResolution()
+ */
+void QwtPainter::setVectorResolution( double dpi )
+{
+    m_vectorResolution = qMax( dpi, 0.0 );
+}
+
+/*!
+   \brief Resolution for reducing polylines in painter coordinates
+
+   \param painter Painter
+   \return Number of pixels of the virtual pixel grid per unit
+           of the painter coordinates, or 0.0, when the painter is
+           aligning or no vector resolution has been set.
+
+   \sa setVectorResolution(), isAligning()
+ */
+double QwtPainter::vectorResolution( const QPainter* painter )
+{
+    if ( m_vectorResolution <= 0.0 || painter == NULL
+        || !painter->isActive() || isAligning( painter ) )
+    {
+        return 0.0;
+    }
+
+    const QPaintDevice* device = painter->device();
+
+    const int dpi = device ? device->logicalDpiX() : 0;
+    if ( dpi <= 0 )
+        return 0.0;
+
+    // painter coordinates -> device coordinates -> pixels of the grid
+
+    const QTransform& tr = painter->transform();
+    const double scale = qSqrt( tr.m11() * tr.m11() + tr.m12() * tr.m12() );
+
+    return scale * m_vectorResolution / dpi;
+}
+
 /*!
    \brief En/Disable line splitting for the raster paint engine
 
@@ -328,8 +554,16 @@ void QwtPainter::setRoundingAlignment( bool enable )
    for short lines ( https://codereview.qt-project.org/#/c/99456 ), that is worked
    around in this mode.
 
+   The size of the chunks depends on the width of the pen and on antialiasing.
+   Polylines painted with thin, opaque and solid pens without antialiasing
+   are passed as individual lines to the cosmetic stroker of the raster
+   paint engine.
+
    The default setting is true.
 
+   \note The flag is global for all threads and is not meant to be
+         changed while painting is in progress.
+
    \sa polylineSplitting()
  */
 void QwtPainter::setPolylineSplitting( bool enable )
@@ -378,6 +612,31 @@ void QwtPainter::drawRect( QPainter* painter, const QRectF& rect )
     painter->drawRect( r );
 }
 
+/*!
+   \brief Wrapper for QPainter::drawRects()
+
+   \param painter Painter
+   \param rects Array of rectangles
+   \param rectCount Number of rectangles
+ */
+void QwtPainter::drawRects( QPainter* painter,
+    const QRectF* rects, int rectCount )
+{
+    if ( rectCount <= 0 )
+        return;
+
+    QRectF clipRect;
+    if ( qwtIsClippingNeeded( painter, clipRect ) )
+    {
+        for ( int i = 0; i < rectCount; i++ )
+            drawRect( painter, rects[i] );
+
+        return;
+    }
+
+    painter->drawRects( rects, rectCount );
+}
+
 //! Wrapper for QPainter::fillRect()
 void QwtPainter::fillRect( QPainter* painter,
     const QRectF& rect, const QBrush& brush )
@@ -1201,11 +1460,39 @@ void QwtPainter::drawRoundedFrame( QPainter* painter,
    \param scaleMap Scale map
    \param orientation Orientation
    \param rect Target rectangle
+
+   \sa colorBarPixmap()
  */
 void QwtPainter::drawColorBar( QPainter* painter,
     const QwtColorMap& colorMap, const QwtInterval& interval,
     const QwtScaleMap& scaleMap, Qt::Orientation orientation,
     const QRectF& rect )
+{
+    const QPixmap pixmap = colorBarPixmap(
+        colorMap, interval, scaleMap, orientation, rect );
+
+    drawPixmap( painter, rect, pixmap );
+}
+
+/*!
+   Render a color bar into a pixmap
+
+   The pixmap can be painted to rect by drawPixmap() - what
+   allows to reuse it as long as the parameters do not change.
+
+   \param colorMap Color map
+   \param interval Value range
+   \param scaleMap Scale map
+   \param orientation Orientation
+   \param rect Target rectangle
+
+   \return Pixmap with the size of the aligned rect
+   \sa drawColorBar()
+ */
+QPixmap QwtPainter::colorBarPixmap(
+    const QwtColorMap& colorMap, const QwtInterval& interval,
+    const QwtScaleMap& scaleMap, Qt::Orientation orientation,
+    const QRectF& rect )
 {
     QVector< QRgb > colorTable;
     if ( colorMap.format() == QwtColorMap::Indexed )
@@ -1264,7 +1551,7 @@ void QwtPainter::drawColorBar( QPainter* painter,
     }
     pmPainter.end();
 
-    drawPixmap( painter, rect, pixmap );
+    return pixmap;
 }
 
 static inline void qwtFillRect( const QWidget* widget, QPainter* painter,
@@ -1523,15 +1810,31 @@ qreal QwtPainter::devicePixelRatio( const QPaintDevice* paintDevice )
    \param size Size of the pixmap
  */
 QPixmap QwtPainter::backingStore( QWidget* widget, const QSize& size )
+{
+    return backingStore( widget, size, QwtPainter::devicePixelRatio( widget ) );
+}
+
+/*!
+   \return A pixmap that can be used as backing store
+
+   \param widget Widget, for which the backingstore is intended
+   \param size Size of the pixmap in logical coordinates
+   \param pixelRatio Device pixel ratio of the pixmap, that might be
+                     lower than the one of the widget to
+                     reduce the number of pixels being rendered
+
+   \note The pixel ratio is ignored for Qt < 5
+ */
+QPixmap QwtPainter::backingStore( QWidget* widget,
+    const QSize& size, qreal pixelRatio )
 {
     QPixmap pm;
 
 #if QT_VERSION >= 0x050000
-    const qreal pixelRatio = QwtPainter::devicePixelRatio( widget );
-
     pm = QPixmap( size * pixelRatio );
     pm.setDevicePixelRatio( pixelRatio );
 #else
+    Q_UNUSED( pixelRatio )
     pm = QPixmap( size );
 #endif
 
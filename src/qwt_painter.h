@@ -43,6 +43,12 @@ class QWT_EXPORT QwtPainter
     static bool roundingAlignment();
     static bool roundingAlignment( const QPainter* );
 
+    static void setVectorResolution( double dpi );
+    static double vectorResolution();
+    static double vectorResolution( const QPainter* );
+
+    static bool isMeasureOnly( const QPainter* );
+
     static void drawText( QPainter*, qreal x, qreal y, const QString& );
     static void drawText( QPainter*, const QPointF&, const QString& );
     static void drawText( QPainter*, qreal x, qreal y, qreal w, qreal h,
@@ -57,6 +63,7 @@ class QWT_EXPORT QwtPainter
 
     static void drawRect( QPainter*, qreal x, qreal y, qreal w, qreal h );
     static void drawRect( QPainter*, const QRectF& rect );
+    static void drawRects( QPainter*, const QRectF* rects, int rectCount );
     static void fillRect( QPainter*, const QRectF&, const QBrush& );
 
     static void drawEllipse( QPainter*, const QRectF& );
@@ -105,6 +112,9 @@ class QWT_EXPORT QwtPainter
         const QwtColorMap&, const QwtInterval&,
         const QwtScaleMap&, Qt::Orientation, const QRectF& );
 
+    static QPixmap colorBarPixmap( const QwtColorMap&, const QwtInterval&,
+        const QwtScaleMap&, Qt::Orientation, const QRectF& );
+
     static bool isAligning( const QPainter*);
     static bool isX11GraphicsSystem();
 
@@ -115,6 +125,7 @@ class QWT_EXPORT QwtPainter
         const QRectF&, const QWidget* );
 
     static QPixmap backingStore( QWidget*, const QSize& );
+    static QPixmap backingStore( QWidget*, const QSize&, qreal pixelRatio );
     static qreal devicePixelRatio( const QPaintDevice* );
 
     static qreal effectivePenWidth( const QPen& );
@@ -130,6 +141,7 @@ class QWT_EXPORT QwtPainter
   private:
     static bool m_polylineSplitting;
     static bool m_roundingAlignment;
+    static double m_vectorResolution;
 };
 
 //!  Wrapper for QPainter::drawPoint()
@@ -185,6 +197,16 @@ inline bool QwtPainter::roundingAlignment()
     return m_roundingAlignment;
 }
 
+/*!
+   \return Resolution in dpi for reducing the points of a polyline,
+           when painting to devices without integer coordinates.
+   \sa setVectorResolution()
+ */
+inline double QwtPainter::vectorResolution()
+{
+    return m_vectorResolution;
+}
+
 /*!
    \return roundingAlignment() && isAligning(painter);
    \param painter Painter
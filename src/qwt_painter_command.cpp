@@ -120,6 +120,16 @@ QwtPainterCommand::QwtPainterCommand( const QPaintEngineState& state )
         m_stateData->opacity = state.opacity();
 }
 
+/*!
+   Constructor for State paint operation
+   \param stateData Attributes of the state change
+ */
+QwtPainterCommand::QwtPainterCommand( const StateData& stateData )
+    : m_type( State )
+{
+    m_stateData = new StateData( stateData );
+}
+
 /*!
    Copy constructor
    \param other Command to be copied
@@ -104,6 +104,7 @@ class QWT_EXPORT QwtPainterCommand
         Qt::ImageConversionFlags );
 
     explicit QwtPainterCommand( const QPaintEngineState& );
+    explicit QwtPainterCommand( const StateData& );
 
     ~QwtPainterCommand();
 
@@ -46,7 +46,9 @@ class QwtPanner::PrivateData
         , hasCursor( false )
 #endif
         , isEnabled( false )
+        , isPanning( false )
         , orientations( Qt::Vertical | Qt::Horizontal )
+        , panningMode( QwtPanner::PixmapPanning )
     {
     }
 
@@ -76,7 +78,9 @@ class QwtPanner::PrivateData
     bool hasCursor;
 #endif
     bool isEnabled;
+    bool isPanning;
     Qt::Orientations orientations;
+    QwtPanner::PanningMode panningMode;
 };
 
 /*!
@@ -176,6 +180,40 @@ const QCursor QwtPanner::cursor() const
 }
 #endif
 
+/*!
+   \brief Set the panning mode
+
+   In LivePanning mode the widget is not grabbed, what avoids
+   allocating and painting a pixmap of the size of the widget.
+   Instead the owner of the panner has to update the widget
+   according to the moved() signals. The default mode is PixmapPanning.
+
+   \param mode Panning mode
+   \sa panningMode()
+ */
+void QwtPanner::setPanningMode( PanningMode mode )
+{
+    m_data->panningMode = mode;
+}
+
+/*!
+   \return Panning mode
+   \sa setPanningMode()
+ */
+QwtPanner::PanningMode QwtPanner::panningMode() const
+{
+    return m_data->panningMode;
+}
+
+/*!
+   \return true, between pressing and releasing the mouse button
+   \sa widgetMousePressEvent(), widgetMouseReleaseEvent()
+ */
+bool QwtPanner::isPanning() const
+{
+    return m_data->isPanning;
+}
+
 /*!
    \brief En/disable the panner
 
@@ -202,6 +240,8 @@ void QwtPanner::setEnabled( bool on )
             {
                 w->removeEventFilter( this );
                 hide();
+
+                m_data->isPanning = false;
             }
         }
     }
@@ -395,9 +435,13 @@ void QwtPanner::widgetMousePressEvent( QMouseEvent* mouseEvent )
 #endif
 
     m_data->initialPos = m_data->pos = mouseEvent->pos();
+    m_data->isPanning = true;
 
     setGeometry( parentWidget()->rect() );
 
+    if ( m_data->panningMode == LivePanning )
+        return;
+
     // We don't want to grab the picker !
     QVector< QwtPicker* > pickers = qwtActivePickers( parentWidget() );
     for ( int i = 0; i < pickers.size(); i++ )
@@ -420,7 +464,7 @@ void QwtPanner::widgetMousePressEvent( QMouseEvent* mouseEvent )
  */
 void QwtPanner::widgetMouseMoveEvent( QMouseEvent* mouseEvent )
 {
-    if ( !isVisible() )
+    if ( !m_data->isPanning )
         return;
 
     QPoint pos = mouseEvent->pos();
@@ -432,7 +476,9 @@ void QwtPanner::widgetMouseMoveEvent( QMouseEvent* mouseEvent )
     if ( pos != m_data->pos && rect().contains( pos ) )
     {
         m_data->pos = pos;
-        update();
+
+        if ( isVisible() )
+            update();
 
         Q_EMIT moved( m_data->pos.x() - m_data->initialPos.x(),
             m_data->pos.y() - m_data->initialPos.y() );
@@ -448,8 +494,10 @@ void QwtPanner::widgetMouseMoveEvent( QMouseEvent* mouseEvent )
  */
 void QwtPanner::widgetMouseReleaseEvent( QMouseEvent* mouseEvent )
 {
-    if ( isVisible() )
+    if ( m_data->isPanning )
     {
+        m_data->isPanning = false;
+
         hide();
 #ifndef QT_NO_CURSOR
         showCursor( false );
@@ -484,12 +532,23 @@ void QwtPanner::widgetKeyPressEvent( QKeyEvent* keyEvent )
     if ( ( keyEvent->key() == m_data->abortKey )
         && ( keyEvent->modifiers() == m_data->abortKeyModifiers ) )
     {
+        const bool wasPanning = m_data->isPanning;
+        m_data->isPanning = false;
+
         hide();
 
 #ifndef QT_NO_CURSOR
         showCursor( false );
 #endif
         m_data->pixmap = QPixmap();
+
+        if ( wasPanning && m_data->panningMode == LivePanning
+            && m_data->pos != m_data->initialPos )
+        {
+            // moving the widget back to its initial position
+            m_data->pos = m_data->initialPos;
+            Q_EMIT moved( 0, 0 );
+        }
     }
 }
 
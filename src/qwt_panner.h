@@ -31,15 +31,43 @@ class QPixmap;
 
    For widgets, where repaints are very fast it might be better to
    implement panning manually by mapping mouse events into paint events.
+   In LivePanning mode nothing is grabbed and the moved() signals can be
+   used to update the widget continuously.
+
+   \sa setPanningMode()
  */
 class QWT_EXPORT QwtPanner : public QWidget
 {
     Q_OBJECT
 
   public:
+    /*!
+       \brief Panning mode
+
+       \sa setPanningMode(), panningMode()
+     */
+    enum PanningMode
+    {
+        /*!
+           The content of the widget is grabbed into a pixmap, that
+           is dragged around until the mouse button is released.
+         */
+        PixmapPanning,
+
+        /*!
+           Nothing is grabbed. The panner only emits the moved() signals,
+           so that the widget can be updated while dragging. When panning
+           is aborted moved( 0, 0 ) is emitted.
+         */
+        LivePanning
+    };
+
     explicit QwtPanner( QWidget* parent );
     virtual ~QwtPanner();
 
+    void setPanningMode( PanningMode );
+    PanningMode panningMode() const;
+
     void setEnabled( bool );
     bool isEnabled() const;
 
@@ -91,6 +119,8 @@ class QWT_EXPORT QwtPanner : public QWidget
     virtual QBitmap contentsMask() const;
     virtual QPixmap grab() const;
 
+    bool isPanning() const;
+
   private:
 #ifndef QT_NO_CURSOR
     void showCursor( bool );
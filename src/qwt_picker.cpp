@@ -71,7 +71,7 @@ namespace
             : QwtWidgetOverlay( parent )
             , m_picker( picker )
         {
-            setMaskMode( QwtWidgetOverlay::MaskHint );
+            setMaskMode( QwtWidgetOverlay::UpdateRegion );
         }
 
       protected:
@@ -96,7 +96,7 @@ namespace
             : QwtWidgetOverlay( parent )
             , m_picker( picker )
         {
-            setMaskMode( QwtWidgetOverlay::MaskHint );
+            setMaskMode( QwtWidgetOverlay::UpdateRegion );
         }
 
       protected:
@@ -127,7 +127,11 @@ class QwtPicker::PrivateData
         isActive( false ),
         trackerPosition( -1, -1 ),
         mouseTracking( false ),
-        openGL( false )
+        openGL( false ),
+        moveInterval( 0 ),
+        moveTimerId( 0 ),
+        moveButtons( Qt::NoButton ),
+        moveModifiers( Qt::NoModifier )
     {
     }
 
@@ -154,6 +158,13 @@ class QwtPicker::PrivateData
     QPointer< Tracker > trackerOverlay;
 
     bool openGL;
+
+    // the latest of the coalesced mouse move events
+    int moveInterval;
+    int moveTimerId;
+    QPoint movePosition;
+    Qt::MouseButtons moveButtons;
+    Qt::KeyboardModifiers moveModifiers;
 };
 
 /*!
@@ -387,6 +398,12 @@ void QwtPicker::setEnabled( bool enabled )
                 w->removeEventFilter( this );
         }
 
+        if ( !enabled && m_data->moveTimerId != 0 )
+        {
+            killTimer( m_data->moveTimerId );
+            m_data->moveTimerId = 0;
+        }
+
         updateDisplay();
     }
 }
@@ -426,6 +443,39 @@ QFont QwtPicker::trackerFont() const
     return m_data->trackerFont;
 }
 
+/*!
+   \brief Set the interval for coalescing mouse move events
+
+   When the interval is > 0, the first mouse move event starts a timer
+   and only the position of the latest mouse move event until it
+   expires is passed to widgetMouseMoveEvent(). A pending move is
+   processed before any other mouse or key event.
+
+   This limits the transitions of the state machine, the updates of the
+   rubber band and tracker overlays and the moved() signals to one per
+   interval ( f.e. 16ms for 60Hz ), regardless of the polling rate of
+   the mouse.
+
+   The default setting is 0, where each mouse move event is processed
+   immediately.
+
+   \param msec Interval in milliseconds
+   \sa mouseMoveCoalescingInterval(), widgetMouseMoveEvent()
+ */
+void QwtPicker::setMouseMoveCoalescingInterval( int msec )
+{
+    m_data->moveInterval = qMax( msec, 0 );
+}
+
+/*!
+   \return Interval for coalescing mouse move events
+   \sa setMouseMoveCoalescingInterval()
+ */
+int QwtPicker::mouseMoveCoalescingInterval() const
+{
+    return m_data->moveInterval;
+}
+
 /*!
    Set the pen for the tracker
 
@@ -894,6 +944,28 @@ bool QwtPicker::eventFilter( QObject* object, QEvent* event )
 {
     if ( object && object == parentWidget() )
     {
+        if ( m_data->moveTimerId != 0 )
+        {
+            switch ( event->type() )
+            {
+                case QEvent::Enter:
+                case QEvent::Leave:
+                case QEvent::MouseButtonPress:
+                case QEvent::MouseButtonRelease:
+                case QEvent::MouseButtonDblClick:
+                case QEvent::KeyPress:
+                case QEvent::KeyRelease:
+                case QEvent::Wheel:
+                {
+                    // keeping the order of the events
+                    flushMouseMove();
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
         switch ( event->type() )
         {
             case QEvent::Resize:
@@ -945,7 +1017,21 @@ bool QwtPicker::eventFilter( QObject* object, QEvent* event )
             }
             case QEvent::MouseMove:
             {
-                widgetMouseMoveEvent( static_cast< QMouseEvent* >( event ) );
+                const QMouseEvent* me = static_cast< QMouseEvent* >( event );
+
+                if ( m_data->moveInterval > 0 )
+                {
+                    m_data->movePosition = me->pos();
+                    m_data->moveButtons = me->buttons();
+                    m_data->moveModifiers = me->modifiers();
+
+                    if ( m_data->moveTimerId == 0 )
+                        m_data->moveTimerId = startTimer( m_data->moveInterval );
+                }
+                else
+                {
+                    widgetMouseMoveEvent( static_cast< QMouseEvent* >( event ) );
+                }
                 break;
             }
             case QEvent::KeyPress:
@@ -1006,6 +1092,37 @@ void QwtPicker::widgetMouseMoveEvent( QMouseEvent* mouseEvent )
     transition( mouseEvent );
 }
 
+/*!
+   Process the latest of the coalesced mouse move events
+
+   \param event Timer event
+   \sa setMouseMoveCoalescingInterval()
+ */
+void QwtPicker::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->moveTimerId )
+    {
+        flushMouseMove();
+        return;
+    }
+
+    QObject::timerEvent( event );
+}
+
+void QwtPicker::flushMouseMove()
+{
+    if ( m_data->moveTimerId == 0 )
+        return;
+
+    killTimer( m_data->moveTimerId );
+    m_data->moveTimerId = 0;
+
+    QMouseEvent event( QEvent::MouseMove, m_data->movePosition,
+        Qt::NoButton, m_data->moveButtons, m_data->moveModifiers );
+
+    widgetMouseMoveEvent( &event );
+}
+
 /*!
    Handle a enter event for the observed widget.
 
@@ -1521,7 +1638,7 @@ void QwtPicker::updateDisplay()
         }
 
         if ( m_data->rubberBand <= RectRubberBand )
-            rw->setMaskMode( QwtWidgetOverlay::MaskHint );
+            rw->setMaskMode( QwtWidgetOverlay::UpdateRegion );
         else
             rw->setMaskMode( QwtWidgetOverlay::AlphaMask );
 
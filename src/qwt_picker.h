@@ -22,6 +22,7 @@ class QWidget;
 class QMouseEvent;
 class QWheelEvent;
 class QKeyEvent;
+class QTimerEvent;
 class QPainter;
 class QPen;
 class QFont;
@@ -94,6 +95,13 @@ class QPolygon;
    The cursor can be moved using the arrow keys. All selections can be aborted
    using the abort key. (QwtEventPattern::KeyPatternCode)
 
+   Mice with high polling rates generate many more mouse move events
+   than can be displayed. With a mouse move coalescing interval only the
+   latest position of each interval is processed, what also reduces
+   the updates of the tracker and rubber band and the number of
+   moved() signals.
+   ( setMouseMoveCoalescingInterval() )
+
    \warning In case of QWidget::NoFocus the focus policy of the observed
            widget is set to QWidget::WheelFocus and mouse tracking
            will be manipulated while the picker is active,
@@ -215,6 +223,9 @@ class QWT_EXPORT QwtPicker : public QObject, public QwtEventPattern
     void setTrackerFont( const QFont& );
     QFont trackerFont() const;
 
+    void setMouseMoveCoalescingInterval( int msec );
+    int mouseMoveCoalescingInterval() const;
+
     bool isEnabled() const;
     bool isActive() const;
 
@@ -316,6 +327,8 @@ class QWT_EXPORT QwtPicker : public QObject, public QwtEventPattern
     virtual void widgetEnterEvent( QEvent* );
     virtual void widgetLeaveEvent( QEvent* );
 
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
     virtual void stretchSelection(
         const QSize& oldSize, const QSize& newSize );
 
@@ -330,6 +343,7 @@ class QWT_EXPORT QwtPicker : public QObject, public QwtEventPattern
     void init( QWidget*, RubberBand rubberBand, DisplayMode trackerMode );
 
     void setMouseTracking( bool );
+    void flushMouseMove();
 
     class PrivateData;
     PrivateData* m_data;
@@ -13,16 +13,35 @@
 #include "qwt_scale_widget.h"
 #include "qwt_scale_engine.h"
 #include "qwt_scale_map.h"
+#include "qwt_transform.h"
+#include "qwt_scale_div.h"
 #include "qwt_text_label.h"
 #include "qwt_legend.h"
 #include "qwt_legend_data.h"
 #include "qwt_plot_canvas.h"
+#include "qwt_plot_seriesitem.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_plot_group.h"
+#include "qwt_render_statistics.h"
+#include "qwt_graphic.h"
 
 #include <qpainter.h>
 #include <qpointer.h>
 #include <qapplication.h>
 #include <qcoreevent.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qvector.h>
+#include <qhash.h>
+#include <qset.h>
+#include <qthread.h>
+#include <qelapsedtimer.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <typeinfo>
 
 static inline void qwtEnableLegendItems( QwtPlot* plot, bool on )
 {
@@ -84,9 +103,193 @@ static void qwtSetTabOrder(
     }
 }
 
+namespace
+{
+    // what has been used to render the layers
+    class QwtLayerGeometry
+    {
+      public:
+        QwtLayerGeometry()
+            : pixelRatio( 0.0 )
+        {
+            for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            {
+                p1[axisPos] = p2[axisPos] = 0.0;
+                transformations[axisPos] = NULL;
+                exponents[axisPos] = 0.0;
+            }
+        }
+
+        bool operator==( const QwtLayerGeometry& other ) const
+        {
+            if ( canvasRect != other.canvasRect || pixelRatio != other.pixelRatio )
+                return false;
+
+            for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            {
+                if ( scaleDivs[axisPos] != other.scaleDivs[axisPos]
+                    || p1[axisPos] != other.p1[axisPos]
+                    || p2[axisPos] != other.p2[axisPos]
+                    || exponents[axisPos] != other.exponents[axisPos] )
+                {
+                    return false;
+                }
+
+                const std::type_info* t1 = transformations[axisPos];
+                const std::type_info* t2 = other.transformations[axisPos];
+
+                if ( ( t1 == NULL || t2 == NULL ) ? ( t1 != t2 ) : ( *t1 != *t2 ) )
+                    return false;
+            }
+
+            return true;
+        }
+
+        bool operator!=( const QwtLayerGeometry& other ) const
+        {
+            return !( *this == other );
+        }
+
+        QRectF canvasRect;
+        qreal pixelRatio;
+
+        QwtScaleDiv scaleDivs[ QwtAxis::AxisPositions ];
+        double p1[ QwtAxis::AxisPositions ];
+        double p2[ QwtAxis::AxisPositions ];
+        const std::type_info* transformations[ QwtAxis::AxisPositions ];
+
+        // the parameter of a QwtPowerTransform, 0 for other transformations
+        double exponents[ QwtAxis::AxisPositions ];
+    };
+
+    // neighboured items with the QwtPlotItem::Static attribute
+    class QwtPlotLayer
+    {
+      public:
+        QwtPlotLayer()
+            : isDirty( true )
+        {
+        }
+
+        QList< const QwtPlotItem* > items;
+        QImage image;
+        bool isDirty;
+    };
+}
+
+static void qwtSetRenderHints( QPainter* painter, const QwtPlotItem* item )
+{
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+#if QT_VERSION < 0x050100
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+#endif
+}
+
+static void qwtDrawItem( QPainter* painter, const QwtPlotItem* item,
+    const QRectF& canvasRect, const QwtScaleMap maps[ QwtAxis::AxisPositions ],
+    QwtRenderStatistics* statistics )
+{
+    if ( statistics )
+    {
+        statistics->reset();
+        QwtRenderStatistics::setCurrent( statistics );
+    }
+
+    const QwtAxisId xAxis = item->xAxis();
+    const QwtAxisId yAxis = item->yAxis();
+
+    painter->save();
+
+    qwtSetRenderHints( painter, item );
+
+    {
+        QwtRenderStatistics::Timer timer( QwtRenderStatistics::Draw );
+        item->draw( painter, maps[xAxis], maps[yAxis], canvasRect );
+    }
+
+    painter->restore();
+
+    if ( statistics )
+        QwtRenderStatistics::setCurrent( NULL );
+}
+
+static inline bool qwtIsSameMap( const QwtScaleMap& map1, const QwtScaleMap& map2 )
+{
+    return map1.s1() == map2.s1() && map1.s2() == map2.s2()
+        && map1.p1() == map2.p1() && map1.p2() == map2.p2();
+}
+
+static inline bool qwtPaintsBackingStore(
+    const QWidget* canvas, const QPainter* painter )
+{
+    const QwtPlotCanvas* plotCanvas = qobject_cast< const QwtPlotCanvas* >( canvas );
+
+    return plotCanvas && plotCanvas->testPaintAttribute( QwtPlotCanvas::BackingStore )
+        && plotCanvas->backingStore() != NULL
+        && painter->device() == plotCanvas->backingStore();
+}
+
+/*
+    The visible items, whose bounding rectangles intersect with a
+    rectangle in paint device coordinates, in z order
+ */
+static QwtPlotItemList qwtItemsInRect( const QwtPlot* plot, const QRectF& rect,
+    const QwtScaleMap maps[ QwtAxis::AxisPositions ], bool withMargins )
+{
+    const QwtPlotItemList& itmList = plot->itemList();
+
+    QSet< int > axisPairs;
+    for ( QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it )
+        axisPairs += ( *it )->xAxis() * QwtAxis::AxisPositions + ( *it )->yAxis();
+
+    QSet< const QwtPlotItem* > hits;
+
+    for ( QSet< int >::const_iterator it = axisPairs.constBegin();
+        it != axisPairs.constEnd(); ++it )
+    {
+        const int xAxis = *it / QwtAxis::AxisPositions;
+        const int yAxis = *it % QwtAxis::AxisPositions;
+
+        const QRectF area = QwtScaleMap::invTransform(
+            maps[xAxis], maps[yAxis], rect );
+
+        const QwtPlotItemList items = plot->intersectingItems( area, xAxis, yAxis );
+        for ( QwtPlotItemIterator it2 = items.begin(); it2 != items.end(); ++it2 )
+            hits += *it2;
+    }
+
+    QwtPlotItemList items;
+
+    for ( QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        QwtPlotItem* item = *it;
+        if ( !item->isVisible() )
+            continue;
+
+        if ( hits.contains( item )
+            || ( withMargins && item->testItemAttribute( QwtPlotItem::Margins ) ) )
+        {
+            items += item;
+        }
+    }
+
+    return items;
+}
+
 class QwtPlot::PrivateData
 {
   public:
+    QwtRenderStatistics* statistics( const QwtPlotItem* item )
+    {
+        if ( !hasRenderStatistics )
+            return NULL;
+
+        return &renderStatistics[ item ];
+    }
+
     QPointer< QwtTextLabel > titleLabel;
     QPointer< QwtTextLabel > footerLabel;
     QPointer< QWidget > canvas;
@@ -94,8 +297,284 @@ class QwtPlot::PrivateData
     QwtPlotLayout* layout;
 
     bool autoReplot;
+
+    bool asyncReplot;
+    bool replotPending;
+
+    bool parallelItemRendering;
+
+    QPointer< QwtPlotGroup > group;
+
+    // throttling of replot()
+    double maxReplotRate;
+    int replotTimerId;
+    QElapsedTimer lastReplot;
+
+    // reduced render quality while the user is interacting
+    QwtPlot::QualityReductions interactiveQuality;
+    int interactionIdleTime;
+    int interactionTimerId;
+    bool isInteracting;
+
+    // progressive rendering into the backing store of the canvas
+    int renderTimeBudget;
+    int progressTimerId;
+    int progressItem;
+    int progressSample;
+    const QwtPlotItem* progressKey;
+    QwtScaleMap progressMaps[ QwtAxis::AxisPositions ];
+    QRectF progressRect;
+
+    // skipping items outside of the canvas
+    bool itemCulling;
+    int itemCullingMargin;
+
+    // timings of the last draw of each item
+    bool hasRenderStatistics;
+    QHash< const QwtPlotItem*, QwtRenderStatistics > renderStatistics;
+
+    // items rendered by the ReplotScheduler, to be displayed
+    // with the next update of the canvas
+    QImage frame;
+    QRect frameRect;
+
+    // legend updates and replot, postponed until endUpdate()
+    QSet< const QwtPlotItem* > pendingLegendItems;
+    bool refreshPending;
+
+    // modifications since the axes have been updated
+    bool isAxesDirty;
+    QwtPlotItem::ChangeFlags itemChanges;
+
+    // replot() has been triggered by the plot itself
+    bool isScheduledReplot;
+
+    bool takeAxesUpdate()
+    {
+        // pure style changes of items do not affect the autoscaling
+        const bool doUpdate = isAxesDirty
+            || ( itemChanges != QwtPlotItem::StyleChange );
+
+        isAxesDirty = false;
+        itemChanges = QwtPlotItem::ChangeFlags();
+
+        return doUpdate;
+    }
+
+    // cached layers of static items
+    QVector< QwtPlotLayer > layers;
+    QwtLayerGeometry layerGeometry;
 };
 
+namespace
+{
+    class QwtPlotFrameJob
+    {
+      public:
+        const QwtPlot* plot;
+
+        QRect canvasRect;
+        QwtScaleMap maps[ QwtAxis::AxisPositions ];
+        qreal pixelRatio;
+
+        QImage image;
+    };
+}
+
+namespace
+{
+    class QwtPlotItemJob
+    {
+      public:
+        const QwtPlotItem* item;
+        QwtRenderStatistics* statistics;
+
+        QImage image;
+    };
+}
+
+static void qwtRenderItem( QwtPlotItemJob* job, const QRect& rect,
+    const QRectF& canvasRect, const QwtScaleMap* maps, qreal pixelRatio )
+{
+    job->image = QImage( rect.size() * pixelRatio,
+        QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+    job->image.setDevicePixelRatio( pixelRatio );
+#endif
+    job->image.fill( Qt::transparent );
+
+    QPainter painter( &job->image );
+    painter.translate( -rect.topLeft() );
+
+    qwtDrawItem( &painter, job->item, canvasRect, maps, job->statistics );
+
+    painter.end();
+
+    QwtScratchPool::trim();
+}
+
+static bool qwtIsParallelDevice( const QPainter* painter )
+{
+    // vector formats, like PDF or SVG, need to get the items unrastered
+
+    const QPaintDevice* device = painter->device();
+    if ( device == NULL )
+        return false;
+
+    switch( device->devType() )
+    {
+        case QInternal::Widget:
+        case QInternal::Image:
+        case QInternal::Pixmap:
+            break;
+        default:
+            return false;
+    }
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
+static void qwtRenderFrame( QwtPlotFrameJob* job )
+{
+    const QSize size = job->canvasRect.size() * job->pixelRatio;
+
+    job->image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+    job->image.setDevicePixelRatio( job->pixelRatio );
+#endif
+    job->image.fill( Qt::transparent );
+
+    QPainter painter( &job->image );
+    painter.translate( -job->canvasRect.topLeft() );
+
+    job->plot->drawItems( &painter, job->canvasRect, job->maps );
+}
+
+/*
+    Collects the replot requests of all plots in asyncReplot mode
+    and processes them together, when the event loop is entered again.
+ */
+class QwtPlot::ReplotScheduler : public QObject
+{
+  public:
+    static ReplotScheduler* instance()
+    {
+        static QPointer< ReplotScheduler > scheduler;
+        if ( scheduler.isNull() )
+            scheduler = new ReplotScheduler();
+
+        return scheduler;
+    }
+
+    void schedule( QwtPlot* plot )
+    {
+        if ( m_plots.isEmpty() )
+            QCoreApplication::postEvent( this, new QEvent( QEvent::User ) );
+
+        m_plots += plot;
+    }
+
+  protected:
+    virtual void customEvent( QEvent* ) QWT_OVERRIDE
+    {
+        QList< QwtPlot* > plots;
+        for ( int i = 0; i < m_plots.size(); i++ )
+        {
+            if ( m_plots[i] )
+                plots += m_plots[i];
+        }
+
+        m_plots.clear();
+
+        QwtPlot::renderFrames( plots );
+    }
+
+  private:
+    ReplotScheduler()
+        : QObject( QCoreApplication::instance() )
+    {
+    }
+
+    QList< QPointer< QwtPlot > > m_plots;
+};
+
+/*
+    Render the items of several plots in parallel and display them
+    together. Used for the asyncReplot mode and by QwtPlotGroup.
+ */
+void QwtPlot::renderFrames( const QList< QwtPlot* >& plots )
+{
+    QVector< QwtPlotFrameJob > jobs;
+    jobs.reserve( plots.size() );
+
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        QwtPlot* plot = plots[i];
+
+        plot->m_data->replotPending = false;
+
+        const bool doAutoReplot = plot->autoReplot();
+        plot->setAutoReplot( false );
+
+        if ( plot->m_data->takeAxesUpdate() )
+            plot->updateAxes();
+
+        QApplication::sendPostedEvents( plot, QEvent::LayoutRequest );
+
+        plot->setAutoReplot( doAutoReplot );
+
+        QWidget* canvas = plot->canvas();
+        if ( canvas == NULL || canvas->contentsRect().isEmpty() )
+        {
+            plot->m_data->frame = QImage();
+            continue;
+        }
+
+        QwtPlotFrameJob job;
+        job.plot = plot;
+        job.canvasRect = canvas->contentsRect();
+        job.pixelRatio = QwtPainter::devicePixelRatio( canvas );
+
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            job.maps[axisPos] = plot->canvasMap( axisPos );
+
+        jobs += job;
+    }
+
+    /*
+        The GUI thread waits for the frames, so that the plot items
+        can't be modified, while they are painted. The items of each
+        plot are painted in a thread of their own.
+     */
+
+#if !defined( QT_NO_QFUTURE )
+    QVector< QFuture< void > > futures;
+    futures.reserve( jobs.size() );
+
+    for ( int i = 1; i < jobs.size(); i++ )
+        futures += QtConcurrent::run( &qwtRenderFrame, &jobs[i] );
+
+    if ( !jobs.isEmpty() )
+        qwtRenderFrame( &jobs[0] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    for ( int i = 0; i < jobs.size(); i++ )
+        qwtRenderFrame( &jobs[i] );
+#endif
+
+    for ( int i = 0; i < jobs.size(); i++ )
+    {
+        QwtPlot* plot = const_cast< QwtPlot* >( jobs[i].plot );
+
+        plot->m_data->frame = jobs[i].image;
+        plot->m_data->frameRect = jobs[i].canvasRect;
+
+        plot->updateCanvas();
+    }
+}
+
 /*!
    \brief Constructor
    \param parent Parent widget
@@ -138,6 +617,25 @@ void QwtPlot::initPlot( const QwtText& title )
 
     m_data->layout = new QwtPlotLayout;
     m_data->autoReplot = false;
+    m_data->asyncReplot = false;
+    m_data->replotPending = false;
+    m_data->parallelItemRendering = false;
+    m_data->maxReplotRate = 0.0;
+    m_data->replotTimerId = 0;
+    m_data->interactionIdleTime = 300;
+    m_data->interactionTimerId = 0;
+    m_data->isInteracting = false;
+    m_data->renderTimeBudget = 0;
+    m_data->progressTimerId = 0;
+    m_data->progressItem = 0;
+    m_data->progressSample = 0;
+    m_data->progressKey = NULL;
+    m_data->itemCulling = false;
+    m_data->itemCullingMargin = 10;
+    m_data->hasRenderStatistics = false;
+    m_data->refreshPending = false;
+    m_data->isAxesDirty = true;
+    m_data->isScheduledReplot = false;
 
     // title
     m_data->titleLabel = new QwtTextLabel( this );
@@ -243,8 +741,36 @@ bool QwtPlot::event( QEvent* event )
             updateLayout();
             break;
         case QEvent::PolishRequest:
-            replot();
+            scheduledReplot();
+            break;
+        case QEvent::Timer:
+        {
+            const int timerId = static_cast< QTimerEvent* >( event )->timerId();
+
+            if ( timerId == m_data->replotTimerId )
+            {
+                killTimer( m_data->replotTimerId );
+                m_data->replotTimerId = 0;
+
+                // the delayed replot of the throttle
+                m_data->lastReplot.invalidate();
+                scheduledReplot();
+            }
+            else if ( timerId == m_data->interactionTimerId )
+            {
+                killTimer( m_data->interactionTimerId );
+                m_data->interactionTimerId = 0;
+
+                // the interaction is over: one replot in full quality
+                m_data->isInteracting = false;
+                scheduledReplot();
+            }
+            else if ( timerId == m_data->progressTimerId )
+            {
+                continueProgress();
+            }
             break;
+        }
         default:;
     }
     return ok;
@@ -285,11 +811,77 @@ bool QwtPlot::eventFilter( QObject* object, QEvent* event )
     return QFrame::eventFilter( object, event );
 }
 
-//! Replots the plot if autoReplot() is \c true.
+/*!
+   Replots the plot if autoReplot() is \c true.
+
+   Between beginUpdate() and endUpdate() the replot is postponed.
+   The axes are updated with the next replot.
+ */
 void QwtPlot::autoRefresh()
 {
+    m_data->isAxesDirty = true;
+
     if ( m_data->autoReplot )
-        replot();
+    {
+        if ( isUpdating() )
+            m_data->refreshPending = true;
+        else
+            scheduledReplot();
+    }
+}
+
+/*!
+   \brief Finish a sequence of modifications
+
+   When the outermost sequence has been finished the items are sorted,
+   the legend is updated for the items, that have been attached or
+   modified in between, and autoRefresh() is called once.
+
+   \code
+   plot->beginUpdate();
+
+   for ( int i = 0; i < 10000; i++ )
+   {
+       QwtPlotCurve* curve = new QwtPlotCurve();
+       curve->setSamples( ... );
+       curve->attach( plot );
+   }
+
+   plot->endUpdate();
+   \endcode
+
+   \sa QwtPlotDict::beginUpdate()
+ */
+void QwtPlot::endUpdate()
+{
+    QwtPlotDict::endUpdate();
+
+    if ( isUpdating() )
+        return;
+
+    if ( !m_data->pendingLegendItems.isEmpty() )
+    {
+        const QSet< const QwtPlotItem* > pending = m_data->pendingLegendItems;
+        m_data->pendingLegendItems.clear();
+
+        // in z order like updateLegend()
+        const QwtPlotItemList& itmList = itemList();
+        for ( QwtPlotItemIterator it = itmList.begin();
+            it != itmList.end(); ++it )
+        {
+            if ( pending.contains( *it ) )
+                updateLegend( *it );
+        }
+    }
+
+    if ( m_data->refreshPending )
+    {
+        m_data->refreshPending = false;
+
+        // modifications of the axes have already been recorded
+        if ( m_data->autoReplot )
+            scheduledReplot();
+    }
 }
 
 /*!
@@ -321,6 +913,453 @@ bool QwtPlot::autoReplot() const
     return m_data->autoReplot;
 }
 
+/*!
+   \brief En/Disable the asynchronous replot mode
+
+   In asyncReplot mode replot() doesn't update the plot immediately,
+   but schedules a replot, when the event loop is entered again.
+   All replot requests - f.e. of several setters in autoReplot mode -
+   are coalesced into one update.
+
+   The requests of all plots are processed together. The plot items
+   of each plot are rendered into an image in a thread of their own
+   ( see drawItems() ), that is painted to the canvas with its next
+   update. While rendering the GUI thread is waiting, so that the items
+   can't be modified meanwhile.
+
+   \param on On/Off
+   \sa asyncReplot(), replot(), setAutoReplot(), QwtPlotGroup
+
+   \note The items of different plots are painted in parallel, so they
+         have to be reentrant - like for QwtPlotItem::renderThreadCount().
+         Symbols ( QwtSymbol ) are painted without their pixmap cache
+         outside of the GUI thread.
+
+   \note Only the plot items are rendered asynchronously. When the plot
+         is painted for other reasons, like resizing the canvas, the
+         items are painted directly again.
+ */
+void QwtPlot::setAsyncReplot( bool on )
+{
+    m_data->asyncReplot = on;
+    if ( !on )
+        m_data->frame = QImage();
+}
+
+/*!
+   \return true if the asyncReplot mode is enabled
+   \sa setAsyncReplot()
+ */
+bool QwtPlot::asyncReplot() const
+{
+    return m_data->asyncReplot;
+}
+
+/*!
+   \brief En/Disable rendering the items of the plot in parallel
+
+   When enabled, drawItems() renders each visible item into a transparent
+   image of its own - all of them in parallel threads. The images are
+   composited in z order, so that the result is the same as painting
+   the items one after the other. The render hints of the items and the
+   clipping of the painter are applied as usual.
+
+   Items are rendered in parallel only, when painting to a widget,
+   an image or a pixmap without scaling or rotation. Painting to vector
+   formats - f.e. when exporting to PDF - is done in z order as before.
+
+   Parallel rendering pays off for plots with a couple of heavy items,
+   like spectrograms or long curves. For many light items the overhead
+   for allocating and compositing the images might be higher than the gain.
+
+   \param on On/Off
+   \sa parallelItemRendering(), drawItems(), setAsyncReplot()
+
+   \note Like for setAsyncReplot() the items have to be reentrant. Static
+         items, that are painted from cached layers, are not affected.
+
+   \warning Symbols ( QwtSymbol ) of items, that are rendered in a worker
+            thread, are painted without their pixmap cache - see
+            QwtSymbol::CachePolicy. For curves with many symbols this might
+            be slower than painting the items one after the other.
+ */
+void QwtPlot::setParallelItemRendering( bool on )
+{
+    m_data->parallelItemRendering = on;
+}
+
+/*!
+   \return true if items are rendered in parallel
+   \sa setParallelItemRendering()
+ */
+bool QwtPlot::parallelItemRendering() const
+{
+    return m_data->parallelItemRendering;
+}
+
+/*!
+   \brief Limit the rate of replots
+
+   When replot() is called more often than the rate allows,
+   the replot is delayed until the minimum interval since the
+   previous replot has elapsed. All calls in between are coalesced
+   into this delayed replot, so the last call is always delivered.
+
+   This is useful, when the data arrives at rates much higher,
+   than the frames, that can be displayed or noticed by the user.
+   It applies to all types of canvases and to the asyncReplot mode.
+   While a delayed replot is pending QwtPlotDirectPainter doesn't
+   paint incrementally, as the samples will be painted with the replot.
+
+   \param fps Maximum number of replots per second. A value <= 0.0
+              disables the throttle, what is the default setting.
+
+   \sa maxReplotRate(), replot(), isReplotPending()
+ */
+void QwtPlot::setMaxReplotRate( double fps )
+{
+    m_data->maxReplotRate = qwtMaxF( fps, 0.0 );
+
+    if ( m_data->maxReplotRate == 0.0 && m_data->replotTimerId != 0 )
+    {
+        killTimer( m_data->replotTimerId );
+        m_data->replotTimerId = 0;
+
+        scheduledReplot();
+    }
+}
+
+/*!
+   \return Maximum number of replots per second
+   \sa setMaxReplotRate()
+ */
+double QwtPlot::maxReplotRate() const
+{
+    return m_data->maxReplotRate;
+}
+
+/*!
+   \brief Reduce the render quality while the user is interacting
+
+   Panning or zooming a plot with many samples or large raster items
+   results in a series of replots, where each of them is noticed for
+   a moment only. Reducing the quality of these replots often makes
+   the difference between a fluent and a sluggish interaction.
+
+   When the plot gets notified about an interaction, the reductions
+   are applied until no further notification arrives for
+   interactionIdleTime() milliseconds. Then the plot is replotted once
+   in full quality. QwtPlotPanner, QwtPlotMagnifier and QwtPlotZoomer
+   notify the plot, other interactive objects can call notifyInteraction().
+
+   The default setting is no reductions, what disables this mechanism.
+
+   \param reductions Reductions of the render quality
+   \sa interactiveQuality(), testQualityReduction(), setInteractionIdleTime()
+ */
+void QwtPlot::setInteractiveQuality( QualityReductions reductions )
+{
+    if ( reductions == m_data->interactiveQuality )
+        return;
+
+    m_data->interactiveQuality = reductions;
+
+    if ( m_data->isInteracting )
+        scheduledReplot();
+}
+
+/*!
+   \return Reductions of the render quality while the user is interacting
+   \sa setInteractiveQuality()
+ */
+QwtPlot::QualityReductions QwtPlot::interactiveQuality() const
+{
+    return m_data->interactiveQuality;
+}
+
+/*!
+   \brief Set the time without interaction, before the plot
+          is replotted in full quality
+
+   \param msec Idle time in milliseconds. The default setting is 300 ms.
+   \sa interactionIdleTime(), setInteractiveQuality()
+ */
+void QwtPlot::setInteractionIdleTime( int msec )
+{
+    m_data->interactionIdleTime = qMax( msec, 0 );
+}
+
+/*!
+   \return Time without interaction, before the plot is replotted in full quality
+   \sa setInteractionIdleTime()
+ */
+int QwtPlot::interactionIdleTime() const
+{
+    return m_data->interactionIdleTime;
+}
+
+/*!
+   \return true, when the plot has been notified about an interaction and
+           the idle time has not elapsed yet
+   \sa notifyInteraction(), testQualityReduction()
+ */
+bool QwtPlot::isInteracting() const
+{
+    return m_data->isInteracting;
+}
+
+/*!
+   \return true, when the render quality has to be reduced
+           according to a specific reduction
+
+   Plot items check the reductions, when being painted.
+
+   \param reduction Reduction to be tested
+   \sa setInteractiveQuality(), isInteracting()
+ */
+bool QwtPlot::testQualityReduction( QualityReduction reduction ) const
+{
+    return m_data->isInteracting && ( m_data->interactiveQuality & reduction );
+}
+
+/*!
+   \brief Notify the plot, that the user is interacting
+
+   Starts or extends the period of reduced render quality.
+   Needs to be called before the replot, that is triggered
+   by the interaction.
+
+   \sa setInteractiveQuality(), isInteracting()
+ */
+void QwtPlot::notifyInteraction()
+{
+    if ( m_data->interactiveQuality == 0 )
+        return;
+
+    if ( m_data->interactionTimerId != 0 )
+        killTimer( m_data->interactionTimerId );
+
+    m_data->isInteracting = true;
+    m_data->interactionTimerId = startTimer( m_data->interactionIdleTime );
+}
+
+/*!
+   \brief Render large series progressively
+
+   Painting series with millions of samples blocks the user interface,
+   until all samples have been processed. With a render time budget
+   the samples are painted in chunks ( see QwtPlotSeriesItem::drawProgressively() )
+   to the backing store of the canvas, until the budget is exhausted.
+   The canvas is updated with what has been painted so far and
+   painting continues in following iterations of the event loop.
+
+   Painting continues where it has stopped, so that the items
+   keep their z order. It is cancelled, when the scales or the
+   geometry of the canvas have been changed or an item has been
+   attached/detached in the meantime - usually followed by a replot,
+   that starts over.
+
+   Progressive rendering requires a QwtPlotCanvas with
+   QwtPlotCanvas::BackingStore. It is not done for plots with
+   QwtPlotItem::Static items or in asyncReplot() mode and takes
+   precedence over parallelItemRendering().
+
+   \param msec Time budget for each iteration in milliseconds.
+               0 disables progressive rendering, what is the default setting.
+
+   \sa renderTimeBudget(), isRenderInProgress()
+ */
+void QwtPlot::setRenderTimeBudget( int msec )
+{
+    msec = qMax( msec, 0 );
+    if ( msec == m_data->renderTimeBudget )
+        return;
+
+    m_data->renderTimeBudget = msec;
+
+    if ( msec == 0 && isRenderInProgress() )
+    {
+        cancelProgress();
+        scheduledReplot();
+    }
+}
+
+/*!
+   \return Time budget for each iteration of progressive rendering
+   \sa setRenderTimeBudget()
+ */
+int QwtPlot::renderTimeBudget() const
+{
+    return m_data->renderTimeBudget;
+}
+
+/*!
+   \return true, when progressive rendering has not been completed yet
+   \sa setRenderTimeBudget()
+ */
+bool QwtPlot::isRenderInProgress() const
+{
+    return m_data->progressTimerId != 0;
+}
+
+/*!
+   \brief En/Disable skipping items outside of the canvas
+
+   Usually each item finds out on its own, when it is outside of the canvas.
+   For plots with thousands of items ( f.e. shapes or markers ) it is
+   more efficient to find the items intersecting with the canvas from
+   the index of QwtPlotDict. Items, that are not found, are not painted.
+
+   Items are expected to paint inside of their bounding rectangles, expanded
+   by itemCullingMargin(). Items with QwtPlotItem::Margins are always painted.
+   Items, that change their bounding rectangles without notification
+   ( f.e. curves with raw samples ), need to call QwtPlotItem::itemChanged().
+
+   Culling is disabled by default.
+
+   \param on On/Off
+   \sa itemCulling(), setItemCullingMargin(), QwtPlotDict::intersectingItems()
+ */
+void QwtPlot::setItemCulling( bool on )
+{
+    m_data->itemCulling = on;
+}
+
+/*!
+   \return true, when items outside of the canvas are skipped
+   \sa setItemCulling()
+ */
+bool QwtPlot::itemCulling() const
+{
+    return m_data->itemCulling;
+}
+
+/*!
+   \brief Set the margin for pens or symbols painted outside of the
+          bounding rectangles of the items
+
+   \param pixels Margin in paint device coordinates. The default setting is 10.
+   \sa itemCullingMargin(), setItemCulling()
+ */
+void QwtPlot::setItemCullingMargin( int pixels )
+{
+    m_data->itemCullingMargin = qMax( pixels, 0 );
+}
+
+/*!
+   \return Margin for pens or symbols painted outside of the
+           bounding rectangles of the items
+   \sa setItemCullingMargin()
+ */
+int QwtPlot::itemCullingMargin() const
+{
+    return m_data->itemCullingMargin;
+}
+
+/*!
+   \brief Find the visible items, whose bounding rectangles are close to a position
+
+   The items are found from the index of QwtPlotDict - like it is done
+   for culling - and can be used by pickers for finding the candidates
+   under the cursor, before doing more precise hit tests.
+
+   \param pos Position in canvas coordinates
+   \param tolerance Maximum distance in canvas coordinates
+
+   \return Visible items in increasing z order, the topmost item is the last one
+   \sa QwtPlotDict::intersectingItems(), setItemCulling()
+ */
+QwtPlotItemList QwtPlot::itemsAt( const QPointF& pos, double tolerance ) const
+{
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        maps[axisPos] = canvasMap( axisPos );
+
+    const double t = qAbs( tolerance );
+    const QRectF rect( pos.x() - t, pos.y() - t, 2 * t, 2 * t );
+
+    return qwtItemsInRect( this, rect, maps, false );
+}
+
+QwtPlotItemList QwtPlot::culledItems( const QRectF& canvasRect,
+    const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const
+{
+    if ( !m_data->itemCulling )
+        return itemList();
+
+    const double m = m_data->itemCullingMargin;
+    return qwtItemsInRect( this, canvasRect.adjusted( -m, -m, m, m ), maps, true );
+}
+
+/*!
+   \brief En/Disable recording the render statistics of the plot items
+
+   When enabled the time spent in QwtPlotItem::draw() - and in mapping,
+   clipping and rendering images inside of it - and the number of
+   mapped samples is recorded each time an item is painted.
+   The statistics can be inspected with renderStatistics().
+
+   Recording has a small overhead and is disabled by default.
+
+   \param on On/Off
+   \sa renderStatistics(), QwtRenderStatistics
+ */
+void QwtPlot::setRenderStatisticsEnabled( bool on )
+{
+    m_data->hasRenderStatistics = on;
+    if ( !on )
+        m_data->renderStatistics.clear();
+}
+
+/*!
+   \return true, when recording render statistics is enabled
+   \sa setRenderStatisticsEnabled()
+ */
+bool QwtPlot::isRenderStatisticsEnabled() const
+{
+    return m_data->hasRenderStatistics;
+}
+
+/*!
+   \param item Plot item
+   \return Statistics of the last time the item has been painted
+
+   \sa setRenderStatisticsEnabled()
+   \note The statistics are updated, when the item is painted - what
+         might be in a worker thread in asyncReplot mode.
+ */
+QwtRenderStatistics QwtPlot::renderStatistics( const QwtPlotItem* item ) const
+{
+    return m_data->renderStatistics.value( item );
+}
+
+/*!
+   \return true, when a replot has been requested, but has not been done yet
+   \sa setMaxReplotRate(), setAsyncReplot(), QwtPlotGroup
+ */
+bool QwtPlot::isReplotPending() const
+{
+    return m_data->replotPending || ( m_data->replotTimerId != 0 );
+}
+
+/*!
+   \return Group the plot is member of, or NULL
+   \sa QwtPlotGroup::addPlot()
+ */
+QwtPlotGroup* QwtPlot::plotGroup() const
+{
+    return m_data->group;
+}
+
+void QwtPlot::setPlotGroup( QwtPlotGroup* group )
+{
+    m_data->group = group;
+    m_data->replotPending = false;
+
+    if ( group == NULL && !m_data->asyncReplot )
+        m_data->frame = QImage();
+}
+
 /*!
    Change the plot's title
    \param title New title
@@ -540,14 +1579,74 @@ void QwtPlot::resizeEvent( QResizeEvent* e )
    or if any curves are attached to raw data, the plot has to
    be refreshed explicitly in order to make changes visible.
 
-   \sa updateAxes(), setAutoReplot()
+   In asyncReplot() mode the replot is scheduled for the next cycle
+   of the event loop. When the plot is member of a QwtPlotGroup
+   the replot is scheduled for the next frame of the group.
+   With a maxReplotRate() calls, that are too frequent, are delayed.
+
+   An explicit call of replot() always updates the axes, so that
+   samples, that have been modified in place - f.e. through
+   QwtSeriesStore::data() without calling QwtPlotItem::itemChanged() -
+   are taken into account for autoscaling. Only replots, that are
+   triggered by the plot itself - f.e. by autoReplot() - skip
+   updateAxes(), when all modifications of the items since the
+   previous replot have been pure style changes.
+
+   \sa updateAxes(), setAutoReplot(), setAsyncReplot(), plotGroup(),
+       setMaxReplotRate()
  */
 void QwtPlot::replot()
 {
+    if ( !m_data->isScheduledReplot )
+        m_data->isAxesDirty = true;
+
+    if ( m_data->maxReplotRate > 0.0 )
+    {
+        if ( m_data->replotTimerId != 0 )
+            return; // a delayed replot is already pending
+
+        const double interval = 1000.0 / m_data->maxReplotRate;
+
+        if ( m_data->lastReplot.isValid() )
+        {
+            const double elapsed = m_data->lastReplot.elapsed();
+            if ( elapsed < interval )
+            {
+                m_data->replotTimerId = startTimer( qwtCeil( interval - elapsed ) );
+                return;
+            }
+        }
+
+        m_data->lastReplot.start();
+    }
+
+    if ( m_data->group )
+    {
+        if ( !m_data->replotPending )
+        {
+            m_data->replotPending = true;
+            m_data->group->scheduleReplot( this );
+        }
+
+        return;
+    }
+
+    if ( m_data->asyncReplot )
+    {
+        if ( !m_data->replotPending )
+        {
+            m_data->replotPending = true;
+            ReplotScheduler::instance()->schedule( this );
+        }
+
+        return;
+    }
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
-    updateAxes();
+    if ( m_data->takeAxesUpdate() )
+        updateAxes();
 
     /*
        Maybe the layout needs to be updated, because of changed
@@ -556,6 +1655,24 @@ void QwtPlot::replot()
      */
     QApplication::sendPostedEvents( this, QEvent::LayoutRequest );
 
+    updateCanvas();
+
+    setAutoReplot( doAutoReplot );
+}
+
+/*
+    A replot, that has not been requested by the application:
+    updating the axes can be skipped after pure style changes.
+ */
+void QwtPlot::scheduledReplot()
+{
+    m_data->isScheduledReplot = true;
+    replot();
+    m_data->isScheduledReplot = false;
+}
+
+void QwtPlot::updateCanvas()
+{
     if ( m_data->canvas )
     {
         const bool ok = QMetaObject::invokeMethod(
@@ -566,8 +1683,6 @@ void QwtPlot::replot()
             m_data->canvas->update( m_data->canvas->contentsRect() );
         }
     }
-
-    setAutoReplot( doAutoReplot );
 }
 
 /*!
@@ -737,15 +1852,287 @@ void QwtPlot::updateCanvasMargins()
    \warning drawCanvas calls drawItems what is also used
            for printing. Applications that like to add individual
            plot items better overload drawItems()
+
+   \note When items with the QwtPlotItem::Static attribute are attached,
+         the items are painted in layers instead of calling drawItems().
+         Neighboured static items are cached in a layer, that is only
+         painted again, when one of its items has changed.
+
    \sa drawItems()
  */
 void QwtPlot::drawCanvas( QPainter* painter )
 {
+    cancelProgress();
+
+    if ( !m_data->frame.isNull() )
+    {
+        // items, that have been rendered in asyncReplot mode
+
+        const QImage frame = m_data->frame;
+        m_data->frame = QImage();
+
+        if ( m_data->frameRect == m_data->canvas->contentsRect() )
+        {
+            painter->drawImage( m_data->frameRect.topLeft(), frame );
+            return;
+        }
+    }
+
     QwtScaleMap maps[ QwtAxis::AxisPositions ];
     for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
         maps[axisPos] = canvasMap( axisPos );
 
-    drawItems( painter, m_data->canvas->contentsRect(), maps );
+    const QRectF canvasRect = m_data->canvas->contentsRect();
+
+    bool hasStaticItems = false;
+
+    const QwtPlotItemList& itmList = itemList();
+    for ( QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+        if ( item->isVisible() && item->testItemAttribute( QwtPlotItem::Static ) )
+        {
+            hasStaticItems = true;
+            break;
+        }
+    }
+
+    if ( hasStaticItems && painter->transform().isIdentity() )
+    {
+        drawLayers( painter, canvasRect, maps );
+    }
+    else
+    {
+        m_data->layers.clear();
+
+        if ( m_data->renderTimeBudget > 0 && painter->transform().isIdentity()
+            && qwtPaintsBackingStore( m_data->canvas, painter ) )
+        {
+            m_data->progressItem = 0;
+            m_data->progressSample = 0;
+            m_data->progressRect = canvasRect;
+
+            for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+                m_data->progressMaps[axisPos] = maps[axisPos];
+
+            if ( !drawProgress( painter, canvasRect, maps ) )
+                m_data->progressTimerId = startTimer( 0 );
+        }
+        else
+        {
+            drawItems( painter, canvasRect, maps );
+        }
+    }
+}
+
+/*
+    Paint the items from where progressive rendering has stopped,
+    until the time budget is exhausted. Returns true, when all items
+    have been painted.
+ */
+bool QwtPlot::drawProgress( QPainter* painter, const QRectF& canvasRect,
+    const QwtScaleMap maps[ QwtAxis::AxisPositions ] )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QwtPlotItemList& itmList = itemList();
+
+    while ( m_data->progressItem < itmList.size() )
+    {
+        const QwtPlotItem* item = itmList[ m_data->progressItem ];
+
+        if ( item->isVisible() )
+        {
+            const QwtPlotSeriesItem* seriesItem =
+                dynamic_cast< const QwtPlotSeriesItem* >( item );
+
+            if ( seriesItem )
+            {
+                painter->save();
+                qwtSetRenderHints( painter, item );
+
+                m_data->progressSample = seriesItem->drawProgressively( painter,
+                    maps[ item->xAxis() ], maps[ item->yAxis() ], canvasRect,
+                    m_data->progressSample, timer, m_data->renderTimeBudget );
+
+                painter->restore();
+
+                if ( m_data->progressSample >= 0 )
+                {
+                    m_data->progressKey = item;
+                    return false;
+                }
+            }
+            else
+            {
+                qwtDrawItem( painter, item, canvasRect, maps,
+                    m_data->statistics( item ) );
+            }
+        }
+
+        m_data->progressItem++;
+        m_data->progressSample = 0;
+
+        if ( m_data->progressItem < itmList.size()
+            && timer.hasExpired( m_data->renderTimeBudget ) )
+        {
+            m_data->progressKey = itmList[ m_data->progressItem ];
+            return false;
+        }
+    }
+
+    QwtScratchPool::trim();
+    return true;
+}
+
+// continue progressive rendering in the backing store of the canvas
+void QwtPlot::continueProgress()
+{
+    QwtPlotCanvas* canvas = qobject_cast< QwtPlotCanvas* >( m_data->canvas );
+
+    bool isValid = canvas && canvas->backingStore()
+        && !canvas->backingStore()->isNull()
+        && QRectF( canvas->contentsRect() ) == m_data->progressRect
+        && itemList().value( m_data->progressItem ) == m_data->progressKey;
+
+    for ( int axisPos = 0; isValid && axisPos < QwtAxis::AxisPositions; axisPos++ )
+        isValid = qwtIsSameMap( canvasMap( axisPos ), m_data->progressMaps[axisPos] );
+
+    if ( !isValid )
+    {
+        cancelProgress();
+        return;
+    }
+
+    QPainter painter( const_cast< QPixmap* >( canvas->backingStore() ) );
+    painter.setClipRect( m_data->progressRect );
+
+    const bool done = drawProgress( &painter,
+        m_data->progressRect, m_data->progressMaps );
+
+    painter.end();
+
+    if ( done )
+        cancelProgress();
+
+    canvas->update( canvas->contentsRect() );
+}
+
+void QwtPlot::cancelProgress()
+{
+    if ( m_data->progressTimerId != 0 )
+    {
+        killTimer( m_data->progressTimerId );
+        m_data->progressTimerId = 0;
+    }
+}
+
+/*!
+   Paint the items in layers
+
+   Neighboured static items are painted from a cached image, that
+   is updated, when one of its items has been changed, or the
+   geometry has been modified. All other items are painted directly.
+
+   \param painter Painter
+   \param canvasRect Contents rectangle of the canvas
+   \param maps Maps, mapping between plot and paint device coordinates
+ */
+void QwtPlot::drawLayers( QPainter* painter, const QRectF& canvasRect,
+    const QwtScaleMap maps[ QwtAxis::AxisPositions ] )
+{
+    QwtLayerGeometry geometry;
+    geometry.canvasRect = canvasRect;
+    geometry.pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        const QwtScaleMap& map = maps[axisPos];
+
+        geometry.scaleDivs[axisPos] = axisScaleDiv( axisPos );
+        geometry.p1[axisPos] = map.p1();
+        geometry.p2[axisPos] = map.p2();
+
+        if ( map.transformation() )
+        {
+            geometry.transformations[axisPos] = &typeid( *map.transformation() );
+
+            const QwtPowerTransform* powerTransform =
+                dynamic_cast< const QwtPowerTransform* >( map.transformation() );
+
+            if ( powerTransform )
+                geometry.exponents[axisPos] = powerTransform->exponent();
+        }
+    }
+
+    if ( geometry != m_data->layerGeometry )
+    {
+        m_data->layers.clear();
+        m_data->layerGeometry = geometry;
+    }
+
+    const QRect rect = canvasRect.toAlignedRect();
+    const QSize imageSize = rect.size() * geometry.pixelRatio;
+
+    QVector< QwtPlotLayer >& layers = m_data->layers;
+    int layerIndex = 0;
+
+    QList< const QwtPlotItem* > staticItems;
+
+    const QwtPlotItemList& itmList = itemList();
+    for ( int i = 0; i <= itmList.size(); i++ )
+    {
+        const QwtPlotItem* item = ( i < itmList.size() ) ? itmList[i] : NULL;
+
+        if ( item && !item->isVisible() )
+            continue;
+
+        if ( item && item->testItemAttribute( QwtPlotItem::Static ) )
+        {
+            staticItems += item;
+            continue;
+        }
+
+        if ( !staticItems.isEmpty() )
+        {
+            if ( layerIndex >= layers.size() )
+                layers.resize( layerIndex + 1 );
+
+            QwtPlotLayer& layer = layers[layerIndex++];
+
+            if ( layer.isDirty || layer.items != staticItems
+                || layer.image.size() != imageSize )
+            {
+                layer.items = staticItems;
+                layer.isDirty = false;
+
+                layer.image = QImage( imageSize, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+                layer.image.setDevicePixelRatio( geometry.pixelRatio );
+#endif
+                layer.image.fill( Qt::transparent );
+
+                QPainter layerPainter( &layer.image );
+                layerPainter.translate( -rect.topLeft() );
+
+                for ( int j = 0; j < staticItems.size(); j++ )
+                {
+                    qwtDrawItem( &layerPainter, staticItems[j], canvasRect, maps,
+                        m_data->statistics( staticItems[j] ) );
+                }
+            }
+
+            painter->drawImage( rect.topLeft(), layer.image );
+
+            staticItems.clear();
+        }
+
+        if ( item )
+            qwtDrawItem( painter, item, canvasRect, maps, m_data->statistics( item ) );
+    }
+
+    layers.resize( layerIndex );
 }
 
 /*!
@@ -764,30 +2151,202 @@ void QwtPlot::drawCanvas( QPainter* painter )
 void QwtPlot::drawItems( QPainter* painter, const QRectF& canvasRect,
     const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const
 {
-    const QwtPlotItemList& itmList = itemList();
+    if ( m_data->parallelItemRendering
+        && drawItemsParallel( painter, canvasRect, maps ) )
+    {
+        return;
+    }
+
+    const QwtPlotItemList itmList = culledItems( canvasRect, maps );
     for ( QwtPlotItemIterator it = itmList.begin();
         it != itmList.end(); ++it )
     {
         QwtPlotItem* item = *it;
+        if ( item && item->isVisible() )
+            qwtDrawItem( painter, item, canvasRect, maps, m_data->statistics( item ) );
+    }
+
+    // keeping the scratch buffers for the next replot
+    QwtScratchPool::trim();
+}
+
+/*!
+   \brief Record the paint commands of the items on the canvas
+
+   The items are painted like in drawCanvas() - but without the caches
+   of the layers, the asyncReplot() frames or rendering in parallel - to
+   a QwtGraphic, that records the command stream of the paint engine.
+   The graphic can be replayed later to different paint devices, f.e.
+   for profiling the paint engines without the application.
+
+   \return Recorded paint commands in canvas coordinates
+   \sa saveRenderTrace(), QwtGraphic::render()
+ */
+QwtGraphic QwtPlot::renderTrace() const
+{
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        maps[axisPos] = canvasMap( axisPos );
+
+    QwtGraphic graphic;
+    graphic.setDefaultSize( m_data->canvas->size() );
+
+    QPainter painter( &graphic );
+    drawItems( &painter, m_data->canvas->contentsRect(), maps );
+    painter.end();
+
+    return graphic;
+}
+
+/*!
+   \brief Record the paint commands of the items and write them to a file
+
+   The file can be loaded by QwtGraphic::load() and replayed by
+   QwtGraphic::render(), like it is done by the replay benchmark
+   of the Qwt tests.
+
+   \param fileName Name of the file
+   \return true, when the file could be written
+   \sa renderTrace(), QwtGraphic::save()
+ */
+bool QwtPlot::saveRenderTrace( const QString& fileName ) const
+{
+    return renderTrace().save( fileName );
+}
+
+/*!
+   Render the items in parallel and composite them in z order
+
+   \param painter Painter used for drawing
+   \param canvasRect Bounding rectangle where to paint
+   \param maps Maps, mapping between plot and paint device coordinates
+
+   \return false, when the items have not been painted, because
+           the paint device does not allow to rasterize them
+   \sa setParallelItemRendering()
+ */
+bool QwtPlot::drawItemsParallel( QPainter* painter, const QRectF& canvasRect,
+    const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const
+{
+#if !defined( QT_NO_QFUTURE )
+    if ( !qwtIsParallelDevice( painter ) )
+        return false;
+
+    QVector< QwtPlotItemJob > jobs;
+
+    const QwtPlotItemList itmList = culledItems( canvasRect, maps );
+    for ( QwtPlotItemIterator it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
         if ( item && item->isVisible() )
         {
-            const QwtAxisId xAxis = item->xAxis();
-            const QwtAxisId yAxis = item->yAxis();
+            QwtPlotItemJob job;
+            job.item = item;
+            job.statistics = m_data->statistics( item );
+
+            jobs += job;
+        }
+    }
 
-            painter->save();
+    if ( jobs.size() < 2 )
+        return false;
 
-            painter->setRenderHint( QPainter::Antialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    const QRect rect = canvasRect.toAlignedRect();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
 
-#if QT_VERSION < 0x050100
-            painter->setRenderHint( QPainter::HighQualityAntialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    /*
+        The statistics have been allocated before, so that
+        the threads do not modify the hash table. The calling thread
+        waits for the images, so that the items can't be modified,
+        while they are painted.
+     */
+
+    QVector< QFuture< void > > futures;
+    futures.reserve( jobs.size() - 1 );
+
+    for ( int i = 1; i < jobs.size(); i++ )
+    {
+        futures += QtConcurrent::run( &qwtRenderItem,
+            &jobs[i], rect, canvasRect, maps, pixelRatio );
+    }
+
+    qwtRenderItem( &jobs[0], rect, canvasRect, maps, pixelRatio );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+
+    for ( int i = 0; i < jobs.size(); i++ )
+        painter->drawImage( rect.topLeft(), jobs[i].image );
+
+    return true;
+#else
+    Q_UNUSED( painter )
+    Q_UNUSED( canvasRect )
+    Q_UNUSED( maps )
+
+    return false;
 #endif
+}
+
+/*!
+   Handle a modification of an item
 
-            item->draw( painter, maps[xAxis], maps[yAxis], canvasRect );
+   The cached layer of the item is invalidated - unless it has only been
+   shown or hidden, what is detected from the composition of the layers.
+   The axes are not updated by the next automatic replot, when all
+   modifications since the previous replot have been pure style changes.
+   An explicit replot() always updates the axes.
 
-            painter->restore();
-        }
+   \param item Plot item, that has been changed
+   \param flags Kind of the modification
+
+   \sa QwtPlotItem::itemChanged(), autoRefresh()
+ */
+void QwtPlot::itemChanged( const QwtPlotItem* item,
+    QwtPlotItem::ChangeFlags flags )
+{
+    if ( flags != QwtPlotItem::VisibilityChange )
+        invalidateLayer( item );
+
+    if ( flags & ( QwtPlotItem::DataChange | QwtPlotItem::GeometryChange ) )
+        invalidateItemIndex();
+
+    m_data->itemChanges |= flags;
+
+    if ( m_data->autoReplot )
+    {
+        if ( isUpdating() )
+            m_data->refreshPending = true;
+        else
+            scheduledReplot();
+    }
+}
+
+/*!
+   Discard the cached layers of all static items
+
+   The parameters of other transformations than QwtPowerTransform
+   are unknown, so the layers are discarded whenever a scale engine
+   - and its transformation - is replaced.
+
+   \sa setAxisScaleEngine()
+ */
+void QwtPlot::invalidateLayers()
+{
+    m_data->layers.clear();
+}
+
+/*!
+   Mark the cached layer of an item as invalid
+   \param item Plot item, that has been changed
+ */
+void QwtPlot::invalidateLayer( const QwtPlotItem* item )
+{
+    QVector< QwtPlotLayer >& layers = m_data->layers;
+    for ( int i = 0; i < layers.size(); i++ )
+    {
+        if ( layers[i].items.contains( item ) )
+            layers[i].isDirty = true;
     }
 }
 
@@ -1026,6 +2585,8 @@ void QwtPlot::updateLegend()
 /*!
    Emit legendDataChanged() for a plot item
 
+   Between beginUpdate() and endUpdate() the signal is postponed.
+
    \param plotItem Plot item
    \sa QwtPlotItem::legendData(), legendDataChanged()
  */
@@ -1034,6 +2595,12 @@ void QwtPlot::updateLegend( const QwtPlotItem* plotItem )
     if ( plotItem == NULL )
         return;
 
+    if ( isUpdating() )
+    {
+        m_data->pendingLegendItems.insert( plotItem );
+        return;
+    }
+
     QList< QwtLegendData > legendData;
 
     if ( plotItem->testItemAttribute( QwtPlotItem::Legend ) )
@@ -1080,6 +2647,10 @@ void QwtPlot::updateLegendItems( const QVariant& itemInfo,
  */
 void QwtPlot::attachItem( QwtPlotItem* plotItem, bool on )
 {
+    // the address of a deleted item might be reused
+    m_data->layers.clear();
+    m_data->renderStatistics.remove( plotItem );
+
     if ( plotItem->testItemInterest( QwtPlotItem::LegendInterest ) )
     {
         // plotItem is some sort of legend
@@ -1116,6 +2687,9 @@ void QwtPlot::attachItem( QwtPlotItem* plotItem, bool on )
         }
         else
         {
+            // the item might be deleted before endUpdate()
+            m_data->pendingLegendItems.remove( plotItem );
+
             const QVariant itemInfo = itemToInfo( plotItem );
             Q_EMIT legendDataChanged( itemInfo, QList< QwtLegendData >() );
         }
@@ -24,6 +24,9 @@ class QwtScaleDiv;
 class QwtScaleMap;
 class QwtScaleDraw;
 class QwtTextLabel;
+class QwtPlotGroup;
+class QwtRenderStatistics;
+class QwtGraphic;
 class QwtInterval;
 class QwtText;
 template< typename T > class QList;
@@ -83,6 +86,10 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
         READ canvasBackground WRITE setCanvasBackground )
 
     Q_PROPERTY( bool autoReplot READ autoReplot WRITE setAutoReplot )
+    Q_PROPERTY( bool asyncReplot READ asyncReplot WRITE setAsyncReplot )
+    Q_PROPERTY( bool parallelItemRendering
+        READ parallelItemRendering WRITE setParallelItemRendering )
+    Q_PROPERTY( double maxReplotRate READ maxReplotRate WRITE setMaxReplotRate )
 
   public:
     /*!
@@ -105,6 +112,49 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
         TopLegend
     };
 
+    /*!
+        Reductions of the render quality, that are applied while
+        the user is interacting with the plot.
+
+        \sa setInteractiveQuality(), notifyInteraction()
+     */
+    enum QualityReduction
+    {
+        //! QwtPlotItem::RenderAntialiased is ignored
+        NoAntialiasing = 0x01,
+
+        //! Curves filter their points like with QwtPlotCurve::FilterPointsAggressive
+        AggressiveFiltering = 0x02,
+
+        //! Raster items are rendered with a coarser resolution
+        CoarseRasters = 0x04,
+
+        //! Contour lines of spectrograms are not painted
+        NoContours = 0x08
+    };
+
+    Q_DECLARE_FLAGS( QualityReductions, QualityReduction )
+
+    /*!
+        Range of the samples, that is used for autoscaling a y axis
+
+        \sa setAxisAutoScaleMode(), setAxisAutoScale()
+     */
+    enum AutoScaleMode
+    {
+        //! The bounding rectangles of the items
+        FitAll,
+
+        /*!
+           The y coordinates of the samples inside the scale interval
+           of the x axis. Only items with QPointF samples support
+           this mode, for all others the bounding rectangle is used.
+
+           \sa qwtSeriesStatistics()
+         */
+        FitVisible
+    };
+
     explicit QwtPlot( QWidget* = NULL );
     explicit QwtPlot( const QwtText& title, QWidget* = NULL );
 
@@ -113,6 +163,48 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     void setAutoReplot( bool = true );
     bool autoReplot() const;
 
+    void setAsyncReplot( bool on );
+    bool asyncReplot() const;
+
+    void setParallelItemRendering( bool on );
+    bool parallelItemRendering() const;
+
+    void setMaxReplotRate( double fps );
+    double maxReplotRate() const;
+
+    void setInteractiveQuality( QualityReductions );
+    QualityReductions interactiveQuality() const;
+
+    void setInteractionIdleTime( int msec );
+    int interactionIdleTime() const;
+
+    bool isInteracting() const;
+    bool testQualityReduction( QualityReduction ) const;
+
+    void setRenderTimeBudget( int msec );
+    int renderTimeBudget() const;
+
+    bool isRenderInProgress() const;
+
+    void setItemCulling( bool on );
+    bool itemCulling() const;
+
+    void setItemCullingMargin( int pixels );
+    int itemCullingMargin() const;
+
+    QwtPlotItemList itemsAt( const QPointF& pos, double tolerance = 0.0 ) const;
+
+    virtual void endUpdate() QWT_OVERRIDE;
+
+    bool isReplotPending() const;
+
+    void setRenderStatisticsEnabled( bool );
+    bool isRenderStatisticsEnabled() const;
+
+    QwtRenderStatistics renderStatistics( const QwtPlotItem* ) const;
+
+    QwtPlotGroup* plotGroup() const;
+
     // Layout
 
     void setPlotLayout( QwtPlotLayout* );
@@ -169,6 +261,12 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     void setAxisAutoScale( QwtAxisId, bool on = true );
     bool axisAutoScale( QwtAxisId ) const;
 
+    void setAxisAutoScaleHysteresis( QwtAxisId, double hysteresis );
+    double axisAutoScaleHysteresis( QwtAxisId ) const;
+
+    void setAxisAutoScaleMode( QwtAxisId, AutoScaleMode );
+    AutoScaleMode axisAutoScaleMode( QwtAxisId ) const;
+
     void setAxisFont( QwtAxisId, const QFont& );
     QFont axisFont( QwtAxisId ) const;
 
@@ -218,6 +316,9 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     virtual void updateLayout();
     virtual void drawCanvas( QPainter* );
 
+    QwtGraphic renderTrace() const;
+    bool saveRenderTrace( const QString& fileName ) const;
+
     void updateAxes();
     void updateCanvasMargins();
 
@@ -281,6 +382,7 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
   public Q_SLOTS:
     virtual void replot();
     void autoRefresh();
+    void notifyInteraction();
 
   protected:
 
@@ -293,12 +395,37 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
   private:
     friend class QwtPlotItem;
     void attachItem( QwtPlotItem*, bool );
+    void itemChanged( const QwtPlotItem*, QwtPlotItem::ChangeFlags );
+    void invalidateLayer( const QwtPlotItem* );
+    void invalidateLayers();
+    void drawLayers( QPainter*, const QRectF&,
+        const QwtScaleMap maps[ QwtAxis::AxisPositions ] );
+    bool drawItemsParallel( QPainter*, const QRectF&,
+        const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const;
+
+    QwtPlotItemList culledItems( const QRectF&,
+        const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const;
+
+    bool drawProgress( QPainter*, const QRectF&,
+        const QwtScaleMap maps[ QwtAxis::AxisPositions ] );
+    void continueProgress();
+    void cancelProgress();
 
     void initAxesData();
     void deleteAxesData();
     void updateScaleDiv();
+    void updateAxis( QwtAxisId, const QwtInterval& );
 
     void initPlot( const QwtText& title );
+    void updateCanvas();
+    void scheduledReplot();
+
+    static void renderFrames( const QList< QwtPlot* >& );
+    void setPlotGroup( QwtPlotGroup* );
+
+    class ReplotScheduler;
+    friend class ReplotScheduler;
+    friend class QwtPlotGroup;
 
     class ScaleData;
     ScaleData* m_scaleData;
@@ -307,4 +434,6 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlot::QualityReductions )
+
 #endif
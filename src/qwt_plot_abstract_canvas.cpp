@@ -14,6 +14,7 @@
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qimage.h>
 #include <qpainterpath.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
@@ -500,16 +501,50 @@ static QPainterPath qwtBorderPath( const QWidget* canvas, const QRect& rect )
 class QwtPlotAbstractCanvas::PrivateData
 {
   public:
+    enum CornerMode
+    {
+        // the corners are painted by the caller of drawCanvas()
+        NoCorners,
+
+        // background from the parent, border painted on top
+        BackgroundCorners,
+
+        // background from the parent and the style sheet
+        StyledCorners
+    };
+
     PrivateData()
         : focusIndicator( NoFocusIndicator )
         , borderRadius( 0 )
+        , cornerMasking( false )
+        , cornerMode( NoCorners )
     {
         styleSheet.hasBorder = false;
+        cornerCache.mode = NoCorners;
+        cornerCache.pixelRatio = 1.0;
     }
 
     FocusIndicator focusIndicator;
     double borderRadius;
 
+    bool cornerMasking;
+    CornerMode cornerMode;
+
+    /*
+        What is painted outside of the border path before the plot
+        items, only the pixels outside of the path are opaque.
+     */
+    struct CornerCache
+    {
+        QSize size;
+        QPainterPath path;
+        CornerMode mode;
+        qreal pixelRatio;
+
+        QVector< QRect > rects;
+        QVector< QImage > images;
+    } cornerCache;
+
     struct StyleSheet
     {
         bool hasBorder;
@@ -615,6 +650,47 @@ double QwtPlotAbstractCanvas::borderRadius() const
     return m_data->borderRadius;
 }
 
+/*!
+   \brief En/Disable masking of rounded corners
+
+   For a canvas with rounded corners - because of borderRadius() or
+   a style sheet - the plot items are clipped by the path of the border.
+   Clipping by a path is significantly slower for the raster paint engine
+   than clipping by a rectangle and affects all items being painted.
+
+   When corner masking is enabled the items are clipped by the bounding
+   rectangle of the path only. Then the corners are restored by
+   cached images of the background outside of the path, that are
+   painted on top of the items.
+
+   \param on On/Off. The default setting is off.
+
+   \note Corner masking needs an opaque background of the parent widget.
+         The cached images are updated, when the canvas size, its border
+         or its style sheet changes.
+
+   \sa cornerMasking(), setBorderRadius()
+ */
+void QwtPlotAbstractCanvas::setCornerMasking( bool on )
+{
+    m_data->cornerMasking = on;
+
+    if ( !on )
+    {
+        m_data->cornerCache.rects.clear();
+        m_data->cornerCache.images.clear();
+    }
+}
+
+/*!
+   \return True, when masking of rounded corners is enabled
+   \sa setCornerMasking()
+ */
+bool QwtPlotAbstractCanvas::cornerMasking() const
+{
+    return m_data->cornerMasking;
+}
+
 //! \return Path for the canvas border
 QPainterPath QwtPlotAbstractCanvas::canvasBorderPath( const QRect& rect ) const
 {
@@ -737,7 +813,9 @@ void QwtPlotAbstractCanvas::drawUnstyled( QPainter* painter )
         painter->restore();
     }
 
+    m_data->cornerMode = PrivateData::BackgroundCorners;
     drawCanvas( painter );
+    m_data->cornerMode = PrivateData::NoCorners;
 }
 
 //! Helper function for the derived plot canvas
@@ -782,7 +860,9 @@ void QwtPlotAbstractCanvas::drawStyled( QPainter* painter, bool hackStyledBackgr
 
         painter->restore();
 
+        m_data->cornerMode = PrivateData::BackgroundCorners;
         drawCanvas( painter );
+        m_data->cornerMode = PrivateData::NoCorners;
 
         // Now paint the border on top
         QStyleOptionFrame opt;
@@ -795,7 +875,9 @@ void QwtPlotAbstractCanvas::drawStyled( QPainter* painter, bool hackStyledBackgr
         opt.initFrom( w );
         w->style()->drawPrimitive( QStyle::PE_Widget, &opt, painter, w );
 
+        m_data->cornerMode = PrivateData::StyledCorners;
         drawCanvas( painter );
+        m_data->cornerMode = PrivateData::NoCorners;
     }
 }
 
@@ -804,26 +886,28 @@ void QwtPlotAbstractCanvas::drawCanvas( QPainter* painter )
 {
     QWidget* w = canvasWidget();
 
-    painter->save();
+    QPainterPath borderPath;
 
     if ( !m_data->styleSheet.borderPath.isEmpty() )
     {
-        painter->setClipPath(
-            m_data->styleSheet.borderPath, Qt::IntersectClip );
+        borderPath = m_data->styleSheet.borderPath;
     }
-    else
+    else if ( borderRadius() > 0.0 )
     {
-        if ( borderRadius() > 0.0 )
-        {
-            const QRect frameRect = w->property( "frameRect" ).toRect();
-            painter->setClipPath( canvasBorderPath( frameRect ), Qt::IntersectClip );
-        }
-        else
-        {
-            painter->setClipRect( w->contentsRect(), Qt::IntersectClip );
-        }
+        const QRect frameRect = w->property( "frameRect" ).toRect();
+        borderPath = canvasBorderPath( frameRect );
     }
 
+    if ( !borderPath.isEmpty() && drawMaskedCanvas( painter, borderPath ) )
+        return;
+
+    painter->save();
+
+    if ( !borderPath.isEmpty() )
+        painter->setClipPath( borderPath, Qt::IntersectClip );
+    else
+        painter->setClipRect( w->contentsRect(), Qt::IntersectClip );
+
     QwtPlot* plot = qobject_cast< QwtPlot* >( w->parent() );
     if ( plot )
         plot->drawCanvas( painter );
@@ -831,11 +915,132 @@ void QwtPlotAbstractCanvas::drawCanvas( QPainter* painter )
     painter->restore();
 }
 
+/*
+    Draw the plot items clipped by the bounding rectangle of the
+    border path and paint the cached corners on top.
+ */
+bool QwtPlotAbstractCanvas::drawMaskedCanvas(
+    QPainter* painter, const QPainterPath& borderPath )
+{
+    if ( !m_data->cornerMasking || m_data->cornerMode == PrivateData::NoCorners )
+        return false;
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    updateCornerImages( borderPath,
+        QwtPainter::devicePixelRatio( painter->device() ) );
+
+    const PrivateData::CornerCache& cache = m_data->cornerCache;
+    if ( cache.images.isEmpty() )
+        return false;
+
+    QWidget* w = canvasWidget();
+
+    painter->save();
+
+    painter->setClipRect( borderPath.controlPointRect().toAlignedRect()
+        & w->rect(), Qt::IntersectClip );
+
+    QwtPlot* plot = qobject_cast< QwtPlot* >( w->parent() );
+    if ( plot )
+        plot->drawCanvas( painter );
+
+    painter->restore();
+
+    for ( int i = 0; i < cache.images.size(); i++ )
+        painter->drawImage( cache.rects[i].topLeft(), cache.images[i] );
+
+    return true;
+}
+
+void QwtPlotAbstractCanvas::updateCornerImages(
+    const QPainterPath& borderPath, qreal pixelRatio )
+{
+    PrivateData::CornerCache& cache = m_data->cornerCache;
+
+    QWidget* w = canvasWidget();
+
+    if ( cache.size == w->size() && cache.mode == m_data->cornerMode
+        && cache.pixelRatio == pixelRatio && cache.path == borderPath )
+    {
+        return;
+    }
+
+    QVector< QRectF > cornerRects;
+    if ( !m_data->styleSheet.borderPath.isEmpty() )
+    {
+        cornerRects = m_data->styleSheet.cornerRects;
+    }
+    else
+    {
+        const double radius = borderRadius();
+        const QRectF r = w->property( "frameRect" ).toRect();
+        const QSizeF sz( radius, radius );
+
+        cornerRects += QRectF( r.topLeft(), sz );
+        cornerRects += QRectF( r.topRight() - QPointF( radius, 0 ), sz );
+        cornerRects += QRectF( r.bottomRight() - QPointF( radius, radius ), sz );
+        cornerRects += QRectF( r.bottomLeft() - QPointF( 0, radius ), sz );
+    }
+
+    cache.size = w->size();
+    cache.mode = m_data->cornerMode;
+    cache.pixelRatio = pixelRatio;
+    cache.path = borderPath;
+
+    cache.rects.clear();
+    cache.images.clear();
+
+    QWidget* bgWidget = qwtBackgroundWidget( w->parentWidget() );
+
+    for ( int i = 0; i < cornerRects.size(); i++ )
+    {
+        const QRect rect = cornerRects[i].toAlignedRect() & w->rect();
+        if ( rect.isEmpty() )
+            continue;
+
+#if QT_VERSION >= 0x050000
+        QImage image( rect.size() * pixelRatio, QImage::Format_ARGB32_Premultiplied );
+        image.setDevicePixelRatio( pixelRatio );
+#else
+        QImage image( rect.size(), QImage::Format_ARGB32_Premultiplied );
+#endif
+        image.fill( Qt::transparent );
+
+        QPixmap pm( rect.size() );
+        QwtPainter::fillPixmap( bgWidget, pm, w->mapTo( bgWidget, rect.topLeft() ) );
+
+        QPainter painter( &image );
+        painter.translate( -rect.topLeft() );
+
+        painter.drawPixmap( rect, pm );
+
+        if ( m_data->cornerMode == PrivateData::StyledCorners )
+            qwtDrawStyledBackground( w, &painter );
+
+        // removing everything inside of the border path
+
+        painter.setCompositionMode( QPainter::CompositionMode_DestinationOut );
+        painter.setRenderHint( QPainter::Antialiasing, true );
+        painter.fillPath( borderPath, Qt::black );
+
+        painter.end();
+
+        cache.rects += rect;
+        cache.images += image;
+    }
+}
+
 //! Update the cached information about the current style sheet
 void QwtPlotAbstractCanvas::updateStyleSheetInfo()
 {
     QWidget* w = canvasWidget();
 
+    m_data->cornerCache.rects.clear();
+    m_data->cornerCache.images.clear();
+    m_data->cornerCache.size = QSize();
+
     if ( !w->testAttribute( Qt::WA_StyledBackground ) )
         return;
 
@@ -936,10 +1141,10 @@ void QwtPlotAbstractGLCanvas::setPaintAttribute( PaintAttribute attribute, bool
     else
     {
         m_data->paintAttributes &= ~attribute;
-
-        if ( attribute == BackingStore )
-            clearBackingStore();
     }
+
+    if ( attribute == WidgetBackingStore || ( attribute == BackingStore && !on ) )
+        clearBackingStore();
 }
 
 /*!
@@ -1101,6 +1306,40 @@ void QwtPlotAbstractGLCanvas::replot()
         w->update( w->contentsRect() );
 }
 
+/*!
+   \brief Open a painter on the backing store
+
+   QwtPlotDirectPainter paints new samples on top of the backing store,
+   instead of replotting the canvas. The backing store is presented with
+   the next paint without rendering the plot again.
+
+   \param painter Painter to be opened on the backing store
+   \return true, when the backing store is valid and the painter has
+           been opened. The default implementation returns false.
+
+   \sa endIncrementalPaint(), QwtPlotDirectPainter::drawSeries()
+ */
+bool QwtPlotAbstractGLCanvas::beginIncrementalPaint( QPainter* painter )
+{
+    Q_UNUSED( painter );
+    return false;
+}
+
+/*!
+   \brief Close a painter opened by beginIncrementalPaint()
+
+   \param painter Painter opened by beginIncrementalPaint()
+   \param rect Part of the canvas, that has been modified
+
+   \sa beginIncrementalPaint()
+ */
+void QwtPlotAbstractGLCanvas::endIncrementalPaint(
+    QPainter* painter, const QRect& rect )
+{
+    Q_UNUSED( painter );
+    Q_UNUSED( rect );
+}
+
 //! \return The rectangle where the frame is drawn in.
 QRect QwtPlotAbstractGLCanvas::frameRect() const
 {
@@ -58,6 +58,9 @@ class QWT_EXPORT QwtPlotAbstractCanvas
     void setBorderRadius( double );
     double borderRadius() const;
 
+    void setCornerMasking( bool );
+    bool cornerMasking() const;
+
   protected:
     QWidget* canvasWidget();
     const QWidget* canvasWidget() const;
@@ -77,6 +80,9 @@ class QWT_EXPORT QwtPlotAbstractCanvas
   private:
     Q_DISABLE_COPY(QwtPlotAbstractCanvas)
 
+    bool drawMaskedCanvas( QPainter*, const QPainterPath& );
+    void updateCornerImages( const QPainterPath&, qreal pixelRatio );
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -109,6 +115,22 @@ class QWT_EXPORT QwtPlotAbstractGLCanvas : public QwtPlotAbstractCanvas
          */
         BackingStore = 1,
 
+        /*!
+           \brief Use the framebuffer of the widget as backing store
+
+           Instead of rendering into an additional framebuffer, that is
+           copied to the framebuffer of the widget with each paint,
+           the plot is rendered directly into the framebuffer of the widget.
+           Its content is preserved and the plot is rendered again only
+           after a replot(), resizing or a change of the focus.
+
+           Only supported by QwtPlotOpenGLCanvas, where it saves
+           the copy of the complete canvas for each frame.
+
+           \sa QOpenGLWidget::setUpdateBehavior()
+         */
+        WidgetBackingStore = 2,
+
         /*!
            When ImmediatePaint is set replot() calls repaint()
            instead of update().
@@ -148,6 +170,9 @@ class QWT_EXPORT QwtPlotAbstractGLCanvas : public QwtPlotAbstractCanvas
     //! Invalidate the internal backing store
     virtual void invalidateBackingStore() = 0;
 
+    virtual bool beginIncrementalPaint( QPainter* );
+    virtual void endIncrementalPaint( QPainter*, const QRect& );
+
   protected:
     void replot();
     void draw( QPainter* );
@@ -13,6 +13,7 @@
 #include "qwt_scale_div.h"
 #include "qwt_scale_engine.h"
 #include "qwt_interval.h"
+#include "qwt_series_store.h"
 
 namespace
 {
@@ -27,6 +28,8 @@ namespace
             , stepSize( 0.0 )
             , maxMajor( 8 )
             , maxMinor( 5 )
+            , autoScaleHysteresis( 0.0 )
+            , autoScaleMode( QwtPlot::FitAll )
             , isValid( false )
             , scaleEngine( new QwtLinearScaleEngine() )
             , scaleWidget( NULL )
@@ -69,6 +72,9 @@ namespace
         int maxMajor;
         int maxMinor;
 
+        double autoScaleHysteresis;
+        QwtPlot::AutoScaleMode autoScaleMode;
+
         bool isValid;
 
         QwtScaleDiv scaleDiv;
@@ -104,6 +110,32 @@ class QwtPlot::ScaleData
     AxisData m_axisData[ QwtAxis::AxisPositions ];
 };
 
+static const QwtSeriesData< QPointF >* qwtPointSeries( const QwtPlotItem* item )
+{
+    const QwtSeriesStore< QPointF >* store =
+        dynamic_cast< const QwtSeriesStore< QPointF >* >( item );
+
+    return store ? store->data() : NULL;
+}
+
+static bool qwtKeepScaleDiv( const AxisData& d, const QwtInterval& interval )
+{
+    if ( d.autoScaleHysteresis <= 0.0 )
+        return false;
+
+    const QwtInterval scaleInterval = d.scaleDiv.interval().normalized();
+    const QwtInterval boundingInterval = interval.normalized();
+
+    if ( boundingInterval.minValue() < scaleInterval.minValue()
+        || boundingInterval.maxValue() > scaleInterval.maxValue() )
+    {
+        return false;
+    }
+
+    return boundingInterval.width() >=
+        ( 1.0 - d.autoScaleHysteresis ) * scaleInterval.width();
+}
+
 void QwtPlot::initAxesData()
 {
     m_scaleData = new ScaleData( this );
@@ -179,6 +211,9 @@ void QwtPlot::setAxisScaleEngine( QwtAxisId axisId, QwtScaleEngine* scaleEngine
 
         d.isValid = false;
 
+        // the transformation might differ by its parameters only
+        invalidateLayers();
+
         autoRefresh();
     }
 }
@@ -450,11 +485,114 @@ void QwtPlot::setAxisAutoScale( QwtAxisId axisId, bool on )
 {
     if ( isAxisValid( axisId ) && ( m_scaleData->axisData( axisId ).doAutoScale != on ) )
     {
-        m_scaleData->axisData( axisId ).doAutoScale = on;
+        AxisData& d = m_scaleData->axisData( axisId );
+
+        d.doAutoScale = on;
+        if ( on )
+            d.isValid = false;
+
         autoRefresh();
     }
 }
 
+/*!
+   \brief Set a hysteresis for autoscaling an axis
+
+   By default the autoscaling recalculates the scale division for each
+   call of updateAxes(). For plots, where the data is changing with each
+   replot - f.e streaming data - this means recalculating the scale division
+   and checking the layout of the scale even when the result would be the
+   same or almost the same.
+
+   With a hysteresis > 0.0 the current scale division is kept as long as
+   the bounding interval of the items is inside of it and covers at least
+   ( 1.0 - hysteresis ) of its width. So a value of 0.2 means that the scale
+   is not adjusted before the data leaves the scale or has shrunk to less
+   than 80% of the scale.
+
+   \param axisId Axis
+   \param hysteresis Value in the range [0.0, 1.0], where 0.0 disables the hysteresis
+
+   \sa axisAutoScaleHysteresis(), setAxisAutoScale(), updateAxes()
+
+   \note The current scale division is also kept, when attributes
+         of the scale engine have been modified. In this case
+         setAxisAutoScale() has to be called again
+ */
+void QwtPlot::setAxisAutoScaleHysteresis( QwtAxisId axisId, double hysteresis )
+{
+    if ( isAxisValid( axisId ) )
+    {
+        hysteresis = qBound( 0.0, hysteresis, 1.0 );
+
+        AxisData& d = m_scaleData->axisData( axisId );
+        if ( d.autoScaleHysteresis != hysteresis )
+        {
+            d.autoScaleHysteresis = hysteresis;
+            d.isValid = false;
+
+            autoRefresh();
+        }
+    }
+}
+
+/*!
+   \return Hysteresis for autoscaling an axis
+   \param axisId Axis
+   \sa setAxisAutoScaleHysteresis()
+ */
+double QwtPlot::axisAutoScaleHysteresis( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_scaleData->axisData( axisId ).autoScaleHysteresis;
+
+    return 0.0;
+}
+
+/*!
+   \brief Set the range of the samples, that is used for autoscaling a y axis
+
+   With FitVisible the y axis is scaled to the samples inside
+   of the scale interval of the x axis - f.e. for following a zoomed
+   section of a long recording. As the x axes are adjusted before the y axes
+   in updateAxes(), this also works together with an autoscaled x axis.
+
+   For series data being a QwtSeriesDataPyramid the range is found
+   in O(log n), otherwise the samples are iterated.
+
+   \param axisId Axis, has to be a y axis
+   \param mode Autoscale mode
+
+   \sa axisAutoScaleMode(), setAxisAutoScale(), qwtSeriesStatistics()
+ */
+void QwtPlot::setAxisAutoScaleMode( QwtAxisId axisId, AutoScaleMode mode )
+{
+    if ( isAxisValid( axisId ) && QwtAxis::isYAxis( axisId ) )
+    {
+        AxisData& d = m_scaleData->axisData( axisId );
+        if ( d.autoScaleMode != mode )
+        {
+            d.autoScaleMode = mode;
+            d.isValid = false;
+
+            autoRefresh();
+        }
+    }
+}
+
+/*!
+   \return Range of the samples, that is used for autoscaling an axis
+   \param axisId Axis
+   \sa setAxisAutoScaleMode()
+ */
+QwtPlot::AutoScaleMode QwtPlot::axisAutoScaleMode( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_scaleData->axisData( axisId ).autoScaleMode;
+
+    return FitAll;
+}
+
 /*!
    \brief Disable autoscaling and specify a fixed scale for a selected axis.
 
@@ -646,7 +784,13 @@ void QwtPlot::setAxisTitle( QwtAxisId axisId, const QwtText& title )
    from the bounding rectangles of all plot items, having the
    QwtPlotItem::AutoScale flag enabled ( QwtScaleEngine::autoScale() ).
    Then a scale division is calculated ( QwtScaleEngine::didvideScale() )
-   and assigned to scale widget.
+   and assigned to scale widget. With a hysteresis for autoscaling the
+   current scale division is kept, as long as the bounding interval
+   is inside of it ( see setAxisAutoScaleHysteresis() ).
+
+   The x axes are adjusted before the y axes, so that y axes
+   in FitVisible mode can be scaled to the samples inside of the
+   scale intervals of the x axes ( see setAxisAutoScaleMode() ).
 
    When the scale boundaries have been assigned with setAxisScale() a
    scale division is calculated ( QwtScaleEngine::didvideScale() )
@@ -660,8 +804,8 @@ void QwtPlot::setAxisTitle( QwtAxisId axisId, const QwtText& title )
 
    updateAxes() is usually called by replot().
 
-   \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
-      QwtPlotItem::boundingRect()
+   \sa setAxisAutoScale(), setAxisAutoScaleHysteresis(), setAxisAutoScaleMode(),
+      setAxisScale(), setAxisScaleDiv(), replot(), QwtPlotItem::boundingRect()
  */
 void QwtPlot::updateAxes()
 {
@@ -670,6 +814,9 @@ void QwtPlot::updateAxes()
 
     QwtInterval boundingIntervals[QwtAxis::AxisPositions];
 
+    // items, that are scaled to their visible samples
+    QList< const QwtPlotItem* > visibleItems;
+
     const QwtPlotItemList& itmList = itemList();
 
     QwtPlotItemIterator it;
@@ -690,50 +837,44 @@ void QwtPlot::updateAxes()
             if ( rect.width() >= 0.0 )
                 boundingIntervals[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
 
+            if ( axisAutoScaleMode( item->yAxis() ) == FitVisible
+                && qwtPointSeries( item ) != NULL )
+            {
+                visibleItems += item;
+                continue;
+            }
+
             if ( rect.height() >= 0.0 )
                 boundingIntervals[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
         }
     }
 
-    // Adjust scales
+    // Adjust scales: the x axes first, so that the y axes
+    // can be scaled to the samples inside of their intervals
 
     for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
     {
-        {
-            const QwtAxisId axisId( axisPos );
-
-            AxisData& d = m_scaleData->axisData( axisId );
-
-            double minValue = d.minValue;
-            double maxValue = d.maxValue;
-            double stepSize = d.stepSize;
-
-            const QwtInterval& interval = boundingIntervals[axisId];
+        if ( QwtAxis::isXAxis( axisPos ) )
+            updateAxis( axisPos, boundingIntervals[axisPos] );
+    }
 
-            if ( d.doAutoScale && interval.isValid() )
-            {
-                d.isValid = false;
+    for ( int i = 0; i < visibleItems.size(); i++ )
+    {
+        const QwtPlotItem* item = visibleItems[i];
 
-                minValue = interval.minValue();
-                maxValue = interval.maxValue();
+        const QwtInterval xInterval =
+            axisScaleDiv( item->xAxis() ).interval().normalized();
 
-                d.scaleEngine->autoScale( d.maxMajor,
-                    minValue, maxValue, stepSize );
-            }
-            if ( !d.isValid )
-            {
-                d.scaleDiv = d.scaleEngine->divideScale(
-                    minValue, maxValue, d.maxMajor, d.maxMinor, stepSize );
-                d.isValid = true;
-            }
+        const QwtSeriesStatistics statistics = qwtSeriesStatistics(
+            *qwtPointSeries( item ), xInterval.minValue(), xInterval.maxValue() );
 
-            QwtScaleWidget* scaleWidget = axisWidget( axisId );
-            scaleWidget->setScaleDiv( d.scaleDiv );
+        boundingIntervals[item->yAxis()] |= statistics.yInterval();
+    }
 
-            int startDist, endDist;
-            scaleWidget->getBorderDistHint( startDist, endDist );
-            scaleWidget->setBorderDist( startDist, endDist );
-        }
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        if ( QwtAxis::isYAxis( axisPos ) )
+            updateAxis( axisPos, boundingIntervals[axisPos] );
     }
 
     for ( it = itmList.begin(); it != itmList.end(); ++it )
@@ -747,3 +888,37 @@ void QwtPlot::updateAxes()
     }
 }
 
+void QwtPlot::updateAxis( QwtAxisId axisId, const QwtInterval& interval )
+{
+    AxisData& d = m_scaleData->axisData( axisId );
+
+    double minValue = d.minValue;
+    double maxValue = d.maxValue;
+    double stepSize = d.stepSize;
+
+    if ( d.doAutoScale && interval.isValid()
+        && !( d.isValid && qwtKeepScaleDiv( d, interval ) ) )
+    {
+        d.isValid = false;
+
+        minValue = interval.minValue();
+        maxValue = interval.maxValue();
+
+        d.scaleEngine->autoScale( d.maxMajor,
+            minValue, maxValue, stepSize );
+    }
+    if ( !d.isValid )
+    {
+        d.scaleDiv = d.scaleEngine->divideScale(
+            minValue, maxValue, d.maxMajor, d.maxMinor, stepSize );
+        d.isValid = true;
+    }
+
+    QwtScaleWidget* scaleWidget = axisWidget( axisId );
+    scaleWidget->setScaleDiv( d.scaleDiv );
+
+    int startDist, endDist;
+    scaleWidget->getBorderDistHint( startDist, endDist );
+    scaleWidget->setBorderDist( startDist, endDist );
+}
+
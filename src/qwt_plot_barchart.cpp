@@ -13,25 +13,72 @@
 #include "qwt_text.h"
 #include "qwt_graphic.h"
 #include "qwt_legend_data.h"
+#include "qwt_painter.h"
+#include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qmath.h>
 
-class QwtPlotBarChart::PrivateData
+static inline bool qwtIsBatchable( const QwtColumnSymbol* symbol )
 {
-  public:
-    PrivateData()
-        : symbol( NULL )
-        , legendMode( QwtPlotBarChart::LegendChartTitle )
+    return ( symbol->style() == QwtColumnSymbol::Box )
+        && ( symbol->frameStyle() != QwtColumnSymbol::Raised );
+}
+
+/*
+   Append a bar to rects. When the bar and the previous
+   one are both inside of the same pixel column they are merged.
+ */
+static inline void qwtAddBar( QVector< QRectF >& rects,
+    const QRectF& rect, Qt::Orientation orientation )
+{
+    if ( !rects.isEmpty() )
     {
+        QRectF& last = rects.last();
+
+        if ( orientation == Qt::Vertical )
+        {
+            const int pos = qFloor( last.left() );
+            if ( qFloor( last.right() ) == pos
+                && qFloor( rect.left() ) == pos && qFloor( rect.right() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
+        else
+        {
+            const int pos = qFloor( last.top() );
+            if ( qFloor( last.bottom() ) == pos
+                && qFloor( rect.top() ) == pos && qFloor( rect.bottom() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
     }
 
-    ~PrivateData()
+    rects += rect;
+}
+
+static inline void qwtDrawBoxes( QPainter* painter,
+    const QwtColumnSymbol* symbol, QVector< QRectF >& rects )
+{
+    symbol->drawBoxes( painter, rects.constData(), rects.size() );
+    rects.clear();
+}
+
+class QwtPlotBarChart::PrivateData
+{
+  public:
+    PrivateData()
+        : legendMode( QwtPlotBarChart::LegendChartTitle )
     {
-        delete symbol;
     }
 
-    QwtColumnSymbol* symbol;
+    QSharedPointer< const QwtColumnSymbol > symbol;
     QwtPlotBarChart::LegendMode legendMode;
+    QwtPlotBarChart::PaintAttributes paintAttributes;
 };
 
 /*!
@@ -72,6 +119,30 @@ int QwtPlotBarChart::rtti() const
     return QwtPlotItem::Rtti_PlotBarChart;
 }
 
+/*!
+   Specify an attribute how to draw the bar chart
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotBarChart::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa setPaintAttribute()
+ */
+bool QwtPlotBarChart::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
 /*!
    Initialize data with an array of points
 
@@ -132,10 +203,25 @@ void QwtPlotBarChart::setSamples( QwtSeriesData< QPointF >* data )
    \sa symbol()
  */
 void QwtPlotBarChart::setSymbol( QwtColumnSymbol* symbol )
+{
+    if ( symbol != m_data->symbol.data() )
+        setSymbol( QSharedPointer< const QwtColumnSymbol >( symbol ) );
+}
+
+/*!
+   \brief Assign a symbol, that might be shared with other items
+
+   Bar charts with the same symbol can share one instance
+   instead of having individual copies.
+
+   \param symbol Symbol
+   \sa symbol()
+ */
+void QwtPlotBarChart::setSymbol(
+    const QSharedPointer< const QwtColumnSymbol >& symbol )
 {
     if ( symbol != m_data->symbol )
     {
-        delete m_data->symbol;
         m_data->symbol = symbol;
 
         legendChanged();
@@ -149,7 +235,7 @@ void QwtPlotBarChart::setSymbol( QwtColumnSymbol* symbol )
  */
 const QwtColumnSymbol* QwtPlotBarChart::symbol() const
 {
-    return m_data->symbol;
+    return m_data->symbol.data();
 }
 
 /*!
@@ -218,7 +304,7 @@ QRectF QwtPlotBarChart::boundingRect() const
    \param to Index of the last point to be painted. If to < 0 the
          curve will be painted to its last point.
 
-   \sa drawSymbols()
+   \sa drawSymbols(), BatchBars
  */
 void QwtPlotBarChart::drawSeries( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -239,6 +325,34 @@ void QwtPlotBarChart::drawSeries( QPainter* painter,
 
     painter->save();
 
+    if ( m_data->paintAttributes & BatchBars )
+    {
+        if ( m_data->symbol )
+        {
+            if ( qwtIsBatchable( m_data->symbol.data() ) )
+            {
+                drawBarsBatched( painter, m_data->symbol.data(),
+                    xMap, yMap, canvasRect, interval, from, to );
+
+                painter->restore();
+                return;
+            }
+        }
+        else
+        {
+            // the default symbol of drawBar()
+            QwtColumnSymbol columnSymbol( QwtColumnSymbol::Box );
+            columnSymbol.setLineWidth( 1 );
+            columnSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+            drawBarsBatched( painter, &columnSymbol,
+                xMap, yMap, canvasRect, interval, from, to );
+
+            painter->restore();
+            return;
+        }
+    }
+
     for ( int i = from; i <= to; i++ )
     {
         drawSample( painter, xMap, yMap,
@@ -248,6 +362,56 @@ void QwtPlotBarChart::drawSeries( QPainter* painter,
     painter->restore();
 }
 
+/*!
+   Collect the bars, that are displayed by the same symbol
+   and paint them by calls of QPainter::drawRects()
+
+   \sa drawSeries(), BatchBars
+ */
+void QwtPlotBarChart::drawBarsBatched( QPainter* painter,
+    const QwtColumnSymbol* symbol,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, const QwtInterval& boundingInterval,
+    int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    QVector< QRectF > rects;
+    rects.reserve( to - from + 1 );
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = this->sample( i );
+
+        const QwtColumnRect barRect = columnRect( xMap, yMap,
+            canvasRect, boundingInterval, sample );
+
+        const QwtColumnSymbol* specialSym = specialSymbol( i, sample );
+        if ( specialSym )
+        {
+            qwtDrawBoxes( painter, symbol, rects );
+
+            specialSym->draw( painter, barRect );
+            delete specialSym;
+
+            continue;
+        }
+
+        QRectF r = barRect.toRect();
+        if ( doAlign )
+        {
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+        }
+
+        qwtAddBar( rects, r, orientation() );
+    }
+
+    qwtDrawBoxes( painter, symbol, rects );
+}
+
 /*!
    Calculate the geometry of a bar in widget coordinates
 
@@ -347,7 +511,7 @@ void QwtPlotBarChart::drawBar( QPainter* painter,
 
     const QwtColumnSymbol* sym = specialSym;
     if ( sym == NULL )
-        sym = m_data->symbol;
+        sym = m_data->symbol.data();
 
     if ( sym )
     {
@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_plot_abstract_barchart.h"
 
+#include <qsharedpointer.h>
+
 class QwtColumnRect;
 class QwtColumnSymbol;
 template< typename T > class QwtSeriesData;
@@ -68,6 +70,31 @@ class QWT_EXPORT QwtPlotBarChart
         LegendBarTitles
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        The default setting disables all attributes
+
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+           Bars, that are displayed by the same symbol(), are collected
+           and painted by calls of QPainter::drawRects(). Bars, that are
+           narrower than a pixel and located in the same pixel column,
+           are merged into one rectangle.
+
+           Only symbols of QwtColumnSymbol::Box style without a
+           QwtColumnSymbol::Raised frame can be batched. As the bars
+           are not painted one by one drawSample(), drawBar() and
+           QwtColumnSymbol::draw() are not called for them.
+           Bars with a specialSymbol() are painted as before.
+         */
+        BatchBars = 0x01
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
     explicit QwtPlotBarChart( const QString& title = QString() );
     explicit QwtPlotBarChart( const QwtText& title );
 
@@ -75,11 +102,15 @@ class QWT_EXPORT QwtPlotBarChart
 
     virtual int rtti() const QWT_OVERRIDE;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setSamples( const QVector< QPointF >& );
     void setSamples( const QVector< double >& );
     void setSamples( QwtSeriesData< QPointF >* );
 
     void setSymbol( QwtColumnSymbol* );
+    void setSymbol( const QSharedPointer< const QwtColumnSymbol >& );
     const QwtColumnSymbol* symbol() const;
 
     void setLegendMode( LegendMode );
@@ -117,8 +148,15 @@ class QWT_EXPORT QwtPlotBarChart
   private:
     void init();
 
+    void drawBarsBatched( QPainter*, const QwtColumnSymbol*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, const QwtInterval& boundingInterval,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotBarChart::PaintAttributes )
+
 #endif
@@ -10,6 +10,9 @@
 #include "qwt_plot_canvas.h"
 #include "qwt_painter.h"
 #include "qwt_plot.h"
+#include "qwt_scale_map.h"
+#include "qwt_math.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
@@ -20,18 +23,256 @@ class QwtPlotCanvas::PrivateData
   public:
     PrivateData()
         : backingStore( NULL )
+        , parkedStore( NULL )
+        , isBackingStoreValid( false )
+        , isInteractive( false )
+        , interactivePixelRatio( 0.0 )
+        , hasScrollMaps( false )
+        , cacheEntry( this )
     {
     }
 
     ~PrivateData()
     {
         delete backingStore;
+        delete parkedStore;
     }
 
+    void updateCacheUsage()
+    {
+        qint64 bytes = 0;
+        if ( backingStore )
+            bytes += QwtCacheEntry::pixmapSize( *backingStore );
+        if ( parkedStore )
+            bytes += QwtCacheEntry::pixmapSize( *parkedStore );
+
+        cacheEntry.setMemoryUsage( bytes );
+    }
+
+    void updateScrollMaps( const QwtPlotCanvas* );
+    bool scroll( QwtPlotCanvas* );
+
+    qreal backingStoreRatio( const QwtPlotCanvas* ) const;
+
     QwtPlotCanvas::PaintAttributes paintAttributes;
+
+    /*
+        The backing store in use and the one for the other
+        resolution. Both are kept, so that switching between
+        interactive and idle mode does not reallocate them.
+     */
     QPixmap* backingStore;
+    QPixmap* parkedStore;
+    bool isBackingStoreValid;
+
+    bool isInteractive;
+    double interactivePixelRatio;
+
+    // the maps, that have been used for the backing store
+    bool hasScrollMaps;
+    QwtScaleMap scrollMaps[ QwtAxis::AxisPositions ];
+    QRect scrollRect;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::BackingStoreCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            if ( m_data->backingStore )
+                *m_data->backingStore = QPixmap();
+
+            if ( m_data->parkedStore )
+                *m_data->parkedStore = QPixmap();
+
+            m_data->isBackingStoreValid = false;
+            m_data->hasScrollMaps = false;
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
+qreal QwtPlotCanvas::PrivateData::backingStoreRatio(
+    const QwtPlotCanvas* canvas ) const
+{
+    qreal pixelRatio = QwtPainter::devicePixelRatio( canvas );
+
+#if QT_VERSION >= 0x050000
+    if ( isInteractive && interactivePixelRatio > 0.0 )
+        pixelRatio = qMin( pixelRatio, qreal( interactivePixelRatio ) );
+#endif
+
+    return pixelRatio;
+}
+
+void QwtPlotCanvas::PrivateData::updateScrollMaps( const QwtPlotCanvas* canvas )
+{
+    const QwtPlot* plot = canvas->plot();
+
+    hasScrollMaps = ( plot != NULL );
+    if ( hasScrollMaps )
+    {
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            scrollMaps[axisPos] = plot->canvasMap( axisPos );
+
+        scrollRect = canvas->contentsRect();
+    }
+}
+
+bool QwtPlotCanvas::PrivateData::scroll( QwtPlotCanvas* canvas )
+{
+    const QwtPlot* plot = canvas->plot();
+
+    if ( plot == NULL || plot->asyncReplot() || !hasScrollMaps )
+        return false;
+
+    if ( backingStore == NULL || backingStore->isNull() || !isBackingStoreValid )
+        return false;
+
+    if ( canvas->testAttribute( Qt::WA_StyledBackground )
+        || canvas->borderRadius() > 0.0 )
+    {
+        return false;
+    }
+
+    const QRect canvasRect = canvas->contentsRect();
+    if ( canvasRect != scrollRect || canvasRect.isEmpty() )
+        return false;
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( backingStore );
+    if ( backingStore->size() != canvas->size() * pixelRatio )
+        return false;
+
+    bool isUsed[ QwtAxis::AxisPositions ] = { false, false, false, false };
+
+    const QwtPlotItemList& items = plot->itemList();
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+        if ( item->isVisible() && QwtAxis::isValid( item->xAxis() )
+            && QwtAxis::isValid( item->yAxis() ) )
+        {
+            isUsed[ item->xAxis() ] = true;
+            isUsed[ item->yAxis() ] = true;
+        }
+    }
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+
+    bool hasShift = false;
+    int shift = 0; // in device pixels
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        maps[axisPos] = plot->canvasMap( axisPos );
+
+        if ( !isUsed[axisPos] )
+            continue;
+
+        const QwtScaleMap& map = maps[axisPos];
+        const QwtScaleMap& oldMap = scrollMaps[axisPos];
+
+        if ( map.p1() != oldMap.p1() || map.p2() != oldMap.p2() )
+            return false;
+
+        if ( QwtAxis::isYAxis( axisPos ) )
+        {
+            if ( map.s1() != oldMap.s1() || map.s2() != oldMap.s2() )
+                return false;
+
+            continue;
+        }
+
+        if ( map.transformation() || oldMap.transformation() )
+            return false;
+
+        const double width = map.s2() - map.s1();
+        if ( width == 0.0 ||
+            qwtFuzzyCompare( width, oldMap.s2() - oldMap.s1(), width ) != 0 )
+        {
+            return false;
+        }
+
+        const double cnv = ( map.p2() - map.p1() ) / width;
+        const int d = qRound( ( oldMap.s1() - map.s1() ) * cnv * pixelRatio );
+
+        if ( hasShift && d != shift )
+            return false;
+
+        shift = d;
+        hasShift = true;
+    }
+
+    const QRect deviceRect( qRound( canvasRect.x() * pixelRatio ),
+        qRound( canvasRect.y() * pixelRatio ),
+        qRound( canvasRect.width() * pixelRatio ),
+        qRound( canvasRect.height() * pixelRatio ) );
+
+    if ( shift == 0 || qAbs( shift ) >= deviceRect.width() )
+        return false;
+
+    /*
+        The new content is rendered for maps, that are shifted
+        by the rounded pixel delta. So the backing store is always
+        consistent, while the deviation from the exact scales
+        is below a pixel.
+     */
+    const double delta = shift / pixelRatio;
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        if ( isUsed[axisPos] && QwtAxis::isXAxis( axisPos ) )
+        {
+            const QwtScaleMap& oldMap = scrollMaps[axisPos];
+            const double d = delta * ( oldMap.s2() - oldMap.s1() )
+                / ( oldMap.p2() - oldMap.p1() );
+
+            maps[axisPos].setScaleInterval( oldMap.s1() - d, oldMap.s2() - d );
+        }
+    }
+
+    backingStore->scroll( shift, 0, deviceRect );
+
+    /*
+        Segments, that connect to samples in the exposed strip
+        are partly in the scrolled area. So we repaint a strip
+        of twice the width.
+     */
+    const int stripWidth = qMin( 2 * qAbs( shift ), deviceRect.width() );
+
+    QRect strip = deviceRect;
+    if ( shift < 0 )
+        strip.setLeft( deviceRect.right() + 1 - stripWidth );
+    else
+        strip.setWidth( stripWidth );
+
+    const QRectF clipRect( strip.x() / pixelRatio, strip.y() / pixelRatio,
+        strip.width() / pixelRatio, strip.height() / pixelRatio );
+
+    QPainter painter( backingStore );
+    painter.setClipRect( clipRect );
+    painter.fillRect( clipRect, canvas->palette().brush( canvas->backgroundRole() ) );
+
+    plot->drawItems( &painter, canvasRect, maps );
+
+    painter.end();
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        scrollMaps[axisPos] = maps[axisPos];
+
+    return true;
+}
+
 /*!
    \brief Constructor
 
@@ -84,7 +325,10 @@ void QwtPlotCanvas::setPaintAttribute( PaintAttribute attribute, bool on )
             if ( on )
             {
                 if ( m_data->backingStore == NULL )
+                {
                     m_data->backingStore = new QPixmap();
+                    m_data->parkedStore = new QPixmap();
+                }
 
                 if ( isVisible() )
                 {
@@ -94,13 +338,21 @@ void QwtPlotCanvas::setPaintAttribute( PaintAttribute attribute, bool on )
                     *m_data->backingStore =
                         QPixmap::grabWidget( this, rect() );
 #endif
+                    m_data->isBackingStoreValid = true;
                 }
             }
             else
             {
                 delete m_data->backingStore;
                 m_data->backingStore = NULL;
+
+                delete m_data->parkedStore;
+                m_data->parkedStore = NULL;
+
+                m_data->isBackingStoreValid = false;
             }
+
+            m_data->updateCacheUsage();
             break;
         }
         case Opaque:
@@ -135,11 +387,112 @@ const QPixmap* QwtPlotCanvas::backingStore() const
     return m_data->backingStore;
 }
 
-//! Invalidate the internal backing store
+/*!
+   \brief Invalidate the internal backing store
+
+   The content of the backing store will be rendered again with the
+   next paint event. The pixmap itself is reused, unless the size
+   or the pixel ratio of the canvas has changed.
+ */
 void QwtPlotCanvas::invalidateBackingStore()
 {
-    if ( m_data->backingStore )
-        *m_data->backingStore = QPixmap();
+    m_data->isBackingStoreValid = false;
+}
+
+/*!
+   \brief Set the pixel ratio of the backing store in interactive mode
+
+   On high resolution screens the backing store is allocated with the
+   device pixel ratio of the canvas - f.e. 4 times the number of pixels
+   for a ratio of 2. As the effort for rendering curves and raster
+   items usually grows with the number of pixels, an application might
+   decide to render with a lower resolution while the user is
+   interacting - f.e. when panning or zooming - and to switch back
+   to the full resolution when being idle.
+
+   \param ratio Pixel ratio for the interactive mode. Values
+               above the device pixel ratio are ignored.
+               The default setting is 0.0, what disables the
+               reduced resolution.
+
+   \note Has no effect without the BackingStore paint attribute
+         and for Qt < 5.
+
+   \sa interactivePixelRatio(), setInteractive()
+ */
+void QwtPlotCanvas::setInteractivePixelRatio( double ratio )
+{
+    if ( ratio < 0.0 )
+        ratio = 0.0;
+
+    if ( ratio != m_data->interactivePixelRatio )
+    {
+        m_data->interactivePixelRatio = ratio;
+
+        if ( m_data->isInteractive )
+            replot();
+    }
+}
+
+/*!
+   \return Pixel ratio of the backing store in interactive mode
+   \sa setInteractivePixelRatio(), setInteractive()
+ */
+double QwtPlotCanvas::interactivePixelRatio() const
+{
+    return m_data->interactivePixelRatio;
+}
+
+/*!
+   \brief En/Disable the interactive mode
+
+   In interactive mode the backing store is rendered in the resolution
+   of interactivePixelRatio(). Leaving the interactive mode
+   replots the canvas in the full resolution.
+
+   The backing stores for both resolutions are kept, so toggling
+   the mode does not reallocate them.
+
+   \param on On/Off
+   \par Example
+   \code
+   QwtPlotCanvas* canvas = new QwtPlotCanvas();
+   canvas->setInteractivePixelRatio( 1.0 );
+
+   // f.e. while dragging with a mouse button being pressed
+   canvas->setInteractive( true );
+   ...
+   canvas->setInteractive( false );
+   \endcode
+   \endpar
+
+   \sa isInteractive(), setInteractivePixelRatio()
+ */
+void QwtPlotCanvas::setInteractive( bool on )
+{
+    if ( on == m_data->isInteractive )
+        return;
+
+    m_data->isInteractive = on;
+
+    if ( m_data->interactivePixelRatio > 0.0 && m_data->backingStore )
+    {
+        qSwap( m_data->backingStore, m_data->parkedStore );
+        m_data->hasScrollMaps = false;
+
+        m_data->updateCacheUsage();
+
+        replot();
+    }
+}
+
+/*!
+   \return True, when the canvas is in interactive mode
+   \sa setInteractive()
+ */
+bool QwtPlotCanvas::isInteractive() const
+{
+    return m_data->isInteractive;
 }
 
 /*!
@@ -184,9 +537,25 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
         m_data->backingStore != NULL )
     {
         QPixmap& bs = *m_data->backingStore;
-        if ( bs.size() != size() * QwtPainter::devicePixelRatio( &bs ) )
+
+        const qreal pixelRatio = m_data->backingStoreRatio( this );
+
+        bool isValid = m_data->isBackingStoreValid;
+        if ( bs.isNull() || bs.size() != size() * pixelRatio
+            || QwtPainter::devicePixelRatio( &bs ) != pixelRatio )
+        {
+            bs = QwtPainter::backingStore( this, size(), pixelRatio );
+            isValid = false;
+
+            m_data->updateCacheUsage();
+        }
+        else if ( !isValid && bs.hasAlphaChannel() )
+        {
+            bs.fill( Qt::transparent );
+        }
+
+        if ( !isValid )
         {
-            bs = QwtPainter::backingStore( this, size() );
 
             if ( testAttribute(Qt::WA_StyledBackground) )
             {
@@ -211,9 +580,15 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
                 if ( frameWidth() > 0 )
                     drawBorder( &p );
             }
+
+            if ( testPaintAttribute( ScrollingBackingStore ) )
+                m_data->updateScrollMaps( this );
+
+            m_data->isBackingStoreValid = true;
         }
 
         painter.drawPixmap( 0, 0, *m_data->backingStore );
+        m_data->cacheEntry.touch();
     }
     else
     {
@@ -296,11 +671,24 @@ void QwtPlotCanvas::resizeEvent( QResizeEvent* event )
 
 /*!
    Invalidate the paint cache and repaint the canvas
+
+   When ScrollingBackingStore is enabled and the x scales have
+   been shifted only, the backing store is scrolled instead.
+
    \sa invalidatePaintCache()
  */
 void QwtPlotCanvas::replot()
 {
-    invalidateBackingStore();
+    bool isScrolled = false;
+
+    if ( testPaintAttribute( QwtPlotCanvas::BackingStore )
+        && testPaintAttribute( QwtPlotCanvas::ScrollingBackingStore ) )
+    {
+        isScrolled = m_data->scroll( this );
+    }
+
+    if ( !isScrolled )
+        invalidateBackingStore();
 
     if ( testPaintAttribute( QwtPlotCanvas::ImmediatePaint ) )
         repaint( contentsRect() );
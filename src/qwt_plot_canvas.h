@@ -96,7 +96,28 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
 
            \sa replot(), QWidget::repaint(), QWidget::update()
          */
-        ImmediatePaint = 8
+        ImmediatePaint = 8,
+
+        /*!
+           \brief Scroll the backing store for strip charts
+
+           When the x scales have been shifted by replot() without
+           changing their width, the content of the backing store is
+           scrolled by the pixel delta and only the exposed strip
+           is rendered again. The y scales have to be unchanged.
+
+           ScrollingBackingStore has no effect without BackingStore and
+           is ignored for styled backgrounds, rounded borders,
+           non linear x scales and in QwtPlot::asyncReplot() mode.
+
+           \warning All items on the canvas have to scroll with the x scale
+                    and modifications are expected to be inside of the exposed
+                    strip only. Items, that are pinned to the canvas
+                    ( f.e. QwtPlotLegendItem ) can't be used.
+
+           \sa replot(), QwtPlot::drawItems()
+         */
+        ScrollingBackingStore = 16
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -110,12 +131,18 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
     const QPixmap* backingStore() const;
     Q_INVOKABLE void invalidateBackingStore();
 
+    void setInteractivePixelRatio( double );
+    double interactivePixelRatio() const;
+
+    bool isInteractive() const;
+
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
     Q_INVOKABLE QPainterPath borderPath( const QRect& ) const;
 
   public Q_SLOTS:
     void replot();
+    void setInteractive( bool );
 
   protected:
     virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
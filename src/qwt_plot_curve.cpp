@@ -9,19 +9,33 @@
 
 #include "qwt_plot_curve.h"
 #include "qwt_point_data.h"
+#include "qwt_series_data_pyramid.h"
+#include "qwt_uniform_series_data.h"
+#include "qwt_point_spatial_index.h"
 #include "qwt_math.h"
 #include "qwt_clipper.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_line_rasterizer.h"
 #include "qwt_painter.h"
 #include "qwt_scale_map.h"
 #include "qwt_plot.h"
 #include "qwt_spline_curve_fitter.h"
+#include "qwt_spline.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
+#include "qwt_pixel_matrix.h"
+#include "qwt_color_map.h"
 #include "qwt_text.h"
 #include "qwt_graphic.h"
+#include "qwt_painter_command.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qmutex.h>
+#include <qlist.h>
+
+#include <typeinfo>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF& rect, QPainter* painter )
 {
@@ -32,6 +46,254 @@ static inline QRectF qwtIntersectedClipRect( const QRectF& rect, QPainter* paint
     return clipRect;
 }
 
+static inline bool qwtFilterAggressive( const QwtPlotCurve* curve )
+{
+    if ( curve->testPaintAttribute( QwtPlotCurve::FilterPointsAggressive ) )
+        return true;
+
+    // reduced quality, while the user is interacting
+    const QwtPlot* plot = curve->plot();
+    return plot && plot->testQualityReduction( QwtPlot::AggressiveFiltering );
+}
+
+/*
+    The streaming polyline of QwtPointMapper::drawPolyline() can be
+    interrupted at the gaps. All other paths need the runs of samples
+    between the gaps.
+ */
+static bool qwtBreaksWhileMapping( const QwtPlotCurve* curve, int style )
+{
+    if ( style != QwtPlotCurve::Lines )
+        return false;
+
+    if ( curve->testCurveAttribute( QwtPlotCurve::Fitted ) && curve->curveFitter() )
+        return false;
+
+    if ( curve->brush().style() != Qt::NoBrush && curve->brush().color().alpha() > 0 )
+        return false;
+
+    if ( curve->testPaintAttribute( QwtPlotCurve::ImageBuffer ) )
+        return false;
+
+    return dynamic_cast< const QwtSeriesDataPyramid* >( curve->data() ) == NULL;
+}
+
+namespace
+{
+    /*
+        All attributes, that have an effect on the legend icon of a curve.
+        Symbols can be compared only, when they are built-in styles
+        of QwtSymbol itself.
+     */
+    class LegendIconKey
+    {
+      public:
+        LegendIconKey()
+            : isValid( false )
+        {
+        }
+
+        LegendIconKey( const QwtPlotCurve* curve, const QSizeF& size )
+            : size( size )
+            , legendAttributes( 0 )
+            , curveStyle( curve->style() )
+            , antialiased( curve->testRenderHint( QwtPlotItem::RenderAntialiased ) )
+            , pen( curve->pen() )
+            , brush( curve->brush() )
+            , symbolStyle( QwtSymbol::NoSymbol )
+            , pinPointEnabled( false )
+        {
+            const QwtPlotCurve::LegendAttribute attributes[] =
+            {
+                QwtPlotCurve::LegendShowLine,
+                QwtPlotCurve::LegendShowSymbol,
+                QwtPlotCurve::LegendShowBrush
+            };
+
+            for ( size_t i = 0; i < sizeof( attributes ) / sizeof( attributes[0] ); i++ )
+            {
+                if ( curve->testLegendAttribute( attributes[i] ) )
+                    legendAttributes |= attributes[i];
+            }
+
+            isValid = true;
+
+            if ( const QwtSymbol* symbol = curve->symbol() )
+            {
+                if ( typeid( *symbol ) != typeid( QwtSymbol )
+                    || symbol->style() >= QwtSymbol::Path )
+                {
+                    // custom symbols might paint anything
+                    isValid = false;
+                }
+
+                symbolStyle = symbol->style();
+                symbolSize = symbol->size();
+                symbolPen = symbol->pen();
+                symbolBrush = symbol->brush();
+                pinPoint = symbol->pinPoint();
+                pinPointEnabled = symbol->isPinPointEnabled();
+            }
+        }
+
+        bool operator==( const LegendIconKey& other ) const
+        {
+            return size == other.size
+                   && legendAttributes == other.legendAttributes
+                   && curveStyle == other.curveStyle
+                   && antialiased == other.antialiased
+                   && pen == other.pen
+                   && brush == other.brush
+                   && symbolStyle == other.symbolStyle
+                   && symbolSize == other.symbolSize
+                   && symbolPen == other.symbolPen
+                   && symbolBrush == other.symbolBrush
+                   && pinPoint == other.pinPoint
+                   && pinPointEnabled == other.pinPointEnabled;
+        }
+
+        bool isValid;
+
+        QSizeF size;
+        int legendAttributes;
+        int curveStyle;
+        bool antialiased;
+
+        QPen pen;
+        QBrush brush;
+
+        int symbolStyle;
+        QSize symbolSize;
+        QPen symbolPen;
+        QBrush symbolBrush;
+        QPointF pinPoint;
+        bool pinPointEnabled;
+    };
+
+    /*
+        Curves of a plot usually differ in their colors only, but often
+        the same styles are used in many plots. So the icons are shared
+        between all curves.
+     */
+    class LegendIconCache : public QwtCacheEntry
+    {
+      public:
+        LegendIconCache()
+            : QwtCacheEntry( QwtCacheRegistry::LegendCache )
+        {
+        }
+
+        bool find( const LegendIconKey& key, QwtGraphic& icon )
+        {
+            {
+                QMutexLocker locker( &m_mutex );
+
+                int index = -1;
+                for ( int i = 0; i < m_entries.size(); i++ )
+                {
+                    if ( m_entries[i].key == key )
+                    {
+                        index = i;
+                        break;
+                    }
+                }
+
+                if ( index < 0 )
+                    return false;
+
+                if ( index > 0 )
+                    m_entries.move( index, 0 ); // most recently used first
+
+                icon = m_entries.first().icon;
+            }
+
+            touch();
+            return true;
+        }
+
+        void insert( const LegendIconKey& key, const QwtGraphic& icon )
+        {
+            // a handful of styles is used in practice
+            const int maxEntries = 64;
+
+            qint64 usage = 0;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                Entry entry;
+                entry.key = key;
+                entry.icon = icon;
+
+                m_entries.prepend( entry );
+                while ( m_entries.size() > maxEntries )
+                    m_entries.removeLast();
+
+                for ( int i = 0; i < m_entries.size(); i++ )
+                    usage += entrySize( m_entries[i] );
+            }
+
+            setMemoryUsage( usage );
+            touch();
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            QMutexLocker locker( &m_mutex );
+            m_entries.clear();
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            LegendIconKey key;
+            QwtGraphic icon;
+        };
+
+        static qint64 entrySize( const Entry& entry )
+        {
+            // a rough estimation
+            return sizeof( Entry )
+                   + entry.icon.commands().size() * sizeof( QwtPainterCommand );
+        }
+
+        QMutex m_mutex;
+        QList< Entry > m_entries;
+    };
+}
+
+static LegendIconCache* qwtLegendIconCache()
+{
+    static LegendIconCache cache;
+    return &cache;
+}
+
+/*
+   Number of samples on each side of the visible range, that have an
+   effect on the visible part of a fitted curve, or -1, when
+   the curve fitter needs all samples.
+ */
+static int qwtFitMargin( const QwtCurveFitter* fitter )
+{
+    const QwtSplineCurveFitter* splineFitter =
+        dynamic_cast< const QwtSplineCurveFitter* >( fitter );
+
+    if ( splineFitter == NULL )
+        return -1;
+
+    const QwtSpline* spline = splineFitter->spline();
+    if ( spline == NULL || spline->locality() == 0
+        || spline->boundaryType() == QwtSpline::ClosedPolygon )
+    {
+        return -1;
+    }
+
+    // the boundary conditions have an effect on one more point
+    return spline->locality() + 1;
+}
+
 static void qwtUpdateLegendIconSize( QwtPlotCurve* curve )
 {
     if ( curve->symbol() &&
@@ -55,6 +317,28 @@ static void qwtUpdateLegendIconSize( QwtPlotCurve* curve )
     }
 }
 
+static inline QBrush qwtFillBrush( const QBrush& brush, const QPen& pen )
+{
+    QBrush fillBrush = brush;
+    if ( !fillBrush.color().isValid() )
+        fillBrush.setColor( pen.color() );
+
+    return fillBrush;
+}
+
+static void qwtFillPolygon( QPainter* painter,
+    const QBrush& brush, const QPolygonF& polygon )
+{
+    painter->save();
+
+    painter->setPen( Qt::NoPen );
+    painter->setBrush( brush );
+
+    QwtPainter::drawPolygon( painter, polygon );
+
+    painter->restore();
+}
+
 static int qwtVerifyRange( int size, int& i1, int& i2 )
 {
     if ( size < 1 )
@@ -69,29 +353,407 @@ static int qwtVerifyRange( int size, int& i1, int& i2 )
     return ( i2 - i1 + 1 );
 }
 
+/*
+    Reduce runs of consecutive points with the same x or the same y
+    coordinate - in place - to the first point, the points with the
+    minimum/maximum of the other coordinate and the last point.
+    As the points are on a straight line the result looks the same,
+    when painting in integer coordinates.
+ */
+static int qwtReduceRuns( QPointF* points, int numPoints )
+{
+    int numOut = 0;
+
+    int i = 0;
+    while ( i < numPoints )
+    {
+        const QPointF& p0 = points[i];
+
+        int k = i;
+        while ( k + 1 < numPoints && points[k + 1].x() == p0.x() )
+            k++;
+
+        const bool isVertical = ( k > i );
+        if ( !isVertical )
+        {
+            while ( k + 1 < numPoints && points[k + 1].y() == p0.y() )
+                k++;
+        }
+
+        if ( k == i )
+        {
+            points[numOut++] = p0;
+            i++;
+
+            continue;
+        }
+
+        // extremes of the run, without the first and the last point
+
+        int iMin = i;
+        int iMax = i;
+
+        for ( int j = i + 1; j < k; j++ )
+        {
+            const qreal v = isVertical ? points[j].y() : points[j].x();
+
+            if ( v < ( isVertical ? points[iMin].y() : points[iMin].x() ) )
+                iMin = j;
+
+            if ( v > ( isVertical ? points[iMax].y() : points[iMax].x() ) )
+                iMax = j;
+        }
+
+        const QPointF first = p0;
+        const QPointF pMin = points[iMin];
+        const QPointF pMax = points[iMax];
+
+        points[numOut++] = first;
+
+        if ( iMin < iMax )
+        {
+            if ( iMin != i )
+                points[numOut++] = pMin;
+
+            points[numOut++] = pMax;
+        }
+        else if ( iMax < iMin )
+        {
+            if ( iMax != i )
+                points[numOut++] = pMax;
+
+            points[numOut++] = pMin;
+        }
+
+        // the last point of the run starts the next one
+        i = k;
+    }
+
+    return numOut;
+}
+
+static QPolygonF qwtSamples( const QwtSeriesData< QPointF >* series )
+{
+    const int numSamples = static_cast< int >( series->size() );
+
+    QPolygonF samples( numSamples );
+
+    QPointF* points = samples.data();
+    for ( int i = 0; i < numSamples; i++ )
+        points[i] = series->sample( i );
+
+    return samples;
+}
+
+static QPolygonF qwtMappedPolygon( const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QPolygonF& polygon )
+{
+    QPolygonF mapped( polygon.size() );
+
+    const QPointF* points = polygon.constData();
+    QPointF* mappedPoints = mapped.data();
+
+    for ( int i = 0; i < polygon.size(); i++ )
+        mappedPoints[i] = QwtScaleMap::transform( xMap, yMap, points[i] );
+
+    return mapped;
+}
+
+static QPainterPath qwtMappedPath( const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QPainterPath& path )
+{
+    QPainterPath mapped = path;
+
+    for ( int i = 0; i < mapped.elementCount(); i++ )
+    {
+        const QPainterPath::Element el = mapped.elementAt( i );
+        mapped.setElementPositionAt( i, xMap.transform( el.x ), yMap.transform( el.y ) );
+    }
+
+    return mapped;
+}
+
+namespace
+{
+    class QwtPointPositionX
+    {
+      public:
+        inline double operator()( const QPointF& pos ) const
+        {
+            return pos.x();
+        }
+    };
+
+    /*
+        Drops symbols, that are hidden by the symbols painted before:
+        the canvas is divided into cells of half of the symbol size
+        and only limit symbols are painted per cell.
+     */
+    class QwtSymbolOverdrawFilter
+    {
+      public:
+        QwtSymbolOverdrawFilter( const QRectF& rect, int cellSize, int limit )
+            : m_rect( rect )
+            , m_cellSize( cellSize )
+            , m_limit( limit )
+            , m_matrix( QRect( 0, 0,
+                int( rect.width() ) / cellSize + 1, int( rect.height() ) / cellSize + 1 ) )
+        {
+            if ( m_limit > 1 )
+                m_counts.fill( 0, m_matrix.size() );
+        }
+
+        void filter( QPolygonF& points )
+        {
+            QPointF* p = points.data();
+
+            int count = 0;
+            for ( int i = 0; i < points.size(); i++ )
+            {
+                if ( isVisible( p[i] ) )
+                    p[count++] = p[i];
+            }
+
+            points.resize( count );
+        }
+
+      private:
+        inline bool isVisible( const QPointF& pos )
+        {
+            const double dx = pos.x() - m_rect.left();
+            const double dy = pos.y() - m_rect.top();
+
+            // symbols on the border are always painted
+            if ( dx < 0.0 || dy < 0.0 )
+                return true;
+
+            const int idx = m_matrix.index(
+                int( dx ) / m_cellSize, int( dy ) / m_cellSize );
+
+            if ( idx < 0 )
+                return true;
+
+            if ( m_limit == 1 )
+            {
+                if ( m_matrix.testBit( idx ) )
+                    return false;
+
+                m_matrix.setBit( idx );
+                return true;
+            }
+
+            quint8& count = m_counts[idx];
+            if ( count >= m_limit )
+                return false;
+
+            count++;
+            return true;
+        }
+
+        const QRectF m_rect;
+        const int m_cellSize;
+        const int m_limit;
+
+        QwtPixelMatrix m_matrix;
+        QVector< quint8 > m_counts;
+    };
+}
+
+static int qwtSymbolOverdrawLimit( const QwtSymbol& symbol )
+{
+    // number of symbols per cell, until the cell is covered
+
+    switch( symbol.style() )
+    {
+        case QwtSymbol::Ellipse:
+        case QwtSymbol::Rect:
+        case QwtSymbol::Diamond:
+        case QwtSymbol::Triangle:
+        case QwtSymbol::DTriangle:
+        case QwtSymbol::UTriangle:
+        case QwtSymbol::LTriangle:
+        case QwtSymbol::RTriangle:
+        case QwtSymbol::Star2:
+        case QwtSymbol::Hexagon:
+        {
+            const QBrush& brush = symbol.brush();
+            if ( brush.style() != Qt::SolidPattern )
+                break;
+
+            const int alpha = brush.color().alpha();
+            if ( alpha == 255 )
+                return 1;
+
+            if ( alpha == 0 )
+                break;
+
+            // until 99% of the cell are covered
+            const double a = alpha / 255.0;
+            const double n = std::log( 0.01 ) / std::log( 1.0 - a );
+
+            return qBound( 1, qwtCeil( n ), 255 );
+        }
+        default:
+            break;
+    }
+
+    // outlines, pixmaps, graphics
+    return 4;
+}
+
+static inline bool qwtIsSameMap( const QwtScaleMap& map1, const QwtScaleMap& map2 )
+{
+    if ( map1.s1() != map2.s1() || map1.s2() != map2.s2()
+        || map1.p1() != map2.p1() || map1.p2() != map2.p2() )
+    {
+        return false;
+    }
+
+    const QwtTransform* t1 = map1.transformation();
+    const QwtTransform* t2 = map2.transformation();
+
+    if ( t1 == NULL || t2 == NULL )
+        return t1 == t2;
+
+    return typeid( *t1 ) == typeid( *t2 );
+}
+
+namespace
+{
+    // everything, that has an effect on the mapped polyline
+    class PolylineKey
+    {
+      public:
+        PolylineKey()
+            : revision( 0 )
+            , size( 0 )
+            , from( 0 )
+            , to( -1 )
+            , flags( 0 )
+            , resolution( 0.0 )
+        {
+        }
+
+        bool operator==( const PolylineKey& other ) const
+        {
+            return revision == other.revision && size == other.size
+                && from == other.from && to == other.to
+                && flags == other.flags && resolution == other.resolution
+                && clipRect == other.clipRect
+                && qwtIsSameMap( xMap, other.xMap )
+                && qwtIsSameMap( yMap, other.yMap );
+        }
+
+        uint revision;
+        size_t size;
+
+        int from;
+        int to;
+
+        int flags;
+        double resolution;
+
+        QRectF clipRect;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+    };
+
+    class PolylineCache : public QwtCacheEntry
+    {
+      public:
+        PolylineCache()
+            : QwtCacheEntry( QwtCacheRegistry::PolylineCache )
+            , m_isValid( false )
+        {
+        }
+
+        bool find( const PolylineKey& key, QVector< QPolygonF >& parts )
+        {
+            {
+                QMutexLocker locker( &m_mutex );
+
+                if ( !( m_isValid && m_key == key ) )
+                    return false;
+
+                parts = m_parts;
+            }
+
+            touch();
+            return true;
+        }
+
+        void insert( const PolylineKey& key, const QVector< QPolygonF >& parts )
+        {
+            qint64 usage = 0;
+            for ( int i = 0; i < parts.size(); i++ )
+                usage += sizeof( QPolygonF ) + parts[i].size() * sizeof( QPointF );
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                m_key = key;
+                m_parts = parts;
+                m_isValid = true;
+            }
+
+            setMemoryUsage( usage );
+            touch();
+        }
+
+        void clear()
+        {
+            purge();
+            setMemoryUsage( 0 );
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            QMutexLocker locker( &m_mutex );
+
+            m_isValid = false;
+            m_parts.clear();
+            m_key = PolylineKey();
+        }
+
+      private:
+        QMutex m_mutex;
+
+        bool m_isValid;
+        PolylineKey m_key;
+        QVector< QPolygonF > m_parts;
+    };
+}
+
 class QwtPlotCurve::PrivateData
 {
   public:
     PrivateData()
         : style( QwtPlotCurve::Lines )
         , baseline( 0.0 )
-        , symbol( NULL )
         , pen( Qt::black )
         , paintAttributes( QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints )
+        , spatialIndex( NULL )
+        , densityColorMap( NULL )
+        , hasFittedPolygon( false )
+        , hasFittedPath( false )
+        , dataRevision( 0 )
     {
         curveFitter = new QwtSplineCurveFitter;
     }
 
     ~PrivateData()
     {
-        delete symbol;
         delete curveFitter;
+        delete spatialIndex;
+        delete densityColorMap;
     }
 
     QwtPlotCurve::CurveStyle style;
     double baseline;
 
-    const QwtSymbol* symbol;
+    QSharedPointer< const QwtSymbol > symbol;
     QwtCurveFitter* curveFitter;
 
     QPen pen;
@@ -101,6 +763,28 @@ class QwtPlotCurve::PrivateData
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    QwtPointSpatialIndex* spatialIndex;
+    QwtColorMap* densityColorMap;
+
+    void invalidateFit()
+    {
+        hasFittedPolygon = hasFittedPath = false;
+
+        fittedPolygon.clear();
+        fittedPath = QPainterPath();
+    }
+
+    // results of the curve fitter in scale coordinates
+    bool hasFittedPolygon;
+    QPolygonF fittedPolygon;
+
+    bool hasFittedPath;
+    QPainterPath fittedPath;
+
+    // incremented by dataChanged()
+    uint dataRevision;
+    PolylineCache polylineCache;
 };
 
 /*!
@@ -160,6 +844,12 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         m_data->paintAttributes |= attribute;
     else
         m_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CacheFittedCurve )
+        m_data->invalidateFit();
+
+    if ( attribute == CachePolyline && !on )
+        m_data->polylineCache.clear();
 }
 
 /*!
@@ -240,7 +930,7 @@ void QwtPlotCurve::setStyle( CurveStyle style )
         m_data->style = style;
 
         legendChanged();
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -264,16 +954,30 @@ QwtPlotCurve::CurveStyle QwtPlotCurve::style() const
    \sa symbol()
  */
 void QwtPlotCurve::setSymbol( QwtSymbol* symbol )
+{
+    if ( symbol != m_data->symbol.data() )
+        setSymbol( QSharedPointer< const QwtSymbol >( symbol ) );
+}
+
+/*!
+   \brief Assign a symbol, that might be shared with other items
+
+   Curves with the same symbol can share one instance - including
+   its cache - instead of having individual copies.
+
+   \param symbol Symbol
+   \sa symbol()
+ */
+void QwtPlotCurve::setSymbol( const QSharedPointer< const QwtSymbol >& symbol )
 {
     if ( symbol != m_data->symbol )
     {
-        delete m_data->symbol;
         m_data->symbol = symbol;
 
         qwtUpdateLegendIconSize( this );
 
         legendChanged();
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -283,7 +987,7 @@ void QwtPlotCurve::setSymbol( QwtSymbol* symbol )
  */
 const QwtSymbol* QwtPlotCurve::symbol() const
 {
-    return m_data->symbol;
+    return m_data->symbol.data();
 }
 
 /*!
@@ -317,7 +1021,7 @@ void QwtPlotCurve::setPen( const QPen& pen )
         m_data->pen = pen;
 
         legendChanged();
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -352,7 +1056,7 @@ void QwtPlotCurve::setBrush( const QBrush& brush )
         m_data->brush = brush;
 
         legendChanged();
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -392,6 +1096,63 @@ void QwtPlotCurve::drawSeries( QPainter* painter,
 
     if ( qwtVerifyRange( numSamples, from, to ) > 0 )
     {
+        const bool ordered = testSeriesAttribute( QwtPlotSeriesItem::OrderedSamples )
+            || data()->isMonotonic();
+
+        /*
+            Fitting local splines can be restricted to the visible samples
+            plus the neighbours, that have an effect on them.
+            The cached fit is always done for all samples.
+         */
+        int fitMargin = 0;
+        if ( testCurveAttribute( Fitted ) )
+        {
+            fitMargin = -1;
+            if ( !testPaintAttribute( CacheFittedCurve ) )
+                fitMargin = qwtFitMargin( m_data->curveFitter );
+        }
+
+        if ( ordered && fitMargin >= 0 )
+        {
+            // only the samples inside of the canvas, plus 1 on each side
+
+            double margin = QwtPainter::effectivePenWidth( m_data->pen );
+            if ( m_data->symbol )
+            {
+                const QSize sz = m_data->symbol->size();
+                margin += 0.5 * qMax( sz.width(), sz.height() );
+            }
+
+            const double x1 = xMap.invTransform( canvasRect.left() - margin );
+            const double x2 = xMap.invTransform( canvasRect.right() + margin );
+
+            const int from0 = from;
+            const int to0 = to;
+
+            const QwtAbstractUniformData* uniformData =
+                dynamic_cast< const QwtAbstractUniformData* >( data() );
+
+            if ( uniformData )
+            {
+                // O(1) for equidistant samples
+
+                int i1, i2;
+                if ( uniformData->indexRange( x1, x2, i1, i2 ) )
+                {
+                    from = qMax( i1, from0 );
+                    to = qMin( i2, to0 );
+                }
+            }
+            else
+            {
+                qwtClipSampleRange( *data(), qMin( x1, x2 ), qMax( x1, x2 ),
+                    QwtPointPositionX(), from, to );
+            }
+
+            from = qMax( from - fitMargin, from0 );
+            to = qMin( to + fitMargin, to0 );
+        }
+
         painter->save();
         painter->setPen( m_data->pen );
 
@@ -430,16 +1191,39 @@ void QwtPlotCurve::drawCurve( QPainter* painter, int style,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& canvasRect, int from, int to ) const
 {
+    if ( ( style == Lines ) && testCurveAttribute( Fitted ) )
+    {
+        // we always need the complete
+        // curve for fitting
+        from = 0;
+        to = dataSize() - 1;
+    }
+
+    if ( ( m_data->attributes & BreakAtGaps )
+        && ( style == Lines || style == Steps )
+        && !qwtBreaksWhileMapping( this, style ) )
+    {
+        const QwtSeriesData< QPointF >* series = data();
+
+        int i = qwtSkipGaps( *series, from, to );
+        while ( i <= to )
+        {
+            const int last = qwtFindGap( *series, i, to ) - 1;
+
+            if ( style == Lines )
+                drawLines( painter, xMap, yMap, canvasRect, i, last );
+            else
+                drawSteps( painter, xMap, yMap, canvasRect, i, last );
+
+            i = qwtSkipGaps( *series, last + 1, to );
+        }
+
+        return;
+    }
+
     switch ( style )
     {
         case Lines:
-            if ( testCurveAttribute( Fitted ) )
-            {
-                // we always need the complete
-                // curve for fitting
-                from = 0;
-                to = dataSize() - 1;
-            }
             drawLines( painter, xMap, yMap, canvasRect, from, to );
             break;
         case Sticks:
@@ -463,6 +1247,14 @@ void QwtPlotCurve::drawCurve( QPainter* painter, int style,
    If the CurveAttribute Fitted is enabled a QwtCurveFitter tries
    to interpolate/smooth the curve, before it is painted.
 
+   When the data is a QwtSeriesDataPyramid with increasing x coordinates
+   and the curve is painted to a paint device with integer coordinates,
+   only the first, minimum, maximum and last sample of each pixel column
+   are mapped.
+
+   For paint devices without integer coordinates ( PDF, SVG ) the same
+   reduction is done for the columns of QwtPainter::vectorResolution().
+
    \param painter Painter
    \param xMap x map
    \param yMap y map
@@ -471,7 +1263,8 @@ void QwtPlotCurve::drawCurve( QPainter* painter, int style,
    \param to index of the last point to be painted
 
    \sa setCurveAttribute(), setCurveFitter(), draw(),
-      drawLines(), drawDots(), drawSteps(), drawSticks()
+      drawLines(), drawDots(), drawSteps(), drawSticks(),
+      QwtPlotRenderer::setExportResolution()
  */
 void QwtPlotCurve::drawLines( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -488,28 +1281,157 @@ void QwtPlotCurve::drawLines( QPainter* painter,
     QRectF clipRect;
     if ( m_data->paintAttributes & ClipPolygons )
     {
-        clipRect = qwtIntersectedClipRect( canvasRect, painter );
+        clipRect = qwtIntersectedClipRect( canvasRect, painter );
+
+        const qreal pw = QwtPainter::effectivePenWidth( painter->pen() );
+        clipRect = clipRect.adjusted(-pw, -pw, pw, pw);
+    }
+
+    /*
+        The cache is for the complete curve, not for the runs between gaps
+        or the range of samples of an incremental painting - f.e. by
+        QwtPlotDirectPainter.
+     */
+    const bool isComplete = ( from == 0 ) && ( to == int( dataSize() ) - 1 );
+
+    if ( doFit && isComplete && ( m_data->paintAttributes & CacheFittedCurve )
+        && !( m_data->attributes & BreakAtGaps ) )
+    {
+        drawFittedCache( painter, xMap, yMap, canvasRect, clipRect, doFill );
+        return;
+    }
+
+    // for vector devices with an export resolution, see QwtPlotRenderer
+    const double resolution = ( doFit || doAlign )
+        ? 0.0 : QwtPainter::vectorResolution( painter );
+
+    QwtPointMapper mapper;
+
+    if ( doAlign )
+    {
+        mapper.setFlag( QwtPointMapper::RoundPoints, true );
+        mapper.setFlag( QwtPointMapper::WeedOutIntermediatePoints,
+            qwtFilterAggressive( this ) );
+    }
+
+    mapper.setResolution( resolution );
+
+    mapper.setFlag( QwtPointMapper::WeedOutPoints,
+        testPaintAttribute( FilterPoints ) || qwtFilterAggressive( this ) );
+
+    mapper.setFlag( QwtPointMapper::BreakAtGaps,
+        testCurveAttribute( BreakAtGaps ) );
+
+    if ( testPaintAttribute( ParallelMapping ) )
+    {
+        mapper.setFlag( QwtPointMapper::ParallelMapping, true );
+        mapper.setRenderThreadCount( renderThreadCount() );
+    }
+
+    const QwtSeriesData< QPointF >* series = data();
+
+    if ( !doFit && !( testSeriesAttribute( QwtPlotSeriesItem::OrderedSamples )
+        || series->isMonotonic() ) )
+    {
+        // samples in random order: drop those, that can't be visible,
+        // before mapping them. The rectangle includes the pen width
+
+        const qreal pw = QwtPainter::effectivePenWidth( painter->pen() );
+
+        mapper.setFlag( QwtPointMapper::CullSamples, true );
+        mapper.setBoundingRect( canvasRect.adjusted( -pw, -pw, pw, pw ) );
+    }
+    else
+    {
+        mapper.setBoundingRect( canvasRect );
+    }
+
+    const QwtSeriesDataPyramid* pyramid = ( doAlign || resolution > 0.0 )
+        ? dynamic_cast< const QwtSeriesDataPyramid* >( series ) : NULL;
+
+    QwtPointSeriesData reduced;
+
+    if ( pyramid && pyramid->isMonotonic() )
+    {
+        // reducing the samples to first/min/max/last of each pixel column
+
+        QwtScaleMap columnMap = xMap;
+        if ( resolution > 0.0 )
+        {
+            columnMap.setPaintInterval(
+                xMap.p1() * resolution, xMap.p2() * resolution );
+        }
+
+        reduced.setSamples( pyramid->reducedSamples( columnMap, from, to ) );
+        if ( reduced.size() == 0 )
+            return;
+
+        series = &reduced;
+        from = 0;
+        to = int( reduced.size() ) - 1;
+    }
+
+    if ( !doFit && ( m_data->paintAttributes & ImageBuffer )
+        && QwtLineRasterizer::isSupported( painter ) )
+    {
+        QPolygonF polyline = mapper.toPolygonF( xMap, yMap, series, from, to );
+
+        if ( doFill )
+        {
+            // one clip pass for the filled area and the outline
+
+            if ( m_data->paintAttributes & ClipPolygons )
+                QwtClipper::clipPolygonF( clipRect, polyline, false );
+
+            fillPolyline( painter, xMap, yMap, clipRect, polyline );
+        }
+
+        QwtLineRasterizer::draw( painter, canvasRect,
+            polyline.constData(), polyline.size(),
+            QwtLineRasterizer::Polyline, renderThreadCount() );
+
+        QwtScratchPool::release( polyline );
+        return;
+    }
+
+    if ( !doFill && !doFit )
+    {
+        if ( m_data->paintAttributes & CachePolyline )
+        {
+            PolylineKey key;
+            key.revision = m_data->dataRevision;
+            key.size = series->size();
+            key.from = from;
+            key.to = to;
+            key.flags = int( mapper.flags() );
+            key.resolution = resolution;
+            key.clipRect = clipRect;
+            key.xMap = xMap;
+            key.yMap = yMap;
+
+            QVector< QPolygonF > parts;
+            if ( !m_data->polylineCache.find( key, parts ) )
+            {
+                parts = mapper.toClippedPolylines(
+                    clipRect, xMap, yMap, series, from, to );
 
-        const qreal pw = QwtPainter::effectivePenWidth( painter->pen() );
-        clipRect = clipRect.adjusted(-pw, -pw, pw, pw);
-    }
+                m_data->polylineCache.insert( key, parts );
+            }
 
-    QwtPointMapper mapper;
+            for ( int i = 0; i < parts.size(); i++ )
+                QwtPainter::drawPolyline( painter, parts[i] );
 
-    if ( doAlign )
-    {
-        mapper.setFlag( QwtPointMapper::RoundPoints, true );
-        mapper.setFlag( QwtPointMapper::WeedOutIntermediatePoints,
-            testPaintAttribute( FilterPointsAggressive ) );
-    }
+            return;
+        }
 
-    mapper.setFlag( QwtPointMapper::WeedOutPoints,
-        testPaintAttribute( FilterPoints ) ||
-        testPaintAttribute( FilterPointsAggressive ) );
+        // mapping, weeding and clipping in one pass, without
+        // materializing the unclipped polyline
 
-    mapper.setBoundingRect( canvasRect );
+        mapper.drawPolyline( painter, clipRect, xMap, yMap, series, from, to );
+        return;
+    }
 
-    QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+    QPolygonF polyline = mapper.toPolygonF( xMap, yMap, series, from, to );
 
     if ( doFill )
     {
@@ -524,16 +1446,13 @@ void QwtPlotCurve::drawLines( QPainter* painter,
 
         if ( painter->pen().style() != Qt::NoPen )
         {
-            // here we are wasting memory for the filled copy,
-            // do polygon clipping twice etc .. TODO
-
-            QPolygonF filled = polyline;
-            fillCurve( painter, xMap, yMap, canvasRect, filled );
-            filled.clear();
+            // the filled area and the outline share the mapped
+            // polyline and one clip pass
 
             if ( m_data->paintAttributes & ClipPolygons )
                 QwtClipper::clipPolygonF( clipRect, polyline, false );
 
+            fillPolyline( painter, xMap, yMap, clipRect, polyline );
             QwtPainter::drawPolyline( painter, polyline );
         }
         else
@@ -543,30 +1462,103 @@ void QwtPlotCurve::drawLines( QPainter* painter,
     }
     else
     {
+        // each visible part is fitted on its own, without
+        // runs along the border of the clip rectangle
+
+        QVector< QPolygonF > parts;
         if ( testPaintAttribute( ClipPolygons ) )
-        {
-            QwtClipper::clipPolygonF( clipRect, polyline, false );
-        }
+            parts = QwtClipper::clippedPolyline( clipRect, polyline );
+        else
+            parts += polyline;
 
-        if ( doFit )
+        for ( int i = 0; i < parts.size(); i++ )
         {
             if ( m_data->curveFitter->mode() == QwtCurveFitter::Path )
             {
                 const QPainterPath curvePath =
-                    m_data->curveFitter->fitCurvePath( polyline );
+                    m_data->curveFitter->fitCurvePath( parts[i] );
 
                 painter->drawPath( curvePath );
             }
             else
             {
-                polyline = m_data->curveFitter->fitCurve( polyline );
-                QwtPainter::drawPolyline( painter, polyline );
+                const QPolygonF fitted = m_data->curveFitter->fitCurve( parts[i] );
+                QwtPainter::drawPolyline( painter, fitted );
             }
         }
-        else
+    }
+
+    QwtScratchPool::release( polyline );
+}
+
+/*!
+   Draw the cached result of the curve fitter
+
+   The samples are fitted in scale coordinates, when there is no
+   cached result. Then the cached curve is mapped into paint
+   device coordinates.
+
+   \param painter Painter
+   \param xMap x map
+   \param yMap y map
+   \param canvasRect Contents rectangle of the canvas
+   \param clipRect Rectangle for clipping the polygon, or an invalid
+                   rectangle, when clipping is disabled
+   \param doFill Fill the area between curve and baseline
+
+   \sa CacheFittedCurve, drawLines()
+ */
+void QwtPlotCurve::drawFittedCache( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, const QRectF& clipRect, bool doFill ) const
+{
+    const QwtCurveFitter* fitter = m_data->curveFitter;
+
+    if ( doFill || fitter->mode() == QwtCurveFitter::Polygon )
+    {
+        if ( !m_data->hasFittedPolygon )
         {
-            QwtPainter::drawPolyline( painter, polyline );
+            m_data->fittedPolygon = fitter->fitCurve( qwtSamples( data() ) );
+            m_data->hasFittedPolygon = true;
+        }
+
+        QPolygonF polyline = qwtMappedPolygon( xMap, yMap, m_data->fittedPolygon );
+
+        if ( doFill )
+        {
+            if ( painter->pen().style() == Qt::NoPen )
+            {
+                fillCurve( painter, xMap, yMap, canvasRect, polyline );
+                return;
+            }
+
+            if ( clipRect.isValid() )
+                QwtClipper::clipPolygonF( clipRect, polyline, false );
+
+            fillPolyline( painter, xMap, yMap, clipRect, polyline );
+        }
+        else if ( clipRect.isValid() )
+        {
+            const QVector< QPolygonF > parts =
+                QwtClipper::clippedPolyline( clipRect, polyline );
+
+            for ( int i = 0; i < parts.size(); i++ )
+                QwtPainter::drawPolyline( painter, parts[i] );
+
+            return;
+        }
+
+        QwtPainter::drawPolyline( painter, polyline );
+    }
+    else
+    {
+        if ( !m_data->hasFittedPath )
+        {
+            m_data->fittedPath = fitter->fitCurvePath( qwtSamples( data() ) );
+            m_data->hasFittedPath = true;
         }
+
+        painter->drawPath( qwtMappedPath( xMap, yMap, m_data->fittedPath ) );
     }
 }
 
@@ -586,8 +1578,6 @@ void QwtPlotCurve::drawSticks( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& canvasRect, int from, int to ) const
 {
-    Q_UNUSED( canvasRect )
-
     painter->save();
     painter->setRenderHint( QPainter::Antialiasing, false );
 
@@ -605,21 +1595,149 @@ void QwtPlotCurve::drawSticks( QPainter* painter,
 
     const QwtSeriesData< QPointF >* series = data();
 
-    for ( int i = from; i <= to; i++ )
+    const QPolygonF fitted = fittedPoints( xMap, yMap, doAlign, from, to );
+    if ( !fitted.isEmpty() )
     {
-        const QPointF sample = series->sample( i );
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
+        from = 0;
+        to = fitted.size() - 1;
+    }
+
+    const bool doRasterize = ( m_data->paintAttributes & ImageBuffer )
+        && QwtLineRasterizer::isSupported( painter );
+
+    /*
+        Sticks being mapped to the same pixel column ( or row )
+        overlap. They are reduced to one stick covering all of them.
+     */
+    const bool doReduce = doAlign && fitted.isEmpty()
+        && qwtFilterAggressive( this );
+
+    QPolygonF lines;
+    if ( doRasterize )
+        QwtScratchPool::acquire( lines, 2 * ( to - from + 1 ) );
+
+    int numLines = 0;
+
+    if ( doReduce )
+    {
+        const double v0 = ( o == Qt::Horizontal ) ? x0 : y0;
+
+        double pos = 0.0;
+        double vMin = 0.0;
+        double vMax = 0.0;
+
+        for ( int i = from; i <= to + 1; i++ )
         {
-            xi = qRound( xi );
-            yi = qRound( yi );
+            double p = 0.0;
+            double v = 0.0;
+
+            if ( i <= to )
+            {
+                const QPointF sample = series->sample( i );
+
+                const double xi = qRound( xMap.transform( sample.x() ) );
+                const double yi = qRound( yMap.transform( sample.y() ) );
+
+                p = ( o == Qt::Horizontal ) ? yi : xi;
+                v = ( o == Qt::Horizontal ) ? xi : yi;
+
+                if ( i > from && p == pos )
+                {
+                    vMin = qMin( vMin, v );
+                    vMax = qMax( vMax, v );
+
+                    continue;
+                }
+            }
+
+            if ( i > from )
+            {
+                QPointF p1, p2;
+                if ( o == Qt::Horizontal )
+                {
+                    p1 = QPointF( vMin, pos );
+                    p2 = QPointF( vMax, pos );
+                }
+                else
+                {
+                    p1 = QPointF( pos, vMin );
+                    p2 = QPointF( pos, vMax );
+                }
+
+                if ( doRasterize )
+                {
+                    QPointF* points = lines.data() + 2 * numLines;
+                    points[0] = p1;
+                    points[1] = p2;
+                }
+                else
+                {
+                    QwtPainter::drawLine( painter, p1, p2 );
+                }
+
+                numLines++;
+            }
+
+            // the stick from the baseline to the value
+
+            pos = p;
+            vMin = qMin( v0, v );
+            vMax = qMax( v0, v );
         }
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            double xi, yi;
 
-        if ( o == Qt::Horizontal )
-            QwtPainter::drawLine( painter, x0, yi, xi, yi );
-        else
-            QwtPainter::drawLine( painter, xi, y0, xi, yi );
+            if ( !fitted.isEmpty() )
+            {
+                xi = fitted[i].x();
+                yi = fitted[i].y();
+            }
+            else
+            {
+                const QPointF sample = series->sample( i );
+                xi = xMap.transform( sample.x() );
+                yi = yMap.transform( sample.y() );
+                if ( doAlign )
+                {
+                    xi = qRound( xi );
+                    yi = qRound( yi );
+                }
+            }
+
+            if ( doRasterize )
+            {
+                QPointF* points = lines.data() + 2 * numLines;
+
+                if ( o == Qt::Horizontal )
+                    points[0] = QPointF( x0, yi );
+                else
+                    points[0] = QPointF( xi, y0 );
+
+                points[1] = QPointF( xi, yi );
+            }
+            else
+            {
+                if ( o == Qt::Horizontal )
+                    QwtPainter::drawLine( painter, x0, yi, xi, yi );
+                else
+                    QwtPainter::drawLine( painter, xi, y0, xi, yi );
+            }
+
+            numLines++;
+        }
+    }
+
+    if ( doRasterize )
+    {
+        QwtLineRasterizer::draw( painter, canvasRect,
+            lines.constData(), 2 * numLines,
+            QwtLineRasterizer::LinePairs, renderThreadCount() );
+
+        QwtScratchPool::release( lines );
     }
 
     painter->restore();
@@ -656,7 +1774,7 @@ void QwtPlotCurve::drawDots( QPainter* painter,
     mapper.setBoundingRect( canvasRect );
     mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
 
-    if ( m_data->paintAttributes & FilterPoints )
+    if ( testPaintAttribute( FilterPoints ) || qwtFilterAggressive( this ) )
     {
         if ( ( color.alpha() == 255 )
             && !( painter->renderHints() & QPainter::Antialiasing ) )
@@ -677,10 +1795,21 @@ void QwtPlotCurve::drawDots( QPainter* painter,
     }
     else if ( m_data->paintAttributes & ImageBuffer )
     {
-        const QImage image = mapper.toImage( xMap, yMap,
-            data(), from, to, m_data->pen,
-            painter->testRenderHint( QPainter::Antialiasing ),
-            renderThreadCount() );
+        QImage image;
+
+        if ( m_data->densityColorMap )
+        {
+            image = mapper.toDensityImage( xMap, yMap,
+                data(), from, to, *m_data->densityColorMap,
+                renderThreadCount() );
+        }
+        else
+        {
+            image = mapper.toImage( xMap, yMap,
+                data(), from, to, m_data->pen,
+                painter->testRenderHint( QPainter::Antialiasing ),
+                renderThreadCount() );
+        }
 
         painter->drawImage( canvasRect.toAlignedRect(), image );
     }
@@ -744,7 +1873,16 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
 {
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    QPolygonF polygon( 2 * ( to - from ) + 1 );
+    const QPolygonF fitted = fittedPoints( xMap, yMap, doAlign, from, to );
+    if ( !fitted.isEmpty() )
+    {
+        from = 0;
+        to = fitted.size() - 1;
+    }
+
+    QPolygonF polygon;
+    QwtScratchPool::acquire( polygon, 2 * ( to - from ) + 1 );
+
     QPointF* points = polygon.data();
 
     bool inverted = orientation() == Qt::Vertical;
@@ -756,13 +1894,23 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
     int i, ip;
     for ( i = from, ip = 0; i <= to; i++, ip += 2 )
     {
-        const QPointF sample = series->sample( i );
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
+        double xi, yi;
+
+        if ( !fitted.isEmpty() )
         {
-            xi = qRound( xi );
-            yi = qRound( yi );
+            xi = fitted[i].x();
+            yi = fitted[i].y();
+        }
+        else
+        {
+            const QPointF sample = series->sample( i );
+            xi = xMap.transform( sample.x() );
+            yi = yMap.transform( sample.y() );
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
         }
 
         if ( ip > 0 )
@@ -786,7 +1934,24 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
         points[ip].ry() = yi;
     }
 
-    if ( m_data->paintAttributes & ClipPolygons )
+    if ( doAlign && fitted.isEmpty() && qwtFilterAggressive( this ) )
+    {
+        /*
+            Many transitions inside of the same pixel column ( or row )
+            are reduced to one vertical ( or horizontal ) line,
+            that covers all of them. The edges are preserved.
+         */
+        polygon.resize( qwtReduceRuns( points, polygon.size() ) );
+    }
+
+    if ( ( m_data->paintAttributes & ImageBuffer )
+        && QwtLineRasterizer::isSupported( painter ) )
+    {
+        QwtLineRasterizer::draw( painter, canvasRect,
+            polygon.constData(), polygon.size(),
+            QwtLineRasterizer::Polyline, renderThreadCount() );
+    }
+    else if ( m_data->paintAttributes & ClipPolygons )
     {
         QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
 
@@ -805,8 +1970,42 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
 
     if ( m_data->brush.style() != Qt::NoBrush )
         fillCurve( painter, xMap, yMap, canvasRect, polygon );
+
+    QwtScratchPool::release( polygon );
 }
 
+/*!
+   \brief Map and fit the points of Steps and Sticks
+
+   When the Fitted attribute is enabled and the curve fitter creates a
+   polygon - like QwtDownsamplingCurveFitter or QwtWeedingCurveFitter -
+   the points are fitted before the steps or sticks are built from them.
+
+   \param xMap x map
+   \param yMap y map
+   \param doAlign Round the mapped points to integers
+   \param from index of the first point to be painted
+   \param to index of the last point to be painted
+
+   \return Fitted points in paint device coordinates, or an empty polygon,
+           when the points are not fitted
+ */
+QPolygonF QwtPlotCurve::fittedPoints(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    bool doAlign, int from, int to ) const
+{
+    if ( !( m_data->attributes & Fitted ) || m_data->curveFitter == NULL
+        || m_data->curveFitter->mode() != QwtCurveFitter::Polygon )
+    {
+        return QPolygonF();
+    }
+
+    QwtPointMapper mapper;
+    mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+
+    const QPolygonF points = mapper.toPolygonF( xMap, yMap, data(), from, to );
+    return m_data->curveFitter->fitCurve( points );
+}
 
 /*!
    Specify an attribute for drawing the curve
@@ -826,7 +2025,7 @@ void QwtPlotCurve::setCurveAttribute( CurveAttribute attribute, bool on )
     else
         m_data->attributes &= ~attribute;
 
-    itemChanged();
+    itemChanged( QwtPlotItem::StyleChange );
 }
 
 /*!
@@ -860,7 +2059,9 @@ void QwtPlotCurve::setCurveFitter( QwtCurveFitter* curveFitter )
     delete m_data->curveFitter;
     m_data->curveFitter = curveFitter;
 
-    itemChanged();
+    m_data->invalidateFit();
+
+    itemChanged( QwtPlotItem::StyleChange );
 }
 
 /*!
@@ -874,6 +2075,42 @@ QwtCurveFitter* QwtPlotCurve::curveFitter() const
     return m_data->curveFitter;
 }
 
+/*!
+   \brief Assign a color map for displaying the density of Dots
+
+   When the ImageBuffer paint attribute is set, a curve of Dots style
+   is rendered by counting the points, that are mapped to each pixel.
+   The counts are translated into colors by the color map - using
+   the interval [ 1, maximum count ].
+
+   This way overlapping points of huge scatter plots can be told apart.
+   The pen has no effect on the image, but needs to be visible.
+
+   \param colorMap Color map, that is deleted by the curve.
+                   NULL disables the density mode.
+
+   \sa densityColorMap(), ImageBuffer, QwtPointMapper::toDensityImage()
+ */
+void QwtPlotCurve::setDensityColorMap( QwtColorMap* colorMap )
+{
+    if ( colorMap != m_data->densityColorMap )
+    {
+        delete m_data->densityColorMap;
+        m_data->densityColorMap = colorMap;
+
+        itemChanged( QwtPlotItem::StyleChange );
+    }
+}
+
+/*!
+   \return Color map for displaying the density of Dots
+   \sa setDensityColorMap()
+ */
+const QwtColorMap* QwtPlotCurve::densityColorMap() const
+{
+    return m_data->densityColorMap;
+}
+
 /*!
    Fill the area between the curve and the baseline with
    the curve brush
@@ -897,24 +2134,62 @@ void QwtPlotCurve::fillCurve( QPainter* painter,
     if ( polygon.count() <= 2 ) // a line can't be filled
         return;
 
-    QBrush brush = m_data->brush;
-    if ( !brush.color().isValid() )
-        brush.setColor( m_data->pen.color() );
-
     if ( m_data->paintAttributes & ClipPolygons )
     {
         const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
         QwtClipper::clipPolygonF( clipRect, polygon, true );
     }
 
-    painter->save();
+    qwtFillPolygon( painter,
+        qwtFillBrush( m_data->brush, m_data->pen ), polygon );
+}
 
-    painter->setPen( Qt::NoPen );
-    painter->setBrush( brush );
+/*!
+   Fill the area between a polyline and the baseline
 
-    QwtPainter::drawPolygon( painter, polygon );
+   Unlike fillCurve() the polyline is closed by appending the baseline
+   points temporarily, so that the outline can be painted from the same
+   buffer afterwards - without copying it.
 
-    painter->restore();
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param clipRect Rectangle, the polyline has already been clipped to.
+                   An invalid rectangle, when the polyline is not clipped.
+   \param polyline Polyline, that is unmodified on return
+
+   \sa fillCurve(), closePolyline()
+ */
+void QwtPlotCurve::fillPolyline( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& clipRect, QPolygonF& polyline ) const
+{
+    if ( m_data->brush.style() == Qt::NoBrush )
+        return;
+
+    const int numPoints = polyline.size();
+
+    closePolyline( painter, xMap, yMap, polyline );
+
+    if ( polyline.size() > 2 )
+    {
+        if ( clipRect.isValid() )
+        {
+            // the baseline might be far outside
+
+            for ( int i = numPoints; i < polyline.size(); i++ )
+            {
+                QPointF& pos = polyline[i];
+                pos.setX( qBound( clipRect.left(), pos.x(), clipRect.right() ) );
+                pos.setY( qBound( clipRect.top(), pos.y(), clipRect.bottom() ) );
+            }
+        }
+
+        qwtFillPolygon( painter,
+            qwtFillBrush( m_data->brush, m_data->pen ), polyline );
+    }
+
+    polyline.resize( numPoints );
 }
 
 /*!
@@ -966,6 +2241,9 @@ void QwtPlotCurve::closePolyline( QPainter* painter,
 /*!
    Draw symbols
 
+   With FilterSymbols symbols, that would be covered by symbols
+   painted before, are dropped.
+
    \param painter Painter
    \param symbol Curve symbol
    \param xMap x map
@@ -989,18 +2267,33 @@ void QwtPlotCurve::drawSymbols( QPainter* painter, const QwtSymbol& symbol,
     const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
     mapper.setBoundingRect( clipRect );
 
+    QwtSymbolOverdrawFilter* overdrawFilter = NULL;
+    if ( testPaintAttribute( QwtPlotCurve::FilterSymbols ) )
+    {
+        const QSize sz = symbol.size();
+
+        overdrawFilter = new QwtSymbolOverdrawFilter( clipRect,
+            qMax( qMin( sz.width(), sz.height() ) / 2, 1 ),
+            qwtSymbolOverdrawLimit( symbol ) );
+    }
+
     const int chunkSize = 500;
 
     for ( int i = from; i <= to; i += chunkSize )
     {
         const int n = qMin( chunkSize, to - i + 1 );
 
-        const QPolygonF points = mapper.toPointsF( xMap, yMap,
+        QPolygonF points = mapper.toPointsF( xMap, yMap,
             data(), i, i + n - 1 );
 
+        if ( overdrawFilter )
+            overdrawFilter->filter( points );
+
         if ( points.size() > 0 )
             symbol.drawSymbols( painter, points );
     }
+
+    delete overdrawFilter;
 }
 
 /*!
@@ -1024,7 +2317,7 @@ void QwtPlotCurve::setBaseline( double value )
     if ( m_data->baseline != value )
     {
         m_data->baseline = value;
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -1045,8 +2338,10 @@ double QwtPlotCurve::baseline() const
               the position and the closest curve point
    \return Index of the closest curve point, or -1 if none can be found
           ( f.e when the curve has no points )
-   \note closestPoint() implements a dumb algorithm, that iterates
-        over all points
+   \note Without a spatial index closestPoint() implements a dumb algorithm,
+         that iterates over all points
+
+   \sa setSpatialIndexEnabled()
  */
 int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
 {
@@ -1060,21 +2355,37 @@ int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
     const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
     const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
 
+    if ( m_data->spatialIndex )
+        return m_data->spatialIndex->closestPoint( series, xMap, yMap, pos, dist );
+
     int index = -1;
     double dmin = 1.0e10;
 
-    for ( uint i = 0; i < numSamples; i++ )
+    // mapping the samples in chunks, so that the
+    // vectorized transformation can be used
+
+    const size_t chunkSize = 512;
+    QPointF points[ chunkSize ];
+
+    for ( size_t i0 = 0; i0 < numSamples; i0 += chunkSize )
     {
-        const QPointF sample = series->sample( i );
+        const size_t n = qMin( chunkSize, numSamples - i0 );
 
-        const double cx = xMap.transform( sample.x() ) - pos.x();
-        const double cy = yMap.transform( sample.y() ) - pos.y();
+        series->fetch( i0, n, points );
 
-        const double f = qwtSqr( cx ) + qwtSqr( cy );
-        if ( f < dmin )
+        QwtScaleMap::transform( xMap, yMap, points, points, n );
+
+        for ( size_t j = 0; j < n; j++ )
         {
-            index = i;
-            dmin = f;
+            const double cx = points[j].x() - pos.x();
+            const double cy = points[j].y() - pos.y();
+
+            const double f = qwtSqr( cx ) + qwtSqr( cy );
+            if ( f < dmin )
+            {
+                index = int( i0 + j );
+                dmin = f;
+            }
         }
     }
     if ( dist )
@@ -1083,6 +2394,63 @@ int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
     return index;
 }
 
+/*!
+   \brief En/Disable a spatial index for closestPoint()
+
+   With an index closestPoint() finds the closest point without iterating
+   over all samples. For series with increasing x coordinates a binary
+   search is used, for all other series a k-d tree is built, that
+   needs additional memory for each sample.
+
+   The index is built, when it is needed the first time, and is
+   invalidated by dataChanged(). When modifying the samples of the series
+   without notifying the curve ( f.e by QwtPointAppendSeriesData::setSample() )
+   dataChanged() has to be called manually.
+
+   The spatial index is disabled by default.
+
+   \param on On/Off
+   \sa isSpatialIndexEnabled(), closestPoint(), QwtPointSpatialIndex
+ */
+void QwtPlotCurve::setSpatialIndexEnabled( bool on )
+{
+    if ( on == ( m_data->spatialIndex != NULL ) )
+        return;
+
+    if ( on )
+    {
+        m_data->spatialIndex = new QwtPointSpatialIndex();
+    }
+    else
+    {
+        delete m_data->spatialIndex;
+        m_data->spatialIndex = NULL;
+    }
+}
+
+/*!
+   \return True, when closestPoint() uses a spatial index
+   \sa setSpatialIndexEnabled()
+ */
+bool QwtPlotCurve::isSpatialIndexEnabled() const
+{
+    return m_data->spatialIndex != NULL;
+}
+
+//! Invalidate the spatial index, when the samples have been changed
+void QwtPlotCurve::dataChanged()
+{
+    if ( m_data->spatialIndex )
+        m_data->spatialIndex->invalidate();
+
+    m_data->invalidateFit();
+
+    m_data->dataRevision++;
+    m_data->polylineCache.clear();
+
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
    \return Icon representing the curve on the legend
 
@@ -1090,6 +2458,11 @@ int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
                 ( ignored as there is only one )
    \param size Icon size
 
+   \note Icons of curves with the same pen, brush, symbol, size and
+         legend attributes are shared, so that changing the samples
+         doesn't render the icon again. Curves with symbols, that
+         are not one of the built-in styles of QwtSymbol, are not cached.
+
    \sa QwtPlotItem::setLegendIconSize(), QwtPlotItem::legendData()
  */
 QwtGraphic QwtPlotCurve::legendIcon( int index, const QSizeF& size ) const
@@ -1099,7 +2472,12 @@ QwtGraphic QwtPlotCurve::legendIcon( int index, const QSizeF& size ) const
     if ( size.isEmpty() )
         return QwtGraphic();
 
+    const LegendIconKey key( this, size );
+
     QwtGraphic graphic;
+    if ( key.isValid && qwtLegendIconCache()->find( key, graphic ) )
+        return graphic;
+
     graphic.setDefaultSize( size );
     graphic.setRenderHint( QwtGraphic::RenderPensUnscaled, true );
 
@@ -1156,6 +2534,11 @@ QwtGraphic QwtPlotCurve::legendIcon( int index, const QSizeF& size ) const
         }
     }
 
+    painter.end();
+
+    if ( key.isValid )
+        qwtLegendIconCache()->insert( key, graphic );
+
     return graphic;
 }
 
@@ -14,10 +14,12 @@
 #include "qwt_plot_seriesitem.h"
 
 #include <qstring.h>
+#include <qsharedpointer.h>
 
 class QwtScaleMap;
 class QwtSymbol;
 class QwtCurveFitter;
+class QwtColorMap;
 template< typename T > class QwtSeriesData;
 class QwtText;
 class QPainter;
@@ -118,16 +120,37 @@ class QWT_EXPORT QwtPlotCurve
         Inverted = 0x01,
 
         /*!
-           Only in combination with QwtPlotCurve::Lines
-           A QwtCurveFitter tries to
+           For QwtPlotCurve::Lines a QwtCurveFitter tries to
            interpolate/smooth the curve, before it is painted.
 
+           For QwtPlotCurve::Steps and QwtPlotCurve::Sticks
+           curve fitters of QwtCurveFitter::Polygon mode are applied
+           to the points, before the steps or sticks are built.
+           This is useful for reducing the points by a
+           QwtDownsamplingCurveFitter.
+
            \note Curve fitting requires temporary memory
            for calculating coefficients and additional points.
            If painting in QwtPlotCurve::Fitted mode is slow it might be better
            to fit the points, before they are passed to QwtPlotCurve.
+
+           For ordered samples and a QwtSplineCurveFitter with a local
+           spline ( QwtSpline::locality() > 0 ) only the visible samples
+           and their neighbours are fitted.
+         */
+        Fitted = 0x02,
+
+        /*!
+           For QwtPlotCurve::Lines and QwtPlotCurve::Steps only.
+           Samples with a NaN coordinate are gaps, where the curve
+           is interrupted. This way a signal with dropouts can be
+           displayed by one curve instead of one curve per segment.
+
+           Unfilled lines are interrupted while being mapped and clipped
+           ( QwtPointMapper::BreakAtGaps ). Otherwise each run of samples
+           between the gaps is painted - filled or fitted - on its own.
          */
-        Fitted = 0x02
+        BreakAtGaps = 0x04
     };
 
     Q_DECLARE_FLAGS( CurveAttributes, CurveAttribute )
@@ -203,6 +226,18 @@ class QWT_EXPORT QwtPlotCurve
            having a huge amount of points.
            With a reasonable number of points QPainter::drawPoints()
            will be faster.
+
+           For Lines, Sticks and Steps the lines are rasterized to the
+           image by QwtLineRasterizer - using renderThreadCount() threads -
+           when painting with a solid, opaque pen of 1 pixel without
+           antialiasing to a raster paint device. Fitted Lines are
+           excluded.
+
+           When a density color map is assigned, Dots are not painted
+           with the pen color, but colored according to the number of
+           points, that are mapped to the same pixel.
+
+           \sa QwtLineRasterizer::isSupported(), setDensityColorMap()
          */
         ImageBuffer = 0x08,
 
@@ -222,13 +257,94 @@ class QWT_EXPORT QwtPlotCurve
            The algorithm is very fast and effective for huge datasets, and can be used
            inside a replot cycle.
 
-           \note Implemented for QwtPlotCurve::Lines only
+           For the other styles the reduction is:
+
+           - Steps: runs of transitions inside of the same pixel column
+             ( or row ) are reduced to one line, preserving the edges
+           - Sticks: sticks inside of the same pixel column ( or row )
+             are reduced to the one covering all of them
+           - Dots: points mapped to the same pixel are painted once,
+             like with FilterPoints
+
+           \note Has no effect on fitted curves
            \note As this algo replaces many small lines by a long one
                 a nasty bug of the raster paint engine ( Qt 4.8, Qt 5.1 - 5.3 )
                 becomes more dominant. For these versions the bug can be
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+           Map the points of QwtPlotCurve::Lines in parallel chunks
+           using renderThreadCount() threads.
+
+           The results of the chunks are stitched together, so that the
+           polyline is the same as the one being mapped in one thread.
+           On systems with many cores this might be a substantial
+           improvement for curves with millions of points.
+
+           \sa QwtPointMapper::ParallelMapping, QwtPlotItem::setRenderThreadCount()
+         */
+        ParallelMapping = 0x20,
+
+        /*!
+           Fit the curve in scale coordinates once and keep the
+           result until the samples or the curve fitter are changed.
+           On replots the cached curve is mapped only.
+
+           As the curve fitter is applied to the samples and not to the
+           points in paint device coordinates, this is only reasonable
+           for linear scales and for curve fitters, that are not
+           depending on the resolution in pixels. F.e. the cached
+           spline of a QwtSplineCurveFitter is mapped without any visual
+           difference, while the tolerance of a QwtWeedingCurveFitter
+           would be in scale coordinates.
+
+           The cache is used, when all samples are painted. Painting a range
+           of samples only - f.e. by QwtPlotDirectPainter - fits the range
+           without a cache.
+
+           \note Setting this attribute discards the cached curve, what is
+                 necessary after modifying the parameters of the curve fitter.
+           \sa Fitted, setCurveFitter()
+         */
+        CacheFittedCurve = 0x40,
+
+        /*!
+           Don't paint symbols, that are covered by symbols painted before.
+
+           The canvas is divided into cells of half of the symbol size.
+           For symbols filled with an opaque brush only the first symbol
+           of a cell is painted, for translucent brushes the symbols
+           are painted until the cell is covered by 99%. For all other
+           symbols - outlines, pixmaps, graphics - 4 symbols per cell
+           are painted.
+
+           As the painted symbol might be up to half of the symbol size
+           away from the dropped ones, this is not free of visual
+           differences. But for scatter plots with millions of symbols,
+           where most of them are on top of each other, the number
+           of painted symbols is limited by the size of the canvas.
+
+           \sa drawSymbols(), QwtSymbol::setCachePolicy()
+         */
+        FilterSymbols = 0x80,
+
+        /*!
+           Keep the mapped, weeded and clipped polyline of an unfilled
+           QwtPlotCurve::Lines curve. As long as the scale maps, the clip
+           rectangle, the paint attributes and the samples are unchanged
+           the polyline is painted again without processing the samples.
+           This speeds up replots triggered by other items - f.e. a moving
+           marker.
+
+           Changes of the samples are detected by dataChanged(). When
+           modifying the samples of the series without notifying the curve
+           dataChanged() has to be called manually.
+
+           \sa QwtPointMapper::toClippedPolylines(), QwtCacheRegistry
+         */
+        CachePolyline = 0x100
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -272,6 +388,9 @@ class QWT_EXPORT QwtPlotCurve
 
     virtual int closestPoint( const QPointF& pos, double* dist = NULL ) const;
 
+    void setSpatialIndexEnabled( bool on );
+    bool isSpatialIndexEnabled() const;
+
     double minXValue() const;
     double maxXValue() const;
     double minYValue() const;
@@ -294,11 +413,15 @@ class QWT_EXPORT QwtPlotCurve
     CurveStyle style() const;
 
     void setSymbol( QwtSymbol* );
+    void setSymbol( const QSharedPointer< const QwtSymbol >& );
     const QwtSymbol* symbol() const;
 
     void setCurveFitter( QwtCurveFitter* );
     QwtCurveFitter* curveFitter() const;
 
+    void setDensityColorMap( QwtColorMap* );
+    const QwtColorMap* densityColorMap() const;
+
     virtual void drawSeries( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
@@ -340,6 +463,19 @@ class QWT_EXPORT QwtPlotCurve
     void closePolyline( QPainter*,
         const QwtScaleMap&, const QwtScaleMap&, QPolygonF& ) const;
 
+    void fillPolyline( QPainter*,
+        const QwtScaleMap&, const QwtScaleMap&,
+        const QRectF& clipRect, QPolygonF& ) const;
+
+    QPolygonF fittedPoints( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        bool doAlign, int from, int to ) const;
+
+    void drawFittedCache( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, const QRectF& clipRect, bool doFill ) const;
+
+    virtual void dataChanged() QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -0,0 +1,417 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_curve_tracker.h"
+#include "qwt_plot_curve.h"
+#include "qwt_picker_machine.h"
+#include "qwt_plot.h"
+#include "qwt_series_data.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qregion.h>
+#include <qvector.h>
+
+namespace
+{
+    class CompareX
+    {
+      public:
+        inline bool operator()( const double x, const QPointF& pos ) const
+        {
+            return ( x < pos.x() );
+        }
+    };
+
+    class CurveValue
+    {
+      public:
+        CurveValue()
+            : curve( NULL )
+            , size( 0 )
+            , index( -1 )
+        {
+        }
+
+        inline bool isValid() const
+        {
+            return index > 0;
+        }
+
+        const QwtPlotCurve* curve;
+        size_t size;
+
+        // index of the upper sample of the interval, containing x
+        int index;
+
+        QPointF value;
+    };
+}
+
+/*
+    The upper index of x, what is the index of the first sample
+    with a x coordinate > x, or the last index if x is the
+    x coordinate of the last sample. Before doing a binary search
+    the interval of the previous lookup and its neighbours are checked.
+ */
+static int qwtUpperIndex( const QwtSeriesData< QPointF >& data,
+    double x, int hint )
+{
+    const int numSamples = static_cast< int >( data.size() );
+    if ( numSamples < 2 )
+        return -1;
+
+    if ( hint > 0 && hint < numSamples )
+    {
+        const int from = qMax( hint - 1, 1 );
+        const int to = qMin( hint + 1, numSamples - 1 );
+
+        double x1 = data.sample( from - 1 ).x();
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const double x2 = data.sample( i ).x();
+
+            if ( x >= x1 && ( x < x2 || ( x == x2 && i == numSamples - 1 ) ) )
+                return i;
+
+            x1 = x2;
+        }
+    }
+
+    int index = qwtUpperSampleIndex< QPointF >( data, x, CompareX() );
+
+    if ( index == -1 && x == data.sample( numSamples - 1 ).x() )
+    {
+        // the last sample is excluded from qwtUpperSampleIndex
+        index = numSamples - 1;
+    }
+
+    return index;
+}
+
+class QwtPlotCurveTracker::PrivateData
+{
+  public:
+    PrivateData()
+        : markerSize( 7 )
+        , isValid( false )
+        , x( 0.0 )
+        , hasText( false )
+    {
+    }
+
+    int markerSize;
+
+    mutable bool isValid;
+    mutable double x;
+    mutable QVector< CurveValue > values;
+
+    mutable bool hasText;
+    mutable QwtText text;
+};
+
+/*!
+   \brief Constructor
+
+   The tracker is displayed while dragging ( QwtPickerDragPointMachine )
+   together with a vertical line.
+
+   \param canvas Plot canvas to observe, also the parent object
+ */
+QwtPlotCurveTracker::QwtPlotCurveTracker( QWidget* canvas )
+    : QwtPlotPicker( canvas )
+{
+    m_data = new PrivateData;
+
+    setTrackerMode( QwtPlotPicker::ActiveOnly );
+    setRubberBand( VLineRubberBand );
+
+    setStateMachine( new QwtPickerDragPointMachine() );
+}
+
+//! Destructor
+QwtPlotCurveTracker::~QwtPlotCurveTracker()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the size of the markers
+
+   A marker is drawn at the position of each value.
+   The default setting is 7, 0 disables the markers.
+
+   \param size Size of the markers in pixels
+   \sa markerSize()
+ */
+void QwtPlotCurveTracker::setMarkerSize( int size )
+{
+    m_data->markerSize = qMax( size, 0 );
+}
+
+/*!
+   \return Size of the markers in pixels
+   \sa setMarkerSize()
+ */
+int QwtPlotCurveTracker::markerSize() const
+{
+    return m_data->markerSize;
+}
+
+/*!
+   \brief Invalidate the cached values and the tracker text
+
+   Changing the number of samples of a curve is detected, but
+   any other modification of the samples requires to call
+   invalidateCache().
+ */
+void QwtPlotCurveTracker::invalidateCache()
+{
+    m_data->isValid = false;
+    m_data->values.clear();
+
+    m_data->hasText = false;
+    m_data->text = QwtText();
+}
+
+/*!
+   \brief Translate a position into a tracker text
+
+   The text is built from curveInfo() for all curves having
+   a value at the x coordinate of pos. It is cached as long
+   as the x coordinate doesn't change.
+
+   \param pos Position in plot coordinates
+   \return Tracker text
+ */
+QwtText QwtPlotCurveTracker::trackerTextF( const QPointF& pos ) const
+{
+    updateValues( pos.x() );
+
+    if ( !m_data->hasText )
+    {
+        QString info;
+
+        const QVector< CurveValue >& values = m_data->values;
+        for ( int i = 0; i < values.size(); i++ )
+        {
+            if ( !values[i].isValid() )
+                continue;
+
+            const QString curveText = curveInfo(
+                values[i].curve, values[i].value );
+
+            if ( !curveText.isEmpty() )
+            {
+                if ( !info.isEmpty() )
+                    info += "<br>";
+
+                info += curveText;
+            }
+        }
+
+        m_data->text = QwtText( info, QwtText::RichText );
+        m_data->hasText = true;
+    }
+
+    return m_data->text;
+}
+
+/*!
+   \brief Calculate the bounding rectangle for the tracker text
+
+   The rectangle is vertically aligned to the value of the first curve.
+
+   \param font Font of the tracker text
+   \return Bounding rectangle of the tracker text
+ */
+QRect QwtPlotCurveTracker::trackerRect( const QFont& font ) const
+{
+    QRect r = QwtPlotPicker::trackerRect( font );
+    if ( r.isEmpty() )
+        return r;
+
+    updateValues( invTransform( trackerPosition() ).x() );
+
+    const QVector< CurveValue >& values = m_data->values;
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        if ( values[i].isValid() )
+        {
+            r.moveBottom( transform( values[i].value ).y() );
+            break;
+        }
+    }
+
+    return r;
+}
+
+/*!
+   \brief Draw the tracker text and the markers
+
+   \param painter Painter
+   \sa setMarkerSize(), trackerMask()
+ */
+void QwtPlotCurveTracker::drawTracker( QPainter* painter ) const
+{
+    QwtPlotPicker::drawTracker( painter );
+
+    const int size = m_data->markerSize;
+    if ( size <= 0 )
+        return;
+
+    updateValues( invTransform( trackerPosition() ).x() );
+
+    painter->save();
+    painter->setRenderHint( QPainter::Antialiasing, true );
+
+    QRectF r( 0.0, 0.0, size, size );
+
+    const QVector< CurveValue >& values = m_data->values;
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        if ( !values[i].isValid() )
+            continue;
+
+        const QColor color = values[i].curve->pen().color();
+
+        painter->setPen( color );
+        painter->setBrush( color );
+
+        r.moveCenter( transform( values[i].value ) );
+        painter->drawEllipse( r );
+    }
+
+    painter->restore();
+}
+
+/*!
+   \return Region of the tracker text and the markers
+   \sa drawTracker()
+ */
+QRegion QwtPlotCurveTracker::trackerMask() const
+{
+    QRegion mask = QwtPlotPicker::trackerMask();
+
+    const int size = m_data->markerSize;
+    if ( size <= 0 || mask.isEmpty() )
+        return mask;
+
+    updateValues( invTransform( trackerPosition() ).x() );
+
+    // some extra pixels for the antialiased outline
+    QRect r( 0, 0, size + 2, size + 2 );
+
+    const QVector< CurveValue >& values = m_data->values;
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        if ( values[i].isValid() )
+        {
+            r.moveCenter( transform( values[i].value ) );
+            mask += r;
+        }
+    }
+
+    return mask;
+}
+
+/*!
+   \brief Format the value of a curve
+
+   The default implementation returns the y coordinate in
+   the color of the curve pen.
+
+   \param curve Curve
+   \param value Interpolated value of the curve
+   \return Rich text for the value
+ */
+QString QwtPlotCurveTracker::curveInfo(
+    const QwtPlotCurve* curve, const QPointF& value ) const
+{
+    const QString info( "<font color=" "%1" ">%2</font>" );
+    return info.arg( curve->pen().color().name() ).arg( value.y() );
+}
+
+void QwtPlotCurveTracker::updateValues( double x ) const
+{
+    const QwtPlot* plt = plot();
+    if ( plt == NULL )
+        return;
+
+    QVector< CurveValue >& values = m_data->values;
+
+    // curves, that are attached to the axes of the picker
+
+    QVector< const QwtPlotCurve* > curves;
+
+    const QwtPlotItemList items = plt->itemList( QwtPlotItem::Rtti_PlotCurve );
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem* item = items[i];
+
+        if ( item->isVisible() && item->xAxis() == xAxis()
+            && item->yAxis() == yAxis() )
+        {
+            curves += static_cast< const QwtPlotCurve* >( item );
+        }
+    }
+
+    bool isValid = m_data->isValid
+        && ( x == m_data->x ) && ( curves.size() == values.size() );
+
+    for ( int i = 0; isValid && i < curves.size(); i++ )
+    {
+        isValid = ( values[i].curve == curves[i] )
+            && ( values[i].size == curves[i]->dataSize() );
+    }
+
+    if ( isValid )
+        return;
+
+    if ( curves.size() != values.size() )
+        values.resize( curves.size() );
+
+    for ( int i = 0; i < curves.size(); i++ )
+    {
+        const QwtPlotCurve* curve = curves[i];
+        CurveValue& v = values[i];
+
+        if ( v.curve != curve || v.size > curve->dataSize() )
+        {
+            // the previous index is no hint for another curve
+            v.index = -1;
+        }
+
+        v.curve = curve;
+        v.size = curve->dataSize();
+        v.index = qwtUpperIndex( *curve->data(), x, v.index );
+
+        if ( v.isValid() )
+        {
+            const QPointF p1 = curve->sample( v.index - 1 );
+            const QPointF p2 = curve->sample( v.index );
+
+            double y = p2.y();
+            if ( p2.x() != p1.x() )
+                y = p1.y() + ( x - p1.x() ) / ( p2.x() - p1.x() ) * ( p2.y() - p1.y() );
+
+            v.value = QPointF( x, y );
+        }
+    }
+
+    m_data->x = x;
+    m_data->isValid = true;
+
+    m_data->hasText = false;
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_curve_tracker.cpp"
+#endif
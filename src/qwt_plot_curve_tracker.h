@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_CURVE_TRACKER_H
+#define QWT_PLOT_CURVE_TRACKER_H
+
+#include "qwt_global.h"
+#include "qwt_plot_picker.h"
+
+class QwtPlotCurve;
+class QString;
+
+/*!
+   \brief A picker displaying the values of all curves at the x position
+          of the mouse
+
+   QwtPlotCurveTracker shows a vertical line and a tracker text with
+   the interpolated values of all curves, that are attached to the axes
+   of the picker. Optionally a marker is drawn at the position of each value.
+
+   The samples of the curves need to be sorted in increasing x order.
+   The values are found by a binary search, that starts with a check
+   of the samples found for the previous position. So following the mouse
+   costs O(1) per curve in most cases. All curves are looked up in one pass
+   and the results - including the tracker text - are shared between the
+   calculations of the tracker rectangle, its mask and the text.
+
+   The overlay is masked by the tracker text and the markers
+   ( see trackerMask() ), so that only these regions of the
+   canvas need to be repainted when the mouse is moved.
+
+   \note When the samples of a curve have been modified without changing
+         the number of samples invalidateCache() has to be called.
+ */
+class QWT_EXPORT QwtPlotCurveTracker : public QwtPlotPicker
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtPlotCurveTracker( QWidget* canvas );
+    virtual ~QwtPlotCurveTracker();
+
+    void setMarkerSize( int );
+    int markerSize() const;
+
+    void invalidateCache();
+
+  protected:
+    virtual QwtText trackerTextF( const QPointF& ) const QWT_OVERRIDE;
+    virtual QRect trackerRect( const QFont& ) const QWT_OVERRIDE;
+
+    virtual void drawTracker( QPainter* ) const QWT_OVERRIDE;
+    virtual QRegion trackerMask() const QWT_OVERRIDE;
+
+    virtual QString curveInfo(
+        const QwtPlotCurve*, const QPointF& value ) const;
+
+  private:
+    void updateValues( double x ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,488 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_density_item.h"
+#include "qwt_scale_map.h"
+#include "qwt_color_map.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+
+#include <qimage.h>
+#include <qvector.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <cmath>
+
+// maximum size of the lookup table from counts to colors
+static const quint32 qwtMaxColorTableSize = 65536;
+
+// minimum number of points, that are counted in a separate thread
+static const size_t qwtMinPointsPerThread = 100000;
+
+namespace
+{
+    class QwtDensityJob
+    {
+      public:
+        const QwtSeriesData< QPointF >* series;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QSize imageSize;
+
+        size_t from;
+        size_t to;
+
+        QVector< quint32 > counts;
+    };
+}
+
+static void qwtCountPoints( QwtDensityJob* job )
+{
+    const QwtSeriesData< QPointF >* series = job->series;
+
+    const QwtScaleMap& xMap = job->xMap;
+    const QwtScaleMap& yMap = job->yMap;
+
+    const int w = job->imageSize.width();
+    const int h = job->imageSize.height();
+
+    job->counts.fill( 0u, w * h );
+    quint32* counts = job->counts.data();
+
+    for ( size_t i = job->from; i <= job->to; i++ )
+    {
+        const QPointF pos = series->sample( i );
+
+        // pixel centers are at integer positions of the image maps
+        const double px = std::floor( xMap.transform( pos.x() ) + 0.5 );
+        const double py = std::floor( yMap.transform( pos.y() ) + 0.5 );
+
+        if ( px >= 0.0 && px < w && py >= 0.0 && py < h )
+            counts[ int( py ) * w + int( px ) ]++;
+    }
+}
+
+static inline double qwtScaledCount( quint32 count,
+    QwtPlotDensityItem::CountScaling scaling )
+{
+    if ( scaling == QwtPlotDensityItem::LogarithmicScaling )
+        return std::log( 1.0 + count );
+
+    return count;
+}
+
+static inline QRgb qwtCountColor( const QwtColorMap* colorMap,
+    const QVector< QRgb >& colorTable256, const QwtInterval& range, double value )
+{
+    if ( colorMap->format() == QwtColorMap::Indexed )
+        return colorTable256[ colorMap->colorIndex( 256, range, value ) ];
+
+    return colorMap->rgb( range, value );
+}
+
+class QwtPlotDensityItem::PrivateData
+{
+  public:
+    PrivateData()
+        : countScaling( QwtPlotDensityItem::LinearScaling )
+        , maxCount( 0 )
+    {
+        colorMap = new QwtLinearColorMap();
+    }
+
+    ~PrivateData()
+    {
+        delete colorMap;
+    }
+
+    QwtColorMap* colorMap;
+    QwtPlotDensityItem::CountScaling countScaling;
+    int maxCount;
+};
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotDensityItem::QwtPlotDensityItem( const QString& title )
+    : QwtPlotRasterItem( QwtText( title ) )
+{
+    init();
+}
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotDensityItem::QwtPlotDensityItem( const QwtText& title )
+    : QwtPlotRasterItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotDensityItem::~QwtPlotDensityItem()
+{
+    // stop tiles being rendered in the background
+    invalidateCache();
+
+    delete m_data;
+}
+
+/*!
+   Sets the following item attributes:
+   - QwtPlotItem::AutoScale: true
+   - QwtPlotItem::Legend:    false
+
+   The z value is initialized by 8.0 and the cache policy
+   by QwtPlotRasterItem::PaintCache.
+ */
+void QwtPlotDensityItem::init()
+{
+    m_data = new PrivateData();
+
+    setItemAttribute( QwtPlotItem::AutoScale, true );
+    setItemAttribute( QwtPlotItem::Legend, false );
+
+    setCachePolicy( QwtPlotRasterItem::PaintCache );
+
+    setData( new QwtPointSeriesData() );
+
+    setZ( 8.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotDensity
+int QwtPlotDensityItem::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotDensity;
+}
+
+/*!
+   Initialize data with an array of points
+
+   \param samples Vector of points
+ */
+void QwtPlotDensityItem::setSamples( const QVector< QPointF >& samples )
+{
+    setData( new QwtPointSeriesData( samples ) );
+}
+
+/*!
+   Assign a series of points
+
+   setSamples() is just a wrapper for setData() without any additional
+   value - beside that it is easier to find for the developer.
+
+   \param data Data
+   \warning The item takes ownership of the data object, deleting
+            it when its not used anymore.
+ */
+void QwtPlotDensityItem::setSamples( QwtSeriesData< QPointF >* data )
+{
+    setData( data );
+}
+
+/*!
+   Change the color map
+
+   The color map is used to map the - scaled - number of points
+   of a pixel into a color.
+
+   \param colorMap Color Map
+   \sa colorMap(), setCountScaling()
+ */
+void QwtPlotDensityItem::setColorMap( QwtColorMap* colorMap )
+{
+    if ( colorMap == NULL )
+        return;
+
+    invalidateCache();
+
+    if ( colorMap != m_data->colorMap )
+    {
+        delete m_data->colorMap;
+        m_data->colorMap = colorMap;
+    }
+
+    itemChanged();
+}
+
+/*!
+   \return Color Map used for mapping the counts to colors
+   \sa setColorMap()
+ */
+const QwtColorMap* QwtPlotDensityItem::colorMap() const
+{
+    return m_data->colorMap;
+}
+
+/*!
+   Set the mapping of the counts into the color map
+
+   The default setting is LinearScaling.
+
+   \param scaling Scaling of the counts
+   \sa countScaling(), setMaxCount()
+ */
+void QwtPlotDensityItem::setCountScaling( CountScaling scaling )
+{
+    if ( scaling != m_data->countScaling )
+    {
+        invalidateCache();
+
+        m_data->countScaling = scaling;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Scaling of the counts
+   \sa setCountScaling()
+ */
+QwtPlotDensityItem::CountScaling QwtPlotDensityItem::countScaling() const
+{
+    return m_data->countScaling;
+}
+
+/*!
+   \brief Set the count, that is mapped to the upper end of the color map
+
+   Pixels with more points are displayed in the same color.
+   When maxCount is <= 0 the maximum count of all pixels is used,
+   what means that the colors depend on the zoom level.
+
+   The default setting is 0.
+
+   \param maxCount Upper limit for the counts
+   \sa maxCount(), setCountScaling()
+ */
+void QwtPlotDensityItem::setMaxCount( int maxCount )
+{
+    maxCount = qMax( maxCount, 0 );
+
+    if ( maxCount != m_data->maxCount )
+    {
+        invalidateCache();
+
+        m_data->maxCount = maxCount;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Count, that is mapped to the upper end of the color map
+   \sa setMaxCount()
+ */
+int QwtPlotDensityItem::maxCount() const
+{
+    return m_data->maxCount;
+}
+
+/*!
+   \param axis X, Y or Z axis
+   \return Bounding interval of the points for the x and y axis,
+           an invalid interval for the z axis
+ */
+QwtInterval QwtPlotDensityItem::interval( Qt::Axis axis ) const
+{
+    const QRectF rect = dataRect();
+    if ( !rect.isValid() )
+        return QwtInterval();
+
+    if ( axis == Qt::XAxis )
+        return QwtInterval( rect.left(), rect.right() );
+
+    if ( axis == Qt::YAxis )
+        return QwtInterval( rect.top(), rect.bottom() );
+
+    return QwtInterval();
+}
+
+//! Invalidate the image and trigger an autorefresh
+void QwtPlotDensityItem::dataChanged()
+{
+    invalidateCache();
+    itemChanged();
+}
+
+/*!
+   \brief Count the points, that are mapped to each pixel of an image
+
+   The series is divided into chunks, that are counted in parallel
+   threads ( see QwtPlotItem::setRenderThreadCount() ).
+
+   \param xMap Maps x-values into image coordinates
+   \param yMap Maps y-values into image coordinates
+   \param imageSize Size of the image
+
+   \return Counts of the pixels, row by row
+ */
+QVector< quint32 > QwtPlotDensityItem::countPoints(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QSize& imageSize ) const
+{
+    const int numPixels = imageSize.width() * imageSize.height();
+
+    const size_t numPoints = dataSize();
+    if ( numPoints == 0 || numPixels <= 0 )
+        return QVector< quint32 >( qMax( numPixels, 0 ), 0u );
+
+    uint numThreads = 1;
+
+#if !defined( QT_NO_QFUTURE )
+    numThreads = renderThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    // each thread needs its own buffer, what is not worth it for small series
+    numThreads = qMin( numThreads, uint( numPoints / qwtMinPointsPerThread ) );
+    numThreads = qMax( numThreads, 1u );
+#endif
+
+    const size_t chunkSize = numPoints / numThreads;
+
+    QVector< QwtDensityJob > jobs( numThreads );
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        QwtDensityJob& job = jobs[i];
+
+        job.series = data();
+        job.xMap = xMap;
+        job.yMap = yMap;
+        job.imageSize = imageSize;
+        job.from = i * chunkSize;
+        job.to = ( i == numThreads - 1 ) ? numPoints - 1 : ( i + 1 ) * chunkSize - 1;
+    }
+
+#if !defined( QT_NO_QFUTURE )
+    QVector< QFuture< void > > futures;
+    futures.reserve( jobs.size() - 1 );
+
+    for ( int i = 1; i < jobs.size(); i++ )
+        futures += QtConcurrent::run( &qwtCountPoints, &jobs[i] );
+#endif
+
+    qwtCountPoints( &jobs[0] );
+
+    QVector< quint32 > counts;
+    counts.swap( jobs[0].counts );
+
+#if !defined( QT_NO_QFUTURE )
+    quint32* c = counts.data();
+
+    for ( int i = 0; i < futures.size(); i++ )
+    {
+        futures[i].waitForFinished();
+
+        const quint32* b = jobs[i + 1].counts.constData();
+        for ( int j = 0; j < numPixels; j++ )
+            c[j] += b[j];
+    }
+#endif
+
+    return counts;
+}
+
+/*!
+   \brief Render an image from the counts of the pixels
+
+   \param xMap X-Scale Map
+   \param yMap Y-Scale Map
+   \param area Requested area for the image in scale coordinates
+   \param imageSize Size of the requested image
+
+   \return A QImage::Format_ARGB32 image, where pixels without
+           any point are transparent
+
+   \sa countPoints(), setColorMap(), setCountScaling()
+ */
+QImage QwtPlotDensityItem::renderImage(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& area, const QSize& imageSize ) const
+{
+    Q_UNUSED( area );
+
+    if ( imageSize.isEmpty() )
+        return QImage();
+
+    QImage image( imageSize, QImage::Format_ARGB32 );
+    image.fill( 0u );
+
+    const QVector< quint32 > counts = countPoints( xMap, yMap, imageSize );
+
+    quint32 maxCount = m_data->maxCount;
+    if ( maxCount == 0 )
+    {
+        for ( int i = 0; i < counts.size(); i++ )
+            maxCount = qMax( maxCount, counts[i] );
+    }
+
+    if ( maxCount == 0 )
+        return image;
+
+    const QwtColorMap* colorMap = m_data->colorMap;
+    const CountScaling scaling = m_data->countScaling;
+
+    QVector< QRgb > colorTable256;
+    if ( colorMap->format() == QwtColorMap::Indexed )
+        colorTable256 = colorMap->colorTable256();
+
+    const QwtInterval range( 0.0, qwtScaledCount( maxCount, scaling ) );
+
+    // the colors of small counts are looked up
+
+    QVector< QRgb > colorTable( int( qMin( maxCount, qwtMaxColorTableSize ) ) + 1 );
+    for ( int i = 1; i < colorTable.size(); i++ )
+    {
+        colorTable[i] = qwtCountColor( colorMap, colorTable256,
+            range, qwtScaledCount( i, scaling ) );
+    }
+
+    const QRgb maxColor = qwtCountColor( colorMap, colorTable256,
+        range, range.maxValue() );
+
+    const quint32 tableSize = colorTable.size();
+    const QRgb* table = colorTable.constData();
+
+    const quint32* c = counts.constData();
+    const int w = imageSize.width();
+
+    for ( int y = 0; y < imageSize.height(); y++ )
+    {
+        QRgb* line = reinterpret_cast< QRgb* >( image.scanLine( y ) );
+
+        for ( int x = 0; x < w; x++ )
+        {
+            const quint32 count = *c++;
+
+            if ( count == 0 )
+                continue;
+
+            if ( count < tableSize )
+            {
+                line[x] = table[count];
+            }
+            else if ( count >= maxCount )
+            {
+                line[x] = maxColor;
+            }
+            else
+            {
+                line[x] = qwtCountColor( colorMap, colorTable256,
+                    range, qwtScaledCount( count, scaling ) );
+            }
+        }
+    }
+
+    return image;
+}
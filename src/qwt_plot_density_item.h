@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_DENSITY_ITEM_H
+#define QWT_PLOT_DENSITY_ITEM_H
+
+#include "qwt_global.h"
+#include "qwt_plot_rasteritem.h"
+#include "qwt_series_store.h"
+
+class QwtColorMap;
+
+/*!
+   \brief A plot item, that displays the density of a scatter plot
+
+   Painting huge scatter plots with QwtPlotCurve::Dots loses the
+   information how many points are mapped to the same pixel - beside
+   the time being spent for painting points over points.
+
+   QwtPlotDensityItem counts the points, that are mapped to each pixel,
+   and maps the counts into colors using a color map. Pixels without
+   any point are transparent.
+
+   Counting the points is done in parallel ( see QwtPlotItem::setRenderThreadCount() ).
+   The cache policy is initialized to QwtPlotRasterItem::PaintCache,
+   so that the points are counted again only, when the scales
+   or the size of the canvas have changed.
+
+   \par Example
+   \code
+   QwtPlotDensityItem* density = new QwtPlotDensityItem();
+   density->setCountScaling( QwtPlotDensityItem::LogarithmicScaling );
+   density->setSamples( points );
+   density->attach( plot );
+   \endcode
+   \endpar
+
+   \sa QwtPlotSpectrogram, QwtPlotCurve::Dots
+ */
+class QWT_EXPORT QwtPlotDensityItem
+    : public QwtPlotRasterItem
+    , public QwtSeriesStore< QPointF >
+{
+  public:
+    /*!
+       How to map the number of points of a pixel into a color
+       \sa setCountScaling()
+     */
+    enum CountScaling
+    {
+        //! The counts are mapped linearly into the color map
+        LinearScaling,
+
+        /*!
+           log( 1 + count ) is mapped into the color map, so that
+           sparse regions are still visible besides dense clusters.
+         */
+        LogarithmicScaling
+    };
+
+    explicit QwtPlotDensityItem( const QString& title = QString() );
+    explicit QwtPlotDensityItem( const QwtText& title );
+
+    virtual ~QwtPlotDensityItem();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setSamples( const QVector< QPointF >& );
+    void setSamples( QwtSeriesData< QPointF >* );
+
+    void setColorMap( QwtColorMap* );
+    const QwtColorMap* colorMap() const;
+
+    void setCountScaling( CountScaling );
+    CountScaling countScaling() const;
+
+    void setMaxCount( int );
+    int maxCount() const;
+
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE;
+
+  protected:
+    virtual void dataChanged() QWT_OVERRIDE;
+
+    virtual QImage renderImage( const QwtScaleMap& xMap,
+        const QwtScaleMap& yMap, const QRectF& area,
+        const QSize& imageSize ) const QWT_OVERRIDE;
+
+    virtual QVector< quint32 > countPoints( const QwtScaleMap& xMap,
+        const QwtScaleMap& yMap, const QSize& imageSize ) const;
+
+  private:
+    void init();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -8,7 +8,208 @@
  *****************************************************************************/
 
 #include "qwt_plot_dict.h"
+#include "qwt_axis.h"
+#include "qwt_math.h"
+
+#include <qrect.h>
+#include <qmap.h>
+#include <qvector.h>
+
 #include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace
+{
+    /*
+        Bounding rectangle of an item. Items without a valid
+        width or height ( f.e. grids ) are unbounded in
+        the corresponding direction.
+     */
+    class Box
+    {
+      public:
+        Box()
+            : x1( 0.0 )
+            , x2( 0.0 )
+            , y1( 0.0 )
+            , y2( 0.0 )
+        {
+        }
+
+        explicit Box( const QRectF& rect )
+        {
+            const double max = std::numeric_limits< double >::max();
+
+            if ( rect.width() >= 0.0 )
+            {
+                x1 = rect.left();
+                x2 = rect.right();
+            }
+            else
+            {
+                x1 = -max;
+                x2 = max;
+            }
+
+            if ( rect.height() >= 0.0 )
+            {
+                y1 = rect.top();
+                y2 = rect.bottom();
+            }
+            else
+            {
+                y1 = -max;
+                y2 = max;
+            }
+        }
+
+        inline bool intersects( const Box& other ) const
+        {
+            return x1 <= other.x2 && other.x1 <= x2
+                && y1 <= other.y2 && other.y1 <= y2;
+        }
+
+        inline void unite( const Box& other )
+        {
+            x1 = qMin( x1, other.x1 );
+            x2 = qMax( x2, other.x2 );
+            y1 = qMin( y1, other.y1 );
+            y2 = qMax( y2, other.y2 );
+        }
+
+        inline double centerX() const { return 0.5 * x1 + 0.5 * x2; }
+        inline double centerY() const { return 0.5 * y1 + 0.5 * y2; }
+
+        double x1, x2, y1, y2;
+    };
+
+    /*
+        Node of the tree: on the lowest level "first" is the position
+        of the item in the item list, otherwise the index of the first
+        child on the level below.
+     */
+    class Node
+    {
+      public:
+        Box box;
+        int first;
+        int count;
+    };
+
+    class LessX
+    {
+      public:
+        inline bool operator()( const Node& node1, const Node& node2 ) const
+        {
+            return node1.box.centerX() < node2.box.centerX();
+        }
+    };
+
+    class LessY
+    {
+      public:
+        inline bool operator()( const Node& node1, const Node& node2 ) const
+        {
+            return node1.box.centerY() < node2.box.centerY();
+        }
+    };
+
+    /*
+        A static R-tree, that is bulk loaded with the
+        "Sort Tile Recursive" algorithm. The index is rebuilt from scratch
+        on modifications, what is cheap compared to a replot.
+     */
+    class ItemTree
+    {
+      public:
+        enum { NodeCapacity = 16 };
+
+        void build( QVector< Node > nodes )
+        {
+            m_levels.clear();
+
+            while ( !nodes.isEmpty() )
+            {
+                sortTiles( nodes );
+                m_levels += nodes;
+
+                if ( nodes.size() == 1 )
+                    break;
+
+                QVector< Node > parents;
+                parents.reserve( ( nodes.size() + NodeCapacity - 1 ) / NodeCapacity );
+
+                for ( int i = 0; i < nodes.size(); i += NodeCapacity )
+                {
+                    Node parent;
+                    parent.first = i;
+                    parent.count = qMin( int( NodeCapacity ), nodes.size() - i );
+                    parent.box = nodes[i].box;
+
+                    for ( int j = 1; j < parent.count; j++ )
+                        parent.box.unite( nodes[i + j].box );
+
+                    parents += parent;
+                }
+
+                nodes = parents;
+            }
+        }
+
+        void query( const Box& box, QVector< int >& positions ) const
+        {
+            if ( !m_levels.isEmpty() )
+            {
+                const int level = m_levels.size() - 1;
+                collect( level, 0, m_levels[level].size(), box, positions );
+            }
+        }
+
+      private:
+        static void sortTiles( QVector< Node >& nodes )
+        {
+            // vertical slices in x order, the nodes of a slice in y order
+
+            std::sort( nodes.begin(), nodes.end(), LessX() );
+
+            const int numParents = ( nodes.size() + NodeCapacity - 1 ) / NodeCapacity;
+            const int sliceSize =
+                NodeCapacity * qwtCeil( std::sqrt( double( numParents ) ) );
+
+            for ( int i = 0; i < nodes.size(); i += sliceSize )
+            {
+                std::sort( nodes.begin() + i,
+                    nodes.begin() + qMin( i + sliceSize, nodes.size() ), LessY() );
+            }
+        }
+
+        void collect( int level, int first, int count,
+            const Box& box, QVector< int >& positions ) const
+        {
+            const QVector< Node >& nodes = m_levels[level];
+
+            for ( int i = first; i < first + count; i++ )
+            {
+                const Node& node = nodes[i];
+                if ( !node.box.intersects( box ) )
+                    continue;
+
+                if ( level == 0 )
+                    positions += node.first;
+                else
+                    collect( level - 1, node.first, node.count, box, positions );
+            }
+        }
+
+        QVector< QVector< Node > > m_levels;
+    };
+}
+
+static inline int qwtIndexKey( QwtAxisId xAxis, QwtAxisId yAxis )
+{
+    return xAxis * QwtAxis::AxisPositions + yAxis;
+}
 
 class QwtPlotDict::PrivateData
 {
@@ -27,6 +228,18 @@ class QwtPlotDict::PrivateData
             insert( it, item );
         }
 
+        void appendItem( QwtPlotItem* item )
+        {
+            if ( item != NULL )
+                append( item );
+        }
+
+        void sortItems()
+        {
+            // stable: items with the same z keep the order of insertion
+            std::stable_sort( begin(), end(), LessZThan() );
+        }
+
         void removeItem( QwtPlotItem* item )
         {
             if ( item == NULL )
@@ -56,8 +269,42 @@ class QwtPlotDict::PrivateData
         };
     };
 
+    void buildIndex()
+    {
+        QMap< int, QVector< Node > > leaves;
+
+        for ( int i = 0; i < itemList.size(); i++ )
+        {
+            const QwtPlotItem* item = itemList[i];
+
+            Node node;
+            node.box = Box( item->boundingRect() );
+            node.first = i;
+            node.count = 0;
+
+            leaves[ qwtIndexKey( item->xAxis(), item->yAxis() ) ] += node;
+        }
+
+        itemIndex.clear();
+
+        for ( QMap< int, QVector< Node > >::const_iterator it = leaves.constBegin();
+            it != leaves.constEnd(); ++it )
+        {
+            itemIndex[ it.key() ].build( it.value() );
+        }
+
+        isIndexValid = true;
+    }
+
     ItemList itemList;
     bool autoDelete;
+
+    int updateDepth;
+    bool isSorted;
+
+    // an index for each pair of axes, built on demand
+    QMap< int, ItemTree > itemIndex;
+    bool isIndexValid;
 };
 
 /*!
@@ -70,6 +317,9 @@ QwtPlotDict::QwtPlotDict()
 {
     m_data = new QwtPlotDict::PrivateData;
     m_data->autoDelete = true;
+    m_data->updateDepth = 0;
+    m_data->isSorted = true;
+    m_data->isIndexValid = false;
 }
 
 /*!
@@ -114,7 +364,18 @@ bool QwtPlotDict::autoDelete() const
  */
 void QwtPlotDict::insertItem( QwtPlotItem* item )
 {
-    m_data->itemList.insertItem( item );
+    m_data->isIndexValid = false;
+
+    if ( m_data->updateDepth > 0 )
+    {
+        // sorted in endUpdate() or when the list is requested
+        m_data->itemList.appendItem( item );
+        m_data->isSorted = false;
+    }
+    else
+    {
+        m_data->itemList.insertItem( item );
+    }
 }
 
 /*!
@@ -125,7 +386,63 @@ void QwtPlotDict::insertItem( QwtPlotItem* item )
  */
 void QwtPlotDict::removeItem( QwtPlotItem* item )
 {
-    m_data->itemList.removeItem( item );
+    m_data->isIndexValid = false;
+
+    if ( m_data->isSorted )
+        m_data->itemList.removeItem( item );
+    else
+        m_data->itemList.removeOne( item );
+}
+
+/*!
+   \brief Start a sequence of modifications
+
+   Until the matching endUpdate() items are appended to the list
+   without sorting them by their z value. Calls might be nested.
+
+   \code
+   plot->beginUpdate();
+
+   for ( int i = 0; i < curves.size(); i++ )
+       curves[i]->attach( plot );
+
+   plot->endUpdate();
+   \endcode
+
+   \sa endUpdate(), isUpdating()
+ */
+void QwtPlotDict::beginUpdate()
+{
+    m_data->updateDepth++;
+}
+
+/*!
+   \brief Finish a sequence of modifications
+
+   When the outermost sequence has been finished the items
+   are sorted by their z value.
+
+   \sa beginUpdate(), isUpdating()
+ */
+void QwtPlotDict::endUpdate()
+{
+    if ( m_data->updateDepth <= 0 )
+        return;
+
+    if ( --m_data->updateDepth == 0 && !m_data->isSorted )
+    {
+        m_data->itemList.sortItems();
+        m_data->isSorted = true;
+    }
+}
+
+/*!
+   \return True, between beginUpdate() and endUpdate()
+   \sa beginUpdate(), endUpdate()
+ */
+bool QwtPlotDict::isUpdating() const
+{
+    return m_data->updateDepth > 0;
 }
 
 /*!
@@ -137,7 +454,9 @@ void QwtPlotDict::removeItem( QwtPlotItem* item )
  */
 void QwtPlotDict::detachItems( int rtti, bool autoDelete )
 {
-    PrivateData::ItemList list = m_data->itemList;
+    beginUpdate();
+
+    const QwtPlotItemList list = itemList();
     QwtPlotItemIterator it = list.constBegin();
     while ( it != list.constEnd() )
     {
@@ -152,6 +471,8 @@ void QwtPlotDict::detachItems( int rtti, bool autoDelete )
                 delete item;
         }
     }
+
+    endUpdate();
 }
 
 /*!
@@ -165,6 +486,12 @@ void QwtPlotDict::detachItems( int rtti, bool autoDelete )
  */
 const QwtPlotItemList& QwtPlotDict::itemList() const
 {
+    if ( !m_data->isSorted )
+    {
+        m_data->itemList.sortItems();
+        m_data->isSorted = true;
+    }
+
     return m_data->itemList;
 }
 
@@ -175,12 +502,12 @@ const QwtPlotItemList& QwtPlotDict::itemList() const
  */
 QwtPlotItemList QwtPlotDict::itemList( int rtti ) const
 {
+    const QwtPlotItemList& list = itemList();
     if ( rtti == QwtPlotItem::Rtti_PlotItem )
-        return m_data->itemList;
+        return list;
 
     QwtPlotItemList items;
 
-    PrivateData::ItemList list = m_data->itemList;
     for ( QwtPlotItemIterator it = list.constBegin(); it != list.constEnd(); ++it )
     {
         QwtPlotItem* item = *it;
@@ -190,3 +517,62 @@ QwtPlotItemList QwtPlotDict::itemList( int rtti ) const
 
     return items;
 }
+
+/*!
+   \brief Find the items, that intersect with a rectangle
+
+   The items are found from an index over their bounding rectangles,
+   that is built, when it is needed the first time. Items without a valid
+   width or height of their bounding rectangle are unbounded in
+   the corresponding direction and are always included.
+
+   \param rect Rectangle in scale coordinates of the axes
+   \param xAxis X axis
+   \param yAxis Y axis
+
+   \return Items attached to the axes, whose bounding rectangles
+           intersect with rect - in increasing z order
+
+   \note The index needs to be invalidated by invalidateItemIndex(), when
+         the bounding rectangle of an item has been changed. QwtPlot does this,
+         when being notified by QwtPlotItem::itemChanged().
+
+   \sa QwtPlotItem::boundingRect(), invalidateItemIndex()
+ */
+QwtPlotItemList QwtPlotDict::intersectingItems( const QRectF& rect,
+    QwtAxisId xAxis, QwtAxisId yAxis ) const
+{
+    const QwtPlotItemList& list = itemList();
+
+    if ( !m_data->isIndexValid )
+        m_data->buildIndex();
+
+    QwtPlotItemList items;
+
+    QMap< int, ItemTree >::const_iterator it =
+        m_data->itemIndex.constFind( qwtIndexKey( xAxis, yAxis ) );
+
+    if ( it != m_data->itemIndex.constEnd() )
+    {
+        QVector< int > positions;
+        it.value().query( Box( rect.normalized() ), positions );
+
+        std::sort( positions.begin(), positions.end() );
+
+        for ( int i = 0; i < positions.size(); i++ )
+            items += list[ positions[i] ];
+    }
+
+    return items;
+}
+
+/*!
+   \brief Invalidate the index over the bounding rectangles of the items
+
+   The index is rebuilt, when it is needed the next time.
+   \sa intersectingItems()
+ */
+void QwtPlotDict::invalidateItemIndex()
+{
+    m_data->isIndexValid = false;
+}
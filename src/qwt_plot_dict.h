@@ -27,6 +27,14 @@ typedef QList< QwtPlotItem* >::ConstIterator QwtPlotItemIterator;
    QwtPlotDict can be used to get access to all QwtPlotItem items - or all
    items of a specific type -  that are currently on the plot.
 
+   Attaching or detaching many items can be enclosed by beginUpdate()
+   and endUpdate(). Then the items are sorted once, instead of being
+   inserted one by one.
+
+   For plots with many items intersectingItems() finds the items
+   being located in a rectangle from an index over their bounding
+   rectangles, without iterating over all of them.
+
    \sa QwtPlotItem::attach(), QwtPlotItem::detach(), QwtPlotItem::z()
  */
 class QWT_EXPORT QwtPlotDict
@@ -41,13 +49,23 @@ class QWT_EXPORT QwtPlotDict
     const QwtPlotItemList& itemList() const;
     QwtPlotItemList itemList( int rtti ) const;
 
+    QwtPlotItemList intersectingItems( const QRectF&,
+        QwtAxisId xAxis, QwtAxisId yAxis ) const;
+
     void detachItems( int rtti = QwtPlotItem::Rtti_PlotItem,
         bool autoDelete = true );
 
+    virtual void beginUpdate();
+    virtual void endUpdate();
+
+    bool isUpdating() const;
+
   protected:
     void insertItem( QwtPlotItem* );
     void removeItem( QwtPlotItem* );
 
+    void invalidateItemIndex();
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -11,6 +11,7 @@
 #include "qwt_scale_map.h"
 #include "qwt_plot.h"
 #include "qwt_plot_canvas.h"
+#include "qwt_plot_abstract_canvas.h"
 #include "qwt_plot_seriesitem.h"
 
 #include <qpainter.h>
@@ -164,6 +165,16 @@ QRegion QwtPlotDirectPainter::clipRegion() const
    will result in faster painting, if the paint engine of the canvas widget
    supports this feature.
 
+   For the OpenGL canvases ( QwtPlotOpenGLCanvas, QwtPlotGLCanvas,
+   QwtPlotRhiCanvas ) the points are painted into the backing store,
+   that is presented with the next update of the canvas - see
+   QwtPlotAbstractGLCanvas::beginIncrementalPaint(). Without a valid
+   backing store the canvas needs to be replotted.
+
+   When a replot of the plot is pending - see QwtPlot::isReplotPending() -
+   nothing is painted, as the points will be painted with the replot. So
+   the incremental updates are limited by QwtPlot::setMaxReplotRate() too.
+
    \param seriesItem Item to be painted
    \param from Index of the first point to be painted
    \param to Index of the last point to be painted. If to < 0 the
@@ -175,9 +186,44 @@ void QwtPlotDirectPainter::drawSeries(
     if ( seriesItem == NULL || seriesItem->plot() == NULL )
         return;
 
+    if ( seriesItem->plot()->isReplotPending() )
+        return;
+
     QWidget* canvas = seriesItem->plot()->canvas();
     const QRect canvasRect = canvas->contentsRect();
 
+    QwtPlotAbstractGLCanvas* glCanvas =
+        dynamic_cast< QwtPlotAbstractGLCanvas* >( canvas );
+
+    if ( glCanvas )
+    {
+        /*
+            Painting on an OpenGL widget is only possible from its
+            paint handler. So we paint into its backing store, that
+            gets presented without a replot.
+         */
+        QPainter painter;
+        if ( glCanvas->beginIncrementalPaint( &painter ) )
+        {
+            QRect rect = canvasRect;
+            if ( m_data->hasClipping )
+            {
+                painter.setClipRegion( m_data->clipRegion );
+                rect &= m_data->clipRegion.boundingRect();
+            }
+
+            qwtRenderItem( &painter, canvasRect, seriesItem, from, to );
+            glCanvas->endIncrementalPaint( &painter, rect );
+        }
+        else
+        {
+            // the new points will be painted with the replot
+            QMetaObject::invokeMethod( canvas, "replot", Qt::DirectConnection );
+        }
+
+        return;
+    }
+
     QwtPlotCanvas* plotCanvas = qobject_cast< QwtPlotCanvas* >( canvas );
 
     if ( plotCanvas && qwtHasBackingStore( plotCanvas ) )
@@ -145,6 +145,49 @@ void QwtPlotGLCanvas::clearBackingStore()
     m_data->fbo = NULL;
 }
 
+/*!
+   \brief Open a painter on the framebuffer object of the backing store
+
+   \param painter Painter to be opened on the backing store
+   \return false, when the backing store is disabled or needs to
+           be rendered anyway
+
+   \sa endIncrementalPaint(), QwtPlotDirectPainter::drawSeries()
+ */
+bool QwtPlotGLCanvas::beginIncrementalPaint( QPainter* painter )
+{
+    if ( !testPaintAttribute( QwtPlotGLCanvas::BackingStore )
+        || m_data->fbo == NULL || m_data->fboDirty || !isValid() )
+    {
+        return false;
+    }
+
+    makeCurrent();
+
+    painter->begin( m_data->fbo );
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( NULL );
+    painter->scale( pixelRatio, pixelRatio );
+
+    return true;
+}
+
+/*!
+   \brief Close a painter opened by beginIncrementalPaint()
+
+   The framebuffer object is blitted to the widget with the next paintGL().
+
+   \param painter Painter opened by beginIncrementalPaint()
+   \param rect Part of the canvas, that has been modified
+
+   \sa beginIncrementalPaint()
+ */
+void QwtPlotGLCanvas::endIncrementalPaint( QPainter* painter, const QRect& rect )
+{
+    painter->end();
+    update( rect );
+}
+
 /*!
    Calculate the painter path for a styled or rounded border
 
@@ -63,6 +63,9 @@ class QWT_EXPORT QwtPlotGLCanvas : public QGLWidget, public QwtPlotAbstractGLCan
     Q_INVOKABLE virtual void invalidateBackingStore() QWT_OVERRIDE;
     Q_INVOKABLE QPainterPath borderPath( const QRect& ) const;
 
+    virtual bool beginIncrementalPaint( QPainter* ) QWT_OVERRIDE;
+    virtual void endIncrementalPaint( QPainter*, const QRect& ) QWT_OVERRIDE;
+
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
   public Q_SLOTS:
@@ -12,14 +12,512 @@
 #include "qwt_painter.h"
 #include "qwt_text.h"
 #include "qwt_graphic.h"
+#include "qwt_math.h"
+#include "qwt_render_statistics.h"
+#include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
+
+#include <qpainter.h>
+#include <qimage.h>
+#include <qregion.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#include <qmutex.h>
+#include <qtimer.h>
+#include <qmap.h>
+#include <qlist.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // size of the tiles in pixels
+    const int qwtTileSize = 256;
+
+    // a level is the width/height of the complete graphic as power of 2
+    const int qwtMaxTileLevel = 24;
+
+    // interval, when polling for tiles being rendered in the background
+    const int qwtTilePollInterval = 40;
+
+    class QwtGraphicTile
+    {
+      public:
+        QwtGraphicTile()
+            : usage( 0 )
+        {
+        }
+
+        QImage image;
+        uint usage;
+    };
+
+    class QwtGraphicTileRequest
+    {
+      public:
+        quint64 key;
+        QSize levelSize;
+        QPoint pos;
+    };
+
+    class QwtGraphicTileResult
+    {
+      public:
+        quint64 key;
+        QImage image;
+    };
+}
+
+static inline quint64 qwtTileKey( int levelX, int levelY, int col, int row )
+{
+    return ( quint64( levelX ) << 58 ) | ( quint64( levelY ) << 52 )
+        | ( quint64( col ) << 26 ) | quint64( row );
+}
+
+static int qwtTileLevel( double length )
+{
+    int level = 0;
+    while ( ( 1 << level ) < length )
+    {
+        if ( ++level > qwtMaxTileLevel )
+            return -1;
+    }
+
+    return level;
+}
+
+static QImage qwtRenderTile( const QwtGraphic& graphic,
+    const QSize& levelSize, const QPoint& pos, bool antialiased )
+{
+    QImage image( qwtTileSize, qwtTileSize, QImage::Format_ARGB32_Premultiplied );
+    image.fill( 0 );
+
+    // the commands outside of the tile are culled by QwtGraphic
+
+    QPainter painter( &image );
+    painter.setRenderHint( QPainter::Antialiasing, antialiased );
+    painter.translate( -pos.x(), -pos.y() );
+
+    graphic.render( &painter,
+        QRectF( 0.0, 0.0, levelSize.width(), levelSize.height() ),
+        Qt::IgnoreAspectRatio );
+
+    painter.end();
+
+    return image;
+}
 
 class QwtPlotGraphicItem::PrivateData
 {
   public:
+    PrivateData()
+        : cachePolicy( QwtPlotGraphicItem::NoCache )
+    {
+        tileCache.limit = 64 * 1024;
+        tileCache.usage = 0;
+        tileCache.antialiased = false;
+        tileCache.hasCurrent = false;
+        tileCache.generation = 0;
+        tileCache.pollTimer = NULL;
+        tileCache.pollPlot = NULL;
+    }
+
+    ~PrivateData()
+    {
+        delete tileCache.pollTimer;
+    }
+
+    bool drawTiles( const QwtPlotGraphicItem*, QPainter*,
+        const QRectF& rect, const QRectF& clipRect );
+
+    void stopRendering();
+    void clearTiles();
+
+    static void renderTiles( PrivateData* );
+
     QRectF boundingRect;
     QwtGraphic graphic;
+
+    QwtPlotGraphicItem::CachePolicy cachePolicy;
+
+    struct TileCache
+    {
+        // only accessed from the GUI thread
+
+        int limit; // in kB
+
+        QMap< quint64, QwtGraphicTile > tiles;
+        uint usage;
+
+        // triggers replots, while tiles are rendered
+        QTimer* pollTimer;
+        QwtPlot* pollPlot;
+
+        // constant, while tiles are rendered
+        bool antialiased;
+
+        // shared with the rendering thread, protected by mutex
+
+        QMutex mutex;
+        QList< QwtGraphicTileRequest > requests;
+        QList< QwtGraphicTileResult > results;
+        quint64 current;
+        bool hasCurrent;
+        int generation;
+
+#if QWT_USE_THREADS
+        QFuture< void > future;
+#endif
+    } tileCache;
+
+  private:
+    void pollResults( QwtPlot* );
+    void expireTiles( uint usage );
 };
 
+/*
+    Executed in a background thread: renders the requested tiles
+    one by one, until no more requests are pending.
+ */
+void QwtPlotGraphicItem::PrivateData::renderTiles( PrivateData* d )
+{
+    TileCache& cache = d->tileCache;
+
+    while ( true )
+    {
+        QwtGraphicTileRequest request;
+        int generation;
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( cache.requests.isEmpty() )
+            {
+                cache.hasCurrent = false;
+                return;
+            }
+
+            request = cache.requests.takeFirst();
+            generation = cache.generation;
+
+            cache.current = request.key;
+            cache.hasCurrent = true;
+        }
+
+        QwtGraphicTileResult result;
+        result.key = request.key;
+        result.image = qwtRenderTile( d->graphic,
+            request.levelSize, request.pos, cache.antialiased );
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( generation == cache.generation )
+                cache.results += result;
+
+            cache.hasCurrent = false;
+        }
+    }
+}
+
+void QwtPlotGraphicItem::PrivateData::pollResults( QwtPlot* plot )
+{
+    TileCache& cache = tileCache;
+
+    if ( cache.pollTimer == NULL )
+    {
+        cache.pollTimer = new QTimer();
+        cache.pollTimer->setSingleShot( true );
+    }
+
+    if ( plot != cache.pollPlot )
+    {
+        cache.pollTimer->disconnect();
+        QObject::connect( cache.pollTimer, SIGNAL(timeout()), plot, SLOT(replot()) );
+
+        cache.pollPlot = plot;
+    }
+
+    if ( !cache.pollTimer->isActive() )
+        cache.pollTimer->start( qwtTilePollInterval );
+}
+
+/*
+    Discarding the tiles, that have not been used for the longest time,
+    until the memory fits into the limit. Tiles, that have
+    been painted with the current usage are never discarded.
+ */
+void QwtPlotGraphicItem::PrivateData::expireTiles( uint usage )
+{
+    QMap< quint64, QwtGraphicTile >& tiles = tileCache.tiles;
+
+    const int tileMemory = qwtTileSize * qwtTileSize * 4 / 1024;
+    const int maxTiles = tileCache.limit / tileMemory;
+
+    while ( tiles.size() > maxTiles )
+    {
+        QMap< quint64, QwtGraphicTile >::iterator oldest = tiles.begin();
+
+        for ( QMap< quint64, QwtGraphicTile >::iterator it = tiles.begin();
+            it != tiles.end(); ++it )
+        {
+            if ( it->usage < oldest->usage )
+                oldest = it;
+        }
+
+        if ( oldest->usage == usage )
+            break;
+
+        tiles.erase( oldest );
+    }
+}
+
+void QwtPlotGraphicItem::PrivateData::stopRendering()
+{
+    TileCache& cache = tileCache;
+
+    {
+        QMutexLocker locker( &cache.mutex );
+
+        cache.requests.clear();
+        cache.results.clear();
+        cache.generation++;
+    }
+
+#if QWT_USE_THREADS
+    cache.future.waitForFinished();
+#endif
+}
+
+void QwtPlotGraphicItem::PrivateData::clearTiles()
+{
+    stopRendering();
+    tileCache.tiles.clear();
+}
+
+/*
+    Paint the tiles covering the visible part of rect. Missing tiles
+    are requested from the rendering thread.
+ */
+bool QwtPlotGraphicItem::PrivateData::drawTiles(
+    const QwtPlotGraphicItem* item, QPainter* painter,
+    const QRectF& rect, const QRectF& clipRect )
+{
+    const QwtPlot* plot = item->plot();
+    if ( plot == NULL || painter->transform().isScaling() )
+        return false;
+
+    // rasterizing makes only sense, when painting to the canvas
+
+    const QPaintDevice* device = painter->device();
+    const QwtPlotCanvas* canvas =
+        qobject_cast< const QwtPlotCanvas* >( plot->canvas() );
+
+    if ( device != plot->canvas()
+        && !( canvas && device == canvas->backingStore() ) )
+    {
+        return false;
+    }
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( device );
+
+    const int levelX = qwtTileLevel( rect.width() * pixelRatio );
+    const int levelY = qwtTileLevel( rect.height() * pixelRatio );
+
+    if ( levelX < 0 || levelY < 0 )
+        return false;
+
+    TileCache& cache = tileCache;
+
+    const bool antialiased = painter->testRenderHint( QPainter::Antialiasing );
+    if ( antialiased != cache.antialiased )
+    {
+        clearTiles();
+        cache.antialiased = antialiased;
+    }
+
+    QRectF visibleRect = rect & clipRect;
+    if ( painter->hasClipping() )
+        visibleRect &= painter->clipBoundingRect();
+
+    if ( visibleRect.isEmpty() )
+        return true;
+
+    {
+        QMutexLocker locker( &cache.mutex );
+
+        for ( int i = 0; i < cache.results.size(); i++ )
+        {
+            const QwtGraphicTileResult& result = cache.results[i];
+            cache.tiles[ result.key ].image = result.image;
+        }
+
+        cache.results.clear();
+    }
+
+    const QSize levelSize( 1 << levelX, 1 << levelY );
+
+    const double fx = levelSize.width() / rect.width();
+    const double fy = levelSize.height() / rect.height();
+
+    // the visible area in pixels of the level
+
+    const QRectF levelRect(
+        ( visibleRect.left() - rect.left() ) * fx,
+        ( visibleRect.top() - rect.top() ) * fy,
+        visibleRect.width() * fx, visibleRect.height() * fy );
+
+    const int numCols = ( levelSize.width() + qwtTileSize - 1 ) / qwtTileSize;
+    const int numRows = ( levelSize.height() + qwtTileSize - 1 ) / qwtTileSize;
+
+    const int col0 = qMax( qwtFloor( levelRect.left() / qwtTileSize ), 0 );
+    const int col1 = qMin( qwtCeil( levelRect.right() / qwtTileSize ), numCols ) - 1;
+    const int row0 = qMax( qwtFloor( levelRect.top() / qwtTileSize ), 0 );
+    const int row1 = qMin( qwtCeil( levelRect.bottom() / qwtTileSize ), numRows ) - 1;
+
+    // QPixmaps can't be rendered in a background thread
+
+    bool async = false;
+#if QWT_USE_THREADS
+    async = !( graphic.commandTypes() & QwtGraphic::RasterData );
+#endif
+
+    QList< QwtGraphicTileRequest > requests;
+
+    for ( int row = row0; row <= row1; row++ )
+    {
+        for ( int col = col0; col <= col1; col++ )
+        {
+            const quint64 key = qwtTileKey( levelX, levelY, col, row );
+            if ( cache.tiles.contains( key ) )
+                continue;
+
+            QwtGraphicTileRequest request;
+            request.key = key;
+            request.levelSize = levelSize;
+            request.pos = QPoint( col * qwtTileSize, row * qwtTileSize );
+
+            if ( async )
+            {
+                requests += request;
+            }
+            else
+            {
+                QwtRenderStatistics::Timer timer( QwtRenderStatistics::Raster );
+
+                cache.tiles[ key ].image = qwtRenderTile(
+                    graphic, levelSize, request.pos, antialiased );
+            }
+        }
+    }
+
+    if ( async )
+    {
+        bool isRendering;
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            cache.requests.clear();
+            for ( int i = 0; i < requests.size(); i++ )
+            {
+                if ( cache.hasCurrent && cache.current == requests[i].key )
+                    continue; // already in progress
+
+                cache.requests += requests[i];
+            }
+
+            isRendering = cache.hasCurrent || !cache.requests.isEmpty();
+        }
+
+#if QWT_USE_THREADS
+        if ( !requests.isEmpty() && cache.future.isFinished() )
+            cache.future = QtConcurrent::run( &PrivateData::renderTiles, this );
+#endif
+
+        if ( isRendering )
+            pollResults( item->plot() );
+    }
+
+    // painting the tiles
+
+    const uint usage = ++cache.usage;
+
+    QRegion missingRegion;
+
+    painter->save();
+    painter->setRenderHint( QPainter::Antialiasing, false );
+    painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+
+    for ( int row = row0; row <= row1; row++ )
+    {
+        for ( int col = col0; col <= col1; col++ )
+        {
+            const QRectF tileRect( col * qwtTileSize, row * qwtTileSize,
+                qwtTileSize, qwtTileSize );
+
+            const QRectF r = tileRect & levelRect;
+
+            const QRectF targetRect(
+                rect.left() + r.left() / fx, rect.top() + r.top() / fy,
+                r.width() / fx, r.height() / fy );
+
+            QMap< quint64, QwtGraphicTile >::iterator it =
+                cache.tiles.find( qwtTileKey( levelX, levelY, col, row ) );
+
+            if ( it != cache.tiles.end() )
+            {
+                it->usage = usage;
+                painter->drawImage( targetRect, it->image,
+                    r.translated( -tileRect.topLeft() ) );
+
+                continue;
+            }
+
+            // a preview from the next lower resolution
+
+            if ( levelX > 0 && levelY > 0 )
+            {
+                it = cache.tiles.find(
+                    qwtTileKey( levelX - 1, levelY - 1, col / 2, row / 2 ) );
+
+                if ( it != cache.tiles.end() )
+                {
+                    const QPointF pos( ( col / 2 ) * qwtTileSize,
+                        ( row / 2 ) * qwtTileSize );
+
+                    const QRectF sourceRect( 0.5 * r.left() - pos.x(),
+                        0.5 * r.top() - pos.y(), 0.5 * r.width(), 0.5 * r.height() );
+
+                    it->usage = usage;
+                    painter->drawImage( targetRect, it->image, sourceRect );
+
+                    continue;
+                }
+            }
+
+            missingRegion += targetRect.toAlignedRect();
+        }
+    }
+
+    painter->restore();
+
+    if ( !missingRegion.isEmpty() )
+    {
+        painter->save();
+        painter->setClipRegion( missingRegion, Qt::IntersectClip );
+        graphic.render( painter, rect );
+        painter->restore();
+    }
+
+    expireTiles( usage );
+
+    return true;
+}
+
 /*!
    \brief Constructor
 
@@ -53,6 +551,7 @@ QwtPlotGraphicItem::QwtPlotGraphicItem( const QwtText& title )
 //! Destructor
 QwtPlotGraphicItem::~QwtPlotGraphicItem()
 {
+    m_data->stopRendering();
     delete m_data;
 }
 
@@ -82,6 +581,9 @@ int QwtPlotGraphicItem::rtti() const
 void QwtPlotGraphicItem::setGraphic(
     const QRectF& rect, const QwtGraphic& graphic )
 {
+    // waits for tiles being rendered from the previous graphic
+    invalidateCache();
+
     m_data->boundingRect = rect;
     m_data->graphic = graphic;
 
@@ -98,6 +600,73 @@ QwtGraphic QwtPlotGraphicItem::graphic() const
     return m_data->graphic;
 }
 
+/*!
+   Change the cache policy
+
+   The default policy is NoCache
+
+   \param policy Cache policy
+   \sa CachePolicy, cachePolicy()
+ */
+void QwtPlotGraphicItem::setCachePolicy( CachePolicy policy )
+{
+    if ( m_data->cachePolicy != policy )
+    {
+        m_data->cachePolicy = policy;
+
+        invalidateCache();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Cache policy
+   \sa CachePolicy, setCachePolicy()
+ */
+QwtPlotGraphicItem::CachePolicy QwtPlotGraphicItem::cachePolicy() const
+{
+    return m_data->cachePolicy;
+}
+
+/*!
+   \brief Limit the memory for the tiles of the TileCache policy
+
+   When the tiles of all cached resolutions exceed the limit, the tiles,
+   that have not been displayed for the longest time, are discarded.
+   The tiles being displayed are never discarded.
+
+   The default limit is 64MB.
+
+   \param kiloBytes Memory limit in kilobytes
+   \sa cacheLimit(), setCachePolicy()
+ */
+void QwtPlotGraphicItem::setCacheLimit( int kiloBytes )
+{
+    m_data->tileCache.limit = qMax( kiloBytes, 0 );
+}
+
+/*!
+   \return Memory limit for the tiles of the TileCache policy in kilobytes
+   \sa setCacheLimit()
+ */
+int QwtPlotGraphicItem::cacheLimit() const
+{
+    return m_data->tileCache.limit;
+}
+
+/*!
+   Invalidate the tiles of the TileCache policy
+
+   invalidateCache() waits until the tile, that is currently rendered
+   in the background, has been finished.
+
+   \sa setCachePolicy()
+ */
+void QwtPlotGraphicItem::invalidateCache()
+{
+    m_data->clearTiles();
+}
+
 //! Bounding rectangle of the item
 QRectF QwtPlotGraphicItem::boundingRect() const
 {
@@ -132,5 +701,11 @@ void QwtPlotGraphicItem::draw( QPainter* painter,
         r.setBottom ( qRound( r.bottom() ) );
     }
 
+    if ( m_data->cachePolicy == TileCache )
+    {
+        if ( m_data->drawTiles( this, painter, r, canvasRect ) )
+            return;
+    }
+
     m_data->graphic.render( painter, r );
 }
@@ -23,12 +23,46 @@
    into a specific plot area. Recording of painter commands can be
    done manually by QPainter or e.g. QSvgRenderer.
 
-   \sa QwtPlotShapeItem, QwtPlotSvgItem
+   Rendering a complex graphic ( f.e. a map ) for each replot might be slow.
+   With the TileCache policy the graphic is rendered into tiles of a
+   resolution, that depends on the zoom level, and the tiles are
+   reused when panning or zooming back.
+
+   \sa QwtPlotShapeItem, QwtPlotSvgItem, setCachePolicy()
  */
 
 class QWT_EXPORT QwtPlotGraphicItem : public QwtPlotItem
 {
   public:
+    /*!
+       \brief Cache policy
+       The default policy is NoCache
+     */
+    enum CachePolicy
+    {
+        //! The graphic is rendered each time the item has to be repainted
+        NoCache,
+
+        /*!
+           The graphic is rendered into tiles of 256x256 pixels.
+           The resolution of the tiles is the size of the item on the
+           canvas rounded up to the next power of 2, so that small
+           zoom or resize operations don't invalidate them.
+
+           When painting to the canvas the tiles are rendered asynchronously
+           in a background thread, what is not possible for graphics
+           with pixmaps or images ( QwtGraphic::RasterData ). In the meantime
+           tiles of the next lower resolution are displayed - if available -
+           or the missing area is rendered directly.
+
+           Tiles, that have not been displayed for the longest time,
+           are discarded, when exceeding cacheLimit(). Painting to other
+           devices than the canvas ( f.e. when printing ) always renders
+           the graphic directly.
+         */
+        TileCache
+    };
+
     explicit QwtPlotGraphicItem( const QString& title = QString() );
     explicit QwtPlotGraphicItem( const QwtText& title );
 
@@ -37,6 +71,14 @@ class QWT_EXPORT QwtPlotGraphicItem : public QwtPlotItem
     void setGraphic( const QRectF& rect, const QwtGraphic& );
     QwtGraphic graphic() const;
 
+    void setCachePolicy( CachePolicy );
+    CachePolicy cachePolicy() const;
+
+    void setCacheLimit( int kiloBytes );
+    int cacheLimit() const;
+
+    void invalidateCache();
+
     virtual QRectF boundingRect() const QWT_OVERRIDE;
 
     virtual void draw( QPainter*,
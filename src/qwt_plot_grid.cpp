@@ -15,12 +15,63 @@
 
 #include <qpainter.h>
 #include <qpen.h>
+#include <qimage.h>
+#include <qmutex.h>
 
 static inline bool qwtFuzzyGreaterOrEqual( double d1, double d2 )
 {
     return ( d1 >= d2 ) || qFuzzyCompare( d1, d2 );
 }
 
+static inline bool qwtIsSameMap(
+    const QwtScaleMap& map1, const QwtScaleMap& map2 )
+{
+    return ( map1.s1() == map2.s1() ) && ( map1.s2() == map2.s2() )
+        && ( map1.p1() == map2.p1() ) && ( map1.p2() == map2.p2() );
+}
+
+namespace
+{
+    // everything, that has an effect on the rendered grid lines
+    class QwtGridCacheKey
+    {
+      public:
+        QwtGridCacheKey()
+            : pixelRatio( 0.0 )
+            , flags( 0 )
+        {
+        }
+
+        bool operator==( const QwtGridCacheKey& other ) const
+        {
+            return ( canvasRect == other.canvasRect )
+                && ( pixelRatio == other.pixelRatio )
+                && ( renderHints == other.renderHints )
+                && ( flags == other.flags )
+                && qwtIsSameMap( xMap, other.xMap )
+                && qwtIsSameMap( yMap, other.yMap )
+                && ( xScaleDiv == other.xScaleDiv )
+                && ( yScaleDiv == other.yScaleDiv )
+                && ( majorPen == other.majorPen )
+                && ( minorPen == other.minorPen );
+        }
+
+        QRectF canvasRect;
+        qreal pixelRatio;
+        QPainter::RenderHints renderHints;
+        int flags;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+
+        QwtScaleDiv xScaleDiv;
+        QwtScaleDiv yScaleDiv;
+
+        QPen majorPen;
+        QPen minorPen;
+    };
+}
+
 class QwtPlotGrid::PrivateData
 {
   public:
@@ -29,9 +80,16 @@ class QwtPlotGrid::PrivateData
         , yEnabled( true )
         , xMinEnabled( false )
         , yMinEnabled( false )
+        , cachePolicy( QwtPlotGrid::NoCache )
     {
     }
 
+    int flags() const
+    {
+        return ( xEnabled ? 0x01 : 0 ) | ( yEnabled ? 0x02 : 0 )
+            | ( xMinEnabled ? 0x04 : 0 ) | ( yMinEnabled ? 0x08 : 0 );
+    }
+
     bool xEnabled;
     bool yEnabled;
     bool xMinEnabled;
@@ -42,6 +100,15 @@ class QwtPlotGrid::PrivateData
 
     QPen majorPen;
     QPen minorPen;
+
+    QwtPlotGrid::CachePolicy cachePolicy;
+
+    struct
+    {
+        QMutex mutex;
+        QwtGridCacheKey key;
+        QImage image;
+    } cache;
 };
 
 //! Enables major grid, disables minor grid
@@ -282,6 +349,65 @@ void QwtPlotGrid::setMinorPen( const QPen& pen )
 void QwtPlotGrid::draw( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& canvasRect ) const
+{
+    const bool doCache = ( m_data->cachePolicy == PaintCache )
+        && QwtPainter::roundingAlignment( painter )
+        && painter->transform().type() <= QTransform::TxTranslate;
+
+    if ( !doCache )
+    {
+        drawGrid( painter, xMap, yMap, canvasRect );
+        return;
+    }
+
+    const QRect rect = canvasRect.toAlignedRect();
+
+    QwtGridCacheKey key;
+    key.canvasRect = canvasRect;
+    key.pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    key.renderHints = painter->renderHints();
+    key.flags = m_data->flags();
+    key.xMap = xMap;
+    key.yMap = yMap;
+    key.xScaleDiv = m_data->xScaleDiv;
+    key.yScaleDiv = m_data->yScaleDiv;
+    key.majorPen = m_data->majorPen;
+    key.minorPen = m_data->minorPen;
+
+    QMutexLocker locker( &m_data->cache.mutex );
+
+    QImage& image = m_data->cache.image;
+
+    if ( image.isNull() || !( m_data->cache.key == key ) )
+    {
+        const qreal pixelRatio = key.pixelRatio;
+
+        image = QImage( rect.size() * pixelRatio,
+            QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+        image.setDevicePixelRatio( pixelRatio );
+#endif
+        image.fill( Qt::transparent );
+
+        QPainter p( &image );
+        p.setRenderHints( key.renderHints );
+#if QT_VERSION < 0x050000
+        p.scale( pixelRatio, pixelRatio );
+#endif
+        p.translate( -rect.topLeft() );
+
+        drawGrid( &p, xMap, yMap, canvasRect );
+        p.end();
+
+        m_data->cache.key = key;
+    }
+
+    painter->drawImage( rect.topLeft(), image );
+}
+
+void QwtPlotGrid::drawGrid( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
 {
     //  draw minor grid lines
     QPen minorPen = m_data->minorPen;
@@ -324,6 +450,50 @@ void QwtPlotGrid::draw( QPainter* painter,
     }
 }
 
+/*!
+   Change the cache policy
+
+   The default policy is NoCache
+
+   \param policy Cache policy
+   \sa CachePolicy, cachePolicy(), invalidateCache()
+ */
+void QwtPlotGrid::setCachePolicy( CachePolicy policy )
+{
+    if ( m_data->cachePolicy != policy )
+    {
+        m_data->cachePolicy = policy;
+
+        invalidateCache();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Cache policy
+   \sa CachePolicy, setCachePolicy()
+ */
+QwtPlotGrid::CachePolicy QwtPlotGrid::cachePolicy() const
+{
+    return m_data->cachePolicy;
+}
+
+/*!
+   \brief Release the cached image
+
+   All attributes of the grid are part of the cache key, so calling
+   invalidateCache() is only necessary to free the memory.
+
+   \sa setCachePolicy()
+ */
+void QwtPlotGrid::invalidateCache()
+{
+    QMutexLocker locker( &m_data->cache.mutex );
+
+    m_data->cache.image = QImage();
+    m_data->cache.key = QwtGridCacheKey();
+}
+
 void QwtPlotGrid::drawLines( QPainter* painter, const QRectF& canvasRect,
     Qt::Orientation orientation, const QwtScaleMap& scaleMap,
     const QList< double >& values ) const
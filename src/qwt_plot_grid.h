@@ -28,11 +28,38 @@ class QwtScaleDiv;
    be assigned with setXDiv() and setYDiv().
    The draw() member draws the grid within a bounding
    rectangle.
+
+   Stroking many grid lines with dashed pens can be expensive for
+   large canvases. With PaintCache the lines are rendered into an image,
+   that is reused as long as the scale divisions, the maps and the size
+   of the canvas don't change.
  */
 
 class QWT_EXPORT QwtPlotGrid : public QwtPlotItem
 {
   public:
+    /*!
+       \brief Cache policy
+       The default policy is NoCache
+       \sa setCachePolicy()
+     */
+    enum CachePolicy
+    {
+        //! The grid lines are painted each time the grid is drawn
+        NoCache,
+
+        /*!
+           The grid lines are rendered into an image, whenever the
+           scale divisions, the maps, the size of the canvas or any attribute
+           of the grid have changed. Otherwise the image is painted.
+
+           The cache is only used, when painting to a paint device with
+           integer coordinates ( f.e. the plot canvas ) without any
+           scaling or rotation. All other situations are handled like NoCache.
+         */
+        PaintCache
+    };
+
     explicit QwtPlotGrid();
     virtual ~QwtPlotGrid();
 
@@ -71,6 +98,11 @@ class QWT_EXPORT QwtPlotGrid : public QwtPlotItem
     void setMinorPen( const QPen& );
     const QPen& minorPen() const;
 
+    void setCachePolicy( CachePolicy );
+    CachePolicy cachePolicy() const;
+
+    void invalidateCache();
+
     virtual void draw( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect ) const QWT_OVERRIDE;
@@ -79,6 +111,10 @@ class QWT_EXPORT QwtPlotGrid : public QwtPlotItem
         const QwtScaleDiv& xScaleDiv, const QwtScaleDiv& yScaleDiv ) QWT_OVERRIDE;
 
   private:
+    void drawGrid( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
     void drawLines( QPainter*, const QRectF&,
         Qt::Orientation, const QwtScaleMap&,
         const QList< double >& ) const;
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_group.h"
+#include "qwt_plot.h"
+#include "qwt_math.h"
+
+#include <qpointer.h>
+#include <qelapsedtimer.h>
+#include <qcoreevent.h>
+
+class QwtPlotGroup::PrivateData
+{
+  public:
+    PrivateData()
+        : maxFrameRate( 0.0 )
+        , timerId( 0 )
+    {
+    }
+
+    QList< QPointer< QwtPlot > > plots;
+    QList< QPointer< QwtPlot > > scheduledPlots;
+
+    double maxFrameRate;
+
+    int timerId;
+    QElapsedTimer lastFrame;
+};
+
+/*!
+   \brief Constructor
+   \param parent Parent object
+ */
+QwtPlotGroup::QwtPlotGroup( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtPlotGroup::~QwtPlotGroup()
+{
+    const QList< QwtPlot* > plotList = plots();
+    for ( int i = 0; i < plotList.size(); i++ )
+        removePlot( plotList[i] );
+
+    delete m_data;
+}
+
+/*!
+   \brief Add a plot to the group
+
+   A plot can be member of one group only. When it is member
+   of another group it is removed from it.
+
+   \param plot Plot to be added
+   \sa removePlot(), plots(), QwtPlot::plotGroup()
+ */
+void QwtPlotGroup::addPlot( QwtPlot* plot )
+{
+    if ( plot == NULL || plot->plotGroup() == this )
+        return;
+
+    if ( plot->plotGroup() )
+        plot->plotGroup()->removePlot( plot );
+
+    plot->setPlotGroup( this );
+    m_data->plots += plot;
+}
+
+/*!
+   \brief Remove a plot from the group
+
+   When a replot of the plot is scheduled it is done immediately.
+
+   \param plot Plot to be removed
+   \sa addPlot(), plots()
+ */
+void QwtPlotGroup::removePlot( QwtPlot* plot )
+{
+    if ( plot == NULL || plot->plotGroup() != this )
+        return;
+
+    m_data->plots.removeAll( plot );
+
+    const bool isScheduled = m_data->scheduledPlots.removeAll( plot ) > 0;
+
+    plot->setPlotGroup( NULL );
+
+    if ( isScheduled )
+        plot->replot();
+}
+
+/*!
+   \return Plots of the group
+   \sa addPlot(), removePlot()
+ */
+QList< QwtPlot* > QwtPlotGroup::plots() const
+{
+    QList< QwtPlot* > plotList;
+
+    for ( int i = 0; i < m_data->plots.size(); i++ )
+    {
+        if ( m_data->plots[i] )
+            plotList += m_data->plots[i];
+    }
+
+    return plotList;
+}
+
+/*!
+   \brief Limit the number of frames per second
+
+   Replot requests, that arrive before the next frame is due,
+   are collected and processed together with the next frame.
+
+   \param fps Maximum number of frames per second. A value <= 0.0
+              means, that the frame is rendered, when the event loop
+              is entered again. The default setting is 0.0.
+
+   \sa maxFrameRate()
+ */
+void QwtPlotGroup::setMaxFrameRate( double fps )
+{
+    m_data->maxFrameRate = qwtMaxF( fps, 0.0 );
+}
+
+/*!
+   \return Maximum number of frames per second
+   \sa setMaxFrameRate()
+ */
+double QwtPlotGroup::maxFrameRate() const
+{
+    return m_data->maxFrameRate;
+}
+
+/*!
+   \brief Schedule a replot of a plot for the next frame
+
+   This method is called from QwtPlot::replot() for members of the group.
+
+   \param plot Plot member of the group
+   \sa replot(), setMaxFrameRate()
+ */
+void QwtPlotGroup::scheduleReplot( QwtPlot* plot )
+{
+    if ( plot == NULL || plot->plotGroup() != this )
+        return;
+
+    if ( !m_data->scheduledPlots.contains( plot ) )
+        m_data->scheduledPlots += plot;
+
+    if ( m_data->timerId == 0 )
+    {
+        int delay = 0;
+
+        if ( m_data->maxFrameRate > 0.0 && m_data->lastFrame.isValid() )
+        {
+            const double interval = 1000.0 / m_data->maxFrameRate;
+
+            const double elapsed = m_data->lastFrame.elapsed();
+            if ( elapsed < interval )
+                delay = qwtCeil( interval - elapsed );
+        }
+
+        m_data->timerId = startTimer( delay );
+    }
+}
+
+//! Replot all plots of the group with the next frame
+void QwtPlotGroup::replot()
+{
+    for ( int i = 0; i < m_data->plots.size(); i++ )
+    {
+        if ( m_data->plots[i] )
+            m_data->plots[i]->replot();
+    }
+}
+
+/*!
+   Render the scheduled plots, when the frame is due
+   \param event Timer event
+ */
+void QwtPlotGroup::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->timerId )
+    {
+        killTimer( m_data->timerId );
+        m_data->timerId = 0;
+
+        renderFrame();
+        return;
+    }
+
+    QObject::timerEvent( event );
+}
+
+void QwtPlotGroup::renderFrame()
+{
+    m_data->lastFrame.start();
+
+    QList< QwtPlot* > plotList;
+    for ( int i = 0; i < m_data->scheduledPlots.size(); i++ )
+    {
+        if ( m_data->scheduledPlots[i] )
+            plotList += m_data->scheduledPlots[i];
+    }
+
+    m_data->scheduledPlots.clear();
+
+    QwtPlot::renderFrames( plotList );
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_group.cpp"
+#endif
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_GROUP_H
+#define QWT_PLOT_GROUP_H
+
+#include "qwt_global.h"
+#include <qobject.h>
+#include <qlist.h>
+
+class QwtPlot;
+
+/*!
+   \brief A scheduler for the replots of several plots
+
+   Dashboards often display many plots, that are updated from
+   the same source of data. When each plot calls replot() on its
+   own every plot is rendered in the GUI thread one after the other,
+   and the updates of the plots are not synchronized.
+
+   A replot() of a plot, that is member of a QwtPlotGroup, only schedules
+   the plot for the next frame of the group. All requests are coalesced
+   until the frame is due, what is limited by maxFrameRate(). Then
+   the plot items of all scheduled plots are rendered in parallel - each
+   plot in a thread of their own - and the rendered images are displayed
+   together with the next update of the canvases.
+
+   \code
+   QwtPlotGroup* group = new QwtPlotGroup( this );
+   group->setMaxFrameRate( 30 );
+
+   for ( int i = 0; i < plots.size(); i++ )
+       group->addPlot( plots[i] );
+   \endcode
+
+   \note The GUI thread is waiting, while the items are rendered, so
+         they can't be modified meanwhile. But the items of different
+         plots are painted in parallel, so the same restrictions as for
+         QwtPlot::setAsyncReplot() apply.
+
+   \sa QwtPlot::setAsyncReplot(), QwtPlot::plotGroup()
+ */
+class QWT_EXPORT QwtPlotGroup : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtPlotGroup( QObject* parent = NULL );
+    virtual ~QwtPlotGroup();
+
+    void addPlot( QwtPlot* );
+    void removePlot( QwtPlot* );
+
+    QList< QwtPlot* > plots() const;
+
+    void setMaxFrameRate( double fps );
+    double maxFrameRate() const;
+
+    void scheduleReplot( QwtPlot* );
+
+  public Q_SLOTS:
+    void replot();
+
+  protected:
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
+  private:
+    void renderFrame();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
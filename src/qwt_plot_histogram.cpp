@@ -15,6 +15,7 @@
 
 #include <qstring.h>
 #include <qpainter.h>
+#include <qmath.h>
 
 static inline bool qwtIsCombinable( const QwtInterval& d1,
     const QwtInterval& d2 )
@@ -34,19 +35,49 @@ static inline bool qwtIsCombinable( const QwtInterval& d1,
     return false;
 }
 
+/*
+   Append a column to rects. When the column and the previous
+   one are both inside of the same pixel column they are merged.
+ */
+static inline void qwtAddColumn( QVector< QRectF >& rects,
+    const QRectF& rect, Qt::Orientation orientation )
+{
+    if ( !rects.isEmpty() )
+    {
+        QRectF& last = rects.last();
+
+        if ( orientation == Qt::Vertical )
+        {
+            const int pos = qFloor( last.left() );
+            if ( qFloor( last.right() ) == pos
+                && qFloor( rect.left() ) == pos && qFloor( rect.right() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
+        else
+        {
+            const int pos = qFloor( last.top() );
+            if ( qFloor( last.bottom() ) == pos
+                && qFloor( rect.top() ) == pos && qFloor( rect.bottom() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
+    }
+
+    rects += rect;
+}
+
 class QwtPlotHistogram::PrivateData
 {
   public:
     PrivateData()
         : baseline( 0.0 )
         , style( Columns )
-        , symbol( NULL )
-    {
-    }
-
-    ~PrivateData()
     {
-        delete symbol;
     }
 
     double baseline;
@@ -54,7 +85,9 @@ class QwtPlotHistogram::PrivateData
     QPen pen;
     QBrush brush;
     QwtPlotHistogram::HistogramStyle style;
-    const QwtColumnSymbol* symbol;
+    QSharedPointer< const QwtColumnSymbol > symbol;
+
+    QwtPlotHistogram::PaintAttributes paintAttributes;
 };
 
 /*!
@@ -121,6 +154,30 @@ QwtPlotHistogram::HistogramStyle QwtPlotHistogram::style() const
     return m_data->style;
 }
 
+/*!
+   Specify an attribute how to draw the histogram
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotHistogram::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa setPaintAttribute()
+ */
+bool QwtPlotHistogram::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
 /*!
    Build and assign a pen
 
@@ -206,10 +263,25 @@ const QBrush& QwtPlotHistogram::brush() const
         it is recommended to overload drawColumn().
  */
 void QwtPlotHistogram::setSymbol( const QwtColumnSymbol* symbol )
+{
+    if ( symbol != m_data->symbol.data() )
+        setSymbol( QSharedPointer< const QwtColumnSymbol >( symbol ) );
+}
+
+/*!
+   \brief Assign a symbol, that might be shared with other items
+
+   Histograms with the same symbol can share one instance
+   instead of having individual copies.
+
+   \param symbol Symbol
+   \sa symbol()
+ */
+void QwtPlotHistogram::setSymbol(
+    const QSharedPointer< const QwtColumnSymbol >& symbol )
 {
     if ( symbol != m_data->symbol )
     {
-        delete m_data->symbol;
         m_data->symbol = symbol;
 
         legendChanged();
@@ -223,7 +295,7 @@ void QwtPlotHistogram::setSymbol( const QwtColumnSymbol* symbol )
  */
 const QwtColumnSymbol* QwtPlotHistogram::symbol() const
 {
-    return m_data->symbol;
+    return m_data->symbol.data();
 }
 
 /*!
@@ -456,7 +528,7 @@ void QwtPlotHistogram::drawOutline( QPainter* painter,
    \param to Index of the last sample to be painted. If to < 0 the
          histogram will be painted to its last point.
 
-   \sa setStyle(), style(), setSymbol(), drawColumn()
+   \sa setStyle(), style(), setSymbol(), drawColumn(), BatchColumns
  */
 void QwtPlotHistogram::drawColumns( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -465,6 +537,16 @@ void QwtPlotHistogram::drawColumns( QPainter* painter,
     painter->setPen( m_data->pen );
     painter->setBrush( m_data->brush );
 
+    if ( m_data->paintAttributes & BatchColumns )
+    {
+        if ( m_data->symbol.isNull() ||
+            m_data->symbol->style() == QwtColumnSymbol::NoStyle )
+        {
+            drawColumnsBatched( painter, xMap, yMap, from, to );
+            return;
+        }
+    }
+
     const QwtSeriesData< QwtIntervalSample >* series = data();
 
     for ( int i = from; i <= to; i++ )
@@ -478,6 +560,49 @@ void QwtPlotHistogram::drawColumns( QPainter* painter,
     }
 }
 
+/*!
+   Draw all columns as plain rectangles by one call of QPainter::drawRects()
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param from Index of the first sample to be painted
+   \param to Index of the last sample to be painted
+
+   \sa drawColumns(), BatchColumns
+ */
+void QwtPlotHistogram::drawColumnsBatched( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const QwtSeriesData< QwtIntervalSample >* series = data();
+
+    QVector< QRectF > rects;
+    rects.reserve( to - from + 1 );
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtIntervalSample sample = series->sample( i );
+        if ( sample.interval.isNull() )
+            continue;
+
+        QRectF r = columnRect( sample, xMap, yMap ).toRect();
+        if ( doAlign )
+        {
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+        }
+
+        qwtAddColumn( rects, r, orientation() );
+    }
+
+    QwtPainter::drawRects( painter, rects.constData(), rects.size() );
+}
+
 /*!
    Draw a histogram in Lines style()
 
@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_plot_seriesitem.h"
 
+#include <qsharedpointer.h>
+
 class QwtColumnSymbol;
 class QwtColumnRect;
 class QColor;
@@ -79,12 +81,38 @@ class QWT_EXPORT QwtPlotHistogram
         UserStyle = 100
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        The default setting disables all attributes
+
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+           In Columns style() without a symbol() the rectangles of all
+           columns are collected and painted by one call of
+           QPainter::drawRects(). Columns, that are narrower than a pixel
+           and located in the same pixel column, are merged into
+           one rectangle.
+
+           As the columns are not painted one by one drawColumn()
+           is not called, when this attribute is enabled.
+         */
+        BatchColumns = 0x01
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
     explicit QwtPlotHistogram( const QString& title = QString() );
     explicit QwtPlotHistogram( const QwtText& title );
     virtual ~QwtPlotHistogram();
 
     virtual int rtti() const QWT_OVERRIDE;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setPen( const QColor&,
         qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
 
@@ -104,6 +132,7 @@ class QWT_EXPORT QwtPlotHistogram
     HistogramStyle style() const;
 
     void setSymbol( const QwtColumnSymbol* );
+    void setSymbol( const QSharedPointer< const QwtColumnSymbol >& );
     const QwtColumnSymbol* symbol() const;
 
     virtual void drawSeries( QPainter*,
@@ -126,6 +155,10 @@ class QWT_EXPORT QwtPlotHistogram
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         int from, int to ) const;
 
+    void drawColumnsBatched( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        int from, int to ) const;
+
     void drawOutline( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         int from, int to ) const;
@@ -142,4 +175,6 @@ class QWT_EXPORT QwtPlotHistogram
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotHistogram::PaintAttributes )
+
 #endif
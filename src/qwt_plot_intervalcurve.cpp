@@ -9,14 +9,16 @@
 
 #include "qwt_plot_intervalcurve.h"
 #include "qwt_interval_symbol.h"
+#include "qwt_interval_series_data_pyramid.h"
 #include "qwt_scale_map.h"
 #include "qwt_clipper.h"
+#include "qwt_scratch_pool.h"
 #include "qwt_painter.h"
 #include "qwt_graphic.h"
 #include "qwt_text.h"
 
 #include <qpainter.h>
-#include <cstring>
+#include <qvector.h>
 
 static inline bool qwtIsHSampleInside( const QwtIntervalSample& sample,
     double xMin, double xMax, double yMin, double yMax )
@@ -44,12 +46,25 @@ static inline bool qwtIsVSampleInside( const QwtIntervalSample& sample,
     return !isOffScreen;
 }
 
+namespace
+{
+    class QwtIntervalPosition
+    {
+      public:
+        inline double operator()( const QwtIntervalSample& sample ) const
+        {
+            return sample.value;
+        }
+    };
+}
+
 class QwtPlotIntervalCurve::PrivateData
 {
   public:
     PrivateData():
         style( QwtPlotIntervalCurve::Tube ),
         symbol( NULL ),
+        minSymbolDistance( 0.0 ),
         pen( Qt::black ),
         brush( Qt::white )
     {
@@ -66,6 +81,7 @@ class QwtPlotIntervalCurve::PrivateData
 
     QwtPlotIntervalCurve::CurveStyle style;
     const QwtIntervalSymbol* symbol;
+    double minSymbolDistance;
 
     QPen pen;
     QBrush brush;
@@ -222,6 +238,36 @@ const QwtIntervalSymbol* QwtPlotIntervalCurve::symbol() const
     return m_data->symbol;
 }
 
+/*!
+   \brief Set a density limit for the symbols
+
+   When the average distance between the visible samples
+   is below distance, the symbols are not painted, as they would
+   merge into a solid area anyway. The default setting is 0.0,
+   what means that the symbols are always painted.
+
+   \param distance Distance in paint device coordinates
+   \sa minSymbolDistance(), drawSymbols()
+ */
+void QwtPlotIntervalCurve::setMinSymbolDistance( double distance )
+{
+    distance = qMax( distance, 0.0 );
+    if ( distance != m_data->minSymbolDistance )
+    {
+        m_data->minSymbolDistance = distance;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Density limit for the symbols
+   \sa setMinSymbolDistance()
+ */
+double QwtPlotIntervalCurve::minSymbolDistance() const
+{
+    return m_data->minSymbolDistance;
+}
+
 /*!
    Build and assign a pen
 
@@ -332,6 +378,31 @@ void QwtPlotIntervalCurve::drawSeries( QPainter* painter,
     if ( from > to )
         return;
 
+    if ( testSeriesAttribute( QwtPlotSeriesItem::OrderedSamples )
+        || data()->isMonotonic() )
+    {
+        // only the samples inside of the canvas, plus 1 on each side
+
+        double margin = QwtPainter::effectivePenWidth( m_data->pen );
+        if ( m_data->symbol )
+            margin += 0.5 * m_data->symbol->width() + 1.0;
+
+        double v1, v2;
+        if ( orientation() == Qt::Vertical )
+        {
+            v1 = xMap.invTransform( canvasRect.left() - margin );
+            v2 = xMap.invTransform( canvasRect.right() + margin );
+        }
+        else
+        {
+            v1 = yMap.invTransform( canvasRect.top() - margin );
+            v2 = yMap.invTransform( canvasRect.bottom() + margin );
+        }
+
+        qwtClipSampleRange( *data(), qMin( v1, v2 ), qMax( v1, v2 ),
+            QwtIntervalPosition(), from, to );
+    }
+
     switch ( m_data->style )
     {
         case Tube:
@@ -358,6 +429,10 @@ void QwtPlotIntervalCurve::drawSeries( QPainter* painter,
    and draws them with the pen(). The area between the curves is
    filled with the brush().
 
+   When the data is a QwtIntervalSeriesDataPyramid with increasing values
+   the intervals of all samples, that are mapped to the same pixel
+   are united.
+
    \param painter Painter
    \param xMap Maps x-values into pixel coordinates.
    \param yMap Maps y-values into pixel coordinates.
@@ -366,7 +441,8 @@ void QwtPlotIntervalCurve::drawSeries( QPainter* painter,
    \param to Index of the last sample to be painted. If to < 0 the
          series will be painted to its last sample.
 
-   \sa drawSeries(), drawSymbols()
+   \sa drawSeries(), drawSymbols(),
+       QwtIntervalSeriesDataPyramid::aggregatedSamples()
  */
 void QwtPlotIntervalCurve::drawTube( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -374,10 +450,32 @@ void QwtPlotIntervalCurve::drawTube( QPainter* painter,
 {
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
+    QVector< QwtIntervalSample > aggregated;
+
+    const QwtIntervalSeriesDataPyramid* pyramid =
+        dynamic_cast< const QwtIntervalSeriesDataPyramid* >( data() );
+
+    const bool doAggregate = pyramid && pyramid->isMonotonic();
+    if ( doAggregate )
+    {
+        const QwtScaleMap& valueMap =
+            ( orientation() == Qt::Vertical ) ? xMap : yMap;
+
+        aggregated = pyramid->aggregatedSamples( valueMap, 1.0, from, to );
+
+        from = 0;
+        to = aggregated.size() - 1;
+
+        if ( from > to )
+            return;
+    }
+
     painter->save();
 
     const size_t size = to - from + 1;
-    QPolygonF polygon( 2 * size );
+    QPolygonF polygon;
+    QwtScratchPool::acquire( polygon, 2 * size );
+
     QPointF* points = polygon.data();
 
     for ( uint i = 0; i < size; i++ )
@@ -385,7 +483,8 @@ void QwtPlotIntervalCurve::drawTube( QPainter* painter,
         QPointF& minValue = points[i];
         QPointF& maxValue = points[2 * size - 1 - i];
 
-        const QwtIntervalSample intervalSample = sample( from + i );
+        const QwtIntervalSample intervalSample =
+            doAggregate ? aggregated[from + i] : sample( from + i );
         if ( orientation() == Qt::Vertical )
         {
             double x = xMap.transform( intervalSample.value );
@@ -451,15 +550,14 @@ void QwtPlotIntervalCurve::drawTube( QPainter* painter,
             qreal pw = QwtPainter::effectivePenWidth( painter->pen() );
             const QRectF clipRect = canvasRect.adjusted( -pw, -pw, pw, pw );
 
-            QPolygonF p( size );
-
-            std::memcpy( p.data(), points, size * sizeof( QPointF ) );
-            QwtPainter::drawPolyline( painter,
-                QwtClipper::clippedPolygonF( clipRect, p ) );
+            for ( int i = 0; i < 2; i++ )
+            {
+                const QVector< QPolygonF > parts = QwtClipper::clippedPolyline(
+                    clipRect, points + i * size, size );
 
-            std::memcpy( p.data(), points + size, size * sizeof( QPointF ) );
-            QwtPainter::drawPolyline( painter,
-                QwtClipper::clippedPolygonF( clipRect, p ) );
+                for ( int j = 0; j < parts.size(); j++ )
+                    QwtPainter::drawPolyline( painter, parts[j] );
+            }
         }
         else
         {
@@ -468,12 +566,17 @@ void QwtPlotIntervalCurve::drawTube( QPainter* painter,
         }
     }
 
+    QwtScratchPool::release( polygon );
+
     painter->restore();
 }
 
 /*!
    Draw symbols for a subset of the samples
 
+   Nothing is painted, when the average distance between the samples
+   is below minSymbolDistance().
+
    \param painter Painter
    \param symbol Interval symbol
    \param xMap x map
@@ -489,6 +592,18 @@ void QwtPlotIntervalCurve::drawSymbols(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& canvasRect, int from, int to ) const
 {
+    if ( m_data->minSymbolDistance > 0.0 && to > from )
+    {
+        const QwtScaleMap& valueMap =
+            ( orientation() == Qt::Vertical ) ? xMap : yMap;
+
+        const double pos1 = valueMap.transform( sample( from ).value );
+        const double pos2 = valueMap.transform( sample( to ).value );
+
+        if ( qAbs( pos2 - pos1 ) < m_data->minSymbolDistance * ( to - from ) )
+            return;
+    }
+
     painter->save();
 
     QPen pen = symbol.pen();
@@ -104,6 +104,9 @@ class QWT_EXPORT QwtPlotIntervalCurve
     void setSymbol( const QwtIntervalSymbol* );
     const QwtIntervalSymbol* symbol() const;
 
+    void setMinSymbolDistance( double );
+    double minSymbolDistance() const;
+
     virtual void drawSeries( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
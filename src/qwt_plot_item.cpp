@@ -27,6 +27,7 @@ class QwtPlotItem::PrivateData
         , xAxisId( QwtAxis::XBottom )
         , yAxisId( QwtAxis::YLeft )
         , legendIconSize( 8, 8 )
+        , changeFlags( QwtPlotItem::AllChanges )
     {
     }
 
@@ -47,6 +48,9 @@ class QwtPlotItem::PrivateData
 
     QwtText title;
     QSize legendIconSize;
+
+    // kind of the modification, that is notified by itemChanged()
+    QwtPlotItem::ChangeFlags changeFlags;
 };
 
 /*!
@@ -174,7 +178,7 @@ void QwtPlotItem::setZ( double z )
         if ( m_data->plot )
             m_data->plot->attachItem( this, true );
 
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -252,7 +256,7 @@ void QwtPlotItem::setItemAttribute( ItemAttribute attribute, bool on )
             }
         }
 
-        itemChanged();
+        itemChanged( QwtPlotItem::GeometryChange );
     }
 }
 
@@ -285,7 +289,7 @@ void QwtPlotItem::setItemInterest( ItemInterest interest, bool on )
         else
             m_data->interests &= ~interest;
 
-        itemChanged();
+        itemChanged( QwtPlotItem::GeometryChange );
     }
 }
 
@@ -318,7 +322,7 @@ void QwtPlotItem::setRenderHint( RenderHint hint, bool on )
         else
             m_data->renderHints &= ~hint;
 
-        itemChanged();
+        itemChanged( QwtPlotItem::StyleChange );
     }
 }
 
@@ -327,10 +331,20 @@ void QwtPlotItem::setRenderHint( RenderHint hint, bool on )
 
    \param hint Render hint
    \return true/false
-   \sa setRenderHint(), RenderHint
+
+   \note RenderAntialiased is ignored while the plot reduces
+         the render quality for QwtPlot::NoAntialiasing
+
+   \sa setRenderHint(), RenderHint, QwtPlot::setInteractiveQuality()
  */
 bool QwtPlotItem::testRenderHint( RenderHint hint ) const
 {
+    if ( hint == RenderAntialiased && m_data->plot
+        && m_data->plot->testQualityReduction( QwtPlot::NoAntialiasing ) )
+    {
+        return false;
+    }
+
     return m_data->renderHints.testFlag( hint );
 }
 
@@ -459,7 +473,7 @@ void QwtPlotItem::setVisible( bool on )
     if ( on != m_data->isVisible )
     {
         m_data->isVisible = on;
-        itemChanged();
+        itemChanged( QwtPlotItem::VisibilityChange );
     }
 }
 
@@ -473,15 +487,38 @@ bool QwtPlotItem::isVisible() const
 }
 
 /*!
-   Update the legend and call QwtPlot::autoRefresh() for the
-   parent plot.
+   Notify the parent plot about a modification of the item
+
+   The plot invalidates the cached layer of the item and
+   replots, when QwtPlot::autoReplot() is enabled.
 
-   \sa QwtPlot::legendChanged(), QwtPlot::autoRefresh()
+   \sa itemChanged( ChangeFlags ), QwtPlot::autoRefresh()
  */
 void QwtPlotItem::itemChanged()
 {
     if ( m_data->plot )
-        m_data->plot->autoRefresh();
+        m_data->plot->itemChanged( this, m_data->changeFlags );
+}
+
+/*!
+   Notify the parent plot about a specific kind of modification
+
+   Like itemChanged(), but the plot can skip the work, that is not
+   affected by the modification. F.e. a pure StyleChange does not need
+   to recalculate the autoscaled axes, while a VisibilityChange does not
+   invalidate the cached layer of a static item.
+
+   \param flags Kind of the modification
+   \note The virtual itemChanged() is called, so that derived classes
+         are notified about all modifications.
+
+   \sa ChangeFlag, QwtPlot::replot()
+ */
+void QwtPlotItem::itemChanged( ChangeFlags flags )
+{
+    m_data->changeFlags = flags;
+    itemChanged();
+    m_data->changeFlags = AllChanges;
 }
 
 /*!
@@ -512,7 +549,7 @@ void QwtPlotItem::setAxes( QwtAxisId xAxisId, QwtAxisId yAxisId )
     if ( QwtAxis::isYAxis( yAxisId ) )
         m_data->yAxisId = yAxisId;
 
-    itemChanged();
+    itemChanged( QwtPlotItem::GeometryChange );
 }
 
 /*!
@@ -528,7 +565,7 @@ void QwtPlotItem::setXAxis( QwtAxisId axisId )
     if ( QwtAxis::isXAxis( axisId ) )
     {
         m_data->xAxisId = axisId;
-        itemChanged();
+        itemChanged( QwtPlotItem::GeometryChange );
     }
 }
 
@@ -545,7 +582,7 @@ void QwtPlotItem::setYAxis( QwtAxisId axisId )
     if ( QwtAxis::isYAxis( axisId ) )
     {
         m_data->yAxisId = axisId;
-        itemChanged();
+        itemChanged( QwtPlotItem::GeometryChange );
     }
 }
 
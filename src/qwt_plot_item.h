@@ -128,6 +128,18 @@ class QWT_EXPORT QwtPlotItem
         //! For QwtPlotVectorField
         Rtti_PlotVectorField,
 
+        //! For QwtPlotDensityItem
+        Rtti_PlotDensity,
+
+        //! For QwtPlotMultiCurve
+        Rtti_PlotMultiCurve,
+
+        //! For QwtPlotMarkerCollection
+        Rtti_PlotMarkerCollection,
+
+        //! For QwtPlotStackedCurve
+        Rtti_PlotStackedCurve,
+
         /*!
            Values >= Rtti_PlotUserItem are reserved for plot items
            not implemented in the Qwt library.
@@ -161,7 +173,19 @@ class QWT_EXPORT QwtPlotItem
            its bounding rectangle.
            \sa getCanvasMarginHint()
          */
-        Margins = 0x04
+        Margins = 0x04,
+
+        /*!
+           The item changes rarely compared to other items of the plot.
+           QwtPlot::drawCanvas() paints neighboured static items into a
+           cached layer, that is painted again only when one of its
+           items has been changed ( see itemChanged() ), or the geometry
+           of the canvas or a scale has been modified.
+
+           Items, that are modified without notification ( f.e. curves
+           with raw samples ) need to call itemChanged() explicitly.
+         */
+        Static = 0x08
     };
 
     Q_DECLARE_FLAGS( ItemAttributes, ItemAttribute )
@@ -208,6 +232,34 @@ class QWT_EXPORT QwtPlotItem
 
     Q_DECLARE_FLAGS( RenderHints, RenderHint )
 
+    /*!
+       \brief Kind of a modification
+
+       itemChanged() passes the kind of a modification to the plot,
+       that can skip the work, that is not affected by it.
+
+       \sa itemChanged(), QwtPlot::replot()
+     */
+    enum ChangeFlag
+    {
+        //! The data has been modified, what might affect boundingRect()
+        DataChange = 0x01,
+
+        //! Pens, brushes, symbols or other attributes of the appearance
+        StyleChange = 0x02,
+
+        //! Axes, attributes or interests of the item
+        GeometryChange = 0x04,
+
+        //! The item has been shown or hidden
+        VisibilityChange = 0x08,
+
+        //! Any modification
+        AllChanges = 0xff
+    };
+
+    Q_DECLARE_FLAGS( ChangeFlags, ChangeFlag )
+
     explicit QwtPlotItem();
     explicit QwtPlotItem( const QString& title );
     explicit QwtPlotItem( const QwtText& title );
@@ -257,6 +309,8 @@ class QWT_EXPORT QwtPlotItem
     QwtAxisId yAxis() const;
 
     virtual void itemChanged();
+    void itemChanged( ChangeFlags );
+
     virtual void legendChanged();
 
     /*!
@@ -304,6 +358,7 @@ class QWT_EXPORT QwtPlotItem
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotItem::ItemAttributes )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotItem::ItemInterests )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotItem::RenderHints )
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotItem::ChangeFlags )
 
 Q_DECLARE_METATYPE( QwtPlotItem* )
 
@@ -12,12 +12,167 @@
 #include "qwt_text_label.h"
 #include "qwt_scale_widget.h"
 #include "qwt_abstract_legend.h"
+#include "qwt_scale_draw.h"
 #include "qwt_math.h"
 
 #include <qmargins.h>
+#include <qvector.h>
 
 namespace
 {
+    /*
+       The extent of a scale widget is expensive as it includes
+       the sizes of all tick labels. We remember it together with
+       all parameters it depends on, so that it has to be recalculated
+       only for the axes, that have been modified.
+     */
+    class ScaleExtentCache
+    {
+      public:
+        ScaleExtentCache()
+            : m_isValid( false )
+            , m_dimWithoutTitle( 0 )
+        {
+        }
+
+        inline void invalidate()
+        {
+            m_isValid = false;
+        }
+
+        int dimWithoutTitle( const QwtScaleWidget* axisWidget )
+        {
+            const Key key( axisWidget );
+
+            if ( !m_isValid || !( key == m_key ) )
+            {
+                int dim = axisWidget->dimForLength( QWIDGETSIZE_MAX, key.font );
+                if ( !key.title.isEmpty() )
+                    dim -= axisWidget->titleHeightForWidth( QWIDGETSIZE_MAX );
+
+                m_key = key;
+                m_dimWithoutTitle = dim;
+                m_isValid = true;
+            }
+
+            return m_dimWithoutTitle;
+        }
+
+      private:
+        struct Key
+        {
+            Key()
+                : scaleDraw( NULL )
+                , components( 0 )
+                , spacing( 0.0 )
+                , penWidth( 0.0 )
+                , minimumExtent( 0.0 )
+                , labelRotation( 0.0 )
+                , labelAlignment( 0 )
+                , alignment( 0 )
+                , margin( 0 )
+                , titleSpacing( 0 )
+                , colorBarWidth( -1 )
+            {
+                for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+                    tickLength[i] = 0.0;
+            }
+
+            explicit Key( const QwtScaleWidget* axisWidget )
+            {
+                const QwtScaleDraw* sd = axisWidget->scaleDraw();
+
+                scaleDraw = sd;
+                font = axisWidget->font();
+                scaleDiv = sd->scaleDiv();
+
+                // the texts might change without modifying the scale div
+                const QList< double > ticks = scaleDiv.ticks( QwtScaleDiv::MajorTick );
+
+                labels.reserve( ticks.size() );
+                for ( int i = 0; i < ticks.size(); i++ )
+                    labels += sd->label( ticks[i] );
+
+                components = 0;
+                if ( sd->hasComponent( QwtAbstractScaleDraw::Backbone ) )
+                    components |= QwtAbstractScaleDraw::Backbone;
+                if ( sd->hasComponent( QwtAbstractScaleDraw::Ticks ) )
+                    components |= QwtAbstractScaleDraw::Ticks;
+                if ( sd->hasComponent( QwtAbstractScaleDraw::Labels ) )
+                    components |= QwtAbstractScaleDraw::Labels;
+
+                for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+                    tickLength[i] = sd->tickLength( static_cast< QwtScaleDiv::TickType >( i ) );
+
+                spacing = sd->spacing();
+                penWidth = sd->penWidthF();
+                minimumExtent = sd->minimumExtent();
+                labelRotation = sd->labelRotation();
+                labelAlignment = sd->labelAlignment();
+                alignment = sd->alignment();
+
+                margin = axisWidget->margin();
+                titleSpacing = axisWidget->spacing();
+                title = axisWidget->title();
+
+                colorBarWidth = -1;
+                if ( axisWidget->isColorBarEnabled()
+                    && axisWidget->colorBarInterval().isValid() )
+                {
+                    colorBarWidth = axisWidget->colorBarWidth();
+                }
+            }
+
+            bool operator==( const Key& other ) const
+            {
+                for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+                {
+                    if ( tickLength[i] != other.tickLength[i] )
+                        return false;
+                }
+
+                return ( scaleDraw == other.scaleDraw )
+                       && ( components == other.components )
+                       && ( spacing == other.spacing )
+                       && ( penWidth == other.penWidth )
+                       && ( minimumExtent == other.minimumExtent )
+                       && ( labelRotation == other.labelRotation )
+                       && ( labelAlignment == other.labelAlignment )
+                       && ( alignment == other.alignment )
+                       && ( margin == other.margin )
+                       && ( titleSpacing == other.titleSpacing )
+                       && ( colorBarWidth == other.colorBarWidth )
+                       && ( font == other.font )
+                       && ( scaleDiv == other.scaleDiv )
+                       && ( title == other.title )
+                       && ( labels == other.labels );
+            }
+
+            const QwtScaleDraw* scaleDraw;
+            QFont font;
+            QwtScaleDiv scaleDiv;
+            QVector< QwtText > labels;
+
+            int components;
+            double tickLength[QwtScaleDiv::NTickTypes];
+            double spacing;
+            double penWidth;
+            double minimumExtent;
+            double labelRotation;
+            int labelAlignment;
+            int alignment;
+
+            int margin;
+            int titleSpacing;
+            QwtText title;
+            int colorBarWidth;
+        };
+
+        bool m_isValid;
+        int m_dimWithoutTitle;
+        Key m_key;
+    };
+
     class LayoutData
     {
       public:
@@ -33,6 +188,19 @@ namespace
 
                     hint = legend->sizeHint();
                 }
+                else
+                {
+                    frameWidth = hScrollExtent = vScrollExtent = 0;
+                    hint = QSize();
+                }
+            }
+
+            bool operator==( const LegendData& other ) const
+            {
+                return ( frameWidth == other.frameWidth )
+                       && ( hScrollExtent == other.hScrollExtent )
+                       && ( vScrollExtent == other.vScrollExtent )
+                       && ( hint == other.hint );
             }
 
             QSize legendHint( const QwtAbstractLegend* legend, const QRectF& rect ) const
@@ -69,18 +237,24 @@ namespace
                 }
             }
 
+            bool operator==( const LabelData& other ) const
+            {
+                return ( frameWidth == other.frameWidth ) && ( text == other.text );
+            }
+
             QwtText text;
             int frameWidth;
         };
 
         struct ScaleData
         {
-            void init( const QwtScaleWidget* axisWidget )
+            void init( const QwtScaleWidget* axisWidget, ScaleExtentCache& cache )
             {
                 isVisible = true;
 
                 scaleWidget = axisWidget;
                 scaleFont = axisWidget->font();
+                title = axisWidget->title();
 
                 start = axisWidget->startBorderDist();
                 end = axisWidget->endBorderDist();
@@ -91,14 +265,15 @@ namespace
                 if ( axisWidget->scaleDraw()->hasComponent( QwtAbstractScaleDraw::Ticks ) )
                     tickOffset += axisWidget->scaleDraw()->maxTickLength();
 
-                dimWithoutTitle = axisWidget->dimForLength( QWIDGETSIZE_MAX, scaleFont );
-                if ( !axisWidget->title().isEmpty() )
-                    dimWithoutTitle -= axisWidget->titleHeightForWidth( QWIDGETSIZE_MAX );
+                dimWithoutTitle = cache.dimWithoutTitle( axisWidget );
             }
 
             void reset()
             {
                 isVisible = false;
+                scaleWidget = NULL;
+                scaleFont = QFont();
+                title = QwtText();
                 start = 0;
                 end = 0;
                 baseLineOffset = 0;
@@ -106,9 +281,23 @@ namespace
                 dimWithoutTitle = 0;
             }
 
+            bool operator==( const ScaleData& other ) const
+            {
+                return ( isVisible == other.isVisible )
+                       && ( scaleWidget == other.scaleWidget )
+                       && ( start == other.start )
+                       && ( end == other.end )
+                       && ( baseLineOffset == other.baseLineOffset )
+                       && ( tickOffset == other.tickOffset )
+                       && ( dimWithoutTitle == other.dimWithoutTitle )
+                       && ( scaleFont == other.scaleFont )
+                       && ( title == other.title );
+            }
+
             bool isVisible;
             const QwtScaleWidget* scaleWidget;
             QFont scaleFont;
+            QwtText title;
             int start;
             int end;
             int baseLineOffset;
@@ -128,6 +317,17 @@ namespace
                 contentsMargins[ QwtAxis::XBottom ] = m.bottom();
             }
 
+            bool operator==( const CanvasData& other ) const
+            {
+                for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+                {
+                    if ( contentsMargins[ axisPos ] != other.contentsMargins[ axisPos ] )
+                        return false;
+                }
+
+                return true;
+            }
+
             int contentsMargins[ QwtAxis::AxisPositions ];
         };
 
@@ -140,7 +340,10 @@ namespace
             NumLabels
         };
 
-        LayoutData( const QwtPlot* );
+        LayoutData();
+        LayoutData( const QwtPlot*, ScaleExtentCache[ QwtAxis::AxisPositions ] );
+
+        bool operator==( const LayoutData& ) const;
         bool hasSymmetricYAxes() const;
 
         inline ScaleData& axisData( QwtAxisId axisId )
@@ -166,10 +369,24 @@ namespace
         ScaleData m_scaleData[ QwtAxis::AxisPositions ];
     };
 
+    LayoutData::LayoutData()
+    {
+        legendData.init( NULL );
+        labelData[ Title ].init( NULL );
+        labelData[ Footer ].init( NULL );
+
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            m_scaleData[ axisPos ].reset();
+
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            canvasData.contentsMargins[ axisPos ] = 0;
+    }
+
     /*
        Extract all layout relevant data from the plot components
      */
-    LayoutData::LayoutData( const QwtPlot* plot )
+    LayoutData::LayoutData( const QwtPlot* plot,
+        ScaleExtentCache scaleExtentCache[ QwtAxis::AxisPositions ] )
     {
         legendData.init( plot->legend() );
         labelData[ Title ].init( plot->titleLabel() );
@@ -185,11 +402,12 @@ namespace
                 if ( plot->isAxisVisible( axisId ) )
                 {
                     const QwtScaleWidget* scaleWidget = plot->axisWidget( axisId );
-                    scaleData.init( scaleWidget );
+                    scaleData.init( scaleWidget, scaleExtentCache[ axisPos ] );
                 }
                 else
                 {
                     scaleData.reset();
+                    scaleExtentCache[ axisPos ].invalidate();
                 }
             }
         }
@@ -197,6 +415,20 @@ namespace
         canvasData.init( plot->canvas() );
     }
 
+    bool LayoutData::operator==( const LayoutData& other ) const
+    {
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        {
+            if ( !( m_scaleData[ axisPos ] == other.m_scaleData[ axisPos ] ) )
+                return false;
+        }
+
+        return ( legendData == other.legendData )
+               && ( labelData[ Title ] == other.labelData[ Title ] )
+               && ( labelData[ Footer ] == other.labelData[ Footer ] )
+               && ( canvasData == other.canvasData );
+    }
+
     bool LayoutData::hasSymmetricYAxes() const
     {
         using namespace QwtAxis;
@@ -1020,6 +1252,50 @@ void LayoutEngine::alignScales( QwtPlotLayout::Options options,
 class QwtPlotLayout::PrivateData
 {
   public:
+    bool restoreLayout( const QRectF& plotRect, QwtPlotLayout::Options options,
+        const QSize& legendHint, const LayoutData& layoutData )
+    {
+        if ( !lastLayout.isValid || plotRect != lastLayout.plotRect
+            || int( options ) != lastLayout.options
+            || legendHint != lastLayout.legendHint
+            || !( layoutData == lastLayout.layoutData ) )
+        {
+            return false;
+        }
+
+        // nothing geometric has changed: the rectangles might
+        // have been modified by setTitleRect() ... only
+
+        titleRect = lastLayout.titleRect;
+        footerRect = lastLayout.footerRect;
+        legendRect = lastLayout.legendRect;
+        canvasRect = lastLayout.canvasRect;
+
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            scaleRects[axisPos] = lastLayout.scaleRects[axisPos];
+
+        return true;
+    }
+
+    void storeLayout( const QRectF& plotRect, QwtPlotLayout::Options options,
+        const QSize& legendHint, const LayoutData& layoutData )
+    {
+        lastLayout.plotRect = plotRect;
+        lastLayout.options = int( options );
+        lastLayout.legendHint = legendHint;
+        lastLayout.layoutData = layoutData;
+
+        lastLayout.titleRect = titleRect;
+        lastLayout.footerRect = footerRect;
+        lastLayout.legendRect = legendRect;
+        lastLayout.canvasRect = canvasRect;
+
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            lastLayout.scaleRects[axisPos] = scaleRects[axisPos];
+
+        lastLayout.isValid = true;
+    }
+
     QRectF titleRect;
     QRectF footerRect;
     QRectF legendRect;
@@ -1027,6 +1303,25 @@ class QwtPlotLayout::PrivateData
     QRectF canvasRect;
 
     LayoutEngine engine;
+
+    // the extents of the axes and the input/output of the last activate()
+    ScaleExtentCache scaleExtentCache[QwtAxis::AxisPositions];
+
+    struct
+    {
+        bool isValid;
+
+        QRectF plotRect;
+        int options;
+        QSize legendHint;
+        LayoutData layoutData;
+
+        QRectF titleRect;
+        QRectF footerRect;
+        QRectF legendRect;
+        QRectF scaleRects[QwtAxis::AxisPositions];
+        QRectF canvasRect;
+    } lastLayout;
 };
 
 /*!
@@ -1036,6 +1331,7 @@ class QwtPlotLayout::PrivateData
 QwtPlotLayout::QwtPlotLayout()
 {
     m_data = new PrivateData;
+    m_data->lastLayout.isValid = false;
 
     setLegendPosition( QwtPlot::BottomLegend );
     setCanvasMargin( 4 );
@@ -1068,6 +1364,8 @@ void QwtPlotLayout::setCanvasMargin( int margin, int axisPos )
     if ( margin < -1 )
         margin = -1;
 
+    m_data->lastLayout.isValid = false;
+
     LayoutEngine& engine = m_data->engine;
 
     if ( axisPos == -1 )
@@ -1102,6 +1400,8 @@ int QwtPlotLayout::canvasMargin( int axisPos ) const
  */
 void QwtPlotLayout::setAlignCanvasToScales( bool on )
 {
+    m_data->lastLayout.isValid = false;
+
     for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
         m_data->engine.setAlignCanvas( axisPos, on );
 }
@@ -1126,7 +1426,10 @@ void QwtPlotLayout::setAlignCanvasToScales( bool on )
 void QwtPlotLayout::setAlignCanvasToScale( int axisPos, bool on )
 {
     if ( QwtAxis::isValid( axisPos ) )
+    {
         m_data->engine.setAlignCanvas( axisPos, on );
+        m_data->lastLayout.isValid = false;
+    }
 }
 
 /*!
@@ -1156,6 +1459,7 @@ bool QwtPlotLayout::alignCanvasToScale( int axisPos ) const
 void QwtPlotLayout::setSpacing( int spacing )
 {
     m_data->engine.setSpacing( qMax( 0, spacing ) );
+    m_data->lastLayout.isValid = false;
 }
 
 /*!
@@ -1185,6 +1489,8 @@ void QwtPlotLayout::setLegendPosition( QwtPlot::LegendPosition pos, double ratio
     if ( ratio > 1.0 )
         ratio = 1.0;
 
+    m_data->lastLayout.isValid = false;
+
     LayoutEngine& engine = m_data->engine;
 
     switch ( pos )
@@ -1384,10 +1690,17 @@ QRectF QwtPlotLayout::canvasRect() const
 
 /*!
    Invalidate the geometry of all components.
+
+   activate() recalculates the layout only, when one of the layout
+   relevant parameters of the plot components has changed. invalidate()
+   forces the next activate() to do a complete layout.
+
    \sa activate()
  */
 void QwtPlotLayout::invalidate()
 {
+    m_data->lastLayout.isValid = false;
+
     m_data->titleRect = m_data->footerRect =
         m_data->legendRect = m_data->canvasRect = QRectF();
 
@@ -1502,28 +1815,38 @@ QSize QwtPlotLayout::minimumSizeHint( const QwtPlot* plot ) const
    \param plotRect Rectangle where to place the components
    \param options Layout options
 
+   When none of the layout relevant parameters has changed since
+   the previous call, the previous geometry is reused. The extents
+   of the axes are only recalculated for the axes, that have been modified.
+
    \sa invalidate(), titleRect(), footerRect()
       legendRect(), scaleRect(), canvasRect()
  */
 void QwtPlotLayout::activate( const QwtPlot* plot,
     const QRectF& plotRect, Options options )
 {
-    invalidate();
+    // We extract all layout relevant parameters from the widgets.
+    // The extents of the axes are only recalculated for
+    // axes, that have been modified.
 
-    QRectF rect( plotRect );  // undistributed rest of the plot rect
-
-    // We extract all layout relevant parameters from the widgets,
-    // and save them to m_data->layoutData.
+    const LayoutData layoutData( plot, m_data->scaleExtentCache );
 
-    LayoutData layoutData( plot );
+    const bool hasLegend = !( options & IgnoreLegend )
+        && plot->legend() && !plot->legend()->isEmpty();
 
     QSize legendHint;
+    if ( hasLegend )
+        legendHint = layoutData.legendData.legendHint( plot->legend(), plotRect );
 
-    if ( !( options & IgnoreLegend )
-        && plot->legend() && !plot->legend()->isEmpty() )
-    {
-        legendHint = layoutData.legendData.legendHint( plot->legend(), rect );
+    if ( m_data->restoreLayout( plotRect, options, legendHint, layoutData ) )
+        return;
 
+    invalidate();
+
+    QRectF rect( plotRect );  // undistributed rest of the plot rect
+
+    if ( hasLegend )
+    {
         m_data->legendRect = m_data->engine.layoutLegend(
             options, layoutData.legendData, rect, legendHint );
 
@@ -1703,4 +2026,6 @@ void QwtPlotLayout::activate( const QwtPlot* plot,
         m_data->legendRect = m_data->engine.alignLegend(
             legendHint, m_data->canvasRect, m_data->legendRect );
     }
+
+    m_data->storeLayout( plotRect, options, legendHint, layoutData );
 }
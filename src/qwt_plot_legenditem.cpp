@@ -13,11 +13,15 @@
 #include "qwt_graphic.h"
 #include "qwt_legend_data.h"
 #include "qwt_math.h"
+#include "qwt_painter.h"
+#include "qwt_cache_registry.h"
 
 #include <qlayoutitem.h>
 #include <qpen.h>
 #include <qbrush.h>
 #include <qpainter.h>
+#include <qpaintengine.h>
+#include <qpixmap.h>
 
 namespace
 {
@@ -129,6 +133,28 @@ namespace
     }
 }
 
+static bool qwtIsCacheable( const QPainter* painter )
+{
+    // when the paint device is aligning it is not one
+    // where scalability matters ( PDF, SVG )
+
+    if ( !QwtPainter::roundingAlignment( painter ) )
+        return false;
+
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Picture:
+        case QPaintEngine::User: // usually QwtGraphic
+        {
+            // don't use a cache for record/replay devices
+            return false;
+        }
+        default:;
+    }
+
+    return true;
+}
+
 class QwtPlotLegendItem::PrivateData
 {
   public:
@@ -140,6 +166,7 @@ class QwtPlotLegendItem::PrivateData
         , backgroundBrush( Qt::NoBrush )
         , backgroundMode( QwtPlotLegendItem::LegendBackground )
         , canvasAlignment( Qt::AlignRight | Qt::AlignBottom )
+        , cacheEntry( this )
     {
         canvasOffset[ 0 ] = canvasOffset[1] = 10;
         layout = new QwtDynGridLayout();
@@ -169,6 +196,29 @@ class QwtPlotLegendItem::PrivateData
 
     QMap< const QwtPlotItem*, QList< LayoutItem* > > map;
     QwtDynGridLayout* layout;
+
+    QPixmap pixmap;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::PixmapCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->pixmap = QPixmap();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 //! Constructor
@@ -592,12 +642,65 @@ void QwtPlotLegendItem::draw( QPainter* painter,
     Q_UNUSED( yMap );
 
     m_data->layout->setGeometry( geometry( canvasRect ) );
-    if ( m_data->layout->geometry().isEmpty() )
+
+    const QRect legendRect = m_data->layout->geometry();
+    if ( legendRect.isEmpty() )
     {
         // don't draw a legend when having no content
         return;
     }
 
+    if ( !qwtIsCacheable( painter ) )
+    {
+        drawLegend( painter );
+        return;
+    }
+
+    // the legend is repainted for each replot, but its
+    // content changes rarely. So we use a cache.
+
+    int pw = 0;
+    if ( m_data->borderPen.style() != Qt::NoPen )
+        pw = qwtCeil( qMax( m_data->borderPen.widthF(), 1.0 ) );
+
+    const QRect pixmapRect = legendRect.adjusted( -pw, -pw, pw, pw );
+
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    const QSize scaledSize = pixmapRect.size() * pixelRatio;
+#else
+    const QSize scaledSize = pixmapRect.size();
+#endif
+
+    if ( m_data->pixmap.isNull() || scaledSize != m_data->pixmap.size() )
+    {
+        m_data->pixmap = QPixmap( scaledSize );
+#if QT_VERSION >= 0x050000
+        m_data->pixmap.setDevicePixelRatio( pixelRatio );
+#endif
+        m_data->pixmap.fill( Qt::transparent );
+
+        QPainter pmPainter( &m_data->pixmap );
+        pmPainter.setRenderHints( painter->renderHints() );
+        pmPainter.translate( -pixmapRect.topLeft() );
+
+        drawLegend( &pmPainter );
+
+        pmPainter.end();
+
+        m_data->cacheEntry.setMemoryUsage(
+            QwtCacheEntry::pixmapSize( m_data->pixmap ) );
+    }
+    else
+    {
+        m_data->cacheEntry.touch();
+    }
+
+    painter->drawPixmap( pixmapRect.topLeft(), m_data->pixmap );
+}
+
+void QwtPlotLegendItem::drawLegend( QPainter* painter ) const
+{
     if ( m_data->backgroundMode == QwtPlotLegendItem::LegendBackground )
         drawBackground( painter, m_data->layout->geometry() );
 
@@ -618,6 +721,28 @@ void QwtPlotLegendItem::draw( QPainter* painter,
     }
 }
 
+/*!
+   Invalidate the pixmap, that caches the rendered legend
+
+   \sa itemChanged()
+ */
+void QwtPlotLegendItem::invalidateCache()
+{
+    m_data->pixmap = QPixmap();
+    m_data->cacheEntry.setMemoryUsage( 0 );
+}
+
+/*!
+   Invalidate the cached legend and update the plot
+
+   \sa invalidateCache(), QwtPlotItem::itemChanged()
+ */
+void QwtPlotLegendItem::itemChanged()
+{
+    invalidateCache();
+    QwtPlotItem::itemChanged();
+}
+
 /*!
    Draw a rounded rect
 
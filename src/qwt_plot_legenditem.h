@@ -36,6 +36,12 @@ class QFont;
    \note An external QwtLegend with a transparent background
         on top the plot canvas might be another option
         with a similar effect.
+
+   On raster paint devices the legend is rendered into a pixmap, that
+   is reused until the legend entries, the attributes of the legend
+   item or the size of the legend are changed. Implementations of
+   drawLegendData() or drawBackground() with content, that changes
+   for other reasons, need to call invalidateCache().
  */
 
 class QWT_EXPORT QwtPlotLegendItem : public QwtPlotItem
@@ -121,6 +127,9 @@ class QWT_EXPORT QwtPlotLegendItem : public QwtPlotItem
     QList< const QwtPlotItem* > plotItems() const;
     QList< QRect > legendGeometries( const QwtPlotItem* ) const;
 
+    void invalidateCache();
+    virtual void itemChanged() QWT_OVERRIDE;
+
   protected:
     virtual void drawLegendData( QPainter*,
         const QwtPlotItem*, const QwtLegendData&, const QRectF& ) const;
@@ -128,6 +137,8 @@ class QWT_EXPORT QwtPlotLegendItem : public QwtPlotItem
     virtual void drawBackground( QPainter*, const QRectF& rect ) const;
 
   private:
+    void drawLegend( QPainter* ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -164,7 +164,10 @@ void QwtPlotMagnifier::rescale( double factor )
     plt->setAutoReplot( autoReplot );
 
     if ( doReplot )
+    {
+        plt->notifyInteraction();
         plt->replot();
+    }
 }
 
 #if QWT_MOC_INCLUDE
@@ -24,25 +24,19 @@ class QwtPlotMarker::PrivateData
         : labelAlignment( Qt::AlignCenter )
         , labelOrientation( Qt::Horizontal )
         , spacing( 2 )
-        , symbol( NULL )
         , style( QwtPlotMarker::NoLine )
         , xValue( 0.0 )
         , yValue( 0.0 )
     {
     }
 
-    ~PrivateData()
-    {
-        delete symbol;
-    }
-
     QwtText label;
     Qt::Alignment labelAlignment;
     Qt::Orientation labelOrientation;
     int spacing;
 
     QPen pen;
-    const QwtSymbol* symbol;
+    QSharedPointer< const QwtSymbol > symbol;
     LineStyle style;
 
     double xValue;
@@ -203,7 +197,7 @@ void QwtPlotMarker::drawLines( QPainter* painter,
 void QwtPlotMarker::drawSymbol( QPainter* painter,
     const QRectF& canvasRect, const QPointF& pos ) const
 {
-    if ( m_data->symbol == NULL )
+    if ( m_data->symbol.isNull() )
         return;
 
     const QwtSymbol& symbol = *m_data->symbol;
@@ -389,10 +383,24 @@ QwtPlotMarker::LineStyle QwtPlotMarker::lineStyle() const
    \sa symbol()
  */
 void QwtPlotMarker::setSymbol( const QwtSymbol* symbol )
+{
+    if ( symbol != m_data->symbol.data() )
+        setSymbol( QSharedPointer< const QwtSymbol >( symbol ) );
+}
+
+/*!
+   \brief Assign a symbol, that might be shared with other items
+
+   Markers with the same symbol can share one instance - including
+   its cache - instead of having individual copies.
+
+   \param symbol New symbol
+   \sa symbol()
+ */
+void QwtPlotMarker::setSymbol( const QSharedPointer< const QwtSymbol >& symbol )
 {
     if ( symbol != m_data->symbol )
     {
-        delete m_data->symbol;
         m_data->symbol = symbol;
 
         if ( symbol )
@@ -409,7 +417,7 @@ void QwtPlotMarker::setSymbol( const QwtSymbol* symbol )
  */
 const QwtSymbol* QwtPlotMarker::symbol() const
 {
-    return m_data->symbol;
+    return m_data->symbol.data();
 }
 
 /*!
@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_plot_item.h"
 
+#include <qsharedpointer.h>
+
 class QString;
 class QRectF;
 class QwtText;
@@ -90,6 +92,7 @@ class QWT_EXPORT QwtPlotMarker : public QwtPlotItem
     const QPen& linePen() const;
 
     void setSymbol( const QwtSymbol* );
+    void setSymbol( const QSharedPointer< const QwtSymbol >& );
     const QwtSymbol* symbol() const;
 
     void setLabel( const QwtText& );
@@ -0,0 +1,703 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_marker_collection.h"
+#include "qwt_scale_map.h"
+#include "qwt_painter.h"
+#include "qwt_symbol.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qpolygon.h>
+#include <qline.h>
+#include <qsharedpointer.h>
+
+#include <algorithm>
+
+namespace
+{
+    class QwtMarkerStyle
+    {
+      public:
+        QwtMarkerStyle()
+            : lineStyle( QwtPlotMarkerCollection::NoLine )
+        {
+        }
+
+        QSharedPointer< const QwtSymbol > symbol;
+        QwtPlotMarkerCollection::LineStyle lineStyle;
+        QPen pen;
+    };
+
+    class QwtMarkerOrder
+    {
+      public:
+        QwtMarkerOrder( const QVector< QPointF >& positions )
+            : m_positions( positions )
+        {
+        }
+
+        inline bool operator()( int index1, int index2 ) const
+        {
+            return m_positions[index1].x() < m_positions[index2].x();
+        }
+
+      private:
+        const QVector< QPointF >& m_positions;
+    };
+}
+
+static inline bool qwtHasSymbol( const QwtMarkerStyle& style )
+{
+    return style.symbol && ( style.symbol->style() != QwtSymbol::NoSymbol );
+}
+
+class QwtPlotMarkerCollection::PrivateData
+{
+  public:
+    PrivateData()
+        : labelAlignment( Qt::AlignCenter )
+        , spacing( 2 )
+        , paintAttributes( QwtPlotMarkerCollection::DropOverlappingLabels )
+        , symbolExtent( 0.0 )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+        , isDirty( true )
+    {
+    }
+
+    inline void insertMarker( int index, double x, double y, int style, int label )
+    {
+        xValues.insert( index, x );
+        yValues.insert( index, y );
+        styles.insert( index, style );
+        labels.insert( index, label );
+    }
+
+    QVector< QwtMarkerStyle > markerStyles;
+    QVector< QwtText > labelTexts;
+
+    // the markers sorted by x
+    QVector< double > xValues;
+    QVector< double > yValues;
+    QVector< int > styles;
+    QVector< int > labels;
+
+    Qt::Alignment labelAlignment;
+    int spacing;
+
+    QwtPlotMarkerCollection::PaintAttributes paintAttributes;
+
+    // half of the size of the largest symbol
+    double symbolExtent;
+
+    // text sizes of the labels for labelFont
+    mutable QFont labelFont;
+    mutable QVector< QSizeF > textSizes;
+
+    mutable QRectF boundingRect;
+    mutable bool isDirty;
+};
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotMarkerCollection::QwtPlotMarkerCollection( const QString& title )
+    : QwtPlotItem( QwtText( title ) )
+{
+    init();
+}
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotMarkerCollection::QwtPlotMarkerCollection( const QwtText& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotMarkerCollection::~QwtPlotMarkerCollection()
+{
+    delete m_data;
+}
+
+void QwtPlotMarkerCollection::init()
+{
+    m_data = new PrivateData;
+
+    setItemAttribute( QwtPlotItem::AutoScale, true );
+    setZ( 30.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotMarkerCollection
+int QwtPlotMarkerCollection::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotMarkerCollection;
+}
+
+/*!
+   Specify an attribute how to draw the markers
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotMarkerCollection::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa setPaintAttribute()
+ */
+bool QwtPlotMarkerCollection::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
+/*!
+   \brief Add a style, that can be referred by markers
+
+   \param symbol Symbol, that is drawn at the position of the marker.
+                 The collection takes ownership of the symbol. Might be NULL.
+   \param lineStyle Line style
+   \param pen Pen for the line
+
+   \return Index of the style
+   \sa addMarker(), styleCount()
+ */
+int QwtPlotMarkerCollection::addStyle( const QwtSymbol* symbol,
+    LineStyle lineStyle, const QPen& pen )
+{
+    QwtMarkerStyle style;
+    style.symbol = QSharedPointer< const QwtSymbol >( symbol );
+    style.lineStyle = lineStyle;
+    style.pen = pen;
+
+    if ( qwtHasSymbol( style ) )
+    {
+        const QSizeF sz = symbol->size();
+        m_data->symbolExtent = qwtMaxF( m_data->symbolExtent,
+            0.5 * qwtMaxF( sz.width(), sz.height() ) );
+    }
+
+    m_data->markerStyles += style;
+    itemChanged( QwtPlotItem::StyleChange );
+
+    return m_data->markerStyles.size() - 1;
+}
+
+/*!
+   \return Number of styles
+   \sa addStyle()
+ */
+int QwtPlotMarkerCollection::styleCount() const
+{
+    return m_data->markerStyles.size();
+}
+
+/*!
+   \param style Index of the style
+   \return Symbol of a style
+   \sa addStyle()
+ */
+const QwtSymbol* QwtPlotMarkerCollection::symbol( int style ) const
+{
+    if ( style < 0 || style >= m_data->markerStyles.size() )
+        return NULL;
+
+    return m_data->markerStyles[style].symbol.data();
+}
+
+/*!
+   \param style Index of the style
+   \return Line style of a style
+   \sa addStyle()
+ */
+QwtPlotMarkerCollection::LineStyle QwtPlotMarkerCollection::lineStyle( int style ) const
+{
+    if ( style < 0 || style >= m_data->markerStyles.size() )
+        return NoLine;
+
+    return m_data->markerStyles[style].lineStyle;
+}
+
+/*!
+   \param style Index of the style
+   \return Pen of the line of a style
+   \sa addStyle()
+ */
+QPen QwtPlotMarkerCollection::linePen( int style ) const
+{
+    if ( style < 0 || style >= m_data->markerStyles.size() )
+        return QPen();
+
+    return m_data->markerStyles[style].pen;
+}
+
+/*!
+   \brief Add a label, that can be referred by markers
+
+   \param text Text of the label
+   \return Index of the label
+   \sa addMarker(), labelCount()
+ */
+int QwtPlotMarkerCollection::addLabel( const QwtText& text )
+{
+    m_data->labelTexts += text;
+    itemChanged( QwtPlotItem::StyleChange );
+
+    return m_data->labelTexts.size() - 1;
+}
+
+/*!
+   \return Number of labels
+   \sa addLabel()
+ */
+int QwtPlotMarkerCollection::labelCount() const
+{
+    return m_data->labelTexts.size();
+}
+
+/*!
+   \param index Index of the label
+   \return Text of a label
+   \sa addLabel()
+ */
+QwtText QwtPlotMarkerCollection::label( int index ) const
+{
+    if ( index < 0 || index >= m_data->labelTexts.size() )
+        return QwtText();
+
+    return m_data->labelTexts[index];
+}
+
+/*!
+   \brief Add a marker
+
+   Appending markers in increasing order of x is fast, otherwise
+   the marker is inserted at its position. For inserting many markers at
+   once setMarkers() is faster.
+
+   \param pos Position of the marker
+   \param style Index of a style, see addStyle()
+   \param label Index of a label, see addLabel(). -1 means no label.
+
+   \sa setMarkers(), clear()
+ */
+void QwtPlotMarkerCollection::addMarker(
+    const QPointF& pos, int style, int label )
+{
+    const QVector< double >& xValues = m_data->xValues;
+
+    int index = xValues.size();
+    if ( !xValues.isEmpty() && pos.x() < xValues.last() )
+    {
+        index = int( std::upper_bound( xValues.constBegin(),
+            xValues.constEnd(), pos.x() ) - xValues.constBegin() );
+    }
+
+    m_data->insertMarker( index, pos.x(), pos.y(), style, label );
+    m_data->isDirty = true;
+
+    itemChanged( QwtPlotItem::DataChange );
+}
+
+/*!
+   \brief Replace all markers
+
+   \param positions Positions of the markers
+   \param styles Style indexes of the markers. Markers without
+                 an entry get the style 0.
+   \param labels Label indexes of the markers. Markers without
+                 an entry have no label.
+
+   \sa addMarker(), clear()
+ */
+void QwtPlotMarkerCollection::setMarkers( const QVector< QPointF >& positions,
+    const QVector< int >& styles, const QVector< int >& labels )
+{
+    const int numMarkers = positions.size();
+
+    QVector< int > order( numMarkers );
+    for ( int i = 0; i < numMarkers; i++ )
+        order[i] = i;
+
+    std::stable_sort( order.begin(), order.end(), QwtMarkerOrder( positions ) );
+
+    m_data->xValues.resize( numMarkers );
+    m_data->yValues.resize( numMarkers );
+    m_data->styles.resize( numMarkers );
+    m_data->labels.resize( numMarkers );
+
+    for ( int i = 0; i < numMarkers; i++ )
+    {
+        const int index = order[i];
+
+        m_data->xValues[i] = positions[index].x();
+        m_data->yValues[i] = positions[index].y();
+        m_data->styles[i] = ( index < styles.size() ) ? styles[index] : 0;
+        m_data->labels[i] = ( index < labels.size() ) ? labels[index] : -1;
+    }
+
+    m_data->isDirty = true;
+    itemChanged( QwtPlotItem::DataChange );
+}
+
+//! \return Number of markers
+int QwtPlotMarkerCollection::markerCount() const
+{
+    return m_data->xValues.size();
+}
+
+/*!
+   \param index Index of the marker in the order of increasing x
+   \return Position of a marker
+ */
+QPointF QwtPlotMarkerCollection::markerPosition( int index ) const
+{
+    if ( index < 0 || index >= m_data->xValues.size() )
+        return QPointF();
+
+    return QPointF( m_data->xValues[index], m_data->yValues[index] );
+}
+
+/*!
+   \brief Remove all markers
+
+   The styles and labels are not removed.
+   \sa setMarkers()
+ */
+void QwtPlotMarkerCollection::clear()
+{
+    m_data->xValues.clear();
+    m_data->yValues.clear();
+    m_data->styles.clear();
+    m_data->labels.clear();
+
+    m_data->isDirty = true;
+    itemChanged( QwtPlotItem::DataChange );
+}
+
+/*!
+   \brief Set the alignment of the labels
+
+   The alignment refers to the position of the marker like in
+   QwtPlotMarker::setLabelAlignment(). For markers with a VLine
+   the vertical alignment is relative to the canvas.
+
+   \param alignment Alignment
+   \sa labelAlignment()
+ */
+void QwtPlotMarkerCollection::setLabelAlignment( Qt::Alignment alignment )
+{
+    if ( alignment != m_data->labelAlignment )
+    {
+        m_data->labelAlignment = alignment;
+        itemChanged( QwtPlotItem::StyleChange );
+    }
+}
+
+/*!
+   \return Alignment of the labels
+   \sa setLabelAlignment()
+ */
+Qt::Alignment QwtPlotMarkerCollection::labelAlignment() const
+{
+    return m_data->labelAlignment;
+}
+
+/*!
+   \brief Set the spacing between a label and the position of its marker
+
+   \param spacing Spacing
+   \sa spacing(), setLabelAlignment()
+ */
+void QwtPlotMarkerCollection::setSpacing( int spacing )
+{
+    spacing = qMax( spacing, 0 );
+    if ( spacing != m_data->spacing )
+    {
+        m_data->spacing = spacing;
+        itemChanged( QwtPlotItem::StyleChange );
+    }
+}
+
+/*!
+   \return Spacing between a label and the position of its marker
+   \sa setSpacing()
+ */
+int QwtPlotMarkerCollection::spacing() const
+{
+    return m_data->spacing;
+}
+
+/*!
+   \brief Draw the visible markers
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+ */
+void QwtPlotMarkerCollection::draw( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    const QVector< double >& xValues = m_data->xValues;
+    if ( xValues.isEmpty() )
+        return;
+
+    const QRectF clipRect = canvasRect.adjusted( -m_data->symbolExtent - 1.0,
+        -m_data->symbolExtent - 1.0, m_data->symbolExtent + 1.0,
+        m_data->symbolExtent + 1.0 );
+
+    double x1 = xMap.invTransform( clipRect.left() );
+    double x2 = xMap.invTransform( clipRect.right() );
+    if ( x1 > x2 )
+        qSwap( x1, x2 );
+
+    const double* values = xValues.constData();
+
+    const int from = int( std::lower_bound( values, values + xValues.size(), x1 ) - values );
+    const int to = int( std::upper_bound( values, values + xValues.size(), x2 ) - values );
+
+    if ( from >= to )
+        return;
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const QVector< QwtMarkerStyle >& markerStyles = m_data->markerStyles;
+    const int numStyles = markerStyles.size();
+
+    QVector< QPolygonF > points( numStyles );
+    QVector< QVector< QLineF > > lines( numStyles );
+
+    for ( int i = from; i < to; i++ )
+    {
+        const int style = m_data->styles[i];
+        if ( style < 0 || style >= numStyles )
+            continue;
+
+        double x = xMap.transform( values[i] );
+        if ( doAlign )
+            x = qRound( x );
+
+        if ( markerStyles[style].lineStyle == VLine )
+            lines[style] += QLineF( x, canvasRect.top(), x, canvasRect.bottom() - 1.0 );
+
+        if ( qwtHasSymbol( markerStyles[style] ) )
+        {
+            double y = yMap.transform( m_data->yValues[i] );
+            if ( doAlign )
+                y = qRound( y );
+
+            if ( y >= clipRect.top() && y <= clipRect.bottom() )
+                points[style] += QPointF( x, y );
+        }
+    }
+
+    for ( int style = 0; style < numStyles; style++ )
+    {
+        if ( !lines[style].isEmpty() )
+        {
+            painter->setPen( markerStyles[style].pen );
+            painter->drawLines( lines[style] );
+        }
+    }
+
+    for ( int style = 0; style < numStyles; style++ )
+    {
+        if ( !points[style].isEmpty() )
+            markerStyles[style].symbol->drawSymbols( painter, points[style] );
+    }
+
+    drawLabels( painter, xMap, yMap, canvasRect, from, to );
+}
+
+void QwtPlotMarkerCollection::drawLabels( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    const QVector< QwtText >& texts = m_data->labelTexts;
+    if ( texts.isEmpty() )
+        return;
+
+    if ( painter->font() != m_data->labelFont
+        || m_data->textSizes.size() != texts.size() )
+    {
+        m_data->labelFont = painter->font();
+        m_data->textSizes.fill( QSizeF( -1.0, -1.0 ), texts.size() );
+    }
+
+    /*
+        The labels, that have been painted, sorted into columns
+        of the canvas, so that we have to compare a label with
+        its horizontal neighbours only.
+     */
+    const double columnWidth = 32.0;
+
+    QVector< QVector< QRectF > > columns;
+    if ( m_data->paintAttributes & DropOverlappingLabels )
+        columns.resize( int( canvasRect.width() / columnWidth ) + 1 );
+
+    const int spacing = m_data->spacing;
+
+    for ( int i = from; i < to; i++ )
+    {
+        const int label = m_data->labels[i];
+        if ( label < 0 || label >= texts.size() || texts[label].isEmpty() )
+            continue;
+
+        QSizeF& textSize = m_data->textSizes[label];
+        if ( textSize.width() < 0.0 )
+            textSize = texts[label].textSize( m_data->labelFont );
+
+        const int style = m_data->styles[i];
+
+        LineStyle lineStyle = NoLine;
+        QSizeF symbolOff( 0.0, 0.0 );
+        qreal pw2 = 0.5;
+
+        if ( style >= 0 && style < m_data->markerStyles.size() )
+        {
+            const QwtMarkerStyle& markerStyle = m_data->markerStyles[style];
+
+            lineStyle = markerStyle.lineStyle;
+
+            if ( lineStyle == NoLine && qwtHasSymbol( markerStyle ) )
+                symbolOff = ( markerStyle.symbol->size() + QSizeF( 1, 1 ) ) / 2;
+
+            if ( markerStyle.pen.widthF() > 0.0 )
+                pw2 = markerStyle.pen.widthF() / 2.0;
+        }
+
+        Qt::Alignment align = m_data->labelAlignment;
+        QPointF pos( xMap.transform( m_data->xValues[i] ),
+            yMap.transform( m_data->yValues[i] ) );
+
+        if ( lineStyle == VLine )
+        {
+            // like QwtPlotMarker: the alignment is relative to the canvas
+
+            if ( align & Qt::AlignTop )
+            {
+                pos.setY( canvasRect.top() );
+                align &= ~Qt::AlignTop;
+                align |= Qt::AlignBottom;
+            }
+            else if ( align & Qt::AlignBottom )
+            {
+                pos.setY( canvasRect.bottom() - 1 );
+                align &= ~Qt::AlignBottom;
+                align |= Qt::AlignTop;
+            }
+            else
+            {
+                pos.setY( canvasRect.center().y() );
+            }
+        }
+
+        const qreal xOff = qwtMaxF( pw2, symbolOff.width() );
+        const qreal yOff = qwtMaxF( pw2, symbolOff.height() );
+
+        if ( align & Qt::AlignLeft )
+            pos.rx() -= xOff + spacing + textSize.width();
+        else if ( align & Qt::AlignRight )
+            pos.rx() += xOff + spacing;
+        else
+            pos.rx() -= textSize.width() / 2;
+
+        if ( align & Qt::AlignTop )
+            pos.ry() -= yOff + spacing + textSize.height();
+        else if ( align & Qt::AlignBottom )
+            pos.ry() += yOff + spacing;
+        else
+            pos.ry() -= textSize.height() / 2;
+
+        const QRectF textRect( pos, textSize );
+        if ( !textRect.intersects( canvasRect ) )
+            continue;
+
+        if ( !columns.isEmpty() )
+        {
+            const int maxColumn = columns.size() - 1;
+
+            const int c1 = qBound( 0,
+                int( ( textRect.left() - canvasRect.left() ) / columnWidth ), maxColumn );
+            const int c2 = qBound( 0,
+                int( ( textRect.right() - canvasRect.left() ) / columnWidth ), maxColumn );
+
+            bool overlaps = false;
+            for ( int c = c1; c <= c2 && !overlaps; c++ )
+            {
+                const QVector< QRectF >& rects = columns[c];
+                for ( int j = 0; j < rects.size(); j++ )
+                {
+                    if ( rects[j].intersects( textRect ) )
+                    {
+                        overlaps = true;
+                        break;
+                    }
+                }
+            }
+
+            if ( overlaps )
+                continue;
+
+            for ( int c = c1; c <= c2; c++ )
+                columns[c] += textRect;
+        }
+
+        texts[label].draw( painter, textRect );
+    }
+}
+
+/*!
+   \return Bounding rectangle of the positions of all markers
+ */
+QRectF QwtPlotMarkerCollection::boundingRect() const
+{
+    if ( m_data->isDirty )
+    {
+        m_data->isDirty = false;
+
+        const QVector< double >& xValues = m_data->xValues;
+        const QVector< double >& yValues = m_data->yValues;
+
+        if ( xValues.isEmpty() )
+        {
+            m_data->boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+        }
+        else
+        {
+            double minY = yValues[0];
+            double maxY = yValues[0];
+
+            for ( int i = 1; i < yValues.size(); i++ )
+            {
+                minY = qMin( minY, yValues[i] );
+                maxY = qMax( maxY, yValues[i] );
+            }
+
+            m_data->boundingRect.setCoords(
+                xValues.first(), minY, xValues.last(), maxY );
+        }
+    }
+
+    return m_data->boundingRect;
+}
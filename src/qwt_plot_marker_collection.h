@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_MARKER_COLLECTION_H
+#define QWT_PLOT_MARKER_COLLECTION_H
+
+#include "qwt_global.h"
+#include "qwt_plot_item.h"
+
+#include <qvector.h>
+#include <qpen.h>
+
+class QwtSymbol;
+class QwtText;
+
+/*!
+   \brief A plot item, that displays many markers
+
+   Each QwtPlotMarker is a plot item of its own, what makes attaching,
+   sorting and painting thousands of them - f.e. events of a log -
+   slow. QwtPlotMarkerCollection stores the markers in arrays of
+   positions, style and label indexes. The styles ( symbol, line and pen )
+   and the labels are shared by all markers referring to them.
+
+   The markers are sorted by their x coordinates, so that the visible
+   markers are found by a binary search. The symbols and lines of all
+   visible markers of the same style are painted in one call.
+   With DropOverlappingLabels a label is not painted, when it would
+   overlap a label, that has been painted before.
+
+   \par Example
+   \code
+   QwtPlotMarkerCollection* events = new QwtPlotMarkerCollection();
+
+   const int errorStyle = events->addStyle(
+       new QwtSymbol( QwtSymbol::Diamond, Qt::red, Qt::NoPen, QSize( 7, 7 ) ) );
+
+   const int restartStyle = events->addStyle( NULL,
+       QwtPlotMarkerCollection::VLine, QPen( Qt::darkGray ) );
+
+   const int restartLabel = events->addLabel( QwtText( "Restart" ) );
+
+   for ( ... )
+       events->addMarker( QPointF( time, 0.0 ), errorStyle );
+
+   events->addMarker( QPointF( restartTime, 0.0 ), restartStyle, restartLabel );
+   events->attach( plot );
+   \endcode
+   \endpar
+
+   \sa QwtPlotMarker
+ */
+class QWT_EXPORT QwtPlotMarkerCollection : public QwtPlotItem
+{
+  public:
+    /*!
+       Line styles.
+       \sa addStyle()
+     */
+    enum LineStyle
+    {
+        //! No line
+        NoLine,
+
+        //! A vertical line
+        VLine
+    };
+
+    /*!
+       Attributes to modify the drawing algorithm.
+       The default setting enables DropOverlappingLabels
+
+       \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        //! Don't paint labels, that overlap a label painted before
+        DropOverlappingLabels = 0x01
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
+    explicit QwtPlotMarkerCollection( const QString& title = QString() );
+    explicit QwtPlotMarkerCollection( const QwtText& title );
+
+    virtual ~QwtPlotMarkerCollection();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
+    int addStyle( const QwtSymbol*,
+        LineStyle = NoLine, const QPen& = QPen() );
+
+    int styleCount() const;
+    const QwtSymbol* symbol( int style ) const;
+    LineStyle lineStyle( int style ) const;
+    QPen linePen( int style ) const;
+
+    int addLabel( const QwtText& );
+    int labelCount() const;
+    QwtText label( int index ) const;
+
+    void addMarker( const QPointF&, int style = 0, int label = -1 );
+
+    void setMarkers( const QVector< QPointF >& positions,
+        const QVector< int >& styles = QVector< int >(),
+        const QVector< int >& labels = QVector< int >() );
+
+    int markerCount() const;
+    QPointF markerPosition( int index ) const;
+
+    void clear();
+
+    void setLabelAlignment( Qt::Alignment );
+    Qt::Alignment labelAlignment() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    virtual void draw( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    void init();
+
+    void drawLabels( QPainter*, const QwtScaleMap& xMap,
+        const QwtScaleMap& yMap, const QRectF& canvasRect,
+        int from, int to ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotMarkerCollection::PaintAttributes )
+
+#endif
@@ -13,9 +13,13 @@
 #include "qwt_text.h"
 #include "qwt_graphic.h"
 #include "qwt_legend_data.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
 
 #include <qmap.h>
+#include <qvector.h>
+#include <qpainter.h>
+#include <qmath.h>
 
 inline static bool qwtIsIncreasing(
     const QwtScaleMap& map, const QVector< double >& values )
@@ -32,6 +36,223 @@ inline static bool qwtIsIncreasing(
     return !isInverting;
 }
 
+namespace
+{
+    class QwtBar
+    {
+      public:
+        int valueIndex;
+        QwtColumnRect rect;
+    };
+}
+
+static void qwtGroupedBars( Qt::Orientation orientation,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    double baseline, double sampleWidth, const QwtSetSample& sample,
+    QVector< QwtBar >& bars )
+{
+    const int numBars = sample.set.size();
+    if ( numBars == 0 )
+        return;
+
+    if ( orientation == Qt::Vertical )
+    {
+        const double barWidth = sampleWidth / numBars;
+
+        const double y1 = yMap.transform( baseline );
+        const double x0 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            const double x1 = x0 + i * barWidth;
+            const double x2 = x1 + barWidth;
+
+            const double y2 = yMap.transform( sample.set[i] );
+
+            QwtBar bar;
+            bar.valueIndex = i;
+
+            QwtColumnRect& barRect = bar.rect;
+            barRect.direction = ( y1 < y2 ) ?
+                QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
+            if ( i != 0 )
+                barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+
+            barRect.vInterval = QwtInterval( y1, y2 ).normalized();
+
+            bars += bar;
+        }
+    }
+    else
+    {
+        const double barHeight = sampleWidth / numBars;
+
+        const double x1 = xMap.transform( baseline );
+        const double y0 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            double y1 = y0 + i * barHeight;
+            double y2 = y1 + barHeight;
+
+            double x2 = xMap.transform( sample.set[i] );
+
+            QwtBar bar;
+            bar.valueIndex = i;
+
+            QwtColumnRect& barRect = bar.rect;
+            barRect.direction = x1 < x2 ?
+                QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+
+            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
+
+            barRect.vInterval = QwtInterval( y1, y2 );
+            if ( i != 0 )
+                barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+
+            bars += bar;
+        }
+    }
+}
+
+static void qwtStackedBars( Qt::Orientation orientation,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    double baseline, double sampleWidth, const QwtSetSample& sample,
+    QVector< QwtBar >& bars )
+{
+    const int numBars = sample.set.size();
+    if ( numBars == 0 )
+        return;
+
+    QwtInterval::BorderFlag borderFlags = QwtInterval::IncludeBorders;
+
+    if ( orientation == Qt::Vertical )
+    {
+        const double x1 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
+        const double x2 = x1 + sampleWidth;
+
+        const bool increasing = qwtIsIncreasing( yMap, sample.set );
+
+        QwtBar bar;
+        bar.rect.direction = increasing ?
+            QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+        bar.rect.hInterval = QwtInterval( x1, x2 ).normalized();
+
+        double sum = baseline;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            const double si = sample.set[ i ];
+            if ( si == 0.0 )
+                continue;
+
+            const double y1 = yMap.transform( sum );
+            const double y2 = yMap.transform( sum + si );
+
+            if ( ( y2 > y1 ) != increasing )
+            {
+                // stacked bars need to be in the same direction
+                continue;
+            }
+
+            bar.valueIndex = i;
+            bar.rect.vInterval = QwtInterval( y1, y2 ).normalized();
+            bar.rect.vInterval.setBorderFlags( borderFlags );
+
+            bars += bar;
+
+            sum += si;
+
+            if ( increasing )
+                borderFlags = QwtInterval::ExcludeMinimum;
+            else
+                borderFlags = QwtInterval::ExcludeMaximum;
+        }
+    }
+    else
+    {
+        const double y1 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
+        const double y2 = y1 + sampleWidth;
+
+        const bool increasing = qwtIsIncreasing( xMap, sample.set );
+
+        QwtBar bar;
+        bar.rect.direction = increasing ?
+            QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+        bar.rect.vInterval = QwtInterval( y1, y2 ).normalized();
+
+        double sum = baseline;
+
+        for ( int i = 0; i < numBars; i++ )
+        {
+            const double si = sample.set[ i ];
+            if ( si == 0.0 )
+                continue;
+
+            const double x1 = xMap.transform( sum );
+            const double x2 = xMap.transform( sum + si );
+
+            if ( ( x2 > x1 ) != increasing )
+            {
+                // stacked bars need to be in the same direction
+                continue;
+            }
+
+            bar.valueIndex = i;
+            bar.rect.hInterval = QwtInterval( x1, x2 ).normalized();
+            bar.rect.hInterval.setBorderFlags( borderFlags );
+
+            bars += bar;
+
+            sum += si;
+
+            if ( increasing )
+                borderFlags = QwtInterval::ExcludeMinimum;
+            else
+                borderFlags = QwtInterval::ExcludeMaximum;
+        }
+    }
+}
+
+/*
+   Append a bar to rects. When the bar and the previous
+   one are both inside of the same pixel column they are merged.
+ */
+static inline void qwtAddBar( QVector< QRectF >& rects,
+    const QRectF& rect, Qt::Orientation orientation )
+{
+    if ( !rects.isEmpty() )
+    {
+        QRectF& last = rects.last();
+
+        if ( orientation == Qt::Vertical )
+        {
+            const int pos = qFloor( last.left() );
+            if ( qFloor( last.right() ) == pos
+                && qFloor( rect.left() ) == pos && qFloor( rect.right() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
+        else
+        {
+            const int pos = qFloor( last.top() );
+            if ( qFloor( last.bottom() ) == pos
+                && qFloor( rect.top() ) == pos && qFloor( rect.bottom() ) == pos )
+            {
+                last = last.united( rect );
+                return;
+            }
+        }
+    }
+
+    rects += rect;
+}
+
 class QwtPlotMultiBarChart::PrivateData
 {
   public:
@@ -41,6 +262,7 @@ class QwtPlotMultiBarChart::PrivateData
     }
 
     QwtPlotMultiBarChart::ChartStyle style;
+    QwtPlotMultiBarChart::PaintAttributes paintAttributes;
     QList< QwtText > barTitles;
     QMap< int, QwtColumnSymbol* > symbolMap;
 };
@@ -84,6 +306,31 @@ int QwtPlotMultiBarChart::rtti() const
     return QwtPlotItem::Rtti_PlotMultiBarChart;
 }
 
+/*!
+   Specify an attribute how to draw the chart
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotMultiBarChart::setPaintAttribute(
+    PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa setPaintAttribute()
+ */
+bool QwtPlotMultiBarChart::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
 /*!
    Initialize data with an array of samples.
    \param samples Vector of points
@@ -390,15 +637,119 @@ void QwtPlotMultiBarChart::drawSeries( QPainter* painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( m_data->paintAttributes & BatchBars )
     {
-        drawSample( painter, xMap, yMap,
-            canvasRect, interval, i, sample( i ) );
+        drawBarsBatched( painter, xMap, yMap,
+            canvasRect, interval, from, to );
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
 }
 
+/*
+   Collect the bars of each value index and paint them
+   with QwtColumnSymbol::drawBoxes()
+ */
+void QwtPlotMultiBarChart::drawBarsBatched( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, const QwtInterval& boundingInterval,
+    int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    // the default symbol of drawBar()
+    QwtColumnSymbol defaultSymbol( QwtColumnSymbol::Box );
+    defaultSymbol.setLineWidth( 1 );
+    defaultSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+    // symbols and bars for each value index
+    QVector< const QwtColumnSymbol* > symbols;
+    QVector< QVector< QRectF > > rects;
+
+    QVector< QwtBar > bars;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtSetSample sample = this->sample( i );
+        if ( sample.set.size() <= 0 )
+            continue;
+
+        double sampleW;
+        if ( orientation() == Qt::Horizontal )
+        {
+            sampleW = sampleWidth( yMap, canvasRect.height(),
+                boundingInterval.width(), sample.value );
+        }
+        else
+        {
+            sampleW = sampleWidth( xMap, canvasRect.width(),
+                boundingInterval.width(), sample.value );
+        }
+
+        bars.clear();
+
+        if ( m_data->style == Stacked )
+        {
+            qwtStackedBars( orientation(), xMap, yMap,
+                baseline(), sampleW, sample, bars );
+        }
+        else
+        {
+            qwtGroupedBars( orientation(), xMap, yMap,
+                baseline(), sampleW, sample, bars );
+        }
+
+        for ( int j = 0; j < bars.size(); j++ )
+        {
+            const QwtBar& bar = bars[j];
+
+            const QwtColumnSymbol* specialSym =
+                specialSymbol( i, bar.valueIndex );
+
+            if ( specialSym )
+            {
+                specialSym->draw( painter, bar.rect );
+                delete specialSym;
+
+                continue;
+            }
+
+            while ( symbols.size() <= bar.valueIndex )
+            {
+                const QwtColumnSymbol* sym = symbol( symbols.size() );
+                symbols += sym ? sym : &defaultSymbol;
+
+                rects += QVector< QRectF >();
+            }
+
+            QRectF r = bar.rect.toRect();
+            if ( doAlign )
+            {
+                r.setLeft( qRound( r.left() ) );
+                r.setRight( qRound( r.right() ) );
+                r.setTop( qRound( r.top() ) );
+                r.setBottom( qRound( r.bottom() ) );
+            }
+
+            qwtAddBar( rects[ bar.valueIndex ], r, orientation() );
+        }
+    }
+
+    for ( int i = 0; i < symbols.size(); i++ )
+    {
+        const QVector< QRectF >& r = rects[i];
+        symbols[i]->drawBoxes( painter, r.constData(), r.size() );
+    }
+}
+
 /*!
    Draw a sample
 
@@ -465,64 +816,12 @@ void QwtPlotMultiBarChart::drawGroupedBars( QPainter* painter,
 {
     Q_UNUSED( canvasRect );
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
-
-    if ( orientation() == Qt::Vertical )
-    {
-        const double barWidth = sampleWidth / numBars;
-
-        const double y1 = yMap.transform( baseline() );
-        const double x0 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double x1 = x0 + i * barWidth;
-            const double x2 = x1 + barWidth;
-
-            const double y2 = yMap.transform( sample.set[i] );
-
-            QwtColumnRect barRect;
-            barRect.direction = ( y1 < y2 ) ?
-                QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-            if ( i != 0 )
-                barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            barRect.vInterval = QwtInterval( y1, y2 ).normalized();
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
-    else
-    {
-        const double barHeight = sampleWidth / numBars;
-
-        const double x1 = xMap.transform( baseline() );
-        const double y0 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            double y1 = y0 + i * barHeight;
-            double y2 = y1 + barHeight;
-
-            double x2 = xMap.transform( sample.set[i] );
+    QVector< QwtBar > bars;
+    qwtGroupedBars( orientation(), xMap, yMap,
+        baseline(), sampleWidth, sample, bars );
 
-            QwtColumnRect barRect;
-            barRect.direction = x1 < x2 ?
-                QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-
-            barRect.vInterval = QwtInterval( y1, y2 );
-            if ( i != 0 )
-                barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
+    for ( int i = 0; i < bars.size(); i++ )
+        drawBar( painter, index, bars[i].valueIndex, bars[i].rect );
 }
 
 /*!
@@ -545,97 +844,12 @@ void QwtPlotMultiBarChart::drawStackedBars( QPainter* painter,
 {
     Q_UNUSED( canvasRect ); // clipping the bars ?
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
-
-    QwtInterval::BorderFlag borderFlags = QwtInterval::IncludeBorders;
-
-    if ( orientation() == Qt::Vertical )
-    {
-        const double x1 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double x2 = x1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( yMap, sample.set );
-
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-        bar.hInterval = QwtInterval( x1, x2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double y1 = yMap.transform( sum );
-            const double y2 = yMap.transform( sum + si );
-
-            if ( ( y2 > y1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.vInterval = QwtInterval( y1, y2 ).normalized();
-            bar.vInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
+    QVector< QwtBar > bars;
+    qwtStackedBars( orientation(), xMap, yMap,
+        baseline(), sampleWidth, sample, bars );
 
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
-    else
-    {
-        const double y1 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double y2 = y1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( xMap, sample.set );
-
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-        bar.vInterval = QwtInterval( y1, y2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < sample.set.size(); i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double x1 = xMap.transform( sum );
-            const double x2 = xMap.transform( sum + si );
-
-            if ( ( x2 > x1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.hInterval = QwtInterval( x1, x2 ).normalized();
-            bar.hInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
-
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
+    for ( int i = 0; i < bars.size(); i++ )
+        drawBar( painter, index, bars[i].valueIndex, bars[i].rect );
 }
 
 /*!
@@ -62,6 +62,32 @@ class QWT_EXPORT QwtPlotMultiBarChart
         Stacked
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        The default setting disables all attributes
+
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+           Bars with the same value index are collected and painted
+           by calls of QPainter::drawRects(). Bars, that are narrower
+           than a pixel and located in the same pixel column, are merged
+           into one rectangle. The symbols are looked up only once
+           for each value index.
+
+           As the bars are not painted one by one drawSample(), drawBar()
+           and QwtColumnSymbol::draw() are not called for them.
+           Bars with a specialSymbol() are painted as before.
+
+           \sa QwtColumnSymbol::drawBoxes()
+         */
+        BatchBars = 0x01
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
     explicit QwtPlotMultiBarChart( const QString& title = QString() );
     explicit QwtPlotMultiBarChart( const QwtText& title );
 
@@ -69,6 +95,9 @@ class QWT_EXPORT QwtPlotMultiBarChart
 
     virtual int rtti() const QWT_OVERRIDE;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setBarTitles( const QList< QwtText >& );
     QList< QwtText > barTitles() const;
 
@@ -122,8 +151,15 @@ class QWT_EXPORT QwtPlotMultiBarChart
   private:
     void init();
 
+    void drawBarsBatched( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, const QwtInterval& boundingInterval,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotMultiBarChart::PaintAttributes )
+
 #endif
@@ -0,0 +1,631 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_multi_curve.h"
+#include "qwt_scale_map.h"
+#include "qwt_painter.h"
+#include "qwt_clipper.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_graphic.h"
+#include "qwt_legend_data.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qpen.h>
+
+#include <algorithm>
+
+class QwtPlotMultiCurve::PrivateData
+{
+  public:
+    PrivateData()
+        : channelLayout( QwtPlotMultiCurve::Overlaid )
+        , channelOffset( 1.0 )
+        , paintAttributes( QwtPlotMultiCurve::ClipPolygons |
+            QwtPlotMultiCurve::FilterPoints )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+        , isDirty( true )
+    {
+    }
+
+    inline double offset( int channel ) const
+    {
+        return ( channelLayout == QwtPlotMultiCurve::Stacked )
+            ? channel * channelOffset : 0.0;
+    }
+
+    QVector< double > xData;
+    QVector< QVector< double > > yData;
+
+    QVector< QPen > pens;
+    QList< QwtText > channelTitles;
+
+    QwtPlotMultiCurve::ChannelLayout channelLayout;
+    double channelOffset;
+
+    QwtPlotMultiCurve::PaintAttributes paintAttributes;
+
+    // cached bounding rectangle of all channels
+    mutable QRectF boundingRect;
+    mutable bool isDirty;
+};
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotMultiCurve::QwtPlotMultiCurve( const QString& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotMultiCurve::QwtPlotMultiCurve( const QwtText& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotMultiCurve::~QwtPlotMultiCurve()
+{
+    delete m_data;
+}
+
+void QwtPlotMultiCurve::init()
+{
+    m_data = new PrivateData;
+
+    setItemAttribute( QwtPlotItem::Legend, true );
+    setItemAttribute( QwtPlotItem::AutoScale, true );
+
+    setZ( 20.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotMultiCurve
+int QwtPlotMultiCurve::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotMultiCurve;
+}
+
+/*!
+   Specify an attribute how to draw the channels
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotMultiCurve::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa setPaintAttribute()
+ */
+bool QwtPlotMultiCurve::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
+/*!
+   \brief Assign the x values and the values of all channels
+
+   \param xData Increasing x values, shared by all channels
+   \param yData Values for each channel
+
+   \note Channels with less values than xData are displayed
+         up to their last value only.
+ */
+void QwtPlotMultiCurve::setSamples( const QVector< double >& xData,
+    const QVector< QVector< double > >& yData )
+{
+    m_data->xData = xData;
+    m_data->yData = yData;
+
+    channelsChanged();
+}
+
+/*!
+   \brief Assign the x values, that are shared by all channels
+   \param xData Increasing x values
+   \sa xData(), setChannelData()
+ */
+void QwtPlotMultiCurve::setXData( const QVector< double >& xData )
+{
+    m_data->xData = xData;
+    channelsChanged();
+}
+
+/*!
+   \return x values, that are shared by all channels
+   \sa setXData()
+ */
+QVector< double > QwtPlotMultiCurve::xData() const
+{
+    return m_data->xData;
+}
+
+/*!
+   \brief Set the number of channels
+
+   Additional channels have no values, channels beyond
+   count are removed.
+
+   \param count Number of channels
+   \sa channelCount(), setChannelData()
+ */
+void QwtPlotMultiCurve::setChannelCount( int count )
+{
+    count = qMax( count, 0 );
+    if ( count != m_data->yData.size() )
+    {
+        m_data->yData.resize( count );
+        channelsChanged();
+    }
+}
+
+//! \return Number of channels
+int QwtPlotMultiCurve::channelCount() const
+{
+    return m_data->yData.size();
+}
+
+/*!
+   \brief Assign the values of a channel
+
+   The number of channels is increased, when channel >= channelCount().
+
+   \param channel Index of the channel
+   \param yData Values of the channel
+   \sa channelData(), setXData()
+ */
+void QwtPlotMultiCurve::setChannelData(
+    int channel, const QVector< double >& yData )
+{
+    if ( channel < 0 )
+        return;
+
+    if ( channel >= m_data->yData.size() )
+        m_data->yData.resize( channel + 1 );
+
+    m_data->yData[channel] = yData;
+    channelsChanged();
+}
+
+/*!
+   \param channel Index of the channel
+   \return Values of the channel
+   \sa setChannelData()
+ */
+QVector< double > QwtPlotMultiCurve::channelData( int channel ) const
+{
+    return m_data->yData.value( channel );
+}
+
+/*!
+   \brief Set the titles for the channels on the legend
+
+   \param titles Channel titles
+   \sa channelTitles(), legendData()
+ */
+void QwtPlotMultiCurve::setChannelTitles( const QList< QwtText >& titles )
+{
+    m_data->channelTitles = titles;
+
+    legendChanged();
+    itemChanged();
+}
+
+/*!
+   \return Channel titles
+   \sa setChannelTitles(), legendData()
+ */
+QList< QwtText > QwtPlotMultiCurve::channelTitles() const
+{
+    return m_data->channelTitles;
+}
+
+/*!
+   \brief Assign the pen of a channel
+
+   \param channel Index of the channel
+   \param pen Pen
+   \sa pen()
+ */
+void QwtPlotMultiCurve::setPen( int channel, const QPen& pen )
+{
+    if ( channel < 0 )
+        return;
+
+    if ( channel >= m_data->pens.size() )
+        m_data->pens.resize( channel + 1 );
+
+    if ( pen != m_data->pens[channel] )
+    {
+        m_data->pens[channel] = pen;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \param channel Index of the channel
+   \return Pen of the channel
+   \sa setPen()
+ */
+QPen QwtPlotMultiCurve::pen( int channel ) const
+{
+    return m_data->pens.value( channel );
+}
+
+/*!
+   \brief Set the layout of the channels
+
+   \param layout Channel layout
+   \sa channelLayout(), setChannelOffset()
+ */
+void QwtPlotMultiCurve::setChannelLayout( ChannelLayout layout )
+{
+    if ( layout != m_data->channelLayout )
+    {
+        m_data->channelLayout = layout;
+        channelsChanged();
+    }
+}
+
+/*!
+   \return Layout of the channels
+   \sa setChannelLayout()
+ */
+QwtPlotMultiCurve::ChannelLayout QwtPlotMultiCurve::channelLayout() const
+{
+    return m_data->channelLayout;
+}
+
+/*!
+   \brief Set the offset between 2 channels for the Stacked layout
+
+   \param offset Offset in y coordinates
+   \sa channelOffset(), setChannelLayout()
+ */
+void QwtPlotMultiCurve::setChannelOffset( double offset )
+{
+    if ( offset != m_data->channelOffset )
+    {
+        m_data->channelOffset = offset;
+
+        if ( m_data->channelLayout == Stacked )
+            channelsChanged();
+    }
+}
+
+/*!
+   \return Offset between 2 channels for the Stacked layout
+   \sa setChannelOffset()
+ */
+double QwtPlotMultiCurve::channelOffset() const
+{
+    return m_data->channelOffset;
+}
+
+void QwtPlotMultiCurve::channelsChanged()
+{
+    m_data->isDirty = true;
+
+    legendChanged();
+    itemChanged();
+}
+
+/*!
+   \return Bounding rectangle of all channels, including
+           the offsets of the Stacked layout
+ */
+QRectF QwtPlotMultiCurve::boundingRect() const
+{
+    if ( m_data->isDirty )
+    {
+        QRectF rect( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+        const QVector< double >& xData = m_data->xData;
+
+        for ( int channel = 0; channel < m_data->yData.size(); channel++ )
+        {
+            const QVector< double >& yData = m_data->yData[channel];
+
+            const int numPoints = qMin( xData.size(), yData.size() );
+            if ( numPoints <= 0 )
+                continue;
+
+            const double offset = m_data->offset( channel );
+
+            const double x1 = xData[0];
+            const double x2 = xData[numPoints - 1];
+
+            double yMin = yData[0];
+            double yMax = yData[0];
+
+            for ( int i = 1; i < numPoints; i++ )
+            {
+                yMin = qMin( yMin, yData[i] );
+                yMax = qMax( yMax, yData[i] );
+            }
+
+            const QRectF r( x1, yMin + offset, x2 - x1, yMax - yMin );
+
+            rect = ( rect.width() < 0.0 ) ? r : ( rect | r );
+        }
+
+        m_data->boundingRect = rect;
+        m_data->isDirty = false;
+    }
+
+    return m_data->boundingRect;
+}
+
+/*!
+   \brief Draw all channels
+
+   The range of the visible x values is found by a binary search
+   and mapped once. Then each channel is painted by drawChannel().
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+ */
+void QwtPlotMultiCurve::draw( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    const QVector< double >& xData = m_data->xData;
+    if ( xData.isEmpty() || m_data->yData.isEmpty() )
+        return;
+
+    const double* values = xData.constData();
+
+    const double x1 = qMin( xMap.s1(), xMap.s2() );
+    const double x2 = qMax( xMap.s1(), xMap.s2() );
+
+    // including the points outside, that are connected to the visible ones
+
+    int from = int( std::lower_bound( values, values + xData.size(), x1 ) - values );
+    int to = int( std::upper_bound( values, values + xData.size(), x2 ) - values );
+
+    from = qMax( from - 1, 0 );
+    to = qMin( to, xData.size() - 1 );
+
+    if ( from >= to )
+        return;
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    QVector< double > xValues( to - from + 1 );
+    for ( int i = from; i <= to; i++ )
+    {
+        double x = xMap.transform( values[i] );
+        if ( doAlign )
+            x = qRound( x );
+
+        xValues[i - from] = x;
+    }
+
+    for ( int channel = 0; channel < m_data->yData.size(); channel++ )
+    {
+        const QPen channelPen = pen( channel );
+        if ( channelPen.style() == Qt::NoPen )
+            continue;
+
+        const int numPoints = qMin( xData.size(), m_data->yData[channel].size() );
+        if ( numPoints <= from + 1 )
+            continue;
+
+        QRectF clipRect;
+        if ( m_data->paintAttributes & ClipPolygons )
+        {
+            const qreal pw = QwtPainter::effectivePenWidth( channelPen );
+            clipRect = canvasRect.adjusted( -pw, -pw, pw, pw );
+        }
+
+        painter->setPen( channelPen );
+
+        drawChannel( painter, channel, yMap, clipRect,
+            xValues.constData(), from, qMin( to, numPoints - 1 ) );
+    }
+}
+
+/*!
+   \brief Draw a channel
+
+   \param painter Painter
+   \param channel Index of the channel
+   \param yMap Maps y-values into pixel coordinates.
+   \param clipRect Rectangle for clipping the polyline, or an invalid
+                   rectangle, when clipping is disabled
+   \param xValues Mapped x values, where xValues[0] belongs to from
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+ */
+void QwtPlotMultiCurve::drawChannel( QPainter* painter, int channel,
+    const QwtScaleMap& yMap, const QRectF& clipRect,
+    const double* xValues, int from, int to ) const
+{
+    const double* yData = m_data->yData[channel].constData();
+    const double offset = m_data->offset( channel );
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool doFilter = doAlign && ( m_data->paintAttributes & FilterPoints );
+
+    QPolygonF polyline;
+    QwtScratchPool::acquire( polyline, to - from + 1 );
+
+    QPointF* points = polyline.data();
+    int numPoints = 0;
+
+    int i = from;
+    while ( i <= to )
+    {
+        const double x = xValues[i - from];
+
+        double y = yMap.transform( yData[i] + offset );
+        if ( doAlign )
+            y = qRound( y );
+
+        points[numPoints++] = QPointF( x, y );
+
+        if ( !doFilter )
+        {
+            i++;
+            continue;
+        }
+
+        // the points of the same pixel column: first, min, max, last
+
+        double yMin = y;
+        double yMax = y;
+        double yLast = y;
+
+        int iMin = i;
+        int iMax = i;
+
+        int j = i + 1;
+        for ( ; j <= to && xValues[j - from] == x; j++ )
+        {
+            yLast = qRound( yMap.transform( yData[j] + offset ) );
+
+            if ( yLast < yMin )
+            {
+                yMin = yLast;
+                iMin = j;
+            }
+
+            if ( yLast > yMax )
+            {
+                yMax = yLast;
+                iMax = j;
+            }
+        }
+
+        const int iLast = j - 1;
+
+        if ( iMin < iMax )
+        {
+            if ( iMin != i )
+                points[numPoints++] = QPointF( x, yMin );
+
+            if ( iMax != iLast )
+                points[numPoints++] = QPointF( x, yMax );
+        }
+        else if ( iMax < iMin )
+        {
+            if ( iMax != i )
+                points[numPoints++] = QPointF( x, yMax );
+
+            if ( iMin != iLast )
+                points[numPoints++] = QPointF( x, yMin );
+        }
+
+        if ( iLast != i )
+            points[numPoints++] = QPointF( x, yLast );
+
+        i = j;
+    }
+
+    polyline.resize( numPoints );
+
+    if ( clipRect.isValid() )
+    {
+        const QVector< QPolygonF > parts =
+            QwtClipper::clippedPolyline( clipRect, polyline );
+
+        for ( int k = 0; k < parts.size(); k++ )
+            QwtPainter::drawPolyline( painter, parts[k] );
+    }
+    else
+    {
+        QwtPainter::drawPolyline( painter, polyline );
+    }
+
+    QwtScratchPool::release( polyline );
+}
+
+/*!
+   \return One entry for each channel
+   \sa channelTitles(), legendIcon(), legendIconSize()
+ */
+QList< QwtLegendData > QwtPlotMultiCurve::legendData() const
+{
+    QList< QwtLegendData > list;
+
+    const int numChannels = m_data->yData.size();
+    list.reserve( numChannels );
+
+    for ( int i = 0; i < numChannels; i++ )
+    {
+        QwtLegendData data;
+
+        data.setValue( QwtLegendData::TitleRole,
+            QVariant::fromValue( m_data->channelTitles.value( i ) ) );
+
+        if ( !legendIconSize().isEmpty() )
+        {
+            data.setValue( QwtLegendData::IconRole,
+                QVariant::fromValue( legendIcon( i, legendIconSize() ) ) );
+        }
+
+        list += data;
+    }
+
+    return list;
+}
+
+/*!
+   \return Icon representing a channel on the legend
+
+   \param index Index of the channel
+   \param size Icon size
+
+   \return An icon showing a line with the pen of the channel
+   \sa legendData()
+ */
+QwtGraphic QwtPlotMultiCurve::legendIcon( int index, const QSizeF& size ) const
+{
+    if ( size.isEmpty() )
+        return QwtGraphic();
+
+    QwtGraphic graphic;
+    graphic.setDefaultSize( size );
+    graphic.setRenderHint( QwtGraphic::RenderPensUnscaled, true );
+
+    QPen pn = pen( index );
+    if ( pn.style() != Qt::NoPen )
+    {
+        pn.setCapStyle( Qt::FlatCap );
+
+        QPainter painter( &graphic );
+        painter.setRenderHint( QPainter::Antialiasing,
+            testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+        painter.setPen( pn );
+
+        const double y = 0.5 * size.height();
+        QwtPainter::drawLine( &painter, 0.0, y, size.width(), y );
+    }
+
+    return graphic;
+}
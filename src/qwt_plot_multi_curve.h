@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_MULTI_CURVE_H
+#define QWT_PLOT_MULTI_CURVE_H
+
+#include "qwt_global.h"
+#include "qwt_plot_item.h"
+
+#include <qvector.h>
+#include <qlist.h>
+
+class QPen;
+class QPolygonF;
+
+/*!
+   \brief A plot item, that displays many channels sharing the same x values
+
+   Displaying N channels of a multi-channel recording as N QwtPlotCurve
+   objects maps the same x values N times, and each curve has its own
+   overhead for being sorted into the item list, clipped and painted.
+
+   QwtPlotMultiCurve stores one array of x values and N arrays of y values.
+   The x values are mapped once for all channels, each channel is painted
+   as a polyline with its own pen.
+
+   The x values need to be increasing, so that the visible range can be
+   found by a binary search. With FilterPoints the lines are reduced to
+   first, minimum, maximum and last point of each pixel column,
+   when painting in integer coordinates.
+
+   With the Stacked layout channel i is displayed with an offset
+   of i * channelOffset(), like the traces of an oscilloscope.
+
+   Like QwtPlotMultiBarChart the item returns one entry for each channel
+   to the legend.
+
+   \par Example
+   \code
+   QwtPlotMultiCurve* curve = new QwtPlotMultiCurve();
+   curve->setChannelLayout( QwtPlotMultiCurve::Stacked );
+   curve->setChannelOffset( 2.0 );
+   curve->setSamples( time, channels );
+
+   for ( int i = 0; i < channels.size(); i++ )
+       curve->setPen( i, QPen( colors[i] ) );
+
+   curve->attach( plot );
+   \endcode
+   \endpar
+
+   \sa QwtPlotCurve
+ */
+class QWT_EXPORT QwtPlotMultiCurve : public QwtPlotItem
+{
+  public:
+    /*!
+       \brief Layout of the channels
+       \sa setChannelLayout(), setChannelOffset()
+     */
+    enum ChannelLayout
+    {
+        //! All channels are displayed with their values
+        Overlaid,
+
+        //! Channel i is displayed with an offset of i * channelOffset()
+        Stacked
+    };
+
+    /*!
+       Attributes to modify the drawing algorithm.
+       The default setting enables ClipPolygons | FilterPoints
+
+       \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        //! Clip the polylines to the canvas before painting them
+        ClipPolygons = 0x01,
+
+        /*!
+           Reduce the points of each pixel column to the first, minimum,
+           maximum and last point. Has only an effect, when painting
+           in integer coordinates.
+         */
+        FilterPoints = 0x02
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
+    explicit QwtPlotMultiCurve( const QString& title = QString() );
+    explicit QwtPlotMultiCurve( const QwtText& title );
+
+    virtual ~QwtPlotMultiCurve();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
+    void setSamples( const QVector< double >& xData,
+        const QVector< QVector< double > >& yData );
+
+    void setXData( const QVector< double >& );
+    QVector< double > xData() const;
+
+    void setChannelCount( int );
+    int channelCount() const;
+
+    void setChannelData( int channel, const QVector< double >& );
+    QVector< double > channelData( int channel ) const;
+
+    void setChannelTitles( const QList< QwtText >& );
+    QList< QwtText > channelTitles() const;
+
+    void setPen( int channel, const QPen& );
+    QPen pen( int channel ) const;
+
+    void setChannelLayout( ChannelLayout );
+    ChannelLayout channelLayout() const;
+
+    void setChannelOffset( double );
+    double channelOffset() const;
+
+    virtual void draw( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual QList< QwtLegendData > legendData() const QWT_OVERRIDE;
+
+    virtual QwtGraphic legendIcon(
+        int index, const QSizeF& ) const QWT_OVERRIDE;
+
+  protected:
+    virtual void drawChannel( QPainter*, int channel,
+        const QwtScaleMap& yMap, const QRectF& clipRect,
+        const double* xValues, int from, int to ) const;
+
+  private:
+    void init();
+    void channelsChanged();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotMultiCurve::PaintAttributes )
+
+#endif
@@ -25,11 +25,14 @@ class QwtPlotOpenGLCanvas::PrivateData
         , isPolished( false )
         , fboDirty( true )
         , fbo( NULL )
+        , paintDevice( NULL )
+        , hasPaintedFocusIndicator( false )
     {
     }
 
     ~PrivateData()
     {
+        delete paintDevice;
         delete fbo;
     }
 
@@ -38,6 +41,12 @@ class QwtPlotOpenGLCanvas::PrivateData
     bool isPolished;
     bool fboDirty;
     QOpenGLFramebufferObject* fbo;
+
+    // for painting incrementally outside of paintGL()
+    QOpenGLPaintDevice* paintDevice;
+
+    // the focus indicator is part of the widget framebuffer
+    bool hasPaintedFocusIndicator;
 };
 
 /*!
@@ -171,6 +180,87 @@ void QwtPlotOpenGLCanvas::clearBackingStore()
 {
     delete m_data->fbo;
     m_data->fbo = NULL;
+
+    m_data->fboDirty = true;
+}
+
+/*!
+   \brief Open a painter on the backing store
+
+   Depending on WidgetBackingStore the painter paints into the framebuffer
+   of the widget or into the additional framebuffer object. In both cases
+   the next paintGL() presents the backing store without rendering the
+   plot again.
+
+   \param painter Painter to be opened on the backing store
+   \return false, when the backing store is disabled or needs to
+           be rendered anyway
+
+   \sa endIncrementalPaint(), QwtPlotDirectPainter::drawSeries()
+ */
+bool QwtPlotOpenGLCanvas::beginIncrementalPaint( QPainter* painter )
+{
+    if ( !testPaintAttribute( QwtPlotOpenGLCanvas::BackingStore )
+        || m_data->fboDirty || !isValid() || m_data->paintDevice )
+    {
+        return false;
+    }
+
+    const bool useWidgetFBO =
+        testPaintAttribute( QwtPlotOpenGLCanvas::WidgetBackingStore );
+
+    if ( !useWidgetFBO && m_data->fbo == NULL )
+        return false;
+
+    // binds the framebuffer of the widget
+    makeCurrent();
+
+    if ( useWidgetFBO )
+    {
+        const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+
+        m_data->paintDevice = new QOpenGLPaintDevice( size() * pixelRatio );
+        m_data->paintDevice->setDevicePixelRatio( pixelRatio );
+
+        painter->begin( m_data->paintDevice );
+    }
+    else
+    {
+        const qreal pixelRatio = QwtPainter::devicePixelRatio( NULL );
+
+        m_data->fbo->bind();
+        m_data->paintDevice = new QOpenGLPaintDevice( m_data->fbo->size() );
+
+        painter->begin( m_data->paintDevice );
+        painter->scale( pixelRatio, pixelRatio );
+    }
+
+    return true;
+}
+
+/*!
+   \brief Close a painter opened by beginIncrementalPaint()
+
+   \param painter Painter opened by beginIncrementalPaint()
+   \param rect Part of the canvas, that has been modified
+
+   \sa beginIncrementalPaint()
+ */
+void QwtPlotOpenGLCanvas::endIncrementalPaint(
+    QPainter* painter, const QRect& rect )
+{
+    painter->end();
+
+    delete m_data->paintDevice;
+    m_data->paintDevice = NULL;
+
+    if ( !testPaintAttribute( QwtPlotOpenGLCanvas::WidgetBackingStore ) )
+        m_data->fbo->release();
+
+    doneCurrent();
+
+    // QOpenGLWidget composes the complete framebuffer anyway
+    update( rect );
 }
 
 /*!
@@ -198,6 +288,41 @@ void QwtPlotOpenGLCanvas::paintGL()
     const bool hasFocusIndicator =
         hasFocus() && focusIndicator() == CanvasFocusIndicator;
 
+    const bool useWidgetFBO =
+        testPaintAttribute( QwtPlotOpenGLCanvas::BackingStore ) &&
+        testPaintAttribute( QwtPlotOpenGLCanvas::WidgetBackingStore );
+
+    /*
+        With PartialUpdate QOpenGLWidget preserves the content of its
+        framebuffer. The new behavior is effective from the next paint,
+        where the plot is rendered anyway, because clearBackingStore()
+        has been called, when changing the attribute.
+     */
+    const UpdateBehavior behavior = useWidgetFBO ? PartialUpdate : NoPartialUpdate;
+    if ( updateBehavior() != behavior )
+        setUpdateBehavior( behavior );
+
+    if ( useWidgetFBO )
+    {
+        if ( m_data->fboDirty || hasFocusIndicator != m_data->hasPaintedFocusIndicator )
+        {
+            QPainter painter( this );
+            painter.setCompositionMode( QPainter::CompositionMode_Source );
+            painter.fillRect( rect(), Qt::transparent );
+            painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+
+            draw( &painter );
+
+            if ( hasFocusIndicator )
+                drawFocusIndicator( &painter );
+
+            m_data->fboDirty = false;
+            m_data->hasPaintedFocusIndicator = hasFocusIndicator;
+        }
+
+        return;
+    }
+
     QPainter painter;
 
     if ( testPaintAttribute( QwtPlotOpenGLCanvas::BackingStore ) &&
@@ -266,10 +391,13 @@ void QwtPlotOpenGLCanvas::paintGL()
         drawFocusIndicator( &painter );
 }
 
-//! No operation - reserved for some potential use in the future
+/*!
+   Invalidate the backing store, as the framebuffer of the widget
+   has been recreated
+ */
 void QwtPlotOpenGLCanvas::resizeGL( int, int )
 {
-    // nothing to do
+    m_data->fboDirty = true;
 }
 
 #if QWT_MOC_INCLUDE
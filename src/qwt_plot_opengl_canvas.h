@@ -52,6 +52,9 @@ class QWT_EXPORT QwtPlotOpenGLCanvas : public QOpenGLWidget, public QwtPlotAbstr
     Q_INVOKABLE virtual void invalidateBackingStore() QWT_OVERRIDE;
     Q_INVOKABLE QPainterPath borderPath( const QRect& ) const;
 
+    virtual bool beginIncrementalPaint( QPainter* ) QWT_OVERRIDE;
+    virtual void endIncrementalPaint( QPainter*, const QRect& ) QWT_OVERRIDE;
+
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
   public Q_SLOTS:
@@ -0,0 +1,612 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_opengl_curve.h"
+#include "qwt_scale_map.h"
+#include "qwt_symbol.h"
+#include "qwt_painter.h"
+#include "qwt_series_data.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qvector.h>
+#include <qmath.h>
+#include <qopenglcontext.h>
+#include <qopenglfunctions.h>
+#include <qopenglbuffer.h>
+#include <qopenglshaderprogram.h>
+#include <qopengltexture.h>
+#include <qopenglpaintdevice.h>
+
+#include <limits>
+
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+
+#ifndef GL_POINT_SPRITE
+#define GL_POINT_SPRITE 0x8861
+#endif
+
+#ifndef GL_ALIASED_POINT_SIZE_RANGE
+#define GL_ALIASED_POINT_SIZE_RANGE 0x846E
+#endif
+
+/*
+    The vertices are stored relative to the first sample and
+    mapping translates them into normalized device coordinates:
+
+        ndc = vertex * mapping.xz + mapping.yw + offset
+ */
+static const char qwtVertexShader[] =
+    "attribute highp vec2 vertex;\n"
+    "uniform highp vec4 mapping;\n"
+    "uniform highp vec2 offset;\n"
+    "uniform mediump float pointSize;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4( vertex.x * mapping.x + mapping.y + offset.x,\n"
+    "        vertex.y * mapping.z + mapping.w + offset.y, 0.0, 1.0 );\n"
+    "    gl_PointSize = pointSize;\n"
+    "}\n";
+
+static const char qwtColorShader[] =
+    "#ifdef GL_ES\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "uniform vec4 color;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+static const char qwtSpriteShader[] =
+    "#ifdef GL_ES\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "uniform sampler2D sprite;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = texture2D( sprite,\n"
+    "        vec2( gl_PointCoord.x, 1.0 - gl_PointCoord.y ) );\n"
+    "}\n";
+
+static bool qwtIsLinear( const QwtScaleMap& map )
+{
+    return ( map.transformation() == NULL ) && ( map.s1() != map.s2() );
+}
+
+static bool qwtHasOpenGLPath( const QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap )
+{
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::OpenGL2 )
+        return false;
+
+    if ( QOpenGLContext::currentContext() == NULL )
+        return false;
+
+    if ( painter->deviceTransform().type() > QTransform::TxScale )
+        return false;
+
+    return qwtIsLinear( xMap ) && qwtIsLinear( yMap );
+}
+
+static bool qwtHasSolidPen( const QPen& pen )
+{
+    return pen.style() == Qt::SolidLine
+        && pen.brush().style() == Qt::SolidPattern
+        && pen.color().alpha() > 0;
+}
+
+static bool qwtHasBrush( const QBrush& brush )
+{
+    return ( brush.style() != Qt::NoBrush ) && ( brush.color().alpha() > 0 );
+}
+
+static qreal qwtDeviceScale( const QPainter* painter )
+{
+    return qAbs( painter->deviceTransform().m11() );
+}
+
+static QRect qwtScissorRect( const QPainter* painter, const QRectF& canvasRect )
+{
+    QRectF clipRect = canvasRect;
+    if ( painter->hasClipping() )
+        clipRect &= painter->clipBoundingRect();
+
+    return painter->deviceTransform().mapRect( clipRect ).toAlignedRect();
+}
+
+class QwtPlotOpenGLCurve::PrivateData
+{
+  public:
+    PrivateData()
+        : context( NULL )
+        , colorProgram( NULL )
+        , spriteProgram( NULL )
+        , buffer( NULL )
+        , sprite( NULL )
+        , series( NULL )
+        , numSamples( 0 )
+        , x0( 0.0 )
+        , y0( 0.0 )
+        , isDirty( true )
+    {
+    }
+
+    ~PrivateData()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        delete colorProgram;
+        colorProgram = NULL;
+
+        delete spriteProgram;
+        spriteProgram = NULL;
+
+        delete buffer;
+        buffer = NULL;
+
+        delete sprite;
+        sprite = NULL;
+
+        spriteImage = QImage();
+
+        context = NULL;
+        isDirty = true;
+    }
+
+    bool initResources();
+    bool updateBuffer( const QwtSeriesData< QPointF >* );
+    bool updateSprite( const QImage& );
+
+    bool render( QPainter*, QOpenGLShaderProgram*,
+        const QwtSeriesData< QPointF >*, GLenum mode,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to,
+        float pointSize, const QPointF& offset );
+
+    QOpenGLContext* context;
+
+    QOpenGLShaderProgram* colorProgram;
+    QOpenGLShaderProgram* spriteProgram;
+    QOpenGLBuffer* buffer;
+    QOpenGLTexture* sprite;
+    QImage spriteImage;
+
+    const QwtSeriesData< QPointF >* series;
+    size_t numSamples;
+    double x0;
+    double y0;
+
+    bool isDirty;
+};
+
+static QOpenGLShaderProgram* qwtCreateProgram( const char* fragmentShader )
+{
+    QOpenGLShaderProgram* program = new QOpenGLShaderProgram();
+
+    bool ok = program->addShaderFromSourceCode(
+        QOpenGLShader::Vertex, qwtVertexShader );
+
+    if ( ok )
+    {
+        ok = program->addShaderFromSourceCode(
+            QOpenGLShader::Fragment, fragmentShader );
+    }
+
+    if ( ok )
+    {
+        program->bindAttributeLocation( "vertex", 0 );
+        ok = program->link();
+    }
+
+    if ( !ok )
+    {
+        delete program;
+        program = NULL;
+    }
+
+    return program;
+}
+
+bool QwtPlotOpenGLCurve::PrivateData::initResources()
+{
+    QOpenGLContext* currentContext = QOpenGLContext::currentContext();
+
+    if ( context && !QOpenGLContext::areSharing( context, currentContext ) )
+    {
+        // the resources belong to a different context
+        reset();
+    }
+
+    if ( context == NULL )
+    {
+        context = currentContext;
+
+        colorProgram = qwtCreateProgram( qwtColorShader );
+        spriteProgram = qwtCreateProgram( qwtSpriteShader );
+
+        buffer = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+        buffer->setUsagePattern( QOpenGLBuffer::StaticDraw );
+        if ( !buffer->create() )
+        {
+            delete buffer;
+            buffer = NULL;
+        }
+    }
+
+    return colorProgram && spriteProgram && buffer;
+}
+
+bool QwtPlotOpenGLCurve::PrivateData::updateBuffer(
+    const QwtSeriesData< QPointF >* series )
+{
+    if ( !isDirty && series == this->series && series->size() == numSamples )
+        return true;
+
+    const size_t size = series->size();
+    if ( size > size_t( std::numeric_limits< int >::max() / 2 ) )
+        return false;
+
+    this->series = series;
+    numSamples = size;
+    isDirty = false;
+
+    x0 = y0 = 0.0;
+    if ( size > 0 )
+    {
+        const QPointF sample0 = series->sample( 0 );
+        x0 = sample0.x();
+        y0 = sample0.y();
+    }
+
+    // floats relative to the first sample to preserve the precision
+
+    QVector< float > vertices( int( 2 * size ) );
+    float* v = vertices.data();
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        *v++ = static_cast< float >( sample.x() - x0 );
+        *v++ = static_cast< float >( sample.y() - y0 );
+    }
+
+    buffer->bind();
+    buffer->allocate( vertices.constData(),
+        vertices.size() * int( sizeof( float ) ) );
+    buffer->release();
+
+    return true;
+}
+
+bool QwtPlotOpenGLCurve::PrivateData::updateSprite( const QImage& image )
+{
+    if ( sprite && image == spriteImage )
+        return true;
+
+    delete sprite;
+
+    sprite = new QOpenGLTexture( image );
+    sprite->setMinMagFilters( QOpenGLTexture::Nearest, QOpenGLTexture::Nearest );
+    sprite->setWrapMode( QOpenGLTexture::ClampToEdge );
+
+    spriteImage = image;
+
+    return sprite->isCreated();
+}
+
+bool QwtPlotOpenGLCurve::PrivateData::render( QPainter* painter,
+    QOpenGLShaderProgram* program, const QwtSeriesData< QPointF >* series,
+    GLenum mode, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to,
+    float pointSize, const QPointF& offset )
+{
+    if ( !updateBuffer( series ) )
+        return false;
+
+    const QPaintDevice* device = painter->device();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( device );
+
+    const int w = qRound( device->width() * pixelRatio );
+    const int h = qRound( device->height() * pixelRatio );
+
+    if ( w <= 0 || h <= 0 )
+        return false;
+
+    bool flipped = false;
+
+    const QOpenGLPaintDevice* glDevice =
+        dynamic_cast< const QOpenGLPaintDevice* >( device );
+    if ( glDevice )
+        flipped = glDevice->paintFlipped();
+
+    /*
+        scale map: p = p1 + ( x - s1 ) * cnv
+        painter:   d = m * p + t
+        viewport:  ndc = 2 * d / w - 1
+
+        with x = x0 + vertex
+     */
+    const QTransform transform = painter->deviceTransform();
+
+    const double cx = ( xMap.p2() - xMap.p1() ) / ( xMap.s2() - xMap.s1() );
+    const double cy = ( yMap.p2() - yMap.p1() ) / ( yMap.s2() - yMap.s1() );
+
+    const double px0 = xMap.p1() + ( x0 - xMap.s1() ) * cx;
+    const double py0 = yMap.p1() + ( y0 - yMap.s1() ) * cy;
+
+    double ax = 2.0 * transform.m11() * cx / w;
+    double bx = 2.0 * ( transform.m11() * px0 + transform.dx() ) / w - 1.0;
+
+    double ay = 2.0 * transform.m22() * cy / h;
+    double by = 2.0 * ( transform.m22() * py0 + transform.dy() ) / h - 1.0;
+
+    double ox = 2.0 * offset.x() / w;
+    double oy = 2.0 * offset.y() / h;
+
+    if ( !flipped )
+    {
+        ay = -ay;
+        by = -by;
+        oy = -oy;
+    }
+
+    QRect scissorRect = qwtScissorRect( painter, canvasRect );
+    if ( !flipped )
+        scissorRect.moveTop( h - scissorRect.bottom() - 1 );
+
+    QOpenGLFunctions* f = context->functions();
+
+    f->glViewport( 0, 0, w, h );
+
+    f->glEnable( GL_SCISSOR_TEST );
+    f->glScissor( scissorRect.x(), scissorRect.y(),
+        scissorRect.width(), scissorRect.height() );
+
+    f->glDisable( GL_DEPTH_TEST );
+    f->glDisable( GL_STENCIL_TEST );
+
+    f->glEnable( GL_BLEND );
+    f->glBlendFuncSeparate( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+        GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+
+    if ( mode == GL_POINTS && !context->isOpenGLES() )
+    {
+        f->glEnable( GL_PROGRAM_POINT_SIZE );
+        f->glEnable( GL_POINT_SPRITE );
+    }
+
+    program->bind();
+    program->setUniformValue( "mapping", float( ax ), float( bx ), float( ay ), float( by ) );
+    program->setUniformValue( "offset", float( ox ), float( oy ) );
+    program->setUniformValue( "pointSize", pointSize );
+
+    buffer->bind();
+    program->enableAttributeArray( 0 );
+    program->setAttributeBuffer( 0, GL_FLOAT, 0, 2 );
+
+    f->glDrawArrays( mode, from, to - from + 1 );
+
+    program->disableAttributeArray( 0 );
+    buffer->release();
+    program->release();
+
+    if ( mode == GL_POINTS && !context->isOpenGLES() )
+    {
+        f->glDisable( GL_POINT_SPRITE );
+        f->glDisable( GL_PROGRAM_POINT_SIZE );
+    }
+
+    return true;
+}
+
+/*!
+   Constructor
+   \param title Title of the curve
+ */
+QwtPlotOpenGLCurve::QwtPlotOpenGLCurve( const QString& title )
+    : QwtPlotCurve( title )
+{
+    m_data = new PrivateData;
+}
+
+/*!
+   Constructor
+   \param title Title of the curve
+ */
+QwtPlotOpenGLCurve::QwtPlotOpenGLCurve( const QwtText& title )
+    : QwtPlotCurve( title )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtPlotOpenGLCurve::~QwtPlotOpenGLCurve()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Draw the line part (without symbols) of a curve interval.
+
+   QwtPlotCurve::Lines with a solid pen of 1 pixel and QwtPlotCurve::Dots
+   are rendered from the vertex buffer, when the painter has an OpenGL paint
+   engine. All other situations are handled by QwtPlotCurve::drawCurve().
+
+   \param painter Painter
+   \param style curve style, see QwtPlotCurve::CurveStyle
+   \param xMap x map
+   \param yMap y map
+   \param canvasRect Contents rectangle of the canvas
+   \param from index of the first point to be painted
+   \param to index of the last point to be painted
+ */
+void QwtPlotOpenGLCurve::drawCurve( QPainter* painter, int style,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    const QPen pen = painter->pen();
+
+    bool isSupported = ( style == Lines || style == Dots )
+        && qwtHasSolidPen( pen ) && !qwtHasBrush( brush() )
+        && qwtHasOpenGLPath( painter, xMap, yMap );
+
+    if ( isSupported && style == Lines )
+    {
+        if ( testCurveAttribute( Fitted ) && curveFitter() )
+            isSupported = false;
+
+        // wide lines are not available in all OpenGL profiles
+        const qreal pw = QwtPainter::effectivePenWidth( pen );
+        if ( pw * qwtDeviceScale( painter ) > 1.0 )
+            isSupported = false;
+    }
+
+    if ( isSupported )
+        isSupported = m_data->initResources();
+
+    if ( isSupported )
+    {
+        painter->beginNativePainting();
+
+        m_data->colorProgram->bind();
+
+        const QColor c = pen.color();
+        m_data->colorProgram->setUniformValue( "color",
+            float( c.redF() ), float( c.greenF() ),
+            float( c.blueF() ), float( c.alphaF() ) );
+
+        float pointSize = 1.0f;
+        if ( style == Dots )
+        {
+            const qreal pw = QwtPainter::effectivePenWidth( pen );
+            pointSize = float( qMax( pw * qwtDeviceScale( painter ), qreal( 1.0 ) ) );
+        }
+
+        isSupported = m_data->render( painter, m_data->colorProgram, data(),
+            ( style == Lines ) ? GL_LINE_STRIP : GL_POINTS,
+            xMap, yMap, canvasRect, from, to, pointSize, QPointF() );
+
+        m_data->colorProgram->release();
+
+        painter->endNativePainting();
+    }
+
+    if ( !isSupported )
+        QwtPlotCurve::drawCurve( painter, style, xMap, yMap, canvasRect, from, to );
+}
+
+/*!
+   \brief Draw symbols
+
+   When the painter has an OpenGL paint engine the symbol is rendered
+   once into a texture, that is drawn as point sprite for each sample.
+   Otherwise QwtPlotCurve::drawSymbols() is called.
+
+   \param painter Painter
+   \param symbol Curve symbol
+   \param xMap x map
+   \param yMap y map
+   \param canvasRect Contents rectangle of the canvas
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+ */
+void QwtPlotOpenGLCurve::drawSymbols( QPainter* painter, const QwtSymbol& symbol,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    bool isSupported = qwtHasOpenGLPath( painter, xMap, yMap )
+        && m_data->initResources();
+
+    QImage image;
+    QPointF offset;
+
+    if ( isSupported )
+    {
+        const qreal scale = qwtDeviceScale( painter );
+        const QRectF br = symbol.boundingRect();
+
+        // a square image, with the center of the symbol in its center
+        const int side = qCeil( qMax( br.width(), br.height() ) * scale ) + 2;
+
+        GLfloat range[2] = { 1.0f, 1.0f };
+        m_data->context->functions()->glGetFloatv(
+            GL_ALIASED_POINT_SIZE_RANGE, range );
+
+        if ( br.isEmpty() || side > range[1] )
+        {
+            isSupported = false;
+        }
+        else
+        {
+            image = QImage( side, side, QImage::Format_ARGB32_Premultiplied );
+            image.fill( Qt::transparent );
+
+            QPainter p( &image );
+            p.setRenderHint( QPainter::Antialiasing,
+                painter->testRenderHint( QPainter::Antialiasing ) );
+            p.translate( 0.5 * side, 0.5 * side );
+            p.scale( scale, scale );
+            p.translate( -br.center() );
+
+            symbol.drawSymbol( &p, QPointF( 0.0, 0.0 ) );
+            p.end();
+
+            offset = br.center() * scale;
+        }
+    }
+
+    if ( isSupported )
+    {
+        painter->beginNativePainting();
+
+        isSupported = m_data->updateSprite( image );
+        if ( isSupported )
+        {
+            m_data->sprite->bind( 0 );
+
+            m_data->spriteProgram->bind();
+            m_data->spriteProgram->setUniformValue( "sprite", 0 );
+
+            isSupported = m_data->render( painter, m_data->spriteProgram, data(),
+                GL_POINTS, xMap, yMap, canvasRect, from, to,
+                float( image.width() ), offset );
+
+            m_data->spriteProgram->release();
+            m_data->sprite->release( 0 );
+        }
+
+        painter->endNativePainting();
+    }
+
+    if ( !isSupported )
+    {
+        QwtPlotCurve::drawSymbols( painter, symbol,
+            xMap, yMap, canvasRect, from, to );
+    }
+}
+
+/*!
+   Invalidate the vertex buffer, when the samples have been changed
+   \sa QwtSeriesStore::setData()
+ */
+void QwtPlotOpenGLCurve::dataChanged()
+{
+    m_data->isDirty = true;
+    QwtPlotCurve::dataChanged();
+}
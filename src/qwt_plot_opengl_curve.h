@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_OPENGL_CURVE_H
+#define QWT_PLOT_OPENGL_CURVE_H
+
+#include "qwt_global.h"
+#include "qwt_plot_curve.h"
+
+/*!
+   \brief A curve, that is rendered by OpenGL on OpenGL canvases
+
+   When being painted to a QPainter with an OpenGL paint engine
+   ( f.e. QwtPlotOpenGLCanvas or QwtPlotGLCanvas ) QwtPlotOpenGLCurve
+   bypasses the tessellation of QPainter:
+
+   - The samples are uploaded once to a vertex buffer object, that
+     is kept until the samples have been modified. Panning or zooming
+     only changes the parameters of the vertex shader, that does the
+     mapping of the scales.
+
+   - QwtPlotCurve::Lines are drawn as line strip, QwtPlotCurve::Dots as
+     points with the size of the pen width.
+
+   - Symbols are rendered once into a texture, that is drawn for each
+     sample as point sprite.
+
+   For all situations, that can't be handled by the OpenGL path - f.e.
+   when painting to a different paint device, for scales with a
+   non linear transformation, wide or non solid pens, brushes or curve
+   fitting - the implementation of QwtPlotCurve is used.
+
+   \note Modifications of the samples, that are not announced by
+         QwtSeriesStore::setData() or dataChanged(), are not detected.
+
+   \sa QwtPlotOpenGLCanvas, QwtPlotGLCanvas
+ */
+class QWT_EXPORT QwtPlotOpenGLCurve : public QwtPlotCurve
+{
+  public:
+    explicit QwtPlotOpenGLCurve( const QString& title = QString() );
+    explicit QwtPlotOpenGLCurve( const QwtText& title );
+
+    virtual ~QwtPlotOpenGLCurve();
+
+  protected:
+    virtual void drawCurve( QPainter*, int style,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
+
+    virtual void drawSymbols( QPainter*, const QwtSymbol&,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
+
+    virtual void dataChanged() QWT_OVERRIDE;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,788 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_opengl_spectrogram.h"
+#include "qwt_matrix_raster_data.h"
+#include "qwt_color_map.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+#include "qwt_painter.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qvector.h>
+#include <qmath.h>
+#include <qnumeric.h>
+#include <qopenglcontext.h>
+#include <qopenglfunctions.h>
+#include <qopenglbuffer.h>
+#include <qopenglshaderprogram.h>
+#include <qopengltexture.h>
+#include <qopenglpaintdevice.h>
+
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+
+#ifndef GL_R32F
+#define GL_R32F 0x822E
+#endif
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+static const int qwtAutoColorTableSize = 4096;
+
+// values, that are not finite, are stored as gaps
+static const float qwtGapValue = 3.0e38f;
+
+static const char qwtVertexShader[] =
+    "attribute highp vec4 vertex;\n"
+    "varying highp vec2 coord;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4( vertex.xy, 0.0, 1.0 );\n"
+    "    coord = vertex.zw;\n"
+    "}\n";
+
+/*
+    mapping: factor and offset to find the index in the color table,
+             number of colors and the alpha value ( < 0: unused )
+ */
+static const char qwtFragmentShader[] =
+    "#ifdef GL_ES\n"
+    "precision highp float;\n"
+    "#endif\n"
+    "varying vec2 coord;\n"
+    "uniform sampler2D values;\n"
+    "uniform sampler2D colors;\n"
+    "uniform vec4 mapping;\n"
+    "uniform float rowOffset;\n"
+    "void main()\n"
+    "{\n"
+    "    float v = texture2D( values,\n"
+    "        vec2( coord.x, fract( coord.y + rowOffset ) ) ).r;\n"
+    "    if ( v > 1.0e38 )\n"
+    "        discard;\n"
+    "    float index = clamp( floor( v * mapping.x + mapping.y ),\n"
+    "        0.0, mapping.z - 1.0 );\n"
+    "    vec4 c = texture2D( colors, vec2( ( index + 0.5 ) / mapping.z, 0.5 ) );\n"
+    "    if ( mapping.w >= 0.0 && c.a > 0.0 )\n"
+    "        c.a = mapping.w;\n"
+    "    gl_FragColor = c;\n"
+    "}\n";
+
+static bool qwtIsLinear( const QwtScaleMap& map )
+{
+    return ( map.transformation() == NULL ) && ( map.s1() != map.s2() );
+}
+
+static bool qwtHasOpenGLPath( const QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap )
+{
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::OpenGL2 )
+        return false;
+
+    if ( QOpenGLContext::currentContext() == NULL )
+        return false;
+
+    if ( painter->deviceTransform().type() > QTransform::TxScale )
+        return false;
+
+    return qwtIsLinear( xMap ) && qwtIsLinear( yMap );
+}
+
+static bool qwtHasFloatTextures( const QOpenGLContext* context, bool linear )
+{
+    if ( context->isOpenGLES() )
+    {
+        if ( context->format().majorVersion() < 3 )
+            return false;
+
+        // float textures are not filterable without extension
+        return !linear || context->hasExtension( "GL_OES_texture_float_linear" );
+    }
+
+    if ( context->format().majorVersion() >= 3 )
+        return true;
+
+    return context->hasExtension( "GL_ARB_texture_float" )
+        && context->hasExtension( "GL_ARB_texture_rg" );
+}
+
+namespace
+{
+    /*
+        The raster of the texture: the cells of a matrix or
+        the pixel hint of the raster data
+     */
+    class QwtTextureGrid
+    {
+      public:
+        QwtTextureGrid()
+            : matrixData( NULL )
+            , numColumns( 0 )
+            , numRows( 0 )
+            , linear( false )
+        {
+        }
+
+        bool init( const QwtRasterData* data )
+        {
+            const QwtInterval xInterval = data->interval( Qt::XAxis );
+            const QwtInterval yInterval = data->interval( Qt::YAxis );
+
+            if ( !( xInterval.isValid() && yInterval.isValid() ) )
+                return false;
+
+            rect = QRectF( xInterval.minValue(), yInterval.minValue(),
+                xInterval.width(), yInterval.width() );
+
+            if ( rect.isEmpty() )
+                return false;
+
+            matrixData = dynamic_cast< const QwtMatrixRasterData* >( data );
+            if ( matrixData )
+            {
+                switch( matrixData->resampleMode() )
+                {
+                    case QwtMatrixRasterData::NearestNeighbour:
+                        linear = false;
+                        break;
+
+                    case QwtMatrixRasterData::BilinearInterpolation:
+                        linear = true;
+                        break;
+
+                    default:
+                        return false;
+                }
+
+                numColumns = matrixData->numColumns();
+                numRows = matrixData->numRows();
+            }
+            else
+            {
+                const QRectF hint = data->pixelHint( rect );
+                if ( !( hint.width() > 0.0 && hint.height() > 0.0 ) )
+                    return false;
+
+                const double columns = rect.width() / hint.width();
+                const double rows = rect.height() / hint.height();
+
+                if ( columns > 1e6 || rows > 1e6 )
+                    return false;
+
+                numColumns = qMax( qRound( columns ), 1 );
+                numRows = qMax( qRound( rows ), 1 );
+
+                linear = false;
+            }
+
+            return numColumns > 0 && numRows > 0;
+        }
+
+        void sampleRow( const QwtRasterData* data, int row,
+            double valueOffset, QVector< double >& buffer, float* values ) const
+        {
+            const bool hasGaps = !data->testAttribute( QwtRasterData::WithoutGaps );
+
+            const double* v;
+
+            if ( matrixData )
+            {
+                v = matrix.constData() + qint64( row ) * numColumns;
+            }
+            else
+            {
+                const double dx = rect.width() / numColumns;
+                const double dy = rect.height() / numRows;
+
+                buffer.resize( 2 * numColumns );
+
+                double* x = buffer.data();
+                for ( int col = 0; col < numColumns; col++ )
+                    x[col] = rect.left() + ( col + 0.5 ) * dx;
+
+                double* out = x + numColumns;
+                data->values( rect.top() + ( row + 0.5 ) * dy, x, numColumns, out );
+
+                v = out;
+            }
+
+            for ( int col = 0; col < numColumns; col++ )
+            {
+                if ( hasGaps && !qIsFinite( v[col] ) )
+                    values[col] = qwtGapValue;
+                else
+                    values[col] = static_cast< float >( v[col] - valueOffset );
+            }
+        }
+
+        const QwtMatrixRasterData* matrixData;
+
+        // a shallow copy, so that modifications detach
+        QVector< double > matrix;
+
+        QRectF rect;
+        int numColumns;
+        int numRows;
+        bool linear;
+    };
+}
+
+class QwtPlotOpenGLSpectrogram::PrivateData
+{
+  public:
+    PrivateData()
+        : context( NULL )
+        , program( NULL )
+        , vertexBuffer( NULL )
+        , colorTexture( NULL )
+        , valueTexture( 0 )
+        , data( NULL )
+        , valueOffset( 0.0 )
+        , rowOffset( 0 )
+        , pendingRows( 0 )
+        , colorMap( NULL )
+        , numColors( 0 )
+        , isDirty( true )
+        , isColorTableDirty( true )
+    {
+    }
+
+    ~PrivateData()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        if ( valueTexture != 0 && context == QOpenGLContext::currentContext() )
+            context->functions()->glDeleteTextures( 1, &valueTexture );
+
+        valueTexture = 0;
+
+        delete program;
+        program = NULL;
+
+        delete vertexBuffer;
+        vertexBuffer = NULL;
+
+        delete colorTexture;
+        colorTexture = NULL;
+
+        context = NULL;
+        isDirty = true;
+        isColorTableDirty = true;
+    }
+
+    bool initResources();
+
+    bool updateValueTexture( const QwtRasterData*, const QwtTextureGrid& );
+    bool updateColorTexture( const QwtColorMap*, int numColors );
+
+    void uploadRows( const QwtRasterData*, int from, int count );
+
+    QOpenGLContext* context;
+    QOpenGLShaderProgram* program;
+    QOpenGLBuffer* vertexBuffer;
+    QOpenGLTexture* colorTexture;
+    GLuint valueTexture;
+
+    // the content of the value texture
+    const QwtRasterData* data;
+    QwtTextureGrid grid;
+    double valueOffset;
+    int rowOffset;
+
+    int pendingRows;
+
+    // the content of the color texture
+    const QwtColorMap* colorMap;
+    int numColors;
+
+    bool isDirty;
+    bool isColorTableDirty;
+};
+
+bool QwtPlotOpenGLSpectrogram::PrivateData::initResources()
+{
+    QOpenGLContext* currentContext = QOpenGLContext::currentContext();
+
+    if ( context && !QOpenGLContext::areSharing( context, currentContext ) )
+    {
+        // the resources belong to a different context
+        reset();
+    }
+
+    if ( context == NULL )
+    {
+        context = currentContext;
+
+        program = new QOpenGLShaderProgram();
+
+        bool ok = program->addShaderFromSourceCode(
+            QOpenGLShader::Vertex, qwtVertexShader );
+
+        if ( ok )
+        {
+            ok = program->addShaderFromSourceCode(
+                QOpenGLShader::Fragment, qwtFragmentShader );
+        }
+
+        if ( ok )
+        {
+            program->bindAttributeLocation( "vertex", 0 );
+            ok = program->link();
+        }
+
+        if ( !ok )
+        {
+            delete program;
+            program = NULL;
+        }
+
+        vertexBuffer = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+        vertexBuffer->setUsagePattern( QOpenGLBuffer::StreamDraw );
+        if ( !vertexBuffer->create() )
+        {
+            delete vertexBuffer;
+            vertexBuffer = NULL;
+        }
+    }
+
+    return program && vertexBuffer;
+}
+
+void QwtPlotOpenGLSpectrogram::PrivateData::uploadRows(
+    const QwtRasterData* data, int from, int count )
+{
+    QOpenGLFunctions* f = context->functions();
+
+    QVector< double > buffer;
+    QVector< float > values( grid.numColumns );
+
+    for ( int row = from; row < from + count; row++ )
+    {
+        grid.sampleRow( data, row, valueOffset, buffer, values.data() );
+
+        const int textureRow = ( row + rowOffset ) % grid.numRows;
+
+        f->glTexSubImage2D( GL_TEXTURE_2D, 0, 0, textureRow,
+            grid.numColumns, 1, GL_RED, GL_FLOAT, values.constData() );
+    }
+}
+
+bool QwtPlotOpenGLSpectrogram::PrivateData::updateValueTexture(
+    const QwtRasterData* data, const QwtTextureGrid& newGrid )
+{
+    bool fullUpdate = isDirty || valueTexture == 0 || data != this->data
+        || newGrid.numColumns != grid.numColumns
+        || newGrid.numRows != grid.numRows
+        || newGrid.linear != grid.linear
+        || qAbs( pendingRows ) >= grid.numRows;
+
+    QVector< double > matrix;
+    if ( newGrid.matrixData )
+    {
+        matrix = newGrid.matrixData->valueMatrix();
+
+        if ( pendingRows == 0 && matrix.constData() != grid.matrix.constData() )
+            fullUpdate = true;
+    }
+
+    if ( !fullUpdate && pendingRows == 0 )
+    {
+        grid.rect = newGrid.rect;
+        return true;
+    }
+
+    QOpenGLFunctions* f = context->functions();
+
+    GLint maxSize = 0;
+    f->glGetIntegerv( GL_MAX_TEXTURE_SIZE, &maxSize );
+
+    if ( newGrid.numColumns > maxSize || newGrid.numRows > maxSize )
+        return false;
+
+    this->data = data;
+    grid = newGrid;
+    grid.matrix = matrix;
+
+    if ( fullUpdate )
+    {
+        // keeping the float values close to 0.0
+        valueOffset = data->interval( Qt::ZAxis ).minValue();
+        if ( !qIsFinite( valueOffset ) )
+            valueOffset = 0.0;
+
+        rowOffset = 0;
+
+        if ( valueTexture == 0 )
+            f->glGenTextures( 1, &valueTexture );
+
+        f->glBindTexture( GL_TEXTURE_2D, valueTexture );
+
+        const GLint filter = grid.linear ? GL_LINEAR : GL_NEAREST;
+        f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter );
+        f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter );
+        f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        f->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+
+        f->glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+        f->glTexImage2D( GL_TEXTURE_2D, 0, GL_R32F, grid.numColumns, grid.numRows,
+            0, GL_RED, GL_FLOAT, NULL );
+
+        uploadRows( data, 0, grid.numRows );
+    }
+    else
+    {
+        // the texture is a ring buffer: only the new rows are uploaded
+
+        rowOffset = ( rowOffset + pendingRows ) % grid.numRows;
+        if ( rowOffset < 0 )
+            rowOffset += grid.numRows;
+
+        f->glBindTexture( GL_TEXTURE_2D, valueTexture );
+        f->glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+
+        if ( pendingRows > 0 )
+            uploadRows( data, grid.numRows - pendingRows, pendingRows );
+        else
+            uploadRows( data, 0, -pendingRows );
+    }
+
+    f->glBindTexture( GL_TEXTURE_2D, 0 );
+
+    pendingRows = 0;
+    isDirty = false;
+
+    return true;
+}
+
+bool QwtPlotOpenGLSpectrogram::PrivateData::updateColorTexture(
+    const QwtColorMap* colorMap, int numColors )
+{
+    if ( colorTexture && !isColorTableDirty
+        && colorMap == this->colorMap && numColors == this->numColors )
+    {
+        return true;
+    }
+
+    const QVector< QRgb > colorTable = colorMap->colorTable( numColors );
+
+    QImage image( colorTable.size(), 1, QImage::Format_ARGB32 );
+    for ( int i = 0; i < colorTable.size(); i++ )
+        image.setPixel( i, 0, colorTable[i] );
+
+    delete colorTexture;
+
+    colorTexture = new QOpenGLTexture( image, QOpenGLTexture::DontGenerateMipMaps );
+    colorTexture->setMinMagFilters( QOpenGLTexture::Nearest, QOpenGLTexture::Nearest );
+    colorTexture->setWrapMode( QOpenGLTexture::ClampToEdge );
+
+    this->colorMap = colorMap;
+    this->numColors = numColors;
+    isColorTableDirty = false;
+
+    return colorTexture->isCreated();
+}
+
+/*!
+   Constructor
+   \param title Title of the spectrogram
+ */
+QwtPlotOpenGLSpectrogram::QwtPlotOpenGLSpectrogram( const QString& title )
+    : QwtPlotSpectrogram( title )
+{
+    m_data = new PrivateData();
+
+    // the shader maps the values by a lookup texture
+    setColorTableSize( -1 );
+}
+
+//! Destructor
+QwtPlotOpenGLSpectrogram::~QwtPlotOpenGLSpectrogram()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Upload the complete raster data with the next replot
+
+   Needed, when the values of a raster data, that is not
+   a QwtMatrixRasterData, have been modified.
+
+   \sa scrollRows()
+ */
+void QwtPlotOpenGLSpectrogram::invalidateTexture()
+{
+    m_data->isDirty = true;
+    m_data->pendingRows = 0;
+
+    invalidateCache();
+}
+
+/*!
+   \brief Indicate, that the rows of the raster data have been shifted
+
+   A positive value means, that the rows have been moved towards
+   the minimum of the y interval and numRows rows have been appended
+   at the maximum. A negative value is the opposite direction.
+
+   Only the new rows will be uploaded with the next replot.
+
+   \param numRows Number of rows, that have been scrolled
+   \sa invalidateTexture()
+ */
+void QwtPlotOpenGLSpectrogram::scrollRows( int numRows )
+{
+    if ( numRows == 0 )
+        return;
+
+    if ( ( numRows > 0 && m_data->pendingRows < 0 )
+        || ( numRows < 0 && m_data->pendingRows > 0 ) )
+    {
+        // rows at both borders have changed
+        invalidateTexture();
+        return;
+    }
+
+    m_data->pendingRows += numRows;
+
+    // the image, when falling back to QwtPlotSpectrogram
+    QwtPlotSpectrogram::scrollRows( numRows );
+}
+
+/*!
+   Invalidates the textures, f.e. after setData() or setColorMap()
+   \sa QwtPlotItem::itemChanged()
+ */
+void QwtPlotOpenGLSpectrogram::itemChanged()
+{
+    m_data->isDirty = true;
+    m_data->isColorTableDirty = true;
+    m_data->pendingRows = 0;
+
+    QwtPlotSpectrogram::itemChanged();
+}
+
+/*!
+   \brief Draw the spectrogram
+
+   The image is rendered by drawTexture(), when possible. Otherwise
+   QwtPlotSpectrogram::draw() is called.
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+ */
+void QwtPlotOpenGLSpectrogram::draw( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    if ( testDisplayMode( ImageMode )
+        && drawTexture( painter, xMap, yMap, canvasRect ) )
+    {
+        if ( testDisplayMode( ContourMode ) )
+            drawContours( painter, xMap, yMap, canvasRect );
+
+        return;
+    }
+
+    QwtPlotSpectrogram::draw( painter, xMap, yMap, canvasRect );
+}
+
+/*!
+   \brief Render the image from the textures
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \return false, when rendering with OpenGL is not possible
+ */
+bool QwtPlotOpenGLSpectrogram::drawTexture( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    const QwtRasterData* data = this->data();
+    const QwtColorMap* colorMap = this->colorMap();
+
+    if ( data == NULL || !QwtColorLookupTable::isSupported( colorMap ) )
+        return false;
+
+    int numColors = colorTableSize();
+    if ( numColors < 0 )
+        numColors = qwtAutoColorTableSize;
+
+    if ( numColors < 2 )
+        return false;
+
+    if ( !qwtHasOpenGLPath( painter, xMap, yMap ) )
+        return false;
+
+    QwtTextureGrid grid;
+    if ( !grid.init( data ) )
+        return false;
+
+    const QRectF area = QwtScaleMap::invTransform(
+        xMap, yMap, canvasRect ).normalized() & grid.rect;
+
+    if ( area.isEmpty() )
+        return true;
+
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if ( !qwtHasFloatTextures( context, grid.linear ) )
+        return false;
+
+    const QPaintDevice* device = painter->device();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( device );
+
+    const int w = qRound( device->width() * pixelRatio );
+    const int h = qRound( device->height() * pixelRatio );
+
+    if ( w <= 0 || h <= 0 )
+        return false;
+
+    painter->beginNativePainting();
+
+    bool ok = m_data->initResources()
+        && m_data->updateValueTexture( data, grid )
+        && m_data->updateColorTexture( colorMap, numColors );
+
+    if ( ok )
+    {
+        bool flipped = false;
+
+        const QOpenGLPaintDevice* glDevice =
+            dynamic_cast< const QOpenGLPaintDevice* >( device );
+        if ( glDevice )
+            flipped = glDevice->paintFlipped();
+
+        const QTransform transform = painter->deviceTransform();
+
+        // the corners of the visible part of the data in NDC
+
+        const QRectF& rect = m_data->grid.rect;
+
+        const double xValues[2] = { area.left(), area.right() };
+        const double yValues[2] = { area.top(), area.bottom() };
+
+        float vertices[16];
+        float* v = vertices;
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            const double x = xValues[i % 2];
+            const double y = yValues[i / 2];
+
+            const QPointF pos = transform.map( QPointF(
+                xMap.transform( x ), yMap.transform( y ) ) );
+
+            double ny = 2.0 * pos.y() / h - 1.0;
+            if ( !flipped )
+                ny = -ny;
+
+            *v++ = static_cast< float >( 2.0 * pos.x() / w - 1.0 );
+            *v++ = static_cast< float >( ny );
+            *v++ = static_cast< float >( ( x - rect.left() ) / rect.width() );
+            *v++ = static_cast< float >( ( y - rect.top() ) / rect.height() );
+        }
+
+        // like QwtColorLookupTable
+
+        const QwtInterval interval = data->interval( Qt::ZAxis );
+
+        double rounding = 0.5;
+
+        const QwtLinearColorMap* linearMap =
+            dynamic_cast< const QwtLinearColorMap* >( colorMap );
+        if ( linearMap && linearMap->mode() == QwtLinearColorMap::FixedColors )
+            rounding = 0.0;
+
+        double factor = 0.0;
+        double offset = 0.0;
+
+        if ( interval.width() > 0.0 )
+        {
+            factor = ( numColors - 1 ) / interval.width();
+            offset = rounding + ( m_data->valueOffset - interval.minValue() ) * factor;
+        }
+
+        const float a = ( alpha() >= 0 ) ? alpha() / 255.0f : -1.0f;
+
+        QRectF clipRect = canvasRect;
+        if ( painter->hasClipping() )
+            clipRect &= painter->clipBoundingRect();
+
+        QRect scissorRect = transform.mapRect( clipRect ).toAlignedRect();
+        if ( !flipped )
+            scissorRect.moveTop( h - scissorRect.bottom() - 1 );
+
+        QOpenGLFunctions* f = context->functions();
+
+        f->glViewport( 0, 0, w, h );
+
+        f->glEnable( GL_SCISSOR_TEST );
+        f->glScissor( scissorRect.x(), scissorRect.y(),
+            scissorRect.width(), scissorRect.height() );
+
+        f->glDisable( GL_DEPTH_TEST );
+        f->glDisable( GL_STENCIL_TEST );
+
+        f->glEnable( GL_BLEND );
+        f->glBlendFuncSeparate( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+            GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+
+        f->glActiveTexture( GL_TEXTURE0 );
+        f->glBindTexture( GL_TEXTURE_2D, m_data->valueTexture );
+
+        m_data->colorTexture->bind( 1 );
+
+        QOpenGLShaderProgram* program = m_data->program;
+
+        program->bind();
+        program->setUniformValue( "values", 0 );
+        program->setUniformValue( "colors", 1 );
+        program->setUniformValue( "mapping", float( factor ),
+            float( offset ), float( numColors ), a );
+        program->setUniformValue( "rowOffset",
+            float( m_data->rowOffset ) / m_data->grid.numRows );
+
+        QOpenGLBuffer* buffer = m_data->vertexBuffer;
+
+        buffer->bind();
+        buffer->allocate( vertices, int( sizeof( vertices ) ) );
+
+        program->enableAttributeArray( 0 );
+        program->setAttributeBuffer( 0, GL_FLOAT, 0, 4 );
+
+        f->glDrawArrays( GL_TRIANGLE_STRIP, 0, 4 );
+
+        program->disableAttributeArray( 0 );
+        buffer->release();
+        program->release();
+
+        m_data->colorTexture->release( 1 );
+
+        f->glActiveTexture( GL_TEXTURE0 );
+        f->glBindTexture( GL_TEXTURE_2D, 0 );
+    }
+
+    painter->endNativePainting();
+
+    return ok;
+}
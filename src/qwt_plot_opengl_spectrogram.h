@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_OPENGL_SPECTROGRAM_H
+#define QWT_PLOT_OPENGL_SPECTROGRAM_H
+
+#include "qwt_global.h"
+#include "qwt_plot_spectrogram.h"
+
+/*!
+   \brief A spectrogram, that maps its values to colors on the GPU
+
+   When being painted to a QPainter with an OpenGL paint engine
+   ( f.e. QwtPlotOpenGLCanvas or QwtPlotGLCanvas ) the values of the
+   raster data are uploaded once as float texture. The color map is
+   uploaded as lookup texture and applied in a fragment shader, so that
+   panning and zooming only modify the texture coordinates
+   of a single quad.
+
+   The raster of the texture is:
+
+   - the matrix of a QwtMatrixRasterData with the resample modes
+     QwtMatrixRasterData::NearestNeighbour or
+     QwtMatrixRasterData::BilinearInterpolation
+   - the raster of other QwtRasterData objects, that is indicated
+     by QwtRasterData::pixelHint()
+
+   For waterfall displays, where the data scrolls by some rows,
+   scrollRows() avoids uploading the complete texture:
+   the texture is organized as ring buffer and only the rows, that
+   have been added, are fetched from the raster data.
+
+   For all other situations - f.e. painting to a different paint device,
+   non linear scales, color maps that are not supported by
+   QwtColorLookupTable or missing support for float textures -
+   the implementation of QwtPlotSpectrogram is used.
+
+   \note Modifications of the values of a QwtMatrixRasterData are
+         detected, but for other types of raster data invalidateTexture()
+         has to be called.
+ */
+class QWT_EXPORT QwtPlotOpenGLSpectrogram : public QwtPlotSpectrogram
+{
+  public:
+    explicit QwtPlotOpenGLSpectrogram( const QString& title = QString() );
+    virtual ~QwtPlotOpenGLSpectrogram();
+
+    void invalidateTexture();
+    void scrollRows( int numRows );
+
+    virtual void draw( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const QWT_OVERRIDE;
+
+    virtual void itemChanged() QWT_OVERRIDE;
+
+  protected:
+    virtual bool drawTexture( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,364 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_overlay.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_widget.h"
+#include "qwt_scale_map.h"
+#include "qwt_graphic.h"
+#include "qwt_painter_command.h"
+
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qregion.h>
+
+#include <algorithm>
+
+namespace
+{
+    class LessZThan
+    {
+      public:
+        inline bool operator()( const QwtPlotItem* item1,
+            const QwtPlotItem* item2 ) const
+        {
+            return item1->z() < item2->z();
+        }
+    };
+}
+
+static inline qreal qwtPenMargin( const QPen& pen, const QTransform& transform )
+{
+    if ( pen.style() == Qt::NoPen )
+        return 0.0;
+
+    qreal pw = pen.widthF();
+    if ( pw <= 0.0 )
+        pw = 1.0;
+
+    if ( !pen.isCosmetic() )
+    {
+        // a good enough approximation for the scaled pen width
+        pw *= qMax( qAbs( transform.m11() ) + qAbs( transform.m21() ),
+            qAbs( transform.m12() ) + qAbs( transform.m22() ) );
+    }
+
+    return 0.5 * pw;
+}
+
+static void qwtDrawItem( QPainter* painter, const QwtPlotItem* item,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QRectF& canvasRect )
+{
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+#if QT_VERSION < 0x050100
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+#endif
+
+    item->draw( painter, xMap, yMap, canvasRect );
+
+    painter->restore();
+}
+
+class QwtPlotOverlay::PrivateData
+{
+  public:
+    PrivateData()
+        : plot( NULL )
+        , autoDelete( true )
+    {
+    }
+
+    QwtPlot* plot;
+    QwtPlotItemList items;
+    bool autoDelete;
+};
+
+/*!
+   \brief Constructor
+
+   The overlay is a child of the canvas of the plot.
+
+   \param plot Plot widget
+ */
+QwtPlotOverlay::QwtPlotOverlay( QwtPlot* plot )
+    : QwtWidgetOverlay( plot->canvas() )
+{
+    m_data = new PrivateData;
+    m_data->plot = plot;
+
+    setMaskMode( QwtWidgetOverlay::MaskHint );
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        connect( plot->axisWidget( axisPos ), SIGNAL(scaleDivChanged()),
+            this, SLOT(updateOverlay()) );
+    }
+}
+
+/*!
+   \brief Destructor
+
+   If autoDelete() is on, all attached items will be deleted
+ */
+QwtPlotOverlay::~QwtPlotOverlay()
+{
+    detachItems( m_data->autoDelete );
+    delete m_data;
+}
+
+//! \return Plot widget
+QwtPlot* QwtPlotOverlay::plot()
+{
+    return m_data->plot;
+}
+
+//! \return Plot widget
+const QwtPlot* QwtPlotOverlay::plot() const
+{
+    return m_data->plot;
+}
+
+/*!
+   En/Disable Auto deletion
+
+   If Auto deletion is on all attached plot items will be deleted
+   in the destructor of the overlay. The default value is on.
+
+   \sa autoDelete(), attachItem()
+ */
+void QwtPlotOverlay::setAutoDelete( bool autoDelete )
+{
+    m_data->autoDelete = autoDelete;
+}
+
+/*!
+   \return true if auto deletion is enabled
+   \sa setAutoDelete(), attachItem()
+ */
+bool QwtPlotOverlay::autoDelete() const
+{
+    return m_data->autoDelete;
+}
+
+/*!
+   \brief Insert an item
+
+   The items are organized in increasing z order. The item must not be
+   attached to the plot and has to be detached before being deleted.
+
+   \param item Plot item
+   \sa detachItem(), updateOverlay()
+ */
+void QwtPlotOverlay::attachItem( QwtPlotItem* item )
+{
+    if ( item == NULL || m_data->items.contains( item ) )
+        return;
+
+    QwtPlotItemList& items = m_data->items;
+
+    QwtPlotItemList::iterator it =
+        std::upper_bound( items.begin(), items.end(), item, LessZThan() );
+    items.insert( it, item );
+
+    updateOverlay();
+}
+
+/*!
+   \brief Remove an item
+
+   \param item Plot item
+   \sa attachItem()
+ */
+void QwtPlotOverlay::detachItem( QwtPlotItem* item )
+{
+    if ( m_data->items.removeAll( item ) > 0 )
+        updateOverlay();
+}
+
+/*!
+   \brief Remove all items
+
+   \param autoDelete If true, delete all items
+   \sa attachItem()
+ */
+void QwtPlotOverlay::detachItems( bool autoDelete )
+{
+    const QwtPlotItemList items = m_data->items;
+    m_data->items.clear();
+
+    if ( autoDelete )
+    {
+        for ( int i = 0; i < items.size(); i++ )
+            delete items[i];
+    }
+}
+
+/*!
+   \return List of all attached items in increasing z order
+   \sa attachItem()
+ */
+const QwtPlotItemList& QwtPlotOverlay::itemList() const
+{
+    return m_data->items;
+}
+
+/*!
+   Draw the visible items with the current scales of the plot
+   \param painter Painter
+ */
+void QwtPlotOverlay::drawOverlay( QPainter* painter ) const
+{
+    const QwtPlot* plt = m_data->plot;
+    const QRectF canvasRect = plt->canvas()->contentsRect();
+
+    const QwtPlotItemList& items = m_data->items;
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem* item = items[i];
+        if ( item->isVisible() )
+        {
+            qwtDrawItem( painter, item, plt->canvasMap( item->xAxis() ),
+                plt->canvasMap( item->yAxis() ), canvasRect );
+        }
+    }
+}
+
+/*!
+   \return Union of the masks of all visible items
+   \sa itemMask()
+ */
+QRegion QwtPlotOverlay::maskHint() const
+{
+    const QwtPlot* plt = m_data->plot;
+    const QRectF canvasRect = plt->canvas()->contentsRect();
+
+    QRegion mask;
+
+    const QwtPlotItemList& items = m_data->items;
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem* item = items[i];
+        if ( item->isVisible() )
+        {
+            mask += itemMask( item, plt->canvasMap( item->xAxis() ),
+                plt->canvasMap( item->yAxis() ), canvasRect );
+        }
+    }
+
+    if ( mask.isEmpty() )
+    {
+        // an empty mask would result in no mask at all
+        mask = QRect( 0, 0, 1, 1 );
+    }
+
+    return mask;
+}
+
+/*!
+   \brief Calculate the region, that is covered by an item
+
+   The default implementation records the item into a QwtGraphic
+   and unites the bounding rectangles of the painter paths and images,
+   extended by the width of the pen.
+
+   \param item Plot item
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas
+
+   \return Region covered by the item
+ */
+QRegion QwtPlotOverlay::itemMask( const QwtPlotItem* item,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    QwtGraphic graphic;
+
+    QPainter painter( &graphic );
+    qwtDrawItem( &painter, item, xMap, yMap, canvasRect );
+    painter.end();
+
+    QRegion region;
+
+    QTransform transform;
+    QPen pen;
+
+    const QVector< QwtPainterCommand >& commands = graphic.commands();
+    for ( int i = 0; i < commands.size(); i++ )
+    {
+        const QwtPainterCommand& cmd = commands[i];
+
+        QRectF rect;
+
+        switch ( cmd.type() )
+        {
+            case QwtPainterCommand::State:
+            {
+                const QwtPainterCommand::StateData* data = cmd.stateData();
+
+                if ( data->flags & QPaintEngine::DirtyTransform )
+                    transform = data->transform;
+
+                if ( data->flags & QPaintEngine::DirtyPen )
+                    pen = data->pen;
+
+                break;
+            }
+            case QwtPainterCommand::Path:
+            {
+                // 1 extra pixel for antialiasing
+                const qreal m = qwtPenMargin( pen, transform ) + 1.0;
+
+                rect = transform.mapRect( cmd.path()->boundingRect() );
+                rect.adjust( -m, -m, m, m );
+
+                break;
+            }
+            case QwtPainterCommand::Pixmap:
+            {
+                rect = transform.mapRect( cmd.pixmapData()->rect );
+                break;
+            }
+            case QwtPainterCommand::Image:
+            {
+                rect = transform.mapRect( cmd.imageData()->rect );
+                break;
+            }
+            default:
+                break;
+        }
+
+        if ( rect.isValid() )
+            region += rect.toAlignedRect();
+    }
+
+    return region & canvasRect.toAlignedRect();
+}
+
+/*!
+   Resize event
+   \param event Resize event
+ */
+void QwtPlotOverlay::resizeEvent( QResizeEvent* event )
+{
+    QwtWidgetOverlay::resizeEvent( event );
+
+    // the maps of the plot depend on the size of the canvas
+    updateOverlay();
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_overlay.cpp"
+#endif
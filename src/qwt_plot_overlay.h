@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_OVERLAY_H
+#define QWT_PLOT_OVERLAY_H
+
+#include "qwt_global.h"
+#include "qwt_widget_overlay.h"
+#include "qwt_plot_dict.h"
+
+class QwtPlot;
+class QwtScaleMap;
+
+/*!
+   \brief An overlay on top of the plot canvas displaying plot items
+
+   Items like markers or zones, that are used for cursors, thresholds or
+   selections, often need to be moved interactively. When being attached to
+   the plot each movement requires a replot, that also repaints all curves
+   or raster items below.
+
+   QwtPlotOverlay is a widget overlay, that renders its own list of items
+   with the scales of the plot. Together with the backing store of
+   the canvas a movement costs repainting of the regions, that are covered
+   by the items before and after the movement only. The mask is calculated
+   from the outlines of the painter paths of the items, so that f.e. moving
+   a vertical line marker repaints a stripe of a few pixels only.
+
+   Items are added by attachItem() and must not be attached to the plot.
+   As the items don't notify the overlay about modifications
+   updateOverlay() has to be called explicitly.
+
+   The overlay is repainted automatically, when a scale of the plot or
+   the size of the canvas has changed.
+
+   \par Example
+   \code
+   QwtPlotOverlay* overlay = new QwtPlotOverlay( plot );
+
+   QwtPlotMarker* cursor = new QwtPlotMarker();
+   cursor->setLineStyle( QwtPlotMarker::VLine );
+   overlay->attachItem( cursor );
+
+   ...
+
+   // f.e. when dragging the cursor
+   cursor->setXValue( x );
+   overlay->updateOverlay();
+   \endcode
+   \endpar
+
+   \note The overlay is not included, when rendering the plot
+         with QwtPlotRenderer.
+   \sa QwtPlotCanvas::BackingStore
+ */
+class QWT_EXPORT QwtPlotOverlay : public QwtWidgetOverlay
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtPlotOverlay( QwtPlot* );
+    virtual ~QwtPlotOverlay();
+
+    QwtPlot* plot();
+    const QwtPlot* plot() const;
+
+    void setAutoDelete( bool );
+    bool autoDelete() const;
+
+    void attachItem( QwtPlotItem* );
+    void detachItem( QwtPlotItem* );
+    void detachItems( bool autoDelete = true );
+
+    const QwtPlotItemList& itemList() const;
+
+  protected:
+    virtual void drawOverlay( QPainter* ) const QWT_OVERRIDE;
+    virtual QRegion maskHint() const QWT_OVERRIDE;
+
+    virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
+
+    virtual QRegion itemMask( const QwtPlotItem*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,755 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_overview.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_series_store.h"
+#include "qwt_scale_map.h"
+#include "qwt_scale_div.h"
+#include "qwt_transform.h"
+#include "qwt_interval.h"
+#include "qwt_painter.h"
+
+#include <qpainter.h>
+#include <qpixmap.h>
+#include <qpointer.h>
+#include <qevent.h>
+
+namespace
+{
+    /*
+        The cached pixmap is valid as long as the geometry and
+        the data of the items are unchanged.
+     */
+    class CacheKey
+    {
+      public:
+        CacheKey()
+            : pixelRatio( 0.0 )
+            , numItems( 0 )
+            , numSamples( 0 )
+        {
+        }
+
+        bool operator==( const CacheKey& other ) const
+        {
+            return size == other.size && pixelRatio == other.pixelRatio
+                && rect == other.rect && numItems == other.numItems
+                && numSamples == other.numSamples;
+        }
+
+        bool operator!=( const CacheKey& other ) const
+        {
+            return !( *this == other );
+        }
+
+        QSize size;
+        qreal pixelRatio;
+        QRectF rect;
+        int numItems;
+        size_t numSamples;
+    };
+}
+
+class QwtPlotOverview::PrivateData
+{
+  public:
+    PrivateData()
+        : xAxisId( QwtAxis::XBottom )
+        , yAxisId( QwtAxis::YLeft )
+        , scrollOrientations( Qt::Horizontal )
+        , viewportPen( Qt::darkBlue )
+        , viewportBrush( QColor( 0, 0, 255, 40 ) )
+        , isDragging( false )
+    {
+    }
+
+    QPointer< QwtPlot > plot;
+    QwtAxisId xAxisId;
+    QwtAxisId yAxisId;
+
+    QList< const QwtPlotItem* > items;
+    QRectF overviewRect;
+
+    Qt::Orientations scrollOrientations;
+
+    QPen viewportPen;
+    QBrush viewportBrush;
+
+    QPixmap cache;
+    CacheKey cacheKey;
+
+    bool isDragging;
+    QPointF dragOffset;
+};
+
+/*!
+   \brief Constructor
+   \param parent Parent widget
+ */
+QwtPlotOverview::QwtPlotOverview( QWidget* parent )
+    : QFrame( parent )
+{
+    m_data = new PrivateData;
+
+    setFrameStyle( QFrame::Panel | QFrame::Sunken );
+    setLineWidth( 1 );
+
+    setBackgroundRole( QPalette::Base );
+    setAutoFillBackground( true );
+
+    setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Fixed );
+}
+
+//! Destructor
+QwtPlotOverview::~QwtPlotOverview()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the detail plot
+
+   The overview is updated, whenever the canvas of the plot
+   has been repainted.
+
+   \param plot Plot
+   \sa plot(), setAxes()
+ */
+void QwtPlotOverview::setPlot( QwtPlot* plot )
+{
+    if ( plot == m_data->plot )
+        return;
+
+    if ( m_data->plot )
+    {
+        if ( m_data->plot->canvas() )
+            m_data->plot->canvas()->removeEventFilter( this );
+
+        disconnect( m_data->plot, SIGNAL(itemAttached(QwtPlotItem*,bool)),
+            this, SLOT(itemAttached(QwtPlotItem*,bool)) );
+    }
+
+    m_data->plot = plot;
+    m_data->items.clear();
+
+    if ( plot )
+    {
+        if ( plot->canvas() )
+            plot->canvas()->installEventFilter( this );
+
+        connect( plot, SIGNAL(itemAttached(QwtPlotItem*,bool)),
+            this, SLOT(itemAttached(QwtPlotItem*,bool)) );
+    }
+
+    invalidateCache();
+}
+
+//! \return Detail plot
+QwtPlot* QwtPlotOverview::plot()
+{
+    return m_data->plot;
+}
+
+//! \return Detail plot
+const QwtPlot* QwtPlotOverview::plot() const
+{
+    return m_data->plot;
+}
+
+/*!
+   \brief Select the axes of the detail plot
+
+   Only items attached to these axes are displayed and the
+   viewport is the visible area of the scales of these axes.
+   The default axes are QwtAxis::XBottom and QwtAxis::YLeft.
+
+   \param xAxisId X axis
+   \param yAxisId Y axis
+   \sa xAxis(), yAxis()
+ */
+void QwtPlotOverview::setAxes( QwtAxisId xAxisId, QwtAxisId yAxisId )
+{
+    if ( QwtAxis::isXAxis( xAxisId ) && QwtAxis::isYAxis( yAxisId ) )
+    {
+        m_data->xAxisId = xAxisId;
+        m_data->yAxisId = yAxisId;
+
+        invalidateCache();
+    }
+}
+
+//! \return X axis
+QwtAxisId QwtPlotOverview::xAxis() const
+{
+    return m_data->xAxisId;
+}
+
+//! \return Y axis
+QwtAxisId QwtPlotOverview::yAxis() const
+{
+    return m_data->yAxisId;
+}
+
+/*!
+   \brief Add an item of the detail plot to the overview
+
+   When no items have been added, all curves of the detail plot
+   are displayed. Items, that are detached from the plot, are
+   removed from the overview.
+
+   \param item Item attached to the detail plot
+   \sa removeItem(), overviewItems()
+ */
+void QwtPlotOverview::addItem( QwtPlotItem* item )
+{
+    if ( item && !m_data->items.contains( item ) )
+    {
+        m_data->items += item;
+        invalidateCache();
+    }
+}
+
+/*!
+   \brief Remove an item from the overview
+
+   \param item Item
+   \sa addItem()
+ */
+void QwtPlotOverview::removeItem( QwtPlotItem* item )
+{
+    if ( m_data->items.removeAll( item ) > 0 )
+        invalidateCache();
+}
+
+/*!
+   \return Visible items of the detail plot, that are displayed
+           in the overview
+   \sa addItem()
+ */
+QwtPlotItemList QwtPlotOverview::overviewItems() const
+{
+    QwtPlotItemList items;
+
+    if ( m_data->plot == NULL )
+        return items;
+
+    const QwtPlotItemList& itemList = m_data->plot->itemList();
+
+    for ( int i = 0; i < itemList.size(); i++ )
+    {
+        QwtPlotItem* item = itemList[i];
+
+        if ( !item->isVisible() || item->xAxis() != m_data->xAxisId
+            || item->yAxis() != m_data->yAxisId )
+        {
+            continue;
+        }
+
+        const bool isOverviewItem = m_data->items.isEmpty()
+            ? ( item->rtti() == QwtPlotItem::Rtti_PlotCurve )
+            : m_data->items.contains( item );
+
+        if ( isOverviewItem )
+            items += item;
+    }
+
+    return items;
+}
+
+/*!
+   \brief Set the area, that is displayed by the overview
+
+   \param rect Rectangle in scale coordinates. An invalid rectangle
+               means the bounding rectangle of all overview items,
+               what is also the default setting.
+   \sa overviewRect()
+ */
+void QwtPlotOverview::setOverviewRect( const QRectF& rect )
+{
+    if ( rect != m_data->overviewRect )
+    {
+        m_data->overviewRect = rect;
+        update();
+    }
+}
+
+/*!
+   \return Area, that is displayed by the overview
+   \sa setOverviewRect()
+ */
+QRectF QwtPlotOverview::overviewRect() const
+{
+    return m_data->overviewRect;
+}
+
+/*!
+   \brief Set the directions, where the detail plot is scrolled
+          when moving the viewport
+
+   The default setting is Qt::Horizontal.
+
+   \param orientations Scroll orientations
+   \sa scrollOrientations()
+ */
+void QwtPlotOverview::setScrollOrientations( Qt::Orientations orientations )
+{
+    m_data->scrollOrientations = orientations;
+}
+
+/*!
+   \return Directions, where the detail plot is scrolled
+   \sa setScrollOrientations()
+ */
+Qt::Orientations QwtPlotOverview::scrollOrientations() const
+{
+    return m_data->scrollOrientations;
+}
+
+/*!
+   \brief Set the pen for the outline of the viewport
+   \param pen Pen
+   \sa viewportPen(), setViewportBrush()
+ */
+void QwtPlotOverview::setViewportPen( const QPen& pen )
+{
+    if ( pen != m_data->viewportPen )
+    {
+        m_data->viewportPen = pen;
+        update();
+    }
+}
+
+/*!
+   \return Pen for the outline of the viewport
+   \sa setViewportPen()
+ */
+QPen QwtPlotOverview::viewportPen() const
+{
+    return m_data->viewportPen;
+}
+
+/*!
+   \brief Set the brush for filling the viewport
+   \param brush Brush
+   \sa viewportBrush(), setViewportPen()
+ */
+void QwtPlotOverview::setViewportBrush( const QBrush& brush )
+{
+    if ( brush != m_data->viewportBrush )
+    {
+        m_data->viewportBrush = brush;
+        update();
+    }
+}
+
+/*!
+   \return Brush for filling the viewport
+   \sa setViewportBrush()
+ */
+QBrush QwtPlotOverview::viewportBrush() const
+{
+    return m_data->viewportBrush;
+}
+
+/*!
+   \brief Map between the scale coordinates of the detail plot
+          and the contents rectangle of the overview
+
+   \param axisId Axis
+   \return Map for the x axis, when axisId is an x axis, otherwise
+           the map for the y axis
+ */
+QwtScaleMap QwtPlotOverview::overviewMap( QwtAxisId axisId ) const
+{
+    const bool isXAxis = QwtAxis::isXAxis( axisId );
+
+    QwtScaleMap map;
+
+    if ( m_data->plot )
+    {
+        const QwtScaleMap canvasMap = m_data->plot->canvasMap(
+            isXAxis ? m_data->xAxisId : m_data->yAxisId );
+
+        if ( canvasMap.transformation() )
+            map.setTransformation( canvasMap.transformation()->copy() );
+    }
+
+    const QRectF rect = itemsRect();
+    const QRect cr = contentsRect();
+
+    if ( isXAxis )
+    {
+        map.setScaleInterval( rect.left(), rect.right() );
+        map.setPaintInterval( cr.left(), cr.right() );
+    }
+    else
+    {
+        map.setScaleInterval( rect.top(), rect.bottom() );
+        map.setPaintInterval( cr.bottom(), cr.top() );
+    }
+
+    return map;
+}
+
+/*!
+   \return Visible area of the detail plot in widget coordinates
+           of the overview
+ */
+QRectF QwtPlotOverview::viewportRect() const
+{
+    if ( m_data->plot == NULL )
+        return QRectF();
+
+    const QwtInterval xInterval = m_data->plot->axisInterval( m_data->xAxisId );
+    const QwtInterval yInterval = m_data->plot->axisInterval( m_data->yAxisId );
+
+    const QwtScaleMap xMap = overviewMap( m_data->xAxisId );
+    const QwtScaleMap yMap = overviewMap( m_data->yAxisId );
+
+    const QRectF rect( QPointF( xMap.transform( xInterval.minValue() ),
+        yMap.transform( yInterval.maxValue() ) ),
+        QPointF( xMap.transform( xInterval.maxValue() ),
+        yMap.transform( yInterval.minValue() ) ) );
+
+    return rect.normalized();
+}
+
+//! \return A size hint for an overview above or below a plot
+QSize QwtPlotOverview::sizeHint() const
+{
+    const int fw = 2 * frameWidth();
+    return QSize( 200 + fw, 60 + fw );
+}
+
+/*!
+   \brief Rebuild the cached pixmap with the next paint event
+
+   The cache is rebuilt automatically, when the size of the overview or
+   the bounding rectangles or number of samples of the items have changed.
+   All other modifications of the overview items need to be
+   indicated by invalidateCache().
+ */
+void QwtPlotOverview::invalidateCache()
+{
+    m_data->cache = QPixmap();
+    m_data->cacheKey = CacheKey();
+
+    update();
+}
+
+/*!
+   Paint the cached pixmap and the viewport
+
+   \param event Paint event
+ */
+void QwtPlotOverview::paintEvent( QPaintEvent* event )
+{
+    QFrame::paintEvent( event );
+
+    updateCache();
+
+    QPainter painter( this );
+    painter.setClipRect( contentsRect() );
+
+    if ( !m_data->cache.isNull() )
+        painter.drawPixmap( contentsRect().topLeft(), m_data->cache );
+
+    const QRectF rect = viewportRect();
+    if ( rect.isValid() )
+        drawViewport( &painter, rect );
+}
+
+/*!
+   Rebuild the cached pixmap for the new size
+
+   \param event Resize event
+ */
+void QwtPlotOverview::resizeEvent( QResizeEvent* event )
+{
+    QFrame::resizeEvent( event );
+    invalidateCache();
+}
+
+/*!
+   Center the viewport at the mouse position, or start dragging
+   it, when the viewport has been hit
+
+   \param event Mouse event
+ */
+void QwtPlotOverview::mousePressEvent( QMouseEvent* event )
+{
+    if ( event->button() != Qt::LeftButton || m_data->plot == NULL )
+    {
+        QFrame::mousePressEvent( event );
+        return;
+    }
+
+    const QRectF rect = viewportRect();
+
+    if ( !rect.contains( event->pos() ) )
+        moveViewport( event->pos() );
+
+    m_data->isDragging = true;
+    m_data->dragOffset = viewportRect().center() - QPointF( event->pos() );
+}
+
+/*!
+   Scroll the detail plot, while dragging the viewport
+   \param event Mouse event
+ */
+void QwtPlotOverview::mouseMoveEvent( QMouseEvent* event )
+{
+    if ( m_data->isDragging )
+        moveViewport( QPointF( event->pos() ) + m_data->dragOffset );
+    else
+        QFrame::mouseMoveEvent( event );
+}
+
+/*!
+   Stop dragging the viewport
+   \param event Mouse event
+ */
+void QwtPlotOverview::mouseReleaseEvent( QMouseEvent* event )
+{
+    if ( m_data->isDragging && event->button() == Qt::LeftButton )
+        m_data->isDragging = false;
+    else
+        QFrame::mouseReleaseEvent( event );
+}
+
+/*!
+   Update the viewport, when the canvas of the detail
+   plot has been repainted
+
+   \param object Object to be filtered
+   \param event Event
+   \return Always false
+ */
+bool QwtPlotOverview::eventFilter( QObject* object, QEvent* event )
+{
+    if ( event->type() == QEvent::Paint && m_data->plot
+        && object == m_data->plot->canvas() )
+    {
+        // usually a blit of the cached pixmap
+        update();
+    }
+
+    return QFrame::eventFilter( object, event );
+}
+
+/*!
+   \brief Paint the overview items into the cached pixmap
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates
+   \param yMap Maps y-values into pixel coordinates
+   \param rect Contents rectangle of the overview in painter coordinates
+ */
+void QwtPlotOverview::drawItems( QPainter* painter, const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QRectF& rect ) const
+{
+    const QwtPlotItemList items = overviewItems();
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem* item = items[i];
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+        item->draw( painter, xMap, yMap, rect );
+
+        painter->restore();
+    }
+}
+
+/*!
+   \brief Paint the viewport on top of the cached pixmap
+
+   \param painter Painter
+   \param rect Visible area of the detail plot in widget coordinates
+ */
+void QwtPlotOverview::drawViewport( QPainter* painter, const QRectF& rect ) const
+{
+    painter->setPen( m_data->viewportPen );
+    painter->setBrush( m_data->viewportBrush );
+
+    QwtPainter::drawRect( painter, rect.intersected( contentsRect() ) );
+}
+
+void QwtPlotOverview::itemAttached( QwtPlotItem* item, bool on )
+{
+    if ( !on )
+        m_data->items.removeAll( item );
+
+    invalidateCache();
+}
+
+QRectF QwtPlotOverview::itemsRect() const
+{
+    QRectF rect = m_data->overviewRect;
+
+    if ( !rect.isValid() )
+    {
+        const QwtPlotItemList items = overviewItems();
+
+        rect = QRectF();
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            const QRectF r = items[i]->boundingRect();
+            if ( r.width() >= 0.0 && r.height() >= 0.0 )
+                rect = rect.isNull() ? r : ( rect | r );
+        }
+    }
+
+    // avoiding empty scale intervals
+
+    if ( rect.width() <= 0.0 )
+        rect.adjust( -0.5, 0.0, 0.5, 0.0 );
+
+    if ( rect.height() <= 0.0 )
+        rect.adjust( 0.0, -0.5, 0.0, 0.5 );
+
+    return rect;
+}
+
+void QwtPlotOverview::updateCache()
+{
+    const QRect cr = contentsRect();
+
+    CacheKey key;
+    key.size = cr.size();
+    key.pixelRatio = QwtPainter::devicePixelRatio( this );
+    key.rect = itemsRect();
+
+    const QwtPlotItemList items = overviewItems();
+    key.numItems = items.size();
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtAbstractSeriesStore* series =
+            dynamic_cast< const QwtAbstractSeriesStore* >( items[i] );
+
+        if ( series )
+            key.numSamples += series->dataSize();
+    }
+
+    if ( key == m_data->cacheKey && !m_data->cache.isNull() )
+        return;
+
+    m_data->cacheKey = key;
+
+    if ( cr.isEmpty() )
+    {
+        m_data->cache = QPixmap();
+        return;
+    }
+
+    QPixmap pixmap = QwtPainter::backingStore( this, cr.size() );
+    pixmap.fill( palette().color( backgroundRole() ) );
+
+    QPainter painter( &pixmap );
+    painter.translate( -cr.topLeft() );
+
+    drawItems( &painter, overviewMap( m_data->xAxisId ),
+        overviewMap( m_data->yAxisId ), cr );
+
+    painter.end();
+
+    m_data->cache = pixmap;
+}
+
+void QwtPlotOverview::moveViewport( const QPointF& center )
+{
+    QwtPlot* plot = m_data->plot;
+    if ( plot == NULL )
+        return;
+
+    const QRect cr = contentsRect();
+
+    QRectF r = viewportRect();
+    r.moveCenter( center );
+
+    // keeping the viewport inside of the overview, when it fits
+
+    if ( r.width() <= cr.width() )
+    {
+        if ( r.left() < cr.left() )
+            r.moveLeft( cr.left() );
+        else if ( r.right() > cr.right() )
+            r.moveRight( cr.right() );
+    }
+
+    if ( r.height() <= cr.height() )
+    {
+        if ( r.top() < cr.top() )
+            r.moveTop( cr.top() );
+        else if ( r.bottom() > cr.bottom() )
+            r.moveBottom( cr.bottom() );
+    }
+
+    const QwtScaleMap xMap = overviewMap( m_data->xAxisId );
+    const QwtScaleMap yMap = overviewMap( m_data->yAxisId );
+
+    QwtInterval xInterval = plot->axisInterval( m_data->xAxisId ).normalized();
+    QwtInterval yInterval = plot->axisInterval( m_data->yAxisId ).normalized();
+
+    const bool doAutoReplot = plot->autoReplot();
+    plot->setAutoReplot( false );
+
+    if ( m_data->scrollOrientations & Qt::Horizontal )
+    {
+        xInterval.setInterval( xMap.invTransform( r.left() ),
+            xMap.invTransform( r.right() ) );
+
+        const QwtScaleDiv& scaleDiv = plot->axisScaleDiv( m_data->xAxisId );
+        if ( scaleDiv.lowerBound() > scaleDiv.upperBound() )
+        {
+            plot->setAxisScale( m_data->xAxisId,
+                xInterval.maxValue(), xInterval.minValue() );
+        }
+        else
+        {
+            plot->setAxisScale( m_data->xAxisId,
+                xInterval.minValue(), xInterval.maxValue() );
+        }
+    }
+
+    if ( m_data->scrollOrientations & Qt::Vertical )
+    {
+        yInterval.setInterval( yMap.invTransform( r.bottom() ),
+            yMap.invTransform( r.top() ) );
+
+        const QwtScaleDiv& scaleDiv = plot->axisScaleDiv( m_data->yAxisId );
+        if ( scaleDiv.lowerBound() > scaleDiv.upperBound() )
+        {
+            plot->setAxisScale( m_data->yAxisId,
+                yInterval.maxValue(), yInterval.minValue() );
+        }
+        else
+        {
+            plot->setAxisScale( m_data->yAxisId,
+                yInterval.minValue(), yInterval.maxValue() );
+        }
+    }
+
+    plot->setAutoReplot( doAutoReplot );
+    plot->replot();
+
+    Q_EMIT viewportMoved( QRectF( xInterval.minValue(), yInterval.minValue(),
+        xInterval.width(), yInterval.width() ) );
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_overview.cpp"
+#endif
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_OVERVIEW_H
+#define QWT_PLOT_OVERVIEW_H
+
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+#include "qwt_plot_dict.h"
+
+#include <qframe.h>
+
+class QwtPlot;
+class QwtScaleMap;
+class QPen;
+class QBrush;
+
+/*!
+   \brief An overview of all samples of a plot, showing the visible
+          area of the plot as a viewport rectangle
+
+   A small overview of the complete recording above or below a zoomed plot
+   is a common pattern for navigating in long series. Implemented
+   as another QwtPlot, the overview would map all samples again for
+   each replot of the detail plot.
+
+   QwtPlotOverview paints the items of the detail plot into a cached
+   pixmap once. The curves are painted with their own data, so that
+   a QwtSeriesDataPyramid assigned to a curve of the detail plot
+   is used for the overview as well and the costs depend on the
+   width of the overview instead of the number of samples.
+   When the detail plot is scrolled or zoomed only the viewport
+   rectangle is painted on top of the cached pixmap.
+
+   The cache is rebuilt, when the size of the overview, the bounding
+   rectangles or the number of samples of the items have changed.
+   Other modifications of the items - f.e. changing the pen of a curve -
+   need to be indicated by invalidateCache().
+
+   Pressing the left mouse button centers the viewport at the position
+   of the mouse, dragging the viewport scrolls the detail plot.
+
+   \par Example
+   \code
+   QwtPlotCurve* curve = new QwtPlotCurve();
+   curve->setData( new QwtSeriesDataPyramid( series ) );
+   curve->attach( detailPlot );
+
+   QwtPlotOverview* overview = new QwtPlotOverview( parent );
+   overview->setPlot( detailPlot );
+   \endcode
+   \endpar
+
+   \sa QwtSeriesDataPyramid, QwtPlotOverlay
+ */
+class QWT_EXPORT QwtPlotOverview : public QFrame
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtPlotOverview( QWidget* parent = NULL );
+    virtual ~QwtPlotOverview();
+
+    void setPlot( QwtPlot* );
+    QwtPlot* plot();
+    const QwtPlot* plot() const;
+
+    void setAxes( QwtAxisId xAxisId, QwtAxisId yAxisId );
+    QwtAxisId xAxis() const;
+    QwtAxisId yAxis() const;
+
+    void addItem( QwtPlotItem* );
+    void removeItem( QwtPlotItem* );
+
+    QwtPlotItemList overviewItems() const;
+
+    void setOverviewRect( const QRectF& );
+    QRectF overviewRect() const;
+
+    void setScrollOrientations( Qt::Orientations );
+    Qt::Orientations scrollOrientations() const;
+
+    void setViewportPen( const QPen& );
+    QPen viewportPen() const;
+
+    void setViewportBrush( const QBrush& );
+    QBrush viewportBrush() const;
+
+    QwtScaleMap overviewMap( QwtAxisId ) const;
+    QRectF viewportRect() const;
+
+    virtual QSize sizeHint() const QWT_OVERRIDE;
+
+  public Q_SLOTS:
+    void invalidateCache();
+
+  Q_SIGNALS:
+    /*!
+       The viewport has been moved by the mouse
+
+       \param rect Visible area of the detail plot in scale coordinates
+     */
+    void viewportMoved( const QRectF& rect );
+
+  protected:
+    virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
+    virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
+
+    virtual void mousePressEvent( QMouseEvent* ) QWT_OVERRIDE;
+    virtual void mouseMoveEvent( QMouseEvent* ) QWT_OVERRIDE;
+    virtual void mouseReleaseEvent( QMouseEvent* ) QWT_OVERRIDE;
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+    virtual void drawItems( QPainter*, const QwtScaleMap& xMap,
+        const QwtScaleMap& yMap, const QRectF& rect ) const;
+
+    virtual void drawViewport( QPainter*, const QRectF& rect ) const;
+
+  private Q_SLOTS:
+    void itemAttached( QwtPlotItem*, bool on );
+
+  private:
+    QRectF itemsRect() const;
+    void updateCache();
+    void moveViewport( const QPointF& center );
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
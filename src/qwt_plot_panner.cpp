@@ -108,12 +108,20 @@ class QwtPlotPanner::PrivateData
 {
   public:
     PrivateData()
+        : hasLiveMaps( false )
     {
         for ( int axis = 0; axis < QwtAxis::AxisPositions; axis++ )
             isAxisEnabled[axis] = true;
     }
 
     bool isAxisEnabled[QwtAxis::AxisPositions];
+
+    /*
+       maps of the scales, when live panning has started. The
+       moved() offsets are always relative to them.
+     */
+    bool hasLiveMaps;
+    QwtScaleMap liveMaps[QwtAxis::AxisPositions];
 };
 
 /*!
@@ -130,8 +138,10 @@ QwtPlotPanner::QwtPlotPanner( QWidget* canvas )
 {
     m_data = new PrivateData();
 
+    connect( this, SIGNAL(moved(int,int)),
+        SLOT(moveCanvasLive(int,int)) );
     connect( this, SIGNAL(panned(int,int)),
-        SLOT(moveCanvas(int,int)) );
+        SLOT(finishPanning(int,int)) );
 }
 
 //! Destructor
@@ -258,6 +268,78 @@ void QwtPlotPanner::moveCanvas( int dx, int dy )
     plot->replot();
 }
 
+/*!
+   Handle a mouse press event for the observed widget.
+
+   Resets the scale maps of the previous live panning, before
+   passing the event to QwtPanner::widgetMousePressEvent().
+
+   \param mouseEvent Mouse event
+ */
+void QwtPlotPanner::widgetMousePressEvent( QMouseEvent* mouseEvent )
+{
+    m_data->hasLiveMaps = false;
+    QwtPanner::widgetMousePressEvent( mouseEvent );
+}
+
+void QwtPlotPanner::moveCanvasLive( int dx, int dy )
+{
+    if ( panningMode() != LivePanning )
+        return;
+
+    QwtPlot* plot = this->plot();
+    if ( plot == NULL )
+        return;
+
+    if ( !m_data->hasLiveMaps )
+    {
+        /*
+           As QwtPlot::axisScaleDiv() is not updated before the
+           next replot, we can't move the scales incrementally.
+         */
+        for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            m_data->liveMaps[axisPos] = plot->canvasMap( QwtAxisId( axisPos ) );
+
+        m_data->hasLiveMaps = true;
+    }
+
+    const bool doAutoReplot = plot->autoReplot();
+    plot->setAutoReplot( false );
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        const QwtAxisId axisId( axisPos );
+
+        if ( !m_data->isAxisEnabled[axisId] )
+            continue;
+
+        const QwtScaleMap& map = m_data->liveMaps[axisPos];
+
+        const double d = QwtAxis::isXAxis( axisPos ) ? dx : dy;
+
+        plot->setAxisScale( axisId,
+            map.invTransform( map.p1() - d ), map.invTransform( map.p2() - d ) );
+    }
+
+    plot->setAutoReplot( doAutoReplot );
+    plot->notifyInteraction();
+    plot->replot();
+}
+
+void QwtPlotPanner::finishPanning( int dx, int dy )
+{
+    if ( panningMode() == LivePanning )
+    {
+        // the final position might have been missed
+        moveCanvasLive( dx, dy );
+        m_data->hasLiveMaps = false;
+    }
+    else
+    {
+        moveCanvas( dx, dy );
+    }
+}
+
 /*!
    Calculate a mask from the border path of the canvas
 
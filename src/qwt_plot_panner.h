@@ -26,8 +26,13 @@ class QwtPlot;
    Together with QwtPlotZoomer and QwtPlotMagnifier powerful ways
    of navigating on a QwtPlot widget can be implemented easily.
 
-   \note The axes are not updated, while dragging the canvas
-   \sa QwtPlotZoomer, QwtPlotMagnifier
+   In the default PixmapPanning mode the axes are not updated, while dragging
+   the canvas. In LivePanning mode the scales are adjusted for each mouse
+   move and the plot is replotted, without grabbing the canvas. As mouse
+   moves come in faster than most plots can be rendered it is recommended
+   to limit the replots by QwtPlot::setMaxReplotRate().
+
+   \sa QwtPlotZoomer, QwtPlotMagnifier, QwtPanner::setPanningMode()
  */
 class QWT_EXPORT QwtPlotPanner : public QwtPanner
 {
@@ -53,6 +58,12 @@ class QWT_EXPORT QwtPlotPanner : public QwtPanner
     virtual QBitmap contentsMask() const QWT_OVERRIDE;
     virtual QPixmap grab() const QWT_OVERRIDE;
 
+    virtual void widgetMousePressEvent( QMouseEvent* ) QWT_OVERRIDE;
+
+  private Q_SLOTS:
+    void moveCanvasLive( int dx, int dy );
+    void finishPanning( int dx, int dy );
+
   private:
     class PrivateData;
     PrivateData* m_data;
@@ -13,14 +13,203 @@
 #include "qwt_text.h"
 #include "qwt_interval.h"
 #include "qwt_math.h"
+#include "qwt_render_statistics.h"
+#include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpaintengine.h>
 #include <qthread.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
+#include <qmutex.h>
+#include <qtimer.h>
+#include <qmap.h>
+#include <qlist.h>
+#include <qvector.h>
 
+#include <algorithm>
 #include <limits>
+#include <cstring>
+#include <typeinfo>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // size of the tiles in paint device pixels
+    const int qwtTileSize = 256;
+
+    // the preview of a tile has a lower resolution by this factor
+    const int qwtCoarseFactor = 8;
+
+    // interval, when polling for tiles being rendered in the background
+    const int qwtTilePollInterval = 40;
+
+    class QwtRasterTile
+    {
+      public:
+        QwtRasterTile()
+            : isCoarse( true )
+            , alpha( -1 )
+            , usage( 0 )
+        {
+        }
+
+        QImage image;
+        bool isCoarse;
+
+        // image with the alpha value of the item applied
+        QImage alphaImage;
+        int alpha;
+
+        uint usage;
+
+        inline qint64 memory() const
+        {
+            return qint64( image.bytesPerLine() ) * image.height()
+                + qint64( alphaImage.bytesPerLine() ) * alphaImage.height();
+        }
+    };
+
+    class QwtTileRequest
+    {
+      public:
+        int level;
+        qint64 key;
+        bool isCoarse;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF area;
+        QSize imageSize;
+    };
+
+    class QwtTileResult
+    {
+      public:
+        int level;
+        qint64 key;
+        bool isCoarse;
+        QImage image;
+    };
+
+    /*
+        The tile grid of one axis: a paint device coordinate p corresponds
+        to the grid coordinate u = p + offset, where tile i covers
+        [ i * qwtTileSize, ( i + 1 ) * qwtTileSize [. The grid is anchored
+        to a transformed scale value, so that it doesn't change when panning.
+     */
+    class QwtTileAxis
+    {
+      public:
+        QwtTileAxis()
+            : t0( 0.0 )
+            , resolution( 0.0 )
+            , offset( 0.0 )
+        {
+        }
+
+        static double transformed( const QwtScaleMap& map, double s )
+        {
+            const QwtTransform* transform = map.transformation();
+            return transform ? transform->transform( s ) : s;
+        }
+
+        static double resolutionOf( const QwtScaleMap& map )
+        {
+            // transformed scale units per paint device pixel
+            const double ts1 = transformed( map, map.s1() );
+            const double ts2 = transformed( map, map.s2() );
+
+            return ( ts2 - ts1 ) / ( map.p2() - map.p1() );
+        }
+
+        bool matches( const QwtScaleMap& map ) const
+        {
+            const double r = resolutionOf( map );
+
+            // panning introduces rounding errors
+            return qAbs( r - resolution ) <= 1e-9 * qAbs( resolution );
+        }
+
+        void reset( const QwtScaleMap& map )
+        {
+            t0 = transformed( map, map.s1() );
+            resolution = resolutionOf( map );
+            update( map );
+        }
+
+        void update( const QwtScaleMap& map )
+        {
+            const double ts1 = transformed( map, map.s1() );
+            offset = ( ts1 - t0 ) / resolution - map.p1();
+        }
+
+        double scaleValue( const QwtScaleMap& map, double u ) const
+        {
+            const double t = t0 + u * resolution;
+
+            const QwtTransform* transform = map.transformation();
+            return transform ? transform->invTransform( t ) : t;
+        }
+
+        double t0;
+        double resolution;
+        double offset;
+    };
+}
+
+static bool qwtSameTransformation( const QwtTransform* t1, const QwtTransform* t2 )
+{
+    if ( t1 == NULL || t2 == NULL )
+        return t1 == t2;
+
+    // QwtPlot::canvasMap() returns maps with copies of the transformation
+
+    return typeid( *t1 ) == typeid( *t2 )
+        && t1->transform( 2.0 ) == t2->transform( 2.0 )
+        && t1->transform( 10.0 ) == t2->transform( 10.0 );
+}
+
+namespace
+{
+    /*
+        The tiles of one resolution of the scales. A level remains
+        valid as long as the distances between the pixels - in transformed
+        scale coordinates - do not change.
+     */
+    class QwtTileLevel
+    {
+      public:
+        bool matches( const QwtScaleMap& xMap, const QwtScaleMap& yMap ) const
+        {
+            return xAxis.matches( xMap ) && yAxis.matches( yMap )
+                && qwtSameTransformation( this->xMap.transformation(), xMap.transformation() )
+                && qwtSameTransformation( this->yMap.transformation(), yMap.transformation() );
+        }
+
+        int id;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QwtTileAxis xAxis;
+        QwtTileAxis yAxis;
+
+        QMap< qint64, QwtRasterTile > tiles;
+    };
+}
+
+static inline qint64 qwtTileKey( int col, int row )
+{
+    return ( qint64( col ) << 32 ) | quint32( row );
+}
+
+static bool qwtAlphaByOpacity( const QPainter*, const QImage&, bool );
+static QImage qwtAlphaImage( const QImage&, int alpha, uint numThreads );
 
 class QwtPlotRasterItem::PrivateData
 {
@@ -28,23 +217,578 @@ class QwtPlotRasterItem::PrivateData
     PrivateData()
         : alpha( -1 )
         , paintAttributes( QwtPlotRasterItem::PaintInDeviceResolution )
+        , revision( 0 )
+        , cacheEntry( this )
     {
         cache.policy = QwtPlotRasterItem::NoCache;
+        cache.pendingRows = 0;
+
+        tileCache.limit = 64 * 1024;
+        tileCache.nextLevel = 0;
+        tileCache.usage = 0;
+        tileCache.hasCurrent = false;
+        tileCache.generation = 0;
+        tileCache.pollTimer = NULL;
+        tileCache.pollPlot = NULL;
+    }
+
+    ~PrivateData()
+    {
+        delete tileCache.pollTimer;
+    }
+
+    bool drawTiles( const QwtPlotRasterItem*, QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& paintRect, const QRectF& clipRect );
+
+    void stopRendering();
+    void clearTiles();
+    qint64 tileMemory() const;
+
+    void updateCacheUsage()
+    {
+        cacheEntry.setMemoryUsage(
+            QwtCacheEntry::imageSize( cache.image ) + tileMemory() );
     }
 
+    bool updateImage( const QwtPlotRasterItem*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap );
+
+    bool renderSubImage( const QwtPlotRasterItem*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QRect& );
+
+    static void renderTiles( PrivateData*, const QwtPlotRasterItem* );
+
     int alpha;
 
     QwtPlotRasterItem::PaintAttributes paintAttributes;
 
+    // increased with every invalidation of the data
+    uint revision;
+
     struct ImageCache
     {
         QwtPlotRasterItem::CachePolicy policy;
         QRectF area;
         QSizeF size;
         QImage image;
+
+        // rows scrolled and regions invalidated since
+        // the image has been rendered
+        int pendingRows;
+        QVector< QRectF > dirtyRects;
     } cache;
+
+    struct TileCache
+    {
+        // only accessed from the GUI thread
+
+        int limit; // in kB
+
+        // the level of the current resolution is always the first one
+        QList< QwtTileLevel > levels;
+        int nextLevel;
+
+        uint usage;
+
+        // triggers replots, while tiles are rendered
+        QTimer* pollTimer;
+        QwtPlot* pollPlot;
+
+        // shared with the rendering thread, protected by mutex
+
+        QMutex mutex;
+        QList< QwtTileRequest > requests;
+        QList< QwtTileResult > results;
+        QwtTileRequest current;
+        bool hasCurrent;
+        int generation;
+
+#if QWT_USE_THREADS
+        QFuture< void > future;
+#endif
+    } tileCache;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::RasterCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            ImageCache& cache = m_data->cache;
+
+            cache.image = QImage();
+            cache.area = QRectF();
+            cache.size = QSizeF();
+            cache.pendingRows = 0;
+            cache.dirtyRects.clear();
+
+            m_data->clearTiles();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
+
+  private:
+    void pollResults( QwtPlot* );
+    QwtTileRequest request( const QwtTileLevel&, int col, int row, bool coarse ) const;
+    void insertResult( const QwtTileResult& );
+    void expireTiles( uint usage );
 };
 
+/*
+    Executed in a background thread: renders the requested tiles
+    one by one, until no more requests are pending. The newest
+    requests are always set by the GUI thread.
+ */
+void QwtPlotRasterItem::PrivateData::renderTiles(
+    PrivateData* d, const QwtPlotRasterItem* item )
+{
+    TileCache& cache = d->tileCache;
+
+    while ( true )
+    {
+        QwtTileRequest request;
+        int generation;
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( cache.requests.isEmpty() )
+            {
+                cache.hasCurrent = false;
+                return;
+            }
+
+            request = cache.requests.takeFirst();
+            generation = cache.generation;
+
+            cache.current = request;
+            cache.hasCurrent = true;
+        }
+
+        QwtTileResult result;
+        result.level = request.level;
+        result.key = request.key;
+        result.isCoarse = request.isCoarse;
+        result.image = item->renderImage(
+            request.xMap, request.yMap, request.area, request.imageSize );
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( generation == cache.generation )
+                cache.results += result;
+
+            cache.hasCurrent = false;
+        }
+    }
+}
+
+QwtTileRequest QwtPlotRasterItem::PrivateData::request(
+    const QwtTileLevel& level, int col, int row, bool coarse ) const
+{
+    const int size = coarse ? qwtTileSize / qwtCoarseFactor : qwtTileSize;
+
+    const double x1 = level.xAxis.scaleValue( level.xMap, col * qwtTileSize );
+    const double x2 = level.xAxis.scaleValue( level.xMap, ( col + 1 ) * qwtTileSize );
+    const double y1 = level.yAxis.scaleValue( level.yMap, row * qwtTileSize );
+    const double y2 = level.yAxis.scaleValue( level.yMap, ( row + 1 ) * qwtTileSize );
+
+    QwtTileRequest request;
+    request.level = level.id;
+    request.key = qwtTileKey( col, row );
+    request.isCoarse = coarse;
+    request.imageSize = QSize( size, size );
+    request.area = QRectF( QPointF( x1, y1 ), QPointF( x2, y2 ) ).normalized();
+
+    // pixel i of the image corresponds to the grid coordinate
+    // of the left/top border of the tile + i * ( tileSize / size )
+
+    request.xMap = level.xMap;
+    request.xMap.setPaintInterval( 0.0, size );
+    request.xMap.setScaleInterval( x1, x2 );
+
+    request.yMap = level.yMap;
+    request.yMap.setPaintInterval( 0.0, size );
+    request.yMap.setScaleInterval( y1, y2 );
+
+    return request;
+}
+
+void QwtPlotRasterItem::PrivateData::pollResults( QwtPlot* plot )
+{
+    TileCache& cache = tileCache;
+
+    if ( cache.pollTimer == NULL )
+    {
+        cache.pollTimer = new QTimer();
+        cache.pollTimer->setSingleShot( true );
+    }
+
+    if ( plot != cache.pollPlot )
+    {
+        cache.pollTimer->disconnect();
+        QObject::connect( cache.pollTimer, SIGNAL(timeout()), plot, SLOT(replot()) );
+
+        cache.pollPlot = plot;
+    }
+
+    if ( !cache.pollTimer->isActive() )
+        cache.pollTimer->start( qwtTilePollInterval );
+}
+
+void QwtPlotRasterItem::PrivateData::insertResult( const QwtTileResult& result )
+{
+    QList< QwtTileLevel >& levels = tileCache.levels;
+
+    for ( int i = 0; i < levels.size(); i++ )
+    {
+        if ( levels[i].id == result.level )
+        {
+            QwtRasterTile& tile = levels[i].tiles[ result.key ];
+            if ( result.isCoarse && !tile.isCoarse )
+                return;
+
+            tile.image = result.image;
+            tile.isCoarse = result.isCoarse;
+            tile.alphaImage = QImage();
+            tile.alpha = -1;
+
+            return;
+        }
+    }
+
+    // the level has been expired in the meantime
+}
+
+/*
+    Discarding the tiles, that have not been used for the longest time,
+    until the memory of all levels fits into the limit. Tiles, that have
+    been painted with the current usage are never discarded.
+ */
+void QwtPlotRasterItem::PrivateData::expireTiles( uint usage )
+{
+    QList< QwtTileLevel >& levels = tileCache.levels;
+
+    const qint64 limit = qint64( tileCache.limit ) * 1024;
+
+    qint64 memory = tileMemory();
+    while ( memory > limit )
+    {
+        int oldestLevel = -1;
+        QMap< qint64, QwtRasterTile >::iterator oldest;
+
+        for ( int i = 0; i < levels.size(); i++ )
+        {
+            QMap< qint64, QwtRasterTile >& tiles = levels[i].tiles;
+
+            for ( QMap< qint64, QwtRasterTile >::iterator it = tiles.begin();
+                it != tiles.end(); ++it )
+            {
+                if ( oldestLevel < 0 || it->usage < oldest->usage )
+                {
+                    oldestLevel = i;
+                    oldest = it;
+                }
+            }
+        }
+
+        if ( oldestLevel < 0 || oldest->usage == usage )
+            break;
+
+        memory -= oldest->memory();
+        levels[oldestLevel].tiles.erase( oldest );
+    }
+
+    for ( int i = levels.size() - 1; i > 0; i-- )
+    {
+        if ( levels[i].tiles.isEmpty() )
+            levels.removeAt( i );
+    }
+}
+
+void QwtPlotRasterItem::PrivateData::stopRendering()
+{
+    TileCache& cache = tileCache;
+
+    {
+        QMutexLocker locker( &cache.mutex );
+
+        cache.requests.clear();
+        cache.results.clear();
+        cache.generation++;
+    }
+
+#if QWT_USE_THREADS
+    cache.future.waitForFinished();
+#endif
+}
+
+void QwtPlotRasterItem::PrivateData::clearTiles()
+{
+    stopRendering();
+    tileCache.levels.clear();
+}
+
+qint64 QwtPlotRasterItem::PrivateData::tileMemory() const
+{
+    const QList< QwtTileLevel >& levels = tileCache.levels;
+
+    qint64 memory = 0;
+    for ( int i = 0; i < levels.size(); i++ )
+    {
+        const QMap< qint64, QwtRasterTile >& tiles = levels[i].tiles;
+
+        for ( QMap< qint64, QwtRasterTile >::const_iterator it = tiles.begin();
+            it != tiles.end(); ++it )
+        {
+            memory += it->memory();
+        }
+    }
+
+    return memory;
+}
+
+/*
+    Paint the tiles covering paintRect. Missing tiles are requested
+    from the rendering thread.
+ */
+bool QwtPlotRasterItem::PrivateData::drawTiles(
+    const QwtPlotRasterItem* item, QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& paintRect, const QRectF& clipRect )
+{
+    if ( xMap.p1() == xMap.p2() || yMap.p1() == yMap.p2() )
+        return false;
+
+    TileCache& cache = tileCache;
+
+    int levelIndex = -1;
+    for ( int i = 0; i < cache.levels.size(); i++ )
+    {
+        if ( cache.levels[i].matches( xMap, yMap ) )
+        {
+            levelIndex = i;
+            break;
+        }
+    }
+
+    if ( levelIndex < 0 )
+    {
+        // a resolution, that has not been cached before
+
+        QwtTileLevel level;
+        level.id = cache.nextLevel++;
+        level.xMap = xMap;
+        level.yMap = yMap;
+        level.xAxis.reset( xMap );
+        level.yAxis.reset( yMap );
+
+        cache.levels.prepend( level );
+    }
+    else if ( levelIndex > 0 )
+    {
+        // f.e. going back in the zoom stack
+        cache.levels.move( levelIndex, 0 );
+    }
+
+    {
+        QMutexLocker locker( &cache.mutex );
+
+        for ( int i = 0; i < cache.results.size(); i++ )
+            insertResult( cache.results[i] );
+
+        cache.results.clear();
+    }
+
+    QwtTileLevel& level = cache.levels.first();
+
+    level.xAxis.update( xMap );
+    level.yAxis.update( yMap );
+
+    const QRectF r = paintRect.normalized();
+
+    const double xOffset = level.xAxis.offset;
+    const double yOffset = level.yAxis.offset;
+
+    const int col0 = qwtFloor( ( r.left() + xOffset ) / qwtTileSize );
+    const int col1 = qwtCeil( ( r.right() + xOffset ) / qwtTileSize ) - 1;
+    const int row0 = qwtFloor( ( r.top() + yOffset ) / qwtTileSize );
+    const int row1 = qwtCeil( ( r.bottom() + yOffset ) / qwtTileSize ) - 1;
+
+    // tiles are rendered in the background, when painting to the canvas
+
+    bool async = false;
+
+#if QWT_USE_THREADS
+    if ( const QwtPlot* plot = item->plot() )
+    {
+        const QPaintDevice* device = painter->device();
+
+        const QwtPlotCanvas* canvas =
+            qobject_cast< const QwtPlotCanvas* >( plot->canvas() );
+
+        async = ( device == plot->canvas() )
+            || ( canvas && device == canvas->backingStore() );
+    }
+#endif
+
+    QList< QwtTileRequest > coarseRequests;
+    QList< QwtTileRequest > fineRequests;
+
+    for ( int row = row0; row <= row1; row++ )
+    {
+        for ( int col = col0; col <= col1; col++ )
+        {
+            const qint64 key = qwtTileKey( col, row );
+
+            QMap< qint64, QwtRasterTile >::iterator it = level.tiles.find( key );
+            if ( it != level.tiles.end() && !it->isCoarse )
+                continue;
+
+            if ( !async )
+            {
+                // rendering in the GUI thread
+                const QwtTileRequest rq = request( level, col, row, false );
+
+                QwtTileResult result;
+                result.level = rq.level;
+                result.key = rq.key;
+                result.isCoarse = false;
+                {
+                    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Raster );
+                    result.image = item->renderImage(
+                        rq.xMap, rq.yMap, rq.area, rq.imageSize );
+                }
+
+                insertResult( result );
+
+                continue;
+            }
+
+            if ( it == level.tiles.end() )
+                coarseRequests += request( level, col, row, true );
+
+            fineRequests += request( level, col, row, false );
+        }
+    }
+
+    if ( async )
+    {
+        const QList< QwtTileRequest > requests = coarseRequests + fineRequests;
+
+        bool isRendering;
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            cache.requests.clear();
+            for ( int i = 0; i < requests.size(); i++ )
+            {
+                const QwtTileRequest& rq = requests[i];
+
+                if ( cache.hasCurrent && cache.current.level == rq.level
+                    && cache.current.key == rq.key
+                    && cache.current.isCoarse == rq.isCoarse )
+                {
+                    // already in progress
+                    continue;
+                }
+
+                cache.requests += rq;
+            }
+
+            isRendering = cache.hasCurrent || !cache.requests.isEmpty();
+        }
+
+#if QWT_USE_THREADS
+        if ( !requests.isEmpty() && cache.future.isFinished() )
+        {
+            cache.future = QtConcurrent::run(
+                &PrivateData::renderTiles, this, item );
+        }
+#endif
+
+        if ( isRendering )
+            pollResults( item->plot() );
+    }
+
+    // painting the tiles
+
+    const int x0 = qRound( -xOffset );
+    const int y0 = qRound( -yOffset );
+
+    painter->save();
+    painter->setWorldTransform( QTransform() );
+    painter->setClipRect( clipRect, Qt::IntersectClip );
+
+    const uint usage = ++cache.usage;
+
+    const bool hasAlpha = ( alpha >= 0 && alpha < 255 );
+    const bool alphaAttribute =
+        item->testPaintAttribute( QwtPlotRasterItem::PaintAlphaAsOpacity );
+
+    const qreal opacity = painter->opacity();
+
+    for ( int row = row0; row <= row1; row++ )
+    {
+        for ( int col = col0; col <= col1; col++ )
+        {
+            QMap< qint64, QwtRasterTile >::iterator it =
+                level.tiles.find( qwtTileKey( col, row ) );
+
+            if ( it == level.tiles.end() || it->image.isNull() )
+                continue;
+
+            QwtRasterTile& tile = *it;
+            tile.usage = usage;
+
+            const QImage* image = &tile.image;
+
+            if ( hasAlpha )
+            {
+                if ( qwtAlphaByOpacity( painter, tile.image, alphaAttribute ) )
+                {
+                    painter->setOpacity( opacity * alpha / 255.0 );
+                }
+                else
+                {
+                    if ( tile.alpha != alpha )
+                    {
+                        tile.alphaImage = qwtAlphaImage( tile.image, alpha, 1 );
+                        tile.alpha = alpha;
+                    }
+
+                    painter->setOpacity( opacity );
+                    image = &tile.alphaImage;
+                }
+            }
+
+            const QRectF rect( x0 + col * qwtTileSize,
+                y0 + row * qwtTileSize, qwtTileSize, qwtTileSize );
+
+            QwtPainter::drawImage( painter, rect, *image );
+        }
+    }
+
+    painter->restore();
+
+    expireTiles( usage );
+    updateCacheUsage();
+
+    return true;
+}
+
 
 static QRectF qwtAlignRect(const QRectF& rect)
 {
@@ -109,10 +853,92 @@ static QRectF qwtStripRect(const QRectF& rect, const QRectF& area,
     return r;
 }
 
+namespace
+{
+    class QwtExpandJob
+    {
+      public:
+        const QImage* image;
+
+        uchar* bits;
+        int bytesPerLine;
+        int width;
+
+        // target pixels [cols1[i], cols2[i][ for column i of the image
+        const int* cols1;
+        const int* cols2;
+
+        // target rows [rows1[i], rows2[i][ for row i of the image
+        const int* rows1;
+        const int* rows2;
+
+        // rows of the image
+        int from;
+        int to;
+    };
+}
+
+static void qwtExpandRuns( int count, double size, double offset,
+    int numPixels, QVector< int >& from, QVector< int >& to )
+{
+    from.resize( count );
+    to.resize( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        from[i] = ( i == 0 ) ? 0 : qMax( qRound( i * size - offset ), 0 );
+
+        to[i] = ( i == count - 1 ) ? numPixels
+            : qMin( qRound( ( i + 1 ) * size - offset ), numPixels );
+    }
+}
+
+template< typename T >
+static void qwtExpandRows( const QwtExpandJob* job )
+{
+    /*
+        The first target row of an image row is filled run by run,
+        all further target rows are copies of it.
+     */
+
+    const size_t lineSize = job->width * sizeof( T );
+
+    for ( int y1 = job->from; y1 < job->to; y1++ )
+    {
+        const int yy1 = job->rows1[y1];
+        const int yy2 = job->rows2[y1];
+
+        if ( yy1 >= yy2 )
+            continue;
+
+        const T* line1 = reinterpret_cast< const T* >( job->image->scanLine( y1 ) );
+
+        uchar* firstLine = job->bits + qptrdiff( yy1 ) * job->bytesPerLine;
+        T* line2 = reinterpret_cast< T* >( firstLine );
+
+        const int w = job->image->width();
+        for ( int x1 = 0; x1 < w; x1++ )
+        {
+            const int xx1 = job->cols1[x1];
+            const int xx2 = job->cols2[x1];
+
+            if ( xx1 < xx2 )
+                std::fill( line2 + xx1, line2 + xx2, line1[x1] );
+        }
+
+        for ( int y2 = yy1 + 1; y2 < yy2; y2++ )
+        {
+            std::memcpy( job->bits + qptrdiff( y2 ) * job->bytesPerLine,
+                firstLine, lineSize );
+        }
+    }
+}
+
 static QImage qwtExpandImage(const QImage& image,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& area, const QRectF& area2, const QRectF& paintRect,
-    const QwtInterval& xInterval, const QwtInterval& yInterval )
+    const QwtInterval& xInterval, const QwtInterval& yInterval,
+    int numThreads )
 {
     const QRectF strippedRect = qwtStripRect(paintRect, area2,
         xMap, yMap, xInterval, yInterval);
@@ -162,146 +988,69 @@ static QImage qwtExpandImage(const QImage& image,
     if ( image.format() == QImage::Format_Indexed8 )
         expanded.setColorTable( image.colorTable() );
 
-    switch( image.depth() )
-    {
-        case 32:
-        {
-            for ( int y1 = 0; y1 < h; y1++ )
-            {
-                int yy1;
-                if ( y1 == 0 )
-                {
-                    yy1 = 0;
-                }
-                else
-                {
-                    yy1 = qRound( y1 * ph - py0 );
-                    if ( yy1 < 0 )
-                        yy1 = 0;
-                }
-
-                int yy2;
-                if ( y1 == h - 1 )
-                {
-                    yy2 = sz.height();
-                }
-                else
-                {
-                    yy2 = qRound( ( y1 + 1 ) * ph - py0 );
-                    if ( yy2 > sz.height() )
-                        yy2 = sz.height();
-                }
-
-                const quint32* line1 =
-                    reinterpret_cast< const quint32* >( image.scanLine( y1 ) );
-
-                for ( int x1 = 0; x1 < w; x1++ )
-                {
-                    int xx1;
-                    if ( x1 == 0 )
-                    {
-                        xx1 = 0;
-                    }
-                    else
-                    {
-                        xx1 = qRound( x1 * pw - px0 );
-                        if ( xx1 < 0 )
-                            xx1 = 0;
-                    }
+    if ( image.depth() != 32 && image.depth() != 8 )
+        return image;
 
-                    int xx2;
-                    if ( x1 == w - 1 )
-                    {
-                        xx2 = sz.width();
-                    }
-                    else
-                    {
-                        xx2 = qRound( ( x1 + 1 ) * pw - px0 );
-                        if ( xx2 > sz.width() )
-                            xx2 = sz.width();
-                    }
+    // the runs of target pixels for each column and row of the image
 
-                    const quint32 rgb( line1[x1] );
-                    for ( int y2 = yy1; y2 < yy2; y2++ )
-                    {
-                        quint32* line2 = reinterpret_cast< quint32* >(
-                            expanded.scanLine( y2 ) );
+    QVector< int > cols1, cols2, rows1, rows2;
+    qwtExpandRuns( w, pw, px0, sz.width(), cols1, cols2 );
+    qwtExpandRuns( h, ph, py0, sz.height(), rows1, rows2 );
 
-                        for ( int x2 = xx1; x2 < xx2; x2++ )
-                            line2[x2] = rgb;
-                    }
-                }
-            }
-            break;
-        }
-        case 8:
-        {
-            for ( int y1 = 0; y1 < h; y1++ )
-            {
-                int yy1;
-                if ( y1 == 0 )
-                {
-                    yy1 = 0;
-                }
-                else
-                {
-                    yy1 = qRound( y1 * ph - py0 );
-                    if ( yy1 < 0 )
-                        yy1 = 0;
-                }
+    QwtExpandJob job;
+    job.image = &image;
+    job.bits = expanded.bits();
+    job.bytesPerLine = expanded.bytesPerLine();
+    job.width = sz.width();
+    job.cols1 = cols1.constData();
+    job.cols2 = cols2.constData();
+    job.rows1 = rows1.constData();
+    job.rows2 = rows2.constData();
+    job.from = 0;
+    job.to = h;
 
-                int yy2;
-                if ( y1 == h - 1 )
-                {
-                    yy2 = sz.height();
-                }
-                else
-                {
-                    yy2 = qRound( ( y1 + 1 ) * ph - py0 );
-                    if ( yy2 > sz.height() )
-                        yy2 = sz.height();
-                }
+    void ( *expandRows )( const QwtExpandJob* ) = ( image.depth() == 32 )
+        ? &qwtExpandRows< quint32 > : &qwtExpandRows< uchar >;
 
-                const uchar* line1 = image.scanLine( y1 );
+#if QWT_USE_THREADS
+    // below ~64k pixels the overhead of threads is not worth it
 
-                for ( int x1 = 0; x1 < w; x1++ )
-                {
-                    int xx1;
-                    if ( x1 == 0 )
-                    {
-                        xx1 = 0;
-                    }
-                    else
-                    {
-                        xx1 = qRound( x1 * pw - px0 );
-                        if ( xx1 < 0 )
-                            xx1 = 0;
-                    }
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
 
-                    int xx2;
-                    if ( x1 == w - 1 )
-                    {
-                        xx2 = sz.width();
-                    }
-                    else
-                    {
-                        xx2 = qRound( ( x1 + 1 ) * pw - px0 );
-                        if ( xx2 > sz.width() )
-                            xx2 = sz.width();
-                    }
+    numThreads = qBound( 1, numThreads,
+        qMin( h, sz.width() * sz.height() / 65536 ) );
 
-                    for ( int y2 = yy1; y2 < yy2; y2++ )
-                    {
-                        uchar* line2 = expanded.scanLine( y2 );
-                        memset( line2 + xx1, line1[x1], xx2 - xx1 );
-                    }
-                }
-            }
-            break;
+    if ( numThreads > 1 )
+    {
+        QVector< QwtExpandJob > jobs( numThreads );
+
+        const int numRows = h / numThreads;
+        for ( int i = 0; i < numThreads; i++ )
+        {
+            jobs[i] = job;
+            jobs[i].from = i * numRows;
+            jobs[i].to = ( i == numThreads - 1 ) ? h : ( i + 1 ) * numRows;
         }
-        default:
-            expanded = image;
+
+        QVector< QFuture< void > > futures;
+        futures.reserve( numThreads - 1 );
+
+        for ( int i = 1; i < numThreads; i++ )
+            futures += QtConcurrent::run( expandRows, &jobs[i] );
+
+        expandRows( &jobs[0] );
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        return expanded;
     }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    expandRows( &job );
 
     return expanded;
 }
@@ -365,7 +1114,8 @@ static bool qwtUseCache( QwtPlotRasterItem::CachePolicy policy,
 {
     bool doCache = false;
 
-    if ( policy == QwtPlotRasterItem::PaintCache )
+    if ( policy == QwtPlotRasterItem::PaintCache
+        || policy == QwtPlotRasterItem::TileCache )
     {
         // Caching doesn't make sense, when the item is
         // not painted to screen
@@ -400,18 +1150,7 @@ static void qwtToRgba( const QImage* from, QImage* to,
     const int x0 = tile.left();
     const int x1 = tile.right();
 
-    if ( from->depth() == 8 )
-    {
-        for ( int y = y0; y <= y1; y++ )
-        {
-            QRgb* alphaLine = reinterpret_cast< QRgb* >( to->scanLine( y ) );
-            const unsigned char* line = from->scanLine( y );
-
-            for ( int x = x0; x <= x1; x++ )
-                *alphaLine++ = ( from->color( *line++ ) & mask2 ) | mask1;
-        }
-    }
-    else if ( from->depth() == 32 )
+    if ( from->depth() == 32 )
     {
         for ( int y = y0; y <= y1; y++ )
         {
@@ -430,6 +1169,86 @@ static void qwtToRgba( const QImage* from, QImage* to,
     }
 }
 
+/*
+    For opaque images the alpha value can be applied by the
+    paint engine, without touching the pixels.
+ */
+static bool qwtAlphaByOpacity( const QPainter* painter,
+    const QImage& image, bool alphaAsOpacity )
+{
+    if ( image.format() == QImage::Format_Indexed8 )
+        return false;
+
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || !engine->hasFeature( QPaintEngine::ConstantOpacity ) )
+        return false;
+
+    return alphaAsOpacity || !image.hasAlphaChannel();
+}
+
+static QImage qwtAlphaImage( const QImage& image, int alpha, uint numThreads )
+{
+    if ( image.format() == QImage::Format_Indexed8 )
+    {
+        // it is enough to modify the colors of the color table
+
+        QVector< QRgb > colorTable = image.colorTable();
+        for ( int i = 0; i < colorTable.size(); i++ )
+        {
+            const QRgb rgb = colorTable[i];
+            if ( qAlpha( rgb ) != 0 )
+                colorTable[i] = qRgba( qRed( rgb ), qGreen( rgb ), qBlue( rgb ), alpha );
+        }
+
+        QImage alphaImage = image;
+        alphaImage.setColorTable( colorTable );
+
+        return alphaImage;
+    }
+
+    if ( image.depth() != 32 )
+        return image;
+
+    QImage alphaImage( image.size(), QImage::Format_ARGB32 );
+
+#if !defined( QT_NO_QFUTURE )
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    const int numRows = image.height() / numThreads;
+
+    QVector< QFuture< void > > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        QRect tile( 0, i * numRows, image.width(), numRows );
+        if ( i == numThreads - 1 )
+        {
+            tile.setHeight( image.height() - i * numRows );
+            qwtToRgba( &image, &alphaImage, tile, alpha );
+        }
+        else
+        {
+            futures += QtConcurrent::run(
+                &qwtToRgba, &image, &alphaImage, tile, alpha );
+        }
+    }
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    Q_UNUSED( numThreads )
+
+    const QRect tile( 0, 0, image.width(), image.height() );
+    qwtToRgba( &image, &alphaImage, tile, alpha );
+#endif
+
+    return alphaImage;
+}
+
 //! Constructor
 QwtPlotRasterItem::QwtPlotRasterItem( const QString& title )
     : QwtPlotItem( QwtText( title ) )
@@ -447,6 +1266,7 @@ QwtPlotRasterItem::QwtPlotRasterItem( const QwtText& title )
 //! Destructor
 QwtPlotRasterItem::~QwtPlotRasterItem()
 {
+    m_data->stopRendering();
     delete m_data;
 }
 
@@ -505,6 +1325,9 @@ bool QwtPlotRasterItem::testPaintAttribute( PaintAttribute attribute ) const
 
    The default alpha value is -1.
 
+   \note Whenever possible the alpha value is applied without a pass
+         over all pixels ( see PaintAlphaAsOpacity ).
+
    \sa alpha()
  */
 void QwtPlotRasterItem::setAlpha( int alpha )
@@ -561,15 +1384,167 @@ QwtPlotRasterItem::CachePolicy QwtPlotRasterItem::cachePolicy() const
     return m_data->cache.policy;
 }
 
+/*!
+   \brief Limit the memory for the tiles of the TileCache policy
+
+   When the tiles of all cached resolutions exceed the limit, the tiles,
+   that have not been displayed for the longest time, are discarded.
+   The tiles being displayed are never discarded.
+
+   The default limit is 64MB.
+
+   \param kiloBytes Memory limit in kilobytes
+   \sa cacheLimit(), setCachePolicy()
+ */
+void QwtPlotRasterItem::setCacheLimit( int kiloBytes )
+{
+    m_data->tileCache.limit = qMax( kiloBytes, 0 );
+}
+
+/*!
+   \return Memory limit for the tiles of the TileCache policy in kilobytes
+   \sa setCacheLimit()
+ */
+int QwtPlotRasterItem::cacheLimit() const
+{
+    return m_data->tileCache.limit;
+}
+
 /*!
    Invalidate the paint cache
+
+   When tiles are rendered in a background thread ( TileCache )
+   invalidateCache() waits until the current tile has been finished.
+   So it has to be called before modifying anything, that is used
+   by renderImage().
+
    \sa setCachePolicy()
  */
 void QwtPlotRasterItem::invalidateCache()
 {
+    m_data->revision++;
+
     m_data->cache.image = QImage();
     m_data->cache.area = QRect();
     m_data->cache.size = QSize();
+    m_data->cache.pendingRows = 0;
+    m_data->cache.dirtyRects.clear();
+
+    // waits for tiles being rendered in the background
+    m_data->clearTiles();
+
+    m_data->updateCacheUsage();
+}
+
+/*!
+   \brief Invalidate a region of the cached image
+
+   With the PaintCache policy only the pixels of the cached image,
+   that are affected by rect, are rendered again with the next replot
+   and copied into the image. The pixels are rendered by calling
+   renderImage() for the bounding rectangle of the pixels, so that
+   QwtPlotSpectrogram renders them in parallel tiles.
+
+   For the other cache policies invalidateRegion() is the same
+   as invalidateCache().
+
+   \param rect Region, that has been modified, in scale coordinates
+   \note invalidateRegion() does not trigger a replot
+
+   \warning A derived class, where the color of a pixel is not only
+            depending on its position - f.e. because of normalizing
+            the values of the complete image - has to call
+            invalidateCache() instead.
+
+   \sa invalidateCache(), scrollRows()
+ */
+void QwtPlotRasterItem::invalidateRegion( const QRectF& rect )
+{
+    m_data->revision++;
+
+    if ( m_data->cache.policy != PaintCache )
+    {
+        invalidateCache();
+        return;
+    }
+
+    if ( m_data->cache.image.isNull() || rect.isNull() )
+        return;
+
+    QVector< QRectF >& dirtyRects = m_data->cache.dirtyRects;
+
+    if ( dirtyRects.size() >= 16 )
+    {
+        // too many small regions are not worth the effort
+
+        QRectF r = rect.normalized();
+        for ( int i = 0; i < dirtyRects.size(); i++ )
+            r |= dirtyRects[i];
+
+        dirtyRects.clear();
+        dirtyRects += r;
+    }
+    else
+    {
+        dirtyRects += rect.normalized();
+    }
+}
+
+/*!
+   \brief Revision of the raster data
+
+   The revision is increased by invalidateCache(), invalidateRegion()
+   and scrollRows(). Derived classes can use it to find out, if
+   their own caches - like the contour lines of QwtPlotSpectrogram -
+   are still valid.
+
+   \return Revision counter
+ */
+uint QwtPlotRasterItem::revision() const
+{
+    return m_data->revision;
+}
+
+/*!
+   \brief Indicate, that the rows of the raster data have been shifted
+
+   A positive value means, that the rows have been moved towards
+   the minimum of the y interval and numRows rows have been appended
+   at the maximum - like QwtRingBufferRasterData::appendRows().
+   A negative value is the opposite direction.
+
+   With the PaintCache policy the cached image is shifted in place with
+   the next replot and only the new rows are rendered. This is possible,
+   when the image is rendered in the resolution of the rows
+   ( see pixelHint() ) and the y axis has a linear scale.
+   In all other situations the complete image is rendered again.
+
+   \param numRows Number of rows, that have been scrolled
+   \note scrollRows() does not trigger a replot
+   \sa invalidateCache(), QwtRingBufferRasterData
+ */
+void QwtPlotRasterItem::scrollRows( int numRows )
+{
+    if ( numRows == 0 )
+        return;
+
+    m_data->revision++;
+
+    if ( m_data->cache.policy != PaintCache )
+    {
+        invalidateCache();
+        return;
+    }
+
+    if ( ( numRows > 0 && m_data->cache.pendingRows < 0 )
+        || ( numRows < 0 && m_data->cache.pendingRows > 0 ) )
+    {
+        // rows at both borders have changed
+        invalidateCache();
+        return;
+    }
+
+    m_data->cache.pendingRows += numRows;
 }
 
 /*!
@@ -604,12 +1579,18 @@ QRectF QwtPlotRasterItem::pixelHint( const QRectF& area ) const
     return QRectF();
 }
 
+// device pixels per image pixel, when QwtPlot::CoarseRasters applies
+static const double qwtCoarseRasterFactor = 4.0;
+
 /*!
    \brief Draw the raster data
    \param painter Painter
    \param xMap X-Scale Map
    \param yMap Y-Scale Map
    \param canvasRect Contents rectangle of the plot canvas
+
+   \note While the plot reduces the render quality for QwtPlot::CoarseRasters
+         the image is rendered with a lower resolution and bypasses the cache.
  */
 void QwtPlotRasterItem::draw( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -618,7 +1599,7 @@ void QwtPlotRasterItem::draw( QPainter* painter,
     if ( canvasRect.isEmpty() || m_data->alpha == 0 )
         return;
 
-    const bool doCache = qwtUseCache( m_data->cache.policy, painter );
+    bool doCache = qwtUseCache( m_data->cache.policy, painter );
 
     const QwtInterval xInterval = interval( Qt::XAxis );
     const QwtInterval yInterval = interval( Qt::YAxis );
@@ -645,6 +1626,21 @@ void QwtPlotRasterItem::draw( QPainter* painter,
         paintRect = QwtScaleMap::transform( xxMap, yyMap, area );
     }
 
+    if ( QwtPainter::isMeasureOnly( painter ) )
+    {
+        // a placeholder with the geometry of the image
+
+        QImage placeholder( 1, 1, QImage::Format_ARGB32_Premultiplied );
+        placeholder.fill( Qt::transparent );
+
+        painter->save();
+        painter->setWorldTransform( QTransform() );
+        painter->drawImage( paintRect, placeholder );
+        painter->restore();
+
+        return;
+    }
+
     QRectF imageRect;
     QImage image;
 
@@ -679,6 +1675,41 @@ void QwtPlotRasterItem::draw( QPainter* painter,
         }
     }
 
+    if ( plot() && plot()->testQualityReduction( QwtPlot::CoarseRasters ) )
+    {
+        /*
+            While the user is interacting the image is rendered
+            with a reduced resolution and is not cached, as the
+            next replot will be in full quality anyway.
+         */
+        const double dx = qwtCoarseRasterFactor
+            * qAbs( xxMap.invTransform( 1 ) - xxMap.invTransform( 0 ) );
+        const double dy = qwtCoarseRasterFactor
+            * qAbs( yyMap.invTransform( 1 ) - yyMap.invTransform( 0 ) );
+
+        if ( pixelRect.isEmpty() )
+            pixelRect = QRectF( area.left(), area.top(), dx, dy );
+
+        if ( dx > pixelRect.width() )
+            pixelRect.setWidth( dx );
+
+        if ( dy > pixelRect.height() )
+            pixelRect.setHeight( dy );
+
+        doCache = false;
+    }
+
+    if ( pixelRect.isEmpty() && m_data->cache.policy == TileCache
+        && qwtUseCache( TileCache, painter )
+        && painter->transform().isIdentity() )
+    {
+        const QRectF clipRect = qwtStripRect( qwtAlignRect( paintRect ),
+            area, xxMap, yyMap, xInterval, yInterval );
+
+        if ( m_data->drawTiles( this, painter, xxMap, yyMap, paintRect, clipRect ) )
+            return;
+    }
+
     if ( pixelRect.isEmpty() )
     {
         if ( QwtPainter::roundingAlignment( painter ) )
@@ -755,13 +1786,27 @@ void QwtPlotRasterItem::draw( QPainter* painter,
             // different sizes
 
             image = qwtExpandImage(image, xxMap, yyMap,
-                imageArea, area, paintRect, xInterval, yInterval );
+                imageArea, area, paintRect, xInterval, yInterval,
+                renderThreadCount() );
         }
     }
 
     painter->save();
     painter->setWorldTransform( QTransform() );
 
+    if ( m_data->alpha >= 0 && m_data->alpha < 255 )
+    {
+        if ( qwtAlphaByOpacity( painter, image,
+            testPaintAttribute( PaintAlphaAsOpacity ) ) )
+        {
+            painter->setOpacity( painter->opacity() * m_data->alpha / 255.0 );
+        }
+        else
+        {
+            image = qwtAlphaImage( image, m_data->alpha, renderThreadCount() );
+        }
+    }
+
     QwtPainter::drawImage( painter, imageRect, image );
 
     painter->restore();
@@ -824,6 +1869,136 @@ QRectF QwtPlotRasterItem::boundingRect() const
     return r.normalized();
 }
 
+bool QwtPlotRasterItem::PrivateData::updateImage(
+    const QwtPlotRasterItem* item,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap )
+{
+    QImage& image = cache.image;
+
+    if ( cache.pendingRows != 0 )
+    {
+        if ( yMap.transformation() != NULL || yMap.s1() == yMap.s2() )
+            return false;
+
+        const QRectF pixelRect = item->pixelHint( cache.area );
+        if ( pixelRect.isEmpty() )
+            return false;
+
+        /*
+            Moving the rows towards the minimum of the y interval
+            moves them by a number of image rows, that has to be integral.
+         */
+        const double rowsF = -cache.pendingRows * pixelRect.height()
+            * ( yMap.p2() - yMap.p1() ) / ( yMap.s2() - yMap.s1() );
+
+        const int rows = qRound( rowsF );
+        if ( rows == 0 || qAbs( rowsF - rows ) > 1e-6
+            || qAbs( rows ) >= image.height() )
+        {
+            return false;
+        }
+
+        const int numRows = qAbs( rows );
+        const int bytesPerLine = image.bytesPerLine();
+
+        // the cache is not shared - no reallocation
+        uchar* bits = image.bits();
+
+        QRect rowRect( 0, 0, image.width(), numRows );
+
+        if ( rows > 0 )
+        {
+            std::memmove( bits + qint64( numRows ) * bytesPerLine, bits,
+                qint64( image.height() - numRows ) * bytesPerLine );
+        }
+        else
+        {
+            std::memmove( bits, bits + qint64( numRows ) * bytesPerLine,
+                qint64( image.height() - numRows ) * bytesPerLine );
+
+            rowRect.moveTop( image.height() - numRows );
+        }
+
+        if ( !renderSubImage( item, xMap, yMap, rowRect ) )
+            return false;
+
+        cache.pendingRows = 0;
+    }
+
+    for ( int i = 0; i < cache.dirtyRects.size(); i++ )
+    {
+        const QRectF& r = cache.dirtyRects[i];
+
+        // bounded to avoid overflows for regions far outside
+
+        const double w = image.width();
+        const double h = image.height();
+
+        const double x1 = qBound( -1.0, xMap.transform( r.left() ), w );
+        const double x2 = qBound( -1.0, xMap.transform( r.right() ), w );
+        const double y1 = qBound( -1.0, yMap.transform( r.top() ), h );
+        const double y2 = qBound( -1.0, yMap.transform( r.bottom() ), h );
+
+        // 2 extra pixels for resampling algorithms interpolating neighbours
+
+        QRect pixelRect;
+        pixelRect.setCoords(
+            qwtFloor( qMin( x1, x2 ) ) - 2, qwtFloor( qMin( y1, y2 ) ) - 2,
+            qwtCeil( qMax( x1, x2 ) ) + 2, qwtCeil( qMax( y1, y2 ) ) + 2 );
+
+        pixelRect &= image.rect();
+
+        if ( !pixelRect.isEmpty() )
+        {
+            if ( !renderSubImage( item, xMap, yMap, pixelRect ) )
+                return false;
+        }
+    }
+
+    cache.dirtyRects.clear();
+    return true;
+}
+
+bool QwtPlotRasterItem::PrivateData::renderSubImage(
+    const QwtPlotRasterItem* item, const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QRect& rect )
+{
+    QImage& image = cache.image;
+
+    // maps for an image, that consists of the pixels of rect only
+
+    QwtScaleMap subXMap = xMap;
+    subXMap.setPaintInterval( xMap.p1() - rect.left(), xMap.p2() - rect.left() );
+
+    QwtScaleMap subYMap = yMap;
+    subYMap.setPaintInterval( yMap.p1() - rect.top(), yMap.p2() - rect.top() );
+
+    const QRectF subArea = QRectF(
+        QPointF( subXMap.invTransform( -0.5 ), subYMap.invTransform( -0.5 ) ),
+        QPointF( subXMap.invTransform( rect.width() - 0.5 ),
+            subYMap.invTransform( rect.height() - 0.5 ) ) ).normalized();
+
+    QImage subImage;
+    {
+        QwtRenderStatistics::Timer timer( QwtRenderStatistics::Raster );
+        subImage = item->renderImage( subXMap, subYMap, subArea, rect.size() );
+    }
+
+    if ( subImage.format() != image.format() || subImage.size() != rect.size() )
+        return false;
+
+    const int bytesPerPixel = image.depth() / 8;
+    const QImage& constSubImage = subImage;
+
+    for ( int i = 0; i < rect.height(); i++ )
+    {
+        uchar* line = image.scanLine( rect.top() + i ) + rect.left() * bytesPerPixel;
+        std::memcpy( line, constSubImage.scanLine( i ), rect.width() * bytesPerPixel );
+    }
+
+    return true;
+}
+
 QImage QwtPlotRasterItem::compose(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& imageArea, const QRectF& paintRect,
@@ -833,83 +2008,56 @@ QImage QwtPlotRasterItem::compose(
     if ( imageArea.isEmpty() || paintRect.isEmpty() || imageSize.isEmpty() )
         return image;
 
+    double dx = 0.0;
+    if ( paintRect.toRect().width() > imageSize.width() )
+        dx = imageArea.width() / imageSize.width();
+
+    const QwtScaleMap xxMap =
+        imageMap(Qt::Horizontal, xMap, imageArea, imageSize, dx);
+
+    double dy = 0.0;
+    if ( paintRect.toRect().height() > imageSize.height() )
+        dy = imageArea.height() / imageSize.height();
+
+    const QwtScaleMap yyMap =
+        imageMap(Qt::Vertical, yMap, imageArea, imageSize, dy);
+
     if ( doCache )
     {
         if ( !m_data->cache.image.isNull()
+            && m_data->cache.image.size() == imageSize
             && m_data->cache.area == imageArea
             && m_data->cache.size == paintRect.size() )
         {
-            image = m_data->cache.image;
+            // scrolled rows or invalidated regions are updated in place
+
+            if ( m_data->updateImage( this, xxMap, yyMap ) )
+                image = m_data->cache.image;
+
+            m_data->cacheEntry.touch();
         }
     }
 
     if ( image.isNull() )
     {
-        double dx = 0.0;
-        if ( paintRect.toRect().width() > imageSize.width() )
-            dx = imageArea.width() / imageSize.width();
-
-        const QwtScaleMap xxMap =
-            imageMap(Qt::Horizontal, xMap, imageArea, imageSize, dx);
-
-        double dy = 0.0;
-        if ( paintRect.toRect().height() > imageSize.height() )
-            dy = imageArea.height() / imageSize.height();
-
-        const QwtScaleMap yyMap =
-            imageMap(Qt::Vertical, yMap, imageArea, imageSize, dy);
-
-        image = renderImage( xxMap, yyMap, imageArea, imageSize );
+        {
+            QwtRenderStatistics::Timer timer( QwtRenderStatistics::Raster );
+            image = renderImage( xxMap, yyMap, imageArea, imageSize );
+        }
 
         if ( doCache )
         {
             m_data->cache.area = imageArea;
             m_data->cache.size = paintRect.size();
             m_data->cache.image = image;
-        }
-    }
-
-    if ( m_data->alpha >= 0 && m_data->alpha < 255 )
-    {
-        QImage alphaImage( image.size(), QImage::Format_ARGB32 );
-
-#if !defined( QT_NO_QFUTURE )
-        uint numThreads = renderThreadCount();
-
-        if ( numThreads <= 0 )
-            numThreads = QThread::idealThreadCount();
 
-        if ( numThreads <= 0 )
-            numThreads = 1;
-
-        const int numRows = image.height() / numThreads;
-
-        QVector< QFuture< void > > futures;
-        futures.reserve( numThreads - 1 );
-
-        for ( uint i = 0; i < numThreads; i++ )
-        {
-            QRect tile( 0, i * numRows, image.width(), numRows );
-            if ( i == numThreads - 1 )
-            {
-                tile.setHeight( image.height() - i * numRows );
-                qwtToRgba( &image, &alphaImage, tile, m_data->alpha );
-            }
-            else
-            {
-                futures += QtConcurrent::run(
-                    &qwtToRgba, &image, &alphaImage, tile, m_data->alpha );
-            }
+            m_data->updateCacheUsage();
         }
-        for ( int i = 0; i < futures.size(); i++ )
-            futures[i].waitForFinished();
-#else
-        const QRect tile( 0, 0, image.width(), image.height() );
-        qwtToRgba( &image, &alphaImage, tile, m_data->alpha );
-#endif
-        image = alphaImage;
     }
 
+    m_data->cache.pendingRows = 0;
+    m_data->cache.dirtyRects.clear();
+
     return image;
 }
 
@@ -56,7 +56,28 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
            of hide/show operations or manipulations of the alpha value.
            All other situations are handled by the canvas backing store.
          */
-        PaintCache
+        PaintCache,
+
+        /*!
+           The image is composed from tiles, that are rendered
+           asynchronously in a background thread. Tiles, that are not
+           available yet, are displayed in a lower resolution first
+           and refined later. Rendered tiles are kept when panning and
+           for the most recently used resolutions of the scales, so that
+           f.e. going back in the zoom stack of a QwtPlotZoomer doesn't
+           need to render anything. The memory being used for the tiles
+           is limited by cacheLimit().
+
+           This type of cache is useful for raster data, where renderImage()
+           is too expensive to be done for each replot.
+           It only applies, when painting to the plot canvas in device
+           resolution - all other situations are handled like PaintCache.
+
+           \note A derived class has to call invalidateCache(),
+                 before modifying anything, that is used by renderImage().
+                 This includes the destructor.
+         */
+        TileCache
     };
 
     /*!
@@ -77,7 +98,19 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
            depends on the implementation of the specific QPaintEngine.
          */
 
-        PaintInDeviceResolution = 1
+        PaintInDeviceResolution = 1,
+
+        /*!
+           The alpha value ( see setAlpha() ) is applied by the paint engine
+           as opacity instead of replacing the alpha values of all pixels.
+           For images with opaque and fully transparent pixels only - f.e.
+           a spectrogram with an opaque color map - the result is the same,
+           but without an extra pass over the image.
+
+           Images without alpha channel are always painted with an opacity
+           and for Format_Indexed8 images only the color table is modified.
+         */
+        PaintAlphaAsOpacity = 2
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -95,7 +128,12 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
     void setCachePolicy( CachePolicy );
     CachePolicy cachePolicy() const;
 
+    void setCacheLimit( int kiloBytes );
+    int cacheLimit() const;
+
     void invalidateCache();
+    void invalidateRegion( const QRectF& );
+    void scrollRows( int numRows );
 
     virtual void draw( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -131,6 +169,8 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
         const QwtScaleMap& map, const QRectF& area,
         const QSize& imageSize, double pixelSize) const;
 
+    uint revision() const;
+
   private:
     explicit QwtPlotRasterItem( const QwtPlotRasterItem& );
     QwtPlotRasterItem& operator=( const QwtPlotRasterItem& );
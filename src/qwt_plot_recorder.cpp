@@ -0,0 +1,475 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_recorder.h"
+#include "qwt_frame_encoder.h"
+#include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
+
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+#include <qqueue.h>
+#include <qimage.h>
+#include <qpixmap.h>
+#include <qpointer.h>
+#include <qelapsedtimer.h>
+#include <qevent.h>
+
+namespace
+{
+    class Frame
+    {
+      public:
+        Frame()
+            : index( -1 )
+            , timestamp( 0 )
+        {
+        }
+
+        QImage image;
+        int index;
+        qint64 timestamp;
+    };
+}
+
+class QwtPlotRecorder::EncoderThread : public QThread
+{
+  public:
+    EncoderThread( QwtFrameEncoder* encoder )
+        : m_encoder( encoder )
+        , m_isStopped( false )
+        , m_failedFrames( 0 )
+    {
+    }
+
+    bool enqueue( const Frame& frame, int maxQueueSize,
+        QwtPlotRecorder::OverflowPolicy policy, int& droppedIndex )
+    {
+        droppedIndex = -1;
+
+        QMutexLocker locker( &m_mutex );
+
+        if ( m_queue.size() >= maxQueueSize )
+        {
+            if ( policy == QwtPlotRecorder::DropNewest || m_queue.isEmpty() )
+            {
+                droppedIndex = frame.index;
+                return false;
+            }
+
+            droppedIndex = m_queue.dequeue().index;
+        }
+
+        m_queue.enqueue( frame );
+        m_condition.wakeOne();
+
+        return true;
+    }
+
+    void finish()
+    {
+        QMutexLocker locker( &m_mutex );
+
+        m_isStopped = true;
+        m_condition.wakeOne();
+    }
+
+    int failedFrames() const
+    {
+        QMutexLocker locker( &m_mutex );
+        return m_failedFrames;
+    }
+
+  protected:
+    virtual void run() QWT_OVERRIDE
+    {
+        const bool isOpen = m_encoder->open();
+
+        while ( true )
+        {
+            Frame frame;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                while ( m_queue.isEmpty() && !m_isStopped )
+                    m_condition.wait( &m_mutex );
+
+                // the queued frames are encoded before stopping
+                if ( m_queue.isEmpty() )
+                    break;
+
+                frame = m_queue.dequeue();
+            }
+
+            const bool ok = isOpen
+                && m_encoder->encode( frame.image, frame.index, frame.timestamp );
+
+            if ( !ok )
+            {
+                QMutexLocker locker( &m_mutex );
+                m_failedFrames++;
+            }
+        }
+
+        if ( isOpen )
+            m_encoder->close();
+    }
+
+  private:
+    QwtFrameEncoder* m_encoder;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_condition;
+    QQueue< Frame > m_queue;
+
+    bool m_isStopped;
+    int m_failedFrames;
+};
+
+class QwtPlotRecorder::PrivateData
+{
+  public:
+    PrivateData()
+        : encoder( NULL )
+        , thread( NULL )
+        , maxQueueSize( 8 )
+        , overflowPolicy( QwtPlotRecorder::DropNewest )
+        , isPending( false )
+        , isGrabbing( false )
+        , frameCount( 0 )
+        , droppedFrames( 0 )
+        , failedFrames( 0 )
+    {
+    }
+
+    QwtFrameEncoder* encoder;
+    EncoderThread* thread;
+
+    int maxQueueSize;
+    QwtPlotRecorder::OverflowPolicy overflowPolicy;
+
+    QPointer< QwtPlot > plot;
+    QPointer< QWidget > canvas;
+
+    QElapsedTimer timer;
+
+    bool isPending;
+    bool isGrabbing;
+
+    int frameCount;
+    int droppedFrames;
+    int failedFrames;
+};
+
+//! Constructor
+QwtPlotRecorder::QwtPlotRecorder( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor, stopping the recording
+QwtPlotRecorder::~QwtPlotRecorder()
+{
+    stop();
+
+    delete m_data->encoder;
+    delete m_data;
+}
+
+/*!
+   \brief Assign the encoder for the frames
+
+   The encoder is used from the encoder thread. It can't be changed
+   while recording. The ownership of the encoder is transferred to
+   the recorder.
+
+   \param encoder Frame encoder
+   \sa encoder(), QwtImageSequenceEncoder
+ */
+void QwtPlotRecorder::setEncoder( QwtFrameEncoder* encoder )
+{
+    if ( isRecording() || encoder == m_data->encoder )
+        return;
+
+    delete m_data->encoder;
+    m_data->encoder = encoder;
+}
+
+/*!
+   \return Frame encoder
+   \sa setEncoder()
+ */
+QwtFrameEncoder* QwtPlotRecorder::encoder()
+{
+    return m_data->encoder;
+}
+
+/*!
+   \return Frame encoder
+   \sa setEncoder()
+ */
+const QwtFrameEncoder* QwtPlotRecorder::encoder() const
+{
+    return m_data->encoder;
+}
+
+/*!
+   \brief Limit the number of frames waiting for the encoder
+
+   Each queued frame holds an image of the size of the canvas.
+   The default setting is 8.
+
+   \param size Maximum number of queued frames
+   \sa maxQueueSize(), setOverflowPolicy()
+ */
+void QwtPlotRecorder::setMaxQueueSize( int size )
+{
+    m_data->maxQueueSize = qMax( size, 1 );
+}
+
+/*!
+   \return Maximum number of frames waiting for the encoder
+   \sa setMaxQueueSize()
+ */
+int QwtPlotRecorder::maxQueueSize() const
+{
+    return m_data->maxQueueSize;
+}
+
+/*!
+   \brief Set the strategy, when the queue is full
+
+   The default setting is DropNewest.
+
+   \param policy Overflow policy
+   \sa overflowPolicy(), setMaxQueueSize()
+ */
+void QwtPlotRecorder::setOverflowPolicy( OverflowPolicy policy )
+{
+    m_data->overflowPolicy = policy;
+}
+
+/*!
+   \return Strategy, when the queue is full
+   \sa setOverflowPolicy()
+ */
+QwtPlotRecorder::OverflowPolicy QwtPlotRecorder::overflowPolicy() const
+{
+    return m_data->overflowPolicy;
+}
+
+/*!
+   \brief Start recording the canvas of a plot
+
+   The frame counters are reset and the encoder thread is started.
+
+   \param plot Plot to be recorded
+   \return false, when no encoder has been assigned or the recorder
+           is already recording
+
+   \sa stop(), setEncoder()
+ */
+bool QwtPlotRecorder::start( QwtPlot* plot )
+{
+    if ( plot == NULL || m_data->encoder == NULL || isRecording() )
+        return false;
+
+    m_data->plot = plot;
+    m_data->canvas = plot->canvas();
+
+    m_data->frameCount = 0;
+    m_data->droppedFrames = 0;
+    m_data->failedFrames = 0;
+    m_data->isPending = false;
+
+    m_data->thread = new EncoderThread( m_data->encoder );
+    m_data->thread->start();
+
+    m_data->timer.start();
+
+    if ( m_data->canvas )
+        m_data->canvas->installEventFilter( this );
+
+    return true;
+}
+
+/*!
+   \brief Stop recording
+
+   stop() blocks until the queued frames have been encoded
+   and the encoder has been closed.
+
+   \sa start()
+ */
+void QwtPlotRecorder::stop()
+{
+    if ( m_data->thread == NULL )
+        return;
+
+    if ( m_data->canvas )
+        m_data->canvas->removeEventFilter( this );
+
+    m_data->thread->finish();
+    m_data->thread->wait();
+
+    m_data->failedFrames = m_data->thread->failedFrames();
+
+    delete m_data->thread;
+    m_data->thread = NULL;
+
+    m_data->plot = NULL;
+    m_data->canvas = NULL;
+}
+
+//! \return true, when recording
+bool QwtPlotRecorder::isRecording() const
+{
+    return m_data->thread != NULL;
+}
+
+/*!
+   \return Plot, that is recorded
+   \sa start()
+ */
+QwtPlot* QwtPlotRecorder::plot() const
+{
+    return m_data->plot;
+}
+
+/*!
+   \return Number of recorded frames, including the dropped frames
+   \sa droppedFrames(), failedFrames()
+ */
+int QwtPlotRecorder::frameCount() const
+{
+    return m_data->frameCount;
+}
+
+/*!
+   \return Number of frames, that have been dropped, because
+           the queue was full
+   \sa frameCount(), setMaxQueueSize(), setOverflowPolicy()
+ */
+int QwtPlotRecorder::droppedFrames() const
+{
+    return m_data->droppedFrames;
+}
+
+/*!
+   \return Number of frames, that could not be encoded
+   \sa QwtFrameEncoder::encode()
+ */
+int QwtPlotRecorder::failedFrames() const
+{
+    if ( m_data->thread )
+        return m_data->thread->failedFrames();
+
+    return m_data->failedFrames;
+}
+
+/*!
+   \brief Record the current content of the canvas
+
+   recordFrame() is called for the paint events of the canvas.
+   It has to be called manually for painting operations, that
+   bypass them - like QwtPlotDirectPainter.
+
+   \sa frameDropped()
+ */
+void QwtPlotRecorder::recordFrame()
+{
+    if ( m_data->thread == NULL || m_data->canvas == NULL )
+        return;
+
+    Frame frame;
+    frame.timestamp = m_data->timer.elapsed();
+    frame.image = grabCanvas();
+
+    if ( frame.image.isNull() )
+        return;
+
+    frame.index = m_data->frameCount++;
+
+    int droppedIndex = -1;
+    m_data->thread->enqueue( frame, m_data->maxQueueSize,
+        m_data->overflowPolicy, droppedIndex );
+
+    if ( droppedIndex >= 0 )
+    {
+        m_data->droppedFrames++;
+        Q_EMIT frameDropped( droppedIndex );
+    }
+}
+
+/*!
+   Event filter, scheduling a frame after the paint events of the canvas
+
+   \param object Object to be filtered
+   \param event Event
+   \return Always false
+ */
+bool QwtPlotRecorder::eventFilter( QObject* object, QEvent* event )
+{
+    if ( event->type() == QEvent::Paint && object == m_data->canvas
+        && !m_data->isGrabbing && !m_data->isPending )
+    {
+        // the frame is taken, when the paint event has been processed
+
+        m_data->isPending = true;
+        QMetaObject::invokeMethod( this, "recordPendingFrame", Qt::QueuedConnection );
+    }
+
+    return false;
+}
+
+void QwtPlotRecorder::recordPendingFrame()
+{
+    if ( m_data->isPending )
+    {
+        m_data->isPending = false;
+        recordFrame();
+    }
+}
+
+QImage QwtPlotRecorder::grabCanvas()
+{
+    QWidget* canvas = m_data->canvas;
+
+    const QwtPlotCanvas* plotCanvas = qobject_cast< const QwtPlotCanvas* >( canvas );
+    if ( plotCanvas && plotCanvas->testPaintAttribute( QwtPlotCanvas::BackingStore ) )
+    {
+        const QPixmap* backingStore = plotCanvas->backingStore();
+        if ( backingStore && !backingStore->isNull() )
+        {
+            // for the raster engine the image shares the pixels
+            return backingStore->toImage();
+        }
+    }
+
+    // grabbing repaints the canvas
+
+    m_data->isGrabbing = true;
+
+#if QT_VERSION >= 0x050000
+    const QPixmap pixmap = canvas->grab( canvas->rect() );
+#else
+    const QPixmap pixmap = QPixmap::grabWidget( canvas, canvas->rect() );
+#endif
+
+    m_data->isGrabbing = false;
+
+    return pixmap.toImage();
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_recorder.cpp"
+#endif
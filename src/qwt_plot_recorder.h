@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_RECORDER_H
+#define QWT_PLOT_RECORDER_H
+
+#include "qwt_global.h"
+#include <qobject.h>
+
+class QwtPlot;
+class QwtFrameEncoder;
+class QImage;
+
+/*!
+   \brief Recorder for the frames of a plot canvas
+
+   QwtPlotRecorder records the content of the canvas after each
+   paint event. The frames are passed through a bounded queue to
+   an encoder thread, so that the GUI thread is not blocked by
+   encoding the images and writing them to disk.
+
+   When the canvas has a backing store ( QwtPlotCanvas::BackingStore )
+   the frame is taken from it. As the image shares the pixels of the
+   backing store, nothing is copied, before the canvas is painted
+   the next time. Otherwise the canvas is grabbed.
+
+   When the encoder can't keep up with the frame rate of the plot
+   and the queue is full the frames are dropped according to the
+   overflowPolicy() instead of stalling the rendering. Dropped frames
+   leave gaps in the indexes passed to QwtFrameEncoder::encode().
+
+   \note Painting operations, that bypass the paint events of the canvas
+         - like QwtPlotDirectPainter - are not recorded automatically.
+         In this case recordFrame() needs to be called manually.
+
+   \sa QwtFrameEncoder, QwtImageSequenceEncoder
+ */
+class QWT_EXPORT QwtPlotRecorder : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /*!
+       \brief Strategy, when the queue of the encoder thread is full
+       \sa setOverflowPolicy()
+     */
+    enum OverflowPolicy
+    {
+        //! The new frame is dropped
+        DropNewest,
+
+        //! The oldest frame in the queue is replaced by the new frame
+        DropOldest
+    };
+
+    explicit QwtPlotRecorder( QObject* parent = NULL );
+    virtual ~QwtPlotRecorder();
+
+    void setEncoder( QwtFrameEncoder* );
+    QwtFrameEncoder* encoder();
+    const QwtFrameEncoder* encoder() const;
+
+    void setMaxQueueSize( int );
+    int maxQueueSize() const;
+
+    void setOverflowPolicy( OverflowPolicy );
+    OverflowPolicy overflowPolicy() const;
+
+    bool start( QwtPlot* );
+    void stop();
+
+    bool isRecording() const;
+    QwtPlot* plot() const;
+
+    int frameCount() const;
+    int droppedFrames() const;
+    int failedFrames() const;
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+  public Q_SLOTS:
+    void recordFrame();
+
+  Q_SIGNALS:
+    /*!
+       A frame has been dropped, because the queue was full
+
+       \param frameIndex Index of the dropped frame
+     */
+    void frameDropped( int frameIndex );
+
+  private Q_SLOTS:
+    void recordPendingFrame();
+
+  private:
+    QImage grabCanvas();
+
+    class EncoderThread;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
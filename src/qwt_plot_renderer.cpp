@@ -9,6 +9,7 @@
 
 #include "qwt_plot_renderer.h"
 #include "qwt_plot.h"
+#include "qwt_plot_scene.h"
 #include "qwt_painter.h"
 #include "qwt_plot_layout.h"
 #include "qwt_abstract_legend.h"
@@ -18,6 +19,8 @@
 #include "qwt_text.h"
 #include "qwt_text_label.h"
 #include "qwt_math.h"
+#include "qwt_graphic.h"
+#include "qwt_painter_command.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
@@ -28,6 +31,15 @@
 #include <qimagewriter.h>
 #include <qvariant.h>
 #include <qmargins.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <cstring>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
 
 #ifndef QWT_NO_SVG
 #ifdef QT_SVG_LIB
@@ -71,6 +83,259 @@
 #include <qpdfwriter.h>
 #endif
 
+namespace
+{
+    // a recorded plot, that can be written without accessing any widget
+    class QwtDocumentJob
+    {
+      public:
+        QwtGraphic graphic;
+
+        QString fileName;
+        QString format;
+        QString title;
+
+        QSizeF sizeMM;
+        int resolution;
+    };
+}
+
+static inline QString qwtDocumentTitle( const QwtPlot* plot )
+{
+    QString title = plot->title().text();
+    if ( title.isEmpty() )
+        title = "Plot Document";
+
+    return title;
+}
+
+/*
+    Record the plot like on a device with 72 dpi, what is the
+    resolution of QwtNullPaintDevice. The texts are converted
+    into paths, so that replaying doesn't need any fonts.
+ */
+static QwtGraphic qwtRecordDocument( const QwtPlotRenderer* renderer,
+    QwtPlot* plot, const QSizeF& sizeMM )
+{
+    const QSizeF size = sizeMM * 72.0 / 25.4;
+
+    QwtGraphic graphic;
+    graphic.setDefaultSize( size );
+
+    QPainter painter( &graphic );
+    renderer->render( plot, &painter,
+        QRectF( 0.0, 0.0, size.width(), size.height() ) );
+    painter.end();
+
+    return graphic;
+}
+
+static QwtGraphic qwtRecordDocument(
+    const QwtPlotScene* scene, const QSizeF& sizeMM )
+{
+    const QSizeF size = sizeMM * 72.0 / 25.4;
+
+    QwtGraphic graphic;
+    graphic.setDefaultSize( size );
+
+    QPainter painter( &graphic );
+    scene->render( &painter,
+        QRectF( 0.0, 0.0, size.width(), size.height() ) );
+    painter.end();
+
+    return graphic;
+}
+
+static inline void qwtReplayDocument( QPainter* painter,
+    const QwtGraphic& graphic, int resolution )
+{
+    const double scale = resolution / 72.0;
+
+    painter->save();
+    painter->scale( scale, scale );
+    graphic.render( painter );
+    painter->restore();
+}
+
+static void qwtRenderTile( const QwtGraphic* graphic,
+    int resolution, QImage* tileImage, const QPoint& pos )
+{
+    tileImage->fill( QColor( Qt::white ).rgb() );
+
+    QPainter painter( tileImage );
+    painter.translate( -pos );
+
+    qwtReplayDocument( &painter, *graphic, resolution );
+}
+
+/*
+    Replaying a recorded plot in tiles, that are rendered by concurrent
+    threads. As the commands of the graphic are culled by its
+    spatial index each tile is mostly busy with its own part
+    of the image.
+ */
+static void qwtRenderTiled( const QwtGraphic& graphic,
+    int resolution, int tileSize, QImage& image )
+{
+    QVector< QRect > tiles;
+    for ( int y = 0; y < image.height(); y += tileSize )
+    {
+        for ( int x = 0; x < image.width(); x += tileSize )
+            tiles += QRect( x, y, tileSize, tileSize ) & image.rect();
+    }
+
+    int numThreads = 1;
+#if QWT_USE_THREADS
+    numThreads = qMax( QThread::idealThreadCount(), 1 );
+#endif
+
+    // not more tiles than threads in memory at the same time
+
+    for ( int i = 0; i < tiles.size(); i += numThreads )
+    {
+        const int numTiles = qMin( numThreads, int( tiles.size() ) - i );
+
+        QVector< QImage > tileImages( numTiles );
+        for ( int j = 0; j < numTiles; j++ )
+            tileImages[j] = QImage( tiles[i + j].size(), image.format() );
+
+#if QWT_USE_THREADS
+        QVector< QFuture< void > > futures;
+        for ( int j = 0; j < numTiles - 1; j++ )
+        {
+            futures += QtConcurrent::run( qwtRenderTile, &graphic,
+                resolution, &tileImages[j], tiles[i + j].topLeft() );
+        }
+
+        qwtRenderTile( &graphic, resolution,
+            &tileImages[numTiles - 1], tiles[i + numTiles - 1].topLeft() );
+
+        for ( int j = 0; j < futures.size(); j++ )
+            futures[j].waitForFinished();
+#else
+        qwtRenderTile( &graphic, resolution,
+            &tileImages[0], tiles[i].topLeft() );
+#endif
+
+        for ( int j = 0; j < numTiles; j++ )
+        {
+            const QRect& tile = tiles[i + j];
+            const QImage& tileImage = tileImages[j];
+
+            const int bytesPerLine = tile.width() * 4;
+
+            for ( int row = 0; row < tile.height(); row++ )
+            {
+                uchar* line = image.scanLine( tile.top() + row ) + tile.left() * 4;
+                std::memcpy( line, tileImage.constScanLine( row ), bytesPerLine );
+            }
+        }
+    }
+}
+
+static bool qwtHasPixmaps( const QwtGraphic& graphic )
+{
+    if ( !( graphic.commandTypes() & QwtGraphic::RasterData ) )
+        return false;
+
+    const QVector< QwtPainterCommand >& commands = graphic.commands();
+    for ( int i = 0; i < commands.size(); i++ )
+    {
+        if ( commands[i].type() == QwtPainterCommand::Pixmap )
+            return true;
+    }
+
+    return false;
+}
+
+/*
+    Formats, that can be written from a worker thread:
+    QPrinter ( postscript, PDF for Qt < 5.3 ) is not thread-safe
+ */
+static bool qwtIsThreadSafeFormat( const QString& format )
+{
+#if QWT_PDF_WRITER
+    if ( format == QLatin1String( "pdf" ) )
+        return true;
+#endif
+
+#if QWT_FORMAT_SVG
+    if ( format == QLatin1String( "svg" ) )
+        return true;
+#endif
+
+    if ( format == QLatin1String( "pdf" ) || format == QLatin1String( "ps" ) )
+        return false;
+
+    return QImageWriter::supportedImageFormats().indexOf( format.toLatin1() ) >= 0;
+}
+
+static bool qwtWriteDocument( const QwtDocumentJob& job )
+{
+    const double mmToInch = 1.0 / 25.4;
+    const QSizeF size = job.sizeMM * mmToInch * job.resolution;
+
+#if QWT_PDF_WRITER
+    if ( job.format == QLatin1String( "pdf" ) )
+    {
+        QPdfWriter pdfWriter( job.fileName );
+        pdfWriter.setPageSize( QPageSize( job.sizeMM, QPageSize::Millimeter ) );
+        pdfWriter.setTitle( job.title );
+        pdfWriter.setPageMargins( QMarginsF() );
+        pdfWriter.setResolution( job.resolution );
+
+        QPainter painter( &pdfWriter );
+        qwtReplayDocument( &painter, job.graphic, job.resolution );
+
+        return painter.end();
+    }
+#endif
+
+#if QWT_FORMAT_SVG
+    if ( job.format == QLatin1String( "svg" ) )
+    {
+        QSvgGenerator generator;
+        generator.setTitle( job.title );
+        generator.setFileName( job.fileName );
+        generator.setResolution( job.resolution );
+        generator.setViewBox( QRectF( 0.0, 0.0, size.width(), size.height() ) );
+
+        QPainter painter( &generator );
+        qwtReplayDocument( &painter, job.graphic, job.resolution );
+
+        return painter.end();
+    }
+#endif
+
+    const int dotsPerMeter = qRound( job.resolution * mmToInch * 1000.0 );
+
+    QImage image( QRectF( QPointF(), size ).toRect().size(), QImage::Format_ARGB32 );
+    image.setDotsPerMeterX( dotsPerMeter );
+    image.setDotsPerMeterY( dotsPerMeter );
+    image.fill( QColor( Qt::white ).rgb() );
+
+    QPainter painter( &image );
+    qwtReplayDocument( &painter, job.graphic, job.resolution );
+    painter.end();
+
+    return image.save( job.fileName, job.format.toLatin1() );
+}
+
+#if QWT_PDF_WRITER
+
+static void qwtWritePage( QPdfWriter* pdfWriter,
+    QPainter* painter, const QwtGraphic& graphic, int resolution )
+{
+    if ( painter->isActive() )
+        pdfWriter->newPage();
+    else
+        painter->begin( pdfWriter );
+
+    qwtReplayDocument( painter, graphic, resolution );
+}
+
+#endif
+
 static qreal qwtScalePenWidth( const QwtPlot* plot )
 {
     qreal pw = 0.0;
@@ -132,13 +397,40 @@ class QwtPlotRenderer::PrivateData
     PrivateData()
         : discardFlags( QwtPlotRenderer::DiscardNone )
         , layoutFlags( QwtPlotRenderer::DefaultLayout )
+        , exportResolution( 0 )
+        , exportTileSize( 0 )
     {
     }
 
     QwtPlotRenderer::DiscardFlags discardFlags;
     QwtPlotRenderer::LayoutFlags layoutFlags;
+    int exportResolution;
+    int exportTileSize;
 };
 
+namespace
+{
+    // sets the vector resolution of QwtPainter for the lifetime of the object
+    class QwtVectorResolutionScope
+    {
+      public:
+        explicit QwtVectorResolutionScope( int dpi )
+            : m_resolution( QwtPainter::vectorResolution() )
+        {
+            if ( dpi > 0 )
+                QwtPainter::setVectorResolution( dpi );
+        }
+
+        ~QwtVectorResolutionScope()
+        {
+            QwtPainter::setVectorResolution( m_resolution );
+        }
+
+      private:
+        const double m_resolution;
+    };
+}
+
 /*!
    Constructor
    \param parent Parent object
@@ -247,6 +539,69 @@ QwtPlotRenderer::LayoutFlags QwtPlotRenderer::layoutFlags() const
     return m_data->layoutFlags;
 }
 
+/*!
+   \brief Set the resolution for reducing the plot items on vector devices
+
+   When exporting to PDF or SVG the coordinates are not rounded
+   to integers and the plot items can't reduce their points to what
+   is visible on the pixel grid. Then the document size and the time for
+   exporting and opening it depend on the number of samples.
+
+   When an export resolution is set, the points of curves are reduced to
+   a virtual pixel grid of this resolution ( first/min/max/last point
+   of each column ) and long polylines are written in chunks, while
+   the canvas is rendered.
+
+   \param dpi Resolution in dots per inch. A value <= 0 disables
+          the reduction, what is the default setting.
+
+   \sa exportResolution(), QwtPainter::setVectorResolution()
+ */
+void QwtPlotRenderer::setExportResolution( int dpi )
+{
+    m_data->exportResolution = qMax( dpi, 0 );
+}
+
+/*!
+   \return Resolution for reducing the plot items on vector devices
+   \sa setExportResolution()
+ */
+int QwtPlotRenderer::exportResolution() const
+{
+    return m_data->exportResolution;
+}
+
+/*!
+   \brief Set the tile size for exporting huge images
+
+   When exporting to an image format, that is larger than one tile,
+   renderDocument() records the plot once - including the layout and
+   the canvas maps - and replays it in tiles, that are rendered
+   by concurrent threads.
+
+   The plot is recorded like for renderDocuments(): the texts
+   are converted into paths and raster items are recorded with
+   the resolution of the recording device.
+
+   \param size Width/height of the tiles in pixels. A value <= 0 disables
+          tiled exports, what is the default setting.
+
+   \sa exportTileSize(), renderDocument()
+ */
+void QwtPlotRenderer::setExportTileSize( int size )
+{
+    m_data->exportTileSize = qMax( size, 0 );
+}
+
+/*!
+   \return Tile size for exporting huge images
+   \sa setExportTileSize()
+ */
+int QwtPlotRenderer::exportTileSize() const
+{
+    return m_data->exportTileSize;
+}
+
 /*!
    Render a plot to a file
 
@@ -297,9 +652,7 @@ void QwtPlotRenderer::renderDocument( QwtPlot* plot,
     if ( plot == NULL || sizeMM.isEmpty() || resolution <= 0 )
         return;
 
-    QString title = plot->title().text();
-    if ( title.isEmpty() )
-        title = "Plot Document";
+    const QString title = qwtDocumentTitle( plot );
 
     const double mmToInch = 1.0 / 25.4;
     const QSizeF size = sizeMM * mmToInch * resolution;
@@ -375,17 +728,271 @@ void QwtPlotRenderer::renderDocument( QwtPlot* plot,
             QImage image( imageRect.size(), QImage::Format_ARGB32 );
             image.setDotsPerMeterX( dotsPerMeter );
             image.setDotsPerMeterY( dotsPerMeter );
-            image.fill( QColor( Qt::white ).rgb() );
 
-            QPainter painter( &image );
-            render( plot, &painter, imageRect );
-            painter.end();
+            const int tileSize = m_data->exportTileSize;
+
+            if ( tileSize > 0 && ( imageRect.width() > tileSize
+                || imageRect.height() > tileSize ) )
+            {
+                const QwtGraphic graphic = qwtRecordDocument( this, plot, sizeMM );
+                qwtRenderTiled( graphic, resolution, tileSize, image );
+            }
+            else
+            {
+                image.fill( QColor( Qt::white ).rgb() );
+
+                QPainter painter( &image );
+                render( plot, &painter, imageRect );
+                painter.end();
+            }
 
             image.save( fileName, format.toLatin1() );
         }
     }
 }
 
+/*!
+   \brief Render plots into a PDF document - one page for each plot
+
+   The pages are written one by one, so that the memory does not
+   depend on the number of plots. When QPdfWriter is available
+   ( Qt >= 5.3 ) the next plot is recorded on the GUI thread, while
+   the previous page is written in a worker thread.
+
+   \param plots Plots to be rendered
+   \param fileName Path of the PDF file
+   \param sizeMM Size of the pages in millimeters.
+   \param resolution Resolution in dots per Inch (dpi)
+
+   \sa renderDocuments()
+ */
+void QwtPlotRenderer::renderDocument( const QList< QwtPlot* >& plots,
+    const QString& fileName, const QSizeF& sizeMM, int resolution )
+{
+    if ( plots.isEmpty() || plots.first() == NULL
+        || sizeMM.isEmpty() || resolution <= 0 )
+    {
+        return;
+    }
+
+    const QString title = qwtDocumentTitle( plots.first() );
+
+#if QWT_PDF_WRITER
+
+    QPdfWriter pdfWriter( fileName );
+    pdfWriter.setPageSize( QPageSize( sizeMM, QPageSize::Millimeter ) );
+    pdfWriter.setTitle( title );
+    pdfWriter.setPageMargins( QMarginsF() );
+    pdfWriter.setResolution( resolution );
+
+    // only used by the thread writing the pages
+    QPainter painter;
+
+#if QWT_USE_THREADS
+    QFuture< void > future;
+#endif
+
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        QwtPlot* plot = plots[i];
+        if ( plot == NULL )
+            continue;
+
+        const QwtGraphic graphic = qwtRecordDocument( this, plot, sizeMM );
+
+#if QWT_USE_THREADS
+        // recording the next page while the previous one is written
+        future.waitForFinished();
+        future = QtConcurrent::run( qwtWritePage,
+            &pdfWriter, &painter, graphic, resolution );
+#else
+        qwtWritePage( &pdfWriter, &painter, graphic, resolution );
+#endif
+    }
+
+#if QWT_USE_THREADS
+    future.waitForFinished();
+#endif
+
+    painter.end();
+
+#elif QWT_FORMAT_PDF
+
+    const double mmToInch = 1.0 / 25.4;
+    const QSizeF size = sizeMM * mmToInch * resolution;
+
+    QPrinter printer;
+    printer.setOutputFormat( QPrinter::PdfFormat );
+    printer.setColorMode( QPrinter::Color );
+    printer.setFullPage( true );
+    printer.setPaperSize( sizeMM, QPrinter::Millimeter );
+    printer.setDocName( title );
+    printer.setOutputFileName( fileName );
+    printer.setResolution( resolution );
+
+    QPainter painter( &printer );
+
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        if ( plots[i] == NULL )
+            continue;
+
+        if ( i > 0 )
+            printer.newPage();
+
+        render( plots[i], &painter,
+            QRectF( 0.0, 0.0, size.width(), size.height() ) );
+    }
+
+#else
+    Q_UNUSED( fileName )
+    Q_UNUSED( title )
+#endif
+}
+
+/*!
+   \brief Render plots into files
+
+   The format of each document is derived from the suffix of its file name
+   ( see renderDocument() ). All plots are rendered with the same size
+   and resolution.
+
+   As QWidget based plots can only be accessed from the GUI thread,
+   each plot is recorded into a QwtGraphic there first. Replaying the
+   recorded commands into images, PDF or SVG documents and encoding
+   the files is done in parallel by worker threads.
+   Documents, that can't be written from other threads ( QPrinter
+   based formats and plots including QPixmaps ), are rendered
+   on the GUI thread like by renderDocument().
+
+   \param plots Plots to be rendered
+   \param fileNames Paths of the files - one for each plot
+   \param sizeMM Size of the documents in millimeters.
+   \param resolution Resolution in dots per Inch (dpi)
+
+   \note Pens and fonts are scaled from the 72 dpi of the recording
+         to the resolution of the document. Cosmetic pens remain 1 pixel
+         wide like when rendering directly.
+
+   \sa renderDocument()
+ */
+void QwtPlotRenderer::renderDocuments( const QList< QwtPlot* >& plots,
+    const QStringList& fileNames, const QSizeF& sizeMM, int resolution )
+{
+    if ( sizeMM.isEmpty() || resolution <= 0 )
+        return;
+
+    const int numPlots = qMin( plots.size(), fileNames.size() );
+
+#if QWT_USE_THREADS
+    // limiting the number of recorded plots in memory
+    const int maxPending = 2 * qMax( QThread::idealThreadCount(), 1 );
+    QList< QFuture< bool > > futures;
+#endif
+
+    for ( int i = 0; i < numPlots; i++ )
+    {
+        QwtPlot* plot = plots[i];
+        if ( plot == NULL )
+            continue;
+
+        const QString format = QFileInfo( fileNames[i] ).suffix().toLower();
+
+        if ( !qwtIsThreadSafeFormat( format ) )
+        {
+            renderDocument( plot, fileNames[i], format, sizeMM, resolution );
+            continue;
+        }
+
+        QwtDocumentJob job;
+        job.graphic = qwtRecordDocument( this, plot, sizeMM );
+        job.fileName = fileNames[i];
+        job.format = format;
+        job.title = qwtDocumentTitle( plot );
+        job.sizeMM = sizeMM;
+        job.resolution = resolution;
+
+#if QWT_USE_THREADS
+        if ( !qwtHasPixmaps( job.graphic ) )
+        {
+            if ( futures.size() >= maxPending )
+                futures.takeFirst().waitForFinished();
+
+            futures += QtConcurrent::run( qwtWriteDocument, job );
+            continue;
+        }
+#endif
+
+        qwtWriteDocument( job );
+    }
+
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+}
+
+/*!
+   \brief Render a scene to a file
+
+   As a QwtPlotScene doesn't depend on any widget renderDocument()
+   can be called from any thread - f.e. for creating plots on a server.
+   The formats are the same as for renderDocument( QwtPlot*, ... ),
+   beside the ones that are written by QPrinter, what is not thread-safe:
+   postscript and PDF for Qt < 5.3.
+
+   \param scene Scene to be rendered
+   \param fileName Path of the file, where the document will be stored.
+                   The format is guessed from the suffix.
+   \param sizeMM Size for the document in millimeters.
+   \param resolution Resolution in dots per Inch (dpi)
+
+   \return true, when the document has been written successfully
+   \note The discard and layout flags are not applied to scenes.
+   \sa renderScene(), QwtPlotScene::render()
+ */
+bool QwtPlotRenderer::renderDocument( const QwtPlotScene* scene,
+    const QString& fileName, const QSizeF& sizeMM, int resolution ) const
+{
+    if ( scene == NULL || sizeMM.isEmpty() || resolution <= 0 )
+        return false;
+
+    const QString format = QFileInfo( fileName ).suffix().toLower();
+    if ( !qwtIsThreadSafeFormat( format ) )
+        return false;
+
+    QString title = scene->title().text();
+    if ( title.isEmpty() )
+        title = "Plot Document";
+
+    QwtDocumentJob job;
+    job.graphic = qwtRecordDocument( scene, sizeMM );
+    job.fileName = fileName;
+    job.format = format;
+    job.title = title;
+    job.sizeMM = sizeMM;
+    job.resolution = resolution;
+
+    return qwtWriteDocument( job );
+}
+
+/*!
+   \brief Render a scene into a given rectangle
+
+   \param scene Scene to be rendered
+   \param painter Painter
+   \param sceneRect Bounding rectangle
+
+   \note The discard and layout flags are not applied to scenes.
+   \sa QwtPlotScene::render(), renderDocument()
+ */
+void QwtPlotRenderer::renderScene( const QwtPlotScene* scene,
+    QPainter* painter, const QRectF& sceneRect ) const
+{
+    if ( scene && painter )
+        scene->render( painter, sceneRect );
+}
+
 /*!
    \brief Render the plot to a \c QPaintDevice
 
@@ -834,6 +1441,8 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot* plot,
 {
     const QWidget* canvas = plot->canvas();
 
+    const QwtVectorResolutionScope resolutionScope( m_data->exportResolution );
+
     QRectF r = canvasRect.adjusted( 0.0, 0.0, -1.0, -1.0 );
 
     if ( m_data->layoutFlags & FrameWithScales )
@@ -15,8 +15,11 @@
 
 #include <qobject.h>
 #include <qsize.h>
+#include <qlist.h>
+#include <qstringlist.h>
 
 class QwtPlot;
+class QwtPlotScene;
 class QwtScaleMap;
 class QRectF;
 class QPainter;
@@ -35,6 +38,13 @@ class QSvgGenerator;
 /*!
     \brief Renderer for exporting a plot to a document, a printer
            or anything else, that is supported by QPainter/QPaintDevice
+
+    Rendering a QwtPlot has to be done in the GUI thread, as the plot
+    is a widget and its layout is temporarily modified. renderScene()
+    and the renderDocument() variants for scenes are reentrant:
+    different scenes can be rendered in different threads at the same
+    time, as the state shared by QwtPainter and the text engines
+    is thread-safe.
  */
 class QWT_EXPORT QwtPlotRenderer : public QObject
 {
@@ -108,6 +118,12 @@ class QWT_EXPORT QwtPlotRenderer : public QObject
     void setLayoutFlags( LayoutFlags flags );
     LayoutFlags layoutFlags() const;
 
+    void setExportResolution( int dpi );
+    int exportResolution() const;
+
+    void setExportTileSize( int size );
+    int exportTileSize() const;
+
     void renderDocument( QwtPlot*, const QString& fileName,
         const QSizeF& sizeMM, int resolution = 85 );
 
@@ -115,6 +131,19 @@ class QWT_EXPORT QwtPlotRenderer : public QObject
         const QString& fileName, const QString& format,
         const QSizeF& sizeMM, int resolution = 85 );
 
+    void renderDocument( const QList< QwtPlot* >&,
+        const QString& fileName, const QSizeF& sizeMM, int resolution = 85 );
+
+    void renderDocuments( const QList< QwtPlot* >&,
+        const QStringList& fileNames, const QSizeF& sizeMM,
+        int resolution = 85 );
+
+    bool renderDocument( const QwtPlotScene*, const QString& fileName,
+        const QSizeF& sizeMM, int resolution = 85 ) const;
+
+    void renderScene( const QwtPlotScene*,
+        QPainter*, const QRectF& sceneRect ) const;
+
 #ifndef QWT_NO_SVG
 #ifdef QT_SVG_LIB
     void renderTo( QwtPlot*, QSvgGenerator& ) const;
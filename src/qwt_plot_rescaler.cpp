@@ -38,6 +38,11 @@ class QwtPlotRescaler::PrivateData
         , rescalePolicy( QwtPlotRescaler::Expanding )
         , isEnabled( false )
         , inReplot( 0 )
+        , resizeInterval( 0 )
+        , resizeTimerId( 0 )
+        , idleTicks( 0 )
+        , hasPendingResize( false )
+        , isInteractive( false )
     {
     }
 
@@ -55,6 +60,14 @@ class QwtPlotRescaler::PrivateData
 
     mutable int inReplot;
 
+    // coalescing resize events
+    int resizeInterval;
+    int resizeTimerId;
+    int idleTicks;
+    bool hasPendingResize;
+    bool isInteractive;
+    QSize pendingOldSize;
+
   private:
     QwtPlotRescaler::AxisData m_axisData[QwtAxis::AxisPositions];
 };
@@ -108,6 +121,9 @@ void QwtPlotRescaler::setEnabled( bool on )
             else
                 w->removeEventFilter( this );
         }
+
+        if ( !m_data->isEnabled )
+            finishResize();
     }
 }
 
@@ -278,6 +294,38 @@ QwtInterval QwtPlotRescaler::intervalHint( QwtAxisId axisId ) const
     return QwtInterval();
 }
 
+/*!
+   \brief Set the interval for coalescing resize events
+
+   When the interval is > 0, the first resize event of the canvas
+   starts a timer and all resize events until it expires are
+   accumulated to one rescale() and replot. While resizing, a
+   QwtPlotCanvas is switched into interactive mode, so that
+   it is rendered with the interactivePixelRatio() as preview.
+   When no resize event has been received for a couple of intervals
+   the interactive mode is left, what replots the canvas in full
+   resolution.
+
+   The default setting is 0, where each resize event is
+   rescaled immediately.
+
+   \param msec Interval in milliseconds
+   \sa resizeCoalescingInterval(), QwtPlotCanvas::setInteractive()
+ */
+void QwtPlotRescaler::setResizeCoalescingInterval( int msec )
+{
+    m_data->resizeInterval = qMax( msec, 0 );
+}
+
+/*!
+   \return Interval for coalescing resize events
+   \sa setResizeCoalescingInterval()
+ */
+int QwtPlotRescaler::resizeCoalescingInterval() const
+{
+    return m_data->resizeInterval;
+}
+
 //! \return plot canvas
 QWidget* QwtPlotRescaler::canvas()
 {
@@ -348,7 +396,84 @@ void QwtPlotRescaler::canvasResizeEvent( QResizeEvent* event )
     const QSize newSize = event->size() - marginSize;
     const QSize oldSize = event->oldSize() - marginSize;
 
-    rescale( oldSize, newSize );
+    if ( m_data->resizeInterval <= 0 )
+    {
+        rescale( oldSize, newSize );
+        return;
+    }
+
+    if ( !m_data->hasPendingResize )
+    {
+        m_data->hasPendingResize = true;
+        m_data->pendingOldSize = oldSize;
+    }
+
+    m_data->idleTicks = 0;
+
+    if ( m_data->resizeTimerId == 0 )
+    {
+        QwtPlotCanvas* canvas = qobject_cast< QwtPlotCanvas* >( this->canvas() );
+        if ( canvas && !canvas->isInteractive() )
+        {
+            canvas->setInteractive( true );
+            m_data->isInteractive = true;
+        }
+
+        m_data->resizeTimerId = startTimer( m_data->resizeInterval );
+    }
+}
+
+/*!
+   Rescale the accumulated resize events
+
+   \param event Timer event
+   \sa setResizeCoalescingInterval()
+ */
+void QwtPlotRescaler::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() != m_data->resizeTimerId )
+    {
+        QObject::timerEvent( event );
+        return;
+    }
+
+    if ( m_data->hasPendingResize )
+    {
+        m_data->hasPendingResize = false;
+        rescale( m_data->pendingOldSize, canvas()->contentsRect().size() );
+    }
+    else if ( ++m_data->idleTicks >= 3 )
+    {
+        // resizing has been finished
+        finishResize();
+    }
+}
+
+void QwtPlotRescaler::finishResize()
+{
+    if ( m_data->resizeTimerId != 0 )
+    {
+        killTimer( m_data->resizeTimerId );
+        m_data->resizeTimerId = 0;
+    }
+
+    if ( m_data->hasPendingResize )
+    {
+        m_data->hasPendingResize = false;
+
+        if ( canvas() )
+            rescale( m_data->pendingOldSize, canvas()->contentsRect().size() );
+    }
+
+    m_data->idleTicks = 0;
+
+    if ( m_data->isInteractive )
+    {
+        m_data->isInteractive = false;
+
+        if ( QwtPlotCanvas* canvas = qobject_cast< QwtPlotCanvas* >( this->canvas() ) )
+            canvas->setInteractive( false );
+    }
 }
 
 //! Adjust the plot axes scales
@@ -18,12 +18,22 @@
 class QwtPlot;
 class QwtInterval;
 class QResizeEvent;
+class QTimerEvent;
 
 /*!
     \brief QwtPlotRescaler takes care of fixed aspect ratios for plot scales
 
     QwtPlotRescaler auto adjusts the axes of a QwtPlot according
     to fixed aspect ratios.
+
+    Dragging the border of a window generates many resize events
+    and rescaling each of them results in a replot. With a resize
+    coalescing interval the canvas is rescaled once per interval
+    only - in the reduced resolution of
+    QwtPlotCanvas::setInteractivePixelRatio() - and replotted in
+    full resolution, when resizing has been finished.
+
+    \sa setResizeCoalescingInterval()
  */
 
 class QWT_EXPORT QwtPlotRescaler : public QObject
@@ -105,6 +115,9 @@ class QWT_EXPORT QwtPlotRescaler : public QObject
     void setIntervalHint( QwtAxisId, const QwtInterval& );
     QwtInterval intervalHint( QwtAxisId ) const;
 
+    void setResizeCoalescingInterval( int msec );
+    int resizeCoalescingInterval() const;
+
     QWidget* canvas();
     const QWidget* canvas() const;
 
@@ -117,6 +130,7 @@ class QWT_EXPORT QwtPlotRescaler : public QObject
 
   protected:
     virtual void canvasResizeEvent( QResizeEvent* );
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
 
     virtual void rescale( const QSize& oldSize, const QSize& newSize ) const;
     virtual QwtInterval expandScale(
@@ -135,6 +149,7 @@ class QWT_EXPORT QwtPlotRescaler : public QObject
 
   private:
     double pixelDist( QwtAxisId, const QSize& ) const;
+    void finishResize();
 
     class AxisData;
     class PrivateData;
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_rhi_canvas.h"
+#include "qwt_plot.h"
+
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qimage.h>
+#include <qcoreevent.h>
+#include <rhi/qrhi.h>
+
+class QwtPlotRhiCanvas::PrivateData
+{
+  public:
+    PrivateData()
+        : isPolished( false )
+        , imageDirty( true )
+        , uploadPending( true )
+    {
+    }
+
+    bool isPolished;
+
+    // the image needs to be rendered again
+    bool imageDirty;
+
+    // the color buffer has not yet received the image
+    bool uploadPending;
+
+    // part of the image to be uploaded, invalid for all of it
+    QRect uploadRect;
+
+    QImage image;
+};
+
+/*!
+   \brief Constructor
+
+   \param plot Parent plot widget
+   \sa QwtPlot::setCanvas()
+ */
+QwtPlotRhiCanvas::QwtPlotRhiCanvas( QwtPlot* plot )
+    : QRhiWidget( plot )
+    , QwtPlotAbstractGLCanvas( this )
+{
+    m_data = new PrivateData;
+
+    setAttribute( Qt::WA_OpaquePaintEvent, true );
+
+    setLineWidth( 2 );
+    setFrameShadow( QFrame::Sunken );
+    setFrameShape( QFrame::Panel );
+}
+
+//! Destructor
+QwtPlotRhiCanvas::~QwtPlotRhiCanvas()
+{
+    delete m_data;
+}
+
+/*!
+   Qt event handler for QEvent::PolishRequest and QEvent::StyleChange
+   \param event Qt Event
+   \return See QRhiWidget::event()
+ */
+bool QwtPlotRhiCanvas::event( QEvent* event )
+{
+    const bool ok = QRhiWidget::event( event );
+
+    if ( event->type() == QEvent::PolishRequest )
+    {
+        // like QOpenGLWidget we receive pointless early repaints,
+        // before the widget has been polished
+
+        m_data->isPolished = true;
+    }
+
+    if ( event->type() == QEvent::PolishRequest ||
+        event->type() == QEvent::StyleChange )
+    {
+        // assuming, that we always have a styled background
+        // when we have a style sheet
+
+        setAttribute( Qt::WA_StyledBackground,
+            testAttribute( Qt::WA_StyleSheet ) );
+    }
+
+    return ok;
+}
+
+/*!
+   Invalidate the paint cache and repaint the canvas
+   \sa invalidateBackingStore()
+ */
+void QwtPlotRhiCanvas::replot()
+{
+    QwtPlotAbstractGLCanvas::replot();
+}
+
+//! Invalidate the internal backing store
+void QwtPlotRhiCanvas::invalidateBackingStore()
+{
+    m_data->imageDirty = true;
+}
+
+void QwtPlotRhiCanvas::clearBackingStore()
+{
+    m_data->image = QImage();
+    m_data->imageDirty = true;
+}
+
+/*!
+   \brief Open a painter on the image of the backing store
+
+   \param painter Painter to be opened on the backing store
+   \return false, when the backing store is disabled or needs to
+           be rendered anyway
+
+   \sa endIncrementalPaint(), QwtPlotDirectPainter::drawSeries()
+ */
+bool QwtPlotRhiCanvas::beginIncrementalPaint( QPainter* painter )
+{
+    if ( !testPaintAttribute( QwtPlotAbstractGLCanvas::BackingStore )
+        || m_data->imageDirty || m_data->image.isNull() )
+    {
+        return false;
+    }
+
+    return painter->begin( &m_data->image );
+}
+
+/*!
+   \brief Close a painter opened by beginIncrementalPaint()
+
+   Only the modified part of the image is uploaded with the next render().
+
+   \param painter Painter opened by beginIncrementalPaint()
+   \param rect Part of the canvas, that has been modified
+
+   \sa beginIncrementalPaint()
+ */
+void QwtPlotRhiCanvas::endIncrementalPaint( QPainter* painter, const QRect& rect )
+{
+    painter->end();
+
+    const qreal ratio = m_data->image.devicePixelRatio();
+
+    const QRect pixelRect = QRectF( rect.x() * ratio, rect.y() * ratio,
+        rect.width() * ratio, rect.height() * ratio ).toAlignedRect()
+        & m_data->image.rect();
+
+    if ( !m_data->uploadPending )
+    {
+        m_data->uploadRect = pixelRect;
+        m_data->uploadPending = true;
+    }
+    else if ( m_data->uploadRect.isValid() )
+    {
+        m_data->uploadRect |= pixelRect;
+    }
+
+    update();
+}
+
+/*!
+   Calculate the painter path for a styled or rounded border
+
+   When the canvas has no styled background or rounded borders
+   the painter path is empty.
+
+   \param rect Bounding rectangle of the canvas
+   \return Painter path, that can be used for clipping
+ */
+QPainterPath QwtPlotRhiCanvas::borderPath( const QRect& rect ) const
+{
+    return canvasBorderPath( rect );
+}
+
+/*!
+   Called, when the color buffer has been ( re- )created
+
+   As the content of a new color buffer is undefined the image
+   has to be uploaded again.
+
+   \param cb Command buffer
+ */
+void QwtPlotRhiCanvas::initialize( QRhiCommandBuffer* cb )
+{
+    Q_UNUSED( cb )
+
+    m_data->uploadPending = true;
+    m_data->uploadRect = QRect();
+}
+
+/*!
+   Render the plot into an image and upload it into the color buffer
+
+   \param cb Command buffer
+ */
+void QwtPlotRhiCanvas::render( QRhiCommandBuffer* cb )
+{
+    QRhiTexture* texture = colorTexture();
+    if ( texture == NULL || !m_data->isPolished )
+        return;
+
+    const QSize pixelSize = texture->pixelSize();
+    const bool hasFocusIndicator =
+        hasFocus() && focusIndicator() == CanvasFocusIndicator;
+
+    /*
+        The focus indicator is part of the image, so we can't
+        reuse an image, that has been rendered without it.
+     */
+    if ( !testPaintAttribute( QwtPlotAbstractGLCanvas::BackingStore )
+        || hasFocusIndicator || m_data->image.size() != pixelSize )
+    {
+        m_data->imageDirty = true;
+    }
+
+    if ( m_data->imageDirty )
+    {
+        if ( m_data->image.size() != pixelSize )
+        {
+            m_data->image = QImage( pixelSize,
+                QImage::Format_RGBA8888_Premultiplied );
+        }
+
+        m_data->image.setDevicePixelRatio(
+            qreal( pixelSize.width() ) / qMax( width(), 1 ) );
+        m_data->image.fill( Qt::transparent );
+
+        QPainter painter( &m_data->image );
+        draw( &painter );
+
+        if ( hasFocusIndicator )
+            drawFocusIndicator( &painter );
+
+        painter.end();
+
+        m_data->imageDirty = false;
+        m_data->uploadPending = true;
+        m_data->uploadRect = QRect();
+    }
+
+    if ( m_data->uploadPending )
+    {
+        QRhiResourceUpdateBatch* updates = rhi()->nextResourceUpdateBatch();
+
+        const QRect& rect = m_data->uploadRect;
+        if ( rect.isValid() )
+        {
+            // samples painted by QwtPlotDirectPainter
+
+            QRhiTextureSubresourceUploadDescription description( m_data->image );
+            description.setSourceTopLeft( rect.topLeft() );
+            description.setSourceSize( rect.size() );
+            description.setDestinationTopLeft( rect.topLeft() );
+
+            updates->uploadTexture( texture, QRhiTextureUploadDescription(
+                QRhiTextureUploadEntry( 0, 0, description ) ) );
+        }
+        else
+        {
+            updates->uploadTexture( texture, m_data->image );
+        }
+
+        cb->resourceUpdate( updates );
+
+        m_data->uploadPending = false;
+        m_data->uploadRect = QRect();
+    }
+}
+
+//! Release the image, when the graphics resources are released
+void QwtPlotRhiCanvas::releaseResources()
+{
+    clearBackingStore();
+
+    m_data->uploadPending = true;
+    m_data->uploadRect = QRect();
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_plot_rhi_canvas.cpp"
+#endif
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_RHI_CANVAS_H
+#define QWT_PLOT_RHI_CANVAS_H
+
+#include "qwt_global.h"
+#include "qwt_plot_abstract_canvas.h"
+
+#include <qrhiwidget.h>
+
+class QwtPlot;
+
+/*!
+   \brief An alternative canvas for a QwtPlot derived from QRhiWidget
+
+   QwtPlotRhiCanvas is composed by the Qt Rendering Hardware Interface,
+   that uses the native graphics API of the platform - Vulkan, Metal,
+   Direct3D or OpenGL ( see QRhiWidget::setApi() ). This avoids
+   depending on the quality of the OpenGL drivers on Windows and macOS.
+
+   The plot is rendered by QPainter into an image, that is uploaded
+   into the color buffer of the widget. With the BackingStore attribute
+   the image is reused, when the canvas needs to be updated without
+   a replot. Together with QwtPlot::setParallelItemRendering() the
+   items are rendered on all cores.
+
+   Like QwtPlotOpenGLCanvas it imitates the API of QFrame and supports
+   style sheets.
+
+   \sa QwtPlot::setCanvas(), QwtPlotOpenGLCanvas, QwtPlotCanvas
+
+   \note QwtPlotRhiCanvas is available for Qt >= 6.7 only.
+   \note Multisampling of the widget ( QRhiWidget::setSampleCount() )
+         is not supported. Antialiasing is done by QPainter.
+ */
+class QWT_EXPORT QwtPlotRhiCanvas : public QRhiWidget, public QwtPlotAbstractGLCanvas
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QFrame::Shadow frameShadow READ frameShadow WRITE setFrameShadow )
+    Q_PROPERTY( QFrame::Shape frameShape READ frameShape WRITE setFrameShape )
+    Q_PROPERTY( int lineWidth READ lineWidth WRITE setLineWidth )
+    Q_PROPERTY( int midLineWidth READ midLineWidth WRITE setMidLineWidth )
+    Q_PROPERTY( int frameWidth READ frameWidth )
+    Q_PROPERTY( QRect frameRect READ frameRect DESIGNABLE false )
+
+    Q_PROPERTY( double borderRadius READ borderRadius WRITE setBorderRadius )
+
+  public:
+    explicit QwtPlotRhiCanvas( QwtPlot* = NULL );
+    virtual ~QwtPlotRhiCanvas();
+
+    Q_INVOKABLE virtual void invalidateBackingStore() QWT_OVERRIDE;
+    Q_INVOKABLE QPainterPath borderPath( const QRect& ) const;
+
+    virtual bool beginIncrementalPaint( QPainter* ) QWT_OVERRIDE;
+    virtual void endIncrementalPaint( QPainter*, const QRect& ) QWT_OVERRIDE;
+
+    virtual bool event( QEvent* ) QWT_OVERRIDE;
+
+  public Q_SLOTS:
+    void replot();
+
+  protected:
+    virtual void initialize( QRhiCommandBuffer* ) QWT_OVERRIDE;
+    virtual void render( QRhiCommandBuffer* ) QWT_OVERRIDE;
+    virtual void releaseResources() QWT_OVERRIDE;
+
+  private:
+    virtual void clearBackingStore() QWT_OVERRIDE;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
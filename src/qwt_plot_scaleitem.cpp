@@ -12,9 +12,69 @@
 #include "qwt_scale_map.h"
 #include "qwt_interval.h"
 #include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt_painter.h"
+#include "qwt_cache_registry.h"
 
 #include <qpalette.h>
 #include <qpainter.h>
+#include <qpaintengine.h>
+#include <qpixmap.h>
+
+#include <typeinfo>
+
+static bool qwtIsCacheable( const QPainter* painter )
+{
+    // when the paint device is aligning it is not one
+    // where scalability matters ( PDF, SVG )
+
+    if ( !QwtPainter::roundingAlignment( painter ) )
+        return false;
+
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Picture:
+        case QPaintEngine::User: // usually QwtGraphic
+        {
+            // don't use a cache for record/replay devices
+            return false;
+        }
+        default:;
+    }
+
+    return true;
+}
+
+namespace
+{
+    // everything, that has an effect on the pixmap
+    class ScaleKey
+    {
+      public:
+        ScaleKey()
+            : length( 0.0 )
+            , transformType( NULL )
+        {
+        }
+
+        bool operator==( const ScaleKey& other ) const
+        {
+            return offset == other.offset && length == other.length
+                && transformType == other.transformType
+                && scaleDiv == other.scaleDiv && pen == other.pen;
+        }
+
+        // position inside of the pixel, the pixmap is moved
+        // by full pixels without rendering it again
+        QPointF offset;
+
+        double length;
+        const std::type_info* transformType;
+
+        QwtScaleDiv scaleDiv;
+        QPen pen;
+    };
+}
 
 class QwtPlotScaleItem::PrivateData
 {
@@ -24,6 +84,7 @@ class QwtPlotScaleItem::PrivateData
         , borderDistance( -1 )
         , scaleDivFromAxis( true )
         , scaleDraw( new QwtScaleDraw() )
+        , cacheEntry( this )
     {
     }
 
@@ -41,6 +102,31 @@ class QwtPlotScaleItem::PrivateData
     int borderDistance;
     bool scaleDivFromAxis;
     QwtScaleDraw* scaleDraw;
+
+    ScaleKey cacheKey;
+    QRect cacheRect; // relative to the integral part of the position
+    QPixmap pixmap;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::PixmapCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->pixmap = QPixmap();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 QwtInterval QwtPlotScaleItem::PrivateData::scaleInterval( const QRectF& canvasRect,
@@ -425,9 +511,118 @@ void QwtPlotScaleItem::draw( QPainter* painter,
         sd->setTransformation( transform );
     }
 
-    painter->setFont( m_data->font );
+    if ( !qwtIsCacheable( painter ) )
+    {
+        painter->setFont( m_data->font );
+        sd->draw( painter, m_data->palette );
+
+        return;
+    }
+
+    // the ticks and labels are rendered once into a pixmap
 
-    sd->draw( painter, m_data->palette );
+    const QPointF pos = sd->pos();
+    const QPoint anchor( qwtFloor( pos.x() ), qwtFloor( pos.y() ) );
+
+    ScaleKey key;
+    key.offset = pos - anchor;
+    key.length = sd->length();
+    key.scaleDiv = sd->scaleDiv();
+    key.pen = painter->pen();
+
+    if ( const QwtTransform* transform = sd->scaleMap().transformation() )
+        key.transformType = &typeid( *transform );
+
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+#else
+    const qreal pixelRatio = 1.0;
+#endif
+
+    if ( m_data->pixmap.isNull() || !( key == m_data->cacheKey )
+        || QwtPainter::devicePixelRatio( &m_data->pixmap ) != pixelRatio )
+    {
+        const int extent = qwtCeil( sd->extent( m_data->font ) );
+
+        int start, end;
+        sd->getBorderDistHint( m_data->font, start, end );
+
+        const int dist = qMax( start, end );
+        const int margin = 2 + qwtCeil( key.pen.widthF() );
+        const int length = qwtCeil( key.offset.x() + key.offset.y() + key.length );
+
+        QRect rect;
+        switch ( sd->alignment() )
+        {
+            case QwtScaleDraw::BottomScale:
+                rect.setRect( -dist, 0, length + 2 * dist, extent );
+                break;
+
+            case QwtScaleDraw::TopScale:
+                rect.setRect( -dist, -extent, length + 2 * dist, extent );
+                break;
+
+            case QwtScaleDraw::LeftScale:
+                rect.setRect( -extent, -dist, extent, length + 2 * dist );
+                break;
+
+            case QwtScaleDraw::RightScale:
+                rect.setRect( 0, -dist, extent, length + 2 * dist );
+                break;
+        }
+
+        m_data->cacheRect = rect.adjusted( -margin, -margin, margin, margin );
+
+        m_data->pixmap = QPixmap( m_data->cacheRect.size() * pixelRatio );
+#if QT_VERSION >= 0x050000
+        m_data->pixmap.setDevicePixelRatio( pixelRatio );
+#endif
+        m_data->pixmap.fill( Qt::transparent );
+
+        QPainter pmPainter( &m_data->pixmap );
+        pmPainter.setRenderHints( painter->renderHints() );
+        pmPainter.setPen( key.pen );
+        pmPainter.setFont( m_data->font );
+        pmPainter.translate( anchor - m_data->cacheRect.topLeft() );
+
+        sd->draw( &pmPainter, m_data->palette );
+
+        pmPainter.end();
+
+        // the pixmap is independent of the anchor
+        m_data->cacheKey = key;
+
+        m_data->cacheEntry.setMemoryUsage(
+            QwtCacheEntry::pixmapSize( m_data->pixmap ) );
+    }
+    else
+    {
+        m_data->cacheEntry.touch();
+    }
+
+    painter->drawPixmap( m_data->cacheRect.topLeft() + anchor, m_data->pixmap );
+}
+
+/*!
+   Invalidate the pixmap, that caches the rendered scale
+
+   \sa itemChanged()
+ */
+void QwtPlotScaleItem::invalidateCache()
+{
+    m_data->pixmap = QPixmap();
+    m_data->cacheEntry.setMemoryUsage( 0 );
+}
+
+/*!
+   Invalidate the cached scale and update the plot
+
+   \sa invalidateCache(), QwtPlotItem::itemChanged()
+ */
+void QwtPlotScaleItem::itemChanged()
+{
+    invalidateCache();
+    QwtPlotItem::itemChanged();
 }
 
 /*!
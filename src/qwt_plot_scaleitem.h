@@ -41,6 +41,11 @@ class QPalette;
 
       plot->setAxisVisible( QwtAxis::YLeft, false );
     \endcode
+
+   On raster paint devices the scale is rendered into a pixmap, that is
+   reused as long as the scale division, the length of the scale and the
+   attributes of the item don't change. When modifying the scale draw
+   by scaleDraw() invalidateCache() has to be called.
  */
 
 class QWT_EXPORT QwtPlotScaleItem : public QwtPlotItem
@@ -86,6 +91,9 @@ class QWT_EXPORT QwtPlotScaleItem : public QwtPlotItem
     virtual void updateScaleDiv(
         const QwtScaleDiv&, const QwtScaleDiv& ) QWT_OVERRIDE;
 
+    void invalidateCache();
+    virtual void itemChanged() QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
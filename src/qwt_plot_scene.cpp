@@ -0,0 +1,1130 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_scene.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_div.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt_scratch_pool.h"
+
+#include <qpainter.h>
+#include <qpalette.h>
+#include <qbrush.h>
+#include <qfont.h>
+
+#include <algorithm>
+
+namespace
+{
+    class LessZThan
+    {
+      public:
+        inline bool operator()( const QwtPlotItem* item1,
+            const QwtPlotItem* item2 ) const
+        {
+            return item1->z() < item2->z();
+        }
+    };
+
+    class AxisData
+    {
+      public:
+        AxisData()
+            : isVisible( false )
+            , doAutoScale( true )
+            , minValue( 0.0 )
+            , maxValue( 1000.0 )
+            , stepSize( 0.0 )
+            , maxMajor( 8 )
+            , maxMinor( 5 )
+            , isValid( false )
+            , scaleEngine( new QwtLinearScaleEngine() )
+            , scaleDraw( new QwtScaleDraw() )
+        {
+        }
+
+        ~AxisData()
+        {
+            delete scaleEngine;
+            delete scaleDraw;
+        }
+
+        // the scale draw needs to know about the current scale
+        void syncScaleDraw()
+        {
+            scaleDraw->setTransformation( scaleEngine->transformation() );
+            scaleDraw->setScaleDiv( scaleDiv );
+        }
+
+        bool isVisible;
+        bool doAutoScale;
+
+        double minValue;
+        double maxValue;
+        double stepSize;
+
+        int maxMajor;
+        int maxMinor;
+
+        bool isValid;
+
+        QwtScaleDiv scaleDiv;
+        QwtScaleEngine* scaleEngine;
+        QwtScaleDraw* scaleDraw;
+
+        QwtText title;
+    };
+}
+
+static inline QwtScaleDraw::Alignment qwtScaleAlignment( QwtAxisId axisId )
+{
+    switch ( axisId )
+    {
+        case QwtAxis::YLeft:
+            return QwtScaleDraw::LeftScale;
+
+        case QwtAxis::YRight:
+            return QwtScaleDraw::RightScale;
+
+        case QwtAxis::XTop:
+            return QwtScaleDraw::TopScale;
+
+        case QwtAxis::XBottom:
+        default:
+            return QwtScaleDraw::BottomScale;
+    }
+}
+
+class QwtPlotScene::Layout
+{
+  public:
+    QRectF titleRect;
+    QRectF canvasRect;
+    QRectF scaleRects[ QwtAxis::AxisPositions ];
+};
+
+class QwtPlotScene::PrivateData
+{
+  public:
+    PrivateData()
+        : autoDelete( true )
+        , canvasBackground( Qt::white )
+        , margin( 5 )
+        , spacing( 2 )
+    {
+    }
+
+    inline AxisData& axisData( QwtAxisId axisId )
+    {
+        return axes[ axisId ];
+    }
+
+    inline const AxisData& axisData( QwtAxisId axisId ) const
+    {
+        return axes[ axisId ];
+    }
+
+    QwtPlotItemList items;
+    bool autoDelete;
+
+    QwtText title;
+    QFont font;
+    QPalette palette;
+
+    QBrush background;
+    QBrush canvasBackground;
+
+    int margin;
+    int spacing;
+
+    AxisData axes[ QwtAxis::AxisPositions ];
+};
+
+/*!
+   \brief Constructor
+
+   Like in QwtPlot the axes QwtAxis::YLeft and QwtAxis::XBottom are
+   visible and autoscaling is enabled for all axes.
+ */
+QwtPlotScene::QwtPlotScene()
+{
+    m_data = new PrivateData;
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        AxisData& d = m_data->axisData( axisPos );
+        d.scaleDraw->setAlignment( qwtScaleAlignment( axisPos ) );
+    }
+
+    m_data->axisData( QwtAxis::YLeft ).isVisible = true;
+    m_data->axisData( QwtAxis::XBottom ).isVisible = true;
+
+    updateAxes();
+}
+
+/*!
+   \brief Destructor
+
+   If autoDelete() is on, all attached items will be deleted
+   \sa setAutoDelete()
+ */
+QwtPlotScene::~QwtPlotScene()
+{
+    detachItems( m_data->autoDelete );
+    delete m_data;
+}
+
+/*!
+   En/Disable Auto deletion
+
+   If Auto deletion is on all attached plot items will be deleted
+   in the destructor of QwtPlotScene. The default value is on.
+
+   \sa autoDelete(), attachItem()
+ */
+void QwtPlotScene::setAutoDelete( bool autoDelete )
+{
+    m_data->autoDelete = autoDelete;
+}
+
+/*!
+   \return true if auto deletion is enabled
+   \sa setAutoDelete(), attachItem()
+ */
+bool QwtPlotScene::autoDelete() const
+{
+    return m_data->autoDelete;
+}
+
+/*!
+   \brief Insert an item
+
+   The items are organized in increasing z order. When the z value
+   of an item is modified later it has to be detached and attached again.
+
+   \param item Plot item
+   \warning When an item is deleted it has to be detached before
+   \sa detachItem()
+ */
+void QwtPlotScene::attachItem( QwtPlotItem* item )
+{
+    if ( item == NULL || m_data->items.contains( item ) )
+        return;
+
+    QwtPlotItemList& items = m_data->items;
+
+    QwtPlotItemList::iterator it =
+        std::upper_bound( items.begin(), items.end(), item, LessZThan() );
+    items.insert( it, item );
+}
+
+/*!
+   \brief Remove an item
+
+   \param item Plot item
+   \sa attachItem()
+ */
+void QwtPlotScene::detachItem( QwtPlotItem* item )
+{
+    m_data->items.removeAll( item );
+}
+
+/*!
+   \brief Remove all items
+
+   \param autoDelete If true, delete all items
+   \sa attachItem()
+ */
+void QwtPlotScene::detachItems( bool autoDelete )
+{
+    const QwtPlotItemList items = m_data->items;
+    m_data->items.clear();
+
+    if ( autoDelete )
+    {
+        for ( int i = 0; i < items.size(); i++ )
+            delete items[i];
+    }
+}
+
+/*!
+   \return List of all attached items in increasing z order
+   \sa attachItem()
+ */
+const QwtPlotItemList& QwtPlotScene::itemList() const
+{
+    return m_data->items;
+}
+
+/*!
+   Change the title of the scene
+   \param title New title
+ */
+void QwtPlotScene::setTitle( const QString& title )
+{
+    setTitle( QwtText( title ) );
+}
+
+/*!
+   Change the title of the scene
+   \param title New title
+ */
+void QwtPlotScene::setTitle( const QwtText& title )
+{
+    m_data->title = title;
+}
+
+//! \return Title of the scene
+QwtText QwtPlotScene::title() const
+{
+    return m_data->title;
+}
+
+/*!
+   \brief Set the font
+
+   The font is used for the scale labels and all texts,
+   that have no individual font.
+
+   \param font Font
+   \sa font()
+ */
+void QwtPlotScene::setFont( const QFont& font )
+{
+    m_data->font = font;
+}
+
+//! \return Font for the scales and the titles
+QFont QwtPlotScene::font() const
+{
+    return m_data->font;
+}
+
+/*!
+   \brief Set the palette
+
+   The palette is used for drawing the scales and the titles.
+
+   \param palette Palette
+   \sa palette(), QwtAbstractScaleDraw::draw()
+ */
+void QwtPlotScene::setPalette( const QPalette& palette )
+{
+    m_data->palette = palette;
+}
+
+//! \return Palette for the scales and the titles
+QPalette QwtPlotScene::palette() const
+{
+    return m_data->palette;
+}
+
+/*!
+   \brief Set the background of the scene
+
+   The default setting is Qt::NoBrush.
+
+   \param brush Background brush
+   \sa background(), setCanvasBackground()
+ */
+void QwtPlotScene::setBackground( const QBrush& brush )
+{
+    m_data->background = brush;
+}
+
+//! \return Background brush of the scene
+QBrush QwtPlotScene::background() const
+{
+    return m_data->background;
+}
+
+/*!
+   \brief Set the background of the canvas
+
+   The default setting is Qt::white.
+
+   \param brush Background brush
+   \sa canvasBackground(), setBackground()
+ */
+void QwtPlotScene::setCanvasBackground( const QBrush& brush )
+{
+    m_data->canvasBackground = brush;
+}
+
+//! \return Background brush of the canvas
+QBrush QwtPlotScene::canvasBackground() const
+{
+    return m_data->canvasBackground;
+}
+
+/*!
+   \brief Set the margin around the scene
+
+   \param margin Margin
+   \sa margin()
+ */
+void QwtPlotScene::setMargin( int margin )
+{
+    m_data->margin = qMax( margin, 0 );
+}
+
+//! \return Margin around the scene
+int QwtPlotScene::margin() const
+{
+    return m_data->margin;
+}
+
+/*!
+   \brief Set the spacing between titles and the other components
+
+   \param spacing Spacing
+   \sa spacing()
+ */
+void QwtPlotScene::setSpacing( int spacing )
+{
+    m_data->spacing = qMax( spacing, 0 );
+}
+
+//! \return Spacing between titles and the other components
+int QwtPlotScene::spacing() const
+{
+    return m_data->spacing;
+}
+
+/*!
+   \return true if the specified axis exists, otherwise false
+   \param axisId axis index
+ */
+bool QwtPlotScene::isAxisValid( QwtAxisId axisId ) const
+{
+    return QwtAxis::isValid( axisId );
+}
+
+/*!
+   \brief Hide or show a specified axis
+
+   Hidden axes are not drawn, but they still define the
+   mapping of the items attached to them.
+
+   \param axisId Axis
+   \param on Show if true, hide if false
+ */
+void QwtPlotScene::setAxisVisible( QwtAxisId axisId, bool on )
+{
+    if ( isAxisValid( axisId ) )
+        m_data->axisData( axisId ).isVisible = on;
+}
+
+/*!
+   \return \c True, if a specified axis is visible
+   \param axisId Axis
+ */
+bool QwtPlotScene::isAxisVisible( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).isVisible;
+
+    return false;
+}
+
+/*!
+   \brief Change the title of a specified axis
+
+   \param axisId Axis
+   \param title axis title
+ */
+void QwtPlotScene::setAxisTitle( QwtAxisId axisId, const QString& title )
+{
+    setAxisTitle( axisId, QwtText( title ) );
+}
+
+/*!
+   \brief Change the title of a specified axis
+
+   \param axisId Axis
+   \param title Axis title
+ */
+void QwtPlotScene::setAxisTitle( QwtAxisId axisId, const QwtText& title )
+{
+    if ( isAxisValid( axisId ) )
+        m_data->axisData( axisId ).title = title;
+}
+
+/*!
+   \return Title of a specified axis
+   \param axisId Axis
+ */
+QwtText QwtPlotScene::axisTitle( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).title;
+
+    return QwtText();
+}
+
+/*!
+   Change the scale engine for an axis
+
+   \param axisId Axis
+   \param scaleEngine Scale engine
+
+   \sa axisScaleEngine(), QwtPlot::setAxisScaleEngine()
+ */
+void QwtPlotScene::setAxisScaleEngine(
+    QwtAxisId axisId, QwtScaleEngine* scaleEngine )
+{
+    if ( isAxisValid( axisId ) && scaleEngine != NULL )
+    {
+        AxisData& d = m_data->axisData( axisId );
+
+        if ( scaleEngine != d.scaleEngine )
+        {
+            delete d.scaleEngine;
+            d.scaleEngine = scaleEngine;
+
+            d.isValid = false;
+            d.syncScaleDraw();
+        }
+    }
+}
+
+/*!
+   \param axisId Axis
+   \return Scale engine for a specific axis
+ */
+QwtScaleEngine* QwtPlotScene::axisScaleEngine( QwtAxisId axisId )
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).scaleEngine;
+
+    return NULL;
+}
+
+/*!
+   \param axisId Axis
+   \return Scale engine for a specific axis
+ */
+const QwtScaleEngine* QwtPlotScene::axisScaleEngine( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).scaleEngine;
+
+    return NULL;
+}
+
+/*!
+   \brief Set a scale draw
+
+   \param axisId Axis
+   \param scaleDraw Object responsible for drawing scales.
+
+   The alignment of the scale draw is adjusted to the axis.
+   The previous scale draw is deleted.
+
+   \sa axisScaleDraw(), QwtPlot::setAxisScaleDraw()
+ */
+void QwtPlotScene::setAxisScaleDraw(
+    QwtAxisId axisId, QwtScaleDraw* scaleDraw )
+{
+    if ( isAxisValid( axisId ) && scaleDraw != NULL )
+    {
+        AxisData& d = m_data->axisData( axisId );
+
+        if ( scaleDraw != d.scaleDraw )
+        {
+            delete d.scaleDraw;
+            d.scaleDraw = scaleDraw;
+
+            d.scaleDraw->setAlignment( qwtScaleAlignment( axisId ) );
+            d.syncScaleDraw();
+        }
+    }
+}
+
+/*!
+   \return Scale draw of a specified axis
+   \param axisId Axis
+ */
+QwtScaleDraw* QwtPlotScene::axisScaleDraw( QwtAxisId axisId )
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).scaleDraw;
+
+    return NULL;
+}
+
+/*!
+   \return Scale draw of a specified axis
+   \param axisId Axis
+ */
+const QwtScaleDraw* QwtPlotScene::axisScaleDraw( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).scaleDraw;
+
+    return NULL;
+}
+
+/*!
+   \brief Enable autoscaling for a specified axis
+
+   \param axisId Axis
+   \param on On/Off
+   \sa setAxisScale(), setAxisScaleDiv(), updateAxes()
+ */
+void QwtPlotScene::setAxisAutoScale( QwtAxisId axisId, bool on )
+{
+    if ( isAxisValid( axisId ) )
+        m_data->axisData( axisId ).doAutoScale = on;
+}
+
+/*!
+   \return True, if autoscaling is enabled
+   \param axisId Axis
+ */
+bool QwtPlotScene::axisAutoScale( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).doAutoScale;
+
+    return false;
+}
+
+/*!
+   \brief Disable autoscaling and specify a fixed scale for a selected axis.
+
+   The scale division will be calculated by the scale engine
+   in updateAxes().
+
+   \param axisId Axis
+   \param min Minimum of the scale
+   \param max Maximum of the scale
+   \param stepSize Major step size. If <code>step == 0</code>, the step size is
+                  calculated automatically using the maxMajor setting.
+
+   \sa setAxisMaxMajor(), setAxisAutoScale(), QwtPlot::setAxisScale()
+ */
+void QwtPlotScene::setAxisScale( QwtAxisId axisId,
+    double min, double max, double stepSize )
+{
+    if ( isAxisValid( axisId ) )
+    {
+        AxisData& d = m_data->axisData( axisId );
+
+        d.doAutoScale = false;
+        d.isValid = false;
+
+        d.minValue = min;
+        d.maxValue = max;
+        d.stepSize = stepSize;
+    }
+}
+
+/*!
+   \brief Disable autoscaling and specify a fixed scale for a selected axis.
+
+   \param axisId Axis
+   \param scaleDiv Scale division
+
+   \sa setAxisScale(), setAxisAutoScale()
+ */
+void QwtPlotScene::setAxisScaleDiv( QwtAxisId axisId, const QwtScaleDiv& scaleDiv )
+{
+    if ( isAxisValid( axisId ) )
+    {
+        AxisData& d = m_data->axisData( axisId );
+
+        d.doAutoScale = false;
+        d.scaleDiv = scaleDiv;
+        d.isValid = true;
+
+        d.syncScaleDraw();
+    }
+}
+
+/*!
+   \brief Return the scale division of a specified axis
+
+   \param axisId Axis
+   \return Scale division
+   \sa updateAxes()
+ */
+const QwtScaleDiv& QwtPlotScene::axisScaleDiv( QwtAxisId axisId ) const
+{
+    if ( !isAxisValid( axisId ) )
+    {
+        static const QwtScaleDiv dummyScaleDiv;
+        return dummyScaleDiv;
+    }
+
+    return m_data->axisData( axisId ).scaleDiv;
+}
+
+/*!
+   Set the maximum number of major scale intervals for a specified axis
+
+   \param axisId Axis
+   \param maxMajor Maximum number of major steps
+
+   \sa axisMaxMajor()
+ */
+void QwtPlotScene::setAxisMaxMajor( QwtAxisId axisId, int maxMajor )
+{
+    if ( isAxisValid( axisId ) )
+    {
+        maxMajor = qBound( 1, maxMajor, 10000 );
+
+        AxisData& d = m_data->axisData( axisId );
+        if ( maxMajor != d.maxMajor )
+        {
+            d.maxMajor = maxMajor;
+            d.isValid = false;
+        }
+    }
+}
+
+/*!
+   \return The maximum number of major ticks for a specified axis
+   \param axisId Axis
+ */
+int QwtPlotScene::axisMaxMajor( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).maxMajor;
+
+    return 0;
+}
+
+/*!
+   Set the maximum number of minor scale intervals for a specified axis
+
+   \param axisId Axis
+   \param maxMinor Maximum number of minor steps
+
+   \sa axisMaxMinor()
+ */
+void QwtPlotScene::setAxisMaxMinor( QwtAxisId axisId, int maxMinor )
+{
+    if ( isAxisValid( axisId ) )
+    {
+        maxMinor = qBound( 0, maxMinor, 100 );
+
+        AxisData& d = m_data->axisData( axisId );
+        if ( maxMinor != d.maxMinor )
+        {
+            d.maxMinor = maxMinor;
+            d.isValid = false;
+        }
+    }
+}
+
+/*!
+   \return The maximum number of minor ticks for a specified axis
+   \param axisId Axis
+ */
+int QwtPlotScene::axisMaxMinor( QwtAxisId axisId ) const
+{
+    if ( isAxisValid( axisId ) )
+        return m_data->axisData( axisId ).maxMinor;
+
+    return 0;
+}
+
+/*!
+   \brief Rebuild the axes scales
+
+   Like QwtPlot::updateAxes() - but without autoscaling hysteresis.
+   As there is no replot() updateAxes() has to be called, whenever
+   the items or the scale settings have been modified.
+
+   \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv()
+ */
+void QwtPlotScene::updateAxes()
+{
+    QwtInterval boundingIntervals[QwtAxis::AxisPositions];
+
+    const QwtPlotItemList& itmList = m_data->items;
+
+    QwtPlotItemIterator it;
+    for ( it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+
+        if ( !item->testItemAttribute( QwtPlotItem::AutoScale ) )
+            continue;
+
+        if ( !item->isVisible() )
+            continue;
+
+        if ( axisAutoScale( item->xAxis() ) || axisAutoScale( item->yAxis() ) )
+        {
+            const QRectF rect = item->boundingRect();
+
+            if ( rect.width() >= 0.0 )
+                boundingIntervals[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
+
+            if ( rect.height() >= 0.0 )
+                boundingIntervals[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
+        }
+    }
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        AxisData& d = m_data->axisData( axisPos );
+
+        double minValue = d.minValue;
+        double maxValue = d.maxValue;
+        double stepSize = d.stepSize;
+
+        const QwtInterval& interval = boundingIntervals[axisPos];
+
+        if ( d.doAutoScale && interval.isValid() )
+        {
+            d.isValid = false;
+
+            minValue = interval.minValue();
+            maxValue = interval.maxValue();
+
+            d.scaleEngine->autoScale( d.maxMajor,
+                minValue, maxValue, stepSize );
+        }
+
+        if ( !d.isValid )
+        {
+            d.scaleDiv = d.scaleEngine->divideScale(
+                minValue, maxValue, d.maxMajor, d.maxMinor, stepSize );
+            d.isValid = true;
+        }
+
+        d.syncScaleDraw();
+    }
+
+    for ( it = itmList.begin(); it != itmList.end(); ++it )
+    {
+        QwtPlotItem* item = *it;
+        if ( item->testItemInterest( QwtPlotItem::ScaleInterest ) )
+        {
+            item->updateScaleDiv( axisScaleDiv( item->xAxis() ),
+                axisScaleDiv( item->yAxis() ) );
+        }
+    }
+}
+
+/*!
+   \brief Calculate the geometry of the canvas
+
+   \param rect Bounding rectangle of the scene
+   \return Rectangle of the canvas, when rendering the scene into rect
+   \sa render(), canvasMap()
+ */
+QRectF QwtPlotScene::canvasRect( const QRectF& rect ) const
+{
+    Layout layout;
+    updateLayout( rect, layout );
+
+    return layout.canvasRect;
+}
+
+/*!
+   \brief Map between scale and paint device coordinates
+
+   \param axisId Axis
+   \param canvasRect Rectangle of the canvas
+   \return Map for the axis
+
+   \sa canvasRect()
+ */
+QwtScaleMap QwtPlotScene::canvasMap(
+    QwtAxisId axisId, const QRectF& canvasRect ) const
+{
+    QwtScaleMap map;
+    if ( !isAxisValid( axisId ) )
+        return map;
+
+    const AxisData& d = m_data->axisData( axisId );
+
+    map.setTransformation( d.scaleEngine->transformation() );
+    map.setScaleInterval( d.scaleDiv.lowerBound(), d.scaleDiv.upperBound() );
+
+    if ( QwtAxis::isYAxis( axisId ) )
+        map.setPaintInterval( canvasRect.bottom(), canvasRect.top() );
+    else
+        map.setPaintInterval( canvasRect.left(), canvasRect.right() );
+
+    return map;
+}
+
+/*!
+   \brief Render the scene
+
+   The title is rendered on top, the visible axes around the canvas.
+   The scales are not updated - updateAxes() has to be called before,
+   when the items have been modified.
+
+   \param painter Painter
+   \param rect Bounding rectangle of the scene
+
+   \sa drawTitle(), drawScale(), drawCanvas()
+ */
+void QwtPlotScene::render( QPainter* painter, const QRectF& rect ) const
+{
+    if ( painter == NULL || !painter->isActive() || !rect.isValid() )
+        return;
+
+    Layout layout;
+    updateLayout( rect, layout );
+
+    painter->save();
+
+    if ( m_data->background.style() != Qt::NoBrush )
+        painter->fillRect( rect, m_data->background );
+
+    if ( !layout.titleRect.isEmpty() )
+        drawTitle( painter, layout.titleRect );
+
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        maps[axisPos] = canvasMap( axisPos, layout.canvasRect );
+
+        if ( isAxisVisible( axisPos ) )
+        {
+            drawScale( painter, axisPos,
+                layout.canvasRect, layout.scaleRects[axisPos] );
+        }
+    }
+
+    drawCanvas( painter, layout.canvasRect, maps );
+
+    painter->restore();
+}
+
+/*!
+   \brief Draw the title of the scene
+
+   \param painter Painter
+   \param titleRect Bounding rectangle of the title
+ */
+void QwtPlotScene::drawTitle( QPainter* painter, const QRectF& titleRect ) const
+{
+    painter->save();
+
+    painter->setFont( m_data->font );
+    painter->setPen( m_data->palette.color( QPalette::Text ) );
+
+    m_data->title.draw( painter, titleRect );
+
+    painter->restore();
+}
+
+/*!
+   \brief Draw a scale and its title
+
+   \param painter Painter
+   \param axisId Axis
+   \param canvasRect Rectangle of the canvas
+   \param scaleRect Bounding rectangle of the scale
+ */
+void QwtPlotScene::drawScale( QPainter* painter, QwtAxisId axisId,
+    const QRectF& canvasRect, const QRectF& scaleRect ) const
+{
+    AxisData& d = m_data->axisData( axisId );
+
+    QPalette palette = m_data->palette;
+    palette.setCurrentColorGroup( QPalette::Active );
+
+    painter->save();
+    painter->setFont( m_data->font );
+
+    QwtScaleDraw* sd = d.scaleDraw;
+
+    switch ( axisId )
+    {
+        case QwtAxis::YLeft:
+            sd->move( canvasRect.left(), canvasRect.top() );
+            sd->setLength( canvasRect.height() );
+            break;
+
+        case QwtAxis::YRight:
+            sd->move( canvasRect.right(), canvasRect.top() );
+            sd->setLength( canvasRect.height() );
+            break;
+
+        case QwtAxis::XTop:
+            sd->move( canvasRect.left(), canvasRect.top() );
+            sd->setLength( canvasRect.width() );
+            break;
+
+        case QwtAxis::XBottom:
+        default:
+            sd->move( canvasRect.left(), canvasRect.bottom() );
+            sd->setLength( canvasRect.width() );
+            break;
+    }
+
+    sd->draw( painter, palette );
+
+    if ( !d.title.isEmpty() )
+    {
+        painter->setPen( palette.color( QPalette::Text ) );
+
+        const bool isYAxis = QwtAxis::isYAxis( axisId );
+
+        const double length = isYAxis ? scaleRect.height() : scaleRect.width();
+        const double h = qwtCeil( d.title.heightForWidth( length, m_data->font ) );
+
+        if ( isYAxis )
+        {
+            // rotated by -90°, reading from bottom to top
+            const double x = ( axisId == QwtAxis::YLeft )
+                ? scaleRect.left() : scaleRect.right() - h;
+
+            painter->translate( x, scaleRect.bottom() );
+            painter->rotate( -90.0 );
+
+            d.title.draw( painter, QRectF( 0.0, 0.0, length, h ) );
+        }
+        else
+        {
+            const double y = ( axisId == QwtAxis::XTop )
+                ? scaleRect.top() : scaleRect.bottom() - h;
+
+            d.title.draw( painter, QRectF( scaleRect.left(), y, length, h ) );
+        }
+    }
+
+    painter->restore();
+}
+
+/*!
+   \brief Draw the canvas background and the items
+
+   \param painter Painter
+   \param canvasRect Rectangle of the canvas
+   \param maps Maps, mapping between plot and paint device coordinates
+ */
+void QwtPlotScene::drawCanvas( QPainter* painter,
+    const QRectF& canvasRect, const QwtScaleMap maps[] ) const
+{
+    painter->save();
+
+    if ( m_data->canvasBackground.style() != Qt::NoBrush )
+        painter->fillRect( canvasRect, m_data->canvasBackground );
+
+    painter->setClipRect( canvasRect, Qt::IntersectClip );
+
+    const QwtPlotItemList& itmList = m_data->items;
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+#if QT_VERSION < 0x050100
+        painter->setRenderHint( QPainter::HighQualityAntialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+#endif
+
+        item->draw( painter, maps[item->xAxis()],
+            maps[item->yAxis()], canvasRect );
+
+        painter->restore();
+    }
+
+    painter->restore();
+
+    QwtScratchPool::trim();
+}
+
+void QwtPlotScene::updateLayout( const QRectF& rect, Layout& layout ) const
+{
+    const QFont& font = m_data->font;
+    const int spacing = m_data->spacing;
+
+    const double m = m_data->margin;
+    QRectF r = rect.adjusted( m, m, -m, -m );
+
+    if ( !m_data->title.isEmpty() )
+    {
+        const double h = qwtCeil( m_data->title.heightForWidth( r.width(), font ) );
+
+        layout.titleRect = QRectF( r.left(), r.top(), r.width(), h );
+        r.setTop( r.top() + h + spacing );
+    }
+
+    double dims[ QwtAxis::AxisPositions ] = { 0.0 };
+
+    // space needed for the labels at the ends of the scales
+    int xDist = 0;
+    int yDist = 0;
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        const AxisData& d = m_data->axisData( axisPos );
+        if ( !d.isVisible )
+            continue;
+
+        const bool isYAxis = QwtAxis::isYAxis( axisPos );
+
+        double dim = qwtCeil( d.scaleDraw->extent( font ) ) + 1;
+
+        if ( !d.title.isEmpty() )
+        {
+            const double length = isYAxis ? r.height() : r.width();
+            dim += qwtCeil( d.title.heightForWidth( length, font ) ) + spacing;
+        }
+
+        dims[axisPos] = dim;
+
+        int startDist, endDist;
+        d.scaleDraw->getBorderDistHint( font, startDist, endDist );
+
+        if ( isYAxis )
+            yDist = qMax( yDist, qMax( startDist, endDist ) );
+        else
+            xDist = qMax( xDist, qMax( startDist, endDist ) );
+    }
+
+    using namespace QwtAxis;
+
+    const double left = qMax( dims[YLeft], double( xDist ) );
+    const double right = qMax( dims[YRight], double( xDist ) );
+    const double top = qMax( dims[XTop], double( yDist ) );
+    const double bottom = qMax( dims[XBottom], double( yDist ) );
+
+    const QRectF cr( r.left() + left, r.top() + top,
+        qMax( r.width() - left - right, 0.0 ),
+        qMax( r.height() - top - bottom, 0.0 ) );
+
+    layout.canvasRect = cr;
+
+    layout.scaleRects[YLeft] = QRectF( cr.left() - dims[YLeft],
+        cr.top(), dims[YLeft], cr.height() );
+
+    layout.scaleRects[YRight] = QRectF( cr.right(),
+        cr.top(), dims[YRight], cr.height() );
+
+    layout.scaleRects[XTop] = QRectF( cr.left(),
+        cr.top() - dims[XTop], cr.width(), dims[XTop] );
+
+    layout.scaleRects[XBottom] = QRectF( cr.left(),
+        cr.bottom(), cr.width(), dims[XBottom] );
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_SCENE_H
+#define QWT_PLOT_SCENE_H
+
+#include "qwt_global.h"
+#include "qwt_axis_id.h"
+#include "qwt_plot_dict.h"
+
+class QwtText;
+class QwtScaleDraw;
+class QwtScaleEngine;
+class QwtScaleDiv;
+class QwtScaleMap;
+class QPainter;
+class QPalette;
+class QBrush;
+class QFont;
+class QRectF;
+class QString;
+
+/*!
+   \brief A plot without widgets
+
+   QwtPlotScene is a lightweight model of a plot: items, axes and a title,
+   that can be rendered into any QPaintDevice. As it doesn't depend on
+   QWidget it can be used from any thread - f.e. for generating
+   plots on a server. Only a QGuiApplication is needed, for the fonts.
+
+   Items are inserted with attachItem(). They are organized like in
+   QwtPlotDict and must not be attached to a QwtPlot at the same time.
+   The axes are QwtScaleDraw objects together with a QwtScaleEngine
+   and the same scale settings as in QwtPlot.
+
+   \par Example
+   \code
+   QwtPlotScene scene;
+   scene.setTitle( "Temperature" );
+
+   QwtPlotCurve* curve = new QwtPlotCurve();
+   curve->setSamples( samples );
+   scene.attachItem( curve );
+
+   scene.updateAxes();
+
+   QImage image( 800, 600, QImage::Format_ARGB32 );
+   image.fill( Qt::white );
+
+   QPainter painter( &image );
+   scene.render( &painter, image.rect() );
+   \endcode
+   \endpar
+
+   \note A scene must not be modified or rendered from different threads
+         at the same time.
+   \note The legend is not supported.
+
+   \sa QwtPlotRenderer::renderScene(), QwtPlotRenderer::renderDocument()
+ */
+class QWT_EXPORT QwtPlotScene
+{
+  public:
+    QwtPlotScene();
+    virtual ~QwtPlotScene();
+
+    void setAutoDelete( bool );
+    bool autoDelete() const;
+
+    void attachItem( QwtPlotItem* );
+    void detachItem( QwtPlotItem* );
+    void detachItems( bool autoDelete = true );
+
+    const QwtPlotItemList& itemList() const;
+
+    void setTitle( const QString& );
+    void setTitle( const QwtText& );
+    QwtText title() const;
+
+    void setFont( const QFont& );
+    QFont font() const;
+
+    void setPalette( const QPalette& );
+    QPalette palette() const;
+
+    void setBackground( const QBrush& );
+    QBrush background() const;
+
+    void setCanvasBackground( const QBrush& );
+    QBrush canvasBackground() const;
+
+    void setMargin( int );
+    int margin() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    // Axes
+
+    bool isAxisValid( QwtAxisId ) const;
+
+    void setAxisVisible( QwtAxisId, bool on = true );
+    bool isAxisVisible( QwtAxisId ) const;
+
+    void setAxisTitle( QwtAxisId, const QString& );
+    void setAxisTitle( QwtAxisId, const QwtText& );
+    QwtText axisTitle( QwtAxisId ) const;
+
+    void setAxisScaleEngine( QwtAxisId, QwtScaleEngine* );
+    QwtScaleEngine* axisScaleEngine( QwtAxisId );
+    const QwtScaleEngine* axisScaleEngine( QwtAxisId ) const;
+
+    void setAxisScaleDraw( QwtAxisId, QwtScaleDraw* );
+    QwtScaleDraw* axisScaleDraw( QwtAxisId );
+    const QwtScaleDraw* axisScaleDraw( QwtAxisId ) const;
+
+    void setAxisAutoScale( QwtAxisId, bool on = true );
+    bool axisAutoScale( QwtAxisId ) const;
+
+    void setAxisScale( QwtAxisId,
+        double min, double max, double stepSize = 0 );
+
+    void setAxisScaleDiv( QwtAxisId, const QwtScaleDiv& );
+    const QwtScaleDiv& axisScaleDiv( QwtAxisId ) const;
+
+    void setAxisMaxMajor( QwtAxisId, int maxMajor );
+    int axisMaxMajor( QwtAxisId ) const;
+
+    void setAxisMaxMinor( QwtAxisId, int maxMinor );
+    int axisMaxMinor( QwtAxisId ) const;
+
+    void updateAxes();
+
+    // Layout and rendering
+
+    QRectF canvasRect( const QRectF& rect ) const;
+    QwtScaleMap canvasMap( QwtAxisId, const QRectF& canvasRect ) const;
+
+    virtual void render( QPainter*, const QRectF& rect ) const;
+
+  protected:
+    virtual void drawTitle( QPainter*, const QRectF& titleRect ) const;
+
+    virtual void drawScale( QPainter*, QwtAxisId,
+        const QRectF& canvasRect, const QRectF& scaleRect ) const;
+
+    virtual void drawCanvas( QPainter*, const QRectF& canvasRect,
+        const QwtScaleMap maps[] ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtPlotScene )
+
+    class Layout;
+    void updateLayout( const QRectF&, Layout& ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
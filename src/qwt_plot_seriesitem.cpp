@@ -8,18 +8,59 @@
  *****************************************************************************/
 
 #include "qwt_plot_seriesitem.h"
+#include "qwt_plot_directpainter.h"
+#include "qwt_plot.h"
 #include "qwt_scale_div.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
 #include "qwt_text.h"
 
+#include <qwidget.h>
+#include <qelapsedtimer.h>
+
+// samples of a chunk, that is painted by drawProgressively()
+static const int qwtProgressiveChunkSize = 65536;
+
+static inline bool qwtIsEqual( const QwtScaleMap& map1, const QwtScaleMap& map2 )
+{
+    return map1.s1() == map2.s1() && map1.s2() == map2.s2()
+        && map1.p1() == map2.p1() && map1.p2() == map2.p2();
+}
+
+static inline bool qwtContains( const QwtInterval& interval,
+    double value1, double value2 )
+{
+    const QwtInterval intv = interval.normalized();
+    return intv.contains( value1 ) && intv.contains( value2 );
+}
+
 class QwtPlotSeriesItem::PrivateData
 {
   public:
     PrivateData()
         : orientation( Qt::Vertical )
+        , directPainter( NULL )
+        , isPainted( false )
+        , paintedSamples( 0 )
+    {
+    }
+
+    ~PrivateData()
     {
+        delete directPainter;
     }
 
     Qt::Orientation orientation;
+    QwtPlotSeriesItem::SeriesAttributes seriesAttributes;
+
+    QwtPlotDirectPainter* directPainter;
+
+    // what has been painted to the canvas
+    bool isPainted;
+    size_t paintedSamples;
+    QwtScaleMap xMap;
+    QwtScaleMap yMap;
+    QRectF canvasRect;
 };
 
 /*!
@@ -66,7 +107,7 @@ void QwtPlotSeriesItem::setOrientation( Qt::Orientation orientation )
         m_data->orientation = orientation;
 
         legendChanged();
-        itemChanged();
+        itemChanged( QwtPlotItem::GeometryChange );
     }
 }
 
@@ -79,6 +120,36 @@ Qt::Orientation QwtPlotSeriesItem::orientation() const
     return m_data->orientation;
 }
 
+/*!
+   Specify an attribute describing the samples
+
+   \param attribute Series attribute
+   \param on On/Off
+
+   \sa testSeriesAttribute(), SeriesAttribute
+ */
+void QwtPlotSeriesItem::setSeriesAttribute( SeriesAttribute attribute, bool on )
+{
+    if ( on != testSeriesAttribute( attribute ) )
+    {
+        if ( on )
+            m_data->seriesAttributes |= attribute;
+        else
+            m_data->seriesAttributes &= ~attribute;
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa setSeriesAttribute(), SeriesAttribute
+ */
+bool QwtPlotSeriesItem::testSeriesAttribute( SeriesAttribute attribute ) const
+{
+    return m_data->seriesAttributes & attribute;
+}
+
 /*!
    \brief Draw the complete series
 
@@ -91,9 +162,165 @@ void QwtPlotSeriesItem::draw( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRectF& canvasRect ) const
 {
+    // the state for paintAppendedSamples()
+
+    m_data->isPainted = true;
+    m_data->paintedSamples = dataSize();
+    m_data->xMap = xMap;
+    m_data->yMap = yMap;
+    m_data->canvasRect = canvasRect;
+
     drawSeries( painter, xMap, yMap, canvasRect, 0, -1 );
 }
 
+/*!
+   \brief Draw the series in chunks, until a time budget is exhausted
+
+   The samples are painted in chunks of subsequent samples by drawSeries().
+   The chunks share their boundary samples, so that the lines of a curve
+   stay connected. Drawing stops after the first chunk, that exceeds
+   the budget, so that the caller can continue in a later call
+   with the returned index.
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas
+   \param from Index of the first sample to be painted
+   \param timer Timer, that has been started with the operation
+   \param msecBudget Time budget in milliseconds, measured by timer
+
+   \return Index of the sample, where to continue, or -1, when
+           the series has been painted completely
+
+   \sa QwtPlot::setRenderTimeBudget(), drawSeries()
+ */
+int QwtPlotSeriesItem::drawProgressively( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from,
+    const QElapsedTimer& timer, qint64 msecBudget ) const
+{
+    const int numSamples = static_cast< int >( dataSize() );
+
+    if ( from == 0 )
+    {
+        // the state for paintAppendedSamples()
+
+        m_data->isPainted = true;
+        m_data->paintedSamples = numSamples;
+        m_data->xMap = xMap;
+        m_data->yMap = yMap;
+        m_data->canvasRect = canvasRect;
+    }
+
+    if ( from >= numSamples )
+        return -1;
+
+    while ( true )
+    {
+        const int to = qMin( from + qwtProgressiveChunkSize, numSamples - 1 );
+        drawSeries( painter, xMap, yMap, canvasRect, from, to );
+
+        if ( to >= numSamples - 1 )
+            return -1;
+
+        from = to;
+
+        if ( timer.hasExpired( msecBudget ) )
+            return from;
+    }
+}
+
+/*!
+   \brief Paint the samples, that have been appended since the last paint operation
+
+   paintAppendedSamples() keeps track of the samples, that have been painted
+   to the canvas and paints the new samples incrementally using
+   directPainter(). A full replot is done instead, when this is not possible:
+
+   - the item hasn't been painted before
+   - the number of samples has been decreased
+   - the scales or the geometry of the canvas have been changed
+   - the new samples exceed the scale of an autoscaled axis
+
+   Starting with the last painted sample the segment to the first
+   new sample is painted as well.
+
+   \note The samples are expected to be appended only. Modifications of
+         samples, that have been painted before, are not detected.
+
+   \sa directPainter(), QwtPlotDirectPainter::drawSeries(), QwtPlot::replot()
+ */
+void QwtPlotSeriesItem::paintAppendedSamples()
+{
+    QwtPlot* plot = this->plot();
+    if ( plot == NULL || plot->canvas() == NULL )
+        return;
+
+    const size_t numSamples = dataSize();
+
+    bool doReplot = !m_data->isPainted || numSamples < m_data->paintedSamples;
+
+    if ( !doReplot )
+    {
+        const QwtScaleMap xMap = plot->canvasMap( xAxis() );
+        const QwtScaleMap yMap = plot->canvasMap( yAxis() );
+
+        doReplot = !qwtIsEqual( xMap, m_data->xMap )
+            || !qwtIsEqual( yMap, m_data->yMap )
+            || QRectF( plot->canvas()->contentsRect() ) != m_data->canvasRect;
+    }
+
+    if ( !doReplot && numSamples > m_data->paintedSamples )
+    {
+        const QRectF br = dataRect();
+        if ( br.width() >= 0.0 && br.height() >= 0.0 )
+        {
+            if ( plot->axisAutoScale( xAxis() ) && !qwtContains(
+                plot->axisScaleDiv( xAxis() ).interval(), br.left(), br.right() ) )
+            {
+                doReplot = true;
+            }
+
+            if ( plot->axisAutoScale( yAxis() ) && !qwtContains(
+                plot->axisScaleDiv( yAxis() ).interval(), br.top(), br.bottom() ) )
+            {
+                doReplot = true;
+            }
+        }
+    }
+
+    if ( doReplot )
+    {
+        // draw() updates the painted samples
+        plot->replot();
+        return;
+    }
+
+    if ( numSamples > m_data->paintedSamples )
+    {
+        const int from = int( m_data->paintedSamples > 0
+            ? m_data->paintedSamples - 1 : 0 );
+
+        directPainter()->drawSeries( this, from, int( numSamples - 1 ) );
+        m_data->paintedSamples = numSamples;
+    }
+}
+
+/*!
+   \return Direct painter, that is used by paintAppendedSamples()
+
+   The direct painter is created on demand and can be used to configure
+   the incremental painting ( f.e. clipping or attributes ).
+ */
+QwtPlotDirectPainter* QwtPlotSeriesItem::directPainter() const
+{
+    if ( m_data->directPainter == NULL )
+        m_data->directPainter = new QwtPlotDirectPainter();
+
+    return m_data->directPainter;
+}
+
 QRectF QwtPlotSeriesItem::boundingRect() const
 {
     return dataRect();
@@ -111,5 +338,5 @@ void QwtPlotSeriesItem::updateScaleDiv(
 
 void QwtPlotSeriesItem::dataChanged()
 {
-    itemChanged();
+    itemChanged( QwtPlotItem::DataChange );
 }
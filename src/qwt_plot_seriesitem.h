@@ -17,6 +17,8 @@
 #include <qstring.h>
 
 class QwtScaleDiv;
+class QwtPlotDirectPainter;
+class QElapsedTimer;
 
 /*!
    \brief Base class for plot items representing a series of samples
@@ -25,6 +27,31 @@ class QWT_EXPORT QwtPlotSeriesItem : public QwtPlotItem,
     public virtual QwtAbstractSeriesStore
 {
   public:
+    /*!
+       Attributes describing the samples
+       \sa setSeriesAttribute(), testSeriesAttribute()
+     */
+    enum SeriesAttribute
+    {
+        /*!
+           The samples are sorted in increasing order of their positions:
+           the x coordinates of a QwtPlotCurve or the values/times
+           of a QwtPlotIntervalCurve/QwtPlotTradingCurve.
+
+           Then the samples inside of the canvas can be found by
+           a binary search and only those need to be processed.
+
+           Series, that detect the order themselves ( f.e. QwtPointArrayData )
+           indicate it by QwtSeriesData::isMonotonic() and do not need
+           this attribute.
+
+           \sa qwtClipSampleRange(), QwtSeriesData::isMonotonic()
+         */
+        OrderedSamples = 0x01
+    };
+
+    Q_DECLARE_FLAGS( SeriesAttributes, SeriesAttribute )
+
     explicit QwtPlotSeriesItem( const QString& title = QString() );
     explicit QwtPlotSeriesItem( const QwtText& title );
 
@@ -33,6 +60,9 @@ class QWT_EXPORT QwtPlotSeriesItem : public QwtPlotItem,
     void setOrientation( Qt::Orientation );
     Qt::Orientation orientation() const;
 
+    void setSeriesAttribute( SeriesAttribute, bool on = true );
+    bool testSeriesAttribute( SeriesAttribute ) const;
+
     virtual void draw( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect ) const QWT_OVERRIDE;
@@ -52,8 +82,16 @@ class QWT_EXPORT QwtPlotSeriesItem : public QwtPlotItem,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, int from, int to ) const = 0;
 
+    int drawProgressively( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from,
+        const QElapsedTimer&, qint64 msecBudget ) const;
+
     virtual QRectF boundingRect() const QWT_OVERRIDE;
 
+    void paintAppendedSamples();
+    QwtPlotDirectPainter* directPainter() const;
+
     virtual void updateScaleDiv(
         const QwtScaleDiv&, const QwtScaleDiv& ) QWT_OVERRIDE;
 
@@ -65,4 +103,6 @@ class QWT_EXPORT QwtPlotSeriesItem : public QwtPlotItem,
     PrivateData* m_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotSeriesItem::SeriesAttributes )
+
 #endif
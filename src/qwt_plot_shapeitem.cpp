@@ -18,6 +18,85 @@
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qlist.h>
+#include <qvector.h>
+
+namespace
+{
+    // accepted error of the level of detail in pixels
+    const double qwtLodTolerance = 0.5;
+
+    // number of zoom levels, that are cached
+    const int qwtMaxLodLevels = 8;
+
+    // the subpaths simplified for a resolution of the scales
+    class QwtShapeLevel
+    {
+      public:
+        int levelX;
+        int levelY;
+
+        QVector< QPolygonF > polygons;
+    };
+
+    /*
+        The transformed path of the subpaths intersecting an area, that is
+        larger than the visible part. It can be reused for scale maps, that
+        differ by a translation only.
+     */
+    class QwtShapeCache
+    {
+      public:
+        QwtShapeCache()
+            : isValid( false )
+        {
+        }
+
+        bool isValid;
+
+        double mx, my; // scale factors
+        double x0, y0; // paint coordinates of the plot origin
+        bool doAlign;
+
+        QRectF area;
+        QPainterPath path;
+    };
+}
+
+static inline int qwtLodLevel( double unitsPerPixel )
+{
+    return qwtFloor( std::log( unitsPerPixel ) / std::log( 2.0 ) );
+}
+
+static QPolygonF qwtSimplified( const QPolygonF& polygon, double dx, double dy )
+{
+    if ( polygon.size() <= 3 )
+        return polygon;
+
+    // weeding in a coordinate system, where 1.0 is the size of a pixel
+
+    QPolygonF scaled( polygon.size() );
+    for ( int i = 0; i < polygon.size(); i++ )
+        scaled[i] = QPointF( polygon[i].x() / dx, polygon[i].y() / dy );
+
+    const QwtWeedingCurveFitter fitter( qwtLodTolerance );
+    QPolygonF simplified = fitter.fitCurve( scaled );
+
+    for ( int i = 0; i < simplified.size(); i++ )
+    {
+        QPointF& p = simplified[i];
+        p = QPointF( p.x() * dx, p.y() * dy );
+    }
+
+    return simplified;
+}
+
+static inline bool qwtIntersects( const QRectF& r1, const QRectF& r2 )
+{
+    // accepting horizontal/vertical lines
+    return ( r1.left() <= r2.right() ) && ( r1.right() >= r2.left() )
+        && ( r1.top() <= r2.bottom() ) && ( r1.bottom() >= r2.top() );
+}
 
 static QPainterPath qwtTransformPath( const QwtScaleMap& xMap,
     const QwtScaleMap& yMap, const QPainterPath& path, bool doAlign )
@@ -86,6 +165,8 @@ class QwtPlotShapeItem::PrivateData
     PrivateData()
         : legendMode( QwtPlotShapeItem::LegendColor )
         , renderTolerance( 0.0 )
+        , isIndexed( false )
+        , hasCurves( false )
     {
     }
 
@@ -98,8 +179,216 @@ class QwtPlotShapeItem::PrivateData
     QPen pen;
     QBrush brush;
     QPainterPath shape;
+
+    bool drawLevelOfDetail( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, bool doClip ) const;
+
+    void invalidateLevels()
+    {
+        subpaths.clear();
+        subpathRects.clear();
+        isIndexed = false;
+
+        levels.clear();
+        invalidateCache();
+    }
+
+    void invalidateCache()
+    {
+        cache = QwtShapeCache();
+    }
+
+  private:
+    const QwtShapeLevel* level( int levelX, int levelY ) const;
+
+    // level of detail, built lazily
+    mutable bool isIndexed;
+    mutable bool hasCurves;
+    mutable QVector< QPolygonF > subpaths;
+    mutable QVector< QRectF > subpathRects;
+    mutable QList< QwtShapeLevel > levels;
+    mutable QwtShapeCache cache;
 };
 
+const QwtShapeLevel* QwtPlotShapeItem::PrivateData::level(
+    int levelX, int levelY ) const
+{
+    for ( int i = 0; i < levels.size(); i++ )
+    {
+        if ( levels[i].levelX == levelX && levels[i].levelY == levelY )
+        {
+            if ( i > 0 )
+                levels.move( i, 0 );
+
+            return &levels.first();
+        }
+    }
+
+    if ( levels.size() >= qwtMaxLodLevels )
+        levels.removeLast();
+
+    const double dx = std::ldexp( 1.0, levelX );
+    const double dy = std::ldexp( 1.0, levelY );
+
+    QwtShapeLevel lod;
+    lod.levelX = levelX;
+    lod.levelY = levelY;
+
+    lod.polygons.reserve( subpaths.size() );
+    for ( int i = 0; i < subpaths.size(); i++ )
+        lod.polygons += qwtSimplified( subpaths[i], dx, dy );
+
+    levels.prepend( lod );
+    return &levels.first();
+}
+
+bool QwtPlotShapeItem::PrivateData::drawLevelOfDetail( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, bool doClip ) const
+{
+    if ( xMap.transformation() || yMap.transformation() )
+        return false;
+
+    if ( xMap.sDist() == 0.0 || yMap.sDist() == 0.0
+        || xMap.pDist() == 0.0 || yMap.pDist() == 0.0 )
+    {
+        return false;
+    }
+
+    if ( !isIndexed )
+    {
+        hasCurves = false;
+        for ( int i = 0; i < shape.elementCount(); i++ )
+        {
+            if ( shape.elementAt( i ).type == QPainterPath::CurveToElement )
+            {
+                hasCurves = true;
+                break;
+            }
+        }
+
+        if ( !hasCurves )
+        {
+            subpaths = shape.toSubpathPolygons().toVector();
+
+            subpathRects.resize( subpaths.size() );
+            for ( int i = 0; i < subpaths.size(); i++ )
+                subpathRects[i] = subpaths[i].boundingRect();
+        }
+
+        isIndexed = true;
+    }
+
+    if ( hasCurves )
+        return false;
+
+    const double mx = xMap.pDist() / xMap.sDist();
+    const double my = yMap.pDist() / yMap.sDist();
+
+    const double x0 = xMap.transform( 0.0 );
+    const double y0 = yMap.transform( 0.0 );
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const qreal pw = QwtPainter::effectivePenWidth( pen );
+
+    // visible area in plot coordinates, including the pen
+    const QRectF visibleRect = QwtScaleMap::invTransform( xMap, yMap,
+        canvasRect.adjusted( -pw, -pw, pw, pw ) ).normalized();
+
+    bool reuse = cache.isValid && cache.doAlign == doAlign
+        && qFuzzyCompare( cache.mx, mx ) && qFuzzyCompare( cache.my, my )
+        && cache.area.contains( visibleRect );
+
+    const double dx = x0 - cache.x0;
+    const double dy = y0 - cache.y0;
+
+    if ( reuse && doAlign )
+    {
+        // translating an aligned path by fractions would break the alignment
+        reuse = ( qAbs( dx - qRound( dx ) ) < 1e-6 )
+            && ( qAbs( dy - qRound( dy ) ) < 1e-6 );
+    }
+
+    if ( !reuse )
+    {
+        const QwtShapeLevel* lod = level(
+            qwtLodLevel( qAbs( 1.0 / mx ) ), qwtLodLevel( qAbs( 1.0 / my ) ) );
+
+        // the cached path covers 3x3 times the visible area
+        const QRectF area = visibleRect.adjusted(
+            -visibleRect.width(), -visibleRect.height(),
+            visibleRect.width(), visibleRect.height() );
+
+        const QRectF clipRect = QwtScaleMap::transform(
+            xMap, yMap, area ).adjusted( -pw, -pw, pw, pw );
+
+        QPainterPath path;
+        path.setFillRule( shape.fillRule() );
+
+        QwtWeedingCurveFitter fitter( renderTolerance );
+
+        for ( int i = 0; i < lod->polygons.size(); i++ )
+        {
+            if ( !qwtIntersects( subpathRects[i], area ) )
+                continue;
+
+            const QPolygonF& points = lod->polygons[i];
+
+            QPolygonF polygon( points.size() );
+            for ( int j = 0; j < points.size(); j++ )
+            {
+                double x = xMap.transform( points[j].x() );
+                double y = yMap.transform( points[j].y() );
+
+                if ( doAlign )
+                {
+                    x = qRound( x );
+                    y = qRound( y );
+                }
+
+                polygon[j] = QPointF( x, y );
+            }
+
+            if ( doClip )
+                QwtClipper::clipPolygonF( clipRect, polygon, true );
+
+            if ( renderTolerance > 0.0 )
+                polygon = fitter.fitCurve( polygon );
+
+            path.addPolygon( polygon );
+        }
+
+        cache.isValid = true;
+        cache.mx = mx;
+        cache.my = my;
+        cache.x0 = x0;
+        cache.y0 = y0;
+        cache.doAlign = doAlign;
+        cache.area = area;
+        cache.path = path;
+    }
+
+    painter->setPen( pen );
+    painter->setBrush( brush );
+
+    if ( reuse && ( dx != 0.0 || dy != 0.0 ) )
+    {
+        painter->save();
+        painter->translate( doAlign ? qRound( dx ) : dx,
+            doAlign ? qRound( dy ) : dy );
+        painter->drawPath( cache.path );
+        painter->restore();
+    }
+    else
+    {
+        painter->drawPath( cache.path );
+    }
+
+    return true;
+}
+
 /*!
    \brief Constructor
 
@@ -166,6 +455,8 @@ void QwtPlotShapeItem::setPaintAttribute( PaintAttribute attribute, bool on )
         m_data->paintAttributes |= attribute;
     else
         m_data->paintAttributes &= ~attribute;
+
+    m_data->invalidateCache();
 }
 
 /*!
@@ -246,6 +537,8 @@ void QwtPlotShapeItem::setShape( const QPainterPath& shape )
     if ( shape != m_data->shape )
     {
         m_data->shape = shape;
+        m_data->invalidateLevels();
+
         if ( shape.isEmpty() )
         {
             m_data->boundingRect = QwtPlotItem::boundingRect();
@@ -299,6 +592,8 @@ void QwtPlotShapeItem::setPen( const QPen& pen )
     if ( pen != m_data->pen )
     {
         m_data->pen = pen;
+        m_data->invalidateCache();
+
         itemChanged();
     }
 }
@@ -361,6 +656,8 @@ void QwtPlotShapeItem::setRenderTolerance( double tolerance )
     if ( tolerance != m_data->renderTolerance )
     {
         m_data->renderTolerance = tolerance;
+        m_data->invalidateCache();
+
         itemChanged();
     }
 }
@@ -407,6 +704,14 @@ void QwtPlotShapeItem::draw( QPainter* painter,
         return;
     }
 
+    if ( testPaintAttribute( QwtPlotShapeItem::LevelOfDetail ) )
+    {
+        const bool doClip = testPaintAttribute( QwtPlotShapeItem::ClipPolygons );
+
+        if ( m_data->drawLevelOfDetail( painter, xMap, yMap, canvasRect, doClip ) )
+            return;
+    }
+
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
     QPainterPath path = qwtTransformPath( xMap, yMap,
@@ -56,6 +56,22 @@ class QWT_EXPORT QwtPlotShapeItem : public QwtPlotItem
            performance of paths composed from curves or ellipses.
          */
         ClipPolygons = 0x01,
+
+        /*!
+           Display simplified versions of the shape: for each zoom level
+           the subpaths are reduced by the Douglas-Peucker algorithm
+           to what is visible in the resolution of the canvas ( < 1/2 pixel ).
+           The simplified subpaths are cached for the most recently
+           used zoom levels.
+
+           Subpaths outside of the visible area are skipped and the
+           transformed path is reused, when the scales have been translated
+           only ( f.e. by QwtPlotPanner ).
+
+           LevelOfDetail is ignored for shapes with curves and for
+           scales with a transformation ( f.e. logarithmic scales ).
+         */
+        LevelOfDetail = 0x02
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
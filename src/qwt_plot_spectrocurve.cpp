@@ -11,9 +11,127 @@
 #include "qwt_color_map.h"
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
+#include "qwt_symbol.h"
+#include "qwt_symbol_atlas.h"
 #include "qwt_text.h"
 
 #include <qpainter.h>
+#include <qimage.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// limiting the number of prerendered symbol variants
+static const int qwtNumSymbolSizes = 8;
+static const int qwtNumSymbolColors = 256;
+static const int qwtNumSizedSymbolColors = 64;
+
+// number of colors of the lookup table for the ImageBuffer mode
+static const int qwtNumDotColors = 1024;
+
+// minimum number of points, that are mapped in a separate thread
+static const int qwtMinDotsPerThread = 50000;
+
+namespace
+{
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class QwtColoredDotsJob
+    {
+      public:
+        const QwtSeriesData< QwtPoint3D >* series;
+        int from;
+        int to;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRect rect;
+
+        const QwtColorMap* colorMap;
+        QwtInterval colorRange;
+        const QwtColorLookupTable* lookupTable;
+        const QRgb* colorTable256;
+
+        QRgb* bits;
+        QVector< QRgb > buffer;
+    };
+}
+
+static void qwtRenderColoredDots( QwtColoredDotsJob* job )
+{
+    if ( job->bits == NULL )
+    {
+        job->buffer.fill( 0u, job->rect.width() * job->rect.height() );
+        job->bits = job->buffer.data();
+    }
+
+    QRgb* bits = job->bits;
+
+    const int w = job->rect.width();
+    const int h = job->rect.height();
+    const int x0 = job->rect.x();
+    const int y0 = job->rect.y();
+
+    const QwtColorMap* colorMap = job->colorMap;
+    const QwtColorLookupTable* lookupTable = job->lookupTable;
+
+    const int chunkSize = 512;
+
+    QwtPoint3D samples[ chunkSize ];
+    double zValues[ chunkSize ];
+    QRgb rgbs[ chunkSize ];
+    uint indices[ chunkSize ];
+
+    for ( int i0 = job->from; i0 <= job->to; i0 += chunkSize )
+    {
+        const int n = qMin( chunkSize, job->to - i0 + 1 );
+        job->series->fetch( i0, n, samples );
+
+        if ( lookupTable == NULL )
+        {
+            // mapping the values of the chunk with one call of the color map
+
+            for ( int j = 0; j < n; j++ )
+                zValues[j] = samples[j].z();
+
+            if ( job->colorTable256 )
+            {
+                colorMap->colorIndices( 256, job->colorRange, zValues, indices, n );
+
+                for ( int j = 0; j < n; j++ )
+                    rgbs[j] = job->colorTable256[ indices[j] ];
+            }
+            else
+            {
+                colorMap->rgbValues( job->colorRange, zValues, rgbs, n );
+            }
+        }
+
+        for ( int j = 0; j < n; j++ )
+        {
+            const QwtPoint3D& sample = samples[j];
+
+            // checking the range before converting to int
+            const double px = job->xMap.transform( sample.x() ) - x0 + 0.5;
+            const double py = job->yMap.transform( sample.y() ) - y0 + 0.5;
+
+            if ( !( px >= 0.0 && px < w && py >= 0.0 && py < h ) )
+                continue;
+
+            const int x = static_cast< int >( px );
+            const int y = static_cast< int >( py );
+
+            const QRgb rgb = lookupTable ? lookupTable->rgb( sample.z() ) : rgbs[j];
+
+            if ( qAlpha( rgb ) != 0 )
+                bits[ y * w + x ] = rgb;
+        }
+    }
+}
 
 class QwtPlotSpectroCurve::PrivateData
 {
@@ -21,6 +139,7 @@ class QwtPlotSpectroCurve::PrivateData
     PrivateData()
         : colorRange( 0.0, 1000.0 )
         , penWidth( 0.0 )
+        , symbol( NULL )
         , paintAttributes( QwtPlotSpectroCurve::ClipPoints )
     {
         colorMap = new QwtLinearColorMap();
@@ -29,12 +148,18 @@ class QwtPlotSpectroCurve::PrivateData
     ~PrivateData()
     {
         delete colorMap;
+        delete symbol;
     }
 
     QwtColorMap* colorMap;
     QwtInterval colorRange;
     QVector< QRgb > colorTable;
     double penWidth;
+
+    QwtSymbol* symbol;
+    QwtInterval symbolSizeRange;
+    QwtSymbolAtlas symbolAtlas;
+
     QwtPlotSpectroCurve::PaintAttributes paintAttributes;
 };
 
@@ -222,6 +347,77 @@ double QwtPlotSpectroCurve::penWidth() const
     return m_data->penWidth;
 }
 
+/*!
+   \brief Assign a symbol
+
+   When a symbol has been assigned the points are displayed as symbols,
+   instead of dots. The z coordinates are mapped to the colors of the
+   symbols - see setColorMap(), setColorRange().
+
+   The curve will take the ownership of the symbol, hence the previously
+   set symbol will be delete by setting a new one. If \p symbol is
+   \c NULL dots will be drawn.
+
+   \param symbol Symbol
+   \sa symbol(), setSymbolSizeRange(), drawSymbols()
+ */
+void QwtPlotSpectroCurve::setSymbol( QwtSymbol* symbol )
+{
+    if ( symbol != m_data->symbol )
+    {
+        delete m_data->symbol;
+        m_data->symbol = symbol;
+
+        m_data->symbolAtlas.invalidate();
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Current symbol or NULL, when no symbol has been assigned
+   \sa setSymbol()
+ */
+const QwtSymbol* QwtPlotSpectroCurve::symbol() const
+{
+    return m_data->symbol;
+}
+
+/*!
+   \brief Map the z coordinates to the size of the symbols
+
+   The z coordinate of a point is mapped from colorRange() to
+   a symbol extent in the interval, that is quantized into 8 steps.
+   The width of the symbol is set to the extent, while its height keeps
+   the aspect ratio of the size of the symbol.
+
+   \param interval Range of the symbol extent in pixels. An invalid
+                   interval means, that all symbols are painted with the
+                   size of the symbol, what is also the default setting.
+
+   \sa symbolSizeRange(), setSymbol(), setColorRange()
+ */
+void QwtPlotSpectroCurve::setSymbolSizeRange( const QwtInterval& interval )
+{
+    if ( interval != m_data->symbolSizeRange )
+    {
+        m_data->symbolSizeRange = interval;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Range of the symbol extent in pixels
+   \sa setSymbolSizeRange()
+ */
+QwtInterval QwtPlotSpectroCurve::symbolSizeRange() const
+{
+    return m_data->symbolSizeRange;
+}
+
 /*!
    Draw a subset of the points
 
@@ -233,7 +429,7 @@ double QwtPlotSpectroCurve::penWidth() const
    \param to Index of the last sample to be painted. If to < 0 the
          series will be painted to its last sample.
 
-   \sa drawDots()
+   \sa drawDots(), drawSymbols()
  */
 void QwtPlotSpectroCurve::drawSeries( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -251,7 +447,11 @@ void QwtPlotSpectroCurve::drawSeries( QPainter* painter,
     if ( from > to )
         return;
 
-    drawDots( painter, xMap, yMap, canvasRect, from, to );
+    const QwtSymbol* symbol = m_data->symbol;
+    if ( symbol && symbol->style() != QwtSymbol::NoSymbol )
+        drawSymbols( painter, *symbol, xMap, yMap, canvasRect, from, to );
+    else
+        drawDots( painter, xMap, yMap, canvasRect, from, to );
 }
 
 /*!
@@ -265,7 +465,7 @@ void QwtPlotSpectroCurve::drawSeries( QPainter* painter,
    \param to Index of the last sample to be painted. If to < 0 the
          series will be painted to its last sample.
 
-   \sa drawSeries()
+   \sa drawSeries(), ImageBuffer
  */
 void QwtPlotSpectroCurve::drawDots( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -276,6 +476,17 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
+    if ( doAlign && ( m_data->paintAttributes & ImageBuffer )
+        && m_data->penWidth <= 1.0 )
+    {
+        const QRect rect = canvasRect.toAlignedRect();
+
+        const QImage image = renderDots( xMap, yMap, rect, from, to );
+        painter->drawImage( rect.topLeft(), image );
+
+        return;
+    }
+
     const QwtColorMap::Format format = m_data->colorMap->format();
     if ( format == QwtColorMap::Indexed )
         m_data->colorTable = m_data->colorMap->colorTable256();
@@ -321,3 +532,222 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
 
     m_data->colorTable.clear();
 }
+
+/*
+   Each thread maps its chunk of points into a buffer of its own
+   and the buffers are composed in the order of the chunks, so that
+   the result is the same as when drawing the points one by one.
+ */
+QImage QwtPlotSpectroCurve::renderDots(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRect& rect, int from, int to ) const
+{
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+    image.fill( Qt::transparent );
+
+    if ( rect.isEmpty() )
+        return image;
+
+    const QwtColorMap* colorMap = m_data->colorMap;
+
+    QwtColorLookupTable lookupTable;
+    if ( QwtColorLookupTable::isSupported( colorMap ) )
+    {
+        lookupTable.setColorMap( colorMap, qwtNumDotColors );
+        lookupTable.setInterval( m_data->colorRange );
+    }
+
+    if ( colorMap->format() == QwtColorMap::Indexed )
+        m_data->colorTable = colorMap->colorTable256();
+
+    int numThreads = 1;
+
+#if QWT_USE_THREADS
+    numThreads = renderThreadCount();
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    // each thread needs its own image buffer
+    numThreads = qMin( numThreads, ( to - from + 1 ) / qwtMinDotsPerThread );
+    numThreads = qMax( numThreads, 1 );
+#endif
+
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+    QVector< QwtColoredDotsJob > jobs( numThreads );
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        QwtColoredDotsJob& job = jobs[i];
+
+        job.series = data();
+        job.from = from + i * numPoints;
+        job.to = ( i == numThreads - 1 ) ? to : job.from + numPoints - 1;
+        job.xMap = xMap;
+        job.yMap = yMap;
+        job.rect = rect;
+        job.colorMap = colorMap;
+        job.colorRange = m_data->colorRange;
+        job.lookupTable = lookupTable.isNull() ? NULL : &lookupTable;
+        job.colorTable256 = m_data->colorTable.isEmpty()
+            ? NULL : m_data->colorTable.constData();
+
+        // the first chunk is painted directly into the image
+        job.bits = ( i == 0 ) ? reinterpret_cast< QRgb* >( image.bits() ) : NULL;
+    }
+
+#if QWT_USE_THREADS
+    QVector< QFuture< void > > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( int i = 1; i < numThreads; i++ )
+        futures += QtConcurrent::run( &qwtRenderColoredDots, &jobs[i] );
+#endif
+
+    qwtRenderColoredDots( &jobs[0] );
+
+#if QWT_USE_THREADS
+    QRgb* bits = reinterpret_cast< QRgb* >( image.bits() );
+    const int numPixels = rect.width() * rect.height();
+
+    for ( int i = 0; i < futures.size(); i++ )
+    {
+        futures[i].waitForFinished();
+
+        const QRgb* buffer = jobs[i + 1].buffer.constData();
+        for ( int j = 0; j < numPixels; j++ )
+        {
+            if ( buffer[j] != 0u )
+                bits[j] = buffer[j];
+        }
+    }
+#endif
+
+    m_data->colorTable.clear();
+
+    return image;
+}
+
+/*!
+   Draw a subset of the points as symbols
+
+   The symbols are painted from a QwtSymbolAtlas with variants
+   for 256 colors of the color map. When a symbolSizeRange()
+   has been set, the atlas has variants for 64 colors and 8 sizes.
+
+   \param painter Painter
+   \param symbol Symbol
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas
+   \param from Index of the first sample to be painted
+   \param to Index of the last sample to be painted. If to < 0 the
+         series will be painted to its last sample.
+
+   \sa drawSeries(), setSymbol(), setSymbolSizeRange()
+ */
+void QwtPlotSpectroCurve::drawSymbols( QPainter* painter, const QwtSymbol& symbol,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    const QwtInterval& colorRange = m_data->colorRange;
+    if ( !colorRange.isValid() )
+        return;
+
+    const QwtColorMap* colorMap = m_data->colorMap;
+
+    const QwtInterval& sizeRange = m_data->symbolSizeRange;
+
+    const int numColors = sizeRange.isValid()
+        ? qwtNumSizedSymbolColors : qwtNumSymbolColors;
+
+    QwtSymbolAtlas& atlas = m_data->symbolAtlas;
+    atlas.setColorTable( colorMap->colorTable( numColors ) );
+
+    QVector< QSize > sizes;
+    if ( sizeRange.isValid() )
+    {
+        const QSize sz = symbol.size();
+        const double aspectRatio = ( sz.width() > 0 && sz.height() > 0 )
+            ? double( sz.height() ) / sz.width() : 1.0;
+
+        sizes.reserve( qwtNumSymbolSizes );
+        for ( int i = 0; i < qwtNumSymbolSizes; i++ )
+        {
+            const double extent = sizeRange.minValue() +
+                i * sizeRange.width() / ( qwtNumSymbolSizes - 1 );
+
+            const int w = qMax( qRound( extent ), 1 );
+            sizes += QSize( w, qMax( qRound( w * aspectRatio ), 1 ) );
+        }
+    }
+    atlas.setSizes( sizes );
+
+    QRectF clipRect;
+    if ( m_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints )
+    {
+        QSize sz = symbol.boundingRect().size();
+        for ( int i = 0; i < sizes.size(); i++ )
+            sz = sz.expandedTo( sizes[i] + QSize( 2, 2 ) * symbol.pen().widthF() );
+
+        const qreal mw = 0.5 * sz.width() + 1;
+        const qreal mh = 0.5 * sz.height() + 1;
+
+        clipRect = canvasRect.adjusted( -mw, -mh, mw, mh );
+    }
+
+    const QwtSeriesData< QwtPoint3D >* series = data();
+
+    const int chunkSize = 512;
+
+    QwtPoint3D samples[ chunkSize ];
+    QPointF points[ chunkSize ];
+    double zValues[ chunkSize ];
+    uint indices[ chunkSize ];
+    unsigned char colorIndexes[ chunkSize ];
+    unsigned char sizeIndexes[ chunkSize ];
+
+    for ( int i0 = from; i0 <= to; i0 += chunkSize )
+    {
+        const int n = qMin( chunkSize, to - i0 + 1 );
+        series->fetch( i0, n, samples );
+
+        int numPoints = 0;
+        for ( int j = 0; j < n; j++ )
+        {
+            const QwtPoint3D& sample = samples[j];
+
+            const QPointF pos( xMap.transform( sample.x() ),
+                yMap.transform( sample.y() ) );
+
+            if ( clipRect.isValid() && !clipRect.contains( pos ) )
+                continue;
+
+            points[numPoints] = pos;
+            zValues[numPoints] = sample.z();
+
+            if ( !sizes.isEmpty() )
+            {
+                int sizeIndex = 0;
+
+                const double f = ( sample.z() - colorRange.minValue() )
+                    / colorRange.width();
+
+                if ( f > 0.0 )
+                    sizeIndex = qMin( int( f * qwtNumSymbolSizes ), qwtNumSymbolSizes - 1 );
+
+                sizeIndexes[numPoints] = sizeIndex;
+            }
+
+            numPoints++;
+        }
+
+        colorMap->colorIndices( numColors, colorRange,
+            zValues, indices, numPoints );
+
+        for ( int j = 0; j < numPoints; j++ )
+            colorIndexes[j] = static_cast< unsigned char >( indices[j] );
+
+        atlas.drawSymbols( painter, symbol, points, colorIndexes,
+            sizes.isEmpty() ? NULL : sizeIndexes, numPoints );
+    }
+}
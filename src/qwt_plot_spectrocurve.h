@@ -14,10 +14,20 @@
 #include "qwt_plot_seriesitem.h"
 
 class QwtColorMap;
+class QwtSymbol;
+class QImage;
 
 /*!
     \brief Curve that displays 3D points as dots, where the z coordinate is
            mapped to a color.
+
+    When a symbol has been assigned, the points are displayed as symbols,
+    where the z coordinate is mapped to the color of the symbol and
+    optionally to its size. The variants of the symbol are quantized
+    and prerendered by a QwtSymbolAtlas, so that even large scatter plots
+    can be painted with a couple of QPainter::drawPixmapFragments() calls.
+
+    \sa setSymbol(), setSymbolSizeRange()
  */
 class QWT_EXPORT QwtPlotSpectroCurve
     : public QwtPlotSeriesItem
@@ -28,7 +38,20 @@ class QWT_EXPORT QwtPlotSpectroCurve
     enum PaintAttribute
     {
         //! Clip points outside the canvas rectangle
-        ClipPoints = 1
+        ClipPoints = 1,
+
+        /*!
+           Render the dots to a temporary image and paint the image.
+           The colors are looked up from a table and the points are mapped
+           in parallel threads ( see QwtPlotItem::setRenderThreadCount() ).
+
+           This is a very special optimization for huge scatter plots,
+           that has only an effect, when painting to a paint device
+           in integer coordinates with a pen width <= 1. Then each point
+           sets one pixel, what includes, that the colors of overlapping
+           points are not blended.
+         */
+        ImageBuffer = 2
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -60,14 +83,27 @@ class QWT_EXPORT QwtPlotSpectroCurve
     void setPenWidth( double );
     double penWidth() const;
 
+    void setSymbol( QwtSymbol* );
+    const QwtSymbol* symbol() const;
+
+    void setSymbolSizeRange( const QwtInterval& );
+    QwtInterval symbolSizeRange() const;
+
   protected:
     virtual void drawDots( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect, int from, int to ) const;
 
+    virtual void drawSymbols( QPainter*, const QwtSymbol&,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const;
+
   private:
     void init();
 
+    QImage renderDots( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRect&, int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -8,16 +8,23 @@
  *****************************************************************************/
 
 #include "qwt_plot_spectrogram.h"
+#include "qwt_plot.h"
 #include "qwt_painter.h"
 #include "qwt_interval.h"
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
 #include "qwt_math.h"
+#include "qwt_cache_registry.h"
 
 #include <qimage.h>
 #include <qpen.h>
+#include <qmap.h>
+#include <qpolygon.h>
 #include <qpainter.h>
 #include <qthread.h>
+#include <qmutex.h>
+#include <qlist.h>
+#include <qvector.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
 
@@ -28,6 +35,7 @@
 #endif
 
 #include <algorithm>
+#include <typeinfo>
 
 static inline bool qwtIsNaN( double d )
 {
@@ -45,12 +53,125 @@ static inline bool qwtIsNaN( double d )
     }
 }
 
+// number of colors, when choosing the color table automatically
+static const int qwtAutoColorTableSize = 4096;
+
+static bool qwtSameTransformation( const QwtTransform* t1, const QwtTransform* t2 )
+{
+    if ( t1 == NULL || t2 == NULL )
+        return t1 == t2;
+
+    // QwtPlot::canvasMap() returns maps with copies of the transformation
+
+    return typeid( *t1 ) == typeid( *t2 )
+        && t1->transform( 2.0 ) == t2->transform( 2.0 )
+        && t1->transform( 10.0 ) == t2->transform( 10.0 );
+}
+
+static bool qwtSameMap( const QwtScaleMap& map1, const QwtScaleMap& map2 )
+{
+    return map1.s1() == map2.s1() && map1.s2() == map2.s2()
+        && map1.p1() == map2.p1() && map1.p2() == map2.p2()
+        && qwtSameTransformation( map1.transformation(), map2.transformation() );
+}
+
+namespace
+{
+    /*
+        The values of an image, as they have been sampled from
+        the raster data. The value of the pixel ( col, row ) has been
+        requested for the position, that is mapped to ( col, row ).
+     */
+    class ValueGrid
+    {
+      public:
+        bool matches( uint revision,
+            const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+            const QRectF& area, const QSize& size ) const
+        {
+            return this->revision == revision
+                && this->area == area && this->size == size
+                && qwtSameMap( this->xMap, xMap )
+                && qwtSameMap( this->yMap, yMap );
+        }
+
+        bool covers( uint revision, const QRectF& rect ) const
+        {
+            if ( this->revision != revision )
+                return false;
+
+            // the contour lines are calculated with a small margin
+            const double margin = 3.0;
+
+            const QRectF r = QwtScaleMap::transform( xMap, yMap, rect ).normalized();
+
+            return r.left() >= -margin && r.top() >= -margin
+                && r.right() <= size.width() + margin
+                && r.bottom() <= size.height() + margin;
+        }
+
+        qint64 memoryUsage() const
+        {
+            return qint64( values.size() ) * sizeof( float );
+        }
+
+        uint revision;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF area;
+        QSize size;
+
+        QVector< float > values;
+    };
+
+    /*
+        Raster data, that looks up the values of a ValueGrid,
+        so that the contour lines can be calculated without
+        sampling the original data again.
+     */
+    class ValueGridData : public QwtRasterData
+    {
+      public:
+        ValueGridData( const ValueGrid& grid, const QwtRasterData* data )
+            : m_grid( grid )
+            , m_data( data )
+        {
+            setAttribute( WithoutGaps, data->testAttribute( WithoutGaps ) );
+        }
+
+        virtual QwtInterval interval( Qt::Axis axis ) const QWT_OVERRIDE
+        {
+            return m_data->interval( axis );
+        }
+
+        virtual double value( double x, double y ) const QWT_OVERRIDE
+        {
+            const int numColumns = m_grid.size.width();
+
+            const int col = qBound( 0,
+                qRound( m_grid.xMap.transform( x ) ), numColumns - 1 );
+
+            const int row = qBound( 0,
+                qRound( m_grid.yMap.transform( y ) ), m_grid.size.height() - 1 );
+
+            return m_grid.values[ row * numColumns + col ];
+        }
+
+      private:
+        const ValueGrid& m_grid;
+        const QwtRasterData* m_data;
+    };
+}
+
 class QwtPlotSpectrogram::PrivateData
 {
   public:
     PrivateData()
         : data( NULL )
         , colorTableSize( 0 )
+        , valueCacheEnabled( false )
+        , cacheEntry( this )
     {
         colorMap = new QwtLinearColorMap();
         displayMode = ImageMode;
@@ -69,19 +190,76 @@ class QwtPlotSpectrogram::PrivateData
 
     void updateColorTable()
     {
+        lookupTable.reset();
+
         if ( colorMap->format() == QwtColorMap::Indexed )
         {
             colorTable = colorMap->colorTable256();
         }
         else
         {
-            if ( colorTableSize == 0 )
+            int numColors = colorTableSize;
+            if ( numColors < 0 )
+            {
+                numColors = QwtColorLookupTable::isSupported( colorMap )
+                    ? qwtAutoColorTableSize : 0;
+            }
+
+            if ( numColors == 0 )
                 colorTable.clear();
             else
-                colorTable = colorMap->colorTable( colorTableSize );
+                colorTable = colorMap->colorTable( numColors );
+
+            if ( numColors > 1 && QwtColorLookupTable::isSupported( colorMap ) )
+                lookupTable.setColorMap( colorMap, numColors );
         }
     }
 
+    QwtInterval colorRange() const
+    {
+        if ( colorInterval.isValid() )
+            return colorInterval;
+
+        return data->interval( Qt::ZAxis );
+    }
+
+    // Helper class to pass a tile to QtConcurrent::run()
+    class Tile
+    {
+      public:
+        const PrivateData* data;
+
+        const QwtScaleMap* xMap;
+        const QwtScaleMap* yMap;
+
+        QRect rect;
+        QImage* image;
+
+        // coordinates of the columns/rows, indexed by image position
+        const double* xValues;
+        const double* yValues;
+
+        // values of the complete image, row by row
+        const float* cachedValues;
+        float* sampledValues;
+    };
+
+    static void renderTile( Tile* );
+
+    void colorizeRow( const QwtColorLookupTable&, const QwtInterval& range,
+        bool hasGaps, const double* values, int numValues,
+        uint* indices, uchar* scanLine, int offset ) const;
+
+    bool findValues( uint revision,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& area, const QSize& size, QVector< float >& values );
+
+    bool findGrid( uint revision, const QRectF& rect, ValueGrid& grid );
+    void insertGrid( const ValueGrid&, qint64 limit );
+    void clearGrids();
+
+    void updateRevision( uint oldRevision, uint newRevision );
+
     QwtRasterData* data;
     QwtColorMap* colorMap;
     DisplayModes displayMode;
@@ -92,8 +270,316 @@ class QwtPlotSpectrogram::PrivateData
 
     int colorTableSize;
     QVector< QRgb > colorTable;
+    QwtColorLookupTable lookupTable;
+
+    struct ContourCache
+    {
+        ContourCache()
+            : valid( false )
+            , revision( 0 )
+        {
+        }
+
+        bool valid;
+
+        // the key of the cached lines
+        uint revision;
+        QRectF area;
+        QSize raster;
+        QwtRasterData::ConrecFlags conrecFlags;
+
+        // lines for all levels, that have been calculated so far
+        QwtRasterData::ContourLines lines;
+    } contourCache;
+
+    QwtInterval colorInterval;
+    bool valueCacheEnabled;
+
+    struct ValueCache
+    {
+        QMutex mutex;
+
+        // the most recently used grid first
+        QList< ValueGrid > grids;
+    } valueCache;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::RasterCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            QMutexLocker locker( &m_data->valueCache.mutex );
+            m_data->valueCache.grids.clear();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
+/*
+    Plot coordinates of the pixels [from, from + count[ in values[from ...].
+    On logarithmic or other nonlinear scales each of them is an expensive
+    transformation, so they are calculated once for all tiles and rows.
+ */
+static void qwtPixelCoordinates( const QwtScaleMap& map,
+    int from, int count, QVector< double >& values )
+{
+    values.resize( from + count );
+
+    double* v = values.data() + from;
+    for ( int i = 0; i < count; i++ )
+        v[i] = from + i;
+
+    map.invTransform( v, v, count );
+}
+
+void QwtPlotSpectrogram::PrivateData::renderTile( Tile* tile )
+{
+    const PrivateData* d = tile->data;
+    const QRect& rect = tile->rect;
+
+    const QwtInterval range = d->colorRange();
+    if ( range.width() <= 0.0 )
+        return;
+
+    const bool hasGaps = !d->data->testAttribute( QwtRasterData::WithoutGaps );
+
+    QwtColorLookupTable lookupTable = d->lookupTable;
+    if ( !lookupTable.isNull() )
+        lookupTable.setInterval( range );
+
+    const int numColumns = rect.width();
+    const int stride = tile->image->width();
+
+    QVector< double > rowValues( numColumns );
+    double* values = rowValues.data();
+
+    QVector< uint > rowIndices( numColumns );
+
+    const double* xValues = NULL;
+    QwtRasterData::RenderContext* context = NULL;
+
+    if ( tile->cachedValues == NULL )
+    {
+        xValues = tile->xValues + rect.left();
+
+        /*
+            All scanlines of the tile share the same x coordinates, and
+            the values of a scanline are requested with one call of
+            QwtRasterData::values()
+         */
+        context = d->data->createRenderContext(
+            QwtScaleMap::invTransform( *tile->xMap, *tile->yMap, QRectF( rect ) ).normalized(),
+            rect.size() );
+
+        context->setColumns( xValues, numColumns );
+    }
+
+    for ( int y = rect.top(); y <= rect.bottom(); y++ )
+    {
+        const int offset = y * stride + rect.left();
+
+        if ( context )
+        {
+            context->values( tile->yValues[y], xValues, numColumns, values );
+
+            if ( tile->sampledValues )
+            {
+                float* v = tile->sampledValues + offset;
+                for ( int i = 0; i < numColumns; i++ )
+                    v[i] = static_cast< float >( values[i] );
+            }
+        }
+        else
+        {
+            const float* v = tile->cachedValues + offset;
+            for ( int i = 0; i < numColumns; i++ )
+                values[i] = v[i];
+        }
+
+        d->colorizeRow( lookupTable, range, hasGaps, values, numColumns,
+            rowIndices.data(), tile->image->scanLine( y ), rect.left() );
+    }
+
+    delete context;
+}
+
+void QwtPlotSpectrogram::PrivateData::colorizeRow(
+    const QwtColorLookupTable& lookupTable, const QwtInterval& range,
+    bool hasGaps, const double* values, int numValues,
+    uint* indices, uchar* scanLine, int offset ) const
+{
+    if ( !lookupTable.isNull() )
+    {
+        QRgb* line = reinterpret_cast< QRgb* >( scanLine ) + offset;
+
+        for ( int i = 0; i < numValues; i++ )
+        {
+            const double value = values[i];
+
+            if ( hasGaps && qwtIsNaN( value ) )
+                *line++ = 0u;
+            else
+                *line++ = lookupTable.rgb( value );
+        }
+    }
+    else if ( colorMap->format() == QwtColorMap::RGB )
+    {
+        QRgb* line = reinterpret_cast< QRgb* >( scanLine ) + offset;
+
+        const int numColors = colorTable.size();
+        if ( numColors == 0 )
+        {
+            // gaps are mapped to 0u by the color map
+            colorMap->rgbValues( range, values, line, numValues );
+        }
+        else
+        {
+            colorMap->colorIndices( numColors, range, values, indices, numValues );
+
+            const QRgb* rgbTable = colorTable.constData();
+            for ( int i = 0; i < numValues; i++ )
+                line[i] = rgbTable[ indices[i] ];
+
+            if ( hasGaps )
+            {
+                for ( int i = 0; i < numValues; i++ )
+                {
+                    if ( qwtIsNaN( values[i] ) )
+                        line[i] = 0u;
+                }
+            }
+        }
+    }
+    else if ( colorMap->format() == QwtColorMap::Indexed )
+    {
+        // gaps are mapped to the index 0 by the color map
+        colorMap->colorIndices( 256, range, values, indices, numValues );
+
+        unsigned char* line = scanLine + offset;
+        for ( int i = 0; i < numValues; i++ )
+            line[i] = static_cast< unsigned char >( indices[i] );
+    }
+}
+
+bool QwtPlotSpectrogram::PrivateData::findValues( uint revision,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& area, const QSize& size, QVector< float >& values )
+{
+    bool found = false;
+
+    {
+        QMutexLocker locker( &valueCache.mutex );
+
+        QList< ValueGrid >& grids = valueCache.grids;
+        for ( int i = 0; i < grids.size(); i++ )
+        {
+            if ( grids[i].matches( revision, xMap, yMap, area, size ) )
+            {
+                grids.move( i, 0 );
+                values = grids.first().values;
+
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if ( found )
+        cacheEntry.touch();
+
+    return found;
+}
+
+bool QwtPlotSpectrogram::PrivateData::findGrid(
+    uint revision, const QRectF& rect, ValueGrid& grid )
+{
+    QMutexLocker locker( &valueCache.mutex );
+
+    const QList< ValueGrid >& grids = valueCache.grids;
+    for ( int i = 0; i < grids.size(); i++ )
+    {
+        if ( grids[i].covers( revision, rect ) )
+        {
+            grid = grids[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void QwtPlotSpectrogram::PrivateData::insertGrid(
+    const ValueGrid& grid, qint64 limit )
+{
+    qint64 usage = 0;
+
+    {
+        QMutexLocker locker( &valueCache.mutex );
+
+        QList< ValueGrid >& grids = valueCache.grids;
+        grids.prepend( grid );
+
+        for ( int i = 0; i < grids.size(); )
+        {
+            const qint64 bytes = grids[i].memoryUsage();
+
+            // grids of other revisions will never be requested again
+            if ( grids[i].revision != grid.revision
+                || ( i > 0 && usage + bytes > limit ) )
+            {
+                grids.removeAt( i );
+                continue;
+            }
+
+            usage += bytes;
+            i++;
+        }
+    }
+
+    // the registry might call purge(), so the mutex has to be unlocked
+    cacheEntry.setMemoryUsage( usage );
+    cacheEntry.touch();
+}
+
+void QwtPlotSpectrogram::PrivateData::clearGrids()
+{
+    {
+        QMutexLocker locker( &valueCache.mutex );
+        valueCache.grids.clear();
+    }
+
+    cacheEntry.setMemoryUsage( 0 );
+}
+
+void QwtPlotSpectrogram::PrivateData::updateRevision(
+    uint oldRevision, uint newRevision )
+{
+    {
+        QMutexLocker locker( &valueCache.mutex );
+
+        QList< ValueGrid >& grids = valueCache.grids;
+        for ( int i = 0; i < grids.size(); i++ )
+        {
+            if ( grids[i].revision == oldRevision )
+                grids[i].revision = newRevision;
+        }
+    }
+
+    if ( contourCache.valid && contourCache.revision == oldRevision )
+        contourCache.revision = newRevision;
+}
+
 /*!
    Sets the following item attributes:
    - QwtPlotItem::AutoScale: true
@@ -119,6 +605,9 @@ QwtPlotSpectrogram::QwtPlotSpectrogram( const QString& title )
 //! Destructor
 QwtPlotSpectrogram::~QwtPlotSpectrogram()
 {
+    // stop tiles being rendered in the background
+    invalidateCache();
+
     delete m_data;
 }
 
@@ -179,6 +668,8 @@ void QwtPlotSpectrogram::setColorMap( QwtColorMap* colorMap )
     if ( colorMap == NULL )
         return;
 
+    invalidateColors();
+
     if ( colorMap != m_data->colorMap )
     {
         delete m_data->colorMap;
@@ -187,8 +678,6 @@ void QwtPlotSpectrogram::setColorMap( QwtColorMap* colorMap )
 
     m_data->updateColorTable();
 
-    invalidateCache();
-
     legendChanged();
     itemChanged();
 }
@@ -210,11 +699,16 @@ const QwtColorMap* QwtPlotSpectrogram::colorMap() const
     precalculated color table.
 
     Setting a table size > 0 enables using a color table, while setting
-    the size to 0 disables it.
+    the size to 0 disables it. A negative size enables a table of 4096 colors
+    for the color maps, where this is supported by QwtColorLookupTable
+    ( the color maps of Qwt, but not classes derived from them ),
+    and no table for all other color maps.
 
-    The default size = 0, and no color table is used.
+    The default size = 0, what means the colors are calculated
+    by the color map without quantization.
 
-    \param numColors Number of colors. 0 means not using a color table
+    \param numColors Number of colors. 0 means not using a color table,
+                     a negative value for automatic mode
     \note The colorTableSize has no effect when using a color table
           of QwtColorMap::Indexed, where the size is always 256.
 
@@ -223,16 +717,18 @@ const QwtColorMap* QwtPlotSpectrogram::colorMap() const
  */
 void QwtPlotSpectrogram::setColorTableSize( int numColors )
 {
-    numColors = qMax( numColors, 0 );
+    numColors = qMax( numColors, -1 );
     if ( numColors != m_data->colorTableSize )
     {
+        invalidateColors();
+
         m_data->colorTableSize = numColors;
         m_data->updateColorTable();
-        invalidateCache();
     }
 }
 /*!
-    \return Size of the color table, 0 means not using a color table
+    \return Size of the color table, 0 means not using a color table,
+            -1 choosing the table automatically
     \sa QwtColorMap::colorTable(), setColorTableSize()
  */
 int QwtPlotSpectrogram::colorTableSize() const
@@ -240,6 +736,100 @@ int QwtPlotSpectrogram::colorTableSize() const
     return m_data->colorTableSize;
 }
 
+/*!
+   \brief Set the interval, that is mapped to the colors of the color map
+
+   Changing the color interval - f.e. for adjusting the contrast
+   with a slider - does not affect the values of the data. When
+   the value cache is enabled, the image is colored from the cached
+   values without sampling the data again.
+
+   The default setting is an invalid interval, what means that
+   the interval of the data for the z axis is used.
+
+   \param interval Color interval, an invalid interval to use
+                   data()->interval( Qt::ZAxis )
+
+   \sa colorInterval(), setColorMap(), setValueCacheEnabled()
+ */
+void QwtPlotSpectrogram::setColorInterval( const QwtInterval& interval )
+{
+    if ( interval != m_data->colorInterval )
+    {
+        invalidateColors();
+        m_data->colorInterval = interval;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Interval, that is mapped to the colors of the color map.
+           An invalid interval means that data()->interval( Qt::ZAxis )
+           is used.
+   \sa setColorInterval()
+ */
+QwtInterval QwtPlotSpectrogram::colorInterval() const
+{
+    return m_data->colorInterval;
+}
+
+/*!
+   \brief En/Disable caching the values of the rendered images
+
+   When enabled the values, that have been sampled from the data,
+   are kept together with the rendered images. When only the color map,
+   the color interval or the size of the color table have changed the images
+   are rendered from the cached values and the contour lines are
+   calculated from them without sampling the data again.
+
+   The values are stored as float - one for each pixel of an image.
+   The cached values of all images are limited by cacheLimit() and
+   are accounted as QwtCacheRegistry::RasterCache.
+
+   The default setting is false.
+
+   \param on On/Off
+   \note The cache relies on invalidateCache(), invalidateRegion()
+         or scrollRows() being called, whenever the data has changed.
+   \note As the contour lines are calculated from the cached values
+         an implementation of QwtRasterData::contourLines() is bypassed.
+
+   \sa isValueCacheEnabled(), setColorInterval(), setCacheLimit()
+ */
+void QwtPlotSpectrogram::setValueCacheEnabled( bool on )
+{
+    if ( on != m_data->valueCacheEnabled )
+    {
+        m_data->valueCacheEnabled = on;
+
+        if ( !on )
+            m_data->clearGrids();
+    }
+}
+
+/*!
+   \return True, when the values of the rendered images are cached
+   \sa setValueCacheEnabled()
+ */
+bool QwtPlotSpectrogram::isValueCacheEnabled() const
+{
+    return m_data->valueCacheEnabled;
+}
+
+/*
+   Invalidate the rendered images, but keep the cached
+   values and contour lines, that do not depend on the colors
+ */
+void QwtPlotSpectrogram::invalidateColors()
+{
+    const uint oldRevision = revision();
+    invalidateCache();
+
+    m_data->updateRevision( oldRevision, revision() );
+}
+
 /*!
    Build and assign the default pen for the contour lines
 
@@ -305,7 +895,7 @@ QPen QwtPlotSpectrogram::contourPen( double level ) const
     if ( m_data->data == NULL || m_data->colorMap == NULL )
         return QPen();
 
-    const QwtInterval intensityRange = m_data->data->interval(Qt::ZAxis);
+    const QwtInterval intensityRange = m_data->colorRange();
     const QColor c( m_data->colorMap->rgb( intensityRange, level ) );
 
     return QPen( c );
@@ -394,10 +984,11 @@ void QwtPlotSpectrogram::setData( QwtRasterData* data )
 {
     if ( data != m_data->data )
     {
+        invalidateCache();
+
         delete m_data->data;
         m_data->data = data;
 
-        invalidateCache();
         itemChanged();
     }
 }
@@ -465,6 +1056,9 @@ QRectF QwtPlotSpectrogram::pixelHint( const QRectF& area ) const
    \brief Render an image from data and color map.
 
    For each pixel of area the value is mapped into a color.
+   When the value cache is enabled and the values for the maps, the area
+   and the size of the image have been sampled before, the cached
+   values are mapped into colors instead.
 
    \param xMap X-Scale Map
    \param yMap Y-Scale Map
@@ -475,7 +1069,7 @@ QRectF QwtPlotSpectrogram::pixelHint( const QRectF& area ) const
            on the color map.
 
    \sa QwtRasterData::value(), QwtColorMap::rgb(),
-       QwtColorMap::colorIndex()
+       QwtColorMap::colorIndex(), setValueCacheEnabled()
  */
 QImage QwtPlotSpectrogram::renderImage(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -487,7 +1081,7 @@ QImage QwtPlotSpectrogram::renderImage(
         return QImage();
     }
 
-    const QwtInterval intensityRange = m_data->data->interval( Qt::ZAxis );
+    const QwtInterval intensityRange = m_data->colorRange();
     if ( !intensityRange.isValid() )
         return QImage();
 
@@ -499,13 +1093,47 @@ QImage QwtPlotSpectrogram::renderImage(
     if ( m_data->colorMap->format() == QwtColorMap::Indexed )
         image.setColorTable( m_data->colorMap->colorTable256() );
 
-    m_data->data->initRaster( area, image.size() );
+    const uint currentRevision = revision();
+
+    QVector< float > values;
+    bool isCached = false;
+
+    if ( m_data->valueCacheEnabled )
+    {
+        isCached = m_data->findValues( currentRevision,
+            xMap, yMap, area, imageSize, values );
+
+        if ( !isCached )
+            values.resize( imageSize.width() * imageSize.height() );
+    }
+
+    if ( !isCached )
+        m_data->data->initRaster( area, image.size() );
 
 #if DEBUG_RENDER
     QElapsedTimer time;
     time.start();
 #endif
 
+    QVector< double > xValues;
+    QVector< double > yValues;
+
+    if ( !isCached )
+    {
+        qwtPixelCoordinates( xMap, 0, imageSize.width(), xValues );
+        qwtPixelCoordinates( yMap, 0, imageSize.height(), yValues );
+    }
+
+    PrivateData::Tile tile;
+    tile.data = m_data;
+    tile.xMap = &xMap;
+    tile.yMap = &yMap;
+    tile.image = &image;
+    tile.xValues = xValues.constData();
+    tile.yValues = yValues.constData();
+    tile.cachedValues = isCached ? values.constData() : NULL;
+    tile.sampledValues = ( !isCached && !values.isEmpty() ) ? values.data() : NULL;
+
 #if !defined( QT_NO_QFUTURE )
     uint numThreads = renderThreadCount();
 
@@ -517,26 +1145,24 @@ QImage QwtPlotSpectrogram::renderImage(
 
     const int numRows = imageSize.height() / numThreads;
 
+    QVector< PrivateData::Tile > tiles( numThreads, tile );
+
     QVector< QFuture< void > > futures;
     futures.reserve( numThreads - 1 );
 
     for ( uint i = 0; i < numThreads; i++ )
     {
-        QRect tile( 0, i * numRows, image.width(), numRows );
+        PrivateData::Tile& t = tiles[i];
+
+        t.rect = QRect( 0, i * numRows, image.width(), numRows );
         if ( i == numThreads - 1 )
         {
-            tile.setHeight( image.height() - i * numRows );
-            renderTile( xMap, yMap, tile, &image );
+            t.rect.setHeight( image.height() - i * numRows );
+            PrivateData::renderTile( &t );
         }
         else
         {
-            futures += QtConcurrent::run(
-#if QT_VERSION >= 0x060000
-                &QwtPlotSpectrogram::renderTile, this,
-#else
-                this, &QwtPlotSpectrogram::renderTile,
-#endif
-                xMap, yMap, tile, &image );
+            futures += QtConcurrent::run( &PrivateData::renderTile, &t );
         }
     }
 
@@ -544,8 +1170,8 @@ QImage QwtPlotSpectrogram::renderImage(
         futures[i].waitForFinished();
 
 #else
-    const QRect tile( 0, 0, image.width(), image.height() );
-    renderTile( xMap, yMap, tile, &image );
+    tile.rect = QRect( 0, 0, image.width(), image.height() );
+    PrivateData::renderTile( &tile );
 #endif
 
 #if DEBUG_RENDER
@@ -553,7 +1179,23 @@ QImage QwtPlotSpectrogram::renderImage(
     qDebug() << "renderImage" << imageSize << elapsed;
 #endif
 
-    m_data->data->discardRaster();
+    if ( !isCached )
+    {
+        m_data->data->discardRaster();
+
+        if ( m_data->valueCacheEnabled )
+        {
+            ValueGrid grid;
+            grid.revision = currentRevision;
+            grid.xMap = xMap;
+            grid.yMap = yMap;
+            grid.area = area;
+            grid.size = imageSize;
+            grid.values = values;
+
+            m_data->insertGrid( grid, qint64( cacheLimit() ) * 1024 );
+        }
+    }
 
     return image;
 }
@@ -568,79 +1210,34 @@ QImage QwtPlotSpectrogram::renderImage(
     \param yMap Y-Scale Map
     \param tile Geometry of the tile in image coordinates
     \param image Image to be rendered
+
+    \note The values of the tile are requested through a
+          QwtRasterData::RenderContext, that is created for the tile.
+          The coordinates of its columns are announced by
+          QwtRasterData::RenderContext::setColumns().
  */
 void QwtPlotSpectrogram::renderTile(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QRect& tile, QImage* image ) const
 {
-    const QwtInterval range = m_data->data->interval( Qt::ZAxis );
-    if ( range.width() <= 0.0 )
-        return;
-
-    const bool hasGaps = !m_data->data->testAttribute( QwtRasterData::WithoutGaps );
-
-    if ( m_data->colorMap->format() == QwtColorMap::RGB )
-    {
-        const int numColors = m_data->colorTable.size();
-        const QRgb* rgbTable = m_data->colorTable.constData();
-        const QwtColorMap* colorMap = m_data->colorMap;
-
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
-
-            QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y ) );
-            line += tile.left();
-
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
-
-                const double value = m_data->data->value( tx, ty );
-
-                if ( hasGaps && qwtIsNaN( value ) )
-                {
-                    *line++ = 0u;
-                }
-                else if ( numColors == 0 )
-                {
-                    *line++ = colorMap->rgb( range, value );
-                }
-                else
-                {
-                    const uint index = colorMap->colorIndex( numColors, range, value );
-                    *line++ = rgbTable[index];
-                }
-            }
-        }
-    }
-    else if ( m_data->colorMap->format() == QwtColorMap::Indexed )
-    {
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
-
-            unsigned char* line = image->scanLine( y );
-            line += tile.left();
-
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
-
-                const double value = m_data->data->value( tx, ty );
-
-                if ( hasGaps && qwtIsNaN( value ) )
-                {
-                    *line++ = 0;
-                }
-                else
-                {
-                    const uint index = m_data->colorMap->colorIndex( 256, range, value );
-                    *line++ = static_cast< unsigned char >( index );
-                }
-            }
-        }
-    }
+    QVector< double > xValues;
+    QVector< double > yValues;
+
+    qwtPixelCoordinates( xMap, tile.left(), tile.width(), xValues );
+    qwtPixelCoordinates( yMap, tile.top(), tile.height(), yValues );
+
+    PrivateData::Tile t;
+    t.data = m_data;
+    t.xMap = &xMap;
+    t.yMap = &yMap;
+    t.rect = tile;
+    t.image = image;
+    t.xValues = xValues.constData();
+    t.yValues = yValues.constData();
+    t.cachedValues = NULL;
+    t.sampledValues = NULL;
+
+    PrivateData::renderTile( &t );
 }
 
 /*!
@@ -679,11 +1276,22 @@ QSize QwtPlotSpectrogram::contourRasterSize(
 /*!
    Calculate contour lines
 
+   The lines are cached for the combination of rect, raster,
+   the CONREC flags and the revision() of the data. When only
+   the contour levels have changed, the lines of the new levels are
+   calculated, while the lines of the other levels are taken from the cache.
+
    \param rect Rectangle, where to calculate the contour lines
    \param raster Raster, used by the CONREC algorithm
    \return Calculated contour lines
 
-   \sa contourLevels(), setConrecFlag(),
+   When the value cache is enabled and the values of a rendered
+   image cover rect, the lines are calculated from these values.
+
+   \note The cache relies on invalidateCache(), invalidateRegion()
+         or scrollRows() being called, whenever the data has changed.
+
+   \sa contourLevels(), setConrecFlag(), setValueCacheEnabled(),
        QwtRasterData::contourLines()
  */
 QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
@@ -692,8 +1300,71 @@ QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
     if ( m_data->data == NULL )
         return QwtRasterData::ContourLines();
 
-    return m_data->data->contourLines( rect, raster,
-        m_data->contourLevels, m_data->conrecFlags );
+    PrivateData::ContourCache& cache = m_data->contourCache;
+
+    if ( !cache.valid || cache.revision != revision()
+        || cache.area != rect || cache.raster != raster
+        || cache.conrecFlags != m_data->conrecFlags )
+    {
+        cache.lines.clear();
+
+        cache.revision = revision();
+        cache.area = rect;
+        cache.raster = raster;
+        cache.conrecFlags = m_data->conrecFlags;
+        cache.valid = true;
+    }
+
+    const QList< double >& levels = m_data->contourLevels;
+
+    // the lines of a level do not depend on the other levels,
+    // so only the levels, that are not in the cache, are calculated
+
+    QList< double > missingLevels;
+    for ( int i = 0; i < levels.size(); i++ )
+    {
+        if ( !cache.lines.contains( levels[i] ) )
+            missingLevels += levels[i];
+    }
+
+    if ( !missingLevels.isEmpty() )
+    {
+        QwtRasterData::ContourLines lines;
+
+        ValueGrid grid;
+        if ( m_data->valueCacheEnabled && m_data->findGrid( revision(), rect, grid ) )
+        {
+            // calculating the lines from the values of a rendered image
+            const ValueGridData gridData( grid, m_data->data );
+
+            lines = gridData.contourLines(
+                rect, raster, missingLevels, m_data->conrecFlags );
+        }
+        else
+        {
+            m_data->data->initRaster( rect, raster );
+
+            lines = m_data->data->contourLines(
+                rect, raster, missingLevels, m_data->conrecFlags );
+
+            m_data->data->discardRaster();
+        }
+
+        for ( int i = 0; i < missingLevels.size(); i++ )
+            cache.lines.insert( missingLevels[i], lines.value( missingLevels[i] ) );
+    }
+
+    QwtRasterData::ContourLines lines;
+    for ( int i = 0; i < levels.size(); i++ )
+        lines.insert( levels[i], cache.lines.value( levels[i] ) );
+
+    if ( cache.lines.size() > lines.size() )
+    {
+        // forget the lines of levels, that have been removed
+        cache.lines = lines;
+    }
+
+    return lines;
 }
 
 /*!
@@ -728,6 +1399,11 @@ void QwtPlotSpectrogram::drawContourLines( QPainter* painter,
         painter->setPen( pen );
 
         const QPolygonF& lines = contourLines[level];
+
+        // connected segments ( QwtRasterData::MarchingSquares )
+        // are painted as one polyline
+
+        QPolygonF polyline;
         for ( int i = 0; i < lines.size(); i += 2 )
         {
             const QPointF p1( xMap.transform( lines[i].x() ),
@@ -735,8 +1411,20 @@ void QwtPlotSpectrogram::drawContourLines( QPainter* painter,
             const QPointF p2( xMap.transform( lines[i + 1].x() ),
                 yMap.transform( lines[i + 1].y() ) );
 
-            QwtPainter::drawLine( painter, p1, p2 );
+            if ( i == 0 || lines[i] != lines[i - 1] )
+            {
+                if ( polyline.size() > 0 )
+                    QwtPainter::drawPolyline( painter, polyline );
+
+                polyline.clear();
+                polyline += p1;
+            }
+
+            polyline += p2;
         }
+
+        if ( polyline.size() > 0 )
+            QwtPainter::drawPolyline( painter, polyline );
     }
 }
 
@@ -748,8 +1436,11 @@ void QwtPlotSpectrogram::drawContourLines( QPainter* painter,
    \param yMap Maps y-values into pixel coordinates.
    \param canvasRect Contents rectangle of the canvas in painter coordinates
 
+   \note The contour lines are not painted, while the plot reduces
+         the render quality for QwtPlot::NoContours
+
    \sa setDisplayMode(), renderImage(),
-      QwtPlotRasterItem::draw(), drawContourLines()
+      QwtPlotRasterItem::draw(), drawContours()
  */
 void QwtPlotSpectrogram::draw( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -760,31 +1451,51 @@ void QwtPlotSpectrogram::draw( QPainter* painter,
 
     if ( m_data->displayMode & ContourMode )
     {
-        // Add some pixels at the borders
-        const int margin = 2;
-        QRectF rasterRect( canvasRect.x() - margin, canvasRect.y() - margin,
-            canvasRect.width() + 2 * margin, canvasRect.height() + 2 * margin );
+        if ( plot() && plot()->testQualityReduction( QwtPlot::NoContours ) )
+            return;
 
-        QRectF area = QwtScaleMap::invTransform( xMap, yMap, rasterRect );
+        drawContours( painter, xMap, yMap, canvasRect );
+    }
+}
 
-        const QRectF br = boundingRect();
-        if ( br.isValid() )
-        {
-            area &= br;
-            if ( area.isEmpty() )
-                return;
+/*!
+   \brief Calculate and draw the contour lines
 
-            rasterRect = QwtScaleMap::transform( xMap, yMap, area );
-        }
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
 
-        QSize raster = contourRasterSize( area, rasterRect.toRect() );
-        raster = raster.boundedTo( rasterRect.toRect().size() );
-        if ( raster.isValid() )
-        {
-            const QwtRasterData::ContourLines lines =
-                renderContourLines( area, raster );
+   \sa contourRasterSize(), renderContourLines(), drawContourLines()
+ */
+void QwtPlotSpectrogram::drawContours( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    // Add some pixels at the borders
+    const int margin = 2;
+    QRectF rasterRect( canvasRect.x() - margin, canvasRect.y() - margin,
+        canvasRect.width() + 2 * margin, canvasRect.height() + 2 * margin );
 
-            drawContourLines( painter, xMap, yMap, lines );
-        }
+    QRectF area = QwtScaleMap::invTransform( xMap, yMap, rasterRect );
+
+    const QRectF br = boundingRect();
+    if ( br.isValid() )
+    {
+        area &= br;
+        if ( area.isEmpty() )
+            return;
+
+        rasterRect = QwtScaleMap::transform( xMap, yMap, area );
+    }
+
+    QSize raster = contourRasterSize( area, rasterRect.toRect() );
+    raster = raster.boundedTo( rasterRect.toRect().size() );
+    if ( raster.isValid() )
+    {
+        const QwtRasterData::ContourLines lines =
+            renderContourLines( area, raster );
+
+        drawContourLines( painter, xMap, yMap, lines );
     }
 }
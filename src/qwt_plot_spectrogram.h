@@ -30,6 +30,13 @@ template< typename T > class QList;
 
    In ContourMode contour lines are painted for the contour levels.
 
+   When the values are expensive to calculate - f.e. computed or
+   loaded from disk - the values of the rendered images can be cached
+   ( see setValueCacheEnabled() ). Then changing the color map,
+   the color interval or the size of the color table only maps the
+   cached values to colors again, and the contour lines are calculated
+   from the cached values too.
+
    \sa QwtRasterData, QwtColorMap, QwtPlotItem::setRenderThreadCount()
  */
 
@@ -68,6 +75,12 @@ class QWT_EXPORT QwtPlotSpectrogram : public QwtPlotRasterItem
     void setColorTableSize( int numColors );
     int colorTableSize() const;
 
+    void setColorInterval( const QwtInterval& );
+    QwtInterval colorInterval() const;
+
+    void setValueCacheEnabled( bool );
+    bool isValueCacheEnabled() const;
+
     virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE;
     virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
 
@@ -105,10 +118,16 @@ class QWT_EXPORT QwtPlotSpectrogram : public QwtPlotRasterItem
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtRasterData::ContourLines& ) const;
 
+    void drawContours( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
     void renderTile( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRect& tile, QImage* ) const;
 
   private:
+    void invalidateColors();
+
     class PrivateData;
     PrivateData* m_data;
 };
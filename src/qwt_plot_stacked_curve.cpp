@@ -0,0 +1,733 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_stacked_curve.h"
+#include "qwt_scale_map.h"
+#include "qwt_painter.h"
+#include "qwt_clipper.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_graphic.h"
+#include "qwt_legend_data.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qpen.h>
+#include <qbrush.h>
+
+#include <algorithm>
+
+class QwtPlotStackedCurve::PrivateData
+{
+  public:
+    PrivateData()
+        : baseline( 0.0 )
+        , paintAttributes( QwtPlotStackedCurve::ClipPolygons |
+            QwtPlotStackedCurve::FilterPoints )
+        , yMin( 0.0 )
+        , yMax( 0.0 )
+    {
+    }
+
+    int rowCount() const
+    {
+        int count = xData.size();
+        for ( int i = 0; i < yData.size(); i++ )
+            count = qMin( count, yData[i].size() );
+
+        return count;
+    }
+
+    void invalidateBounds()
+    {
+        totals.clear();
+    }
+
+    QVector< double > xData;
+    QVector< QVector< double > > yData;
+
+    QVector< QPen > pens;
+    QVector< QBrush > brushes;
+    QList< QwtText > channelTitles;
+
+    double baseline;
+
+    QwtPlotStackedCurve::PaintAttributes paintAttributes;
+
+    /*
+        The sum of all channels for each sample and the y range
+        of all partial sums. Both are extended for appended samples.
+     */
+    mutable QVector< double > totals;
+    mutable double yMin;
+    mutable double yMax;
+};
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotStackedCurve::QwtPlotStackedCurve( const QString& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+/*!
+   Constructor
+   \param title Title of the item
+ */
+QwtPlotStackedCurve::QwtPlotStackedCurve( const QwtText& title )
+    : QwtPlotItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotStackedCurve::~QwtPlotStackedCurve()
+{
+    delete m_data;
+}
+
+void QwtPlotStackedCurve::init()
+{
+    m_data = new PrivateData;
+
+    setItemAttribute( QwtPlotItem::Legend, true );
+    setItemAttribute( QwtPlotItem::AutoScale, true );
+
+    setZ( 20.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotStackedCurve
+int QwtPlotStackedCurve::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotStackedCurve;
+}
+
+/*!
+   Specify an attribute how to draw the bands
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPlotStackedCurve::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+   \return True, when attribute is enabled
+   \sa setPaintAttribute()
+ */
+bool QwtPlotStackedCurve::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
+/*!
+   \brief Assign the x values and the values of all channels
+
+   \param xData Increasing x values, shared by all channels
+   \param yData Values for each channel
+
+   \note Only the samples, where all channels have a value,
+         are displayed.
+
+   \sa appendSample()
+ */
+void QwtPlotStackedCurve::setSamples( const QVector< double >& xData,
+    const QVector< QVector< double > >& yData )
+{
+    m_data->xData = xData;
+    m_data->yData = yData;
+
+    m_data->invalidateBounds();
+    samplesChanged();
+}
+
+/*!
+   \brief Append a sample
+
+   Only the values of the appended sample are processed, when
+   updating the bounding rectangle.
+
+   \param x X value, that needs to be greater or equal than
+            the x value of the previous sample
+   \param values Values for each channel. Missing values are
+                 treated as 0.
+
+   \sa setSamples(), clearSamples()
+ */
+void QwtPlotStackedCurve::appendSample( double x, const QVector< double >& values )
+{
+    // channels being shorter than the x values would hide the sample
+
+    const int count = m_data->rowCount();
+
+    m_data->xData.resize( count );
+    m_data->xData += x;
+
+    for ( int i = 0; i < m_data->yData.size(); i++ )
+    {
+        QVector< double >& yData = m_data->yData[i];
+
+        yData.resize( count );
+        yData += values.value( i, 0.0 );
+    }
+
+    // the channels and the legend are unchanged
+    itemChanged();
+}
+
+/*!
+   \brief Remove all samples
+
+   The number of channels is not changed.
+   \sa setSamples(), appendSample()
+ */
+void QwtPlotStackedCurve::clearSamples()
+{
+    m_data->xData.clear();
+    for ( int i = 0; i < m_data->yData.size(); i++ )
+        m_data->yData[i].clear();
+
+    m_data->invalidateBounds();
+    samplesChanged();
+}
+
+//! \return Number of samples, where all channels have a value
+int QwtPlotStackedCurve::sampleCount() const
+{
+    return m_data->rowCount();
+}
+
+/*!
+   \return x values, that are shared by all channels
+   \sa setSamples()
+ */
+QVector< double > QwtPlotStackedCurve::xData() const
+{
+    return m_data->xData;
+}
+
+/*!
+   \brief Set the number of channels
+
+   Additional channels have no values, channels beyond
+   count are removed.
+
+   \param count Number of channels
+   \sa channelCount(), setChannelData()
+ */
+void QwtPlotStackedCurve::setChannelCount( int count )
+{
+    count = qMax( count, 0 );
+    if ( count != m_data->yData.size() )
+    {
+        m_data->yData.resize( count );
+
+        m_data->invalidateBounds();
+        samplesChanged();
+    }
+}
+
+//! \return Number of channels
+int QwtPlotStackedCurve::channelCount() const
+{
+    return m_data->yData.size();
+}
+
+/*!
+   \brief Assign the values of a channel
+
+   The number of channels is increased, when channel >= channelCount().
+
+   \param channel Index of the channel
+   \param yData Values of the channel
+   \sa channelData(), setSamples()
+ */
+void QwtPlotStackedCurve::setChannelData(
+    int channel, const QVector< double >& yData )
+{
+    if ( channel < 0 )
+        return;
+
+    if ( channel >= m_data->yData.size() )
+        m_data->yData.resize( channel + 1 );
+
+    m_data->yData[channel] = yData;
+
+    m_data->invalidateBounds();
+    samplesChanged();
+}
+
+/*!
+   \param channel Index of the channel
+   \return Values of the channel
+   \sa setChannelData()
+ */
+QVector< double > QwtPlotStackedCurve::channelData( int channel ) const
+{
+    return m_data->yData.value( channel );
+}
+
+/*!
+   \brief Set the titles for the channels on the legend
+
+   \param titles Channel titles
+   \sa channelTitles(), legendData()
+ */
+void QwtPlotStackedCurve::setChannelTitles( const QList< QwtText >& titles )
+{
+    m_data->channelTitles = titles;
+
+    legendChanged();
+    itemChanged();
+}
+
+/*!
+   \return Channel titles
+   \sa setChannelTitles(), legendData()
+ */
+QList< QwtText > QwtPlotStackedCurve::channelTitles() const
+{
+    return m_data->channelTitles;
+}
+
+/*!
+   \brief Assign the pen for the upper boundary of a channel
+
+   \param channel Index of the channel
+   \param pen Pen
+   \sa pen(), setBrush()
+ */
+void QwtPlotStackedCurve::setPen( int channel, const QPen& pen )
+{
+    if ( channel < 0 )
+        return;
+
+    if ( channel >= m_data->pens.size() )
+        m_data->pens.resize( channel + 1 );
+
+    if ( pen != m_data->pens[channel] )
+    {
+        m_data->pens[channel] = pen;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \param channel Index of the channel
+   \return Pen for the upper boundary of the channel
+   \sa setPen()
+ */
+QPen QwtPlotStackedCurve::pen( int channel ) const
+{
+    return m_data->pens.value( channel );
+}
+
+/*!
+   \brief Assign the brush for filling the band of a channel
+
+   \param channel Index of the channel
+   \param brush Brush
+   \sa brush(), setPen()
+ */
+void QwtPlotStackedCurve::setBrush( int channel, const QBrush& brush )
+{
+    if ( channel < 0 )
+        return;
+
+    if ( channel >= m_data->brushes.size() )
+        m_data->brushes.resize( channel + 1 );
+
+    if ( brush != m_data->brushes[channel] )
+    {
+        m_data->brushes[channel] = brush;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+   \param channel Index of the channel
+   \return Brush for filling the band of the channel
+   \sa setBrush()
+ */
+QBrush QwtPlotStackedCurve::brush( int channel ) const
+{
+    return m_data->brushes.value( channel );
+}
+
+/*!
+   \brief Set the value, where the first channel is stacked on
+
+   The default setting is 0.0.
+
+   \param value Baseline
+   \sa baseline()
+ */
+void QwtPlotStackedCurve::setBaseline( double value )
+{
+    if ( value != m_data->baseline )
+    {
+        m_data->baseline = value;
+
+        m_data->invalidateBounds();
+        itemChanged();
+    }
+}
+
+/*!
+   \return Value, where the first channel is stacked on
+   \sa setBaseline()
+ */
+double QwtPlotStackedCurve::baseline() const
+{
+    return m_data->baseline;
+}
+
+void QwtPlotStackedCurve::samplesChanged()
+{
+    legendChanged();
+    itemChanged();
+}
+
+void QwtPlotStackedCurve::updateBounds() const
+{
+    const int numRows = m_data->rowCount();
+
+    int from = m_data->totals.size();
+    if ( from == numRows )
+        return;
+
+    if ( from == 0 )
+    {
+        m_data->yMin = m_data->yMax = m_data->baseline;
+        m_data->totals.reserve( numRows );
+    }
+
+    m_data->totals.resize( numRows );
+
+    const QVector< QVector< double > >& yData = m_data->yData;
+
+    for ( int i = from; i < numRows; i++ )
+    {
+        double sum = m_data->baseline;
+
+        for ( int channel = 0; channel < yData.size(); channel++ )
+        {
+            sum += yData[channel][i];
+
+            m_data->yMin = qMin( m_data->yMin, sum );
+            m_data->yMax = qMax( m_data->yMax, sum );
+        }
+
+        m_data->totals[i] = sum;
+    }
+}
+
+/*!
+   \return Bounding rectangle of all bands, including the baseline
+ */
+QRectF QwtPlotStackedCurve::boundingRect() const
+{
+    updateBounds();
+
+    const QVector< double >& totals = m_data->totals;
+    if ( totals.isEmpty() || m_data->yData.isEmpty() )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    const double x1 = m_data->xData.first();
+    const double x2 = m_data->xData[totals.size() - 1];
+
+    return QRectF( x1, m_data->yMin, x2 - x1, m_data->yMax - m_data->yMin );
+}
+
+QVector< int > QwtPlotStackedCurve::visibleIndexes(
+    const QwtScaleMap& xMap, int from, int to, bool doFilter ) const
+{
+    QVector< int > indexes;
+
+    if ( !doFilter )
+    {
+        indexes.resize( to - from + 1 );
+        for ( int i = from; i <= to; i++ )
+            indexes[i - from] = i;
+
+        return indexes;
+    }
+
+    const double* xData = m_data->xData.constData();
+    const double* totals = m_data->totals.constData();
+
+    // the samples of the same pixel column: first, min, max, last
+
+    int i = from;
+    while ( i <= to )
+    {
+        const int x = qRound( xMap.transform( xData[i] ) );
+
+        int iMin = i;
+        int iMax = i;
+
+        int j = i + 1;
+        for ( ; j <= to && qRound( xMap.transform( xData[j] ) ) == x; j++ )
+        {
+            if ( totals[j] < totals[iMin] )
+                iMin = j;
+
+            if ( totals[j] > totals[iMax] )
+                iMax = j;
+        }
+
+        const int iLast = j - 1;
+
+        indexes += i;
+
+        const int i1 = qMin( iMin, iMax );
+        const int i2 = qMax( iMin, iMax );
+
+        if ( i1 != i )
+            indexes += i1;
+
+        if ( i2 != i1 && i2 != iLast )
+            indexes += i2;
+
+        if ( iLast != i && iLast != i1 )
+            indexes += iLast;
+
+        i = j;
+    }
+
+    return indexes;
+}
+
+/*!
+   \brief Draw the bands of all channels
+
+   The range of the visible x values is found by a binary search.
+   The partial sums are calculated and mapped once for each boundary
+   and each visible sample. Then the bands are filled, before the upper
+   boundaries of the channels are painted with their pens.
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+ */
+void QwtPlotStackedCurve::draw( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    updateBounds();
+
+    const int numRows = m_data->totals.size();
+    const int numChannels = m_data->yData.size();
+
+    if ( numRows < 2 || numChannels == 0 )
+        return;
+
+    const double* values = m_data->xData.constData();
+
+    const double x1 = qMin( xMap.s1(), xMap.s2() );
+    const double x2 = qMax( xMap.s1(), xMap.s2() );
+
+    // including the samples outside, that are connected to the visible ones
+
+    int from = int( std::lower_bound( values, values + numRows, x1 ) - values );
+    int to = int( std::upper_bound( values, values + numRows, x2 ) - values );
+
+    from = qMax( from - 1, 0 );
+    to = qMin( to, numRows - 1 );
+
+    if ( from >= to )
+        return;
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool doFilter = doAlign && ( m_data->paintAttributes & FilterPoints );
+
+    const QVector< int > indexes = visibleIndexes( xMap, from, to, doFilter );
+    const int numPoints = indexes.size();
+
+    QRectF clipRect;
+    if ( m_data->paintAttributes & ClipPolygons )
+    {
+        qreal pw = 0.0;
+        for ( int channel = 0; channel < numChannels; channel++ )
+            pw = qMax( pw, QwtPainter::effectivePenWidth( pen( channel ) ) );
+
+        clipRect = canvasRect.adjusted( -pw, -pw, pw, pw );
+    }
+
+    // boundaries[0] is the baseline, boundaries[i + 1] the top of channel i
+
+    QVector< QPolygonF > boundaries( numChannels + 1 );
+    for ( int k = 0; k <= numChannels; k++ )
+        QwtScratchPool::acquire( boundaries[k], numPoints );
+
+    QVector< double > sums( numPoints, m_data->baseline );
+
+    double yBase = yMap.transform( m_data->baseline );
+    if ( doAlign )
+        yBase = qRound( yBase );
+
+    for ( int k = 0; k < numPoints; k++ )
+    {
+        double x = xMap.transform( values[ indexes[k] ] );
+        if ( doAlign )
+            x = qRound( x );
+
+        boundaries[0][k] = QPointF( x, yBase );
+    }
+
+    for ( int channel = 0; channel < numChannels; channel++ )
+    {
+        const double* yData = m_data->yData[channel].constData();
+
+        const QPolygonF& lower = boundaries[channel];
+        QPolygonF& upper = boundaries[channel + 1];
+
+        for ( int k = 0; k < numPoints; k++ )
+        {
+            sums[k] += yData[ indexes[k] ];
+
+            double y = yMap.transform( sums[k] );
+            if ( doAlign )
+                y = qRound( y );
+
+            upper[k] = QPointF( lower[k].x(), y );
+        }
+
+        const QBrush channelBrush = brush( channel );
+        if ( channelBrush.style() == Qt::NoBrush )
+            continue;
+
+        // the band: upper boundary forward, lower boundary backward
+
+        QPolygonF polygon;
+        QwtScratchPool::acquire( polygon, 2 * numPoints );
+
+        QPointF* points = polygon.data();
+        for ( int k = 0; k < numPoints; k++ )
+        {
+            points[k] = upper[k];
+            points[2 * numPoints - 1 - k] = lower[k];
+        }
+
+        if ( clipRect.isValid() )
+            QwtClipper::clipPolygonF( clipRect, polygon, true );
+
+        painter->setPen( Qt::NoPen );
+        painter->setBrush( channelBrush );
+
+        QwtPainter::drawPolygon( painter, polygon );
+
+        QwtScratchPool::release( polygon );
+    }
+
+    // the boundaries on top of the bands
+
+    painter->setBrush( Qt::NoBrush );
+
+    for ( int channel = 0; channel < numChannels; channel++ )
+    {
+        const QPen channelPen = pen( channel );
+        if ( channelPen.style() == Qt::NoPen )
+            continue;
+
+        painter->setPen( channelPen );
+
+        const QPolygonF& polyline = boundaries[channel + 1];
+
+        if ( clipRect.isValid() )
+        {
+            const QVector< QPolygonF > parts =
+                QwtClipper::clippedPolyline( clipRect, polyline );
+
+            for ( int k = 0; k < parts.size(); k++ )
+                QwtPainter::drawPolyline( painter, parts[k] );
+        }
+        else
+        {
+            QwtPainter::drawPolyline( painter, polyline );
+        }
+    }
+
+    for ( int k = 0; k <= numChannels; k++ )
+        QwtScratchPool::release( boundaries[k] );
+}
+
+/*!
+   \return One entry for each channel
+   \sa channelTitles(), legendIcon(), legendIconSize()
+ */
+QList< QwtLegendData > QwtPlotStackedCurve::legendData() const
+{
+    QList< QwtLegendData > list;
+
+    const int numChannels = m_data->yData.size();
+    list.reserve( numChannels );
+
+    for ( int i = 0; i < numChannels; i++ )
+    {
+        QwtLegendData data;
+
+        data.setValue( QwtLegendData::TitleRole,
+            QVariant::fromValue( m_data->channelTitles.value( i ) ) );
+
+        if ( !legendIconSize().isEmpty() )
+        {
+            data.setValue( QwtLegendData::IconRole,
+                QVariant::fromValue( legendIcon( i, legendIconSize() ) ) );
+        }
+
+        list += data;
+    }
+
+    return list;
+}
+
+/*!
+   \return Icon representing a channel on the legend
+
+   \param index Index of the channel
+   \param size Icon size
+
+   \return A rectangle filled with the brush and outlined
+           with the pen of the channel
+   \sa legendData()
+ */
+QwtGraphic QwtPlotStackedCurve::legendIcon( int index, const QSizeF& size ) const
+{
+    if ( size.isEmpty() )
+        return QwtGraphic();
+
+    QwtGraphic graphic;
+    graphic.setDefaultSize( size );
+    graphic.setRenderHint( QwtGraphic::RenderPensUnscaled, true );
+
+    QPainter painter( &graphic );
+    painter.setRenderHint( QPainter::Antialiasing,
+        testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    painter.setPen( pen( index ) );
+    painter.setBrush( brush( index ) );
+
+    QwtPainter::drawRect( &painter, QRectF( QPointF( 0.0, 0.0 ), size ) );
+
+    return graphic;
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_STACKED_CURVE_H
+#define QWT_PLOT_STACKED_CURVE_H
+
+#include "qwt_global.h"
+#include "qwt_plot_item.h"
+
+#include <qvector.h>
+#include <qlist.h>
+
+class QPen;
+class QBrush;
+
+/*!
+   \brief A plot item, that displays channels sharing the same x values
+          as stacked areas
+
+   Displaying stacked channels with QwtPlotCurve requires to calculate
+   the cumulative sums of all channels into N series and to fill
+   each curve down to the previous one.
+
+   QwtPlotStackedCurve stores one array of x values and N arrays
+   of y values. Channel i is displayed as the band between the sum
+   of the channels 0 to i - 1 and the sum of the channels 0 to i, starting
+   at the baseline(). The sums are calculated, when painting,
+   for the visible samples only. Each boundary between 2 bands is mapped
+   once and shared by the polygons of both bands.
+
+   The x values need to be increasing, so that the visible range can be
+   found by a binary search. With FilterPoints the samples are reduced to
+   the first, minimum, maximum and last sample of each pixel column,
+   where the extrema are those of the sum of all channels,
+   when painting in integer coordinates.
+
+   Samples can be appended by appendSample(). Only the values of the
+   appended samples are processed for the bounding rectangle.
+
+   \par Example
+   \code
+   QwtPlotStackedCurve* curve = new QwtPlotStackedCurve();
+   curve->setChannelCount( colors.size() );
+
+   for ( int i = 0; i < colors.size(); i++ )
+   {
+       curve->setPen( i, QPen( colors[i].darker() ) );
+       curve->setBrush( i, colors[i] );
+   }
+
+   curve->attach( plot );
+
+   ...
+
+   // when new values have been sampled
+   curve->appendSample( time, values );
+   \endcode
+   \endpar
+
+   \sa QwtPlotMultiCurve, QwtPlotCurve
+ */
+class QWT_EXPORT QwtPlotStackedCurve : public QwtPlotItem
+{
+  public:
+    /*!
+       Attributes to modify the drawing algorithm.
+       The default setting enables ClipPolygons | FilterPoints
+
+       \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        //! Clip the bands to the canvas before painting them
+        ClipPolygons = 0x01,
+
+        /*!
+           Reduce the samples of each pixel column to the first, minimum,
+           maximum and last sample of the sum of all channels. Has only
+           an effect, when painting in integer coordinates.
+         */
+        FilterPoints = 0x02
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
+    explicit QwtPlotStackedCurve( const QString& title = QString() );
+    explicit QwtPlotStackedCurve( const QwtText& title );
+
+    virtual ~QwtPlotStackedCurve();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
+    void setSamples( const QVector< double >& xData,
+        const QVector< QVector< double > >& yData );
+
+    void appendSample( double x, const QVector< double >& values );
+    void clearSamples();
+
+    int sampleCount() const;
+
+    QVector< double > xData() const;
+
+    void setChannelCount( int );
+    int channelCount() const;
+
+    void setChannelData( int channel, const QVector< double >& );
+    QVector< double > channelData( int channel ) const;
+
+    void setChannelTitles( const QList< QwtText >& );
+    QList< QwtText > channelTitles() const;
+
+    void setPen( int channel, const QPen& );
+    QPen pen( int channel ) const;
+
+    void setBrush( int channel, const QBrush& );
+    QBrush brush( int channel ) const;
+
+    void setBaseline( double );
+    double baseline() const;
+
+    virtual void draw( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual QList< QwtLegendData > legendData() const QWT_OVERRIDE;
+
+    virtual QwtGraphic legendIcon(
+        int index, const QSizeF& ) const QWT_OVERRIDE;
+
+  private:
+    void init();
+    void samplesChanged();
+    void updateBounds() const;
+
+    QVector< int > visibleIndexes( const QwtScaleMap& xMap,
+        int from, int to, bool doFilter ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotStackedCurve::PaintAttributes )
+
+#endif
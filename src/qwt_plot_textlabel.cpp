@@ -11,6 +11,7 @@
 #include "qwt_painter.h"
 #include "qwt_text.h"
 #include "qwt_math.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpaintengine.h>
@@ -55,6 +56,7 @@ class QwtPlotTextLabel::PrivateData
   public:
     PrivateData()
         : margin( 5 )
+        , cacheEntry( this )
     {
     }
 
@@ -62,6 +64,27 @@ class QwtPlotTextLabel::PrivateData
     int margin;
 
     QPixmap pixmap;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::PixmapCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->pixmap = QPixmap();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 /*!
@@ -239,6 +262,14 @@ void QwtPlotTextLabel::draw( QPainter* painter,
 
             QPainter pmPainter( &m_data->pixmap );
             m_data->text.draw( &pmPainter, r );
+            pmPainter.end();
+
+            m_data->cacheEntry.setMemoryUsage(
+                QwtCacheEntry::pixmapSize( m_data->pixmap ) );
+        }
+        else
+        {
+            m_data->cacheEntry.touch();
         }
 
         painter->drawPixmap( pixmapRect, m_data->pixmap );
@@ -270,4 +301,5 @@ QRectF QwtPlotTextLabel::textRect(
 void QwtPlotTextLabel::invalidateCache()
 {
     m_data->pixmap = QPixmap();
+    m_data->cacheEntry.setMemoryUsage( 0 );
 }
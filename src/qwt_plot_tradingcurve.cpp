@@ -13,6 +13,7 @@
 #include "qwt_text.h"
 #include "qwt_graphic.h"
 #include "qwt_math.h"
+#include "qwt_ohlc_series_data_pyramid.h"
 
 #include <qpainter.h>
 
@@ -28,6 +29,18 @@ static inline bool qwtIsSampleInside( const QwtOHLCSample& sample,
     return !isOffScreen;
 }
 
+namespace
+{
+    class QwtOHLCPosition
+    {
+      public:
+        inline double operator()( const QwtOHLCSample& sample ) const
+        {
+            return sample.time;
+        }
+    };
+}
+
 class QwtPlotTradingCurve::PrivateData
 {
   public:
@@ -397,6 +410,27 @@ void QwtPlotTradingCurve::drawSeries( QPainter* painter,
     if ( from > to )
         return;
 
+    if ( testSeriesAttribute( QwtPlotSeriesItem::OrderedSamples )
+        || data()->isMonotonic() )
+    {
+        // drawSymbols() ignores all samples outside of the canvas
+
+        double t1, t2;
+        if ( orientation() == Qt::Vertical )
+        {
+            t1 = xMap.invTransform( canvasRect.left() );
+            t2 = xMap.invTransform( canvasRect.right() );
+        }
+        else
+        {
+            t1 = yMap.invTransform( canvasRect.top() );
+            t2 = yMap.invTransform( canvasRect.bottom() );
+        }
+
+        qwtClipSampleRange( *data(), qMin( t1, t2 ), qMax( t1, t2 ),
+            QwtOHLCPosition(), from, to );
+    }
+
     painter->save();
 
     if ( m_data->symbolStyle != QwtPlotTradingCurve::NoSymbol )
@@ -408,6 +442,10 @@ void QwtPlotTradingCurve::drawSeries( QPainter* painter,
 /*!
    Draw symbols
 
+   When the data is a QwtOHLCSeriesDataPyramid with increasing time values
+   all samples, that are mapped to the same pixel are aggregated into
+   one symbol.
+
    \param painter Painter
    \param xMap x map
    \param yMap y map
@@ -415,7 +453,7 @@ void QwtPlotTradingCurve::drawSeries( QPainter* painter,
    \param from Index of the first point to be painted
    \param to Index of the last point to be painted
 
-   \sa drawSeries()
+   \sa drawSeries(), QwtOHLCSeriesDataPyramid::aggregatedSamples()
  */
 void QwtPlotTradingCurve::drawSymbols( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -461,9 +499,23 @@ void QwtPlotTradingCurve::drawSymbols( QPainter* painter,
 
     painter->setPen( pen );
 
+    QVector< QwtOHLCSample > aggregated;
+
+    const QwtOHLCSeriesDataPyramid* pyramid =
+        dynamic_cast< const QwtOHLCSeriesDataPyramid* >( data() );
+
+    const bool doAggregate = pyramid && pyramid->isMonotonic();
+    if ( doAggregate )
+    {
+        aggregated = pyramid->aggregatedSamples( *timeMap, 1.0, from, to );
+
+        from = 0;
+        to = aggregated.size() - 1;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
-        const QwtOHLCSample s = sample( i );
+        const QwtOHLCSample s = doAggregate ? aggregated[i] : sample( i );
 
         if ( !doClip || qwtIsSampleInside( s, tMin, tMax, vMin, vMax ) )
         {
@@ -9,6 +9,7 @@
 
 #include "qwt_plot_vectorfield.h"
 #include "qwt_vectorfield_symbol.h"
+#include "qwt_raster_vectorfield_data.h"
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
 #include "qwt_painter.h"
@@ -18,6 +19,9 @@
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qmap.h>
+#include <qmath.h>
+#include <qnumeric.h>
 #include <qdebug.h>
 #include <cstdlib>
 #include <limits>
@@ -235,8 +239,270 @@ namespace
 
         Entry* m_entries;
     };
+
+    // number of cells of the finest level of the pyramid in each direction
+    const int qwtPyramidSize = 512;
+
+    class FilterPyramid
+    {
+      public:
+        class Cell
+        {
+          public:
+            Cell()
+                : count( 0 )
+                , x( 0.0 )
+                , y( 0.0 )
+                , vx( 0.0 )
+                , vy( 0.0 )
+            {
+            }
+
+            inline void add( const Cell& other )
+            {
+                count += other.count;
+
+                x += other.x;
+                y += other.y;
+                vx += other.vx;
+                vy += other.vy;
+            }
+
+            quint32 count;
+
+            // sums in plot coordinates
+            double x;
+            double y;
+            double vx;
+            double vy;
+        };
+
+        inline bool isValid() const
+        {
+            return !levels.isEmpty();
+        }
+
+        void invalidate()
+        {
+            levels.clear();
+        }
+
+        void build( const QwtSeriesData< QwtVectorFieldSample >* series )
+        {
+            levels.clear();
+
+            rect = series->boundingRect();
+
+            if ( rect.width() <= 0.0 )
+                rect.setRect( rect.x() - 0.5, rect.y(), 1.0, rect.height() );
+
+            if ( rect.height() <= 0.0 )
+                rect.setRect( rect.x(), rect.y() - 0.5, rect.width(), 1.0 );
+
+            int n = qwtPyramidSize;
+
+            const double dx = rect.width() / n;
+            const double dy = rect.height() / n;
+
+            QVector< Cell > cells( n * n );
+
+            for ( size_t i = 0; i < series->size(); i++ )
+            {
+                const QwtVectorFieldSample sample = series->sample( i );
+                if ( sample.isNull() )
+                    continue;
+
+                const int col = qBound( 0, int( ( sample.x - rect.x() ) / dx ), n - 1 );
+                const int row = qBound( 0, int( ( sample.y - rect.y() ) / dy ), n - 1 );
+
+                Cell& cell = cells[ row * n + col ];
+
+                cell.count++;
+                cell.x += sample.x;
+                cell.y += sample.y;
+                cell.vx += sample.vx;
+                cell.vy += sample.vy;
+            }
+
+            levels += cells;
+
+            while ( n > 1 )
+            {
+                const QVector< Cell > lower = levels.last();
+                const int n2 = n / 2;
+
+                cells.fill( Cell(), n2 * n2 );
+
+                for ( int row = 0; row < n; row++ )
+                {
+                    for ( int col = 0; col < n; col++ )
+                        cells[ ( row / 2 ) * n2 + col / 2 ].add( lower[ row * n + col ] );
+                }
+
+                levels += cells;
+                n = n2;
+            }
+        }
+
+        QRectF rect;
+
+        // level 0: qwtPyramidSize x qwtPyramidSize cells
+        QVector< QVector< Cell > > levels;
+    };
+
+    // number of path elements, after which the batched arrows are painted
+    const int qwtMaxBatchElements = 20000;
+
+    // number of arrows, that are colored with one call of the color map
+    const int qwtColorChunkSize = 256;
 }
 
+class QwtPlotVectorField::SymbolBatch
+{
+  public:
+    SymbolBatch( QPainter* painter,
+            const QwtColorMap* colorMap, const QwtInterval& colorRange )
+        : m_painter( painter )
+        , m_colorMap( colorMap )
+        , m_colorRange( colorRange )
+        , m_numElements( 0 )
+    {
+    }
+
+    void add( const QPainterPath& symbolPath,
+        const QTransform& transform, double magnitude )
+    {
+        if ( m_colorMap )
+        {
+            // the colors are mapped in chunks with one call of the color map
+
+            PendingSymbol symbol;
+            symbol.path = symbolPath;
+            symbol.transform = transform;
+
+            m_pendingSymbols += symbol;
+            m_magnitudes += magnitude;
+
+            if ( m_magnitudes.size() >= qwtColorChunkSize )
+                mapColors();
+        }
+        else
+        {
+            addPath( m_paths[0u], symbolPath, transform );
+        }
+
+        m_numElements += symbolPath.elementCount();
+        if ( m_numElements >= qwtMaxBatchElements )
+            flush();
+    }
+
+    void flush()
+    {
+        mapColors();
+
+        for ( QMap< QRgb, QPainterPath >::const_iterator it = m_paths.constBegin();
+            it != m_paths.constEnd(); ++it )
+        {
+            if ( m_colorMap )
+            {
+                const QColor c( it.key() );
+
+                m_painter->setBrush( c );
+                m_painter->setPen( c );
+            }
+
+            m_painter->drawPath( it.value() );
+        }
+
+        m_paths.clear();
+        m_numElements = 0;
+    }
+
+  private:
+    void mapColors()
+    {
+        const int numSymbols = m_magnitudes.size();
+        if ( numSymbols == 0 )
+            return;
+
+        m_rgbs.resize( numSymbols );
+        m_colorMap->rgbValues( m_colorRange,
+            m_magnitudes.constData(), m_rgbs.data(), numSymbols );
+
+        for ( int i = 0; i < numSymbols; i++ )
+        {
+            const PendingSymbol& symbol = m_pendingSymbols[i];
+            addPath( m_paths[ m_rgbs[i] ], symbol.path, symbol.transform );
+        }
+
+        m_pendingSymbols.clear();
+        m_magnitudes.clear();
+    }
+
+    static void addPath( QPainterPath& path,
+        const QPainterPath& symbolPath, const QTransform& transform )
+    {
+        path.setFillRule( Qt::WindingFill );
+
+        const int numElements = symbolPath.elementCount();
+
+        for ( int i = 0; i < numElements; i++ )
+        {
+            const QPainterPath::Element& e = symbolPath.elementAt( i );
+            const QPointF pos = transform.map( QPointF( e.x, e.y ) );
+
+            switch ( e.type )
+            {
+                case QPainterPath::MoveToElement:
+                {
+                    path.moveTo( pos );
+                    break;
+                }
+                case QPainterPath::LineToElement:
+                {
+                    path.lineTo( pos );
+                    break;
+                }
+                case QPainterPath::CurveToElement:
+                {
+                    if ( i + 2 < numElements )
+                    {
+                        const QPainterPath::Element& e1 = symbolPath.elementAt( i + 1 );
+                        const QPainterPath::Element& e2 = symbolPath.elementAt( i + 2 );
+
+                        path.cubicTo( pos, transform.map( QPointF( e1.x, e1.y ) ),
+                            transform.map( QPointF( e2.x, e2.y ) ) );
+                    }
+
+                    i += 2;
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    class PendingSymbol
+    {
+      public:
+        QPainterPath path;
+        QTransform transform;
+    };
+
+    QPainter* m_painter;
+
+    const QwtColorMap* m_colorMap;
+    const QwtInterval m_colorRange;
+
+    int m_numElements;
+    QMap< QRgb, QPainterPath > m_paths;
+
+    QVector< PendingSymbol > m_pendingSymbols;
+    QVector< double > m_magnitudes;
+    QVector< QRgb > m_rgbs;
+};
+
 class QwtPlotVectorField::PrivateData
 {
   public:
@@ -283,6 +549,8 @@ class QwtPlotVectorField::PrivateData
 
     PaintAttributes paintAttributes;
     MagnitudeModes magnitudeModes;
+
+    mutable FilterPyramid filterPyramid;
 };
 
 /*!
@@ -485,6 +753,10 @@ void QwtPlotVectorField::setPaintAttribute(
     if ( m_data->paintAttributes != attributes )
     {
         m_data->paintAttributes = attributes;
+
+        if ( !( attributes & CacheFilterLevels ) )
+            m_data->filterPyramid.invalidate();
+
         itemChanged();
     }
 }
@@ -842,7 +1114,7 @@ void QwtPlotVectorField::drawSeries( QPainter* painter,
    \param from Index of the first sample to be painted
    \param to Index of the last sample to be painted
 
-   \sa setSymbol(), drawSymbol(), drawSeries()
+   \sa setSymbol(), drawSymbol(), drawSeries(), BatchSymbols, CacheFilterLevels
  */
 void QwtPlotVectorField::drawSymbols( QPainter* painter,
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -869,7 +1141,51 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
         painter->setBrush( m_data->brush );
     }
 
-    if ( ( m_data->paintAttributes & FilterVectors ) && !m_data->rasterSize.isEmpty() )
+    const bool isColored = testMagnitudeMode( MagnitudeAsColor );
+
+    SymbolBatch symbolBatch( painter,
+        isColored ? m_data->colorMap : NULL,
+        isColored ? magnitudeColorRange() : QwtInterval() );
+
+    SymbolBatch* batch = NULL;
+    if ( m_data->paintAttributes & BatchSymbols )
+    {
+        if ( !m_data->symbol->path().isEmpty() )
+            batch = &symbolBatch;
+    }
+
+    const bool doFilter = ( m_data->paintAttributes & FilterVectors )
+        && !m_data->rasterSize.isEmpty();
+
+    if ( doFilter )
+    {
+        const QwtRasterVectorFieldData* rasterData =
+            dynamic_cast< const QwtRasterVectorFieldData* >( series );
+
+        if ( rasterData )
+        {
+            drawRasterSymbols( painter, batch, rasterData, xMap, yMap, canvasRect );
+
+            if ( batch )
+                batch->flush();
+
+            return;
+        }
+    }
+
+    if ( doFilter && ( m_data->paintAttributes & CacheFilterLevels )
+        && from == 0 && to == int( dataSize() ) - 1 )
+    {
+        if ( drawFilteredSymbols( painter, batch, xMap, yMap, canvasRect ) )
+        {
+            if ( batch )
+                batch->flush();
+
+            return;
+        }
+    }
+
+    if ( doFilter )
     {
         const QRectF dataRect = QwtScaleMap::transform(
             xMap, yMap, boundingRect() );
@@ -925,11 +1241,19 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
                 yi = qRound( yi );
             }
 
-            const double vx = entry.vx / entry.count;
-            const double vy = entry.vy / entry.count;
+            double vx = entry.vx / entry.count;
+            double vy = entry.vy / entry.count;
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
+            if ( isInvertingX )
+                vx = -vx;
+
+            if ( isInvertingY )
+                vy = -vy;
+
+            if ( batch )
+                addSymbol( batch, xi, yi, vx, vy );
+            else
+                drawSymbol( painter, xi, yi, vx, vy );
         }
     }
     else
@@ -938,8 +1262,8 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
         {
             const QwtVectorFieldSample sample = series->sample( i );
 
-            // arrows with zero length are never drawn
-            if ( sample.isNull() )
+            // arrows with zero length and gaps are never drawn
+            if ( sample.isNull() || qIsNaN( sample.vx ) || qIsNaN( sample.vy ) )
                 continue;
 
             double xi = xMap.transform( sample.x );
@@ -957,13 +1281,266 @@ void QwtPlotVectorField::drawSymbols( QPainter* painter,
                     continue;
             }
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -sample.vx : sample.vx,
-                isInvertingY ? -sample.vy : sample.vy );
+            const double vx = isInvertingX ? -sample.vx : sample.vx;
+            const double vy = isInvertingY ? -sample.vy : sample.vy;
+
+            if ( batch )
+                addSymbol( batch, xi, yi, vx, vy );
+            else
+                drawSymbol( painter, xi, yi, vx, vy );
+        }
+    }
+
+    if ( batch )
+        batch->flush();
+}
+
+/*
+   Draw the averaged samples from the cached filter pyramid.
+   Returns false, when the pyramid can't be used for the maps.
+ */
+bool QwtPlotVectorField::drawFilteredSymbols( QPainter* painter,
+    SymbolBatch* batch, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    if ( xMap.transformation() || yMap.transformation() )
+        return false;
+
+    if ( xMap.sDist() == 0.0 || yMap.sDist() == 0.0 )
+        return false;
+
+    FilterPyramid& pyramid = m_data->filterPyramid;
+    if ( !pyramid.isValid() )
+        pyramid.build( data() );
+
+    const QRectF& rect = pyramid.rect;
+
+    // pixels per plot coordinate
+    const double sx = qAbs( xMap.pDist() / xMap.sDist() );
+    const double sy = qAbs( yMap.pDist() / yMap.sDist() );
+
+    const double rasterWidth = m_data->rasterSize.width();
+    const double rasterHeight = m_data->rasterSize.height();
+
+    int level = 0;
+    int n = qwtPyramidSize;
+
+    double dx = rect.width() / n;
+    double dy = rect.height() / n;
+
+    if ( dx * sx > rasterWidth || dy * sy > rasterHeight )
+        return false;
+
+    while ( n > 1 && ( dx * sx < rasterWidth || dy * sy < rasterHeight ) )
+    {
+        level++;
+        n /= 2;
+
+        dx *= 2.0;
+        dy *= 2.0;
+    }
+
+    const QRectF tr = QwtScaleMap::invTransform(
+        xMap, yMap, canvasRect ).normalized();
+
+    const int col0 = qBound( 0, qFloor( ( tr.left() - rect.x() ) / dx ), n - 1 );
+    const int col1 = qBound( 0, qFloor( ( tr.right() - rect.x() ) / dx ), n - 1 );
+    const int row0 = qBound( 0, qFloor( ( tr.top() - rect.y() ) / dy ), n - 1 );
+    const int row1 = qBound( 0, qFloor( ( tr.bottom() - rect.y() ) / dy ), n - 1 );
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const bool isInvertingX = xMap.isInverting();
+    const bool isInvertingY = yMap.isInverting();
+
+    const FilterPyramid::Cell* cells = pyramid.levels[level].constData();
+
+    for ( int row = row0; row <= row1; row++ )
+    {
+        for ( int col = col0; col <= col1; col++ )
+        {
+            const FilterPyramid::Cell& cell = cells[ row * n + col ];
+            if ( cell.count == 0 )
+                continue;
+
+            double xi = xMap.transform( cell.x / cell.count );
+            double yi = yMap.transform( cell.y / cell.count );
+
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
+
+            double vx = cell.vx / cell.count;
+            double vy = cell.vy / cell.count;
+
+            if ( isInvertingX )
+                vx = -vx;
+
+            if ( isInvertingY )
+                vy = -vy;
+
+            if ( batch )
+                addSymbol( batch, xi, yi, vx, vy );
+            else
+                drawSymbol( painter, xi, yi, vx, vy );
+        }
+    }
+
+    return true;
+}
+
+/*
+   Draw the vectors of raster data sampled at the centers
+   of the cells of the raster size.
+ */
+void QwtPlotVectorField::drawRasterSymbols( QPainter* painter,
+    SymbolBatch* batch, const QwtRasterVectorFieldData* rasterData,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    const QRectF dataRect = QwtScaleMap::transform(
+        xMap, yMap, rasterData->dataRect() ).normalized();
+
+    const QRectF area = dataRect & canvasRect;
+    if ( area.isEmpty() )
+        return;
+
+    // the cells are aligned to the data, so that the arrows move with it
+
+    const double dx = m_data->rasterSize.width();
+    const double dy = m_data->rasterSize.height();
+
+    const int maxCells = 1000;
+
+    const int col0 = qMax( qFloor( ( area.left() - dataRect.left() ) / dx ), 0 );
+    const int col1 = qMin( qCeil( ( area.right() - dataRect.left() ) / dx ),
+        qFloor( dataRect.width() / dx ) );
+
+    const int row0 = qMax( qFloor( ( area.top() - dataRect.top() ) / dy ), 0 );
+    const int row1 = qMin( qCeil( ( area.bottom() - dataRect.top() ) / dy ),
+        qFloor( dataRect.height() / dy ) );
+
+    const int numColumns = qMin( col1 - col0, maxCells );
+    const int numRows = qMin( row1 - row0, maxCells );
+
+    if ( numColumns <= 0 || numRows <= 0 )
+        return;
+
+    QVector< double > xPos( numColumns );
+    QVector< double > xValues( numColumns );
+
+    for ( int i = 0; i < numColumns; i++ )
+    {
+        xPos[i] = dataRect.left() + ( col0 + i + 0.5 ) * dx;
+        xValues[i] = xMap.invTransform( xPos[i] );
+    }
+
+    QVector< double > yPos( numRows );
+    QVector< double > yValues( numRows );
+
+    for ( int i = 0; i < numRows; i++ )
+    {
+        yPos[i] = dataRect.top() + ( row0 + i + 0.5 ) * dy;
+        yValues[i] = yMap.invTransform( yPos[i] );
+    }
+
+    const QVector< QwtVectorFieldSample > samples =
+        rasterData->sampleGrid( xValues, yValues, renderThreadCount() );
+
+    if ( samples.size() != numColumns * numRows )
+        return;
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const bool isInvertingX = xMap.isInverting();
+    const bool isInvertingY = yMap.isInverting();
+
+    const QwtVectorFieldSample* s = samples.constData();
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const QwtVectorFieldSample& sample = s[ row * numColumns + col ];
+
+            // gaps and arrows with zero length are never drawn
+            if ( qIsNaN( sample.vx ) || qIsNaN( sample.vy ) || sample.isNull() )
+                continue;
+
+            double xi = xPos[col];
+            double yi = yPos[row];
+
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
+
+            const double vx = isInvertingX ? -sample.vx : sample.vx;
+            const double vy = isInvertingY ? -sample.vy : sample.vy;
+
+            if ( batch )
+                addSymbol( batch, xi, yi, vx, vy );
+            else
+                drawSymbol( painter, xi, yi, vx, vy );
         }
     }
 }
 
+/*
+   Add the arrow for a sample to a batch. Like drawSymbol(), but the
+   transformed path of the symbol is added instead of being painted.
+ */
+void QwtPlotVectorField::addSymbol( SymbolBatch* batch,
+    double x, double y, double vx, double vy ) const
+{
+    const double magnitude = qwtVector2Magnitude( vx, vy );
+
+    QTransform transform = qwtSymbolTransformation( QTransform(),
+        x, y, vx, vy, magnitude );
+
+    QwtVectorFieldSymbol* symbol = m_data->symbol;
+
+    double length = 0.0;
+
+    if ( m_data->magnitudeModes & MagnitudeAsLength )
+        length = arrowLength( magnitude );
+
+    symbol->setLength( length );
+
+    if ( m_data->indicatorOrigin == OriginTail )
+        transform.translate( symbol->length(), 0.0 );
+    else if ( m_data->indicatorOrigin == OriginCenter )
+        transform.translate( 0.5 * symbol->length(), 0.0 );
+
+    batch->add( symbol->path(), transform, magnitude );
+}
+
+/*
+   Interval of the magnitudes, that is mapped by the color map,
+   when MagnitudeAsColor is enabled
+ */
+QwtInterval QwtPlotVectorField::magnitudeColorRange() const
+{
+    if ( m_data->magnitudeRange.isValid() )
+        return m_data->magnitudeRange;
+
+    if ( !m_data->boundingMagnitudeRange.isValid() )
+        m_data->boundingMagnitudeRange = qwtMagnitudeRange( data() );
+
+    return m_data->boundingMagnitudeRange;
+}
+
+/*
+   Color for a magnitude, when MagnitudeAsColor is enabled
+ */
+QColor QwtPlotVectorField::magnitudeColor( double magnitude ) const
+{
+    return m_data->colorMap->rgb( magnitudeColorRange(), magnitude );
+}
+
 /*!
    Draw a arrow/symbols at a specific position
 
@@ -1008,17 +1585,7 @@ void QwtPlotVectorField::drawSymbol( QPainter* painter,
     {
         // Determine color for arrow if colored by magnitude.
 
-        QwtInterval range = m_data->magnitudeRange;
-
-        if ( !range.isValid() )
-        {
-            if ( !m_data->boundingMagnitudeRange.isValid() )
-                m_data->boundingMagnitudeRange = qwtMagnitudeRange( data() );
-
-            range = m_data->boundingMagnitudeRange;
-        }
-
-        const QColor c = m_data->colorMap->rgb( range, magnitude );
+        const QColor c = magnitudeColor( magnitude );
 
 #if 1
         painter->setBrush( c );
@@ -1034,5 +1601,7 @@ void QwtPlotVectorField::drawSymbol( QPainter* painter,
 void QwtPlotVectorField::dataChanged()
 {
     m_data->boundingMagnitudeRange.invalidate();
+    m_data->filterPyramid.invalidate();
+
     QwtPlotSeriesItem::dataChanged();
 }
@@ -14,9 +14,11 @@
 #include "qwt_plot_seriesitem.h"
 
 class QwtVectorFieldSymbol;
+class QwtRasterVectorFieldData;
 class QwtColorMap;
 class QPen;
 class QBrush;
+class QColor;
 
 /*!
     \brief A plot item, that represents a vector field
@@ -59,9 +61,43 @@ class QWT_EXPORT QwtPlotVectorField
             that lie in the same cell of a grid that is determined by
             setting the rasterSize().
 
+            For a QwtRasterVectorFieldData the vector field is sampled
+            at the centers of the cells instead.
+
+            \sa setRasterSize()
+         */
+        FilterVectors        = 0x01,
+
+        /*!
+            All arrows are collected into paths, that are painted
+            by few calls of QPainter::drawPath() - one for each color,
+            when MagnitudeAsColor is enabled.
+
+            Batching is only possible for symbols, that can be represented
+            by a QwtVectorFieldSymbol::path(). As the arrows are not
+            painted one by one drawSymbol() is not called.
+            Overlapping arrows are united, so that their outlines
+            might be painted to other positions in the stacking order.
+         */
+        BatchSymbols         = 0x02,
+
+        /*!
+            In combination with FilterVectors the samples are aggregated
+            once into a pyramid of grids in plot coordinates, that
+            is reused for all replots until the samples are changed.
+            Each replot processes the cells of the level, where a cell
+            is at least as large as the rasterSize(), only.
+
+            As the cells are aligned to the bounding rectangle of the
+            samples and their sizes double from level to level, the
+            result differs from the filter without cache. When zooming
+            in, so that the cells of the finest level are larger than
+            the raster size, or for non linear scales the samples
+            are filtered without cache.
+
             \sa setRasterSize()
          */
-        FilterVectors        = 0x01
+        CacheFilterLevels    = 0x04
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -159,6 +195,23 @@ class QWT_EXPORT QwtPlotVectorField
   private:
     void init();
 
+    class SymbolBatch;
+
+    void addSymbol( SymbolBatch*,
+        double x, double y, double vx, double vy ) const;
+
+    bool drawFilteredSymbols( QPainter*, SymbolBatch*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
+    void drawRasterSymbols( QPainter*, SymbolBatch*,
+        const QwtRasterVectorFieldData*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
+    QwtInterval magnitudeColorRange() const;
+    QColor magnitudeColor( double magnitude ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
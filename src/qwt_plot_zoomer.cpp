@@ -441,6 +441,7 @@ void QwtPlotZoomer::rescale()
 
         plt->setAutoReplot( doReplot );
 
+        plt->notifyInteraction();
         plt->replot();
     }
 }
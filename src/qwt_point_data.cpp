@@ -9,6 +9,198 @@
 
 #include "qwt_point_data.h"
 
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    class QwtArrayBounds
+    {
+      public:
+        QwtArrayBounds()
+            : xMin( 0.0 )
+            , xMax( 0.0 )
+            , yMin( 0.0 )
+            , yMax( 0.0 )
+            , isMonotonic( true )
+        {
+        }
+
+        double xMin;
+        double xMax;
+        double yMin;
+        double yMax;
+
+        bool isMonotonic;
+    };
+
+    /*
+        The x and y arrays are scanned in separate loops without
+        branches, what can be vectorized by the compiler.
+     */
+    // gaps ( NaN ) fail all comparisons, but must not be the initial value
+
+    template< typename T >
+    inline size_t qwtFirstValue( const T* values, size_t from, size_t to )
+    {
+        size_t i = from;
+        while ( i + 1 < to && qIsNaN( values[i] ) )
+            i++;
+
+        return i;
+    }
+
+    template< typename T >
+    void qwtScanArrays( const T* x, const T* y,
+        size_t from, size_t to, QwtArrayBounds* bounds )
+    {
+        T xMin = x[ qwtFirstValue( x, from, to ) ];
+        T xMax = xMin;
+
+        // the first value is compared with the last value of the previous chunk
+        int decreasing = ( from > 0 && x[from] < x[from - 1] );
+
+        for ( size_t i = from + 1; i < to; i++ )
+        {
+            const T v = x[i];
+
+            xMin = ( v < xMin ) ? v : xMin;
+            xMax = ( v > xMax ) ? v : xMax;
+            decreasing |= ( v < x[i - 1] );
+        }
+
+        T yMin = y[ qwtFirstValue( y, from, to ) ];
+        T yMax = yMin;
+
+        for ( size_t i = from + 1; i < to; i++ )
+        {
+            const T v = y[i];
+
+            yMin = ( v < yMin ) ? v : yMin;
+            yMax = ( v > yMax ) ? v : yMax;
+        }
+
+        bounds->xMin = xMin;
+        bounds->xMax = xMax;
+        bounds->yMin = yMin;
+        bounds->yMax = yMax;
+        bounds->isMonotonic = ( decreasing == 0 );
+    }
+
+    template< typename T >
+    QRectF qwtArrayBoundingRect( const T* x, const T* y,
+        size_t size, bool* isMonotonic )
+    {
+        if ( isMonotonic )
+            *isMonotonic = false;
+
+        if ( size == 0 )
+            return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+        const size_t minChunkSize = 1000000;
+
+        int numChunks = 1;
+
+#if QWT_USE_THREADS
+        numChunks = int( qBound( size_t( 1 ), size / minChunkSize,
+            size_t( qMax( QThread::idealThreadCount(), 1 ) ) ) );
+#else
+        Q_UNUSED( minChunkSize )
+#endif
+
+        QVector< QwtArrayBounds > bounds( numChunks );
+
+        const size_t chunkSize = size / numChunks;
+
+#if QWT_USE_THREADS
+        QList< QFuture< void > > futures;
+#endif
+
+        for ( int i = 0; i < numChunks; i++ )
+        {
+            const size_t from = i * chunkSize;
+
+            if ( i == numChunks - 1 )
+            {
+                qwtScanArrays( x, y, from, size, &bounds[i] );
+            }
+            else
+            {
+#if QWT_USE_THREADS
+                futures += QtConcurrent::run( &qwtScanArrays< T >,
+                    x, y, from, from + chunkSize, &bounds[i] );
+#endif
+            }
+        }
+
+#if QWT_USE_THREADS
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#endif
+
+        QwtArrayBounds b = bounds[0];
+
+        for ( int i = 1; i < numChunks; i++ )
+        {
+            b.xMin = qMin( b.xMin, bounds[i].xMin );
+            b.xMax = qMax( b.xMax, bounds[i].xMax );
+            b.yMin = qMin( b.yMin, bounds[i].yMin );
+            b.yMax = qMax( b.yMax, bounds[i].yMax );
+            b.isMonotonic = b.isMonotonic && bounds[i].isMonotonic;
+        }
+
+        if ( isMonotonic )
+            *isMonotonic = b.isMonotonic;
+
+        return QRectF( b.xMin, b.yMin, b.xMax - b.xMin, b.yMax - b.yMin );
+    }
+}
+
+/*!
+   \brief Calculate the bounding rectangle of 2 arrays
+
+   For large arrays the work is distributed to several threads, that
+   scan their part of the arrays in loops, that can be vectorized.
+   In the same pass it is detected if the x values are increasing.
+
+   \param x Array of x values
+   \param y Array of y values
+   \param size Size of the arrays
+   \param isMonotonic When not NULL it is set to true, when the
+                      x values are increasing
+
+   \return Bounding rectangle
+   \sa QwtPointArrayData::boundingRect(), QwtCPointerData::boundingRect()
+ */
+QRectF qwtBoundingRect( const double* x, const double* y,
+    size_t size, bool* isMonotonic )
+{
+    return qwtArrayBoundingRect( x, y, size, isMonotonic );
+}
+
+/*!
+   \brief Calculate the bounding rectangle of 2 arrays
+
+   \param x Array of x values
+   \param y Array of y values
+   \param size Size of the arrays
+   \param isMonotonic When not NULL it is set to true, when the
+                      x values are increasing
+
+   \return Bounding rectangle
+   \sa qwtBoundingRect( const double*, const double*, size_t, bool* )
+ */
+QRectF qwtBoundingRect( const float* x, const float* y,
+    size_t size, bool* isMonotonic )
+{
+    return qwtArrayBoundingRect( x, y, size, isMonotonic );
+}
+
 /*!
    Constructor
 
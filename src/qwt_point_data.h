@@ -13,10 +13,26 @@
 #include "qwt_global.h"
 #include "qwt_series_data.h"
 
+#include <qnumeric.h>
 #include <cstring>
 
+QWT_EXPORT QRectF qwtBoundingRect( const double* x, const double* y,
+    size_t size, bool* isMonotonic = NULL );
+
+QWT_EXPORT QRectF qwtBoundingRect( const float* x, const float* y,
+    size_t size, bool* isMonotonic = NULL );
+
+template< typename T >
+QRectF qwtBoundingRect( const T* x, const T* y,
+    size_t size, bool* isMonotonic = NULL );
+
 /*!
    \brief Interface for iterating over two QVector<T> objects.
+
+   The bounding rectangle is calculated in one pass over the arrays,
+   that also detects if the x coordinates are increasing. In this
+   case isMonotonic() returns true and QwtPlotCurve restricts painting
+   to the visible samples, like for QwtPlotSeriesItem::OrderedSamples.
  */
 template< typename T >
 class QwtPointArrayData : public QwtSeriesData< QPointF >
@@ -28,16 +44,29 @@ class QwtPointArrayData : public QwtSeriesData< QPointF >
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
     const QVector< T >& xData() const;
     const QVector< T >& yData() const;
 
   private:
     QVector< T > m_x;
     QVector< T > m_y;
+
+    mutable bool m_isMonotonic;
 };
 
 /*!
    \brief Data class containing two pointers to memory blocks of T.
+
+   Like QwtPointArrayData the bounding rectangle and the order
+   of the x coordinates are calculated in one pass and cached.
+   When the values in memory are modified, a new QwtCPointerData
+   object has to be assigned to the curve.
  */
 template< typename T >
 class QwtCPointerData : public QwtSeriesData< QPointF >
@@ -48,6 +77,12 @@ class QwtCPointerData : public QwtSeriesData< QPointF >
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
     const T* xData() const;
     const T* yData() const;
 
@@ -55,6 +90,8 @@ class QwtCPointerData : public QwtSeriesData< QPointF >
     const T* m_x;
     const T* m_y;
     size_t m_size;
+
+    mutable bool m_isMonotonic;
 };
 
 /*!
@@ -73,6 +110,9 @@ class QwtValuePointData : public QwtSeriesData< QPointF >
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
     const QVector< T >& yData() const;
 
   private:
@@ -94,6 +134,9 @@ class QwtCPointerValueData : public QwtSeriesData< QPointF >
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
     const T* yData() const;
 
   private:
@@ -101,6 +144,121 @@ class QwtCPointerValueData : public QwtSeriesData< QPointF >
     size_t m_size;
 };
 
+/*!
+   \brief Data class referencing x and y values in memory with arbitrary strides
+
+   QwtStridedPointData gives zero copy access to samples, that are not
+   stored in 2 contiguous arrays - f.e. fields of interleaved records or
+   a column of a matrix. The values might be raw integer types ( f.e. ADC counts ),
+   that are converted on the fly by an affine transformation.
+
+   \code
+    struct Record
+    {
+        double time;
+        qint16 counts;
+        quint8 flags;
+    };
+
+    const Record* records = ...;
+
+    QwtStridedPointData< double, qint16 >* data =
+        new QwtStridedPointData< double, qint16 >(
+            &records[0].time, &records[0].counts, numRecords, sizeof( Record ) );
+
+    data->setYScaling( gain, offset ); // y = gain * counts + offset
+
+    curve->setData( data );
+   \endcode
+
+   \warning The programmer must assure that the memory blocks referenced
+            by the pointers remain valid during the lifetime of the
+            QwtStridedPointData object.
+
+   \sa QwtCPointerData, QwtStridedValueData
+ */
+template< typename TX, typename TY = TX >
+class QwtStridedPointData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtStridedPointData( const TX* x, const TY* y,
+        size_t size, size_t stride );
+
+    QwtStridedPointData( const TX* x, size_t xStride,
+        const TY* y, size_t yStride, size_t size );
+
+    void setXScaling( double factor, double offset = 0.0 );
+    void setYScaling( double factor, double offset = 0.0 );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
+    const TX* xData() const;
+    const TY* yData() const;
+
+    size_t xStride() const;
+    size_t yStride() const;
+
+  private:
+    const char* m_x;
+    const char* m_y;
+    size_t m_xStride;
+    size_t m_yStride;
+    size_t m_size;
+
+    double m_xFactor;
+    double m_xOffset;
+    double m_yFactor;
+    double m_yOffset;
+};
+
+/*!
+   \brief Data class referencing y values in memory with an arbitrary stride
+
+   The index of a sample is mapped by an affine transformation
+   into its x coordinate. So equidistant samples ( f.e. from an ADC
+   with a fixed sample rate ) can be displayed without storing
+   the x coordinates.
+
+   \warning The programmer must assure that the memory block referenced
+            by the pointer remains valid during the lifetime of the
+            QwtStridedValueData object.
+
+   \sa QwtCPointerValueData, QwtStridedPointData
+ */
+template< typename T >
+class QwtStridedValueData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtStridedValueData( const T* y, size_t size,
+        size_t stride = sizeof( T ) );
+
+    void setXScaling( double factor, double offset = 0.0 );
+    void setYScaling( double factor, double offset = 0.0 );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
+    const T* yData() const;
+    size_t yStride() const;
+
+  private:
+    const char* m_y;
+    size_t m_yStride;
+    size_t m_size;
+
+    double m_xFactor;
+    double m_xOffset;
+    double m_yFactor;
+    double m_yOffset;
+};
+
 /*!
    \brief Synthetic point data
 
@@ -201,6 +359,7 @@ QwtPointArrayData< T >::QwtPointArrayData(
         const QVector< T >& x, const QVector< T >& y )
     : m_x( x )
     , m_y( y )
+    , m_isMonotonic( false )
 {
 }
 
@@ -214,6 +373,7 @@ QwtPointArrayData< T >::QwtPointArrayData(
  */
 template< typename T >
 QwtPointArrayData< T >::QwtPointArrayData( const T* x, const T* y, size_t size )
+    : m_isMonotonic( false )
 {
     m_x.resize( size );
     std::memcpy( m_x.data(), x, size * sizeof( T ) );
@@ -241,6 +401,56 @@ QPointF QwtPointArrayData< T >::sample( size_t index ) const
     return QPointF( m_x[int( index )], m_y[int( index )] );
 }
 
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtPointArrayData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const T* x = m_x.constData() + from;
+    const T* y = m_y.constData() + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = QPointF( x[i], y[i] );
+}
+
+/*!
+   \brief Calculate the bounding rectangle
+
+   The rectangle is calculated once by qwtBoundingRect() for arrays
+   and cached.
+
+   \return Bounding rectangle
+   \sa isMonotonic()
+ */
+template< typename T >
+QRectF QwtPointArrayData< T >::boundingRect() const
+{
+    if ( this->cachedBoundingRect.width() < 0.0 )
+    {
+        this->cachedBoundingRect = qwtBoundingRect(
+            m_x.constData(), m_y.constData(), size(), &m_isMonotonic );
+    }
+
+    return this->cachedBoundingRect;
+}
+
+/*!
+   \return True, when the x coordinates are increasing
+   \sa boundingRect()
+ */
+template< typename T >
+bool QwtPointArrayData< T >::isMonotonic() const
+{
+    ( void )boundingRect();
+    return m_isMonotonic;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const QVector< T >& QwtPointArrayData< T >::xData() const
@@ -301,6 +511,23 @@ QPointF QwtValuePointData< T >::sample( size_t index ) const
     return QPointF( index, m_y[int( index )] );
 }
 
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtValuePointData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const T* y = m_y.constData() + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = QPointF( from + i, y[i] );
+}
+
 //! \return Array of the y-values
 template< typename T >
 const QVector< T >& QwtValuePointData< T >::yData() const
@@ -327,6 +554,7 @@ QwtCPointerData< T >::QwtCPointerData( const T* x, const T* y, size_t size )
     : m_x( x )
     , m_y( y )
     , m_size( size )
+    , m_isMonotonic( false )
 {
 }
 
@@ -349,6 +577,56 @@ QPointF QwtCPointerData< T >::sample( size_t index ) const
     return QPointF( m_x[int( index )], m_y[int( index )] );
 }
 
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtCPointerData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const T* x = m_x + from;
+    const T* y = m_y + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = QPointF( x[i], y[i] );
+}
+
+/*!
+   \brief Calculate the bounding rectangle
+
+   The rectangle is calculated once by qwtBoundingRect() for arrays
+   and cached.
+
+   \return Bounding rectangle
+   \sa isMonotonic()
+ */
+template< typename T >
+QRectF QwtCPointerData< T >::boundingRect() const
+{
+    if ( this->cachedBoundingRect.width() < 0.0 )
+    {
+        this->cachedBoundingRect =
+            qwtBoundingRect( m_x, m_y, m_size, &m_isMonotonic );
+    }
+
+    return this->cachedBoundingRect;
+}
+
+/*!
+   \return True, when the x coordinates are increasing
+   \sa boundingRect()
+ */
+template< typename T >
+bool QwtCPointerData< T >::isMonotonic() const
+{
+    ( void )boundingRect();
+    return m_isMonotonic;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const T* QwtCPointerData< T >::xData() const
@@ -402,6 +680,23 @@ QPointF QwtCPointerValueData< T >::sample( size_t index ) const
     return QPointF( index, m_y[ int( index ) ] );
 }
 
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtCPointerValueData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const T* y = m_y + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = QPointF( from + i, y[i] );
+}
+
 //! \return Array of the y-values
 template< typename T >
 const T* QwtCPointerValueData< T >::yData() const
@@ -409,4 +704,345 @@ const T* QwtCPointerValueData< T >::yData() const
     return m_y;
 }
 
+// reading values, that might be unaligned in packed records
+template< typename T >
+inline double qwtStridedValue( const char* data, size_t index, size_t stride )
+{
+    T value;
+    std::memcpy( &value, data + index * stride, sizeof( T ) );
+
+    return static_cast< double >( value );
+}
+
+/*!
+   Constructor for interleaved records
+
+   \param x Pointer to the x value of the first record
+   \param y Pointer to the y value of the first record
+   \param size Number of records
+   \param stride Distance between 2 records in bytes
+
+   \sa QwtPlotCurve::setData()
+ */
+template< typename TX, typename TY >
+QwtStridedPointData< TX, TY >::QwtStridedPointData(
+        const TX* x, const TY* y, size_t size, size_t stride )
+    : m_x( reinterpret_cast< const char* >( x ) )
+    , m_y( reinterpret_cast< const char* >( y ) )
+    , m_xStride( stride )
+    , m_yStride( stride )
+    , m_size( size )
+    , m_xFactor( 1.0 )
+    , m_xOffset( 0.0 )
+    , m_yFactor( 1.0 )
+    , m_yOffset( 0.0 )
+{
+}
+
+/*!
+   Constructor
+
+   \param x Pointer to the first x value
+   \param xStride Distance between 2 x values in bytes
+   \param y Pointer to the first y value
+   \param yStride Distance between 2 y values in bytes
+   \param size Number of samples
+
+   \sa QwtPlotCurve::setData()
+ */
+template< typename TX, typename TY >
+QwtStridedPointData< TX, TY >::QwtStridedPointData(
+        const TX* x, size_t xStride, const TY* y, size_t yStride, size_t size )
+    : m_x( reinterpret_cast< const char* >( x ) )
+    , m_y( reinterpret_cast< const char* >( y ) )
+    , m_xStride( xStride )
+    , m_yStride( yStride )
+    , m_size( size )
+    , m_xFactor( 1.0 )
+    , m_xOffset( 0.0 )
+    , m_yFactor( 1.0 )
+    , m_yOffset( 0.0 )
+{
+}
+
+/*!
+   Set an affine transformation for the x values: x = factor * value + offset
+
+   \param factor Factor
+   \param offset Offset
+ */
+template< typename TX, typename TY >
+void QwtStridedPointData< TX, TY >::setXScaling( double factor, double offset )
+{
+    m_xFactor = factor;
+    m_xOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   Set an affine transformation for the y values: y = factor * value + offset
+
+   \param factor Factor
+   \param offset Offset
+ */
+template< typename TX, typename TY >
+void QwtStridedPointData< TX, TY >::setYScaling( double factor, double offset )
+{
+    m_yFactor = factor;
+    m_yOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+//! \return Size of the data set
+template< typename TX, typename TY >
+size_t QwtStridedPointData< TX, TY >::size() const
+{
+    return m_size;
+}
+
+/*!
+   Return the sample at position i
+
+   \param index Index
+   \return Sample at position i
+ */
+template< typename TX, typename TY >
+QPointF QwtStridedPointData< TX, TY >::sample( size_t index ) const
+{
+    const double x = qwtStridedValue< TX >( m_x, index, m_xStride );
+    const double y = qwtStridedValue< TY >( m_y, index, m_yStride );
+
+    return QPointF( m_xFactor * x + m_xOffset, m_yFactor * y + m_yOffset );
+}
+
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename TX, typename TY >
+void QwtStridedPointData< TX, TY >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const char* x = m_x + from * m_xStride;
+    const char* y = m_y + from * m_yStride;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+    {
+        const double vx = qwtStridedValue< TX >( x, i, m_xStride );
+        const double vy = qwtStridedValue< TY >( y, i, m_yStride );
+
+        samples[i].setX( m_xFactor * vx + m_xOffset );
+        samples[i].setY( m_yFactor * vy + m_yOffset );
+    }
+}
+
+//! \return Pointer to the first x value
+template< typename TX, typename TY >
+const TX* QwtStridedPointData< TX, TY >::xData() const
+{
+    return reinterpret_cast< const TX* >( m_x );
+}
+
+//! \return Pointer to the first y value
+template< typename TX, typename TY >
+const TY* QwtStridedPointData< TX, TY >::yData() const
+{
+    return reinterpret_cast< const TY* >( m_y );
+}
+
+//! \return Distance between 2 x values in bytes
+template< typename TX, typename TY >
+size_t QwtStridedPointData< TX, TY >::xStride() const
+{
+    return m_xStride;
+}
+
+//! \return Distance between 2 y values in bytes
+template< typename TX, typename TY >
+size_t QwtStridedPointData< TX, TY >::yStride() const
+{
+    return m_yStride;
+}
+
+/*!
+   Constructor
+
+   \param y Pointer to the first y value
+   \param size Number of samples
+   \param stride Distance between 2 y values in bytes
+
+   \sa QwtPlotCurve::setData()
+ */
+template< typename T >
+QwtStridedValueData< T >::QwtStridedValueData(
+        const T* y, size_t size, size_t stride )
+    : m_y( reinterpret_cast< const char* >( y ) )
+    , m_yStride( stride )
+    , m_size( size )
+    , m_xFactor( 1.0 )
+    , m_xOffset( 0.0 )
+    , m_yFactor( 1.0 )
+    , m_yOffset( 0.0 )
+{
+}
+
+/*!
+   Set an affine transformation for mapping the index into x: x = factor * index + offset
+
+   \param factor Factor, f.e. the sample interval
+   \param offset Offset, f.e. the time of the first sample
+ */
+template< typename T >
+void QwtStridedValueData< T >::setXScaling( double factor, double offset )
+{
+    m_xFactor = factor;
+    m_xOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   Set an affine transformation for the y values: y = factor * value + offset
+
+   \param factor Factor
+   \param offset Offset
+ */
+template< typename T >
+void QwtStridedValueData< T >::setYScaling( double factor, double offset )
+{
+    m_yFactor = factor;
+    m_yOffset = offset;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+//! \return Size of the data set
+template< typename T >
+size_t QwtStridedValueData< T >::size() const
+{
+    return m_size;
+}
+
+/*!
+   Return the sample at position i
+
+   \param index Index
+   \return Sample at position i
+ */
+template< typename T >
+QPointF QwtStridedValueData< T >::sample( size_t index ) const
+{
+    const double y = qwtStridedValue< T >( m_y, index, m_yStride );
+
+    return QPointF( m_xFactor * index + m_xOffset, m_yFactor * y + m_yOffset );
+}
+
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtStridedValueData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const char* y = m_y + from * m_yStride;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+    {
+        const double vy = qwtStridedValue< T >( y, i, m_yStride );
+
+        samples[i].setX( m_xFactor * double( from + i ) + m_xOffset );
+        samples[i].setY( m_yFactor * vy + m_yOffset );
+    }
+}
+
+//! \return Pointer to the first y value
+template< typename T >
+const T* QwtStridedValueData< T >::yData() const
+{
+    return reinterpret_cast< const T* >( m_y );
+}
+
+//! \return Distance between 2 y values in bytes
+template< typename T >
+size_t QwtStridedValueData< T >::yStride() const
+{
+    return m_yStride;
+}
+
+/*!
+   \brief Calculate the bounding rectangle of 2 arrays
+
+   Generic implementation for arrays of other types than double or float.
+
+   \param x Array of x values
+   \param y Array of y values
+   \param size Size of the arrays
+   \param isMonotonic When not NULL it is set to true, when the
+                      x values are increasing
+
+   \return Bounding rectangle
+ */
+template< typename T >
+QRectF qwtBoundingRect( const T* x, const T* y,
+    size_t size, bool* isMonotonic )
+{
+    if ( isMonotonic )
+        *isMonotonic = false;
+
+    if ( size == 0 )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    // gaps ( NaN ) fail all comparisons, but must not be the initial value
+
+    size_t ix = 0;
+    while ( ix + 1 < size && qIsNaN( double( x[ix] ) ) )
+        ix++;
+
+    size_t iy = 0;
+    while ( iy + 1 < size && qIsNaN( double( y[iy] ) ) )
+        iy++;
+
+    double xMin = x[ix];
+    double xMax = x[ix];
+    double yMin = y[iy];
+    double yMax = y[iy];
+
+    bool increasing = true;
+
+    for ( size_t i = 1; i < size; i++ )
+    {
+        const double vx = x[i];
+        const double vy = y[i];
+
+        if ( x[i] < x[i - 1] )
+            increasing = false;
+
+        if ( vx < xMin )
+            xMin = vx;
+
+        if ( vx > xMax )
+            xMax = vx;
+
+        if ( vy < yMin )
+            yMin = vy;
+
+        if ( vy > yMax )
+            yMax = vy;
+    }
+
+    if ( isMonotonic )
+        *isMonotonic = increasing;
+
+    return QRectF( xMin, yMin, xMax - xMin, yMax - yMin );
+}
+
 #endif
@@ -9,9 +9,16 @@
 
 #include "qwt_point_mapper.h"
 #include "qwt_scale_map.h"
-#include "qwt_pixel_matrix.h"
 #include "qwt_series_data.h"
+#include "qwt_point_data.h"
+#include "qwt_uniform_series_data.h"
 #include "qwt_math.h"
+#include "qwt_painter.h"
+#include "qwt_clipper.h"
+#include "qwt_scratch_pool.h"
+#include "qwt_render_statistics.h"
+#include "qwt_color_map.h"
+#include "qwt_interval.h"
 
 #include <qpolygon.h>
 #include <qimage.h>
@@ -22,6 +29,8 @@
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
 
+#include <typeinfo>
+
 #if !defined( QT_NO_QFUTURE )
 #define QWT_USE_THREADS 1
 #endif
@@ -52,6 +61,15 @@ static Qt::Orientation qwtProbeOrientation(
         return Qt::Horizontal;
     }
 
+    const QwtAbstractUniformData* uniformData =
+        dynamic_cast< const QwtAbstractUniformData* >( series );
+
+    if ( uniformData && uniformData->dx() != 0.0 )
+    {
+        // equidistant x coordinates
+        return Qt::Horizontal;
+    }
+
     const double x0 = series->sample( from ).x();
     const double xn = series->sample( to ).x();
 
@@ -183,23 +201,436 @@ namespace
     };
 }
 
+namespace
+{
+    /*
+        Direct access to the coordinates of the most common series types,
+        so that they can be mapped without calling the virtual fetch().
+     */
+    class QwtSeriesArrays
+    {
+      public:
+        enum Type
+        {
+            NoArrays,
+            DoubleArrays,
+            FloatArrays,
+
+            // y values only, x = x0 + index * dx
+            UniformDoubleArrays,
+            UniformFloatArrays
+        };
+
+        explicit QwtSeriesArrays( const QwtSeriesData< QPointF >* series )
+            : type( NoArrays )
+            , x( NULL )
+            , y( NULL )
+            , x0( 0.0 )
+            , dx( 0.0 )
+            , origin( 0 )
+            , size( 0 )
+        {
+            typedef QwtPointArrayData< double > DoubleArrayData;
+            typedef QwtPointArrayData< float > FloatArrayData;
+            typedef QwtCPointerData< double > DoublePointerData;
+            typedef QwtCPointerData< float > FloatPointerData;
+            typedef QwtUniformSeriesData< double > DoubleUniformData;
+            typedef QwtUniformSeriesData< float > FloatUniformData;
+
+            // subclasses might override sample(): exact types only
+
+            const std::type_info& info = typeid( *series );
+
+            if ( info == typeid( DoubleArrayData ) )
+            {
+                const DoubleArrayData* data = static_cast< const DoubleArrayData* >( series );
+                set( DoubleArrays, data->xData().constData(), data->yData().constData() );
+            }
+            else if ( info == typeid( FloatArrayData ) )
+            {
+                const FloatArrayData* data = static_cast< const FloatArrayData* >( series );
+                set( FloatArrays, data->xData().constData(), data->yData().constData() );
+            }
+            else if ( info == typeid( DoublePointerData ) )
+            {
+                const DoublePointerData* data = static_cast< const DoublePointerData* >( series );
+                set( DoubleArrays, data->xData(), data->yData() );
+            }
+            else if ( info == typeid( FloatPointerData ) )
+            {
+                const FloatPointerData* data = static_cast< const FloatPointerData* >( series );
+                set( FloatArrays, data->xData(), data->yData() );
+            }
+            else if ( info == typeid( DoubleUniformData ) )
+            {
+                const DoubleUniformData* data = static_cast< const DoubleUniformData* >( series );
+                setUniform( UniformDoubleArrays, data, data->yData().constData() );
+            }
+            else if ( info == typeid( FloatUniformData ) )
+            {
+                const FloatUniformData* data = static_cast< const FloatUniformData* >( series );
+                setUniform( UniformFloatArrays, data, data->yData().constData() );
+            }
+        }
+
+        Type type;
+        const void* x;
+        const void* y;
+
+        double x0;
+        double dx;
+        int origin;
+        int size;
+
+      private:
+        inline void setUniform( Type arrayType,
+            const QwtAbstractUniformData* data, const void* yValues )
+        {
+            set( arrayType, NULL, yValues );
+
+            x0 = data->x0();
+            dx = data->dx();
+            origin = int( data->origin() );
+            size = int( data->size() );
+        }
+
+        inline void set( Type arrayType, const void* xValues, const void* yValues )
+        {
+            type = arrayType;
+            x = xValues;
+            y = yValues;
+        }
+    };
+
+    /*
+        p1 + ( s - s1 ) * cnv, what is the same as QwtScaleMap::transform()
+        for a map without transformation.
+     */
+    class QwtLinearMap
+    {
+      public:
+        explicit QwtLinearMap( const QwtScaleMap& map )
+            : p1( map.p1() )
+            , s1( map.s1() )
+            , cnv( 1.0 )
+        {
+            if ( map.s1() != map.s2() )
+                cnv = ( map.p2() - map.p1() ) / ( map.s2() - map.s1() );
+        }
+
+        inline double map( double value ) const
+        {
+            return p1 + ( value - s1 ) * cnv;
+        }
+
+        // distance in paint device coordinates for a distance in scale coordinates
+        inline double step( double distance ) const
+        {
+            return distance * cnv;
+        }
+
+      private:
+        double p1;
+        double s1;
+        double cnv;
+    };
+
+    /*
+        Fetching and mapping in one loop, that can be inlined
+        and vectorized by the compiler.
+     */
+    template< typename T >
+    inline void qwtMapArrays( const QwtLinearMap& xMap, const QwtLinearMap& yMap,
+        const T* x, const T* y, int count, QPointF* points )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            points[i].rx() = xMap.map( x[i] );
+            points[i].ry() = yMap.map( y[i] );
+        }
+    }
+
+    /*
+        For equidistant samples the mapped x coordinates are
+        equidistant as well: no multiplication per sample.
+     */
+    template< typename T >
+    inline void qwtMapUniform( const QwtLinearMap& xMap, const QwtLinearMap& yMap,
+        double x0, double dx, const T* y, int count, QPointF* points )
+    {
+        const double step = xMap.step( dx );
+        double px = xMap.map( x0 );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            points[i].rx() = px;
+            points[i].ry() = yMap.map( y[i] );
+
+            px += step;
+        }
+    }
+
+    template< typename T >
+    inline void qwtCopyUniform( double x0, double dx,
+        const T* y, int count, QPointF* points )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            points[i].rx() = x0 + i * dx;
+            points[i].ry() = y[i];
+        }
+    }
+
+    template< typename T >
+    inline void qwtCopyArrays( const T* x, const T* y, int count, QPointF* points )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            points[i].rx() = x[i];
+            points[i].ry() = y[i];
+        }
+    }
+
+    /*
+        Samples are fetched and mapped in chunks, so that the
+        transformation can be done by the vectorized
+        QwtScaleMap::transform() for arrays of points.
+
+        For QwtPointArrayData, QwtCPointerData and QwtUniformSeriesData
+        of double or float the coordinates are read from the arrays
+        directly. For linear maps - what is the most common case - they are
+        mapped in the same loop.
+     */
+    class QwtMappedSamples
+    {
+      public:
+        QwtMappedSamples( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                const QwtSeriesData< QPointF >* series, int to )
+            : m_xMap( xMap )
+            , m_yMap( yMap )
+            , m_series( series )
+            , m_arrays( series )
+            , m_isLinear(
+                xMap.transformationType() == QwtScaleMap::NoTransformation &&
+                yMap.transformationType() == QwtScaleMap::NoTransformation )
+            , m_xLinear( xMap )
+            , m_yLinear( yMap )
+            , m_to( to )
+            , m_first( 0 )
+            , m_count( 0 )
+        {
+        }
+
+        inline const QPointF& point( int index )
+        {
+            const int pos = index - m_first;
+            if ( pos < 0 || pos >= m_count )
+            {
+                load( index );
+                return m_points[0];
+            }
+
+            return m_points[pos];
+        }
+
+      private:
+        enum { ChunkSize = 512 };
+
+        void load( int index )
+        {
+            m_first = index;
+            m_count = qMin( int( ChunkSize ), m_to - index + 1 );
+
+            switch( m_arrays.type )
+            {
+                case QwtSeriesArrays::DoubleArrays:
+                {
+                    load( static_cast< const double* >( m_arrays.x ) + index,
+                        static_cast< const double* >( m_arrays.y ) + index );
+                    break;
+                }
+                case QwtSeriesArrays::FloatArrays:
+                {
+                    load( static_cast< const float* >( m_arrays.x ) + index,
+                        static_cast< const float* >( m_arrays.y ) + index );
+                    break;
+                }
+                case QwtSeriesArrays::UniformDoubleArrays:
+                {
+                    loadUniform( static_cast< const double* >( m_arrays.y ), index );
+                    break;
+                }
+                case QwtSeriesArrays::UniformFloatArrays:
+                {
+                    loadUniform( static_cast< const float* >( m_arrays.y ), index );
+                    break;
+                }
+                default:
+                {
+                    m_series->fetch( index, m_count, m_points );
+
+                    QwtScaleMap::transform( m_xMap, m_yMap,
+                        m_points, m_points, m_count );
+                }
+            }
+        }
+
+        template< typename T >
+        inline void load( const T* x, const T* y )
+        {
+            if ( m_isLinear )
+            {
+                qwtMapArrays( m_xLinear, m_yLinear, x, y, m_count, m_points );
+            }
+            else
+            {
+                qwtCopyArrays( x, y, m_count, m_points );
+
+                QwtScaleMap::transform( m_xMap, m_yMap,
+                    m_points, m_points, m_count );
+            }
+        }
+
+        template< typename T >
+        inline void loadUniform( const T* values, int index )
+        {
+            // a chunk ends at the end of the ring buffer
+
+            int pos = m_arrays.origin + index;
+            if ( pos >= m_arrays.size )
+                pos -= m_arrays.size;
+
+            m_count = qMin( m_count, m_arrays.size - pos );
+
+            const double x0 = m_arrays.x0 + index * m_arrays.dx;
+
+            if ( m_isLinear )
+            {
+                qwtMapUniform( m_xLinear, m_yLinear,
+                    x0, m_arrays.dx, values + pos, m_count, m_points );
+            }
+            else
+            {
+                qwtCopyUniform( x0, m_arrays.dx, values + pos, m_count, m_points );
+
+                QwtScaleMap::transform( m_xMap, m_yMap,
+                    m_points, m_points, m_count );
+            }
+        }
+
+        const QwtScaleMap& m_xMap;
+        const QwtScaleMap& m_yMap;
+        const QwtSeriesData< QPointF >* m_series;
+
+        const QwtSeriesArrays m_arrays;
+
+        const bool m_isLinear;
+        const QwtLinearMap m_xLinear;
+        const QwtLinearMap m_yLinear;
+
+        const int m_to;
+        int m_first;
+        int m_count;
+
+        QPointF m_points[ChunkSize];
+    };
+}
+
+/*
+   Reducing the points to first/min/max/last of each column of
+   a virtual pixel grid, without rounding the coordinates. Used for
+   devices without integer coordinates, where the number of points
+   should be limited by a target resolution.
+ */
+static QPolygonF qwtMapPointsColumns( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to, double resolution )
+{
+    QPolygonF polyline;
+    if ( from > to )
+        return polyline;
+
+    QwtMappedSamples mapped( xMap, yMap, series, to );
+
+    QPointF first = mapped.point( from );
+    QPointF last = first;
+    QPointF minPos = first;
+    QPointF maxPos = first;
+    int minIndex = from;
+    int maxIndex = from;
+
+    double column = std::floor( first.x() * resolution );
+
+    for ( int i = from; i <= to + 1; i++ )
+    {
+        QPointF pos;
+        double c = column;
+
+        if ( i <= to )
+        {
+            pos = mapped.point( i );
+            c = std::floor( pos.x() * resolution );
+
+            if ( c == column )
+            {
+                if ( pos.y() < minPos.y() )
+                {
+                    minPos = pos;
+                    minIndex = i;
+                }
+
+                if ( pos.y() > maxPos.y() )
+                {
+                    maxPos = pos;
+                    maxIndex = i;
+                }
+
+                last = pos;
+                continue;
+            }
+        }
+
+        // flushing the column in the order of the samples
+
+        polyline += first;
+
+        const QPointF& p1 = ( minIndex < maxIndex ) ? minPos : maxPos;
+        const QPointF& p2 = ( minIndex < maxIndex ) ? maxPos : minPos;
+
+        if ( p1 != polyline.last() )
+            polyline += p1;
+
+        if ( p2 != polyline.last() )
+            polyline += p2;
+
+        if ( last != polyline.last() )
+            polyline += last;
+
+        first = last = minPos = maxPos = pos;
+        minIndex = maxIndex = i;
+        column = c;
+    }
+
+    return polyline;
+}
+
 template< class Polygon, class Point, class PolygonQuadrupel >
 static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to )
 {
-    const QPointF sample0 = series->sample( from );
+    QwtMappedSamples mapped( xMap, yMap, series, to );
+
+    const QPointF& pos0 = mapped.point( from );
 
     PolygonQuadrupel q;
-    q.start( qwtRoundValue( xMap.transform( sample0.x() ) ),
-        qwtRoundValue( yMap.transform( sample0.y() ) ) );
+    q.start( qwtRoundValue( pos0.x() ), qwtRoundValue( pos0.y() ) );
 
     Polygon polyline;
     for ( int i = from; i <= to; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF& pos = mapped.point( i );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
 
         if ( !q.append( x, y ) )
         {
@@ -302,18 +733,44 @@ static void qwtRenderDots(
     const int x0 = pos.x();
     const int y0 = pos.y();
 
+    QwtMappedSamples mapped( xMap, yMap, command.series, command.to );
+
     for ( int i = command.from; i <= command.to; i++ )
     {
-        const QPointF sample = command.series->sample( i );
+        const QPointF& point = mapped.point( i );
 
-        const int x = static_cast< int >( xMap.transform( sample.x() ) + 0.5 ) - x0;
-        const int y = static_cast< int >( yMap.transform( sample.y() ) + 0.5 ) - y0;
+        const int x = static_cast< int >( point.x() + 0.5 ) - x0;
+        const int y = static_cast< int >( point.y() + 0.5 ) - y0;
 
         if ( x >= 0 && x < w && y >= 0 && y < h )
             bits[ y * w + x ] = rgb;
     }
 }
 
+static void qwtAccumulateDots(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtDotsCommand& command, const QRect& rect, quint32* counts )
+{
+    const int w = rect.width();
+    const int h = rect.height();
+
+    const int x0 = rect.x();
+    const int y0 = rect.y();
+
+    QwtMappedSamples mapped( xMap, yMap, command.series, command.to );
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QPointF& pos = mapped.point( i );
+
+        const int x = static_cast< int >( pos.x() + 0.5 ) - x0;
+        const int y = static_cast< int >( pos.y() + 0.5 ) - y0;
+
+        if ( x >= 0 && x < w && y >= 0 && y < h )
+            counts[ y * w + x ]++;
+    }
+}
+
 // some functors, so that the compile can inline
 struct QwtRoundI
 {
@@ -349,9 +806,13 @@ static inline Polygon qwtToPoints(
     const QwtSeriesData< QPointF >* series,
     int from, int to, Round round )
 {
-    Polygon polyline( to - from + 1 );
+    Polygon polyline;
+    QwtScratchPool::acquire( polyline, to - from + 1 );
+
     Point* points = polyline.data();
 
+    QwtMappedSamples mapped( xMap, yMap, series, to );
+
     int numPoints = 0;
 
     if ( boundingRect.isValid() )
@@ -362,10 +823,10 @@ static inline Polygon qwtToPoints(
 
         for ( int i = from; i <= to; i++ )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF& pos = mapped.point( i );
 
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            const double x = pos.x();
+            const double y = pos.y();
 
             if ( boundingRect.contains( x, y ) )
             {
@@ -385,10 +846,10 @@ static inline Polygon qwtToPoints(
 
         for ( int i = from; i <= to; i++ )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF& pos = mapped.point( i );
 
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            const double x = pos.x();
+            const double y = pos.y();
 
             points[ numPoints ].rx() = round( x );
             points[ numPoints ].ry() = round( y );
@@ -435,21 +896,24 @@ static inline Polygon qwtToPolylineFiltered(
     // result in empty lines ( or symbols hidden by others )
     // we try to filter them out
 
-    Polygon polyline( to - from + 1 );
+    Polygon polyline;
+    QwtScratchPool::acquire( polyline, to - from + 1 );
+
     Point* points = polyline.data();
 
-    const QPointF sample0 = series->sample( from );
+    QwtMappedSamples mapped( xMap, yMap, series, to );
 
-    points[0].rx() = round( xMap.transform( sample0.x() ) );
-    points[0].ry() = round( yMap.transform( sample0.y() ) );
+    const QPointF& pos0 = mapped.point( from );
+
+    points[0].rx() = round( pos0.x() );
+    points[0].ry() = round( pos0.y() );
 
     int pos = 0;
     for ( int i = from + 1; i <= to; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF& mappedPos = mapped.point( i );
 
-        const Point p( round( xMap.transform( sample.x() ) ),
-            round( yMap.transform( sample.y() ) ) );
+        const Point p( round( mappedPos.x() ), round( mappedPos.y() ) );
 
         if ( points[pos] != p )
             points[++pos] = p;
@@ -478,6 +942,89 @@ static inline QPolygonF qwtToPolylineFilteredF(
         xMap, yMap, series, from, to, round );
 }
 
+namespace
+{
+    /*
+        A bitmap for finding duplicates in an unsorted array of points
+
+        The pixels are organized in blocks of 8x8 pixels, each of them
+        stored in one 64 bit word. As the points of a curve are usually
+        close to their predecessors, they often hit the same word or
+        at least the same cache line.
+
+        Unlike QwtPixelMatrix the bits are accessed without any
+        detaching or index calculations of QBitArray.
+     */
+    class QwtPixelBitmap
+    {
+      public:
+        explicit QwtPixelBitmap( const QRect& rect )
+            : m_x0( rect.x() )
+            , m_y0( rect.y() )
+            , m_width( qMax( rect.width(), 0 ) )
+            , m_height( qMax( rect.height(), 0 ) )
+            , m_blocksPerRow( ( m_width + 7 ) >> 3 )
+        {
+            m_words.fill( 0, m_blocksPerRow * ( ( m_height + 7 ) >> 3 ) );
+            m_bits = m_words.data();
+        }
+
+        // true, when the pixel is outside or has been set before
+        inline bool testAndSetPixel( int x, int y )
+        {
+            // negative values wrap around to huge unsigned values
+            const uint dx = uint( x - m_x0 );
+            const uint dy = uint( y - m_y0 );
+
+            if ( dx >= uint( m_width ) || dy >= uint( m_height ) )
+                return true;
+
+            quint64& word =
+                m_bits[ ( dy >> 3 ) * m_blocksPerRow + ( dx >> 3 ) ];
+
+            const quint64 mask =
+                Q_UINT64_C( 1 ) << ( ( ( dy & 7 ) << 3 ) | ( dx & 7 ) );
+
+            if ( word & mask )
+                return true;
+
+            word |= mask;
+            return false;
+        }
+
+      private:
+        Q_DISABLE_COPY( QwtPixelBitmap )
+
+        const int m_x0;
+        const int m_y0;
+        const int m_width;
+        const int m_height;
+        const int m_blocksPerRow;
+
+        QVector< quint64 > m_words;
+        quint64* m_bits;
+    };
+}
+
+// removing all duplicates in place
+template< class Polygon >
+static void qwtRemoveDuplicates( const QRectF& boundingRect, Polygon& polygon )
+{
+    QwtPixelBitmap bitmap( boundingRect.toAlignedRect() );
+
+    int numPoints = 0;
+    for ( int i = 0; i < polygon.size(); i++ )
+    {
+        const int x = qwtRoundValue( polygon[i].x() );
+        const int y = qwtRoundValue( polygon[i].y() );
+
+        if ( !bitmap.testAndSetPixel( x, y ) )
+            polygon[ numPoints++ ] = polygon[i];
+    }
+
+    polygon.resize( numPoints );
+}
+
 template< class Polygon, class Point >
 static inline Polygon qwtToPointsFiltered(
     const QRectF& boundingRect,
@@ -487,20 +1034,24 @@ static inline Polygon qwtToPointsFiltered(
     // F.e. in scatter plots ( no connecting lines ) we
     // can sort out all duplicates ( not only consecutive points )
 
-    Polygon polygon( to - from + 1 );
+    Polygon polygon;
+    QwtScratchPool::acquire( polygon, to - from + 1 );
+
     Point* points = polygon.data();
 
-    QwtPixelMatrix pixelMatrix( boundingRect.toAlignedRect() );
+    QwtPixelBitmap bitmap( boundingRect.toAlignedRect() );
+
+    QwtMappedSamples mapped( xMap, yMap, series, to );
 
     int numPoints = 0;
     for ( int i = from; i <= to; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF& pos = mapped.point( i );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
 
-        if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+        if ( !bitmap.testAndSetPixel( x, y ) )
         {
             points[ numPoints ].rx() = x;
             points[ numPoints ].ry() = y;
@@ -531,40 +1082,589 @@ static inline QPolygonF qwtToPointsFilteredF(
         boundingRect, xMap, yMap, series, from, to );
 }
 
-class QwtPointMapper::PrivateData
+// mapping points into interleaved buffers ( x1, y1, x2, y2, ... )
+
+struct QwtFloatVertex
 {
-  public:
-    PrivateData()
-        : boundingRect( qwtInvalidRect )
+    inline float operator()( double value ) const
     {
+        return static_cast< float >( value );
     }
+};
 
-    QRectF boundingRect;
-    QwtPointMapper::TransformationFlags flags;
+struct QwtShortVertex
+{
+    inline qint16 operator()( double value ) const
+    {
+        return static_cast< qint16 >( qBound( -32768.0, value, 32767.0 ) );
+    }
 };
 
-//! Constructor
-QwtPointMapper::QwtPointMapper()
+template< class T >
+static QVector< T > qwtVertices( const QPolygon& polygon )
 {
-    m_data = new PrivateData();
+    QVector< T > vertices( 2 * polygon.size() );
+
+    T* v = vertices.data();
+    for ( int i = 0; i < polygon.size(); i++ )
+    {
+        *v++ = static_cast< T >( polygon[i].x() );
+        *v++ = static_cast< T >( polygon[i].y() );
+    }
+
+    return vertices;
 }
 
-//! Destructor
-QwtPointMapper::~QwtPointMapper()
+template< class T, class Round, class Convert >
+static QVector< T > qwtToVertices(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series,
+    int from, int to, bool weedOut, Round round, Convert convert )
 {
-    delete m_data;
-}
+    QVector< T > vertices;
+    if ( from > to )
+        return vertices;
 
-/*!
-   Set the flags affecting the transformation process
+    vertices.resize( 2 * ( to - from + 1 ) );
+    T* v = vertices.data();
 
-   \param flags Flags
-   \sa flags(), setFlag()
- */
-void QwtPointMapper::setFlags( TransformationFlags flags )
-{
-    m_data->flags = flags;
-}
+    QwtMappedSamples mapped( xMap, yMap, series, to );
+
+    int numPoints = 0;
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF& pos = mapped.point( i );
+
+        const T x = convert( round( pos.x() ) );
+        const T y = convert( round( pos.y() ) );
+
+        if ( weedOut && numPoints > 0
+            && v[-2] == x && v[-1] == y )
+        {
+            // consecutive points mapped to the same position
+            continue;
+        }
+
+        *v++ = x;
+        *v++ = y;
+
+        numPoints++;
+    }
+
+    vertices.resize( 2 * numPoints );
+    return vertices;
+}
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtMappingCommand
+{
+  public:
+    enum Mode
+    {
+        Points,
+        Filtered,
+        Quadrupel,
+        Unique
+    };
+
+    const QwtSeriesData< QPointF >* series;
+    int from;
+    int to;
+
+    Mode mode;
+    Qt::Orientation orientation;
+
+    // only for Unique
+    QRectF boundingRect;
+};
+
+template< class Polygon, class Point, class Round >
+static void qwtMapChunk(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtMappingCommand& command, Polygon* polygon )
+{
+    switch ( command.mode )
+    {
+        case QwtMappingCommand::Quadrupel:
+        {
+            // only the first pass, the chunks are reduced
+            // again after stitching them together
+
+            if ( command.orientation == Qt::Horizontal )
+            {
+                *polygon = qwtMapPointsQuad< Polygon, Point,
+                    QwtPolygonQuadrupelY< Polygon, Point > >(
+                    xMap, yMap, command.series, command.from, command.to );
+            }
+            else
+            {
+                *polygon = qwtMapPointsQuad< Polygon, Point,
+                    QwtPolygonQuadrupelX< Polygon, Point > >(
+                    xMap, yMap, command.series, command.from, command.to );
+            }
+            break;
+        }
+        case QwtMappingCommand::Filtered:
+        {
+            *polygon = qwtToPolylineFiltered< Polygon, Point >( xMap, yMap,
+                command.series, command.from, command.to, Round() );
+            break;
+        }
+        case QwtMappingCommand::Unique:
+        {
+            // each chunk has its own bitmap
+            *polygon = qwtToPointsFiltered< Polygon, Point >(
+                command.boundingRect, xMap, yMap,
+                command.series, command.from, command.to );
+            break;
+        }
+        default:
+        {
+            *polygon = qwtToPoints< Polygon, Point >( qwtInvalidRect,
+                xMap, yMap, command.series, command.from, command.to, Round() );
+        }
+    }
+}
+
+template< class Polygon, class Point, class Round >
+static Polygon qwtMapPointsParallel(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    QwtMappingCommand::Mode mode, uint numThreads,
+    const QRectF& boundingRect = qwtInvalidRect )
+{
+    // chunks below this size are not worth the threading overhead
+    const int minChunkSize = 10000;
+
+    Polygon polyline;
+    if ( from > to )
+        return polyline;
+
+    QwtMappingCommand command;
+    command.series = series;
+    command.mode = mode;
+    command.orientation = Qt::Horizontal;
+    command.boundingRect = boundingRect;
+
+    if ( mode == QwtMappingCommand::Quadrupel )
+        command.orientation = qwtProbeOrientation( series, from, to );
+
+    const int numPoints = to - from + 1;
+
+    int numChunks = 1;
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numChunks = qBound( 1, numPoints / minChunkSize, int( numThreads ) );
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    QVector< Polygon > chunks( numChunks );
+
+    const int chunkSize = numPoints / numChunks;
+
+#if QWT_USE_THREADS
+    QList< QFuture< void > > futures;
+#endif
+
+    for ( int i = 0; i < numChunks; i++ )
+    {
+        command.from = from + i * chunkSize;
+
+        if ( i == numChunks - 1 )
+        {
+            command.to = to;
+            qwtMapChunk< Polygon, Point, Round >(
+                xMap, yMap, command, &chunks[i] );
+        }
+        else
+        {
+            command.to = command.from + chunkSize - 1;
+
+#if QWT_USE_THREADS
+            futures += QtConcurrent::run( &qwtMapChunk< Polygon, Point, Round >,
+                xMap, yMap, command, &chunks[i] );
+#endif
+        }
+    }
+
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
+    if ( numChunks == 1 )
+    {
+        polyline = chunks[0];
+    }
+    else
+    {
+        int numStitched = 0;
+        for ( int i = 0; i < numChunks; i++ )
+            numStitched += chunks[i].size();
+
+        polyline.reserve( numStitched );
+
+        for ( int i = 0; i < numChunks; i++ )
+        {
+            const Polygon& chunk = chunks[i];
+
+            int index0 = 0;
+            if ( ( mode == QwtMappingCommand::Filtered
+                || mode == QwtMappingCommand::Quadrupel ) && !polyline.isEmpty()
+                && !chunk.isEmpty() && polyline.last() == chunk.first() )
+            {
+                // consecutive duplicate at the seam
+                index0 = 1;
+            }
+
+            for ( int j = index0; j < chunk.size(); j++ )
+                polyline += chunk[j];
+        }
+    }
+
+    if ( mode == QwtMappingCommand::Unique && numChunks > 1 )
+    {
+        // duplicates of different chunks
+
+        qwtRemoveDuplicates( boundingRect, polyline );
+    }
+
+    if ( mode == QwtMappingCommand::Quadrupel )
+    {
+        /*
+            Reducing the stitched polyline with the first quadrupel
+            again merges chunks of points at the seams, that are mapped
+            to the same coordinate. Then the second pass follows.
+         */
+
+        if ( command.orientation == Qt::Horizontal )
+        {
+            if ( numChunks > 1 )
+            {
+                polyline = qwtMapPointsQuad< Polygon, Point,
+                    QwtPolygonQuadrupelY< Polygon, Point > >( polyline );
+            }
+
+            polyline = qwtMapPointsQuad< Polygon, Point,
+                QwtPolygonQuadrupelX< Polygon, Point > >( polyline );
+        }
+        else
+        {
+            if ( numChunks > 1 )
+            {
+                polyline = qwtMapPointsQuad< Polygon, Point,
+                    QwtPolygonQuadrupelX< Polygon, Point > >( polyline );
+            }
+
+            polyline = qwtMapPointsQuad< Polygon, Point,
+                QwtPolygonQuadrupelY< Polygon, Point > >( polyline );
+        }
+    }
+
+    return polyline;
+}
+
+namespace
+{
+    /*
+        Collecting the visible parts of a polyline in a scratch buffer.
+        Each part is painted - or appended to a list of parts - when
+        the polyline leaves the clip rectangle, so that the unclipped
+        polyline is never materialized.
+     */
+    class QwtClippedPolyline
+    {
+      public:
+        QwtClippedPolyline( QPainter* painter,
+                QVector< QPolygonF >* parts, const QRectF& clipRect )
+            : m_painter( painter )
+            , m_parts( parts )
+            , m_clipRect( clipRect )
+            , m_doClip( clipRect.isValid() )
+            , m_hasPoint( false )
+            , m_count( 0 )
+        {
+            QwtScratchPool::acquire( m_points, 0 );
+        }
+
+        ~QwtClippedPolyline()
+        {
+            QwtScratchPool::release( m_points );
+        }
+
+        inline void append( const QPointF& pos )
+        {
+            if ( !m_doClip )
+            {
+                add( pos );
+                return;
+            }
+
+            if ( !m_hasPoint )
+            {
+                m_hasPoint = true;
+                m_last = pos;
+
+                if ( m_clipRect.contains( pos ) )
+                    add( pos );
+
+                return;
+            }
+
+            QPointF p1 = m_last;
+            QPointF p2 = pos;
+
+            m_last = pos;
+
+            if ( QwtClipper::clipLine( m_clipRect, p1, p2 ) )
+            {
+                if ( m_count == 0 )
+                    add( p1 );
+
+                add( p2 );
+
+                if ( p2 != pos )
+                {
+                    // leaving the clip rectangle
+                    flush();
+                }
+            }
+        }
+
+        void flush()
+        {
+            if ( m_count > 1 )
+            {
+                if ( m_painter )
+                    QwtPainter::drawPolyline( m_painter, m_points.constData(), m_count );
+                else
+                    *m_parts += m_points.mid( 0, m_count );
+            }
+
+            m_count = 0;
+        }
+
+        void interrupt()
+        {
+            flush();
+            m_hasPoint = false;
+        }
+
+      private:
+        inline void add( const QPointF& pos )
+        {
+            if ( m_count == m_points.size() )
+                m_points.resize( qMax( 2 * m_count, 256 ) );
+
+            m_points[ m_count++ ] = pos;
+        }
+
+        QPainter* m_painter;
+        QVector< QPolygonF >* m_parts;
+
+        const QRectF m_clipRect;
+        const bool m_doClip;
+
+        bool m_hasPoint;
+        QPointF m_last;
+
+        QPolygonF m_points;
+        int m_count;
+    };
+}
+
+template< class Round >
+static void qwtDrawPolyline( QPainter* painter, QVector< QPolygonF >* parts,
+    const QRectF& clipRect, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series,
+    int from, int to, bool weedOut, bool breakAtGaps, Round round )
+{
+    QwtMappedSamples mapped( xMap, yMap, series, to );
+    QwtClippedPolyline polyline( painter, parts, clipRect );
+
+    QPointF last;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF& mappedPos = mapped.point( i );
+
+        if ( breakAtGaps && ( qIsNaN( mappedPos.x() ) || qIsNaN( mappedPos.y() ) ) )
+        {
+            polyline.interrupt();
+
+            // a NaN position never compares equal
+            last = mappedPos;
+            continue;
+        }
+
+        const QPointF pos( round( mappedPos.x() ), round( mappedPos.y() ) );
+
+        if ( weedOut && i > from && pos == last )
+            continue;
+
+        polyline.append( pos );
+        last = pos;
+    }
+
+    polyline.flush();
+}
+
+static inline int qwtOutCode( const QRectF& rect, const QPointF& pos )
+{
+    int code = 0;
+
+    if ( pos.x() < rect.left() )
+        code |= 0x01;
+    else if ( pos.x() > rect.right() )
+        code |= 0x02;
+
+    if ( pos.y() < rect.top() )
+        code |= 0x04;
+    else if ( pos.y() > rect.bottom() )
+        code |= 0x08;
+
+    return code;
+}
+
+/*
+    Reduce the samples to those, that might be visible inside of a rectangle
+    in paint device coordinates. The rectangle is mapped into scale
+    coordinates once, so that the samples outside can be rejected
+    before being transformed.
+
+    For polylines a sample is dropped, when it shares an edge of the
+    rectangle, it is outside of, with its neighbours. Then the lines
+    connecting the neighbours are outside as well and the lines entering
+    and leaving the rectangle remain unchanged.
+
+    Returns false, when less than half of the samples could be rejected
+    and culling is not worth the effort.
+ */
+static bool qwtCullSamples( const QRectF& rect,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    bool isPolyline, QVector< QPointF >& samples )
+{
+    if ( !rect.isValid() || to - from < 2 )
+        return false;
+
+    const QRectF area = QwtScaleMap::invTransform( xMap, yMap, rect ).normalized();
+    const int maxSamples = ( to - from + 1 ) / 2;
+
+    if ( !isPolyline )
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            const QPointF sample = series->sample( i );
+            if ( qwtOutCode( area, sample ) == 0 )
+            {
+                if ( samples.size() >= maxSamples )
+                    return false;
+
+                samples += sample;
+            }
+        }
+
+        return true;
+    }
+
+    QPointF sample = series->sample( from );
+    samples += sample;
+
+    int keptCode = qwtOutCode( area, sample );
+
+    sample = series->sample( from + 1 );
+    int code = qwtOutCode( area, sample );
+
+    for ( int i = from + 1; i < to; i++ )
+    {
+        const QPointF next = series->sample( i + 1 );
+        const int nextCode = qwtOutCode( area, next );
+
+        if ( ( keptCode & code & nextCode ) == 0 )
+        {
+            if ( samples.size() >= maxSamples )
+                return false;
+
+            samples += sample;
+            keptCode = code;
+        }
+
+        sample = next;
+        code = nextCode;
+    }
+
+    samples += sample;
+    return true;
+}
+
+class QwtPointMapper::PrivateData
+{
+  public:
+    PrivateData()
+        : boundingRect( qwtInvalidRect )
+        , numThreads( 1 )
+        , resolution( 0.0 )
+    {
+    }
+
+    /*
+        With CullSamples the series might be replaced by the samples
+        inside of the bounding rectangle.
+     */
+    void cullSamples( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >*& series, int& from, int& to,
+        bool isPolyline, QwtPointSeriesData& culled ) const
+    {
+        if ( !( flags & QwtPointMapper::CullSamples ) )
+            return;
+
+        QVector< QPointF > samples;
+        if ( qwtCullSamples( boundingRect, xMap, yMap,
+            series, from, to, isPolyline, samples ) )
+        {
+            culled.setSamples( samples );
+
+            series = &culled;
+            from = 0;
+            to = samples.size() - 1;
+        }
+    }
+
+    QRectF boundingRect;
+    QwtPointMapper::TransformationFlags flags;
+
+    uint numThreads;
+    double resolution;
+};
+
+//! Constructor
+QwtPointMapper::QwtPointMapper()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtPointMapper::~QwtPointMapper()
+{
+    delete m_data;
+}
+
+/*!
+   Set the flags affecting the transformation process
+
+   \param flags Flags
+   \sa flags(), setFlag()
+ */
+void QwtPointMapper::setFlags( TransformationFlags flags )
+{
+    m_data->flags = flags;
+}
 
 /*!
    \return Flags affecting the transformation process
@@ -598,29 +1698,90 @@ void QwtPointMapper::setFlag( TransformationFlag flag, bool on )
  */
 bool QwtPointMapper::testFlag( TransformationFlag flag ) const
 {
-    return m_data->flags & flag;
+    return m_data->flags & flag;
+}
+
+/*!
+   Set a bounding rectangle for the point mapping algorithm
+
+   A valid bounding rectangle can be used for optimizations.
+   With CullSamples the samples outside of it are rejected
+   before being mapped.
+
+   \param rect Bounding rectangle
+   \sa boundingRect()
+ */
+void QwtPointMapper::setBoundingRect( const QRectF& rect )
+{
+    m_data->boundingRect = rect;
+}
+
+/*!
+   \return Bounding rectangle
+   \sa setBoundingRect()
+ */
+QRectF QwtPointMapper::boundingRect() const
+{
+    return m_data->boundingRect;
+}
+
+/*!
+   Set the number of threads, that are used for mapping the points,
+   when ParallelMapping is enabled.
+
+   \param numThreads Number of threads to be used for mapping points.
+                     If numThreads is set to 0, the system specific
+                     ideal thread count is used.
+
+   The default thread count is 1 ( = no additional threads )
+
+   \sa renderThreadCount(), ParallelMapping
+ */
+void QwtPointMapper::setRenderThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads to be used for mapping points
+   \sa setRenderThreadCount()
+ */
+uint QwtPointMapper::renderThreadCount() const
+{
+    return m_data->numThreads;
 }
 
 /*!
-   Set a bounding rectangle for the point mapping algorithm
+   \brief Set a resolution for reducing points without rounding
 
-   A valid bounding rectangle can be used for optimizations
+   When RoundPoints is not set and the resolution is > 0.0, toPolygonF()
+   and drawPolyline() split the x axis into columns of 1.0 / resolution
+   and reduce the points of each column to first, minimum, maximum and last
+   point - like WeedOutIntermediatePoints does for integer coordinates.
+   The coordinates of the remaining points are not modified.
 
-   \param rect Bounding rectangle
-   \sa boundingRect()
+   This is useful for vector devices ( PDF, SVG ), where the number
+   of points should be bounded by the resolution of the document
+   and not by the number of samples.
+
+   \param pixelsPerUnit Number of columns per unit of the
+          paint device coordinates. A value <= 0.0 disables the reduction,
+          what is the default setting.
+
+   \sa resolution(), QwtPainter::vectorResolution()
  */
-void QwtPointMapper::setBoundingRect( const QRectF& rect )
+void QwtPointMapper::setResolution( double pixelsPerUnit )
 {
-    m_data->boundingRect = rect;
+    m_data->resolution = qMax( pixelsPerUnit, 0.0 );
 }
 
 /*!
-   \return Bounding rectangle
-   \sa setBoundingRect()
+   \return Resolution for reducing points without rounding
+   \sa setResolution()
  */
-QRectF QwtPointMapper::boundingRect() const
+double QwtPointMapper::resolution() const
 {
-    return m_data->boundingRect;
+    return m_data->resolution;
 }
 
 /*!
@@ -634,7 +1795,11 @@ QRectF QwtPointMapper::boundingRect() const
    when the further processing of the values need a QPolygonF.
 
    When RoundPoints & WeedOutIntermediatePoints is enabled an even more
-   aggressive weeding algorithm is enabled.
+   aggressive weeding algorithm is enabled. Without RoundPoints a similar
+   reduction is done for a resolution() > 0.0.
+
+   When ParallelMapping is enabled the series is mapped in chunks by
+   renderThreadCount() threads.
 
    \param xMap x map
    \param yMap y map
@@ -648,8 +1813,49 @@ QPolygonF QwtPointMapper::toPolygonF(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
     QPolygonF polyline;
 
+    QwtPointSeriesData culled;
+    m_data->cullSamples( xMap, yMap, series, from, to, true, culled );
+
+    if ( from > to )
+        return polyline;
+
+    if ( !( m_data->flags & RoundPoints ) && ( m_data->resolution > 0.0 ) )
+    {
+        polyline = qwtMapPointsColumns( xMap, yMap,
+            series, from, to, m_data->resolution );
+
+        QwtRenderStatistics::addSamples( to - from + 1, polyline.size() );
+        return polyline;
+    }
+
+    if ( m_data->flags & ParallelMapping )
+    {
+        QwtMappingCommand::Mode mode = QwtMappingCommand::Points;
+        if ( m_data->flags & WeedOutPoints )
+            mode = QwtMappingCommand::Filtered;
+
+        if ( m_data->flags & RoundPoints )
+        {
+            if ( m_data->flags & WeedOutIntermediatePoints )
+                mode = QwtMappingCommand::Quadrupel;
+
+            polyline = qwtMapPointsParallel< QPolygonF, QPointF, QwtRoundF >(
+                xMap, yMap, series, from, to, mode, m_data->numThreads );
+        }
+        else
+        {
+            polyline = qwtMapPointsParallel< QPolygonF, QPointF, QwtNoRoundF >(
+                xMap, yMap, series, from, to, mode, m_data->numThreads );
+        }
+
+        QwtRenderStatistics::addSamples( to - from + 1, polyline.size() );
+        return polyline;
+    }
+
     if ( m_data->flags & RoundPoints )
     {
         if ( m_data->flags & WeedOutIntermediatePoints )
@@ -682,9 +1888,141 @@ QPolygonF QwtPointMapper::toPolygonF(
         }
     }
 
+    QwtRenderStatistics::addSamples( to - from + 1, polyline.size() );
     return polyline;
 }
 
+/*!
+   \brief Map, weed, clip and paint a series of points as polyline
+
+   The points are processed in one pass: they are mapped in chunks,
+   weeded according to the WeedOutPoints and RoundPoints flags and
+   clipped segment by segment. The visible parts of the polyline
+   are painted, as soon as the polyline leaves the clip rectangle.
+   Compared to toPolygonF() followed by QwtClipper::clippedPolyline()
+   the unclipped polyline is never materialized, what makes a difference
+   when zooming deep into long curves.
+
+   In combination with WeedOutIntermediatePoints, a resolution()
+   or ParallelMapping the points are translated by toPolygonF()
+   and clipped afterwards.
+
+   \param painter Painter
+   \param clipRect Clip rectangle. For an invalid rectangle
+                   the polyline is not clipped.
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+
+   \sa toPolygonF(), QwtClipper::clippedPolyline()
+ */
+void QwtPointMapper::drawPolyline( QPainter* painter, const QRectF& clipRect,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to ) const
+{
+    processPolyline( painter, NULL, clipRect, xMap, yMap, series, from, to );
+}
+
+/*!
+   \brief Map, weed and clip a series of points as polyline
+
+   The points are processed like in drawPolyline(), but the visible
+   parts of the polyline are returned instead of being painted. This
+   is useful for keeping the result for later paints.
+
+   \param clipRect Clip rectangle. For an invalid rectangle
+                   the polyline is not clipped.
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be mapped
+   \param to Index of the last point to be mapped
+
+   \return Visible parts of the polyline
+   \sa drawPolyline(), QwtPlotCurve::CachePolyline
+ */
+QVector< QPolygonF > QwtPointMapper::toClippedPolylines( const QRectF& clipRect,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to ) const
+{
+    QVector< QPolygonF > parts;
+    processPolyline( NULL, &parts, clipRect, xMap, yMap, series, from, to );
+
+    return parts;
+}
+
+void QwtPointMapper::processPolyline( QPainter* painter,
+    QVector< QPolygonF >* parts, const QRectF& clipRect,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to ) const
+{
+    QwtPointSeriesData culled;
+    m_data->cullSamples( xMap, yMap, series, from, to, true, culled );
+
+    if ( from > to )
+        return;
+
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
+    const TransformationFlags flags = m_data->flags;
+
+    const bool doReduce = ( flags & RoundPoints )
+        ? bool( flags & WeedOutIntermediatePoints ) : ( m_data->resolution > 0.0 );
+
+    if ( ( flags & ParallelMapping ) || doReduce )
+    {
+        // the reduced polygon has no room for gaps,
+        // so each run of samples between them is mapped on its own
+
+        const bool breakAtGaps = flags & BreakAtGaps;
+
+        int i = breakAtGaps ? qwtSkipGaps( *series, from, to ) : from;
+        while ( i <= to )
+        {
+            const int last = breakAtGaps ? qwtFindGap( *series, i, to ) - 1 : to;
+
+            QPolygonF polyline = toPolygonF( xMap, yMap, series, i, last );
+
+            QVector< QPolygonF > visibleParts;
+            if ( clipRect.isValid() )
+                visibleParts = QwtClipper::clippedPolyline( clipRect, polyline );
+            else if ( polyline.size() > 1 )
+                visibleParts += polyline;
+
+            if ( painter )
+            {
+                for ( int j = 0; j < visibleParts.size(); j++ )
+                    QwtPainter::drawPolyline( painter, visibleParts[j] );
+            }
+            else
+            {
+                *parts += visibleParts;
+            }
+
+            QwtScratchPool::release( polyline );
+
+            i = breakAtGaps ? qwtSkipGaps( *series, last + 1, to ) : to + 1;
+        }
+
+        return;
+    }
+
+    const bool weedOut = flags & WeedOutPoints;
+
+    if ( flags & RoundPoints )
+    {
+        qwtDrawPolyline( painter, parts, clipRect, xMap, yMap,
+            series, from, to, weedOut, flags & BreakAtGaps, QwtRoundF() );
+    }
+    else
+    {
+        qwtDrawPolyline( painter, parts, clipRect, xMap, yMap,
+            series, from, to, weedOut, flags & BreakAtGaps, QwtNoRoundF() );
+    }
+}
+
 /*!
    \brief Translate a series of points into a QPolygon
 
@@ -703,8 +2041,32 @@ QPolygon QwtPointMapper::toPolygon(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
     QPolygon polyline;
 
+    QwtPointSeriesData culled;
+    m_data->cullSamples( xMap, yMap, series, from, to, true, culled );
+
+    if ( from > to )
+        return polyline;
+
+    if ( m_data->flags & ParallelMapping )
+    {
+        QwtMappingCommand::Mode mode = QwtMappingCommand::Points;
+
+        if ( m_data->flags & WeedOutIntermediatePoints )
+            mode = QwtMappingCommand::Quadrupel;
+        else if ( m_data->flags & WeedOutPoints )
+            mode = QwtMappingCommand::Filtered;
+
+        polyline = qwtMapPointsParallel< QPolygon, QPoint, QwtRoundI >(
+            xMap, yMap, series, from, to, mode, m_data->numThreads );
+
+        QwtRenderStatistics::addSamples( to - from + 1, polyline.size() );
+        return polyline;
+    }
+
     if ( m_data->flags & WeedOutIntermediatePoints )
     {
         // TODO WeedOutIntermediatePointsY ...
@@ -722,6 +2084,7 @@ QPolygon QwtPointMapper::toPolygon(
             qwtInvalidRect, xMap, yMap, series, from, to );
     }
 
+    QwtRenderStatistics::addSamples( to - from + 1, polyline.size() );
     return polyline;
 }
 
@@ -760,16 +2123,33 @@ QPolygonF QwtPointMapper::toPointsF(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
     QPolygonF points;
 
+    QwtPointSeriesData culled;
+    m_data->cullSamples( xMap, yMap, series, from, to, false, culled );
+
+    if ( from > to )
+        return points;
+
     if ( m_data->flags & WeedOutPoints )
     {
         if ( m_data->flags & RoundPoints )
         {
             if ( m_data->boundingRect.isValid() )
             {
-                points = qwtToPointsFilteredF( m_data->boundingRect,
-                    xMap, yMap, series, from, to );
+                if ( m_data->flags & ParallelMapping )
+                {
+                    points = qwtMapPointsParallel< QPolygonF, QPointF, QwtRoundF >(
+                        xMap, yMap, series, from, to, QwtMappingCommand::Unique,
+                        m_data->numThreads, m_data->boundingRect );
+                }
+                else
+                {
+                    points = qwtToPointsFilteredF( m_data->boundingRect,
+                        xMap, yMap, series, from, to );
+                }
             }
             else
             {
@@ -804,6 +2184,7 @@ QPolygonF QwtPointMapper::toPointsF(
         }
     }
 
+    QwtRenderStatistics::addSamples( to - from + 1, points.size() );
     return points;
 }
 
@@ -834,14 +2215,31 @@ QPolygon QwtPointMapper::toPoints(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
     const QwtSeriesData< QPointF >* series, int from, int to ) const
 {
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
     QPolygon points;
 
+    QwtPointSeriesData culled;
+    m_data->cullSamples( xMap, yMap, series, from, to, false, culled );
+
+    if ( from > to )
+        return points;
+
     if ( m_data->flags & WeedOutPoints )
     {
         if ( m_data->boundingRect.isValid() )
         {
-            points = qwtToPointsFilteredI( m_data->boundingRect,
-                xMap, yMap, series, from, to );
+            if ( m_data->flags & ParallelMapping )
+            {
+                points = qwtMapPointsParallel< QPolygon, QPoint, QwtRoundI >(
+                    xMap, yMap, series, from, to, QwtMappingCommand::Unique,
+                    m_data->numThreads, m_data->boundingRect );
+            }
+            else
+            {
+                points = qwtToPointsFilteredI( m_data->boundingRect,
+                    xMap, yMap, series, from, to );
+            }
         }
         else
         {
@@ -858,10 +2256,252 @@ QPolygon QwtPointMapper::toPoints(
             m_data->boundingRect, xMap, yMap, series, from, to );
     }
 
+    QwtRenderStatistics::addSamples( to - from + 1, points.size() );
     return points;
 }
 
 
+/*!
+   \brief Translate a series of points into interleaved floats
+
+   The result contains x1, y1, x2, y2, ... what can be uploaded
+   to a vertex buffer without any conversion. Compared to a QPolygonF
+   only half of the memory is needed.
+
+   The flags are respected like in toPolygonF() - beside ParallelMapping,
+   what is ignored.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+
+   \return Interleaved coordinates of the translated points
+   \sa toShortVertices(), toPolygonF()
+ */
+QVector< float > QwtPointMapper::toFloatVertices(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to ) const
+{
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
+    QVector< float > vertices;
+
+    const int flags = m_data->flags;
+
+    if ( ( flags & RoundPoints ) && ( flags & WeedOutIntermediatePoints ) )
+    {
+        // the reduced polygon has less than 4 points per pixel
+        vertices = qwtVertices< float >( qwtMapPointsQuad< QPolygon, QPoint >(
+            xMap, yMap, series, from, to ) );
+    }
+    else if ( flags & RoundPoints )
+    {
+        vertices = qwtToVertices< float >( xMap, yMap, series, from, to,
+            flags & WeedOutPoints, QwtRoundF(), QwtFloatVertex() );
+    }
+    else
+    {
+        vertices = qwtToVertices< float >( xMap, yMap, series, from, to,
+            flags & WeedOutPoints, QwtNoRoundF(), QwtFloatVertex() );
+    }
+
+    QwtRenderStatistics::addSamples( to - from + 1, vertices.size() / 2 );
+    return vertices;
+}
+
+/*!
+   \brief Translate a series of points into interleaved 16 bit integers
+
+   The result contains x1, y1, x2, y2, ... rounded to integers, what
+   is a compact representation for rasterizing into images. Compared
+   to a QPolygonF only a quarter of the memory is needed.
+
+   Coordinates outside of the 16 bit range are bounded, so the
+   series should be clipped to a reasonable range before - f.e.
+   by the visible interval of the scale maps.
+
+   The flags are respected like in toPolygon() - beside ParallelMapping,
+   what is ignored.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+
+   \return Interleaved coordinates of the translated points
+   \sa toFloatVertices(), toPolygon()
+ */
+QVector< qint16 > QwtPointMapper::toShortVertices(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to ) const
+{
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
+    QVector< qint16 > vertices;
+
+    if ( m_data->flags & WeedOutIntermediatePoints )
+    {
+        vertices = qwtVertices< qint16 >( qwtMapPointsQuad< QPolygon, QPoint >(
+            xMap, yMap, series, from, to ) );
+    }
+    else
+    {
+        vertices = qwtToVertices< qint16 >( xMap, yMap, series, from, to,
+            m_data->flags & WeedOutPoints, QwtRoundF(), QwtShortVertex() );
+    }
+
+    QwtRenderStatistics::addSamples( to - from + 1, vertices.size() / 2 );
+    return vertices;
+}
+
+/*!
+   \brief Translate a series into an image showing the density of the points
+
+   Like the ImageBuffer mode of toImage() each point is mapped to one pixel.
+   But instead of setting the pixel the number of points, that are mapped
+   to it, is counted. Then the counts are translated into colors
+   by colorMap, where the interval is [ 1, maximum count ]. Pixels without
+   any point remain transparent.
+
+   Each thread accumulates into its own buffer of counters, that are summed
+   up afterwards. So the costs are almost the same as for toImage().
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param colorMap Color map for translating the counts into colors
+   \param numThreads Number of threads to be used for accumulating.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \return Image displaying the density of the series
+   \sa toImage(), setBoundingRect()
+ */
+QImage QwtPointMapper::toDensityImage(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    const QwtColorMap& colorMap, uint numThreads ) const
+{
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
+    const QRect rect = m_data->boundingRect.toAlignedRect();
+
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+    image.fill( Qt::transparent );
+
+    const int numPixels = rect.width() * rect.height();
+    if ( from > to || numPixels <= 0 )
+        return image;
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    // not worth to allocate more counters than points
+    numThreads = qMax( 1u,
+        qMin( numThreads, uint( ( to - from + 1 ) / numPixels ) ) );
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    QwtDotsCommand command;
+    command.series = series;
+    command.rgb = 0;
+
+#if QWT_USE_THREADS
+    QVector< QVector< quint32 > > buffers( numThreads );
+
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+    QList< QFuture< void > > futures;
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        buffers[i].fill( 0, numPixels );
+        quint32* counts = buffers[i].data();
+
+        const int index0 = from + i * numPoints;
+        if ( i == numThreads - 1 )
+        {
+            command.from = index0;
+            command.to = to;
+
+            qwtAccumulateDots( xMap, yMap, command, rect, counts );
+        }
+        else
+        {
+            command.from = index0;
+            command.to = index0 + numPoints - 1;
+
+            futures += QtConcurrent::run( &qwtAccumulateDots,
+                xMap, yMap, command, rect, counts );
+        }
+    }
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+
+    quint32* counts = buffers[0].data();
+
+    for ( uint i = 1; i < numThreads; i++ )
+    {
+        const quint32* c = buffers[i].constData();
+        for ( int j = 0; j < numPixels; j++ )
+            counts[j] += c[j];
+    }
+#else
+    QVector< quint32 > buffer( numPixels, 0 );
+    quint32* counts = buffer.data();
+
+    command.from = from;
+    command.to = to;
+
+    qwtAccumulateDots( xMap, yMap, command, rect, counts );
+#endif
+
+    quint32 maxCount = 0;
+    for ( int i = 0; i < numPixels; i++ )
+        maxCount = qMax( maxCount, counts[i] );
+
+    if ( maxCount == 0 )
+        return image;
+
+    const QwtInterval interval( 1.0, maxCount );
+
+    // most pixels are hit only a few times
+
+    QVector< QRgb > colorTable( int( qMin( maxCount, 1024u ) ) + 1 );
+    for ( int i = 1; i < colorTable.size(); i++ )
+        colorTable[i] = colorMap.rgb( interval, i );
+
+    QRgb* bits = reinterpret_cast< QRgb* >( image.bits() );
+
+    int numHits = 0;
+    for ( int i = 0; i < numPixels; i++ )
+    {
+        const quint32 count = counts[i];
+        if ( count == 0 )
+            continue;
+
+        numHits++;
+
+        if ( count < quint32( colorTable.size() ) )
+            bits[i] = colorTable[ int( count ) ];
+        else
+            bits[i] = colorMap.rgb( interval, count );
+    }
+
+    QwtRenderStatistics::addSamples( to - from + 1, numHits );
+
+    return image;
+}
+
 /*!
    \brief Translate a series into a QImage
 
@@ -887,6 +2527,8 @@ QImage QwtPointMapper::toImage(
 {
     Q_UNUSED( antialiased )
 
+    QwtRenderStatistics::Timer timer( QwtRenderStatistics::Mapping );
+
 #if QWT_USE_THREADS
     if ( numThreads == 0 )
         numThreads = QThread::idealThreadCount();
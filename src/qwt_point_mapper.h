@@ -11,8 +11,10 @@
 #define QWT_POINT_MAPPER_H
 
 #include "qwt_global.h"
+#include <qvector.h>
 
 class QwtScaleMap;
+class QwtColorMap;
 template< typename T > class QwtSeriesData;
 class QPolygonF;
 class QPointF;
@@ -20,6 +22,7 @@ class QRectF;
 class QPolygon;
 class QPen;
 class QImage;
+class QPainter;
 
 /*!
    \brief A helper class for translating a series of points
@@ -65,7 +68,50 @@ class QWT_EXPORT QwtPointMapper
            As the algorithm is fast it can be used inside of
            a polyline render cycle.
          */
-        WeedOutIntermediatePoints = 0x04
+        WeedOutIntermediatePoints = 0x04,
+
+        /*!
+           Split the series into chunks, that are mapped and weeded
+           in parallel in toPolygon()/toPolygonF(). The results are stitched
+           together, including the weeding at the seams of the chunks.
+
+           toPoints()/toPointsF() remove the duplicates of WeedOutPoints
+           for each chunk with its own bitmap and the duplicates between
+           chunks in a final pass over the reduced points.
+
+           The number of threads is specified by setRenderThreadCount().
+           For small series parallel mapping is not worth the overhead,
+           and the points are mapped in the calling thread.
+         */
+        ParallelMapping = 0x08,
+
+        /*!
+           The boundingRect() is mapped into scale coordinates once and
+           samples outside of it are rejected before being transformed.
+           For polylines runs of samples outside of the same edge are
+           reduced to their first and last sample, so that the lines
+           entering and leaving the rectangle remain unchanged.
+
+           Culling applies to toPolygonF(), toPolygon(), drawPolyline(),
+           toPoints() and toPointsF(). It is intended for series, where
+           the visible samples can't be found by a binary search
+           ( f.e. scatter plots ), and is skipped, when less than half
+           of the samples can be rejected.
+
+           \note The result of a curve fitter depends on all samples, so
+                 culling should not be enabled for fitted curves.
+         */
+        CullSamples = 0x10,
+
+        /*!
+           Samples with a NaN coordinate are gaps, where drawPolyline()
+           interrupts the polyline. The gaps are detected while mapping
+           and clipping, so that a series with dropouts can be painted
+           without splitting it into separate series.
+
+           \sa qwtFindGap(), qwtSkipGaps()
+         */
+        BreakAtGaps = 0x20
     };
 
     Q_DECLARE_FLAGS( TransformationFlags, TransformationFlag )
@@ -82,9 +128,23 @@ class QWT_EXPORT QwtPointMapper
     void setBoundingRect( const QRectF& );
     QRectF boundingRect() const;
 
+    void setRenderThreadCount( uint numThreads );
+    uint renderThreadCount() const;
+
+    void setResolution( double pixelsPerUnit );
+    double resolution() const;
+
     QPolygonF toPolygonF( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
+    void drawPolyline( QPainter*, const QRectF& clipRect,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to ) const;
+
+    QVector< QPolygonF > toClippedPolylines( const QRectF& clipRect,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to ) const;
+
     QPolygon toPolygon( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
@@ -94,13 +154,29 @@ class QWT_EXPORT QwtPointMapper
     QPolygonF toPointsF( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
+    QVector< float > toFloatVertices(
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to ) const;
+
+    QVector< qint16 > toShortVertices(
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to ) const;
+
     QImage toImage( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to,
         const QPen&, bool antialiased, uint numThreads ) const;
 
+    QImage toDensityImage( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to,
+        const QwtColorMap&, uint numThreads ) const;
+
   private:
     Q_DISABLE_COPY(QwtPointMapper)
 
+    void processPolyline( QPainter*, QVector< QPolygonF >*,
+        const QRectF& clipRect, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
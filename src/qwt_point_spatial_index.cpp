@@ -0,0 +1,448 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_point_spatial_index.h"
+#include "qwt_scale_map.h"
+#include "qwt_transform.h"
+
+#include <qvector.h>
+#include <qnumeric.h>
+
+#include <algorithm>
+#include <typeinfo>
+#include <cmath>
+
+namespace
+{
+    // number of nodes, that are scanned linearly
+    const int qwtLeafSize = 8;
+
+    // closestPoint() ignores points with a larger squared distance
+    const double qwtMaxDistance = 1.0e10;
+
+    class QwtIndexNode
+    {
+      public:
+        double value[2];
+        int index;
+    };
+
+    class QwtNodeLessThan
+    {
+      public:
+        explicit QwtNodeLessThan( int axis )
+            : m_axis( axis )
+        {
+        }
+
+        inline bool operator()( const QwtIndexNode& n1, const QwtIndexNode& n2 ) const
+        {
+            return n1.value[m_axis] < n2.value[m_axis];
+        }
+
+      private:
+        int m_axis;
+    };
+
+    /*
+        Identifies the transformation of a scale map. The values of
+        some probes are compared, as the maps returned by
+        QwtPlot::canvasMap() have their own copies of the transformation.
+     */
+    class QwtTransformKey
+    {
+      public:
+        QwtTransformKey()
+            : type( NULL )
+            , probe1( 0.0 )
+            , probe2( 0.0 )
+        {
+        }
+
+        explicit QwtTransformKey( const QwtTransform* transform )
+            : type( NULL )
+            , probe1( 0.0 )
+            , probe2( 0.0 )
+        {
+            if ( transform )
+            {
+                type = &typeid( *transform );
+                probe1 = transform->transform( 2.0 );
+                probe2 = transform->transform( 10.0 );
+            }
+        }
+
+        bool operator==( const QwtTransformKey& other ) const
+        {
+            if ( type == NULL || other.type == NULL )
+                return type == other.type;
+
+            return *type == *other.type
+                && probe1 == other.probe1 && probe2 == other.probe2;
+        }
+
+        const std::type_info* type;
+        double probe1;
+        double probe2;
+    };
+
+    /*
+        The parameters to calculate the distance in paint device coordinates
+        from a transformed value t: d = ( t - ts1 ) * cnv + offset
+     */
+    class QwtAxisMetric
+    {
+      public:
+        QwtAxisMetric( const QwtScaleMap& map, double pos )
+        {
+            const QwtTransform* transform = map.transformation();
+
+            double ts2 = map.s2();
+
+            ts1 = map.s1();
+            if ( transform )
+            {
+                ts1 = transform->transform( ts1 );
+                ts2 = transform->transform( ts2 );
+            }
+
+            cnv = 1.0;
+            if ( ts1 != ts2 )
+                cnv = ( map.p2() - map.p1() ) / ( ts2 - ts1 );
+
+            offset = map.p1() - pos;
+        }
+
+        inline double distance( double t ) const
+        {
+            return ( t - ts1 ) * cnv + offset;
+        }
+
+        double ts1;
+        double cnv;
+        double offset;
+    };
+
+    class QwtNearestSearch
+    {
+      public:
+        QwtNearestSearch( const QwtIndexNode* nodes,
+                const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QPointF& pos )
+            : index( -1 )
+            , distance( qwtMaxDistance )
+            , m_nodes( nodes )
+            , m_xMetric( xMap, pos.x() )
+            , m_yMetric( yMap, pos.y() )
+        {
+        }
+
+        void search( int from, int to, int axis )
+        {
+            // nodes in [from, to[ have been partitioned around
+            // the median with respect to axis
+
+            if ( to - from <= qwtLeafSize )
+            {
+                for ( int i = from; i < to; i++ )
+                    check( m_nodes[i] );
+
+                return;
+            }
+
+            const int mid = ( from + to ) / 2;
+
+            const QwtIndexNode& node = m_nodes[mid];
+            check( node );
+
+            const QwtAxisMetric& metric = ( axis == 0 ) ? m_xMetric : m_yMetric;
+            const double d = metric.distance( node.value[axis] );
+
+            // the query position is on the side of smaller values,
+            // when the paint distance has the same sign as the factor
+
+            const bool lower = ( d >= 0.0 ) == ( metric.cnv > 0.0 );
+            const int nextAxis = 1 - axis;
+
+            if ( lower )
+            {
+                search( from, mid, nextAxis );
+                if ( d * d <= distance )
+                    search( mid + 1, to, nextAxis );
+            }
+            else
+            {
+                search( mid + 1, to, nextAxis );
+                if ( d * d <= distance )
+                    search( from, mid, nextAxis );
+            }
+        }
+
+        int index;
+        double distance;
+
+      private:
+        inline void check( const QwtIndexNode& node )
+        {
+            const double dx = m_xMetric.distance( node.value[0] );
+            const double dy = m_yMetric.distance( node.value[1] );
+
+            const double f = dx * dx + dy * dy;
+            if ( f < distance || ( f == distance && node.index < index ) )
+            {
+                distance = f;
+                index = node.index;
+            }
+        }
+
+        const QwtIndexNode* m_nodes;
+        const QwtAxisMetric m_xMetric;
+        const QwtAxisMetric m_yMetric;
+    };
+}
+
+static void qwtBuildTree( QwtIndexNode* nodes, int from, int to, int axis )
+{
+    if ( to - from <= qwtLeafSize )
+        return;
+
+    const int mid = ( from + to ) / 2;
+
+    std::nth_element( nodes + from, nodes + mid, nodes + to,
+        QwtNodeLessThan( axis ) );
+
+    qwtBuildTree( nodes, from, mid, 1 - axis );
+    qwtBuildTree( nodes, mid + 1, to, 1 - axis );
+}
+
+static inline double qwtTransformValue( const QwtTransform* transform, double value )
+{
+    return transform ? transform->transform( value ) : value;
+}
+
+class QwtPointSpatialIndex::PrivateData
+{
+  public:
+    PrivateData()
+        : series( NULL )
+        , numSamples( 0 )
+        , isDirty( true )
+        , isMonotonic( false )
+    {
+    }
+
+    void build( const QwtSeriesData< QPointF >* series,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap )
+    {
+        const QwtTransformKey xKey( xMap.transformation() );
+        const QwtTransformKey yKey( yMap.transformation() );
+
+        if ( !isDirty && series == this->series
+            && series->size() == numSamples )
+        {
+            if ( isMonotonic || ( xKey == xTransform && yKey == yTransform ) )
+                return;
+        }
+
+        this->series = series;
+        numSamples = series->size();
+        isDirty = false;
+
+        xTransform = xKey;
+        yTransform = yKey;
+
+        nodes.clear();
+
+        isMonotonic = true;
+        for ( size_t i = 1; i < numSamples; i++ )
+        {
+            if ( !( series->sample( i ).x() >= series->sample( i - 1 ).x() ) )
+            {
+                isMonotonic = false;
+                break;
+            }
+        }
+
+        if ( isMonotonic )
+            return;
+
+        const QwtTransform* tx = xMap.transformation();
+        const QwtTransform* ty = yMap.transformation();
+
+        nodes.reserve( int( numSamples ) );
+
+        for ( size_t i = 0; i < numSamples; i++ )
+        {
+            const QPointF sample = series->sample( i );
+
+            QwtIndexNode node;
+            node.value[0] = qwtTransformValue( tx, sample.x() );
+            node.value[1] = qwtTransformValue( ty, sample.y() );
+            node.index = int( i );
+
+            // points that can't be mapped are never the closest point
+
+            if ( qIsFinite( node.value[0] ) && qIsFinite( node.value[1] ) )
+                nodes += node;
+        }
+
+        qwtBuildTree( nodes.data(), 0, nodes.size(), 0 );
+    }
+
+    int upperIndex( double value ) const
+    {
+        // index of the first sample with x >= value
+
+        int n = int( numSamples );
+        int index = 0;
+
+        while ( n > 0 )
+        {
+            const int half = n >> 1;
+            const int indexMid = index + half;
+
+            if ( series->sample( indexMid ).x() < value )
+            {
+                index = indexMid + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+
+        return index;
+    }
+
+    const QwtSeriesData< QPointF >* series;
+    size_t numSamples;
+
+    bool isDirty;
+    bool isMonotonic;
+
+    QwtTransformKey xTransform;
+    QwtTransformKey yTransform;
+
+    QVector< QwtIndexNode > nodes;
+};
+
+//! Constructor
+QwtPointSpatialIndex::QwtPointSpatialIndex()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtPointSpatialIndex::~QwtPointSpatialIndex()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Invalidate the index
+
+   invalidate() has to be called, whenever samples of the series
+   have been modified. The index will be rebuilt, when it is needed
+   the next time.
+ */
+void QwtPointSpatialIndex::invalidate()
+{
+    m_data->isDirty = true;
+    m_data->nodes.clear();
+}
+
+/*!
+   Find the closest sample of a series to a position
+
+   The result is the same as calculating the distances of all samples
+   in paint device coordinates, but the costs are O(log n) on average.
+
+   \param series Series of points
+   \param xMap Maps x-values into pixel coordinates
+   \param yMap Maps y-values into pixel coordinates
+   \param pos Position in paint device coordinates
+   \param dist If dist != NULL, closestPoint() returns the distance between
+               the position and the closest point
+
+   \return Index of the closest point, or -1 if none can be found
+ */
+int QwtPointSpatialIndex::closestPoint( const QwtSeriesData< QPointF >* series,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QPointF& pos, double* dist ) const
+{
+    if ( series == NULL || series->size() == 0 )
+        return -1;
+
+    m_data->build( series, xMap, yMap );
+
+    int index = -1;
+    double dmin = qwtMaxDistance;
+
+    if ( m_data->isMonotonic )
+    {
+        /*
+            starting at the samples around the x coordinate of the position
+            and walking in both directions, until the horizontal distance
+            exceeds the distance of the closest point
+         */
+
+        const int numSamples = int( m_data->numSamples );
+        const int start = m_data->upperIndex( xMap.invTransform( pos.x() ) );
+
+        for ( int i = start - 1; i >= 0; i-- )
+        {
+            const QPointF sample = series->sample( i );
+
+            const double cx = xMap.transform( sample.x() ) - pos.x();
+            if ( cx * cx > dmin )
+                break;
+
+            const double cy = yMap.transform( sample.y() ) - pos.y();
+
+            const double f = cx * cx + cy * cy;
+            if ( f < dmin || ( f == dmin && index >= 0 ) )
+            {
+                // on equal distances the lower index wins
+                index = i;
+                dmin = f;
+            }
+        }
+
+        for ( int i = start; i < numSamples; i++ )
+        {
+            const QPointF sample = series->sample( i );
+
+            const double cx = xMap.transform( sample.x() ) - pos.x();
+            if ( cx * cx > dmin )
+                break;
+
+            const double cy = yMap.transform( sample.y() ) - pos.y();
+
+            const double f = cx * cx + cy * cy;
+            if ( f < dmin || ( f == dmin && i < index ) )
+            {
+                index = i;
+                dmin = f;
+            }
+        }
+    }
+    else if ( !m_data->nodes.isEmpty() )
+    {
+        QwtNearestSearch search( m_data->nodes.constData(), xMap, yMap, pos );
+        search.search( 0, m_data->nodes.size(), 0 );
+
+        index = search.index;
+        dmin = search.distance;
+    }
+
+    if ( dist )
+        *dist = std::sqrt( dmin );
+
+    return index;
+}
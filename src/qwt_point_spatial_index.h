@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_POINT_SPATIAL_INDEX_H
+#define QWT_POINT_SPATIAL_INDEX_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtScaleMap;
+
+/*!
+   \brief An index for finding the sample closest to a position
+
+   QwtPointSpatialIndex answers nearest neighbour queries in paint device
+   coordinates for a series of points, without iterating over all samples:
+
+   - For series with x coordinates in increasing order
+     ( f.e. recordings of a signal ) the samples around the position
+     are found by a binary search. No additional memory is needed.
+
+   - For all other series ( f.e. scatter plots ) a k-d tree is
+     built from the transformed coordinates of the samples. As the tree
+     is independent of the scale intervals it remains valid when
+     zooming or panning. It is rebuilt when the transformations
+     of the scale maps ( f.e. QwtLogTransform ) differ.
+
+   The index is built lazily, when it is needed the first time. When the
+   samples of the series have been modified invalidate() has to be called.
+   A different series or a different number of samples are detected
+   automatically.
+
+   \sa QwtPlotCurve::setSpatialIndexEnabled(), QwtPlotCurve::closestPoint()
+ */
+class QWT_EXPORT QwtPointSpatialIndex
+{
+  public:
+    QwtPointSpatialIndex();
+    ~QwtPointSpatialIndex();
+
+    void invalidate();
+
+    int closestPoint( const QwtSeriesData< QPointF >*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QPointF& pos, double* dist = NULL ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtPointSpatialIndex )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -17,6 +17,13 @@
 #include "qwt_clipper.h"
 
 #include <qpainter.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
 
 static inline bool qwtInsidePole( const QwtScaleMap& map, double radius )
 {
@@ -37,12 +44,159 @@ static int qwtVerifyRange( int size, int& i1, int& i2 )
     return ( i2 - i1 + 1 );
 }
 
+namespace
+{
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class QwtPolarMappingCommand
+    {
+      public:
+        const QwtSeriesData< QwtPointPolar >* series;
+        int from;
+        int to;
+
+        QPointF pole;
+        bool filter;
+    };
+}
+
+static inline bool qwtSamePixel( const QPointF& p1, const QPointF& p2 )
+{
+    return ( qRound( p1.x() ) == qRound( p2.x() ) )
+        && ( qRound( p1.y() ) == qRound( p2.y() ) );
+}
+
+static void qwtMapPolarChunk(
+    const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+    const QwtPolarMappingCommand& command, QPolygonF* polygon )
+{
+    const QwtSeriesData< QwtPointPolar >* series = command.series;
+    const QPointF& pole = command.pole;
+
+    polygon->resize( command.to - command.from + 1 );
+    QPointF* points = polygon->data();
+
+    int numPoints = 0;
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtPointPolar point = series->sample( i );
+
+        QPointF pos = pole;
+        if ( !qwtInsidePole( radialMap, point.radius() ) )
+        {
+            const double r = radialMap.transform( point.radius() );
+            const double a = azimuthMap.transform( point.azimuth() );
+
+            pos = qwtPolar2Pos( pole, r, a );
+        }
+
+        if ( command.filter && numPoints > 0
+            && qwtSamePixel( points[numPoints - 1], pos ) )
+        {
+            continue;
+        }
+
+        points[numPoints++] = pos;
+    }
+
+    polygon->resize( numPoints );
+}
+
+static QPolygonF qwtMapPolarPoints(
+    const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+    const QwtSeriesData< QwtPointPolar >* series, const QPointF& pole,
+    int from, int to, bool filter, uint numThreads )
+{
+    // chunks below this size are not worth the threading overhead
+    const int minChunkSize = 10000;
+
+    QwtPolarMappingCommand command;
+    command.series = series;
+    command.pole = pole;
+    command.filter = filter;
+
+    const int numPoints = to - from + 1;
+
+    int numChunks = 1;
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numChunks = qBound( 1, numPoints / minChunkSize, int( numThreads ) );
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    QVector< QPolygonF > chunks( numChunks );
+
+    const int chunkSize = numPoints / numChunks;
+
+#if QWT_USE_THREADS
+    QList< QFuture< void > > futures;
+#endif
+
+    for ( int i = 0; i < numChunks; i++ )
+    {
+        command.from = from + i * chunkSize;
+
+        if ( i == numChunks - 1 )
+        {
+            command.to = to;
+            qwtMapPolarChunk( azimuthMap, radialMap, command, &chunks[i] );
+        }
+        else
+        {
+            command.to = command.from + chunkSize - 1;
+
+#if QWT_USE_THREADS
+            futures += QtConcurrent::run( &qwtMapPolarChunk,
+                azimuthMap, radialMap, command, &chunks[i] );
+#endif
+        }
+    }
+
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
+    if ( numChunks == 1 )
+        return chunks[0];
+
+    int numStitched = 0;
+    for ( int i = 0; i < numChunks; i++ )
+        numStitched += chunks[i].size();
+
+    QPolygonF polyline;
+    polyline.reserve( numStitched );
+
+    for ( int i = 0; i < numChunks; i++ )
+    {
+        const QPolygonF& chunk = chunks[i];
+
+        int index0 = 0;
+        if ( filter && !polyline.isEmpty() && !chunk.isEmpty()
+            && qwtSamePixel( polyline.last(), chunk.first() ) )
+        {
+            // consecutive duplicate at the seam
+            index0 = 1;
+        }
+
+        for ( int j = index0; j < chunk.size(); j++ )
+            polyline += chunk[j];
+    }
+
+    return polyline;
+}
+
 class QwtPolarCurve::PrivateData
 {
   public:
     PrivateData()
         : style( QwtPolarCurve::Lines )
         , curveFitter( NULL )
+        , paintAttributes( QwtPolarCurve::ClipPolygons )
     {
         symbol = new QwtSymbol();
         pen = QPen( Qt::black );
@@ -59,6 +213,7 @@ class QwtPolarCurve::PrivateData
     QPen pen;
     QwtCurveFitter* curveFitter;
 
+    QwtPolarCurve::PaintAttributes paintAttributes;
     QwtPolarCurve::LegendAttributes legendAttributes;
 };
 
@@ -143,6 +298,30 @@ bool QwtPolarCurve::testLegendAttribute( LegendAttribute attribute ) const
     return ( m_data->legendAttributes & attribute );
 }
 
+/*!
+   Specify an attribute how to draw the curve
+
+   \param attribute Paint attribute
+   \param on On/Off
+   \sa testPaintAttribute()
+ */
+void QwtPolarCurve::setPaintAttribute( PaintAttribute attribute, bool on )
+{
+    if ( on )
+        m_data->paintAttributes |= attribute;
+    else
+        m_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa setPaintAttribute()
+ */
+bool QwtPolarCurve::testPaintAttribute( PaintAttribute attribute ) const
+{
+    return ( m_data->paintAttributes & attribute );
+}
+
 /*!
    Set the curve's drawing style
 
@@ -362,7 +541,12 @@ void QwtPolarCurve::drawCurve( QPainter* painter, int style,
    \param pole Position of the pole in painter coordinates
    \param from index of the first point to be painted
    \param to index of the last point to be painted.
-   \sa draw(), drawLines(), setCurveFitter()
+
+   Curves with many points are mapped in parallel, when a
+   renderThreadCount() other than 1 has been set.
+
+   \sa draw(), drawLines(), setCurveFitter(), setPaintAttribute(),
+       QwtPolarItem::setRenderThreadCount()
  */
 void QwtPolarCurve::drawLines( QPainter* painter,
     const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
@@ -402,23 +586,14 @@ void QwtPolarCurve::drawLines( QPainter* painter,
     }
     else
     {
-        polyline.resize( size );
-        QPointF* polylineData = polyline.data();
+        polyline = qwtMapPolarPoints( azimuthMap, radialMap, m_series, pole,
+            from, to, testPaintAttribute( FilterPoints ), renderThreadCount() );
+    }
 
-        for ( int i = from; i <= to; i++ )
-        {
-            QwtPointPolar point = sample( i );
-            if ( !qwtInsidePole( radialMap, point.radius() ) )
-            {
-                double r = radialMap.transform( point.radius() );
-                const double a = azimuthMap.transform( point.azimuth() );
-                polylineData[i - from] = qwtPolar2Pos( pole, r, a );
-            }
-            else
-            {
-                polylineData[i - from] = pole;
-            }
-        }
+    if ( !testPaintAttribute( ClipPolygons ) )
+    {
+        QwtPainter::drawPolyline( painter, polyline );
+        return;
     }
 
     QRectF clipRect;
@@ -435,9 +610,33 @@ void QwtPolarCurve::drawLines( QPainter* painter,
 
     if ( !clipRect.isEmpty() )
     {
+        /*
+           QwtPolarPlot clips items with points outside of the radial
+           scale to the plot circle. As clipping to a circular region
+           is slow, we cut off what is outside of its bounding rectangle
+           before.
+         */
+        const double radius = qMax( qAbs( radialMap.p1() ), qAbs( radialMap.p2() ) );
+        if ( radius > 0.0 )
+        {
+            const QRectF circleRect( pole.x() - radius, pole.y() - radius,
+                2 * radius, 2 * radius );
+
+            const QRectF r = clipRect & circleRect;
+            if ( !r.isEmpty() )
+                clipRect = r;
+        }
+
         double off = qCeil( qMax( qreal( 1.0 ), painter->pen().widthF() ) );
         clipRect = clipRect.toRect().adjusted( -off, -off, off, off );
-        QwtClipper::clipPolygonF( clipRect, polyline );
+
+        const QVector< QPolygonF > parts =
+            QwtClipper::clippedPolyline( clipRect, polyline );
+
+        for ( int i = 0; i < parts.size(); i++ )
+            QwtPainter::drawPolyline( painter, parts[i] );
+
+        return;
     }
 
     QwtPainter::drawPolyline( painter, polyline );
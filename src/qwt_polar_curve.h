@@ -74,6 +74,31 @@ class QWT_EXPORT QwtPolarCurve : public QwtPolarItem
 
     Q_DECLARE_FLAGS( LegendAttributes, LegendAttribute )
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        The default setting enables ClipPolygons
+
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+           Clip polygons before painting them. In situations, where points
+           are far outside the visible area (f.e when zooming deep) this
+           might be a substantial improvement for the painting performance
+         */
+        ClipPolygons = 0x01,
+
+        /*!
+           Consecutive points, that are mapped to the same pixel, are
+           omitted. This has a notable impact on curves with many
+           close points, like sweeps with a high angular resolution.
+         */
+        FilterPoints = 0x02
+    };
+
+    Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
+
 
     explicit QwtPolarCurve();
     explicit QwtPolarCurve( const QwtText& title );
@@ -83,6 +108,9 @@ class QWT_EXPORT QwtPolarCurve : public QwtPolarItem
 
     virtual int rtti() const QWT_OVERRIDE;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setLegendAttribute( LegendAttribute, bool on = true );
     bool testLegendAttribute( LegendAttribute ) const;
 
@@ -155,6 +183,7 @@ inline QwtPointPolar QwtPolarCurve::sample( int i ) const
     return m_series->sample( i );
 }
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPolarCurve::PaintAttributes )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPolarCurve::LegendAttributes )
 
 #endif
@@ -0,0 +1,407 @@
+/******************************************************************************
+ * QwtPolar Widget Library
+ * Copyright (C) 2008   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_polar_directpainter.h"
+#include "qwt_polar_plot.h"
+#include "qwt_polar_canvas.h"
+#include "qwt_polar_curve.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qevent.h>
+#include <qpixmap.h>
+
+static inline bool qwtHasBackingStore( const QwtPolarCanvas* canvas )
+{
+    return canvas->testPaintAttribute( QwtPolarCanvas::BackingStore )
+           && canvas->backingStore() && !canvas->backingStore()->isNull();
+}
+
+static QPainterPath qwtSectorPath( const QwtScaleMap& azimuthMap,
+    const QPointF& pole, double radius, const QwtInterval& azimuthInterval )
+{
+    const double a1 = azimuthMap.transform( azimuthInterval.minValue() );
+    const double a2 = azimuthMap.transform( azimuthInterval.maxValue() );
+
+    QRectF rect( 0.0, 0.0, 2 * radius, 2 * radius );
+    rect.moveCenter( pole );
+
+    QPainterPath path;
+    path.moveTo( pole );
+    path.arcTo( rect, qwtDegrees( a1 ), qwtDegrees( a2 - a1 ) );
+    path.closeSubpath();
+
+    return path;
+}
+
+static void qwtRenderItem( QPainter* painter, const QRect& canvasRect,
+    QwtPolarItem* item, int from, int to, const QwtInterval& azimuthInterval )
+{
+    const QwtPolarPlot* plot = item->plot();
+
+    const QRectF pr = plot->plotRect( canvasRect );
+    const double radius = pr.width() / 2.0;
+    const QPointF pole = pr.center();
+
+    const QwtScaleMap azimuthMap = plot->scaleMap( QwtPolar::Azimuth, radius );
+    const QwtScaleMap radialMap = plot->scaleMap( QwtPolar::Radius, radius );
+
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPolarItem::RenderAntialiased ) );
+
+    if ( azimuthInterval.isValid() )
+    {
+        const double span = qAbs( azimuthMap.transform( azimuthInterval.maxValue() )
+            - azimuthMap.transform( azimuthInterval.minValue() ) );
+
+        if ( span < 2 * M_PI )
+        {
+            // the item clips itself to the plot area, the margin
+            // is for the parts outside, like the axes of a grid
+
+            const QPainterPath sector = qwtSectorPath( azimuthMap,
+                pole, radius + item->marginHint(), azimuthInterval );
+
+            painter->setClipPath( sector, Qt::IntersectClip );
+        }
+
+        item->draw( painter, azimuthMap, radialMap, pole, radius, canvasRect );
+    }
+    else
+    {
+        // see QwtPolarPlot::drawItems
+        const QwtInterval intv = item->boundingInterval( QwtPolar::Radius );
+
+        bool doClipping = !intv.isValid();
+        if ( !doClipping )
+        {
+            if ( radialMap.s1() < radialMap.s2() )
+                doClipping = intv.maxValue() > radialMap.s2();
+            else
+                doClipping = intv.minValue() < radialMap.s2();
+        }
+
+        if ( doClipping )
+        {
+            const int margin = item->marginHint();
+
+            const QRectF clipRect = pr.adjusted(
+                -margin, -margin, margin, margin );
+            if ( !clipRect.contains( QRectF( canvasRect ) ) )
+            {
+                QRegion clipRegion( clipRect.toRect(), QRegion::Ellipse );
+                painter->setClipRegion( clipRegion, Qt::IntersectClip );
+            }
+        }
+
+        const QwtPolarCurve* curve = static_cast< const QwtPolarCurve* >( item );
+        curve->draw( painter, azimuthMap, radialMap, pole, from, to );
+    }
+
+    painter->restore();
+}
+
+class QwtPolarDirectPainter::PrivateData
+{
+  public:
+    PrivateData()
+        : hasClipping( false )
+        , item( NULL )
+        , from( 0 )
+        , to( 0 )
+    {
+    }
+
+    QwtPolarDirectPainter::Attributes attributes;
+
+    bool hasClipping;
+    QRegion clipRegion;
+
+    QPainter painter;
+
+    QwtPolarItem* item;
+    int from;
+    int to;
+    QwtInterval azimuthInterval;
+};
+
+//! Constructor
+QwtPolarDirectPainter::QwtPolarDirectPainter( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtPolarDirectPainter::~QwtPolarDirectPainter()
+{
+    delete m_data;
+}
+
+/*!
+   Change an attribute
+
+   \param attribute Attribute to change
+   \param on On/Off
+
+   \sa Attribute, testAttribute()
+ */
+void QwtPolarDirectPainter::setAttribute( Attribute attribute, bool on )
+{
+    if ( bool( m_data->attributes & attribute ) != on )
+    {
+        if ( on )
+            m_data->attributes |= attribute;
+        else
+            m_data->attributes &= ~attribute;
+
+        if ( ( attribute == AtomicPainter ) && on )
+            reset();
+    }
+}
+
+/*!
+   \return True, when attribute is enabled
+   \param attribute Attribute to be tested
+   \sa Attribute, setAttribute()
+ */
+bool QwtPolarDirectPainter::testAttribute( Attribute attribute ) const
+{
+    return m_data->attributes & attribute;
+}
+
+/*!
+   En/Disables clipping
+
+   \param enable Enables clipping is true, disable it otherwise
+   \sa hasClipping(), clipRegion(), setClipRegion()
+ */
+void QwtPolarDirectPainter::setClipping( bool enable )
+{
+    m_data->hasClipping = enable;
+}
+
+/*!
+   \return true, when clipping is enabled
+   \sa setClipping(), clipRegion(), setClipRegion()
+ */
+bool QwtPolarDirectPainter::hasClipping() const
+{
+    return m_data->hasClipping;
+}
+
+/*!
+   \brief Assign a clip region and enable clipping
+
+   \param region Clip region
+   \sa clipRegion(), hasClipping(), setClipping()
+ */
+void QwtPolarDirectPainter::setClipRegion( const QRegion& region )
+{
+    m_data->clipRegion = region;
+    m_data->hasClipping = true;
+}
+
+/*!
+   \return Currently set clip region.
+   \sa setClipRegion(), setClipping(), hasClipping()
+ */
+QRegion QwtPolarDirectPainter::clipRegion() const
+{
+    return m_data->clipRegion;
+}
+
+/*!
+   \brief Draw a set of points of a curve.
+
+   When observing a measurement while it is running, new points have to be
+   added to an existing curve. drawSeries() can be used to display them
+   avoiding a complete redraw of the canvas.
+
+   \param curve Curve to be painted
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted. If to < 0 the
+         curve will be painted to its last point.
+
+   \sa drawSector()
+ */
+void QwtPolarDirectPainter::drawSeries(
+    QwtPolarCurve* curve, int from, int to )
+{
+    drawItem( curve, from, to, QwtInterval() );
+}
+
+/*!
+   \brief Draw the sector of an item
+
+   The item is painted with a clip path, that is limited to the sector
+   of the azimuth interval. The item is expected to respect the clip
+   for its expensive operations - f.e. QwtPolarSpectrogram renders
+   the image for the bounding rectangle of the sector only.
+
+   Typically used for radar displays, where only the sector of the
+   latest spoke needs to be updated.
+
+   \param item Item to be painted
+   \param azimuthInterval Sector in azimuth scale coordinates. When the
+          interval covers the complete circle the item is painted without
+          clipping.
+
+   \sa drawSeries()
+ */
+void QwtPolarDirectPainter::drawSector(
+    QwtPolarItem* item, const QwtInterval& azimuthInterval )
+{
+    if ( azimuthInterval.isValid() )
+        drawItem( item, 0, -1, azimuthInterval.normalized() );
+}
+
+void QwtPolarDirectPainter::drawItem( QwtPolarItem* item,
+    int from, int to, const QwtInterval& azimuthInterval )
+{
+    if ( item == NULL || item->plot() == NULL )
+        return;
+
+    QwtPolarCanvas* canvas = item->plot()->canvas();
+    const QRect canvasRect = canvas->contentsRect();
+
+    if ( qwtHasBackingStore( canvas ) )
+    {
+        QPainter painter( const_cast< QPixmap* >( canvas->backingStore() ) );
+
+        if ( m_data->hasClipping )
+            painter.setClipRegion( m_data->clipRegion );
+
+        qwtRenderItem( &painter, canvasRect,
+            item, from, to, azimuthInterval );
+
+        painter.end();
+
+        if ( testAttribute( QwtPolarDirectPainter::FullRepaint ) )
+        {
+            canvas->repaint();
+            return;
+        }
+    }
+
+    bool immediatePaint = true;
+    if ( !canvas->testAttribute( Qt::WA_WState_InPaintEvent ) )
+    {
+#if QT_VERSION < 0x050000
+        if ( !canvas->testAttribute( Qt::WA_PaintOutsidePaintEvent ) )
+#endif
+        immediatePaint = false;
+    }
+
+    if ( immediatePaint )
+    {
+        if ( !m_data->painter.isActive() )
+        {
+            reset();
+
+            m_data->painter.begin( canvas );
+            canvas->installEventFilter( this );
+        }
+
+        if ( m_data->hasClipping )
+        {
+            m_data->painter.setClipRegion(
+                QRegion( canvasRect ) & m_data->clipRegion );
+        }
+        else
+        {
+            if ( !m_data->painter.hasClipping() )
+                m_data->painter.setClipRect( canvasRect );
+        }
+
+        qwtRenderItem( &m_data->painter, canvasRect,
+            item, from, to, azimuthInterval );
+
+        if ( m_data->attributes & QwtPolarDirectPainter::AtomicPainter )
+        {
+            reset();
+        }
+        else
+        {
+            if ( m_data->hasClipping )
+                m_data->painter.setClipping( false );
+        }
+    }
+    else
+    {
+        reset();
+
+        m_data->item = item;
+        m_data->from = from;
+        m_data->to = to;
+        m_data->azimuthInterval = azimuthInterval;
+
+        QRegion clipRegion = canvasRect;
+        if ( m_data->hasClipping )
+            clipRegion &= m_data->clipRegion;
+
+        canvas->installEventFilter( this );
+        canvas->repaint( clipRegion );
+        canvas->removeEventFilter( this );
+
+        m_data->item = NULL;
+    }
+}
+
+//! Close the internal QPainter
+void QwtPolarDirectPainter::reset()
+{
+    if ( m_data->painter.isActive() )
+    {
+        QWidget* w = static_cast< QWidget* >( m_data->painter.device() );
+        if ( w )
+            w->removeEventFilter( this );
+
+        m_data->painter.end();
+    }
+}
+
+//! Event filter
+bool QwtPolarDirectPainter::eventFilter( QObject*, QEvent* event )
+{
+    if ( event->type() == QEvent::Paint )
+    {
+        reset();
+
+        if ( m_data->item )
+        {
+            const QPaintEvent* pe = static_cast< QPaintEvent* >( event );
+
+            QwtPolarCanvas* canvas = m_data->item->plot()->canvas();
+
+            QPainter painter( canvas );
+            painter.setClipRegion( pe->region() );
+
+            if ( testAttribute( CopyBackingStore ) && qwtHasBackingStore( canvas ) )
+            {
+                painter.drawPixmap( canvas->rect().topLeft(),
+                    *canvas->backingStore() );
+            }
+            else
+            {
+                qwtRenderItem( &painter, canvas->contentsRect(),
+                    m_data->item, m_data->from, m_data->to,
+                    m_data->azimuthInterval );
+            }
+
+            return true; // don't call QwtPolarCanvas::paintEvent()
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * QwtPolar Widget Library
+ * Copyright (C) 2008   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_POLAR_DIRECT_PAINTER_H
+#define QWT_POLAR_DIRECT_PAINTER_H
+
+#include "qwt_global.h"
+#include <qobject.h>
+
+class QRegion;
+class QwtInterval;
+class QwtPolarItem;
+class QwtPolarCurve;
+
+/*!
+    \brief Painter object trying to paint incrementally on a polar plot
+
+    QwtPolarDirectPainter is the counterpart of QwtPlotDirectPainter
+    for QwtPolarPlot. It offers an API to paint subsets of a polar plot
+    without erasing/repainting the canvas:
+
+    - drawSeries() paints a range of samples of a QwtPolarCurve
+    - drawSector() paints the part of an item, that is inside of
+      an azimuth interval. F.e. a radar display can paint the sector
+      of a QwtPolarSpectrogram, that has been updated by the latest
+      spoke, followed by the same sector of the grid.
+
+    The painting operations go to the backing store of the canvas,
+    when QwtPolarCanvas::BackingStore is enabled, and to the canvas widget.
+
+    \warning Incremental painting will only help when no replot is triggered
+             by another operation ( like changing scales ) and nothing needs
+             to be erased.
+ */
+class QWT_EXPORT QwtPolarDirectPainter : public QObject
+{
+  public:
+    /*!
+       \brief Paint attributes
+       \sa setAttribute(), testAttribute(), drawSeries(), drawSector()
+     */
+    enum Attribute
+    {
+        /*!
+           Initializing a QPainter is an expensive operation.
+           When AtomicPainter is set each call of drawSeries()/drawSector()
+           opens/closes a temporary QPainter. Otherwise QwtPolarDirectPainter
+           tries to use the same QPainter as long as possible.
+         */
+        AtomicPainter = 0x01,
+
+        /*!
+           When FullRepaint is set the plot canvas is explicitly repainted
+           after the samples have been rendered.
+         */
+        FullRepaint = 0x02,
+
+        /*!
+           When QwtPolarCanvas::BackingStore is enabled the painter
+           has to paint to the backing store and the widget. In certain
+           situations/environments it might be faster to paint to
+           the backing store only and then copy the backing store to the canvas.
+         */
+        CopyBackingStore = 0x04
+    };
+
+    Q_DECLARE_FLAGS( Attributes, Attribute )
+
+    explicit QwtPolarDirectPainter( QObject* parent = NULL );
+    virtual ~QwtPolarDirectPainter();
+
+    void setAttribute( Attribute, bool on );
+    bool testAttribute( Attribute ) const;
+
+    void setClipping( bool );
+    bool hasClipping() const;
+
+    void setClipRegion( const QRegion& );
+    QRegion clipRegion() const;
+
+    void drawSeries( QwtPolarCurve*, int from, int to );
+    void drawSector( QwtPolarItem*, const QwtInterval& azimuthInterval );
+
+    void reset();
+
+    virtual bool eventFilter( QObject*, QEvent* ) QWT_OVERRIDE;
+
+  private:
+    void drawItem( QwtPolarItem*, int from, int to, const QwtInterval& );
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPolarDirectPainter::Attributes )
+
+#endif
@@ -15,8 +15,11 @@
 #include "qwt_scale_div.h"
 #include "qwt_scale_draw.h"
 #include "qwt_round_scale_draw.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
+#include <qpaintengine.h>
+#include <qpixmap.h>
 #include <qpen.h>
 #include <float.h>
 
@@ -63,15 +66,96 @@ namespace
         QPen majorPen;
         QPen minorPen;
     };
+
+    // the parameters, that have been used for rendering the cached layer
+    class LayerKey
+    {
+      public:
+        LayerKey()
+            : radius( 0.0 )
+            , pixelRatio( 1.0 )
+        {
+        }
+
+        LayerKey( const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+                const QPointF& pole, double radius, const QRect& rect,
+                qreal pixelRatio, QPainter::RenderHints renderHints )
+            : rect( rect )
+            , pole( pole )
+            , radius( radius )
+            , pixelRatio( pixelRatio )
+            , renderHints( renderHints )
+        {
+            maps[0] = azimuthMap.s1();
+            maps[1] = azimuthMap.s2();
+            maps[2] = azimuthMap.p1();
+            maps[3] = azimuthMap.p2();
+            maps[4] = radialMap.s1();
+            maps[5] = radialMap.s2();
+            maps[6] = radialMap.p1();
+            maps[7] = radialMap.p2();
+            maps[8] = radialMap.transformationType();
+        }
+
+        bool operator==( const LayerKey& other ) const
+        {
+            for ( int i = 0; i < 9; i++ )
+            {
+                if ( maps[i] != other.maps[i] )
+                    return false;
+            }
+
+            return ( rect == other.rect ) && ( pole == other.pole )
+                && ( radius == other.radius ) && ( pixelRatio == other.pixelRatio )
+                && ( renderHints == other.renderHints );
+        }
+
+        QRect rect;
+        QPointF pole;
+        double radius;
+        qreal pixelRatio;
+        QPainter::RenderHints renderHints;
+
+        double maps[9];
+    };
 }
 
 class QwtPolarGrid::PrivateData
 {
   public:
+    PrivateData()
+        : cacheEntry( this )
+    {
+    }
+
     GridData gridData[QwtPolar::ScaleCount];
     AxisData axisData[QwtPolar::AxesCount];
     QwtPolarGrid::DisplayFlags displayFlags;
     QwtPolarGrid::GridAttributes attributes;
+
+    QPixmap layer;
+    LayerKey layerKey;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::PixmapCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->layer = QPixmap();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 /*!
@@ -564,17 +648,119 @@ QFont QwtPolarGrid::axisFont( int axisId ) const
 /*!
    Draw the grid and axes
 
+   When CacheLayer is enabled the grid and axes are rendered into a pixmap,
+   that is reused until one of the parameters or an attribute
+   of the grid changes.
+
    \param painter Painter
    \param azimuthMap Maps azimuth values to values related to 0.0, M_2PI
    \param radialMap Maps radius values into painter coordinates.
    \param pole Position of the pole in painter coordinates
    \param radius Radius of the complete plot area in painter coordinates
    \param canvasRect Contents rect of the canvas in painter coordinates
+
+   \sa CacheLayer, invalidateCache()
  */
 void QwtPolarGrid::draw( QPainter* painter,
     const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
     const QPointF& pole, double radius,
     const QRectF& canvasRect ) const
+{
+    bool doCache = testGridAttribute( CacheLayer )
+        && QwtPainter::roundingAlignment( painter );
+
+    if ( doCache )
+    {
+        switch( painter->paintEngine()->type() )
+        {
+            case QPaintEngine::Picture:
+            case QPaintEngine::User: // usually QwtGraphic
+            {
+                // don't use a cache for record/replay devices
+                doCache = false;
+                break;
+            }
+            default:;
+        }
+    }
+
+    if ( !doCache )
+    {
+        drawLayer( painter, azimuthMap, radialMap, pole, radius, canvasRect );
+        return;
+    }
+
+    const QRect layerRect = canvasRect.toAlignedRect();
+
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+#else
+    const qreal pixelRatio = 1.0;
+#endif
+
+    const LayerKey key( azimuthMap, radialMap, pole, radius,
+        layerRect, pixelRatio, painter->renderHints() );
+
+    if ( m_data->layer.isNull() || !( key == m_data->layerKey ) )
+    {
+#if QT_VERSION >= 0x050000
+        m_data->layer = QPixmap( layerRect.size() * pixelRatio );
+        m_data->layer.setDevicePixelRatio( pixelRatio );
+#else
+        m_data->layer = QPixmap( layerRect.size() );
+#endif
+        m_data->layer.fill( Qt::transparent );
+
+        QPainter layerPainter( &m_data->layer );
+        layerPainter.setRenderHints( painter->renderHints() );
+        layerPainter.setFont( painter->font() );
+        layerPainter.translate( -layerRect.topLeft() );
+
+        drawLayer( &layerPainter, azimuthMap, radialMap, pole, radius, canvasRect );
+
+        layerPainter.end();
+
+        m_data->layerKey = key;
+        m_data->cacheEntry.setMemoryUsage(
+            QwtCacheEntry::pixmapSize( m_data->layer ) );
+    }
+    else
+    {
+        m_data->cacheEntry.touch();
+    }
+
+    painter->drawPixmap( layerRect.topLeft(), m_data->layer );
+}
+
+/*!
+   Invalidate the cached layer
+
+   Needs to be called, when the scale draws have been modified
+   using scaleDraw() or azimuthScaleDraw(). All other modifications
+   of the grid invalidate the cache implicitly.
+
+   \sa CacheLayer
+ */
+void QwtPolarGrid::invalidateCache()
+{
+    m_data->layer = QPixmap();
+    m_data->cacheEntry.setMemoryUsage( 0 );
+}
+
+/*!
+   Invalidate the cached layer and update the plot
+
+   \sa invalidateCache(), QwtPolarItem::itemChanged()
+ */
+void QwtPolarGrid::itemChanged()
+{
+    invalidateCache();
+    QwtPolarItem::itemChanged();
+}
+
+void QwtPolarGrid::drawLayer( QPainter* painter,
+    const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+    const QPointF& pole, double radius, const QRectF& canvasRect ) const
 {
     updateScaleDraws( azimuthMap, radialMap, pole, radius );
 
@@ -954,6 +1140,8 @@ void QwtPolarGrid::updateScaleDiv( const QwtScaleDiv& azimuthScaleDiv,
 {
     GridData& radialGrid = m_data->gridData[QwtPolar::Radius];
 
+    const QwtScaleDiv oldRadialScaleDiv = radialGrid.scaleDiv;
+
     const QwtPolarPlot* plt = plot();
     if ( plt && testGridAttribute( AutoScaling ) )
     {
@@ -973,8 +1161,12 @@ void QwtPolarGrid::updateScaleDiv( const QwtScaleDiv& azimuthScaleDiv,
     if ( azimuthGrid.scaleDiv != azimuthScaleDiv )
     {
         azimuthGrid.scaleDiv = azimuthScaleDiv;
+        invalidateCache();
     }
 
+    if ( radialGrid.scaleDiv != oldRadialScaleDiv )
+        invalidateCache();
+
     bool hasOrigin = false;
     for ( int axisId = 0; axisId < QwtPolar::AxesCount; axisId++ )
     {
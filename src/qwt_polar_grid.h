@@ -97,7 +97,21 @@ class QWT_EXPORT QwtPolarGrid : public QwtPolarItem
            When AutoScaling is enabled, the radial axes will be adjusted
            to the interval, that is currently visible on the canvas plot.
          */
-        AutoScaling = 0x01
+        AutoScaling = 0x01,
+
+        /*!
+           Grid lines and axes are rendered into a pixmap, that is reused
+           as long as the pole, the scale maps and the canvas geometry
+           do not change. This is useful for plots, where the data
+           is updated frequently, while the scales are fixed
+           ( f.e. radar displays ).
+
+           The cache is not used for paint devices, that are not aligning
+           ( f.e. PDF, SVG ) or for record/replay devices.
+
+           \sa invalidateCache()
+         */
+        CacheLayer = 0x02
     };
 
     Q_DECLARE_FLAGS( GridAttributes, GridAttribute )
@@ -157,6 +171,9 @@ class QWT_EXPORT QwtPolarGrid : public QwtPolarItem
 
     virtual int marginHint() const QWT_OVERRIDE;
 
+    virtual void itemChanged() QWT_OVERRIDE;
+    void invalidateCache();
+
   protected:
     void drawRays( QPainter*, const QRectF&,
         const QPointF& pole, double radius,
@@ -168,6 +185,10 @@ class QWT_EXPORT QwtPolarGrid : public QwtPolarItem
     void drawAxis( QPainter*, int axisId ) const;
 
   private:
+    void drawLayer( QPainter*,
+        const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+        const QPointF& pole, double radius, const QRectF& ) const;
+
     void updateScaleDraws(
         const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
         const QPointF& pole, const double radius ) const;
@@ -14,9 +14,11 @@
 #include "qwt_raster_data.h"
 #include "qwt_math.h"
 #include "qwt_clipper.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qpointer.h>
 #include <qthread.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
@@ -33,11 +35,200 @@ class QwtPolarSpectrogram::TileInfo
     QImage* image;
 };
 
+// number of colors of the lookup table for RGB color maps
+static const int qwtLookupTableSize = 4096;
+
+static inline double qwtPolarAngle( double dy, double dx, bool doFastAtan )
+{
+    double a = doFastAtan ? qwtFastAtan2( dy, dx ) : qAtan2( dy, dx );
+    if ( a < 0.0 )
+        a += 2 * M_PI;
+
+    return a;
+}
+
+/*
+   Angles and distances to the pole for the pixels of an image. They
+   depend on the position of the image relative to the pole only
+   and can be reused as long as the pole moves in integer steps
+   together with the image - f.e. for a rotating azimuth origin.
+ */
+class QwtPolarSpectrogram::PolarGrid
+{
+  public:
+    PolarGrid()
+        : doFastAtan( false )
+    {
+    }
+
+    bool isValid( const QPoint& imagePos, const QSize& imageSize,
+        const QPointF& pole, bool fastAtan ) const
+    {
+        return ( size == imageSize ) && ( doFastAtan == fastAtan )
+            && ( offset == QPointF( imagePos ) - pole );
+    }
+
+    void update( const QPoint& imagePos, const QSize& imageSize,
+        const QPointF& pole, bool fastAtan )
+    {
+        if ( isValid( imagePos, imageSize, pole, fastAtan ) )
+            return;
+
+        size = imageSize;
+        offset = QPointF( imagePos ) - pole;
+        doFastAtan = fastAtan;
+
+        const int numPixels = size.width() * size.height();
+
+        angles.resize( numPixels );
+        distances.resize( numPixels );
+
+        float* a = angles.data();
+        float* d = distances.data();
+
+        for ( int row = 0; row < size.height(); row++ )
+        {
+            const double dy = -( offset.y() + row );
+            const double dy2 = qwtSqr( dy );
+
+            for ( int col = 0; col < size.width(); col++ )
+            {
+                const double dx = offset.x() + col;
+
+                *a++ = static_cast< float >( qwtPolarAngle( dy, dx, doFastAtan ) );
+                *d++ = static_cast< float >( qSqrt( qwtSqr( dx ) + dy2 ) );
+            }
+        }
+    }
+
+    void reset()
+    {
+        size = QSize();
+        angles.clear();
+        distances.clear();
+    }
+
+    QSize size;
+    QPointF offset;
+    bool doFastAtan;
+
+    QVector< float > angles;
+    QVector< float > distances;
+};
+
+namespace
+{
+    /*
+       Triggers a replot, when the azimuth origin has not been changed
+       for a while, so that a rotated image gets replaced by a precise one.
+     */
+    class RefreshTimer : public QObject
+    {
+      public:
+        RefreshTimer()
+            : timerId( 0 )
+            , hasExpired( false )
+        {
+        }
+
+        void restart( QwtPolarPlot* plot, int delay )
+        {
+            if ( timerId != 0 )
+                killTimer( timerId );
+
+            this->plot = plot;
+            hasExpired = false;
+
+            timerId = startTimer( delay );
+        }
+
+        QPointer< QwtPolarPlot > plot;
+        int timerId;
+        bool hasExpired;
+
+      protected:
+        virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE
+        {
+            killTimer( timerId );
+            timerId = 0;
+
+            hasExpired = true;
+            if ( plot )
+                plot->replot();
+        }
+    };
+}
+
+/*
+   The last rendered image together with the parameters, that have
+   been used for rendering it. As long as only the azimuth origin - the p1()
+   of the azimuth map - has changed, the image can be painted rotated.
+ */
+class QwtPolarSpectrogram::ImageCache : public QwtCacheEntry
+{
+  public:
+    ImageCache()
+        : QwtCacheEntry( QwtCacheRegistry::RasterCache )
+        , origin( 0.0 )
+        , refreshTimer( NULL )
+    {
+    }
+
+    ~ImageCache()
+    {
+        delete refreshTimer;
+    }
+
+    bool isValid( const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+        const QPointF& pole, const QRect& rect ) const
+    {
+        if ( image.isNull() || rect != imageRect || pole != imagePole )
+            return false;
+
+        if ( azimuthMap.s1() != this->azimuthMap.s1()
+            || azimuthMap.s2() != this->azimuthMap.s2()
+            || azimuthMap.pDist() != this->azimuthMap.pDist() )
+        {
+            return false;
+        }
+
+        return ( radialMap.s1() == this->radialMap.s1() )
+            && ( radialMap.s2() == this->radialMap.s2() )
+            && ( radialMap.p1() == this->radialMap.p1() )
+            && ( radialMap.p2() == this->radialMap.p2() )
+            && ( radialMap.transformationType()
+                == this->radialMap.transformationType() );
+    }
+
+    void reset()
+    {
+        image = QImage();
+        setMemoryUsage( 0 );
+    }
+
+    QImage image;
+    QRect imageRect;
+    QPointF imagePole;
+    QwtScaleMap azimuthMap;
+    QwtScaleMap radialMap;
+
+    double origin; // azimuth origin of the last paint operation
+    RefreshTimer* refreshTimer;
+
+  protected:
+    virtual void purge() QWT_OVERRIDE
+    {
+        image = QImage();
+    }
+};
+
 class QwtPolarSpectrogram::PrivateData
 {
   public:
     PrivateData()
         : data( NULL )
+        , rotationThreshold( 15.0 )
+        , refreshDelay( 250 )
     {
         colorMap = new QwtLinearColorMap();
     }
@@ -50,6 +241,13 @@ class QwtPolarSpectrogram::PrivateData
 
     QwtRasterData* data;
     QwtColorMap* colorMap;
+    QwtColorLookupTable lookupTable;
+
+    QwtPolarSpectrogram::PolarGrid grid;
+    QwtPolarSpectrogram::ImageCache imageCache;
+
+    double rotationThreshold;
+    int refreshDelay;
 
     QwtPolarSpectrogram::PaintAttributes paintAttributes;
 };
@@ -152,6 +350,11 @@ void QwtPolarSpectrogram::setPaintAttribute( PaintAttribute attribute, bool on )
         m_data->paintAttributes |= attribute;
     else
         m_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CachePolarGrid && !on )
+        m_data->grid.reset();
+
+    invalidateCache();
 }
 
 /*!
@@ -164,6 +367,78 @@ bool QwtPolarSpectrogram::testPaintAttribute( PaintAttribute attribute ) const
     return ( m_data->paintAttributes & attribute );
 }
 
+/*!
+   \brief Set the maximum angle for painting a rotated image
+
+   When CacheImage is enabled, the cached image is painted rotated
+   as long as the azimuth origin differs by less than the threshold
+   from the origin of the cached image. Otherwise a new image is
+   rendered.
+
+   \param degrees Threshold in degrees. The default setting is 15°.
+   \sa rotationThreshold(), CacheImage
+ */
+void QwtPolarSpectrogram::setRotationThreshold( double degrees )
+{
+    m_data->rotationThreshold = qMax( degrees, 0.0 );
+}
+
+/*!
+   \return Maximum angle in degrees for painting a rotated image
+   \sa setRotationThreshold()
+ */
+double QwtPolarSpectrogram::rotationThreshold() const
+{
+    return m_data->rotationThreshold;
+}
+
+/*!
+   \brief Set the delay for replacing a rotated image
+
+   When CacheImage is enabled and the origin has not been changed
+   for delay ms after painting a rotated image, the plot is replotted
+   with a precise image.
+
+   \param ms Delay in ms. A negative value disables the refresh.
+          The default setting is 250 ms.
+
+   \sa refreshDelay(), CacheImage
+ */
+void QwtPolarSpectrogram::setRefreshDelay( int ms )
+{
+    m_data->refreshDelay = ms;
+}
+
+/*!
+   \return Delay in ms for replacing a rotated image by a precise one
+   \sa setRefreshDelay()
+ */
+int QwtPolarSpectrogram::refreshDelay() const
+{
+    return m_data->refreshDelay;
+}
+
+/*!
+   Invalidate the cached image
+
+   \sa CacheImage, itemChanged()
+ */
+void QwtPolarSpectrogram::invalidateCache()
+{
+    m_data->imageCache.reset();
+}
+
+/*!
+   Invalidate the cached image and update the plot
+
+   \sa invalidateCache(), QwtPolarItem::itemChanged()
+ */
+void QwtPolarSpectrogram::itemChanged()
+{
+    invalidateCache();
+    QwtPolarItem::itemChanged();
+}
+
 /*!
    Draw the spectrogram
 
@@ -182,15 +457,22 @@ void QwtPolarSpectrogram::draw( QPainter* painter,
     const QRectF plotRect = plot()->plotRect( canvasRect.toRect() );
     QRect imageRect = canvasRect.toRect();
 
+    if ( painter->hasClipping() )
+    {
+        // f.e. the sector of QwtPolarDirectPainter::drawSector()
+        imageRect &= painter->clipBoundingRect().toAlignedRect();
+    }
+
     painter->save();
 
-    painter->setClipRect( canvasRect );
+    painter->setClipRect( canvasRect, Qt::IntersectClip );
 
     QPainterPath clipPathCanvas;
     clipPathCanvas.addEllipse( plotRect );
     painter->setClipPath( clipPathCanvas, Qt::IntersectClip );
 
-    imageRect &= plotRect.toAlignedRect(); // outer rect
+    // the bounding rect of the disc, where we have values
+    QRect discRect = plotRect.toAlignedRect(); // outer rect
 
     const QwtInterval radialInterval = boundingInterval( QwtPolar::ScaleRadius );
     if ( radialInterval.isValid() )
@@ -201,19 +483,111 @@ void QwtPolarSpectrogram::draw( QPainter* painter,
         QRectF clipRect( 0, 0, 2 * radius, 2 * radius );
         clipRect.moveCenter( pole );
 
-        imageRect &= clipRect.toRect(); // inner rect, we don't have points outside
+        discRect &= clipRect.toRect(); // inner rect, we don't have points outside
 
         QPainterPath clipPathRadial;
         clipPathRadial.addEllipse( clipRect );
         painter->setClipPath( clipPathRadial, Qt::IntersectClip );
     }
 
-    const QImage image = renderImage( azimuthMap, radialMap, pole, imageRect );
-    painter->drawImage( imageRect, image );
+    imageRect &= discRect;
+
+    /*
+        Rotating the image is only possible, when it covers
+        the complete disc. Otherwise parts, that have been cut off
+        by the canvas, would be rotated into the visible area.
+     */
+    if ( testPaintAttribute( CacheImage ) && imageRect == discRect )
+    {
+        drawCachedImage( painter, azimuthMap, radialMap, pole, imageRect );
+    }
+    else
+    {
+        const QImage image = renderImage( azimuthMap, radialMap, pole, imageRect );
+        painter->drawImage( imageRect, image );
+    }
 
     painter->restore();
 }
 
+void QwtPolarSpectrogram::drawCachedImage( QPainter* painter,
+    const QwtScaleMap& azimuthMap, const QwtScaleMap& radialMap,
+    const QPointF& pole, const QRect& imageRect ) const
+{
+    ImageCache& cache = m_data->imageCache;
+
+    const double origin = azimuthMap.p1();
+
+    bool doRender = true;
+
+    if ( cache.isValid( azimuthMap, radialMap, pole, imageRect ) )
+    {
+        const bool hasExpired =
+            cache.refreshTimer && cache.refreshTimer->hasExpired;
+
+        if ( origin == cache.azimuthMap.p1() )
+        {
+            doRender = false;
+        }
+        else if ( !( hasExpired && origin == cache.origin ) )
+        {
+            double angle = std::fmod( origin - cache.azimuthMap.p1(), 2 * M_PI );
+            if ( angle > M_PI )
+                angle -= 2 * M_PI;
+            else if ( angle < -M_PI )
+                angle += 2 * M_PI;
+
+            doRender = qAbs( qwtDegrees( angle ) ) > m_data->rotationThreshold;
+        }
+    }
+
+    if ( doRender )
+    {
+        cache.image = renderImage( azimuthMap, radialMap, pole, imageRect );
+        cache.imageRect = imageRect;
+        cache.imagePole = pole;
+        cache.azimuthMap = azimuthMap;
+        cache.radialMap = radialMap;
+
+        cache.setMemoryUsage( QwtCacheEntry::imageSize( cache.image ) );
+
+        painter->drawImage( imageRect, cache.image );
+    }
+    else
+    {
+        cache.touch();
+
+        const double angle = origin - cache.azimuthMap.p1();
+        if ( angle == 0.0 )
+        {
+            painter->drawImage( imageRect, cache.image );
+        }
+        else
+        {
+            // azimuth angles are counter clockwise, QPainter::rotate is clockwise
+
+            painter->save();
+            painter->setRenderHint( QPainter::SmoothPixmapTransform, true );
+            painter->translate( pole );
+            painter->rotate( -qwtDegrees( angle ) );
+            painter->translate( -pole );
+            painter->drawImage( imageRect, cache.image );
+            painter->restore();
+        }
+    }
+
+    cache.origin = origin;
+
+    const bool isRotated = ( origin != cache.azimuthMap.p1() );
+    if ( isRotated && m_data->refreshDelay >= 0 && plot() )
+    {
+        if ( cache.refreshTimer == NULL )
+            cache.refreshTimer = new RefreshTimer();
+
+        cache.refreshTimer->restart( plot(), m_data->refreshDelay );
+    }
+}
+
 /*!
    \brief Render an image from the data and color map.
 
@@ -249,6 +623,15 @@ QImage QwtPolarSpectrogram::renderImage(
     if ( m_data->colorMap->format() == QwtColorMap::Indexed )
         image.setColorTable( m_data->colorMap->colorTable256() );
 
+    /*
+       The color map might have been modified since the last image,
+       so the lookup table is calculated for each image. Compared
+       to the number of pixels the costs are neglectable.
+     */
+    m_data->lookupTable.reset();
+    if ( QwtColorLookupTable::isSupported( m_data->colorMap ) )
+        m_data->lookupTable.setColorMap( m_data->colorMap, qwtLookupTableSize );
+
     /*
        For the moment we only announce the composition of the image by
        calling initRaster(), but we don't pass any useful parameters.
@@ -257,6 +640,12 @@ QImage QwtPolarSpectrogram::renderImage(
      */
     m_data->data->initRaster( QRectF(), QSize() );
 
+    if ( testPaintAttribute( CachePolarGrid ) )
+    {
+        m_data->grid.update( rect.topLeft(), rect.size(),
+            pole, testPaintAttribute( ApproximatedAtan ) );
+    }
+
 
 #if !defined( QT_NO_QFUTURE )
     uint numThreads = renderThreadCount();
@@ -337,7 +726,11 @@ void QwtPolarSpectrogram::renderTileInfo(
    \param tile Sub-rectangle of the tile in painter coordinates
    \param image Image to be rendered
 
-   \sa setRenderThreadCount()
+   The values of each scanline are fetched by one call
+   of QwtRasterData::RenderContext::pointValues() of a context,
+   that is created for the tile.
+
+   \sa setRenderThreadCount(), CachePolarGrid
    \note renderTile needs to be reentrant
  */
 void QwtPolarSpectrogram::renderTile(
@@ -351,6 +744,13 @@ void QwtPolarSpectrogram::renderTile(
 
     const bool doFastAtan = testPaintAttribute( ApproximatedAtan );
 
+    const PolarGrid* grid = NULL;
+    if ( testPaintAttribute( CachePolarGrid )
+        && m_data->grid.isValid( imagePos, image->size(), pole, doFastAtan ) )
+    {
+        grid = &m_data->grid;
+    }
+
     const int y0 = imagePos.y();
     const int y1 = tile.top();
     const int y2 = tile.bottom();
@@ -359,76 +759,108 @@ void QwtPolarSpectrogram::renderTile(
     const int x1 = tile.left();
     const int x2 = tile.right();
 
-    if ( m_data->colorMap->format() == QwtColorMap::RGB )
-    {
-        for ( int y = y1; y <= y2; y++ )
-        {
-            const double dy = pole.y() - y;
-            const double dy2 = qwtSqr( dy );
+    const int numColumns = x2 - x1 + 1;
+    if ( numColumns <= 0 )
+        return;
 
-            QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y - y0 ) );
-            line += x1 - x0;
+    QVector< double > azimuths( numColumns );
+    QVector< double > radii( numColumns );
+    QVector< double > values( numColumns );
+    QVector< uint > indices;
 
-            for ( int x = x1; x <= x2; x++ )
-            {
-                const double dx = x - pole.x();
+    if ( m_data->colorMap->format() == QwtColorMap::Indexed )
+        indices.resize( numColumns );
 
-                double a = doFastAtan ? qwtFastAtan2( dy, dx ) : qAtan2( dy, dx );
+    QwtColorLookupTable lookupTable = m_data->lookupTable;
+    if ( !lookupTable.isNull() )
+        lookupTable.setInterval( intensityRange );
 
-                if ( a < 0.0 )
-                    a += 2 * M_PI;
+    const double a1 = azimuthMap.p1();
 
-                if ( a < azimuthMap.p1() )
-                    a += 2 * M_PI;
+    // like initRaster() the context gets no useful area
+    QwtRasterData::RenderContext* context =
+        m_data->data->createRenderContext( QRectF(), tile.size() );
 
-                const double r = qSqrt( qwtSqr( dx ) + dy2 );
+    for ( int y = y1; y <= y2; y++ )
+    {
+        // translating the pixels of the row into polar coordinates
+
+        double* az = azimuths.data();
+        double* rd = radii.data();
+
+        if ( grid )
+        {
+            const int offset = ( y - y0 ) * grid->size.width() + ( x1 - x0 );
+
+            const float* angles = grid->angles.constData() + offset;
+            const float* distances = grid->distances.constData() + offset;
+
+            for ( int i = 0; i < numColumns; i++ )
+            {
+                double a = angles[i];
+                if ( a < a1 )
+                    a += 2 * M_PI;
 
-                const double azimuth = azimuthMap.invTransform( a );
-                const double radius = radialMap.invTransform( r );
-
-                const double value = m_data->data->value( azimuth, radius );
-                if ( qIsNaN( value ) )
-                {
-                    *line++ = 0u;
-                }
-                else
-                {
-                    *line++ = m_data->colorMap->rgb( intensityRange, value );
-                }
+                az[i] = azimuthMap.invTransform( a );
+                rd[i] = radialMap.invTransform( distances[i] );
             }
         }
-    }
-    else if ( m_data->colorMap->format() == QwtColorMap::Indexed )
-    {
-        for ( int y = y1; y <= y2; y++ )
+        else
         {
             const double dy = pole.y() - y;
             const double dy2 = qwtSqr( dy );
 
-            unsigned char* line = image->scanLine( y - y0 );
-            line += x1 - x0;
-            for ( int x = x1; x <= x2; x++ )
+            for ( int i = 0; i < numColumns; i++ )
             {
-                const double dx = x - pole.x();
+                const double dx = x1 + i - pole.x();
 
-                double a = doFastAtan ? qwtFastAtan2( dy, dx ) : qAtan2( dy, dx );
-                if ( a < 0.0 )
-                    a += 2 * M_PI;
-                if ( a < azimuthMap.p1() )
+                double a = qwtPolarAngle( dy, dx, doFastAtan );
+                if ( a < a1 )
                     a += 2 * M_PI;
 
                 const double r = qSqrt( qwtSqr( dx ) + dy2 );
 
-                const double azimuth = azimuthMap.invTransform( a );
-                const double radius = radialMap.invTransform( r );
+                az[i] = azimuthMap.invTransform( a );
+                rd[i] = radialMap.invTransform( r );
+            }
+        }
+
+        context->pointValues( az, rd, numColumns, values.data() );
 
-                const double value = m_data->data->value( azimuth, radius );
+        // translating the values into colors
 
-                const uint index = m_data->colorMap->colorIndex( 256, intensityRange, value );
-                *line++ = static_cast< unsigned char >( index );
-            }
+        const double* v = values.constData();
+
+        if ( !lookupTable.isNull() )
+        {
+            QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y - y0 ) );
+            line += x1 - x0;
+
+            for ( int i = 0; i < numColumns; i++ )
+                *line++ = qIsNaN( v[i] ) ? 0u : lookupTable.rgb( v[i] );
+        }
+        else if ( m_data->colorMap->format() == QwtColorMap::RGB )
+        {
+            QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y - y0 ) );
+            line += x1 - x0;
+
+            // gaps are mapped to 0u by the color map
+            m_data->colorMap->rgbValues( intensityRange, v, line, numColumns );
+        }
+        else if ( m_data->colorMap->format() == QwtColorMap::Indexed )
+        {
+            unsigned char* line = image->scanLine( y - y0 );
+            line += x1 - x0;
+
+            uint* index = indices.data();
+            m_data->colorMap->colorIndices( 256, intensityRange, v, index, numColumns );
+
+            for ( int i = 0; i < numColumns; i++ )
+                *line++ = static_cast< unsigned char >( index[i] );
         }
     }
+
+    delete context;
 }
 
 /*!
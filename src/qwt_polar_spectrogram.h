@@ -41,7 +41,32 @@ class QWT_EXPORT QwtPolarSpectrogram : public QwtPolarItem
            widget into polar coordinates.
          */
 
-        ApproximatedAtan = 0x01
+        ApproximatedAtan = 0x01,
+
+        /*!
+           Cache the polar coordinates of the pixels relative to the pole.
+           The cache is valid as long as the size of the image and its
+           position relative to the pole don't change. F.e for rotating
+           the azimuth origin or updating the data no atan2/sqrt
+           operations are needed. The cache needs 8 bytes per pixel.
+         */
+        CachePolarGrid = 0x02,
+
+        /*!
+           Cache the rendered image. When only the azimuth origin has
+           been changed ( f.e. for a rotating antenna display ) the cached
+           image is painted with a rotated painter instead of
+           rendering all pixels again. A precise image is rendered,
+           when the rotation exceeds the rotationThreshold() or when the
+           origin has not been changed for refreshDelay() ms.
+
+           The cache is invalidated by itemChanged(). When the values
+           of the raster data are modified without calling itemChanged(),
+           the cache has to be invalidated manually by invalidateCache().
+
+           \sa setRotationThreshold(), setRefreshDelay()
+         */
+        CacheImage = 0x04
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -58,6 +83,15 @@ class QWT_EXPORT QwtPolarSpectrogram : public QwtPolarItem
     void setPaintAttribute( PaintAttribute, bool on = true );
     bool testPaintAttribute( PaintAttribute ) const;
 
+    void setRotationThreshold( double degrees );
+    double rotationThreshold() const;
+
+    void setRefreshDelay( int ms );
+    int refreshDelay() const;
+
+    void invalidateCache();
+    virtual void itemChanged() QWT_OVERRIDE;
+
     virtual int rtti() const QWT_OVERRIDE;
 
     virtual void draw( QPainter* painter,
@@ -79,9 +113,15 @@ class QWT_EXPORT QwtPolarSpectrogram : public QwtPolarItem
 
   private:
     class TileInfo;
+    class PolarGrid;
+    class ImageCache;
+
     void renderTileInfo( const QwtScaleMap&, const QwtScaleMap&,
         const QPointF& pole, TileInfo* ) const;
 
+    void drawCachedImage( QPainter*, const QwtScaleMap&, const QwtScaleMap&,
+        const QPointF& pole, const QRect& ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -16,6 +16,13 @@
 #include <qnumeric.h>
 #include <qlist.h>
 #include <qmap.h>
+#include <qvector.h>
+#include <qpair.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
 
 class QwtRasterData::ContourPlane
 {
@@ -161,6 +168,387 @@ inline QPointF QwtRasterData::ContourPlane::intersection(
     return QPointF( x, y );
 }
 
+namespace
+{
+    /*
+        A segment of a contour line inside a cell. The edges
+        of the raster, where the segment starts/ends, are used
+        to connect the segments of neighboured cells.
+     */
+    class QwtContourSegment
+    {
+      public:
+        int edges[2];
+        QPointF points[2];
+    };
+
+    typedef QVector< QwtContourSegment > QwtContourSegments;
+
+    class QwtContourStrip
+    {
+      public:
+        const QwtRasterData* data;
+
+        const QVector< double >* xValues;
+        double y0;
+        double dy;
+
+        const QList< double >* levels;
+
+        bool ignoreOutOfRange;
+        QwtInterval range;
+
+        // cells of the rows [ firstRow, lastRow [
+        int firstRow;
+        int lastRow;
+
+        // segments for each level
+        QVector< QwtContourSegments > segments;
+    };
+
+    /*
+        Edges of a cell: 0 = top, 1 = right, 2 = bottom, 3 = left
+
+        The corners are indexed clockwise starting at the top left
+        corner and the bits of the case index are set for the
+        corners with a value >= level. For each case there are up to
+        2 segments, where -1 terminates the list.
+        The saddles ( 5, 10 ) have a second entry, that is used
+        when the center of the cell is >= level.
+     */
+    const int qwtSquareSegments[16][4] =
+    {
+        { -1, -1, -1, -1 },
+        { 3, 0, -1, -1 },
+        { 0, 1, -1, -1 },
+        { 3, 1, -1, -1 },
+        { 1, 2, -1, -1 },
+        { 3, 0, 1, 2 },
+        { 0, 2, -1, -1 },
+        { 2, 3, -1, -1 },
+        { 2, 3, -1, -1 },
+        { 0, 2, -1, -1 },
+        { 0, 1, 2, 3 },
+        { 1, 2, -1, -1 },
+        { 3, 1, -1, -1 },
+        { 0, 1, -1, -1 },
+        { 3, 0, -1, -1 },
+        { -1, -1, -1, -1 }
+    };
+
+    const int qwtSaddleSegments[2][4] =
+    {
+        { 0, 1, 2, 3 }, // case 5
+        { 3, 0, 1, 2 }  // case 10
+    };
+}
+
+static inline QPointF qwtEdgePoint( double x1, double y1, double z1,
+    double x2, double y2, double z2, double level )
+{
+    // the points of an edge are always passed in the same order,
+    // so that neighboured cells find exactly the same point
+
+    const double t = ( level - z1 ) / ( z2 - z1 );
+    return QPointF( x1 + t * ( x2 - x1 ), y1 + t * ( y2 - y1 ) );
+}
+
+static void qwtContourStrip( QwtContourStrip* strip )
+{
+    const QList< double >& levels = *strip->levels;
+    const int numLevels = levels.size();
+
+    const QVector< double >& xValues = *strip->xValues;
+    const int numColumns = xValues.size();
+    const double* xv = xValues.constData();
+
+    strip->segments.resize( numLevels );
+
+    const QRectF area( xv[0], strip->y0 + strip->firstRow * strip->dy,
+        xv[numColumns - 1] - xv[0],
+        ( strip->lastRow - strip->firstRow ) * strip->dy );
+
+    QwtRasterData::RenderContext* context = strip->data->createRenderContext(
+        area, QSize( numColumns, strip->lastRow - strip->firstRow + 1 ) );
+
+    QVector< double > values1( numColumns );
+    QVector< double > values2( numColumns );
+
+    double* top = values1.data();
+    double* bottom = values2.data();
+
+    double y1 = strip->y0 + strip->firstRow * strip->dy;
+    context->values( y1, xv, numColumns, top );
+
+    for ( int row = strip->firstRow; row < strip->lastRow; row++ )
+    {
+        const double y2 = strip->y0 + ( row + 1 ) * strip->dy;
+        context->values( y2, xv, numColumns, bottom );
+
+        for ( int col = 0; col < numColumns - 1; col++ )
+        {
+            const double z[4] =
+                { top[col], top[col + 1], bottom[col + 1], bottom[col] };
+
+            double zMin = z[0];
+            double zMax = z[0];
+            double zSum = z[0];
+
+            for ( int i = 1; i < 4; i++ )
+            {
+                zSum += z[i];
+                if ( z[i] < zMin )
+                    zMin = z[i];
+                if ( z[i] > zMax )
+                    zMax = z[i];
+            }
+
+            if ( qIsNaN( zSum ) )
+                continue;
+
+            if ( strip->ignoreOutOfRange )
+            {
+                if ( !strip->range.contains( zMin ) || !strip->range.contains( zMax ) )
+                    continue;
+            }
+
+            const double x1 = xv[col];
+            const double x2 = xv[col + 1];
+
+            // edge ids: horizontal edges are even, vertical edges odd
+            const int topLeft = 2 * ( row * numColumns + col );
+            const int edgeIds[4] =
+            {
+                topLeft,
+                topLeft + 2 + 1,
+                topLeft + 2 * numColumns,
+                topLeft + 1
+            };
+
+            for ( int l = 0; l < numLevels; l++ )
+            {
+                const double level = levels[l];
+                if ( level < zMin || level > zMax )
+                    continue;
+
+                int index = 0;
+                for ( int i = 0; i < 4; i++ )
+                {
+                    if ( z[i] >= level )
+                        index |= 1 << i;
+                }
+
+                const int* edges = qwtSquareSegments[index];
+                if ( ( index == 5 || index == 10 ) && 0.25 * zSum >= level )
+                    edges = qwtSaddleSegments[ index == 5 ? 0 : 1 ];
+
+                for ( int i = 0; i < 4 && edges[i] >= 0; i += 2 )
+                {
+                    QwtContourSegment segment;
+
+                    for ( int j = 0; j < 2; j++ )
+                    {
+                        const int edge = edges[i + j];
+                        segment.edges[j] = edgeIds[edge];
+
+                        QPointF& pos = segment.points[j];
+                        switch( edge )
+                        {
+                            case 0:
+                                pos = qwtEdgePoint( x1, y1, z[0], x2, y1, z[1], level );
+                                break;
+                            case 1:
+                                pos = qwtEdgePoint( x2, y1, z[1], x2, y2, z[2], level );
+                                break;
+                            case 2:
+                                pos = qwtEdgePoint( x1, y2, z[3], x2, y2, z[2], level );
+                                break;
+                            default:
+                                pos = qwtEdgePoint( x1, y1, z[0], x1, y2, z[3], level );
+                        }
+                    }
+
+                    strip->segments[l] += segment;
+                }
+            }
+        }
+
+        qSwap( top, bottom );
+        y1 = y2;
+    }
+
+    delete context;
+}
+
+static QPolygonF qwtConnectSegments( const QwtContourSegments& segments )
+{
+    /*
+        Each edge is shared by the segments of 2 cells at most.
+        Sorting the ends of the segments by their edges we find the
+        neighbours. Then we walk from each segment in both directions,
+        until the line is closed or reaches a border.
+     */
+
+    const int numSegments = segments.size();
+
+    // ends of the segments: edge and 2 * segment + end
+    QVector< QPair< int, int > > ends( 2 * numSegments );
+    for ( int i = 0; i < numSegments; i++ )
+    {
+        ends[2 * i] = qMakePair( segments[i].edges[0], 2 * i );
+        ends[2 * i + 1] = qMakePair( segments[i].edges[1], 2 * i + 1 );
+    }
+
+    std::sort( ends.begin(), ends.end() );
+
+    QVector< int > neighbours( 2 * numSegments, -1 );
+    for ( int i = 1; i < ends.size(); i++ )
+    {
+        if ( ends[i].first == ends[i - 1].first )
+        {
+            neighbours[ ends[i].second ] = ends[i - 1].second;
+            neighbours[ ends[i - 1].second ] = ends[i].second;
+        }
+    }
+
+    QVector< bool > visited( numSegments, false );
+
+    QPolygonF lines;
+    lines.reserve( 2 * numSegments );
+
+    QVector< QPointF > points;
+    QVector< QPointF > chain;
+
+    for ( int i = 0; i < numSegments; i++ )
+    {
+        if ( visited[i] )
+            continue;
+
+        visited[i] = true;
+
+        points.clear();
+        points += segments[i].points[0];
+        points += segments[i].points[1];
+
+        for ( int direction = 0; direction < 2; direction++ )
+        {
+            chain.clear();
+
+            // leaving segment i at its end point first, then at its start point
+            int end = 2 * i + 1 - direction;
+
+            while ( true )
+            {
+                const int next = neighbours[end];
+                if ( next < 0 || visited[ next / 2 ] )
+                    break;
+
+                const int segmentIndex = next / 2;
+                visited[segmentIndex] = true;
+
+                // leaving the next segment at its other end
+                end = next ^ 1;
+                chain += segments[segmentIndex].points[ end % 2 ];
+            }
+
+            if ( direction == 0 )
+            {
+                points += chain;
+            }
+            else
+            {
+                std::reverse( chain.begin(), chain.end() );
+                points = chain + points;
+            }
+        }
+
+        for ( int j = 1; j < points.size(); j++ )
+        {
+            lines += points[j - 1];
+            lines += points[j];
+        }
+    }
+
+    return lines;
+}
+
+static QwtRasterData::ContourLines qwtMarchingSquares(
+    const QwtRasterData* data, const QRectF& rect, const QSize& raster,
+    const QList< double >& levels, QwtRasterData::ConrecFlags flags )
+{
+    const double dx = rect.width() / raster.width();
+    const double dy = rect.height() / raster.height();
+
+    // same positions as the CONREC implementation
+
+    QVector< double > xValues( raster.width() );
+    for ( int i = 0; i < xValues.size(); i++ )
+        xValues[i] = rect.x() + i * dx;
+
+    const int numRows = raster.height() - 1;
+    if ( numRows <= 0 || xValues.size() < 2 )
+        return QwtRasterData::ContourLines();
+
+    int numStrips = 1;
+
+#if !defined( QT_NO_QFUTURE )
+    numStrips = QThread::idealThreadCount();
+
+    // strips of less than 16 rows are not worth a thread
+    numStrips = qMin( numStrips, numRows / 16 );
+    numStrips = qMax( numStrips, 1 );
+#endif
+
+    QVector< QwtContourStrip > strips( numStrips );
+
+    const int stripRows = numRows / numStrips;
+
+    for ( int i = 0; i < numStrips; i++ )
+    {
+        QwtContourStrip& strip = strips[i];
+
+        strip.data = data;
+        strip.xValues = &xValues;
+        strip.y0 = rect.y();
+        strip.dy = dy;
+        strip.levels = &levels;
+        strip.range = data->interval( Qt::ZAxis );
+        strip.ignoreOutOfRange = strip.range.isValid()
+            && ( flags & QwtRasterData::IgnoreOutOfRange );
+        strip.firstRow = i * stripRows;
+        strip.lastRow = ( i == numStrips - 1 ) ? numRows : ( i + 1 ) * stripRows;
+    }
+
+#if !defined( QT_NO_QFUTURE )
+    QVector< QFuture< void > > futures;
+    futures.reserve( numStrips - 1 );
+
+    for ( int i = 0; i < numStrips - 1; i++ )
+        futures += QtConcurrent::run( &qwtContourStrip, &strips[i] );
+
+    qwtContourStrip( &strips[numStrips - 1] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtContourStrip( &strips[0] );
+#endif
+
+    QwtRasterData::ContourLines contourLines;
+
+    for ( int l = 0; l < levels.size(); l++ )
+    {
+        QwtContourSegments segments = strips[0].segments[l];
+        for ( int i = 1; i < numStrips; i++ )
+            segments += strips[i].segments[l];
+
+        if ( !segments.isEmpty() )
+            contourLines[ levels[l] ] = qwtConnectSegments( segments );
+    }
+
+    return contourLines;
+}
+
 class QwtRasterData::PrivateData
 {
   public:
@@ -208,15 +596,19 @@ bool QwtRasterData::testAttribute( Attribute attribute ) const
 
    Before the composition of an image QwtPlotSpectrogram calls initRaster(),
    announcing the area and its resolution that will be requested.
+   initRaster() is called from the thread, that owns the plot item,
+   and before any render context for the image has been created.
 
    The default implementation does nothing, but for data sets that
    are stored in files, it might be good idea to reimplement initRaster(),
    where the data is resampled and loaded into memory.
+   Caches, that are needed by the threads requesting the values,
+   are better kept in a RenderContext.
 
    \param area Area of the raster
    \param raster Number of horizontal and vertical pixels
 
-   \sa initRaster(), value()
+   \sa discardRaster(), createRenderContext()
  */
 void QwtRasterData::initRaster( const QRectF& area, const QSize& raster )
 {
@@ -228,16 +620,42 @@ void QwtRasterData::initRaster( const QRectF& area, const QSize& raster )
    \brief Discard a raster
 
    After the composition of an image QwtPlotSpectrogram calls discardRaster().
+   All render contexts of the image have been deleted before.
 
    The default implementation does nothing, but if data has been loaded
    in initRaster(), it could deleted now.
 
-   \sa initRaster(), value()
+   \sa initRaster(), createRenderContext()
  */
 void QwtRasterData::discardRaster()
 {
 }
 
+/*!
+   \brief Create a context for requesting the values of an area
+
+   Between initRaster() and discardRaster() the values of the raster
+   are requested by several threads in parallel. Each thread creates
+   its own context for the area it is processing, and requests all values
+   through it. The context is deleted by the thread, when it is done.
+
+   createRenderContext() is called concurrently from different threads
+   and has to be reentrant. The default implementation returns a
+   RenderContext, that forwards all requests to value(), values()
+   and pointValues().
+
+   \param area Area, that will be requested by the context
+   \param raster Number of horizontal and vertical pixels of the area
+
+   \return Render context, to be deleted by the caller
+   \sa RenderContext, initRaster()
+ */
+QwtRasterData::RenderContext* QwtRasterData::createRenderContext(
+    const QRectF& area, const QSize& raster ) const
+{
+    return new RenderContext( this, area, raster );
+}
+
 /*!
    \brief Pixel hint
 
@@ -270,6 +688,55 @@ QRectF QwtRasterData::pixelHint( const QRectF& area ) const
     return QRectF();
 }
 
+/*!
+   \brief Values of a row
+
+   Calculates the values for a couple of positions with the same y
+   coordinate, f.e. the pixels of a scanline of an image.
+   QwtPlotSpectrogram::renderTile() calls values() for each scanline
+   instead of calling value() for each pixel.
+
+   The default implementation calls value() for each position. Derived
+   classes might reimplement values(), where calculations depending
+   only on y can be done once for the row.
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa value()
+ */
+void QwtRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+        values[i] = value( x[i], y );
+}
+
+/*!
+   \brief Values for a couple of arbitrary positions
+
+   In opposite to values() the positions don't need to have the same y
+   coordinate. QwtPolarSpectrogram::renderTile() calls pointValues()
+   for the polar coordinates of each scanline.
+
+   The default implementation calls value() for each position.
+
+   \param x Array of x values in plot coordinates
+   \param y Array of y values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+
+   \sa value(), values()
+ */
+void QwtRasterData::pointValues( const double* x, const double* y,
+    int numValues, double* values ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+        values[i] = value( x[i], y[i] );
+}
+
 /*!
    Calculate contour lines
 
@@ -282,6 +749,18 @@ QRectF QwtRasterData::pixelHint( const QRectF& area ) const
 
    An adaption of CONREC, a simple contouring algorithm.
    http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+
+   The values are requested through render contexts ( see
+   createRenderContext() ), but initRaster() and discardRaster() are
+   not called. This is left to the caller, that owns the data
+   - like QwtPlotSpectrogram::renderContourLines().
+
+   When QwtRasterData::MarchingSquares is set, the lines are calculated
+   with a marching squares algorithm, where the raster is processed in
+   parallel strips. Each pair of points is a line segment for both algorithms,
+   but the segments of the marching squares algorithm are connected:
+   the first point of a segment is the last point of the previous one,
+   unless a new line starts.
  */
 QwtRasterData::ContourLines QwtRasterData::contourLines(
     const QRectF& rect, const QSize& raster,
@@ -292,6 +771,9 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
     if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
         return contourLines;
 
+    if ( flags & MarchingSquares )
+        return qwtMarchingSquares( this, rect, raster, levels, flags );
+
     const double dx = rect.width() / raster.width();
     const double dy = rect.height() / raster.height();
 
@@ -303,8 +785,7 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
     if ( range.isValid() )
         ignoreOutOfRange = flags & IgnoreOutOfRange;
 
-    QwtRasterData* that = const_cast< QwtRasterData* >( this );
-    that->initRaster( rect, raster );
+    RenderContext* context = createRenderContext( rect, raster );
 
     for ( int y = 0; y < raster.height() - 1; y++ )
     {
@@ -331,13 +812,13 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
                 xy[TopRight].setX( pos.x() );
                 xy[TopRight].setY( pos.y() );
                 xy[TopRight].setZ(
-                    value( xy[TopRight].x(), xy[TopRight].y() )
+                    context->value( xy[TopRight].x(), xy[TopRight].y() )
                     );
 
                 xy[BottomRight].setX( pos.x() );
                 xy[BottomRight].setY( pos.y() + dy );
                 xy[BottomRight].setZ(
-                    value( xy[BottomRight].x(), xy[BottomRight].y() )
+                    context->value( xy[BottomRight].x(), xy[BottomRight].y() )
                     );
             }
 
@@ -350,10 +831,10 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
             xy[BottomRight].setY( pos.y() + dy );
 
             xy[TopRight].setZ(
-                value( xy[TopRight].x(), xy[TopRight].y() )
+                context->value( xy[TopRight].x(), xy[TopRight].y() )
                 );
             xy[BottomRight].setZ(
-                value( xy[BottomRight].x(), xy[BottomRight].y() )
+                context->value( xy[BottomRight].x(), xy[BottomRight].y() )
                 );
 
             double zMin = xy[TopLeft].z();
@@ -423,7 +904,121 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
         }
     }
 
-    that->discardRaster();
+    delete context;
 
     return contourLines;
 }
+
+class QwtRasterData::RenderContext::PrivateData
+{
+  public:
+    const QwtRasterData* data;
+    QRectF area;
+    QSize raster;
+};
+
+/*!
+   \brief Constructor
+
+   \param data Raster data
+   \param area Area, that will be requested
+   \param raster Number of horizontal and vertical pixels of the area
+ */
+QwtRasterData::RenderContext::RenderContext( const QwtRasterData* data,
+    const QRectF& area, const QSize& raster )
+{
+    m_data = new PrivateData();
+    m_data->data = data;
+    m_data->area = area;
+    m_data->raster = raster;
+}
+
+//! Destructor
+QwtRasterData::RenderContext::~RenderContext()
+{
+    delete m_data;
+}
+
+//! \return Raster data, that has created the context
+const QwtRasterData* QwtRasterData::RenderContext::data() const
+{
+    return m_data->data;
+}
+
+//! \return Area, that will be requested
+QRectF QwtRasterData::RenderContext::area() const
+{
+    return m_data->area;
+}
+
+//! \return Number of horizontal and vertical pixels of the area
+QSize QwtRasterData::RenderContext::raster() const
+{
+    return m_data->raster;
+}
+
+/*!
+   \return the value at a raster position
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   The default implementation returns data()->value( x, y )
+ */
+double QwtRasterData::RenderContext::value( double x, double y )
+{
+    return m_data->data->value( x, y );
+}
+
+/*!
+   \brief Announce the x values of the following rows
+
+   Images are requested row by row with the same x values, like the
+   columns of a spectrogram. setColumns() is called once before the rows,
+   so that implementations can precompute everything, that depends on
+   the x values only - f.e. the indices of the columns of a matrix.
+   Then values() is called with the same array, that remains unmodified.
+
+   The default implementation does nothing.
+
+   \param x Array of x values in plot coordinates
+   \param numColumns Number of values
+
+   \sa values(), QwtMatrixRasterData::createRenderContext()
+ */
+void QwtRasterData::RenderContext::setColumns( const double* x, int numColumns )
+{
+    Q_UNUSED( x );
+    Q_UNUSED( numColumns );
+}
+
+/*!
+   \brief Values of a row
+
+   The default implementation calls QwtRasterData::values()
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+ */
+void QwtRasterData::RenderContext::values( double y, const double* x,
+    int numValues, double* values )
+{
+    m_data->data->values( y, x, numValues, values );
+}
+
+/*!
+   \brief Values for a couple of arbitrary positions
+
+   The default implementation calls QwtRasterData::pointValues()
+
+   \param x Array of x values in plot coordinates
+   \param y Array of y values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+ */
+void QwtRasterData::RenderContext::pointValues(
+    const double* x, const double* y, int numValues, double* values )
+{
+    m_data->data->pointValues( x, y, numValues, values );
+}
@@ -37,7 +37,12 @@ template< class Key, class T > class QMap;
    QwtMatrixRasterData implements raster data, that returns values from
    a given 2D matrix.
 
-   \sa QwtMatrixRasterData
+   The values of an image are requested from several threads in parallel.
+   Each thread requests its values through its own RenderContext
+   ( see createRenderContext() ), where implementations can keep caches
+   - like decoded blocks of a matrix on disk - without any locking.
+
+   \sa QwtMatrixRasterData, RenderContext
  */
 class QWT_EXPORT QwtRasterData
 {
@@ -80,7 +85,18 @@ class QWT_EXPORT QwtRasterData
         IgnoreAllVerticesOnLevel = 0x01,
 
         //! Ignore all values, that are out of range
-        IgnoreOutOfRange = 0x02
+        IgnoreOutOfRange = 0x02,
+
+        /*!
+           Calculate the contour lines with a marching squares algorithm
+           instead of CONREC. The raster is sampled once and processed in
+           parallel strips of rows. The segments of a contour line
+           are returned in connected order.
+
+           IgnoreAllVerticesOnLevel has no effect, as vertices on a level
+           are always treated as being above.
+         */
+        MarchingSquares = 0x04
     };
 
     Q_DECLARE_FLAGS( ConrecFlags, ConrecFlag )
@@ -102,6 +118,11 @@ class QWT_EXPORT QwtRasterData
     virtual void initRaster( const QRectF&, const QSize& raster );
     virtual void discardRaster();
 
+    class RenderContext;
+
+    virtual RenderContext* createRenderContext(
+        const QRectF& area, const QSize& raster ) const;
+
     /*!
        \return the value at a raster position
        \param x X value in plot coordinates
@@ -109,6 +130,12 @@ class QWT_EXPORT QwtRasterData
      */
     virtual double value( double x, double y ) const = 0;
 
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const;
+
+    virtual void pointValues( const double* x, const double* y,
+        int numValues, double* values ) const;
+
     virtual ContourLines contourLines( const QRectF& rect,
         const QSize& raster, const QList< double >& levels,
         ConrecFlags ) const;
@@ -123,6 +150,54 @@ class QWT_EXPORT QwtRasterData
     PrivateData* m_data;
 };
 
+/*!
+   \brief Context for requesting the values of a part of a raster
+
+   A render context is created by QwtRasterData::createRenderContext()
+   for the area, that is rendered by one thread - f.e. a tile of an image
+   or a strip of rows, when calculating contour lines. It is used by this
+   thread only and deleted, when the area has been processed.
+
+   As the context is not shared, derived classes can store anything
+   that helps to find the values of the area - f.e. decoded blocks of
+   a matrix on disk, or the last row being requested - without
+   any synchronization.
+
+   The default implementation forwards all requests to the
+   raster data object.
+
+   \sa QwtRasterData::createRenderContext()
+ */
+class QWT_EXPORT QwtRasterData::RenderContext
+{
+  public:
+    RenderContext( const QwtRasterData*,
+        const QRectF& area, const QSize& raster );
+
+    virtual ~RenderContext();
+
+    const QwtRasterData* data() const;
+
+    QRectF area() const;
+    QSize raster() const;
+
+    virtual double value( double x, double y );
+
+    virtual void setColumns( const double* x, int numColumns );
+
+    virtual void values( double y, const double* x,
+        int numValues, double* values );
+
+    virtual void pointValues( const double* x, const double* y,
+        int numValues, double* values );
+
+  private:
+    Q_DISABLE_COPY(RenderContext)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtRasterData::ConrecFlags )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtRasterData::Attributes )
 
@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_raster_vectorfield_data.h"
+#include "qwt_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qsize.h>
+#include <qrect.h>
+#include <qlist.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class GridStrip
+    {
+      public:
+        const QwtRasterData* u;
+        const QwtRasterData* v;
+
+        const QVector< double >* xValues;
+        const QVector< double >* yValues;
+
+        // rows [firstRow, lastRow[
+        int firstRow;
+        int lastRow;
+
+        QwtVectorFieldSample* samples;
+    };
+}
+
+static void qwtSampleStrip( GridStrip* strip )
+{
+    const double* xv = strip->xValues->constData();
+    const double* yv = strip->yValues->constData();
+
+    const int numColumns = strip->xValues->size();
+    const int numRows = strip->lastRow - strip->firstRow;
+
+    const QRectF area = QRectF( QPointF( xv[0], yv[strip->firstRow] ),
+        QPointF( xv[numColumns - 1], yv[strip->lastRow - 1] ) ).normalized();
+
+    const QSize raster( numColumns, numRows );
+
+    // each thread requests the values through its own contexts
+    QwtRasterData::RenderContext* uContext =
+        strip->u->createRenderContext( area, raster );
+    QwtRasterData::RenderContext* vContext =
+        strip->v->createRenderContext( area, raster );
+
+    QVector< double > uValues( numColumns );
+    QVector< double > vValues( numColumns );
+
+    double* uv = uValues.data();
+    double* vv = vValues.data();
+
+    for ( int row = strip->firstRow; row < strip->lastRow; row++ )
+    {
+        const double y = yv[row];
+
+        uContext->values( y, xv, numColumns, uv );
+        vContext->values( y, xv, numColumns, vv );
+
+        QwtVectorFieldSample* samples = strip->samples + row * numColumns;
+
+        for ( int col = 0; col < numColumns; col++ )
+            samples[col] = QwtVectorFieldSample( xv[col], y, uv[col], vv[col] );
+    }
+
+    delete uContext;
+    delete vContext;
+}
+
+class QwtRasterVectorFieldData::PrivateData
+{
+  public:
+    PrivateData( QwtRasterData* uData, QwtRasterData* vData )
+        : u( uData )
+        , v( vData )
+        , gridSize( 64, 64 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete u;
+        delete v;
+    }
+
+    QwtRasterData* u;
+    QwtRasterData* v;
+
+    QSize gridSize;
+};
+
+/*!
+   \brief Constructor
+
+   \param u Raster data for the x components of the vectors
+   \param v Raster data for the y components of the vectors
+
+   \note The ownership of the raster data objects is
+         transferred to QwtRasterVectorFieldData
+ */
+QwtRasterVectorFieldData::QwtRasterVectorFieldData(
+    QwtRasterData* u, QwtRasterData* v )
+{
+    m_data = new PrivateData( u, v );
+}
+
+//! Destructor
+QwtRasterVectorFieldData::~QwtRasterVectorFieldData()
+{
+    delete m_data;
+}
+
+//! \return Raster data for the x components
+const QwtRasterData* QwtRasterVectorFieldData::uData() const
+{
+    return m_data->u;
+}
+
+//! \return Raster data for the y components
+const QwtRasterData* QwtRasterVectorFieldData::vData() const
+{
+    return m_data->v;
+}
+
+/*!
+   \brief Set the number of samples of the grid
+
+   The grid is spread over dataRect() and its samples are returned
+   by sample(). They are painted, when QwtPlotVectorField::FilterVectors
+   is disabled, and they are used to find the range of the magnitudes.
+
+   The default setting is 64x64.
+
+   \param size Number of columns and rows
+   \sa gridSize(), sample()
+ */
+void QwtRasterVectorFieldData::setGridSize( const QSize& size )
+{
+    m_data->gridSize = size.expandedTo( QSize( 0, 0 ) );
+}
+
+/*!
+   \return Number of columns and rows of the grid
+   \sa setGridSize()
+ */
+QSize QwtRasterVectorFieldData::gridSize() const
+{
+    return m_data->gridSize;
+}
+
+/*!
+   \return Rectangle spanned by the intervals of the x and
+           y axes of both raster data objects
+ */
+QRectF QwtRasterVectorFieldData::dataRect() const
+{
+    if ( m_data->u == NULL || m_data->v == NULL )
+        return QRectF();
+
+    const QwtInterval xInterval = m_data->u->interval( Qt::XAxis ) |
+        m_data->v->interval( Qt::XAxis );
+
+    const QwtInterval yInterval = m_data->u->interval( Qt::YAxis ) |
+        m_data->v->interval( Qt::YAxis );
+
+    if ( !xInterval.isValid() || !yInterval.isValid() )
+        return QRectF();
+
+    return QRectF( xInterval.minValue(), yInterval.minValue(),
+        xInterval.width(), yInterval.width() );
+}
+
+/*!
+   \return Number of samples of the grid
+   \sa setGridSize()
+ */
+size_t QwtRasterVectorFieldData::size() const
+{
+    if ( m_data->u == NULL || m_data->v == NULL )
+        return 0;
+
+    return size_t( m_data->gridSize.width() ) * m_data->gridSize.height();
+}
+
+/*!
+   \return Sample at the center of a cell of the grid
+   \param index Index of the cell, counted row by row
+   \sa setGridSize(), sampleGrid()
+ */
+QwtVectorFieldSample QwtRasterVectorFieldData::sample( size_t index ) const
+{
+    const int numColumns = m_data->gridSize.width();
+    const int numRows = m_data->gridSize.height();
+
+    if ( numColumns <= 0 || numRows <= 0 )
+        return QwtVectorFieldSample();
+
+    const QRectF rect = dataRect();
+
+    const int col = int( index % numColumns );
+    const int row = int( index / numColumns );
+
+    const double x = rect.left() + ( col + 0.5 ) * rect.width() / numColumns;
+    const double y = rect.top() + ( row + 0.5 ) * rect.height() / numRows;
+
+    return QwtVectorFieldSample( x, y,
+        m_data->u->value( x, y ), m_data->v->value( x, y ) );
+}
+
+/*!
+   \return Bounding rectangle of the data
+   \sa dataRect()
+ */
+QRectF QwtRasterVectorFieldData::boundingRect() const
+{
+    return dataRect();
+}
+
+/*!
+   \brief Sample the vector field at the nodes of a grid
+
+   The grid might be irregular - f.e. when being found by inverting
+   the pixel positions for a logarithmic scale. The rows are
+   sampled in parallel, where each thread requests the values
+   through its own QwtRasterData::RenderContext.
+
+   \param xValues x coordinates of the columns
+   \param yValues y coordinates of the rows
+   \param numThreads Number of threads, 0 means the ideal thread count
+                     of the system
+
+   \return Samples of the grid, row by row. Gaps are indicated by
+           NaN values for the vector components.
+ */
+QVector< QwtVectorFieldSample > QwtRasterVectorFieldData::sampleGrid(
+    const QVector< double >& xValues, const QVector< double >& yValues,
+    uint numThreads ) const
+{
+    const int numColumns = xValues.size();
+    const int numRows = yValues.size();
+
+    if ( numColumns <= 0 || numRows <= 0
+        || m_data->u == NULL || m_data->v == NULL )
+    {
+        return QVector< QwtVectorFieldSample >();
+    }
+
+    QVector< QwtVectorFieldSample > samples( numColumns * numRows );
+
+    const QRectF area = QRectF( QPointF( xValues.first(), yValues.first() ),
+        QPointF( xValues.last(), yValues.last() ) ).normalized();
+
+    const QSize raster( numColumns, numRows );
+
+    m_data->u->initRaster( area, raster );
+    m_data->v->initRaster( area, raster );
+
+    int numStrips = 1;
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    // not worth the overhead for a few arrows
+    const int minValuesPerStrip = 4096;
+
+    numStrips = qBound( 1, numColumns * numRows / minValuesPerStrip,
+        qMin( int( numThreads ), numRows ) );
+#else
+    Q_UNUSED( numThreads );
+#endif
+
+    QVector< GridStrip > strips( numStrips );
+
+    const int rowsPerStrip = numRows / numStrips;
+
+#if QWT_USE_THREADS
+    QList< QFuture< void > > futures;
+#endif
+
+    for ( int i = 0; i < numStrips; i++ )
+    {
+        GridStrip& strip = strips[i];
+
+        strip.u = m_data->u;
+        strip.v = m_data->v;
+        strip.xValues = &xValues;
+        strip.yValues = &yValues;
+        strip.firstRow = i * rowsPerStrip;
+        strip.lastRow = ( i == numStrips - 1 ) ? numRows : strip.firstRow + rowsPerStrip;
+        strip.samples = samples.data();
+
+#if QWT_USE_THREADS
+        if ( i < numStrips - 1 )
+        {
+            futures += QtConcurrent::run( &qwtSampleStrip, &strip );
+            continue;
+        }
+#endif
+        qwtSampleStrip( &strip );
+    }
+
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
+    m_data->u->discardRaster();
+    m_data->v->discardRaster();
+
+    return samples;
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RASTER_VECTORFIELD_DATA_H
+#define QWT_RASTER_VECTORFIELD_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_samples.h"
+
+#include <qvector.h>
+
+class QwtRasterData;
+class QSize;
+
+/*!
+   \brief Vector field, that is sampled from 2 raster data objects
+
+   Simulations often produce the components of a vector field on
+   dense grids. Instead of converting them into millions of
+   QwtVectorFieldSample, QwtRasterVectorFieldData reads the vectors from
+   2 QwtRasterData objects - one for each component - f.e. from
+   2 QwtMatrixRasterData sharing the same grid.
+
+   When QwtPlotVectorField::FilterVectors is enabled the vector field
+   is sampled at the centers of the cells of QwtPlotVectorField::rasterSize()
+   only - in parallel and without creating the samples of the
+   complete grid. Otherwise the vectors are painted at the positions
+   of a grid of gridSize() samples, that are spread over the bounding
+   rectangle of the data.
+
+   Gaps ( NaN values ) of the raster data are not painted.
+
+   \par Example
+   \code
+   QwtMatrixRasterData* u = new QwtMatrixRasterData();
+   u->setValueMatrix( uValues, numColumns );
+   ...
+
+   QwtMatrixRasterData* v = new QwtMatrixRasterData();
+   v->setValueMatrix( vValues, numColumns );
+   ...
+
+   QwtPlotVectorField* field = new QwtPlotVectorField();
+   field->setPaintAttribute( QwtPlotVectorField::FilterVectors, true );
+   field->setSamples( new QwtRasterVectorFieldData( u, v ) );
+   \endcode
+   \endpar
+
+   \sa QwtPlotVectorField, QwtVectorFieldData
+ */
+class QWT_EXPORT QwtRasterVectorFieldData
+    : public QwtSeriesData< QwtVectorFieldSample >
+{
+  public:
+    QwtRasterVectorFieldData( QwtRasterData* u, QwtRasterData* v );
+    virtual ~QwtRasterVectorFieldData();
+
+    const QwtRasterData* uData() const;
+    const QwtRasterData* vData() const;
+
+    void setGridSize( const QSize& );
+    QSize gridSize() const;
+
+    QRectF dataRect() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtVectorFieldSample sample( size_t index ) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    QVector< QwtVectorFieldSample > sampleGrid(
+        const QVector< double >& xValues, const QVector< double >& yValues,
+        uint numThreads = 0 ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtRasterVectorFieldData )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_render_statistics.h"
+#include "qwt_atomic_p.h"
+
+#include <qthreadstorage.h>
+
+namespace
+{
+    class QwtStatisticsSlot
+    {
+      public:
+        QwtStatisticsSlot()
+            : statistics( NULL )
+        {
+        }
+
+        QwtRenderStatistics* statistics;
+    };
+}
+
+static QThreadStorage< QwtStatisticsSlot* > qwtStatisticsSlots;
+
+// number of threads with a current statistics object
+static QAtomicInt qwtNumActiveSlots;
+
+static inline bool qwtHasActiveSlots()
+{
+    return qwtLoadAcquire( qwtNumActiveSlots ) > 0;
+}
+
+//! Constructor
+QwtRenderStatistics::QwtRenderStatistics()
+{
+    reset();
+}
+
+//! Reset all timings and counters to 0
+void QwtRenderStatistics::reset()
+{
+    for ( int i = 0; i < NumOperations; i++ )
+    {
+        m_elapsed[i] = 0;
+        m_nesting[i] = 0;
+    }
+
+    m_numSamples = 0;
+    m_numPoints = 0;
+}
+
+/*!
+   \param operation Operation
+   \return Accumulated time spent in operation in nanoseconds
+ */
+qint64 QwtRenderStatistics::elapsed( Operation operation ) const
+{
+    if ( operation < 0 || operation >= NumOperations )
+        return 0;
+
+    return m_elapsed[operation];
+}
+
+/*!
+   \return Number of samples, that have been passed to QwtPointMapper
+   \sa numPoints()
+ */
+qint64 QwtRenderStatistics::numSamples() const
+{
+    return m_numSamples;
+}
+
+/*!
+   \return Number of points, that have been returned from QwtPointMapper
+           - after weeding out points, that are mapped to the same position
+   \sa numSamples()
+ */
+qint64 QwtRenderStatistics::numPoints() const
+{
+    return m_numPoints;
+}
+
+/*!
+   \brief Set the statistics object, that collects the reports of the calling thread
+
+   \param statistics Statistics object, or NULL to stop collecting
+   \sa current()
+ */
+void QwtRenderStatistics::setCurrent( QwtRenderStatistics* statistics )
+{
+    if ( !qwtStatisticsSlots.hasLocalData() )
+    {
+        if ( statistics == NULL )
+            return;
+
+        qwtStatisticsSlots.setLocalData( new QwtStatisticsSlot() );
+    }
+
+    QwtStatisticsSlot* slot = qwtStatisticsSlots.localData();
+
+    if ( ( slot->statistics == NULL ) != ( statistics == NULL ) )
+    {
+        if ( statistics )
+            qwtNumActiveSlots.ref();
+        else
+            qwtNumActiveSlots.deref();
+    }
+
+    slot->statistics = statistics;
+}
+
+/*!
+   \return Statistics object, that collects the reports of the calling thread
+   \sa setCurrent()
+ */
+QwtRenderStatistics* QwtRenderStatistics::current()
+{
+    if ( !qwtHasActiveSlots() || !qwtStatisticsSlots.hasLocalData() )
+        return NULL;
+
+    return qwtStatisticsSlots.localData()->statistics;
+}
+
+/*!
+   \brief Add the number of samples to the current statistics object
+
+   \param numSamples Number of samples, that have been mapped
+   \param numPoints Number of points, that are left after weeding
+ */
+void QwtRenderStatistics::addSamples( int numSamples, int numPoints )
+{
+    QwtRenderStatistics* statistics = current();
+    if ( statistics )
+    {
+        statistics->m_numSamples += numSamples;
+        statistics->m_numPoints += numPoints;
+    }
+}
+
+/*!
+   \brief Start the timer, when a statistics object is current
+   \param operation Operation to be measured
+ */
+QwtRenderStatistics::Timer::Timer( Operation operation )
+    : m_statistics( QwtRenderStatistics::current() )
+    , m_operation( operation )
+{
+    if ( m_statistics )
+    {
+        if ( m_statistics->m_nesting[operation]++ == 0 )
+            m_timer.start();
+    }
+}
+
+//! Add the elapsed time to the statistics object
+QwtRenderStatistics::Timer::~Timer()
+{
+    if ( m_statistics )
+    {
+        if ( --m_statistics->m_nesting[m_operation] == 0 )
+            m_statistics->m_elapsed[m_operation] += m_timer.nsecsElapsed();
+    }
+}
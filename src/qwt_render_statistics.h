@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RENDER_STATISTICS_H
+#define QWT_RENDER_STATISTICS_H
+
+#include "qwt_global.h"
+#include <qelapsedtimer.h>
+
+/*!
+   \brief Timings and sample counts of painting a plot item
+
+   When enabled by QwtPlot::setRenderStatisticsEnabled() the time
+   spent in QwtPlotItem::draw() and in the expensive operations
+   of the rendering pipeline - like mapping, clipping or rendering
+   images - is recorded for each item.
+
+   The operations report to the statistics object, that has been
+   made current for the calling thread by setCurrent(). When no object is
+   current the reporting is a no-op, so that the instrumentation has
+   almost no cost, as long as it is not enabled.
+
+   \code
+    QwtRenderStatistics statistics;
+    QwtRenderStatistics::setCurrent( &statistics );
+
+    item->draw( painter, xMap, yMap, canvasRect );
+
+    QwtRenderStatistics::setCurrent( NULL );
+
+    qDebug() << statistics.elapsed( QwtRenderStatistics::Mapping );
+   \endcode
+
+   \sa QwtPlot::renderStatistics()
+ */
+class QWT_EXPORT QwtRenderStatistics
+{
+  public:
+    //! Operations, that are timed
+    enum Operation
+    {
+        //! QwtPlotItem::draw()
+        Draw,
+
+        /*!
+           Mapping and weeding of points by QwtPointMapper.
+           For QwtPointMapper::drawPolyline() it includes clipping
+           and painting of the polyline.
+         */
+        Mapping,
+
+        //! Clipping of polygons by QwtClipper
+        Clipping,
+
+        //! Rendering of images by QwtPlotRasterItem::renderImage()
+        Raster,
+
+        //! Number of operations
+        NumOperations
+    };
+
+    /*!
+       \brief Measuring the time of an operation
+
+       The time between construction and destruction of the
+       timer is added to the current statistics object. Nested
+       timers of the same operation are ignored.
+     */
+    class QWT_EXPORT Timer
+    {
+      public:
+        explicit Timer( Operation );
+        ~Timer();
+
+      private:
+        Q_DISABLE_COPY(Timer)
+
+        QwtRenderStatistics* m_statistics;
+        Operation m_operation;
+        QElapsedTimer m_timer;
+    };
+
+    QwtRenderStatistics();
+
+    void reset();
+
+    qint64 elapsed( Operation ) const;
+
+    qint64 numSamples() const;
+    qint64 numPoints() const;
+
+    static void setCurrent( QwtRenderStatistics* );
+    static QwtRenderStatistics* current();
+
+    static void addSamples( int numSamples, int numPoints );
+
+  private:
+    qint64 m_elapsed[NumOperations];
+    int m_nesting[NumOperations];
+
+    qint64 m_numSamples;
+    qint64 m_numPoints;
+};
+
+#endif
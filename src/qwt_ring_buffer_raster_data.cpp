@@ -0,0 +1,336 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_ring_buffer_raster_data.h"
+#include "qwt_interval.h"
+
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qrect.h>
+
+#include <cstring>
+
+class QwtRingBufferRasterData::PrivateData
+{
+  public:
+    PrivateData()
+        : numColumns( 0 )
+        , numRows( 0 )
+        , rowCount( 0 )
+        , next( 0 )
+        , dx( 0.0 )
+        , dy( 0.0 )
+    {
+    }
+
+    inline const double* row( int row ) const
+    {
+        // row 0 is the oldest row at the minimum of the y interval
+
+        if ( row < numRows - rowCount )
+            return NULL;
+
+        int index = next + row;
+        if ( index >= numRows )
+            index -= numRows;
+
+        return values.constData() + qint64( index ) * numColumns;
+    }
+
+    QwtInterval intervals[3];
+
+    QVector< double > values;
+    int numColumns;
+    int numRows;
+
+    int rowCount;
+    int next;
+
+    double dx;
+    double dy;
+};
+
+/*!
+   \brief Constructor
+
+   \param numColumns Number of values of a row
+   \param numRows Number of rows
+
+   \sa setDimensions()
+ */
+QwtRingBufferRasterData::QwtRingBufferRasterData( int numColumns, int numRows )
+{
+    m_data = new PrivateData();
+    setDimensions( numColumns, numRows );
+}
+
+//! Destructor
+QwtRingBufferRasterData::~QwtRingBufferRasterData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Change the dimensions of the matrix
+
+   All rows will be removed
+
+   \param numColumns Number of values of a row
+   \param numRows Number of rows
+
+   \sa numColumns(), numRows(), clear()
+ */
+void QwtRingBufferRasterData::setDimensions( int numColumns, int numRows )
+{
+    numColumns = qMax( numColumns, 0 );
+    numRows = qMax( numRows, 0 );
+
+    if ( numColumns == 0 || numRows == 0 )
+        numColumns = numRows = 0;
+
+    m_data->numColumns = numColumns;
+    m_data->numRows = numRows;
+
+    m_data->values.resize( numColumns * numRows );
+
+    clear();
+    update();
+}
+
+/*!
+   \return Number of values of a row
+   \sa setDimensions()
+ */
+int QwtRingBufferRasterData::numColumns() const
+{
+    return m_data->numColumns;
+}
+
+/*!
+   \return Number of rows, including those without appended values
+   \sa setDimensions(), rowCount()
+ */
+int QwtRingBufferRasterData::numRows() const
+{
+    return m_data->numRows;
+}
+
+/*!
+   \return Number of rows with appended values
+   \sa numRows(), appendRow()
+ */
+int QwtRingBufferRasterData::rowCount() const
+{
+    return m_data->rowCount;
+}
+
+/*!
+   \brief Append a row at the maximum of the y interval
+
+   \param values Array of numColumns() values
+
+   \sa appendRows(), QwtPlotRasterItem::scrollRows()
+ */
+void QwtRingBufferRasterData::appendRow( const double* values )
+{
+    appendRows( values, 1 );
+}
+
+/*!
+   \brief Append rows at the maximum of the y interval
+
+   \param values Array of count rows of numColumns() values,
+                 the last row is the newest one
+   \param count Number of rows
+
+   \sa appendRow(), QwtPlotRasterItem::scrollRows()
+ */
+void QwtRingBufferRasterData::appendRows( const double* values, int count )
+{
+    PrivateData* d = m_data;
+
+    if ( values == NULL || count <= 0 || d->numRows == 0 )
+        return;
+
+    if ( count > d->numRows )
+    {
+        // the leading rows would be overwritten anyway
+        values += qint64( count - d->numRows ) * d->numColumns;
+        count = d->numRows;
+    }
+
+    double* buffer = d->values.data();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        std::memcpy( buffer + qint64( d->next ) * d->numColumns,
+            values + qint64( i ) * d->numColumns,
+            d->numColumns * sizeof( double ) );
+
+        if ( ++d->next == d->numRows )
+            d->next = 0;
+    }
+
+    d->rowCount = qMin( d->rowCount + count, d->numRows );
+}
+
+/*!
+   Remove all rows
+   \sa rowCount()
+ */
+void QwtRingBufferRasterData::clear()
+{
+    m_data->rowCount = 0;
+    m_data->next = 0;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   Setting the bounding intervals for the X/Y axis is mandatory
+   to define the positions for the values of the matrix.
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa QwtRasterData::interval()
+ */
+void QwtRingBufferRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+    {
+        m_data->intervals[axis] = interval;
+        update();
+    }
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval
+ */
+QwtInterval QwtRingBufferRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \brief Calculate the pixel hint
+
+   \param area Requested area, ignored
+   \return Surrounding pixel of the top left value in the matrix
+
+   \note The pixel hint makes QwtPlotRasterItem render the image in
+         the resolution of the rows, what is necessary for scrolling
+         the cached image.
+ */
+QRectF QwtRingBufferRasterData::pixelHint( const QRectF& area ) const
+{
+    Q_UNUSED( area )
+
+    const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+    const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+
+    QRectF rect;
+    if ( m_data->numRows > 0 && xInterval.isValid() && yInterval.isValid() )
+    {
+        rect = QRectF( xInterval.minValue(), yInterval.minValue(),
+            m_data->dx, m_data->dy );
+    }
+
+    return rect;
+}
+
+/*!
+   \return the value at a raster position
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+ */
+double QwtRingBufferRasterData::value( double x, double y ) const
+{
+    double v;
+    values( y, &x, 1, &v );
+
+    return v;
+}
+
+/*!
+   \brief Values of a row
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+ */
+void QwtRingBufferRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+    const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+
+    const double* r = NULL;
+
+    if ( m_data->numRows > 0 && yInterval.contains( y ) )
+    {
+        int row = int( ( y - yInterval.minValue() ) / m_data->dy );
+        if ( row >= m_data->numRows )
+            row = m_data->numRows - 1;
+
+        r = m_data->row( row );
+    }
+
+    if ( r == NULL )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            values[i] = qQNaN();
+
+        return;
+    }
+
+    const double x0 = xInterval.minValue();
+    const double dx = m_data->dx;
+    const int numColumns = m_data->numColumns;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        if ( !xInterval.contains( x[i] ) )
+        {
+            values[i] = qQNaN();
+            continue;
+        }
+
+        int col = int( ( x[i] - x0 ) / dx );
+        if ( col >= numColumns )
+            col = numColumns - 1;
+
+        values[i] = r[col];
+    }
+}
+
+void QwtRingBufferRasterData::update()
+{
+    m_data->dx = 0.0;
+    m_data->dy = 0.0;
+
+    if ( m_data->numRows > 0 )
+    {
+        const QwtInterval& xInterval = m_data->intervals[ Qt::XAxis ];
+        const QwtInterval& yInterval = m_data->intervals[ Qt::YAxis ];
+
+        if ( xInterval.isValid() )
+            m_data->dx = xInterval.width() / m_data->numColumns;
+
+        if ( yInterval.isValid() )
+            m_data->dy = yInterval.width() / m_data->numRows;
+    }
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RING_BUFFER_RASTER_DATA_H
+#define QWT_RING_BUFFER_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+
+/*!
+   \brief Raster data for waterfall displays
+
+   QwtRingBufferRasterData is a matrix of a fixed number of rows,
+   where new rows - f.e. the result of a FFT - are appended at the
+   maximum of the y interval, while the previous rows move towards
+   the minimum. When all rows are in use the oldest row
+   is overwritten by the next one.
+
+   The rows are stored in a ring buffer, so that appending a row
+   only copies its values. Rows with no values yet are gaps
+   ( NaN ).
+
+   In combination with QwtPlotRasterItem::scrollRows() only the new
+   rows need to be rendered, when the image of the item is cached.
+
+   \par Example
+   \code
+   QwtRingBufferRasterData* data = new QwtRingBufferRasterData( 8192, 500 );
+   data->setInterval( Qt::XAxis, QwtInterval( 0.0, sampleRate / 2 ) );
+   data->setInterval( Qt::YAxis, QwtInterval( 0.0, 500 ) );
+   data->setInterval( Qt::ZAxis, QwtInterval( -120.0, 0.0 ) );
+
+   spectrogram->setData( data );
+   spectrogram->setCachePolicy( QwtPlotRasterItem::PaintCache );
+
+   ...
+
+   data->appendRow( fft.constData() );
+   spectrogram->scrollRows( 1 );
+   plot->replot();
+   \endcode
+   \endpar
+
+   \note The values must not be modified while an image is rendered
+   \sa QwtPlotRasterItem::scrollRows(), QwtPlotOpenGLSpectrogram::scrollRows()
+ */
+class QWT_EXPORT QwtRingBufferRasterData : public QwtRasterData
+{
+  public:
+    explicit QwtRingBufferRasterData( int numColumns = 0, int numRows = 0 );
+    virtual ~QwtRingBufferRasterData();
+
+    void setDimensions( int numColumns, int numRows );
+
+    int numColumns() const;
+    int numRows() const;
+
+    int rowCount() const;
+
+    void appendRow( const double* values );
+    void appendRows( const double* values, int count );
+
+    void clear();
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE QWT_FINAL;
+
+    virtual QRectF pixelHint( const QRectF& ) const QWT_OVERRIDE;
+
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const QWT_OVERRIDE;
+
+  private:
+    void update();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -0,0 +1,317 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_ringbuffer_series_data.h"
+#include "qwt_atomic_p.h"
+
+#include <qvector.h>
+
+// number of slots of the snapshot, that are summarized by a bounding rectangle
+static const int qwtRectBlockSize = 256;
+
+static inline void qwtExtendRect( QRectF& rect, const QPointF& sample )
+{
+    if ( rect.width() < 0.0 )
+    {
+        rect.setRect( sample.x(), sample.y(), 0.0, 0.0 );
+    }
+    else
+    {
+        rect.setCoords(
+            qMin( rect.left(), sample.x() ),
+            qMin( rect.top(), sample.y() ),
+            qMax( rect.right(), sample.x() ),
+            qMax( rect.bottom(), sample.y() ) );
+    }
+}
+
+static inline int qwtQueueSize( int capacity )
+{
+    // a power of 2, with one slot always being empty
+
+    int size = 2;
+    while ( size <= capacity )
+        size <<= 1;
+
+    return size;
+}
+
+class QwtRingBufferSeriesData::PrivateData
+{
+  public:
+    PrivateData( int capacity )
+        : capacity( qMax( capacity, 1 ) )
+        , queueMask( qwtQueueSize( this->capacity ) - 1 )
+        , readIndex( 0 )
+        , writeIndex( 0 )
+        , dropped( 0 )
+        , first( 0 )
+        , count( 0 )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+        , isDirty( false )
+    {
+        queue = new QPointF[ queueMask + 1 ];
+        values = new QPointF[ this->capacity ];
+
+        const int numBlocks =
+            ( this->capacity + qwtRectBlockSize - 1 ) / qwtRectBlockSize;
+
+        blockRects.fill( QRectF( 1.0, 1.0, -2.0, -2.0 ), numBlocks );
+        dirtyBlocks.fill( false, numBlocks );
+    }
+
+    ~PrivateData()
+    {
+        delete [] queue;
+        delete [] values;
+    }
+
+    inline const QPointF& value( int index ) const
+    {
+        int pos = first + index;
+        if ( pos >= capacity )
+            pos -= capacity;
+
+        return values[pos];
+    }
+
+    inline void appendValue( const QPointF& sample )
+    {
+        if ( count < capacity )
+        {
+            int pos = first + count;
+            if ( pos >= capacity )
+                pos -= capacity;
+
+            values[pos] = sample;
+            count++;
+
+            qwtExtendRect( blockRects[ pos / qwtRectBlockSize ], sample );
+
+            if ( !isDirty )
+                qwtExtendRect( boundingRect, sample );
+        }
+        else
+        {
+            // overwriting the oldest sample: its block has to be recalculated
+
+            values[first] = sample;
+            dirtyBlocks[ first / qwtRectBlockSize ] = true;
+
+            if ( ++first >= capacity )
+                first = 0;
+
+            isDirty = true;
+        }
+    }
+
+    void updateBoundingRect()
+    {
+        // blocks are only dirty, when all slots are in use
+
+        boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+
+        for ( int i = 0; i < blockRects.size(); i++ )
+        {
+            QRectF& rect = blockRects[i];
+
+            if ( dirtyBlocks[i] )
+            {
+                const int from = i * qwtRectBlockSize;
+                const int to = qMin( from + qwtRectBlockSize, capacity );
+
+                rect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+                for ( int pos = from; pos < to; pos++ )
+                    qwtExtendRect( rect, values[pos] );
+
+                dirtyBlocks[i] = false;
+            }
+
+            if ( rect.width() >= 0.0 )
+            {
+                qwtExtendRect( boundingRect, rect.topLeft() );
+                qwtExtendRect( boundingRect, rect.bottomRight() );
+            }
+        }
+
+        isDirty = false;
+    }
+
+    void reset()
+    {
+        first = 0;
+        count = 0;
+
+        boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+        isDirty = false;
+
+        blockRects.fill( QRectF( 1.0, 1.0, -2.0, -2.0 ) );
+        dirtyBlocks.fill( false );
+    }
+
+    const int capacity;
+
+    // transport queue: written by the producer, read by the consumer
+    const int queueMask;
+    QPointF* queue;
+
+    QAtomicInt readIndex;
+    QAtomicInt writeIndex;
+    QAtomicInt dropped;
+
+    // snapshot: only accessed by the consumer
+    QPointF* values;
+    int first;
+    int count;
+
+    QRectF boundingRect;
+    bool isDirty;
+
+    // bounding rectangles of blocks of slots of the snapshot
+    QVector< QRectF > blockRects;
+    QVector< bool > dirtyBlocks;
+};
+
+/*!
+   \brief Constructor
+
+   \param capacity Maximum number of samples in the snapshot. It is also the
+                   minimum number of samples, that can be pending between
+                   2 calls of update() without being dropped.
+ */
+QwtRingBufferSeriesData::QwtRingBufferSeriesData( int capacity )
+{
+    m_data = new PrivateData( capacity );
+}
+
+//! Destructor
+QwtRingBufferSeriesData::~QwtRingBufferSeriesData()
+{
+    delete m_data;
+}
+
+//! \return Maximum number of samples in the snapshot
+int QwtRingBufferSeriesData::capacity() const
+{
+    return m_data->capacity;
+}
+
+/*!
+   \brief Append a sample to the transport queue
+
+   append() is wait-free and intended to be called from the producer
+   thread. The sample will be visible in the snapshot after the next update().
+
+   \param sample Sample
+   \return false, when the queue is full and the sample has been dropped
+   \sa update(), droppedSamples()
+ */
+bool QwtRingBufferSeriesData::append( const QPointF& sample )
+{
+    // only the producer modifies writeIndex
+    const int writeIndex = qwtLoadAcquire( m_data->writeIndex );
+    const int nextIndex = ( writeIndex + 1 ) & m_data->queueMask;
+
+    if ( nextIndex == qwtLoadAcquire( m_data->readIndex ) )
+    {
+        m_data->dropped.fetchAndAddRelaxed( 1 );
+        return false;
+    }
+
+    m_data->queue[ writeIndex ] = sample;
+    qwtStoreRelease( m_data->writeIndex, nextIndex );
+
+    return true;
+}
+
+/*!
+   \brief Move the pending samples into the snapshot
+
+   update() has to be called from the consumer ( usually the GUI ) thread
+   before replotting. Between 2 calls of update() the snapshot is stable,
+   so that the plot items can iterate over the samples without interference
+   of the producer thread.
+
+   \return Number of samples, that have been moved into the snapshot
+ */
+int QwtRingBufferSeriesData::update()
+{
+    int readIndex = qwtLoadAcquire( m_data->readIndex );
+    const int writeIndex = qwtLoadAcquire( m_data->writeIndex );
+
+    int numSamples = 0;
+    while ( readIndex != writeIndex )
+    {
+        m_data->appendValue( m_data->queue[ readIndex ] );
+
+        readIndex = ( readIndex + 1 ) & m_data->queueMask;
+        numSamples++;
+    }
+
+    qwtStoreRelease( m_data->readIndex, readIndex );
+
+    return numSamples;
+}
+
+/*!
+   \brief Remove all samples from the snapshot
+
+   Samples, that are pending in the transport queue are not affected.
+   Like update() clear() has to be called from the consumer thread.
+ */
+void QwtRingBufferSeriesData::clear()
+{
+    m_data->reset();
+}
+
+//! \return Number of samples, that are waiting for being moved to the snapshot
+int QwtRingBufferSeriesData::pendingSamples() const
+{
+    const int readIndex = qwtLoadAcquire( m_data->readIndex );
+    const int writeIndex = qwtLoadAcquire( m_data->writeIndex );
+
+    return ( writeIndex - readIndex ) & m_data->queueMask;
+}
+
+//! \return Number of samples, that have been dropped because of a full queue
+int QwtRingBufferSeriesData::droppedSamples() const
+{
+    return qwtLoadAcquire( m_data->dropped );
+}
+
+//! \return Number of samples in the snapshot
+size_t QwtRingBufferSeriesData::size() const
+{
+    return m_data->count;
+}
+
+/*!
+   \param index Index
+   \return Sample of the snapshot at position index
+ */
+QPointF QwtRingBufferSeriesData::sample( size_t index ) const
+{
+    return m_data->value( int( index ) );
+}
+
+/*!
+   \return Bounding rectangle of the snapshot
+
+   The rectangle is extended, when new samples are moved into
+   the snapshot. When older samples have been discarded, only the
+   blocks of 256 samples, that have been overwritten, are recalculated,
+   and the rectangles of all blocks are merged.
+ */
+QRectF QwtRingBufferSeriesData::boundingRect() const
+{
+    if ( m_data->isDirty )
+        m_data->updateBoundingRect();
+
+    return m_data->boundingRect;
+}
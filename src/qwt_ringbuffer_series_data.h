@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RINGBUFFER_SERIES_DATA_H
+#define QWT_RINGBUFFER_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+/*!
+   \brief Series of points, that is fed by a producer thread
+
+   QwtRingBufferSeriesData transports samples from one producer thread
+   ( f.e. a QwtSamplingThread ) to the GUI thread without any locking:
+
+   - append() is wait-free and may be called from the producer thread.
+     When the transport queue is full the sample is dropped.
+
+   - update() has to be called from the GUI thread, before
+     the plot gets replotted. It moves all pending samples into the
+     snapshot, that is displayed by the plot items.
+
+   - size(), sample() and boundingRect() operate on the snapshot and
+     don't change between 2 calls of update(). So they are only allowed to
+     be called from the GUI thread.
+
+   The snapshot keeps the latest capacity() samples, older samples are
+   discarded.
+
+   \par Example
+   \code
+   QwtRingBufferSeriesData* buffer = new QwtRingBufferSeriesData( 100000 );
+   curve->setData( buffer );
+
+   samplingThread->setRingBuffer( buffer );
+   samplingThread->start();
+
+   ...
+
+   // f.e. in a timer event of the GUI thread
+   buffer->update();
+   plot->replot();
+   \endcode
+   \endpar
+
+   \note Only one producer and one consumer thread are supported
+   \sa QwtSamplingThread::appendSample()
+ */
+class QWT_EXPORT QwtRingBufferSeriesData : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtRingBufferSeriesData( int capacity = 10000 );
+    virtual ~QwtRingBufferSeriesData();
+
+    int capacity() const;
+
+    bool append( const QPointF& );
+
+    int update();
+    void clear();
+
+    int pendingSamples() const;
+    int droppedSamples() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtRingBufferSeriesData )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
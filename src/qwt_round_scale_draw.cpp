@@ -175,7 +175,7 @@ void QwtRoundScaleDraw::drawLabel( QPainter* painter, double value ) const
 
     const QRectF r( x - sz.width() / 2, y - sz.height() / 2,
         sz.width(), sz.height() );
-    label.draw( painter, r );
+    drawTickLabel( painter, value, label, r );
 }
 
 /*!
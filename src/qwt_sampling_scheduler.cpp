@@ -0,0 +1,680 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_sampling_scheduler.h"
+#include "qwt_ringbuffer_series_data.h"
+
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+#include <qelapsedtimer.h>
+#include <qatomic.h>
+#include <qvector.h>
+#include <qlist.h>
+#include <qcoreevent.h>
+
+#include <algorithm>
+
+//! Constructor
+QwtSampler::QwtSampler()
+    : m_interval( 1e3 ) // 1 second
+    , m_ringBuffer( NULL )
+{
+}
+
+//! Destructor
+QwtSampler::~QwtSampler()
+{
+}
+
+/*!
+   Change the interval (in ms), when sample() is called.
+   The default interval is 1000.0 ( = 1s )
+
+   \param msecs Interval
+   \sa interval()
+ */
+void QwtSampler::setInterval( double msecs )
+{
+    m_interval = qMax( msecs, 0.0 );
+}
+
+/*!
+   \return Interval (in ms), between 2 calls of sample()
+   \sa setInterval()
+ */
+double QwtSampler::interval() const
+{
+    return m_interval;
+}
+
+/*!
+   \brief Assign a ring buffer for the collected samples
+
+   The ring buffer is not owned by the sampler and has to stay alive
+   as long as the sampler is scheduled.
+
+   \param buffer Ring buffer, or NULL
+   \sa ringBuffer(), appendSample()
+ */
+void QwtSampler::setRingBuffer( QwtRingBufferSeriesData* buffer )
+{
+    m_ringBuffer = buffer;
+}
+
+/*!
+   \return Ring buffer for the collected samples
+   \sa setRingBuffer(), appendSample()
+ */
+QwtRingBufferSeriesData* QwtSampler::ringBuffer() const
+{
+    return m_ringBuffer;
+}
+
+/*!
+   \brief Collect several samples
+
+   The default implementation calls sample() for each of the samples.
+
+   \param elapsed Time of the first sample since the scheduler
+                  was started in seconds
+   \param numSamples Number of samples. The time of the samples
+                     is elapsed + i * interval()
+   \sa sample()
+ */
+void QwtSampler::sampleBatch( double elapsed, int numSamples )
+{
+    const double interval = m_interval / 1e3;
+
+    for ( int i = 0; i < numSamples; i++ )
+        sample( elapsed + i * interval );
+}
+
+/*!
+   \brief Pass a collected sample to the ring buffer
+
+   \param sample Sample
+   \return false, when no ring buffer is assigned or the sample
+           has been dropped because the buffer is full
+   \sa setRingBuffer(), QwtRingBufferSeriesData::append()
+ */
+bool QwtSampler::appendSample( const QPointF& sample )
+{
+    if ( m_ringBuffer == NULL )
+        return false;
+
+    return m_ringBuffer->append( sample );
+}
+
+namespace
+{
+    class Entry
+    {
+      public:
+        Entry( QwtSampler* s )
+            : sampler( s )
+            , msecsInterval( -1.0 )
+            , interval( 0 )
+            , deadline( 0 )
+            , isBusy( false )
+        {
+        }
+
+        QwtSampler* sampler;
+
+        double msecsInterval;
+        qint64 interval;  // ns
+        qint64 deadline;  // ns, of the next sample
+
+        bool isBusy;
+    };
+
+    class EntryCompare
+    {
+      public:
+        // std::push_heap builds a max heap: the earliest deadline on top
+        bool operator()( const Entry* entry1, const Entry* entry2 ) const
+        {
+            return entry1->deadline > entry2->deadline;
+        }
+    };
+}
+
+class QwtSamplingScheduler::Worker : public QThread
+{
+  public:
+    Worker( QwtSamplingScheduler* scheduler )
+        : m_scheduler( scheduler )
+    {
+    }
+
+  protected:
+    virtual void run() QWT_OVERRIDE
+    {
+        m_scheduler->work();
+    }
+
+  private:
+    QwtSamplingScheduler* m_scheduler;
+};
+
+class QwtSamplingScheduler::PrivateData
+{
+  public:
+    PrivateData()
+        : threadCount( 1 )
+        , coalescingWindow( 0.5 )
+        , updateInterval( 16 )
+        , isRunning( false )
+        , updateTimerId( 0 )
+        , sumJitter( 0 )
+        , maxJitter( 0 )
+    {
+    }
+
+    void schedule( Entry* entry )
+    {
+        heap += entry;
+        std::push_heap( heap.begin(), heap.end(), EntryCompare() );
+    }
+
+    Entry* takeNext()
+    {
+        std::pop_heap( heap.begin(), heap.end(), EntryCompare() );
+
+        Entry* entry = heap.last();
+        heap.removeLast();
+
+        return entry;
+    }
+
+    void unschedule( Entry* entry )
+    {
+        const int index = heap.indexOf( entry );
+        if ( index >= 0 )
+        {
+            heap.remove( index );
+            std::make_heap( heap.begin(), heap.end(), EntryCompare() );
+        }
+    }
+
+    int threadCount;
+    double coalescingWindow;
+    int updateInterval;
+
+    mutable QMutex mutex;
+    QWaitCondition condition;
+
+    QList< Entry* > entries;
+    QVector< Entry* > heap;
+
+    QList< QwtSamplingScheduler::Worker* > workers;
+
+    QElapsedTimer timer;
+    bool isRunning;
+
+    QAtomicInt hasSamples;
+    int updateTimerId;
+
+    // statistics, in ns
+    QwtSamplingThread::Statistics statistics;
+    qint64 sumJitter;
+    qint64 maxJitter;
+};
+
+//! Constructor
+QwtSamplingScheduler::QwtSamplingScheduler( QObject* parent )
+    : QObject( parent )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor, stopping the worker threads
+QwtSamplingScheduler::~QwtSamplingScheduler()
+{
+    stop();
+
+    qDeleteAll( m_data->entries );
+    delete m_data;
+}
+
+/*!
+   \brief Add a sampler
+
+   A sampler can be added, while the scheduler is running.
+   Its first sample is taken at the next multiple of its interval.
+   The sampler is not owned by the scheduler.
+
+   \param sampler Sampler
+   \sa removeSampler(), samplers()
+ */
+void QwtSamplingScheduler::addSampler( QwtSampler* sampler )
+{
+    if ( sampler == NULL )
+        return;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    for ( int i = 0; i < m_data->entries.size(); i++ )
+    {
+        if ( m_data->entries[i]->sampler == sampler )
+            return;
+    }
+
+    Entry* entry = new Entry( sampler );
+    m_data->entries += entry;
+
+    if ( m_data->isRunning )
+    {
+        m_data->schedule( entry );
+        m_data->condition.wakeOne();
+    }
+}
+
+/*!
+   \brief Remove a sampler
+
+   When the sampler is currently collecting samples, removeSampler()
+   blocks until it has finished. Afterwards the sampler is not called
+   anymore and can be deleted.
+
+   \param sampler Sampler
+   \sa addSampler()
+ */
+void QwtSamplingScheduler::removeSampler( QwtSampler* sampler )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    for ( int i = 0; i < m_data->entries.size(); i++ )
+    {
+        Entry* entry = m_data->entries[i];
+        if ( entry->sampler == sampler )
+        {
+            while ( entry->isBusy )
+                m_data->condition.wait( &m_data->mutex );
+
+            m_data->unschedule( entry );
+            m_data->entries.removeAll( entry );
+
+            delete entry;
+            return;
+        }
+    }
+}
+
+//! \return Samplers, that have been added to the scheduler
+QList< QwtSampler* > QwtSamplingScheduler::samplers() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    QList< QwtSampler* > samplers;
+    for ( int i = 0; i < m_data->entries.size(); i++ )
+        samplers += m_data->entries[i]->sampler;
+
+    return samplers;
+}
+
+/*!
+   \brief Set the number of worker threads
+
+   As the samplers are usually waiting for devices most of the time
+   a few threads are enough for many samplers. The number of
+   threads is applied, when the scheduler is started.
+   The default setting is 1.
+
+   \param numThreads Number of worker threads, 0 means
+                     the ideal thread count of the system
+   \sa threadCount(), start()
+ */
+void QwtSamplingScheduler::setThreadCount( int numThreads )
+{
+    m_data->threadCount = qMax( numThreads, 0 );
+}
+
+/*!
+   \return Number of worker threads
+   \sa setThreadCount()
+ */
+int QwtSamplingScheduler::threadCount() const
+{
+    return m_data->threadCount;
+}
+
+/*!
+   \brief Set the window for coalescing wakeups
+
+   Samplers, that are due within the window after the earliest
+   deadline, are processed by the same wakeup - a bit too early.
+   The default setting is 0.5 ms.
+
+   \param msecs Coalescing window
+   \sa coalescingWindow()
+ */
+void QwtSamplingScheduler::setCoalescingWindow( double msecs )
+{
+    QMutexLocker locker( &m_data->mutex );
+    m_data->coalescingWindow = qMax( msecs, 0.0 );
+}
+
+/*!
+   \return Window for coalescing wakeups
+   \sa setCoalescingWindow()
+ */
+double QwtSamplingScheduler::coalescingWindow() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->coalescingWindow;
+}
+
+/*!
+   \brief Set the minimum interval between 2 notifications
+
+   The default setting is 16 ms, what corresponds to 60 frames per second.
+
+   \param msecs Update interval
+   \sa updateInterval(), samplesAvailable()
+ */
+void QwtSamplingScheduler::setUpdateInterval( int msecs )
+{
+    msecs = qMax( msecs, 1 );
+
+    if ( msecs != m_data->updateInterval )
+    {
+        m_data->updateInterval = msecs;
+
+        if ( m_data->updateTimerId != 0 )
+        {
+            killTimer( m_data->updateTimerId );
+            m_data->updateTimerId = startTimer( msecs );
+        }
+    }
+}
+
+/*!
+   \return Minimum interval between 2 notifications
+   \sa setUpdateInterval(), samplesAvailable()
+ */
+int QwtSamplingScheduler::updateInterval() const
+{
+    return m_data->updateInterval;
+}
+
+//! \return true, when the scheduler has been started
+bool QwtSamplingScheduler::isRunning() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->isRunning;
+}
+
+/*!
+   \return Time (in ms) since the scheduler was started
+   \sa start()
+ */
+double QwtSamplingScheduler::elapsed() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    if ( m_data->isRunning )
+        return m_data->timer.nsecsElapsed() / 1e6;
+
+    return 0.0;
+}
+
+/*!
+   \return Timing statistics of all samplers since the scheduler
+           has been started or resetStatistics() had been called
+ */
+QwtSamplingThread::Statistics QwtSamplingScheduler::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    QwtSamplingThread::Statistics statistics = m_data->statistics;
+    if ( statistics.numWakeups > 0 )
+        statistics.meanJitter = m_data->sumJitter / 1e6 / statistics.numWakeups;
+
+    statistics.maxJitter = m_data->maxJitter / 1e6;
+
+    return statistics;
+}
+
+//! Reset the timing statistics
+void QwtSamplingScheduler::resetStatistics()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->statistics = QwtSamplingThread::Statistics();
+    m_data->sumJitter = 0;
+    m_data->maxJitter = 0;
+}
+
+/*!
+   \brief Start the worker threads
+
+   The schedule of all samplers starts from now.
+   \sa stop(), setThreadCount()
+ */
+void QwtSamplingScheduler::start()
+{
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( m_data->isRunning )
+            return;
+
+        m_data->isRunning = true;
+        m_data->timer.start();
+
+        m_data->heap.clear();
+        for ( int i = 0; i < m_data->entries.size(); i++ )
+        {
+            Entry* entry = m_data->entries[i];
+            entry->msecsInterval = -1.0;
+
+            m_data->schedule( entry );
+        }
+    }
+
+    resetStatistics();
+
+    int numThreads = m_data->threadCount;
+    if ( numThreads <= 0 )
+        numThreads = qMax( QThread::idealThreadCount(), 1 );
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        Worker* worker = new Worker( this );
+        m_data->workers += worker;
+
+        worker->start();
+    }
+
+    m_data->updateTimerId = startTimer( m_data->updateInterval );
+}
+
+/*!
+   \brief Stop the worker threads
+
+   stop() blocks until the samplers, that are currently collecting
+   samples, have finished.
+
+   \sa start()
+ */
+void QwtSamplingScheduler::stop()
+{
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( !m_data->isRunning )
+            return;
+
+        m_data->isRunning = false;
+        m_data->condition.wakeAll();
+    }
+
+    for ( int i = 0; i < m_data->workers.size(); i++ )
+    {
+        m_data->workers[i]->wait();
+        delete m_data->workers[i];
+    }
+
+    m_data->workers.clear();
+    m_data->heap.clear();
+
+    if ( m_data->updateTimerId != 0 )
+    {
+        killTimer( m_data->updateTimerId );
+        m_data->updateTimerId = 0;
+    }
+}
+
+/*!
+   Emit samplesAvailable(), when samples have been
+   collected since the last notification
+
+   \param event Timer event
+ */
+void QwtSamplingScheduler::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->updateTimerId )
+    {
+        if ( m_data->hasSamples.fetchAndStoreOrdered( 0 ) != 0 )
+            Q_EMIT samplesAvailable();
+
+        return;
+    }
+
+    QObject::timerEvent( event );
+}
+
+void QwtSamplingScheduler::work()
+{
+    QList< Entry* > dueEntries;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    while ( m_data->isRunning )
+    {
+        if ( m_data->heap.isEmpty() )
+        {
+            m_data->condition.wait( &m_data->mutex );
+            continue;
+        }
+
+        const qint64 window = qRound64( m_data->coalescingWindow * 1e6 );
+        const qint64 now = m_data->timer.nsecsElapsed();
+
+        Entry* next = m_data->heap.first();
+        if ( next->msecsInterval != next->sampler->interval() )
+        {
+            // the first deadline is the next multiple of the interval,
+            // so that harmonic intervals share the wakeups
+
+            m_data->takeNext();
+
+            next->msecsInterval = next->sampler->interval();
+            next->interval = qRound64( next->msecsInterval * 1e6 );
+            next->deadline = ( next->interval > 0 )
+                ? ( now / next->interval + 1 ) * next->interval : now;
+
+            m_data->schedule( next );
+            continue;
+        }
+
+        const qint64 remaining = next->deadline - now;
+        if ( remaining > window )
+        {
+            // another thread might pick up an earlier deadline meanwhile
+            const unsigned long msecs = qMax( qint64( 1 ), remaining / 1000000 );
+            m_data->condition.wait( &m_data->mutex, msecs );
+
+            continue;
+        }
+
+        dueEntries.clear();
+        while ( !m_data->heap.isEmpty()
+            && m_data->heap.first()->deadline <= now + window )
+        {
+            Entry* entry = m_data->takeNext();
+            entry->isBusy = true;
+
+            dueEntries += entry;
+        }
+
+        locker.unlock();
+
+        QwtSamplingThread::Statistics statistics;
+        qint64 sumJitter = 0;
+        qint64 maxJitter = 0;
+
+        for ( int i = 0; i < dueEntries.size(); i++ )
+        {
+            Entry* entry = dueEntries[i];
+
+            int numSamples = 1;
+            int numSkipped = 0;
+            qint64 jitter = 0;
+
+            if ( entry->interval > 0 )
+            {
+                jitter = qMax( now - entry->deadline, qint64( 0 ) );
+                numSamples += int( jitter / entry->interval );
+
+                // catching up one interval at most, skipping the rest
+                if ( numSamples > 2 )
+                {
+                    numSkipped = numSamples - 2;
+                    numSamples = 2;
+
+                    entry->deadline += numSkipped * entry->interval;
+                }
+            }
+
+            entry->sampler->sampleBatch( entry->deadline / 1e9, numSamples );
+            entry->deadline += numSamples * qMax( entry->interval, qint64( 1 ) );
+
+            statistics.numWakeups++;
+            statistics.numSamples += numSamples;
+            statistics.numSkipped += numSkipped;
+
+            if ( entry->interval > 0 && jitter > entry->interval )
+                statistics.numOverruns++;
+
+            sumJitter += jitter;
+            maxJitter = qMax( maxJitter, jitter );
+        }
+
+        m_data->hasSamples.fetchAndStoreOrdered( 1 );
+
+        locker.relock();
+
+        for ( int i = 0; i < dueEntries.size(); i++ )
+        {
+            Entry* entry = dueEntries[i];
+            entry->isBusy = false;
+
+            m_data->schedule( entry );
+        }
+
+        QwtSamplingThread::Statistics& s = m_data->statistics;
+        s.numWakeups += statistics.numWakeups;
+        s.numSamples += statistics.numSamples;
+        s.numSkipped += statistics.numSkipped;
+        s.numOverruns += statistics.numOverruns;
+
+        m_data->sumJitter += sumJitter;
+        m_data->maxJitter = qMax( m_data->maxJitter, maxJitter );
+
+        // waking up removeSampler() and the other workers
+        m_data->condition.wakeAll();
+    }
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_sampling_scheduler.cpp"
+#endif
@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SAMPLING_SCHEDULER_H
+#define QWT_SAMPLING_SCHEDULER_H
+
+#include "qwt_global.h"
+#include "qwt_sampling_thread.h"
+
+#include <qobject.h>
+
+class QwtRingBufferSeriesData;
+class QPointF;
+
+/*!
+   \brief A source of samples, that is run by a QwtSamplingScheduler
+
+   QwtSampler is the counterpart of QwtSamplingThread for applications
+   with many sources: instead of having a thread for each of them, the
+   samplers are called from the worker threads of a QwtSamplingScheduler.
+
+   \sa QwtSamplingScheduler
+ */
+class QWT_EXPORT QwtSampler
+{
+  public:
+    QwtSampler();
+    virtual ~QwtSampler();
+
+    void setInterval( double msecs );
+    double interval() const;
+
+    void setRingBuffer( QwtRingBufferSeriesData* );
+    QwtRingBufferSeriesData* ringBuffer() const;
+
+  protected:
+    friend class QwtSamplingScheduler;
+
+    /*!
+       Collect a sample
+
+       \param elapsed Time since the scheduler was started in seconds,
+                      like for QwtSamplingThread::sample()
+     */
+    virtual void sample( double elapsed ) = 0;
+
+    virtual void sampleBatch( double elapsed, int numSamples );
+
+    bool appendSample( const QPointF& );
+
+  private:
+    Q_DISABLE_COPY( QwtSampler )
+
+    double m_interval;
+    QwtRingBufferSeriesData* m_ringBuffer;
+};
+
+/*!
+   \brief Scheduler running many QwtSampler objects on a small pool of threads
+
+   Having a QwtSamplingThread for each source of samples ends up in many
+   sleeping threads, that wake up at unaligned times. QwtSamplingScheduler
+   runs the samplers from a couple of worker threads instead, that
+   wake up for the earliest deadline of all samplers.
+
+   The deadlines of a sampler are multiples of its interval counted
+   from the start of the scheduler, so that samplers with harmonic
+   intervals ( f.e. 10, 20 and 40 ms ) are due at the same time. Samplers,
+   that are due within the coalescingWindow(), are processed by the same
+   wakeup. A sampler being late is catching up one interval at most,
+   like QwtSamplingThread::DeadlineScheduling.
+
+   The GUI thread is notified by samplesAvailable() at most once per
+   updateInterval() - f.e. once per frame - instead of being
+   notified for each sample.
+
+   \par Example
+   \code
+   QwtSamplingScheduler* scheduler = new QwtSamplingScheduler( this );
+   scheduler->setThreadCount( 2 );
+
+   for ( int i = 0; i < numDevices; i++ )
+   {
+       DeviceSampler* sampler = new DeviceSampler( device[i] );
+       sampler->setInterval( 10.0 );
+       sampler->setRingBuffer( buffer[i] );
+
+       scheduler->addSampler( sampler );
+   }
+
+   connect( scheduler, SIGNAL(samplesAvailable()), plot, SLOT(replot()) );
+   scheduler->start();
+   \endcode
+   \endpar
+
+   \sa QwtSampler, QwtSamplingThread, QwtRingBufferSeriesData
+ */
+class QWT_EXPORT QwtSamplingScheduler : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit QwtSamplingScheduler( QObject* parent = NULL );
+    virtual ~QwtSamplingScheduler();
+
+    void addSampler( QwtSampler* );
+    void removeSampler( QwtSampler* );
+    QList< QwtSampler* > samplers() const;
+
+    void setThreadCount( int );
+    int threadCount() const;
+
+    void setCoalescingWindow( double msecs );
+    double coalescingWindow() const;
+
+    void setUpdateInterval( int msecs );
+    int updateInterval() const;
+
+    bool isRunning() const;
+    double elapsed() const;
+
+    QwtSamplingThread::Statistics statistics() const;
+    void resetStatistics();
+
+  public Q_SLOTS:
+    void start();
+    void stop();
+
+  Q_SIGNALS:
+    /*!
+       New samples have been collected since the last notification
+
+       The signal is emitted from the thread of the scheduler at most
+       once per updateInterval().
+     */
+    void samplesAvailable();
+
+  protected:
+    virtual void timerEvent( QTimerEvent* ) QWT_OVERRIDE;
+
+  private:
+    class Worker;
+    class PrivateData;
+
+    void work();
+
+    PrivateData* m_data;
+};
+
+#endif
@@ -8,21 +8,56 @@
  *****************************************************************************/
 
 #include "qwt_sampling_thread.h"
+#include "qwt_ringbuffer_series_data.h"
 #include <qelapsedtimer.h>
+#include <qmutex.h>
 
 class QwtSamplingThread::PrivateData
 {
   public:
+    PrivateData()
+        : msecsInterval( 1e3 ) // 1 second
+        , ringBuffer( NULL )
+        , schedulingMode( QwtSamplingThread::RelativeScheduling )
+        , spinThreshold( 0.1 )
+        , batchSize( 1 )
+        , sumJitter( 0 )
+        , maxJitter( 0 )
+    {
+    }
+
     QElapsedTimer timer;
     double msecsInterval;
+
+    QwtRingBufferSeriesData* ringBuffer;
+
+    QwtSamplingThread::SchedulingMode schedulingMode;
+    double spinThreshold;
+    int batchSize;
+
+    // statistics, in ns
+    mutable QMutex mutex;
+    QwtSamplingThread::Statistics statistics;
+    qint64 sumJitter;
+    qint64 maxJitter;
 };
 
+//! Constructor, initializing all values with 0
+QwtSamplingThread::Statistics::Statistics()
+    : numWakeups( 0 )
+    , numSamples( 0 )
+    , numOverruns( 0 )
+    , numSkipped( 0 )
+    , meanJitter( 0.0 )
+    , maxJitter( 0.0 )
+{
+}
+
 //! Constructor
 QwtSamplingThread::QwtSamplingThread( QObject* parent )
     : QThread( parent )
 {
     m_data = new PrivateData;
-    m_data->msecsInterval = 1e3; // 1 second
 }
 
 //! Destructor
@@ -55,6 +90,168 @@ double QwtSamplingThread::interval() const
     return m_data->msecsInterval;
 }
 
+/*!
+   \brief Assign a ring buffer for the collected samples
+
+   The ring buffer is not owned by the thread and has to stay alive
+   as long as the thread is running. It has to be assigned before
+   the thread is started.
+
+   \param buffer Ring buffer, or NULL
+   \sa ringBuffer(), appendSample()
+ */
+void QwtSamplingThread::setRingBuffer( QwtRingBufferSeriesData* buffer )
+{
+    m_data->ringBuffer = buffer;
+}
+
+/*!
+   \return Ring buffer for the collected samples
+   \sa setRingBuffer(), appendSample()
+ */
+QwtRingBufferSeriesData* QwtSamplingThread::ringBuffer() const
+{
+    return m_data->ringBuffer;
+}
+
+/*!
+   \brief Set the strategy for scheduling the samples
+
+   The default setting is RelativeScheduling.
+
+   \param mode Scheduling mode
+   \sa schedulingMode(), setBatchSize(), setSpinThreshold()
+ */
+void QwtSamplingThread::setSchedulingMode( SchedulingMode mode )
+{
+    m_data->schedulingMode = mode;
+}
+
+/*!
+   \return Strategy for scheduling the samples
+   \sa setSchedulingMode()
+ */
+QwtSamplingThread::SchedulingMode QwtSamplingThread::schedulingMode() const
+{
+    return m_data->schedulingMode;
+}
+
+/*!
+   \brief Set the time (in ms) before a deadline, that is busy waited
+
+   Sleeping is only accurate to the granularity of the scheduler of the
+   operating system. With DeadlineScheduling the thread sleeps until
+   the deadline minus the spin threshold and burns the CPU for the rest.
+   The default setting is 0.1 ms, 0.0 disables spinning.
+
+   \param msecs Spin threshold
+   \sa spinThreshold(), DeadlineScheduling
+ */
+void QwtSamplingThread::setSpinThreshold( double msecs )
+{
+    m_data->spinThreshold = qMax( msecs, 0.0 );
+}
+
+/*!
+   \return Time (in ms) before a deadline, that is busy waited
+   \sa setSpinThreshold()
+ */
+double QwtSamplingThread::spinThreshold() const
+{
+    return m_data->spinThreshold;
+}
+
+/*!
+   \brief Set the number of samples, that are collected per wakeup
+
+   With DeadlineScheduling the thread wakes up at the deadline of
+   the last sample of a batch and passes all samples, that are due,
+   to sampleBatch(). The default setting is 1.
+
+   \param numSamples Number of samples per wakeup
+   \sa batchSize(), sampleBatch()
+ */
+void QwtSamplingThread::setBatchSize( int numSamples )
+{
+    m_data->batchSize = qMax( numSamples, 1 );
+}
+
+/*!
+   \return Number of samples, that are collected per wakeup
+   \sa setBatchSize()
+ */
+int QwtSamplingThread::batchSize() const
+{
+    return m_data->batchSize;
+}
+
+/*!
+   \return Timing statistics since the thread has been started
+            or resetStatistics() had been called
+   \note Statistics are collected for DeadlineScheduling only
+ */
+QwtSamplingThread::Statistics QwtSamplingThread::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    Statistics statistics = m_data->statistics;
+    if ( statistics.numWakeups > 0 )
+        statistics.meanJitter = m_data->sumJitter / 1e6 / statistics.numWakeups;
+
+    statistics.maxJitter = m_data->maxJitter / 1e6;
+
+    return statistics;
+}
+
+//! Reset the timing statistics
+void QwtSamplingThread::resetStatistics()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->statistics = Statistics();
+    m_data->sumJitter = 0;
+    m_data->maxJitter = 0;
+}
+
+/*!
+   \brief Collect several samples
+
+   sampleBatch() is called with DeadlineScheduling. The default
+   implementation calls sample() for each of the samples.
+
+   \param elapsed Time of the first sample since the thread
+                  was started in seconds
+   \param numSamples Number of samples. The time of the samples
+                     is elapsed + i * interval()
+   \sa setBatchSize(), sample()
+ */
+void QwtSamplingThread::sampleBatch( double elapsed, int numSamples )
+{
+    const double interval = m_data->msecsInterval / 1e3;
+
+    for ( int i = 0; i < numSamples; i++ )
+        sample( elapsed + i * interval );
+}
+
+/*!
+   \brief Pass a collected sample to the ring buffer
+
+   appendSample() is intended to be called from sample() and
+   does not block.
+
+   \param sample Sample
+   \return false, when no ring buffer is assigned or the sample
+           has been dropped because the buffer is full
+   \sa setRingBuffer(), QwtRingBufferSeriesData::append()
+ */
+bool QwtSamplingThread::appendSample( const QPointF& sample )
+{
+    if ( m_data->ringBuffer == NULL )
+        return false;
+
+    return m_data->ringBuffer->append( sample );
+}
+
 /*!
    \return Time (in ms) since the thread was started
    \sa QThread::start(), run()
@@ -78,12 +275,21 @@ void QwtSamplingThread::stop()
 
 /*!
    Loop collecting samples started from QThread::start()
-   \sa stop()
+   \sa stop(), setSchedulingMode()
  */
 void QwtSamplingThread::run()
 {
+    resetStatistics();
     m_data->timer.start();
 
+    if ( m_data->schedulingMode == DeadlineScheduling )
+        runDeadlines();
+    else
+        runRelative();
+}
+
+void QwtSamplingThread::runRelative()
+{
     /*
         We should have all values in nsecs/qint64, but
         this would break existing code. TODO ...
@@ -107,6 +313,88 @@ void QwtSamplingThread::run()
     }
 }
 
+void QwtSamplingThread::runDeadlines()
+{
+    double msecsInterval = -1.0;
+    qint64 interval = 0;
+
+    qint64 deadline = 0; // of the next sample
+
+    while ( m_data->timer.isValid() )
+    {
+        if ( m_data->msecsInterval != msecsInterval )
+        {
+            // restarting the schedule from now
+            msecsInterval = m_data->msecsInterval;
+            interval = qRound64( msecsInterval * 1e6 );
+            deadline = m_data->timer.nsecsElapsed();
+        }
+
+        if ( interval <= 0 )
+        {
+            sampleBatch( m_data->timer.nsecsElapsed() / 1e9, 1 );
+            continue;
+        }
+
+        const int batchSize = m_data->batchSize;
+        const qint64 wakeup = deadline + ( batchSize - 1 ) * interval;
+
+        waitUntil( wakeup );
+        if ( !m_data->timer.isValid() )
+            break;
+
+        const qint64 now = m_data->timer.nsecsElapsed();
+        const qint64 jitter = qMax( now - wakeup, qint64( 0 ) );
+
+        int numSamples = int( jitter / interval ) + batchSize;
+
+        // catching up one batch at most, skipping the rest
+        int numSkipped = 0;
+        if ( numSamples > 2 * batchSize )
+        {
+            numSkipped = numSamples - 2 * batchSize;
+            numSamples = 2 * batchSize;
+
+            deadline += numSkipped * interval;
+        }
+
+        sampleBatch( deadline / 1e9, numSamples );
+        deadline += numSamples * interval;
+
+        QMutexLocker locker( &m_data->mutex );
+
+        Statistics& statistics = m_data->statistics;
+        statistics.numWakeups++;
+        statistics.numSamples += numSamples;
+        statistics.numSkipped += numSkipped;
+
+        if ( jitter > interval )
+            statistics.numOverruns++;
+
+        m_data->sumJitter += jitter;
+        m_data->maxJitter = qMax( m_data->maxJitter, jitter );
+    }
+}
+
+void QwtSamplingThread::waitUntil( qint64 nsecs ) const
+{
+    const qint64 spin = qRound64( m_data->spinThreshold * 1e6 );
+
+    while ( m_data->timer.isValid() )
+    {
+        const qint64 remaining = nsecs - m_data->timer.nsecsElapsed();
+        if ( remaining <= 0 )
+            break;
+
+        if ( remaining > spin )
+        {
+            const qint64 usecs = ( remaining - spin ) / 1000;
+            if ( usecs > 0 )
+                QThread::usleep( usecs );
+        }
+    }
+}
+
 #if QWT_MOC_INCLUDE
 #include "moc_qwt_sampling_thread.cpp"
 #endif
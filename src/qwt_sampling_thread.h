@@ -13,6 +13,9 @@
 #include "qwt_global.h"
 #include <qthread.h>
 
+class QwtRingBufferSeriesData;
+class QPointF;
+
 /*!
    \brief A thread collecting samples at regular intervals.
 
@@ -23,18 +26,92 @@
    QwtSamplingThread starts a thread calling periodically sample(),
    to collect and store ( or emit ) a single sample.
 
-   \sa QwtPlotCurve, QwtPlotSeriesItem
+   When a QwtRingBufferSeriesData has been assigned, sample() can pass
+   the collected values to appendSample(), that forwards them to the
+   ring buffer without any locking.
+
+   For high sampling rates DeadlineScheduling avoids, that the
+   inaccuracies of the sleeps accumulate. Together with a batch size > 1
+   the costs of waking up the thread can be reduced to one wakeup
+   for several samples, that are passed to sampleBatch().
+
+   \sa QwtPlotCurve, QwtPlotSeriesItem, QwtRingBufferSeriesData
  */
 class QWT_EXPORT QwtSamplingThread : public QThread
 {
     Q_OBJECT
 
   public:
+    /*!
+       \brief Strategy for scheduling the calls of sample()
+       \sa setSchedulingMode()
+     */
+    enum SchedulingMode
+    {
+        /*!
+           After each call of sample() the thread sleeps for what is
+           left from the interval. The sleeps usually take a bit
+           longer than requested and the sampling period drifts.
+         */
+        RelativeScheduling,
+
+        /*!
+           The samples are scheduled for absolute deadlines: origin +
+           n * interval(). The thread sleeps until the deadline minus
+           spinThreshold() and busy waits the rest of the time.
+           The samples are passed in batches to sampleBatch().
+         */
+        DeadlineScheduling
+    };
+
+    /*!
+       \brief Timing statistics of DeadlineScheduling
+       \sa statistics(), resetStatistics()
+     */
+    class Statistics
+    {
+      public:
+        Statistics();
+
+        //! Number of wakeups of the thread
+        int numWakeups;
+
+        //! Number of samples, that have been passed to sampleBatch()
+        int numSamples;
+
+        //! Number of wakeups, that have been more than an interval too late
+        int numOverruns;
+
+        //! Number of deadlines, that have been skipped because of overruns
+        int numSkipped;
+
+        //! Mean delay of the wakeups in ms
+        double meanJitter;
+
+        //! Maximum delay of the wakeups in ms
+        double maxJitter;
+    };
+
     virtual ~QwtSamplingThread();
 
     double interval() const;
     double elapsed() const;
 
+    void setRingBuffer( QwtRingBufferSeriesData* );
+    QwtRingBufferSeriesData* ringBuffer() const;
+
+    void setSchedulingMode( SchedulingMode );
+    SchedulingMode schedulingMode() const;
+
+    void setSpinThreshold( double msecs );
+    double spinThreshold() const;
+
+    void setBatchSize( int );
+    int batchSize() const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
   public Q_SLOTS:
     void setInterval( double interval );
     void stop();
@@ -54,7 +131,16 @@ class QWT_EXPORT QwtSamplingThread : public QThread
      */
     virtual void sample( double elapsed ) = 0;
 
+    virtual void sampleBatch( double elapsed, int numSamples );
+
+    bool appendSample( const QPointF& );
+
   private:
+    void runRelative();
+    void runDeadlines();
+
+    void waitUntil( qint64 nsecs ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -774,7 +774,7 @@ void QwtScaleDraw::drawLabel( QPainter* painter, double value ) const
     painter->save();
     painter->setWorldTransform( transform, true );
 
-    lbl.draw ( painter, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
+    drawTickLabel( painter, value, lbl, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
 
     painter->restore();
 }
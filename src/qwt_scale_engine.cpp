@@ -13,8 +13,11 @@
 #include "qwt_transform.h"
 
 #include <qdebug.h>
+#include <qmutex.h>
+#include <qlist.h>
 
 #include <limits>
+#include <typeinfo>
 
 static inline double qwtLog( double base, double value )
 {
@@ -33,6 +36,212 @@ static inline QwtInterval qwtPowInterval( double base, const QwtInterval& interv
         std::pow( base, interval.maxValue() ) );
 }
 
+namespace
+{
+    /*
+        All parameters, that have an effect on the result
+        of autoScale() or divideScale()
+     */
+    class QwtDivisionKey
+    {
+      public:
+        enum Operation
+        {
+            AutoScale,
+            DivideScale
+        };
+
+        QwtDivisionKey( const QwtScaleEngine* engine, Operation operation,
+                double x1, double x2, int maxMajorSteps, int maxMinorSteps,
+                double stepSize )
+            : type( &typeid( *engine ) )
+            , operation( operation )
+            , base( engine->base() )
+            , attributes( engine->attributes() )
+            , reference( engine->reference() )
+            , lowerMargin( engine->lowerMargin() )
+            , upperMargin( engine->upperMargin() )
+            , x1( x1 )
+            , x2( x2 )
+            , maxMajorSteps( maxMajorSteps )
+            , maxMinorSteps( maxMinorSteps )
+            , stepSize( stepSize )
+        {
+        }
+
+        bool operator==( const QwtDivisionKey& other ) const
+        {
+            return ( operation == other.operation )
+                && ( x1 == other.x1 ) && ( x2 == other.x2 )
+                && ( maxMajorSteps == other.maxMajorSteps )
+                && ( maxMinorSteps == other.maxMinorSteps )
+                && ( stepSize == other.stepSize )
+                && ( base == other.base ) && ( attributes == other.attributes )
+                && ( reference == other.reference )
+                && ( lowerMargin == other.lowerMargin )
+                && ( upperMargin == other.upperMargin )
+                && ( *type == *other.type );
+        }
+
+      private:
+        const std::type_info* type;
+        int operation;
+
+        uint base;
+        int attributes;
+        double reference;
+        double lowerMargin;
+        double upperMargin;
+
+        double x1;
+        double x2;
+        int maxMajorSteps;
+        int maxMinorSteps;
+        double stepSize;
+    };
+
+    /*
+        A cache for the results of the scale engines, that is shared
+        by all plots. F.e. for synchronized axes of many plots the
+        divisions are calculated only once.
+
+        The ticks of the cached divisions are implicitly shared
+        with the divisions being returned.
+     */
+    class QwtDivisionCache
+    {
+      public:
+        QwtDivisionCache()
+            : maxSize( 32 )
+        {
+        }
+
+        bool find( const QwtDivisionKey& key, QwtScaleDiv& scaleDiv )
+        {
+            QMutexLocker locker( &mutex );
+
+            const int index = indexOf( key );
+            if ( index < 0 )
+                return false;
+
+            scaleDiv = entries[index].scaleDiv;
+            return true;
+        }
+
+        bool find( const QwtDivisionKey& key,
+            double& x1, double& x2, double& stepSize )
+        {
+            QMutexLocker locker( &mutex );
+
+            const int index = indexOf( key );
+            if ( index < 0 )
+                return false;
+
+            const Entry& entry = entries[index];
+
+            x1 = entry.x1;
+            x2 = entry.x2;
+            stepSize = entry.stepSize;
+
+            return true;
+        }
+
+        void insert( const QwtDivisionKey& key, const QwtScaleDiv& scaleDiv )
+        {
+            Entry entry( key );
+            entry.scaleDiv = scaleDiv;
+
+            insert( entry );
+        }
+
+        void insert( const QwtDivisionKey& key,
+            double x1, double x2, double stepSize )
+        {
+            Entry entry( key );
+            entry.x1 = x1;
+            entry.x2 = x2;
+            entry.stepSize = stepSize;
+
+            insert( entry );
+        }
+
+        void setMaxSize( int size )
+        {
+            QMutexLocker locker( &mutex );
+
+            maxSize = qMax( size, 0 );
+            while ( entries.size() > maxSize )
+                entries.removeLast();
+        }
+
+        int size()
+        {
+            QMutexLocker locker( &mutex );
+            return maxSize;
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            explicit Entry( const QwtDivisionKey& key )
+                : key( key )
+                , x1( 0.0 )
+                , x2( 0.0 )
+                , stepSize( 0.0 )
+            {
+            }
+
+            QwtDivisionKey key;
+
+            QwtScaleDiv scaleDiv;
+
+            double x1;
+            double x2;
+            double stepSize;
+        };
+
+        int indexOf( const QwtDivisionKey& key )
+        {
+            for ( int i = 0; i < entries.size(); i++ )
+            {
+                if ( entries[i].key == key )
+                {
+                    // most recently used entries first
+                    if ( i > 0 )
+                        entries.move( i, 0 );
+
+                    return 0;
+                }
+            }
+
+            return -1;
+        }
+
+        void insert( const Entry& entry )
+        {
+            QMutexLocker locker( &mutex );
+
+            if ( maxSize <= 0 )
+                return;
+
+            entries.prepend( entry );
+            while ( entries.size() > maxSize )
+                entries.removeLast();
+        }
+
+        QMutex mutex;
+        QList< Entry > entries;
+        int maxSize;
+    };
+}
+
+static QwtDivisionCache& qwtDivisionCache()
+{
+    static QwtDivisionCache cache;
+    return cache;
+}
+
 #if 1
 
 // this version often doesn't find the best ticks: f.e for 15: 5, 10
@@ -271,6 +480,37 @@ QwtTransform* QwtScaleEngine::transformation() const
     return transform;
 }
 
+/*!
+   \brief Set the size of the division cache
+
+   The results of autoScale() and divideScale() of QwtLinearScaleEngine
+   and QwtLogScaleEngine are stored in a cache, that is shared by all
+   engines of these types. When many plots are showing the same
+   scales - f.e. synchronized x axes - the divisions are calculated
+   only once and the ticks of the divisions are implicitly shared.
+
+   Classes derived from these engines are not cached, as they
+   might depend on additional settings.
+
+   \param size Maximum number of cached results. 0 disables the cache.
+               The default setting is 32.
+
+   \sa divisionCacheSize()
+ */
+void QwtScaleEngine::setDivisionCacheSize( int size )
+{
+    qwtDivisionCache().setMaxSize( size );
+}
+
+/*!
+   \return Maximum number of cached results
+   \sa setDivisionCacheSize()
+ */
+int QwtScaleEngine::divisionCacheSize()
+{
+    return qwtDivisionCache().size();
+}
+
 /*!
     \return the margin at the lower end of the scale
     The default margin is 0.
@@ -530,6 +770,27 @@ QwtLinearScaleEngine::~QwtLinearScaleEngine()
  */
 void QwtLinearScaleEngine::autoScale( int maxNumSteps,
     double& x1, double& x2, double& stepSize ) const
+{
+    if ( typeid( *this ) != typeid( QwtLinearScaleEngine ) )
+    {
+        alignScale( maxNumSteps, x1, x2, stepSize );
+        return;
+    }
+
+    const QwtDivisionKey key( this, QwtDivisionKey::AutoScale,
+        x1, x2, maxNumSteps, 0, 0.0 );
+
+    QwtDivisionCache& cache = qwtDivisionCache();
+    if ( !cache.find( key, x1, x2, stepSize ) )
+    {
+        alignScale( maxNumSteps, x1, x2, stepSize );
+        cache.insert( key, x1, x2, stepSize );
+    }
+}
+
+// the uncached implementation of autoScale()
+void QwtLinearScaleEngine::alignScale( int maxNumSteps,
+    double& x1, double& x2, double& stepSize ) const
 {
     QwtInterval interval( x1, x2 );
     interval = interval.normalized();
@@ -576,6 +837,28 @@ void QwtLinearScaleEngine::autoScale( int maxNumSteps,
  */
 QwtScaleDiv QwtLinearScaleEngine::divideScale( double x1, double x2,
     int maxMajorSteps, int maxMinorSteps, double stepSize ) const
+{
+    if ( typeid( *this ) != typeid( QwtLinearScaleEngine ) )
+        return buildScaleDiv( x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+
+    const QwtDivisionKey key( this, QwtDivisionKey::DivideScale,
+        x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+
+    QwtDivisionCache& cache = qwtDivisionCache();
+
+    QwtScaleDiv scaleDiv;
+    if ( !cache.find( key, scaleDiv ) )
+    {
+        scaleDiv = buildScaleDiv( x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+        cache.insert( key, scaleDiv );
+    }
+
+    return scaleDiv;
+}
+
+// the uncached implementation of divideScale()
+QwtScaleDiv QwtLinearScaleEngine::buildScaleDiv( double x1, double x2,
+    int maxMajorSteps, int maxMinorSteps, double stepSize ) const
 {
     QwtInterval interval = QwtInterval( x1, x2 ).normalized();
 
@@ -796,6 +1079,27 @@ QwtLogScaleEngine::~QwtLogScaleEngine()
  */
 void QwtLogScaleEngine::autoScale( int maxNumSteps,
     double& x1, double& x2, double& stepSize ) const
+{
+    if ( typeid( *this ) != typeid( QwtLogScaleEngine ) )
+    {
+        alignScale( maxNumSteps, x1, x2, stepSize );
+        return;
+    }
+
+    const QwtDivisionKey key( this, QwtDivisionKey::AutoScale,
+        x1, x2, maxNumSteps, 0, 0.0 );
+
+    QwtDivisionCache& cache = qwtDivisionCache();
+    if ( !cache.find( key, x1, x2, stepSize ) )
+    {
+        alignScale( maxNumSteps, x1, x2, stepSize );
+        cache.insert( key, x1, x2, stepSize );
+    }
+}
+
+// the uncached implementation of autoScale()
+void QwtLogScaleEngine::alignScale( int maxNumSteps,
+    double& x1, double& x2, double& stepSize ) const
 {
     if ( x1 > x2 )
         qSwap( x1, x2 );
@@ -878,6 +1182,28 @@ void QwtLogScaleEngine::autoScale( int maxNumSteps,
  */
 QwtScaleDiv QwtLogScaleEngine::divideScale( double x1, double x2,
     int maxMajorSteps, int maxMinorSteps, double stepSize ) const
+{
+    if ( typeid( *this ) != typeid( QwtLogScaleEngine ) )
+        return buildScaleDiv( x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+
+    const QwtDivisionKey key( this, QwtDivisionKey::DivideScale,
+        x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+
+    QwtDivisionCache& cache = qwtDivisionCache();
+
+    QwtScaleDiv scaleDiv;
+    if ( !cache.find( key, scaleDiv ) )
+    {
+        scaleDiv = buildScaleDiv( x1, x2, maxMajorSteps, maxMinorSteps, stepSize );
+        cache.insert( key, scaleDiv );
+    }
+
+    return scaleDiv;
+}
+
+// the uncached implementation of divideScale()
+QwtScaleDiv QwtLogScaleEngine::buildScaleDiv( double x1, double x2,
+    int maxMajorSteps, int maxMinorSteps, double stepSize ) const
 {
     QwtInterval interval = QwtInterval( x1, x2 ).normalized();
     interval = interval.limited( QwtLogTransform::LogMin, QwtLogTransform::LogMax );
@@ -126,6 +126,9 @@ class QWT_EXPORT QwtScaleEngine
     void setTransformation( QwtTransform* );
     QwtTransform* transformation() const;
 
+    static void setDivisionCacheSize( int );
+    static int divisionCacheSize();
+
   protected:
     bool contains( const QwtInterval&, double value ) const;
     QList< double > strip( const QList< double >&, const QwtInterval& ) const;
@@ -175,6 +178,13 @@ class QWT_EXPORT QwtLinearScaleEngine : public QwtScaleEngine
     void buildMinorTicks( const QList< double >& majorTicks,
         int maxMinorSteps, double stepSize,
         QList< double >& minorTicks, QList< double >& mediumTicks ) const;
+
+  private:
+    void alignScale( int maxNumSteps,
+        double& x1, double& x2, double& stepSize ) const;
+
+    QwtScaleDiv buildScaleDiv( double x1, double x2,
+        int maxMajorSteps, int maxMinorSteps, double stepSize ) const;
 };
 
 /*!
@@ -214,6 +224,13 @@ class QWT_EXPORT QwtLogScaleEngine : public QwtScaleEngine
     void buildMinorTicks( const QList< double >& majorTicks,
         int maxMinorSteps, double stepSize,
         QList< double >& minorTicks, QList< double >& mediumTicks ) const;
+
+  private:
+    void alignScale( int maxNumSteps,
+        double& x1, double& x2, double& stepSize ) const;
+
+    QwtScaleDiv buildScaleDiv( double x1, double x2,
+        int maxMajorSteps, int maxMinorSteps, double stepSize ) const;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtScaleEngine::Attributes )
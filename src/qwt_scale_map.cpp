@@ -12,6 +12,282 @@
 
 #include <qrect.h>
 #include <qdebug.h>
+#include <typeinfo>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+    ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define QWT_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined( __AVX__ )
+#define QWT_SIMD_AVX 1
+#include <immintrin.h>
+#endif
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#define QWT_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*
+    The linear part of the mapping: out = p1 + ( in - ts1 ) * cnv
+
+    The vectorized kernels use the same order of operations
+    like QwtScaleMap::transform(), so that the results are identical.
+    The instruction sets are chosen at compile time.
+ */
+static void qwtMapLinear( double p1, double ts1, double cnv,
+    const double* in, double* out, size_t count )
+{
+    size_t i = 0;
+
+#if QWT_SIMD_AVX
+    {
+        const __m256d vp1 = _mm256_set1_pd( p1 );
+        const __m256d vts1 = _mm256_set1_pd( ts1 );
+        const __m256d vcnv = _mm256_set1_pd( cnv );
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            const __m256d v = _mm256_sub_pd( _mm256_loadu_pd( in + i ), vts1 );
+            _mm256_storeu_pd( out + i, _mm256_add_pd( vp1, _mm256_mul_pd( v, vcnv ) ) );
+        }
+    }
+#endif
+
+#if QWT_SIMD_SSE2
+    {
+        const __m128d vp1 = _mm_set1_pd( p1 );
+        const __m128d vts1 = _mm_set1_pd( ts1 );
+        const __m128d vcnv = _mm_set1_pd( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const __m128d v = _mm_sub_pd( _mm_loadu_pd( in + i ), vts1 );
+            _mm_storeu_pd( out + i, _mm_add_pd( vp1, _mm_mul_pd( v, vcnv ) ) );
+        }
+    }
+#elif QWT_SIMD_NEON
+    {
+        const float64x2_t vp1 = vdupq_n_f64( p1 );
+        const float64x2_t vts1 = vdupq_n_f64( ts1 );
+        const float64x2_t vcnv = vdupq_n_f64( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const float64x2_t v = vsubq_f64( vld1q_f64( in + i ), vts1 );
+            vst1q_f64( out + i, vaddq_f64( vp1, vmulq_f64( v, vcnv ) ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+        out[i] = p1 + ( in[i] - ts1 ) * cnv;
+}
+
+// the inverse of the linear part: out = ts1 + ( in - p1 ) / cnv
+static void qwtInvMapLinear( double p1, double ts1, double cnv,
+    const double* in, double* out, size_t count )
+{
+    size_t i = 0;
+
+#if QWT_SIMD_SSE2
+    {
+        const __m128d vp1 = _mm_set1_pd( p1 );
+        const __m128d vts1 = _mm_set1_pd( ts1 );
+        const __m128d vcnv = _mm_set1_pd( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const __m128d v = _mm_sub_pd( _mm_loadu_pd( in + i ), vp1 );
+            _mm_storeu_pd( out + i, _mm_add_pd( vts1, _mm_div_pd( v, vcnv ) ) );
+        }
+    }
+#elif QWT_SIMD_NEON
+    {
+        const float64x2_t vp1 = vdupq_n_f64( p1 );
+        const float64x2_t vts1 = vdupq_n_f64( ts1 );
+        const float64x2_t vcnv = vdupq_n_f64( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const float64x2_t v = vsubq_f64( vld1q_f64( in + i ), vp1 );
+            vst1q_f64( out + i, vaddq_f64( vts1, vdivq_f64( v, vcnv ) ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+        out[i] = ts1 + ( in[i] - p1 ) / cnv;
+}
+
+namespace
+{
+    /*
+        Non virtual implementations of the transformations, so that
+        the loops below can be specialized at compile time. They
+        are doing exactly the same operations as QwtLogTransform and
+        QwtPowerTransform.
+     */
+    class QwtLogKernel
+    {
+      public:
+        inline double transform( double value ) const
+        {
+            return std::log( value );
+        }
+
+        inline double invTransform( double value ) const
+        {
+            return std::exp( value );
+        }
+    };
+
+    class QwtPowerKernel
+    {
+      public:
+        explicit QwtPowerKernel( double exponent )
+            : m_exponent( exponent )
+            , m_inverted( 1.0 / exponent )
+        {
+        }
+
+        inline double transform( double value ) const
+        {
+            if ( value < 0.0 )
+                return -std::pow( -value, m_inverted );
+            else
+                return std::pow( value, m_inverted );
+        }
+
+        inline double invTransform( double value ) const
+        {
+            if ( value < 0.0 )
+                return -std::pow( -value, m_exponent );
+            else
+                return std::pow( value, m_exponent );
+        }
+
+      private:
+        const double m_exponent;
+        const double m_inverted;
+    };
+
+    class QwtVirtualKernel
+    {
+      public:
+        explicit QwtVirtualKernel( const QwtTransform* transform )
+            : m_transform( transform )
+        {
+        }
+
+        inline double transform( double value ) const
+        {
+            return m_transform->transform( value );
+        }
+
+        inline double invTransform( double value ) const
+        {
+            return m_transform->invTransform( value );
+        }
+
+      private:
+        const QwtTransform* m_transform;
+    };
+
+    class QwtNullKernel
+    {
+      public:
+        inline double transform( double value ) const
+        {
+            return value;
+        }
+
+        inline double invTransform( double value ) const
+        {
+            return value;
+        }
+    };
+
+    // the linear part of a map
+    class QwtLinearPart
+    {
+      public:
+        inline double map( double value ) const
+        {
+            return p1 + ( value - ts1 ) * cnv;
+        }
+
+        double p1;
+        double ts1;
+        double cnv;
+    };
+}
+
+template< class Kernel >
+static inline void qwtTransformValues( const Kernel& kernel,
+    const double* in, double* out, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+        out[i] = kernel.transform( in[i] );
+}
+
+template< class Kernel >
+static inline void qwtInvTransformValues( const Kernel& kernel,
+    const double* in, double* out, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+        out[i] = kernel.invTransform( in[i] );
+}
+
+template< class XKernel, class YKernel >
+static void qwtMapPoints(
+    const QwtLinearPart& xMap, const XKernel& xKernel,
+    const QwtLinearPart& yMap, const YKernel& yKernel,
+    const QPointF* points, QPointF* out, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const QPointF& pos = points[i];
+
+        const double x = xMap.map( xKernel.transform( pos.x() ) );
+        const double y = yMap.map( yKernel.transform( pos.y() ) );
+
+        out[i] = QPointF( x, y );
+    }
+}
+
+template< class XKernel >
+static void qwtMapPoints(
+    const QwtLinearPart& xMap, const XKernel& xKernel,
+    const QwtLinearPart& yMap, QwtScaleMap::TransformationType yType,
+    const QwtTransform* yTransform, const QPointF* points, QPointF* out, size_t count )
+{
+    switch ( yType )
+    {
+        case QwtScaleMap::NoTransformation:
+        {
+            qwtMapPoints( xMap, xKernel, yMap, QwtNullKernel(), points, out, count );
+            break;
+        }
+        case QwtScaleMap::LogTransformation:
+        {
+            qwtMapPoints( xMap, xKernel, yMap, QwtLogKernel(), points, out, count );
+            break;
+        }
+        case QwtScaleMap::PowerTransformation:
+        {
+            const QwtPowerKernel kernel(
+                static_cast< const QwtPowerTransform* >( yTransform )->exponent() );
+
+            qwtMapPoints( xMap, xKernel, yMap, kernel, points, out, count );
+            break;
+        }
+        default:
+        {
+            qwtMapPoints( xMap, xKernel, yMap,
+                QwtVirtualKernel( yTransform ), points, out, count );
+        }
+    }
+}
 
 /*!
    \brief Constructor
@@ -26,6 +302,8 @@ QwtScaleMap::QwtScaleMap()
     , m_cnv( 1.0 )
     , m_ts1( 0.0 )
     , m_transform( NULL )
+    , m_transformType( NoTransformation )
+    , m_exponent( 1.0 )
 {
 }
 
@@ -38,6 +316,8 @@ QwtScaleMap::QwtScaleMap( const QwtScaleMap& other )
     , m_cnv( other.m_cnv )
     , m_ts1( other.m_ts1 )
     , m_transform( NULL )
+    , m_transformType( other.m_transformType )
+    , m_exponent( other.m_exponent )
 {
     if ( other.m_transform )
         m_transform = other.m_transform->copy();
@@ -67,6 +347,9 @@ QwtScaleMap& QwtScaleMap::operator=( const QwtScaleMap& other )
     if ( other.m_transform )
         m_transform = other.m_transform->copy();
 
+    m_transformType = other.m_transformType;
+    m_exponent = other.m_exponent;
+
     return *this;
 }
 
@@ -81,9 +364,36 @@ void QwtScaleMap::setTransformation( QwtTransform* transform )
         m_transform = transform;
     }
 
+    updateTransformationType();
     setScaleInterval( m_s1, m_s2 );
 }
 
+void QwtScaleMap::updateTransformationType()
+{
+    m_transformType = NoTransformation;
+    m_exponent = 1.0;
+
+    if ( m_transform )
+    {
+        m_transformType = OtherTransformation;
+
+        // subclasses might override transform(): exact types only
+
+        const std::type_info& info = typeid( *m_transform );
+
+        if ( info == typeid( QwtLogTransform ) )
+        {
+            m_transformType = LogTransformation;
+        }
+        else if ( info == typeid( QwtPowerTransform ) )
+        {
+            m_transformType = PowerTransformation;
+            m_exponent = static_cast< const QwtPowerTransform* >(
+                m_transform )->exponent();
+        }
+    }
+}
+
 //! Get the transformation
 const QwtTransform* QwtScaleMap::transformation() const
 {
@@ -140,6 +450,194 @@ void QwtScaleMap::updateFactor()
         m_cnv = ( m_p2 - m_p1 ) / ( ts2 - m_ts1 );
 }
 
+/*!
+   \brief Transform an array of values from scale to paint device coordinates
+
+   The result is the same as calling transform( double ) for each value,
+   but the linear part of the mapping is vectorized ( SSE2/AVX/NEON,
+   depending on the instruction sets being enabled at compile time ).
+   For QwtLogTransform the virtual call for each value is avoided.
+
+   \param values Values in scale coordinates
+   \param out Translated values, might be the same array as values
+   \param count Number of values
+
+   \sa invTransform()
+ */
+void QwtScaleMap::transform( const double* values,
+    double* out, size_t count ) const
+{
+    switch ( m_transformType )
+    {
+        case NoTransformation:
+            break;
+
+        case LogTransformation:
+        {
+            qwtTransformValues( QwtLogKernel(), values, out, count );
+            values = out;
+            break;
+        }
+        case PowerTransformation:
+        {
+            qwtTransformValues( QwtPowerKernel( m_exponent ), values, out, count );
+            values = out;
+            break;
+        }
+        default:
+        {
+            qwtTransformValues( QwtVirtualKernel( m_transform ), values, out, count );
+            values = out;
+        }
+    }
+
+    qwtMapLinear( m_p1, m_ts1, m_cnv, values, out, count );
+}
+
+/*!
+   \brief Transform an array of values from paint device to scale coordinates
+
+   The result is the same as calling invTransform( double ) for each value.
+
+   \param values Values in paint device coordinates
+   \param out Translated values, might be the same array as values
+   \param count Number of values
+
+   \sa transform()
+ */
+void QwtScaleMap::invTransform( const double* values,
+    double* out, size_t count ) const
+{
+    qwtInvMapLinear( m_p1, m_ts1, m_cnv, values, out, count );
+
+    switch ( m_transformType )
+    {
+        case NoTransformation:
+            break;
+
+        case LogTransformation:
+        {
+            qwtInvTransformValues( QwtLogKernel(), out, out, count );
+            break;
+        }
+        case PowerTransformation:
+        {
+            qwtInvTransformValues( QwtPowerKernel( m_exponent ), out, out, count );
+            break;
+        }
+        default:
+        {
+            qwtInvTransformValues( QwtVirtualKernel( m_transform ), out, out, count );
+        }
+    }
+}
+
+/*!
+   \brief Transform an array of points from scale to paint coordinates
+
+   The result is the same as calling transform( const QwtScaleMap&,
+   const QwtScaleMap&, const QPointF& ) for each point. Without
+   transformations the points are mapped in vectorized operations.
+
+   \param xMap X map
+   \param yMap Y map
+   \param points Points in scale coordinates
+   \param out Translated points, might be the same array as points
+   \param count Number of points
+ */
+void QwtScaleMap::transform( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QPointF* points, QPointF* out, size_t count )
+{
+    size_t i = 0;
+
+#if QWT_SIMD_SSE2 || QWT_SIMD_NEON
+    if ( sizeof( qreal ) == sizeof( double )
+        && xMap.m_transform == NULL && yMap.m_transform == NULL )
+    {
+        // x and y are processed in one operation
+
+        const double* in = reinterpret_cast< const double* >( points );
+        double* to = reinterpret_cast< double* >( out );
+
+#if QWT_SIMD_SSE2
+        const __m128d vp1 = _mm_set_pd( yMap.m_p1, xMap.m_p1 );
+        const __m128d vts1 = _mm_set_pd( yMap.m_ts1, xMap.m_ts1 );
+        const __m128d vcnv = _mm_set_pd( yMap.m_cnv, xMap.m_cnv );
+
+        for ( ; i < count; i++ )
+        {
+            const __m128d v = _mm_sub_pd( _mm_loadu_pd( in + 2 * i ), vts1 );
+            _mm_storeu_pd( to + 2 * i, _mm_add_pd( vp1, _mm_mul_pd( v, vcnv ) ) );
+        }
+#else
+        const double p1[] = { xMap.m_p1, yMap.m_p1 };
+        const double ts1[] = { xMap.m_ts1, yMap.m_ts1 };
+        const double cnv[] = { xMap.m_cnv, yMap.m_cnv };
+
+        const float64x2_t vp1 = vld1q_f64( p1 );
+        const float64x2_t vts1 = vld1q_f64( ts1 );
+        const float64x2_t vcnv = vld1q_f64( cnv );
+
+        for ( ; i < count; i++ )
+        {
+            const float64x2_t v = vsubq_f64( vld1q_f64( in + 2 * i ), vts1 );
+            vst1q_f64( to + 2 * i, vaddq_f64( vp1, vmulq_f64( v, vcnv ) ) );
+        }
+#endif
+    }
+#endif
+
+    if ( i >= count )
+        return;
+
+    /*
+        The transformations are resolved once for all points, so that
+        the loop is specialized for the combination of both types.
+     */
+
+    points += i;
+    out += i;
+    count -= i;
+
+    QwtLinearPart x;
+    x.p1 = xMap.m_p1;
+    x.ts1 = xMap.m_ts1;
+    x.cnv = xMap.m_cnv;
+
+    QwtLinearPart y;
+    y.p1 = yMap.m_p1;
+    y.ts1 = yMap.m_ts1;
+    y.cnv = yMap.m_cnv;
+
+    const TransformationType yType = yMap.m_transformType;
+    const QwtTransform* yTransform = yMap.m_transform;
+
+    switch ( xMap.m_transformType )
+    {
+        case NoTransformation:
+        {
+            qwtMapPoints( x, QwtNullKernel(), y, yType, yTransform, points, out, count );
+            break;
+        }
+        case LogTransformation:
+        {
+            qwtMapPoints( x, QwtLogKernel(), y, yType, yTransform, points, out, count );
+            break;
+        }
+        case PowerTransformation:
+        {
+            qwtMapPoints( x, QwtPowerKernel( xMap.m_exponent ),
+                y, yType, yTransform, points, out, count );
+            break;
+        }
+        default:
+        {
+            qwtMapPoints( x, QwtVirtualKernel( xMap.m_transform ),
+                y, yType, yTransform, points, out, count );
+        }
+    }
+}
+
 /*!
    Transform a rectangle from scale to paint coordinates
 
@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_transform.h"
 
+#include <cstddef>
+
 class QPointF;
 class QRectF;
 
@@ -26,6 +28,30 @@ class QRectF;
 class QWT_EXPORT QwtScaleMap
 {
   public:
+    /*!
+       \brief Type of the transformation
+
+       The type is detected, when assigning the transformation.
+       The mapping of arrays uses specialized loops for the
+       known types, avoiding a virtual call for each value.
+
+       \sa transformationType(), setTransformation()
+     */
+    enum TransformationType
+    {
+        //! No transformation
+        NoTransformation,
+
+        //! QwtLogTransform, but not a class derived from it
+        LogTransformation,
+
+        //! QwtPowerTransform, but not a class derived from it
+        PowerTransformation,
+
+        //! Any other transformation, including derived classes of the above
+        OtherTransformation
+    };
+
     QwtScaleMap();
     QwtScaleMap( const QwtScaleMap& );
 
@@ -36,12 +62,17 @@ class QWT_EXPORT QwtScaleMap
     void setTransformation( QwtTransform* );
     const QwtTransform* transformation() const;
 
+    TransformationType transformationType() const;
+
     void setPaintInterval( double p1, double p2 );
     void setScaleInterval( double s1, double s2 );
 
     double transform( double s ) const;
     double invTransform( double p ) const;
 
+    void transform( const double* values, double* out, size_t count ) const;
+    void invTransform( const double* values, double* out, size_t count ) const;
+
     double p1() const;
     double p2() const;
 
@@ -63,10 +94,14 @@ class QWT_EXPORT QwtScaleMap
     static QPointF invTransform( const QwtScaleMap&,
         const QwtScaleMap&, const QPointF& );
 
+    static void transform( const QwtScaleMap&, const QwtScaleMap&,
+        const QPointF* points, QPointF* out, size_t count );
+
     bool isInverting() const;
 
   private:
     void updateFactor();
+    void updateTransformationType();
 
     double m_s1, m_s2;     // scale interval boundaries
     double m_p1, m_p2;     // paint device interval boundaries
@@ -75,8 +110,20 @@ class QWT_EXPORT QwtScaleMap
     double m_ts1;
 
     QwtTransform* m_transform;
+
+    TransformationType m_transformType;
+    double m_exponent;  // for PowerTransformation
 };
 
+/*!
+   \return Type of the transformation
+   \sa setTransformation()
+ */
+inline QwtScaleMap::TransformationType QwtScaleMap::transformationType() const
+{
+    return m_transformType;
+}
+
 /*!
     \return First border of the scale interval
  */
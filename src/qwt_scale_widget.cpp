@@ -23,6 +23,360 @@
 #include <qstyleoption.h>
 #include <qapplication.h>
 #include <qmargins.h>
+#include <qpixmap.h>
+#include <qregion.h>
+
+namespace
+{
+    /*
+        Attributes of the scale draw, that have an effect on
+        the rendered scale - beside the scale division and the map.
+     */
+    class QwtScaleCacheKey
+    {
+      public:
+        QwtScaleCacheKey()
+            : scaleDraw( NULL )
+            , pixelRatio( 1.0 )
+        {
+        }
+
+        QwtScaleCacheKey( const QWidget* widget, const QwtScaleDraw* sd )
+            : scaleDraw( sd )
+            , size( widget->size() )
+            , pixelRatio( QwtPainter::devicePixelRatio( widget ) )
+            , alignment( sd->alignment() )
+            , pos( sd->pos() )
+            , length( sd->length() )
+            , labelRotation( sd->labelRotation() )
+            , labelAlignment( sd->labelAlignment() )
+            , spacing( sd->spacing() )
+            , penWidthF( sd->penWidthF() )
+            , components( 0 )
+        {
+            for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+            {
+                tickLength[i] = sd->tickLength(
+                    static_cast< QwtScaleDiv::TickType >( i ) );
+            }
+
+            const QwtAbstractScaleDraw::ScaleComponent c[] =
+            {
+                QwtAbstractScaleDraw::Backbone,
+                QwtAbstractScaleDraw::Ticks,
+                QwtAbstractScaleDraw::Labels
+            };
+
+            for ( int i = 0; i < 3; i++ )
+            {
+                if ( sd->hasComponent( c[i] ) )
+                    components |= c[i];
+            }
+        }
+
+        bool operator==( const QwtScaleCacheKey& other ) const
+        {
+            for ( int i = 0; i < QwtScaleDiv::NTickTypes; i++ )
+            {
+                if ( tickLength[i] != other.tickLength[i] )
+                    return false;
+            }
+
+            return ( scaleDraw == other.scaleDraw )
+                && ( size == other.size )
+                && ( pixelRatio == other.pixelRatio )
+                && ( alignment == other.alignment )
+                && ( pos == other.pos )
+                && ( length == other.length )
+                && ( labelRotation == other.labelRotation )
+                && ( labelAlignment == other.labelAlignment )
+                && ( spacing == other.spacing )
+                && ( penWidthF == other.penWidthF )
+                && ( components == other.components );
+        }
+
+        bool operator!=( const QwtScaleCacheKey& other ) const
+        {
+            return !( *this == other );
+        }
+
+        const QwtScaleDraw* scaleDraw;
+
+        QSize size;
+        qreal pixelRatio;
+
+        QwtScaleDraw::Alignment alignment;
+        QPointF pos;
+        double length;
+
+        double labelRotation;
+        Qt::Alignment labelAlignment;
+
+        double tickLength[QwtScaleDiv::NTickTypes];
+        double spacing;
+        qreal penWidthF;
+        int components;
+    };
+
+    /*
+        The backbone, ticks and labels rendered to a pixmap, that is
+        reused as long as the scale does not change. When the scale
+        division has been translated only the pixmap is scrolled and
+        the scale is rendered to the exposed strips.
+     */
+    class QwtScaleCache
+    {
+      public:
+        QwtScaleCache()
+            : isValid( false )
+        {
+        }
+
+        void update( QWidget*, const QwtScaleDraw* );
+
+      private:
+        bool scroll( const QWidget*, const QwtScaleDraw*, QRegion& );
+        void render( const QWidget*, const QwtScaleDraw*, const QRegion& );
+
+      public:
+        bool isValid;
+        QPixmap pixmap;
+
+      private:
+        QwtScaleCacheKey key;
+        QwtScaleDiv scaleDiv;
+        QwtScaleMap scaleMap;
+    };
+}
+
+static inline bool qwtHasSameTicks( const QwtScaleDiv& div1,
+    const QwtScaleDiv& div2, double min, double max )
+{
+    for ( int type = 0; type < QwtScaleDiv::NTickTypes; type++ )
+    {
+        const QList< double >& ticks1 = div1.ticks( type );
+        const QList< double >& ticks2 = div2.ticks( type );
+
+        int i1 = 0;
+        int i2 = 0;
+
+        while ( true )
+        {
+            while ( i1 < ticks1.size() &&
+                ( ticks1[i1] < min || ticks1[i1] > max ) )
+            {
+                i1++;
+            }
+
+            while ( i2 < ticks2.size() &&
+                ( ticks2[i2] < min || ticks2[i2] > max ) )
+            {
+                i2++;
+            }
+
+            if ( i1 == ticks1.size() || i2 == ticks2.size() )
+            {
+                if ( i1 != ticks1.size() || i2 != ticks2.size() )
+                    return false;
+
+                break;
+            }
+
+            if ( ticks1[i1++] != ticks2[i2++] )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static inline bool qwtIsIntegral( double value )
+{
+    return qAbs( value - qRound( value ) ) < 1e-6;
+}
+
+void QwtScaleCache::update( QWidget* widget, const QwtScaleDraw* sd )
+{
+    const QwtScaleCacheKey newKey( widget, sd );
+
+    if ( newKey.size.isEmpty() )
+    {
+        pixmap = QPixmap();
+        isValid = false;
+
+        return;
+    }
+
+    if ( isValid && newKey == key )
+    {
+        if ( sd->scaleDiv() == scaleDiv
+            && sd->scaleMap().s1() == scaleMap.s1()
+            && sd->scaleMap().s2() == scaleMap.s2() )
+        {
+            return;
+        }
+
+        QRegion exposed;
+        if ( scroll( widget, sd, exposed ) )
+        {
+            render( widget, sd, exposed );
+
+            scaleDiv = sd->scaleDiv();
+            scaleMap = sd->scaleMap();
+
+            return;
+        }
+    }
+
+    pixmap = QwtPainter::backingStore( widget, newKey.size );
+    pixmap.fill( Qt::transparent );
+
+    render( widget, sd, QRegion() );
+
+    key = newKey;
+    scaleDiv = sd->scaleDiv();
+    scaleMap = sd->scaleMap();
+
+    isValid = true;
+}
+
+/*
+    Scrolling the pixmap, when the new scale is the old one translated
+    by an integral number of pixels, with the same ticks, where both
+    scales overlap.
+ */
+bool QwtScaleCache::scroll( const QWidget* widget,
+    const QwtScaleDraw* sd, QRegion& exposed )
+{
+    const QwtScaleMap& map = sd->scaleMap();
+
+    if ( map.transformationType() != scaleMap.transformationType() )
+        return false;
+
+    if ( map.transformationType() != QwtScaleMap::NoTransformation &&
+        map.transformationType() != QwtScaleMap::LogTransformation )
+    {
+        return false;
+    }
+
+    const QwtScaleDiv& div = sd->scaleDiv();
+
+    const double min = qMax( qMin( div.lowerBound(), div.upperBound() ),
+        qMin( scaleDiv.lowerBound(), scaleDiv.upperBound() ) );
+
+    const double max = qMin( qMax( div.lowerBound(), div.upperBound() ),
+        qMax( scaleDiv.lowerBound(), scaleDiv.upperBound() ) );
+
+    if ( min >= max )
+        return false;
+
+    const double d = map.transform( min ) - scaleMap.transform( min );
+    if ( qAbs( d - ( map.transform( max ) - scaleMap.transform( max ) ) ) > 1e-6 )
+        return false;
+
+    const qreal pixelRatio = key.pixelRatio;
+
+    // the rounding of the positions has to be the same
+    if ( !qwtIsIntegral( d ) || !qwtIsIntegral( d * pixelRatio ) )
+        return false;
+
+    const int dist = qRound( d );
+
+    const double p1 = qMin( map.p1(), map.p2() );
+    const double p2 = qMax( map.p1(), map.p2() );
+
+    if ( qAbs( dist ) >= p2 - p1 )
+        return false;
+
+    if ( !qwtHasSameTicks( div, scaleDiv, min, max ) )
+        return false;
+
+    /*
+        The labels might be wider than the distance of the ticks,
+        so the strips need to include the labels, that are
+        partly inside of the scrolled area.
+     */
+    const bool isHorizontal = ( sd->orientation() == Qt::Horizontal );
+    const QFont font = widget->font();
+
+    double labelMargin = 0.0;
+    if ( sd->hasComponent( QwtAbstractScaleDraw::Labels ) )
+    {
+        const QwtScaleDiv* divs[] = { &div, &scaleDiv };
+        for ( int k = 0; k < 2; k++ )
+        {
+            const QList< double >& ticks = divs[k]->ticks( QwtScaleDiv::MajorTick );
+            for ( int i = 0; i < ticks.size(); i++ )
+            {
+                const QRect r = sd->boundingLabelRect( font, ticks[i] );
+                if ( r.isEmpty() )
+                    continue;
+
+                const double pos = map.transform( ticks[i] );
+                if ( isHorizontal )
+                {
+                    labelMargin = qMax( labelMargin, qAbs( r.left() - pos ) );
+                    labelMargin = qMax( labelMargin, qAbs( r.right() - pos ) );
+                }
+                else
+                {
+                    labelMargin = qMax( labelMargin, qAbs( r.top() - pos ) );
+                    labelMargin = qMax( labelMargin, qAbs( r.bottom() - pos ) );
+                }
+            }
+        }
+    }
+
+    const int margin = qwtCeil( labelMargin + sd->penWidthF() ) + 2;
+
+    const int from = qwtFloor( p1 ) + qAbs( dist ) + margin;
+    const int to = qwtCeil( p2 ) - qAbs( dist ) - margin;
+
+    if ( from >= to )
+        return false;
+
+    // QPixmap::scroll works in device pixels
+    const int offset = qRound( dist * pixelRatio );
+    if ( isHorizontal )
+        pixmap.scroll( offset, 0, pixmap.rect() );
+    else
+        pixmap.scroll( 0, offset, pixmap.rect() );
+
+    const QRect rect( QPoint( 0, 0 ), key.size );
+
+    if ( isHorizontal )
+    {
+        exposed = QRegion( rect.left(), rect.top(),
+            from - rect.left(), rect.height() );
+        exposed += QRegion( to, rect.top(), rect.right() - to + 1, rect.height() );
+    }
+    else
+    {
+        exposed = QRegion( rect.left(), rect.top(),
+            rect.width(), from - rect.top() );
+        exposed += QRegion( rect.left(), to, rect.width(), rect.bottom() - to + 1 );
+    }
+
+    return true;
+}
+
+void QwtScaleCache::render( const QWidget* widget,
+    const QwtScaleDraw* sd, const QRegion& clipRegion )
+{
+    QPainter painter( &pixmap );
+
+    if ( !clipRegion.isEmpty() )
+    {
+        painter.setClipRegion( clipRegion );
+
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+        painter.fillRect( clipRegion.boundingRect(), Qt::transparent );
+        painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+    }
+
+    painter.setFont( widget->font() );
+    sd->draw( &painter, widget->palette() );
+}
 
 class QwtScaleWidget::PrivateData
 {
@@ -58,7 +412,22 @@ class QwtScaleWidget::PrivateData
         int width;
         QwtInterval interval;
         QwtColorMap* colorMap;
+
+        // the rendered bar is reused as long as its key does not change
+        struct t_cache
+        {
+            QPixmap pixmap;
+
+            QRectF rect;
+            QwtInterval interval;
+            double s1, s2;
+            const QwtTransform* transformation;
+            Qt::Orientation orientation;
+            qreal pixelRatio;
+        } cache;
     } colorBar;
+
+    QwtScaleCache scaleCache;
 };
 
 /*!
@@ -343,6 +712,9 @@ void QwtScaleWidget::setScaleDraw( QwtScaleDraw* scaleDraw )
     delete m_data->scaleDraw;
     m_data->scaleDraw = scaleDraw;
 
+    m_data->scaleCache.isValid = false;
+    m_data->colorBar.cache.pixmap = QPixmap();
+
     layoutScale();
 }
 
@@ -421,7 +793,10 @@ void QwtScaleWidget::paintEvent( QPaintEvent* event )
     opt.initFrom(this);
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
 
-    draw( &painter );
+    m_data->scaleCache.update( this, m_data->scaleDraw );
+    painter.drawPixmap( 0, 0, m_data->scaleCache.pixmap );
+
+    drawColorBarAndTitle( &painter );
 }
 
 /*!
@@ -430,7 +805,31 @@ void QwtScaleWidget::paintEvent( QPaintEvent* event )
 void QwtScaleWidget::draw( QPainter* painter ) const
 {
     m_data->scaleDraw->draw( painter, palette() );
+    drawColorBarAndTitle( painter );
+}
 
+/*!
+   \brief Invalidate the pixmap, that is used to speed up repainting
+
+   The backbone, ticks and labels are cached in a pixmap, that is
+   updated, when the attributes of the scale draw or the geometry
+   of the widget have changed. When the scale division has been
+   translated by an integral number of pixels - like when scrolling -
+   the pixmap is scrolled and only the exposed strips are rendered.
+
+   Changes of the labels, that can't be detected - f.e. when
+   QwtAbstractScaleDraw::label() returns different texts after
+   calling QwtAbstractScaleDraw::invalidateCache() - need to be
+   followed by invalidateCache().
+ */
+void QwtScaleWidget::invalidateCache()
+{
+    m_data->scaleCache.isValid = false;
+    update();
+}
+
+void QwtScaleWidget::drawColorBarAndTitle( QPainter* painter ) const
+{
     if ( m_data->colorBar.isEnabled && m_data->colorBar.width > 0 &&
         m_data->colorBar.interval.isValid() )
     {
@@ -518,9 +917,23 @@ QRectF QwtScaleWidget::colorBarRect( const QRectF& rect ) const
  */
 void QwtScaleWidget::changeEvent( QEvent* event )
 {
-    if ( event->type() == QEvent::LocaleChange )
+    switch ( event->type() )
     {
-        m_data->scaleDraw->invalidateCache();
+        case QEvent::LocaleChange:
+        {
+            m_data->scaleDraw->invalidateCache();
+            m_data->scaleCache.isValid = false;
+            break;
+        }
+        case QEvent::FontChange:
+        case QEvent::PaletteChange:
+        case QEvent::StyleChange:
+        {
+            m_data->scaleCache.isValid = false;
+            break;
+        }
+        default:
+            break;
     }
 
     QWidget::changeEvent( event );
@@ -616,6 +1029,10 @@ void QwtScaleWidget::layoutScale( bool update_geometry )
 /*!
    Draw the color bar of the scale widget
 
+   The rendered bar is cached and painted again, as long as rect,
+   the scale, the color map and the device pixel ratio of the paint
+   device are unchanged.
+
    \param painter Painter
    \param rect Bounding rectangle for the color bar
 
@@ -627,10 +1044,33 @@ void QwtScaleWidget::drawColorBar( QPainter* painter, const QRectF& rect ) const
         return;
 
     const QwtScaleDraw* sd = m_data->scaleDraw;
+    const QwtScaleMap& scaleMap = sd->scaleMap();
+
+    const QwtInterval interval = m_data->colorBar.interval.normalized();
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+
+    PrivateData::t_colorBar::t_cache& cache = m_data->colorBar.cache;
 
-    QwtPainter::drawColorBar( painter, *m_data->colorBar.colorMap,
-        m_data->colorBar.interval.normalized(), sd->scaleMap(),
-        sd->orientation(), rect );
+    if ( cache.pixmap.isNull() || cache.rect != rect
+        || cache.interval != interval
+        || cache.s1 != scaleMap.s1() || cache.s2 != scaleMap.s2()
+        || cache.transformation != scaleMap.transformation()
+        || cache.orientation != sd->orientation()
+        || cache.pixelRatio != pixelRatio )
+    {
+        cache.pixmap = QwtPainter::colorBarPixmap( *m_data->colorBar.colorMap,
+            interval, scaleMap, sd->orientation(), rect );
+
+        cache.rect = rect;
+        cache.interval = interval;
+        cache.s1 = scaleMap.s1();
+        cache.s2 = scaleMap.s2();
+        cache.transformation = scaleMap.transformation();
+        cache.orientation = sd->orientation();
+        cache.pixelRatio = pixelRatio;
+    }
+
+    QwtPainter::drawPixmap( painter, rect, cache.pixmap );
 }
 
 /*!
@@ -884,6 +1324,9 @@ void QwtScaleWidget::setScaleDiv( const QwtScaleDiv& scaleDiv )
 void QwtScaleWidget::setTransformation( QwtTransform* transformation )
 {
     m_data->scaleDraw->setTransformation( transformation );
+    m_data->scaleCache.isValid = false;
+    m_data->colorBar.cache.pixmap = QPixmap();
+
     layoutScale();
 }
 
@@ -956,6 +1399,7 @@ void QwtScaleWidget::setColorMap(
     const QwtInterval& interval, QwtColorMap* colorMap )
 {
     m_data->colorBar.interval = interval;
+    m_data->colorBar.cache.pixmap = QPixmap();
 
     if ( colorMap != m_data->colorBar.colorMap )
     {
@@ -115,6 +115,8 @@ class QWT_EXPORT QwtScaleWidget : public QWidget
 
     QRectF colorBarRect( const QRectF& ) const;
 
+    void invalidateCache();
+
   protected:
     virtual void paintEvent( QPaintEvent* ) QWT_OVERRIDE;
     virtual void resizeEvent( QResizeEvent* ) QWT_OVERRIDE;
@@ -127,6 +129,7 @@ class QWT_EXPORT QwtScaleWidget : public QWidget
 
   private:
     void initScale( QwtScaleDraw::Alignment );
+    void drawColorBarAndTitle( QPainter* ) const;
 
     class PrivateData;
     PrivateData* m_data;
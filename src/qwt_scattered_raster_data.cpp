@@ -0,0 +1,860 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_scattered_raster_data.h"
+#include "qwt_interval.h"
+#include "qwt_point_3d.h"
+#include "qwt_math.h"
+
+#include <qvector.h>
+#include <qnumeric.h>
+#include <qrect.h>
+
+static const int qwtMaxNeighbours = 64;
+
+namespace
+{
+    /*
+        A triangle of the triangulation in counter clockwise order.
+        n[i] is the neighbour at the edge opposite to v[i],
+        or -1 for the edges of the enclosing triangle.
+     */
+    class QwtTriangle
+    {
+      public:
+        int v[3];
+        int n[3];
+    };
+
+    class QwtCavityEdge
+    {
+      public:
+        int a;
+        int b;
+        int neighbour;
+        int triangle;
+    };
+
+    class QwtScatteredRenderContext : public QwtRasterData::RenderContext
+    {
+      public:
+        QwtScatteredRenderContext( const QwtScatteredRasterData* data,
+                const QRectF& area, const QSize& raster )
+            : QwtRasterData::RenderContext( data, area, raster )
+            , m_triangle( -1 )
+        {
+        }
+
+        virtual double value( double x, double y ) QWT_OVERRIDE
+        {
+            return scatteredData()->value( x, y, &m_triangle );
+        }
+
+        virtual void values( double y, const double* x,
+            int numValues, double* values ) QWT_OVERRIDE
+        {
+            const QwtScatteredRasterData* data = scatteredData();
+
+            for ( int i = 0; i < numValues; i++ )
+                values[i] = data->value( x[i], y, &m_triangle );
+        }
+
+      private:
+        inline const QwtScatteredRasterData* scatteredData() const
+        {
+            return static_cast< const QwtScatteredRasterData* >( data() );
+        }
+
+        // triangle of the previous value, where to start the next walk
+        int m_triangle;
+    };
+}
+
+static inline double qwtOrient( const QPointF& a,
+    const QPointF& b, const QPointF& p )
+{
+    // > 0, when p is on the left side of a->b
+    return ( b.x() - a.x() ) * ( p.y() - a.y() )
+        - ( b.y() - a.y() ) * ( p.x() - a.x() );
+}
+
+static inline bool qwtInCircle( const QPointF& a, const QPointF& b,
+    const QPointF& c, const QPointF& p )
+{
+    // a, b, c in counter clockwise order
+
+    const double adx = a.x() - p.x();
+    const double ady = a.y() - p.y();
+    const double bdx = b.x() - p.x();
+    const double bdy = b.y() - p.y();
+    const double cdx = c.x() - p.x();
+    const double cdy = c.y() - p.y();
+
+    const double det = ( adx * adx + ady * ady ) * ( bdx * cdy - cdx * bdy )
+        + ( bdx * bdx + bdy * bdy ) * ( cdx * ady - adx * cdy )
+        + ( cdx * cdx + cdy * cdy ) * ( adx * bdy - bdx * ady );
+
+    return det > 0.0;
+}
+
+static int qwtWalk( const QPointF* points, const QwtTriangle* triangles,
+    int numTriangles, int triangle, const QPointF& p )
+{
+    // visibility walk, that terminates for Delaunay triangulations
+
+    for ( int steps = 0; steps < numTriangles; steps++ )
+    {
+        const QwtTriangle& t = triangles[triangle];
+
+        int next = triangle;
+        for ( int i = 0; i < 3; i++ )
+        {
+            const QPointF& a = points[ t.v[ ( i + 1 ) % 3 ] ];
+            const QPointF& b = points[ t.v[ ( i + 2 ) % 3 ] ];
+
+            if ( qwtOrient( a, b, p ) < 0.0 )
+            {
+                next = t.n[i];
+                break;
+            }
+        }
+
+        if ( next == triangle )
+            return triangle;
+
+        if ( next < 0 )
+            return -1; // outside of the enclosing triangle
+
+        triangle = next;
+    }
+
+    return -1;
+}
+
+static QVector< QwtTriangle > qwtDelaunayTriangles( const QVector< QPointF >& points )
+{
+    /*
+        Bowyer-Watson: the last 3 points are the vertices of a triangle,
+        that encloses all other points. The points are inserted in
+        the order of the buckets, so that the walks are short.
+     */
+
+    const int numPoints = points.size() - 3;
+    const QPointF* pts = points.constData();
+
+    QVector< QwtTriangle > triangles;
+    triangles.reserve( 2 * numPoints + 1 );
+
+    QVector< int > marks;
+    QVector< int > freeSlots;
+    QVector< int > cavity;
+    QVector< QwtCavityEdge > edges;
+
+    const QwtTriangle enclosing = { { numPoints, numPoints + 1, numPoints + 2 }, { -1, -1, -1 } };
+    triangles += enclosing;
+    marks += 0;
+
+    int last = 0;
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const QPointF& p = pts[i];
+        const int stamp = i + 1;
+
+        int t = qwtWalk( pts, triangles.constData(), triangles.size(), last, p );
+        if ( t < 0 )
+            continue;
+
+        {
+            const QwtTriangle& tri = triangles[t];
+            if ( pts[ tri.v[0] ] == p || pts[ tri.v[1] ] == p || pts[ tri.v[2] ] == p )
+                continue; // duplicate
+        }
+
+        // the triangles, whose circumcircle contains p
+
+        cavity.clear();
+        cavity += t;
+        marks[t] = stamp;
+
+        for ( int j = 0; j < cavity.size(); j++ )
+        {
+            const QwtTriangle& tri = triangles[ cavity[j] ];
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                const int nb = tri.n[k];
+                if ( nb < 0 || marks[nb] == stamp )
+                    continue;
+
+                const QwtTriangle& nt = triangles[nb];
+                if ( qwtInCircle( pts[ nt.v[0] ], pts[ nt.v[1] ], pts[ nt.v[2] ], p ) )
+                {
+                    marks[nb] = stamp;
+                    cavity += nb;
+                }
+            }
+        }
+
+        // the border of the cavity
+
+        edges.clear();
+        for ( int j = 0; j < cavity.size(); j++ )
+        {
+            const QwtTriangle& tri = triangles[ cavity[j] ];
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                const int nb = tri.n[k];
+                if ( nb < 0 || marks[nb] != stamp )
+                {
+                    const QwtCavityEdge edge =
+                        { tri.v[ ( k + 1 ) % 3 ], tri.v[ ( k + 2 ) % 3 ], nb, -1 };
+                    edges += edge;
+                }
+            }
+        }
+
+        freeSlots += cavity;
+
+        // connecting p with the edges of the border
+
+        for ( int j = 0; j < edges.size(); j++ )
+        {
+            QwtCavityEdge& edge = edges[j];
+
+            if ( freeSlots.isEmpty() )
+            {
+                edge.triangle = triangles.size();
+                triangles += QwtTriangle();
+                marks += 0;
+            }
+            else
+            {
+                edge.triangle = freeSlots.last();
+                freeSlots.removeLast();
+            }
+
+            QwtTriangle& tri = triangles[ edge.triangle ];
+            tri.v[0] = edge.a;
+            tri.v[1] = edge.b;
+            tri.v[2] = i;
+            tri.n[0] = tri.n[1] = -1;
+            tri.n[2] = edge.neighbour;
+
+            if ( edge.neighbour >= 0 )
+            {
+                QwtTriangle& nt = triangles[ edge.neighbour ];
+                for ( int k = 0; k < 3; k++ )
+                {
+                    if ( nt.v[k] != edge.a && nt.v[k] != edge.b )
+                        nt.n[k] = edge.triangle;
+                }
+            }
+        }
+
+        for ( int j = 0; j < edges.size(); j++ )
+        {
+            const QwtCavityEdge& e1 = edges[j];
+            QwtTriangle& tri = triangles[ e1.triangle ];
+
+            for ( int k = 0; k < edges.size(); k++ )
+            {
+                const QwtCavityEdge& e2 = edges[k];
+
+                if ( e2.a == e1.b )
+                    tri.n[0] = e2.triangle;
+
+                if ( e2.b == e1.a )
+                    tri.n[1] = e2.triangle;
+            }
+        }
+
+        last = edges.last().triangle;
+    }
+
+    // removing the unused slots
+
+    if ( !freeSlots.isEmpty() )
+    {
+        QVector< int > indexes( triangles.size(), 0 );
+        for ( int i = 0; i < freeSlots.size(); i++ )
+            indexes[ freeSlots[i] ] = -1;
+
+        int count = 0;
+        for ( int i = 0; i < triangles.size(); i++ )
+        {
+            if ( indexes[i] == 0 )
+                indexes[i] = count++;
+        }
+
+        QVector< QwtTriangle > compacted;
+        compacted.reserve( count );
+
+        for ( int i = 0; i < triangles.size(); i++ )
+        {
+            if ( indexes[i] < 0 )
+                continue;
+
+            QwtTriangle tri = triangles[i];
+            for ( int k = 0; k < 3; k++ )
+            {
+                if ( tri.n[k] >= 0 )
+                    tri.n[k] = indexes[ tri.n[k] ];
+            }
+
+            compacted += tri;
+        }
+
+        triangles = compacted;
+    }
+
+    return triangles;
+}
+
+class QwtScatteredRasterData::PrivateData
+{
+  public:
+    PrivateData()
+        : resampleMode( QwtScatteredRasterData::NearestNeighbour )
+        , neighbourCount( 8 )
+        , power( 2.0 )
+        , x0( 0.0 )
+        , y0( 0.0 )
+        , sx( 1.0 )
+        , sy( 1.0 )
+        , numColumns( 0 )
+    {
+    }
+
+    inline int cell( double v ) const
+    {
+        const int c = static_cast< int >( v * numColumns );
+        return qBound( 0, c, numColumns - 1 );
+    }
+
+    inline int bucket( int col, int row ) const
+    {
+        // rows in alternating directions, for short walks
+        if ( row & 1 )
+            col = numColumns - 1 - col;
+
+        return row * numColumns + col;
+    }
+
+    inline QPointF normalized( double x, double y ) const
+    {
+        return QPointF( ( x - x0 ) * sx, ( y - y0 ) * sy );
+    }
+
+    int nearestNeighbours( const QPointF&, int count,
+        int* indexes, double* distances ) const;
+
+    int findTriangle( const QPointF&, int hint ) const;
+
+    QwtScatteredRasterData::ResampleMode resampleMode;
+    int neighbourCount;
+    double power;
+
+    QwtInterval intervals[3];
+
+    // mapping into the unit square
+    double x0, y0;
+    double sx, sy;
+
+    // buckets of numColumns x numColumns
+    int numColumns;
+    QVector< int > bucketStart;
+
+    // normalized positions and values, sorted by buckets
+    QVector< QPointF > points;
+    QVector< double > values;
+
+    // + the vertices of the enclosing triangle
+    QVector< QPointF > vertices;
+    QVector< QwtTriangle > triangles;
+    QVector< int > vertexTriangles;
+};
+
+int QwtScatteredRasterData::PrivateData::nearestNeighbours(
+    const QPointF& pos, int count, int* indexes, double* distances ) const
+{
+    const QPointF* pts = points.constData();
+
+    const int col = cell( pos.x() );
+    const int row = cell( pos.y() );
+    const double cellSize = 1.0 / numColumns;
+
+    int found = 0;
+
+    for ( int ring = 0; ring < numColumns; ring++ )
+    {
+        for ( int r = row - ring; r <= row + ring; r++ )
+        {
+            if ( r < 0 || r >= numColumns )
+                continue;
+
+            const bool isFullRow = qAbs( r - row ) == ring;
+            const int step = ( isFullRow || ring == 0 ) ? 1 : 2 * ring;
+
+            for ( int c = col - ring; c <= col + ring; c += step )
+            {
+                if ( c < 0 || c >= numColumns )
+                    continue;
+
+                const int b = bucket( c, r );
+                for ( int i = bucketStart[b]; i < bucketStart[b + 1]; i++ )
+                {
+                    const double dx = pts[i].x() - pos.x();
+                    const double dy = pts[i].y() - pos.y();
+                    const double d = dx * dx + dy * dy;
+
+                    if ( found == count && d >= distances[count - 1] )
+                        continue;
+
+                    // insertion sort
+
+                    int j = ( found < count ) ? found++ : count - 1;
+                    for ( ; j > 0 && distances[j - 1] > d; j-- )
+                    {
+                        distances[j] = distances[j - 1];
+                        indexes[j] = indexes[j - 1];
+                    }
+
+                    distances[j] = d;
+                    indexes[j] = i;
+                }
+            }
+        }
+
+        if ( found == count )
+        {
+            // all samples of the following rings are further away
+            const double d = ring * cellSize;
+            if ( distances[count - 1] <= d * d )
+                break;
+        }
+    }
+
+    return found;
+}
+
+int QwtScatteredRasterData::PrivateData::findTriangle(
+    const QPointF& pos, int hint ) const
+{
+    if ( hint < 0 || hint >= triangles.size() )
+    {
+        hint = 0;
+
+        const int b = bucket( cell( pos.x() ), cell( pos.y() ) );
+        if ( bucketStart[b] < bucketStart[b + 1] )
+            hint = vertexTriangles[ bucketStart[b] ];
+    }
+
+    return qwtWalk( vertices.constData(), triangles.constData(),
+        triangles.size(), hint, pos );
+}
+
+//! Constructor
+QwtScatteredRasterData::QwtScatteredRasterData()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtScatteredRasterData::~QwtScatteredRasterData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the samples
+
+   The samples are sorted into buckets and - for LinearInterpolation -
+   triangulated. The intervals are set to the bounding intervals
+   of the samples.
+
+   \param samples Positions and values
+   \sa sampleCount(), setInterval()
+ */
+void QwtScatteredRasterData::setSamples( const QVector< QwtPoint3D >& samples )
+{
+    PrivateData* d = m_data;
+
+    d->points.clear();
+    d->values.clear();
+    d->bucketStart.clear();
+    d->vertices.clear();
+    d->triangles.clear();
+    d->vertexTriangles.clear();
+    d->numColumns = 0;
+
+    for ( int i = 0; i < 3; i++ )
+        d->intervals[i] = QwtInterval();
+
+    if ( samples.isEmpty() )
+        return;
+
+    double minX, maxX, minY, maxY, minZ, maxZ;
+    minX = maxX = samples[0].x();
+    minY = maxY = samples[0].y();
+    minZ = maxZ = samples[0].z();
+
+    for ( int i = 1; i < samples.size(); i++ )
+    {
+        const QwtPoint3D& s = samples[i];
+
+        minX = qMin( minX, s.x() );
+        maxX = qMax( maxX, s.x() );
+        minY = qMin( minY, s.y() );
+        maxY = qMax( maxY, s.y() );
+        minZ = qMin( minZ, s.z() );
+        maxZ = qMax( maxZ, s.z() );
+    }
+
+    d->intervals[Qt::XAxis] = QwtInterval( minX, maxX );
+    d->intervals[Qt::YAxis] = QwtInterval( minY, maxY );
+    d->intervals[Qt::ZAxis] = QwtInterval( minZ, maxZ );
+
+    d->x0 = minX;
+    d->y0 = minY;
+    d->sx = ( maxX > minX ) ? 1.0 / ( maxX - minX ) : 1.0;
+    d->sy = ( maxY > minY ) ? 1.0 / ( maxY - minY ) : 1.0;
+
+    // sorting the samples into buckets
+
+    const int numSamples = samples.size();
+
+    d->numColumns = qMax( 1, int( std::sqrt( 0.5 * numSamples ) ) );
+
+    const int numBuckets = d->numColumns * d->numColumns;
+    d->bucketStart.fill( 0, numBuckets + 1 );
+
+    QVector< int > buckets( numSamples );
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        const QPointF p = d->normalized( samples[i].x(), samples[i].y() );
+
+        buckets[i] = d->bucket( d->cell( p.x() ), d->cell( p.y() ) );
+        d->bucketStart[ buckets[i] + 1 ]++;
+    }
+
+    for ( int i = 0; i < numBuckets; i++ )
+        d->bucketStart[i + 1] += d->bucketStart[i];
+
+    QVector< int > pos = d->bucketStart;
+
+    d->points.resize( numSamples );
+    d->values.resize( numSamples );
+
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        const int index = pos[ buckets[i] ]++;
+
+        d->points[index] = d->normalized( samples[i].x(), samples[i].y() );
+        d->values[index] = samples[i].z();
+    }
+
+    updateTriangulation();
+}
+
+//! \return Number of samples
+int QwtScatteredRasterData::sampleCount() const
+{
+    return m_data->points.size();
+}
+
+/*!
+   \brief Set the interpolation algorithm
+
+   \param mode Resampling mode
+   \sa resampleMode()
+ */
+void QwtScatteredRasterData::setResampleMode( ResampleMode mode )
+{
+    if ( mode != m_data->resampleMode )
+    {
+        m_data->resampleMode = mode;
+        updateTriangulation();
+    }
+}
+
+/*!
+   \return Interpolation algorithm
+   \sa setResampleMode()
+ */
+QwtScatteredRasterData::ResampleMode QwtScatteredRasterData::resampleMode() const
+{
+    return m_data->resampleMode;
+}
+
+/*!
+   \brief Set the number of samples for InverseDistanceWeighting
+
+   \param count Number of the closest samples, that are
+                taken into account. The default setting is 8.
+
+   \sa neighbourCount(), setPower()
+ */
+void QwtScatteredRasterData::setNeighbourCount( int count )
+{
+    m_data->neighbourCount = qBound( 1, count, qwtMaxNeighbours );
+}
+
+/*!
+   \return Number of samples for InverseDistanceWeighting
+   \sa setNeighbourCount()
+ */
+int QwtScatteredRasterData::neighbourCount() const
+{
+    return m_data->neighbourCount;
+}
+
+/*!
+   \brief Set the power of the distances for InverseDistanceWeighting
+
+   \param power Power, the default setting is 2.0
+   \sa power(), setNeighbourCount()
+ */
+void QwtScatteredRasterData::setPower( double power )
+{
+    m_data->power = qMax( power, 0.0 );
+}
+
+/*!
+   \return Power of the distances for InverseDistanceWeighting
+   \sa setPower()
+ */
+double QwtScatteredRasterData::power() const
+{
+    return m_data->power;
+}
+
+/*!
+   \return Number of triangles of the triangulation
+   \note The triangulation is calculated for LinearInterpolation only
+ */
+int QwtScatteredRasterData::triangleCount() const
+{
+    const int numSamples = m_data->points.size();
+
+    int count = 0;
+    for ( int i = 0; i < m_data->triangles.size(); i++ )
+    {
+        const QwtTriangle& t = m_data->triangles[i];
+        if ( t.v[0] < numSamples && t.v[1] < numSamples && t.v[2] < numSamples )
+            count++;
+    }
+
+    return count;
+}
+
+/*!
+   \brief Assign the bounding interval for an axis
+
+   The intervals are initialized from the samples by setSamples().
+   Often the interval in Z direction is adjusted to the possible
+   range of the values.
+
+   \param axis X, Y or Z axis
+   \param interval Interval
+
+   \sa interval(), setSamples()
+ */
+void QwtScatteredRasterData::setInterval(
+    Qt::Axis axis, const QwtInterval& interval )
+{
+    if ( axis >= 0 && axis <= 2 )
+        m_data->intervals[axis] = interval;
+}
+
+/*!
+   \return Bounding interval for an axis
+   \sa setInterval()
+ */
+QwtInterval QwtScatteredRasterData::interval( Qt::Axis axis ) const
+{
+    if ( axis >= 0 && axis <= 2 )
+        return m_data->intervals[ axis ];
+
+    return QwtInterval();
+}
+
+/*!
+   \return the value at a raster position
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+
+   \sa ResampleMode
+ */
+double QwtScatteredRasterData::value( double x, double y ) const
+{
+    return value( x, y, NULL );
+}
+
+/*!
+   \brief Value at a raster position
+
+   For LinearInterpolation the triangle of the position is found
+   by walking from the triangle, that has been found for the previous
+   position. As the triangle is not stored in the raster data,
+   values can be requested from different threads in parallel.
+
+   \param x X value in plot coordinates
+   \param y Y value in plot coordinates
+   \param triangle In: triangle, where to start the walk, or -1.
+                   Out: triangle of the position. Might be NULL.
+
+   \return Interpolated value
+   \sa ResampleMode, createRenderContext()
+ */
+double QwtScatteredRasterData::value( double x, double y, int* triangle ) const
+{
+    const PrivateData* d = m_data;
+
+    if ( d->points.isEmpty() )
+        return qQNaN();
+
+    const QPointF pos = d->normalized( x, y );
+
+    switch( d->resampleMode )
+    {
+        case LinearInterpolation:
+        {
+            const int t = d->findTriangle( pos, triangle ? *triangle : -1 );
+            if ( t < 0 )
+                return qQNaN();
+
+            if ( triangle )
+                *triangle = t;
+
+            const int numSamples = d->points.size();
+
+            const QwtTriangle& tri = d->triangles[t];
+            if ( tri.v[0] >= numSamples || tri.v[1] >= numSamples
+                || tri.v[2] >= numSamples )
+            {
+                // outside of the convex hull
+                return qQNaN();
+            }
+
+            const QPointF& a = d->vertices[ tri.v[0] ];
+            const QPointF& b = d->vertices[ tri.v[1] ];
+            const QPointF& c = d->vertices[ tri.v[2] ];
+
+            const double area = qwtOrient( a, b, c );
+
+            const double wa = qwtOrient( b, c, pos ) / area;
+            const double wb = qwtOrient( c, a, pos ) / area;
+            const double wc = 1.0 - wa - wb;
+
+            return wa * d->values[ tri.v[0] ] + wb * d->values[ tri.v[1] ]
+                + wc * d->values[ tri.v[2] ];
+        }
+        case InverseDistanceWeighting:
+        {
+            int indexes[qwtMaxNeighbours];
+            double distances[qwtMaxNeighbours];
+
+            const int count = d->nearestNeighbours(
+                pos, d->neighbourCount, indexes, distances );
+
+            if ( distances[0] == 0.0 )
+                return d->values[ indexes[0] ];
+
+            double sum = 0.0;
+            double weights = 0.0;
+
+            for ( int i = 0; i < count; i++ )
+            {
+                const double w = ( d->power == 2.0 ) ? 1.0 / distances[i]
+                    : std::pow( distances[i], -0.5 * d->power );
+
+                sum += w * d->values[ indexes[i] ];
+                weights += w;
+            }
+
+            return sum / weights;
+        }
+        case NearestNeighbour:
+        default:
+        {
+            int index;
+            double distance;
+
+            d->nearestNeighbours( pos, 1, &index, &distance );
+            return d->values[index];
+        }
+    }
+}
+
+/*!
+   \brief Values of a row
+
+   The same as value(), but for LinearInterpolation each walk
+   starts at the triangle of the previous position.
+
+   \param y Y value in plot coordinates
+   \param x Array of x values in plot coordinates
+   \param numValues Number of values
+   \param values Array, where to store numValues results
+ */
+void QwtScatteredRasterData::values( double y, const double* x,
+    int numValues, double* values ) const
+{
+    int triangle = -1;
+
+    for ( int i = 0; i < numValues; i++ )
+        values[i] = value( x[i], y, &triangle );
+}
+
+/*!
+   \brief Create a context for requesting the values of an area
+
+   The context remembers the triangle of the last position,
+   so that the following walk is short.
+
+   \param area Area, that will be requested by the context
+   \param raster Number of horizontal and vertical pixels of the area
+
+   \return Render context, to be deleted by the caller
+ */
+QwtRasterData::RenderContext* QwtScatteredRasterData::createRenderContext(
+    const QRectF& area, const QSize& raster ) const
+{
+    return new QwtScatteredRenderContext( this, area, raster );
+}
+
+void QwtScatteredRasterData::updateTriangulation()
+{
+    PrivateData* d = m_data;
+
+    if ( d->resampleMode != LinearInterpolation
+        || d->points.isEmpty() || !d->triangles.isEmpty() )
+    {
+        return;
+    }
+
+    d->vertices = d->points;
+
+    // a triangle enclosing the unit square
+    d->vertices += QPointF( -10.0, -10.0 );
+    d->vertices += QPointF( 30.0, -10.0 );
+    d->vertices += QPointF( -10.0, 30.0 );
+
+    d->triangles = qwtDelaunayTriangles( d->vertices );
+
+    d->vertexTriangles.fill( 0, d->vertices.size() );
+    for ( int i = 0; i < d->triangles.size(); i++ )
+    {
+        const QwtTriangle& t = d->triangles[i];
+        for ( int k = 0; k < 3; k++ )
+            d->vertexTriangles[ t.v[k] ] = i;
+    }
+}
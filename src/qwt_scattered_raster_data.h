@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SCATTERED_RASTER_DATA_H
+#define QWT_SCATTERED_RASTER_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_raster_data.h"
+
+class QwtPoint3D;
+
+#if QT_VERSION < 0x060000
+template< typename T > class QVector;
+#endif
+
+/*!
+   \brief Raster data, that is interpolated from irregular samples
+
+   QwtScatteredRasterData calculates the values of a raster from
+   samples at arbitrary positions - f.e. measurements of weather
+   stations - so that they can be displayed by a QwtPlotSpectrogram.
+
+   To avoid searching all samples for each pixel, the samples are sorted
+   into a grid of buckets with ~2 samples per bucket. For
+   LinearInterpolation a Delaunay triangulation is calculated once,
+   when the samples are assigned. The triangle of a pixel is found by
+   walking from the triangle of the previous pixel, what is
+   stored in the RenderContext of the tile, that is rendered by a thread.
+   All other structures are shared read-only by the threads.
+
+   Distances are calculated after scaling the bounding rectangle
+   of the samples to a unit square, so that the units of the
+   x and y coordinates don't matter.
+
+   \sa QwtMatrixRasterData, QwtPlotSpectrogram
+ */
+class QWT_EXPORT QwtScatteredRasterData : public QwtRasterData
+{
+  public:
+    /*!
+       \brief Interpolation algorithm
+       The default setting is NearestNeighbour
+     */
+    enum ResampleMode
+    {
+        //! Value of the sample, that is closest to the position
+        NearestNeighbour,
+
+        /*!
+           Mean of the values of the closest samples ( see setNeighbourCount() ),
+           weighted by the inverse of their distance powered by power()
+         */
+        InverseDistanceWeighting,
+
+        /*!
+           Linear interpolation inside the triangle of the Delaunay
+           triangulation, that contains the position. Positions outside
+           of the convex hull of the samples are NaN.
+         */
+        LinearInterpolation
+    };
+
+    QwtScatteredRasterData();
+    virtual ~QwtScatteredRasterData();
+
+    void setSamples( const QVector< QwtPoint3D >& );
+    int sampleCount() const;
+
+    void setResampleMode( ResampleMode );
+    ResampleMode resampleMode() const;
+
+    void setNeighbourCount( int );
+    int neighbourCount() const;
+
+    void setPower( double );
+    double power() const;
+
+    int triangleCount() const;
+
+    void setInterval( Qt::Axis, const QwtInterval& );
+    virtual QwtInterval interval( Qt::Axis ) const QWT_OVERRIDE QWT_FINAL;
+
+    virtual double value( double x, double y ) const QWT_OVERRIDE;
+    double value( double x, double y, int* triangle ) const;
+
+    virtual void values( double y, const double* x,
+        int numValues, double* values ) const QWT_OVERRIDE;
+
+    virtual RenderContext* createRenderContext(
+        const QRectF&, const QSize& ) const QWT_OVERRIDE;
+
+  private:
+    void updateTriangulation();
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
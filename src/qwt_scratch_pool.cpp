@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_scratch_pool.h"
+
+#include <qpolygon.h>
+#include <qvector.h>
+#include <qthreadstorage.h>
+
+namespace
+{
+    template< class Polygon >
+    class QwtPolygonPool
+    {
+      public:
+        void acquire( Polygon& polygon, int size )
+        {
+            if ( !m_buffers.isEmpty() )
+            {
+                polygon.swap( m_buffers.last() );
+                m_buffers.removeLast();
+            }
+            else
+            {
+                polygon = Polygon();
+            }
+
+            polygon.resize( size );
+        }
+
+        void release( Polygon& polygon )
+        {
+            // shared buffers would detach, when being modified
+
+            if ( polygon.capacity() > 0 && polygon.isDetached()
+                && m_buffers.size() < MaxBuffers )
+            {
+                m_buffers.append( Polygon() );
+                m_buffers.last().swap( polygon );
+            }
+            else
+            {
+                polygon = Polygon();
+            }
+        }
+
+        void trim()
+        {
+            // buffers, that are not needed for the next replot
+
+            int bytes = 0;
+
+            for ( int i = 0; i < m_buffers.size(); i++ )
+            {
+                const int n = m_buffers[i].capacity() *
+                    int( sizeof( typename Polygon::value_type ) );
+
+                if ( bytes + n > MaxBytes )
+                {
+                    m_buffers.resize( i );
+                    break;
+                }
+
+                bytes += n;
+            }
+        }
+
+      private:
+        enum { MaxBuffers = 16 };
+        enum { MaxBytes = 64 * 1024 * 1024 };
+
+        QVector< Polygon > m_buffers;
+    };
+
+    class QwtScratchPoolData
+    {
+      public:
+        QwtPolygonPool< QPolygonF > polygonsF;
+        QwtPolygonPool< QPolygon > polygons;
+    };
+}
+
+static QThreadStorage< QwtScratchPoolData* > qwtScratchPools;
+
+static inline QwtScratchPoolData* qwtScratchPool()
+{
+    if ( !qwtScratchPools.hasLocalData() )
+        qwtScratchPools.setLocalData( new QwtScratchPoolData() );
+
+    return qwtScratchPools.localData();
+}
+
+/*!
+   \brief Acquire a polygon from the pool
+
+   \param polygon Polygon, that is replaced by a buffer of the pool
+   \param size Number of points of the acquired polygon
+
+   \note The values of the points are undefined
+   \sa release()
+ */
+void QwtScratchPool::acquire( QPolygonF& polygon, int size )
+{
+    qwtScratchPool()->polygonsF.acquire( polygon, size );
+}
+
+/*!
+   \brief Acquire a polygon from the pool
+
+   \param polygon Polygon, that is replaced by a buffer of the pool
+   \param size Number of points of the acquired polygon
+
+   \note The values of the points are undefined
+   \sa release()
+ */
+void QwtScratchPool::acquire( QPolygon& polygon, int size )
+{
+    qwtScratchPool()->polygons.acquire( polygon, size );
+}
+
+/*!
+   \brief Return the buffer of a polygon to the pool
+
+   The polygon is empty afterwards. Polygons sharing their buffer
+   with other polygons are not added to the pool.
+
+   \param polygon Polygon
+   \sa acquire()
+ */
+void QwtScratchPool::release( QPolygonF& polygon )
+{
+    qwtScratchPool()->polygonsF.release( polygon );
+}
+
+/*!
+   \brief Return the buffer of a polygon to the pool
+
+   The polygon is empty afterwards. Polygons sharing their buffer
+   with other polygons are not added to the pool.
+
+   \param polygon Polygon
+   \sa acquire()
+ */
+void QwtScratchPool::release( QPolygon& polygon )
+{
+    qwtScratchPool()->polygons.release( polygon );
+}
+
+/*!
+   \brief Limit the memory kept by the pool of the calling thread
+
+   \sa QwtPlot::drawItems()
+ */
+void QwtScratchPool::trim()
+{
+    if ( qwtScratchPools.hasLocalData() )
+    {
+        QwtScratchPoolData* pool = qwtScratchPools.localData();
+
+        pool->polygonsF.trim();
+        pool->polygons.trim();
+    }
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SCRATCH_POOL_H
+#define QWT_SCRATCH_POOL_H
+
+#include "qwt_global.h"
+
+class QPolygon;
+class QPolygonF;
+
+/*!
+   \brief A thread local pool of scratch buffers for polygons
+
+   Each replot allocates temporary polygons for mapping, clipping
+   and filling the plot items. Polygons acquired from the pool reuse the
+   memory of polygons, that have been released before, so that
+   no memory has to be allocated for them as long as their size
+   doesn't exceed the capacity of the reused buffer.
+
+   QwtPlot::drawItems() trims the pool of the calling thread after
+   all items have been painted.
+
+   \code
+    QPolygonF polygon;
+    QwtScratchPool::acquire( polygon, numPoints );
+
+    ...
+
+    QwtScratchPool::release( polygon );
+   \endcode
+ */
+namespace QwtScratchPool
+{
+    QWT_EXPORT void acquire( QPolygonF&, int size );
+    QWT_EXPORT void acquire( QPolygon&, int size );
+
+    QWT_EXPORT void release( QPolygonF& );
+    QWT_EXPORT void release( QPolygon& );
+
+    QWT_EXPORT void trim();
+}
+
+#endif
@@ -9,9 +9,20 @@
 
 #include "qwt_series_data.h"
 #include "qwt_point_polar.h"
+#include "qwt_series_data_pyramid.h"
+
+#include <qnumeric.h>
+
+static inline bool qwtIsGap( const QPointF& sample )
+{
+    return qIsNaN( sample.x() ) || qIsNaN( sample.y() );
+}
 
 static inline QRectF qwtBoundingRect( const QPointF& sample )
 {
+    if ( qwtIsGap( sample ) )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
     return QRectF( sample.x(), sample.y(), 0.0, 0.0 );
 }
 
@@ -95,27 +106,36 @@ QRectF qwtBoundingRectT( const QwtSeriesData< T >& series, int from, int to )
     if ( to < from )
         return boundingRect;
 
-    int i;
-    for ( i = from; i <= to; i++ )
-    {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
-        if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
-        {
-            boundingRect = rect;
-            i++;
-            break;
-        }
-    }
+    // fetching the samples in chunks avoids a virtual call for each sample
 
-    for ( ; i <= to; i++ )
+    const int chunkSize = 256;
+    T samples[chunkSize];
+
+    bool isValid = false;
+
+    for ( int i = from; i <= to; i += chunkSize )
     {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
-        if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
+        const int n = qMin( chunkSize, to - i + 1 );
+        series.fetch( i, n, samples );
+
+        for ( int j = 0; j < n; j++ )
         {
-            boundingRect.setLeft( qMin( boundingRect.left(), rect.left() ) );
-            boundingRect.setRight( qMax( boundingRect.right(), rect.right() ) );
-            boundingRect.setTop( qMin( boundingRect.top(), rect.top() ) );
-            boundingRect.setBottom( qMax( boundingRect.bottom(), rect.bottom() ) );
+            const QRectF rect = qwtBoundingRect( samples[j] );
+            if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
+            {
+                if ( isValid )
+                {
+                    boundingRect.setLeft( qMin( boundingRect.left(), rect.left() ) );
+                    boundingRect.setRight( qMax( boundingRect.right(), rect.right() ) );
+                    boundingRect.setTop( qMin( boundingRect.top(), rect.top() ) );
+                    boundingRect.setBottom( qMax( boundingRect.bottom(), rect.bottom() ) );
+                }
+                else
+                {
+                    boundingRect = rect;
+                    isValid = true;
+                }
+            }
         }
     }
 
@@ -138,6 +158,65 @@ QRectF qwtBoundingRect( const QwtSeriesData< QPointF >& series, int from, int to
     return qwtBoundingRectT< QPointF >( series, from, to );
 }
 
+template< bool gap >
+static int qwtFindSample( const QwtSeriesData< QPointF >& series, int from, int to )
+{
+    const int chunkSize = 256;
+    QPointF samples[chunkSize];
+
+    for ( int i = from; i <= to; i += chunkSize )
+    {
+        const int n = qMin( chunkSize, to - i + 1 );
+        series.fetch( i, n, samples );
+
+        for ( int j = 0; j < n; j++ )
+        {
+            if ( qwtIsGap( samples[j] ) == gap )
+                return i + j;
+        }
+    }
+
+    return to + 1;
+}
+
+/*!
+   rief Find the next gap of a series
+
+   A gap is a sample with a NaN coordinate, where a curve is interrupted.
+
+   \param series Series
+   \param from Index of the first sample to be checked
+   \param to Index of the last sample to be checked
+
+   
+eturn Index of the first gap in [from, to], or to + 1,
+           when there is no gap.
+
+   \sa qwtSkipGaps(), QwtPlotCurve::BreakAtGaps
+ */
+int qwtFindGap( const QwtSeriesData< QPointF >& series, int from, int to )
+{
+    return qwtFindSample< true >( series, from, to );
+}
+
+/*!
+   rief Skip the gaps of a series
+
+   \param series Series
+   \param from Index of the first sample to be checked
+   \param to Index of the last sample to be checked
+
+   
+eturn Index of the first sample in [from, to], that is not a gap,
+           or to + 1, when there is no such sample.
+
+   \sa qwtFindGap(), QwtPlotCurve::BreakAtGaps
+ */
+int qwtSkipGaps( const QwtSeriesData< QPointF >& series, int from, int to )
+{
+    return qwtFindSample< false >( series, from, to );
+}
+
 /*!
    \brief Calculate the bounding rectangle of a series subset
 
@@ -242,3 +321,120 @@ QRectF qwtBoundingRect(
 {
     return qwtBoundingRectT< QwtVectorFieldSample >( series, from, to );
 }
+
+//! Constructor, initializing statistics without samples
+QwtSeriesStatistics::QwtSeriesStatistics()
+    : count( 0 )
+    , minY( 0.0 )
+    , maxY( 0.0 )
+    , sumY( 0.0 )
+{
+}
+
+//! \return True, when at least one sample has been counted
+bool QwtSeriesStatistics::isValid() const
+{
+    return count > 0;
+}
+
+//! \return Mean of the y coordinates, or 0.0 without samples
+double QwtSeriesStatistics::mean() const
+{
+    return ( count > 0 ) ? sumY / count : 0.0;
+}
+
+//! \return Interval [ minY, maxY ], or an invalid interval without samples
+QwtInterval QwtSeriesStatistics::yInterval() const
+{
+    if ( count <= 0 )
+        return QwtInterval();
+
+    return QwtInterval( minY, maxY );
+}
+
+namespace
+{
+    class QwtXPosition
+    {
+      public:
+        inline double operator()( const QPointF& sample ) const
+        {
+            return sample.x();
+        }
+    };
+}
+
+/*!
+   \brief Calculate the statistics of the samples inside an x interval
+
+   For a QwtSeriesDataPyramid the statistics are answered from the
+   index in O(log n). Otherwise the samples are iterated - for a series
+   with increasing x coordinates ( QwtSeriesData::isMonotonic() )
+   only those inside the interval.
+
+   \param series Series
+   \param xFrom Lower limit of the x interval
+   \param xTo Upper limit of the x interval
+
+   \return Statistics of the y coordinates of all samples with
+           x coordinates in [xFrom, xTo]. Gaps are ignored.
+
+   \sa QwtSeriesDataPyramid::statistics(), QwtPlot::FitVisible
+ */
+QwtSeriesStatistics qwtSeriesStatistics(
+    const QwtSeriesData< QPointF >& series, double xFrom, double xTo )
+{
+    const QwtSeriesDataPyramid* pyramid =
+        dynamic_cast< const QwtSeriesDataPyramid* >( &series );
+
+    if ( pyramid )
+        return pyramid->statistics( xFrom, xTo );
+
+    if ( xFrom > xTo )
+        qSwap( xFrom, xTo );
+
+    QwtSeriesStatistics statistics;
+
+    int from = 0;
+    int to = int( series.size() ) - 1;
+
+    if ( to < 0 )
+        return statistics;
+
+    if ( series.isMonotonic() )
+        qwtClipSampleRange( series, xFrom, xTo, QwtXPosition(), from, to );
+
+    const int chunkSize = 256;
+    QPointF samples[chunkSize];
+
+    for ( int i = from; i <= to; i += chunkSize )
+    {
+        const int n = qMin( chunkSize, to - i + 1 );
+        series.fetch( i, n, samples );
+
+        for ( int j = 0; j < n; j++ )
+        {
+            const QPointF& sample = samples[j];
+
+            if ( qwtIsGap( sample ) || sample.x() < xFrom || sample.x() > xTo )
+                continue;
+
+            const double y = sample.y();
+
+            if ( statistics.count == 0 )
+            {
+                statistics.minY = statistics.maxY = y;
+            }
+            else
+            {
+                statistics.minY = qMin( statistics.minY, y );
+                statistics.maxY = qMax( statistics.maxY, y );
+            }
+
+            statistics.sumY += y;
+            statistics.count++;
+        }
+    }
+
+    return statistics;
+}
@@ -106,6 +106,10 @@ class QwtSeriesData
      */
     virtual void setRectOfInterest( const QRectF& rect );
 
+    virtual void fetch( size_t from, size_t numSamples, T* samples ) const;
+
+    virtual bool isMonotonic() const;
+
   protected:
     //! Can be used to cache a calculated bounding rectangle
     mutable QRectF cachedBoundingRect;
@@ -130,6 +134,50 @@ void QwtSeriesData< T >::setRectOfInterest( const QRectF& )
 {
 }
 
+/*!
+   \brief Copy a range of samples
+
+   Instead of calling the virtual sample() for each sample, algorithms
+   iterating over many samples can fetch them in blocks. Implementations,
+   that have direct access to their samples, should overload fetch()
+   with an implementation avoiding the virtual call for each sample.
+
+   The default implementation calls sample() for each sample.
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array of at least numSamples samples, where
+                  the samples will be written to
+
+   \note from + numSamples must not exceed size()
+ */
+template< typename T >
+void QwtSeriesData< T >::fetch(
+    size_t from, size_t numSamples, T* samples ) const
+{
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = sample( from + i );
+}
+
+/*!
+   \brief Order of the samples
+
+   A series, that knows that its samples are sorted in increasing
+   order of their positions ( f.e. the x coordinates of QPointF )
+   can indicate it, so that a binary search can be used to find the
+   samples inside of an interval.
+
+   The default implementation returns false.
+
+   \return True, when the samples are sorted in increasing order
+   \sa QwtPlotSeriesItem::OrderedSamples, qwtClipSampleRange()
+ */
+template< typename T >
+bool QwtSeriesData< T >::isMonotonic() const
+{
+    return false;
+}
+
 /*!
    \brief Template class for data, that is organized as QVector
 
@@ -169,6 +217,9 @@ class QwtArraySeriesData : public QwtSeriesData< T >
      */
     virtual T sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual void fetch( size_t from,
+        size_t numSamples, T* samples ) const QWT_OVERRIDE;
+
   protected:
     //! Vector of samples
     QVector< T > m_samples;
@@ -210,6 +261,23 @@ T QwtArraySeriesData< T >::sample( size_t i ) const
     return m_samples[ static_cast< int >( i ) ];
 }
 
+/*!
+   Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+template< typename T >
+void QwtArraySeriesData< T >::fetch(
+    size_t from, size_t numSamples, T* samples ) const
+{
+    const T* values = m_samples.constData() + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+        samples[i] = values[i];
+}
+
 //! Interface for iterating over an array of points
 typedef QwtArraySeriesData< QPointF > QwtPointSeriesData;
 
@@ -249,6 +317,43 @@ QWT_EXPORT QRectF qwtBoundingRect(
 QWT_EXPORT QRectF qwtBoundingRect(
     const QwtSeriesData< QwtVectorFieldSample >&, int from = 0, int to = -1 );
 
+QWT_EXPORT int qwtFindGap(
+    const QwtSeriesData< QPointF >&, int from, int to );
+
+QWT_EXPORT int qwtSkipGaps(
+    const QwtSeriesData< QPointF >&, int from, int to );
+
+/*!
+   \brief Statistics of the y coordinates of a range of samples
+
+   \sa qwtSeriesStatistics(), QwtSeriesDataPyramid::statistics()
+ */
+class QWT_EXPORT QwtSeriesStatistics
+{
+  public:
+    QwtSeriesStatistics();
+
+    bool isValid() const;
+
+    double mean() const;
+    QwtInterval yInterval() const;
+
+    //! Number of samples, gaps are not counted
+    int count;
+
+    //! Minimum of the y coordinates
+    double minY;
+
+    //! Maximum of the y coordinates
+    double maxY;
+
+    //! Sum of the y coordinates
+    double sumY;
+};
+
+QWT_EXPORT QwtSeriesStatistics qwtSeriesStatistics(
+    const QwtSeriesData< QPointF >&, double xFrom, double xTo );
+
 /*!
     Binary search for a sorted series of samples
 
@@ -335,4 +440,73 @@ inline int qwtUpperSampleIndex( const QwtSeriesData< T >& series,
     return indexMin;
 }
 
+/*!
+   \brief Find the samples of a sorted series, that are inside an interval
+
+   The index range [from, to] is reduced to the samples with positions
+   inside [minValue, maxValue] - plus one sample on each side, that is
+   needed for line segments crossing the borders of the interval.
+
+   \param series Series of samples
+   \param minValue Lower limit of the interval
+   \param maxValue Upper limit of the interval
+   \param positionOf Function object returning the position of a sample
+   \param from Index of the first sample, will be modified
+   \param to Index of the last sample, will be modified
+
+   \note The samples must be sorted in increasing order of their positions.
+         The number of calls of QwtSeriesData::sample() is logarithmic.
+
+   \sa qwtUpperSampleIndex(), QwtPlotSeriesItem::OrderedSamples
+ */
+template< typename T, typename PositionOf >
+inline void qwtClipSampleRange( const QwtSeriesData< T >& series,
+    double minValue, double maxValue, PositionOf positionOf, int& from, int& to )
+{
+    // the first sample with a position >= minValue
+
+    int lower = from;
+    int n = to - from + 1;
+
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int indexMid = lower + half;
+
+        if ( positionOf( series.sample( indexMid ) ) < minValue )
+        {
+            lower = indexMid + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    // the first sample with a position > maxValue
+
+    int upper = lower;
+    n = to - lower + 1;
+
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int indexMid = upper + half;
+
+        if ( positionOf( series.sample( indexMid ) ) > maxValue )
+        {
+            n = half;
+        }
+        else
+        {
+            upper = indexMid + 1;
+            n -= half + 1;
+        }
+    }
+
+    from = qMax( lower - 1, from );
+    to = qMin( upper, to );
+}
+
 #endif
@@ -0,0 +1,686 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_series_data_pyramid.h"
+#include "qwt_scale_map.h"
+#include "qwt_uniform_series_data.h"
+
+#include <qpolygon.h>
+#include <qnumeric.h>
+#include <cmath>
+
+namespace
+{
+    // number of samples, that are summarized by a node of the lowest level
+    const int qwtBlockSize = 32;
+
+    class QwtPyramidNode
+    {
+      public:
+        inline void init( int index, double y )
+        {
+            minIndex = maxIndex = index;
+            minY = maxY = y;
+
+            // gaps are not counted
+            valid = !qIsNaN( y );
+
+            count = valid ? 1 : 0;
+            sumY = valid ? y : 0.0;
+        }
+
+        inline void add( int index, double y )
+        {
+            if ( qIsNaN( y ) )
+                return;
+
+            sumY += y;
+            count++;
+
+            if ( !valid )
+            {
+                minIndex = maxIndex = index;
+                minY = maxY = y;
+                valid = true;
+
+                return;
+            }
+
+            if ( y < minY )
+            {
+                minY = y;
+                minIndex = index;
+            }
+
+            if ( y > maxY )
+            {
+                maxY = y;
+                maxIndex = index;
+            }
+        }
+
+        inline void add( const QwtPyramidNode& other )
+        {
+            if ( !other.valid )
+                return;
+
+            sumY += other.sumY;
+            count += other.count;
+
+            if ( !valid )
+            {
+                minY = other.minY;
+                maxY = other.maxY;
+                minIndex = other.minIndex;
+                maxIndex = other.maxIndex;
+                valid = true;
+
+                return;
+            }
+
+            if ( other.minY < minY )
+            {
+                minY = other.minY;
+                minIndex = other.minIndex;
+            }
+
+            if ( other.maxY > maxY )
+            {
+                maxY = other.maxY;
+                maxIndex = other.maxIndex;
+            }
+        }
+
+        double minY;
+        double maxY;
+        double sumY;
+
+        int minIndex;
+        int maxIndex;
+        int count;
+
+        // false, when all samples are gaps
+        bool valid;
+    };
+}
+
+class QwtSeriesDataPyramid::PrivateData
+{
+  public:
+    PrivateData()
+        : series( NULL )
+        , uniform( NULL )
+        , isDirty( true )
+        , isMonotonic( false )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete series;
+    }
+
+    void scan( int from, int to, bool& valid, QwtPyramidNode& node ) const
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            const double y = series->sample( i ).y();
+
+            if ( valid )
+            {
+                node.add( i, y );
+            }
+            else
+            {
+                node.init( i, y );
+                valid = true;
+            }
+        }
+    }
+
+    int upperIndex( double value, int from, int to ) const
+    {
+        // index of the first sample in [from, to] with x >= value,
+        // to + 1, when there is none
+
+        if ( uniform && uniform->isMonotonic() )
+            return qBound( from, uniform->lowerIndex( value ), to + 1 );
+
+        int n = to - from + 1;
+        int index = from;
+
+        while ( n > 0 )
+        {
+            const int half = n >> 1;
+            const int indexMid = index + half;
+
+            if ( series->sample( indexMid ).x() < value )
+            {
+                index = indexMid + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+
+        return index;
+    }
+
+    int lastIndex( double value, int from, int to ) const
+    {
+        // index of the last sample in [from, to] with x <= value,
+        // from - 1, when there is none
+
+        if ( uniform && uniform->isMonotonic() )
+        {
+            int index = uniform->lowerIndex( value );
+            if ( index >= int( uniform->size() ) || uniform->xValue( index ) > value )
+                index--;
+
+            return qBound( from - 1, index, to );
+        }
+
+        int n = to - from + 1;
+        int index = from;
+
+        while ( n > 0 )
+        {
+            const int half = n >> 1;
+            const int indexMid = index + half;
+
+            if ( series->sample( indexMid ).x() <= value )
+            {
+                index = indexMid + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+
+        return index - 1;
+    }
+
+    bool query( int from, int to, QwtPyramidNode& node ) const
+    {
+        if ( from > to )
+            return false;
+
+        bool valid = false;
+
+        int b0 = ( from + qwtBlockSize - 1 ) / qwtBlockSize; // first complete block
+        int b1 = ( to + 1 ) / qwtBlockSize; // behind the last complete block
+
+        if ( b0 >= b1 )
+        {
+            scan( from, to, valid, node );
+        }
+        else
+        {
+            scan( from, b0 * qwtBlockSize - 1, valid, node );
+            scan( b1 * qwtBlockSize, to, valid, node );
+
+            for ( int level = 0; b0 < b1; level++ )
+            {
+                const QwtPyramidNode* nodes = levels[level].constData();
+
+                if ( b0 & 1 )
+                {
+                    if ( valid )
+                        node.add( nodes[b0] );
+                    else
+                        node = nodes[b0];
+
+                    valid = true;
+                    b0++;
+                }
+
+                if ( b1 & 1 )
+                {
+                    b1--;
+
+                    if ( valid )
+                        node.add( nodes[b1] );
+                    else
+                        node = nodes[b1];
+
+                    valid = true;
+                }
+
+                b0 >>= 1;
+                b1 >>= 1;
+            }
+        }
+
+        return valid;
+    }
+
+    void setSeries( QwtSeriesData< QPointF >* s )
+    {
+        series = s;
+
+        // equidistant samples are found arithmetically
+        uniform = dynamic_cast< const QwtAbstractUniformData* >( s );
+    }
+
+    QwtSeriesData< QPointF >* series;
+    const QwtAbstractUniformData* uniform;
+
+    bool isDirty;
+    bool isMonotonic;
+    QRectF boundingRect;
+
+    QVector< QVector< QwtPyramidNode > > levels;
+};
+
+/*!
+   \brief Constructor
+
+   \param series Series to be indexed
+   \warning The pyramid takes ownership of the series
+ */
+QwtSeriesDataPyramid::QwtSeriesDataPyramid( QwtSeriesData< QPointF >* series )
+{
+    m_data = new PrivateData();
+    m_data->setSeries( series );
+}
+
+//! Destructor
+QwtSeriesDataPyramid::~QwtSeriesDataPyramid()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the series to be indexed
+
+   \param series Series
+   \warning The pyramid takes ownership of the series,
+            the previous series will be deleted.
+   \sa series(), invalidate()
+ */
+void QwtSeriesDataPyramid::setSeries( QwtSeriesData< QPointF >* series )
+{
+    if ( series != m_data->series )
+    {
+        delete m_data->series;
+        m_data->setSeries( series );
+    }
+
+    invalidate();
+}
+
+/*!
+   \return Series being indexed
+   \sa setSeries()
+ */
+const QwtSeriesData< QPointF >* QwtSeriesDataPyramid::series() const
+{
+    return m_data->series;
+}
+
+/*!
+   \brief Invalidate the index
+
+   invalidate() has to be called, whenever the samples of the
+   wrapped series have been modified. The index will be rebuilt,
+   when it is needed the next time.
+ */
+void QwtSeriesDataPyramid::invalidate()
+{
+    m_data->isDirty = true;
+    m_data->levels.clear();
+}
+
+/*!
+   \return True, when the x coordinates of the samples are in increasing order
+   \note For a non monotonic series reducedSamples() is not available
+ */
+bool QwtSeriesDataPyramid::isMonotonic() const
+{
+    build();
+    return m_data->isMonotonic;
+}
+
+//! \return Number of samples
+size_t QwtSeriesDataPyramid::size() const
+{
+    return m_data->series ? m_data->series->size() : 0;
+}
+
+/*!
+   \param index Index
+   \return Sample at position index
+ */
+QPointF QwtSeriesDataPyramid::sample( size_t index ) const
+{
+    return m_data->series->sample( index );
+}
+
+/*!
+   \return Bounding rectangle of all samples
+
+   The bounding rectangle is calculated, when building the index.
+   So it is available in O(1) as long as the index is valid.
+ */
+QRectF QwtSeriesDataPyramid::boundingRect() const
+{
+    build();
+    return m_data->boundingRect;
+}
+
+/*!
+   Forward the rectangle of interest to the wrapped series
+
+   \param rect Rectangle of interest
+   \sa QwtSeriesData::setRectOfInterest()
+ */
+void QwtSeriesDataPyramid::setRectOfInterest( const QRectF& rect )
+{
+    if ( m_data->series )
+        m_data->series->setRectOfInterest( rect );
+}
+
+/*!
+   \brief Find the samples with the minimum and maximum y coordinates
+
+   \param from Index of the first sample
+   \param to Index of the last sample
+   \param minIndex Index of the sample with the minimum y coordinate
+   \param maxIndex Index of the sample with the maximum y coordinate
+
+   \return false, when the index range is empty or contains gaps only
+ */
+bool QwtSeriesDataPyramid::minMaxIndex( int from, int to,
+    int& minIndex, int& maxIndex ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QwtPyramidNode node;
+    if ( !m_data->query( from, to, node ) || !node.valid )
+        return false;
+
+    minIndex = node.minIndex;
+    maxIndex = node.maxIndex;
+
+    return true;
+}
+
+/*!
+   \brief Calculate the statistics of the samples inside an x interval
+
+   For a series with increasing x coordinates the index range
+   is found by a binary search and the statistics are answered
+   from the index in O(log n). Otherwise all samples are iterated.
+
+   \param xFrom Lower limit of the x interval
+   \param xTo Upper limit of the x interval
+
+   \return Statistics of the y coordinates of all samples with
+           x coordinates in [xFrom, xTo]. Gaps are ignored.
+
+   \sa indexStatistics(), qwtSeriesStatistics()
+ */
+QwtSeriesStatistics QwtSeriesDataPyramid::statistics(
+    double xFrom, double xTo ) const
+{
+    build();
+
+    if ( xFrom > xTo )
+        qSwap( xFrom, xTo );
+
+    const int numSamples = int( size() );
+
+    if ( m_data->isMonotonic )
+    {
+        const int from = m_data->upperIndex( xFrom, 0, numSamples - 1 );
+        const int to = m_data->lastIndex( xTo, from, numSamples - 1 );
+
+        return indexStatistics( from, to );
+    }
+
+    QwtSeriesStatistics statistics;
+
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        const QPointF sample = m_data->series->sample( i );
+
+        if ( sample.x() < xFrom || sample.x() > xTo || qIsNaN( sample.y() ) )
+            continue;
+
+        if ( statistics.count == 0 )
+        {
+            statistics.minY = statistics.maxY = sample.y();
+        }
+        else
+        {
+            statistics.minY = qMin( statistics.minY, sample.y() );
+            statistics.maxY = qMax( statistics.maxY, sample.y() );
+        }
+
+        statistics.sumY += sample.y();
+        statistics.count++;
+    }
+
+    return statistics;
+}
+
+/*!
+   \brief Calculate the statistics of an index range in O(log n)
+
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return Statistics of the y coordinates. Gaps are ignored.
+   \sa statistics(), minMaxIndex()
+ */
+QwtSeriesStatistics QwtSeriesDataPyramid::indexStatistics( int from, int to ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QwtSeriesStatistics statistics;
+
+    QwtPyramidNode node;
+    if ( m_data->query( from, to, node ) && node.count > 0 )
+    {
+        statistics.count = node.count;
+        statistics.minY = node.minY;
+        statistics.maxY = node.maxY;
+        statistics.sumY = node.sumY;
+    }
+
+    return statistics;
+}
+
+/*!
+   \brief Reduce the samples to those being relevant for a polyline
+
+   All samples, that are mapped to the same pixel column are reduced to
+   the first sample, the samples with the minimum/maximum y coordinates
+   and the last sample. Samples outside of the scale interval of xMap
+   are ignored, beside the neighbours of the visible samples.
+
+   The number of returned samples is limited by 4 times the width
+   of the paint interval of xMap. The costs are O(width * log(n)).
+
+   \param xMap Maps x-values into pixel coordinates
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return Reduced samples in the order of the series.
+           For a non monotonic series all samples in the range are returned.
+ */
+QPolygonF QwtSeriesDataPyramid::reducedSamples(
+    const QwtScaleMap& xMap, int from, int to ) const
+{
+    build();
+
+    from = qMax( from, 0 );
+    to = qMin( to, int( size() ) - 1 );
+
+    QPolygonF points;
+    if ( from > to )
+        return points;
+
+    const QwtSeriesData< QPointF >* series = m_data->series;
+
+    if ( !m_data->isMonotonic )
+    {
+        points.reserve( to - from + 1 );
+        for ( int i = from; i <= to; i++ )
+            points += series->sample( i );
+
+        return points;
+    }
+
+    // restricting the range to the visible samples
+    // and their neighbours
+
+    const double sMin = qMin( xMap.s1(), xMap.s2() );
+    const double sMax = qMax( xMap.s1(), xMap.s2() );
+
+    from = qMax( from, m_data->upperIndex( sMin, from, to ) - 1 );
+    to = qMin( to, m_data->upperIndex( sMax, from, to ) );
+
+    const bool increasing = !xMap.isInverting();
+
+    points.reserve( qMin( to - from + 1, 4 * ( int( xMap.pDist() ) + 3 ) ) );
+
+    int i = from;
+    while ( i <= to )
+    {
+        const double px = std::floor(
+            xMap.transform( series->sample( i ).x() ) + 0.5 );
+        const double x2 = xMap.invTransform( increasing ? px + 0.5 : px - 0.5 );
+
+        const int j = qMax( i, m_data->upperIndex( x2, i + 1, to ) - 1 );
+
+        if ( j - i < 4 )
+        {
+            for ( int k = i; k <= j; k++ )
+                points += series->sample( k );
+        }
+        else
+        {
+            int minIndex, maxIndex;
+            if ( !minMaxIndex( i, j, minIndex, maxIndex ) )
+            {
+                // gaps only: first and last sample
+                minIndex = maxIndex = i;
+            }
+
+            if ( minIndex > maxIndex )
+                qSwap( minIndex, maxIndex );
+
+            points += series->sample( i );
+
+            if ( minIndex != i && minIndex != j )
+                points += series->sample( minIndex );
+
+            if ( maxIndex != i && maxIndex != minIndex && maxIndex != j )
+                points += series->sample( maxIndex );
+
+            points += series->sample( j );
+        }
+
+        i = j + 1;
+    }
+
+    return points;
+}
+
+void QwtSeriesDataPyramid::build() const
+{
+    if ( !m_data->isDirty )
+        return;
+
+    m_data->isDirty = false;
+    m_data->isMonotonic = true;
+    m_data->boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+    m_data->levels.clear();
+
+    const int numSamples = int( size() );
+    if ( numSamples <= 0 )
+        return;
+
+    const QwtSeriesData< QPointF >* series = m_data->series;
+
+    const int numBlocks = ( numSamples + qwtBlockSize - 1 ) / qwtBlockSize;
+
+    QVector< QwtPyramidNode > nodes( numBlocks );
+
+    const QPointF sample0 = series->sample( 0 );
+
+    double xMin = sample0.x();
+    double xMax = sample0.x();
+    double xPrev = sample0.x();
+
+    for ( int block = 0; block < numBlocks; block++ )
+    {
+        const int from = block * qwtBlockSize;
+        const int to = qMin( from + qwtBlockSize, numSamples ) - 1;
+
+        QwtPyramidNode& node = nodes[block];
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QPointF sample = series->sample( i );
+
+            if ( i == from )
+                node.init( i, sample.y() );
+            else
+                node.add( i, sample.y() );
+
+            const double x = sample.x();
+
+            if ( x < xPrev )
+                m_data->isMonotonic = false;
+
+            if ( x < xMin )
+                xMin = x;
+
+            if ( x > xMax )
+                xMax = x;
+
+            xPrev = x;
+        }
+    }
+
+    m_data->levels += nodes;
+
+    while ( nodes.size() > 1 )
+    {
+        const QVector< QwtPyramidNode > lower = nodes;
+
+        nodes.resize( ( lower.size() + 1 ) / 2 );
+        for ( int i = 0; i < nodes.size(); i++ )
+        {
+            nodes[i] = lower[2 * i];
+            if ( 2 * i + 1 < lower.size() )
+                nodes[i].add( lower[2 * i + 1] );
+        }
+
+        m_data->levels += nodes;
+    }
+
+    const QwtPyramidNode& root = m_data->levels.last()[0];
+
+    if ( root.valid )
+        m_data->boundingRect.setCoords( xMin, root.minY, xMax, root.maxY );
+}
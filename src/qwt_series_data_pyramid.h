@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SERIES_DATA_PYRAMID_H
+#define QWT_SERIES_DATA_PYRAMID_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtScaleMap;
+class QPolygonF;
+
+/*!
+   \brief A min/max pyramid for a series of points
+
+   QwtSeriesDataPyramid wraps another QwtSeriesData<QPointF> object and
+   builds a multi-resolution index of the minimum, maximum and sum of the
+   y coordinates of consecutive blocks of samples. For series with
+   monotonically increasing x coordinates ( f.e. recordings of a signal )
+   it offers to find the extremes and the mean of any x interval
+   in O(log n) - f.e. for cursor readouts or autoscaling to the
+   visible samples ( QwtPlot::FitVisible ).
+
+   QwtPlotCurve takes advantage of the index, when painting
+   QwtPlotCurve::Lines to a paint device with integer coordinates:
+   only the first, minimum, maximum and last sample of all samples being
+   mapped to the same pixel column are passed to the QwtPointMapper.
+   So the costs of a replot depend on the width of the canvas
+   instead of the number of samples.
+
+   The index is built lazily, when it is needed the first time.
+   When the samples of the wrapped series are modified invalidate()
+   has to be called.
+
+   \par Example
+   \code
+   QwtPlotCurve* curve = new QwtPlotCurve();
+   curve->setData( new QwtSeriesDataPyramid(
+       new QwtCPointerData< double >( xValues, yValues, numValues ) ) );
+   \endcode
+   \endpar
+
+   \sa QwtPlotCurve::drawLines(), QwtPointMapper
+ */
+class QWT_EXPORT QwtSeriesDataPyramid : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtSeriesDataPyramid( QwtSeriesData< QPointF >* series = NULL );
+    virtual ~QwtSeriesDataPyramid();
+
+    void setSeries( QwtSeriesData< QPointF >* );
+    const QwtSeriesData< QPointF >* series() const;
+
+    void invalidate();
+
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+
+    bool minMaxIndex( int from, int to,
+        int& minIndex, int& maxIndex ) const;
+
+    QwtSeriesStatistics statistics( double xFrom, double xTo ) const;
+    QwtSeriesStatistics indexStatistics( int from, int to ) const;
+
+    QPolygonF reducedSamples( const QwtScaleMap& xMap,
+        int from, int to ) const;
+
+  private:
+    Q_DISABLE_COPY( QwtSeriesDataPyramid )
+
+    void build() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
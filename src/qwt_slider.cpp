@@ -17,6 +17,7 @@
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qmargins.h>
@@ -81,6 +82,8 @@ class QwtSlider::PrivateData
         , hasTrough( true )
         , hasGroove( false )
         , mouseOffset( 0 )
+        , cachePixelRatio( 1.0 )
+        , cacheColorGroup( QPalette::Active )
     {
     }
 
@@ -105,6 +108,11 @@ class QwtSlider::PrivateData
     int mouseOffset;
 
     mutable QSize sizeHintCache;
+
+    // the scale, that doesn't depend on the value
+    QPixmap scaleCache;
+    qreal cachePixelRatio;
+    QPalette::ColorGroup cacheColorGroup;
 };
 /*!
    Construct vertical slider in QwtSlider::Trough style
@@ -377,6 +385,7 @@ QwtScaleDraw* QwtSlider::scaleDraw()
 //! Notify changed scale
 void QwtSlider::scaleChange()
 {
+    invalidateCache();
     QwtAbstractSlider::scaleChange();
 
     if ( testAttribute( Qt::WA_WState_Polished ) )
@@ -684,7 +693,7 @@ void QwtSlider::paintEvent( QPaintEvent* event )
     if ( m_data->scalePosition != QwtSlider::NoScale )
     {
         if ( !m_data->sliderRect.contains( event->rect() ) )
-            scaleDraw()->draw( &painter, palette() );
+            drawScale( &painter );
     }
 
     drawSlider( &painter, m_data->sliderRect );
@@ -693,6 +702,100 @@ void QwtSlider::paintEvent( QPaintEvent* event )
         QwtPainter::drawFocusRect( &painter, this, m_data->sliderRect );
 }
 
+/*!
+   Draw the scale from a pixmap, that is rendered by
+   QwtScaleDraw::draw() only when it is invalid
+
+   \param painter Painter
+   \sa invalidateCache()
+ */
+void QwtSlider::drawScale( QPainter* painter ) const
+{
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+    const QPalette::ColorGroup colorGroup = palette().currentColorGroup();
+
+    QPixmap& cache = m_data->scaleCache;
+
+    if ( cache.isNull() || cache.size() != size() * pixelRatio
+        || pixelRatio != m_data->cachePixelRatio
+        || colorGroup != m_data->cacheColorGroup )
+    {
+        if ( size().isEmpty() )
+            return;
+
+        cache = QwtPainter::backingStore( const_cast< QwtSlider* >( this ), size() );
+        cache.fill( Qt::transparent );
+
+        QPainter p( &cache );
+        p.setFont( font() );
+
+        scaleDraw()->draw( &p, palette() );
+
+        p.end();
+
+        m_data->cachePixelRatio = pixelRatio;
+        m_data->cacheColorGroup = colorGroup;
+    }
+
+    painter->drawPixmap( 0, 0, cache );
+}
+
+/*!
+   Invalidate the pixmap, that is used to speed up painting the scale
+
+   The scale is rendered to a pixmap, that is reused until the layout,
+   the scale or an attribute of the slider changes. Derived classes
+   might need to call invalidateCache() according to their own attributes.
+ */
+void QwtSlider::invalidateCache()
+{
+    m_data->scaleCache = QPixmap();
+}
+
+/*!
+   Update the slider, when the value has changed
+
+   As the scale doesn't depend on the value, the update is restricted
+   to a band along the slider, that includes the handle.
+ */
+void QwtSlider::sliderChange()
+{
+    QRect rect = m_data->sliderRect;
+    if ( rect.isEmpty() )
+    {
+        QwtAbstractSlider::sliderChange();
+        return;
+    }
+
+    const QRect cr = contentsRect();
+    const QRect hr = handleRect();
+
+    if ( m_data->orientation == Qt::Horizontal )
+    {
+        rect.setLeft( cr.left() );
+        rect.setRight( cr.right() );
+
+        if ( hr.isValid() )
+        {
+            rect.setTop( qMin( rect.top(), hr.top() ) );
+            rect.setBottom( qMax( rect.bottom(), hr.bottom() ) );
+        }
+    }
+    else
+    {
+        rect.setTop( cr.top() );
+        rect.setBottom( cr.bottom() );
+
+        if ( hr.isValid() )
+        {
+            rect.setLeft( qMin( rect.left(), hr.left() ) );
+            rect.setRight( qMax( rect.right(), hr.right() ) );
+        }
+    }
+
+    update( rect );
+}
+
 /*!
    Qt resize event handler
    \param event Resize event
@@ -720,14 +823,33 @@ bool QwtSlider::event( QEvent* event )
 /*!
    Handles QEvent::StyleChange and QEvent::FontChange events
    \param event Change event
+
+   Invalidates the scale cache if necessary
  */
 void QwtSlider::changeEvent( QEvent* event )
 {
-    if ( event->type() == QEvent::StyleChange ||
-        event->type() == QEvent::FontChange )
+    switch( event->type() )
     {
-        if ( testAttribute( Qt::WA_WState_Polished ) )
-            layoutSlider( true );
+        case QEvent::StyleChange:
+        case QEvent::FontChange:
+        {
+            invalidateCache();
+
+            if ( testAttribute( Qt::WA_WState_Polished ) )
+                layoutSlider( true );
+
+            break;
+        }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LanguageChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            break;
+        }
+        default:
+            break;
     }
 
     QwtAbstractSlider::changeEvent( event );
@@ -742,6 +864,8 @@ void QwtSlider::changeEvent( QEvent* event )
  */
 void QwtSlider::layoutSlider( bool update_geometry )
 {
+    invalidateCache();
+
     int bw = 0;
     if ( m_data->hasTrough )
         bw = m_data->borderWidth;
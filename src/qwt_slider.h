@@ -115,6 +115,9 @@ class QWT_EXPORT QwtSlider : public QwtAbstractSlider
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
     virtual void scaleChange() QWT_OVERRIDE;
+    virtual void sliderChange() QWT_OVERRIDE;
+
+    void invalidateCache();
 
     QRect sliderRect() const;
     QRect handleRect() const;
@@ -124,6 +127,7 @@ class QWT_EXPORT QwtSlider : public QwtAbstractSlider
 
     void layoutSlider( bool );
     void initSlider( Qt::Orientation );
+    void drawScale( QPainter* ) const;
 
     class PrivateData;
     PrivateData* m_data;
@@ -312,8 +312,8 @@ static inline SplineStore qwtSplineC1PathParametric(
         pointsY.resize( numParamPoints );
     }
 
-    const QVector< double > slopesX = spline->slopes( pointsX );
-    const QVector< double > slopesY = spline->slopes( pointsY );
+    QVector< double > slopesX, slopesY;
+    spline->parametricSlopes( pointsX, pointsY, slopesX, slopesY );
 
     const double* mx = slopesX.constData();
     const double* my = slopesY.constData();
@@ -792,8 +792,9 @@ QPainterPath QwtSplineInterpolating::painterPath( const QPolygonF& points ) cons
    Interpolates a polygon piecewise with Bezier curves
    approximating them by polygons.
 
-   The approximation is based on "Piecewise Linear Approximation of Bézier Curves"
-   by Roger Willcocks ( http://www.rops.org )
+   The number of lines for each Bezier curve is estimated in advance,
+   so that the distance to the curve is below the tolerance
+   ( see QwtBezier::segmentCount() ).
 
    \param points Control points
    \param tolerance Maximum for the accepted error of the approximation
@@ -812,29 +813,9 @@ QPolygonF QwtSplineInterpolating::polygon(
     if ( controlLines.isEmpty() )
         return QPolygonF();
 
-    const bool isClosed = boundaryType() == QwtSpline::ClosedPolygon;
-
-    QwtBezier bezier( tolerance );
-
-    const QPointF* p = points.constData();
-    const QLineF* cl = controlLines.constData();
-
-    const int n = controlLines.size();
-
-    QPolygonF polygon;
-
-    for ( int i = 0; i < n - 1; i++ )
-    {
-        const QLineF& l = cl[i];
-        bezier.appendToPolygon( p[i], l.p1(), l.p2(), p[i + 1], polygon );
-    }
-
-    const QPointF& pn = isClosed ? p[0] : p[n];
-    const QLineF& l = cl[n - 1];
-
-    bezier.appendToPolygon( p[n - 1], l.p1(), l.p2(), pn, polygon );
-
-    return polygon;
+    // the number of control lines already indicates a closed spline
+    const QwtBezier bezier( tolerance );
+    return bezier.toPolygon( points, controlLines );
 }
 
 /*!
@@ -1025,6 +1006,30 @@ double QwtSplineC1::slopeAtEnd( const QPolygonF& points, double slopeBefore ) co
    \note The x coordinates need to be increasing or decreasing
  */
 
+/*!
+   \brief Find the first derivatives of a parametric spline
+
+   For parametric splines the slopes are calculated for x( t ) and y( t ).
+   Both polygons have the same parameter values t as x coordinates.
+
+   The default implementation calls slopes() for each polygon. Derived classes
+   might overload it to share the calculations depending on t only.
+
+   \param pointsX Control nodes ( t, x( t ) )
+   \param pointsY Control nodes ( t, y( t ) )
+   \param slopesX Values of the first derivative of x( t ) at the control points
+   \param slopesY Values of the first derivative of y( t ) at the control points
+
+   \sa slopes()
+ */
+void QwtSplineC1::parametricSlopes(
+    const QPolygonF& pointsX, const QPolygonF& pointsY,
+    QVector< double >& slopesX, QVector< double >& slopesY ) const
+{
+    slopesX = slopes( pointsX );
+    slopesY = slopes( pointsY );
+}
+
 /*!
    \brief Calculate an interpolated painter path
 
@@ -248,6 +248,10 @@ class QWT_EXPORT QwtSplineC1 : public QwtSplineG1
     virtual QVector< QwtSplinePolynomial > polynomials( const QPolygonF& ) const;
     virtual QVector< double > slopes( const QPolygonF& ) const = 0;
 
+    virtual void parametricSlopes(
+        const QPolygonF& pointsX, const QPolygonF& pointsY,
+        QVector< double >& slopesX, QVector< double >& slopesY ) const;
+
     virtual double slopeAtBeginning( const QPolygonF&, double slopeNext ) const;
     virtual double slopeAtEnd( const QPolygonF&, double slopeBefore ) const;
 };
@@ -12,6 +12,7 @@
 
 #include <qpolygon.h>
 #include <qpainterpath.h>
+#include <qmutex.h>
 
 #define SLOPES_INCREMENTAL 0
 #define KAHAN 0
@@ -778,6 +779,224 @@ namespace QwtSplineCubicP
     };
 }
 
+namespace QwtSplineCubicP
+{
+    /*
+       Buffers for the coefficients of the substituted equations,
+       that can be reused for many calls
+     */
+    class Workspace
+    {
+      public:
+        void setup( int size )
+        {
+            if ( p.size() < size )
+            {
+                p.resize( size );
+                q.resize( size );
+                r[0].resize( size );
+                r[1].resize( size );
+            }
+        }
+
+        QVector< double > p;
+        QVector< double > q;
+        QVector< double > r[2];
+    };
+
+    /*
+       The equation systems for x( t ) and y( t ) of a parametric
+       spline have the same coefficients, as they depend on t only. Only
+       the right hand sides are different, so that both systems can be
+       resolved at the same time, running the substitution of EquationSystem
+       once. The boundary equations of both systems have been set up
+       from the same conditions and differ in r only.
+     */
+    class BatchedEquationSystem
+    {
+      public:
+        explicit BatchedEquationSystem( Workspace& workspace )
+            : m_workspace( workspace )
+        {
+        }
+
+        bool resolve( const QPolygonF* points[2],
+            const Equation3 conditions[2][2], QVector< double >* slopes[2] )
+        {
+            const int n = points[0]->size();
+            if ( n < 4 || points[1]->size() != n )
+                return false;
+
+            const Equation3& c0 = conditions[0][0];
+            const Equation3& cn = conditions[0][1];
+
+            if ( c0.p == 0.0 || ( c0.q == 0.0 && c0.u != 0.0 ) )
+                return false;
+
+            if ( cn.u == 0.0 || ( cn.q == 0.0 && cn.p != 0.0 ) )
+                return false;
+
+            m_workspace.setup( n );
+
+            double* P = m_workspace.p.data();
+            double* Q = m_workspace.q.data();
+
+            const QPointF* t = points[0]->constData();
+
+            const double h0 = t[1].x() - t[0].x();
+            const double h1 = t[2].x() - t[1].x();
+            const double hn2 = t[n - 2].x() - t[n - 3].x();
+            const double hn1 = t[n - 1].x() - t[n - 2].x();
+
+            // end condition, substituting b[n-1]
+
+            const double kn = cn.u / hn1;
+            const double eqNp = cn.p - kn * hn2;
+            const double eqNq = cn.q - kn * 2.0 * ( hn2 + hn1 );
+
+            double eqNr[2];
+            for ( int k = 0; k < 2; k++ )
+            {
+                const QPointF* p = points[k]->constData();
+
+                const double s1 = ( p[n - 2].y() - p[n - 3].y() ) / hn2;
+                const double s2 = ( p[n - 1].y() - p[n - 2].y() ) / hn1;
+
+                eqNr[k] = conditions[k][1].r - kn * 3.0 * ( s2 - s1 );
+            }
+
+            // ep * b[i-1] + eq * b[i] = er, starting with i = n - 2
+
+            double ep = eqNp;
+            double eq = eqNq;
+            double er[2] = { eqNr[0], eqNr[1] };
+
+            if ( n > 4 )
+            {
+                const double hn3 = t[n - 3].x() - t[n - 4].x();
+
+                const double v = hn2 / eq;
+
+                P[n - 3] = hn3;
+                Q[n - 3] = 2.0 * ( hn3 + hn2 ) - v * ep;
+
+                for ( int k = 0; k < 2; k++ )
+                {
+                    const QPointF* p = points[k]->constData();
+
+                    const double s1 = ( p[n - 3].y() - p[n - 4].y() ) / hn3;
+                    const double s2 = ( p[n - 2].y() - p[n - 3].y() ) / hn2;
+
+                    m_workspace.r[k][n - 3] = 3.0 * ( s2 - s1 ) - v * er[k];
+                }
+
+                double* R0 = m_workspace.r[0].data();
+                double* R1 = m_workspace.r[1].data();
+
+                const QPointF* p0 = points[0]->constData();
+                const QPointF* p1 = points[1]->constData();
+
+                double slope0 = ( p0[n - 3].y() - p0[n - 4].y() ) / hn3;
+                double slope1 = ( p1[n - 3].y() - p1[n - 4].y() ) / hn3;
+
+                for ( int i = n - 4; i > 1; i-- )
+                {
+                    P[i] = t[i].x() - t[i - 1].x();
+
+                    const double v = P[i + 1] / Q[i + 1];
+
+                    Q[i] = 2.0 * ( P[i] + P[i + 1] ) - v * P[i + 1];
+
+                    const double s0 = ( p0[i].y() - p0[i - 1].y() ) / P[i];
+                    R0[i] = 3.0 * ( slope0 - s0 ) - v * R0[i + 1];
+
+                    const double s1 = ( p1[i].y() - p1[i - 1].y() ) / P[i];
+                    R1[i] = 3.0 * ( slope1 - s1 ) - v * R1[i + 1];
+
+                    slope0 = s0;
+                    slope1 = s1;
+                }
+
+                ep = P[2];
+                eq = Q[2];
+                er[0] = R0[2];
+                er[1] = R1[2];
+            }
+
+            // the equation of the first spline segments, substituting b[2]
+
+            const double k1 = h1 / eq;
+
+            const double eqYp = h0;
+            const double eqYq = 2.0 * ( h0 + h1 ) - k1 * ep;
+
+            for ( int k = 0; k < 2; k++ )
+            {
+                const QPointF* p = points[k]->constData();
+                const Equation3& cb = conditions[k][0];
+                const Equation3& ce = conditions[k][1];
+
+                const double s0 = ( p[1].y() - p[0].y() ) / h0;
+                const double s1 = ( p[2].y() - p[1].y() ) / h1;
+
+                const double eqYr = 3.0 * ( s1 - s0 ) - k1 * er[k];
+
+                double b0;
+                if ( cb.u == 0.0 )
+                {
+                    const double kx = cb.q / eqYq;
+                    b0 = ( cb.r - kx * eqYr ) / ( cb.p - kx * eqYp );
+                }
+                else
+                {
+                    const double kx = cb.u / eq;
+
+                    const double eqXq = cb.q - kx * ep;
+                    const double eqXr = cb.r - kx * er[k];
+
+                    const double ky = eqYq / eqXq;
+                    b0 = ( eqYr - ky * eqXr ) / ( eqYp - ky * cb.p );
+                }
+
+                double b1 = ( eqYr - eqYp * b0 ) / eqYq;
+
+                slopes[k]->resize( n );
+                double* m = slopes[k]->data();
+
+                m[0] = s0 - h0 * ( 2.0 * b0 + b1 ) / 3.0;
+                m[1] = s0 + h0 * ( b0 + 2.0 * b1 ) / 3.0;
+
+                const double* r = m_workspace.r[k].constData();
+
+                for ( int i = 2; i < n - 2; i++ )
+                {
+                    const double b2 = ( r[i] - P[i] * b1 ) / Q[i];
+
+                    const double s = ( p[i].y() - p[i - 1].y() ) / P[i];
+                    m[i] = s + P[i] * ( b1 + 2.0 * b2 ) / 3.0;
+
+                    b1 = b2;
+                }
+
+                const double bn2 = b1;
+                const double bn1 = ( eqNr[k] - eqNp * bn2 ) / eqNq;
+                const double bn0 = ( ce.r - ce.p * bn2 - ce.q * bn1 ) / ce.u;
+
+                const double sn2 = ( p[n - 2].y() - p[n - 3].y() ) / hn2;
+                const double sn1 = ( p[n - 1].y() - p[n - 2].y() ) / hn1;
+
+                m[n - 2] = sn2 + hn2 * ( bn2 + 2.0 * bn1 ) / 3.0;
+                m[n - 1] = sn1 + hn1 * ( bn1 + 2.0 * bn0 ) / 3.0;
+            }
+
+            return true;
+        }
+
+      private:
+        Workspace& m_workspace;
+    };
+}
+
 static void qwtSetupEndEquations(
     int conditionBegin, double valueBegin, int conditionEnd, double valueEnd,
     const QPolygonF& points, QwtSplineCubicP::Equation3 eq[2] )
@@ -957,6 +1176,10 @@ static void qwtSetupEndEquations(
 
 class QwtSplineCubic::PrivateData
 {
+  public:
+    // buffers of parametricSlopes(), locked against concurrent calls
+    QMutex mutex;
+    QwtSplineCubicP::Workspace workspace;
 };
 
 /*!
@@ -964,8 +1187,9 @@ class QwtSplineCubic::PrivateData
    The default setting is a non closing natural spline with no parametrization.
  */
 QwtSplineCubic::QwtSplineCubic()
-    : m_data( nullptr )
 {
+    m_data = new PrivateData;
+
     // a natural spline
 
     setBoundaryCondition( QwtSpline::AtBeginning, QwtSpline::Clamped2 );
@@ -978,6 +1202,7 @@ QwtSplineCubic::QwtSplineCubic()
 //! Destructor
 QwtSplineCubic::~QwtSplineCubic()
 {
+    delete m_data;
 }
 
 /*!
@@ -1066,6 +1291,73 @@ QVector< double > QwtSplineCubic::slopes( const QPolygonF& points ) const
     return eqs.store().slopes();
 }
 
+/*!
+   \brief Find the first derivatives of a parametric spline
+
+   The equation systems for x( t ) and y( t ) have the same coefficients,
+   as they depend on the parameter values only. So both are resolved in
+   one pass, using buffers that are reused for the following calls.
+
+   \param pointsX Control nodes ( t, x( t ) )
+   \param pointsY Control nodes ( t, y( t ) )
+   \param slopesX First derivatives of x( t ) at the control points
+   \param slopesY First derivatives of y( t ) at the control points
+
+   \note For periodic and closed boundary types x( t ) and y( t )
+         are resolved one after the other.
+
+   \sa slopes()
+ */
+void QwtSplineCubic::parametricSlopes(
+    const QPolygonF& pointsX, const QPolygonF& pointsY,
+    QVector< double >& slopesX, QVector< double >& slopesY ) const
+{
+    using namespace QwtSplineCubicP;
+
+    if ( pointsX.size() > 3 && pointsX.size() == pointsY.size()
+        && boundaryType() != QwtSpline::PeriodicPolygon
+        && boundaryType() != QwtSpline::ClosedPolygon )
+    {
+        const QPolygonF* points[2] = { &pointsX, &pointsY };
+
+        Equation3 conditions[2][2];
+        for ( int k = 0; k < 2; k++ )
+        {
+            qwtSetupEndEquations(
+                boundaryCondition( QwtSpline::AtBeginning ),
+                boundaryValue( QwtSpline::AtBeginning ),
+                boundaryCondition( QwtSpline::AtEnd ),
+                boundaryValue( QwtSpline::AtEnd ),
+                *points[k], conditions[k] );
+        }
+
+        QVector< double >* slopes[2] = { &slopesX, &slopesY };
+
+        bool ok;
+        if ( m_data->mutex.tryLock() )
+        {
+            BatchedEquationSystem eqs( m_data->workspace );
+            ok = eqs.resolve( points, conditions, slopes );
+
+            m_data->mutex.unlock();
+        }
+        else
+        {
+            // the buffers are in use by another thread
+
+            Workspace workspace;
+
+            BatchedEquationSystem eqs( workspace );
+            ok = eqs.resolve( points, conditions, slopes );
+        }
+
+        if ( ok )
+            return;
+    }
+
+    QwtSplineC2::parametricSlopes( pointsX, pointsY, slopesX, slopesY );
+}
+
 /*!
    \brief Find the second derivative at the control points
 
@@ -28,6 +28,9 @@
    Resolving the equation system is a 2 pass algorithm, requiring more CPU costs
    than all other implemented type of splines.
 
+   For parametric splines the equation systems for x( t ) and y( t )
+   are resolved in one pass - see parametricSlopes().
+
    \todo The implementation is not numerical stable
  */
 class QWT_EXPORT QwtSplineCubic : public QwtSplineC2
@@ -46,6 +49,10 @@ class QWT_EXPORT QwtSplineCubic : public QwtSplineC2
     virtual QVector< double > slopes( const QPolygonF& ) const QWT_OVERRIDE;
     virtual QVector< double > curvatures( const QPolygonF& ) const QWT_OVERRIDE;
 
+    virtual void parametricSlopes(
+        const QPolygonF& pointsX, const QPolygonF& pointsY,
+        QVector< double >& slopesX, QVector< double >& slopesY ) const QWT_OVERRIDE;
+
   private:
     class PrivateData;
     PrivateData* m_data;
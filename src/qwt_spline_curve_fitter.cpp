@@ -10,14 +10,272 @@
 #include "qwt_spline_curve_fitter.h"
 #include "qwt_spline_local.h"
 #include "qwt_spline_parametrization.h"
+#include "qwt_bezier.h"
 
 #include <qpolygon.h>
 #include <qpainterpath.h>
+#include <qline.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class SplineChunk
+    {
+      public:
+        const QwtSplineInterpolating* spline;
+        const QPolygonF* points;
+
+        // the chunk consists of the polynomials between from and to
+        int from;
+        int to;
+
+        // number of additional points on each side
+        int margin;
+
+        double tolerance;
+
+        QVector< QLineF > controlLines;
+        QPolygonF polygon;
+    };
+
+    class FitCache
+    {
+      public:
+        FitCache()
+            : isEnabled( false )
+            , hasPath( false )
+            , hasPolygon( false )
+            , tolerance( 0.0 )
+        {
+        }
+
+        void invalidate()
+        {
+            hasPath = hasPolygon = false;
+
+            points.clear();
+            path = QPainterPath();
+            polygon.clear();
+        }
+
+        void assign( const QPolygonF& polygon )
+        {
+            if ( points != polygon )
+            {
+                invalidate();
+                points = polygon;
+            }
+        }
+
+        bool isEnabled;
+
+        bool hasPath;
+        bool hasPolygon;
+
+        double tolerance;
+
+        QPolygonF points;
+        QPainterPath path;
+        QPolygonF polygon;
+    };
+}
+
+static void qwtEvaluateChunk( SplineChunk* chunk )
+{
+    const QPolygonF& points = *chunk->points;
+
+    const int from = qMax( chunk->from - chunk->margin, 0 );
+    const int to = qMin( chunk->to + chunk->margin, int( points.size() ) - 1 );
+
+    const QVector< QLineF > lines =
+        chunk->spline->bezierControlLines( points.mid( from, to - from + 1 ) );
+
+    if ( lines.size() < to - from )
+        return;
+
+    chunk->controlLines = lines.mid( chunk->from - from, chunk->to - chunk->from );
+
+    if ( chunk->tolerance > 0.0 )
+    {
+        const QwtBezier bezier( chunk->tolerance );
+
+        const QPointF* p = points.constData();
+        const QLineF* l = chunk->controlLines.constData();
+
+        for ( int i = chunk->from; i < chunk->to; i++ )
+        {
+            const QLineF& line = l[i - chunk->from];
+            bezier.appendToPolygon( p[i], line.p1(), line.p2(), p[i + 1], chunk->polygon );
+        }
+    }
+}
+
+/*
+   Interpolate the polygon in overlapping windows in parallel. When tolerance
+   is > 0.0 the Bezier curves are approximated by a polygon, otherwise their
+   control lines are returned. Returns false, when the spline or the
+   polygon are not suitable for being split.
+ */
+static bool qwtEvaluateParallel( const QwtSpline* spline,
+    const QPolygonF& points, uint numThreads, double tolerance,
+    QVector< QLineF >& controlLines, QPolygonF& polygon )
+{
+#if QWT_USE_THREADS
+    const QwtSplineInterpolating* interpolating =
+        dynamic_cast< const QwtSplineInterpolating* >( spline );
+
+    if ( interpolating == NULL || interpolating->locality() == 0
+        || interpolating->boundaryType() == QwtSpline::ClosedPolygon )
+    {
+        return false;
+    }
+
+    const int minChunkSize = 5000;
+
+    const int numSegments = points.size() - 1;
+
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    const int numChunks = qBound( 1, numSegments / minChunkSize, int( numThreads ) );
+    if ( numChunks <= 1 )
+        return false;
+
+    QVector< SplineChunk > chunks( numChunks );
+
+    const int chunkSize = numSegments / numChunks;
+
+    QList< QFuture< void > > futures;
+
+    for ( int i = 0; i < numChunks; i++ )
+    {
+        SplineChunk& chunk = chunks[i];
+
+        chunk.spline = interpolating;
+        chunk.points = &points;
+        chunk.from = i * chunkSize;
+        chunk.to = ( i == numChunks - 1 ) ? numSegments : chunk.from + chunkSize;
+        chunk.margin = interpolating->locality() + 1;
+        chunk.tolerance = tolerance;
+
+        if ( i < numChunks - 1 )
+            futures += QtConcurrent::run( &qwtEvaluateChunk, &chunk );
+        else
+            qwtEvaluateChunk( &chunk );
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+
+    int numPoints = 0;
+    for ( int i = 0; i < numChunks; i++ )
+    {
+        const SplineChunk& chunk = chunks[i];
+        if ( chunk.controlLines.size() != chunk.to - chunk.from )
+            return false;
+
+        numPoints += chunk.polygon.size();
+    }
+
+    if ( tolerance > 0.0 )
+    {
+        polygon.reserve( numPoints );
+
+        for ( int i = 0; i < numChunks; i++ )
+        {
+            const QPolygonF& chunkPolygon = chunks[i].polygon;
+
+            // the first point of a chunk is the last point of the previous one
+            const int from = ( i > 0 ) ? 1 : 0;
+
+            for ( int j = from; j < chunkPolygon.size(); j++ )
+                polygon += chunkPolygon[j];
+        }
+    }
+    else
+    {
+        controlLines.reserve( numSegments );
+
+        for ( int i = 0; i < numChunks; i++ )
+            controlLines += chunks[i].controlLines;
+    }
+
+    return true;
+#else
+    Q_UNUSED( spline )
+    Q_UNUSED( points )
+    Q_UNUSED( numThreads )
+    Q_UNUSED( tolerance )
+    Q_UNUSED( controlLines )
+    Q_UNUSED( polygon )
+
+    return false;
+#endif
+}
+
+/*
+   Check if polygon is a translated copy of other and
+   return the translation in offset
+ */
+static bool qwtIsTranslated( const QPolygonF& polygon,
+    const QPolygonF& other, QPointF& offset )
+{
+    const int n = polygon.size();
+    if ( n == 0 || n != other.size() )
+        return false;
+
+    const QPointF* p1 = other.constData();
+    const QPointF* p2 = polygon.constData();
+
+    const double dx = p2[0].x() - p1[0].x();
+    const double dy = p2[0].y() - p1[0].y();
+
+    // ignoring rounding errors of mapping the points
+    const double eps = 1e-6;
+
+    for ( int i = 1; i < n; i++ )
+    {
+        if ( qAbs( p2[i].x() - p1[i].x() - dx ) > eps
+            || qAbs( p2[i].y() - p1[i].y() - dy ) > eps )
+        {
+            return false;
+        }
+    }
+
+    offset = QPointF( dx, dy );
+    return true;
+}
+
+class QwtSplineCurveFitter::PrivateData
+{
+  public:
+    PrivateData()
+        : tolerance( 0.0 )
+        , numThreads( 1 )
+    {
+    }
+
+    double tolerance;
+    uint numThreads;
+
+    FitCache cache;
+};
 
 //! Constructor
 QwtSplineCurveFitter::QwtSplineCurveFitter()
     : QwtCurveFitter( QwtCurveFitter::Path )
 {
+    m_data = new PrivateData;
+
     m_spline = new QwtSplineLocal( QwtSplineLocal::Cardinal );
     m_spline->setParametrization( QwtSplineParametrization::ParameterUniform );
 }
@@ -26,6 +284,7 @@ QwtSplineCurveFitter::QwtSplineCurveFitter()
 QwtSplineCurveFitter::~QwtSplineCurveFitter()
 {
     delete m_spline;
+    delete m_data;
 }
 
 /*!
@@ -44,6 +303,8 @@ void QwtSplineCurveFitter::setSpline( QwtSpline* spline )
 
     delete m_spline;
     m_spline = spline;
+
+    invalidateCache();
 }
 
 /*!
@@ -57,6 +318,8 @@ const QwtSpline* QwtSplineCurveFitter::spline() const
 
 /*!
    \return Spline
+   \note When the cache is enabled invalidateCache() needs to be called
+         after modifying the spline
    \sa setSpline()
  */
 QwtSpline* QwtSplineCurveFitter::spline()
@@ -64,23 +327,168 @@ QwtSpline* QwtSplineCurveFitter::spline()
     return m_spline;
 }
 
+/*!
+   Set the tolerance for approximating the Bezier curves by fitCurve()
+
+   For a tolerance > 0.0 the Bezier curves of the spline are approximated
+   by QwtBezier with a maximum error of tolerance. Otherwise the polygon
+   is created by flattening the painter path returned from fitCurvePath().
+
+   The default setting is 0.0.
+
+   \param tolerance Tolerance
+   \sa tolerance(), QwtSpline::polygon()
+ */
+void QwtSplineCurveFitter::setTolerance( double tolerance )
+{
+    tolerance = qMax( tolerance, 0.0 );
+    if ( tolerance != m_data->tolerance )
+    {
+        m_data->tolerance = tolerance;
+        m_data->cache.hasPolygon = false;
+    }
+}
+
+/*!
+   \return Tolerance for approximating the Bezier curves
+   \sa setTolerance()
+ */
+double QwtSplineCurveFitter::tolerance() const
+{
+    return m_data->tolerance;
+}
+
+/*!
+   Set the number of threads for interpolating a polygon
+
+   The polygon is split into overlapping windows, that are
+   interpolated in parallel. This is only possible for splines derived
+   from QwtSplineInterpolating with a locality() > 0 and without
+   QwtSpline::ClosedPolygon boundaries. For small polygons
+   splitting is not worth the overhead.
+
+   \param numThreads Number of threads to be used for interpolating
+                     a polygon. A value of 0 sets the number of threads to
+                     QThread::idealThreadCount(). The default setting is 1.
+
+   \sa renderThreadCount(), QwtPlotItem::setRenderThreadCount()
+ */
+void QwtSplineCurveFitter::setRenderThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads for interpolating a polygon
+   \sa setRenderThreadCount()
+ */
+uint QwtSplineCurveFitter::renderThreadCount() const
+{
+    return m_data->numThreads;
+}
+
+/*!
+   \brief En/Disable caching the result of the last fit
+
+   When the cache is enabled the input and the result of the last fit
+   are stored. When the next polygon is the same - or a translated copy -
+   the cached result is ( translated and ) returned without
+   evaluating the spline again.
+
+   As the fitter is applied to the points in paint device coordinates,
+   a translated polygon is what happens, when panning a plot
+   horizontally ( or vertically ) with linear scales.
+
+   The cache is disabled by default, as it needs memory for the points
+   and the results of the last fit.
+
+   \param on On/Off
+   \sa isCacheEnabled(), invalidateCache()
+ */
+void QwtSplineCurveFitter::setCacheEnabled( bool on )
+{
+    if ( on != m_data->cache.isEnabled )
+    {
+        m_data->cache.isEnabled = on;
+        m_data->cache.invalidate();
+    }
+}
+
+/*!
+   \return True, when caching the result of the last fit is enabled
+   \sa setCacheEnabled()
+ */
+bool QwtSplineCurveFitter::isCacheEnabled() const
+{
+    return m_data->cache.isEnabled;
+}
+
+/*!
+   Clear the result of the last fit
+
+   The cache needs to be invalidated, when the spline has been
+   modified by spline().
+
+   \sa setCacheEnabled()
+ */
+void QwtSplineCurveFitter::invalidateCache()
+{
+    m_data->cache.invalidate();
+}
+
 /*!
    Find a curve which has the best fit to a series of data points
 
    \param points Series of data points
    \return Fitted Curve
 
-   \sa fitCurvePath()
+   \sa fitCurvePath(), setTolerance()
  */
 QPolygonF QwtSplineCurveFitter::fitCurve( const QPolygonF& points ) const
 {
-    const QPainterPath path = fitCurvePath( points );
+    if ( m_spline == NULL )
+        return QPolygonF();
+
+    const double tolerance = m_data->tolerance;
+
+    if ( tolerance <= 0.0 )
+    {
+        const QPainterPath path = fitCurvePath( points );
+
+        const QList< QPolygonF > subPaths = path.toSubpathPolygons();
+        if ( subPaths.size() == 1 )
+            return subPaths.first();
+
+        return QPolygonF();
+    }
+
+    FitCache& cache = m_data->cache;
+
+    QPointF offset;
+    if ( cache.isEnabled && cache.hasPolygon && cache.tolerance == tolerance
+        && qwtIsTranslated( points, cache.points, offset ) )
+    {
+        return cache.polygon.translated( offset );
+    }
 
-    const QList< QPolygonF > subPaths = path.toSubpathPolygons();
-    if ( subPaths.size() == 1 )
-        subPaths.first();
+    QPolygonF polygon;
 
-    return QPolygonF();
+    QVector< QLineF > controlLines;
+    if ( !qwtEvaluateParallel( m_spline, points,
+        m_data->numThreads, tolerance, controlLines, polygon ) )
+    {
+        polygon = m_spline->polygon( points, tolerance );
+    }
+
+    if ( cache.isEnabled )
+    {
+        cache.assign( points );
+        cache.tolerance = tolerance;
+        cache.polygon = polygon;
+        cache.hasPolygon = true;
+    }
+
+    return polygon;
 }
 
 /*!
@@ -95,8 +503,42 @@ QPainterPath QwtSplineCurveFitter::fitCurvePath( const QPolygonF& points ) const
 {
     QPainterPath path;
 
-    if ( m_spline )
+    if ( m_spline == NULL )
+        return path;
+
+    FitCache& cache = m_data->cache;
+
+    QPointF offset;
+    if ( cache.isEnabled && cache.hasPath
+        && qwtIsTranslated( points, cache.points, offset ) )
+    {
+        return cache.path.translated( offset );
+    }
+
+    QVector< QLineF > controlLines;
+    QPolygonF polygon;
+
+    if ( qwtEvaluateParallel( m_spline, points,
+        m_data->numThreads, 0.0, controlLines, polygon ) )
+    {
+        const QPointF* p = points.constData();
+        const QLineF* l = controlLines.constData();
+
+        path.moveTo( p[0] );
+        for ( int i = 0; i < controlLines.size(); i++ )
+            path.cubicTo( l[i].p1(), l[i].p2(), p[i + 1] );
+    }
+    else
+    {
         path = m_spline->painterPath( points );
+    }
+
+    if ( cache.isEnabled )
+    {
+        cache.assign( points );
+        cache.path = path;
+        cache.hasPath = true;
+    }
 
     return path;
 }
@@ -20,6 +20,16 @@ class QwtSpline;
    The default setting for the spline is a cardinal spline with
    uniform parametrization.
 
+   For local splines ( QwtSpline::locality() > 0 ) the polygon can be
+   split into overlapping windows, that are interpolated in parallel
+   ( setRenderThreadCount() ). As each polynomial depends on a couple
+   of neighbouring points only the result is the same as for the
+   complete polygon.
+
+   When the cache is enabled the result of the last fit is kept
+   and reused, when the next polygon is the same - or only translated,
+   like when panning a plot horizontally.
+
    \sa QwtSpline, QwtSplineLocal
  */
 class QWT_EXPORT QwtSplineCurveFitter : public QwtCurveFitter
@@ -33,11 +43,25 @@ class QWT_EXPORT QwtSplineCurveFitter : public QwtCurveFitter
     const QwtSpline* spline() const;
     QwtSpline* spline();
 
+    void setTolerance( double );
+    double tolerance() const;
+
+    void setRenderThreadCount( uint numThreads );
+    uint renderThreadCount() const;
+
+    void setCacheEnabled( bool );
+    bool isCacheEnabled() const;
+
+    void invalidateCache();
+
     virtual QPolygonF fitCurve( const QPolygonF& ) const QWT_OVERRIDE;
     virtual QPainterPath fitCurvePath( const QPolygonF& ) const QWT_OVERRIDE;
 
   private:
     QwtSpline* m_spline;
+
+    class PrivateData;
+    PrivateData* m_data;
 };
 
 #endif
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_swap_buffer_series_data.h"
+#include "qwt_atomic_p.h"
+
+#include <algorithm>
+
+class QwtSwapBufferSeriesData::PrivateData
+{
+  public:
+    /*
+        The index of the buffer in between is stored together
+        with a flag, that indicates if it has been published
+        after the last update().
+     */
+    enum { IndexMask = 0x03, Published = 0x04 };
+
+    PrivateData()
+        : frontIndex( 0 )
+        , backIndex( 1 )
+        , swapIndex( 2 )
+    {
+    }
+
+    QVector< QPointF > buffers[3];
+
+    // only accessed by the consumer
+    int frontIndex;
+
+    // only accessed by the producer
+    int backIndex;
+
+    // exchanged between producer and consumer
+    QAtomicInt swapIndex;
+};
+
+//! Constructor
+QwtSwapBufferSeriesData::QwtSwapBufferSeriesData()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtSwapBufferSeriesData::~QwtSwapBufferSeriesData()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Buffer, that can be filled by the producer thread
+
+   The buffer is a recycled one and contains the samples of a previous
+   round. It is up to the producer to resize and overwrite them.
+
+   \return Back buffer
+   \sa publish()
+ */
+QVector< QPointF >& QwtSwapBufferSeriesData::backBuffer()
+{
+    return m_data->buffers[ m_data->backIndex ];
+}
+
+/*!
+   \brief Publish the back buffer
+
+   The back buffer becomes the most recent buffer, that will be
+   taken by the next update(). publish() is wait-free and intended
+   to be called from the producer thread.
+
+   \sa backBuffer(), update()
+ */
+void QwtSwapBufferSeriesData::publish()
+{
+    const int index = m_data->swapIndex.fetchAndStoreOrdered(
+        m_data->backIndex | PrivateData::Published );
+
+    m_data->backIndex = index & PrivateData::IndexMask;
+}
+
+/*!
+   \brief Copy samples into the back buffer and publish it
+
+   The memory of the back buffer is reused, as long as
+   its capacity is large enough.
+
+   \param samples Samples
+   \sa publish()
+ */
+void QwtSwapBufferSeriesData::publish( const QVector< QPointF >& samples )
+{
+    QVector< QPointF >& buffer = backBuffer();
+
+    buffer.resize( samples.size() );
+    std::copy( samples.constBegin(), samples.constEnd(), buffer.begin() );
+
+    publish();
+}
+
+//! \return true, when a buffer has been published after the last update()
+bool QwtSwapBufferSeriesData::hasPendingBuffer() const
+{
+    return qwtLoadAcquire( m_data->swapIndex ) & PrivateData::Published;
+}
+
+/*!
+   \brief Take the most recent buffer as front buffer
+
+   update() has to be called from the consumer ( usually the GUI ) thread
+   before replotting. Between 2 calls of update() the front buffer is stable,
+   so that the plot items can iterate over the samples without interference
+   of the producer thread.
+
+   \return true, when the front buffer has been replaced
+ */
+bool QwtSwapBufferSeriesData::update()
+{
+    if ( !hasPendingBuffer() )
+        return false;
+
+    const int index = m_data->swapIndex.fetchAndStoreOrdered( m_data->frontIndex );
+    m_data->frontIndex = index & PrivateData::IndexMask;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    return true;
+}
+
+//! \return Samples of the front buffer
+const QVector< QPointF >& QwtSwapBufferSeriesData::frontBuffer() const
+{
+    return m_data->buffers[ m_data->frontIndex ];
+}
+
+//! \return Number of samples of the front buffer
+size_t QwtSwapBufferSeriesData::size() const
+{
+    return frontBuffer().size();
+}
+
+/*!
+   \param index Index
+   \return Sample of the front buffer at position index
+ */
+QPointF QwtSwapBufferSeriesData::sample( size_t index ) const
+{
+    return frontBuffer()[ int( index ) ];
+}
+
+/*!
+   Copy a block of samples from the front buffer
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+void QwtSwapBufferSeriesData::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const QPointF* values = frontBuffer().constData() + from;
+    std::copy( values, values + numSamples, samples );
+}
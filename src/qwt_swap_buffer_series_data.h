@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SWAP_BUFFER_SERIES_DATA_H
+#define QWT_SWAP_BUFFER_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qvector.h>
+
+/*!
+   \brief Series of points, that is replaced as a whole by a producer thread
+
+   QwtSwapBufferSeriesData is a double buffered series: the plot items
+   read from a front buffer, while a producer thread fills a back buffer.
+   A third buffer is kept in between, so that both sides can exchange
+   their buffers with a single atomic operation - no locks are involved:
+
+   - backBuffer() and publish() may be called from the producer thread.
+     publish() makes the filled back buffer the most recent one. Then
+     backBuffer() returns a recycled buffer for the next round.
+
+   - update() has to be called from the GUI thread, before the plot gets
+     replotted. It takes the most recent buffer as front buffer.
+
+   - size(), sample() and boundingRect() operate on the front buffer and
+     don't change between 2 calls of update(). So they are only allowed
+     to be called from the GUI thread.
+
+   Buffers are recycled, so that their memory is not reallocated,
+   as long as the number of samples doesn't grow.
+
+   \par Example
+   \code
+   QwtSwapBufferSeriesData* data = new QwtSwapBufferSeriesData();
+   curve->setData( data );
+
+   // producer thread
+   QVector< QPointF >& buffer = data->backBuffer();
+   buffer.resize( numSamples );
+   ... // fill the buffer
+   data->publish();
+
+   // f.e. in a timer event of the GUI thread
+   if ( data->update() )
+       plot->replot();
+   \endcode
+   \endpar
+
+   \note Only one producer and one consumer thread are supported.
+         Buffers published in between 2 calls of update() are skipped.
+
+   \sa QwtRingBufferSeriesData
+ */
+class QWT_EXPORT QwtSwapBufferSeriesData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtSwapBufferSeriesData();
+    virtual ~QwtSwapBufferSeriesData();
+
+    QVector< QPointF >& backBuffer();
+    void publish();
+    void publish( const QVector< QPointF >& );
+
+    bool hasPendingBuffer() const;
+    bool update();
+
+    const QVector< QPointF >& frontBuffer() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void fetch( size_t from, size_t numSamples,
+        QPointF* samples ) const QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtSwapBufferSeriesData )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -11,11 +11,14 @@
 #include "qwt_painter.h"
 #include "qwt_graphic.h"
 #include "qwt_math.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpixmap.h>
 #include <qpaintengine.h>
+#include <qcoreapplication.h>
+#include <qthread.h>
 #ifndef QWT_NO_SVG
 #include <qsvgrenderer.h>
 #endif
@@ -31,6 +34,12 @@ namespace QwtTriangle
     };
 }
 
+static inline bool qwtIsGuiThread()
+{
+    const QCoreApplication* app = QCoreApplication::instance();
+    return ( app != NULL ) && ( QThread::currentThread() == app->thread() );
+}
+
 static QwtGraphic qwtPathGraphic( const QPainterPath& path,
     const QPen& pen, const QBrush& brush )
 {
@@ -777,6 +786,7 @@ class QwtSymbol::PrivateData
         , brush( br )
         , pen( pn )
         , isPinPointEnabled( false )
+        , cacheEntry( this )
     {
         cache.policy = QwtSymbol::AutoCache;
 #ifndef QWT_NO_SVG
@@ -831,6 +841,27 @@ class QwtSymbol::PrivateData
         QPixmap pixmap;
 
     } cache;
+
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::SymbolCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            m_data->cache.pixmap = QPixmap();
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    CacheEntry cacheEntry;
 };
 
 /*!
@@ -1313,10 +1344,13 @@ void QwtSymbol::drawSymbols( QPainter* painter,
     bool useCache = false;
 
     // Don't use the pixmap, when the paint device
-    // could generate scalable vectors
+    // could generate scalable vectors. Pixmaps must not be created
+    // outside of the GUI thread - f.e. QwtPlot::setParallelItemRendering() -
+    // and the cache is not guarded against being accessed from
+    // several threads.
 
     if ( QwtPainter::roundingAlignment( painter ) &&
-        !painter->transform().isScaling() )
+        !painter->transform().isScaling() && qwtIsGuiThread() )
     {
         if ( m_data->cache.policy == QwtSymbol::Cache )
         {
@@ -1398,6 +1432,13 @@ void QwtSymbol::drawSymbols( QPainter* painter,
 
             const QPointF pos( 0.0, 0.0 );
             renderSymbols( &p, &pos, 1 );
+
+            m_data->cacheEntry.setMemoryUsage(
+                QwtCacheEntry::pixmapSize( m_data->cache.pixmap ) );
+        }
+        else
+        {
+            m_data->cacheEntry.touch();
         }
 
         const int dx = br.left();
@@ -1770,7 +1811,10 @@ QRect QwtSymbol::boundingRect() const
 void QwtSymbol::invalidateCache()
 {
     if ( !m_data->cache.pixmap.isNull() )
+    {
         m_data->cache.pixmap = QPixmap();
+        m_data->cacheEntry.setMemoryUsage( 0 );
+    }
 }
 
 /*!
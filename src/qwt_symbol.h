@@ -143,7 +143,8 @@ class QWT_EXPORT QwtSymbol
        \sa setCachePolicy(), cachePolicy()
 
        \note The policy has no effect, when the symbol is painted
-            to a vector graphics format ( PDF, SVG ).
+            to a vector graphics format ( PDF, SVG ) or outside
+            of the GUI thread.
        \warning Since Qt 4.8 raster is the default backend on X11
      */
 
@@ -0,0 +1,476 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_symbol_atlas.h"
+#include "qwt_symbol.h"
+#include "qwt_painter.h"
+#include "qwt_graphic.h"
+
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qpixmap.h>
+#include <qpaintengine.h>
+#include <qmath.h>
+
+namespace
+{
+    // the attributes of the symbol, the atlas has been rendered for
+
+    class SymbolKey
+    {
+      public:
+        SymbolKey()
+            : style( QwtSymbol::NoSymbol )
+            , isPinPointEnabled( false )
+            , pixmapKey( 0 )
+        {
+        }
+
+        SymbolKey( const QwtSymbol& symbol, QPainter::RenderHints hints )
+            : style( symbol.style() )
+            , brush( symbol.brush() )
+            , pen( symbol.pen() )
+            , size( symbol.size() )
+            , path( symbol.path() )
+            , pinPoint( symbol.pinPoint() )
+            , isPinPointEnabled( symbol.isPinPointEnabled() )
+            , pixmapKey( symbol.pixmap().cacheKey() )
+            , renderHints( hints )
+        {
+        }
+
+        bool operator==( const SymbolKey& other ) const
+        {
+            return ( style == other.style )
+                && ( brush == other.brush )
+                && ( pen == other.pen )
+                && ( size == other.size )
+                && ( path == other.path )
+                && ( pinPoint == other.pinPoint )
+                && ( isPinPointEnabled == other.isPinPointEnabled )
+                && ( pixmapKey == other.pixmapKey )
+                && ( renderHints == other.renderHints );
+        }
+
+      private:
+        QwtSymbol::Style style;
+        QBrush brush;
+        QPen pen;
+        QSize size;
+        QPainterPath path;
+        QPointF pinPoint;
+        bool isPinPointEnabled;
+        qint64 pixmapKey;
+        QPainter::RenderHints renderHints;
+    };
+}
+
+static QwtSymbol* qwtCloneSymbol( const QwtSymbol& symbol )
+{
+    QwtSymbol* clone = NULL;
+
+    switch ( symbol.style() )
+    {
+        case QwtSymbol::NoSymbol:
+        case QwtSymbol::SvgDocument:
+        {
+            // the SVG document is not accessible
+            break;
+        }
+        case QwtSymbol::Path:
+        {
+            clone = new QwtSymbol( symbol.path(), symbol.brush(), symbol.pen() );
+            break;
+        }
+        case QwtSymbol::Pixmap:
+        {
+            clone = new QwtSymbol();
+            clone->setPixmap( symbol.pixmap() );
+            break;
+        }
+        case QwtSymbol::Graphic:
+        {
+            clone = new QwtSymbol();
+            clone->setGraphic( symbol.graphic() );
+            break;
+        }
+        default:
+        {
+            if ( symbol.style() < QwtSymbol::UserStyle )
+            {
+                clone = new QwtSymbol( symbol.style(),
+                    symbol.brush(), symbol.pen(), symbol.size() );
+            }
+        }
+    }
+
+    if ( clone )
+    {
+        clone->setSize( symbol.size() );
+        clone->setPinPoint( symbol.pinPoint(), symbol.isPinPointEnabled() );
+        clone->setCachePolicy( QwtSymbol::NoCache );
+    }
+
+    return clone;
+}
+
+static inline void qwtSetSymbolColor( QwtSymbol* symbol, const QColor& color )
+{
+    if ( symbol->style() == QwtSymbol::Path )
+    {
+        // QwtSymbol::setColor does not invalidate the path graphic
+
+        QBrush brush = symbol->brush();
+        brush.setColor( color );
+        symbol->setBrush( brush );
+
+        QPen pen = symbol->pen();
+        pen.setColor( color );
+        symbol->setPen( pen );
+    }
+    else
+    {
+        symbol->setColor( color );
+    }
+}
+
+static inline bool qwtIsRasterPainter( const QPainter* painter )
+{
+    if ( !QwtPainter::roundingAlignment( painter ) ||
+        painter->transform().isScaling() )
+    {
+        return false;
+    }
+
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::OpenVG:
+        case QPaintEngine::SVG:
+        case QPaintEngine::Pdf:
+        case QPaintEngine::Picture:
+        {
+            // vector graphics
+            return false;
+        }
+        default:
+            break;
+    }
+
+    return true;
+}
+
+class QwtSymbolAtlas::PrivateData
+{
+  public:
+    PrivateData()
+        : pixelRatio( 1.0 )
+    {
+    }
+
+    void render( QwtSymbol*, QPainter::RenderHints );
+
+    inline int variantIndex( const unsigned char* colorIndexes,
+        const unsigned char* sizeIndexes, int pos ) const
+    {
+        const int numSizes = qMax( sizes.size(), 1 );
+
+        int colorIndex = 0;
+        if ( colorIndexes )
+            colorIndex = qMin( int( colorIndexes[pos] ), colorTable.size() - 1 );
+
+        int sizeIndex = 0;
+        if ( sizeIndexes )
+            sizeIndex = qMin( int( sizeIndexes[pos] ), numSizes - 1 );
+
+        return qMax( colorIndex, 0 ) * numSizes + sizeIndex;
+    }
+
+    QVector< QRgb > colorTable;
+    QVector< QSize > sizes;
+
+    SymbolKey key;
+
+    QPixmap pixmap;
+    qreal pixelRatio;
+
+    // source rectangles in device pixels
+    QVector< QRectF > sourceRects;
+
+    // center of a variant, relative to the position of the symbol
+    QVector< QPointF > centers;
+};
+
+void QwtSymbolAtlas::PrivateData::render(
+    QwtSymbol* symbol, QPainter::RenderHints renderHints )
+{
+    const int numColors = qMax( colorTable.size(), 1 );
+    const int numSizes = qMax( sizes.size(), 1 );
+    const int numVariants = numColors * numSizes;
+
+    QVector< QRect > boundingRects( numSizes );
+
+    QSize cellSize( 1, 1 );
+    for ( int i = 0; i < numSizes; i++ )
+    {
+        if ( !sizes.isEmpty() )
+            symbol->setSize( sizes[i] );
+
+        boundingRects[i] = symbol->boundingRect();
+        cellSize = cellSize.expandedTo( boundingRects[i].size() );
+    }
+
+    // a gap between the cells avoids bleeding, when being smoothed
+
+    cellSize += QSize( 1, 1 );
+
+    const int numColumns = qCeil( qSqrt( double( numVariants ) ) );
+    const int numRows = ( numVariants + numColumns - 1 ) / numColumns;
+
+    pixmap = QwtPainter::backingStore( NULL,
+        QSize( numColumns * cellSize.width(), numRows * cellSize.height() ) );
+    pixmap.fill( Qt::transparent );
+
+#if QT_VERSION >= 0x050000
+    pixelRatio = pixmap.devicePixelRatio();
+#else
+    pixelRatio = 1.0;
+#endif
+
+    sourceRects.resize( numVariants );
+    centers.resize( numVariants );
+
+    QPainter painter( &pixmap );
+    painter.setRenderHints( renderHints );
+
+    for ( int colorIndex = 0; colorIndex < numColors; colorIndex++ )
+    {
+        if ( !colorTable.isEmpty() )
+            qwtSetSymbolColor( symbol, QColor::fromRgba( colorTable[colorIndex] ) );
+
+        for ( int sizeIndex = 0; sizeIndex < numSizes; sizeIndex++ )
+        {
+            if ( !sizes.isEmpty() )
+                symbol->setSize( sizes[sizeIndex] );
+
+            const int index = colorIndex * numSizes + sizeIndex;
+
+            const QPoint cellPos( ( index % numColumns ) * cellSize.width(),
+                ( index / numColumns ) * cellSize.height() );
+
+            const QRect& br = boundingRects[sizeIndex];
+            symbol->drawSymbol( &painter, QPointF( cellPos - br.topLeft() ) );
+
+            sourceRects[index] = QRectF( QPointF( cellPos ) * pixelRatio,
+                QSizeF( br.size() ) * pixelRatio );
+
+            centers[index] = QRectF( br ).center();
+        }
+    }
+}
+
+/*!
+   \brief Constructor
+
+   The color and size tables are empty, what means, that
+   all symbols are painted with the attributes of the symbol.
+ */
+QwtSymbolAtlas::QwtSymbolAtlas()
+{
+    m_data = new PrivateData();
+}
+
+//! Destructor
+QwtSymbolAtlas::~QwtSymbolAtlas()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Assign the quantized colors
+
+   For the Ellipse, Rect, Diamond, Triangle, Star2 and Hexagon styles the
+   colors are applied to the brush, for all others to pen and brush
+   - see QwtSymbol::setColor().
+
+   \param colorTable Colors, that can be indexed by drawSymbols().
+          An empty table means, that the colors of the symbol are used.
+
+   \note The table shouldn't have more than 256 entries
+   \sa colorTable(), drawSymbols()
+ */
+void QwtSymbolAtlas::setColorTable( const QVector< QRgb >& colorTable )
+{
+    if ( colorTable != m_data->colorTable )
+    {
+        m_data->colorTable = colorTable;
+        invalidate();
+    }
+}
+
+/*!
+   \return Quantized colors
+   \sa setColorTable()
+ */
+QVector< QRgb > QwtSymbolAtlas::colorTable() const
+{
+    return m_data->colorTable;
+}
+
+/*!
+   \brief Assign the quantized symbol sizes
+
+   \param sizes Sizes, that can be indexed by drawSymbols().
+          An empty table means, that the size of the symbol is used.
+
+   \note The table shouldn't have more than 256 entries
+   \sa sizes(), drawSymbols()
+ */
+void QwtSymbolAtlas::setSizes( const QVector< QSize >& sizes )
+{
+    if ( sizes != m_data->sizes )
+    {
+        m_data->sizes = sizes;
+        invalidate();
+    }
+}
+
+/*!
+   \return Quantized symbol sizes
+   \sa setSizes()
+ */
+QVector< QSize > QwtSymbolAtlas::sizes() const
+{
+    return m_data->sizes;
+}
+
+/*!
+   \brief Discard the prerendered pixmap
+
+   Modifications of the symbol attributes are detected, beside the
+   graphic of a QwtSymbol::Graphic symbol. In this case
+   invalidate() has to be called manually.
+ */
+void QwtSymbolAtlas::invalidate()
+{
+    m_data->pixmap = QPixmap();
+    m_data->sourceRects.clear();
+    m_data->centers.clear();
+}
+
+/*!
+   \brief Draw symbols with individual colors and sizes
+
+   \param painter Painter
+   \param symbol Symbol
+   \param points Positions of the symbols in screen coordinates
+   \param colorIndexes Indexes into colorTable() for each point,
+                       or NULL to use the color of the symbol
+   \param sizeIndexes Indexes into sizes() for each point,
+                      or NULL to use the size of the symbol
+   \param numPoints Number of points
+
+   Indexes beyond the tables are bounded to the last entry.
+ */
+void QwtSymbolAtlas::drawSymbols( QPainter* painter, const QwtSymbol& symbol,
+    const QPointF* points, const unsigned char* colorIndexes,
+    const unsigned char* sizeIndexes, int numPoints ) const
+{
+    if ( numPoints <= 0 || symbol.style() == QwtSymbol::NoSymbol )
+        return;
+
+    if ( m_data->colorTable.isEmpty() )
+        colorIndexes = NULL;
+
+    if ( m_data->sizes.isEmpty() )
+        sizeIndexes = NULL;
+
+    if ( colorIndexes == NULL && sizeIndexes == NULL )
+    {
+        symbol.drawSymbols( painter, points, numPoints );
+        return;
+    }
+
+    if ( !qwtIsRasterPainter( painter ) )
+    {
+        // one by one, using a symbol with modified attributes
+
+        QwtSymbol* clone = qwtCloneSymbol( symbol );
+        if ( clone == NULL )
+        {
+            symbol.drawSymbols( painter, points, numPoints );
+            return;
+        }
+
+        for ( int i = 0; i < numPoints; i++ )
+        {
+            if ( colorIndexes )
+            {
+                const int index = qMin( int( colorIndexes[i] ),
+                    m_data->colorTable.size() - 1 );
+
+                qwtSetSymbolColor( clone,
+                    QColor::fromRgba( m_data->colorTable[index] ) );
+            }
+
+            if ( sizeIndexes )
+            {
+                const int index = qMin( int( sizeIndexes[i] ),
+                    m_data->sizes.size() - 1 );
+
+                clone->setSize( m_data->sizes[index] );
+            }
+
+            clone->drawSymbol( painter, points[i] );
+        }
+
+        delete clone;
+        return;
+    }
+
+    const SymbolKey key( symbol, painter->renderHints() );
+    if ( m_data->pixmap.isNull() || !( key == m_data->key ) )
+    {
+        QwtSymbol* clone = qwtCloneSymbol( symbol );
+        if ( clone == NULL )
+        {
+            symbol.drawSymbols( painter, points, numPoints );
+            return;
+        }
+
+        m_data->render( clone, painter->renderHints() );
+        m_data->key = key;
+
+        delete clone;
+    }
+
+    const qreal scale = 1.0 / m_data->pixelRatio;
+
+    const int chunkSize = 1024;
+    QVector< QPainter::PixmapFragment > fragments( qMin( numPoints, chunkSize ) );
+
+    for ( int i0 = 0; i0 < numPoints; i0 += chunkSize )
+    {
+        const int n = qMin( chunkSize, numPoints - i0 );
+
+        for ( int j = 0; j < n; j++ )
+        {
+            const int i = i0 + j;
+            const int index = m_data->variantIndex( colorIndexes, sizeIndexes, i );
+
+            const QPointF& center = m_data->centers[index];
+            const QPointF pos( qRound( points[i].x() ) + center.x(),
+                qRound( points[i].y() ) + center.y() );
+
+            fragments[j] = QPainter::PixmapFragment::create(
+                pos, m_data->sourceRects[index], scale, scale );
+        }
+
+        painter->drawPixmapFragments( fragments.constData(), n, m_data->pixmap );
+    }
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SYMBOL_ATLAS_H
+#define QWT_SYMBOL_ATLAS_H
+
+#include "qwt_global.h"
+
+#include <qvector.h>
+#include <qcolor.h>
+
+class QwtSymbol;
+class QPainter;
+class QPointF;
+class QSize;
+
+/*!
+   \brief Pixmap with prerendered variants of a symbol
+
+   QwtSymbolAtlas renders a symbol for a quantized set of colors
+   and sizes into a single pixmap. Symbols, where each point has its
+   individual color and size, are painted in bulk by
+   QPainter::drawPixmapFragments() from this pixmap.
+
+   The variants are identified by an index into the color table and
+   an index into the table of sizes. The atlas is rendered on demand
+   and kept until one of the tables or one of the attributes
+   of the symbol ( style, brush, pen, size, path, pin point ) has changed.
+
+   When painting to a vector graphics format, or when the symbol
+   cannot be copied ( QwtSymbol::SvgDocument, QwtSymbol::UserStyle )
+   the symbols are rendered one by one without using the atlas.
+
+   \sa QwtPlotSpectroCurve::setSymbol()
+ */
+class QWT_EXPORT QwtSymbolAtlas
+{
+  public:
+    QwtSymbolAtlas();
+    ~QwtSymbolAtlas();
+
+    void setColorTable( const QVector< QRgb >& );
+    QVector< QRgb > colorTable() const;
+
+    void setSizes( const QVector< QSize >& );
+    QVector< QSize > sizes() const;
+
+    void invalidate();
+
+    void drawSymbols( QPainter*, const QwtSymbol&,
+        const QPointF* points, const unsigned char* colorIndexes,
+        const unsigned char* sizeIndexes, int numPoints ) const;
+
+  private:
+    Q_DISABLE_COPY(QwtSymbolAtlas)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
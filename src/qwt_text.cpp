@@ -18,6 +18,11 @@
 #include <qpen.h>
 #include <qbrush.h>
 #include <qpainter.h>
+#include <qmutex.h>
+
+#ifndef QT_NO_RICHTEXT
+#include <qtextdocument.h>
+#endif
 
 #if QT_VERSION >= 0x050200
 
@@ -61,6 +66,8 @@ namespace
         TextEngineDict();
         ~TextEngineDict();
 
+        void createRichTextEngine() const;
+
         typedef QMap< int, QwtTextEngine* > EngineMap;
 
         inline const QwtTextEngine* engine( EngineMap::const_iterator& it ) const
@@ -68,7 +75,12 @@ namespace
             return it.value();
         }
 
-        EngineMap m_map;
+        // texts might be created and laid out from worker threads
+        mutable QMutex m_mutex;
+        mutable EngineMap m_map;
+
+        // the default engine for rich texts is created on demand
+        mutable bool m_richTextPending;
     };
 
     TextEngineDict& TextEngineDict::dict()
@@ -80,8 +92,22 @@ namespace
     TextEngineDict::TextEngineDict()
     {
         m_map.insert( QwtText::PlainText, new QwtPlainTextEngine() );
+
+    #ifndef QT_NO_RICHTEXT
+        m_richTextPending = true;
+    #else
+        m_richTextPending = false;
+    #endif
+    }
+
+    void TextEngineDict::createRichTextEngine() const
+    {
     #ifndef QT_NO_RICHTEXT
-        m_map.insert( QwtText::RichText, new QwtRichTextEngine() );
+        if ( m_richTextPending )
+        {
+            m_richTextPending = false;
+            m_map.insert( QwtText::RichText, new QwtRichTextEngine() );
+        }
     #endif
     }
 
@@ -98,8 +124,20 @@ namespace
     const QwtTextEngine* TextEngineDict::textEngine( const QString& text,
         QwtText::TextFormat format ) const
     {
+        QMutexLocker locker( &m_mutex );
+
         if ( format == QwtText::AutoText )
         {
+            /*
+                As long as the rich text engine has not been created
+                we can check the text without it. Plain texts - what
+                most labels are - never need the engine.
+             */
+        #ifndef QT_NO_RICHTEXT
+            if ( m_richTextPending && Qt::mightBeRichText( text ) )
+                createRichTextEngine();
+        #endif
+
             for ( EngineMap::const_iterator it = m_map.begin();
                 it != m_map.end(); ++it )
             {
@@ -111,6 +149,10 @@ namespace
                 }
             }
         }
+        else if ( format == QwtText::RichText )
+        {
+            createRichTextEngine();
+        }
 
         EngineMap::const_iterator it = m_map.find( format );
         if ( it != m_map.end() )
@@ -133,6 +175,11 @@ namespace
         if ( format == QwtText::PlainText && engine == NULL )
             return;
 
+        QMutexLocker locker( &m_mutex );
+
+        if ( format == QwtText::RichText )
+            m_richTextPending = false;
+
         EngineMap::const_iterator it = m_map.constFind( format );
         if ( it != m_map.constEnd() )
         {
@@ -147,6 +194,11 @@ namespace
     const QwtTextEngine* TextEngineDict::textEngine(
         QwtText::TextFormat format ) const
     {
+        QMutexLocker locker( &m_mutex );
+
+        if ( format == QwtText::RichText )
+            createRichTextEngine();
+
         const QwtTextEngine* e = NULL;
 
         EngineMap::const_iterator it = m_map.find( format );
@@ -157,7 +209,7 @@ namespace
     }
 }
 
-class QwtText::PrivateData
+class QwtText::PrivateData : public QSharedData
 {
   public:
     PrivateData():
@@ -181,6 +233,27 @@ class QwtText::PrivateData
     QwtText::LayoutAttributes layoutAttributes;
 
     const QwtTextEngine* textEngine;
+
+    static QSharedDataPointer< PrivateData > defaultData()
+    {
+        /*
+            Default constructed texts are very common ( f.e. titles
+            of items or axes ). They all share the same data, so that
+            no allocation is needed, unless a text gets modified.
+         */
+
+        static const QSharedDataPointer< PrivateData > data( createDefault() );
+        return data;
+    }
+
+  private:
+    static PrivateData* createDefault()
+    {
+        PrivateData* data = new PrivateData;
+        data->textEngine = QwtText::textEngine( data->text, PlainText );
+
+        return data;
+    }
 };
 
 class QwtText::LayoutCache
@@ -199,10 +272,8 @@ class QwtText::LayoutCache
    Constructor
  */
 QwtText::QwtText()
+    : m_data( PrivateData::defaultData() )
 {
-    m_data = new PrivateData;
-    m_data->textEngine = textEngine( m_data->text, PlainText );
-
     m_layoutCache = new LayoutCache;
 }
 
@@ -213,8 +284,8 @@ QwtText::QwtText()
    \param textFormat Text format
  */
 QwtText::QwtText( const QString& text, QwtText::TextFormat textFormat )
+    : m_data( new PrivateData )
 {
-    m_data = new PrivateData;
     m_data->text = text;
     m_data->textEngine = textEngine( text, textFormat );
 
@@ -223,10 +294,8 @@ QwtText::QwtText( const QString& text, QwtText::TextFormat textFormat )
 
 //! Copy constructor
 QwtText::QwtText( const QwtText& other )
+    : m_data( other.m_data )
 {
-    m_data = new PrivateData;
-    *m_data = *other.m_data;
-
     m_layoutCache = new LayoutCache;
     *m_layoutCache = *other.m_layoutCache;
 }
@@ -234,14 +303,13 @@ QwtText::QwtText( const QwtText& other )
 //! Destructor
 QwtText::~QwtText()
 {
-    delete m_data;
     delete m_layoutCache;
 }
 
 //! Assignment operator
 QwtText& QwtText::operator=( const QwtText& other )
 {
-    *m_data = *other.m_data;
+    m_data = other.m_data;
     *m_layoutCache = *other.m_layoutCache;
     return *this;
 }
@@ -670,8 +738,40 @@ void QwtText::draw( QPainter* painter, const QRectF& rect ) const
         expandedRect.setRight( rect.right() + right );
     }
 
-    m_data->textEngine->draw( painter, expandedRect,
-        m_data->renderFlags, m_data->text );
+    if ( QwtPainter::isMeasureOnly( painter ) )
+    {
+        // the geometry of the text, without shaping the glyphs
+
+        QSizeF size = textSize( painter->font() );
+        size = size.boundedTo( rect.size() );
+
+        QRectF textRect( QPointF( 0.0, 0.0 ), size );
+
+        const int flags = m_data->renderFlags;
+
+        if ( flags & Qt::AlignRight )
+            textRect.moveRight( rect.right() );
+        else if ( flags & Qt::AlignHCenter )
+            textRect.moveLeft( rect.center().x() - 0.5 * size.width() );
+        else
+            textRect.moveLeft( rect.left() );
+
+        if ( flags & Qt::AlignBottom )
+            textRect.moveBottom( rect.bottom() );
+        else if ( flags & Qt::AlignVCenter )
+            textRect.moveTop( rect.center().y() - 0.5 * size.height() );
+        else
+            textRect.moveTop( rect.top() );
+
+        painter->setBrush( painter->pen().color() );
+        painter->setPen( Qt::NoPen );
+        painter->drawRect( textRect );
+    }
+    else
+    {
+        m_data->textEngine->draw( painter, expandedRect,
+            m_data->renderFlags, m_data->text );
+    }
 
     painter->restore();
 }
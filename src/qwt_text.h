@@ -12,6 +12,7 @@
 
 #include "qwt_global.h"
 #include <qmetatype.h>
+#include <qshareddata.h>
 
 class QFont;
 class QString;
@@ -45,6 +46,9 @@ class QwtTextEngine;
     Flags from Qt::AlignmentFlag and Qt::TextFlag used like in
     QPainter::drawText().
 
+   QwtText is implicitly shared: copies share the same attributes
+   until one of them gets modified.
+
    \sa QwtTextEngine, QwtTextLabel
  */
 
@@ -204,7 +208,7 @@ class QWT_EXPORT QwtText
 
   private:
     class PrivateData;
-    PrivateData* m_data;
+    QSharedDataPointer< PrivateData > m_data;
 
     class LayoutCache;
     LayoutCache* m_layoutCache;
@@ -9,11 +9,13 @@
 
 #include "qwt_text_engine.h"
 #include "qwt_painter.h"
+#include "qwt_cache_registry.h"
 
 #include <qpainter.h>
-#include <qpixmap.h>
 #include <qimage.h>
 #include <qmap.h>
+#include <qcache.h>
+#include <qmutex.h>
 #include <qwidget.h>
 #include <qtextobject.h>
 #include <qtextdocument.h>
@@ -80,21 +82,56 @@ namespace
     };
 }
 
+/*
+    The text engines are shared by all texts and might be used
+    from different threads. So the caches are protected by a mutex,
+    while the expensive calculations are done without holding it.
+ */
 class QwtPlainTextEngine::PrivateData
 {
   public:
+    PrivateData()
+        : m_memory( 0 )
+        , m_cacheEntry( this )
+    {
+    }
+
     int effectiveAscent( const QFont& font ) const
     {
         const QString fontKey = font.key();
 
-        QMap< QString, int >::const_iterator it =
-            m_ascentCache.constFind( fontKey );
+        {
+            QMutexLocker locker( &m_mutex );
+
+            QMap< QString, int >::const_iterator it =
+                m_ascentCache.constFind( fontKey );
 
-        if ( it != m_ascentCache.constEnd() )
-            return *it;
+            if ( it != m_ascentCache.constEnd() )
+            {
+                m_cacheEntry.touch();
+                return *it;
+            }
+        }
 
         const int ascent = findAscent( font );
-        m_ascentCache.insert( fontKey, ascent );
+
+        qint64 memory;
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( !m_ascentCache.contains( fontKey ) )
+            {
+                // key, value and an estimation for the node of the map
+                m_memory += fontKey.size() * qint64( sizeof( QChar ) )
+                    + qint64( sizeof( int ) ) + 64;
+            }
+
+            m_ascentCache.insert( fontKey, ascent );
+            memory = m_memory;
+        }
+
+        // the registry might purge the cache: not holding the mutex
+        m_cacheEntry.setMemoryUsage( memory );
 
         return ascent;
     }
@@ -107,23 +144,23 @@ class QwtPlainTextEngine::PrivateData
 
         const QFontMetrics fm( font );
 
-        QPixmap pm( QwtPainter::horizontalAdvance( fm, dummy ), fm.height() );
-        pm.fill( white );
+        // QPixmap is not available outside of the GUI thread
+        QImage img( QwtPainter::horizontalAdvance( fm, dummy ),
+            fm.height(), QImage::Format_RGB32 );
+        img.fill( white );
 
-        QPainter p( &pm );
+        QPainter p( &img );
         p.setFont( font );
-        p.drawText( 0, 0,  pm.width(), pm.height(), 0, dummy );
+        p.drawText( 0, 0,  img.width(), img.height(), 0, dummy );
         p.end();
 
-        const QImage img = pm.toImage();
-
         int row = 0;
         for ( row = 0; row < img.height(); row++ )
         {
             const QRgb* line = reinterpret_cast< const QRgb* >(
-                img.scanLine( row ) );
+                img.constScanLine( row ) );
 
-            const int w = pm.width();
+            const int w = img.width();
             for ( int col = 0; col < w; col++ )
             {
                 if ( line[col] != white.rgb() )
@@ -134,7 +171,33 @@ class QwtPlainTextEngine::PrivateData
         return fm.ascent();
     }
 
+    class CacheEntry : public QwtCacheEntry
+    {
+      public:
+        explicit CacheEntry( PrivateData* data )
+            : QwtCacheEntry( QwtCacheRegistry::TextCache )
+            , m_data( data )
+        {
+        }
+
+      protected:
+        virtual void purge() QWT_OVERRIDE
+        {
+            QMutexLocker locker( &m_data->m_mutex );
+
+            m_data->m_ascentCache.clear();
+            m_data->m_memory = 0;
+        }
+
+      private:
+        PrivateData* m_data;
+    };
+
+    mutable QMutex m_mutex;
     mutable QMap< QString, int > m_ascentCache;
+    mutable qint64 m_memory;
+
+    mutable CacheEntry m_cacheEntry;
 };
 
 //! Constructor
@@ -244,9 +307,46 @@ bool QwtPlainTextEngine::mightRender( const QString& ) const
 
 #ifndef QT_NO_RICHTEXT
 
+/*
+    Building a QTextDocument is expensive, while the layout code
+    asks for the same sizes over and over again. So the results are
+    kept in a LRU cache, keyed by text, font and flags.
+ */
+class QwtRichTextEngine::PrivateData
+{
+  public:
+    PrivateData()
+        : sizeCache( MaxEntries )
+        , heightCache( MaxEntries )
+    {
+    }
+
+    static inline QString cacheKey( const QFont& font,
+        int flags, const QString& text )
+    {
+        const QChar separator( 0x1f );
+
+        return font.key() + separator
+            + QString::number( flags ) + separator + text;
+    }
+
+    enum { MaxEntries = 500 };
+
+    QMutex mutex;
+    QCache< QString, QSizeF > sizeCache;
+    QCache< QString, double > heightCache;
+};
+
 //! Constructor
 QwtRichTextEngine::QwtRichTextEngine()
 {
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtRichTextEngine::~QwtRichTextEngine()
+{
+    delete m_data;
 }
 
 /*!
@@ -262,10 +362,25 @@ QwtRichTextEngine::QwtRichTextEngine()
 double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
     const QString& text, double width ) const
 {
+    const QString key = PrivateData::cacheKey( font, flags, text )
+        + QChar( 0x1f ) + QString::number( width );
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( const double* h = m_data->heightCache.object( key ) )
+            return *h;
+    }
+
     QwtRichTextDocument doc( text, flags, font );
 
     doc.setPageSize( QSizeF( width, QWIDGETSIZE_MAX ) );
-    return doc.documentLayout()->documentSize().height();
+    const double h = doc.documentLayout()->documentSize().height();
+
+    QMutexLocker locker( &m_data->mutex );
+    m_data->heightCache.insert( key, new double( h ) );
+
+    return h;
 }
 
 /*!
@@ -281,6 +396,15 @@ double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
 QSizeF QwtRichTextEngine::textSize( const QFont& font,
     int flags, const QString& text ) const
 {
+    const QString key = PrivateData::cacheKey( font, flags, text );
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( const QSizeF* sz = m_data->sizeCache.object( key ) )
+            return *sz;
+    }
+
     QwtRichTextDocument doc( text, flags, font );
 
     QTextOption option = doc.defaultTextOption();
@@ -291,7 +415,12 @@ QSizeF QwtRichTextEngine::textSize( const QFont& font,
         doc.adjustSize();
     }
 
-    return doc.size();
+    const QSizeF sz = doc.size();
+
+    QMutexLocker locker( &m_data->mutex );
+    m_data->sizeCache.insert( key, new QSizeF( sz ) );
+
+    return sz;
 }
 
 /*!
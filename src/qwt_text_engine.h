@@ -148,6 +148,7 @@ class QWT_EXPORT QwtRichTextEngine : public QwtTextEngine
 {
   public:
     QwtRichTextEngine();
+    virtual ~QwtRichTextEngine();
 
     virtual double heightForWidth( const QFont& font, int flags,
         const QString& text, double width ) const QWT_OVERRIDE;
@@ -167,6 +168,9 @@ class QWT_EXPORT QwtRichTextEngine : public QwtTextEngine
 
   private:
     QString taggedText( const QString&, int flags ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
 };
 
 #endif // !QT_NO_RICHTEXT
@@ -12,8 +12,10 @@
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
 #include "qwt_math.h"
+#include "qwt_painter.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qstyle.h>
@@ -70,6 +72,84 @@ static QVector< double > qwtTickList( const QwtScaleDiv& scaleDiv )
     return values;
 }
 
+static void qwtDrawColorLines( QPainter* painter, const QwtColorMap* colorMap,
+    const QwtScaleMap& scaleMap, const QwtScaleDiv& scaleDiv,
+    const QRect& pipeRect, const QRect& liquidRect, Qt::Orientation orientation )
+{
+    const QwtInterval interval = scaleDiv.interval().normalized();
+
+    // Because the positions of the ticks are rounded
+    // we calculate the colors for the rounded tick values
+
+    QVector< double > values = qwtTickList( scaleDiv );
+
+    if ( scaleMap.isInverting() )
+        std::sort( values.begin(), values.end(), std::greater< double >() );
+    else
+        std::sort( values.begin(), values.end(), std::less< double >() );
+
+    int from;
+    if ( !values.isEmpty() )
+    {
+        from = qRound( scaleMap.transform( values[0] ) );
+        qwtDrawLine( painter, from,
+            colorMap->color( interval, values[0] ),
+            pipeRect, liquidRect, orientation );
+    }
+
+    for ( int i = 1; i < values.size(); i++ )
+    {
+        const int to = qRound( scaleMap.transform( values[i] ) );
+
+        for ( int pos = from + 1; pos < to; pos++ )
+        {
+            const double v = scaleMap.invTransform( pos );
+
+            qwtDrawLine( painter, pos,
+                colorMap->color( interval, v ),
+                pipeRect, liquidRect, orientation );
+        }
+
+        qwtDrawLine( painter, to,
+            colorMap->color( interval, values[i] ),
+            pipeRect, liquidRect, orientation );
+
+        from = to;
+    }
+}
+
+namespace
+{
+    /*
+        The liquid for a completely filled pipe, so that the
+        colors don't need to be calculated for each value change.
+     */
+    class QwtLiquidCache
+    {
+      public:
+        QwtLiquidCache()
+            : isValid( false )
+            , pixelRatio( 1.0 )
+            , orientation( Qt::Vertical )
+            , p1( 0.0 )
+            , p2( 0.0 )
+            , s1( 0.0 )
+            , s2( 0.0 )
+        {
+        }
+
+        bool isValid;
+        QPixmap pixmap;
+
+        QRect pipeRect;
+        qreal pixelRatio;
+        Qt::Orientation orientation;
+
+        double p1, p2, s1, s2;
+        QwtScaleDiv scaleDiv;
+    };
+}
+
 class QwtThermo::PrivateData
 {
   public:
@@ -86,6 +166,8 @@ class QwtThermo::PrivateData
         , origin( 0.0 )
         , colorMap( NULL )
         , value( 0.0 )
+        , cachePixelRatio( 1.0 )
+        , cacheColorGroup( QPalette::Active )
     {
         rangeFlags = QwtInterval::IncludeBorders;
     }
@@ -112,6 +194,13 @@ class QwtThermo::PrivateData
     QwtColorMap* colorMap;
 
     double value;
+
+    QwtLiquidCache liquidCache;
+
+    // the scale, that doesn't depend on the value
+    QPixmap scaleCache;
+    qreal cachePixelRatio;
+    QPalette::ColorGroup cacheColorGroup;
 };
 
 /*!
@@ -183,7 +272,9 @@ void QwtThermo::setValue( double value )
     if ( m_data->value != value )
     {
         m_data->value = value;
-        update();
+
+        // the scale doesn't depend on the value
+        update( pipeRect() );
     }
 }
 
@@ -246,7 +337,7 @@ void QwtThermo::paintEvent( QPaintEvent* event )
     if ( !tRect.contains( event->rect() ) )
     {
         if ( m_data->scalePosition != QwtThermo::NoScale )
-            scaleDraw()->draw( &painter, palette() );
+            drawScale( &painter );
     }
 
     const int bw = m_data->borderWidth;
@@ -260,6 +351,56 @@ void QwtThermo::paintEvent( QPaintEvent* event )
     drawLiquid( &painter, tRect );
 }
 
+/*!
+   Draw the scale from a pixmap, that is rendered by
+   QwtScaleDraw::draw() only when it is invalid
+
+   \param painter Painter
+   \sa invalidateCache()
+ */
+void QwtThermo::drawScale( QPainter* painter ) const
+{
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+    const QPalette::ColorGroup colorGroup = palette().currentColorGroup();
+
+    QPixmap& cache = m_data->scaleCache;
+
+    if ( cache.isNull() || cache.size() != size() * pixelRatio
+        || pixelRatio != m_data->cachePixelRatio
+        || colorGroup != m_data->cacheColorGroup )
+    {
+        if ( size().isEmpty() )
+            return;
+
+        cache = QwtPainter::backingStore( const_cast< QwtThermo* >( this ), size() );
+        cache.fill( Qt::transparent );
+
+        QPainter p( &cache );
+        p.setFont( font() );
+
+        scaleDraw()->draw( &p, palette() );
+
+        p.end();
+
+        m_data->cachePixelRatio = pixelRatio;
+        m_data->cacheColorGroup = colorGroup;
+    }
+
+    painter->drawPixmap( 0, 0, cache );
+}
+
+/*!
+   Invalidate the pixmap, that is used to speed up painting the scale
+
+   The scale is rendered to a pixmap, that is reused until the layout,
+   the scale or an attribute of the thermo changes. Derived classes
+   might need to call invalidateCache() according to their own attributes.
+ */
+void QwtThermo::invalidateCache()
+{
+    m_data->scaleCache = QPixmap();
+}
+
 /*!
    Resize event handler
    \param event Resize event
@@ -284,6 +425,14 @@ void QwtThermo::changeEvent( QEvent* event )
             layoutThermo( true );
             break;
         }
+        case QEvent::PaletteChange:
+        case QEvent::EnabledChange:
+        case QEvent::LanguageChange:
+        case QEvent::LocaleChange:
+        {
+            invalidateCache();
+            break;
+        }
         default:
             break;
     }
@@ -298,6 +447,8 @@ void QwtThermo::changeEvent( QEvent* event )
  */
 void QwtThermo::layoutThermo( bool update_geometry )
 {
+    invalidateCache();
+
     const QRect tRect = pipeRect();
     const int bw = m_data->borderWidth + m_data->spacing;
     const bool inverted = ( upperBound() < lowerBound() );
@@ -556,45 +707,59 @@ void QwtThermo::drawLiquid(
 
     if ( m_data->colorMap != NULL )
     {
-        const QwtInterval interval = scaleDiv().interval().normalized();
+        const QwtScaleDiv& scaleDiv = scaleDraw()->scaleDiv();
+        const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
 
-        // Because the positions of the ticks are rounded
-        // we calculate the colors for the rounded tick values
+        QwtLiquidCache& cache = m_data->liquidCache;
 
-        QVector< double > values = qwtTickList( scaleDraw()->scaleDiv() );
-
-        if ( scaleMap.isInverting() )
-            std::sort( values.begin(), values.end(), std::greater< double >() );
-        else
-            std::sort( values.begin(), values.end(), std::less< double >() );
-
-        int from;
-        if ( !values.isEmpty() )
+        if ( !cache.isValid || cache.pipeRect != pipeRect
+            || cache.pixelRatio != pixelRatio
+            || cache.orientation != m_data->orientation
+            || cache.p1 != scaleMap.p1() || cache.p2 != scaleMap.p2()
+            || cache.s1 != scaleMap.s1() || cache.s2 != scaleMap.s2()
+            || cache.scaleDiv != scaleDiv )
         {
-            from = qRound( scaleMap.transform( values[0] ) );
-            qwtDrawLine( painter, from,
-                m_data->colorMap->color( interval, values[0] ),
-                pipeRect, liquidRect, m_data->orientation );
+            cache.pixmap = QwtPainter::backingStore(
+                const_cast< QwtThermo* >( this ), pipeRect.size() );
+            cache.pixmap.fill( Qt::transparent );
+
+            QPainter p( &cache.pixmap );
+            p.translate( -pipeRect.topLeft() );
+
+            qwtDrawColorLines( &p, m_data->colorMap, scaleMap, scaleDiv,
+                pipeRect, pipeRect, m_data->orientation );
+
+            p.end();
+
+            cache.isValid = true;
+            cache.pipeRect = pipeRect;
+            cache.pixelRatio = pixelRatio;
+            cache.orientation = m_data->orientation;
+            cache.p1 = scaleMap.p1();
+            cache.p2 = scaleMap.p2();
+            cache.s1 = scaleMap.s1();
+            cache.s2 = scaleMap.s2();
+            cache.scaleDiv = scaleDiv;
         }
 
-        for ( int i = 1; i < values.size(); i++ )
-        {
-            const int to = qRound( scaleMap.transform( values[i] ) );
-
-            for ( int pos = from + 1; pos < to; pos++ )
-            {
-                const double v = scaleMap.invTransform( pos );
-
-                qwtDrawLine( painter, pos,
-                    m_data->colorMap->color( interval, v ),
-                    pipeRect, liquidRect, m_data->orientation );
-            }
+        /*
+            The lines at the right/bottom border of the liquid
+            are excluded, see qwtDrawLine()
+         */
+        QRect r = liquidRect & pipeRect;
+        if ( m_data->orientation == Qt::Horizontal )
+            r.setRight( r.right() - 1 );
+        else
+            r.setBottom( r.bottom() - 1 );
 
-            qwtDrawLine( painter, to,
-                m_data->colorMap->color( interval, values[i] ),
-                pipeRect, liquidRect, m_data->orientation );
+        if ( r.isValid() )
+        {
+            // the source rectangle is in pixels of the pixmap
+            const QRectF sourceRect(
+                QPointF( r.topLeft() - pipeRect.topLeft() ) * pixelRatio,
+                QSizeF( r.size() ) * pixelRatio );
 
-            from = to;
+            painter->drawPixmap( QRectF( r ), cache.pixmap, sourceRect );
         }
     }
     else
@@ -687,15 +852,24 @@ void QwtThermo::setColorMap( QwtColorMap* colorMap )
         delete m_data->colorMap;
         m_data->colorMap = colorMap;
     }
+
+    m_data->liquidCache.isValid = false;
+    update();
 }
 
 /*!
    \return Color map for the fill color
    \warning The alarm threshold has no effect, when
            a color map has been assigned
+
+   \note The liquid is rendered with all colors of the color map
+         to a pixmap, that is reused for each value. As the color map
+         might be modified through the returned pointer, the pixmap
+         is invalidated by this method.
  */
 QwtColorMap* QwtThermo::colorMap()
 {
+    m_data->liquidCache.isValid = false;
     return m_data->colorMap;
 }
 
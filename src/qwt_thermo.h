@@ -168,8 +168,11 @@ class QWT_EXPORT QwtThermo : public QwtAbstractScale
     QRect fillRect( const QRect& ) const;
     QRect alarmRect( const QRect& ) const;
 
+    void invalidateCache();
+
   private:
     void layoutThermo( bool );
+    void drawScale( QPainter* ) const;
 
     class PrivateData;
     PrivateData* m_data;
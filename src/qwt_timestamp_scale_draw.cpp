@@ -0,0 +1,301 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_timestamp_scale_draw.h"
+#include "qwt_date.h"
+#include "qwt_text.h"
+
+#include <qmap.h>
+#include <qdatetime.h>
+
+// labels of a scrolling axis are usually found in the cache
+static const int qwtMaxCachedLabels = 1000;
+
+static const qint64 qwtNanoSecondsPerSecond = Q_INT64_C( 1000000000 );
+static const qint64 qwtNanoSecondsPerMinute = 60 * qwtNanoSecondsPerSecond;
+static const qint64 qwtNanoSecondsPerDay = 1440 * qwtNanoSecondsPerMinute;
+
+static inline qint64 qwtFloorSeconds( qint64 timestamp )
+{
+    qint64 secs = timestamp / qwtNanoSecondsPerSecond;
+    if ( ( timestamp % qwtNanoSecondsPerSecond ) != 0 && timestamp < 0 )
+        secs--;
+
+    return secs;
+}
+
+class QwtTimestampScaleDraw::PrivateData
+{
+  public:
+    PrivateData( qint64 timestamp, Qt::TimeSpec spec )
+        : origin( timestamp )
+        , timeSpec( spec )
+        , hasResolution( false )
+        , resolution( qwtNanoSecondsPerSecond )
+        , cacheResolution( 0 )
+    {
+    }
+
+    void invalidateCache()
+    {
+        hasResolution = false;
+        labelCache.clear();
+    }
+
+    qint64 origin;
+    Qt::TimeSpec timeSpec;
+
+    // resolution of the scale division, that was used last
+    bool hasResolution;
+    QwtScaleDiv resolutionDiv;
+    qint64 resolution;
+
+    // formatted labels for the resolution of cacheResolution
+    qint64 cacheResolution;
+    QMap< qint64, QString > labelCache;
+};
+
+/*!
+   \brief Constructor
+
+   \param origin Timestamp in nanoseconds since the epoch,
+                 that corresponds to the scale value 0.0
+   \param timeSpec Time specification
+
+   \sa setOrigin(), setTimeSpec()
+ */
+QwtTimestampScaleDraw::QwtTimestampScaleDraw(
+    qint64 origin, Qt::TimeSpec timeSpec )
+{
+    m_data = new PrivateData( origin, timeSpec );
+}
+
+//! Destructor
+QwtTimestampScaleDraw::~QwtTimestampScaleDraw()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the origin
+
+   \param origin Timestamp in nanoseconds since the epoch,
+                 that corresponds to the scale value 0.0
+
+   \sa origin(), QwtTimestampScaleEngine::setOrigin()
+ */
+void QwtTimestampScaleDraw::setOrigin( qint64 origin )
+{
+    if ( origin != m_data->origin )
+    {
+        m_data->origin = origin;
+        m_data->invalidateCache();
+        invalidateCache();
+    }
+}
+
+/*!
+   \return Timestamp in nanoseconds since the epoch,
+          that corresponds to the scale value 0.0
+   \sa setOrigin()
+ */
+qint64 QwtTimestampScaleDraw::origin() const
+{
+    return m_data->origin;
+}
+
+/*!
+   Set the time specification used for the labels
+
+   \param timeSpec Time specification
+   \sa timeSpec()
+ */
+void QwtTimestampScaleDraw::setTimeSpec( Qt::TimeSpec timeSpec )
+{
+    if ( timeSpec != m_data->timeSpec )
+    {
+        m_data->timeSpec = timeSpec;
+        m_data->invalidateCache();
+        invalidateCache();
+    }
+}
+
+/*!
+   \return Time specification used for the labels
+   \sa setTimeSpec()
+ */
+Qt::TimeSpec QwtTimestampScaleDraw::timeSpec() const
+{
+    return m_data->timeSpec;
+}
+
+/*!
+   Translate a scale value into a timestamp
+
+   \param value Nanoseconds relative to origin()
+   \return Timestamp in nanoseconds since the epoch
+ */
+qint64 QwtTimestampScaleDraw::toTimestamp( double value ) const
+{
+    return m_data->origin + qRound64( value );
+}
+
+/*!
+   \brief Convert a value into its representing label
+
+   The value is converted to a timestamp, that is formatted
+   according to the resolution of the scale division.
+
+   \param value Value
+   \return Label string
+
+   \sa resolution(), format()
+ */
+QwtText QwtTimestampScaleDraw::label( double value ) const
+{
+    const qint64 res = cachedResolution();
+    const qint64 timestamp = toTimestamp( value );
+
+    if ( res != m_data->cacheResolution )
+    {
+        m_data->labelCache.clear();
+        m_data->cacheResolution = res;
+    }
+
+    QMap< qint64, QString >& cache = m_data->labelCache;
+
+    QMap< qint64, QString >::const_iterator it = cache.constFind( timestamp );
+    if ( it != cache.constEnd() )
+        return *it;
+
+    const QString text = format( timestamp, res );
+
+    if ( cache.size() >= qwtMaxCachedLabels )
+        cache.clear();
+
+    cache.insert( timestamp, text );
+
+    return text;
+}
+
+qint64 QwtTimestampScaleDraw::cachedResolution() const
+{
+    if ( !m_data->hasResolution || m_data->resolutionDiv != scaleDiv() )
+    {
+        m_data->resolutionDiv = scaleDiv();
+        m_data->resolution = resolution( scaleDiv() );
+        m_data->hasResolution = true;
+    }
+
+    return m_data->resolution;
+}
+
+/*!
+   Find the largest unit, where the major ticks can be formatted
+   without rounding errors.
+
+   The units are the powers of 10 from 1 nanosecond up to a second,
+   a minute and a day. All calculations are done in integer
+   arithmetic - only for checking the alignment to midnight
+   the timestamps are converted into QDateTime objects.
+
+   \param scaleDiv Scale division
+   \return Resolution in nanoseconds
+
+   \sa format()
+ */
+qint64 QwtTimestampScaleDraw::resolution( const QwtScaleDiv& scaleDiv ) const
+{
+    const QList< double > ticks = scaleDiv.ticks( QwtScaleDiv::MajorTick );
+
+    qint64 res = qwtNanoSecondsPerMinute;
+    for ( int i = 0; i < ticks.size() && res > 1; i++ )
+    {
+        const qint64 timestamp = toTimestamp( ticks[i] );
+
+        while ( res > 1 && ( timestamp % res ) != 0 )
+        {
+            if ( res == qwtNanoSecondsPerMinute )
+                res = qwtNanoSecondsPerSecond;
+            else
+                res /= 10;
+        }
+    }
+
+    if ( res == qwtNanoSecondsPerMinute && !ticks.isEmpty() )
+    {
+        bool midnight = true;
+        for ( int i = 0; i < ticks.size() && midnight; i++ )
+        {
+            const qint64 secs = qwtFloorSeconds( toTimestamp( ticks[i] ) );
+
+            const QDateTime dt = QwtDate::toDateTime(
+                secs * 1000.0, m_data->timeSpec );
+
+            midnight = ( dt.time() == QTime( 0, 0 ) );
+        }
+
+        if ( midnight )
+            res = qwtNanoSecondsPerDay;
+    }
+
+    return res;
+}
+
+/*!
+   Format a timestamp
+
+   The default implementation returns "ddd dd MMM yyyy" for a resolution
+   of days. Otherwise the time of day is added in front as "hh:mm",
+   "hh:mm:ss" or "hh:mm:ss.fff...", where the number of fractional
+   digits depends on the resolution.
+
+   \param timestamp Timestamp in nanoseconds since the epoch
+   \param resolution Resolution in nanoseconds
+   \return Formatted label
+
+   \sa resolution()
+ */
+QString QwtTimestampScaleDraw::format(
+    qint64 timestamp, qint64 resolution ) const
+{
+    const qint64 secs = qwtFloorSeconds( timestamp );
+    const qint64 nsecs = timestamp - secs * qwtNanoSecondsPerSecond;
+
+    const QDateTime dt = QwtDate::toDateTime( secs * 1000.0, m_data->timeSpec );
+
+    const QString dateString = dt.toString( "ddd dd MMM yyyy" );
+    if ( resolution >= qwtNanoSecondsPerDay )
+        return dateString;
+
+    QString timeString;
+    if ( resolution >= qwtNanoSecondsPerMinute )
+    {
+        timeString = dt.toString( "hh:mm" );
+    }
+    else
+    {
+        timeString = dt.toString( "hh:mm:ss" );
+
+        if ( resolution < qwtNanoSecondsPerSecond )
+        {
+            int numDigits = 9;
+            for ( qint64 r = resolution; r >= 10; r /= 10 )
+                numDigits--;
+
+            const QString fraction =
+                QString::number( nsecs ).rightJustified( 9, '0' );
+
+            timeString += '.';
+            timeString += fraction.left( numDigits );
+        }
+    }
+
+    return timeString + '\n' + dateString;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TIMESTAMP_SCALE_DRAW_H
+#define QWT_TIMESTAMP_SCALE_DRAW_H
+
+#include "qwt_global.h"
+#include "qwt_scale_draw.h"
+
+#include <qnamespace.h>
+
+class QString;
+
+/*!
+   \brief A class for drawing scales of timestamps in nanoseconds
+
+   QwtTimestampScaleDraw displays scale values, that are nanoseconds
+   relative to an origin(), as time labels. The fraction of a second
+   is formatted with as many digits, as are needed to distinguish
+   the major ticks - down to nanoseconds.
+
+   Only the whole seconds of a label are converted into a
+   QDateTime object. Labels are cached, so that a scrolling axis
+   usually finds most of them without formatting.
+
+   \sa QwtTimestampScaleEngine, QwtTimestampSeriesData, QwtDateScaleDraw
+ */
+class QWT_EXPORT QwtTimestampScaleDraw : public QwtScaleDraw
+{
+  public:
+    explicit QwtTimestampScaleDraw(
+        qint64 origin = 0, Qt::TimeSpec = Qt::UTC );
+
+    virtual ~QwtTimestampScaleDraw();
+
+    void setOrigin( qint64 );
+    qint64 origin() const;
+
+    void setTimeSpec( Qt::TimeSpec );
+    Qt::TimeSpec timeSpec() const;
+
+    virtual QwtText label( double ) const QWT_OVERRIDE;
+
+    qint64 toTimestamp( double ) const;
+
+  protected:
+    virtual qint64 resolution( const QwtScaleDiv& ) const;
+    virtual QString format( qint64 timestamp, qint64 resolution ) const;
+
+  private:
+    qint64 cachedResolution() const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
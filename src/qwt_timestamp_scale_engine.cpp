@@ -0,0 +1,300 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_timestamp_scale_engine.h"
+#include "qwt_interval.h"
+
+#include <cmath>
+
+static const qint64 qwtNanoSecondsPerSecond = Q_INT64_C( 1000000000 );
+static const qint64 qwtNanoSecondsPerDay = Q_INT64_C( 86400 ) * qwtNanoSecondsPerSecond;
+
+// step sizes, that fit to the units of a time scale
+
+static const qint64 qwtTimeSteps[] =
+{
+    // 1 ns - 500ms
+    Q_INT64_C( 1 ), Q_INT64_C( 2 ), Q_INT64_C( 5 ),
+    Q_INT64_C( 10 ), Q_INT64_C( 20 ), Q_INT64_C( 50 ),
+    Q_INT64_C( 100 ), Q_INT64_C( 200 ), Q_INT64_C( 500 ),
+    Q_INT64_C( 1000 ), Q_INT64_C( 2000 ), Q_INT64_C( 5000 ),
+    Q_INT64_C( 10000 ), Q_INT64_C( 20000 ), Q_INT64_C( 50000 ),
+    Q_INT64_C( 100000 ), Q_INT64_C( 200000 ), Q_INT64_C( 500000 ),
+    Q_INT64_C( 1000000 ), Q_INT64_C( 2000000 ), Q_INT64_C( 5000000 ),
+    Q_INT64_C( 10000000 ), Q_INT64_C( 20000000 ), Q_INT64_C( 50000000 ),
+    Q_INT64_C( 100000000 ), Q_INT64_C( 200000000 ), Q_INT64_C( 500000000 ),
+
+    // seconds
+    1 * qwtNanoSecondsPerSecond, 2 * qwtNanoSecondsPerSecond,
+    5 * qwtNanoSecondsPerSecond, 10 * qwtNanoSecondsPerSecond,
+    15 * qwtNanoSecondsPerSecond, 30 * qwtNanoSecondsPerSecond,
+
+    // minutes
+    60 * qwtNanoSecondsPerSecond, 120 * qwtNanoSecondsPerSecond,
+    300 * qwtNanoSecondsPerSecond, 600 * qwtNanoSecondsPerSecond,
+    900 * qwtNanoSecondsPerSecond, 1800 * qwtNanoSecondsPerSecond,
+
+    // hours
+    3600 * qwtNanoSecondsPerSecond, 7200 * qwtNanoSecondsPerSecond,
+    10800 * qwtNanoSecondsPerSecond, 21600 * qwtNanoSecondsPerSecond,
+    43200 * qwtNanoSecondsPerSecond,
+
+    // days
+    1 * qwtNanoSecondsPerDay, 2 * qwtNanoSecondsPerDay,
+    5 * qwtNanoSecondsPerDay, 10 * qwtNanoSecondsPerDay
+};
+
+static const int qwtNumTimeSteps =
+    int( sizeof( qwtTimeSteps ) / sizeof( qwtTimeSteps[0] ) );
+
+static inline qint64 qwtFloorDiv( qint64 value, qint64 divisor )
+{
+    qint64 q = value / divisor;
+    if ( ( value % divisor ) != 0 && value < 0 )
+        q--;
+
+    return q;
+}
+
+static inline qint64 qwtFloorTo( qint64 value, qint64 stepSize )
+{
+    return qwtFloorDiv( value, stepSize ) * stepSize;
+}
+
+static inline qint64 qwtCeilTo( qint64 value, qint64 stepSize )
+{
+    return -qwtFloorTo( -value, stepSize );
+}
+
+static inline qint64 qwtMinorStepSize( qint64 stepSize, int maxMinorSteps )
+{
+    if ( maxMinorSteps < 1 )
+        return 0;
+
+    // the smallest step, that divides the major step
+    for ( int i = 0; i < qwtNumTimeSteps; i++ )
+    {
+        const qint64 step = qwtTimeSteps[i];
+        if ( step >= stepSize )
+            break;
+
+        if ( ( stepSize % step == 0 ) && ( stepSize / step <= maxMinorSteps ) )
+            return step;
+    }
+
+    return 0;
+}
+
+class QwtTimestampScaleEngine::PrivateData
+{
+  public:
+    explicit PrivateData( qint64 timestamp )
+        : origin( timestamp )
+    {
+    }
+
+    qint64 origin;
+};
+
+/*!
+   \brief Constructor
+
+   \param origin Timestamp in nanoseconds since the epoch,
+                 that corresponds to the scale value 0.0
+ */
+QwtTimestampScaleEngine::QwtTimestampScaleEngine( qint64 origin )
+    : QwtLinearScaleEngine( 10 )
+{
+    m_data = new PrivateData( origin );
+}
+
+//! Destructor
+QwtTimestampScaleEngine::~QwtTimestampScaleEngine()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Set the origin
+
+   \param origin Timestamp in nanoseconds since the epoch,
+                 that corresponds to the scale value 0.0
+
+   \sa origin(), QwtTimestampScaleDraw::setOrigin(),
+      QwtTimestampSeriesData::setOrigin()
+ */
+void QwtTimestampScaleEngine::setOrigin( qint64 origin )
+{
+    m_data->origin = origin;
+}
+
+/*!
+   \return Timestamp in nanoseconds since the epoch,
+          that corresponds to the scale value 0.0
+   \sa setOrigin()
+ */
+qint64 QwtTimestampScaleEngine::origin() const
+{
+    return m_data->origin;
+}
+
+/*!
+   Align and divide an interval
+
+   The step size is taken from a table of units of a time scale
+   and the limits are aligned to multiples of it - unless the
+   Floating attribute is set.
+
+   \param maxNumSteps Max. number of steps
+   \param x1 First limit of the interval (In/Out)
+   \param x2 Second limit of the interval (In/Out)
+   \param stepSize Step size (Out)
+
+   \sa QwtScaleEngine::setAttribute()
+ */
+void QwtTimestampScaleEngine::autoScale( int maxNumSteps,
+    double& x1, double& x2, double& stepSize ) const
+{
+    QwtInterval interval( x1, x2 );
+    interval = interval.normalized();
+
+    interval.setMinValue( interval.minValue() - lowerMargin() );
+    interval.setMaxValue( interval.maxValue() + upperMargin() );
+
+    const qint64 origin = m_data->origin;
+
+    qint64 t1 = origin + qint64( std::floor( interval.minValue() ) );
+    qint64 t2 = origin + qint64( std::ceil( interval.maxValue() ) );
+
+    if ( t1 == t2 )
+    {
+        t1 -= qwtNanoSecondsPerSecond / 2;
+        t2 += qwtNanoSecondsPerSecond / 2;
+    }
+
+    const qint64 step = alignedStepSize( t2 - t1, qMax( maxNumSteps, 1 ) );
+
+    if ( !testAttribute( QwtScaleEngine::Floating ) )
+    {
+        t1 = qwtFloorTo( t1, step );
+        t2 = qwtCeilTo( t2, step );
+    }
+
+    x1 = double( t1 - origin );
+    x2 = double( t2 - origin );
+    stepSize = double( step );
+
+    if ( testAttribute( QwtScaleEngine::Inverted ) )
+    {
+        qSwap( x1, x2 );
+        stepSize = -stepSize;
+    }
+}
+
+/*!
+   \brief Calculate a scale division for an interval
+
+   The ticks are calculated in integer arithmetic as multiples
+   of the step size since the epoch.
+
+   \param x1 First interval limit
+   \param x2 Second interval limit
+   \param maxMajorSteps Maximum for the number of major steps
+   \param maxMinorSteps Maximum number of minor steps
+   \param stepSize Step size. If stepSize == 0, the engine
+                   calculates one.
+
+   \return Calculated scale division
+ */
+QwtScaleDiv QwtTimestampScaleEngine::divideScale( double x1, double x2,
+    int maxMajorSteps, int maxMinorSteps, double stepSize ) const
+{
+    const QwtInterval interval = QwtInterval( x1, x2 ).normalized();
+    if ( interval.width() <= 0.0 )
+        return QwtScaleDiv();
+
+    const qint64 origin = m_data->origin;
+
+    const qint64 t1 = origin + qint64( std::ceil( interval.minValue() ) );
+    const qint64 t2 = origin + qint64( std::floor( interval.maxValue() ) );
+
+    qint64 step = qAbs( qint64( qRound64( stepSize ) ) );
+    if ( step == 0 )
+    {
+        step = alignedStepSize( qMax( t2 - t1, Q_INT64_C( 1 ) ),
+            qMax( maxMajorSteps, 1 ) );
+    }
+
+    const qint64 minorStep = qwtMinorStepSize( step, maxMinorSteps );
+
+    QList< double > ticks[QwtScaleDiv::NTickTypes];
+
+    const qint64 first = qwtFloorTo( t1, step );
+    if ( ( t2 - first ) / step > 10000 )
+        return QwtScaleDiv( interval.minValue(), interval.maxValue() );
+
+    const int numMinorTicks = minorStep > 0 ? int( step / minorStep ) - 1 : 0;
+    const int medIndex = ( numMinorTicks % 2 ) ? numMinorTicks / 2 : -1;
+
+    for ( qint64 t = first; t <= t2; t += step )
+    {
+        if ( t >= t1 )
+            ticks[QwtScaleDiv::MajorTick] += double( t - origin );
+
+        qint64 minorValue = t;
+        for ( int k = 0; k < numMinorTicks; k++ )
+        {
+            minorValue += minorStep;
+            if ( minorValue < t1 || minorValue > t2 )
+                continue;
+
+            const double value = double( minorValue - origin );
+
+            if ( k == medIndex )
+                ticks[QwtScaleDiv::MediumTick] += value;
+            else
+                ticks[QwtScaleDiv::MinorTick] += value;
+        }
+    }
+
+    QwtScaleDiv scaleDiv( interval, ticks );
+    if ( x1 > x2 )
+        scaleDiv.invert();
+
+    return scaleDiv;
+}
+
+/*!
+   Find the smallest step size of the table of time units,
+   that divides an interval into numSteps steps at most.
+
+   \param intervalSize Size of the interval in nanoseconds
+   \param numSteps Maximum number of steps
+
+   \return Step size in nanoseconds
+ */
+qint64 QwtTimestampScaleEngine::alignedStepSize(
+    qint64 intervalSize, int numSteps )
+{
+    if ( numSteps < 1 )
+        numSteps = 1;
+
+    const qint64 minStep = qAbs( intervalSize ) / numSteps;
+
+    for ( int i = 0; i < qwtNumTimeSteps; i++ )
+    {
+        if ( qwtTimeSteps[i] >= minStep )
+            return qwtTimeSteps[i];
+    }
+
+    // multiples of 10 days
+
+    const qint64 tenDays = qwtTimeSteps[ qwtNumTimeSteps - 1 ];
+    return qwtCeilTo( minStep, tenDays );
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TIMESTAMP_SCALE_ENGINE_H
+#define QWT_TIMESTAMP_SCALE_ENGINE_H
+
+#include "qwt_global.h"
+#include "qwt_scale_engine.h"
+
+/*!
+   \brief A scale engine for timestamps in nanoseconds
+
+   A double has 53 bits of mantissa, what is not enough for
+   nanoseconds since the epoch. QwtDateScaleEngine works with
+   milliseconds and calculates the ticks with QDateTime objects,
+   what is expensive for scales, that are panned continuously.
+
+   QwtTimestampScaleEngine expects the scale values as nanoseconds
+   relative to an origin(), that is a timestamp in nanoseconds
+   since 1970-01-01T00:00:00 UTC. As long as the distance to the origin
+   is below 2^53 nanoseconds ( ~104 days ) the values are exact.
+
+   The step sizes are taken from a table of nanoseconds, seconds,
+   minutes, hours and days and the ticks are calculated
+   in 64 bit integer arithmetic as multiples of the step size since
+   the epoch. So ticks of days are aligned to midnight UTC.
+
+   QwtTimestampScaleEngine is intended to be used together with
+   QwtTimestampScaleDraw and QwtTimestampSeriesData, all of them
+   initialized with the same origin.
+
+   \sa QwtTimestampScaleDraw, QwtTimestampSeriesData, QwtDateScaleEngine
+ */
+class QWT_EXPORT QwtTimestampScaleEngine : public QwtLinearScaleEngine
+{
+  public:
+    explicit QwtTimestampScaleEngine( qint64 origin = 0 );
+    virtual ~QwtTimestampScaleEngine();
+
+    void setOrigin( qint64 );
+    qint64 origin() const;
+
+    virtual void autoScale(
+        int maxNumSteps, double& x1, double& x2,
+        double& stepSize ) const QWT_OVERRIDE;
+
+    virtual QwtScaleDiv divideScale(
+        double x1, double x2,
+        int maxMajorSteps, int maxMinorSteps,
+        double stepSize = 0.0 ) const QWT_OVERRIDE;
+
+    static qint64 alignedStepSize( qint64 intervalSize, int numSteps );
+
+  private:
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
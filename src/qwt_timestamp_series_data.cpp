@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_timestamp_series_data.h"
+
+//! Constructor
+QwtTimestampSeriesData::QwtTimestampSeriesData()
+    : m_origin( 0 )
+{
+}
+
+/*!
+   \brief Constructor
+
+   \param timestamps Timestamps in nanoseconds since the epoch
+   \param values Values
+   \param origin Timestamp, that corresponds to the x coordinate 0.0
+
+   \sa setSamples(), setOrigin()
+ */
+QwtTimestampSeriesData::QwtTimestampSeriesData(
+        const QVector< qint64 >& timestamps,
+        const QVector< double >& values, qint64 origin )
+    : m_timestamps( timestamps )
+    , m_values( values )
+    , m_origin( origin )
+{
+}
+
+//! Destructor
+QwtTimestampSeriesData::~QwtTimestampSeriesData()
+{
+}
+
+/*!
+   \brief Assign timestamps and values
+
+   When the arrays have different sizes the number of samples
+   is the size of the smaller one.
+
+   \param timestamps Timestamps in nanoseconds since the epoch
+   \param values Values
+ */
+void QwtTimestampSeriesData::setSamples(
+    const QVector< qint64 >& timestamps, const QVector< double >& values )
+{
+    m_timestamps = timestamps;
+    m_values = values;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \brief Set the origin
+
+   The x coordinates of the samples are the nanoseconds relative
+   to the origin.
+
+   \param origin Timestamp in nanoseconds since the epoch
+   \sa origin()
+ */
+void QwtTimestampSeriesData::setOrigin( qint64 origin )
+{
+    if ( origin != m_origin )
+    {
+        m_origin = origin;
+        cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    }
+}
+
+/*!
+   \return Timestamp in nanoseconds since the epoch, that
+          corresponds to the x coordinate 0.0
+   \sa setOrigin()
+ */
+qint64 QwtTimestampSeriesData::origin() const
+{
+    return m_origin;
+}
+
+//! \return Timestamps in nanoseconds since the epoch
+const QVector< qint64 >& QwtTimestampSeriesData::timestamps() const
+{
+    return m_timestamps;
+}
+
+//! \return Values
+const QVector< double >& QwtTimestampSeriesData::values() const
+{
+    return m_values;
+}
+
+/*!
+   \param index Index
+   \return Timestamp of the sample at position index
+ */
+qint64 QwtTimestampSeriesData::timestamp( size_t index ) const
+{
+    return m_timestamps[ int( index ) ];
+}
+
+//! \return Number of samples
+size_t QwtTimestampSeriesData::size() const
+{
+    return qMin( m_timestamps.size(), m_values.size() );
+}
+
+/*!
+   \param index Index
+   \return Sample at position index, with the x coordinate
+          relative to origin()
+ */
+QPointF QwtTimestampSeriesData::sample( size_t index ) const
+{
+    const int i = int( index );
+    return QPointF( double( m_timestamps[i] - m_origin ), m_values[i] );
+}
+
+/*!
+   Copy a block of samples
+
+   The differences to the origin are calculated in integer
+   arithmetic, so that the x coordinates are exact.
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array, where the samples will be written to
+ */
+void QwtTimestampSeriesData::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const qint64* timestamps = m_timestamps.constData() + from;
+    const double* values = m_values.constData() + from;
+
+    for ( size_t i = 0; i < numSamples; i++ )
+    {
+        samples[i].rx() = double( timestamps[i] - m_origin );
+        samples[i].ry() = values[i];
+    }
+}
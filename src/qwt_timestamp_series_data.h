@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TIMESTAMP_SERIES_DATA_H
+#define QWT_TIMESTAMP_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qvector.h>
+
+/*!
+   \brief Series of values with timestamps in nanoseconds
+
+   The timestamps are stored as 64 bit integers - nanoseconds since
+   1970-01-01T00:00:00 UTC. The x coordinates of the samples are the
+   nanoseconds relative to an origin(), what keeps them exact as doubles
+   as long as the distance to the origin is below 2^53 nanoseconds
+   ( ~104 days ).
+
+   When panning across a longer period the origin can be moved
+   to the visible interval - together with the origin of the
+   QwtTimestampScaleEngine and QwtTimestampScaleDraw of the axis.
+
+   \par Example
+   \code
+   const qint64 origin = timestamps.first();
+
+   QwtPlotCurve* curve = new QwtPlotCurve();
+   curve->setData( new QwtTimestampSeriesData( timestamps, values, origin ) );
+
+   plot->setAxisScaleEngine( QwtAxis::XBottom,
+       new QwtTimestampScaleEngine( origin ) );
+   plot->setAxisScaleDraw( QwtAxis::XBottom,
+       new QwtTimestampScaleDraw( origin ) );
+   \endcode
+   \endpar
+
+   \sa QwtTimestampScaleEngine, QwtTimestampScaleDraw
+ */
+class QWT_EXPORT QwtTimestampSeriesData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtTimestampSeriesData();
+
+    QwtTimestampSeriesData( const QVector< qint64 >& timestamps,
+        const QVector< double >& values, qint64 origin = 0 );
+
+    virtual ~QwtTimestampSeriesData();
+
+    void setSamples( const QVector< qint64 >& timestamps,
+        const QVector< double >& values );
+
+    void setOrigin( qint64 );
+    qint64 origin() const;
+
+    const QVector< qint64 >& timestamps() const;
+    const QVector< double >& values() const;
+
+    qint64 timestamp( size_t index ) const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void fetch( size_t from, size_t numSamples,
+        QPointF* samples ) const QWT_OVERRIDE;
+
+  private:
+    QVector< qint64 > m_timestamps;
+    QVector< double > m_values;
+    qint64 m_origin;
+};
+
+#endif
@@ -154,6 +154,12 @@ double QwtPowerTransform::invTransform( double value ) const
         return std::pow( value, m_exponent );
 }
 
+//! \return Exponent of the transformation
+double QwtPowerTransform::exponent() const
+{
+    return m_exponent;
+}
+
 //! \return Clone of the transformation
 QwtTransform* QwtPowerTransform::copy() const
 {
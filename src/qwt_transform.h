@@ -133,6 +133,8 @@ class QWT_EXPORT QwtPowerTransform : public QwtTransform
 
     virtual QwtTransform* copy() const QWT_OVERRIDE;
 
+    double exponent() const;
+
   private:
     const double m_exponent;
 };
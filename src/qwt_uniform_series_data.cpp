@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_uniform_series_data.h"
+
+#include <cmath>
+
+/*!
+   Constructor
+
+   \param x0 x coordinate of the first sample
+   \param dx Distance between the x coordinates of 2 samples
+ */
+QwtAbstractUniformData::QwtAbstractUniformData( double x0, double dx )
+    : m_x0( x0 )
+    , m_dx( dx )
+    , m_origin( 0 )
+{
+}
+
+//! Destructor
+QwtAbstractUniformData::~QwtAbstractUniformData()
+{
+}
+
+/*!
+   \brief Set the x coordinates of the samples
+
+   \param x0 x coordinate of the first sample
+   \param dx Distance between the x coordinates of 2 samples.
+             The samples are ordered, when dx > 0.
+
+   \sa x0(), dx()
+ */
+void QwtAbstractUniformData::setSampling( double x0, double dx )
+{
+    m_x0 = x0;
+    m_dx = dx;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \return x coordinate of the first sample
+   \sa setSampling()
+ */
+double QwtAbstractUniformData::x0() const
+{
+    return m_x0;
+}
+
+/*!
+   \return Distance between the x coordinates of 2 samples
+   \sa setSampling()
+ */
+double QwtAbstractUniformData::dx() const
+{
+    return m_dx;
+}
+
+/*!
+   \brief Set the position of the first sample in the ring buffer
+
+   The samples are the values from the origin to the end of the
+   buffer, followed by the values from the beginning to the origin.
+   The default setting is 0.
+
+   \param origin Position of the first sample
+   \sa origin()
+ */
+void QwtAbstractUniformData::setOrigin( size_t origin )
+{
+    m_origin = origin;
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \return Position of the first sample in the ring buffer
+   \sa setOrigin()
+ */
+size_t QwtAbstractUniformData::origin() const
+{
+    return m_origin;
+}
+
+/*!
+   \brief Find the samples inside an x interval in O(1)
+
+   Like qwtClipSampleRange() the range includes one sample on each
+   side, that is needed for line segments crossing the borders
+   of the interval.
+
+   \param x1 First border of the interval
+   \param x2 Second border of the interval
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return false, when the series is empty. For dx() <= 0.0 all samples
+           are returned.
+ */
+bool QwtAbstractUniformData::indexRange(
+    double x1, double x2, int& from, int& to ) const
+{
+    const int numSamples = int( size() );
+    if ( numSamples <= 0 )
+        return false;
+
+    if ( m_dx <= 0.0 )
+    {
+        from = 0;
+        to = numSamples - 1;
+
+        return true;
+    }
+
+    if ( x1 > x2 )
+        qSwap( x1, x2 );
+
+    // clipping in floating point, before converting to int
+
+    const double i1 = std::floor( ( x1 - m_x0 ) / m_dx );
+    const double i2 = std::ceil( ( x2 - m_x0 ) / m_dx );
+
+    from = int( qBound( 0.0, i1, numSamples - 1.0 ) );
+    to = int( qBound( 0.0, i2, numSamples - 1.0 ) );
+
+    return true;
+}
+
+/*!
+   \brief Find the first sample with an x coordinate >= x in O(1)
+
+   \param x x coordinate
+   \return Index of the sample, or size(), when there is none
+   \note Requires dx() > 0.0
+ */
+int QwtAbstractUniformData::lowerIndex( double x ) const
+{
+    const int numSamples = int( size() );
+    if ( numSamples <= 0 || m_dx <= 0.0 )
+        return numSamples;
+
+    const double i = std::ceil( ( x - m_x0 ) / m_dx );
+
+    int index = int( qBound( 0.0, i, double( numSamples ) ) );
+
+    // correcting rounding errors of the division
+
+    if ( index > 0 && xValue( index - 1 ) >= x )
+        index--;
+    else if ( index < numSamples && xValue( index ) < x )
+        index++;
+
+    return index;
+}
+
+/*!
+   \brief Store the rectangle of interest
+
+   QwtPlotSeriesItem passes the visible area of the canvas.
+   \param rect Rectangle of interest
+   \sa rectOfInterest(), visibleRange()
+ */
+void QwtAbstractUniformData::setRectOfInterest( const QRectF& rect )
+{
+    m_rectOfInterest = rect;
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtAbstractUniformData::rectOfInterest() const
+{
+    return m_rectOfInterest;
+}
+
+/*!
+   \brief Find the samples inside of the rectangle of interest in O(1)
+
+   \param from Index of the first sample
+   \param to Index of the last sample
+
+   \return false, when the series is empty or no rectangle
+           of interest has been set
+   \sa indexRange(), setRectOfInterest()
+ */
+bool QwtAbstractUniformData::visibleRange( int& from, int& to ) const
+{
+    if ( m_rectOfInterest.isNull() )
+        return false;
+
+    return indexRange( m_rectOfInterest.left(),
+        m_rectOfInterest.right(), from, to );
+}
+
+/*!
+   \return True, when dx() > 0.0
+   \sa QwtPlotSeriesItem::OrderedSamples
+ */
+bool QwtAbstractUniformData::isMonotonic() const
+{
+    return m_dx > 0.0;
+}
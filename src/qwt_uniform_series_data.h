@@ -0,0 +1,298 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_UNIFORM_SERIES_DATA_H
+#define QWT_UNIFORM_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qvector.h>
+
+/*!
+   \brief Base class for series of uniformly sampled values
+
+   The x coordinate of the sample at index i is x0() + i * dx().
+   So the x coordinates don't need to be stored and the samples inside
+   of an x interval can be found arithmetically in O(1) - see indexRange().
+
+   The values might be stored in a ring buffer, where origin() is the
+   position of the first sample.
+
+   QwtPlotCurve, QwtPointMapper and QwtSeriesDataPyramid take
+   advantage of the uniform sampling:
+
+   - QwtPlotCurve restricts the painted samples to the
+     visible ones by indexRange() instead of a binary search
+   - QwtSeriesDataPyramid finds the samples of each pixel column
+     arithmetically
+   - QwtPointMapper maps the x coordinates of QwtUniformSeriesData<double>
+     and QwtUniformSeriesData<float> by adding a constant step,
+     when the x scale is linear
+
+   \sa QwtUniformSeriesData
+ */
+class QWT_EXPORT QwtAbstractUniformData : public QwtSeriesData< QPointF >
+{
+  public:
+    explicit QwtAbstractUniformData( double x0 = 0.0, double dx = 1.0 );
+    virtual ~QwtAbstractUniformData();
+
+    void setSampling( double x0, double dx );
+
+    double x0() const;
+    double dx() const;
+
+    void setOrigin( size_t );
+    size_t origin() const;
+
+    double xValue( size_t index ) const;
+
+    bool indexRange( double x1, double x2, int& from, int& to ) const;
+    int lowerIndex( double x ) const;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+    bool visibleRange( int& from, int& to ) const;
+
+    virtual bool isMonotonic() const QWT_OVERRIDE;
+
+  protected:
+    size_t position( size_t index ) const;
+
+  private:
+    double m_x0;
+    double m_dx;
+    size_t m_origin;
+
+    QRectF m_rectOfInterest;
+};
+
+/*!
+   \return x coordinate of a sample
+   \param index Index of the sample
+ */
+inline double QwtAbstractUniformData::xValue( size_t index ) const
+{
+    return m_x0 + index * m_dx;
+}
+
+/*!
+   \return Position of a sample in the ring buffer
+   \param index Index of the sample
+ */
+inline size_t QwtAbstractUniformData::position( size_t index ) const
+{
+    const size_t numSamples = size();
+
+    size_t pos = m_origin + index;
+    if ( pos >= numSamples )
+        pos -= numSamples;
+
+    return pos;
+}
+
+/*!
+   \brief Series of uniformly sampled values
+
+   QwtUniformSeriesData stores the y values only, the x coordinate of
+   the sample at index i is x0() + i * dx() - f.e. the time of a
+   signal, that has been sampled with a fixed rate. Compared to
+   QwtPointArrayData it needs half of the memory and compared to
+   QwtValuePointData the x coordinates are not limited to the index.
+
+   When the values are a ring buffer, origin() is the position of
+   the oldest value. shift() replaces the oldest value and moves
+   the x coordinates by dx(), so that a window of the most recent values
+   can be displayed without copying them.
+
+   \par Example
+   \code
+   QwtUniformSeriesData< float >* data =
+       new QwtUniformSeriesData< float >( values, t0, 1.0 / sampleRate );
+
+   curve->setData( new QwtSeriesDataPyramid( data ) );
+   \endcode
+   \endpar
+
+   \sa QwtValuePointData, QwtStridedValueData, QwtSeriesDataPyramid
+ */
+template< typename T >
+class QwtUniformSeriesData : public QwtAbstractUniformData
+{
+  public:
+    explicit QwtUniformSeriesData( const QVector< T >& y = QVector< T >(),
+        double x0 = 0.0, double dx = 1.0 );
+
+    void setValues( const QVector< T >& y );
+    const QVector< T >& yData() const;
+
+    void shift( const T& value );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void fetch( size_t from,
+        size_t numSamples, QPointF* samples ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    QVector< T > m_y;
+};
+
+/*!
+   Constructor
+
+   \param y Values
+   \param x0 x coordinate of the first sample
+   \param dx Distance between the x coordinates of 2 samples
+ */
+template< typename T >
+QwtUniformSeriesData< T >::QwtUniformSeriesData(
+        const QVector< T >& y, double x0, double dx )
+    : QwtAbstractUniformData( x0, dx )
+    , m_y( y )
+{
+}
+
+/*!
+   Assign the values
+
+   \param y Values, where origin() is the position of the first sample
+   \sa yData(), setOrigin()
+ */
+template< typename T >
+void QwtUniformSeriesData< T >::setValues( const QVector< T >& y )
+{
+    m_y = y;
+
+    if ( origin() >= size_t( m_y.size() ) )
+        setOrigin( 0 );
+
+    this->cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   \return Values, where origin() is the position of the first sample
+   \sa setValues()
+ */
+template< typename T >
+const QVector< T >& QwtUniformSeriesData< T >::yData() const
+{
+    return m_y;
+}
+
+/*!
+   \brief Replace the oldest value of the ring buffer
+
+   The value becomes the last sample, while x0() is moved by dx().
+
+   \param value New value
+   \sa setOrigin(), setSampling()
+ */
+template< typename T >
+void QwtUniformSeriesData< T >::shift( const T& value )
+{
+    if ( m_y.isEmpty() )
+        return;
+
+    const size_t pos = origin();
+    m_y[ int( pos ) ] = value;
+
+    setSampling( x0() + dx(), dx() );
+    setOrigin( pos + 1 < size() ? pos + 1 : 0 );
+}
+
+//! \return Number of samples
+template< typename T >
+size_t QwtUniformSeriesData< T >::size() const
+{
+    return m_y.size();
+}
+
+/*!
+   \return Sample at a specific position
+
+   \param index Index
+   \return Sample at position index
+ */
+template< typename T >
+QPointF QwtUniformSeriesData< T >::sample( size_t index ) const
+{
+    return QPointF( xValue( index ), m_y[ int( position( index ) ) ] );
+}
+
+/*!
+   \brief Copy a range of samples
+
+   \param from Index of the first sample
+   \param numSamples Number of samples
+   \param samples Array of at least numSamples points
+ */
+template< typename T >
+void QwtUniformSeriesData< T >::fetch(
+    size_t from, size_t numSamples, QPointF* samples ) const
+{
+    const T* values = m_y.constData();
+    const size_t count = size();
+
+    size_t pos = position( from );
+
+    for ( size_t i = 0; i < numSamples; i++ )
+    {
+        samples[i].rx() = xValue( from + i );
+        samples[i].ry() = values[pos];
+
+        if ( ++pos == count )
+            pos = 0;
+    }
+}
+
+/*!
+   \brief Calculate the bounding rectangle
+
+   The x coordinates are calculated from x0() and dx(), the
+   y coordinates are iterated, when the rectangle is invalid.
+
+   \return Bounding rectangle
+ */
+template< typename T >
+QRectF QwtUniformSeriesData< T >::boundingRect() const
+{
+    if ( this->cachedBoundingRect.width() < 0.0 )
+    {
+        if ( m_y.isEmpty() )
+            return QRectF( 1.0, 1.0, -2.0, -2.0 );
+
+        double yMin = m_y[0];
+        double yMax = m_y[0];
+
+        for ( int i = 1; i < m_y.size(); i++ )
+        {
+            const double y = m_y[i];
+
+            if ( y < yMin )
+                yMin = y;
+            else if ( y > yMax )
+                yMax = y;
+        }
+
+        const double x1 = xValue( 0 );
+        const double x2 = xValue( size() - 1 );
+
+        this->cachedBoundingRect.setCoords(
+            qMin( x1, x2 ), yMin, qMax( x1, x2 ), yMax );
+    }
+
+    return this->cachedBoundingRect;
+}
+
+#endif
@@ -22,6 +22,23 @@ QwtVectorFieldSymbol::~QwtVectorFieldSymbol()
 {
 }
 
+/*!
+   \brief Geometry of the symbol
+
+   The path has to match what is painted by paint() for the
+   current length() using the pen and brush of the painter.
+
+   The default implementation returns an empty path, indicating, that the
+   symbol can't be represented by a path.
+
+   \return Path of the symbol/arrow
+   \sa QwtPlotVectorField::BatchSymbols
+ */
+QPainterPath QwtVectorFieldSymbol::path() const
+{
+    return QPainterPath();
+}
+
 class QwtVectorFieldArrow::PrivateData
 {
   public:
@@ -97,6 +114,12 @@ void QwtVectorFieldArrow::paint( QPainter* painter ) const
     painter->drawPath( m_data->path );
 }
 
+//! \return Path of the arrow
+QPainterPath QwtVectorFieldArrow::path() const
+{
+    return m_data->path;
+}
+
 class QwtVectorFieldThinArrow::PrivateData
 {
   public:
@@ -158,3 +181,9 @@ void QwtVectorFieldThinArrow::paint(QPainter* p) const
 {
     p->drawPath( m_data->path );
 }
+
+//! \return Path of the arrow
+QPainterPath QwtVectorFieldThinArrow::path() const
+{
+    return m_data->path;
+}
@@ -28,6 +28,10 @@ class QPainterPath;
 
     A new arrow implementation can be set with QwtPlotVectorField::setArrowSymbol(), whereby
     ownership is transferred to the plot field.
+
+    When the arrow can be represented by a path(), QwtPlotVectorField
+    is able to paint many arrows by one call of QPainter::drawPath()
+    ( see QwtPlotVectorField::BatchSymbols ).
  */
 class QWT_EXPORT QwtVectorFieldSymbol
 {
@@ -50,6 +54,8 @@ class QWT_EXPORT QwtVectorFieldSymbol
     //! Draw the symbol/arrow
     virtual void paint( QPainter* ) const = 0;
 
+    virtual QPainterPath path() const;
+
   private:
     Q_DISABLE_COPY(QwtVectorFieldSymbol)
 };
@@ -68,6 +74,7 @@ class QWT_EXPORT QwtVectorFieldArrow : public QwtVectorFieldSymbol
     virtual qreal length() const QWT_OVERRIDE;
 
     virtual void paint( QPainter* ) const QWT_OVERRIDE;
+    virtual QPainterPath path() const QWT_OVERRIDE;
 
   private:
     class PrivateData;
@@ -88,6 +95,7 @@ class QWT_EXPORT QwtVectorFieldThinArrow : public QwtVectorFieldSymbol
     virtual qreal length() const QWT_OVERRIDE;
 
     virtual void paint( QPainter* ) const QWT_OVERRIDE;
+    virtual QPainterPath path() const QWT_OVERRIDE;
 
   private:
     class PrivateData;
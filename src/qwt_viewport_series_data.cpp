@@ -0,0 +1,561 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_viewport_series_data.h"
+#include "qwt_interval.h"
+#include "qwt_plot.h"
+
+#include <qwidget.h>
+#include <qpointer.h>
+#include <qtimer.h>
+#include <qlist.h>
+#include <qmutex.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // interval between replots, while samples are fetched
+    const int qwtFetchPollInterval = 50;
+
+    // resolution, when there is no canvas
+    const int qwtDefaultResolution = 1000;
+
+    class QwtViewportFetch
+    {
+      public:
+        QwtViewportFetch()
+            : resolution( 0 )
+        {
+        }
+
+        inline double density() const
+        {
+            const double w = interval.width();
+            return ( w > 0.0 ) ? resolution / w : 0.0;
+        }
+
+        inline bool operator==( const QwtViewportFetch& other ) const
+        {
+            return ( resolution == other.resolution )
+                && ( interval == other.interval );
+        }
+
+        QwtInterval interval;
+        int resolution;
+
+        QVector< QPointF > samples;
+    };
+}
+
+class QwtViewportSeriesData::PrivateData
+{
+  public:
+    PrivateData()
+        : resolution( 0 )
+        , margin( 0.25 )
+        , cacheSize( 8 )
+        , boundingRect( 1.0, 1.0, -2.0, -2.0 )
+        , pollTimer( NULL )
+        , hasRequest( false )
+        , isBusy( false )
+        , isRunning( false )
+        , generation( 0 )
+        , fetchGeneration( 0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete pollTimer;
+    }
+
+    QPointer< QwtPlot > plot;
+
+    int resolution;
+    double margin;
+    int cacheSize;
+
+    QRectF boundingRect;
+    QRectF rectOfInterest;
+
+    // GUI thread only: the most recently used fetch first
+
+    QList< QwtViewportFetch > cache;
+    QVector< QPointF > samples;
+
+    QTimer* pollTimer;
+
+    // shared with the fetching thread, protected by mutex
+
+    mutable QMutex mutex;
+
+    QwtViewportFetch request;
+    bool hasRequest;
+
+    QwtViewportFetch current;
+    bool isBusy;
+    bool isRunning;
+
+    QList< QwtViewportFetch > results;
+
+    int generation;
+    int fetchGeneration;
+
+#if QWT_USE_THREADS
+    QFuture< void > future;
+#endif
+};
+
+/*!
+   \brief Constructor
+
+   The default settings are a margin of 0.25, a cache of 8 fetches
+   and the resolution of the canvas.
+ */
+QwtViewportSeriesData::QwtViewportSeriesData()
+{
+    m_data = new PrivateData();
+}
+
+/*!
+   \brief Destructor
+
+   \note Derived classes have to call cancelFetch() in their destructor
+ */
+QwtViewportSeriesData::~QwtViewportSeriesData()
+{
+    cancelFetch();
+    delete m_data;
+}
+
+/*!
+   \brief Assign the plot, that is replotted when a fetch has finished
+
+   The width of the canvas of the plot is also the default
+   for the resolution.
+
+   \param plot Plot
+   \sa plot(), setResolution()
+ */
+void QwtViewportSeriesData::setPlot( QwtPlot* plot )
+{
+    if ( plot == m_data->plot )
+        return;
+
+    m_data->plot = plot;
+
+    if ( m_data->pollTimer )
+    {
+        m_data->pollTimer->stop();
+        m_data->pollTimer->disconnect();
+
+        if ( plot )
+        {
+            QObject::connect( m_data->pollTimer, SIGNAL(timeout()),
+                plot, SLOT(replot()) );
+        }
+    }
+}
+
+/*!
+   \return Plot, that is replotted when a fetch has finished
+   \sa setPlot()
+ */
+QwtPlot* QwtViewportSeriesData::plot() const
+{
+    return m_data->plot;
+}
+
+/*!
+   \brief Set the resolution for the x interval of the rectangle of interest
+
+   \param numPixels Number of pixels. A value <= 0 means the width of the
+                    canvas of plot(). The default setting is 0.
+
+   \sa resolution(), fetchSamples()
+ */
+void QwtViewportSeriesData::setResolution( int numPixels )
+{
+    m_data->resolution = qMax( numPixels, 0 );
+}
+
+/*!
+   \return Resolution for the x interval of the rectangle of interest
+   \sa setResolution()
+ */
+int QwtViewportSeriesData::resolution() const
+{
+    return m_data->resolution;
+}
+
+/*!
+   \brief Set the margin of fetches
+
+   The x interval of a fetch is the interval of the rectangle of interest
+   extended by margin * width at both sides. So panning the plot doesn't
+   result in a fetch for each step.
+
+   \param margin Margin as fraction of the width of the visible x interval.
+                 The default setting is 0.25.
+
+   \sa margin()
+ */
+void QwtViewportSeriesData::setMargin( double margin )
+{
+    m_data->margin = qMax( margin, 0.0 );
+}
+
+/*!
+   \return Margin of fetches
+   \sa setMargin()
+ */
+double QwtViewportSeriesData::margin() const
+{
+    return m_data->margin;
+}
+
+/*!
+   \brief Set the number of fetches, that are cached
+
+   \param numFetches Number of cached fetches. The default setting is 8.
+   \sa cacheSize(), invalidate()
+ */
+void QwtViewportSeriesData::setCacheSize( int numFetches )
+{
+    m_data->cacheSize = qMax( numFetches, 1 );
+
+    while ( m_data->cache.size() > m_data->cacheSize )
+        m_data->cache.removeLast();
+}
+
+/*!
+   \return Number of fetches, that are cached
+   \sa setCacheSize()
+ */
+int QwtViewportSeriesData::cacheSize() const
+{
+    return m_data->cacheSize;
+}
+
+/*!
+   \brief Set the bounding rectangle of all samples of the backend
+
+   As the samples are not loaded completely the bounding rectangle can't
+   be calculated. It is needed for autoscaling and should be set from
+   the meta data of the backend.
+
+   \param rect Bounding rectangle
+   \sa boundingRect()
+ */
+void QwtViewportSeriesData::setBoundingRect( const QRectF& rect )
+{
+    m_data->boundingRect = rect;
+}
+
+/*!
+   \return Bounding rectangle assigned by setBoundingRect(), or the bounding
+           rectangle of the samples being presented, when no
+           rectangle has been assigned.
+ */
+QRectF QwtViewportSeriesData::boundingRect() const
+{
+    if ( m_data->boundingRect.width() >= 0.0 )
+        return m_data->boundingRect;
+
+    return qwtBoundingRect( *this );
+}
+
+//! \return Number of samples being presented
+size_t QwtViewportSeriesData::size() const
+{
+    return m_data->samples.size();
+}
+
+/*!
+   \param index Index
+   \return Sample being presented
+ */
+QPointF QwtViewportSeriesData::sample( size_t index ) const
+{
+    return m_data->samples[ int( index ) ];
+}
+
+/*!
+   \brief Update the samples for a rectangle of interest
+
+   The best match from the cache is presented. When it doesn't cover
+   the x interval of the rectangle in the requested resolution,
+   a fetch is started.
+
+   \param rect Rectangle of interest
+   \sa rectOfInterest(), fetchSamples()
+ */
+void QwtViewportSeriesData::setRectOfInterest( const QRectF& rect )
+{
+    m_data->rectOfInterest = rect;
+    updateView();
+}
+
+/*!
+   \return Rectangle of interest
+   \sa setRectOfInterest()
+ */
+QRectF QwtViewportSeriesData::rectOfInterest() const
+{
+    return m_data->rectOfInterest;
+}
+
+/*!
+   \return true, when fetches are pending or running, or their results
+           have not been presented yet
+ */
+bool QwtViewportSeriesData::isFetching() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->hasRequest || m_data->isBusy || !m_data->results.isEmpty();
+}
+
+/*!
+   \brief Discard all cached samples and fetch again
+
+   invalidate() has to be called, when the samples of the backend
+   have been modified.
+ */
+void QwtViewportSeriesData::invalidate()
+{
+    cancelFetch();
+
+    m_data->cache.clear();
+    m_data->samples.clear();
+
+    updateView();
+}
+
+/*!
+   \brief Cancel pending fetches and wait for a running fetch
+
+   The result of the running fetch will be discarded.
+   \sa isFetchCanceled()
+ */
+void QwtViewportSeriesData::cancelFetch()
+{
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        m_data->hasRequest = false;
+        m_data->results.clear();
+        m_data->generation++;
+    }
+
+#if QWT_USE_THREADS
+    m_data->future.waitForFinished();
+#endif
+
+    if ( m_data->pollTimer )
+        m_data->pollTimer->stop();
+}
+
+/*!
+   \return true, when the result of the running fetch is not needed
+           anymore: another fetch is pending or the fetches have been
+           canceled.
+
+   Backends with long running queries might check isFetchCanceled()
+   in fetchSamples() and return early.
+ */
+bool QwtViewportSeriesData::isFetchCanceled() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    return m_data->hasRequest
+        || m_data->fetchGeneration != m_data->generation;
+}
+
+/*
+    Executed in a background thread: fetches the requested samples,
+    until no more requests are pending.
+ */
+void QwtViewportSeriesData::fetchLoop( QwtViewportSeriesData* series )
+{
+    PrivateData* d = series->m_data;
+
+    while ( true )
+    {
+        QwtViewportFetch fetch;
+
+        {
+            QMutexLocker locker( &d->mutex );
+
+            if ( !d->hasRequest )
+            {
+                d->isBusy = false;
+                d->isRunning = false;
+                return;
+            }
+
+            fetch = d->request;
+            d->hasRequest = false;
+
+            d->current = fetch;
+            d->isBusy = true;
+            d->fetchGeneration = d->generation;
+        }
+
+        fetch.samples = series->fetchSamples( fetch.interval, fetch.resolution );
+
+        {
+            QMutexLocker locker( &d->mutex );
+
+            if ( d->fetchGeneration == d->generation )
+                d->results += fetch;
+
+            d->isBusy = false;
+        }
+    }
+}
+
+bool QwtViewportSeriesData::syncResults()
+{
+    QList< QwtViewportFetch > results;
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        results = m_data->results;
+        m_data->results.clear();
+    }
+
+    for ( int i = 0; i < results.size(); i++ )
+        m_data->cache.prepend( results[i] );
+
+    while ( m_data->cache.size() > m_data->cacheSize )
+        m_data->cache.removeLast();
+
+    return !results.isEmpty();
+}
+
+void QwtViewportSeriesData::updateView()
+{
+    PrivateData* d = m_data;
+
+    syncResults();
+
+    const QRectF& rect = d->rectOfInterest;
+    if ( !( rect.width() > 0.0 ) )
+        return;
+
+    const QwtInterval interval( rect.left(), rect.right() );
+
+    int resolution = d->resolution;
+    if ( resolution <= 0 )
+    {
+        resolution = qwtDefaultResolution;
+        if ( d->plot && d->plot->canvas() )
+            resolution = qMax( d->plot->canvas()->width(), 1 );
+    }
+
+    const double density = resolution / interval.width();
+
+    // the best match: covering the interval in the highest
+    // resolution, otherwise covering most of the interval
+
+    int bestIndex = -1;
+    bool covers = false;
+    double overlap = 0.0;
+
+    for ( int i = 0; i < d->cache.size(); i++ )
+    {
+        const QwtViewportFetch& fetch = d->cache[i];
+
+        if ( fetch.interval.contains( interval.minValue() )
+            && fetch.interval.contains( interval.maxValue() ) )
+        {
+            if ( !covers || fetch.density() > d->cache[bestIndex].density() )
+                bestIndex = i;
+
+            covers = true;
+        }
+        else if ( !covers )
+        {
+            const double w = ( fetch.interval & interval ).width();
+            if ( w > overlap )
+            {
+                overlap = w;
+                bestIndex = i;
+            }
+        }
+    }
+
+    if ( bestIndex >= 0 )
+    {
+        d->cache.move( bestIndex, 0 );
+        d->samples = d->cache.first().samples;
+
+        if ( covers && d->cache.first().density() >= 0.9 * density )
+            return;
+    }
+
+    QwtViewportFetch request;
+    request.interval = interval.extend( interval.minValue() - d->margin * interval.width() )
+        .extend( interval.maxValue() + d->margin * interval.width() );
+    request.resolution = qRound( resolution * ( 1.0 + 2.0 * d->margin ) );
+
+#if QWT_USE_THREADS
+    bool start = false;
+
+    {
+        QMutexLocker locker( &d->mutex );
+
+        if ( ( d->hasRequest && d->request == request )
+            || ( d->isBusy && d->current == request && !d->hasRequest ) )
+        {
+            // already on its way
+        }
+        else
+        {
+            d->request = request;
+            d->hasRequest = true;
+        }
+
+        start = !d->isRunning;
+        d->isRunning = true;
+    }
+
+    if ( start )
+        d->future = QtConcurrent::run( &QwtViewportSeriesData::fetchLoop, this );
+
+    if ( d->plot )
+    {
+        if ( d->pollTimer == NULL )
+        {
+            d->pollTimer = new QTimer();
+            d->pollTimer->setSingleShot( true );
+
+            QObject::connect( d->pollTimer, SIGNAL(timeout()),
+                d->plot, SLOT(replot()) );
+        }
+
+        if ( !d->pollTimer->isActive() )
+            d->pollTimer->start( qwtFetchPollInterval );
+    }
+#else
+    request.samples = fetchSamples( request.interval, request.resolution );
+
+    d->cache.prepend( request );
+    while ( d->cache.size() > d->cacheSize )
+        d->cache.removeLast();
+
+    d->samples = request.samples;
+#endif
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_VIEWPORT_SERIES_DATA_H
+#define QWT_VIEWPORT_SERIES_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+#include <qvector.h>
+
+class QwtPlot;
+class QwtInterval;
+
+/*!
+   \brief Series data, that loads its samples for the visible area
+
+   QwtViewportSeriesData is an abstract base class for series, where the
+   samples are stored in a backend - f.e. a database, a network service
+   or a file - and are loaded on demand for the x interval and resolution
+   of the plot canvas.
+
+   QwtPlotSeriesItem calls setRectOfInterest(), whenever the scales
+   have changed. When there are no samples cached, that cover the x interval
+   of the rectangle in the requested resolution, fetchSamples() is executed
+   in a background thread. In the meantime the series presents the best
+   match of the cache - usually the samples of a previous fetch
+   in a coarser resolution. When the fetch has finished the plot, that has
+   been assigned by setPlot(), is replotted.
+
+   The resolution is the number of pixels of the canvas, unless
+   it has been set explicitly by setResolution().
+
+   \par Example
+   \code
+   class HistorianData: public QwtViewportSeriesData
+   {
+     public:
+       virtual ~HistorianData()
+       {
+           cancelFetch();
+       }
+
+     protected:
+       virtual QVector< QPointF > fetchSamples(
+           const QwtInterval& interval, int resolution ) const
+       {
+           // executed in a background thread
+           return queryAggregated( interval, resolution );
+       }
+   };
+
+   HistorianData* data = new HistorianData();
+   data->setBoundingRect( QRectF( t1, 0.0, t2 - t1, 100.0 ) );
+   data->setPlot( plot );
+
+   curve->setData( data );
+   \endcode
+   \endpar
+
+   \note Derived classes have to call cancelFetch() in their destructor,
+         so that fetchSamples() is not called for an object being destroyed.
+
+   \note Without support for QFuture the samples are fetched in
+         setRectOfInterest().
+
+   \sa QwtSyntheticPointData, QwtMappedSeriesData
+ */
+class QWT_EXPORT QwtViewportSeriesData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtViewportSeriesData();
+    virtual ~QwtViewportSeriesData();
+
+    void setPlot( QwtPlot* );
+    QwtPlot* plot() const;
+
+    void setResolution( int );
+    int resolution() const;
+
+    void setMargin( double );
+    double margin() const;
+
+    void setCacheSize( int );
+    int cacheSize() const;
+
+    void setBoundingRect( const QRectF& );
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual void setRectOfInterest( const QRectF& ) QWT_OVERRIDE;
+    QRectF rectOfInterest() const;
+
+    bool isFetching() const;
+
+    void invalidate();
+    void cancelFetch();
+
+  protected:
+    /*!
+       \brief Fetch samples from the backend
+
+       fetchSamples() is executed in a background thread and must not
+       access the plot or any other object living in the GUI thread.
+
+       \param interval X interval
+       \param resolution Number of pixels for the interval. Backends
+                         with aggregated data might return samples
+                         in this resolution - f.e. the minimum and maximum
+                         for each pixel.
+
+       \return Samples with increasing x coordinates
+
+       \sa isFetchCanceled()
+     */
+    virtual QVector< QPointF > fetchSamples(
+        const QwtInterval& interval, int resolution ) const = 0;
+
+    bool isFetchCanceled() const;
+
+  private:
+    Q_DISABLE_COPY( QwtViewportSeriesData )
+
+    void updateView();
+    bool syncResults();
+
+    static void fetchLoop( QwtViewportSeriesData* );
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -11,21 +11,373 @@
 #include "qwt_math.h"
 
 #include <qpainterpath.h>
+#include <qpair.h>
 #include <qpolygon.h>
 #include <qstack.h>
 #include <qvector.h>
 
+#include <algorithm>
+
+namespace
+{
+    /*
+       A tree of convex hulls over blocks of consecutive points.
+
+       A node of level l is the convex hull of 2^l blocks. As the
+       point with the maximum distance from a line is a vertex
+       of the convex hull, the farthest point of any index range
+       can be found by querying O( log( n ) ) nodes - each of them
+       by a binary search on its upper and lower chain.
+     */
+    class HullTree
+    {
+      public:
+        enum { BlockSize = 32 };
+
+        explicit HullTree( const QPolygonF& points )
+            : m_points( points.constData() )
+            , m_numPoints( points.size() )
+        {
+            build();
+        }
+
+        /*
+           Find the point in ]from, to[ with the maximum perpendicular
+           distance to the line through points[from] and points[to]
+         */
+        int farthestPoint( int from, int to, double& distance ) const
+        {
+            const QPointF& p1 = m_points[from];
+            const QPointF& p2 = m_points[to];
+
+            const double dx = p2.x() - p1.x();
+            const double dy = p2.y() - p1.y();
+            const double length = std::sqrt( dx * dx + dy * dy );
+
+            Query query;
+            query.index = from + 1;
+            query.distance = 0.0;
+
+            if ( length == 0.0 )
+            {
+                // no direction: the distance is the distance to p1
+
+                for ( int i = from + 1; i < to; i++ )
+                {
+                    const double vx = m_points[i].x() - p1.x();
+                    const double vy = m_points[i].y() - p1.y();
+
+                    const double d = std::sqrt( vx * vx + vy * vy );
+                    if ( d > query.distance )
+                    {
+                        query.distance = d;
+                        query.index = i;
+                    }
+                }
+
+                distance = query.distance;
+                return query.index;
+            }
+
+            query.nx = -dy / length;
+            query.ny = dx / length;
+            query.c = query.nx * p1.x() + query.ny * p1.y();
+
+            const int first = from + 1;
+            const int last = to - 1;
+
+            const int firstBlock = ( first + BlockSize - 1 ) / BlockSize;
+            const int lastBlock = ( last + 1 ) / BlockSize - 1;
+
+            if ( lastBlock - firstBlock < 1 )
+            {
+                scan( query, first, last );
+            }
+            else
+            {
+                scan( query, first, firstBlock * BlockSize - 1 );
+                scan( query, ( lastBlock + 1 ) * BlockSize, last );
+
+                int l = firstBlock;
+                int r = lastBlock + 1;
+
+                for ( int level = 0; l < r; level++ )
+                {
+                    if ( l & 1 )
+                        searchNode( query, m_levels[level] + l++ );
+
+                    if ( r & 1 )
+                        searchNode( query, m_levels[level] + --r );
+
+                    l >>= 1;
+                    r >>= 1;
+                }
+            }
+
+            distance = query.distance;
+            return query.index;
+        }
+
+      private:
+        class Node
+        {
+          public:
+            int upper;
+            int lower;
+            int end;
+        };
+
+        class Query
+        {
+          public:
+            double nx;
+            double ny;
+            double c;
+
+            int index;
+            double distance;
+        };
+
+        class LessThan
+        {
+          public:
+            explicit LessThan( const QPointF* points )
+                : m_points( points )
+            {
+            }
+
+            bool operator()( int i1, int i2 ) const
+            {
+                const QPointF& p1 = m_points[i1];
+                const QPointF& p2 = m_points[i2];
+
+                if ( p1.x() != p2.x() )
+                    return p1.x() < p2.x();
+
+                if ( p1.y() != p2.y() )
+                    return p1.y() < p2.y();
+
+                return i1 < i2;
+            }
+
+          private:
+            const QPointF* m_points;
+        };
+
+        void build()
+        {
+            const int numBlocks = m_numPoints / BlockSize;
+
+            int numNodes = 0;
+            for ( int n = numBlocks; n > 0; n /= 2 )
+            {
+                m_levels += numNodes;
+                numNodes += n;
+            }
+
+            m_nodes.reserve( numNodes );
+            m_hulls.reserve( 4 * numNodes );
+
+            QVector< int > candidates;
+            candidates.reserve( BlockSize );
+
+            for ( int i = 0; i < numBlocks; i++ )
+            {
+                candidates.clear();
+                for ( int j = 0; j < BlockSize; j++ )
+                    candidates += i * BlockSize + j;
+
+                appendNode( candidates );
+            }
+
+            for ( int level = 1; level < m_levels.size(); level++ )
+            {
+                const int numChildren = m_levels[level] - m_levels[level - 1];
+
+                for ( int i = 0; i < numChildren / 2; i++ )
+                {
+                    // the hull of the union is the hull of the vertices of the children
+
+                    candidates.clear();
+
+                    for ( int j = 0; j < 2; j++ )
+                    {
+                        const Node& child = m_nodes[ m_levels[level - 1] + 2 * i + j ];
+                        for ( int k = child.upper; k < child.end; k++ )
+                            candidates += m_hulls[k];
+                    }
+
+                    appendNode( candidates );
+                }
+            }
+        }
+
+        void appendNode( QVector< int >& candidates )
+        {
+            std::sort( candidates.begin(), candidates.end(), LessThan( m_points ) );
+
+            Node node;
+
+            node.upper = m_hulls.size();
+            appendChain( candidates, 1.0 );
+
+            node.lower = m_hulls.size();
+            appendChain( candidates, -1.0 );
+
+            node.end = m_hulls.size();
+
+            m_nodes += node;
+        }
+
+        // Andrew's monotone chain
+        void appendChain( const QVector< int >& candidates, double orientation )
+        {
+            const int start = m_hulls.size();
+
+            for ( int i = 0; i < candidates.size(); i++ )
+            {
+                const QPointF& p = m_points[ candidates[i] ];
+
+                while ( m_hulls.size() - start >= 2 )
+                {
+                    const QPointF& p1 = m_points[ m_hulls[ m_hulls.size() - 2 ] ];
+                    const QPointF& p2 = m_points[ m_hulls.last() ];
+
+                    const double cross = ( p2.x() - p1.x() ) * ( p.y() - p1.y() )
+                        - ( p2.y() - p1.y() ) * ( p.x() - p1.x() );
+
+                    if ( orientation * cross < 0.0 )
+                        break;
+
+                    m_hulls.removeLast();
+                }
+
+                m_hulls += candidates[i];
+            }
+        }
+
+        void scan( Query& query, int from, int to ) const
+        {
+            for ( int i = from; i <= to; i++ )
+                update( query, i );
+        }
+
+        void searchNode( Query& query, int nodeIndex ) const
+        {
+            const Node& node = m_nodes[nodeIndex];
+
+            // the extreme points on both sides of the line
+            update( query, extremeVertex( node, query.nx, query.ny ) );
+            update( query, extremeVertex( node, -query.nx, -query.ny ) );
+        }
+
+        /*
+           The vertex with the maximum projection onto a direction.
+
+           For directions pointing upwards it is on the upper chain,
+           otherwise on the lower chain. Along the chain the projections
+           are unimodal, so that it can be found by a binary search.
+         */
+        int extremeVertex( const Node& node, double dx, double dy ) const
+        {
+            int lo = ( dy > 0.0 ) ? node.upper : node.lower;
+            int hi = ( dy > 0.0 ) ? node.lower - 1 : node.end - 1;
+
+            while ( lo < hi )
+            {
+                const int mid = ( lo + hi ) / 2;
+
+                const QPointF& p1 = m_points[ m_hulls[mid] ];
+                const QPointF& p2 = m_points[ m_hulls[mid + 1] ];
+
+                if ( dx * ( p2.x() - p1.x() ) + dy * ( p2.y() - p1.y() ) > 0.0 )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+
+            return m_hulls[lo];
+        }
+
+        void update( Query& query, int index ) const
+        {
+            const QPointF& p = m_points[index];
+
+            const double d = std::fabs( query.nx * p.x() + query.ny * p.y() - query.c );
+            if ( d > query.distance )
+            {
+                query.distance = d;
+                query.index = index;
+            }
+        }
+
+        const QPointF* m_points;
+        const int m_numPoints;
+
+        QVector< int > m_levels;
+        QVector< Node > m_nodes;
+        QVector< int > m_hulls;
+    };
+}
+
+static QPolygonF qwtSimplifyHull( const QPolygonF& points, double tolerance )
+{
+    const int nPoints = points.size();
+    if ( nPoints < 3 )
+        return points;
+
+    const HullTree tree( points );
+
+    QVector< bool > usePoint( nPoints, false );
+
+    QStack< QPair< int, int > > stack;
+    stack.push( qMakePair( 0, nPoints - 1 ) );
+
+    while ( !stack.isEmpty() )
+    {
+        const QPair< int, int > r = stack.pop();
+
+        double distance = 0.0;
+
+        int index = r.first + 1;
+        if ( index < r.second )
+            index = tree.farthestPoint( r.first, r.second, distance );
+
+        if ( distance <= tolerance )
+        {
+            usePoint[r.first] = true;
+            usePoint[r.second] = true;
+        }
+        else
+        {
+            stack.push( qMakePair( r.first, index ) );
+            stack.push( qMakePair( index, r.second ) );
+        }
+    }
+
+    QPolygonF stripped;
+    for ( int i = 0; i < nPoints; i++ )
+    {
+        if ( usePoint[i] )
+            stripped += points[i];
+    }
+
+    return stripped;
+}
+
 class QwtWeedingCurveFitter::PrivateData
 {
   public:
     PrivateData()
         : tolerance( 1.0 )
         , chunkSize( 0 )
+        , algorithm( QwtWeedingCurveFitter::DouglasPeucker )
     {
     }
 
     double tolerance;
     uint chunkSize;
+    QwtWeedingCurveFitter::Algorithm algorithm;
 };
 
 class QwtWeedingCurveFitter::Line
@@ -60,6 +412,26 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
     delete m_data;
 }
 
+/*!
+   Set the implementation of the Douglas and Peucker algorithm
+
+   \param algorithm Algorithm
+   \sa algorithm()
+ */
+void QwtWeedingCurveFitter::setAlgorithm( Algorithm algorithm )
+{
+    m_data->algorithm = algorithm;
+}
+
+/*!
+   \return Implementation of the Douglas and Peucker algorithm
+   \sa setAlgorithm()
+ */
+QwtWeedingCurveFitter::Algorithm QwtWeedingCurveFitter::algorithm() const
+{
+    return m_data->algorithm;
+}
+
 /*!
    Assign the tolerance
 
@@ -94,6 +466,8 @@ double QwtWeedingCurveFitter::tolerance() const
    with the number of points. For a chunk size > 0 the polygon
    is split into pieces passed to the algorithm one by one.
 
+   \note Splitting is not necessary for the HullDouglasPeucker algorithm
+
    \param numPoints Maximum for the number of points passed to the algorithm
 
    \sa chunkSize()
@@ -157,6 +531,9 @@ QPainterPath QwtWeedingCurveFitter::fitCurvePath( const QPolygonF& points ) cons
 
 QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF& points ) const
 {
+    if ( m_data->algorithm == HullDouglasPeucker )
+        return qwtSimplifyHull( points, m_data->tolerance );
+
     const double toleranceSqr = m_data->tolerance * m_data->tolerance;
 
     QStack< Line > stack;
@@ -21,12 +21,17 @@
    maximum distance (tolerance) between the original curve and the
    smoothed curve.
 
-   The runtime of the algorithm increases non linear ( worst case O( n*n ) )
+   The runtime of the classic algorithm increases non linear ( worst case O( n*n ) )
    and might be very slow for huge polygons. To avoid performance issues
    it might be useful to split the polygon ( setChunkSize() ) and to run the algorithm
    for these smaller parts. The disadvantage of having no interpolation
    at the borders is for most use cases irrelevant.
 
+   Alternatively the HullDouglasPeucker algorithm can be used, that finds
+   the farthest point of a segment by querying a tree of convex hulls. Its
+   worst case is O( n * log( n ) * log( n ) ), so that there is no need for
+   splitting the polygon.
+
    The smoothed curve consists of a subset of the points that defined the
    original curve.
 
@@ -34,13 +39,44 @@
    the number of points. By adjusting the tolerance parameter according to the
    axis scales QwtSplineCurveFitter can be used to implement different
    level of details to speed up painting of curves of many points.
+
+   \note QwtPlotCurve applies the curve fitter to polygons in paint device
+         coordinates. So the tolerance is in pixels and the level of details
+         adapts to the scales of the plot without further ado.
+
+   \sa QwtIncrementalWeeder
  */
 class QWT_EXPORT QwtWeedingCurveFitter : public QwtCurveFitter
 {
   public:
+    /*!
+       \brief Implementation of the Douglas and Peucker algorithm
+       \sa setAlgorithm()
+     */
+    enum Algorithm
+    {
+        /*!
+           The classic implementation, that scans all points of a
+           segment for finding its farthest point. The distance of
+           a point is the distance to the segment.
+         */
+        DouglasPeucker,
+
+        /*!
+           The farthest point of a segment is found by querying
+           a tree of convex hulls built over the polygon.
+           The distance of a point is the perpendicular distance
+           to the line through the end points of the segment.
+         */
+        HullDouglasPeucker
+    };
+
     explicit QwtWeedingCurveFitter( double tolerance = 1.0 );
     virtual ~QwtWeedingCurveFitter();
 
+    void setAlgorithm( Algorithm );
+    Algorithm algorithm() const;
+
     void setTolerance( double );
     double tolerance() const;
 
@@ -18,6 +18,7 @@
 #include <qstyle.h>
 #include <qstyleoption.h>
 #include <qelapsedtimer.h>
+#include <qpixmap.h>
 #include <qmath.h>
 
 class QwtWheel::PrivateData
@@ -50,6 +51,12 @@ class QwtWheel::PrivateData
         , inverted( false )
         , wrapping( false )
     {
+        backgroundCache.pixelRatio = 1.0;
+        backgroundCache.orientation = Qt::Horizontal;
+        backgroundCache.wheelBorderWidth = 0;
+
+        for ( int i = 0; i < 5; i++ )
+            backgroundCache.colors[i] = 0;
     }
 
     Qt::Orientation orientation;
@@ -86,6 +93,18 @@ class QwtWheel::PrivateData
     bool pendingValueChanged; // when not tracking
     bool inverted;
     bool wrapping;
+
+    // the background does not depend on the value
+    struct t_backgroundCache
+    {
+        QPixmap pixmap;
+
+        QRectF rect;
+        qreal pixelRatio;
+        Qt::Orientation orientation;
+        int wheelBorderWidth;
+        QRgb colors[5];
+    } backgroundCache;
 };
 
 //! Constructor
@@ -752,22 +771,14 @@ void QwtWheel::paintEvent( QPaintEvent* event )
         QwtPainter::drawFocusRect( &painter, this );
 }
 
-/*!
-   Draw the Wheel's background gradient
-
-   \param painter Painter
-   \param rect Geometry for the wheel
- */
-void QwtWheel::drawWheelBackground(
-    QPainter* painter, const QRectF& rect )
+static void qwtDrawWheelBackground( QPainter* painter, const QRectF& rect,
+    const QPalette& pal, Qt::Orientation orientation, int wheelBorderWidth )
 {
     painter->save();
 
-    QPalette pal = palette();
-
     //  draw shaded background
     QLinearGradient gradient( rect.topLeft(),
-        ( m_data->orientation == Qt::Horizontal ) ? rect.topRight() : rect.bottomLeft() );
+        ( orientation == Qt::Horizontal ) ? rect.topRight() : rect.bottomLeft() );
     gradient.setColorAt( 0.0, pal.color( QPalette::Button ) );
     gradient.setColorAt( 0.2, pal.color( QPalette::Midlight ) );
     gradient.setColorAt( 0.7, pal.color( QPalette::Mid ) );
@@ -777,14 +788,14 @@ void QwtWheel::drawWheelBackground(
 
     // draw internal border
 
-    const QPen lightPen( palette().color( QPalette::Light ),
-        m_data->wheelBorderWidth, Qt::SolidLine, Qt::FlatCap );
+    const QPen lightPen( pal.color( QPalette::Light ),
+        wheelBorderWidth, Qt::SolidLine, Qt::FlatCap );
     const QPen darkPen( pal.color( QPalette::Dark ),
-        m_data->wheelBorderWidth, Qt::SolidLine, Qt::FlatCap );
+        wheelBorderWidth, Qt::SolidLine, Qt::FlatCap );
 
-    const double bw2 = 0.5 * m_data->wheelBorderWidth;
+    const double bw2 = 0.5 * wheelBorderWidth;
 
-    if ( m_data->orientation == Qt::Horizontal )
+    if ( orientation == Qt::Horizontal )
     {
         painter->setPen( lightPen );
         painter->drawLine( QPointF( rect.left(), rect.top() + bw2 ),
@@ -808,6 +819,69 @@ void QwtWheel::drawWheelBackground(
     painter->restore();
 }
 
+/*!
+   Draw the Wheel's background gradient
+
+   \param painter Painter
+   \param rect Geometry for the wheel
+ */
+void QwtWheel::drawWheelBackground(
+    QPainter* painter, const QRectF& rect )
+{
+    /*
+        The background doesn't change with the value, so
+        we can reuse it, when the wheel is spinning
+     */
+    if ( rect.isEmpty() )
+        return;
+
+    const QPalette::ColorRole roles[] =
+    {
+        QPalette::Button, QPalette::Midlight, QPalette::Mid,
+        QPalette::Dark, QPalette::Light
+    };
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( this );
+
+    PrivateData::t_backgroundCache& cache = m_data->backgroundCache;
+
+    bool isValid = !cache.pixmap.isNull() && cache.rect == rect
+        && cache.pixelRatio == pixelRatio
+        && cache.orientation == m_data->orientation
+        && cache.wheelBorderWidth == m_data->wheelBorderWidth;
+
+    for ( int i = 0; i < 5; i++ )
+    {
+        const QRgb rgb = palette().color( roles[i] ).rgba();
+        if ( cache.colors[i] != rgb )
+        {
+            cache.colors[i] = rgb;
+            isValid = false;
+        }
+    }
+
+    if ( !isValid )
+    {
+        const QRect r = rect.toAlignedRect();
+
+        cache.pixmap = QwtPainter::backingStore( this, r.size() );
+        cache.pixmap.fill( Qt::transparent );
+
+        QPainter p( &cache.pixmap );
+        p.translate( -r.topLeft() );
+        qwtDrawWheelBackground( &p, rect, palette(),
+            m_data->orientation, m_data->wheelBorderWidth );
+        p.end();
+
+        cache.rect = rect;
+        cache.pixelRatio = pixelRatio;
+        cache.orientation = m_data->orientation;
+        cache.wheelBorderWidth = m_data->wheelBorderWidth;
+    }
+
+    painter->drawPixmap( rect.toAlignedRect().topLeft(), cache.pixmap );
+}
+
 /*!
    Draw the Wheel's ticks
 
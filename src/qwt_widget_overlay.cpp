@@ -117,6 +117,9 @@ class QwtWidgetOverlay::PrivateData
     MaskMode maskMode;
     RenderMode renderMode;
     uchar* rgbaBuffer;
+
+    // region of the previous update, when using UpdateRegion
+    QRegion updateRegion;
 };
 
 /*!
@@ -157,6 +160,12 @@ void QwtWidgetOverlay::setMaskMode( MaskMode mode )
     {
         m_data->maskMode = mode;
         m_data->resetRgbaBuffer();
+
+        if ( mode == QwtWidgetOverlay::UpdateRegion )
+        {
+            clearMask();
+            m_data->updateRegion = rect();
+        }
     }
 }
 
@@ -191,9 +200,27 @@ QwtWidgetOverlay::RenderMode QwtWidgetOverlay::renderMode() const
 
 /*!
    Recalculate the mask and repaint the overlay
+
+   When maskMode() is UpdateRegion only the regions, that are
+   covered by the previous or the current maskHint(), are updated.
  */
 void QwtWidgetOverlay::updateOverlay()
 {
+    if ( m_data->maskMode == QwtWidgetOverlay::UpdateRegion )
+    {
+        QRegion region = maskHint();
+        if ( region.isEmpty() )
+            region = rect();
+
+        update( region | m_data->updateRegion );
+        m_data->updateRegion = region;
+
+        if ( isHidden() )
+            setVisible( true );
+
+        return;
+    }
+
     updateMask();
     update();
 }
@@ -362,6 +389,9 @@ void QwtWidgetOverlay::draw( QPainter* painter ) const
      The hint is used to speed up the algorithm
      for calculating a mask from non transparent pixels
 
+   - UpdateRegion
+     The hint is used to restrict the region of the updates
+
    - NoMask
      The hint is unused.
 
@@ -83,7 +83,22 @@ class QWT_EXPORT QwtWidgetOverlay : public QWidget
            When a valid maskHint() is available
            only pixels inside this approximation are checked.
          */
-        AlphaMask
+        AlphaMask,
+
+        /*!
+           \brief Restrict the updates to maskHint()
+
+           No mask is set, but updateOverlay() schedules paint events for
+           the maskHint() of the previous and the current state only.
+           Setting a mask on a child widget is expensive and often results
+           in repaints of the widget below, while updating a small region
+           is not. When the parent widget restores its content from
+           a backing store ( f.e. QwtPlotCanvas::BackingStore )
+           this is usually the cheapest mode.
+
+           Without a valid maskHint() the complete overlay is updated.
+         */
+        UpdateRegion
     };
 
     /*!
@@ -11,7 +11,9 @@
 HEADERS += \
     qwt.h \
     qwt_abstract_scale_draw.h \
+    qwt_atomic_p.h \
     qwt_bezier.h \
+    qwt_cache_registry.h \
     qwt_clipper.h \
     qwt_color_map.h \
     qwt_column_symbol.h \
@@ -34,11 +36,13 @@ HEADERS += \
     qwt_pixel_matrix.h \
     qwt_point_3d.h \
     qwt_point_polar.h \
+    qwt_render_statistics.h \
     qwt_round_scale_draw.h \
     qwt_scale_div.h \
     qwt_scale_draw.h \
     qwt_scale_engine.h \
     qwt_scale_map.h \
+    qwt_scratch_pool.h \
     qwt_spline.h \
     qwt_spline_basis.h \
     qwt_spline_parametrization.h \
@@ -47,10 +51,13 @@ HEADERS += \
     qwt_spline_pleasing.h \
     qwt_spline_polynomial.h \
     qwt_symbol.h \
+    qwt_symbol_atlas.h \
     qwt_system_clock.h \
     qwt_text_engine.h \
     qwt_text_label.h \
     qwt_text.h \
+    qwt_timestamp_scale_draw.h \
+    qwt_timestamp_scale_engine.h \
     qwt_transform.h \
     qwt_widget_overlay.h
 
@@ -58,6 +65,7 @@ SOURCES += \
     qwt.cpp \
     qwt_abstract_scale_draw.cpp \
     qwt_bezier.cpp \
+    qwt_cache_registry.cpp \
     qwt_clipper.cpp \
     qwt_color_map.cpp \
     qwt_column_symbol.cpp \
@@ -80,11 +88,13 @@ SOURCES += \
     qwt_pixel_matrix.cpp \
     qwt_point_3d.cpp \
     qwt_point_polar.cpp \
+    qwt_render_statistics.cpp \
     qwt_round_scale_draw.cpp \
     qwt_scale_div.cpp \
     qwt_scale_draw.cpp \
     qwt_scale_map.cpp \
     qwt_scale_engine.cpp \
+    qwt_scratch_pool.cpp \
     qwt_spline.cpp \
     qwt_spline_basis.cpp \
     qwt_spline_parametrization.cpp \
@@ -93,10 +103,13 @@ SOURCES += \
     qwt_spline_pleasing.cpp \
     qwt_spline_polynomial.cpp \
     qwt_symbol.cpp \
+    qwt_symbol_atlas.cpp \
     qwt_system_clock.cpp \
     qwt_text_engine.cpp \
     qwt_text_label.cpp \
     qwt_text.cpp \
+    qwt_timestamp_scale_draw.cpp \
+    qwt_timestamp_scale_engine.cpp \
     qwt_transform.cpp \
     qwt_widget_overlay.cpp
 
@@ -109,16 +122,23 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_curve_fitter.h \
         qwt_spline_curve_fitter.h \
         qwt_weeding_curve_fitter.h \
+        qwt_downsampling_curve_fitter.h \
+        qwt_incremental_weeder.h \
         qwt_event_pattern.h \
         qwt_abstract_legend.h \
         qwt_legend.h \
         qwt_legend_data.h \
         qwt_legend_label.h \
+        qwt_list_legend.h \
         qwt_plot.h \
+        qwt_plot_group.h \
         qwt_plot_renderer.h \
+        qwt_plot_scene.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
+        qwt_plot_recorder.h \
+        qwt_frame_encoder.h \
         qwt_plot_graphicitem.h \
         qwt_plot_grid.h \
         qwt_plot_histogram.h \
@@ -126,14 +146,18 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_abstract_barchart.h \
         qwt_plot_barchart.h \
         qwt_plot_multi_barchart.h \
+        qwt_plot_multi_curve.h \
+        qwt_plot_stacked_curve.h \
         qwt_plot_intervalcurve.h \
         qwt_plot_tradingcurve.h \
         qwt_plot_layout.h \
         qwt_plot_marker.h \
+        qwt_plot_marker_collection.h \
         qwt_plot_zoneitem.h \
         qwt_plot_textlabel.h \
         qwt_plot_rasteritem.h \
         qwt_plot_spectrogram.h \
+        qwt_plot_density_item.h \
         qwt_plot_spectrocurve.h \
         qwt_plot_scaleitem.h \
         qwt_plot_legenditem.h \
@@ -142,36 +166,68 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_vectorfield.h \
         qwt_plot_abstract_canvas.h \
         qwt_plot_canvas.h \
+        qwt_plot_overlay.h \
+        qwt_plot_overview.h \
         qwt_plot_panner.h \
         qwt_plot_picker.h \
+        qwt_plot_curve_tracker.h \
         qwt_plot_zoomer.h \
         qwt_plot_magnifier.h \
         qwt_plot_rescaler.h \
+        qwt_axis_link.h \
         qwt_point_mapper.h \
+        qwt_line_rasterizer.h \
+        qwt_point_spatial_index.h \
         qwt_raster_data.h \
         qwt_matrix_raster_data.h \
+        qwt_buffer_raster_data.h \
+        qwt_mapped_raster_data.h \
+        qwt_ring_buffer_raster_data.h \
+        qwt_scattered_raster_data.h \
+        qwt_raster_vectorfield_data.h \
         qwt_vectorfield_symbol.h \
         qwt_sampling_thread.h \
+        qwt_sampling_scheduler.h \
+        qwt_ringbuffer_series_data.h \
+        qwt_swap_buffer_series_data.h \
+        qwt_timestamp_series_data.h \
+        qwt_histogram_series_data.h \
         qwt_samples.h \
         qwt_series_data.h \
+        qwt_append_series_data.h \
+        qwt_series_data_pyramid.h \
+        qwt_ohlc_series_data_pyramid.h \
+        qwt_interval_series_data_pyramid.h \
+        qwt_mapped_series_data.h \
+        qwt_viewport_series_data.h \
         qwt_series_store.h \
         qwt_point_data.h \
+        qwt_uniform_series_data.h \
+        qwt_adaptive_point_data.h \
+        qwt_compressed_point_data.h \
         qwt_scale_widget.h 
 
     SOURCES += \
         qwt_curve_fitter.cpp \
         qwt_spline_curve_fitter.cpp \
         qwt_weeding_curve_fitter.cpp \
+        qwt_downsampling_curve_fitter.cpp \
+        qwt_incremental_weeder.cpp \
         qwt_abstract_legend.cpp \
         qwt_legend.cpp \
         qwt_legend_data.cpp \
         qwt_legend_label.cpp \
+        qwt_list_legend.cpp \
         qwt_plot.cpp \
+        qwt_plot_group.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_scene.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
         qwt_plot_dict.cpp \
         qwt_plot_directpainter.cpp \
+        qwt_plot_recorder.cpp \
+        qwt_frame_encoder.cpp \
         qwt_plot_graphicitem.cpp \
         qwt_plot_grid.cpp \
         qwt_plot_histogram.cpp \
@@ -179,10 +235,13 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_abstract_barchart.cpp \
         qwt_plot_barchart.cpp \
         qwt_plot_multi_barchart.cpp \
+        qwt_plot_multi_curve.cpp \
+        qwt_plot_stacked_curve.cpp \
         qwt_plot_intervalcurve.cpp \
         qwt_plot_zoneitem.cpp \
         qwt_plot_tradingcurve.cpp \
         qwt_plot_spectrogram.cpp \
+        qwt_plot_density_item.cpp \
         qwt_plot_spectrocurve.cpp \
         qwt_plot_scaleitem.cpp \
         qwt_plot_legenditem.cpp \
@@ -190,23 +249,48 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_shapeitem.cpp \
         qwt_plot_vectorfield.cpp \
         qwt_plot_marker.cpp \
+        qwt_plot_marker_collection.cpp \
         qwt_plot_textlabel.cpp \
         qwt_plot_layout.cpp \
         qwt_plot_abstract_canvas.cpp \
         qwt_plot_canvas.cpp \
+        qwt_plot_overlay.cpp \
+        qwt_plot_overview.cpp \
         qwt_plot_panner.cpp \
         qwt_plot_rasteritem.cpp \
         qwt_plot_picker.cpp \
+        qwt_plot_curve_tracker.cpp \
         qwt_plot_zoomer.cpp \
         qwt_plot_magnifier.cpp \
         qwt_plot_rescaler.cpp \
+        qwt_axis_link.cpp \
         qwt_point_mapper.cpp \
+        qwt_line_rasterizer.cpp \
+        qwt_point_spatial_index.cpp \
         qwt_raster_data.cpp \
         qwt_matrix_raster_data.cpp \
+        qwt_buffer_raster_data.cpp \
+        qwt_mapped_raster_data.cpp \
+        qwt_ring_buffer_raster_data.cpp \
+        qwt_scattered_raster_data.cpp \
+        qwt_raster_vectorfield_data.cpp \
         qwt_vectorfield_symbol.cpp \
         qwt_sampling_thread.cpp \
+        qwt_sampling_scheduler.cpp \
+        qwt_ringbuffer_series_data.cpp \
+        qwt_swap_buffer_series_data.cpp \
+        qwt_timestamp_series_data.cpp \
+        qwt_histogram_series_data.cpp \
         qwt_series_data.cpp \
+        qwt_series_data_pyramid.cpp \
+        qwt_ohlc_series_data_pyramid.cpp \
+        qwt_interval_series_data_pyramid.cpp \
+        qwt_mapped_series_data.cpp \
+        qwt_viewport_series_data.cpp \
         qwt_point_data.cpp \
+        qwt_uniform_series_data.cpp \
+        qwt_adaptive_point_data.cpp \
+        qwt_compressed_point_data.cpp \
         qwt_scale_widget.cpp
 
     contains(QWT_CONFIG, QwtOpenGL) {
@@ -228,6 +312,12 @@ contains(QWT_CONFIG, QwtPlot) {
 
                     HEADERS += qwt_plot_opengl_canvas.h
                     SOURCES += qwt_plot_opengl_canvas.cpp
+
+                    HEADERS += qwt_plot_opengl_curve.h
+                    SOURCES += qwt_plot_opengl_curve.cpp
+
+                    HEADERS += qwt_plot_opengl_spectrogram.h
+                    SOURCES += qwt_plot_opengl_spectrogram.cpp
                 }
             }
             else {
@@ -235,12 +325,35 @@ contains(QWT_CONFIG, QwtPlot) {
 
                 HEADERS += qwt_plot_opengl_canvas.h
                 SOURCES += qwt_plot_opengl_canvas.cpp
+
+                HEADERS += qwt_plot_opengl_curve.h
+                SOURCES += qwt_plot_opengl_curve.cpp
+
+                HEADERS += qwt_plot_opengl_spectrogram.h
+                SOURCES += qwt_plot_opengl_spectrogram.cpp
             }
             
         }
 
     }
 
+    contains(QWT_CONFIG, QwtRhi) {
+
+        greaterThan(QT_MAJOR_VERSION, 5) {
+
+            !equals(QT_MAJOR_VERSION, 6) | greaterThan(QT_MINOR_VERSION, 6) {
+
+                qtHaveModule(gui-private) {
+
+                    QT += gui-private
+
+                    HEADERS += qwt_plot_rhi_canvas.h
+                    SOURCES += qwt_plot_rhi_canvas.cpp
+                }
+            }
+        }
+    }
+
     contains(QWT_CONFIG, QwtSvg) {
 
         HEADERS += \
@@ -256,6 +369,7 @@ contains(QWT_CONFIG, QwtPlot) {
             qwt_polar.h \
             qwt_polar_canvas.h \
             qwt_polar_curve.h \
+            qwt_polar_directpainter.h \
             qwt_polar_fitter.h \
             qwt_polar_grid.h \
             qwt_polar_itemdict.h \
@@ -272,6 +386,7 @@ contains(QWT_CONFIG, QwtPlot) {
         SOURCES += \
             qwt_polar_canvas.cpp \
             qwt_polar_curve.cpp \
+            qwt_polar_directpainter.cpp \
             qwt_polar_fitter.cpp \
             qwt_polar_grid.cpp \
             qwt_polar_item.cpp \
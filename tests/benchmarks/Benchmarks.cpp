@@ -0,0 +1,1005 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmarks.h"
+
+#include <QwtPointMapper>
+#include <QwtSyntheticPointData>
+#include <QwtPointArrayData>
+#include <QwtCPointerData>
+#include <QwtPlotCurve>
+#include <QwtPlotGrid>
+#include <QwtPlotSpectrogram>
+#include <QwtMatrixRasterData>
+#include <QwtLinearColorMap>
+#include <QwtAlphaColorMap>
+#include <QwtHueColorMap>
+#include <QwtClipper>
+#include <QwtSplineLocal>
+#include <QwtBezier>
+#include <QwtScaleMap>
+#include <QwtScaleDiv>
+#include <QwtScaleDraw>
+#include <QwtLinearScaleEngine>
+#include <QwtLogScaleEngine>
+#include <QwtDateScaleEngine>
+#include <QwtDate>
+#include <QwtText>
+#include <QwtPlot>
+#include <QwtPlotRenderer>
+#include <QwtGraphic>
+#include <QwtSymbol>
+#include <QwtLegend>
+#include <QwtInterval>
+
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+#include <QPolygonF>
+#include <QDateTime>
+#include <QBuffer>
+#include <QPixmap>
+#include <QPicture>
+
+#ifndef QWT_NO_SVG
+#include <QSvgGenerator>
+#endif
+
+#include <cmath>
+
+namespace
+{
+    const int NumSamples = 100000;
+    const QSize CanvasSize( 800, 600 );
+
+    enum MapperMode
+    {
+        PolygonF,
+        Polygon,
+        PointsF,
+        Points,
+        Image
+    };
+
+    enum ColorMapType
+    {
+        LinearColorMap,
+        FixedColorMap,
+        AlphaColorMap,
+        HueColorMap
+    };
+
+    enum ScaleEngineType
+    {
+        LinearScale,
+        LogScale,
+        DateScale
+    };
+
+    /*
+        Scattered points calculated on the fly, so that
+        series of 100M points don't need any memory
+     */
+    class ScatterData : public QwtSyntheticPointData
+    {
+      public:
+        explicit ScatterData( size_t size )
+            : QwtSyntheticPointData( size, QwtInterval( 0.0, 1.0 ) )
+        {
+        }
+
+        virtual double y( double x ) const QWT_OVERRIDE
+        {
+            const double v = std::sin( x * 12345.678 ) * 43758.5453;
+            return 3.0 * ( v - std::floor( v ) ) - 1.5;
+        }
+    };
+
+    class Spectrogram : public QwtPlotSpectrogram
+    {
+      public:
+        QImage render( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+            const QRectF& area, const QSize& imageSize ) const
+        {
+            return renderImage( xMap, yMap, area, imageSize );
+        }
+    };
+}
+
+static QwtScaleMap xCanvasMap( const QVector< QPointF >& samples )
+{
+    QwtScaleMap map;
+    map.setScaleInterval( samples.first().x(), samples.last().x() );
+    map.setPaintInterval( 0, CanvasSize.width() );
+
+    return map;
+}
+
+static QwtScaleMap yCanvasMap()
+{
+    QwtScaleMap map;
+    map.setScaleInterval( -1.5, 1.5 );
+    map.setPaintInterval( CanvasSize.height(), 0 );
+
+    return map;
+}
+
+static QImage canvasImage()
+{
+    QImage image( CanvasSize, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    return image;
+}
+
+static QwtMatrixRasterData* matrixData( QwtMatrixRasterData::ResampleMode mode )
+{
+    const int numColumns = 100;
+    const int numRows = 100;
+
+    QVector< double > values;
+    values.reserve( numColumns * numRows );
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const double x = col * 0.1;
+            const double y = row * 0.1;
+
+            values += 0.5 + 0.5 * std::sin( x ) * std::cos( 0.7 * y );
+        }
+    }
+
+    QwtMatrixRasterData* data = new QwtMatrixRasterData();
+    data->setValueMatrix( values, numColumns );
+    data->setInterval( Qt::XAxis, QwtInterval( 0.0, numColumns ) );
+    data->setInterval( Qt::YAxis, QwtInterval( 0.0, numRows ) );
+    data->setInterval( Qt::ZAxis, QwtInterval( 0.0, 1.0 ) );
+    data->setResampleMode( mode );
+
+    return data;
+}
+
+static QwtColorMap* colorMap( int type )
+{
+    switch ( type )
+    {
+        case FixedColorMap:
+        {
+            QwtLinearColorMap* colorMap =
+                new QwtLinearColorMap( Qt::darkCyan, Qt::red );
+            colorMap->addColorStop( 0.3, Qt::cyan );
+            colorMap->addColorStop( 0.6, Qt::green );
+            colorMap->addColorStop( 0.9, Qt::yellow );
+            colorMap->setMode( QwtLinearColorMap::FixedColors );
+
+            return colorMap;
+        }
+        case AlphaColorMap:
+            return new QwtAlphaColorMap( Qt::darkBlue );
+
+        case HueColorMap:
+            return new QwtHueColorMap();
+
+        default:
+        {
+            QwtLinearColorMap* colorMap =
+                new QwtLinearColorMap( Qt::darkCyan, Qt::red );
+            colorMap->addColorStop( 0.3, Qt::cyan );
+            colorMap->addColorStop( 0.6, Qt::green );
+            colorMap->addColorStop( 0.9, Qt::yellow );
+
+            return colorMap;
+        }
+    }
+}
+
+void Benchmarks::initTestCase()
+{
+    m_samples.reserve( NumSamples );
+
+    for ( int i = 0; i < NumSamples; i++ )
+    {
+        const double x = i;
+        const double y = std::sin( x * 0.01 ) * std::cos( x * 0.0003 )
+            + 0.2 * std::sin( x * 1.7 );
+
+        m_samples += QPointF( x, y );
+    }
+}
+
+void Benchmarks::pointMapper_data()
+{
+    QTest::addColumn< int >( "flags" );
+    QTest::addColumn< int >( "mode" );
+
+    const int flags[] =
+    {
+        0,
+        QwtPointMapper::RoundPoints,
+        QwtPointMapper::WeedOutPoints,
+        QwtPointMapper::RoundPoints | QwtPointMapper::WeedOutPoints,
+        QwtPointMapper::RoundPoints | QwtPointMapper::WeedOutIntermediatePoints,
+        QwtPointMapper::ParallelMapping,
+        QwtPointMapper::ParallelMapping | QwtPointMapper::RoundPoints
+            | QwtPointMapper::WeedOutPoints,
+        QwtPointMapper::ParallelMapping | QwtPointMapper::RoundPoints
+            | QwtPointMapper::WeedOutIntermediatePoints
+    };
+
+    const char* modes[] = { "polygonF", "polygon", "pointsF", "points", "image" };
+
+    for ( int mode = PolygonF; mode <= Image; mode++ )
+    {
+        for ( uint i = 0; i < sizeof( flags ) / sizeof( flags[0] ); i++ )
+        {
+            const QByteArray name = QByteArray( modes[mode] )
+                + " flags=0x" + QByteArray::number( flags[i], 16 );
+
+            QTest::newRow( name.constData() ) << flags[i] << mode;
+        }
+    }
+}
+
+void Benchmarks::pointMapper()
+{
+    QFETCH( int, flags );
+    QFETCH( int, mode );
+
+    QwtPointMapper mapper;
+    mapper.setFlags( QwtPointMapper::TransformationFlags( QFlag( flags ) ) );
+    mapper.setBoundingRect( QRectF( QPointF( 0, 0 ), CanvasSize ) );
+
+    const QwtPointSeriesData series( m_samples );
+
+    const QwtScaleMap xMap = xCanvasMap( m_samples );
+    const QwtScaleMap yMap = yCanvasMap();
+
+    const int from = 0;
+    const int to = m_samples.size() - 1;
+
+    switch ( mode )
+    {
+        case PolygonF:
+        {
+            QBENCHMARK { mapper.toPolygonF( xMap, yMap, &series, from, to ); }
+            break;
+        }
+        case Polygon:
+        {
+            QBENCHMARK { mapper.toPolygon( xMap, yMap, &series, from, to ); }
+            break;
+        }
+        case PointsF:
+        {
+            QBENCHMARK { mapper.toPointsF( xMap, yMap, &series, from, to ); }
+            break;
+        }
+        case Points:
+        {
+            QBENCHMARK { mapper.toPoints( xMap, yMap, &series, from, to ); }
+            break;
+        }
+        case Image:
+        {
+            QBENCHMARK
+            {
+                mapper.toImage( xMap, yMap, &series, from, to,
+                    QPen( Qt::black ), false, 0 );
+            }
+            break;
+        }
+    }
+}
+
+void Benchmarks::seriesMapping_data()
+{
+    QTest::addColumn< int >( "type" );
+    QTest::addColumn< int >( "flags" );
+
+    const char* types[] =
+        { "points", "arrayDouble", "arrayFloat", "pointerDouble", "pointerFloat" };
+
+    for ( int type = 0; type < 5; type++ )
+    {
+        const QByteArray name( types[type] );
+
+        QTest::newRow( name.constData() ) << type << 0;
+        QTest::newRow( ( name + " round" ).constData() )
+            << type << int( QwtPointMapper::RoundPoints );
+    }
+}
+
+void Benchmarks::seriesMapping()
+{
+    QFETCH( int, type );
+    QFETCH( int, flags );
+
+    QVector< double > xd, yd;
+    QVector< float > xf, yf;
+
+    for ( int i = 0; i < m_samples.size(); i++ )
+    {
+        xd += m_samples[i].x();
+        yd += m_samples[i].y();
+        xf += float( m_samples[i].x() );
+        yf += float( m_samples[i].y() );
+    }
+
+    QwtSeriesData< QPointF >* series = NULL;
+    switch ( type )
+    {
+        case 0:
+            series = new QwtPointSeriesData( m_samples );
+            break;
+        case 1:
+            series = new QwtPointArrayData< double >( xd, yd );
+            break;
+        case 2:
+            series = new QwtPointArrayData< float >( xf, yf );
+            break;
+        case 3:
+            series = new QwtCPointerData< double >(
+                xd.constData(), yd.constData(), xd.size() );
+            break;
+        default:
+            series = new QwtCPointerData< float >(
+                xf.constData(), yf.constData(), xf.size() );
+    }
+
+    QwtPointMapper mapper;
+    mapper.setFlags( QwtPointMapper::TransformationFlags( QFlag( flags ) ) );
+
+    const QwtScaleMap xMap = xCanvasMap( m_samples );
+    const QwtScaleMap yMap = yCanvasMap();
+
+    QBENCHMARK
+    {
+        mapper.toPolygonF( xMap, yMap, series, 0, m_samples.size() - 1 );
+    }
+
+    delete series;
+}
+
+void Benchmarks::boundingRect_data()
+{
+    QTest::addColumn< int >( "numPoints" );
+    QTest::addColumn< bool >( "arrays" );
+
+    const int numPoints[] = { 1000000, 10000000 };
+
+    for ( uint i = 0; i < sizeof( numPoints ) / sizeof( numPoints[0] ); i++ )
+    {
+        const QByteArray name = QByteArray::number( numPoints[i] );
+
+        QTest::newRow( ( name + " points" ).constData() ) << numPoints[i] << false;
+        QTest::newRow( ( name + " arrays" ).constData() ) << numPoints[i] << true;
+    }
+}
+
+void Benchmarks::boundingRect()
+{
+    QFETCH( int, numPoints );
+    QFETCH( bool, arrays );
+
+    QVector< double > x( numPoints );
+    QVector< double > y( numPoints );
+    QVector< QPointF > points( numPoints );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        x[i] = i;
+        y[i] = std::sin( 0.001 * i );
+        points[i] = QPointF( x[i], y[i] );
+    }
+
+    // the bounding rectangle is cached: each iteration needs a new series
+
+    if ( arrays )
+    {
+        QBENCHMARK
+        {
+            const QwtPointArrayData< double > series( x, y );
+            series.boundingRect();
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            const QwtPointSeriesData series( points );
+            series.boundingRect();
+        }
+    }
+}
+
+void Benchmarks::weeding_data()
+{
+    QTest::addColumn< int >( "numPoints" );
+    QTest::addColumn< bool >( "parallel" );
+
+    const int numPoints[] = { 1000000, 10000000, 100000000 };
+
+    for ( uint i = 0; i < sizeof( numPoints ) / sizeof( numPoints[0] ); i++ )
+    {
+        for ( int parallel = 0; parallel <= 1; parallel++ )
+        {
+            const QByteArray name = QByteArray::number( numPoints[i] )
+                + ( parallel ? " parallel" : "" );
+
+            QTest::newRow( name.constData() ) << numPoints[i] << bool( parallel );
+        }
+    }
+}
+
+void Benchmarks::weeding()
+{
+    QFETCH( int, numPoints );
+    QFETCH( bool, parallel );
+
+    QwtPointMapper mapper;
+    mapper.setFlag( QwtPointMapper::RoundPoints, true );
+    mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+    mapper.setFlag( QwtPointMapper::ParallelMapping, parallel );
+    mapper.setBoundingRect( QRectF( QPointF( 0, 0 ), CanvasSize ) );
+
+    const ScatterData series( numPoints );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, 1.0 );
+    xMap.setPaintInterval( 0, CanvasSize.width() );
+
+    const QwtScaleMap yMap = yCanvasMap();
+
+    QBENCHMARK
+    {
+        mapper.toPoints( xMap, yMap, &series, 0, numPoints - 1 );
+    }
+}
+
+void Benchmarks::curve_data()
+{
+    QTest::addColumn< int >( "style" );
+    QTest::addColumn< int >( "attributes" );
+
+    const int styles[] =
+    {
+        QwtPlotCurve::Lines, QwtPlotCurve::Sticks,
+        QwtPlotCurve::Steps, QwtPlotCurve::Dots
+    };
+
+    const char* styleNames[] = { "Lines", "Sticks", "Steps", "Dots" };
+
+    // all combinations of the paint attributes
+    const int allAttributes = QwtPlotCurve::ClipPolygons
+        | QwtPlotCurve::FilterPoints | QwtPlotCurve::MinimizeMemory
+        | QwtPlotCurve::ImageBuffer | QwtPlotCurve::FilterPointsAggressive
+        | QwtPlotCurve::ParallelMapping;
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int attributes = 0; attributes <= allAttributes; attributes++ )
+        {
+            const QByteArray name = QByteArray( styleNames[i] )
+                + " attributes=0x" + QByteArray::number( attributes, 16 );
+
+            QTest::newRow( name.constData() ) << styles[i] << attributes;
+        }
+    }
+}
+
+void Benchmarks::curve()
+{
+    QFETCH( int, style );
+    QFETCH( int, attributes );
+
+    QwtPlotCurve curve;
+    curve.setStyle( static_cast< QwtPlotCurve::CurveStyle >( style ) );
+    curve.setSamples( m_samples );
+
+    for ( int attribute = 1; attribute <= QwtPlotCurve::ParallelMapping; attribute <<= 1 )
+    {
+        curve.setPaintAttribute(
+            static_cast< QwtPlotCurve::PaintAttribute >( attribute ),
+            attributes & attribute );
+    }
+
+    const QwtScaleMap xMap = xCanvasMap( m_samples );
+    const QwtScaleMap yMap = yCanvasMap();
+    const QRectF canvasRect( QPointF( 0, 0 ), CanvasSize );
+
+    QImage image = canvasImage();
+    QPainter painter( &image );
+
+    QBENCHMARK { curve.draw( &painter, xMap, yMap, canvasRect ); }
+}
+
+void Benchmarks::clipper_data()
+{
+    QTest::addColumn< double >( "scale" );
+
+    // the polygon is scaled around the center of the clip rectangle
+
+    QTest::newRow( "inside" ) << 0.9;
+    QTest::newRow( "partial" ) << 3.0;
+    QTest::newRow( "outside" ) << 1000.0;
+}
+
+void Benchmarks::clipper()
+{
+    QFETCH( double, scale );
+
+    const QRectF clipRect( QPointF( 0, 0 ), CanvasSize );
+
+    const QwtPointSeriesData series( m_samples );
+
+    QwtScaleMap xMap = xCanvasMap( m_samples );
+    xMap.setPaintInterval( clipRect.center().x() - 0.5 * scale * clipRect.width(),
+        clipRect.center().x() + 0.5 * scale * clipRect.width() );
+
+    QwtScaleMap yMap = yCanvasMap();
+    yMap.setPaintInterval( clipRect.center().y() + 0.5 * scale * clipRect.height(),
+        clipRect.center().y() - 0.5 * scale * clipRect.height() );
+
+    const QwtPointMapper mapper;
+    const QPolygonF polygon =
+        mapper.toPolygonF( xMap, yMap, &series, 0, m_samples.size() - 1 );
+
+    QBENCHMARK { QwtClipper::clippedPolygonF( clipRect, polygon, false ); }
+}
+
+void Benchmarks::bezier_data()
+{
+    QTest::addColumn< bool >( "adaptive" );
+
+    QTest::newRow( "adaptive" ) << true;
+    QTest::newRow( "batch" ) << false;
+}
+
+void Benchmarks::bezier()
+{
+    QFETCH( bool, adaptive );
+
+    const QwtPointSeriesData series( m_samples );
+
+    const QwtPointMapper mapper;
+    const QPolygonF points = mapper.toPolygonF( xCanvasMap( m_samples ),
+        yCanvasMap(), &series, 0, m_samples.size() - 1 );
+
+    const QwtSplineLocal spline( QwtSplineLocal::Cardinal );
+    const QVector< QLineF > controlLines = spline.bezierControlLines( points );
+
+    const QwtBezier bezier( 0.5 );
+
+    if ( adaptive )
+    {
+        QBENCHMARK
+        {
+            QPolygonF polygon;
+            for ( int i = 0; i < controlLines.size(); i++ )
+            {
+                const QLineF& l = controlLines[i];
+                bezier.appendToPolygon( points[i], l.p1(), l.p2(), points[i + 1], polygon );
+            }
+        }
+    }
+    else
+    {
+        QBENCHMARK { bezier.toPolygon( points, controlLines ); }
+    }
+}
+
+void Benchmarks::spectrogram_data()
+{
+    QTest::addColumn< int >( "resampleMode" );
+    QTest::addColumn< int >( "colorMap" );
+
+    const char* modes[] = { "NearestNeighbour", "Bilinear", "Bicubic" };
+    const char* colorMaps[] = { "linear", "fixed", "alpha", "hue" };
+
+    for ( int mode = QwtMatrixRasterData::NearestNeighbour;
+        mode <= QwtMatrixRasterData::BicubicInterpolation; mode++ )
+    {
+        for ( int colorMap = LinearColorMap; colorMap <= HueColorMap; colorMap++ )
+        {
+            const QByteArray name = QByteArray( modes[mode] )
+                + " " + colorMaps[colorMap];
+
+            QTest::newRow( name.constData() ) << mode << colorMap;
+        }
+    }
+}
+
+void Benchmarks::spectrogram()
+{
+    QFETCH( int, resampleMode );
+    QFETCH( int, colorMap );
+
+    Spectrogram spectrogram;
+    spectrogram.setData( matrixData(
+        static_cast< QwtMatrixRasterData::ResampleMode >( resampleMode ) ) );
+    spectrogram.setColorMap( ::colorMap( colorMap ) );
+
+    const QRectF area( 0.0, 0.0, 100.0, 100.0 );
+    const QSize imageSize( 512, 512 );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( area.left(), area.right() );
+    xMap.setPaintInterval( 0, imageSize.width() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( area.top(), area.bottom() );
+    yMap.setPaintInterval( imageSize.height(), 0 );
+
+    QBENCHMARK { spectrogram.render( xMap, yMap, area, imageSize ); }
+}
+
+void Benchmarks::contourLines_data()
+{
+    QTest::addColumn< int >( "flags" );
+
+    QTest::newRow( "conrec" ) << 0;
+    QTest::newRow( "conrec ignoreOnLevel" )
+        << int( QwtRasterData::IgnoreAllVerticesOnLevel );
+    QTest::newRow( "marchingSquares" )
+        << int( QwtRasterData::MarchingSquares );
+}
+
+void Benchmarks::contourLines()
+{
+    QFETCH( int, flags );
+
+    const QwtMatrixRasterData* data =
+        matrixData( QwtMatrixRasterData::BilinearInterpolation );
+
+    QList< double > levels;
+    for ( double level = 0.1; level < 1.0; level += 0.1 )
+        levels += level;
+
+    const QRectF rect( 0.0, 0.0, 100.0, 100.0 );
+    const QSize raster( 400, 400 );
+
+    QBENCHMARK
+    {
+        data->contourLines( rect, raster, levels,
+            QwtRasterData::ConrecFlags( QFlag( flags ) ) );
+    }
+
+    delete data;
+}
+
+void Benchmarks::scaleEngine_data()
+{
+    QTest::addColumn< int >( "type" );
+    QTest::addColumn< double >( "x1" );
+    QTest::addColumn< double >( "x2" );
+
+    QTest::newRow( "linear" ) << int( LinearScale ) << -1.234 << 5678.9;
+    QTest::newRow( "log" ) << int( LogScale ) << 0.0123 << 4.56e7;
+
+    const QDateTime from( QDate( 2020, 1, 17 ), QTime( 7, 13 ), Qt::UTC );
+
+    QTest::newRow( "date hours" ) << int( DateScale )
+        << QwtDate::toDouble( from ) << QwtDate::toDouble( from.addSecs( 13 * 3600 ) );
+
+    QTest::newRow( "date months" ) << int( DateScale )
+        << QwtDate::toDouble( from ) << QwtDate::toDouble( from.addDays( 400 ) );
+}
+
+void Benchmarks::scaleEngine()
+{
+    QFETCH( int, type );
+    QFETCH( double, x1 );
+    QFETCH( double, x2 );
+
+    QwtScaleEngine* engine;
+    switch ( type )
+    {
+        case LogScale:
+            engine = new QwtLogScaleEngine();
+            break;
+        case DateScale:
+            engine = new QwtDateScaleEngine( Qt::UTC );
+            break;
+        default:
+            engine = new QwtLinearScaleEngine();
+    }
+
+    QBENCHMARK
+    {
+        double min = x1;
+        double max = x2;
+        double stepSize = 0.0;
+
+        engine->autoScale( 8, min, max, stepSize );
+        engine->divideScale( min, max, 8, 5, stepSize );
+    }
+
+    delete engine;
+}
+
+void Benchmarks::scaleDraw_data()
+{
+    QTest::addColumn< int >( "alignment" );
+    QTest::addColumn< bool >( "cached" );
+
+    QTest::newRow( "bottom" ) << int( QwtScaleDraw::BottomScale ) << true;
+    QTest::newRow( "bottom uncached" ) << int( QwtScaleDraw::BottomScale ) << false;
+    QTest::newRow( "left" ) << int( QwtScaleDraw::LeftScale ) << true;
+    QTest::newRow( "left uncached" ) << int( QwtScaleDraw::LeftScale ) << false;
+}
+
+void Benchmarks::scaleDraw()
+{
+    QFETCH( int, alignment );
+    QFETCH( bool, cached );
+
+    QwtLinearScaleEngine engine;
+
+    QwtScaleDraw scaleDraw;
+    scaleDraw.setAlignment( static_cast< QwtScaleDraw::Alignment >( alignment ) );
+    scaleDraw.setScaleDiv( engine.divideScale( -1234.5, 6789.0, 10, 5 ) );
+
+    if ( scaleDraw.orientation() == Qt::Horizontal )
+    {
+        scaleDraw.move( 50, 50 );
+        scaleDraw.setLength( CanvasSize.width() - 100 );
+    }
+    else
+    {
+        scaleDraw.move( CanvasSize.width() - 50, 50 );
+        scaleDraw.setLength( CanvasSize.height() - 100 );
+    }
+
+    QImage image = canvasImage();
+    QPainter painter( &image );
+
+    const QPalette palette;
+
+    QBENCHMARK
+    {
+        if ( !cached )
+            scaleDraw.invalidateCache();
+
+        scaleDraw.draw( &painter, palette );
+    }
+}
+
+void Benchmarks::text_data()
+{
+    QTest::addColumn< QString >( "text" );
+    QTest::addColumn< int >( "format" );
+    QTest::addColumn< bool >( "draw" );
+
+    const QString plain( "Amplitude [mV]" );
+    const QString rich( "A<sub>max</sub> = 10<sup>-3</sup> <b>mV</b>" );
+
+    QTest::newRow( "plain size" ) << plain << int( QwtText::PlainText ) << false;
+    QTest::newRow( "plain draw" ) << plain << int( QwtText::PlainText ) << true;
+    QTest::newRow( "rich size" ) << rich << int( QwtText::RichText ) << false;
+    QTest::newRow( "rich draw" ) << rich << int( QwtText::RichText ) << true;
+}
+
+void Benchmarks::text()
+{
+    QFETCH( QString, text );
+    QFETCH( int, format );
+    QFETCH( bool, draw );
+
+    const QwtText qwtText( text, static_cast< QwtText::TextFormat >( format ) );
+    const QFont font( "Helvetica", 12 );
+
+    if ( draw )
+    {
+        QImage image = canvasImage();
+
+        QPainter painter( &image );
+        painter.setFont( font );
+
+        const QRectF rect( 10, 10, 300, 50 );
+
+        QBENCHMARK { qwtText.draw( &painter, rect ); }
+    }
+    else
+    {
+        QBENCHMARK { qwtText.textSize( font ); }
+    }
+}
+
+void Benchmarks::plotConstruction_data()
+{
+    QTest::addColumn< int >( "numPlots" );
+
+    QTest::newRow( "1 plot" ) << 1;
+    QTest::newRow( "100 plots" ) << 100;
+}
+
+void Benchmarks::plotConstruction()
+{
+    /*
+        The target is < 1ms per plot, including the
+        titles of all 4 axes and the layout of the plot.
+     */
+
+    QFETCH( int, numPlots );
+
+    QBENCHMARK
+    {
+        QVector< QwtPlot* > plots;
+        plots.reserve( numPlots );
+
+        for ( int i = 0; i < numPlots; i++ )
+        {
+            QwtPlot* plot = new QwtPlot( "Plot" );
+
+            for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+            {
+                plot->setAxisVisible( axisPos, true );
+                plot->setAxisTitle( axisPos, "Axis" );
+            }
+
+            plot->resize( CanvasSize );
+            plot->updateLayout();
+
+            plots += plot;
+        }
+
+        qDeleteAll( plots );
+    }
+}
+
+void Benchmarks::renderer_data()
+{
+    QTest::addColumn< QString >( "format" );
+
+    QTest::newRow( "image" ) << QString( "image" );
+#ifndef QWT_NO_SVG
+    QTest::newRow( "svg" ) << QString( "svg" );
+#endif
+}
+
+void Benchmarks::renderer()
+{
+    QFETCH( QString, format );
+
+    QwtPlot plot;
+    plot.setTitle( "Benchmark" );
+    plot.insertLegend( new QwtLegend() );
+
+    QwtPlotGrid* grid = new QwtPlotGrid();
+    grid->attach( &plot );
+
+    QwtPlotCurve* curve = new QwtPlotCurve( "Curve" );
+    curve->setSamples( m_samples.mid( 0, 10000 ) );
+    curve->attach( &plot );
+
+    plot.resize( CanvasSize );
+    plot.replot();
+
+    const QwtPlotRenderer renderer;
+
+    if ( format == "image" )
+    {
+        QImage image = canvasImage();
+        QBENCHMARK { renderer.renderTo( &plot, image ); }
+    }
+#ifndef QWT_NO_SVG
+    else if ( format == "svg" )
+    {
+        QBENCHMARK
+        {
+            QBuffer buffer;
+            buffer.open( QIODevice::WriteOnly );
+
+            QSvgGenerator generator;
+            generator.setOutputDevice( &buffer );
+            generator.setSize( CanvasSize );
+            generator.setViewBox( QRect( QPoint( 0, 0 ), CanvasSize ) );
+
+            renderer.renderTo( &plot, generator );
+        }
+    }
+#endif
+}
+
+void Benchmarks::replay_data()
+{
+    QTest::addColumn< QString >( "device" );
+
+    QTest::newRow( "image" ) << QString( "image" );
+    QTest::newRow( "rgb32" ) << QString( "rgb32" );
+    QTest::newRow( "pixmap" ) << QString( "pixmap" );
+    QTest::newRow( "picture" ) << QString( "picture" );
+#ifndef QWT_NO_SVG
+    QTest::newRow( "svg" ) << QString( "svg" );
+#endif
+}
+
+void Benchmarks::replay()
+{
+    QFETCH( QString, device );
+
+    QwtGraphic trace;
+
+    const QString fileName = QString::fromLocal8Bit( qgetenv( "QWT_RENDER_TRACE" ) );
+    if ( !fileName.isEmpty() )
+    {
+        QVERIFY( trace.load( fileName ) );
+    }
+    else
+    {
+        QwtPlot plot;
+
+        QwtPlotGrid* grid = new QwtPlotGrid();
+        grid->attach( &plot );
+
+        QwtPlotCurve* curve = new QwtPlotCurve();
+        curve->setSymbol( new QwtSymbol( QwtSymbol::Ellipse,
+            QBrush( Qt::yellow ), QPen( Qt::blue ), QSize( 5, 5 ) ) );
+        curve->setSamples( m_samples.mid( 0, 10000 ) );
+        curve->attach( &plot );
+
+        plot.resize( CanvasSize );
+        plot.replot();
+
+        trace = plot.renderTrace();
+    }
+
+    const QSize size = trace.defaultSize().toSize();
+
+    if ( device == "image" || device == "rgb32" )
+    {
+        QImage image( size, device == "image"
+            ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32 );
+
+        QBENCHMARK
+        {
+            image.fill( Qt::white );
+
+            QPainter painter( &image );
+            trace.render( &painter );
+        }
+    }
+    else if ( device == "pixmap" )
+    {
+        QPixmap pixmap( size );
+
+        QBENCHMARK
+        {
+            pixmap.fill( Qt::white );
+
+            QPainter painter( &pixmap );
+            trace.render( &painter );
+        }
+    }
+    else if ( device == "picture" )
+    {
+        QBENCHMARK
+        {
+            QPicture picture;
+
+            QPainter painter( &picture );
+            trace.render( &painter );
+        }
+    }
+#ifndef QWT_NO_SVG
+    else if ( device == "svg" )
+    {
+        QBENCHMARK
+        {
+            QBuffer buffer;
+            buffer.open( QIODevice::WriteOnly );
+
+            QSvgGenerator generator;
+            generator.setOutputDevice( &buffer );
+            generator.setSize( size );
+
+            QPainter painter( &generator );
+            trace.render( &painter );
+        }
+    }
+#endif
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+
+/*
+   Benchmarks of the hot paths of the rendering pipeline
+
+   The results can be written in a machine readable format
+   by the options of QtTest, f.e:
+
+     benchmarks -o results.xml,xml
+     benchmarks -o results.csv,csv
+
+   A single benchmark can be run by passing its name:
+
+     benchmarks curve
+
+   The replay benchmark replays a trace, that has been written by
+   QwtPlot::saveRenderTrace(), when its path is passed as QWT_RENDER_TRACE:
+
+     QWT_RENDER_TRACE=/tmp/replot.trace benchmarks replay
+ */
+class Benchmarks : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void pointMapper_data();
+    void pointMapper();
+
+    void seriesMapping_data();
+    void seriesMapping();
+
+    void boundingRect_data();
+    void boundingRect();
+
+    void weeding_data();
+    void weeding();
+
+    void curve_data();
+    void curve();
+
+    void clipper_data();
+    void clipper();
+
+    void bezier_data();
+    void bezier();
+
+    void spectrogram_data();
+    void spectrogram();
+
+    void contourLines_data();
+    void contourLines();
+
+    void scaleEngine_data();
+    void scaleEngine();
+
+    void scaleDraw_data();
+    void scaleDraw();
+
+    void text_data();
+    void text();
+
+    void plotConstruction_data();
+    void plotConstruction();
+
+    void renderer_data();
+    void renderer();
+
+    void replay_data();
+    void replay();
+
+  private:
+    QVector< QPointF > m_samples;
+};
@@ -0,0 +1,9 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Benchmarks.h"
+#include <QtTest>
+
+QTEST_MAIN( Benchmarks )
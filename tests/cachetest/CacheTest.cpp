@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "CacheTest.h"
+
+#include <QwtPlot>
+#include <QwtPlotSpectrogram>
+#include <QwtMatrixRasterData>
+#include <QwtLinearColorMap>
+#include <QwtCacheRegistry>
+#include <QwtInterval>
+
+#include <QtTest>
+
+#include <cmath>
+
+static QwtMatrixRasterData* rasterData()
+{
+    const int numColumns = 500;
+    const int numRows = 500;
+
+    QVector< double > values;
+    values.reserve( numColumns * numRows );
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+            values += std::sin( col * 0.02 ) * std::cos( row * 0.03 );
+    }
+
+    QwtMatrixRasterData* data = new QwtMatrixRasterData();
+    data->setValueMatrix( values, numColumns );
+    data->setInterval( Qt::XAxis, QwtInterval( 0.0, 100.0 ) );
+    data->setInterval( Qt::YAxis, QwtInterval( 0.0, 100.0 ) );
+    data->setInterval( Qt::ZAxis, QwtInterval( -1.0, 1.0 ) );
+    data->setResampleMode( QwtMatrixRasterData::BilinearInterpolation );
+
+    return data;
+}
+
+void CacheTest::cleanup()
+{
+    QwtCacheRegistry::setMemoryBudget( 0 );
+    QwtCacheRegistry::purge();
+}
+
+void CacheTest::purgeWhileRendering()
+{
+    QwtPlot plot;
+    plot.setAutoReplot( false );
+    plot.resize( 600, 400 );
+
+    QwtPlotSpectrogram* spectrogram = new QwtPlotSpectrogram();
+    spectrogram->setData( rasterData() );
+    spectrogram->setColorMap( new QwtLinearColorMap( Qt::darkCyan, Qt::red ) );
+    spectrogram->setCachePolicy( QwtPlotRasterItem::TileCache );
+    spectrogram->setValueCacheEnabled( true );
+    spectrogram->attach( &plot );
+
+    plot.show();
+
+    // exceeded by each tile, so that the evictor runs all the time
+    QwtCacheRegistry::setMemoryBudget( 1024 );
+
+    for ( int i = 0; i < 50; i++ )
+    {
+        const double width = 100.0 / ( 1 + i % 10 );
+
+        plot.setAxisScale( QwtAxis::XBottom, 0.0, width );
+        plot.setAxisScale( QwtAxis::YLeft, 0.0, width );
+        plot.replot();
+
+        // the tile renderer is running in the background
+        QTest::qWait( i % 5 );
+
+        if ( i % 3 == 0 )
+        {
+            QwtCacheRegistry::purge();
+            QCOMPARE( QwtCacheRegistry::memoryUsage( QwtCacheRegistry::RasterCache ),
+                qint64( 0 ) );
+        }
+    }
+
+    QwtCacheRegistry::purge( QwtCacheRegistry::RasterCache );
+    QCOMPARE( QwtCacheRegistry::memoryUsage( QwtCacheRegistry::RasterCache ),
+        qint64( 0 ) );
+}
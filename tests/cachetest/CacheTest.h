@@ -0,0 +1,26 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+
+/*
+   Regression tests for QwtCacheRegistry
+
+   A spectrogram with tile and value cache is zoomed, while the caches
+   are evicted and purged. Purging has to wait for the tile renderer,
+   that reports the memory of the value cache in the meantime.
+
+     cachetest -platform offscreen
+ */
+class CacheTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void cleanup();
+    void purgeWhileRendering();
+};
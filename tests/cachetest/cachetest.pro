@@ -0,0 +1,28 @@
+################################################################
+# Qwt Widget Library
+# Copyright (C) 1997   Josef Wilgen
+# Copyright (C) 2002   Uwe Rathmann
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Qwt License, Version 1.0
+################################################################
+
+include( $${PWD}/../tests.pri )
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+
+    QT += testlib widgets
+}
+else {
+
+    CONFIG += qtestlib
+}
+
+TARGET = cachetest
+
+HEADERS = \
+    CacheTest.h
+
+SOURCES = \
+    CacheTest.cpp \
+    main.cpp
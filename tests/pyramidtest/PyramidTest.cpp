@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "PyramidTest.h"
+
+#include <QwtPlot>
+#include <QwtPlotCurve>
+#include <QwtSeriesData>
+#include <QwtSeriesDataPyramid>
+#include <QwtSeriesStatistics>
+#include <QwtInterval>
+
+#include <QtTest>
+#include <qnumeric.h>
+
+#include <cmath>
+
+static QVector< QPointF > samplesWithGaps()
+{
+    // a gap at the beginning of each block of 32 samples
+
+    QVector< QPointF > samples;
+    samples.reserve( 10000 );
+
+    for ( int i = 0; i < 10000; i++ )
+    {
+        const double y = ( i % 32 == 0 ) ? qQNaN() : std::sin( i * 0.01 );
+        samples += QPointF( i, y );
+    }
+
+    return samples;
+}
+
+void PyramidTest::boundingRect()
+{
+    const QVector< QPointF > samples = samplesWithGaps();
+
+    const QwtPointSeriesData series( samples );
+    const QwtSeriesDataPyramid pyramid( new QwtPointSeriesData( samples ) );
+
+    const QwtSeriesStatistics all = qwtSeriesStatistics( series, 0.0, 9999.0 );
+
+    const QRectF rect = pyramid.boundingRect();
+    QVERIFY( rect.isValid() );
+    QCOMPARE( rect.top(), all.minY );
+    QCOMPARE( rect.bottom(), all.maxY );
+}
+
+void PyramidTest::statistics()
+{
+    const QVector< QPointF > samples = samplesWithGaps();
+
+    const QwtPointSeriesData series( samples );
+    const QwtSeriesDataPyramid pyramid( new QwtPointSeriesData( samples ) );
+
+    const double intervals[][2] =
+    {
+        { 0.0, 9999.0 }, { 0.0, 31.0 }, { 32.0, 32.0 },
+        { 31.0, 33.0 }, { 100.0, 5000.0 }, { 1234.5, 8765.5 }
+    };
+
+    for ( size_t i = 0; i < sizeof( intervals ) / sizeof( intervals[0] ); i++ )
+    {
+        const double xFrom = intervals[i][0];
+        const double xTo = intervals[i][1];
+
+        // qwtSeriesStatistics() scans a QwtPointSeriesData
+        const QwtSeriesStatistics expected = qwtSeriesStatistics( series, xFrom, xTo );
+        const QwtSeriesStatistics statistics = pyramid.statistics( xFrom, xTo );
+
+        QCOMPARE( statistics.isValid(), expected.isValid() );
+        QCOMPARE( statistics.count, expected.count );
+
+        if ( expected.isValid() )
+        {
+            QCOMPARE( statistics.minY, expected.minY );
+            QCOMPARE( statistics.maxY, expected.maxY );
+            QVERIFY( qAbs( statistics.sumY - expected.sumY ) < 1e-9 );
+        }
+
+        int minIndex, maxIndex;
+        if ( pyramid.minMaxIndex( int( std::ceil( xFrom ) ),
+            int( std::floor( xTo ) ), minIndex, maxIndex ) )
+        {
+            QCOMPARE( samples[minIndex].y(), expected.minY );
+            QCOMPARE( samples[maxIndex].y(), expected.maxY );
+        }
+        else
+        {
+            QVERIFY( !expected.isValid() );
+        }
+    }
+}
+
+void PyramidTest::fitVisible()
+{
+    const QVector< QPointF > samples = samplesWithGaps();
+
+    QwtPlot plot;
+    plot.setAutoReplot( false );
+
+    QwtPlotCurve* curve = new QwtPlotCurve();
+    curve->setData( new QwtSeriesDataPyramid( new QwtPointSeriesData( samples ) ) );
+    curve->attach( &plot );
+
+    plot.setAxisScale( QwtAxis::XBottom, 0.0, 200.0 );
+    plot.setAxisAutoScaleMode( QwtAxis::YLeft, QwtPlot::FitVisible );
+    plot.updateAxes();
+
+    const QwtSeriesStatistics expected =
+        qwtSeriesStatistics( QwtPointSeriesData( samples ), 0.0, 200.0 );
+
+    const QwtInterval yInterval = plot.axisInterval( QwtAxis::YLeft );
+    QVERIFY( yInterval.isValid() );
+    QVERIFY( !qIsNaN( yInterval.minValue() ) && !qIsNaN( yInterval.maxValue() ) );
+    QVERIFY( yInterval.contains( expected.yInterval() ) );
+}
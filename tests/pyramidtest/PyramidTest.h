@@ -0,0 +1,27 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+
+/*
+   Unit tests for QwtSeriesDataPyramid
+
+   The summaries of the pyramid are compared with a scan of the samples.
+   The samples have gaps ( NaN values ) at the beginning of each block
+   of the pyramid, so that nodes starting with a gap are covered.
+
+     pyramidtest -platform offscreen
+ */
+class PyramidTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void boundingRect();
+    void statistics();
+    void fitVisible();
+};
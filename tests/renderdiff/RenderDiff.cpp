@@ -0,0 +1,570 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "RenderDiff.h"
+
+#include <QwtPlot>
+#include <QwtPlotCurve>
+#include <QwtPlotSpectrogram>
+#include <QwtPlotVectorField>
+#include <QwtPlotRenderer>
+#include <QwtMatrixRasterData>
+#include <QwtLinearColorMap>
+#include <QwtPolarPlot>
+#include <QwtPolarCurve>
+#include <QwtPolarSpectrogram>
+#include <QwtPolarRenderer>
+#include <QwtSeriesData>
+#include <QwtPointPolar>
+#include <QwtInterval>
+#include <QwtMath>
+
+#include <QtTest>
+#include <QImage>
+#include <QDir>
+#include <QElapsedTimer>
+
+#include <cmath>
+
+namespace
+{
+    const QSize ImageSize( 800, 600 );
+
+    // the number of renderings for finding the best time
+    const int NumRuns = 3;
+
+    // setups of a spectrogram, that are not covered by paint attributes
+    enum SpectrogramSetup
+    {
+        RenderThreads = 0x01,
+        ColorTable = 0x02,
+        ValueCache = 0x04
+    };
+
+    // attributes of QwtPolarCurve and QwtPolarSpectrogram in one mask
+    enum PolarSetup
+    {
+        CurveClipPolygons = 0x01,
+        CurveFilterPoints = 0x02,
+
+        SpectrogramApproximatedAtan = 0x10,
+        SpectrogramCachePolarGrid = 0x20,
+        SpectrogramRenderThreads = 0x40
+    };
+
+    class PolarData : public QwtArraySeriesData< QwtPointPolar >
+    {
+      public:
+        explicit PolarData( const QVector< QwtPointPolar >& samples )
+        {
+            m_samples = samples;
+        }
+
+        virtual QRectF boundingRect() const QWT_OVERRIDE
+        {
+            if ( cachedBoundingRect.width() < 0.0 )
+                cachedBoundingRect = qwtBoundingRect( *this );
+
+            return cachedBoundingRect;
+        }
+    };
+
+    class Result
+    {
+      public:
+        Result()
+            : numCovered( 0 )
+            , numDifferent( 0 )
+            , maxDelta( 0 )
+        {
+        }
+
+        double ratio() const
+        {
+            return ( numCovered > 0 ) ? double( numDifferent ) / numCovered : 0.0;
+        }
+
+        int numCovered;
+        int numDifferent;
+        int maxDelta;
+
+        QImage diffImage;
+    };
+}
+
+static inline int pixelDelta( QRgb rgb1, QRgb rgb2 )
+{
+    const int dr = qAbs( qRed( rgb1 ) - qRed( rgb2 ) );
+    const int dg = qAbs( qGreen( rgb1 ) - qGreen( rgb2 ) );
+    const int db = qAbs( qBlue( rgb1 ) - qBlue( rgb2 ) );
+    const int da = qAbs( qAlpha( rgb1 ) - qAlpha( rgb2 ) );
+
+    return qMax( qMax( dr, dg ), qMax( db, da ) );
+}
+
+static Result compareImages( const QImage& blank,
+    const QImage& reference, const QImage& fast, int tolerance )
+{
+    Result result;
+    result.diffImage = QImage( reference.size(), QImage::Format_RGB32 );
+    result.diffImage.fill( Qt::white );
+
+    for ( int y = 0; y < reference.height(); y++ )
+    {
+        const QRgb* b = reinterpret_cast< const QRgb* >( blank.constScanLine( y ) );
+        const QRgb* r = reinterpret_cast< const QRgb* >( reference.constScanLine( y ) );
+        const QRgb* f = reinterpret_cast< const QRgb* >( fast.constScanLine( y ) );
+
+        QRgb* d = reinterpret_cast< QRgb* >( result.diffImage.scanLine( y ) );
+
+        for ( int x = 0; x < reference.width(); x++ )
+        {
+            // pixels, that have been painted by the items
+            if ( r[x] != b[x] || f[x] != b[x] )
+                result.numCovered++;
+
+            const int delta = pixelDelta( r[x], f[x] );
+            if ( delta > 0 )
+            {
+                result.maxDelta = qMax( result.maxDelta, delta );
+
+                if ( delta > tolerance )
+                {
+                    result.numDifferent++;
+                    d[x] = qRgb( 255, 0, 0 );
+                }
+                else
+                {
+                    d[x] = qRgb( 255, 200, 200 );
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+static QImage renderImage( QWidget* widget, qint64* nsecs = NULL )
+{
+    QImage image( ImageSize, QImage::Format_ARGB32 );
+
+    QElapsedTimer timer;
+    qint64 best = -1;
+
+    for ( int i = 0; i < ( nsecs ? NumRuns : 1 ); i++ )
+    {
+        image.fill( Qt::white );
+
+        timer.start();
+
+        if ( QwtPlot* plot = qobject_cast< QwtPlot* >( widget ) )
+        {
+            QwtPlotRenderer renderer;
+            renderer.setDiscardFlag( QwtPlotRenderer::DiscardBackground );
+            renderer.renderTo( plot, image );
+        }
+        else if ( QwtPolarPlot* plot = qobject_cast< QwtPolarPlot* >( widget ) )
+        {
+            QwtPolarRenderer renderer;
+            renderer.renderTo( plot, image );
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed();
+        if ( best < 0 || elapsed < best )
+            best = elapsed;
+    }
+
+    if ( nsecs )
+        *nsecs = best;
+
+    return image;
+}
+
+static QImage renderBlank( QWidget* widget )
+{
+    QList< bool > visibility;
+
+    if ( QwtPlot* plot = qobject_cast< QwtPlot* >( widget ) )
+    {
+        const QwtPlotItemList& items = plot->itemList();
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            visibility += items[i]->isVisible();
+            items[i]->setVisible( false );
+        }
+
+        const QImage image = renderImage( widget );
+
+        for ( int i = 0; i < items.size(); i++ )
+            items[i]->setVisible( visibility[i] );
+
+        return image;
+    }
+
+    if ( QwtPolarPlot* plot = qobject_cast< QwtPolarPlot* >( widget ) )
+    {
+        const QwtPolarItemList& items = plot->itemList();
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            visibility += items[i]->isVisible();
+            items[i]->setVisible( false );
+        }
+
+        const QImage image = renderImage( widget );
+
+        for ( int i = 0; i < items.size(); i++ )
+            items[i]->setVisible( visibility[i] );
+
+        return image;
+    }
+
+    return QImage();
+}
+
+static void saveImages( const QImage& reference,
+    const QImage& fast, const QImage& diff )
+{
+    const QString dirName = qgetenv( "QWT_RENDERDIFF_OUTPUT" );
+    if ( dirName.isEmpty() )
+        return;
+
+    QString name = QString( "%1_%2" ).arg(
+        QTest::currentTestFunction(), QTest::currentDataTag() );
+
+    for ( int i = 0; i < name.size(); i++ )
+    {
+        if ( !name[i].isLetterOrNumber() )
+            name[i] = QLatin1Char( '_' );
+    }
+
+    const QDir dir( dirName );
+
+    reference.save( dir.filePath( name + "_reference.png" ) );
+    fast.save( dir.filePath( name + "_fast.png" ) );
+    diff.save( dir.filePath( name + "_diff.png" ) );
+}
+
+static QwtPlot* createPlot()
+{
+    QwtPlot* plot = new QwtPlot();
+    plot->setAutoReplot( false );
+    plot->resize( ImageSize );
+
+    return plot;
+}
+
+static QwtPlot* curvePlot( int attributes )
+{
+    QVector< QPointF > samples;
+    samples.reserve( 100000 );
+
+    for ( int i = 0; i < 100000; i++ )
+    {
+        const double x = i;
+        const double y = std::sin( x * 0.001 ) * std::cos( x * 0.00003 )
+            + 0.2 * std::sin( x * 1.7 );
+
+        samples += QPointF( x, y );
+    }
+
+    QwtPlot* plot = createPlot();
+
+    QwtPlotCurve* curve = new QwtPlotCurve();
+    curve->setPen( Qt::darkBlue );
+    curve->setSamples( samples );
+
+    for ( int attribute = QwtPlotCurve::ClipPolygons;
+        attribute <= QwtPlotCurve::CachePolyline; attribute <<= 1 )
+    {
+        curve->setPaintAttribute(
+            static_cast< QwtPlotCurve::PaintAttribute >( attribute ),
+            attributes & attribute );
+    }
+
+    curve->attach( plot );
+
+    plot->setAxisScale( QwtAxis::XBottom, 0.0, samples.size() - 1 );
+    plot->setAxisScale( QwtAxis::YLeft, -1.5, 1.5 );
+    plot->replot();
+
+    return plot;
+}
+
+static QwtMatrixRasterData* rasterData( const QwtInterval& xInterval,
+    const QwtInterval& yInterval )
+{
+    const int numColumns = 200;
+    const int numRows = 200;
+
+    QVector< double > values;
+    values.reserve( numColumns * numRows );
+
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const double x = col * 0.05;
+            const double y = row * 0.05;
+
+            values += 0.5 + 0.5 * std::sin( x ) * std::cos( 0.7 * y );
+        }
+    }
+
+    QwtMatrixRasterData* data = new QwtMatrixRasterData();
+    data->setValueMatrix( values, numColumns );
+    data->setInterval( Qt::XAxis, xInterval );
+    data->setInterval( Qt::YAxis, yInterval );
+    data->setInterval( Qt::ZAxis, QwtInterval( 0.0, 1.0 ) );
+    data->setResampleMode( QwtMatrixRasterData::BilinearInterpolation );
+
+    return data;
+}
+
+static QwtLinearColorMap* createColorMap()
+{
+    QwtLinearColorMap* colorMap = new QwtLinearColorMap( Qt::darkCyan, Qt::red );
+    colorMap->addColorStop( 0.3, Qt::cyan );
+    colorMap->addColorStop( 0.6, Qt::green );
+    colorMap->addColorStop( 0.9, Qt::yellow );
+
+    return colorMap;
+}
+
+static QwtPlot* spectrogramPlot( int setup )
+{
+    QwtPlot* plot = createPlot();
+
+    QwtPlotSpectrogram* spectrogram = new QwtPlotSpectrogram();
+    spectrogram->setData( rasterData(
+        QwtInterval( 0.0, 100.0 ), QwtInterval( 0.0, 100.0 ) ) );
+    spectrogram->setColorMap( createColorMap() );
+    spectrogram->setRenderThreadCount( ( setup & RenderThreads ) ? 0 : 1 );
+    spectrogram->setColorTableSize( ( setup & ColorTable ) ? -1 : 0 );
+    spectrogram->setValueCacheEnabled( setup & ValueCache );
+    spectrogram->attach( plot );
+
+    plot->setAxisScale( QwtAxis::XBottom, 0.0, 100.0 );
+    plot->setAxisScale( QwtAxis::YLeft, 0.0, 100.0 );
+    plot->replot();
+
+    return plot;
+}
+
+static QwtPlot* vectorFieldPlot( int attributes )
+{
+    QVector< QwtVectorFieldSample > samples;
+
+    for ( int row = 0; row < 200; row++ )
+    {
+        for ( int col = 0; col < 200; col++ )
+        {
+            const double x = col - 100.0;
+            const double y = row - 100.0;
+
+            samples += QwtVectorFieldSample( x, y, -y / 100.0, x / 100.0 );
+        }
+    }
+
+    QwtPlot* plot = createPlot();
+
+    QwtPlotVectorField* field = new QwtPlotVectorField();
+    field->setSamples( samples );
+    field->setRasterSize( QSizeF( 20, 20 ) );
+
+    for ( int attribute = QwtPlotVectorField::FilterVectors;
+        attribute <= QwtPlotVectorField::CacheFilterLevels; attribute <<= 1 )
+    {
+        field->setPaintAttribute(
+            static_cast< QwtPlotVectorField::PaintAttribute >( attribute ),
+            attributes & attribute );
+    }
+
+    field->attach( plot );
+
+    plot->setAxisScale( QwtAxis::XBottom, -100.0, 100.0 );
+    plot->setAxisScale( QwtAxis::YLeft, -100.0, 100.0 );
+    plot->replot();
+
+    return plot;
+}
+
+static QwtPolarPlot* polarPlot( int setup )
+{
+    QVector< QwtPointPolar > samples;
+    samples.reserve( 100000 );
+
+    for ( int i = 0; i < 100000; i++ )
+    {
+        const double azimuth = std::fmod( i * 0.001, 2 * M_PI );
+        const double radius = 1.0 + 8.0 * i / 100000.0 + 0.2 * std::sin( i * 1.7 );
+
+        samples += QwtPointPolar( azimuth, radius );
+    }
+
+    QwtPolarPlot* plot = new QwtPolarPlot();
+    plot->setAutoReplot( false );
+    plot->setPlotBackground( Qt::white );
+    plot->setScale( QwtPolar::Azimuth, 0.0, 2 * M_PI );
+    plot->setScale( QwtPolar::Radius, 0.0, 10.0 );
+    plot->resize( ImageSize );
+
+    QwtPolarSpectrogram* spectrogram = new QwtPolarSpectrogram();
+    spectrogram->setData( rasterData(
+        QwtInterval( 0.0, 2 * M_PI ), QwtInterval( 0.0, 10.0 ) ) );
+    spectrogram->setColorMap( createColorMap() );
+    spectrogram->setPaintAttribute( QwtPolarSpectrogram::ApproximatedAtan,
+        setup & SpectrogramApproximatedAtan );
+    spectrogram->setPaintAttribute( QwtPolarSpectrogram::CachePolarGrid,
+        setup & SpectrogramCachePolarGrid );
+    spectrogram->setRenderThreadCount(
+        ( setup & SpectrogramRenderThreads ) ? 0 : 1 );
+    spectrogram->setZ( 1.0 );
+    spectrogram->attach( plot );
+
+    QwtPolarCurve* curve = new QwtPolarCurve();
+    curve->setPen( QPen( Qt::black ) );
+    curve->setData( new PolarData( samples ) );
+    curve->setPaintAttribute( QwtPolarCurve::ClipPolygons,
+        setup & CurveClipPolygons );
+    curve->setPaintAttribute( QwtPolarCurve::FilterPoints,
+        setup & CurveFilterPoints );
+    curve->setZ( 2.0 );
+    curve->attach( plot );
+
+    plot->replot();
+
+    return plot;
+}
+
+static void addRow( const char* name, int reference, int fast,
+    int tolerance, double maxDifference )
+{
+    QTest::newRow( name ) << reference << fast << tolerance << maxDifference;
+}
+
+static void addColumns()
+{
+    QTest::addColumn< int >( "reference" );
+    QTest::addColumn< int >( "fast" );
+
+    // maximum delta of a color channel, that is not counted as difference
+    QTest::addColumn< int >( "tolerance" );
+
+    // maximum ratio of different pixels relative to the covered pixels
+    QTest::addColumn< double >( "maxDifference" );
+}
+
+void RenderDiff::compare( QWidget* reference, QWidget* fast )
+{
+    QFETCH( int, tolerance );
+    QFETCH( double, maxDifference );
+
+    qint64 referenceTime = 0;
+    qint64 fastTime = 0;
+
+    const QImage referenceImage = renderImage( reference, &referenceTime );
+    const QImage fastImage = renderImage( fast, &fastTime );
+    const QImage blankImage = renderBlank( reference );
+
+    const Result result = compareImages( blankImage,
+        referenceImage, fastImage, tolerance );
+
+    saveImages( referenceImage, fastImage, result.diffImage );
+
+    const double speedup = ( fastTime > 0 ) ? double( referenceTime ) / fastTime : 0.0;
+
+    qDebug( "difference: %.3f%% ( %d of %d pixels, max delta %d ), "
+        "reference: %.2fms, fast: %.2fms, speedup: %.2f",
+        100.0 * result.ratio(), result.numDifferent, result.numCovered,
+        result.maxDelta, referenceTime / 1e6, fastTime / 1e6, speedup );
+
+    delete reference;
+    delete fast;
+
+    QVERIFY2( result.ratio() <= maxDifference,
+        qPrintable( QString( "%1% of the covered pixels differ" )
+            .arg( 100.0 * result.ratio() ) ) );
+}
+
+void RenderDiff::curve_data()
+{
+    addColumns();
+
+    addRow( "ClipPolygons", 0, QwtPlotCurve::ClipPolygons, 0, 0.001 );
+    addRow( "FilterPoints", 0,
+        QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints, 0, 0.001 );
+    addRow( "FilterPointsAggressive", 0,
+        QwtPlotCurve::FilterPointsAggressive, 64, 0.05 );
+    addRow( "ParallelMapping", 0,
+        QwtPlotCurve::FilterPoints | QwtPlotCurve::ParallelMapping, 0, 0.001 );
+    addRow( "ImageBuffer", 0, QwtPlotCurve::ImageBuffer, 64, 0.02 );
+    addRow( "CachePolyline", 0,
+        QwtPlotCurve::ClipPolygons | QwtPlotCurve::CachePolyline, 0, 0.001 );
+}
+
+void RenderDiff::curve()
+{
+    QFETCH( int, reference );
+    QFETCH( int, fast );
+
+    compare( curvePlot( reference ), curvePlot( fast ) );
+}
+
+void RenderDiff::spectrogram_data()
+{
+    addColumns();
+
+    addRow( "RenderThreads", 0, RenderThreads, 0, 0.0 );
+    addRow( "ColorTable", 0, ColorTable, 8, 0.001 );
+    addRow( "ValueCache", 0, ValueCache, 0, 0.0 );
+    addRow( "All", 0, RenderThreads | ColorTable | ValueCache, 8, 0.001 );
+}
+
+void RenderDiff::spectrogram()
+{
+    QFETCH( int, reference );
+    QFETCH( int, fast );
+
+    compare( spectrogramPlot( reference ), spectrogramPlot( fast ) );
+}
+
+void RenderDiff::vectorField_data()
+{
+    addColumns();
+
+    addRow( "BatchSymbols", 0, QwtPlotVectorField::BatchSymbols, 64, 0.01 );
+
+    // the cached levels are aligned to the data, see CacheFilterLevels
+    addRow( "CacheFilterLevels", QwtPlotVectorField::FilterVectors,
+        QwtPlotVectorField::FilterVectors | QwtPlotVectorField::CacheFilterLevels,
+        64, 0.5 );
+}
+
+void RenderDiff::vectorField()
+{
+    QFETCH( int, reference );
+    QFETCH( int, fast );
+
+    compare( vectorFieldPlot( reference ), vectorFieldPlot( fast ) );
+}
+
+void RenderDiff::polar_data()
+{
+    addColumns();
+
+    addRow( "FilterPoints", 0,
+        CurveClipPolygons | CurveFilterPoints, 0, 0.001 );
+    addRow( "ApproximatedAtan", 0, SpectrogramApproximatedAtan, 8, 0.01 );
+    addRow( "CachePolarGrid", 0, SpectrogramCachePolarGrid, 0, 0.0 );
+    addRow( "RenderThreads", 0, SpectrogramRenderThreads, 0, 0.0 );
+}
+
+void RenderDiff::polar()
+{
+    QFETCH( int, reference );
+    QFETCH( int, fast );
+
+    compare( polarPlot( reference ), polarPlot( fast ) );
+}
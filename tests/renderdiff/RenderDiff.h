@@ -0,0 +1,52 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+
+class QWidget;
+
+/*
+   Regression tests for the fast render paths
+
+   Each row renders an item twice through QwtPlotRenderer/QwtPolarRenderer:
+   once with a reference setup and once with the attributes of a fast
+   path. A row fails, when more pixels differ by more than the
+   tolerance of the row than allowed. The difference is calculated
+   relative to the pixels covered by the item, found by rendering
+   the plot with the item being hidden.
+
+   The visual difference and the speedup are reported for each row:
+
+     renderdiff -platform offscreen
+     renderdiff -platform offscreen curve
+
+   When QWT_RENDERDIFF_OUTPUT is set to a directory, the reference,
+   the fast and the difference image of each row are written there.
+
+   The timings are the best out of a couple of renderings, so that
+   caches of the fast paths are included.
+ */
+class RenderDiff : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void curve_data();
+    void curve();
+
+    void spectrogram_data();
+    void spectrogram();
+
+    void vectorField_data();
+    void vectorField();
+
+    void polar_data();
+    void polar();
+
+  private:
+    void compare( QWidget* reference, QWidget* fast );
+};
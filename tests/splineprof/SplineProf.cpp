@@ -0,0 +1,412 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "SplineProf.h"
+
+#include <QwtSplineLocal>
+#include <QwtSplineCubic>
+#include <QwtSplinePleasing>
+#include <QwtSplineBasis>
+#include <QwtSplineParametrization>
+#include <QwtSplineCurveFitter>
+#include <QwtWeedingCurveFitter>
+#include <QwtBezier>
+
+#include <QtTest>
+#include <QPolygonF>
+#include <QPainterPath>
+#include <QLineF>
+
+#include <cmath>
+
+namespace
+{
+    enum SplineType
+    {
+        Cardinal,
+        ParabolicBlending,
+        Akima,
+        PChip,
+        Cubic,
+        Pleasing,
+        Basis
+    };
+
+    enum Output
+    {
+        Polygon,
+        PainterPath,
+        EquidistantPolygon,
+        ControlLines
+    };
+
+    const char* splineNames[] =
+    {
+        "Cardinal", "ParabolicBlending", "Akima", "PChip",
+        "Cubic", "Pleasing", "Basis"
+    };
+
+    const char* outputNames[] =
+    {
+        "polygon", "painterPath", "equidistantPolygon", "controlLines"
+    };
+
+    const char* parametrizationNames[] =
+    {
+        "X", "Y", "Uniform", "Chordal", "Centripetal", "Manhattan"
+    };
+
+    const int numPointsList[] = { 1000, 100000, 10000000 };
+    const int numPointsCount = sizeof( numPointsList ) / sizeof( numPointsList[0] );
+}
+
+static QwtSpline* createSpline( int type )
+{
+    switch ( type )
+    {
+        case Cardinal:
+            return new QwtSplineLocal( QwtSplineLocal::Cardinal );
+
+        case ParabolicBlending:
+            return new QwtSplineLocal( QwtSplineLocal::ParabolicBlending );
+
+        case Akima:
+            return new QwtSplineLocal( QwtSplineLocal::Akima );
+
+        case PChip:
+            return new QwtSplineLocal( QwtSplineLocal::PChip );
+
+        case Cubic:
+            return new QwtSplineCubic();
+
+        case Pleasing:
+            return new QwtSplinePleasing();
+
+        default:
+            return new QwtSplineBasis();
+    }
+}
+
+static QPolygonF testPoints( int numPoints )
+{
+    // the 10M points are shared by the rows of a benchmark
+    static QPolygonF points;
+
+    if ( points.size() != numPoints )
+    {
+        points.resize( numPoints );
+
+        for ( int i = 0; i < numPoints; i++ )
+        {
+            const double x = i;
+            const double y = 100.0 * std::sin( x * 0.01 ) * std::cos( x * 0.0003 )
+                + 20.0 * std::sin( x * 1.7 );
+
+            points[i] = QPointF( x, y );
+        }
+    }
+
+    return points;
+}
+
+static QByteArray rowName( const char* name, int numPoints )
+{
+    return QByteArray( name ) + " " + QByteArray::number( numPoints );
+}
+
+void SplineProf::spline_data()
+{
+    QTest::addColumn< int >( "type" );
+    QTest::addColumn< int >( "output" );
+    QTest::addColumn< int >( "numPoints" );
+
+    for ( int type = Cardinal; type <= Basis; type++ )
+    {
+        for ( int output = Polygon; output <= ControlLines; output++ )
+        {
+            // QwtSplineBasis is an approximation without control lines
+            if ( type == Basis && output >= EquidistantPolygon )
+                continue;
+
+            for ( int i = 0; i < numPointsCount; i++ )
+            {
+                const QByteArray name = QByteArray( splineNames[type] )
+                    + " " + rowName( outputNames[output], numPointsList[i] );
+
+                QTest::newRow( name.constData() ) << type << output << numPointsList[i];
+            }
+        }
+    }
+}
+
+void SplineProf::spline()
+{
+    QFETCH( int, type );
+    QFETCH( int, output );
+    QFETCH( int, numPoints );
+
+    const QPolygonF points = testPoints( numPoints );
+
+    QwtSpline* spline = createSpline( type );
+
+    switch ( output )
+    {
+        case Polygon:
+        {
+            QBENCHMARK { spline->polygon( points, 0.5 ); }
+            break;
+        }
+        case PainterPath:
+        {
+            QBENCHMARK { spline->painterPath( points ); }
+            break;
+        }
+        case EquidistantPolygon:
+        {
+            const QwtSplineInterpolating* interpolating =
+                static_cast< const QwtSplineInterpolating* >( spline );
+
+            QBENCHMARK { interpolating->equidistantPolygon( points, 1.0, false ); }
+            break;
+        }
+        case ControlLines:
+        {
+            const QwtSplineInterpolating* interpolating =
+                static_cast< const QwtSplineInterpolating* >( spline );
+
+            QBENCHMARK { interpolating->bezierControlLines( points ); }
+            break;
+        }
+    }
+
+    delete spline;
+}
+
+void SplineProf::parametrization_data()
+{
+    QTest::addColumn< int >( "type" );
+    QTest::addColumn< int >( "parametrization" );
+
+    for ( int type = Cardinal; type <= Pleasing; type++ )
+    {
+        for ( int param = QwtSplineParametrization::ParameterX;
+            param <= QwtSplineParametrization::ParameterManhattan; param++ )
+        {
+            const QByteArray name = QByteArray( splineNames[type] )
+                + " " + parametrizationNames[param];
+
+            QTest::newRow( name.constData() ) << type << param;
+        }
+    }
+}
+
+void SplineProf::parametrization()
+{
+    QFETCH( int, type );
+    QFETCH( int, parametrization );
+
+    const QPolygonF points = testPoints( 100000 );
+
+    QwtSplineInterpolating* spline =
+        static_cast< QwtSplineInterpolating* >( createSpline( type ) );
+    spline->setParametrization( parametrization );
+
+    QBENCHMARK { spline->bezierControlLines( points ); }
+
+    delete spline;
+}
+
+void SplineProf::parametricSlopes_data()
+{
+    QTest::addColumn< int >( "numPoints" );
+    QTest::addColumn< bool >( "batched" );
+
+    for ( int i = 0; i < numPointsCount; i++ )
+    {
+        for ( int batched = 0; batched <= 1; batched++ )
+        {
+            const QByteArray name = rowName(
+                batched ? "batched" : "separate", numPointsList[i] );
+
+            QTest::newRow( name.constData() ) << numPointsList[i] << bool( batched );
+        }
+    }
+}
+
+void SplineProf::parametricSlopes()
+{
+    QFETCH( int, numPoints );
+    QFETCH( bool, batched );
+
+    const QPolygonF points = testPoints( numPoints );
+
+    QPolygonF pointsX( numPoints );
+    QPolygonF pointsY( numPoints );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const double t = i + 0.5 * std::sin( 0.1 * i );
+
+        pointsX[i] = QPointF( t, points[i].x() );
+        pointsY[i] = QPointF( t, points[i].y() );
+    }
+
+    const QwtSplineCubic spline;
+
+    if ( batched )
+    {
+        QVector< double > slopesX, slopesY;
+
+        // the workspace is allocated by the first iteration
+        QBENCHMARK { spline.parametricSlopes( pointsX, pointsY, slopesX, slopesY ); }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            spline.slopes( pointsX );
+            spline.slopes( pointsY );
+        }
+    }
+}
+
+void SplineProf::splineCurveFitter_data()
+{
+    QTest::addColumn< int >( "type" );
+    QTest::addColumn< int >( "numPoints" );
+    QTest::addColumn< bool >( "parallel" );
+
+    for ( int type = Cardinal; type <= Basis; type++ )
+    {
+        for ( int i = 0; i < numPointsCount; i++ )
+        {
+            for ( int parallel = 0; parallel <= 1; parallel++ )
+            {
+                const QByteArray name = QByteArray( splineNames[type] )
+                    + " " + QByteArray::number( numPointsList[i] )
+                    + ( parallel ? " parallel" : "" );
+
+                QTest::newRow( name.constData() )
+                    << type << numPointsList[i] << bool( parallel );
+            }
+        }
+    }
+}
+
+void SplineProf::splineCurveFitter()
+{
+    QFETCH( int, type );
+    QFETCH( int, numPoints );
+    QFETCH( bool, parallel );
+
+    const QPolygonF points = testPoints( numPoints );
+
+    QwtSplineCurveFitter fitter;
+    fitter.setSpline( createSpline( type ) );
+    fitter.setRenderThreadCount( parallel ? 0 : 1 );
+
+    // measuring the fit, not the cache
+    fitter.setCacheEnabled( false );
+
+    QBENCHMARK { fitter.fitCurve( points ); }
+}
+
+void SplineProf::weedingCurveFitter_data()
+{
+    QTest::addColumn< int >( "algorithm" );
+    QTest::addColumn< int >( "chunkSize" );
+    QTest::addColumn< int >( "numPoints" );
+
+    const char* algorithms[] = { "DouglasPeucker", "HullDouglasPeucker" };
+    const int chunkSizes[] = { 0, 100, 1000, 10000 };
+
+    for ( int algorithm = QwtWeedingCurveFitter::DouglasPeucker;
+        algorithm <= QwtWeedingCurveFitter::HullDouglasPeucker; algorithm++ )
+    {
+        for ( uint j = 0; j < sizeof( chunkSizes ) / sizeof( chunkSizes[0] ); j++ )
+        {
+            for ( int i = 0; i < numPointsCount; i++ )
+            {
+                const QByteArray name = QByteArray( algorithms[algorithm] )
+                    + " chunk=" + QByteArray::number( chunkSizes[j] )
+                    + " " + QByteArray::number( numPointsList[i] );
+
+                QTest::newRow( name.constData() )
+                    << algorithm << chunkSizes[j] << numPointsList[i];
+            }
+        }
+    }
+}
+
+void SplineProf::weedingCurveFitter()
+{
+    QFETCH( int, algorithm );
+    QFETCH( int, chunkSize );
+    QFETCH( int, numPoints );
+
+    const QPolygonF points = testPoints( numPoints );
+
+    QwtWeedingCurveFitter fitter( 1.0 );
+    fitter.setAlgorithm( static_cast< QwtWeedingCurveFitter::Algorithm >( algorithm ) );
+    fitter.setChunkSize( chunkSize );
+
+    QBENCHMARK { fitter.fitCurve( points ); }
+}
+
+void SplineProf::bezier_data()
+{
+    QTest::addColumn< double >( "tolerance" );
+    QTest::addColumn< int >( "numPoints" );
+    QTest::addColumn< bool >( "adaptive" );
+
+    const double tolerances[] = { 0.1, 0.25, 0.5, 1.0, 2.0 };
+
+    for ( uint j = 0; j < sizeof( tolerances ) / sizeof( tolerances[0] ); j++ )
+    {
+        for ( int i = 0; i < numPointsCount; i++ )
+        {
+            for ( int adaptive = 0; adaptive <= 1; adaptive++ )
+            {
+                const QByteArray name = QByteArray( adaptive ? "adaptive" : "batch" )
+                    + " tolerance=" + QByteArray::number( tolerances[j] )
+                    + " " + QByteArray::number( numPointsList[i] );
+
+                QTest::newRow( name.constData() )
+                    << tolerances[j] << numPointsList[i] << bool( adaptive );
+            }
+        }
+    }
+}
+
+void SplineProf::bezier()
+{
+    QFETCH( double, tolerance );
+    QFETCH( int, numPoints );
+    QFETCH( bool, adaptive );
+
+    const QPolygonF points = testPoints( numPoints );
+
+    const QwtSplineLocal spline( QwtSplineLocal::Cardinal );
+    const QVector< QLineF > controlLines = spline.bezierControlLines( points );
+
+    const QwtBezier bezier( tolerance );
+
+    if ( adaptive )
+    {
+        QBENCHMARK
+        {
+            QPolygonF polygon;
+            for ( int i = 0; i < controlLines.size(); i++ )
+            {
+                const QLineF& l = controlLines[i];
+                bezier.appendToPolygon( points[i], l.p1(), l.p2(), points[i + 1], polygon );
+            }
+        }
+    }
+    else
+    {
+        QBENCHMARK { bezier.toPolygon( points, controlLines ); }
+    }
+}
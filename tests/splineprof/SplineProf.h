@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QObject>
+
+/*
+   Benchmarks of the spline and curve fitter implementations
+
+   The results can be written in a machine readable format
+   by the options of QtTest, f.e:
+
+     splineprof -o results.xml,xml
+     splineprof -o results.csv,csv
+
+   A single benchmark or a single row can be run by passing its name:
+
+     splineprof spline
+     splineprof "spline:Akima painterPath 100000"
+
+   The input is a noisy signal with one point per unit of the x axis,
+   so that the tolerances are in the same range as on a plot canvas.
+ */
+class SplineProf : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void spline_data();
+    void spline();
+
+    void parametrization_data();
+    void parametrization();
+
+    void parametricSlopes_data();
+    void parametricSlopes();
+
+    void splineCurveFitter_data();
+    void splineCurveFitter();
+
+    void weedingCurveFitter_data();
+    void weedingCurveFitter();
+
+    void bezier_data();
+    void bezier();
+};
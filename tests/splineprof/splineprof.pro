@@ -11,8 +11,20 @@ include( $${PWD}/../tests.pri )
 
 CONFIG -= gui
 
+greaterThan(QT_MAJOR_VERSION, 4) {
+
+    QT += testlib
+}
+else {
+
+    CONFIG += qtestlib
+}
+
 TARGET = splineprof
 
+HEADERS = \
+    SplineProf.h
+
 SOURCES = \
+    SplineProf.cpp \
     main.cpp
-
@@ -13,4 +13,8 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     splinetest \
-    splineprof
+    pyramidtest \
+    cachetest \
+    splineprof \
+    benchmarks \
+    renderdiff